@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cctype>
+#include <string>
 
 #include "opentelemetry/common/kv_properties.h"
 #include "opentelemetry/nostd/shared_ptr.h"
@@ -26,14 +28,16 @@ class Baggage
   static constexpr char kMetadataSeparator  = ';';
 
   Baggage() noexcept : kv_properties_(new opentelemetry::common::KeyValueProperties()) {}
-  Baggage(size_t size) noexcept
-      : kv_properties_(new opentelemetry::common::KeyValueProperties(size)){};
+  Baggage(size_t size, size_t arena_capacity = 0) noexcept
+      : kv_properties_(new opentelemetry::common::KeyValueProperties(size, arena_capacity)){};
 
   template <class T>
   Baggage(const T &keys_and_values) noexcept
       : kv_properties_(new opentelemetry::common::KeyValueProperties(keys_and_values))
   {}
 
+  ~Baggage() noexcept { delete parsed_.load(std::memory_order_acquire); }
+
   static nostd::shared_ptr<Baggage> GetDefault()
   {
     static nostd::shared_ptr<Baggage> baggage{new Baggage()};
@@ -45,7 +49,7 @@ class Baggage
   */
   bool GetValue(nostd::string_view key, std::string &value) const noexcept
   {
-    return kv_properties_->GetValue(key, value);
+    return Properties().GetValue(key, value);
   }
 
   /* Returns shared_ptr of new baggage object which contains new key-value pair. If key or value is
@@ -55,7 +59,9 @@ class Baggage
                                  const nostd::string_view &value) noexcept
   {
 
-    nostd::shared_ptr<Baggage> baggage(new Baggage(kv_properties_->Size() + 1));
+    const auto &kv_properties = Properties();
+    nostd::shared_ptr<Baggage> baggage(new Baggage(
+        kv_properties.Size() + 1, kv_properties.ArenaSize() + key.size() + value.size()));
     const bool valid_kv = IsValidKey(key) && IsValidValue(value);
 
     if (valid_kv)
@@ -64,7 +70,7 @@ class Baggage
     }
 
     // add rest of the fields.
-    kv_properties_->GetAllEntries(
+    kv_properties.GetAllEntries(
         [&baggage, &key, &valid_kv](nostd::string_view e_key, nostd::string_view e_value) {
           // if key or value was not valid, add all the entries. Add only remaining entries
           // otherwise.
@@ -84,7 +90,7 @@ class Baggage
   bool GetAllEntries(
       nostd::function_ref<bool(nostd::string_view, nostd::string_view)> callback) const noexcept
   {
-    return kv_properties_->GetAllEntries(callback);
+    return Properties().GetAllEntries(callback);
   }
 
   // delete key from the baggage if it exists. Returns shared_ptr of new baggage object.
@@ -94,8 +100,10 @@ class Baggage
   nostd::shared_ptr<Baggage> Delete(nostd::string_view key) noexcept
   {
     // keeping size of baggage same as key might not be found in it
-    nostd::shared_ptr<Baggage> baggage(new Baggage(kv_properties_->Size()));
-    kv_properties_->GetAllEntries(
+    const auto &kv_properties = Properties();
+    nostd::shared_ptr<Baggage> baggage(
+        new Baggage(kv_properties.Size(), kv_properties.ArenaSize()));
+    kv_properties.GetAllEntries(
         [&baggage, &key](nostd::string_view e_key, nostd::string_view e_value) {
           if (key != e_key)
             baggage->kv_properties_->AddEntry(e_key, e_value);
@@ -104,15 +112,93 @@ class Baggage
     return baggage;
   }
 
-  // Returns shared_ptr of baggage after extracting key-value pairs from header
+  // Returns shared_ptr of baggage after extracting key-value pairs from header.
+  // The header is kept as is, and its entries are only parsed on first access, so that services
+  // which merely propagate the baggage do not pay for decoding and copying every entry.
   static nostd::shared_ptr<Baggage> FromHeader(nostd::string_view header) noexcept
   {
-    if (header.size() > kMaxSize)
+    if (header.size() > kMaxSize || header.empty())
     {
       // header size exceeds maximum threshold, return empty baggage
       return GetDefault();
     }
 
+    return nostd::shared_ptr<Baggage>(new Baggage(header));
+  }
+
+  // Creates string from baggage object.
+  std::string ToHeader() const noexcept
+  {
+    // A header that was not modified is emitted unchanged, unless parsing and encoding it again
+    // would normalize it.
+    if (kv_properties_ == nullptr && IsCanonicalHeader(header_))
+    {
+      return header_;
+    }
+
+    std::string header_s;
+    bool first = true;
+    Properties().GetAllEntries([&](nostd::string_view key, nostd::string_view value) {
+      if (!first)
+      {
+        header_s.push_back(kMembersSeparator);
+      }
+      else
+      {
+        first = false;
+      }
+      header_s.append(UrlEncode(key));
+      header_s.push_back(kKeyValueSeparator);
+
+      // extracting metadata from value. We do not encode metadata
+      auto metadata_separator = value.find(kMetadataSeparator);
+      if (metadata_separator != std::string::npos)
+      {
+        header_s.append(UrlEncode(value.substr(0, metadata_separator)));
+        auto metadata = value.substr(metadata_separator);
+        header_s.append(std::string(metadata.data(), metadata.size()));
+      }
+      else
+      {
+        header_s.append(UrlEncode(value));
+      }
+      return true;
+    });
+    return header_s;
+  }
+
+private:
+  explicit Baggage(nostd::string_view header) noexcept
+      : header_(header.data(), header.size()), kv_properties_(nullptr)
+  {}
+
+  // Returns the entries of the baggage, parsing them from the header on first access.
+  const opentelemetry::common::KeyValueProperties &Properties() const noexcept
+  {
+    if (kv_properties_ != nullptr)
+    {
+      return *kv_properties_;
+    }
+
+    auto parsed = parsed_.load(std::memory_order_acquire);
+    if (parsed == nullptr)
+    {
+      // Threads racing on the first access each parse the header, and the first one to finish
+      // publishes its entries.
+      opentelemetry::common::KeyValueProperties *expected = nullptr;
+      parsed                                              = ParseHeader(header_);
+      if (!parsed_.compare_exchange_strong(expected, parsed, std::memory_order_acq_rel,
+                                           std::memory_order_acquire))
+      {
+        delete parsed;
+        parsed = expected;
+      }
+    }
+    return *parsed;
+  }
+
+  static opentelemetry::common::KeyValueProperties *ParseHeader(nostd::string_view header) noexcept
+  {
     common::KeyValueStringTokenizer kv_str_tokenizer(header);
     size_t cnt = kv_str_tokenizer.NumTokens();  // upper bound on number of kv pairs
     if (cnt > kMaxKeyValuePairs)
@@ -120,11 +206,12 @@ class Baggage
       cnt = kMaxKeyValuePairs;
     }
 
-    nostd::shared_ptr<Baggage> baggage(new Baggage(cnt));
+    // Decoding only shortens the keys and values, so the header bounds their size.
+    auto kv_properties = new opentelemetry::common::KeyValueProperties(cnt, header.size());
     bool kv_valid;
     nostd::string_view key, value;
 
-    while (kv_str_tokenizer.next(kv_valid, key, value) && baggage->kv_properties_->Size() < cnt)
+    while (kv_str_tokenizer.next(kv_valid, key, value) && kv_properties->Size() < cnt)
     {
       if (!kv_valid || (key.size() + value.size() > kMaxKeyValueSize))
       {
@@ -152,48 +239,58 @@ class Baggage
         {
           value_str.append(metadata.data(), metadata.size());
         }
-        baggage->kv_properties_->AddEntry(key_str, value_str);
+        kv_properties->AddEntry(key_str, value_str);
       }
     }
 
-    return baggage;
+    return kv_properties;
   }
 
-  // Creates string from baggage object.
-  std::string ToHeader() const noexcept
+  // Returns whether ToHeader() of the parsed header would give the header back: every member is
+  // a non-empty key and a value of unreserved characters, which decode and encode to themselves.
+  static bool IsCanonicalHeader(nostd::string_view header) noexcept
   {
-    std::string header_s;
-    bool first = true;
-    kv_properties_->GetAllEntries([&](nostd::string_view key, nostd::string_view value) {
-      if (!first)
-      {
-        header_s.push_back(kMembersSeparator);
-      }
-      else
+    size_t members      = 1;
+    size_t member_begin = 0;
+    size_t separator    = std::string::npos;
+    for (size_t i = 0; i <= header.size(); i++)
+    {
+      if (i == header.size() || header[i] == kMembersSeparator)
       {
-        first = false;
+        if (separator == std::string::npos || separator == member_begin ||
+            i - member_begin - 1 > kMaxKeyValueSize)
+        {
+          return false;
+        }
+        if (i < header.size() && ++members > kMaxKeyValuePairs)
+        {
+          return false;
+        }
+        member_begin = i + 1;
+        separator    = std::string::npos;
       }
-      header_s.append(UrlEncode(key));
-      header_s.push_back(kKeyValueSeparator);
-
-      // extracting metadata from value. We do not encode metadata
-      auto metadata_separator = value.find(kMetadataSeparator);
-      if (metadata_separator != std::string::npos)
+      else if (header[i] == kKeyValueSeparator)
       {
-        header_s.append(UrlEncode(value.substr(0, metadata_separator)));
-        auto metadata = value.substr(metadata_separator);
-        header_s.append(std::string(metadata.data(), metadata.size()));
+        if (separator != std::string::npos)
+        {
+          return false;
+        }
+        separator = i;
       }
-      else
+      else if (!IsUnreserved(header[i]))
       {
-        header_s.append(UrlEncode(value));
+        return false;
       }
-      return true;
-    });
-    return header_s;
+    }
+    return true;
+  }
+
+  static bool IsUnreserved(char c)
+  {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' ||
+           c == '_' || c == '.' || c == '~';
   }
 
-private:
   static bool IsPrintableString(nostd::string_view str)
   {
     for (const auto ch : str)
@@ -290,8 +387,13 @@ class Baggage
   }
 
 private:
-  // Store entries in a C-style array to avoid using std::array or std::vector.
+  // Header of a baggage created by FromHeader().
+  std::string header_;
+
+  // Store entries in a C-style array to avoid using std::array or std::vector. Null for a
+  // baggage created by FromHeader(), whose entries are parsed into parsed_ on first access.
   nostd::unique_ptr<opentelemetry::common::KeyValueProperties> kv_properties_;
+  mutable std::atomic<opentelemetry::common::KeyValueProperties *> parsed_{nullptr};
 };
 
 }  // namespace baggage
@@ -15,10 +15,18 @@ namespace baggage
 
 static const std::string kBaggageHeader = "baggage";
 
+// Interned kBaggageHeader, identifying the baggage in a context. The function returns the same
+// object in every translation unit, so that contexts recognize the key by address.
+inline const context::ContextKey &GetBaggageContextKey() noexcept
+{
+  static constexpr context::ContextKey key{"baggage"};
+  return key;
+}
+
 inline nostd::shared_ptr<opentelemetry::baggage::Baggage> GetBaggage(
     const opentelemetry::context::Context &context) noexcept
 {
-  context::ContextValue context_value = context.GetValue(kBaggageHeader);
+  context::ContextValue context_value = context.GetValue(GetBaggageContextKey());
   if (nostd::holds_alternative<nostd::shared_ptr<opentelemetry::baggage::Baggage>>(context_value))
   {
     return nostd::get<nostd::shared_ptr<opentelemetry::baggage::Baggage>>(context_value);
@@ -32,7 +40,7 @@ inline context::Context SetBaggage(
     opentelemetry::context::Context &context,
     nostd::shared_ptr<opentelemetry::baggage::Baggage> baggage) noexcept
 {
-  return context.SetValue(kBaggageHeader, baggage);
+  return context.SetValue(GetBaggageContextKey(), baggage);
 }
 
 }  // namespace baggage
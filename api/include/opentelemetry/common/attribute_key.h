@@ -0,0 +1,67 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace common
+{
+
+/**
+ * An attribute key known at compile time: its name, the FNV-1a hash of the name and, for the keys
+ * of the semantic conventions, the id the SDK interns the key with. Computing these at compile time
+ * lets the SDK skip hashing and looking up the key when it records the attribute.
+ *
+ * The descriptors of the semantic conventions are generated into the semantic convention headers
+ * by buildscripts/semantic-convention/generate_attribute_keys.py. An AttributeKey converts to the
+ * nostd::string_view of its name, so it can be passed wherever a key is expected.
+ */
+class AttributeKey
+{
+public:
+  /** The id of the keys which are not part of the semantic conventions. */
+  static constexpr uint32_t kNoId = 0xffffffff;
+
+  explicit constexpr AttributeKey(const char *name, uint32_t id = kNoId) noexcept
+      : name_(name), size_(Length(name)), hash_(Hash(name)), id_(id)
+  {}
+
+  constexpr nostd::string_view name() const noexcept { return nostd::string_view(name_, size_); }
+
+  constexpr operator nostd::string_view() const noexcept { return name(); }
+
+  /** Returns the FNV-1a hash of the name. */
+  constexpr uint64_t hash() const noexcept { return hash_; }
+
+  /** Returns the id of a semantic convention key, or kNoId. */
+  constexpr uint32_t id() const noexcept { return id_; }
+
+  /** Returns the 64-bit FNV-1a hash of the null-terminated `str`. */
+  static constexpr uint64_t Hash(const char *str,
+                                 uint64_t hash = 14695981039346656037ULL) noexcept
+  {
+    return *str == '\0'
+               ? hash
+               : Hash(str + 1, (hash ^ static_cast<unsigned char>(*str)) * 1099511628211ULL);
+  }
+
+private:
+  static constexpr size_t Length(const char *str, size_t length = 0) noexcept
+  {
+    return *str == '\0' ? length : Length(str + 1, length + 1);
+  }
+
+  const char *name_;
+  size_t size_;
+  uint64_t hash_;
+  uint32_t id_;
+};
+
+}  // namespace common
+OPENTELEMETRY_END_NAMESPACE
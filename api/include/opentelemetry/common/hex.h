@@ -0,0 +1,211 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opentelemetry/version.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define OPENTELEMETRY_HEX_SSE2
+#elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define OPENTELEMETRY_HEX_NEON
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace common
+{
+
+/**
+ * Hex conversions of ids, e.g. of the trace and span ids formatted into log lines and propagation
+ * headers:
+ * - EncodeLowerHex(bytes, size, hex) encodes `size` bytes into 2 * `size` lowercase hex digits;
+ * - DecodeHex(hex, size, bytes) decodes 2 * `size` hex digits, in either case, into `size` bytes,
+ *   and returns false, leaving bytes unspecified, if any character is not a hex digit.
+ *
+ * With SSE2 (x86-64) or NEON (AArch64), every 8 bytes, e.g. a span id, are converted at once. The
+ * remaining bytes, and other platforms, use the scalar functions, which tests compare against.
+ */
+
+/**
+ * Encodes `size` bytes into 2 * `size` lowercase hex digits, one byte at a time.
+ */
+inline void EncodeLowerHexScalar(const uint8_t *bytes, size_t size, char *hex) noexcept
+{
+  static const char kLowerHex[] = "0123456789abcdef";
+  for (size_t i = 0; i < size; i++)
+  {
+    hex[2 * i]     = kLowerHex[bytes[i] >> 4];
+    hex[2 * i + 1] = kLowerHex[bytes[i] & 0xF];
+  }
+}
+
+/**
+ * Decodes 2 * `size` hex digits, in either case, into `size` bytes, one byte at a time.
+ * Returns false, leaving bytes unspecified, if any character is not a hex digit.
+ */
+inline bool DecodeHexScalar(const char *hex, size_t size, uint8_t *bytes) noexcept
+{
+  bool valid = true;
+  for (size_t i = 0; i < 2 * size; i++)
+  {
+    uint8_t c     = static_cast<uint8_t>(hex[i]);
+    uint8_t digit = static_cast<uint8_t>(c - '0');
+    uint8_t alpha = static_cast<uint8_t>((c | 0x20) - 'a');
+    uint8_t value = digit <= 9 ? digit : static_cast<uint8_t>(alpha + 10);
+    valid         = valid && (digit <= 9 || alpha <= 5);
+    if (i % 2 == 0)
+    {
+      bytes[i / 2] = static_cast<uint8_t>(value << 4);
+    }
+    else
+    {
+      bytes[i / 2] = static_cast<uint8_t>(bytes[i / 2] | (value & 0xF));
+    }
+  }
+  return valid;
+}
+
+#if defined(OPENTELEMETRY_HEX_SSE2)
+
+namespace detail
+{
+// Converts nibbles, one per byte, into lowercase hex digits.
+inline __m128i NibblesToLowerHex(__m128i nibbles) noexcept
+{
+  __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+  return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                      _mm_and_si128(letters, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+// Returns the bytes of `chars` in [low, high] as a mask. SSE2 only compares signed bytes: the
+// range is shifted to start at -128.
+inline __m128i InRange(__m128i chars, char low, char high) noexcept
+{
+  __m128i shifted = _mm_add_epi8(chars, _mm_set1_epi8(static_cast<char>(0x80 - low)));
+  return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + (high - low + 1))));
+}
+
+// Decodes 16 hex digits into 8 bytes, held by the 16-bit lanes of the result. Sets `valid` to
+// zero if any character is not a hex digit.
+inline __m128i DecodeHex16(const char *hex, int &valid) noexcept
+{
+  __m128i chars  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hex));
+  __m128i lower  = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  __m128i digits = InRange(chars, '0', '9');
+  __m128i alphas = InRange(lower, 'a', 'f');
+  valid &= _mm_movemask_epi8(_mm_or_si128(digits, alphas)) == 0xFFFF;
+  __m128i values = _mm_or_si128(_mm_and_si128(digits, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                                _mm_andnot_si128(digits, _mm_sub_epi8(lower, _mm_set1_epi8(87))));
+  // Each 16-bit lane holds the high nibble in its low byte and the low nibble in its high byte.
+  return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0xF)), 4),
+                      _mm_and_si128(_mm_srli_epi16(values, 8), _mm_set1_epi16(0xF)));
+}
+}  // namespace detail
+
+inline void EncodeLowerHex(const uint8_t *bytes, size_t size, char *hex) noexcept
+{
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8)
+  {
+    __m128i in     = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(bytes + i));
+    __m128i high   = _mm_and_si128(_mm_srli_epi16(in, 4), _mm_set1_epi8(0xF));
+    __m128i low    = _mm_and_si128(in, _mm_set1_epi8(0xF));
+    __m128i digits = detail::NibblesToLowerHex(_mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hex + 2 * i), digits);
+  }
+  EncodeLowerHexScalar(bytes + i, size - i, hex + 2 * i);
+}
+
+inline bool DecodeHex(const char *hex, size_t size, uint8_t *bytes) noexcept
+{
+  int valid = 1;
+  size_t i  = 0;
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i first  = detail::DecodeHex16(hex + 2 * i, valid);
+    __m128i second = detail::DecodeHex16(hex + 2 * i + 16, valid);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes + i), _mm_packus_epi16(first, second));
+  }
+  for (; i + 8 <= size; i += 8)
+  {
+    __m128i lanes = detail::DecodeHex16(hex + 2 * i, valid);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(bytes + i), _mm_packus_epi16(lanes, lanes));
+  }
+  return DecodeHexScalar(hex + 2 * i, size - i, bytes + i) && valid;
+}
+
+#elif defined(OPENTELEMETRY_HEX_NEON)
+
+namespace detail
+{
+// Converts nibbles, one per byte, into lowercase hex digits.
+inline uint8x16_t NibblesToLowerHex(uint8x16_t nibbles) noexcept
+{
+  uint8x16_t letters = vcgtq_u8(nibbles, vdupq_n_u8(9));
+  return vaddq_u8(vaddq_u8(nibbles, vdupq_n_u8('0')),
+                  vandq_u8(letters, vdupq_n_u8('a' - '0' - 10)));
+}
+
+// Decodes 16 hex digits into 8 bytes. Clears `valid` if any character is not a hex digit.
+inline uint8x8_t DecodeHex16(const char *hex, uint8x16_t &valid) noexcept
+{
+  uint8x16_t chars  = vld1q_u8(reinterpret_cast<const uint8_t *>(hex));
+  uint8x16_t digit  = vsubq_u8(chars, vdupq_n_u8('0'));
+  uint8x16_t alpha  = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  uint8x16_t digits = vcleq_u8(digit, vdupq_n_u8(9));
+  uint8x16_t alphas = vcleq_u8(alpha, vdupq_n_u8(5));
+  valid             = vandq_u8(valid, vorrq_u8(digits, alphas));
+  uint8x16_t values = vbslq_u8(digits, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+  // The even bytes hold the high nibbles, the odd ones the low nibbles.
+  uint8x16x2_t nibbles = vuzpq_u8(values, values);
+  return vget_low_u8(
+      vorrq_u8(vshlq_n_u8(nibbles.val[0], 4), vandq_u8(nibbles.val[1], vdupq_n_u8(0xF))));
+}
+}  // namespace detail
+
+inline void EncodeLowerHex(const uint8_t *bytes, size_t size, char *hex) noexcept
+{
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8)
+  {
+    uint8x8_t in        = vld1_u8(bytes + i);
+    uint8x8x2_t nibbles = vzip_u8(vshr_n_u8(in, 4), vand_u8(in, vdup_n_u8(0xF)));
+    uint8x16_t digits =
+        detail::NibblesToLowerHex(vcombine_u8(nibbles.val[0], nibbles.val[1]));
+    vst1q_u8(reinterpret_cast<uint8_t *>(hex + 2 * i), digits);
+  }
+  EncodeLowerHexScalar(bytes + i, size - i, hex + 2 * i);
+}
+
+inline bool DecodeHex(const char *hex, size_t size, uint8_t *bytes) noexcept
+{
+  uint8x16_t valid = vdupq_n_u8(0xFF);
+  size_t i         = 0;
+  for (; i + 8 <= size; i += 8)
+  {
+    vst1_u8(bytes + i, detail::DecodeHex16(hex + 2 * i, valid));
+  }
+  return DecodeHexScalar(hex + 2 * i, size - i, bytes + i) && vminvq_u8(valid) == 0xFF;
+}
+
+#else
+
+inline void EncodeLowerHex(const uint8_t *bytes, size_t size, char *hex) noexcept
+{
+  EncodeLowerHexScalar(bytes, size, hex);
+}
+
+inline bool DecodeHex(const char *hex, size_t size, uint8_t *bytes) noexcept
+{
+  return DecodeHexScalar(hex, size, bytes);
+}
+
+#endif
+
+}  // namespace common
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,213 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace common
+{
+
+template <class T>
+class IntrusivePtr;
+
+/**
+ * Base class of objects owned by IntrusivePtr, holding their reference count.
+ *
+ * The count lives in the object itself, so that copying an IntrusivePtr is a single atomic
+ * increment, without the virtual calls of nostd::shared_ptr. The layout of the count is fixed and
+ * the object is deleted through its virtual destructor, i.e. by the module that created it, which
+ * keeps IntrusivePtr ABI stable across modules built with different standard libraries.
+ *
+ * A copy of a RefCounted object starts unreferenced: the count belongs to the instance.
+ */
+class RefCounted
+{
+public:
+  RefCounted() noexcept = default;
+
+  RefCounted(const RefCounted &) noexcept {}
+
+  RefCounted &operator=(const RefCounted &) noexcept { return *this; }
+
+  /** Returns the number of IntrusivePtr owning this object, for tests and diagnostics. */
+  long UseCount() const noexcept { return ref_count_.load(std::memory_order_relaxed); }
+
+protected:
+  virtual ~RefCounted() = default;
+
+private:
+  template <class T>
+  friend class IntrusivePtr;
+
+  void AddRef() const noexcept { ref_count_.fetch_add(1, std::memory_order_relaxed); }
+
+  void Release() const noexcept
+  {
+    // The acquire half orders the destruction after the last uses of the object in other threads.
+    if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      delete this;
+    }
+  }
+
+  mutable std::atomic<long> ref_count_{0};
+};
+
+/**
+ * A shared pointer to an object deriving from RefCounted, whose reference count is intrusive.
+ *
+ * It is the size of a raw pointer and has the interface of std::shared_ptr, except for custom
+ * deleters, aliasing and weak pointers, which it does not support.
+ */
+template <class T>
+class IntrusivePtr
+{
+  static_assert(std::is_base_of<RefCounted, T>::value, "T must derive from common::RefCounted");
+
+public:
+  using element_type = T;
+  using pointer      = element_type *;
+
+  IntrusivePtr() noexcept = default;
+
+  IntrusivePtr(std::nullptr_t) noexcept {}
+
+  /** Takes a reference to `ptr`, which may already be owned by other IntrusivePtr. */
+  explicit IntrusivePtr(pointer ptr) noexcept : ptr_{ptr}
+  {
+    if (ptr_ != nullptr)
+    {
+      AsRefCounted(ptr_)->AddRef();
+    }
+  }
+
+  IntrusivePtr(const IntrusivePtr &other) noexcept : IntrusivePtr(other.ptr_) {}
+
+  IntrusivePtr(IntrusivePtr &&other) noexcept : ptr_{other.ptr_} { other.ptr_ = nullptr; }
+
+  template <class U,
+            typename std::enable_if<std::is_convertible<U *, pointer>::value>::type * = nullptr>
+  IntrusivePtr(const IntrusivePtr<U> &other) noexcept : IntrusivePtr(other.get())
+  {}
+
+  template <class U,
+            typename std::enable_if<std::is_convertible<U *, pointer>::value>::type * = nullptr>
+  IntrusivePtr(IntrusivePtr<U> &&other) noexcept : ptr_{other.ptr_}
+  {
+    other.ptr_ = nullptr;
+  }
+
+  ~IntrusivePtr()
+  {
+    if (ptr_ != nullptr)
+    {
+      AsRefCounted(ptr_)->Release();
+    }
+  }
+
+  IntrusivePtr &operator=(const IntrusivePtr &other) noexcept
+  {
+    IntrusivePtr(other).swap(*this);
+    return *this;
+  }
+
+  IntrusivePtr &operator=(IntrusivePtr &&other) noexcept
+  {
+    IntrusivePtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  IntrusivePtr &operator=(std::nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  template <class U,
+            typename std::enable_if<std::is_convertible<U *, pointer>::value>::type * = nullptr>
+  IntrusivePtr &operator=(IntrusivePtr<U> &&other) noexcept
+  {
+    IntrusivePtr(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  void reset() noexcept { IntrusivePtr().swap(*this); }
+
+  void reset(pointer ptr) noexcept { IntrusivePtr(ptr).swap(*this); }
+
+  void swap(IntrusivePtr &other) noexcept { std::swap(ptr_, other.ptr_); }
+
+  pointer get() const noexcept { return ptr_; }
+
+  element_type &operator*() const noexcept { return *ptr_; }
+
+  pointer operator->() const noexcept { return ptr_; }
+
+  explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+  long use_count() const noexcept { return ptr_ == nullptr ? 0 : AsRefCounted(ptr_)->UseCount(); }
+
+private:
+  template <class U>
+  friend class IntrusivePtr;
+
+  static const RefCounted *AsRefCounted(pointer ptr) noexcept
+  {
+    return static_cast<const RefCounted *>(ptr);
+  }
+
+  pointer ptr_ = nullptr;
+};
+
+/** Creates an object of type T owned by an IntrusivePtr. */
+template <class T, class... Args>
+IntrusivePtr<T> MakeIntrusive(Args &&... args)
+{
+  return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+template <class T1, class T2>
+inline bool operator==(const IntrusivePtr<T1> &lhs, const IntrusivePtr<T2> &rhs) noexcept
+{
+  return lhs.get() == rhs.get();
+}
+
+template <class T1, class T2>
+inline bool operator!=(const IntrusivePtr<T1> &lhs, const IntrusivePtr<T2> &rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+inline bool operator==(const IntrusivePtr<T> &lhs, std::nullptr_t) noexcept
+{
+  return lhs.get() == nullptr;
+}
+
+template <class T>
+inline bool operator==(std::nullptr_t, const IntrusivePtr<T> &rhs) noexcept
+{
+  return nullptr == rhs.get();
+}
+
+template <class T>
+inline bool operator!=(const IntrusivePtr<T> &lhs, std::nullptr_t) noexcept
+{
+  return lhs.get() != nullptr;
+}
+
+template <class T>
+inline bool operator!=(std::nullptr_t, const IntrusivePtr<T> &rhs) noexcept
+{
+  return nullptr != rhs.get();
+}
+
+}  // namespace common
+OPENTELEMETRY_END_NAMESPACE
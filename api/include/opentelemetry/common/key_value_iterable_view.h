@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -73,5 +75,39 @@ class KeyValueIterableView final : public KeyValueIterable
 private:
   const T *container_;
 };
+
+/**
+ * A fixed set of attributes, typically known at compile time. Keys and values are both held by
+ * reference (string views and spans), so iterating a KeyValueIterableView over it passes them on
+ * without building a map or copying strings and arrays; only the recordable which keeps the
+ * attributes copies them.
+ *
+ *   static const common::KeyValueArray<2> kAttributes = {
+ *       {common::MakeKeyValue("http.method", "GET"), common::MakeKeyValue("http.status", 200)}};
+ *   span->AddEvent("request", kAttributes);
+ */
+template <size_t N>
+using KeyValueArray = std::array<std::pair<nostd::string_view, AttributeValue>, N>;
+
+/**
+ * Makes an entry of a KeyValueArray whose key is a string literal, without computing its length
+ * at run time: the entry is a constant expression when the value is (C++14 and later).
+ */
+template <size_t N>
+constexpr std::pair<nostd::string_view, AttributeValue> MakeKeyValue(const char (&key)[N],
+                                                                     AttributeValue value) noexcept
+{
+  return std::pair<nostd::string_view, AttributeValue>(nostd::string_view(key, N - 1), value);
+}
+
+/**
+ * Makes a KeyValueIterable referring to `container`, for the functions which take a
+ * KeyValueIterable rather than a container. `container` must outlive the view.
+ */
+template <class T>
+KeyValueIterableView<T> MakeKeyValueIterableView(const T &container) noexcept
+{
+  return KeyValueIterableView<T>(container);
+}
 }  // namespace common
 OPENTELEMETRY_END_NAMESPACE
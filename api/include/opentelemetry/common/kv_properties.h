@@ -194,45 +194,84 @@ class KeyValueProperties
     }
   };
 
-  // Maintain the number of entries in entries_.
-  size_t num_entries_;
-
-  // Max size of allocated array
-  size_t max_num_entries_;
-
-  // Store entries in a C-style array to avoid using std::array or std::vector.
-  nostd::unique_ptr<Entry[]> entries_;
-
-public:
   // Create Key-value list of given size
   // @param size : Size of list.
-  KeyValueProperties(size_t size) noexcept
-      : num_entries_(0), max_num_entries_(size), entries_(new Entry[size])
-  {}
+  // @param arena_capacity : Number of bytes reserved for the keys and values of the list.
+  KeyValueProperties(size_t size, size_t arena_capacity = 0) noexcept
+      : num_entries_(0),
+        max_num_entries_(size),
+        entries_(size > 0 ? new EntrySlot[size] : nullptr),
+        arena_size_(0),
+        arena_capacity_(0)
+  {
+    ReserveArena(arena_capacity);
+  }
 
   // Create Empty Key-Value list
-  KeyValueProperties() noexcept : num_entries_(0), max_num_entries_(0), entries_(nullptr) {}
+  KeyValueProperties() noexcept
+      : num_entries_(0),
+        max_num_entries_(0),
+        entries_(nullptr),
+        arena_size_(0),
+        arena_capacity_(0)
+  {}
 
   template <class T, class = typename std::enable_if<detail::is_key_value_iterable<T>::value>::type>
   KeyValueProperties(const T &keys_and_values) noexcept
-      : num_entries_(0),
-        max_num_entries_(keys_and_values.size()),
-        entries_(new Entry[max_num_entries_])
+      : KeyValueProperties(keys_and_values.size())
   {
+    size_t arena_capacity = 0;
+    for (auto &e : keys_and_values)
+    {
+      arena_capacity += nostd::string_view(e.first).size() + nostd::string_view(e.second).size();
+    }
+    ReserveArena(arena_capacity);
     for (auto &e : keys_and_values)
     {
-      Entry entry(e.first, e.second);
-      (entries_.get())[num_entries_++] = std::move(entry);
+      AddEntry(e.first, e.second);
     }
   }
 
+  // Copies the entries, with one copy of the slots and one of the arena.
+  KeyValueProperties(const KeyValueProperties &other) noexcept
+      : KeyValueProperties(other.max_num_entries_, other.arena_size_)
+  {
+    CopyFrom(other);
+  }
+
+  KeyValueProperties &operator=(const KeyValueProperties &other) noexcept
+  {
+    if (this != &other)
+    {
+      KeyValueProperties copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  KeyValueProperties(KeyValueProperties &&other) = default;
+  KeyValueProperties &operator=(KeyValueProperties &&other) = default;
+
   // Adds new kv pair into kv properties
   void AddEntry(nostd::string_view key, nostd::string_view value) noexcept
   {
     if (num_entries_ < max_num_entries_)
     {
-      Entry entry(key, value);
-      (entries_.get())[num_entries_++] = std::move(entry);
+      ReserveArena(arena_size_ + key.size() + value.size());
+      auto &slot        = (entries_.get())[num_entries_++];
+      slot.key_offset   = arena_size_;
+      slot.key_size     = key.size();
+      slot.value_size   = value.size();
+      char *destination = arena_.get() + arena_size_;
+      if (!key.empty())
+      {
+        memcpy(destination, key.data(), key.size());
+      }
+      if (!value.empty())
+      {
+        memcpy(destination + key.size(), value.data(), value.size());
+      }
+      arena_size_ += key.size() + value.size();
     }
   }
 
@@ -242,8 +281,8 @@ class KeyValueProperties
   {
     for (size_t i = 0; i < num_entries_; i++)
     {
-      auto &entry = (entries_.get())[i];
-      if (!callback(entry.GetKey(), entry.GetValue()))
+      auto &slot = (entries_.get())[i];
+      if (!callback(GetKey(slot), GetValue(slot)))
       {
         return false;
       }
@@ -256,10 +295,10 @@ class KeyValueProperties
   {
     for (size_t i = 0; i < num_entries_; i++)
     {
-      auto &entry = (entries_.get())[i];
-      if (entry.GetKey() == key)
+      auto &slot = (entries_.get())[i];
+      if (GetKey(slot) == key)
       {
-        const auto &entry_value = entry.GetValue();
+        const auto &entry_value = GetValue(slot);
         value                   = std::string(entry_value.data(), entry_value.size());
         return true;
       }
@@ -267,7 +306,79 @@ class KeyValueProperties
     return false;
   }
 
+  // Returns the number of bytes taken by the keys and values of the list.
+  size_t ArenaSize() const noexcept { return arena_size_; }
+
   size_t Size() const noexcept { return num_entries_; }
+
+private:
+  // An entry, as its key followed by its value in the arena. Offsets rather than pointers keep
+  // the slots valid when the arena grows, and let copies take them as they are.
+  struct EntrySlot
+  {
+    size_t key_offset;
+    size_t key_size;
+    size_t value_size;
+  };
+
+  nostd::string_view GetKey(const EntrySlot &slot) const noexcept
+  {
+    return nostd::string_view(arena_.get() + slot.key_offset, slot.key_size);
+  }
+
+  nostd::string_view GetValue(const EntrySlot &slot) const noexcept
+  {
+    return nostd::string_view(arena_.get() + slot.key_offset + slot.key_size, slot.value_size);
+  }
+
+  // Makes room for at least `capacity` bytes in the arena, doubling it to amortize the growth of
+  // lists whose size was not reserved.
+  void ReserveArena(size_t capacity) noexcept
+  {
+    if (capacity <= arena_capacity_)
+    {
+      return;
+    }
+    if (capacity < 2 * arena_capacity_)
+    {
+      capacity = 2 * arena_capacity_;
+    }
+    char *arena = new char[capacity];
+    if (arena_size_ > 0)
+    {
+      memcpy(arena, arena_.get(), arena_size_);
+    }
+    arena_.reset(arena);
+    arena_capacity_ = capacity;
+  }
+
+  void CopyFrom(const KeyValueProperties &other) noexcept
+  {
+    num_entries_ = other.num_entries_;
+    if (num_entries_ > 0)
+    {
+      memcpy(entries_.get(), other.entries_.get(), num_entries_ * sizeof(EntrySlot));
+    }
+    arena_size_ = other.arena_size_;
+    if (arena_size_ > 0)
+    {
+      memcpy(arena_.get(), other.arena_.get(), arena_size_);
+    }
+  }
+
+  // Maintain the number of entries in entries_.
+  size_t num_entries_;
+
+  // Max size of allocated array
+  size_t max_num_entries_;
+
+  // Store entries in a C-style array to avoid using std::array or std::vector.
+  nostd::unique_ptr<EntrySlot[]> entries_;
+
+  // The keys and values of all the entries, in one allocation rather than two per entry.
+  nostd::unique_ptr<char[]> arena_;
+  size_t arena_size_;
+  size_t arena_capacity_;
 };
 }  // namespace common
 OPENTELEMETRY_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/nostd/shared_ptr.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace common
+{
+
+/**
+ * A nostd::shared_ptr read concurrently and rarely replaced, such as a global provider.
+ *
+ * The pointer lives in one of two slots. Readers enter the active slot, copy its pointer and
+ * leave, without excluding each other: a read is a few atomic operations and never waits for
+ * another read. Store() fills the other slot, makes it active, then waits for the readers still
+ * inside the previous slot to leave before releasing its pointer, so the previous object is
+ * released by the time Store() returns. Stores are serialized with each other.
+ */
+template <class T>
+class ReadMostlySharedPtr
+{
+public:
+  explicit ReadMostlySharedPtr(nostd::shared_ptr<T> ptr) noexcept
+  {
+    slots_[0].ptr = std::move(ptr);
+  }
+
+  nostd::shared_ptr<T> Load() const noexcept
+  {
+    for (;;)
+    {
+      uint32_t index   = active_.load(std::memory_order_seq_cst);
+      const Slot &slot = slots_[index];
+      slot.readers.fetch_add(1, std::memory_order_seq_cst);
+      // A Store() that switched slots before the increment was visible may not wait for this
+      // thread: only read the slot if it is still active.
+      if (active_.load(std::memory_order_seq_cst) == index)
+      {
+        nostd::shared_ptr<T> ptr(slot.ptr);
+        slot.readers.fetch_sub(1, std::memory_order_release);
+        return ptr;
+      }
+      slot.readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  void Store(nostd::shared_ptr<T> ptr) noexcept
+  {
+    nostd::shared_ptr<T> previous_ptr;
+    {
+      std::lock_guard<SpinLockMutex> guard(store_lock_);
+      uint32_t previous = active_.load(std::memory_order_relaxed);
+      // Readers may only be inside the inactive slot transiently, without reading its pointer.
+      slots_[previous ^ 1].ptr = std::move(ptr);
+      active_.store(previous ^ 1, std::memory_order_seq_cst);
+
+      Slot &slot = slots_[previous];
+      while (slot.readers.load(std::memory_order_seq_cst) != 0)
+      {
+        std::this_thread::yield();
+      }
+      previous_ptr.swap(slot.ptr);
+    }
+    // The previous object, if this was its last reference, is destroyed outside of the lock.
+  }
+
+private:
+  struct Slot
+  {
+    // Number of readers inside this slot, or about to check whether they may be.
+    mutable std::atomic<uint32_t> readers{0};
+    nostd::shared_ptr<T> ptr;
+  };
+
+  Slot slots_[2];
+  std::atomic<uint32_t> active_{0};
+  SpinLockMutex store_lock_;
+};
+
+}  // namespace common
+OPENTELEMETRY_END_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 
 #include "opentelemetry/version.h"
@@ -15,7 +16,19 @@
 #  endif
 #  define _WINSOCKAPI_  // stops including winsock.h
 #  include <windows.h>
-#elif defined(__i386__) || defined(__x86_64__)
+#  if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602  // Windows 8
+#    include <synchapi.h>
+#    pragma comment(lib, "Synchronization.lib")
+#    define OPENTELEMETRY_SPINLOCK_PARKING_WAIT_ON_ADDRESS
+#  endif
+#elif defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  define OPENTELEMETRY_SPINLOCK_PARKING_FUTEX
+#endif
+
+#if !defined(_MSC_VER) && (defined(__i386__) || defined(__x86_64__))
 #  if defined(__clang__)
 #    include <emmintrin.h>
 #  endif
@@ -32,20 +45,14 @@ constexpr int SPINLOCK_SLEEP_MS        = 1;
  * A Mutex which uses atomic flags and spin-locks instead of halting threads.
  *
  * This mutex uses an incremental back-off strategy with the following phases:
- * 1. A tight spin-lock loop (pending: using hardware PAUSE/YIELD instructions)
- * 2. A loop where the current thread yields control after checking the lock.
- * 3. Issuing a thread-sleep call before starting back in phase 1.
- *
- * This is meant to give a good balance of perofrmance and CPU consumption in
- * practice.
- *
- * This mutex uses an incremental back-off strategy with the following phases:
- * 1. A tight spin-lock loop (pending: using hardware PAUSE/YIELD instructions)
- * 2. A loop where the current thread yields control after checking the lock.
- * 3. Issuing a thread-sleep call before starting back in phase 1.
+ * 1. A tight spin-lock loop using hardware PAUSE/YIELD instructions.
+ * 2. A yield of the current thread, after which the lock is checked again.
+ * 3. Parking the thread until the lock is released: on a futex on Linux, with WaitOnAddress on
+ *    Windows 8 and later. On other platforms, the thread sleeps before starting back in phase 1.
  *
- * This is meant to give a good balance of perofrmance and CPU consumption in
- * practice.
+ * A thread which parks marks the lock as contended, so that unlock() wakes one parked thread.
+ * As no thread sleeps for a fixed time where parking is available, a release is never followed by
+ * a millisecond without an owner.
  *
  * This class implements the `BasicLockable` specification:
  * https://en.cppreference.com/w/cpp/named_req/BasicLockable
@@ -64,8 +71,10 @@ class SpinLockMutex
    */
   bool try_lock() noexcept
   {
-    return !flag_.load(std::memory_order_relaxed) &&
-           !flag_.exchange(true, std::memory_order_acquire);
+    uint32_t expected = kUnlocked;
+    return state_.load(std::memory_order_relaxed) == kUnlocked &&
+           state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                          std::memory_order_relaxed);
   }
 
   /**
@@ -73,38 +82,26 @@ class SpinLockMutex
    *
    * This mutex will spin the current CPU waiting for the lock to be available.  This can have
    * decent performance in scenarios where there is low lock contention and lock-holders achieve
-   * their work quickly.  It degrades in scenarios where locked tasks take a long time.
+   * their work quickly.  Threads which keep waiting are parked rather than spinning.
    */
   void lock() noexcept
   {
+    uint32_t expected = kUnlocked;
+    if (state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                       std::memory_order_relaxed))
+    {
+      return;
+    }
     for (;;)
     {
-      // Try once
-      if (!flag_.exchange(true, std::memory_order_acquire))
-      {
-        return;
-      }
       // Spin-Fast (goal ~10ns)
-      for (std::size_t i = 0; i < SPINLOCK_FAST_ITERATIONS; ++i)
+      for (int i = 0; i < SPINLOCK_FAST_ITERATIONS; ++i)
       {
         if (try_lock())
         {
           return;
         }
-// Issue a Pause/Yield instruction while spinning.
-#if defined(_MSC_VER)
-        YieldProcessor();
-#elif defined(__i386__) || defined(__x86_64__)
-#  if defined(__clang__)
-        _mm_pause();
-#  else
-        __builtin_ia32_pause();
-#  endif
-#elif defined(__arm__)
-        __asm__ volatile("yield" ::: "memory");
-#else
-        // TODO: Issue PAGE/YIELD on other architectures.
-#endif
+        Pause();
       }
       // Yield then try again (goal ~100ns)
       std::this_thread::yield();
@@ -112,16 +109,81 @@ class SpinLockMutex
       {
         return;
       }
+#if defined(OPENTELEMETRY_SPINLOCK_PARKING_FUTEX) || \
+    defined(OPENTELEMETRY_SPINLOCK_PARKING_WAIT_ON_ADDRESS)
+      // Park until the lock is released. The lock is taken marked as contended, as other threads
+      // may still be parked.
+      while (state_.exchange(kContended, std::memory_order_acquire) != kUnlocked)
+      {
+        Park();
+      }
+      return;
+#else
       // Sleep and then start the whole process again. (goal ~1000ns)
       std::this_thread::sleep_for(std::chrono::milliseconds(SPINLOCK_SLEEP_MS));
+#endif
     }
-    return;
   }
+
   /** Releases the lock held by the execution agent. Throws no exceptions. */
-  void unlock() noexcept { flag_.store(false, std::memory_order_release); }
+  void unlock() noexcept
+  {
+    if (state_.exchange(kUnlocked, std::memory_order_release) == kContended)
+    {
+      Wake();
+    }
+  }
 
 private:
-  std::atomic<bool> flag_{false};
+  static constexpr uint32_t kUnlocked  = 0;
+  static constexpr uint32_t kLocked    = 1;
+  static constexpr uint32_t kContended = 2;
+
+  /** Issues a Pause/Yield instruction while spinning. */
+  static void Pause() noexcept
+  {
+#if defined(_MSC_VER)
+    YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+#  if defined(__clang__)
+    _mm_pause();
+#  else
+    __builtin_ia32_pause();
+#  endif
+#elif defined(__arm__) || defined(__aarch64__)
+    __asm__ volatile("yield" ::: "memory");
+#else
+    // TODO: Issue PAGE/YIELD on other architectures.
+#endif
+  }
+
+  /** Blocks the current thread while the lock is contended, or until it is woken. */
+  void Park() noexcept
+  {
+#if defined(OPENTELEMETRY_SPINLOCK_PARKING_FUTEX)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&state_), FUTEX_WAIT_PRIVATE, kContended,
+            nullptr, nullptr, 0);
+#elif defined(OPENTELEMETRY_SPINLOCK_PARKING_WAIT_ON_ADDRESS)
+    uint32_t contended = kContended;
+    WaitOnAddress(&state_, &contended, sizeof(contended), INFINITE);
+#endif
+  }
+
+  /** Wakes one of the threads parked on the lock. */
+  void Wake() noexcept
+  {
+#if defined(OPENTELEMETRY_SPINLOCK_PARKING_FUTEX)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr,
+            nullptr, 0);
+#elif defined(OPENTELEMETRY_SPINLOCK_PARKING_WAIT_ON_ADDRESS)
+    WakeByAddressSingle(&state_);
+#endif
+  }
+
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "SpinLockMutex parks on the address of its state");
+
+  std::atomic<uint32_t> state_{kUnlocked};
 };
 
 }  // namespace common
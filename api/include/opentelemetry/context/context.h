@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstring>
+#include "opentelemetry/context/context_key.h"
 #include "opentelemetry/context/context_value.h"
 #include "opentelemetry/nostd/shared_ptr.h"
 #include "opentelemetry/nostd/string_view.h"
@@ -15,7 +16,8 @@ namespace context
 // The context class provides a context identifier. Is built as a linked list
 // of DataList nodes and each context holds a shared_ptr to a place within
 // the list that determines which keys and values it has access to. All that
-// come before and none that come after.
+// come before and none that come after. Each node holds a few entries inline,
+// so that the small contexts of a request are one or two nodes long.
 class Context
 {
 
@@ -26,14 +28,32 @@ class Context
   template <class T>
   Context(const T &keys_and_values) noexcept
   {
-    head_ = nostd::shared_ptr<DataList>{new DataList(keys_and_values)};
+    head_ = nostd::shared_ptr<DataList>{new DataList()};
+    DataList *node = head_.get();
+    for (auto &iter : keys_and_values)
+    {
+      if (node->size_ == DataList::kMaxEntries)
+      {
+        node->CopyKeys();
+        node->next_ = nostd::shared_ptr<DataList>{new DataList()};
+        node        = node->next_.get();
+      }
+      nostd::string_view key = iter.first;
+      node->Add(key.data(), key.size(), false, iter.second);
+    }
+    node->CopyKeys();
   }
 
   // Creates a context object from a key and value, this will
   // hold a shared_ptr to the head of the DataList linked list
   Context(nostd::string_view key, ContextValue value) noexcept
   {
-    head_ = nostd::shared_ptr<DataList>{new DataList(key, value)};
+    *this = Context().CreateWithValue(key.data(), key.size(), false, value);
+  }
+
+  Context(const ContextKey &key, ContextValue value) noexcept
+  {
+    *this = Context().CreateWithValue(key.data(), key.size(), true, value);
   }
 
   // Accepts a new iterable and then returns a new context that
@@ -42,11 +62,11 @@ class Context
   template <class T>
   Context SetValues(T &values) noexcept
   {
-    Context context                  = Context(values);
-    nostd::shared_ptr<DataList> last = context.head_;
+    Context context = Context(values);
+    DataList *last  = context.head_.get();
     while (last->next_ != nullptr)
     {
-      last = last->next_;
+      last = last->next_.get();
     }
     last->next_ = head_;
     return context;
@@ -57,25 +77,32 @@ class Context
   // exisiting list to the end of the new list.
   Context SetValue(nostd::string_view key, ContextValue value) noexcept
   {
-    Context context      = Context(key, value);
-    context.head_->next_ = head_;
-    return context;
+    return CreateWithValue(key.data(), key.size(), false, value);
+  }
+
+  Context SetValue(const ContextKey &key, ContextValue value) noexcept
+  {
+    return CreateWithValue(key.data(), key.size(), true, value);
   }
 
   // Returns the value associated with the passed in key.
   context::ContextValue GetValue(const nostd::string_view key) const noexcept
   {
-    for (DataList *data = head_.get(); data != nullptr; data = data->next_.get())
-    {
-      if (key.size() == data->key_length_)
-      {
-        if (std::memcmp(key.data(), data->key_, data->key_length_) == 0)
-        {
-          return data->value_;
-        }
-      }
-    }
-    return ContextValue{};
+    const ContextValue *value = Find(key.data(), key.size());
+    return value == nullptr ? ContextValue{} : *value;
+  }
+
+  context::ContextValue GetValue(const ContextKey &key) const noexcept
+  {
+    const ContextValue *value = Find(key.data(), key.size());
+    return value == nullptr ? ContextValue{} : *value;
+  }
+
+  // Returns the value associated with the passed in key without copying it, or nullptr. The
+  // value lives as long as this context, or any copy of it, does.
+  const ContextValue *FindValue(const ContextKey &key) const noexcept
+  {
+    return Find(key.data(), key.size());
   }
 
   // Checks for key and returns true if found
@@ -84,75 +111,136 @@ class Context
     return !nostd::holds_alternative<nostd::monostate>(GetValue(key));
   }
 
+  bool HasKey(const ContextKey &key) const noexcept
+  {
+    return !nostd::holds_alternative<nostd::monostate>(GetValue(key));
+  }
+
   bool operator==(const Context &other) const noexcept { return (head_ == other.head_); }
 
 private:
-  // A linked list to contain the keys and values of this context node
+  // A node of the linked list, holding up to kMaxEntries keys and values of this context. The
+  // entries of a node are looked up in order, and shadow those of the following nodes.
   class DataList
   {
   public:
-    char *key_;
+    static constexpr size_t kMaxEntries = 4;
+
+    struct Entry
+    {
+      const char *key_   = nullptr;
+      size_t key_length_ = 0;
+      // The key is a ContextKey rather than a copy held by the node.
+      bool interned_ = false;
+      ContextValue value_;
+
+      bool Matches(const char *key, size_t key_length) const noexcept
+      {
+        return key_length == key_length_ &&
+               (key == key_ || key_length == 0 || std::memcmp(key, key_, key_length) == 0);
+      }
+    };
+
+    Entry entries_[kMaxEntries];
+
+    size_t size_ = 0;
 
     nostd::shared_ptr<DataList> next_;
 
-    size_t key_length_;
+    DataList() = default;
 
-    ContextValue value_;
+    DataList(const DataList &)            = delete;
+    DataList &operator=(const DataList &) = delete;
 
-    DataList() { next_ = nullptr; }
+    ~DataList() { delete[] keys_; }
 
-    // Builds a data list off of a key and value iterable and returns the head
-    template <class T>
-    DataList(const T &keys_and_vals) : key_{nullptr}, next_(nostd::shared_ptr<DataList>{nullptr})
+    // Adds an entry after those of the node. Its key is only referred to until CopyKeys().
+    void Add(const char *key, size_t key_length, bool interned, const ContextValue &value)
     {
-      bool first = true;
-      auto *node = this;
-      for (auto &iter : keys_and_vals)
+      Entry &entry      = entries_[size_++];
+      entry.key_        = key;
+      entry.key_length_ = key_length;
+      entry.interned_   = interned;
+      entry.value_      = value;
+    }
+
+    // Copies the keys that are not interned into a single buffer owned by the node, once all
+    // the entries are added.
+    void CopyKeys()
+    {
+      size_t total = 0;
+      for (size_t i = 0; i < size_; i++)
       {
-        if (first)
-        {
-          *node = DataList(iter.first, iter.second);
-          first = false;
-        }
-        else
+        total += entries_[i].interned_ ? 0 : entries_[i].key_length_;
+      }
+      if (total == 0)
+      {
+        return;
+      }
+      keys_      = new char[total];
+      char *next = keys_;
+      for (size_t i = 0; i < size_; i++)
+      {
+        Entry &entry = entries_[i];
+        if (!entry.interned_ && entry.key_length_ > 0)
         {
-          node->next_ = nostd::shared_ptr<DataList>(new DataList(iter.first, iter.second));
-          node        = node->next_.get();
+          std::memcpy(next, entry.key_, entry.key_length_);
+          entry.key_ = next;
+          next += entry.key_length_;
         }
       }
     }
 
-    // Builds a data list with just a key and value, so it will just be the head
-    // and returns that head.
-    DataList(nostd::string_view key, const ContextValue &value)
+  private:
+    char *keys_ = nullptr;
+  };
+
+  // Returns a context holding `key` and `value` in front of the entries of this one.
+  Context CreateWithValue(const char *key,
+                          size_t key_length,
+                          bool interned,
+                          const ContextValue &value) const noexcept
+  {
+    Context context;
+    context.head_  = nostd::shared_ptr<DataList>{new DataList()};
+    DataList &node = *context.head_;
+    node.Add(key, key_length, interned, value);
+    // A head with room left is merged into the new node rather than linked to, so that adding
+    // values one by one does not make lookups walk one node per value.
+    if (head_ != nullptr && head_->size_ < DataList::kMaxEntries)
     {
-      key_        = new char[key.size()];
-      key_length_ = key.size();
-      memcpy(key_, key.data(), key.size() * sizeof(char));
-      value_ = value;
-      next_  = nostd::shared_ptr<DataList>{nullptr};
+      for (size_t i = 0; i < head_->size_; i++)
+      {
+        const DataList::Entry &entry = head_->entries_[i];
+        if (!entry.Matches(key, key_length))
+        {
+          node.Add(entry.key_, entry.key_length_, entry.interned_, entry.value_);
+        }
+      }
+      node.next_ = head_->next_;
     }
-
-    DataList &operator=(DataList &&other) noexcept
+    else
     {
-      key_length_ = other.key_length_;
-      value_      = std::move(other.value_);
-      next_       = std::move(other.next_);
-
-      key_       = other.key_;
-      other.key_ = nullptr;
-
-      return *this;
+      node.next_ = head_;
     }
+    node.CopyKeys();
+    return context;
+  }
 
-    ~DataList()
+  const ContextValue *Find(const char *key, size_t key_length) const noexcept
+  {
+    for (const DataList *data = head_.get(); data != nullptr; data = data->next_.get())
     {
-      if (key_ != nullptr)
+      for (size_t i = 0; i < data->size_; i++)
       {
-        delete[] key_;
+        if (data->entries_[i].Matches(key, key_length))
+        {
+          return &data->entries_[i].value_;
+        }
       }
     }
-  };
+    return nullptr;
+  }
 
   // Head of the list which holds the keys and values of this context
   nostd::shared_ptr<DataList> head_;
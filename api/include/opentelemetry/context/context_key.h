@@ -0,0 +1,35 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace context
+{
+
+/**
+ * A context key whose characters outlive every context using it, typically a string literal.
+ * Contexts refer to such a key instead of copying it, and recognize it by address before
+ * comparing characters, so keys looked up often, such as the active span, are cheap to match.
+ * A ContextKey and a string_view with the same characters designate the same entry.
+ */
+class ContextKey
+{
+public:
+  template <size_t N>
+  explicit constexpr ContextKey(const char (&key)[N]) noexcept : data_(key), size_(N - 1)
+  {}
+
+  constexpr const char *data() const noexcept { return data_; }
+
+  constexpr size_t size() const noexcept { return size_; }
+
+private:
+  const char *data_;
+  size_t size_;
+};
+}  // namespace context
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,108 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "opentelemetry/context/runtime_context.h"
+#include "opentelemetry/nostd/unique_ptr.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace context
+{
+
+/**
+ * A context captured on one thread to be made current on another, e.g. to propagate the active
+ * span into the tasks of a thread pool or an executor.
+ *
+ * Capturing copies the current context. Restoring it with a ContextSnapshot::Scope pushes it on
+ * the context stack of the storage and pops it back off, without the token Attach() creates;
+ * storages which do not support it, see RuntimeContextStorage::Enter(), fall back to Attach().
+ *
+ *   // On the submitting thread.
+ *   pool.Submit(context::WrapWithCurrentContext([] { ... }));
+ */
+class ContextSnapshot
+{
+public:
+  /** Captures the current context. */
+  ContextSnapshot() noexcept : context_(RuntimeContext::GetCurrent()) {}
+
+  explicit ContextSnapshot(Context context) noexcept : context_(std::move(context)) {}
+
+  const Context &GetContext() const noexcept { return context_; }
+
+  /**
+   * Makes the context of a snapshot current for the lifetime of the scope, on the calling
+   * thread. Scopes must be destroyed in the reverse order of their creation.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(const ContextSnapshot &snapshot) noexcept
+    {
+      if (!RuntimeContext::Enter(snapshot.context_, depth_))
+      {
+        token_ = RuntimeContext::Attach(snapshot.context_);
+      }
+    }
+
+    Scope(const Scope &)            = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    ~Scope()
+    {
+      if (token_)
+      {
+        token_.reset();
+        return;
+      }
+      RuntimeContext::Leave(depth_);
+    }
+
+  private:
+    std::size_t depth_ = 0;
+    nostd::unique_ptr<Token> token_;
+  };
+
+private:
+  Context context_;
+};
+
+/**
+ * A callable running a task with the context of a snapshot current, e.g. on the thread of a pool.
+ */
+template <class Task>
+class ContextTask
+{
+public:
+  ContextTask(ContextSnapshot snapshot, Task task)
+      : snapshot_(std::move(snapshot)), task_(std::move(task))
+  {}
+
+  template <class... Args>
+  auto operator()(Args &&...args) -> decltype(std::declval<Task &>()(std::forward<Args>(args)...))
+  {
+    ContextSnapshot::Scope scope(snapshot_);
+    return task_(std::forward<Args>(args)...);
+  }
+
+private:
+  ContextSnapshot snapshot_;
+  Task task_;
+};
+
+/**
+ * Returns a callable running `task` with the current context of the calling thread current.
+ */
+template <class Task>
+ContextTask<typename std::decay<Task>::type> WrapWithCurrentContext(Task &&task)
+{
+  return ContextTask<typename std::decay<Task>::type>(ContextSnapshot(), std::forward<Task>(task));
+}
+
+}  // namespace context
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,125 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/context/runtime_context.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace context
+{
+
+/**
+ * A RuntimeContextStorage keeping the attached contexts per fiber, coroutine or any other unit of
+ * execution that a scheduler runs on a thread, rather than per thread.
+ *
+ * Each unit owns a FiberContextStorage::Stack, e.g. as a member of the fiber object or of the
+ * promise of a coroutine. The scheduler calls Switch() with the stack of the unit it is about to
+ * run, and again with the returned stack once the unit is suspended. Switching is a thread_local
+ * pointer exchange: the contexts themselves are not copied.
+ *
+ * Threads that have not switched to any stack, or have switched back to nullptr, use a stack
+ * of their own, as ThreadLocalContextStorage does.
+ *
+ * With fibers:
+ *
+ *   // Run by the scheduler around each fiber switch.
+ *   auto previous = FiberContextStorage::Switch(&next_fiber->context_stack);
+ *   ... resume next_fiber until it yields ...
+ *   FiberContextStorage::Switch(previous);
+ *
+ * With C++20 coroutines, the awaiter of the scheduler switches to the stack held by the promise
+ * in await_resume(), and switches back before returning from await_suspend() or when the
+ * coroutine completes.
+ */
+class FiberContextStorage : public RuntimeContextStorage
+{
+public:
+  using Stack = ThreadLocalContextStorage::Stack;
+
+  FiberContextStorage() noexcept = default;
+
+  /**
+   * Makes `stack` hold the attached contexts of the calling thread, and returns the stack that
+   * held them until now, or nullptr for the thread's own stack. `stack` must outlive its use:
+   * switch away from it before destroying it.
+   */
+  static Stack *Switch(Stack *stack) noexcept
+  {
+    Stack *&current = CurrentStack();
+    Stack *previous = current;
+    current         = stack;
+    // The active span of the thread is now the one of the resumed unit.
+    if (IsProfilerThreadContextEnabled())
+    {
+      PublishProfilerThreadContext(GetStack().GetActiveSpanContext());
+    }
+    return previous;
+  }
+
+  // Return the current context of the running fiber.
+  Context GetCurrent() noexcept override { return GetStack().Top(); }
+
+  // Resets the context of the running fiber to the value previous to the passed in token. This
+  // will also detach all child contexts of the passed in token.
+  // Returns true if successful, false otherwise, e.g. if the token belongs to another fiber.
+  bool Detach(Token &token) noexcept override { return GetStack().Detach(token); }
+
+  // Sets the current 'Context' object of the running fiber. Returns a token that can be used to
+  // reset to the previous Context.
+  nostd::unique_ptr<Token> Attach(const Context &context) noexcept override
+  {
+    GetStack().Push(context);
+    return CreateToken(context);
+  }
+
+  // Sets the current 'Context' object of the running fiber until the matching call to Leave(),
+  // without a token.
+  bool Enter(const Context &context, std::size_t &depth) noexcept override
+  {
+    Stack &stack = GetStack();
+    depth        = stack.Size();
+    stack.Push(context);
+    return true;
+  }
+
+  // Pops the contexts of the running fiber entered since Enter() returned `depth`.
+  void Leave(std::size_t depth) noexcept override { GetStack().PopTo(depth); }
+
+  // Returns the active span the stack of the running fiber caches for its top context.
+  nostd::shared_ptr<trace::Span> GetActiveSpan() noexcept override
+  {
+    return GetStack().GetActiveSpan();
+  }
+
+  trace::SpanContext GetActiveSpanContext() noexcept override
+  {
+    return GetStack().GetActiveSpanContext();
+  }
+
+  trace::TraceFlags GetActiveTraceFlags() noexcept override
+  {
+    return GetStack().GetActiveSpanContext().trace_flags();
+  }
+
+private:
+  static Stack *&CurrentStack() noexcept
+  {
+    static thread_local Stack *current = nullptr;
+    return current;
+  }
+
+  static Stack &GetStack() noexcept
+  {
+    Stack *current = CurrentStack();
+    if (current != nullptr)
+    {
+      return *current;
+    }
+    static thread_local Stack thread_stack;
+    return thread_stack;
+  }
+};
+
+}  // namespace context
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,125 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "opentelemetry/trace/span_context.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace context
+{
+
+// The version of the ProfilerThreadContext layout, incremented on any change of it.
+constexpr uint8_t kProfilerThreadContextVersion = 1;
+
+/**
+ * The trace and span IDs of the active span of a thread, kept in a thread-local for sampling
+ * profilers to attribute the stacks they sample to spans.
+ *
+ * The layout is fixed, 32 bytes without padding:
+ *
+ *   offset  0  uint8_t  version      kProfilerThreadContextVersion, 0 if never written
+ *   offset  1  uint8_t  valid        1 if the IDs are those of an active span, 0 otherwise
+ *   offset  2  uint8_t  trace_flags  the W3C trace flags of the span
+ *   offset  3  uint8_t  reserved[5]
+ *   offset  8  uint8_t  trace_id[16]
+ *   offset 24  uint8_t  span_id[8]
+ *
+ * On ELF platforms, the block of each thread is the thread-local variable of C linkage
+ * `opentelemetry_profiler_thread_context`, which an out-of-process profiler, e.g. an eBPF program,
+ * finds through the symbol table and the TLS block of the thread. Elsewhere it is only reachable
+ * in-process through GetProfilerThreadContext(), e.g. from a SIGPROF handler.
+ *
+ * The thread clears `valid` before writing the IDs and sets it back after, so that a reader
+ * interrupting the thread, such as a signal handler or a profiler sampling it, never sees the
+ * IDs of two different spans.
+ */
+struct ProfilerThreadContext
+{
+  uint8_t version;
+  uint8_t valid;
+  uint8_t trace_flags;
+  uint8_t reserved[5];
+  uint8_t trace_id[trace::TraceId::kSize];
+  uint8_t span_id[trace::SpanId::kSize];
+};
+
+static_assert(sizeof(ProfilerThreadContext) == 32, "the layout of the block is fixed");
+}  // namespace context
+OPENTELEMETRY_END_NAMESPACE
+
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#  define OPENTELEMETRY_PROFILER_THREAD_CONTEXT_SYMBOL 1
+// A weak definition, merged by the linker into one symbol per module, as the API is header-only.
+extern "C" {
+__attribute__((weak)) thread_local OPENTELEMETRY_NAMESPACE::context::ProfilerThreadContext
+    opentelemetry_profiler_thread_context;
+}
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace context
+{
+
+/**
+ * Returns the ProfilerThreadContext block of the calling thread.
+ */
+inline ProfilerThreadContext &GetProfilerThreadContext() noexcept
+{
+#ifdef OPENTELEMETRY_PROFILER_THREAD_CONTEXT_SYMBOL
+  return opentelemetry_profiler_thread_context;
+#else
+  static thread_local ProfilerThreadContext context;
+  return context;
+#endif
+}
+
+inline std::atomic<bool> &ProfilerThreadContextFlag() noexcept
+{
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+/**
+ * Enables or disables keeping the IDs of the active span in the ProfilerThreadContext of each
+ * thread, disabled by default. Enable it at startup: a thread only writes its block when its
+ * active span changes.
+ */
+inline void SetProfilerThreadContextEnabled(bool enabled) noexcept
+{
+  ProfilerThreadContextFlag().store(enabled, std::memory_order_relaxed);
+}
+
+inline bool IsProfilerThreadContextEnabled() noexcept
+{
+  return ProfilerThreadContextFlag().load(std::memory_order_relaxed);
+}
+
+/**
+ * Writes the IDs of `span_context` in the ProfilerThreadContext of the calling thread, clearing
+ * it if the span context is invalid.
+ */
+inline void PublishProfilerThreadContext(const trace::SpanContext &span_context) noexcept
+{
+  ProfilerThreadContext &block = GetProfilerThreadContext();
+  block.valid                  = 0;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  block.version = kProfilerThreadContextVersion;
+  if (!span_context.IsValid())
+  {
+    return;
+  }
+  block.trace_flags = span_context.trace_flags().flags();
+  std::memcpy(block.trace_id, span_context.trace_id().Id().data(), trace::TraceId::kSize);
+  std::memcpy(block.span_id, span_context.span_id().Id().data(), trace::SpanId::kSize);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  block.valid = 1;
+}
+
+}  // namespace context
+OPENTELEMETRY_END_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include <initializer_list>
 #include <memory>
+#include <string>
 #include <vector>
 #include "opentelemetry/context/propagation/text_map_propagator.h"
 
@@ -19,7 +20,15 @@ class CompositePropagator : public TextMapPropagator
 public:
   CompositePropagator(std::vector<std::unique_ptr<TextMapPropagator>> propagators)
       : propagators_(std::move(propagators))
-  {}
+  {
+    Fields([this](nostd::string_view field) {
+      if (fields_.size() < kMaxBatchedFields)
+      {
+        fields_.emplace_back(field.data(), field.size());
+      }
+      return true;
+    });
+  }
 
   /**
    * Run each of the configured propagators with the given context and carrier.
@@ -46,27 +55,21 @@ class CompositePropagator : public TextMapPropagator
    * propagators write the same context key, the propagator later in the list
    * will "win".
    *
+   * If the carrier supports TextMapCarrier::ForEach(), the fields of all the
+   * propagators are read from it in a single pass beforehand.
+   *
    * @param carrier Carrier from which to extract context
    * @param context Context to add values to
    */
   context::Context Extract(const TextMapCarrier &carrier,
                            context::Context &context) noexcept override
   {
-    auto first = true;
-    context::Context tmp_context;
-    for (auto &p : propagators_)
+    BatchedCarrier batched_carrier(carrier, fields_);
+    if (batched_carrier.Read())
     {
-      if (first)
-      {
-        tmp_context = p->Extract(carrier, context);
-        first       = false;
-      }
-      else
-      {
-        tmp_context = p->Extract(carrier, tmp_context);
-      }
+      return ExtractImpl(batched_carrier, context);
     }
-    return propagators_.size() ? tmp_context : context;
+    return ExtractImpl(carrier, context);
   }
 
   /**
@@ -85,7 +88,110 @@ class CompositePropagator : public TextMapPropagator
   }
 
 private:
+  static constexpr size_t kMaxBatchedFields = 16;
+
+  // A carrier serving the values of the fields of the propagators, read from another carrier in
+  // a single ForEach() pass. Field names are matched ignoring case, as HTTP header names are.
+  // Other keys are looked up in the other carrier.
+  class BatchedCarrier : public TextMapCarrier
+  {
+  public:
+    BatchedCarrier(const TextMapCarrier &carrier, const std::vector<std::string> &fields) noexcept
+        : carrier_(carrier), fields_(fields)
+    {}
+
+    // Reads the fields from the carrier. Returns false if the carrier does not support ForEach().
+    bool Read() noexcept
+    {
+      return carrier_.ForEach([this](nostd::string_view key, nostd::string_view value) {
+        for (size_t i = 0; i < fields_.size(); i++)
+        {
+          if (!found_[i] && EqualsIgnoreCase(key, fields_[i]))
+          {
+            values_[i] = value;
+            found_[i]  = true;
+            break;
+          }
+        }
+        return true;
+      });
+    }
+
+    nostd::string_view Get(nostd::string_view key) const noexcept override
+    {
+      for (size_t i = 0; i < fields_.size(); i++)
+      {
+        if (EqualsIgnoreCase(key, fields_[i]))
+        {
+          return values_[i];
+        }
+      }
+      return carrier_.Get(key);
+    }
+
+    void Set(nostd::string_view /* key */, nostd::string_view /* value */) noexcept override {}
+
+    bool Keys(nostd::function_ref<bool(nostd::string_view)> callback) const noexcept override
+    {
+      return carrier_.Keys(callback);
+    }
+
+    bool ForEach(nostd::function_ref<bool(nostd::string_view, nostd::string_view)> callback)
+        const noexcept override
+    {
+      return carrier_.ForEach(callback);
+    }
+
+  private:
+    static bool EqualsIgnoreCase(nostd::string_view lhs, nostd::string_view rhs) noexcept
+    {
+      if (lhs.size() != rhs.size())
+      {
+        return false;
+      }
+      for (size_t i = 0; i < lhs.size(); i++)
+      {
+        if (ToLower(lhs[i]) != ToLower(rhs[i]))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static char ToLower(char c) noexcept
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    const TextMapCarrier &carrier_;
+    const std::vector<std::string> &fields_;
+    nostd::string_view values_[kMaxBatchedFields];
+    bool found_[kMaxBatchedFields] = {};
+  };
+
+  context::Context ExtractImpl(const TextMapCarrier &carrier, context::Context &context) noexcept
+  {
+    auto first = true;
+    context::Context tmp_context;
+    for (auto &p : propagators_)
+    {
+      if (first)
+      {
+        tmp_context = p->Extract(carrier, context);
+        first       = false;
+      }
+      else
+      {
+        tmp_context = p->Extract(carrier, tmp_context);
+      }
+    }
+    return propagators_.size() ? tmp_context : context;
+  }
+
   std::vector<std::unique_ptr<TextMapPropagator>> propagators_;
+  // Fields of the propagators, read in a single pass by Extract().
+  std::vector<std::string> fields_;
 };
 }  // namespace propagation
 }  // namespace context
@@ -30,6 +30,17 @@ class TextMapCarrier
   {
     return true;
   }
+
+  /* Invokes callback with every key-value pair of the carrier, in a single pass, letting
+   propagators read all their fields at once rather than calling Get() for each of them. The
+   views passed to callback must stay valid as long as the carrier is not modified.
+   Returns false if the carrier does not support it, which it does not by default. */
+  virtual bool ForEach(
+      nostd::function_ref<bool(nostd::string_view, nostd::string_view)> callback) const noexcept
+  {
+    return false;
+  }
+
   virtual ~TextMapCarrier() = default;
 };
 
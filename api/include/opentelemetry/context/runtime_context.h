@@ -4,6 +4,10 @@
 #pragma once
 
 #include "opentelemetry/context/context.h"
+#include "opentelemetry/context/profiler_thread_context.h"
+
+#include <cstddef>
+#include <new>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace context
@@ -19,9 +23,100 @@ class Token
 
   ~Token();
 
+  // A token is created and destroyed for every attached context, e.g. for every active span
+  // Scope. Tokens are therefore recycled through a small per-thread free list rather than
+  // allocated from the heap each time. A token may be freed on another thread than the one that
+  // created it, it then goes to the free list of that thread.
+  static void *operator new(std::size_t size)
+  {
+    FreeList &free_list = GetFreeList();
+    if (size == sizeof(Token) && free_list.head != nullptr)
+    {
+      FreeBlock *block = free_list.head;
+      free_list.head   = block->next;
+      free_list.size--;
+      return block;
+    }
+    return ::operator new(size);
+  }
+
+  static void operator delete(void *ptr) noexcept
+  {
+    if (ptr == nullptr)
+    {
+      return;
+    }
+    FreeList &free_list = GetFreeList();
+    if (free_list.state != FreeList::kAlive || free_list.size >= kMaxFreeTokens)
+    {
+      ::operator delete(ptr);
+      return;
+    }
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next      = free_list.head;
+    free_list.head   = block;
+    free_list.size++;
+  }
+
 private:
   friend class RuntimeContextStorage;
 
+  static constexpr std::size_t kMaxFreeTokens = 16;
+
+  struct FreeBlock
+  {
+    FreeBlock *next;
+  };
+
+  // Trivially destructible, so that it stays usable while the other thread_local objects of the
+  // thread are destroyed, which may free tokens.
+  struct FreeList
+  {
+    enum State
+    {
+      kUnused,
+      kAlive,
+      kDestroyed
+    };
+
+    FreeBlock *head;
+    std::size_t size;
+    State state;
+  };
+
+  // Releases the free list of the thread when the thread exits.
+  struct FreeListOwner
+  {
+    explicit FreeListOwner(FreeList &free_list) noexcept : free_list_(free_list)
+    {
+      free_list_.state = FreeList::kAlive;
+    }
+
+    ~FreeListOwner()
+    {
+      free_list_.state = FreeList::kDestroyed;
+      while (free_list_.head != nullptr)
+      {
+        FreeBlock *block = free_list_.head;
+        free_list_.head  = block->next;
+        ::operator delete(block);
+      }
+      free_list_.size = 0;
+    }
+
+    FreeList &free_list_;
+  };
+
+  static FreeList &GetFreeList() noexcept
+  {
+    static thread_local FreeList free_list = {nullptr, 0, FreeList::kUnused};
+    if (free_list.state == FreeList::kUnused)
+    {
+      static thread_local FreeListOwner owner(free_list);
+    }
+    return free_list;
+  }
+
   // A constructor that sets the token's Context object to the
   // one that was passed in.
   Token(const Context &context) : context_(context) {}
@@ -59,6 +154,57 @@ class RuntimeContextStorage
    */
   virtual bool Detach(Token &token) noexcept = 0;
 
+  /**
+   * Set the current context without creating a token, until the matching call to Leave(). The
+   * contexts entered must be left in the reverse order, on the thread that entered them.
+   * Storages which do not support it return false: the caller then uses Attach().
+   * @param context the new current context
+   * @param depth set to the value to pass to Leave()
+   * @return true if the context was entered
+   */
+  virtual bool Enter(const Context & /* context */, std::size_t & /* depth */) noexcept
+  {
+    return false;
+  }
+
+  /**
+   * Reset the context to the one current before the Enter() call which returned `depth`.
+   */
+  virtual void Leave(std::size_t /* depth */) noexcept {}
+
+  /**
+   * Return the active span of the current context, or a null pointer if it has none. Storages
+   * may override it to look the span up without copying the current context, e.g. from a cache.
+   */
+  virtual nostd::shared_ptr<trace::Span> GetActiveSpan() noexcept
+  {
+    ContextValue span = GetCurrent().GetValue(trace::GetSpanContextKey());
+    if (nostd::holds_alternative<nostd::shared_ptr<trace::Span>>(span))
+    {
+      return nostd::get<nostd::shared_ptr<trace::Span>>(span);
+    }
+    return nostd::shared_ptr<trace::Span>();
+  }
+
+  /**
+   * Return the span context of the active span of the current context, or an invalid one if it
+   * has none.
+   */
+  virtual trace::SpanContext GetActiveSpanContext() noexcept
+  {
+    nostd::shared_ptr<trace::Span> span = GetActiveSpan();
+    return span ? span->GetContext() : trace::SpanContext::GetInvalid();
+  }
+
+  /**
+   * Return the trace flags of the active span of the current context, empty if it has none. It
+   * tells whether the active span is sampled, without copying its span context.
+   */
+  virtual trace::TraceFlags GetActiveTraceFlags() noexcept
+  {
+    return GetActiveSpanContext().trace_flags();
+  }
+
   virtual ~RuntimeContextStorage(){};
 
 protected:
@@ -94,6 +240,36 @@ class RuntimeContext
   // passed in token. Returns true if successful, false otherwise
   static bool Detach(Token &token) noexcept { return GetRuntimeContextStorage()->Detach(token); }
 
+  // Sets the current 'Context' object without creating a token, see
+  // RuntimeContextStorage::Enter(). Returns false if the storage does not support it.
+  static bool Enter(const Context &context, std::size_t &depth) noexcept
+  {
+    // Not GetRuntimeContextStorage(): no copy of the shared pointer.
+    return GetStorage()->Enter(context, depth);
+  }
+
+  // Resets the context to the one current before the matching call to Enter().
+  static void Leave(std::size_t depth) noexcept { GetStorage()->Leave(depth); }
+
+  // Returns the active span of the current context, or a null pointer if it has none, see
+  // RuntimeContextStorage::GetActiveSpan().
+  static nostd::shared_ptr<trace::Span> GetActiveSpan() noexcept
+  {
+    return GetStorage()->GetActiveSpan();
+  }
+
+  // Returns the span context of the active span, or an invalid one if there is none.
+  static trace::SpanContext GetActiveSpanContext() noexcept
+  {
+    return GetStorage()->GetActiveSpanContext();
+  }
+
+  // Returns the trace flags of the active span, empty if there is none.
+  static trace::TraceFlags GetActiveTraceFlags() noexcept
+  {
+    return GetStorage()->GetActiveTraceFlags();
+  }
+
   // Sets the Key and Value into the passed in context or if a context is not
   // passed in, the RuntimeContext.
   // Should be used to SetValues to the current RuntimeContext, is essentially
@@ -104,16 +280,14 @@ class RuntimeContext
                           const ContextValue &value,
                           Context *context = nullptr) noexcept
   {
-    Context temp_context;
-    if (context == nullptr)
-    {
-      temp_context = GetCurrent();
-    }
-    else
-    {
-      temp_context = *context;
-    }
-    return temp_context.SetValue(key, value);
+    return (context == nullptr ? GetCurrent() : *context).SetValue(key, value);
+  }
+
+  static Context SetValue(const ContextKey &key,
+                          const ContextValue &value,
+                          Context *context = nullptr) noexcept
+  {
+    return (context == nullptr ? GetCurrent() : *context).SetValue(key, value);
   }
 
   // Returns the value associated with the passed in key and either the
@@ -122,16 +296,12 @@ class RuntimeContext
   // essentially equivalent to RuntimeContext::GetCurrent().GetValue(key).
   static ContextValue GetValue(nostd::string_view key, Context *context = nullptr) noexcept
   {
-    Context temp_context;
-    if (context == nullptr)
-    {
-      temp_context = GetCurrent();
-    }
-    else
-    {
-      temp_context = *context;
-    }
-    return temp_context.GetValue(key);
+    return (context == nullptr ? GetCurrent() : *context).GetValue(key);
+  }
+
+  static ContextValue GetValue(const ContextKey &key, Context *context = nullptr) noexcept
+  {
+    return (context == nullptr ? GetCurrent() : *context).GetValue(key);
   }
 
   /**
@@ -193,46 +363,137 @@ class ThreadLocalContextStorage : public RuntimeContextStorage
   // Resets the context to the value previous to the passed in token. This will
   // also detach all child contexts of the passed in token.
   // Returns true if successful, false otherwise.
-  bool Detach(Token &token) noexcept override
+  bool Detach(Token &token) noexcept override { return GetStack().Detach(token); }
+
+  // Sets the current 'Context' object. Returns a token
+  // that can be used to reset to the previous Context.
+  nostd::unique_ptr<Token> Attach(const Context &context) noexcept override
+  {
+    GetStack().Push(context);
+    return CreateToken(context);
+  }
+
+  // Sets the current 'Context' object until the matching call to Leave(), without a token.
+  bool Enter(const Context &context, std::size_t &depth) noexcept override
+  {
+    Stack &stack = GetStack();
+    depth        = stack.Size();
+    stack.Push(context);
+    return true;
+  }
+
+  // Pops the contexts entered since Enter() returned `depth`.
+  void Leave(std::size_t depth) noexcept override { GetStack().PopTo(depth); }
+
+  // Returns the active span the stack caches for its top context.
+  nostd::shared_ptr<trace::Span> GetActiveSpan() noexcept override
+  {
+    return GetStack().GetActiveSpan();
+  }
+
+  trace::SpanContext GetActiveSpanContext() noexcept override
+  {
+    return GetStack().GetActiveSpanContext();
+  }
+
+  trace::TraceFlags GetActiveTraceFlags() noexcept override
   {
-    // In most cases, the context to be detached is on the top of the stack.
-    if (token == GetStack().Top())
+    return GetStack().GetActiveSpanContext().trace_flags();
+  }
+
+  // A nested class to store the attached contexts in a stack. Other storages
+  // may keep several of them per thread, e.g. one per fiber.
+  class Stack
+  {
+  public:
+    Stack() noexcept
+        : size_(0),
+          capacity_(0),
+          base_(nullptr),
+          active_span_context_(trace::SpanContext::GetInvalid()){};
+
+    Stack(const Stack &)            = delete;
+    Stack &operator=(const Stack &) = delete;
+
+    // Returns the Context at the top of the stack.
+    Context Top() const noexcept
     {
-      GetStack().Pop();
-      return true;
+      if (size_ == 0)
+      {
+        return Context();
+      }
+      return base_[size_ - 1];
     }
 
-    if (!GetStack().Contains(token))
+    // Pushes the passed in context pointer to the top of the stack
+    // and resizes if necessary.
+    void Push(const Context &context) noexcept
     {
-      return false;
+      size_++;
+      if (size_ > capacity_)
+      {
+        Resize(size_ * 2);
+      }
+      base_[size_ - 1] = context;
+      UpdateActiveSpan();
     }
 
-    while (!(token == GetStack().Top()))
+    // Pops the context of the token, and the contexts above it, off the
+    // stack.
+    // Returns true if successful, false if the context is not on the stack.
+    bool Detach(const Token &token) noexcept
     {
-      GetStack().Pop();
+      // In most cases, the context to be detached is on the top of the stack.
+      if (IsTop(token))
+      {
+        Pop();
+        UpdateActiveSpan();
+        return true;
+      }
+
+      if (!Contains(token))
+      {
+        return false;
+      }
+
+      while (!IsTop(token))
+      {
+        Pop();
+      }
+
+      Pop();
+      UpdateActiveSpan();
+
+      return true;
     }
 
-    GetStack().Pop();
+    // Returns the number of contexts on the stack.
+    size_t Size() const noexcept { return size_; }
 
-    return true;
-  }
+    // Pops contexts off the stack until `size` are left.
+    void PopTo(size_t size) noexcept
+    {
+      while (size_ > size)
+      {
+        Pop();
+      }
+      UpdateActiveSpan();
+    }
 
-  // Sets the current 'Context' object. Returns a token
-  // that can be used to reset to the previous Context.
-  nostd::unique_ptr<Token> Attach(const Context &context) noexcept override
-  {
-    GetStack().Push(context);
-    return CreateToken(context);
-  }
+    // Returns the active span of the top context, or a null pointer if it has none. The stack
+    // keeps it up to date as contexts are pushed and popped, so that looking it up, e.g. for
+    // every span started or log record emitted, does not walk the entries of the context.
+    const nostd::shared_ptr<trace::Span> &GetActiveSpan() const noexcept { return active_span_; }
 
-private:
-  // A nested class to store the attached contexts in a stack.
-  class Stack
-  {
-    friend class ThreadLocalContextStorage;
+    // Returns the span context of the active span, or an invalid one if there is none.
+    const trace::SpanContext &GetActiveSpanContext() const noexcept
+    {
+      return active_span_context_;
+    }
 
-    Stack() noexcept : size_(0), capacity_(0), base_(nullptr){};
+    ~Stack() noexcept { delete[] base_; }
 
+  private:
     // Pops the top Context off the stack.
     void Pop() noexcept
     {
@@ -248,6 +509,34 @@ class ThreadLocalContextStorage : public RuntimeContextStorage
       size_ -= 1;
     }
 
+    // Caches the active span of the top context, and its span context when the span changes.
+    void UpdateActiveSpan() noexcept
+    {
+      const nostd::shared_ptr<trace::Span> *span = nullptr;
+      if (size_ > 0)
+      {
+        const ContextValue *value = base_[size_ - 1].FindValue(trace::GetSpanContextKey());
+        if (value != nullptr)
+        {
+          span = nostd::get_if<nostd::shared_ptr<trace::Span>>(value);
+        }
+      }
+      // Contexts usually stack several scopes of the same span, e.g. with baggage added: the
+      // span context is only fetched again when the span changes.
+      trace::Span *current = span == nullptr ? nullptr : span->get();
+      if (current == active_span_.get())
+      {
+        return;
+      }
+      active_span_context_ =
+          current == nullptr ? trace::SpanContext::GetInvalid() : current->GetContext();
+      active_span_ = current == nullptr ? nostd::shared_ptr<trace::Span>() : *span;
+      if (IsProfilerThreadContextEnabled())
+      {
+        PublishProfilerThreadContext(active_span_context_);
+      }
+    }
+
     bool Contains(const Token &token) const noexcept
     {
       for (size_t pos = size_; pos > 0; --pos)
@@ -261,26 +550,15 @@ class ThreadLocalContextStorage : public RuntimeContextStorage
       return false;
     }
 
-    // Returns the Context at the top of the stack.
-    Context Top() const noexcept
+    // Returns true if the token is associated with the Context at the top of the stack, without
+    // copying that Context.
+    bool IsTop(const Token &token) const noexcept
     {
       if (size_ == 0)
       {
-        return Context();
-      }
-      return base_[size_ - 1];
-    }
-
-    // Pushes the passed in context pointer to the top of the stack
-    // and resizes if necessary.
-    void Push(const Context &context) noexcept
-    {
-      size_++;
-      if (size_ > capacity_)
-      {
-        Resize(size_ * 2);
+        return token == Context();
       }
-      base_[size_ - 1] = context;
+      return token == base_[size_ - 1];
     }
 
     // Reallocates the storage array to the pass in new capacity size.
@@ -308,16 +586,17 @@ class ThreadLocalContextStorage : public RuntimeContextStorage
       capacity_ = new_capacity;
     }
 
-    ~Stack() noexcept { delete[] base_; }
-
     size_t size_;
     size_t capacity_;
     Context *base_;
+    nostd::shared_ptr<trace::Span> active_span_;
+    trace::SpanContext active_span_context_;
   };
 
+private:
   Stack &GetStack()
   {
-    static thread_local Stack stack_ = Stack();
+    static thread_local Stack stack_;
     return stack_;
   }
 };
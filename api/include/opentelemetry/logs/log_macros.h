@@ -0,0 +1,117 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/logs/logger.h"
+#  include "opentelemetry/logs/severity.h"
+#  include "opentelemetry/version.h"
+
+/**
+ * Macros writing a log through a Logger, whose arguments are only evaluated when the log is
+ * recorded:
+ *
+ *   OTEL_LOG_DEBUG(logger, "cache miss", {{"key", key}});
+ *
+ * expands to logger->Log(Severity::kDebug, "cache miss", {{"key", key}}), called only if
+ * logger->Enabled(Severity::kDebug) returns true.
+ *
+ * The logs less severe than OTEL_LOG_MIN_SEVERITY are compiled out: OTEL_LOG_<LEVEL> expands to
+ * nothing below it, and OTEL_LOG is a constant false condition the compiler removes. Define
+ * OTEL_LOG_MIN_SEVERITY to one of the OTEL_LOG_SEVERITY_* values before including this header, e.g.
+ * -DOTEL_LOG_MIN_SEVERITY=OTEL_LOG_SEVERITY_INFO for release builds; all logs are kept by default.
+ */
+
+// The severity numbers of the first Severity of each level
+#  define OTEL_LOG_SEVERITY_TRACE 1
+#  define OTEL_LOG_SEVERITY_DEBUG 5
+#  define OTEL_LOG_SEVERITY_INFO 9
+#  define OTEL_LOG_SEVERITY_WARN 13
+#  define OTEL_LOG_SEVERITY_ERROR 17
+#  define OTEL_LOG_SEVERITY_FATAL 21
+// Compiles out all the logs
+#  define OTEL_LOG_SEVERITY_OFF 25
+
+#  ifndef OTEL_LOG_MIN_SEVERITY
+#    define OTEL_LOG_MIN_SEVERITY OTEL_LOG_SEVERITY_TRACE
+#  endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace logs
+{
+/**
+ * Returns whether the logs of the given severity are compiled in, see OTEL_LOG_MIN_SEVERITY.
+ */
+constexpr bool IsSeverityCompiledIn(Severity severity) noexcept
+{
+  return static_cast<int>(severity) >= OTEL_LOG_MIN_SEVERITY;
+}
+}  // namespace logs
+OPENTELEMETRY_END_NAMESPACE
+
+/**
+ * Logs with the given severity, a Severity value, and the arguments of one of the Logger::Log
+ * overloads following it. logger is a pointer or smart pointer to a Logger, evaluated once.
+ */
+#  define OTEL_LOG(logger, severity, ...)                                              \
+    do                                                                                 \
+    {                                                                                  \
+      if (opentelemetry::logs::IsSeverityCompiledIn(severity))                         \
+      {                                                                                \
+        auto &&otel_log_logger = (logger);                                             \
+        if (otel_log_logger->Enabled(severity))                                        \
+        {                                                                              \
+          otel_log_logger->Log(severity, __VA_ARGS__);                                 \
+        }                                                                              \
+      }                                                                                \
+    } while (false)
+
+#  define OTEL_LOG_DISABLED(logger, ...) \
+    do                                   \
+    {                                    \
+    } while (false)
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_TRACE
+#    define OTEL_LOG_TRACE(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kTrace, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_TRACE(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_DEBUG
+#    define OTEL_LOG_DEBUG(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kDebug, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_DEBUG(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_INFO
+#    define OTEL_LOG_INFO(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kInfo, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_INFO(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_WARN
+#    define OTEL_LOG_WARN(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kWarn, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_WARN(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_ERROR
+#    define OTEL_LOG_ERROR(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kError, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_ERROR(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#  if OTEL_LOG_MIN_SEVERITY <= OTEL_LOG_SEVERITY_FATAL
+#    define OTEL_LOG_FATAL(logger, ...) \
+      OTEL_LOG(logger, opentelemetry::logs::Severity::kFatal, __VA_ARGS__)
+#  else
+#    define OTEL_LOG_FATAL(logger, ...) OTEL_LOG_DISABLED(logger, __VA_ARGS__)
+#  endif
+
+#endif
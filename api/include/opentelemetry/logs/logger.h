@@ -18,6 +18,7 @@
 #  include "opentelemetry/nostd/span.h"
 #  include "opentelemetry/nostd/string_view.h"
 #  include "opentelemetry/nostd/type_traits.h"
+#  include "opentelemetry/nostd/utility.h"
 #  include "opentelemetry/trace/span_id.h"
 #  include "opentelemetry/trace/trace_flags.h"
 #  include "opentelemetry/trace/trace_id.h"
@@ -37,6 +38,14 @@ class Logger
   /* Returns the name of the logger */
   virtual const nostd::string_view GetName() noexcept = 0;
 
+  /**
+   * Returns whether a log event of the given severity would be recorded. Callers can check it
+   * before formatting the body or building the attributes of an expensive log event, which Log
+   * would drop anyway.
+   * @param severity the severity level of the log event.
+   */
+  virtual bool Enabled(Severity /* severity */) const noexcept { return true; }
+
   /**
    * Each of the following overloaded Log(...) methods
    * creates a log message with the specific parameters passed.
@@ -251,6 +260,51 @@ class Logger
     this->Log(severity, message, attributes, {}, {}, {}, std::chrono::system_clock::now());
   }
 
+  /** Message templates **/
+
+  /**
+   * The maximum number of arguments of a message template.
+   */
+  static constexpr size_t kMaxLogTemplateArguments = 10;
+
+  /**
+   * Returns the key of the attribute holding the argument of a message template at index, one of
+   * "log.template.arg.0" to "log.template.arg.9".
+   */
+  static nostd::string_view GetLogTemplateArgumentKey(size_t index) noexcept
+  {
+    static const char *const kKeys[kMaxLogTemplateArguments] = {
+        "log.template.arg.0", "log.template.arg.1", "log.template.arg.2", "log.template.arg.3",
+        "log.template.arg.4", "log.template.arg.5", "log.template.arg.6", "log.template.arg.7",
+        "log.template.arg.8", "log.template.arg.9"};
+    return kKeys[index];
+  }
+
+  /**
+   * Writes a log made of a message template, such as "Request {} took {} ms", and of the
+   * arguments of its {} placeholders, without formatting the message: the template is the body of
+   * the log, and the arguments are its attributes, whose keys are given by
+   * GetLogTemplateArgumentKey. The exporters format the message, or leave it to the backends which
+   * index the templates. Nothing is done if the severity is not enabled.
+   * @param severity The severity of the log
+   * @param message_template The message, with a {} placeholder for each argument
+   * @param args At most kMaxLogTemplateArguments arguments, each of a type an attribute value can
+   * be made of
+   */
+  template <class... Args>
+  void LogTemplate(Severity severity,
+                   nostd::string_view message_template,
+                   const Args &... args) noexcept
+  {
+    static_assert(sizeof...(Args) <= kMaxLogTemplateArguments, "too many template arguments");
+    if (!Enabled(severity))
+    {
+      return;
+    }
+    LogTemplateArguments(severity, message_template, nostd::index_sequence_for<Args...>{},
+                         args...);
+  }
+
   /** Trace severity overloads **/
 
   /**
@@ -634,6 +688,22 @@ class Logger
   {
     this->Log(Severity::kFatal, message, attributes);
   }
+
+private:
+  template <class... Args, size_t... Indexes>
+  void LogTemplateArguments(Severity severity,
+                            nostd::string_view message_template,
+                            nostd::index_sequence<Indexes...>,
+                            const Args &... args) noexcept
+  {
+    // One more element than the arguments, so that the array is never empty.
+    std::pair<nostd::string_view, common::AttributeValue> attributes[] = {
+        {GetLogTemplateArgumentKey(Indexes), common::AttributeValue(args)}..., {}};
+    this->Log(severity, message_template,
+              nostd::span<const std::pair<nostd::string_view, common::AttributeValue>>{
+                  attributes, sizeof...(Args)},
+              {}, {}, {}, std::chrono::system_clock::now());
+  }
 };
 }  // namespace logs
 OPENTELEMETRY_END_NAMESPACE
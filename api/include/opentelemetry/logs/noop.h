@@ -41,6 +41,8 @@ class NoopLogger final : public Logger
 public:
   const nostd::string_view GetName() noexcept override { return "noop logger"; }
 
+  bool Enabled(Severity /* severity */) const noexcept override { return false; }
+
   void Log(Severity severity,
            nostd::string_view body,
            const common::KeyValueIterable &attributes,
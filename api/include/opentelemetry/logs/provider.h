@@ -4,9 +4,9 @@
 #pragma once
 #ifdef ENABLE_LOGS_PREVIEW
 
-#  include <mutex>
+#  include <utility>
 
-#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/common/read_mostly_shared_ptr.h"
 #  include "opentelemetry/logs/logger_provider.h"
 #  include "opentelemetry/logs/noop.h"
 #  include "opentelemetry/nostd/shared_ptr.h"
@@ -28,8 +28,7 @@ class Provider
    */
   static nostd::shared_ptr<LoggerProvider> GetLoggerProvider() noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    return nostd::shared_ptr<LoggerProvider>(GetProvider());
+    return GetProvider().Load();
   }
 
   /**
@@ -37,22 +36,16 @@ class Provider
    */
   static void SetLoggerProvider(nostd::shared_ptr<LoggerProvider> tp) noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    GetProvider() = tp;
+    GetProvider().Store(std::move(tp));
   }
 
 private:
-  static nostd::shared_ptr<LoggerProvider> &GetProvider() noexcept
+  static common::ReadMostlySharedPtr<LoggerProvider> &GetProvider() noexcept
   {
-    static nostd::shared_ptr<LoggerProvider> provider(new NoopLoggerProvider);
+    static common::ReadMostlySharedPtr<LoggerProvider> provider(
+        nostd::shared_ptr<LoggerProvider>(new NoopLoggerProvider));
     return provider;
   }
-
-  static common::SpinLockMutex &GetLock() noexcept
-  {
-    static common::SpinLockMutex lock;
-    return lock;
-  }
 };
 
 }  // namespace logs
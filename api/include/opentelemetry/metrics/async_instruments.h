@@ -5,6 +5,7 @@
 #ifndef ENABLE_METRICS_PREVIEW
 
 #  include "opentelemetry/metrics/observer_result.h"
+#  include "opentelemetry/nostd/string_view.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace metrics
@@ -24,6 +25,40 @@ template <class T>
 class ObservableUpDownCounter : public AsynchronousInstrument
 {};
 
+/**
+ * An observable instrument observed by a batch callback, see
+ * Meter::CreateBatchObservableInstruments.
+ */
+struct BatchObservableInstrument
+{
+  enum class Kind
+  {
+    kCounter,
+    kUpDownCounter,
+    kGauge
+  };
+
+  enum class ValueType
+  {
+    kLong,
+    kDouble
+  };
+
+  BatchObservableInstrument(Kind kind,
+                            ValueType value_type,
+                            nostd::string_view name,
+                            nostd::string_view description = "",
+                            nostd::string_view unit        = "") noexcept
+      : kind(kind), value_type(value_type), name(name), description(description), unit(unit)
+  {}
+
+  Kind kind;
+  ValueType value_type;
+  nostd::string_view name;
+  nostd::string_view description;
+  nostd::string_view unit;
+};
+
 }  // namespace metrics
 OPENTELEMETRY_END_NAMESPACE
 #endif
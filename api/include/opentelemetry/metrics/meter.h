@@ -149,6 +149,73 @@ class Meter
                                                    nostd::string_view description = "",
                                                    nostd::string_view unit        = "",
                                                    void *state = nullptr) noexcept = 0;
+
+  /**
+   * Creates several observable instruments observed by a single callback, which runs once per
+   * collection for all of them. It suits instruments read from a common source, such as the
+   * gauges of a connection pool statistics snapshot, which is then read once instead of once per
+   * instrument.
+   *
+   * @param instruments the instruments to create.
+   * @param callback the function observing the instruments. It reports the observations of
+   * instruments[i] to BatchObserverResult::GetLongResult(i) or GetDoubleResult(i), depending on
+   * the value type of the instrument.
+   * @param state to be passed back to callback
+   */
+  virtual void CreateBatchObservableInstruments(
+      nostd::span<const BatchObservableInstrument> instruments,
+      void (*callback)(BatchObserverResult &, void *),
+      void *state = nullptr) noexcept = 0;
+
+  void CreateBatchObservableInstruments(
+      std::initializer_list<BatchObservableInstrument> instruments,
+      void (*callback)(BatchObserverResult &, void *),
+      void *state = nullptr) noexcept
+  {
+    this->CreateBatchObservableInstruments(
+        nostd::span<const BatchObservableInstrument>{instruments.begin(), instruments.end()},
+        callback, state);
+  }
+
+  /**
+   * Records the values of several synchronous instruments of this meter with the same set of
+   * attributes, such as the count, duration and sizes of a request. The SDK then processes the
+   * attributes once for all the values, instead of once per instrument.
+   *
+   * @param attributes the set of attributes of all the values, as key-value pairs.
+   * @param measurements the values, of instruments created by this meter.
+   * @param context the context of the values.
+   */
+  virtual void RecordBatch(const common::KeyValueIterable &attributes,
+                           nostd::span<const SyncMeasurement> measurements,
+                           const opentelemetry::context::Context &context) noexcept
+  {
+    for (auto &measurement : measurements)
+    {
+      measurement.Record(attributes, context);
+    }
+  }
+
+  template <class U,
+            nostd::enable_if_t<common::detail::is_key_value_iterable<U>::value> * = nullptr>
+  void RecordBatch(
+      const U &attributes,
+      nostd::span<const SyncMeasurement> measurements,
+      const opentelemetry::context::Context &context = opentelemetry::context::Context{}) noexcept
+  {
+    this->RecordBatch(common::KeyValueIterableView<U>{attributes}, measurements, context);
+  }
+
+  void RecordBatch(
+      std::initializer_list<std::pair<nostd::string_view, common::AttributeValue>> attributes,
+      std::initializer_list<SyncMeasurement> measurements,
+      const opentelemetry::context::Context &context = opentelemetry::context::Context{}) noexcept
+  {
+    this->RecordBatch(nostd::span<const std::pair<nostd::string_view, common::AttributeValue>>{
+                          attributes.begin(), attributes.end()},
+                      nostd::span<const SyncMeasurement>{measurements.begin(), measurements.end()},
+                      context);
+  }
 };
 }  // namespace metrics
 OPENTELEMETRY_END_NAMESPACE
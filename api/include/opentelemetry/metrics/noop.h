@@ -15,6 +15,21 @@ OPENTELEMETRY_BEGIN_NAMESPACE
 namespace metrics
 {
 
+template <class T>
+class NoopBoundCounter : public BoundCounter<T>
+{
+public:
+  void Add(T value) noexcept override {}
+  void Add(T value, const opentelemetry::context::Context &context) noexcept override {}
+};
+
+template <class T>
+class NoopBoundHistogram : public BoundHistogram<T>
+{
+public:
+  void Record(T value, const opentelemetry::context::Context &context) noexcept override {}
+};
+
 template <class T>
 class NoopCounter : public Counter<T>
 {
@@ -30,6 +45,11 @@ class NoopCounter : public Counter<T>
            const common::KeyValueIterable &attributes,
            const opentelemetry::context::Context &context) noexcept override
   {}
+  nostd::shared_ptr<BoundCounter<T>> Bind(
+      const common::KeyValueIterable &attributes) noexcept override
+  {
+    return nostd::shared_ptr<BoundCounter<T>>{new NoopBoundCounter<T>()};
+  }
 };
 
 template <class T>
@@ -45,6 +65,11 @@ class NoopHistogram : public Histogram<T>
               const common::KeyValueIterable &attributes,
               const opentelemetry::context::Context &context) noexcept override
   {}
+  nostd::shared_ptr<BoundHistogram<T>> Bind(
+      const common::KeyValueIterable &attributes) noexcept override
+  {
+    return nostd::shared_ptr<BoundHistogram<T>>{new NoopBoundHistogram<T>()};
+  }
 };
 
 template <class T>
@@ -212,6 +237,11 @@ class NoopMeter final : public Meter
                                            nostd::string_view unit        = "",
                                            void *state = nullptr) noexcept override
   {}
+
+  void CreateBatchObservableInstruments(nostd::span<const BatchObservableInstrument> instruments,
+                                        void (*callback)(BatchObserverResult &, void *),
+                                        void *state = nullptr) noexcept override
+  {}
 };
 
 /**
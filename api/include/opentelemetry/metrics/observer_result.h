@@ -44,6 +44,29 @@ class ObserverResult
   }
 };
 
+/**
+ * The results of the instruments observed by one batch callback, see
+ * Meter::CreateBatchObservableInstruments.
+ */
+class BatchObserverResult
+{
+public:
+  /**
+   * @return the result of the instrument at `index` in the instruments of the callback, if it
+   * observes long values. Observations reported for an instrument of the other value type, or for
+   * an index out of range, are dropped.
+   */
+  virtual ObserverResult<long> &GetLongResult(size_t index) noexcept = 0;
+
+  /**
+   * @return the result of the instrument at `index` in the instruments of the callback, if it
+   * observes double values, see GetLongResult.
+   */
+  virtual ObserverResult<double> &GetDoubleResult(size_t index) noexcept = 0;
+
+  virtual ~BatchObserverResult() = default;
+};
+
 }  // namespace metrics
 OPENTELEMETRY_END_NAMESPACE
 #endif
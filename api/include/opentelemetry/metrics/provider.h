@@ -4,9 +4,9 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 
-#  include <mutex>
+#  include <utility>
 
-#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/common/read_mostly_shared_ptr.h"
 #  include "opentelemetry/metrics/meter_provider.h"
 #  include "opentelemetry/metrics/noop.h"
 #  include "opentelemetry/nostd/shared_ptr.h"
@@ -28,8 +28,7 @@ class Provider
    */
   static nostd::shared_ptr<MeterProvider> GetMeterProvider() noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    return nostd::shared_ptr<MeterProvider>(GetProvider());
+    return GetProvider().Load();
   }
 
   /**
@@ -37,22 +36,16 @@ class Provider
    */
   static void SetMeterProvider(nostd::shared_ptr<MeterProvider> tp) noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    GetProvider() = tp;
+    GetProvider().Store(std::move(tp));
   }
 
 private:
-  static nostd::shared_ptr<MeterProvider> &GetProvider() noexcept
+  static common::ReadMostlySharedPtr<MeterProvider> &GetProvider() noexcept
   {
-    static nostd::shared_ptr<MeterProvider> provider(new NoopMeterProvider);
+    static common::ReadMostlySharedPtr<MeterProvider> provider(
+        nostd::shared_ptr<MeterProvider>(new NoopMeterProvider));
     return provider;
   }
-
-  static common::SpinLockMutex &GetLock() noexcept
-  {
-    static common::SpinLockMutex lock;
-    return lock;
-  }
 };
 
 }  // namespace metrics
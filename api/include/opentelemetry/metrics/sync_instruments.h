@@ -7,6 +7,7 @@
 #  include "opentelemetry/common/attribute_value.h"
 #  include "opentelemetry/common/key_value_iterable_view.h"
 #  include "opentelemetry/context/context.h"
+#  include "opentelemetry/nostd/shared_ptr.h"
 #  include "opentelemetry/nostd/span.h"
 #  include "opentelemetry/nostd/string_view.h"
 #  include "opentelemetry/nostd/type_traits.h"
@@ -18,6 +19,42 @@ namespace metrics
 class SynchronousInstrument
 {};
 
+/**
+ * A Counter bound to a fixed set of attributes, see Counter::Bind.
+ */
+template <class T>
+class BoundCounter
+{
+public:
+  /**
+   * Add adds the value to the counter's sum for the bound attributes.
+   *
+   * @param value The increment amount. MUST be non-negative.
+   */
+  virtual void Add(T value) noexcept = 0;
+
+  virtual void Add(T value, const opentelemetry::context::Context &context) noexcept = 0;
+
+  virtual ~BoundCounter() = default;
+};
+
+/**
+ * A Histogram bound to a fixed set of attributes, see Histogram::Bind.
+ */
+template <class T>
+class BoundHistogram
+{
+public:
+  /**
+   * Records a value for the bound attributes.
+   *
+   * @param value The increment amount. May be positive, negative or zero.
+   */
+  virtual void Record(T value, const opentelemetry::context::Context &context) noexcept = 0;
+
+  virtual ~BoundHistogram() = default;
+};
+
 template <class T>
 class Counter : public SynchronousInstrument
 {
@@ -82,6 +119,33 @@ class Counter : public SynchronousInstrument
                   attributes.begin(), attributes.end()},
               context);
   }
+
+  /**
+   * Bind resolves a set of attributes once and returns a handle that adds to the counter's sum
+   * for those attributes. Recording through the handle skips the per-call attribute processing
+   * and lookup, which makes it the cheapest way to record the same attributes repeatedly. The
+   * handle stays valid for as long as it is held, including across metric collections.
+   *
+   * @param attributes the set of attributes, as key-value pairs. They are copied as needed; the
+   * caller does not need to keep them alive.
+   */
+  virtual nostd::shared_ptr<BoundCounter<T>> Bind(
+      const common::KeyValueIterable &attributes) noexcept = 0;
+
+  template <class U,
+            nostd::enable_if_t<common::detail::is_key_value_iterable<U>::value> * = nullptr>
+  nostd::shared_ptr<BoundCounter<T>> Bind(const U &attributes) noexcept
+  {
+    return this->Bind(common::KeyValueIterableView<U>{attributes});
+  }
+
+  nostd::shared_ptr<BoundCounter<T>> Bind(
+      std::initializer_list<std::pair<nostd::string_view, common::AttributeValue>>
+          attributes) noexcept
+  {
+    return this->Bind(nostd::span<const std::pair<nostd::string_view, common::AttributeValue>>{
+        attributes.begin(), attributes.end()});
+  }
 };
 
 /** A histogram instrument that records values. */
@@ -124,6 +188,32 @@ class Histogram : public SynchronousInstrument
                      attributes.begin(), attributes.end()},
                  context);
   }
+
+  /**
+   * Bind resolves a set of attributes once and returns a handle that records values for those
+   * attributes. Recording through the handle skips the per-call attribute processing and lookup.
+   * The handle stays valid for as long as it is held, including across metric collections.
+   *
+   * @param attributes A set of attributes to associate with the recorded values. They are copied
+   * as needed; the caller does not need to keep them alive.
+   */
+  virtual nostd::shared_ptr<BoundHistogram<T>> Bind(
+      const common::KeyValueIterable &attributes) noexcept = 0;
+
+  template <class U,
+            nostd::enable_if_t<common::detail::is_key_value_iterable<U>::value> * = nullptr>
+  nostd::shared_ptr<BoundHistogram<T>> Bind(const U &attributes) noexcept
+  {
+    return this->Bind(common::KeyValueIterableView<U>{attributes});
+  }
+
+  nostd::shared_ptr<BoundHistogram<T>> Bind(
+      std::initializer_list<std::pair<nostd::string_view, common::AttributeValue>>
+          attributes) noexcept
+  {
+    return this->Bind(nostd::span<const std::pair<nostd::string_view, common::AttributeValue>>{
+        attributes.begin(), attributes.end()});
+  }
 };
 
 /** An up-down-counter instrument that adds or reduce values. */
@@ -190,6 +280,94 @@ class UpDownCounter : public SynchronousInstrument
   }
 };
 
+/**
+ * A value of a synchronous instrument, recorded along with the values of other instruments by
+ * Meter::RecordBatch. It refers to the instrument, which must outlive it.
+ */
+class SyncMeasurement
+{
+public:
+  enum class InstrumentKind
+  {
+    kLongCounter,
+    kDoubleCounter,
+    kLongUpDownCounter,
+    kDoubleUpDownCounter,
+    kLongHistogram,
+    kDoubleHistogram
+  };
+
+  SyncMeasurement(Counter<long> &counter, long value) noexcept
+      : kind_(InstrumentKind::kLongCounter), instrument_(&counter), long_value_(value)
+  {}
+
+  SyncMeasurement(Counter<double> &counter, double value) noexcept
+      : kind_(InstrumentKind::kDoubleCounter), instrument_(&counter), double_value_(value)
+  {}
+
+  SyncMeasurement(UpDownCounter<long> &counter, long value) noexcept
+      : kind_(InstrumentKind::kLongUpDownCounter), instrument_(&counter), long_value_(value)
+  {}
+
+  SyncMeasurement(UpDownCounter<double> &counter, double value) noexcept
+      : kind_(InstrumentKind::kDoubleUpDownCounter), instrument_(&counter), double_value_(value)
+  {}
+
+  SyncMeasurement(Histogram<long> &histogram, long value) noexcept
+      : kind_(InstrumentKind::kLongHistogram), instrument_(&histogram), long_value_(value)
+  {}
+
+  SyncMeasurement(Histogram<double> &histogram, double value) noexcept
+      : kind_(InstrumentKind::kDoubleHistogram), instrument_(&histogram), double_value_(value)
+  {}
+
+  InstrumentKind GetInstrumentKind() const noexcept { return kind_; }
+
+  /**
+   * @return the instrument, whose type is given by GetInstrumentKind().
+   */
+  SynchronousInstrument &GetInstrument() const noexcept { return *instrument_; }
+
+  long GetLongValue() const noexcept { return long_value_; }
+
+  double GetDoubleValue() const noexcept { return double_value_; }
+
+  /**
+   * Records the value with the regular call of the instrument.
+   */
+  void Record(const common::KeyValueIterable &attributes,
+              const opentelemetry::context::Context &context) const noexcept
+  {
+    switch (kind_)
+    {
+      case InstrumentKind::kLongCounter:
+        static_cast<Counter<long> *>(instrument_)->Add(long_value_, attributes, context);
+        break;
+      case InstrumentKind::kDoubleCounter:
+        static_cast<Counter<double> *>(instrument_)->Add(double_value_, attributes, context);
+        break;
+      case InstrumentKind::kLongUpDownCounter:
+        static_cast<UpDownCounter<long> *>(instrument_)->Add(long_value_, attributes, context);
+        break;
+      case InstrumentKind::kDoubleUpDownCounter:
+        static_cast<UpDownCounter<double> *>(instrument_)->Add(double_value_, attributes, context);
+        break;
+      case InstrumentKind::kLongHistogram:
+        static_cast<Histogram<long> *>(instrument_)->Record(long_value_, attributes, context);
+        break;
+      case InstrumentKind::kDoubleHistogram:
+        static_cast<Histogram<double> *>(instrument_)->Record(double_value_, attributes, context);
+        break;
+    }
+  }
+
+private:
+  InstrumentKind kind_;
+  SynchronousInstrument *instrument_;
+  long long_value_     = 0;
+  double double_value_ = 0;
+};
+
 }  // namespace metrics
 OPENTELEMETRY_END_NAMESPACE
 #endif
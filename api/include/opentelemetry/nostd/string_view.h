@@ -34,7 +34,7 @@ class string_view
 
   static constexpr size_type npos = static_cast<size_type>(-1);
 
-  string_view() noexcept : length_(0), data_(nullptr) {}
+  constexpr string_view() noexcept : length_(0), data_(nullptr) {}
 
   string_view(const char *str) noexcept : length_(std::strlen(str)), data_(str) {}
 
@@ -42,17 +42,17 @@ class string_view
       : length_(str.length()), data_(str.c_str())
   {}
 
-  string_view(const char *str, size_type len) noexcept : length_(len), data_(str) {}
+  constexpr string_view(const char *str, size_type len) noexcept : length_(len), data_(str) {}
 
   explicit operator std::string() const { return {data_, length_}; }
 
-  const char *data() const noexcept { return data_; }
+  constexpr const char *data() const noexcept { return data_; }
 
-  bool empty() const noexcept { return length_ == 0; }
+  constexpr bool empty() const noexcept { return length_ == 0; }
 
-  size_type length() const noexcept { return length_; }
+  constexpr size_type length() const noexcept { return length_; }
 
-  size_type size() const noexcept { return length_; }
+  constexpr size_type size() const noexcept { return length_; }
 
   const char *begin() const noexcept { return data(); }
 
@@ -8,6 +8,7 @@
 #include "opentelemetry/plugin/detail/utility.h"
 #include "opentelemetry/plugin/factory.h"
 #include "opentelemetry/plugin/hook.h"
+#include "opentelemetry/plugin/span_function_table.h"
 #include "opentelemetry/version.h"
 
 #ifndef NOMINMAX
@@ -90,8 +91,17 @@ inline std::unique_ptr<Factory> LoadFactory(const char *plugin, std::string &err
     detail::CopyErrorMessage(plugin_error_message.get(), error_message);
     return nullptr;
   }
-  return std::unique_ptr<Factory>{new (std::nothrow)
-                                      Factory{std::move(library_handle), std::move(factory_impl)}};
+
+  // Plugins built before SpanFunctionTable export none: their spans are called through their
+  // virtual functions.
+  auto span_functions = reinterpret_cast<const SpanFunctionTable *>(
+      ::GetProcAddress(handle, "OpenTelemetrySpanFunctionTable"));
+  if (span_functions != nullptr && span_functions->version != kSpanFunctionTableVersion)
+  {
+    span_functions = nullptr;
+  }
+  return std::unique_ptr<Factory>{new (std::nothrow) Factory{
+      std::move(library_handle), std::move(factory_impl), span_functions}};
 }
 }  // namespace plugin
 OPENTELEMETRY_END_NAMESPACE
@@ -28,9 +28,15 @@ class Factory final
         nostd::unique_ptr<char[]> &error_message) const noexcept = 0;
   };
 
+  /**
+   * @param span_functions the SpanFunctionTable exported by the plugin, or nullptr.
+   */
   Factory(std::shared_ptr<DynamicLibraryHandle> library_handle,
-          std::unique_ptr<FactoryImpl> &&factory_impl) noexcept
-      : library_handle_{std::move(library_handle)}, factory_impl_{std::move(factory_impl)}
+          std::unique_ptr<FactoryImpl> &&factory_impl,
+          const SpanFunctionTable *span_functions = nullptr) noexcept
+      : library_handle_{std::move(library_handle)},
+        factory_impl_{std::move(factory_impl)},
+        span_functions_{span_functions}
   {}
 
   /**
@@ -51,7 +57,7 @@ class Factory final
       return nullptr;
     }
     return std::shared_ptr<opentelemetry::trace::Tracer>{
-        new (std::nothrow) Tracer{library_handle_, std::move(tracer_handle)}};
+        new (std::nothrow) Tracer{library_handle_, std::move(tracer_handle), span_functions_}};
   }
 
 private:
@@ -60,6 +66,7 @@ class Factory final
   // It's undefined behavior to close the library while a loaded FactoryImpl is still active.
   std::shared_ptr<DynamicLibraryHandle> library_handle_;
   std::unique_ptr<FactoryImpl> factory_impl_;
+  const SpanFunctionTable *span_functions_;
 };
 }  // namespace plugin
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,171 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+#include "opentelemetry/common/attribute_value.h"
+#include "opentelemetry/common/key_value_iterable.h"
+#include "opentelemetry/common/timestamp.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/trace/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace plugin
+{
+/**
+ * The version of the layout of SpanFunctionTable. A loader ignores the table of a plugin built
+ * with another version, and calls its spans through their virtual functions.
+ */
+constexpr uint32_t kSpanFunctionTableVersion = 1;
+
+/**
+ * The operations of the spans of a plugin, as a flat table of functions, resolved once when the
+ * plugin is loaded.
+ *
+ * The spans the loader wraps around the spans of a plugin call these functions directly, rather
+ * than dispatching a second time through the virtual functions of trace::Span, behind those of the
+ * wrapper.
+ */
+struct SpanFunctionTable
+{
+  uint32_t version;
+  void (*set_attribute)(trace::Span &span,
+                        nostd::string_view key,
+                        const common::AttributeValue &value);
+  void (*add_event)(trace::Span &span, nostd::string_view name);
+  void (*add_event_at)(trace::Span &span,
+                       nostd::string_view name,
+                       common::SystemTimestamp timestamp);
+  void (*add_event_with_attributes)(trace::Span &span,
+                                    nostd::string_view name,
+                                    common::SystemTimestamp timestamp,
+                                    const common::KeyValueIterable &attributes);
+  void (*set_status)(trace::Span &span, trace::StatusCode code, nostd::string_view description);
+  void (*update_name)(trace::Span &span, nostd::string_view name);
+  void (*end)(trace::Span &span, const trace::EndSpanOptions &options);
+  bool (*is_recording)(const trace::Span &span);
+  trace::SpanContext (*get_context)(const trace::Span &span);
+};
+
+namespace detail
+{
+template <class SpanT>
+struct SpanFunctions
+{
+  static void SetAttribute(trace::Span &span,
+                           nostd::string_view key,
+                           const common::AttributeValue &value)
+  {
+    static_cast<SpanT &>(span).SetAttribute(key, value);
+  }
+
+  static void AddEvent(trace::Span &span, nostd::string_view name)
+  {
+    static_cast<SpanT &>(span).AddEvent(name);
+  }
+
+  static void AddEventAt(trace::Span &span,
+                         nostd::string_view name,
+                         common::SystemTimestamp timestamp)
+  {
+    static_cast<SpanT &>(span).AddEvent(name, timestamp);
+  }
+
+  static void AddEventWithAttributes(trace::Span &span,
+                                     nostd::string_view name,
+                                     common::SystemTimestamp timestamp,
+                                     const common::KeyValueIterable &attributes)
+  {
+    static_cast<SpanT &>(span).AddEvent(name, timestamp, attributes);
+  }
+
+  static void SetStatus(trace::Span &span, trace::StatusCode code, nostd::string_view description)
+  {
+    static_cast<SpanT &>(span).SetStatus(code, description);
+  }
+
+  static void UpdateName(trace::Span &span, nostd::string_view name)
+  {
+    static_cast<SpanT &>(span).UpdateName(name);
+  }
+
+  static void End(trace::Span &span, const trace::EndSpanOptions &options)
+  {
+    static_cast<SpanT &>(span).End(options);
+  }
+
+  static bool IsRecording(const trace::Span &span)
+  {
+    return static_cast<const SpanT &>(span).IsRecording();
+  }
+
+  static trace::SpanContext GetContext(const trace::Span &span)
+  {
+    return static_cast<const SpanT &>(span).GetContext();
+  }
+};
+}  // namespace detail
+
+/**
+ * Returns the table of the functions calling the spans of type SpanT. When SpanT is final, the
+ * compiler calls its member functions directly rather than through its virtual table.
+ */
+template <class SpanT>
+constexpr SpanFunctionTable MakeSpanFunctionTable() noexcept
+{
+  return SpanFunctionTable{kSpanFunctionTableVersion,
+                           &detail::SpanFunctions<SpanT>::SetAttribute,
+                           &detail::SpanFunctions<SpanT>::AddEvent,
+                           &detail::SpanFunctions<SpanT>::AddEventAt,
+                           &detail::SpanFunctions<SpanT>::AddEventWithAttributes,
+                           &detail::SpanFunctions<SpanT>::SetStatus,
+                           &detail::SpanFunctions<SpanT>::UpdateName,
+                           &detail::SpanFunctions<SpanT>::End,
+                           &detail::SpanFunctions<SpanT>::IsRecording,
+                           &detail::SpanFunctions<SpanT>::GetContext};
+}
+
+namespace detail
+{
+/**
+ * The table of the plugins which export none, calling the spans through their virtual functions.
+ */
+inline const SpanFunctionTable &GetVirtualSpanFunctionTable() noexcept
+{
+  static const SpanFunctionTable table = MakeSpanFunctionTable<trace::Span>();
+  return table;
+}
+}  // namespace detail
+}  // namespace plugin
+OPENTELEMETRY_END_NAMESPACE
+
+#ifdef _WIN32
+
+/**
+ * Cross-platform helper macro to export the SpanFunctionTable of a plugin whose tracers only
+ * create spans of type SpanT, which should be final. It must be used at most once per plugin.
+ */
+#  define OPENTELEMETRY_DEFINE_PLUGIN_SPAN_FUNCTIONS(SpanT)                                    \
+    extern "C" {                                                                              \
+    extern __declspec(dllexport)                                                              \
+        opentelemetry::plugin::SpanFunctionTable const OpenTelemetrySpanFunctionTable;        \
+                                                                                              \
+    __declspec(selectany) opentelemetry::plugin::SpanFunctionTable const                      \
+        OpenTelemetrySpanFunctionTable = opentelemetry::plugin::MakeSpanFunctionTable<SpanT>(); \
+    }  // extern "C"
+
+#else
+
+#  define OPENTELEMETRY_DEFINE_PLUGIN_SPAN_FUNCTIONS(SpanT)                                    \
+    extern "C" {                                                                              \
+    __attribute((weak)) extern opentelemetry::plugin::SpanFunctionTable const                 \
+        OpenTelemetrySpanFunctionTable;                                                       \
+                                                                                              \
+    opentelemetry::plugin::SpanFunctionTable const OpenTelemetrySpanFunctionTable =           \
+        opentelemetry::plugin::MakeSpanFunctionTable<SpanT>();                                \
+    }  // extern "C"
+
+#endif
@@ -8,63 +8,96 @@
 #include "opentelemetry/common/key_value_iterable.h"
 #include "opentelemetry/plugin/detail/dynamic_library_handle.h"
 #include "opentelemetry/plugin/detail/tracer_handle.h"
+#include "opentelemetry/plugin/span_function_table.h"
 #include "opentelemetry/trace/tracer.h"
 #include "opentelemetry/version.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace plugin
 {
+/**
+ * Wraps a span of a plugin, keeping its tracer, and so the plugin, loaded. The span is called
+ * through the SpanFunctionTable of the plugin.
+ */
 class Span final : public trace::Span
 {
 public:
-  Span(std::shared_ptr<trace::Tracer> &&tracer, nostd::shared_ptr<trace::Span> span) noexcept
-      : tracer_{std::move(tracer)}, span_{span}
+  Span(std::shared_ptr<trace::Tracer> &&tracer,
+       nostd::shared_ptr<trace::Span> &&span,
+       const SpanFunctionTable &functions) noexcept
+      : tracer_{std::move(tracer)},
+        span_{std::move(span)},
+        raw_span_{span_.get()},
+        functions_(functions)
   {}
 
   // trace::Span
   void SetAttribute(nostd::string_view name, const common::AttributeValue &value) noexcept override
   {
-    span_->SetAttribute(name, value);
+    functions_.set_attribute(*raw_span_, name, value);
   }
 
-  void AddEvent(nostd::string_view name) noexcept override { span_->AddEvent(name); }
+  void AddEvent(nostd::string_view name) noexcept override
+  {
+    functions_.add_event(*raw_span_, name);
+  }
 
   void AddEvent(nostd::string_view name, common::SystemTimestamp timestamp) noexcept override
   {
-    span_->AddEvent(name, timestamp);
+    functions_.add_event_at(*raw_span_, name, timestamp);
   }
 
   void AddEvent(nostd::string_view name,
                 common::SystemTimestamp timestamp,
                 const common::KeyValueIterable &attributes) noexcept override
   {
-    span_->AddEvent(name, timestamp, attributes);
+    functions_.add_event_with_attributes(*raw_span_, name, timestamp, attributes);
   }
 
   void SetStatus(trace::StatusCode code, nostd::string_view description) noexcept override
   {
-    span_->SetStatus(code, description);
+    functions_.set_status(*raw_span_, code, description);
   }
 
-  void UpdateName(nostd::string_view name) noexcept override { span_->UpdateName(name); }
+  void UpdateName(nostd::string_view name) noexcept override
+  {
+    functions_.update_name(*raw_span_, name);
+  }
 
-  void End(const trace::EndSpanOptions &options = {}) noexcept override { span_->End(options); }
+  void End(const trace::EndSpanOptions &options = {}) noexcept override
+  {
+    functions_.end(*raw_span_, options);
+  }
 
-  bool IsRecording() const noexcept override { return span_->IsRecording(); }
+  bool IsRecording() const noexcept override { return functions_.is_recording(*raw_span_); }
 
-  trace::SpanContext GetContext() const noexcept override { return span_->GetContext(); }
+  trace::SpanContext GetContext() const noexcept override
+  {
+    return functions_.get_context(*raw_span_);
+  }
 
 private:
   std::shared_ptr<trace::Tracer> tracer_;
   nostd::shared_ptr<trace::Span> span_;
+  // span_.get(), which is a virtual call, resolved once
+  trace::Span *raw_span_;
+  const SpanFunctionTable &functions_;
 };
 
 class Tracer final : public trace::Tracer, public std::enable_shared_from_this<Tracer>
 {
 public:
+  /**
+   * @param span_functions the SpanFunctionTable exported by the plugin, or nullptr if it exports
+   * none, in which case its spans are called through their virtual functions.
+   */
   Tracer(std::shared_ptr<DynamicLibraryHandle> library_handle,
-         std::unique_ptr<TracerHandle> &&tracer_handle) noexcept
-      : library_handle_{std::move(library_handle)}, tracer_handle_{std::move(tracer_handle)}
+         std::unique_ptr<TracerHandle> &&tracer_handle,
+         const SpanFunctionTable *span_functions = nullptr) noexcept
+      : library_handle_{std::move(library_handle)},
+        tracer_handle_{std::move(tracer_handle)},
+        span_functions_{span_functions != nullptr ? *span_functions
+                                                  : detail::GetVirtualSpanFunctionTable()}
   {}
 
   // trace::Tracer
@@ -79,7 +112,8 @@ class Tracer final : public trace::Tracer, public std::enable_shared_from_this<T
     {
       return nostd::shared_ptr<trace::Span>(nullptr);
     }
-    return nostd::shared_ptr<trace::Span>{new (std::nothrow) Span{this->shared_from_this(), span}};
+    return nostd::shared_ptr<trace::Span>{
+        new (std::nothrow) Span{this->shared_from_this(), std::move(span), span_functions_}};
   }
 
   void ForceFlushWithMicroseconds(uint64_t timeout) noexcept override
@@ -98,6 +132,7 @@ class Tracer final : public trace::Tracer, public std::enable_shared_from_this<T
   // It's undefined behavior to close the library while a loaded tracer is still active.
   std::shared_ptr<DynamicLibraryHandle> library_handle_;
   std::unique_ptr<TracerHandle> tracer_handle_;
+  const SpanFunctionTable &span_functions_;
 };
 }  // namespace plugin
 OPENTELEMETRY_END_NAMESPACE
@@ -14,7 +14,7 @@ namespace trace
 // Get Span from explicit context
 inline nostd::shared_ptr<Span> GetSpan(const opentelemetry::context::Context &context) noexcept
 {
-  context::ContextValue span = context.GetValue(kSpanKey);
+  context::ContextValue span = context.GetValue(GetSpanContextKey());
   if (nostd::holds_alternative<nostd::shared_ptr<Span>>(span))
   {
     return nostd::get<nostd::shared_ptr<Span>>(span);
@@ -26,7 +26,7 @@ inline nostd::shared_ptr<Span> GetSpan(const opentelemetry::context::Context &co
 inline context::Context SetSpan(opentelemetry::context::Context &context,
                                 nostd::shared_ptr<Span> span) noexcept
 {
-  return context.SetValue(kSpanKey, span);
+  return context.SetValue(GetSpanContextKey(), span);
 }
 
 }  // namespace trace
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
+#include <utility>
+
 #include "opentelemetry/common/attribute_value.h"
 #include "opentelemetry/trace/canonical_code.h"
 #include "opentelemetry/trace/span.h"
@@ -52,7 +54,7 @@ class DefaultSpan : public Span
 
   nostd::string_view ToString() const noexcept { return "DefaultSpan"; }
 
-  DefaultSpan(SpanContext span_context) noexcept : span_context_(span_context) {}
+  DefaultSpan(SpanContext span_context) noexcept : span_context_(std::move(span_context)) {}
 
   // movable and copiable
   DefaultSpan(DefaultSpan &&spn) noexcept : span_context_(spn.GetContext()) {}
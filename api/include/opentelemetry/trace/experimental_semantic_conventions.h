@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "opentelemetry/common/attribute_key.h"
 #include "opentelemetry/common/string_util.h"
 #include "opentelemetry/version.h"
 
@@ -191,5 +192,109 @@ inline const char *attr(uint32_t attr)
   return "";
 }
 
+// BEGIN GENERATED ATTRIBUTE KEYS
+// Generated by buildscripts/semantic-convention/generate_attribute_keys.py, do not edit.
+namespace attribute_keys
+{
+constexpr common::AttributeKey kNetTransport{"net.transport", 0};
+constexpr common::AttributeKey kNetPeerIp{"net.peer.ip", 1};
+constexpr common::AttributeKey kNetPeerPort{"net.peer.port", 2};
+constexpr common::AttributeKey kNetPeerName{"net.peer.name", 3};
+constexpr common::AttributeKey kNetHostIp{"net.host.ip", 4};
+constexpr common::AttributeKey kNetHostPort{"net.host.port", 5};
+constexpr common::AttributeKey kNetHostName{"net.host.name", 6};
+constexpr common::AttributeKey kEnduserId{"enduser.id", 7};
+constexpr common::AttributeKey kEnduserRole{"enduser.role", 8};
+constexpr common::AttributeKey kEnduserScope{"enduser.scope", 9};
+constexpr common::AttributeKey kPeerService{"peer.service", 10};
+constexpr common::AttributeKey kThreadId{"thread.id", 11};
+constexpr common::AttributeKey kThreadName{"thread.name", 12};
+constexpr common::AttributeKey kCodeFunction{"code.function", 13};
+constexpr common::AttributeKey kCodeNamespace{"code.namespace", 14};
+constexpr common::AttributeKey kCodeFilepath{"code.filepath", 15};
+constexpr common::AttributeKey kCodeLineno{"code.lineno", 16};
+constexpr common::AttributeKey kHttpMethod{"http.method", 17};
+constexpr common::AttributeKey kHttpUrl{"http.url", 18};
+constexpr common::AttributeKey kHttpTarget{"http.target", 19};
+constexpr common::AttributeKey kHttpHost{"http.host", 20};
+constexpr common::AttributeKey kHttpScheme{"http.scheme", 21};
+constexpr common::AttributeKey kHttpStatusCode{"http.status_code", 22};
+constexpr common::AttributeKey kHttpFlavor{"http.flavor", 23};
+constexpr common::AttributeKey kHttpUserAgent{"http.user_agent", 24};
+constexpr common::AttributeKey kHttpRequestContentLength{"http.request_content_length", 25};
+constexpr common::AttributeKey kHttpRequestContentLengthUncompressed{
+    "http.request_content_length_uncompressed", 26};
+constexpr common::AttributeKey kHttpResponseContentLength{"http.response_content_length", 27};
+constexpr common::AttributeKey kHttpResponseContentLengthUncompressed{
+    "http.response_content_length_uncompressed", 28};
+constexpr common::AttributeKey kHttpServerName{"http.server_name", 29};
+constexpr common::AttributeKey kHttpRoute{"http.route", 30};
+constexpr common::AttributeKey kHttpClientIp{"http.client_ip", 31};
+constexpr common::AttributeKey kDbSystem{"db.system", 32};
+constexpr common::AttributeKey kDbConnectionString{"db.connection_string", 33};
+constexpr common::AttributeKey kDbUser{"db.user", 34};
+constexpr common::AttributeKey kDbMssqlInstanceName{"db.mssql.instance_name", 35};
+constexpr common::AttributeKey kDbJdbcDriverClassname{"db.jdbc.driver_classname", 36};
+constexpr common::AttributeKey kDbName{"db.name", 37};
+constexpr common::AttributeKey kDbStatement{"db.statement", 38};
+constexpr common::AttributeKey kDbOperation{"db.operation", 39};
+constexpr common::AttributeKey kDbHbaseNamespace{"db.hbase.namespace", 40};
+constexpr common::AttributeKey kDbRedisDatabaseIndex{"db.redis.database_index", 41};
+constexpr common::AttributeKey kDbMongodbCollection{"db.mongodb.collection", 42};
+constexpr common::AttributeKey kDbCassandraKeyspace{"db.cassandra.keyspace", 43};
+constexpr common::AttributeKey kDbCassandraPageSize{"db.cassandra.page_size", 44};
+constexpr common::AttributeKey kDbCassandraConsistencyLevel{"db.cassandra.consistency_level", 45};
+constexpr common::AttributeKey kDbCassandraTable{"db.cassandra.table", 46};
+constexpr common::AttributeKey kDbCassandraIdempotence{"db.cassandra.idempotence", 47};
+constexpr common::AttributeKey kDbCassandraSpeculativeExecutionCount{
+    "db.cassandra.speculative_execution_count", 48};
+constexpr common::AttributeKey kDbCassandraCoordinatorId{"db.cassandra.coordinator.id", 49};
+constexpr common::AttributeKey kDbCassandraCoordinatorDC{"db.cassandra.coordinator.dc", 50};
+constexpr common::AttributeKey kRpcSystem{"rpc.system", 51};
+constexpr common::AttributeKey kRpcService{"rpc.service", 52};
+constexpr common::AttributeKey kRpcMethod{"rpc.method", 53};
+constexpr common::AttributeKey kRpcGrpcStatusCode{"rpc.grpc.status_code", 54};
+constexpr common::AttributeKey kRpcJsonrpcVersion{"rpc.jsonrpc.version", 55};
+constexpr common::AttributeKey kRpcJsonrpcRequestId{"rpc.jsonrpc.request_id", 56};
+constexpr common::AttributeKey kRpcJsonrpcErrorCode{"rpc.jsonrpc.error_code", 57};
+constexpr common::AttributeKey kRpcJsonrpcErrorMessage{"rpc.jsonrpc.error_message", 58};
+constexpr common::AttributeKey kFaasTrigger{"faas.trigger", 59};
+constexpr common::AttributeKey kFaasExecution{"faas.execution", 60};
+constexpr common::AttributeKey kFaasColdStart{"faas.coldstart", 61};
+constexpr common::AttributeKey kFaasInvokedName{"faas.invoked_name", 62};
+constexpr common::AttributeKey kFaasInvokedProvider{"faas.invoked_provider", 63};
+constexpr common::AttributeKey kFaasInvokedRegion{"faas.invoked_region", 64};
+constexpr common::AttributeKey kFaasDocumentCollection{"faas.document.collection", 65};
+constexpr common::AttributeKey kFaasDocumentOperation{"faas.document.operation", 66};
+constexpr common::AttributeKey kFaasDocumentTime{"faas.document.time", 67};
+constexpr common::AttributeKey kFaasDocumentName{"faas.document.name", 68};
+constexpr common::AttributeKey kFaasTime{"faas.time", 69};
+constexpr common::AttributeKey kFaasCron{"faas.cron", 70};
+constexpr common::AttributeKey kMessagingSystem{"messaging.system", 71};
+constexpr common::AttributeKey kMessagingDestination{"messaging.destination", 72};
+constexpr common::AttributeKey kMessagingDestinationKind{"messaging.destination_kind", 73};
+constexpr common::AttributeKey kMessagingTempDestination{"messaging.temp_destination", 74};
+constexpr common::AttributeKey kMessagingProtocol{"messaging.protocol", 75};
+constexpr common::AttributeKey kMessagingProtocolVersion{"messaging.protocol_version", 76};
+constexpr common::AttributeKey kMessagingUrl{"messaging.url", 77};
+constexpr common::AttributeKey kMessagingMessageId{"messaging.message_id", 78};
+constexpr common::AttributeKey kMessagingConversationId{"messaging.conversation_id", 79};
+constexpr common::AttributeKey kMessagingPayloadSize{"messaging.message_payload_size_bytes", 80};
+constexpr common::AttributeKey kMessagingPayloadCompressedSize{
+    "messaging.message_payload_compressed_size_bytes", 81};
+constexpr common::AttributeKey kMessagingOperation{"messaging.operation", 82};
+constexpr common::AttributeKey kMessagingRabbitMQRoutingKey{"messaging.rabbitmq.routing_key", 83};
+constexpr common::AttributeKey kMessagingKafkaMessageKey{"messaging.kafka.message_key", 84};
+constexpr common::AttributeKey kMessagingKafkaConsumerGroup{"messaging.kafka.consumer_group", 85};
+constexpr common::AttributeKey kMessagingKafkaClientId{"messaging.kafka.client_id", 86};
+constexpr common::AttributeKey kMessagingKafkaPartition{"messaging.kafka.partition", 87};
+constexpr common::AttributeKey kMessagingKafkaTombstone{"messaging.kafka.tombstone", 88};
+constexpr common::AttributeKey kExceptionType{"exception.type", 89};
+constexpr common::AttributeKey kExceptionMessage{"exception.message", 90};
+constexpr common::AttributeKey kExceptionStacktrace{"exception.stacktrace", 91};
+constexpr common::AttributeKey kExceptionEscapted{"exception.escaped", 92};
+}  // namespace attribute_keys
+// END GENERATED ATTRIBUTE KEYS
+
 }  // namespace trace
 OPENTELEMETRY_END_NAMESPACE
@@ -105,13 +105,16 @@ class B3PropagatorExtractor : public opentelemetry::context::propagation::TextMa
       trace_flags_hex = carrier.Get(kB3SampledHeader);
     }
 
-    if (!detail::IsValidHex(trace_id_hex) || !detail::IsValidHex(span_id_hex))
+    uint8_t trace_id_buf[kTraceIdHexStrLength / 2];
+    uint8_t span_id_buf[kSpanIdHexStrLength / 2];
+    if (!detail::HexToBinaryIfValid(trace_id_hex, trace_id_buf, sizeof(trace_id_buf)) ||
+        !detail::HexToBinaryIfValid(span_id_hex, span_id_buf, sizeof(span_id_buf)))
     {
       return SpanContext::GetInvalid();
     }
 
-    TraceId trace_id = TraceIdFromHex(trace_id_hex);
-    SpanId span_id   = SpanIdFromHex(span_id_hex);
+    TraceId trace_id(trace_id_buf);
+    SpanId span_id(span_id_buf);
 
     if (!trace_id.IsValid() || !span_id.IsValid())
     {
@@ -139,11 +142,11 @@ class B3Propagator : public B3PropagatorExtractor
 
     char trace_identity[kTraceIdHexStrLength + kSpanIdHexStrLength + 3];
     static_assert(sizeof(trace_identity) == 51, "b3 trace identity buffer size mismatch");
-    span_context.trace_id().ToLowerBase16(nostd::span<char, 2 * TraceId::kSize>{
-        &trace_identity[0], static_cast<std::size_t>(kTraceIdHexStrLength)});
+    detail::EncodeLowerHex(span_context.trace_id().Id().data(), TraceId::kSize,
+                           &trace_identity[0]);
     trace_identity[kTraceIdHexStrLength] = '-';
-    span_context.span_id().ToLowerBase16(nostd::span<char, 2 * SpanId::kSize>{
-        &trace_identity[kTraceIdHexStrLength + 1], static_cast<std::size_t>(kSpanIdHexStrLength)});
+    detail::EncodeLowerHex(span_context.span_id().Id().data(), SpanId::kSize,
+                           &trace_identity[kTraceIdHexStrLength + 1]);
     trace_identity[kTraceIdHexStrLength + kSpanIdHexStrLength + 1] = '-';
     trace_identity[kTraceIdHexStrLength + kSpanIdHexStrLength + 2] =
         span_context.trace_flags().IsSampled() ? '1' : '0';
@@ -168,12 +171,13 @@ class B3PropagatorMultiHeader : public B3PropagatorExtractor
     {
       return;
     }
-    char trace_id[32];
-    TraceId(span_context.trace_id()).ToLowerBase16(trace_id);
-    char span_id[16];
-    SpanId(span_context.span_id()).ToLowerBase16(span_id);
+    char trace_id[kTraceIdHexStrLength];
+    detail::EncodeLowerHex(span_context.trace_id().Id().data(), TraceId::kSize, trace_id);
+    char span_id[kSpanIdHexStrLength];
+    detail::EncodeLowerHex(span_context.span_id().Id().data(), SpanId::kSize, span_id);
     char trace_flags[2];
-    TraceFlags(span_context.trace_flags()).ToLowerBase16(trace_flags);
+    uint8_t flags = span_context.trace_flags().flags();
+    detail::EncodeLowerHex(&flags, 1, trace_flags);
     carrier.Set(kB3TraceIdHeader, nostd::string_view(trace_id, sizeof(trace_id)));
     carrier.Set(kB3SpanIdHeader, nostd::string_view(span_id, sizeof(span_id)));
     carrier.Set(kB3SampledHeader, nostd::string_view(trace_flags + 1, 1));
@@ -0,0 +1,119 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstring>
+
+#include "opentelemetry/context/propagation/text_map_propagator.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/trace/context.h"
+#include "opentelemetry/trace/default_span.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace trace
+{
+namespace propagation
+{
+static const nostd::string_view kGrpcTraceBinHeader = "grpc-trace-bin";
+
+// The BinaryTraceContext propagates the span context in the binary layout of the OpenCensus
+// grpc-trace-bin header, for gRPC metadata between services: binary metadata, whose keys end with
+// "-bin", carries the bytes of the header as they are, so that trace and span ids are copied
+// rather than hex encoded and decoded at every hop. The W3C HttpTraceContext remains the format
+// to use at the edge: the binary layout carries no trace state.
+//
+// The header is made of a version byte, 0, and of fields made of an id byte and a fixed length
+// value: the trace id (0) on 16 bytes, the span id (1) on 8 bytes, and the trace options (2) on
+// one byte, whose lowest bit is the sampled flag.
+// Example:
+//    BinaryTraceContext().Inject(carrier, context);
+//    BinaryTraceContext().Extract(carrier, context);
+
+class BinaryTraceContext : public opentelemetry::context::propagation::TextMapPropagator
+{
+public:
+  static constexpr size_t kHeaderSize = 29;
+
+  void Inject(opentelemetry::context::propagation::TextMapCarrier &carrier,
+              const context::Context &context) noexcept override
+  {
+    SpanContext span_context = trace::GetSpan(context)->GetContext();
+    if (!span_context.IsValid())
+    {
+      return;
+    }
+    uint8_t header[kHeaderSize];
+    ToBytes(span_context, header);
+    carrier.Set(kGrpcTraceBinHeader,
+                nostd::string_view(reinterpret_cast<const char *>(header), sizeof(header)));
+  }
+
+  context::Context Extract(const opentelemetry::context::propagation::TextMapCarrier &carrier,
+                           context::Context &context) noexcept override
+  {
+    SpanContext span_context = FromBytes(carrier.Get(kGrpcTraceBinHeader));
+    nostd::shared_ptr<Span> sp{new DefaultSpan(span_context)};
+    return trace::SetSpan(context, sp);
+  }
+
+  bool Fields(nostd::function_ref<bool(nostd::string_view)> callback) const noexcept override
+  {
+    return callback(kGrpcTraceBinHeader);
+  }
+
+  // Writes the grpc-trace-bin header of span_context into header.
+  static void ToBytes(const SpanContext &span_context, uint8_t (&header)[kHeaderSize]) noexcept
+  {
+    header[0]              = kVersion;
+    header[kTraceIdOffset] = kTraceIdField;
+    std::memcpy(&header[kTraceIdOffset + 1], span_context.trace_id().Id().data(), TraceId::kSize);
+    header[kSpanIdOffset] = kSpanIdField;
+    std::memcpy(&header[kSpanIdOffset + 1], span_context.span_id().Id().data(), SpanId::kSize);
+    header[kTraceOptionsOffset]     = kTraceOptionsField;
+    header[kTraceOptionsOffset + 1] = span_context.trace_flags().flags() & TraceFlags::kIsSampled;
+  }
+
+  // Returns the remote span context of a grpc-trace-bin header, or an invalid span context if
+  // the header is malformed. Fields after the trace options, e.g. from a later version of the
+  // layout, are ignored.
+  static SpanContext FromBytes(nostd::string_view header) noexcept
+  {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(header.data());
+    if (header.size() < kTraceOptionsOffset || data[0] != kVersion ||
+        data[kTraceIdOffset] != kTraceIdField || data[kSpanIdOffset] != kSpanIdField)
+    {
+      return SpanContext::GetInvalid();
+    }
+
+    // The trace options are optional.
+    uint8_t options = 0;
+    if (header.size() >= kHeaderSize && data[kTraceOptionsOffset] == kTraceOptionsField)
+    {
+      options = data[kTraceOptionsOffset + 1] & TraceFlags::kIsSampled;
+    }
+
+    TraceId trace_id(nostd::span<const uint8_t, TraceId::kSize>(&data[kTraceIdOffset + 1],
+                                                                 TraceId::kSize));
+    SpanId span_id(
+        nostd::span<const uint8_t, SpanId::kSize>(&data[kSpanIdOffset + 1], SpanId::kSize));
+    if (!trace_id.IsValid() || !span_id.IsValid())
+    {
+      return SpanContext::GetInvalid();
+    }
+    return SpanContext(trace_id, span_id, TraceFlags(options), true);
+  }
+
+private:
+  static constexpr uint8_t kVersion           = 0;
+  static constexpr uint8_t kTraceIdField      = 0;
+  static constexpr uint8_t kSpanIdField       = 1;
+  static constexpr uint8_t kTraceOptionsField = 2;
+
+  static constexpr size_t kTraceIdOffset      = 1;
+  static constexpr size_t kSpanIdOffset       = kTraceIdOffset + 1 + TraceId::kSize;
+  static constexpr size_t kTraceOptionsOffset = kSpanIdOffset + 1 + SpanId::kSize;
+};
+}  // namespace propagation
+}  // namespace trace
+OPENTELEMETRY_END_NAMESPACE
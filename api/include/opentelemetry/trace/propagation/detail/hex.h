@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "opentelemetry/common/hex.h"
 #include "opentelemetry/nostd/string_view.h"
 
 #include <algorithm>
@@ -48,6 +49,12 @@ inline bool IsValidHex(nostd::string_view s)
  */
 inline bool HexToBinary(nostd::string_view hex, uint8_t *buffer, size_t buffer_size)
 {
+  if (hex.size() == buffer_size * 2)
+  {
+    common::DecodeHex(hex.data(), buffer_size, buffer);
+    return true;
+  }
+
   std::memset(buffer, 0, buffer_size);
 
   if (hex.size() > buffer_size * 2)
@@ -73,6 +80,36 @@ inline bool HexToBinary(nostd::string_view hex, uint8_t *buffer, size_t buffer_s
   return true;
 }
 
+/**
+ * Decodes exactly 2 * buffer_size hex digits into buffer, see common::DecodeHex().
+ * Returns false, leaving buffer unspecified, if any character is not a hex digit.
+ */
+inline bool DecodeHexFixed(const char *hex, uint8_t *buffer, size_t buffer_size) noexcept
+{
+  return common::DecodeHex(hex, buffer_size, buffer);
+}
+
+/**
+ * Like HexToBinary(), but returns false as well if hex is not made of hex digits. Hex strings
+ * that fill the buffer, e.g. full width ids, are decoded by DecodeHexFixed() in a single pass.
+ */
+inline bool HexToBinaryIfValid(nostd::string_view hex, uint8_t *buffer, size_t buffer_size) noexcept
+{
+  if (hex.size() == buffer_size * 2)
+  {
+    return DecodeHexFixed(hex.data(), buffer, buffer_size);
+  }
+  return IsValidHex(hex) && HexToBinary(hex, buffer, buffer_size);
+}
+
+/**
+ * Encodes buffer into 2 * buffer_size lowercase hex digits.
+ */
+inline void EncodeLowerHex(const uint8_t *buffer, size_t buffer_size, char *hex) noexcept
+{
+  common::EncodeLowerHex(buffer, buffer_size, hex);
+}
+
 }  // namespace detail
 }  // namespace propagation
 }  // namespace trace
@@ -3,9 +3,7 @@
 
 #pragma once
 
-#include <array>
 #include "detail/hex.h"
-#include "detail/string.h"
 #include "opentelemetry/context/propagation/text_map_propagator.h"
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/trace/context.h"
@@ -76,28 +74,27 @@ class HttpTraceContext : public opentelemetry::context::propagation::TextMapProp
 private:
   static constexpr uint8_t kInvalidVersion = 0xFF;
 
-  static bool IsValidVersion(nostd::string_view version_hex)
-  {
-    uint8_t version;
-    detail::HexToBinary(version_hex, &version, sizeof(version));
-    return version != kInvalidVersion;
-  }
+  // Offsets of the fields of a traceparent header, e.g.
+  // 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01
+  static constexpr size_t kTraceIdOffset    = kVersionSize + 1;
+  static constexpr size_t kSpanIdOffset     = kTraceIdOffset + kTraceIdSize + 1;
+  static constexpr size_t kTraceFlagsOffset = kSpanIdOffset + kSpanIdSize + 1;
 
   static void InjectImpl(opentelemetry::context::propagation::TextMapCarrier &carrier,
                          const SpanContext &span_context)
   {
     char trace_parent[kTraceParentSize];
-    trace_parent[0] = '0';
-    trace_parent[1] = '0';
-    trace_parent[2] = '-';
-    span_context.trace_id().ToLowerBase16(
-        nostd::span<char, 2 * TraceId::kSize>{&trace_parent[3], kTraceIdSize});
-    trace_parent[kTraceIdSize + 3] = '-';
-    span_context.span_id().ToLowerBase16(
-        nostd::span<char, 2 * SpanId::kSize>{&trace_parent[kTraceIdSize + 4], kSpanIdSize});
-    trace_parent[kTraceIdSize + kSpanIdSize + 4] = '-';
-    span_context.trace_flags().ToLowerBase16(
-        nostd::span<char, 2>{&trace_parent[kTraceIdSize + kSpanIdSize + 5], 2});
+    trace_parent[0]                  = '0';
+    trace_parent[1]                  = '0';
+    trace_parent[kTraceIdOffset - 1] = '-';
+    detail::EncodeLowerHex(span_context.trace_id().Id().data(), TraceId::kSize,
+                           &trace_parent[kTraceIdOffset]);
+    trace_parent[kSpanIdOffset - 1] = '-';
+    detail::EncodeLowerHex(span_context.span_id().Id().data(), SpanId::kSize,
+                           &trace_parent[kSpanIdOffset]);
+    trace_parent[kTraceFlagsOffset - 1] = '-';
+    uint8_t flags = span_context.trace_flags().flags();
+    detail::EncodeLowerHex(&flags, 1, &trace_parent[kTraceFlagsOffset]);
 
     carrier.Set(kTraceParent, nostd::string_view(trace_parent, sizeof(trace_parent)));
     const auto trace_state = span_context.trace_state()->ToHeader();
@@ -110,48 +107,35 @@ class HttpTraceContext : public opentelemetry::context::propagation::TextMapProp
   static SpanContext ExtractContextFromTraceHeaders(nostd::string_view trace_parent,
                                                     nostd::string_view trace_state)
   {
-    if (trace_parent.size() != kTraceParentSize)
-    {
-      return SpanContext::GetInvalid();
-    }
-
-    std::array<nostd::string_view, 4> fields{};
-    if (detail::SplitString(trace_parent, '-', fields.data(), 4) != 4)
+    // The fields have fixed widths, so they are decoded in place rather than split.
+    if (trace_parent.size() != kTraceParentSize || trace_parent[kTraceIdOffset - 1] != '-' ||
+        trace_parent[kSpanIdOffset - 1] != '-' || trace_parent[kTraceFlagsOffset - 1] != '-')
     {
       return SpanContext::GetInvalid();
     }
 
-    nostd::string_view version_hex     = fields[0];
-    nostd::string_view trace_id_hex    = fields[1];
-    nostd::string_view span_id_hex     = fields[2];
-    nostd::string_view trace_flags_hex = fields[3];
-
-    if (version_hex.size() != kVersionSize || trace_id_hex.size() != kTraceIdSize ||
-        span_id_hex.size() != kSpanIdSize || trace_flags_hex.size() != kTraceFlagsSize)
-    {
-      return SpanContext::GetInvalid();
-    }
-
-    if (!detail::IsValidHex(version_hex) || !detail::IsValidHex(trace_id_hex) ||
-        !detail::IsValidHex(span_id_hex) || !detail::IsValidHex(trace_flags_hex))
-    {
-      return SpanContext::GetInvalid();
-    }
-
-    if (!IsValidVersion(version_hex))
+    const char *data = trace_parent.data();
+    uint8_t version;
+    uint8_t trace_id[TraceId::kSize];
+    uint8_t span_id[SpanId::kSize];
+    uint8_t flags;
+    bool valid = detail::DecodeHexFixed(data, &version, 1);
+    valid &= detail::DecodeHexFixed(data + kTraceIdOffset, trace_id, sizeof(trace_id));
+    valid &= detail::DecodeHexFixed(data + kSpanIdOffset, span_id, sizeof(span_id));
+    valid &= detail::DecodeHexFixed(data + kTraceFlagsOffset, &flags, 1);
+    if (!valid || version == kInvalidVersion)
     {
       return SpanContext::GetInvalid();
     }
 
-    TraceId trace_id = TraceIdFromHex(trace_id_hex);
-    SpanId span_id   = SpanIdFromHex(span_id_hex);
-
-    if (!trace_id.IsValid() || !span_id.IsValid())
+    TraceId trace_id_obj(trace_id);
+    SpanId span_id_obj(span_id);
+    if (!trace_id_obj.IsValid() || !span_id_obj.IsValid())
     {
       return SpanContext::GetInvalid();
     }
 
-    return SpanContext(trace_id, span_id, TraceFlagsFromHex(trace_flags_hex), true,
+    return SpanContext(trace_id_obj, span_id_obj, TraceFlags(flags), true,
                        opentelemetry::trace::TraceState::FromHeader(trace_state));
   }
 
@@ -34,11 +34,10 @@ class JaegerPropagator : public context::propagation::TextMapPropagator
 
     // trace-id(32):span-id(16):0:debug(2)
     char trace_identity[trace_id_length + span_id_length + 6];
-    span_context.trace_id().ToLowerBase16(
-        nostd::span<char, 2 * TraceId::kSize>{&trace_identity[0], trace_id_length});
+    detail::EncodeLowerHex(span_context.trace_id().Id().data(), TraceId::kSize, &trace_identity[0]);
     trace_identity[trace_id_length] = ':';
-    span_context.span_id().ToLowerBase16(
-        nostd::span<char, 2 * SpanId::kSize>{&trace_identity[trace_id_length + 1], span_id_length});
+    detail::EncodeLowerHex(span_context.span_id().Id().data(), SpanId::kSize,
+                           &trace_identity[trace_id_length + 1]);
     trace_identity[trace_id_length + span_id_length + 1] = ':';
     trace_identity[trace_id_length + span_id_length + 2] = '0';
     trace_identity[trace_id_length + span_id_length + 3] = ':';
@@ -87,26 +86,20 @@ class JaegerPropagator : public context::propagation::TextMapPropagator
     nostd::string_view span_id_hex  = trace_fields[1];
     nostd::string_view flags_hex    = trace_fields[3];
 
-    if (!detail::IsValidHex(trace_id_hex) || !detail::IsValidHex(span_id_hex) ||
-        !detail::IsValidHex(flags_hex))
-    {
-      return SpanContext::GetInvalid();
-    }
-
     uint8_t trace_id[16];
-    if (!detail::HexToBinary(trace_id_hex, trace_id, sizeof(trace_id)))
+    if (!detail::HexToBinaryIfValid(trace_id_hex, trace_id, sizeof(trace_id)))
     {
       return SpanContext::GetInvalid();
     }
 
     uint8_t span_id[8];
-    if (!detail::HexToBinary(span_id_hex, span_id, sizeof(span_id)))
+    if (!detail::HexToBinaryIfValid(span_id_hex, span_id, sizeof(span_id)))
     {
       return SpanContext::GetInvalid();
     }
 
     uint8_t flags;
-    if (!detail::HexToBinary(flags_hex, &flags, sizeof(flags)))
+    if (!detail::HexToBinaryIfValid(flags_hex, &flags, sizeof(flags)))
     {
       return SpanContext::GetInvalid();
     }
@@ -3,9 +3,9 @@
 
 #pragma once
 
-#include <mutex>
+#include <utility>
 
-#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/common/read_mostly_shared_ptr.h"
 #include "opentelemetry/nostd/shared_ptr.h"
 #include "opentelemetry/trace/noop.h"
 #include "opentelemetry/trace/tracer_provider.h"
@@ -27,8 +27,7 @@ class Provider
    */
   static nostd::shared_ptr<TracerProvider> GetTracerProvider() noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    return nostd::shared_ptr<TracerProvider>(GetProvider());
+    return GetProvider().Load();
   }
 
   /**
@@ -36,22 +35,16 @@ class Provider
    */
   static void SetTracerProvider(nostd::shared_ptr<TracerProvider> tp) noexcept
   {
-    std::lock_guard<common::SpinLockMutex> guard(GetLock());
-    GetProvider() = tp;
+    GetProvider().Store(std::move(tp));
   }
 
 private:
-  static nostd::shared_ptr<TracerProvider> &GetProvider() noexcept
+  static common::ReadMostlySharedPtr<TracerProvider> &GetProvider() noexcept
   {
-    static nostd::shared_ptr<TracerProvider> provider(new NoopTracerProvider);
+    static common::ReadMostlySharedPtr<TracerProvider> provider(
+        nostd::shared_ptr<TracerProvider>(new NoopTracerProvider));
     return provider;
   }
-
-  static common::SpinLockMutex &GetLock() noexcept
-  {
-    static common::SpinLockMutex lock;
-    return lock;
-  }
 };
 
 }  // namespace trace
@@ -26,7 +26,7 @@ class Scope final
    */
   Scope(const nostd::shared_ptr<Span> &span) noexcept
       : token_(context::RuntimeContext::Attach(
-            context::RuntimeContext::GetCurrent().SetValue(kSpanKey, span)))
+            context::RuntimeContext::GetCurrent().SetValue(GetSpanContextKey(), span)))
   {}
 
 private:
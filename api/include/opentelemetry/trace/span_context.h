@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include "opentelemetry/nostd/unique_ptr.h"
 #include "opentelemetry/trace/span_id.h"
 #include "opentelemetry/trace/trace_flags.h"
@@ -31,22 +33,36 @@ class SpanContext final
         span_id_(),
         trace_flags_(opentelemetry::trace::TraceFlags((uint8_t)sampled_flag)),
         is_remote_(is_remote),
-        trace_state_(TraceState::GetDefault())
+        trace_state_()
   {}
 
   SpanContext(TraceId trace_id,
               SpanId span_id,
               TraceFlags trace_flags,
               bool is_remote,
-              nostd::shared_ptr<TraceState> trace_state = TraceState::GetDefault()) noexcept
+              nostd::shared_ptr<TraceState> trace_state = nostd::shared_ptr<TraceState>()) noexcept
       : trace_id_(trace_id),
         span_id_(span_id),
         trace_flags_(trace_flags),
         is_remote_(is_remote),
-        trace_state_(trace_state)
+        trace_state_(std::move(trace_state))
+  {}
+
+  /**
+   * Creates the context of a local child span of `parent`, which shares the trace id and the
+   * trace state of `parent`. A parent without trace state is the common case, in which the child
+   * is created without touching any reference count.
+   */
+  SpanContext(const SpanContext &parent, SpanId span_id, TraceFlags trace_flags) noexcept
+      : trace_id_(parent.trace_id_),
+        span_id_(span_id),
+        trace_flags_(trace_flags),
+        is_remote_(false),
+        trace_state_(parent.trace_state_)
   {}
 
   SpanContext(const SpanContext &ctx) = default;
+  SpanContext(SpanContext &&ctx)      = default;
 
   // @returns whether this context is valid
   bool IsValid() const noexcept { return trace_id_.IsValid() && span_id_.IsValid(); }
@@ -63,7 +79,7 @@ class SpanContext final
   // @returns the trace_state associated with this span_context
   const nostd::shared_ptr<opentelemetry::trace::TraceState> trace_state() const noexcept
   {
-    return trace_state_;
+    return trace_state_ ? trace_state_ : TraceState::GetDefault();
   }
 
   /*
@@ -78,6 +94,7 @@ class SpanContext final
   }
 
   SpanContext &operator=(const SpanContext &ctx) = default;
+  SpanContext &operator=(SpanContext &&ctx)      = default;
 
   bool IsRemote() const noexcept { return is_remote_; }
 
@@ -90,6 +107,8 @@ class SpanContext final
   opentelemetry::trace::SpanId span_id_;
   opentelemetry::trace::TraceFlags trace_flags_;
   bool is_remote_;
+  // Null for the default, empty trace state, so that span contexts without any are copied without
+  // reference counting.
   nostd::shared_ptr<opentelemetry::trace::TraceState> trace_state_;
 };
 }  // namespace trace
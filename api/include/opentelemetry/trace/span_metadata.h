@@ -4,6 +4,7 @@
 #pragma once
 
 #include "opentelemetry/common/timestamp.h"
+#include "opentelemetry/context/context_key.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace trace
@@ -21,6 +22,14 @@ enum class SpanKind
 // The key identifies the active span in the current context.
 constexpr char kSpanKey[] = "active_span";
 
+// Interned kSpanKey. The function returns the same object in every translation unit, so that
+// contexts recognize the key by address.
+inline const context::ContextKey &GetSpanContextKey() noexcept
+{
+  static constexpr context::ContextKey key{"active_span"};
+  return key;
+}
+
 // StatusCode - Represents the canonical set of status codes of a finished Span.
 enum class StatusCode
 {
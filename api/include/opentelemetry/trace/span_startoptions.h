@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "opentelemetry/context/context.h"
 #include "opentelemetry/trace/span_context.h"
 #include "opentelemetry/trace/span_metadata.h"
@@ -35,10 +37,29 @@ struct StartSpanOptions
   // automatically parented to the currently active span.
   nostd::variant<SpanContext, opentelemetry::context::Context> parent = SpanContext::GetInvalid();
 
+  // Parents the Span on `parent` only, never on the currently active span.
+  //
+  // A Span whose parent is invalid then starts a new trace, and SDKs need not
+  // read the runtime context at all, which asynchronous code carrying the
+  // parents of its Spans itself saves the cost of.
+  bool ignore_active_span = false;
+
   // TODO:
   // SpanContext remote_parent;
   // Links
   SpanKind kind = SpanKind::kInternal;
+
+  // Marks a Span which is only ever used by one thread at a time.
+  //
+  // SDKs may then skip the synchronization of calls to the Span. Using a
+  // single-owner Span from several threads concurrently is undefined behavior.
+  bool single_owner = false;
+
+  // The number of attributes and events the Span is expected to end up with,
+  // including the attributes it is started with. SDKs may reserve room for them
+  // once, rather than growing their storage as they are added. 0 means unknown.
+  size_t expected_attributes = 0;
+  size_t expected_events     = 0;
 };
 
 }  // namespace trace
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <cstring>
 
+#include "opentelemetry/common/hex.h"
 #include "opentelemetry/nostd/span.h"
 #include "opentelemetry/version.h"
 
@@ -34,12 +35,7 @@ class TraceId final
   // Populates the buffer with the lowercase base16 representation of the ID.
   void ToLowerBase16(nostd::span<char, 2 * kSize> buffer) const noexcept
   {
-    constexpr char kHex[] = "0123456789abcdef";
-    for (int i = 0; i < kSize; ++i)
-    {
-      buffer[i * 2 + 0] = kHex[(rep_[i] >> 4) & 0xF];
-      buffer[i * 2 + 1] = kHex[(rep_[i] >> 0) & 0xF];
-    }
+    common::EncodeLowerHex(rep_, kSize, buffer.data());
   }
 
   // Returns a nostd::span of the ID.
@@ -5,20 +5,13 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 
-#include <regex>
-#if (__GNUC__ == 4 && (__GNUC_MINOR__ == 8 || __GNUC_MINOR__ == 9))
-#  define HAVE_WORKING_REGEX 0
-#else
-#  define HAVE_WORKING_REGEX 1
-#endif
-
 #include "opentelemetry/common/kv_properties.h"
 #include "opentelemetry/nostd/shared_ptr.h"
 #include "opentelemetry/nostd/span.h"
 #include "opentelemetry/nostd/string_view.h"
-#include "opentelemetry/nostd/unique_ptr.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace trace
@@ -31,6 +24,10 @@ namespace trace
  *
  * For more information, see the W3C Trace Context specification:
  * https://www.w3.org/TR/trace-context
+ *
+ * A TraceState is immutable and shares its entries with the TraceState it was derived from:
+ * Set() and Delete() add a layer holding the change in front of the layers they share, rather than
+ * copying every entry, e.g. when a sampler records its decision in the trace state of each span.
  */
 class TraceState
 {
@@ -63,27 +60,33 @@ class TraceState
       cnt = kMaxKeyValuePairs;
     }
 
-    nostd::shared_ptr<TraceState> ts(new TraceState(cnt));
+    // Only validate the members here. The TraceState keeps the header and reads the members from
+    // it on access, so that no entry is copied for headers that are merely propagated.
+    size_t num_entries    = 0;
+    size_t canonical_size = 0;
     bool kv_valid;
     nostd::string_view key, value;
-    while (kv_str_tokenizer.next(kv_valid, key, value) && ts->kv_properties_->Size() < cnt)
+    while (num_entries < cnt && kv_str_tokenizer.next(kv_valid, key, value))
     {
-      if (kv_valid == false)
+      if (kv_valid == false || !IsValidKey(key) || !IsValidValue(value))
       {
+        // invalid header. return empty TraceState
         return GetDefault();
       }
 
-      if (!IsValidKey(key) || !IsValidValue(value))
-      {
-        // invalid header. return empty TraceState
-        ts->kv_properties_.reset(new opentelemetry::common::KeyValueProperties());
-        break;
-      }
+      canonical_size += (num_entries == 0 ? 0 : 1) + key.size() + 1 + value.size();
+      ++num_entries;
+    }
 
-      ts->kv_properties_->AddEntry(key, value);
+    if (num_entries == 0)
+    {
+      return GetDefault();
     }
 
-    return ts;
+    // The header is canonical if it holds nothing but the members and their separators, in which
+    // case ToHeader() can return it unchanged.
+    return nostd::shared_ptr<TraceState>(new TraceState(
+        CreateHeaderLayer(header, num_entries, canonical_size == header.size()), num_entries));
   }
 
   /**
@@ -91,23 +94,27 @@ class TraceState
    */
   std::string ToHeader() const noexcept
   {
+    if (layer_ != nullptr && layer_->depth == 0 && layer_->header_is_canonical)
+    {
+      return layer_->header;
+    }
+
     std::string header_s;
     bool first = true;
-    kv_properties_->GetAllEntries(
-        [&header_s, &first](nostd::string_view key, nostd::string_view value) noexcept {
-          if (!first)
-          {
-            header_s.append(",");
-          }
-          else
-          {
-            first = false;
-          }
-          header_s.append(std::string(key.data(), key.size()));
-          header_s.append(1, kKeyValueSeparator);
-          header_s.append(std::string(value.data(), value.size()));
-          return true;
-        });
+    GetAllEntries([&header_s, &first](nostd::string_view key, nostd::string_view value) noexcept {
+      if (!first)
+      {
+        header_s.append(",");
+      }
+      else
+      {
+        first = false;
+      }
+      header_s.append(key.data(), key.size());
+      header_s.append(1, kKeyValueSeparator);
+      header_s.append(value.data(), value.size());
+      return true;
+    });
     return header_s;
   }
 
@@ -122,7 +129,35 @@ class TraceState
       return false;
     }
 
-    return kv_properties_->GetValue(key, value);
+    for (const Layer *layer = layer_.get(); layer != nullptr; layer = layer->base.get())
+    {
+      if (layer->depth == 0)
+      {
+        common::KeyValueStringTokenizer kv_str_tokenizer(layer->header);
+        bool kv_valid;
+        nostd::string_view e_key, e_value;
+        for (size_t i = 0;
+             i < layer->num_header_entries && kv_str_tokenizer.next(kv_valid, e_key, e_value); ++i)
+        {
+          if (e_key == key)
+          {
+            value.assign(e_value.data(), e_value.size());
+            return true;
+          }
+        }
+        return false;
+      }
+      if (nostd::string_view(layer->key) == key)
+      {
+        if (layer->value.empty())
+        {
+          return false;
+        }
+        value = layer->value;
+        return true;
+      }
+    }
+    return false;
   }
 
   /**
@@ -134,33 +169,25 @@ class TraceState
    * tracecontext specification, empty TraceState instance will be returned.
    *
    * If the existing object has maximum list members, it's copy is returned.
+   *
+   * The returned object shares the entries of this one rather than copying them.
    */
   nostd::shared_ptr<TraceState> Set(const nostd::string_view &key,
                                     const nostd::string_view &value) noexcept
   {
-    auto curr_size = kv_properties_->Size();
     if (!IsValidKey(key) || !IsValidValue(value))
     {
       // max size reached or invalid key/value. Returning empty TraceState
       return TraceState::GetDefault();
     }
-    auto allocate_size = curr_size;
-    if (curr_size < kMaxKeyValuePairs)
-    {
-      allocate_size += 1;
-    }
-    nostd::shared_ptr<TraceState> ts(new TraceState(allocate_size));
-    if (curr_size < kMaxKeyValuePairs)
+    std::string unused;
+    bool update = Get(key, unused);
+    if (size_ >= kMaxKeyValuePairs && !update)
     {
-      // add new field first
-      ts->kv_properties_->AddEntry(key, value);
+      return nostd::shared_ptr<TraceState>(new TraceState(layer_, size_));
     }
-    // add rest of the fields.
-    kv_properties_->GetAllEntries([&ts](nostd::string_view key, nostd::string_view value) {
-      ts->kv_properties_->AddEntry(key, value);
-      return true;
-    });
-    return ts;
+    return nostd::shared_ptr<TraceState>(
+        new TraceState(CreateEntryLayer(key, value), update ? size_ : size_ + 1));
   }
 
   /**
@@ -175,32 +202,57 @@ class TraceState
     {
       return TraceState::GetDefault();
     }
-    auto curr_size     = kv_properties_->Size();
-    auto allocate_size = curr_size;
     std::string unused;
-    if (kv_properties_->GetValue(key, unused))
+    if (!Get(key, unused))
     {
-      allocate_size -= 1;
+      return nostd::shared_ptr<TraceState>(new TraceState(layer_, size_));
     }
-    nostd::shared_ptr<TraceState> ts(new TraceState(allocate_size));
-    kv_properties_->GetAllEntries(
-        [&ts, &key](nostd::string_view e_key, nostd::string_view e_value) {
-          if (key != e_key)
-            ts->kv_properties_->AddEntry(e_key, e_value);
-          return true;
-        });
-    return ts;
+    if (size_ == 1)
+    {
+      return TraceState::GetDefault();
+    }
+    return nostd::shared_ptr<TraceState>(new TraceState(CreateEntryLayer(key, ""), size_ - 1));
   }
 
   // Returns true if there are no keys, false otherwise.
-  bool Empty() const noexcept { return kv_properties_->Size() == 0; }
+  bool Empty() const noexcept { return size_ == 0; }
 
   // @return all key-values entris by repeatedly invoking the function reference passed as argument
   // for each entry
   bool GetAllEntries(
       nostd::function_ref<bool(nostd::string_view, nostd::string_view)> callback) const noexcept
   {
-    return kv_properties_->GetAllEntries(callback);
+    // The keys of the layers above, whose entries in the layers below are replaced or deleted.
+    nostd::string_view shadowed[kMaxLayerDepth];
+    size_t num_shadowed = 0;
+    for (const Layer *layer = layer_.get(); layer != nullptr; layer = layer->base.get())
+    {
+      if (layer->depth == 0)
+      {
+        common::KeyValueStringTokenizer kv_str_tokenizer(layer->header);
+        bool kv_valid;
+        nostd::string_view key, value;
+        for (size_t i = 0;
+             i < layer->num_header_entries && kv_str_tokenizer.next(kv_valid, key, value); ++i)
+        {
+          if (!IsShadowed(key, shadowed, num_shadowed) && !callback(key, value))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+      if (IsShadowed(layer->key, shadowed, num_shadowed))
+      {
+        continue;
+      }
+      if (!layer->value.empty() && !callback(layer->key, layer->value))
+      {
+        return false;
+      }
+      shadowed[num_shadowed++] = layer->key;
+    }
+    return true;
   }
   /** Returns whether key is a valid key. See https://www.w3.org/TR/trace-context/#key
    * Identifiers MUST begin with a lowercase letter or a digit, and can only contain
@@ -211,11 +263,34 @@ class TraceState
    */
   static bool IsValidKey(nostd::string_view key)
   {
-#if HAVE_WORKING_REGEX
-    return IsValidKeyRegEx(key);
-#else
-    return IsValidKeyNonRegEx(key);
-#endif
+    if (key.empty() || key.size() > kKeyMaxSize)
+    {
+      return false;
+    }
+
+    size_t at = nostd::string_view::npos;
+    for (size_t i = 0; i < key.size(); i++)
+    {
+      if (CharClass(key[i]) & kKeyChar)
+      {
+        continue;
+      }
+      if (key[i] != '@' || at != nostd::string_view::npos)
+      {
+        return false;
+      }
+      at = i;
+    }
+
+    if (at == nostd::string_view::npos)
+    {
+      return (CharClass(key[0]) & kKeyStartChar) != 0;
+    }
+
+    // A multi-tenant key is a tenant of up to 241 characters, '@' and a vendor of up to 14
+    // characters, both beginning with a lowercase letter or a digit.
+    return at > 0 && at <= 241 && key.size() - at - 1 >= 1 && key.size() - at - 1 <= 14 &&
+           (CharClass(key[0]) & kKeyStartChar) && (CharClass(key[at + 1]) & kKeyStartChar);
   }
 
   /** Returns whether value is a valid value. See https://www.w3.org/TR/trace-context/#value
@@ -224,97 +299,138 @@ class TraceState
    */
   static bool IsValidValue(nostd::string_view value)
   {
-#if HAVE_WORKING_REGEX
-    return IsValidValueRegEx(value);
-#else
-    return IsValidValueNonRegEx(value);
-#endif
-  }
-
-private:
-  TraceState() : kv_properties_(new opentelemetry::common::KeyValueProperties()){};
-  TraceState(size_t size) : kv_properties_(new opentelemetry::common::KeyValueProperties(size)){};
-
-  static nostd::string_view TrimString(nostd::string_view str, size_t left, size_t right)
-  {
-    while (str[static_cast<std::size_t>(right)] == ' ' && left < right)
+    if (value.empty() || value.size() > kValueMaxSize || value[value.size() - 1] == ' ')
     {
-      right--;
-    }
-    while (str[static_cast<std::size_t>(left)] == ' ' && left < right)
-    {
-      left++;
+      return false;
     }
-    return str.substr(left, right - left + 1);
-  }
 
-  static bool IsValidKeyRegEx(nostd::string_view key)
-  {
-    static std::regex reg_key("^[a-z0-9][a-z0-9*_\\-/]{0,255}$");
-    static std::regex reg_key_multitenant(
-        "^[a-z0-9][a-z0-9*_\\-/]{0,240}(@)[a-z0-9][a-z0-9*_\\-/]{0,13}$");
-    std::string key_s(key.data(), key.size());
-    if (std::regex_match(key_s, reg_key) || std::regex_match(key_s, reg_key_multitenant))
+    for (const char c : value)
     {
-      return true;
+      if (!(CharClass(c) & kValueChar))
+      {
+        return false;
+      }
     }
-    return false;
+    return true;
   }
 
-  static bool IsValidValueRegEx(nostd::string_view value)
+private:
+  // The number of layers holding a single entry above a header, past which Set() and Delete()
+  // merge the layers into a new header, so that lookups walk a bounded number of layers.
+  static constexpr int kMaxLayerDepth = 8;
+
+  // An immutable set of entries, shared by the TraceState objects derived from one another.
+  struct Layer
+  {
+    // 0 for a layer holding the members of a header, e.g. parsed by FromHeader(); otherwise the
+    // number of layers holding a single entry, this one and those below it.
+    int depth = 0;
+
+    // The header, for a depth of 0.
+    std::string header;
+    size_t num_header_entries = 0;
+    bool header_is_canonical  = false;
+
+    // The entry in front of the entries of `base`, which replaces the entry of `base` with the
+    // same key, or deletes it if `value` is empty.
+    std::string key;
+    std::string value;
+    nostd::shared_ptr<Layer> base;
+  };
+
+  TraceState() noexcept = default;
+  TraceState(nostd::shared_ptr<Layer> layer, size_t size) noexcept
+      : layer_(std::move(layer)), size_(size)
+  {}
+
+  static nostd::shared_ptr<Layer> CreateHeaderLayer(nostd::string_view header,
+                                                    size_t num_entries,
+                                                    bool header_is_canonical)
   {
-    // Hex 0x20 to 0x2B, 0x2D to 0x3C, 0x3E to 0x7E
-    static std::regex reg_value(
-        "^[\\x20-\\x2B\\x2D-\\x3C\\x3E-\\x7E]{0,255}[\\x21-\\x2B\\x2D-\\x3C\\x3E-\\x7E]$");
-    // Need to benchmark without regex, as a string object is created here.
-    return std::regex_match(std::string(value.data(), value.size()), reg_value);
+    std::shared_ptr<Layer> layer = std::make_shared<Layer>();
+    layer->header.assign(header.data(), header.size());
+    layer->num_header_entries  = num_entries;
+    layer->header_is_canonical = header_is_canonical;
+    return nostd::shared_ptr<Layer>(std::move(layer));
   }
 
-  static bool IsValidKeyNonRegEx(nostd::string_view key)
+  // Returns a layer holding `key` and `value`, or deleting `key` if `value` is empty, in front of
+  // the entries of this object.
+  nostd::shared_ptr<Layer> CreateEntryLayer(nostd::string_view key, nostd::string_view value) const
   {
-    if (key.empty() || key.size() > kKeyMaxSize || !IsLowerCaseAlphaOrDigit(key[0]))
+    nostd::shared_ptr<Layer> base = layer_;
+    if (base != nullptr && base->depth >= kMaxLayerDepth)
     {
-      return false;
+      std::string header = ToHeader();
+      base               = CreateHeaderLayer(header, size_, true);
     }
+    std::shared_ptr<Layer> layer = std::make_shared<Layer>();
+    layer->depth                 = (base != nullptr ? base->depth : 0) + 1;
+    layer->key.assign(key.data(), key.size());
+    layer->value.assign(value.data(), value.size());
+    layer->base = std::move(base);
+    return nostd::shared_ptr<Layer>(std::move(layer));
+  }
 
-    int ats = 0;
-
-    for (const char c : key)
+  static bool IsShadowed(nostd::string_view key,
+                         const nostd::string_view *shadowed,
+                         size_t num_shadowed) noexcept
+  {
+    for (size_t i = 0; i < num_shadowed; ++i)
     {
-      if (!IsLowerCaseAlphaOrDigit(c) && c != '_' && c != '-' && c != '@' && c != '*' && c != '/')
+      if (shadowed[i] == key)
       {
-        return false;
-      }
-      if ((c == '@') && (++ats > 1))
-      {
-        return false;
+        return true;
       }
     }
-    return true;
+    return false;
   }
 
-  static bool IsValidValueNonRegEx(nostd::string_view value)
+  static nostd::string_view TrimString(nostd::string_view str, size_t left, size_t right)
   {
-    if (value.empty() || value.size() > kValueMaxSize)
+    while (str[static_cast<std::size_t>(right)] == ' ' && left < right)
     {
-      return false;
+      right--;
     }
-
-    for (const char c : value)
+    while (str[static_cast<std::size_t>(left)] == ' ' && left < right)
     {
-      if (c < ' ' || c > '~' || c == ',' || c == '=')
-      {
-        return false;
-      }
+      left++;
     }
-    return true;
+    return str.substr(left, right - left + 1);
   }
 
-  static bool IsLowerCaseAlphaOrDigit(char c) { return isdigit(c) || islower(c); }
+  // Character classes of the key and value grammars.
+  static constexpr uint8_t kKeyChar      = 1;  // a-z 0-9 _ - * /
+  static constexpr uint8_t kKeyStartChar = 2;  // a-z 0-9
+  static constexpr uint8_t kValueChar    = 4;  // 0x20-0x7E except , and =
+
+  static uint8_t CharClass(char c) noexcept
+  {
+    static const uint8_t kCharClasses[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x00
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x10
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 4, 0, 5, 4, 5,  // 0x20
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 4, 4, 4, 0, 4, 4,  // 0x30
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,  // 0x40
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5,  // 0x50
+        4, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,  // 0x60
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 4, 4, 4, 4, 0,  // 0x70
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x80
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x90
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xA0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xB0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xC0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xD0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xE0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xF0
+    };
+    return kCharClasses[static_cast<unsigned char>(c)];
+  }
 
 private:
-  // Store entries in a C-style array to avoid using std::array or std::vector.
-  nostd::unique_ptr<opentelemetry::common::KeyValueProperties> kv_properties_;
+  // The top layer of the entries, null for an empty TraceState.
+  nostd::shared_ptr<Layer> layer_;
+  size_t size_ = 0;
 };
 }  // namespace trace
 OPENTELEMETRY_END_NAMESPACE
@@ -48,6 +48,21 @@ class Tracer
     return this->StartSpan(name, {}, {}, options);
   }
 
+  /**
+   * Starts a child of `parent`, or the root span of a new trace if `parent` is invalid, without
+   * reading the active span from the runtime context: for event loops and other asynchronous code,
+   * which know the parents of their spans. Like every other overload, it does not make the span
+   * active.
+   */
+  nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
+                                    const SpanContext &parent,
+                                    StartSpanOptions options = {}) noexcept
+  {
+    options.parent             = parent;
+    options.ignore_active_span = true;
+    return this->StartSpan(name, {}, {}, options);
+  }
+
   template <class T,
             nostd::enable_if_t<common::detail::is_key_value_iterable<T>::value> * = nullptr>
   nostd::shared_ptr<Span> StartSpan(nostd::string_view name,
@@ -153,15 +168,23 @@ class Tracer
    */
   static nostd::shared_ptr<Span> GetCurrentSpan() noexcept
   {
-    context::ContextValue active_span = context::RuntimeContext::GetValue(kSpanKey);
-    if (nostd::holds_alternative<nostd::shared_ptr<Span>>(active_span))
+    nostd::shared_ptr<Span> active_span = context::RuntimeContext::GetActiveSpan();
+    if (active_span)
     {
-      return nostd::get<nostd::shared_ptr<Span>>(active_span);
-    }
-    else
-    {
-      return nostd::shared_ptr<Span>(new DefaultSpan(SpanContext::GetInvalid()));
+      return active_span;
     }
+    return nostd::shared_ptr<Span>(new DefaultSpan(SpanContext::GetInvalid()));
+  }
+
+  /**
+   * Get the span context of the currently active span, e.g. to correlate a log record with it.
+   * Unlike GetCurrentSpan()->GetContext(), it allocates no default span when none is active.
+   * @return the span context of the active span, or an invalid span context if no span is
+   * active.
+   */
+  static SpanContext GetCurrentSpanContext() noexcept
+  {
+    return context::RuntimeContext::GetActiveSpanContext();
   }
 
   /**
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/baggage/baggage.h"
+#include "opentelemetry/common/kv_properties.h"
 #include "opentelemetry/nostd/string_view.h"
 
 #include <benchmark/benchmark.h>
@@ -41,6 +42,28 @@ void BM_CreateBaggageFromTenEntries(benchmark::State &state)
 }
 BENCHMARK(BM_CreateBaggageFromTenEntries);
 
+// FromHeader() defers parsing to the first access, GetAllEntries() forces it.
+void BM_CreateAndReadBaggageFromTenEntries(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(kNumEntries);
+  while (state.KeepRunning())
+  {
+    auto baggage = Baggage::FromHeader(header);
+    baggage->GetAllEntries([](nostd::string_view key, nostd::string_view value) { return true; });
+  }
+}
+BENCHMARK(BM_CreateAndReadBaggageFromTenEntries);
+
+void BM_PropagateBaggageFromTenEntries(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(kNumEntries);
+  while (state.KeepRunning())
+  {
+    auto new_header = Baggage::FromHeader(header)->ToHeader();
+  }
+}
+BENCHMARK(BM_PropagateBaggageFromTenEntries);
+
 void BM_ExtractBaggageHavingTenEntries(benchmark::State &state)
 {
   auto baggage = Baggage::FromHeader(header_with_custom_entries(kNumEntries));
@@ -51,6 +74,34 @@ void BM_ExtractBaggageHavingTenEntries(benchmark::State &state)
 }
 BENCHMARK(BM_ExtractBaggageHavingTenEntries);
 
+// A typical inbound request, whose entries take one allocation for the keys and values.
+void BM_CreateAndReadBaggageFrom30Entries(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(30);
+  while (state.KeepRunning())
+  {
+    auto baggage = Baggage::FromHeader(header);
+    baggage->GetAllEntries([](nostd::string_view key, nostd::string_view value) { return true; });
+  }
+}
+BENCHMARK(BM_CreateAndReadBaggageFrom30Entries);
+
+void BM_CopyPropertiesWith30Entries(benchmark::State &state)
+{
+  opentelemetry::common::KeyValueProperties properties(30);
+  for (size_t i = 0; i < 30; i++)
+  {
+    properties.AddEntry("ADecentlyLargekey" + std::to_string(i),
+                        "ADecentlyLargeValue" + std::to_string(i));
+  }
+  while (state.KeepRunning())
+  {
+    opentelemetry::common::KeyValueProperties copy(properties);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_CopyPropertiesWith30Entries);
+
 void BM_CreateBaggageFrom180Entries(benchmark::State &state)
 {
   std::string header = header_with_custom_entries(Baggage::kMaxKeyValuePairs);
@@ -61,6 +112,27 @@ void BM_CreateBaggageFrom180Entries(benchmark::State &state)
 }
 BENCHMARK(BM_CreateBaggageFrom180Entries);
 
+void BM_CreateAndReadBaggageFrom180Entries(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(Baggage::kMaxKeyValuePairs);
+  while (state.KeepRunning())
+  {
+    auto baggage = Baggage::FromHeader(header);
+    baggage->GetAllEntries([](nostd::string_view key, nostd::string_view value) { return true; });
+  }
+}
+BENCHMARK(BM_CreateAndReadBaggageFrom180Entries);
+
+void BM_PropagateBaggageFrom180Entries(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(Baggage::kMaxKeyValuePairs);
+  while (state.KeepRunning())
+  {
+    auto new_header = Baggage::FromHeader(header)->ToHeader();
+  }
+}
+BENCHMARK(BM_PropagateBaggageFrom180Entries);
+
 void BM_ExtractBaggageWith180Entries(benchmark::State &state)
 {
   auto baggage = Baggage::FromHeader(header_with_custom_entries(Baggage::kMaxKeyValuePairs));
@@ -216,3 +216,23 @@ TEST(BaggageTest, BaggageGetAll)
         return true;
       });
 }
+
+TEST(BaggageTest, UnmodifiedHeaderRoundTrip)
+{
+  struct
+  {
+    const char *input;
+    const char *expected;
+  } testcases[] = {
+      {"k1=v1,k2=,k3=v.3~_-", "k1=v1,k2=,k3=v.3~_-"},          // emitted unchanged
+      {" k1 = v1 ,,k2=v2", "k1=v1,k2=v2"},                     // trimmed
+      {"k1=v1,invalidmember,k2=v2", "k1=v1,k2=v2"},            // invalid member is dropped
+      {"k1=bar+1,k2=%61", "k1=bar+1,k2=a"},                    // decoded and encoded again
+      {"k1=v1;metadata", "k1=v1;metadata"},                    // metadata is kept
+      {"k1=v1=v2", ""},                                        // value not valid
+  };
+  for (auto &testcase : testcases)
+  {
+    EXPECT_EQ(Baggage::FromHeader(testcase.input)->ToHeader(), testcase.expected);
+  }
+}
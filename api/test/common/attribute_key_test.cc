@@ -0,0 +1,55 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/common/attribute_key.h"
+#include "opentelemetry/trace/experimental_semantic_conventions.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using opentelemetry::common::AttributeKey;
+namespace nostd = opentelemetry::nostd;
+
+namespace
+{
+uint64_t Fnv1a(nostd::string_view str)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : str)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+TEST(AttributeKeyTest, CompileTime)
+{
+  constexpr AttributeKey key("http.method", 3);
+  static_assert(key.name().size() == 11, "size is computed at compile time");
+  static_assert(key.hash() == AttributeKey::Hash("http.method"),
+                "hash is computed at compile time");
+  static_assert(key.id() == 3, "id is set at compile time");
+  EXPECT_EQ(key.name(), "http.method");
+  EXPECT_EQ(key.hash(), Fnv1a("http.method"));
+}
+
+TEST(AttributeKeyTest, NoId)
+{
+  constexpr AttributeKey key("custom.key");
+  EXPECT_TRUE(key.id() == AttributeKey::kNoId);
+  EXPECT_EQ(key.hash(), Fnv1a("custom.key"));
+
+  constexpr AttributeKey empty("");
+  EXPECT_TRUE(empty.name().empty());
+  EXPECT_EQ(empty.hash(), Fnv1a(""));
+}
+
+TEST(AttributeKeyTest, ConvertsToStringView)
+{
+  nostd::string_view key = opentelemetry::trace::attribute_keys::kHttpMethod;
+  EXPECT_EQ(key, "http.method");
+  EXPECT_EQ(std::string(OTEL_GET_TRACE_ATTR(AttrHttpMethod)), std::string(key.data(), key.size()));
+}
@@ -0,0 +1,100 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/common/hex.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using opentelemetry::common::DecodeHex;
+using opentelemetry::common::DecodeHexScalar;
+using opentelemetry::common::EncodeLowerHex;
+using opentelemetry::common::EncodeLowerHexScalar;
+
+TEST(HexTest, EncodeMatchesScalar)
+{
+  std::vector<uint8_t> bytes(256);
+  for (size_t i = 0; i < bytes.size(); i++)
+  {
+    bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+  // Every size up to a few blocks, so that the vector and the scalar tails are both covered.
+  for (size_t size = 0; size <= 40; size++)
+  {
+    for (size_t offset = 0; offset + size <= bytes.size(); offset += size + 1)
+    {
+      std::string expected(2 * size, '\0');
+      std::string actual(2 * size, '\0');
+      EncodeLowerHexScalar(&bytes[offset], size, &expected[0]);
+      EncodeLowerHex(&bytes[offset], size, &actual[0]);
+      ASSERT_EQ(actual, expected) << "size " << size << ", offset " << offset;
+    }
+  }
+
+  const uint8_t id[] = {0x00, 0x09, 0x0a, 0x0f, 0x10, 0x9a, 0xf0, 0xff};
+  char hex[17]       = {0};
+  EncodeLowerHex(id, sizeof(id), hex);
+  EXPECT_EQ(std::string(hex), "00090a0f109af0ff");
+}
+
+TEST(HexTest, DecodeRoundTrips)
+{
+  std::vector<uint8_t> bytes(256);
+  for (size_t i = 0; i < bytes.size(); i++)
+  {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+  std::string hex(2 * bytes.size(), '\0');
+  EncodeLowerHex(bytes.data(), bytes.size(), &hex[0]);
+
+  std::vector<uint8_t> decoded(bytes.size());
+  ASSERT_TRUE(DecodeHex(hex.data(), bytes.size(), decoded.data()));
+  EXPECT_EQ(decoded, bytes);
+
+  // Upper case digits decode the same.
+  for (char &c : hex)
+  {
+    c = static_cast<char>(std::toupper(c));
+  }
+  std::fill(decoded.begin(), decoded.end(), 0);
+  ASSERT_TRUE(DecodeHex(hex.data(), bytes.size(), decoded.data()));
+  EXPECT_EQ(decoded, bytes);
+
+  uint8_t span_id[8];
+  ASSERT_TRUE(DecodeHex("00f067aa0ba902b7", sizeof(span_id), span_id));
+  const uint8_t expected[] = {0x00, 0xf0, 0x67, 0xaa, 0x0b, 0xa9, 0x02, 0xb7};
+  EXPECT_EQ(std::vector<uint8_t>(span_id, span_id + 8),
+            std::vector<uint8_t>(expected, expected + 8));
+}
+
+TEST(HexTest, DecodeRejectsEveryNonHexCharacter)
+{
+  const size_t kSizes[] = {1, 8, 16, 20};
+  for (size_t size : kSizes)
+  {
+    std::string valid(2 * size, 'a');
+    for (size_t position = 0; position < valid.size(); position++)
+    {
+      for (int c = 0; c < 256; c++)
+      {
+        std::string hex = valid;
+        hex[position]   = static_cast<char>(c);
+        bool is_hex =
+            (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        std::vector<uint8_t> scalar(size);
+        std::vector<uint8_t> decoded(size);
+        ASSERT_EQ(DecodeHexScalar(hex.data(), size, scalar.data()), is_hex);
+        ASSERT_EQ(DecodeHex(hex.data(), size, decoded.data()), is_hex)
+            << "size " << size << ", position " << position << ", character " << c;
+        if (is_hex)
+        {
+          ASSERT_EQ(decoded, scalar);
+        }
+      }
+    }
+  }
+}
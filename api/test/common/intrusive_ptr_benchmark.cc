@@ -0,0 +1,92 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/common/intrusive_ptr.h"
+#include "opentelemetry/nostd/shared_ptr.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using opentelemetry::common::IntrusivePtr;
+using opentelemetry::common::MakeIntrusive;
+using opentelemetry::common::RefCounted;
+namespace nostd = opentelemetry::nostd;
+
+class Object : public RefCounted
+{
+public:
+  int value = 0;
+};
+
+// Copies and destroys a pointer, as when passing a tracer or a span handle by value.
+template <class Ptr>
+void Copy(benchmark::State &state, const Ptr &ptr)
+{
+  for (auto _ : state)
+  {
+    Ptr copy(ptr);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+void BM_NostdSharedPtrCopy(benchmark::State &state)
+{
+  Copy(state, nostd::shared_ptr<Object>(new Object));
+}
+BENCHMARK(BM_NostdSharedPtrCopy)->ThreadRange(1, 4);
+
+void BM_IntrusivePtrCopy(benchmark::State &state)
+{
+  Copy(state, MakeIntrusive<Object>());
+}
+BENCHMARK(BM_IntrusivePtrCopy)->ThreadRange(1, 4);
+
+// Moves a pointer back and forth, as when returning one from a function.
+template <class Ptr>
+void Move(benchmark::State &state, Ptr ptr)
+{
+  for (auto _ : state)
+  {
+    Ptr moved(std::move(ptr));
+    ptr = std::move(moved);
+    benchmark::DoNotOptimize(ptr);
+  }
+}
+
+void BM_NostdSharedPtrMove(benchmark::State &state)
+{
+  Move(state, nostd::shared_ptr<Object>(new Object));
+}
+BENCHMARK(BM_NostdSharedPtrMove);
+
+void BM_IntrusivePtrMove(benchmark::State &state)
+{
+  Move(state, MakeIntrusive<Object>());
+}
+BENCHMARK(BM_IntrusivePtrMove);
+
+template <class Ptr>
+void Dereference(benchmark::State &state, const Ptr &ptr)
+{
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(ptr->value);
+  }
+}
+
+void BM_NostdSharedPtrDereference(benchmark::State &state)
+{
+  Dereference(state, nostd::shared_ptr<Object>(new Object));
+}
+BENCHMARK(BM_NostdSharedPtrDereference);
+
+void BM_IntrusivePtrDereference(benchmark::State &state)
+{
+  Dereference(state, MakeIntrusive<Object>());
+}
+BENCHMARK(BM_IntrusivePtrDereference);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/common/intrusive_ptr.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using opentelemetry::common::IntrusivePtr;
+using opentelemetry::common::MakeIntrusive;
+using opentelemetry::common::RefCounted;
+
+namespace
+{
+class A : public RefCounted
+{
+public:
+  explicit A(bool &destructed) : destructed_{destructed} { destructed_ = false; }
+
+  ~A() override { destructed_ = true; }
+
+private:
+  bool &destructed_;
+};
+
+class B : public A
+{
+public:
+  using A::A;
+};
+}  // namespace
+
+TEST(IntrusivePtrTest, DefaultConstruction)
+{
+  IntrusivePtr<A> ptr;
+  EXPECT_EQ(ptr.get(), nullptr);
+  EXPECT_FALSE(ptr);
+  EXPECT_EQ(ptr, nullptr);
+  EXPECT_EQ(ptr.use_count(), 0);
+}
+
+TEST(IntrusivePtrTest, Destruction)
+{
+  bool destructed;
+  {
+    auto ptr = MakeIntrusive<A>(destructed);
+    EXPECT_EQ(ptr.use_count(), 1);
+    EXPECT_FALSE(destructed);
+  }
+  EXPECT_TRUE(destructed);
+}
+
+TEST(IntrusivePtrTest, CopyAndMove)
+{
+  bool destructed;
+  auto ptr1 = MakeIntrusive<A>(destructed);
+  A *value  = ptr1.get();
+
+  IntrusivePtr<A> ptr2(ptr1);
+  EXPECT_EQ(ptr1, ptr2);
+  EXPECT_EQ(ptr1.use_count(), 2);
+
+  IntrusivePtr<A> ptr3(std::move(ptr2));
+  EXPECT_EQ(ptr2, nullptr);
+  EXPECT_EQ(ptr3.get(), value);
+  EXPECT_EQ(ptr1.use_count(), 2);
+
+  ptr2 = ptr3;
+  EXPECT_EQ(ptr1.use_count(), 3);
+  ptr3 = nullptr;
+  EXPECT_EQ(ptr1.use_count(), 2);
+  ptr2.reset();
+  EXPECT_EQ(ptr1.use_count(), 1);
+
+  EXPECT_FALSE(destructed);
+  ptr1.reset();
+  EXPECT_TRUE(destructed);
+}
+
+TEST(IntrusivePtrTest, RawPointer)
+{
+  bool destructed;
+  auto ptr1 = MakeIntrusive<A>(destructed);
+
+  // The count is in the object, so a raw pointer can be turned back into an owning pointer.
+  IntrusivePtr<A> ptr2(ptr1.get());
+  EXPECT_EQ(ptr1.use_count(), 2);
+  ptr1.reset();
+  EXPECT_FALSE(destructed);
+  ptr2.reset();
+  EXPECT_TRUE(destructed);
+}
+
+TEST(IntrusivePtrTest, Conversion)
+{
+  bool destructed;
+  IntrusivePtr<B> ptr1 = MakeIntrusive<B>(destructed);
+  IntrusivePtr<A> ptr2(ptr1);
+  EXPECT_EQ(ptr1, ptr2);
+  EXPECT_EQ(ptr2.use_count(), 2);
+
+  IntrusivePtr<A> ptr3(std::move(ptr1));
+  EXPECT_EQ(ptr1, nullptr);
+  EXPECT_EQ(ptr3.use_count(), 2);
+
+  ptr2 = IntrusivePtr<B>();
+  ptr3 = IntrusivePtr<B>();
+  EXPECT_TRUE(destructed);
+}
+
+TEST(IntrusivePtrTest, ConcurrentCopies)
+{
+  bool destructed;
+  auto ptr = MakeIntrusive<A>(destructed);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([ptr]() {
+      for (int j = 0; j < 10000; ++j)
+      {
+        IntrusivePtr<A> copy(ptr);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(ptr.use_count(), 1);
+  EXPECT_FALSE(destructed);
+}
@@ -233,3 +233,32 @@ TEST(KeyValueProperties, GetAllEntries)
 
   EXPECT_EQ(index, kNumPairs);
 }
+
+TEST(KeyValueProperties, GrowAndCopy)
+{
+  // The arena is reserved for one short entry, and grows for the others.
+  auto kv_properties = KeyValueProperties(30, 4);
+  for (int i = 0; i < 30; i++)
+  {
+    kv_properties.AddEntry("key" + std::to_string(i), i % 2 ? "" : "value" + std::to_string(i));
+  }
+  KeyValueProperties copy(kv_properties);
+  kv_properties.AddEntry("k", "v");  // entry will not be added as max size reached.
+  EXPECT_EQ(copy.Size(), 30);
+  EXPECT_EQ(copy.ArenaSize(), kv_properties.ArenaSize());
+
+  int index = 0;
+  copy.GetAllEntries([&index](nostd::string_view key, nostd::string_view value) {
+    EXPECT_EQ(key, "key" + std::to_string(index));
+    EXPECT_EQ(value, index % 2 ? "" : "value" + std::to_string(index));
+    index++;
+    return true;
+  });
+  EXPECT_EQ(index, 30);
+
+  copy = KeyValueProperties();
+  EXPECT_EQ(copy.Size(), 0);
+  std::string value;
+  EXPECT_TRUE(kv_properties.GetValue("key28", value));
+  EXPECT_EQ(value, "value28");
+}
@@ -0,0 +1,76 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <opentelemetry/common/read_mostly_shared_ptr.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using opentelemetry::common::ReadMostlySharedPtr;
+namespace nostd = opentelemetry::nostd;
+
+namespace
+{
+struct Counted
+{
+  explicit Counted(int value, std::atomic<int> &live) : value(value), live(live) { ++live; }
+  ~Counted() { --live; }
+
+  int value;
+  std::atomic<int> &live;
+};
+}  // namespace
+
+TEST(ReadMostlySharedPtrTest, LoadAndStore)
+{
+  std::atomic<int> live{0};
+  ReadMostlySharedPtr<Counted> ptr(nostd::shared_ptr<Counted>(new Counted(1, live)));
+  EXPECT_EQ(ptr.Load()->value, 1);
+
+  auto first = ptr.Load();
+  ptr.Store(nostd::shared_ptr<Counted>(new Counted(2, live)));
+  EXPECT_EQ(ptr.Load()->value, 2);
+  // A loaded pointer keeps its object alive, which Store() otherwise releases.
+  EXPECT_EQ(live, 2);
+  EXPECT_EQ(first->value, 1);
+  first = nullptr;
+  EXPECT_EQ(live, 1);
+
+  ptr.Store(nostd::shared_ptr<Counted>(new Counted(3, live)));
+  EXPECT_EQ(live, 1);
+  EXPECT_EQ(ptr.Load()->value, 3);
+}
+
+TEST(ReadMostlySharedPtrTest, ConcurrentLoadsAndStores)
+{
+  std::atomic<int> live{0};
+  ReadMostlySharedPtr<Counted> ptr(nostd::shared_ptr<Counted>(new Counted(0, live)));
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+  {
+    readers.emplace_back([&] {
+      int last = 0;
+      while (!done)
+      {
+        int value = ptr.Load()->value;
+        // Stores are seen in order.
+        EXPECT_GE(value, last);
+        last = value;
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i)
+  {
+    ptr.Store(nostd::shared_ptr<Counted>(new Counted(i, live)));
+  }
+  done = true;
+  for (auto &reader : readers)
+  {
+    reader.join();
+  }
+  EXPECT_EQ(ptr.Load()->value, 1000);
+  EXPECT_EQ(live, 1);
+}
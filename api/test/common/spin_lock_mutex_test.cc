@@ -0,0 +1,69 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <opentelemetry/common/spin_lock_mutex.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using opentelemetry::common::SpinLockMutex;
+
+TEST(SpinLockMutexTest, TryLock)
+{
+  SpinLockMutex mutex;
+  EXPECT_TRUE(mutex.try_lock());
+  EXPECT_FALSE(mutex.try_lock());
+  mutex.unlock();
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST(SpinLockMutexTest, ExcludesThreads)
+{
+  SpinLockMutex mutex;
+  int64_t value = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 16; ++i)
+  {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 10000; ++j)
+      {
+        std::lock_guard<SpinLockMutex> guard(mutex);
+        ++value;
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(value, 160000);
+}
+
+TEST(SpinLockMutexTest, WakesParkedThreads)
+{
+  // The lock is held long enough for the waiting threads to stop spinning and park.
+  SpinLockMutex mutex;
+  mutex.lock();
+  int value = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&] {
+      std::lock_guard<SpinLockMutex> guard(mutex);
+      ++value;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  mutex.unlock();
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(value, 4);
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
@@ -92,7 +92,7 @@ static void BM_ProcYieldSpinLockThrashing(benchmark::State &s)
 #  else
           __builtin_ia32_pause();
 #  endif
-#elif defined(__arm__)
+#elif defined(__arm__) || defined(__aarch64__)
           __asm__ volatile("yield" ::: "memory");
 #endif
         }
@@ -100,6 +100,14 @@ static void BM_ProcYieldSpinLockThrashing(benchmark::State &s)
       [](SpinLockMutex &m) { m.unlock(); });
 }
 
+// std::mutex, for comparison.
+static void BM_StdMutexThrashing(benchmark::State &s)
+{
+  std::mutex mutex;
+  SpinThrash(
+      s, mutex, [](std::mutex &m) { m.lock(); }, [](std::mutex &m) { m.unlock(); });
+}
+
 // SpinLock thrashing with thread::yield().
 static void BM_ThreadYieldSpinLockThrashing(benchmark::State &s)
 {
@@ -121,28 +129,35 @@ static void BM_ThreadYieldSpinLockThrashing(benchmark::State &s)
       [](std::atomic_flag &l) { l.clear(std::memory_order_release); });
 }
 
-// Run the benchmarks at 2x thread/core and measure the amount of time to thrash around.
+// Run the benchmarks from 1 to 64 threads, beyond the number of cores on most machines, and
+// measure the amount of time to thrash around.
 BENCHMARK(BM_SpinLockThrashing)
     ->RangeMultiplier(2)
-    ->Range(1, std::thread::hardware_concurrency())
+    ->Range(1, 64)
     ->MeasureProcessCPUTime()
     ->UseRealTime()
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_ProcYieldSpinLockThrashing)
     ->RangeMultiplier(2)
-    ->Range(1, std::thread::hardware_concurrency())
+    ->Range(1, 64)
     ->MeasureProcessCPUTime()
     ->UseRealTime()
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_NaiveSpinLockThrashing)
     ->RangeMultiplier(2)
-    ->Range(1, std::thread::hardware_concurrency())
+    ->Range(1, 64)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdMutexThrashing)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
     ->MeasureProcessCPUTime()
     ->UseRealTime()
     ->Unit(benchmark::kMillisecond);
 BENCHMARK(BM_ThreadYieldSpinLockThrashing)
     ->RangeMultiplier(2)
-    ->Range(1, std::thread::hardware_concurrency())
+    ->Range(1, 64)
     ->MeasureProcessCPUTime()
     ->UseRealTime()
     ->Unit(benchmark::kMillisecond);
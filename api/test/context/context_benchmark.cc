@@ -0,0 +1,99 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/baggage/baggage_context.h"
+#include "opentelemetry/context/context.h"
+#include "opentelemetry/context/context_snapshot.h"
+#include "opentelemetry/context/runtime_context.h"
+#include "opentelemetry/trace/span_metadata.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry;
+
+namespace
+{
+
+context::Context CreateContext()
+{
+  std::map<std::string, context::ContextValue> values = {{"key", (int64_t)1}};
+  return context::Context(values);
+}
+
+// Attach and detach a context, as a Scope does for every active span.
+void BM_RuntimeContextAttachDetach(benchmark::State &state)
+{
+  context::Context test_context = CreateContext();
+  while (state.KeepRunning())
+  {
+    auto token = context::RuntimeContext::Attach(test_context);
+    benchmark::DoNotOptimize(token);
+  }
+}
+BENCHMARK(BM_RuntimeContextAttachDetach);
+
+// Attach and detach a stack of contexts, innermost first.
+void BM_RuntimeContextNestedAttachDetach(benchmark::State &state)
+{
+  context::Context test_context = CreateContext();
+  while (state.KeepRunning())
+  {
+    auto outer  = context::RuntimeContext::Attach(test_context);
+    auto middle = context::RuntimeContext::Attach(test_context);
+    auto inner  = context::RuntimeContext::Attach(test_context);
+    benchmark::DoNotOptimize(inner);
+  }
+}
+BENCHMARK(BM_RuntimeContextNestedAttachDetach);
+
+// Restore a captured context around a task, as an executor does for every task it runs.
+void BM_ContextSnapshotScope(benchmark::State &state)
+{
+  context::ContextSnapshot snapshot(CreateContext());
+  while (state.KeepRunning())
+  {
+    context::ContextSnapshot::Scope scope(snapshot);
+    benchmark::DoNotOptimize(&scope);
+  }
+}
+BENCHMARK(BM_ContextSnapshotScope);
+
+void BM_RuntimeContextGetCurrent(benchmark::State &state)
+{
+  auto token = context::RuntimeContext::Attach(CreateContext());
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(context::RuntimeContext::GetCurrent());
+  }
+}
+BENCHMARK(BM_RuntimeContextGetCurrent);
+
+void BM_ContextGetValue(benchmark::State &state)
+{
+  context::Context test_context = CreateContext();
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(test_context.GetValue("key"));
+  }
+}
+BENCHMARK(BM_ContextGetValue);
+
+// Look up the active span of a context also holding baggage, as instrumentation does per call.
+void BM_ContextGetSpanKey(benchmark::State &state)
+{
+  context::Context test_context = CreateContext()
+                                      .SetValue(baggage::GetBaggageContextKey(), (int64_t)2)
+                                      .SetValue(trace::GetSpanContextKey(), (int64_t)3);
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(test_context.GetValue(trace::GetSpanContextKey()));
+  }
+}
+BENCHMARK(BM_ContextGetSpanKey);
+
+}  // namespace
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/context/context_snapshot.h"
+#include "opentelemetry/context/context.h"
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <thread>
+
+using namespace opentelemetry;
+
+// A storage which does not support Enter(), as custom storages written before it.
+class AttachOnlyContextStorage : public context::RuntimeContextStorage
+{
+public:
+  context::Context GetCurrent() noexcept override { return storage_.GetCurrent(); }
+
+  nostd::unique_ptr<context::Token> Attach(const context::Context &context) noexcept override
+  {
+    ++attach_count;
+    return storage_.Attach(context);
+  }
+
+  bool Detach(context::Token &token) noexcept override { return storage_.Detach(token); }
+
+  static int attach_count;
+
+private:
+  context::ThreadLocalContextStorage storage_;
+};
+
+int AttachOnlyContextStorage::attach_count = 0;
+
+// Tests that a scope makes the captured context current, and restores the previous one
+TEST(ContextSnapshotTest, Scope)
+{
+  context::Context outer_context = context::Context("key", (int64_t)1);
+  auto outer_token               = context::RuntimeContext::Attach(outer_context);
+  context::ContextSnapshot snapshot;
+  EXPECT_EQ(snapshot.GetContext(), outer_context);
+
+  context::Context inner_context = context::Context("key", (int64_t)2);
+  nostd::unique_ptr<context::Token> leaked;
+  {
+    context::ContextSnapshot::Scope scope(context::ContextSnapshot{inner_context});
+    EXPECT_EQ(context::RuntimeContext::GetCurrent(), inner_context);
+    {
+      context::ContextSnapshot::Scope nested(snapshot);
+      EXPECT_EQ(context::RuntimeContext::GetCurrent(), outer_context);
+    }
+    EXPECT_EQ(context::RuntimeContext::GetCurrent(), inner_context);
+
+    // Contexts attached within the scope and not detached are popped with it.
+    leaked = context::RuntimeContext::Attach(context::Context("key", (int64_t)3));
+  }
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), outer_context);
+}
+
+// Tests that a wrapped task runs with the context of the submitting thread
+TEST(ContextSnapshotTest, WrapWithCurrentContext)
+{
+  context::Context test_context = context::Context("key", (int64_t)1);
+  auto token                    = context::RuntimeContext::Attach(test_context);
+
+  std::function<int64_t(int64_t)> task =
+      context::WrapWithCurrentContext([](int64_t offset) -> int64_t {
+        return nostd::get<int64_t>(context::RuntimeContext::GetValue("key")) + offset;
+      });
+
+  int64_t result = 0;
+  std::thread worker([&] {
+    result = task(10);
+    // The context of the worker is left as it was.
+    EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+  });
+  worker.join();
+  EXPECT_EQ(result, 11);
+  EXPECT_EQ(task(20), 21);
+}
+
+// Tests that storages without Enter() fall back to tokens
+TEST(ContextSnapshotTest, AttachFallback)
+{
+  context::RuntimeContext::SetRuntimeContextStorage(
+      nostd::shared_ptr<context::RuntimeContextStorage>(new AttachOnlyContextStorage()));
+  context::Context test_context = context::Context("key", (int64_t)1);
+  {
+    context::ContextSnapshot::Scope scope(context::ContextSnapshot{test_context});
+    EXPECT_EQ(context::RuntimeContext::GetCurrent(), test_context);
+    EXPECT_EQ(AttachOnlyContextStorage::attach_count, 1);
+  }
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+  context::RuntimeContext::SetRuntimeContextStorage(
+      nostd::shared_ptr<context::RuntimeContextStorage>(new context::ThreadLocalContextStorage()));
+}
@@ -4,6 +4,8 @@
 #include "opentelemetry/context/context.h"
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -145,3 +147,38 @@ TEST(ContextTest, ContextDiffCompare)
   context::Context foo_test                             = context::Context(map_foo);
   EXPECT_FALSE(context_test == foo_test);
 }
+
+// Tests that interned keys and string keys designate the same entries
+TEST(ContextTest, ContextKeyMatchesStringKey)
+{
+  constexpr context::ContextKey test_key{"test_key"};
+  context::Context context_test = context::Context(test_key, (int64_t)123);
+  EXPECT_EQ(nostd::get<int64_t>(context_test.GetValue("test_key")), 123);
+  EXPECT_TRUE(context_test.HasKey(test_key));
+
+  context_test = context_test.SetValue("test_key", (int64_t)456);
+  EXPECT_EQ(nostd::get<int64_t>(context_test.GetValue(test_key)), 456);
+  EXPECT_FALSE(context_test.HasKey(context::ContextKey("foo_key")));
+}
+
+// Tests that values set one by one, over several nodes, are all found and shadow older ones
+TEST(ContextTest, ContextManyValues)
+{
+  std::vector<context::Context> contexts{context::Context()};
+  for (int64_t i = 0; i < 10; i++)
+  {
+    contexts.push_back(contexts.back().SetValue(std::to_string(i % 6), i));
+  }
+  for (size_t i = 1; i < contexts.size(); i++)
+  {
+    // Older contexts are not modified by the later values.
+    EXPECT_EQ(nostd::get<int64_t>(contexts[i].GetValue(std::to_string((i - 1) % 6))),
+              static_cast<int64_t>(i - 1));
+    EXPECT_EQ(contexts[i].HasKey(std::to_string(i % 6)), i >= 6);
+  }
+  for (int64_t key = 0; key < 6; key++)
+  {
+    int64_t expected = key < 4 ? key + 6 : key;
+    EXPECT_EQ(nostd::get<int64_t>(contexts.back().GetValue(std::to_string(key))), expected);
+  }
+}
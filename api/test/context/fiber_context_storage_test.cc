@@ -0,0 +1,73 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/context/fiber_context_storage.h"
+#include "opentelemetry/context/context.h"
+
+#include <gtest/gtest.h>
+
+using namespace opentelemetry;
+
+class FiberContextStorageTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    context::RuntimeContext::SetRuntimeContextStorage(
+        nostd::shared_ptr<context::RuntimeContextStorage>(new context::FiberContextStorage()));
+  }
+
+  void TearDown() override
+  {
+    context::RuntimeContext::SetRuntimeContextStorage(
+        nostd::shared_ptr<context::RuntimeContextStorage>(
+            new context::ThreadLocalContextStorage()));
+  }
+};
+
+// Tests that fibers sharing a thread each see the contexts they attached
+TEST_F(FiberContextStorageTest, ContextsPerFiber)
+{
+  context::Context first_context  = context::Context("fiber", (int64_t)1);
+  context::Context second_context = context::Context("fiber", (int64_t)2);
+  context::FiberContextStorage::Stack first_fiber;
+  context::FiberContextStorage::Stack second_fiber;
+
+  EXPECT_EQ(context::FiberContextStorage::Switch(&first_fiber), nullptr);
+  auto first_token = context::RuntimeContext::Attach(first_context);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), first_context);
+
+  EXPECT_EQ(context::FiberContextStorage::Switch(&second_fiber), &first_fiber);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+  auto second_token = context::RuntimeContext::Attach(second_context);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), second_context);
+
+  context::FiberContextStorage::Switch(&first_fiber);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), first_context);
+  // The token of the other fiber does not detach anything here.
+  EXPECT_FALSE(context::RuntimeContext::Detach(*second_token));
+  first_token.reset();
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+
+  context::FiberContextStorage::Switch(&second_fiber);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), second_context);
+  second_token.reset();
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+
+  EXPECT_EQ(context::FiberContextStorage::Switch(nullptr), &second_fiber);
+}
+
+// Tests that a thread running no fiber uses a stack of its own
+TEST_F(FiberContextStorageTest, ThreadStack)
+{
+  context::Context thread_context = context::Context("thread", (int64_t)1);
+  context::FiberContextStorage::Stack fiber;
+
+  auto token = context::RuntimeContext::Attach(thread_context);
+  context::FiberContextStorage::Switch(&fiber);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+  context::FiberContextStorage::Switch(nullptr);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), thread_context);
+  token.reset();
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+}
@@ -48,6 +48,34 @@ class TextMapCarrierTest : public context::propagation::TextMapCarrier
   std::map<std::string, std::string> headers_;
 };
 
+// A carrier which counts the lookups of its headers, and can hand all of them in a single pass.
+class ForEachTextMapCarrierTest : public TextMapCarrierTest
+{
+public:
+  nostd::string_view Get(nostd::string_view key) const noexcept override
+  {
+    ++get_calls_;
+    return TextMapCarrierTest::Get(key);
+  }
+
+  bool ForEach(nostd::function_ref<bool(nostd::string_view, nostd::string_view)> callback)
+      const noexcept override
+  {
+    ++for_each_calls_;
+    for (auto &header : headers_)
+    {
+      if (!callback(header.first, header.second))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  mutable size_t get_calls_      = 0;
+  mutable size_t for_each_calls_ = 0;
+};
+
 class CompositePropagatorTest : public ::testing::Test
 {
 
@@ -95,6 +123,37 @@ TEST_F(CompositePropagatorTest, Extract)
   EXPECT_EQ(span->GetContext().IsRemote(), true);
 }
 
+TEST_F(CompositePropagatorTest, ExtractInSinglePass)
+{
+  ForEachTextMapCarrierTest carrier;
+  carrier.headers_ = {
+      {"Traceparent", "00-4bf92f3577b34da6a3ce929d0e0e4736-0102030405060708-01"},
+      {"tracestate", "congo=t61rcWkgMzE"},
+      {"B3", "80f198ee56343ba864fe8b2a57d3eff7-e457b5a2e4d86bd1-1-05e3ac9a4f6e3b90"}};
+  context::Context ctx1 = context::Context{};
+
+  context::Context ctx2 = composite_propagator_->Extract(carrier, ctx1);
+  EXPECT_EQ(carrier.for_each_calls_, 1);
+  EXPECT_EQ(carrier.get_calls_, 0);
+
+  auto span = trace::GetSpan(ctx2);
+  EXPECT_EQ(Hex(span->GetContext().trace_id()), "80f198ee56343ba864fe8b2a57d3eff7");
+  EXPECT_EQ(Hex(span->GetContext().span_id()), "e457b5a2e4d86bd1");
+
+  // Keys that are not fields of the propagators, such as the B3 multi-header keys, are still
+  // looked up in the carrier.
+  carrier.headers_ = {{"X-B3-TraceId", "80f198ee56343ba864fe8b2a57d3eff7"},
+                      {"X-B3-SpanId", "e457b5a2e4d86bd1"},
+                      {"X-B3-Sampled", "1"}};
+  ctx2 = composite_propagator_->Extract(carrier, ctx1);
+  EXPECT_EQ(carrier.for_each_calls_, 2);
+  EXPECT_EQ(carrier.get_calls_, 3);
+
+  span = trace::GetSpan(ctx2);
+  EXPECT_EQ(Hex(span->GetContext().trace_id()), "80f198ee56343ba864fe8b2a57d3eff7");
+  EXPECT_EQ(span->GetContext().IsSampled(), true);
+}
+
 TEST_F(CompositePropagatorTest, Inject)
 {
   TextMapCarrierTest carrier;
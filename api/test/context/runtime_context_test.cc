@@ -3,8 +3,10 @@
 
 #include "opentelemetry/context/runtime_context.h"
 #include "opentelemetry/context/context.h"
+#include "opentelemetry/trace/default_span.h"
 
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace opentelemetry;
 
@@ -133,3 +135,66 @@ TEST(RuntimeContextTest, DetachOutOfOrder)
 
   } while (std::next_permutation(indices.begin(), indices.end()));
 }
+
+// Tests that tokens are recycled, including those freed on another thread than the one that
+// created them
+TEST(RuntimeContextTest, TokenReuse)
+{
+  context::Context test_context = context::Context("test_key", (int64_t)123);
+
+  auto token             = context::RuntimeContext::Attach(test_context);
+  context::Token *first  = token.get();
+  token                  = nullptr;
+  token                  = context::RuntimeContext::Attach(test_context);
+  context::Token *second = token.get();
+  EXPECT_EQ(first, second);
+  token = nullptr;
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), context::Context());
+
+  nostd::unique_ptr<context::Token> other_token;
+  std::thread other([&test_context, &other_token]() {
+    other_token = context::RuntimeContext::Attach(test_context);
+    EXPECT_EQ(context::RuntimeContext::GetCurrent(), test_context);
+  });
+  other.join();
+  context::Token *from_other = other_token.get();
+  // Detaching from a thread the context was not attached to fails, but frees the token.
+  other_token = nullptr;
+  token       = context::RuntimeContext::Attach(test_context);
+  EXPECT_EQ(token.get(), from_other);
+  EXPECT_EQ(context::RuntimeContext::GetCurrent(), test_context);
+}
+
+// Tests that the active span IDs are kept in the profiler thread context when it is enabled
+TEST(RuntimeContextTest, ProfilerThreadContext)
+{
+  const uint8_t trace_id_buf[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  const uint8_t span_id_buf[]  = {1, 2, 3, 4, 5, 6, 7, 8};
+  trace::SpanContext span_context(trace::TraceId(trace_id_buf), trace::SpanId(span_id_buf),
+                                  trace::TraceFlags(trace::TraceFlags::kIsSampled), false);
+  nostd::shared_ptr<trace::Span> span(new trace::DefaultSpan(span_context));
+  context::Context span_ctx = context::Context().SetValue(trace::GetSpanContextKey(), span);
+
+  context::ProfilerThreadContext &block = context::GetProfilerThreadContext();
+
+  // Disabled by default.
+  auto token = context::RuntimeContext::Attach(span_ctx);
+  EXPECT_EQ(0, block.valid);
+  token = nullptr;
+
+  context::SetProfilerThreadContextEnabled(true);
+  token = context::RuntimeContext::Attach(span_ctx);
+  EXPECT_EQ(context::kProfilerThreadContextVersion, block.version);
+  EXPECT_EQ(1, block.valid);
+  EXPECT_EQ(span_context.trace_flags().flags(), block.trace_flags);
+  EXPECT_EQ(0, memcmp(trace_id_buf, block.trace_id, sizeof(trace_id_buf)));
+  EXPECT_EQ(0, memcmp(span_id_buf, block.span_id, sizeof(span_id_buf)));
+
+  // Each thread has its own block.
+  std::thread other([]() { EXPECT_EQ(0, context::GetProfilerThreadContext().valid); });
+  other.join();
+
+  token = nullptr;
+  EXPECT_EQ(0, block.valid);
+  context::SetProfilerThreadContextEnabled(false);
+}
@@ -0,0 +1,125 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef ENABLE_LOGS_PREVIEW
+
+// The debug and trace logs are compiled out.
+#  define OTEL_LOG_MIN_SEVERITY OTEL_LOG_SEVERITY_INFO
+
+#  include <gtest/gtest.h>
+#  include <string>
+#  include <vector>
+
+#  include "opentelemetry/logs/log_macros.h"
+#  include "opentelemetry/nostd/shared_ptr.h"
+
+using opentelemetry::logs::Logger;
+using opentelemetry::logs::Severity;
+namespace common = opentelemetry::common;
+namespace nostd  = opentelemetry::nostd;
+namespace trace  = opentelemetry::trace;
+
+namespace
+{
+// Records the logs of a severity at least min_severity.
+class RecordingLogger : public Logger
+{
+public:
+  explicit RecordingLogger(Severity min_severity) : min_severity_(min_severity) {}
+
+  const nostd::string_view GetName() noexcept override { return "recording logger"; }
+
+  bool Enabled(Severity severity) const noexcept override
+  {
+    ++enabled_calls;
+    return severity >= min_severity_;
+  }
+
+  using Logger::Log;
+
+  void Log(Severity severity,
+           nostd::string_view body,
+           const common::KeyValueIterable &attributes,
+           trace::TraceId /* trace_id */,
+           trace::SpanId /* span_id */,
+           trace::TraceFlags /* trace_flags */,
+           common::SystemTimestamp /* timestamp */) noexcept override
+  {
+    severities.push_back(severity);
+    bodies.push_back(std::string(body.data(), body.size()));
+    attribute_counts.push_back(attributes.size());
+  }
+
+  mutable int enabled_calls = 0;
+  std::vector<Severity> severities;
+  std::vector<std::string> bodies;
+  std::vector<size_t> attribute_counts;
+
+private:
+  Severity min_severity_;
+};
+
+std::string Describe(int &evaluations)
+{
+  ++evaluations;
+  return "described";
+}
+}  // namespace
+
+TEST(LogMacros, CompiledOutBelowMinSeverity)
+{
+  EXPECT_FALSE(opentelemetry::logs::IsSeverityCompiledIn(Severity::kTrace));
+  EXPECT_FALSE(opentelemetry::logs::IsSeverityCompiledIn(Severity::kDebug4));
+  EXPECT_TRUE(opentelemetry::logs::IsSeverityCompiledIn(Severity::kInfo));
+
+  nostd::shared_ptr<RecordingLogger> logger(new RecordingLogger(Severity::kTrace));
+  int evaluations = 0;
+  OTEL_LOG_TRACE(logger, Describe(evaluations));
+  OTEL_LOG_DEBUG(logger, Describe(evaluations));
+  OTEL_LOG(logger, Severity::kDebug2, Describe(evaluations));
+
+  // Neither the logger nor the arguments were touched.
+  EXPECT_EQ(0, evaluations);
+  EXPECT_EQ(0, logger->enabled_calls);
+  EXPECT_TRUE(logger->severities.empty());
+}
+
+TEST(LogMacros, ArgumentsEvaluatedOnlyWhenEnabled)
+{
+  nostd::shared_ptr<RecordingLogger> logger(new RecordingLogger(Severity::kWarn));
+  int evaluations = 0;
+  OTEL_LOG_INFO(logger, Describe(evaluations));
+  EXPECT_EQ(0, evaluations);
+  EXPECT_EQ(1, logger->enabled_calls);
+  EXPECT_TRUE(logger->severities.empty());
+
+  OTEL_LOG_WARN(logger, Describe(evaluations));
+  OTEL_LOG_ERROR(logger, "error", {{"key", 1}, {"other", "value"}});
+  OTEL_LOG_FATAL(logger, {{"key", 1}});
+  OTEL_LOG(logger, Severity::kWarn2, "warn2");
+  EXPECT_EQ(1, evaluations);
+
+  ASSERT_EQ(4u, logger->severities.size());
+  EXPECT_EQ(Severity::kWarn, logger->severities[0]);
+  EXPECT_EQ("described", logger->bodies[0]);
+  EXPECT_EQ(Severity::kError, logger->severities[1]);
+  EXPECT_EQ("error", logger->bodies[1]);
+  EXPECT_EQ(2u, logger->attribute_counts[1]);
+  EXPECT_EQ(Severity::kFatal, logger->severities[2]);
+  EXPECT_EQ(1u, logger->attribute_counts[2]);
+  EXPECT_EQ(Severity::kWarn2, logger->severities[3]);
+}
+
+TEST(LogMacros, LoggerEvaluatedOnce)
+{
+  nostd::shared_ptr<RecordingLogger> logger(new RecordingLogger(Severity::kTrace));
+  int lookups = 0;
+  auto get_logger = [&]() -> RecordingLogger * {
+    ++lookups;
+    return logger.get();
+  };
+  OTEL_LOG_INFO(get_logger(), "info");
+  EXPECT_EQ(1, lookups);
+  EXPECT_EQ(1u, logger->severities.size());
+}
+#endif
@@ -31,6 +31,8 @@ TEST(Logger, GetLoggerDefault)
   auto name   = logger->GetName();
   EXPECT_NE(nullptr, logger);
   EXPECT_EQ(name, "noop logger");
+  // The noop logger records nothing
+  EXPECT_FALSE(logger->Enabled(Severity::kFatal));
 }
 
 // Test the two additional overloads for GetLogger()
@@ -110,6 +112,8 @@ TEST(Logger, LogMethodOverloads)
   logger->Fatal("Test log message", {{"key1", "value 1"}, {"key2", 2}});
   logger->Fatal(m);
   logger->Fatal({{"key1", "value 1"}, {"key2", 2}});
+  logger->LogTemplate(Severity::kInfo, "Test log message");
+  logger->LogTemplate(Severity::kInfo, "Test log message {} {} {}", "value 1", 2, 3.0);
 }
 
 // Define a basic Logger class
@@ -19,6 +19,11 @@ TEST(Counter, Add)
   EXPECT_NO_THROW(counter->Add(2l, opentelemetry::context::Context{}));
   EXPECT_NO_THROW(counter->Add(10l, {{"k1", "1"}, {"k2", 2}}));
   EXPECT_NO_THROW(counter->Add(10l, {{"k1", "1"}, {"k2", 2}}, opentelemetry::context::Context{}));
+
+  auto bound_counter = counter->Bind(labels);
+  ASSERT_NE(bound_counter, nullptr);
+  EXPECT_NO_THROW(bound_counter->Add(10l));
+  EXPECT_NO_THROW(counter->Bind({{"k1", "1"}, {"k2", 2}})->Add(10l));
 }
 
 TEST(histogram, Record)
@@ -31,6 +36,10 @@ TEST(histogram, Record)
   EXPECT_NO_THROW(counter->Record(2l, opentelemetry::context::Context{}));
   EXPECT_NO_THROW(
       counter->Record(10l, {{"k1", "1"}, {"k2", 2}}, opentelemetry::context::Context{}));
+
+  auto bound_histogram = counter->Bind(labels);
+  ASSERT_NE(bound_histogram, nullptr);
+  EXPECT_NO_THROW(bound_histogram->Record(10l, opentelemetry::context::Context{}));
 }
 
 TEST(UpDownCountr, Record)
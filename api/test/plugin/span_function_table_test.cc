@@ -0,0 +1,133 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/plugin/span_function_table.h"
+#include "opentelemetry/plugin/tracer.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace opentelemetry;
+
+namespace
+{
+class TestSpan final : public trace::Span
+{
+public:
+  explicit TestSpan(std::string &calls) noexcept : calls_(calls) {}
+
+  void SetAttribute(nostd::string_view key, const common::AttributeValue &) noexcept override
+  {
+    calls_ += "SetAttribute(" + std::string(key) + ") ";
+  }
+
+  void AddEvent(nostd::string_view name) noexcept override
+  {
+    calls_ += "AddEvent(" + std::string(name) + ") ";
+  }
+
+  void AddEvent(nostd::string_view name, common::SystemTimestamp) noexcept override
+  {
+    calls_ += "AddEventAt(" + std::string(name) + ") ";
+  }
+
+  void AddEvent(nostd::string_view name,
+                common::SystemTimestamp,
+                const common::KeyValueIterable &) noexcept override
+  {
+    calls_ += "AddEventWithAttributes(" + std::string(name) + ") ";
+  }
+
+  void SetStatus(trace::StatusCode, nostd::string_view description) noexcept override
+  {
+    calls_ += "SetStatus(" + std::string(description) + ") ";
+  }
+
+  void UpdateName(nostd::string_view name) noexcept override
+  {
+    calls_ += "UpdateName(" + std::string(name) + ") ";
+  }
+
+  void End(const trace::EndSpanOptions &) noexcept override { calls_ += "End "; }
+
+  bool IsRecording() const noexcept override { return true; }
+
+  trace::SpanContext GetContext() const noexcept override
+  {
+    return trace::SpanContext::GetInvalid();
+  }
+
+private:
+  std::string &calls_;
+};
+
+class TestTracer final : public trace::Tracer
+{
+public:
+  explicit TestTracer(std::string &calls) noexcept : calls_(calls) {}
+
+  nostd::shared_ptr<trace::Span> StartSpan(nostd::string_view,
+                                           const common::KeyValueIterable &,
+                                           const trace::SpanContextKeyValueIterable &,
+                                           const trace::StartSpanOptions &) noexcept override
+  {
+    return nostd::shared_ptr<trace::Span>(new TestSpan(calls_));
+  }
+
+  void ForceFlushWithMicroseconds(uint64_t) noexcept override {}
+
+  void CloseWithMicroseconds(uint64_t) noexcept override {}
+
+private:
+  std::string &calls_;
+};
+
+class TestTracerHandle final : public plugin::TracerHandle
+{
+public:
+  explicit TestTracerHandle(std::string &calls) noexcept : tracer_(calls) {}
+
+  trace::Tracer &tracer() const noexcept override { return tracer_; }
+
+private:
+  mutable TestTracer tracer_;
+};
+
+std::string CallSpan(const plugin::SpanFunctionTable *span_functions)
+{
+  std::string calls;
+  std::shared_ptr<trace::Tracer> tracer = std::make_shared<plugin::Tracer>(
+      nullptr, std::unique_ptr<plugin::TracerHandle>(new TestTracerHandle(calls)),
+      span_functions);
+  auto span = tracer->StartSpan("span");
+  span->SetAttribute("key", 1);
+  span->AddEvent("a");
+  span->AddEvent("b", common::SystemTimestamp());
+  span->AddEvent("c", common::SystemTimestamp(), {{"key", 1}});
+  span->SetStatus(trace::StatusCode::kError, "error");
+  span->UpdateName("name");
+  EXPECT_TRUE(span->IsRecording());
+  EXPECT_FALSE(span->GetContext().IsValid());
+  span->End();
+  return calls;
+}
+}  // namespace
+
+TEST(SpanFunctionTableTest, CallsSpan)
+{
+  constexpr plugin::SpanFunctionTable span_functions = plugin::MakeSpanFunctionTable<TestSpan>();
+  EXPECT_EQ(plugin::kSpanFunctionTableVersion, span_functions.version);
+  EXPECT_EQ(
+      "SetAttribute(key) AddEvent(a) AddEventAt(b) AddEventWithAttributes(c) SetStatus(error) "
+      "UpdateName(name) End ",
+      CallSpan(&span_functions));
+}
+
+TEST(SpanFunctionTableTest, VirtualFallback)
+{
+  EXPECT_EQ(
+      "SetAttribute(key) AddEvent(a) AddEventAt(b) AddEventWithAttributes(c) SetStatus(error) "
+      "UpdateName(name) End ",
+      CallSpan(nullptr));
+}
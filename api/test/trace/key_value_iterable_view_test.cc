@@ -66,3 +66,41 @@ TEST(KeyValueIterableViewTest, ForEachKeyValueWithExit)
   EXPECT_EQ(count, 1);
   EXPECT_FALSE(exit);
 }
+
+TEST(KeyValueIterableViewTest, KeyValueArray)
+{
+  static const int32_t codes[]                = {200, 404};
+  static const common::KeyValueArray<3> array = {
+      {common::MakeKeyValue("method", "GET"), common::MakeKeyValue("status", 200),
+       common::MakeKeyValue("codes", nostd::span<const int32_t>(codes))}};
+  EXPECT_TRUE(bool{common::detail::is_key_value_iterable<common::KeyValueArray<3>>::value});
+
+  auto iterable = common::MakeKeyValueIterableView(array);
+  EXPECT_EQ(iterable.size(), 3);
+  size_t index = 0;
+  iterable.ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) noexcept {
+    // Keys and arrays are passed on by reference.
+    EXPECT_EQ(key.data(), array[index].first.data());
+    if (index == 0)
+    {
+      EXPECT_EQ(key, "method");
+    }
+    if (index == 2)
+    {
+      EXPECT_EQ(nostd::get<nostd::span<const int32_t>>(value).data(), codes);
+    }
+    ++index;
+    return true;
+  });
+  EXPECT_EQ(index, 3);
+}
+
+#if __cplusplus >= 201402L
+TEST(KeyValueIterableViewTest, ConstexprKeyValue)
+{
+  static constexpr std::pair<nostd::string_view, common::AttributeValue> kEntry =
+      common::MakeKeyValue("http.status_code", 200);
+  static_assert(kEntry.first.size() == 16, "the key length is computed at compile time");
+  EXPECT_EQ(nostd::get<int>(kEntry.second), 200);
+}
+#endif
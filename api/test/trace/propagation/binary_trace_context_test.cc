@@ -0,0 +1,138 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/trace/propagation/binary_trace_context.h"
+#include "opentelemetry/trace/scope.h"
+#include "util.h"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+using namespace opentelemetry;
+
+namespace
+{
+
+class TextMapCarrierTest : public context::propagation::TextMapCarrier
+{
+public:
+  nostd::string_view Get(nostd::string_view key) const noexcept override
+  {
+    auto it = headers_.find(std::string(key));
+    if (it != headers_.end())
+    {
+      return nostd::string_view(it->second);
+    }
+    return "";
+  }
+  void Set(nostd::string_view key, nostd::string_view value) noexcept override
+  {
+    headers_[std::string(key)] = std::string(value);
+  }
+
+  std::map<std::string, std::string> headers_;
+};
+
+using Propagator = trace::propagation::BinaryTraceContext;
+
+// A header with trace id 4bf92f3577b34da6a3ce929d0e0e4736 and span id 00f067aa0ba902b7.
+std::string ValidHeader(uint8_t options)
+{
+  const uint8_t header[] = {0,    0,    0x4b, 0xf9, 0x2f, 0x35, 0x77, 0xb3, 0x4d, 0xa6,
+                            0xa3, 0xce, 0x92, 0x9d, 0x0e, 0x0e, 0x47, 0x36, 1,    0x00,
+                            0xf0, 0x67, 0xaa, 0x0b, 0xa9, 0x02, 0xb7, 2,    options};
+  return std::string(reinterpret_cast<const char *>(header), sizeof(header));
+}
+
+trace::SpanContext ExtractSpanContext(const std::string &header)
+{
+  TextMapCarrierTest carrier;
+  carrier.headers_ = {{"grpc-trace-bin", header}};
+  context::Context context;
+  return trace::GetSpan(Propagator().Extract(carrier, context))->GetContext();
+}
+
+}  // namespace
+
+TEST(BinaryTraceContextTest, ExtractsValidHeader)
+{
+  auto span_context = ExtractSpanContext(ValidHeader(1));
+  ASSERT_TRUE(span_context.IsValid());
+  EXPECT_EQ(Hex(span_context.trace_id()), "4bf92f3577b34da6a3ce929d0e0e4736");
+  EXPECT_EQ(Hex(span_context.span_id()), "00f067aa0ba902b7");
+  EXPECT_TRUE(span_context.IsSampled());
+  EXPECT_TRUE(span_context.IsRemote());
+
+  EXPECT_FALSE(ExtractSpanContext(ValidHeader(0)).IsSampled());
+  // Unknown option bits are dropped.
+  EXPECT_EQ(ExtractSpanContext(ValidHeader(0xff)).trace_flags().flags(), 1);
+}
+
+TEST(BinaryTraceContextTest, ExtractsOptionalAndUnknownFields)
+{
+  // Without trace options, the span is not sampled.
+  auto span_context = ExtractSpanContext(ValidHeader(1).substr(0, 27));
+  ASSERT_TRUE(span_context.IsValid());
+  EXPECT_FALSE(span_context.IsSampled());
+
+  // Fields of later versions of the layout are ignored.
+  span_context = ExtractSpanContext(ValidHeader(1) + std::string("\x03\x01\x02", 3));
+  ASSERT_TRUE(span_context.IsValid());
+  EXPECT_TRUE(span_context.IsSampled());
+}
+
+TEST(BinaryTraceContextTest, RejectsInvalidHeaders)
+{
+  std::string header = ValidHeader(1);
+  EXPECT_FALSE(ExtractSpanContext("").IsValid());
+  EXPECT_FALSE(ExtractSpanContext(header.substr(0, 26)).IsValid());
+
+  std::string wrong_version = header;
+  wrong_version[0]          = 1;
+  EXPECT_FALSE(ExtractSpanContext(wrong_version).IsValid());
+
+  std::string wrong_field = header;
+  wrong_field[18]         = 2;
+  EXPECT_FALSE(ExtractSpanContext(wrong_field).IsValid());
+
+  std::string zero_trace_id = header;
+  std::fill(zero_trace_id.begin() + 2, zero_trace_id.begin() + 18, '\0');
+  EXPECT_FALSE(ExtractSpanContext(zero_trace_id).IsValid());
+
+  std::string zero_span_id = header;
+  std::fill(zero_span_id.begin() + 19, zero_span_id.begin() + 27, '\0');
+  EXPECT_FALSE(ExtractSpanContext(zero_span_id).IsValid());
+}
+
+TEST(BinaryTraceContextTest, InjectsAndExtractsRoundTrip)
+{
+  constexpr uint8_t buf_span[]  = {1, 2, 3, 4, 5, 6, 7, 8};
+  constexpr uint8_t buf_trace[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  trace::SpanContext span_context{trace::TraceId{buf_trace}, trace::SpanId{buf_span},
+                                  trace::TraceFlags{trace::TraceFlags::kIsSampled}, false};
+  nostd::shared_ptr<trace::Span> span{new trace::DefaultSpan(span_context)};
+  trace::Scope scope(span);
+
+  TextMapCarrierTest carrier;
+  Propagator().Inject(carrier, context::RuntimeContext::GetCurrent());
+  const std::string &header = carrier.headers_["grpc-trace-bin"];
+  ASSERT_EQ(header.size(), 29u);
+  EXPECT_EQ(header.substr(0, 2), std::string("\0\0", 2));
+  EXPECT_EQ(header.substr(2, 16), std::string(buf_trace, buf_trace + 16));
+  EXPECT_EQ(header.substr(18, 1), std::string("\1", 1));
+  EXPECT_EQ(header.substr(19, 8), std::string(buf_span, buf_span + 8));
+  EXPECT_EQ(header.substr(27), std::string("\2\1", 2));
+
+  auto extracted = ExtractSpanContext(header);
+  EXPECT_EQ(extracted, span_context);
+  EXPECT_TRUE(extracted.IsRemote());
+}
+
+TEST(BinaryTraceContextTest, DoesNotInjectInvalidContext)
+{
+  TextMapCarrierTest carrier;
+  context::Context context;
+  Propagator().Inject(carrier, context);
+  EXPECT_TRUE(carrier.headers_.empty());
+}
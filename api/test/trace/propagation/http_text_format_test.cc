@@ -143,6 +143,12 @@ TEST(TextMapPropagatorTest, InvalidIdentitiesAreNotExtracted)
       "00-0af7651916cd43dd8448eb211c80319c1--01",
       "",
       "---",
+      "00-0af7651916cd43dd8448eb211c80319c-b9c7c989f97918e1+01",
+      "00-0af7651916cd43dd8448eb211c80319g-b9c7c989f97918e1-01",
+      "00-0af7651916cd43dd8448eb211c80319c-b9c7c989f97918e--01",
+      "0x-0af7651916cd43dd8448eb211c80319c-b9c7c989f97918e1-01",
+      "00-00000000000000000000000000000000-b9c7c989f97918e1-01",
+      "00-0af7651916cd43dd8448eb211c80319c-0000000000000000-01",
   };
 
   for (auto &trace : traces)
@@ -0,0 +1,140 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/context/context.h"
+#include "opentelemetry/trace/context.h"
+#include "opentelemetry/trace/default_span.h"
+#include "opentelemetry/trace/propagation/b3_propagator.h"
+#include "opentelemetry/trace/propagation/binary_trace_context.h"
+#include "opentelemetry/trace/propagation/http_trace_context.h"
+#include "opentelemetry/trace/propagation/jaeger.h"
+
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry;
+
+namespace
+{
+
+class TextMapCarrierTest : public context::propagation::TextMapCarrier
+{
+public:
+  nostd::string_view Get(nostd::string_view key) const noexcept override
+  {
+    auto it = headers_.find(std::string(key));
+    if (it != headers_.end())
+    {
+      return nostd::string_view(it->second);
+    }
+    return "";
+  }
+  void Set(nostd::string_view key, nostd::string_view value) noexcept override
+  {
+    headers_[std::string(key)] = std::string(value);
+  }
+
+  std::map<std::string, std::string> headers_;
+};
+
+context::Context ContextWithSpan()
+{
+  constexpr uint8_t buf_span[]  = {1, 2, 3, 4, 5, 6, 7, 8};
+  constexpr uint8_t buf_trace[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  trace::SpanContext span_context{trace::TraceId{buf_trace}, trace::SpanId{buf_span},
+                                  trace::TraceFlags{trace::TraceFlags::kIsSampled}, true};
+  nostd::shared_ptr<trace::Span> span{new trace::DefaultSpan(span_context)};
+  context::Context context;
+  return trace::SetSpan(context, span);
+}
+
+void Extract(benchmark::State &state,
+             context::propagation::TextMapPropagator &propagator,
+             const char *header,
+             nostd::string_view value)
+{
+  TextMapCarrierTest carrier;
+  carrier.headers_[header] = std::string(value);
+  context::Context context;
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(propagator.Extract(carrier, context));
+  }
+}
+
+void Inject(benchmark::State &state, context::propagation::TextMapPropagator &propagator)
+{
+  TextMapCarrierTest carrier;
+  auto context = ContextWithSpan();
+  while (state.KeepRunning())
+  {
+    propagator.Inject(carrier, context);
+  }
+}
+
+void BM_HttpTraceContextExtract(benchmark::State &state)
+{
+  trace::propagation::HttpTraceContext propagator;
+  Extract(state, propagator, "traceparent",
+          "00-4bf92f3577b34da6a3ce929d0e0e4736-0102030405060708-01");
+}
+BENCHMARK(BM_HttpTraceContextExtract);
+
+void BM_HttpTraceContextInject(benchmark::State &state)
+{
+  trace::propagation::HttpTraceContext propagator;
+  Inject(state, propagator);
+}
+BENCHMARK(BM_HttpTraceContextInject);
+
+void BM_B3PropagatorExtract(benchmark::State &state)
+{
+  trace::propagation::B3Propagator propagator;
+  Extract(state, propagator, "b3", "80f198ee56343ba864fe8b2a57d3eff7-e457b5a2e4d86bd1-1");
+}
+BENCHMARK(BM_B3PropagatorExtract);
+
+void BM_B3PropagatorInject(benchmark::State &state)
+{
+  trace::propagation::B3Propagator propagator;
+  Inject(state, propagator);
+}
+BENCHMARK(BM_B3PropagatorInject);
+
+void BM_JaegerPropagatorExtract(benchmark::State &state)
+{
+  trace::propagation::JaegerPropagator propagator;
+  Extract(state, propagator, "uber-trace-id",
+          "4bf92f3577b34da6a3ce929d0e0e4736:0102030405060708:0:00");
+}
+BENCHMARK(BM_JaegerPropagatorExtract);
+
+void BM_JaegerPropagatorInject(benchmark::State &state)
+{
+  trace::propagation::JaegerPropagator propagator;
+  Inject(state, propagator);
+}
+BENCHMARK(BM_JaegerPropagatorInject);
+
+void BM_BinaryTraceContextExtract(benchmark::State &state)
+{
+  trace::propagation::BinaryTraceContext propagator;
+  uint8_t header[trace::propagation::BinaryTraceContext::kHeaderSize];
+  trace::propagation::BinaryTraceContext::ToBytes(
+      trace::GetSpan(ContextWithSpan())->GetContext(), header);
+  Extract(state, propagator, "grpc-trace-bin",
+          nostd::string_view(reinterpret_cast<const char *>(header), sizeof(header)));
+}
+BENCHMARK(BM_BinaryTraceContextExtract);
+
+void BM_BinaryTraceContextInject(benchmark::State &state)
+{
+  trace::propagation::BinaryTraceContext propagator;
+  Inject(state, propagator);
+}
+BENCHMARK(BM_BinaryTraceContextInject);
+
+}  // namespace
+BENCHMARK_MAIN();
@@ -49,6 +49,34 @@ void BM_SpanCreationWithScope(benchmark::State &state)
 }
 BENCHMARK(BM_SpanCreationWithScope);
 
+// Test to measure performance for looking up the active span, e.g. for each child span started
+void BM_GetCurrentSpan(benchmark::State &state)
+{
+  auto tracer = initTracer();
+  auto span   = tracer->StartSpan("span");
+  auto scope  = tracer->WithActiveSpan(span);
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(trace_api::Tracer::GetCurrentSpan());
+  }
+  span->End();
+}
+BENCHMARK(BM_GetCurrentSpan);
+
+// Test to measure performance for looking up the active span context, e.g. for each log record
+void BM_GetCurrentSpanContext(benchmark::State &state)
+{
+  auto tracer = initTracer();
+  auto span   = tracer->StartSpan("span");
+  auto scope  = tracer->WithActiveSpan(span);
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(trace_api::Tracer::GetCurrentSpanContext());
+  }
+  span->End();
+}
+BENCHMARK(BM_GetCurrentSpanContext);
+
 // Test to measure performance for nested span creation with scope
 void BM_NestedSpanCreationWithScope(benchmark::State &state)
 {
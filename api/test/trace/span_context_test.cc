@@ -53,3 +53,27 @@ TEST(SpanContextTest, Invalid)
   EXPECT_EQ(s1.trace_id(), trace_api::TraceId());
   EXPECT_EQ(s1.span_id(), trace_api::SpanId());
 }
+
+TEST(SpanContextTest, ChildSharesTraceState)
+{
+  constexpr uint8_t buf_trace[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  constexpr uint8_t buf_span[8]   = {1, 2, 3, 4, 5, 6, 7, 8};
+  constexpr uint8_t buf_child[8]  = {8, 7, 6, 5, 4, 3, 2, 1};
+  auto trace_state                = trace_api::TraceState::FromHeader("k1=v1");
+  SpanContext parent(trace_api::TraceId(buf_trace), trace_api::SpanId(buf_span),
+                     trace_api::TraceFlags(1), true, trace_state);
+
+  SpanContext child(parent, trace_api::SpanId(buf_child), trace_api::TraceFlags(0));
+  EXPECT_EQ(child.trace_id(), parent.trace_id());
+  EXPECT_EQ(child.span_id(), trace_api::SpanId(buf_child));
+  EXPECT_FALSE(child.IsSampled());
+  EXPECT_FALSE(child.IsRemote());
+  EXPECT_EQ(child.trace_state(), trace_state);
+
+  // Without a trace state, the default one is reported.
+  SpanContext no_state(trace_api::TraceId(buf_trace), trace_api::SpanId(buf_span),
+                       trace_api::TraceFlags(1), false);
+  SpanContext no_state_child(no_state, trace_api::SpanId(buf_child), trace_api::TraceFlags(1));
+  EXPECT_EQ(no_state_child.trace_state(), trace_api::TraceState::GetDefault());
+  EXPECT_TRUE(no_state_child.trace_state()->Empty());
+}
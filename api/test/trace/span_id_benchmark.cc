@@ -1,15 +1,21 @@
 // Copyright The OpenTelemetry Authors
 // SPDX-License-Identifier: Apache-2.0
 
+#include "opentelemetry/common/hex.h"
+#include "opentelemetry/trace/propagation/http_trace_context.h"
 #include "opentelemetry/trace/span_id.h"
+#include "opentelemetry/trace/trace_id.h"
 
 #include <benchmark/benchmark.h>
 #include <cstdint>
 
 namespace
 {
+namespace nostd = opentelemetry::nostd;
 using opentelemetry::trace::SpanId;
-constexpr uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+using opentelemetry::trace::TraceId;
+constexpr uint8_t bytes[]       = {1, 2, 3, 4, 5, 6, 7, 8};
+constexpr uint8_t trace_bytes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
 
 void BM_SpanIdDefaultConstructor(benchmark::State &state)
 {
@@ -41,6 +47,79 @@ void BM_SpanIdToLowerBase16(benchmark::State &state)
 }
 BENCHMARK(BM_SpanIdToLowerBase16);
 
+void BM_TraceIdToLowerBase16(benchmark::State &state)
+{
+  TraceId id(trace_bytes);
+  char buf[TraceId::kSize * 2];
+  while (state.KeepRunning())
+  {
+    id.ToLowerBase16(buf);
+    benchmark::DoNotOptimize(buf);
+  }
+}
+BENCHMARK(BM_TraceIdToLowerBase16);
+
+// The scalar conversion the vector kernels replace, for comparison.
+void BM_TraceIdToLowerBase16Scalar(benchmark::State &state)
+{
+  char buf[TraceId::kSize * 2];
+  while (state.KeepRunning())
+  {
+    opentelemetry::common::EncodeLowerHexScalar(trace_bytes, TraceId::kSize, buf);
+    benchmark::DoNotOptimize(buf);
+  }
+}
+BENCHMARK(BM_TraceIdToLowerBase16Scalar);
+
+void BM_TraceIdDecodeHex(benchmark::State &state)
+{
+  const char hex[] = "4bf92f3577b34da6a3ce929d0e0e4736";
+  uint8_t buf[TraceId::kSize];
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(opentelemetry::common::DecodeHex(hex, TraceId::kSize, buf));
+    benchmark::DoNotOptimize(buf);
+  }
+}
+BENCHMARK(BM_TraceIdDecodeHex);
+
+void BM_TraceIdDecodeHexScalar(benchmark::State &state)
+{
+  const char hex[] = "4bf92f3577b34da6a3ce929d0e0e4736";
+  uint8_t buf[TraceId::kSize];
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(opentelemetry::common::DecodeHexScalar(hex, TraceId::kSize, buf));
+    benchmark::DoNotOptimize(buf);
+  }
+}
+BENCHMARK(BM_TraceIdDecodeHexScalar);
+
+// Carries a fixed traceparent header.
+class TraceParentCarrier : public opentelemetry::context::propagation::TextMapCarrier
+{
+public:
+  nostd::string_view Get(nostd::string_view key) const noexcept override
+  {
+    return key == "traceparent" ? "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01" : "";
+  }
+
+  void Set(nostd::string_view, nostd::string_view) noexcept override {}
+};
+
+// Extracts a traceparent header, which decodes a trace id and a span id.
+void BM_TraceParentExtract(benchmark::State &state)
+{
+  opentelemetry::trace::propagation::HttpTraceContext propagator;
+  TraceParentCarrier carrier;
+  opentelemetry::context::Context context;
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(propagator.Extract(carrier, context));
+  }
+}
+BENCHMARK(BM_TraceParentExtract);
+
 void BM_SpanIdIsValid(benchmark::State &state)
 {
   SpanId id(bytes);
@@ -0,0 +1,95 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/trace/trace_state.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+using opentelemetry::trace::TraceState;
+namespace nostd = opentelemetry::nostd;
+
+namespace
+{
+
+std::string header_with_custom_entries(size_t num_entries)
+{
+  std::string header;
+  for (size_t i = 0; i < num_entries; i++)
+  {
+    std::string key   = "vendor" + std::to_string(i) + "@tenant";
+    std::string value = "t61rcWkgMzE-" + std::to_string(i);
+    header += key + "=" + value;
+    if (i != num_entries - 1)
+    {
+      header += ",";
+    }
+  }
+  return header;
+}
+
+void BM_TraceStateIsValidKey(benchmark::State &state)
+{
+  nostd::string_view key = "a*/foo-_/bar@vendor";
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(TraceState::IsValidKey(key));
+  }
+}
+BENCHMARK(BM_TraceStateIsValidKey);
+
+void BM_TraceStateIsValidValue(benchmark::State &state)
+{
+  nostd::string_view value = "00f067aa0ba902b7-t61rcWkgMzE";
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(TraceState::IsValidValue(value));
+  }
+}
+BENCHMARK(BM_TraceStateIsValidValue);
+
+// Inbound requests only parse the header, and propagate it unchanged.
+void BM_TraceStateFromHeader(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(static_cast<size_t>(state.range(0)));
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(TraceState::FromHeader(header));
+  }
+}
+BENCHMARK(BM_TraceStateFromHeader)->Arg(1)->Arg(8)->Arg(32);
+
+void BM_TraceStateFromHeaderToHeader(benchmark::State &state)
+{
+  std::string header = header_with_custom_entries(static_cast<size_t>(state.range(0)));
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(TraceState::FromHeader(header)->ToHeader());
+  }
+}
+BENCHMARK(BM_TraceStateFromHeaderToHeader)->Arg(1)->Arg(8)->Arg(32);
+
+void BM_TraceStateGet(benchmark::State &state)
+{
+  auto trace_state = TraceState::FromHeader(header_with_custom_entries(32));
+  std::string value;
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(trace_state->Get("vendor16@tenant", value));
+  }
+}
+BENCHMARK(BM_TraceStateGet);
+
+void BM_TraceStateSet(benchmark::State &state)
+{
+  auto trace_state = TraceState::FromHeader(header_with_custom_entries(state.range(0)));
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(trace_state->Set("congo", "t61rcWkgMzE"));
+  }
+}
+BENCHMARK(BM_TraceStateSet)->Arg(8)->Arg(31);
+
+}  // namespace
+BENCHMARK_MAIN();
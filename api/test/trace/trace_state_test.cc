@@ -61,6 +61,8 @@ TEST(TraceStateTest, ValidateHeaderParsing)
                    {",k1=v1", "k1=v1"},
                    {",", ""},
                    {",=,", ""},
+                   {" k1=v1 , k2=v2", "k1=v1,k2=v2"},
+                   {"k1=v1,k2=v 2", "k1=v1,k2=v 2"},
                    {"", ""},
                    {max_trace_state_header.data(), max_trace_state_header.data()}};
   for (auto &testcase : testcases)
@@ -102,6 +104,18 @@ TEST(TraceStateTest, TraceStateSet)
   auto ts3           = TraceState::FromHeader(trace_state_header);
   auto ts3_new       = ts3->Set("*n_k1", "n_v1");  // adding invalid key, should return empty
   EXPECT_EQ(ts3_new->ToHeader(), "");
+
+  trace_state_header = "k1=v1,k2=v2";
+  auto ts4           = TraceState::FromHeader(trace_state_header);
+  auto ts4_new       = ts4->Set("k2", "n_v2");  // updated key is moved to the front
+  EXPECT_EQ(ts4_new->ToHeader(), "k2=n_v2,k1=v1");
+
+  trace_state_header = header_with_max_members();
+  auto ts5           = TraceState::FromHeader(trace_state_header);
+  auto ts5_new       = ts5->Set("key0", "n_v0");  // updating on max list should work
+  std::string value;
+  EXPECT_TRUE(ts5_new->Get("key0", value));
+  EXPECT_EQ(value, "n_v0");
 }
 
 TEST(TraceStateTest, TraceStateDelete)
@@ -122,6 +136,51 @@ TEST(TraceStateTest, TraceStateDelete)
   EXPECT_EQ(ts3_new->ToHeader(), "");
 }
 
+TEST(TraceStateTest, SetAndDeleteShareEntries)
+{
+  auto base = TraceState::FromHeader("k1=v1,k2=v2,k3=v3");
+  auto ts   = base;
+  // More changes than the layers a TraceState stacks before merging them into a header.
+  for (int i = 0; i < 20; i++)
+  {
+    ts = ts->Set("k" + std::to_string(i % 5), "n" + std::to_string(i));
+  }
+  EXPECT_EQ(ts->ToHeader(), "k4=n19,k3=n18,k2=n17,k1=n16,k0=n15");
+  EXPECT_EQ(base->ToHeader(), "k1=v1,k2=v2,k3=v3");
+
+  auto deleted = ts->Delete("k2");
+  EXPECT_EQ(deleted->ToHeader(), "k4=n19,k3=n18,k1=n16,k0=n15");
+  std::string value;
+  EXPECT_FALSE(deleted->Get("k2", value));
+  EXPECT_TRUE(ts->Get("k2", value));
+  EXPECT_EQ(value, "n17");
+
+  auto readded = deleted->Set("k2", "v2");
+  EXPECT_EQ(readded->ToHeader(), "k2=v2,k4=n19,k3=n18,k1=n16,k0=n15");
+  EXPECT_EQ(deleted->Delete("k9")->ToHeader(), deleted->ToHeader());
+
+  size_t count = 0;
+  readded->GetAllEntries([&count](nostd::string_view, nostd::string_view) {
+    ++count;
+    return true;
+  });
+  EXPECT_EQ(count, 5u);
+}
+
+TEST(TraceStateTest, SetOnMaxListSharesEntries)
+{
+  auto ts = TraceState::FromHeader(header_with_max_members());
+  for (int i = 0; i < 10; i++)
+  {
+    ts = ts->Set("key" + std::to_string(i), "n" + std::to_string(i));
+  }
+  auto ts_new = ts->Set("n_k1", "n_v1");
+  EXPECT_EQ(ts_new->ToHeader(), ts->ToHeader());
+  std::string value;
+  EXPECT_FALSE(ts_new->Get("n_k1", value));
+  EXPECT_TRUE(ts_new->Get("key31", value));
+}
+
 TEST(TraceStateTest, Empty)
 {
   std::string trace_state_header = "";
@@ -156,6 +215,15 @@ TEST(TraceStateTest, IsValidKey)
   EXPECT_FALSE(TraceState::IsValidKey("invalid$Key&"));
   EXPECT_FALSE(TraceState::IsValidKey(""));
   EXPECT_FALSE(TraceState::IsValidKey(kLongString));
+  EXPECT_TRUE(TraceState::IsValidKey("tenant@vendor"));
+  EXPECT_TRUE(TraceState::IsValidKey("t@abcdefghijklmn"));
+  EXPECT_FALSE(TraceState::IsValidKey("t@abcdefghijklmno"));
+  EXPECT_FALSE(TraceState::IsValidKey("@vendor"));
+  EXPECT_FALSE(TraceState::IsValidKey("tenant@"));
+  EXPECT_FALSE(TraceState::IsValidKey("tenant@*vendor"));
+  EXPECT_FALSE(TraceState::IsValidKey("tenant@vendor@other"));
+  EXPECT_TRUE(TraceState::IsValidKey(std::string(241, 'a') + "@vendor"));
+  EXPECT_FALSE(TraceState::IsValidKey(std::string(242, 'a') + "@vendor"));
 }
 
 TEST(TraceStateTest, IsValidValue)
@@ -166,6 +234,9 @@ TEST(TraceStateTest, IsValidValue)
   EXPECT_FALSE(TraceState::IsValidValue("invalid,val"));
   EXPECT_FALSE(TraceState::IsValidValue(""));
   EXPECT_FALSE(TraceState::IsValidValue(kLongString));
+  EXPECT_TRUE(TraceState::IsValidValue(" leading space"));
+  EXPECT_FALSE(TraceState::IsValidValue("trailing space "));
+  EXPECT_FALSE(TraceState::IsValidValue("non-ascii\xc3\xa9"));
 }
 
 // Tests that keys and values don't depend on null terminators
@@ -1,7 +1,9 @@
 // Copyright The OpenTelemetry Authors
 // SPDX-License-Identifier: Apache-2.0
 
+#include "opentelemetry/context/context_snapshot.h"
 #include "opentelemetry/nostd/shared_ptr.h"
+#include "opentelemetry/trace/default_span.h"
 #include "opentelemetry/trace/noop.h"
 #include "opentelemetry/trace/scope.h"
 
@@ -37,3 +39,34 @@ TEST(TracerTest, GetCurrentSpan)
   current = tracer->GetCurrentSpan();
   ASSERT_FALSE(current->GetContext().IsValid());
 }
+
+TEST(TracerTest, GetCurrentSpanContext)
+{
+  constexpr uint8_t buf_trace[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  constexpr uint8_t buf_span[8]   = {1, 2, 3, 4, 5, 6, 7, 8};
+  trace_api::SpanContext span_context(trace_api::TraceId(buf_trace), trace_api::SpanId(buf_span),
+                                      trace_api::TraceFlags(1), false);
+  nostd::shared_ptr<trace_api::Span> span(new trace_api::DefaultSpan(span_context));
+
+  ASSERT_FALSE(trace_api::Tracer::GetCurrentSpanContext().IsValid());
+  {
+    trace_api::Scope scope(span);
+    EXPECT_EQ(trace_api::Tracer::GetCurrentSpanContext(), span_context);
+
+    // A context without a span of its own keeps the active span.
+    auto token = context::RuntimeContext::Attach(
+        context::RuntimeContext::GetCurrent().SetValue("key", static_cast<int64_t>(1)));
+    EXPECT_EQ(trace_api::Tracer::GetCurrentSpan(), span);
+    EXPECT_EQ(trace_api::Tracer::GetCurrentSpanContext(), span_context);
+
+    // A context without any span hides it.
+    {
+      context::ContextSnapshot empty_snapshot{context::Context()};
+      context::ContextSnapshot::Scope empty_scope(empty_snapshot);
+      EXPECT_FALSE(trace_api::Tracer::GetCurrentSpanContext().IsValid());
+      EXPECT_FALSE(trace_api::Tracer::GetCurrentSpan()->GetContext().IsValid());
+    }
+    EXPECT_EQ(trace_api::Tracer::GetCurrentSpanContext(), span_context);
+  }
+  ASSERT_FALSE(trace_api::Tracer::GetCurrentSpanContext().IsValid());
+}
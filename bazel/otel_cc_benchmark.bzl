@@ -15,14 +15,22 @@ def otel_cc_benchmark(name, srcs, deps, tags = [""]):
       :foo_benchmark           (the benchmark binary)
       :foo_benchmark_result    (results from running the benchmark)
       :foo_benchmark_smoketest (a fast test that runs a single iteration)
+
+    The benchmarks are linked with //test_common:allocation_counter, which reports the allocations
+    per iteration of every benchmark in its JSON results.
     """
 
+    deps = deps + [
+        "//test_common:allocation_counter",
+        "@com_github_google_benchmark//:benchmark",
+    ]
+
     # This is the benchmark as a binary, it can be run manually, and is used
     # to generate the _result below.
     native.cc_binary(
         name = name,
         srcs = srcs,
-        deps = deps + ["@com_github_google_benchmark//:benchmark"],
+        deps = deps,
         tags = tags + ["manual"],
         defines = ["BAZEL_BUILD"],
     )
@@ -42,7 +50,7 @@ def otel_cc_benchmark(name, srcs, deps, tags = [""]):
     native.cc_test(
         name = name + "_smoketest",
         srcs = srcs,
-        deps = deps + ["@com_github_google_benchmark//:benchmark"],
+        deps = deps,
         args = ["--benchmark_min_time=0"],
         tags = tags + ["benchmark"],
         defines = ["BAZEL_BUILD"],
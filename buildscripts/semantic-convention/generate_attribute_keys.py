@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+
+# Copyright The OpenTelemetry Authors
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generates the constexpr AttributeKey descriptors of the semantic conventions.
+
+The keys are read from the attribute_ids tables of the semantic convention
+headers. Each header gets an attribute_keys namespace with one descriptor per
+key, between the BEGIN/END GENERATED ATTRIBUTE KEYS markers, and
+sdk/common/semantic_attribute_keys.h lists every descriptor in the order of
+their ids, which is the order the SDK interns them in.
+
+Run from the root of the repository after editing an attribute_ids table:
+
+    python3 buildscripts/semantic-convention/generate_attribute_keys.py
+"""
+
+import re
+import sys
+
+# (header, namespace of the header, type name of AttributeKey in that namespace)
+HEADERS = [
+    ("api/include/opentelemetry/trace/experimental_semantic_conventions.h",
+     "trace", "common::AttributeKey"),
+    ("sdk/include/opentelemetry/sdk/resource/experimental_semantic_conventions.h",
+     "sdk::resource", "opentelemetry::common::AttributeKey"),
+]
+
+KEY_LIST = "sdk/include/opentelemetry/sdk/common/semantic_attribute_keys.h"
+
+BEGIN = "// BEGIN GENERATED ATTRIBUTE KEYS"
+END = "// END GENERATED ATTRIBUTE KEYS"
+
+ENTRY = re.compile(r'OTEL_CPP_CONST_HASHCODE\(Attr(\w+)\),\s*"([^"]*)"')
+
+COLUMN_LIMIT = 100
+
+
+def descriptor(type_name, name, key, key_id):
+    line = 'constexpr %s k%s{"%s", %d};' % (type_name, name, key, key_id)
+    if len(line) <= COLUMN_LIMIT:
+        return line
+    return 'constexpr %s k%s{\n    "%s", %d};' % (type_name, name, key, key_id)
+
+
+def generate_header(path, type_name, entries):
+    with open(path) as f:
+        text = f.read()
+    block = [
+        BEGIN,
+        "// Generated by buildscripts/semantic-convention/generate_attribute_keys.py, do not edit.",
+        "namespace attribute_keys",
+        "{",
+    ]
+    block += [descriptor(type_name, name, key, key_id) for name, key, key_id in entries]
+    block += ["}  // namespace attribute_keys", END]
+    start = text.index(BEGIN)
+    end = text.index(END) + len(END)
+    text = text[:start] + "\n".join(block) + text[end:]
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def generate_key_list(keys):
+    lines = [
+        "// Copyright The OpenTelemetry Authors",
+        "// SPDX-License-Identifier: Apache-2.0",
+        "",
+        "// Generated by buildscripts/semantic-convention/generate_attribute_keys.py, do not edit.",
+        "",
+        "#pragma once",
+        "",
+        '#include "opentelemetry/common/attribute_key.h"',
+        '#include "opentelemetry/sdk/resource/experimental_semantic_conventions.h"',
+        '#include "opentelemetry/trace/experimental_semantic_conventions.h"',
+        '#include "opentelemetry/version.h"',
+        "",
+        "OPENTELEMETRY_BEGIN_NAMESPACE",
+        "namespace sdk",
+        "{",
+        "namespace common",
+        "{",
+        "",
+        "/**",
+        " * The attribute keys of the semantic conventions, in the order of their ids.",
+        " */",
+        "constexpr opentelemetry::common::AttributeKey kSemanticAttributeKeys[] = {",
+    ]
+    lines += ["    opentelemetry::%s::attribute_keys::k%s," % (namespace, name)
+              for namespace, name in keys]
+    lines += [
+        "};",
+        "",
+        "}  // namespace common",
+        "}  // namespace sdk",
+        "OPENTELEMETRY_END_NAMESPACE",
+        "",
+    ]
+    with open(KEY_LIST, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    ids = {}
+    keys = []
+    for path, namespace, type_name in HEADERS:
+        with open(path) as f:
+            text = f.read()
+        table = text[:text.index(BEGIN)]
+        entries = []
+        for name, key in ENTRY.findall(table):
+            if key not in ids:
+                ids[key] = len(keys)
+                keys.append((namespace, name))
+            entries.append((name, key, ids[key]))
+        generate_header(path, type_name, entries)
+    generate_key_list(keys)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
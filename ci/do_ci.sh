@@ -46,9 +46,14 @@ function run_benchmarks
     cat $component_tmp_bench.json | docker run -i --rm itchyny/gojq:0.12.6 -s \
       '.[0].benchmarks = ([.[].benchmarks] | add) |
       if .[0].benchmarks == null then null else .[0] end' > $BENCHMARK_DIR/$out
+    # the allocations per iteration reported by //test_common:allocation_counter
+    cat $BENCHMARK_DIR/$out | docker run -i --rm itchyny/gojq:0.12.6 \
+      '[(.benchmarks // [])[] | select(.allocs_per_iter != null) |
+      {name: .name, unit: "allocations/iter", value: .allocs_per_iter}]' \
+      > $BENCHMARK_DIR/$component-allocations_result.json
   done
 
-  mv *benchmark_result.json ${SRC_DIR}
+  mv *benchmark_result.json *allocations_result.json ${SRC_DIR}
   popd
   docker kill $(docker ps -q)
 }
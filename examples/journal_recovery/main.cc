@@ -0,0 +1,60 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/ostream/span_exporter.h"
+#include "opentelemetry/sdk/common/binary_encoding.h"
+#include "opentelemetry/sdk/common/record_journal.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace common         = opentelemetry::sdk::common;
+namespace exporter_trace = opentelemetry::exporter::trace;
+namespace trace_sdk      = opentelemetry::sdk::trace;
+namespace nostd          = opentelemetry::nostd;
+
+// Prints the spans of the journal of a BatchSpanProcessor, see BatchSpanProcessorOptions::journal,
+// e.g. to find those an application lost when it crashed. The spans are exported to stdout by the
+// ostream exporter, without their resource and instrumentation library which the journal does not
+// keep. The other records are counted.
+int main(int argc, char *argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <journal file>" << std::endl;
+    return 1;
+  }
+
+  exporter_trace::OStreamSpanExporter exporter;
+  std::vector<std::unique_ptr<trace_sdk::Recordable>> spans;
+  size_t num_invalid = 0;
+  size_t num_other   = 0;
+  bool recovered     = common::RecordJournal::Recover(
+      argv[1], [&](common::JournalRecordType type, nostd::string_view data) {
+        if (type != common::JournalRecordType::kSpan)
+        {
+          ++num_other;
+          return;
+        }
+        std::unique_ptr<trace_sdk::SpanData> span(new trace_sdk::SpanData);
+        common::BinaryDecoder decoder(data.data(), data.size());
+        if (!span->ReadBinary(decoder))
+        {
+          ++num_invalid;
+          return;
+        }
+        spans.push_back(std::move(span));
+      });
+  if (!recovered)
+  {
+    std::cerr << "Cannot read the journal " << argv[1] << std::endl;
+    return 1;
+  }
+
+  exporter.Export(nostd::span<std::unique_ptr<trace_sdk::Recordable>>(spans.data(), spans.size()));
+  std::cout << spans.size() << " spans recovered, " << num_invalid << " invalid, " << num_other
+            << " records of logs or of other encodings" << std::endl;
+  return 0;
+}
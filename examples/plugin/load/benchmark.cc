@@ -0,0 +1,75 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/plugin/dynamic_load.h"
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace trace = opentelemetry::trace;
+
+namespace
+{
+std::shared_ptr<trace::Tracer> plugin_tracer;
+
+void BM_PluginSpanSetAttribute(benchmark::State &state)
+{
+  auto span = plugin_tracer->StartSpan("span");
+  for (auto _ : state)
+  {
+    span->SetAttribute("key", 42);
+  }
+  span->End();
+}
+BENCHMARK(BM_PluginSpanSetAttribute);
+
+void BM_PluginSpanAddEvent(benchmark::State &state)
+{
+  auto span = plugin_tracer->StartSpan("span");
+  for (auto _ : state)
+  {
+    span->AddEvent("event");
+  }
+  span->End();
+}
+BENCHMARK(BM_PluginSpanAddEvent);
+
+void BM_PluginSpanGetContext(benchmark::State &state)
+{
+  auto span = plugin_tracer->StartSpan("span");
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(span->GetContext());
+  }
+  span->End();
+}
+BENCHMARK(BM_PluginSpanGetContext);
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  benchmark::Initialize(&argc, argv);
+  if (argc != 2)
+  {
+    std::cerr << "Usage: load_plugin_benchmark [benchmark options] <plugin>\n";
+    return -1;
+  }
+  std::string error_message;
+  auto factory = opentelemetry::plugin::LoadFactory(argv[1], error_message);
+  if (factory == nullptr)
+  {
+    std::cerr << "Failed to load opentelemetry plugin: " << error_message << "\n";
+    return -1;
+  }
+  plugin_tracer = factory->MakeTracer("", error_message);
+  if (plugin_tracer == nullptr)
+  {
+    std::cerr << "Failed to make tracer: " << error_message << "\n";
+    return -1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  plugin_tracer = nullptr;
+  return 0;
+}
@@ -3,6 +3,7 @@
 
 #include "tracer.h"
 #include "opentelemetry/nostd/unique_ptr.h"
+#include "opentelemetry/plugin/span_function_table.h"
 
 #include <iostream>
 #include <memory>
@@ -63,6 +64,9 @@ class Span final : public trace::Span
 };
 }  // namespace
 
+// The spans of this plugin are all of type Span, whose operations the loader calls directly.
+OPENTELEMETRY_DEFINE_PLUGIN_SPAN_FUNCTIONS(Span);
+
 Tracer::Tracer(nostd::string_view /*output*/) {}
 
 nostd::shared_ptr<trace::Span> Tracer::StartSpan(nostd::string_view name,
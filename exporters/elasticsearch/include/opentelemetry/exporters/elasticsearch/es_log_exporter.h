@@ -12,7 +12,11 @@
 #  include "opentelemetry/sdk/logs/log_record.h"
 
 #  include <time.h>
+#  include <condition_variable>
 #  include <iostream>
+#  include <memory>
+#  include <mutex>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -35,6 +39,20 @@ struct ElasticsearchExporterOptions
   // Whether to print the status of the exporter in the console
   bool console_debug_;
 
+  // Maximum number of requests sent at the same time, 0 for no limit
+  std::size_t max_requests_in_flight_;
+
+  // Maximum number of requests waiting to be sent, 0 for no limit. Beyond it, the oldest waiting
+  // request is dropped.
+  std::size_t max_pending_requests_;
+
+  // Maximum number of bulk requests awaiting their response. Beyond it, Export waits for one of
+  // them to complete.
+  std::size_t max_bulk_requests_;
+
+  // Maximum number of times a document rejected with a transient error is sent again
+  std::size_t max_retries_;
+
   /**
    * Constructor for the ElasticsearchExporterOptions. By default, the endpoint is
    * localhost:9200/logs with a timeout of 30 seconds and disabled console debugging
@@ -44,22 +62,40 @@ struct ElasticsearchExporterOptions
    * @param response_timeout The maximum time in seconds the exporter should wait for a response
    * from elasticsearch
    * @param console_debug If true, print the status of the exporter methods in the console
+   * @param max_requests_in_flight The maximum number of requests sent at the same time
+   * @param max_pending_requests The maximum number of requests waiting to be sent
+   * @param max_bulk_requests The maximum number of bulk requests awaiting their response
+   * @param max_retries The maximum number of times a rejected document is sent again
    */
-  ElasticsearchExporterOptions(std::string host     = "localhost",
-                               int port             = 9200,
-                               std::string index    = "logs",
-                               int response_timeout = 30,
-                               bool console_debug   = false)
+  ElasticsearchExporterOptions(std::string host                   = "localhost",
+                               int port                           = 9200,
+                               std::string index                  = "logs",
+                               int response_timeout               = 30,
+                               bool console_debug                 = false,
+                               std::size_t max_requests_in_flight = 64,
+                               std::size_t max_pending_requests   = 256,
+                               std::size_t max_bulk_requests      = 4,
+                               std::size_t max_retries            = 3)
       : host_{host},
         port_{port},
         index_{index},
         response_timeout_{response_timeout},
-        console_debug_{console_debug}
+        console_debug_{console_debug},
+        max_requests_in_flight_{max_requests_in_flight},
+        max_pending_requests_{max_pending_requests},
+        max_bulk_requests_{max_bulk_requests},
+        max_retries_{max_retries}
   {}
 };
 
+class BulkRequest;
+
 /**
- * The ElasticsearchLogExporter exports logs to Elasticsearch in JSON format
+ * The ElasticsearchLogExporter exports logs to Elasticsearch in JSON format, with the bulk API.
+ *
+ * Export sends a bulk request without waiting for its response, so that several of them can be in
+ * flight. The responses are processed by the next exports: the documents which Elasticsearch
+ * rejected with a transient error, or all those of a request which failed, are sent again.
  */
 class ElasticsearchLogExporter final : public opentelemetry::sdk::logs::LogExporter
 {
@@ -75,14 +111,17 @@ class ElasticsearchLogExporter final : public opentelemetry::sdk::logs::LogExpor
    */
   ElasticsearchLogExporter(const ElasticsearchExporterOptions &options);
 
+  ~ElasticsearchLogExporter() override;
+
   /**
    * Creates a recordable that stores the data in a JSON object
    */
   std::unique_ptr<opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
 
   /**
-   * Exports a vector of log records to the Elasticsearch instance. Guaranteed to return after a
-   * timeout specified from the options passed from the constructor.
+   * Sends a vector of log records to the Elasticsearch instance. Returns once the request is sent,
+   * or fails once the timeout specified in the options passed to the constructor has passed
+   * without room for another bulk request.
    * @param records A list of log records to send to Elasticsearch.
    */
   sdk::common::ExportResult Export(
@@ -90,7 +129,7 @@ class ElasticsearchLogExporter final : public opentelemetry::sdk::logs::LogExpor
           &records) noexcept override;
 
   /**
-   * Shutdown this exporter.
+   * Shutdown this exporter, after waiting for the bulk requests in flight.
    * @param timeout The maximum time to wait for the shutdown method to return
    */
   bool Shutdown(
@@ -107,6 +146,19 @@ class ElasticsearchLogExporter final : public opentelemetry::sdk::logs::LogExpor
   std::unique_ptr<ext::http::client::HttpClient> http_client_;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool isShutdown() const noexcept;
+
+  /* Finishes the bulk requests which completed, and queues the documents to send again. */
+  void ProcessCompletedRequests();
+
+  void SendRequest(std::unique_ptr<BulkRequest> &&request);
+
+  // Guards the bulk requests, and notified when one of them completes
+  std::mutex requests_mutex_;
+  std::condition_variable request_completed_;
+  std::vector<std::unique_ptr<BulkRequest>> requests_in_flight_;
+  std::vector<std::unique_ptr<BulkRequest>> requests_to_retry_;
+  // Bodies of completed requests, kept to serialize the next ones without growing a new buffer
+  std::vector<ext::http::client::Body> free_bodies_;
 };
 }  // namespace logs
 }  // namespace exporter
@@ -3,6 +3,7 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 
+#  include <algorithm>
 #  include <sstream>  // std::stringstream
 
 #  include <mutex>
@@ -19,104 +20,224 @@ namespace exporter
 {
 namespace logs
 {
+namespace
+{
+// Tells Elasticsearch to write the following document to the index specified in the URI
+const char kIndexAction[] = "{\"index\":{}}\n";
+
+// Whether a request or a document which failed with this status may succeed if sent again
+bool IsRetryableStatus(http_client::StatusCode status)
+{
+  return status == 0 || status == 429 || status == 502 || status == 503 || status == 504;
+}
+}  // namespace
+
 /**
- * This class handles the response message from the Elasticsearch request
+ * A bulk request, which handles its own response
  */
-class ResponseHandler : public http_client::EventHandler
+class BulkRequest : public http_client::EventHandler
 {
 public:
-  /**
-   * Creates a response handler, that by default doesn't display to console
-   */
-  ResponseHandler(bool console_debug = false) : console_debug_{console_debug} {}
+  BulkRequest(std::mutex &mutex, std::condition_variable &completed, bool console_debug)
+      : mutex_(mutex), completed_(completed), console_debug_(console_debug)
+  {}
 
   /**
-   * Automatically called when the response is received, store the body into a string and notify any
-   * threads blocked on this result
+   * Appends a document and the action which indexes it to the body.
    */
-  void OnResponse(http_client::Response &response) noexcept override
+  void AddDocument(const std::string &document)
   {
-    // Lock the private members so they can't be read while being modified
-    {
-      std::unique_lock<std::mutex> lk(mutex_);
-
-      // Store the body of the request
-      body_ = std::string(response.GetBody().begin(), response.GetBody().end());
-
-      // Set the response_received_ flag to true and notify any threads waiting on this result
-      response_received_ = true;
-    }
-    cv_.notify_all();
+    std::size_t offset = body_.size();
+    body_.insert(body_.end(), kIndexAction, kIndexAction + sizeof(kIndexAction) - 1);
+    body_.insert(body_.end(), document.begin(), document.end());
+    body_.push_back('\n');
+    documents_.emplace_back(offset, body_.size() - offset);
   }
 
   /**
-   * A method the user calls to block their thread until the response is received. The longest
-   * duration is the timeout of the request, set by SetTimeoutMs()
+   * Appends a document of another request, with its action.
    */
-  bool waitForResponse()
+  void AddDocument(const BulkRequest &other, std::size_t index)
   {
-    std::unique_lock<std::mutex> lk(mutex_);
-    cv_.wait(lk);
-    return response_received_;
+    auto document      = other.documents_[index];
+    std::size_t offset = body_.size();
+    body_.insert(body_.end(), other.body_.begin() + document.first,
+                 other.body_.begin() + document.first + document.second);
+    documents_.emplace_back(offset, document.second);
   }
 
-  /**
-   * Returns the body of the response
-   */
-  std::string GetResponseBody()
+  // Called with the mutex held
+  bool IsCompleted() const noexcept { return completed_flag_; }
+
+  void OnResponse(http_client::Response &response) noexcept override
   {
-    // Lock so that body_ can't be written to while returning it
-    std::unique_lock<std::mutex> lk(mutex_);
-    return body_;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      status_code_   = response.GetStatusCode();
+      response_body_ = std::string(response.GetBody().begin(), response.GetBody().end());
+      completed_flag_ = true;
+    }
+    if (console_debug_)
+    {
+      OTEL_INTERNAL_LOG_DEBUG("[ES Log Exporter] Bulk request completed with status "
+                              << response.GetStatusCode());
+    }
+    completed_.notify_all();
   }
 
-  // Callback method when an http event occurs
   void OnEvent(http_client::SessionState state, nostd::string_view reason) noexcept override
   {
-    // If any failure event occurs, release the condition variable to unblock main thread
     switch (state)
     {
+      case http_client::SessionState::CreateFailed:
       case http_client::SessionState::ConnectFailed:
-        OTEL_INTERNAL_LOG_ERROR("[ES Trace Exporter] Connection to elasticsearch failed");
-        cv_.notify_all();
-        break;
       case http_client::SessionState::SendFailed:
-        OTEL_INTERNAL_LOG_ERROR("[ES Trace Exporter] Request failed to be sent to elasticsearch");
-        cv_.notify_all();
-        break;
+      case http_client::SessionState::SSLHandshakeFailed:
       case http_client::SessionState::TimedOut:
-        OTEL_INTERNAL_LOG_ERROR("[ES Trace Exporter] Request to elasticsearch timed out");
-        cv_.notify_all();
-        break;
       case http_client::SessionState::NetworkError:
-        OTEL_INTERNAL_LOG_ERROR("[ES Trace Exporter] Network error to elasticsearch");
-        cv_.notify_all();
+      case http_client::SessionState::Cancelled:
+        OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] Bulk request to elasticsearch failed, state "
+                                << static_cast<int>(state));
+        {
+          std::lock_guard<std::mutex> guard(mutex_);
+          completed_flag_ = true;
+        }
+        completed_.notify_all();
+        break;
+
+      default:
         break;
     }
   }
 
-private:
-  // Define a condition variable and mutex
-  std::condition_variable cv_;
-  std::mutex mutex_;
+  /**
+   * Returns the request with the documents to send again once this one completed, or nullptr.
+   */
+  std::unique_ptr<BulkRequest> GetRetry(std::size_t max_retries)
+  {
+    std::unique_ptr<BulkRequest> retry(new BulkRequest(mutex_, completed_, console_debug_));
+    retry->attempt_ = attempt_ + 1;
+
+    if (status_code_ < 200 || status_code_ >= 300)
+    {
+      if (!IsRetryableStatus(status_code_))
+      {
+        OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] " << documents_.size()
+                                                     << " log(s) rejected by elasticsearch, status "
+                                                     << status_code_ << ": " << response_body_);
+        return nullptr;
+      }
+      retry->documents_.reserve(documents_.size());
+      for (std::size_t i = 0; i < documents_.size(); ++i)
+      {
+        retry->AddDocument(*this, i);
+      }
+    }
+    else
+    {
+      // Elasticsearch reports the outcome of each document in the items of the response, in the
+      // order of the request.
+      auto response = nlohmann::json::parse(response_body_, nullptr, false);
+      if (!response.is_object())
+      {
+        return nullptr;
+      }
+      auto errors = response.find("errors");
+      auto items  = response.find("items");
+      if (errors == response.end() || !errors->is_boolean() || !errors->get<bool>() ||
+          items == response.end() || !items->is_array())
+      {
+        return nullptr;
+      }
+      std::size_t rejected = 0;
+      for (std::size_t i = 0; i < items->size() && i < documents_.size(); ++i)
+      {
+        const auto &item = (*items)[i];
+        if (!item.is_object() || item.empty() || !item.begin()->is_object())
+        {
+          continue;
+        }
+        const auto &result = item.begin().value();
+        auto status        = result.find("status");
+        if (status == result.end() || !status->is_number_integer())
+        {
+          continue;
+        }
+        auto status_code = status->get<int>();
+        if (status_code >= 200 && status_code < 300)
+        {
+          continue;
+        }
+        if (IsRetryableStatus(static_cast<http_client::StatusCode>(status_code)))
+        {
+          retry->AddDocument(*this, i);
+        }
+        else
+        {
+          auto error = result.find("error");
+          if (rejected == 0 && error != result.end())
+          {
+            OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] Log rejected by elasticsearch: "
+                                    << error->dump());
+          }
+          ++rejected;
+        }
+      }
+      if (rejected > 0)
+      {
+        OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] " << rejected
+                                                     << " log(s) rejected by elasticsearch");
+      }
+    }
 
-  // Whether the response from Elasticsearch has been received
-  bool response_received_ = false;
+    if (retry->documents_.empty())
+    {
+      return nullptr;
+    }
+    if (retry->attempt_ > max_retries)
+    {
+      OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] Dropping " << retry->documents_.size()
+                                                            << " log(s) after "
+                                                            << max_retries << " retries");
+      return nullptr;
+    }
+    return retry;
+  }
 
-  // A string to store the response body
-  std::string body_ = "";
+  http_client::Body body_;
+  // Offset and size in body_ of each document, with its action
+  std::vector<std::pair<std::size_t, std::size_t>> documents_;
+  std::size_t attempt_ = 0;
+  std::shared_ptr<http_client::Session> session_;
 
-  // Whether to print the results from the callback
-  bool console_debug_ = false;
+private:
+  std::mutex &mutex_;
+  std::condition_variable &completed_;
+  bool console_debug_;
+
+  // Set by the callbacks, with the mutex held
+  bool completed_flag_                  = false;
+  http_client::StatusCode status_code_ = 0;
+  std::string response_body_;
 };
 
+static http_client::HttpClientOptions MakeHttpClientOptions(
+    const ElasticsearchExporterOptions &options)
+{
+  http_client::HttpClientOptions http_client_options;
+  http_client_options.max_requests_in_flight = options.max_requests_in_flight_;
+  http_client_options.max_pending_requests   = options.max_pending_requests_;
+  return http_client_options;
+}
+
 ElasticsearchLogExporter::ElasticsearchLogExporter()
     : options_{ElasticsearchExporterOptions()},
       http_client_{new ext::http::client::curl::HttpClient()}
 {}
 
 ElasticsearchLogExporter::ElasticsearchLogExporter(const ElasticsearchExporterOptions &options)
-    : options_{options}, http_client_{new ext::http::client::curl::HttpClient()}
+    : options_{options},
+      http_client_{new ext::http::client::curl::HttpClient(MakeHttpClientOptions(options))}
 {}
 
 std::unique_ptr<sdklogs::Recordable> ElasticsearchLogExporter::MakeRecordable() noexcept
@@ -124,6 +245,12 @@ std::unique_ptr<sdklogs::Recordable> ElasticsearchLogExporter::MakeRecordable()
   return std::unique_ptr<sdklogs::Recordable>(new ElasticSearchRecordable);
 }
 
+ElasticsearchLogExporter::~ElasticsearchLogExporter()
+{
+  // The requests in flight refer to their handlers.
+  http_client_->FinishAllSessions();
+}
+
 sdk::common::ExportResult ElasticsearchLogExporter::Export(
     const nostd::span<std::unique_ptr<sdklogs::Recordable>> &records) noexcept
 {
@@ -135,78 +262,134 @@ sdk::common::ExportResult ElasticsearchLogExporter::Export(
     return sdk::common::ExportResult::kFailure;
   }
 
-  // Create a connection to the ElasticSearch instance
-  auto session = http_client_->CreateSession(options_.host_ + std::to_string(options_.port_));
-  auto request = session->CreateRequest();
+  std::unique_lock<std::mutex> lock(requests_mutex_);
+  ProcessCompletedRequests();
 
-  // Populate the request with headers and methods
-  request->SetUri(options_.index_ + "/_bulk?pretty");
-  request->SetMethod(http_client::Method::Post);
-  request->AddHeader("Content-Type", "application/json");
-  request->SetTimeoutMs(std::chrono::milliseconds(1000 * options_.response_timeout_));
-
-  // Create the request body
-  std::string body = "";
+  // Serialize the records into the body of a completed request, whose memory is reused.
+  std::unique_ptr<BulkRequest> request(
+      new BulkRequest(requests_mutex_, request_completed_, options_.console_debug_));
+  if (!free_bodies_.empty())
+  {
+    request->body_ = std::move(free_bodies_.back());
+    free_bodies_.pop_back();
+    request->body_.clear();
+  }
+  request->documents_.reserve(records.size());
   for (auto &record : records)
   {
-    // Append {"index":{}} before JSON body, which tells Elasticsearch to write to index specified
-    // in URI
-    body += "{\"index\" : {}}\n";
-
-    // Add the context of the Recordable
     auto json_record = std::unique_ptr<ElasticSearchRecordable>(
         static_cast<ElasticSearchRecordable *>(record.release()));
-    body += json_record->GetJSON().dump() + "\n";
+    if (json_record != nullptr)
+    {
+      request->AddDocument(json_record->GetJSON().dump());
+    }
   }
-  std::vector<uint8_t> body_vec(body.begin(), body.end());
-  request->SetBody(body_vec);
-
-  // Send the request
-  std::unique_ptr<ResponseHandler> handler(new ResponseHandler(options_.console_debug_));
-  session->SendRequest(*handler);
 
-  // Wait for the response to be received
-  if (options_.console_debug_)
+  // Wait for room for this request.
+  auto timeout = std::chrono::seconds(options_.response_timeout_);
+  if (!request_completed_.wait_for(lock, timeout, [this] {
+        return std::count_if(requests_in_flight_.begin(), requests_in_flight_.end(),
+                             [](const std::unique_ptr<BulkRequest> &request) {
+                               return !request->IsCompleted();
+                             }) < static_cast<std::ptrdiff_t>(options_.max_bulk_requests_);
+      }))
   {
-    OTEL_INTERNAL_LOG_DEBUG(
-        "[ES Trace Exporter] waiting for response from Elasticsearch (timeout = "
-        << options_.response_timeout_ << " seconds)");
+    OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] Exporting " << records.size()
+                                                           << " log(s) failed, too many bulk "
+                                                              "requests in flight");
+    return sdk::common::ExportResult::kFailure;
   }
-  bool write_successful = handler->waitForResponse();
+  ProcessCompletedRequests();
 
-  // End the session
-  session->FinishSession();
+  auto retries = std::move(requests_to_retry_);
+  requests_to_retry_.clear();
+  for (auto &retry : retries)
+  {
+    SendRequest(std::move(retry));
+  }
+  SendRequest(std::move(request));
+  return sdk::common::ExportResult::kSuccess;
+}
 
-  // If an error occurred with the HTTP request
-  if (!write_successful)
+void ElasticsearchLogExporter::ProcessCompletedRequests()
+{
+  auto completed = std::stable_partition(
+      requests_in_flight_.begin(), requests_in_flight_.end(),
+      [](const std::unique_ptr<BulkRequest> &request) { return !request->IsCompleted(); });
+  for (auto it = completed; it != requests_in_flight_.end(); ++it)
   {
-    // TODO: retry logic
-    return sdk::common::ExportResult::kFailure;
+    auto &request = *it;
+    request->session_->FinishSession();
+
+    auto retry = request->GetRetry(options_.max_retries_);
+    if (retry != nullptr)
+    {
+      requests_to_retry_.push_back(std::move(retry));
+    }
+    if (free_bodies_.size() < options_.max_bulk_requests_)
+    {
+      free_bodies_.push_back(std::move(request->body_));
+    }
   }
+  requests_in_flight_.erase(completed, requests_in_flight_.end());
+}
 
-  // Parse the response output to determine if Elasticsearch consumed it correctly
-  std::string responseBody = handler->GetResponseBody();
-  if (responseBody.find("\"failed\" : 0") == std::string::npos)
+void ElasticsearchLogExporter::SendRequest(std::unique_ptr<BulkRequest> &&bulk_request)
+{
+  if (bulk_request->documents_.empty())
   {
-    OTEL_INTERNAL_LOG_ERROR(
-        "[ES Trace Exporter] Logs were not written to Elasticsearch correctly, response body: "
-        << responseBody);
-    // TODO: Retry logic
-    return sdk::common::ExportResult::kFailure;
+    return;
   }
 
-  return sdk::common::ExportResult::kSuccess;
+  auto session = http_client_->CreateSession(options_.host_ + ":" + std::to_string(options_.port_));
+  auto request = session->CreateRequest();
+
+  // Populate the request with headers and methods
+  request->SetUri(options_.index_ + "/_bulk");
+  request->SetMethod(http_client::Method::Post);
+  request->AddHeader("Content-Type", "application/x-ndjson");
+  request->SetTimeoutMs(std::chrono::milliseconds(1000 * options_.response_timeout_));
+
+  // The request owns a copy of the body, which is kept to send rejected documents again.
+  http_client::Body body(bulk_request->body_);
+  request->SetBody(body);
+
+  bulk_request->session_ = session;
+  session->SendRequest(*bulk_request);
+  requests_in_flight_.push_back(std::move(bulk_request));
 }
 
 bool ElasticsearchLogExporter::Shutdown(std::chrono::microseconds timeout) noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  is_shutdown_ = true;
+  {
+    const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+    is_shutdown_ = true;
+  }
 
-  // Shutdown the session manager
+  // Give the requests in flight until the timeout to complete.
+  {
+    std::unique_lock<std::mutex> lock(requests_mutex_);
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::seconds(options_.response_timeout_));
+    request_completed_.wait_for(lock, (std::min)(timeout, wait), [this] {
+      return std::all_of(
+          requests_in_flight_.begin(), requests_in_flight_.end(),
+          [](const std::unique_ptr<BulkRequest> &request) { return request->IsCompleted(); });
+    });
+  }
+
+  // Shutdown the session manager. The callbacks of cancelled requests take the mutex.
   http_client_->CancelAllSessions();
   http_client_->FinishAllSessions();
 
+  std::lock_guard<std::mutex> guard(requests_mutex_);
+  ProcessCompletedRequests();
+  if (!requests_to_retry_.empty())
+  {
+    OTEL_INTERNAL_LOG_ERROR("[ES Log Exporter] Dropping " << requests_to_retry_.size()
+                                                          << " bulk request(s) at shutdown");
+    requests_to_retry_.clear();
+  }
   return true;
 }
 
@@ -0,0 +1,110 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#ifdef ENABLE_LOGS_PREVIEW
+#  include "opentelemetry/exporters/elasticsearch/es_log_recordable.h"
+#  include "opentelemetry/ext/http/client/http_client.h"
+#  include "test/trace/span_shapes.h"
+
+#  include <chrono>
+#  include <cstdint>
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+namespace logs_api = opentelemetry::logs;
+namespace logs     = opentelemetry::exporter::logs;
+using span_shapes::SpanShape;
+
+namespace
+{
+// The action preceding each document of the bulk request of the exporter.
+const char kIndexAction[] = "{\"index\":{}}\n";
+
+/**
+ * Records the log record matching the span shape: kMinimal has a body, a timestamp and a severity,
+ * kTypical adds the span context and the 8 attributes of an HTTP request, and kLarge 24 more.
+ */
+void FillLogRecord(logs::ElasticSearchRecordable &record, SpanShape shape, uint64_t index)
+{
+  record.SetTimestamp(opentelemetry::common::SystemTimestamp(std::chrono::system_clock::time_point(
+      std::chrono::seconds(1600000000) + std::chrono::microseconds(index))));
+  record.SetSeverity(logs_api::Severity::kInfo);
+  record.SetBody("request served");
+  record.SetResource(span_shapes::GetResource());
+  record.SetInstrumentationLibrary(span_shapes::GetInstrumentationLibrary());
+  if (shape == SpanShape::kMinimal)
+  {
+    return;
+  }
+
+  auto span_context = span_shapes::MakeSpanContext(index, 1);
+  record.SetTraceId(span_context.trace_id());
+  record.SetSpanId(span_context.span_id());
+  record.SetTraceFlags(span_context.trace_flags());
+  record.SetAttribute("http.method", "GET");
+  record.SetAttribute("http.scheme", "https");
+  record.SetAttribute("http.target", "/api/v1/users/12345?expand=groups");
+  record.SetAttribute("http.route", "/api/v1/users/{id}");
+  record.SetAttribute("http.status_code", 200);
+  record.SetAttribute("http.user_agent", "Mozilla/5.0 (X11; Linux x86_64) benchmark/1.0");
+  record.SetAttribute("net.peer.ip", "192.168.1.10");
+  record.SetAttribute("net.peer.port", 51234);
+  if (shape == SpanShape::kTypical)
+  {
+    return;
+  }
+
+  for (int i = 0; i < 24; ++i)
+  {
+    std::string key = "attribute." + std::to_string(i);
+    switch (i % 4)
+    {
+      case 0:
+        record.SetAttribute(key, "a string value of moderate length");
+        break;
+      case 1:
+        record.SetAttribute(key, static_cast<int64_t>(i) * 1000003);
+        break;
+      case 2:
+        record.SetAttribute(key, i * 0.5);
+        break;
+      default:
+        record.SetAttribute(key, i % 8 == 3);
+        break;
+    }
+  }
+}
+
+// Serializes batches into the body of the bulk request of the exporter, without sending them.
+void BM_ElasticsearchSerialization(benchmark::State &state)
+{
+  std::vector<std::unique_ptr<logs::ElasticSearchRecordable>> records;
+  for (int i = 0; i < span_shapes::kSpansPerBatch; ++i)
+  {
+    records.emplace_back(new logs::ElasticSearchRecordable);
+    FillLogRecord(*records.back(), static_cast<SpanShape>(state.range(0)), i);
+  }
+
+  opentelemetry::ext::http::client::Body body;
+  uint64_t bytes = 0;
+  for (auto _ : state)
+  {
+    body.clear();
+    for (auto &record : records)
+    {
+      std::string document = record->GetJSON().dump();
+      body.insert(body.end(), kIndexAction, kIndexAction + sizeof(kIndexAction) - 1);
+      body.insert(body.end(), document.begin(), document.end());
+      body.push_back('\n');
+    }
+    benchmark::DoNotOptimize(body.data());
+    bytes += body.size();
+  }
+  span_shapes::ReportThroughput(state, bytes);
+}
+BENCHMARK(BM_ElasticsearchSerialization)->Apply(span_shapes::ApplyShapes);
+}  // namespace
+#endif
+BENCHMARK_MAIN();
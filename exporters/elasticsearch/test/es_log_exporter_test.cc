@@ -12,18 +12,115 @@
 #  include "opentelemetry/sdk/logs/simple_log_processor.h"
 
 #  include <gtest/gtest.h>
+#  include <chrono>
 #  include <iostream>
+#  include <mutex>
+#  include <sstream>
+#  include <thread>
+#  include <vector>
 
 namespace sdklogs       = opentelemetry::sdk::logs;
 namespace logs_api      = opentelemetry::logs;
 namespace nostd         = opentelemetry::nostd;
 namespace logs_exporter = opentelemetry::exporter::logs;
+namespace sdk_common    = opentelemetry::sdk::common;
 
 TEST(ElasticsearchLogsExporterTests, Dummy)
 {
   // to enable linking
 }
 
+/**
+ * A fake Elasticsearch bulk API, which rejects the second document of the first request with a
+ * transient error.
+ */
+class ElasticsearchBulkTest : public ::testing::Test, public HTTP_SERVER_NS::HttpRequestCallback
+{
+protected:
+  void SetUp() override
+  {
+    port_ = server_.addListeningPort(19200);
+    std::ostringstream os;
+    os << "localhost:" << port_;
+    server_.setServerName(os.str());
+    server_.setKeepalive(false);
+    server_.addHandler("/logs/", *this);
+    server_.start();
+  }
+
+  void TearDown() override { server_.stop(); }
+
+  int onHttpRequest(HTTP_SERVER_NS::HttpRequest const &request,
+                    HTTP_SERVER_NS::HttpResponse &response) override
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    requests_.push_back(request);
+    response.headers["Content-Type"] = "application/json";
+    if (requests_.size() == 1)
+    {
+      response.body =
+          "{\"errors\":true,\"items\":[{\"index\":{\"status\":201}},"
+          "{\"index\":{\"status\":429,\"error\":{\"type\":\"es_rejected_execution_exception\"}}}]}";
+    }
+    else
+    {
+      response.body = "{\"errors\":false,\"items\":[]}";
+    }
+    return 200;
+  }
+
+  std::vector<std::string> GetReceivedBodies()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<std::string> bodies;
+    for (const auto &request : requests_)
+    {
+      bodies.push_back(request.content);
+    }
+    return bodies;
+  }
+
+  static sdk_common::ExportResult Export(sdklogs::LogExporter &exporter,
+                                         const std::vector<std::string> &messages)
+  {
+    std::vector<std::unique_ptr<sdklogs::Recordable>> records;
+    for (const auto &message : messages)
+    {
+      records.push_back(exporter.MakeRecordable());
+      records.back()->SetBody(message);
+    }
+    return exporter.Export(
+        nostd::span<std::unique_ptr<sdklogs::Recordable>>(records.data(), records.size()));
+  }
+
+  HTTP_SERVER_NS::HttpServer server_;
+  int port_ = 0;
+  std::mutex mutex_;
+  std::vector<HTTP_SERVER_NS::HttpRequest> requests_;
+};
+
+// Only the document rejected with a transient error is sent again.
+TEST_F(ElasticsearchBulkTest, RetryRejectedDocuments)
+{
+  logs_exporter::ElasticsearchExporterOptions options("localhost", port_);
+  options.max_bulk_requests_ = 1;
+  logs_exporter::ElasticsearchLogExporter exporter(options);
+
+  ASSERT_EQ(Export(exporter, {"first", "second"}), sdk_common::ExportResult::kSuccess);
+  // With a single bulk request in flight, this export waits for the response to the first one.
+  ASSERT_EQ(Export(exporter, {"third"}), sdk_common::ExportResult::kSuccess);
+  exporter.Shutdown();
+
+  auto bodies = GetReceivedBodies();
+  ASSERT_EQ(bodies.size(), 3u);
+  EXPECT_NE(bodies[0].find("first"), std::string::npos);
+  EXPECT_NE(bodies[0].find("second"), std::string::npos);
+  EXPECT_EQ(bodies[1].find("first"), std::string::npos);
+  EXPECT_NE(bodies[1].find("second"), std::string::npos);
+  EXPECT_NE(bodies[2].find("third"), std::string::npos);
+  EXPECT_EQ(bodies[2].find("second"), std::string::npos);
+}
+
 #  if 0
 // Attempt to write a log to an invalid host/port, test that the Export() returns failure
 TEST(ElasticsearchLogsExporterTests, InvalidEndpoint)
@@ -120,7 +120,9 @@ class Logger : public opentelemetry::logs::Logger
       return Log(severity, provId, body, *evt, trace_id, span_id, trace_flags, timestamp);
     }
 #  endif
-    Properties evtCopy = attributes;
+    // The log is written before Log returns: borrow the string attributes rather than copy them.
+    Properties evtCopy;
+    evtCopy.Borrow(attributes);
     return Log(severity, provId, body, evtCopy, trace_id, span_id, trace_flags, timestamp);
   }
 
@@ -145,7 +147,9 @@ class Logger : public opentelemetry::logs::Logger
       return Log(severity, name, body, *evt, trace_id, span_id, trace_flags, timestamp);
     }
 #  endif
-    Properties evtCopy = attributes;
+    // The log is written before Log returns: borrow the string attributes rather than copy them.
+    Properties evtCopy;
+    evtCopy.Borrow(attributes);
     return Log(severity, name, body, evtCopy, trace_id, span_id, trace_flags, timestamp);
   }
 
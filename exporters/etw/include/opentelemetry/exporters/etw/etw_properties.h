@@ -25,6 +25,7 @@ namespace etw
  * @brief PropertyVariant provides:
  * - a constructor to initialize from initializer lists
  * - an owning wrapper around `common::AttributeValue`
+ * - a non-owning string view, for properties which do not outlive the attributes they borrow from
  */
 using PropertyVariant =
     nostd::variant<bool,
@@ -44,7 +45,8 @@ using PropertyVariant =
                    std::vector<uint32_t>,
                    std::vector<uint64_t>,
                    std::vector<double>,
-                   std::vector<std::string>>;
+                   std::vector<std::string>,
+                   nostd::string_view>;
 
 enum PropertyType
 {
@@ -63,7 +65,8 @@ enum PropertyType
   kTypeSpanUInt,
   kTypeSpanUInt64,
   kTypeSpanDouble,
-  kTypeSpanString
+  kTypeSpanString,
+  kTypeStringView
 };
 
 /**
@@ -92,10 +95,11 @@ class PropertyValue : public PropertyVariant
    */
   std::vector<std::string> static to_vector(const nostd::span<const nostd::string_view> &source)
   {
-    std::vector<std::string> result(source.size());
+    std::vector<std::string> result;
+    result.reserve(source.size());
     for (const auto &item : source)
     {
-      result.push_back(std::string(item.data()));
+      result.push_back(std::string(item.data(), item.size()));
     }
     return result;
   }
@@ -183,6 +187,14 @@ class PropertyValue : public PropertyVariant
    */
   PropertyValue(const std::string &value) : PropertyVariant(value) {}
 
+  /**
+   * @brief PropertyValue borrowing a string, which must outlive it.
+   *
+   * @param v
+   * @return
+   */
+  PropertyValue(nostd::string_view value) : PropertyVariant(value) {}
+
   /**
    * @brief PropertyValue from vector as array.
    * @return
@@ -196,6 +208,17 @@ class PropertyValue : public PropertyVariant
    * @return
    */
   PropertyValue &FromAttributeValue(const common::AttributeValue &v)
+  {
+    return FromAttributeValue(v, false);
+  }
+
+  /**
+   * @brief Convert non-owning common::AttributeValue to PropertyValue, which borrows the strings
+   * of the attribute rather than copying them when `borrow` is true. A borrowing PropertyValue
+   * must not outlive the attribute it was converted from.
+   * @return
+   */
+  PropertyValue &FromAttributeValue(const common::AttributeValue &v, bool borrow)
   {
     switch (v.index())
     {
@@ -222,8 +245,15 @@ class PropertyValue : public PropertyVariant
         break;
       }
       case common::AttributeType::kTypeString: {
-        PropertyVariant::operator=
-            (std::string{nostd::string_view(nostd::get<nostd::string_view>(v)).data()});
+        nostd::string_view view = nostd::get<nostd::string_view>(v);
+        if (borrow)
+        {
+          PropertyVariant::operator=(view);
+        }
+        else
+        {
+          PropertyVariant::operator=(std::string(view.data(), view.size()));
+        }
         break;
       }
 
@@ -338,6 +368,10 @@ class PropertyValue : public PropertyVariant
         // value = to_span(nostd::get<std::vector<std::string>>(self));
         break;
 
+      case PropertyType::kTypeStringView:
+        value = nostd::get<nostd::string_view>(*this);
+        break;
+
       default:
         break;
     }
@@ -420,6 +454,22 @@ class Properties : public common::KeyValueIterable, public PropertyValueMap
     return (*this);
   }
 
+  /**
+   * @brief Replace the properties with the attributes of a KeyValueIterable, borrowing their
+   * string values instead of copying them. Used for events which are written synchronously: the
+   * properties must not be used once `other` is gone. Array values are still copied.
+   */
+  Properties &Borrow(const common::KeyValueIterable &other)
+  {
+    clear();
+    other.ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) noexcept {
+      std::string k(key.data(), key.length());
+      (*this)[k].FromAttributeValue(value, true);
+      return true;
+    });
+    return (*this);
+  }
+
   /**
    * @brief PropertyValueMap property accessor.
    */
@@ -39,7 +39,10 @@
 
 #include "opentelemetry/exporters/etw/etw_traceloggingdynamic.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -73,6 +76,113 @@ class ETWProvider
     ETW_XML      = 2
   };
 
+  /// <summary>
+  /// TraceLogging event metadata blobs of a provider, by event name and field names and types.
+  /// An event whose schema was seen before only has its values serialized.
+  /// </summary>
+  class EventSchemaCache
+  {
+  public:
+    struct Field
+    {
+      const char *name;
+      tld::Type type;
+    };
+
+    /// <summary>
+    /// Get the metadata of an event, building it on first use.
+    /// </summary>
+    /// <returns>the metadata, or nullptr if it is too large for an event</returns>
+    std::shared_ptr<const std::vector<BYTE>> get(const std::string &eventName,
+                                                 const std::vector<Field> &fields)
+    {
+      uint64_t hash = hashSchema(eventName, fields);
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = m_schemas.find(hash);
+        if (it != m_schemas.end() && it->second.matches(eventName, fields))
+        {
+          return it->second.metadata;
+        }
+      }
+
+      std::shared_ptr<std::vector<BYTE>> metadata(new std::vector<BYTE>());
+      tld::EventMetadataBuilder<std::vector<BYTE>> builder(*metadata);
+      builder.Begin(eventName.c_str(), MICROSOFT_EVENTTAG_NORMAL_PERSISTENCE);
+      for (auto &field : fields)
+      {
+        builder.AddField(field.name, field.type);
+      }
+      if (!builder.End())  // Returns false if the metadata is too large.
+      {
+        return nullptr;
+      }
+
+      std::lock_guard<std::mutex> lock(m_lock);
+      // Beyond kMaxSchemas, or on a hash collision, the metadata is built for each event.
+      if (m_schemas.size() < kMaxSchemas && m_schemas.find(hash) == m_schemas.end())
+      {
+        Schema &schema   = m_schemas[hash];
+        schema.eventName = eventName;
+        for (auto &field : fields)
+        {
+          schema.fields.emplace_back(field.name, field.type);
+        }
+        schema.metadata = metadata;
+      }
+      return metadata;
+    }
+
+  private:
+    static constexpr size_t kMaxSchemas = 1024;
+
+    struct Schema
+    {
+      std::string eventName;
+      std::vector<std::pair<std::string, tld::Type>> fields;
+      std::shared_ptr<const std::vector<BYTE>> metadata;
+
+      bool matches(const std::string &name, const std::vector<Field> &other) const
+      {
+        if (name != eventName || other.size() != fields.size())
+        {
+          return false;
+        }
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+          if (other[i].type != fields[i].second || fields[i].first != other[i].name)
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+    };
+
+    /* FNV-1a over the event name and the names and types of its fields. */
+    static uint64_t hashSchema(const std::string &eventName, const std::vector<Field> &fields)
+    {
+      uint64_t hash = 14695981039346656037ULL;
+      auto add      = [&hash](const char *str, size_t size) {
+        for (size_t i = 0; i < size; i++)
+        {
+          hash ^= static_cast<unsigned char>(str[i]);
+          hash *= 1099511628211ULL;
+        }
+      };
+      add(eventName.c_str(), eventName.size() + 1);
+      for (auto &field : fields)
+      {
+        add(field.name, strlen(field.name) + 1);
+        add(reinterpret_cast<const char *>(&field.type), sizeof(field.type));
+      }
+      return hash;
+    }
+
+    std::mutex m_lock;
+    std::unordered_map<uint64_t, Schema> m_schemas;
+  };
+
   /// <summary>
   /// Entry that contains Provider Handle, Provider MetaData and Provider GUID
   /// </summary>
@@ -82,6 +192,7 @@ class ETWProvider
     REGHANDLE providerHandle;
     std::vector<BYTE> providerMetaVector;
     GUID providerGuid;
+    std::shared_ptr<EventSchemaCache> schemaCache;
   };
 
   /// <summary>
@@ -142,6 +253,7 @@ class ETWProvider
       case EventFormat::ETW_MANIFEST: {
         tld::ProviderMetadataBuilder<std::vector<BYTE>> providerMetaBuilder(
             data.providerMetaVector);
+        data.schemaCache = std::make_shared<EventSchemaCache>();
 
         // Use Tenant ID as provider Name
         providerMetaBuilder.Begin(providerId.c_str());
@@ -278,6 +390,11 @@ class ETWProvider
       case PropertyType::kTypeCString:
         eventName = (char *)(nostd::get<const char *>(nameField));
         break;
+      case PropertyType::kTypeStringView: {
+        auto view = nostd::get<nostd::string_view>(nameField);
+        eventName = std::string(view.data(), view.size());
+        break;
+      }
       default:
         // If invalid event name is supplied, then we replace it with 'NoName'
         break;
@@ -342,6 +459,11 @@ class ETWProvider
           jObj[name] = temp;
           break;
         }
+        case PropertyType::kTypeStringView: {
+          auto temp  = nostd::get<nostd::string_view>(value);
+          jObj[name] = std::string(temp.data(), temp.size());
+          break;
+        }
 #  if HAVE_TYPE_GUID
           // TODO: consider adding UUID/GUID to spec
         case common::AttributeType::TYPE_GUID: {
@@ -441,12 +563,11 @@ class ETWProvider
       return STATUS_ERROR;
     }
 
-    UINT32 eventTags = MICROSOFT_EVENTTAG_NORMAL_PERSISTENCE;
-
-    std::vector<BYTE> byteVector;
     std::vector<BYTE> byteDataVector;
-    tld::EventMetadataBuilder<std::vector<BYTE>> builder(byteVector);
     tld::EventDataBuilder<std::vector<BYTE>> dbuilder(byteDataVector);
+    // The values are serialized in one pass, which collects the fields of the event schema.
+    std::vector<EventSchemaCache::Field> fields;
+    fields.reserve(eventData.size());
 
     const std::string EVENT_NAME = ETW_FIELD_NAME;
     std::string eventName        = "NoName";
@@ -459,14 +580,17 @@ class ETWProvider
       case PropertyType::kTypeCString:
         eventName = (char *)(nostd::get<const char *>(nameField));
         break;
+      case PropertyType::kTypeStringView: {
+        auto view = nostd::get<nostd::string_view>(nameField);
+        eventName = std::string(view.data(), view.size());
+        break;
+      }
       default:
         // This is user error. Invalid event name!
         // We supply default 'NoName' event name in this case.
         break;
     }
 
-    builder.Begin(eventName.c_str(), eventTags);
-
     for (auto &kv : eventData)
     {
       const char *name = kv.first.data();
@@ -474,56 +598,64 @@ class ETWProvider
       switch (value.index())
       {
         case PropertyType::kTypeBool: {
-          builder.AddField(name, tld::TypeBool8);
+          fields.push_back({name, tld::TypeBool8});
           UINT8 temp = static_cast<UINT8>(nostd::get<bool>(value));
           dbuilder.AddByte(temp);
           break;
         }
         case PropertyType::kTypeInt: {
-          builder.AddField(name, tld::TypeInt32);
+          fields.push_back({name, tld::TypeInt32});
           auto temp = nostd::get<int32_t>(value);
           dbuilder.AddValue(temp);
           break;
         }
         case PropertyType::kTypeInt64: {
-          builder.AddField(name, tld::TypeInt64);
+          fields.push_back({name, tld::TypeInt64});
           auto temp = nostd::get<int64_t>(value);
           dbuilder.AddValue(temp);
           break;
         }
         case PropertyType::kTypeUInt: {
-          builder.AddField(name, tld::TypeUInt32);
+          fields.push_back({name, tld::TypeUInt32});
           auto temp = nostd::get<uint32_t>(value);
           dbuilder.AddValue(temp);
           break;
         }
         case PropertyType::kTypeUInt64: {
-          builder.AddField(name, tld::TypeUInt64);
+          fields.push_back({name, tld::TypeUInt64});
           auto temp = nostd::get<uint64_t>(value);
           dbuilder.AddValue(temp);
           break;
         }
         case PropertyType::kTypeDouble: {
-          builder.AddField(name, tld::TypeDouble);
+          fields.push_back({name, tld::TypeDouble});
           auto temp = nostd::get<double>(value);
           dbuilder.AddValue(temp);
           break;
         }
         case PropertyType::kTypeString: {
-          builder.AddField(name, tld::TypeUtf8String);
+          fields.push_back({name, tld::TypeUtf8String});
           dbuilder.AddString(nostd::get<std::string>(value).data());
           break;
         }
         case PropertyType::kTypeCString: {
-          builder.AddField(name, tld::TypeUtf8String);
+          fields.push_back({name, tld::TypeUtf8String});
           auto temp = nostd::get<const char *>(value);
           dbuilder.AddString(temp);
           break;
         }
+        case PropertyType::kTypeStringView: {
+          // A borrowed string is not 0-terminated: it is written with its length.
+          fields.push_back({name, tld::TypeCountedUtf8String});
+          auto temp = nostd::get<nostd::string_view>(value);
+          dbuilder.AddCountedString(
+              temp.data(), static_cast<UINT16>((std::min)(temp.size(), size_t(UINT16_MAX))));
+          break;
+        }
 #if HAVE_TYPE_GUID
           // TODO: consider adding UUID/GUID to spec
         case PropertyType::kGUID: {
-          builder.AddField(name.c_str(), TypeGuid);
+          fields.push_back({name, tld::TypeGuid});
           auto temp = nostd::get<GUID>(value);
           dbuilder.AddBytes(&temp, sizeof(GUID));
           break;
@@ -545,7 +677,12 @@ class ETWProvider
       }
     }
 
-    if (!builder.End())  // Returns false if the metadata is too large.
+    // Providers which were not registered for TraceLogging have no cache.
+    EventSchemaCache uncachedSchemas;
+    EventSchemaCache &schemaCache =
+        providerData.schemaCache ? *providerData.schemaCache : uncachedSchemas;
+    auto metadata = schemaCache.get(eventName, fields);
+    if (metadata == nullptr)
     {
       return STATUS_EFBIG;  // if event is too big for UTC to handle
     }
@@ -562,13 +699,13 @@ class ETWProvider
     if ((ActivityId != nullptr) || (RelatedActivityId != nullptr))
     {
       writeResponse = tld::WriteEvent(providerData.providerHandle, eventDescriptor,
-                                      providerData.providerMetaVector.data(), byteVector.data(), 3,
+                                      providerData.providerMetaVector.data(), metadata->data(), 3,
                                       pDataDescriptors, ActivityId, RelatedActivityId);
     }
     else
     {
       writeResponse = tld::WriteEvent(providerData.providerHandle, eventDescriptor,
-                                      providerData.providerMetaVector.data(), byteVector.data(), 3,
+                                      providerData.providerMetaVector.data(), metadata->data(), 3,
                                       pDataDescriptors);
     }
 
@@ -540,8 +540,10 @@ class Tracer : public opentelemetry::trace::Tracer
       return AddEvent(span, name, timestamp, *evt);
     }
 #endif
-    // Pass a copy converted to Properties object on stack
-    Properties evtCopy = attributes;
+    // The event is written before AddEvent returns: the Properties object on stack borrows the
+    // string attributes rather than copying them.
+    Properties evtCopy;
+    evtCopy.Borrow(attributes);
     return AddEvent(span, name, timestamp, evtCopy);
   }
 
@@ -27,26 +27,37 @@ static exporter::etw::TelemetryProviderOptions providerOptions = {
     {"enableRelatedActivityId", false},
     {"enableAutoParent", false}};
 
+/**
+ * @brief Provider options selecting an event encoding.
+ * @param encoding "TLD" or "MsgPack"
+ */
+static exporter::etw::TelemetryProviderOptions WithEncoding(const std::string &encoding)
+{
+  auto options        = providerOptions;
+  options["encoding"] = encoding;
+  return options;
+}
+
 class ETWProviderStressTest
 {
-  exporter::etw::TracerProvider provider_;
   std::string mode_;
+  exporter::etw::TracerProvider provider_;
   nostd::shared_ptr<trace::Tracer> tracer_;
   nostd::shared_ptr<trace::Span> span_;
 
 public:
   /**
    * @brief Construct ETW Provider stress test object
-   * @param mode Operational mode: "TLD" or "MsgPack"
+   * @param mode Event encoding: "TLD" or "MsgPack"
    */
-  ETWProviderStressTest(std::string mode = "TLD") : mode_(mode), provider_(providerOptions) {}
+  ETWProviderStressTest(std::string mode = "TLD") : mode_(mode), provider_(WithEncoding(mode)) {}
 
   /**
    * @brief Initializer tracer and start a Span
    */
   void Initialize()
   {
-    tracer_ = provider_.GetTracer(providerName, mode_);
+    tracer_ = provider_.GetTracer(providerName);
     span_   = tracer_->StartSpan("Span");
   }
 
@@ -120,13 +131,15 @@ class ETWProviderStressTest
   }
 };
 
-ETWProviderStressTest provider;
+ETWProviderStressTest tldProvider("TLD");
+ETWProviderStressTest msgPackProvider("MsgPack");
 
 /**
  * @brief Create Properties and AddEvent(Properties) to Tracer
  * @param state Benchmark state.
+ * @param provider Provider of the encoding to measure.
  */
-void BM_AddPropertiesToTracer(benchmark::State &state)
+void BM_AddPropertiesToTracer(benchmark::State &state, ETWProviderStressTest &provider)
 {
   provider.Initialize();
   while (state.KeepRunning())
@@ -135,13 +148,15 @@ void BM_AddPropertiesToTracer(benchmark::State &state)
   }
   provider.Teardown();
 }
-BENCHMARK(BM_AddPropertiesToTracer);
+BENCHMARK_CAPTURE(BM_AddPropertiesToTracer, TLD, tldProvider);
+BENCHMARK_CAPTURE(BM_AddPropertiesToTracer, MsgPack, msgPackProvider);
 
 /**
  * @brief Create static Properties and AddEvent(Properties) to Tracer
  * @param state Benchmark state.
+ * @param provider Provider of the encoding to measure.
  */
-void BM_AddPropertiesStaticToTracer(benchmark::State &state)
+void BM_AddPropertiesStaticToTracer(benchmark::State &state, ETWProviderStressTest &provider)
 {
   provider.Initialize();
   while (state.KeepRunning())
@@ -150,13 +165,15 @@ void BM_AddPropertiesStaticToTracer(benchmark::State &state)
   }
   provider.Teardown();
 }
-BENCHMARK(BM_AddPropertiesStaticToTracer);
+BENCHMARK_CAPTURE(BM_AddPropertiesStaticToTracer, TLD, tldProvider);
+BENCHMARK_CAPTURE(BM_AddPropertiesStaticToTracer, MsgPack, msgPackProvider);
 
 /**
  * @brief Create event via initializer list and AddEvent({...}) to Tracer
  * @param state Benchmark state.
+ * @param provider Provider of the encoding to measure.
  */
-void BM_AddInitListToTracer(benchmark::State &state)
+void BM_AddInitListToTracer(benchmark::State &state, ETWProviderStressTest &provider)
 {
   provider.Initialize();
   while (state.KeepRunning())
@@ -165,14 +182,16 @@ void BM_AddInitListToTracer(benchmark::State &state)
   }
   provider.Teardown();
 }
-BENCHMARK(BM_AddInitListToTracer);
+BENCHMARK_CAPTURE(BM_AddInitListToTracer, TLD, tldProvider);
+BENCHMARK_CAPTURE(BM_AddInitListToTracer, MsgPack, msgPackProvider);
 
 /**
  * @brief Create event as `std::map<std::string, common::AttributeValue>`
  * and AddEvent(event) to Tracer.
  * @param state Benchmark state.
+ * @param provider Provider of the encoding to measure.
  */
-void BM_AddMapToTracer(benchmark::State &state)
+void BM_AddMapToTracer(benchmark::State &state, ETWProviderStressTest &provider)
 {
   provider.Initialize();
   while (state.KeepRunning())
@@ -181,7 +200,59 @@ void BM_AddMapToTracer(benchmark::State &state)
   }
   provider.Teardown();
 }
-BENCHMARK(BM_AddMapToTracer);
+BENCHMARK_CAPTURE(BM_AddMapToTracer, TLD, tldProvider);
+BENCHMARK_CAPTURE(BM_AddMapToTracer, MsgPack, msgPackProvider);
+
+/**
+ * @brief Encode and write Properties with ETWProvider, without a tracer.
+ * @param state Benchmark state.
+ * @param format Event encoding to measure.
+ */
+void BM_WriteProperties(benchmark::State &state, ETWProvider::EventFormat format)
+{
+  static ETWProvider etw;
+  auto &handle     = etw.open(providerName, format);
+  Properties event = {{ETW_FIELD_NAME, "MyEvent"},
+                      {"uint32Key", (uint32_t)1234},
+                      {"uint64Key", (uint64_t)1234567890},
+                      {"strKey", "someValue"}};
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(etw.write(handle, event, nullptr, nullptr, 0, format));
+  }
+  etw.close(handle);
+}
+BENCHMARK_CAPTURE(BM_WriteProperties, TLD, ETWProvider::EventFormat::ETW_MANIFEST);
+BENCHMARK_CAPTURE(BM_WriteProperties, MsgPack, ETWProvider::EventFormat::ETW_MSGPACK);
+
+/**
+ * @brief Convert attributes to Properties, copying or borrowing their strings.
+ * @param state Benchmark state.
+ * @param borrow true to borrow the strings.
+ */
+void BM_PropertiesFromAttributes(benchmark::State &state, bool borrow)
+{
+  std::map<std::string, common::AttributeValue> attributes = {
+      {"uint32Key", (uint32_t)1234},
+      {"uint64Key", (uint64_t)1234567890},
+      {"strKey", nostd::string_view("a value which does not fit in a small string")}};
+  common::KeyValueIterableView<std::map<std::string, common::AttributeValue>> view(attributes);
+  while (state.KeepRunning())
+  {
+    Properties event;
+    if (borrow)
+    {
+      event.Borrow(view);
+    }
+    else
+    {
+      event = view;
+    }
+    benchmark::DoNotOptimize(event);
+  }
+}
+BENCHMARK_CAPTURE(BM_PropertiesFromAttributes, Copy, false);
+BENCHMARK_CAPTURE(BM_PropertiesFromAttributes, Borrow, true);
 
 }  // namespace
 
@@ -7,6 +7,9 @@
 #include <opentelemetry/ext/http/client/http_client.h>
 #include <opentelemetry/sdk/trace/exporter.h>
 
+#include <chrono>
+#include <string>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
@@ -32,6 +35,16 @@ struct JaegerExporterOptions
   uint16_t server_port             = 6831;
   // Only applicable when using kThriftHttp transport.
   ext::http::client::Headers headers;
+  // Only applicable when using kThriftHttp transport: compression of the requests, "gzip" or
+  // "none".
+  std::string compression = "none";
+  // Only applicable when using kThriftHttp transport: how long the spans of an export may be held
+  // back, so that the following exports send theirs in the same request. With zero, each export
+  // sends its own requests.
+  std::chrono::milliseconds max_batch_delay = std::chrono::milliseconds(0);
+  // Only applicable when using kThriftHttp transport: the size in bytes of the requests the
+  // spans are gathered in, before compression.
+  uint32_t max_request_size = 1 << 22;
 };
 
 class JaegerExporter final : public opentelemetry::sdk::trace::SpanExporter
@@ -4,18 +4,66 @@
 #include "THttpTransport.h"
 #include "opentelemetry/ext/http/client/http_client_factory.h"
 
+#include <zlib.h>
+#include <cstring>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
 namespace jaeger
 {
 
-THttpTransport::THttpTransport(std::string endpoint, ext::http::client::Headers extra_headers)
+namespace
+{
+/**
+ * Compresses body with gzip into compressed. Returns false if compression fails or does not make
+ * the body smaller.
+ */
+bool GzipBody(const std::vector<uint8_t> &body, std::vector<uint8_t> &compressed)
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // 16 added to the window bits selects the gzip wrapper, which Content-Encoding: gzip expects.
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) !=
+      Z_OK)
+  {
+    return false;
+  }
+
+  compressed.resize(deflateBound(&stream, static_cast<uLong>(body.size())));
+  stream.next_in   = const_cast<Bytef *>(body.data());
+  stream.avail_in  = static_cast<uInt>(body.size());
+  stream.next_out  = compressed.data();
+  stream.avail_out = static_cast<uInt>(compressed.size());
+  const int result = deflate(&stream, Z_FINISH);
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  return result == Z_STREAM_END && compressed.size() < body.size();
+}
+}  // namespace
+
+THttpTransport::THttpTransport(std::string endpoint,
+                               ext::http::client::Headers extra_headers,
+                               bool gzip)
+    : THttpTransport(std::move(endpoint),
+                     std::move(extra_headers),
+                     gzip,
+                     ext::http::client::HttpClientFactory::CreateSync())
+{}
+
+THttpTransport::THttpTransport(std::string endpoint,
+                               ext::http::client::Headers extra_headers,
+                               bool gzip,
+                               std::shared_ptr<ext::http::client::HttpClientSync> client)
     : endpoint(std::move(endpoint)),
       headers(std::move(extra_headers)),
-      client(ext::http::client::HttpClientFactory::CreateSync())
+      gzip(gzip),
+      client(std::move(client))
 {
   headers.insert({{"Content-Type", "application/vnd.apache.thrift.binary"}});
+  gzip_headers = headers;
+  gzip_headers.insert({{"Content-Encoding", "gzip"}});
 }
 
 THttpTransport::~THttpTransport() {}
@@ -39,7 +87,9 @@ void THttpTransport::write(const uint8_t *buf, uint32_t len)
 
 bool THttpTransport::sendSpans()
 {
-  auto result = client->Post(endpoint, request_buffer, headers);
+  const bool compressed = gzip && GzipBody(request_buffer, gzip_buffer);
+  auto result = compressed ? client->Post(endpoint, gzip_buffer, gzip_headers)
+                           : client->Post(endpoint, request_buffer, headers);
   request_buffer.clear();
 
   // TODO: Add logging once global log handling is available.
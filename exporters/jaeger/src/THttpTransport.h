@@ -14,10 +14,22 @@ namespace exporter
 namespace jaeger
 {
 
+/**
+ * Buffers what is written to it, and posts it as the body of a request on sendSpans(). The
+ * requests are sent by a synchronous HTTP client, which keeps the connection to the collector
+ * alive from one request to the next.
+ */
 class THttpTransport : public apache::thrift::transport::TVirtualTransport<THttpTransport>
 {
 public:
-  THttpTransport(std::string endpoint, ext::http::client::Headers extra_headers);
+  /**
+   * @param gzip: compress the bodies with gzip, if it makes them smaller
+   */
+  THttpTransport(std::string endpoint, ext::http::client::Headers extra_headers, bool gzip = false);
+  THttpTransport(std::string endpoint,
+                 ext::http::client::Headers extra_headers,
+                 bool gzip,
+                 std::shared_ptr<ext::http::client::HttpClientSync> client);
   ~THttpTransport() override;
 
   bool isOpen() const override;
@@ -31,8 +43,13 @@ class THttpTransport : public apache::thrift::transport::TVirtualTransport<THttp
 private:
   std::string endpoint;
   ext::http::client::Headers headers;
+  // The headers of the compressed requests
+  ext::http::client::Headers gzip_headers;
+  bool gzip;
   std::shared_ptr<ext::http::client::HttpClientSync> client;
   std::vector<uint8_t> request_buffer;
+  // The compressed request_buffer, whose memory is kept for the next requests
+  std::vector<uint8_t> gzip_buffer;
 };
 
 }  // namespace jaeger
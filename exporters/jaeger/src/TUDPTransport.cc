@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <sstream>  // std::stringstream
+#include <vector>
 
 #include "TUDPTransport.h"
 #include "opentelemetry/sdk_config.h"
@@ -106,6 +107,52 @@ void TUDPTransport::write(const uint8_t *buf, uint32_t len)
          len, 0, server_addr_info_->ai_addr, sockaddr_len);
 }
 
+void TUDPTransport::writePackets(const uint8_t *buf, const uint32_t *ends, uint32_t count)
+{
+  if (!server_addr_info_)
+  {
+    return;
+  }
+#if defined(__linux__)
+  std::vector<struct iovec> iovecs(count);
+  std::vector<struct mmsghdr> messages(count);
+  uint32_t begin = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    iovecs[i].iov_base = const_cast<uint8_t *>(buf + begin);
+    iovecs[i].iov_len  = ends[i] - begin;
+    begin              = ends[i];
+
+    memset(&messages[i], 0, sizeof(messages[i]));
+    messages[i].msg_hdr.msg_name    = server_addr_info_->ai_addr;
+    messages[i].msg_hdr.msg_namelen = sockaddr_len;
+    messages[i].msg_hdr.msg_iov     = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // sendmmsg may send fewer messages than asked, go on with the others.
+  uint32_t sent = 0;
+  while (sent < count)
+  {
+    int result = sendmmsg(socket_, messages.data() + sent, count - sent, 0);
+    if (result <= 0)
+    {
+      // Skip the message which failed, as sendto would.
+      ++sent;
+      continue;
+    }
+    sent += static_cast<uint32_t>(result);
+  }
+#else
+  uint32_t begin = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    write(buf + begin, ends[i] - begin);
+    begin = ends[i];
+  }
+#endif
+}
+
 void TUDPTransport::flush() {}
 
 }  // namespace jaeger
@@ -38,6 +38,12 @@ class TUDPTransport : public apache::thrift::transport::TVirtualTransport<TUDPTr
 
   void write(const uint8_t *buf, uint32_t len);
 
+  /**
+   * Send count packets, one datagram each, stored one after the other in buf. Packet i ends at
+   * ends[i]. Where available, the packets are sent with a single system call.
+   */
+  void writePackets(const uint8_t *buf, const uint32_t *ends, uint32_t count);
+
   void flush() override;
 
 private:
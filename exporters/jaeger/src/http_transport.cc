@@ -3,6 +3,9 @@
 
 #include "http_transport.h"
 
+#include "opentelemetry/ext/http/client/http_client_factory.h"
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
 #include <thrift/protocol/TBinaryProtocol.h>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -14,24 +17,101 @@ namespace jaeger
 using TBinaryProtocol = apache::thrift::protocol::TBinaryProtocol;
 using TTransport      = apache::thrift::transport::TTransport;
 
-HttpTransport::HttpTransport(std::string endpoint, ext::http::client::Headers headers)
+namespace
+{
+// Size in bytes of a batch, besides its process and its spans.
+constexpr uint32_t kBatchOverhead = 16;
+}  // namespace
+
+HttpTransport::HttpTransport(const JaegerExporterOptions &options)
+    : HttpTransport(options, ext::http::client::HttpClientFactory::CreateSync())
+{}
+
+HttpTransport::HttpTransport(const JaegerExporterOptions &options,
+                             std::shared_ptr<ext::http::client::HttpClientSync> client)
+    : max_batch_delay_(options.max_batch_delay), max_request_size_(options.max_request_size)
+{
+  endpoint_transport_ = std::make_shared<THttpTransport>(
+      options.endpoint, options.headers, options.compression == "gzip", std::move(client));
+  protocol_       = std::shared_ptr<TProtocol>(new TBinaryProtocol(endpoint_transport_));
+  batch_buffer_   = std::shared_ptr<TMemoryBuffer>(new TMemoryBuffer());
+  batch_protocol_ = std::shared_ptr<TProtocol>(new TBinaryProtocol(batch_buffer_));
+}
+
+HttpTransport::~HttpTransport()
 {
-  endpoint_transport_ = std::make_shared<THttpTransport>(std::move(endpoint), std::move(headers));
-  protocol_           = std::shared_ptr<TProtocol>(new TBinaryProtocol(endpoint_transport_));
+  if (pending_span_count_ > 0)
+  {
+    SendPending();
+  }
 }
 
 int HttpTransport::EmitBatch(const thrift::Batch &batch)
 {
-  batch.write(protocol_.get());
+  batch_buffer_->resetBuffer();
+  batch.process.write(batch_protocol_.get());
+  const uint32_t process_size = batch_buffer_->available_read();
+  for (const auto &span : batch.spans)
+  {
+    span.write(batch_protocol_.get());
+  }
+  uint8_t *data = nullptr;
+  uint32_t size = 0;
+  batch_buffer_->getBuffer(&data, &size);
 
-  if (!endpoint_transport_->sendSpans())
+  // Send the pending spans first if those of the batch do not fit in their request.
+  if (pending_span_count_ > 0 &&
+      kBatchOverhead + size + pending_spans_.size() > max_request_size_ && !SendPending())
   {
-    return 0;
+    OTEL_INTERNAL_LOG_ERROR("[JAEGER TRACE Exporter] Sending the pending spans failed");
+  }
+
+  if (pending_span_count_ == 0)
+  {
+    process_            = batch.process;
+    first_pending_time_ = std::chrono::steady_clock::now();
   }
+  pending_spans_.insert(pending_spans_.end(), data + process_size, data + size);
+  pending_span_count_ += static_cast<uint32_t>(batch.spans.size());
 
+  if (max_batch_delay_.count() == 0 && !SendPending())
+  {
+    return 0;
+  }
   return static_cast<int>(batch.spans.size());
 }
 
+void HttpTransport::Flush()
+{
+  if (pending_span_count_ > 0 &&
+      std::chrono::steady_clock::now() - first_pending_time_ >= max_batch_delay_ && !SendPending())
+  {
+    OTEL_INTERNAL_LOG_ERROR("[JAEGER TRACE Exporter] Sending the pending spans failed");
+  }
+}
+
+bool HttpTransport::SendPending()
+{
+  // Writes what Batch::write writes, with the spans serialized beforehand.
+  protocol_->writeStructBegin("Batch");
+  protocol_->writeFieldBegin("process", apache::thrift::protocol::T_STRUCT, 1);
+  process_.write(protocol_.get());
+  protocol_->writeFieldEnd();
+  protocol_->writeFieldBegin("spans", apache::thrift::protocol::T_LIST, 2);
+  protocol_->writeListBegin(apache::thrift::protocol::T_STRUCT, pending_span_count_);
+  endpoint_transport_->write(pending_spans_.data(), static_cast<uint32_t>(pending_spans_.size()));
+  protocol_->writeListEnd();
+  protocol_->writeFieldEnd();
+  protocol_->writeFieldStop();
+  protocol_->writeStructEnd();
+
+  // Keeps the memory of the buffer for the next spans.
+  pending_spans_.clear();
+  pending_span_count_ = 0;
+
+  return endpoint_transport_->sendSpans();
+}
+
 }  // namespace jaeger
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -3,10 +3,15 @@
 #include "THttpTransport.h"
 #include "transport.h"
 
+#include <opentelemetry/exporters/jaeger/jaeger_exporter.h>
+
 #include <thrift/protocol/TProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
 #include <thrift/transport/TTransport.h>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -14,24 +19,50 @@ namespace exporter
 namespace jaeger
 {
 
-using TProtocol = apache::thrift::protocol::TProtocol;
+using TProtocol     = apache::thrift::protocol::TProtocol;
+using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
 
+/**
+ * Sends batches to the collector over HTTP, binary encoded, one batch per request.
+ *
+ * With options.max_batch_delay, the spans of the batches are held back until Flush() comes
+ * max_batch_delay after the first of them, and sent together in batches of at most
+ * options.max_request_size bytes, so that several exports share a request. The spans left are
+ * sent when the transport is destroyed.
+ */
 class HttpTransport : public Transport
 {
 public:
-  HttpTransport(std::string endpoint, ext::http::client::Headers headers);
+  explicit HttpTransport(const JaegerExporterOptions &options);
+
+  HttpTransport(const JaegerExporterOptions &options,
+                std::shared_ptr<ext::http::client::HttpClientSync> client);
+
+  ~HttpTransport() override;
 
   int EmitBatch(const thrift::Batch &batch) override;
 
-  uint32_t MaxPacketSize() const override
-  {
-    // Default to 4 MiB POST body size.
-    return 1 << 22;
-  }
+  void Flush() override;
+
+  uint32_t MaxPacketSize() const override { return max_request_size_; }
 
 private:
+  /* Sends the pending spans in one batch. Returns false if the request fails. */
+  bool SendPending();
+
   std::shared_ptr<THttpTransport> endpoint_transport_;
   std::shared_ptr<TProtocol> protocol_;
+  // Serializes the process and the spans of a batch, to measure them
+  std::shared_ptr<TMemoryBuffer> batch_buffer_;
+  std::shared_ptr<TProtocol> batch_protocol_;
+  // The process of the pending spans
+  thrift::Process process_;
+  // The pending spans, serialized one after the other
+  std::vector<uint8_t> pending_spans_;
+  uint32_t pending_span_count_ = 0;
+  std::chrono::steady_clock::time_point first_pending_time_;
+  const std::chrono::milliseconds max_batch_delay_;
+  const uint32_t max_request_size_;
 };
 
 }  // namespace jaeger
@@ -83,8 +83,7 @@ void JaegerExporter::InitializeEndpoint()
 
   if (options_.transport_format == TransportFormat::kThriftHttp)
   {
-    auto transport =
-        std::unique_ptr<HttpTransport>(new HttpTransport(options_.endpoint, options_.headers));
+    auto transport = std::unique_ptr<HttpTransport>(new HttpTransport(options_));
     sender_ = std::unique_ptr<ThriftSender>(new ThriftSender(std::move(transport)));
     return;
   }
@@ -17,7 +17,9 @@ using namespace jaegertracing;
 ThriftSender::ThriftSender(std::unique_ptr<Transport> &&transport)
     : transport_(std::move(transport)),
       protocol_factory_(new apache::thrift::protocol::TCompactProtocolFactory()),
-      thrift_buffer_(new apache::thrift::transport::TMemoryBuffer(transport_->MaxPacketSize()))
+      thrift_buffer_(new apache::thrift::transport::TMemoryBuffer(transport_->MaxPacketSize())),
+      thrift_protocol_(protocol_factory_->getProtocol(thrift_buffer_)),
+      max_batch_bytes_(transport_->MaxPacketSize() - kEmitBatchOverhead)
 {}
 
 int ThriftSender::Append(std::unique_ptr<JaegerRecordable> &&span) noexcept
@@ -27,68 +29,82 @@ int ThriftSender::Append(std::unique_ptr<JaegerRecordable> &&span) noexcept
     return 0;
   }
 
-  uint32_t max_span_bytes = transport_->MaxPacketSize() - kEmitBatchOverhead;
   if (process_.serviceName.empty())
   {
     process_.serviceName = span->ServiceName();
     process_.__set_tags(span->ResourceTags());
 
     process_bytes_size_ = CalcSizeOfSerializedThrift(process_);
-    max_span_bytes -= process_bytes_size_;
+    byte_buffer_size_   = process_bytes_size_;
   }
 
-  auto jaeger_span = std::unique_ptr<thrift::Span>(span->Span());
-  jaeger_span->__set_tags(span->Tags());
-  jaeger_span->__set_logs(span->Logs());
-  jaeger_span->__set_references(span->References());
+  // The vectors are moved rather than copied by the __set_ methods.
+  auto jaeger_span        = std::unique_ptr<thrift::Span>(span->Span());
+  jaeger_span->tags       = span->Tags();
+  jaeger_span->logs       = span->Logs();
+  jaeger_span->references = span->References();
+
+  jaeger_span->__isset.tags       = true;
+  jaeger_span->__isset.logs       = true;
+  jaeger_span->__isset.references = true;
 
   const uint32_t span_size = CalcSizeOfSerializedThrift(*jaeger_span);
-  if (span_size > max_span_bytes)
+  if (span_size > max_batch_bytes_ - process_bytes_size_)
   {
     OTEL_INTERNAL_LOG_ERROR("[JAEGER TRACE Exporter] Append() failed: too large span");
     return 0;
   }
 
-  byte_buffer_size_ += span_size;
-  if (byte_buffer_size_ <= max_span_bytes)
+  // Emit the buffered spans first if this one does not fit in their batch.
+  int flushed = 0;
+  if (byte_buffer_size_ + span_size > max_batch_bytes_)
   {
-    span_buffer_.push_back(*jaeger_span);
-    if (byte_buffer_size_ < max_span_bytes)
-    {
-      return 0;
-    }
-    else
-    {
-      // byte buffer is full so flush it before appending new span.
-      return Flush();
-    }
+    flushed = EmitBuffer();
   }
 
-  const auto flushed = Flush();
-  span_buffer_.push_back(*jaeger_span);
-  byte_buffer_size_ = span_size + process_bytes_size_;
+  // Thrift types have no move constructor, swap the span into the buffer instead of copying it.
+  span_buffer_.emplace_back();
+  swap(span_buffer_.back(), *jaeger_span);
+  byte_buffer_size_ += span_size;
 
+  if (byte_buffer_size_ == max_batch_bytes_)
+  {
+    flushed += EmitBuffer();
+  }
   return flushed;
 }
 
-int ThriftSender::Flush()
+int ThriftSender::EmitBuffer()
 {
   if (span_buffer_.empty())
   {
     return 0;
   }
 
+  // Lend the process and the spans to the batch rather than copying them.
   thrift::Batch batch;
-  batch.__set_process(process_);
-  batch.__set_spans(span_buffer_);
+  swap(batch.process, process_);
+  batch.spans.swap(span_buffer_);
 
   int spans_flushed = transport_->EmitBatch(batch);
 
+  swap(batch.process, process_);
+  batch.spans.swap(span_buffer_);
   ResetBuffers();
 
   return spans_flushed;
 }
 
+int ThriftSender::Flush()
+{
+  int spans_flushed = EmitBuffer();
+  if (transport_ != nullptr)
+  {
+    transport_->Flush();
+  }
+  return spans_flushed;
+}
+
 void ThriftSender::Close()
 {
   Flush();
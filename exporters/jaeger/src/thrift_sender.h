@@ -42,6 +42,9 @@ class ThriftSender : public Sender
     byte_buffer_size_ = process_bytes_size_;
   }
 
+  /* Emits the buffered spans, without flushing the transport. */
+  int EmitBuffer();
+
   template <typename ThriftType>
   uint32_t CalcSizeOfSerializedThrift(const ThriftType &base)
   {
@@ -49,8 +52,7 @@ class ThriftSender : public Sender
     uint32_t size = 0;
 
     thrift_buffer_->resetBuffer();
-    auto protocol = protocol_factory_->getProtocol(thrift_buffer_);
-    base.write(protocol.get());
+    base.write(thrift_protocol_.get());
     thrift_buffer_->getBuffer(&data, &size);
     return size;
   }
@@ -61,12 +63,15 @@ class ThriftSender : public Sender
   std::unique_ptr<Transport> transport_;
   std::unique_ptr<apache::thrift::protocol::TProtocolFactory> protocol_factory_;
   std::shared_ptr<apache::thrift::transport::TMemoryBuffer> thrift_buffer_;
+  // Serializes into thrift_buffer_, to measure spans
+  std::shared_ptr<apache::thrift::protocol::TProtocol> thrift_protocol_;
   thrift::Process process_;
 
-  // Size in bytes of the serialization buffer.
+  // Size in bytes of the process and the buffered spans once serialized.
   uint32_t byte_buffer_size_   = 0;
   uint32_t process_bytes_size_ = 0;
-  uint32_t max_span_bytes_     = 0;
+  // Size in bytes available to the process and the spans in a batch.
+  uint32_t max_batch_bytes_ = 0;
   friend class MockThriftSender;
 
 protected:
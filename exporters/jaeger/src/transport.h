@@ -23,6 +23,11 @@ class Transport
 
   virtual int EmitBatch(const thrift::Batch &batch) = 0;
   virtual uint32_t MaxPacketSize() const            = 0;
+
+  /**
+   * Send the batches which the transport holds back to send them together, if any.
+   */
+  virtual void Flush() {}
 };
 
 }  // namespace jaeger
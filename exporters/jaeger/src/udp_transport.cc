@@ -17,16 +17,17 @@ UDPTransport::UDPTransport(const std::string &addr, uint16_t port)
 {
   InitSocket();
 
-  endpoint_transport_ = std::shared_ptr<TTransport>(new TUDPTransport(addr, port));
+  endpoint_transport_ = std::shared_ptr<TUDPTransport>(new TUDPTransport(addr, port));
   endpoint_transport_->open();
-  transport_ =
-      std::shared_ptr<TTransport>(new TBufferedTransport(endpoint_transport_, max_packet_size_));
-  protocol_ = std::shared_ptr<TProtocol>(new TCompactProtocol(transport_));
-  agent_    = std::unique_ptr<AgentClient>(new AgentClient(protocol_));
+  transport_ = std::shared_ptr<TMemoryBuffer>(new TMemoryBuffer(max_packet_size_));
+  protocol_  = std::shared_ptr<TProtocol>(new TCompactProtocol(transport_));
+  agent_     = std::unique_ptr<AgentClient>(new AgentClient(protocol_));
+  packet_ends_.reserve(kMaxPendingPackets);
 }
 
 UDPTransport::~UDPTransport()
 {
+  Flush();
   CleanSocket();
 }
 
@@ -73,14 +74,40 @@ int UDPTransport::EmitBatch(const thrift::Batch &batch)
 {
   try
   {
+    // Appends the packet to the memory buffer, whose flush does nothing.
     agent_->emitBatch(batch);
+    packet_ends_.push_back(transport_->available_read());
   }
   catch (...)
-  {}
+  {
+    // Drops the partly written packet, after sending those before it.
+    Flush();
+  }
+
+  if (packet_ends_.size() >= kMaxPendingPackets)
+  {
+    Flush();
+  }
 
   return static_cast<int>(batch.spans.size());
 }
 
+void UDPTransport::Flush()
+{
+  if (!packet_ends_.empty())
+  {
+    uint8_t *data = nullptr;
+    uint32_t size = 0;
+    transport_->getBuffer(&data, &size);
+    endpoint_transport_->writePackets(data, packet_ends_.data(),
+                                      static_cast<uint32_t>(packet_ends_.size()));
+  }
+
+  // Keeps the memory of the buffer for the next packets.
+  transport_->resetBuffer();
+  packet_ends_.clear();
+}
+
 }  // namespace jaeger
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
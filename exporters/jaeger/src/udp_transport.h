@@ -15,6 +15,7 @@
 #include <thrift/transport/TTransport.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -26,19 +27,30 @@ using AgentClient        = jaegertracing::agent::thrift::AgentClient;
 using TBinaryProtocol    = apache::thrift::protocol::TBinaryProtocol;
 using TCompactProtocol   = apache::thrift::protocol::TCompactProtocol;
 using TBufferedTransport = apache::thrift::transport::TBufferedTransport;
+using TMemoryBuffer      = apache::thrift::transport::TMemoryBuffer;
 using TProtocol          = apache::thrift::protocol::TProtocol;
 using TTransport         = apache::thrift::transport::TTransport;
 
+/**
+ * Sends batches to the agent over UDP, one datagram per batch.
+ *
+ * Batches are serialized into a reusable buffer and held back until Flush(), or until
+ * kMaxPendingPackets of them are pending, so that they are sent with as few system calls as
+ * possible.
+ */
 class UDPTransport : public Transport
 {
 public:
   static constexpr auto kUDPPacketMaxLength = 65000;
+  static constexpr auto kMaxPendingPackets  = 16;
 
   UDPTransport(const std::string &addr, uint16_t port);
   virtual ~UDPTransport();
 
   int EmitBatch(const thrift::Batch &batch) override;
 
+  void Flush() override;
+
   uint32_t MaxPacketSize() const override { return max_packet_size_; }
 
   void InitSocket();
@@ -46,9 +58,12 @@ class UDPTransport : public Transport
 
 private:
   std::unique_ptr<AgentClient> agent_;
-  std::shared_ptr<TTransport> endpoint_transport_;
-  std::shared_ptr<TTransport> transport_;
+  std::shared_ptr<TUDPTransport> endpoint_transport_;
+  // The pending packets, one after the other
+  std::shared_ptr<TMemoryBuffer> transport_;
   std::shared_ptr<TProtocol> protocol_;
+  // Where each pending packet ends in transport_
+  std::vector<uint32_t> packet_ends_;
   uint32_t max_packet_size_;
 };
 
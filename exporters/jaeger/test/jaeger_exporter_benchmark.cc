@@ -0,0 +1,85 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <opentelemetry/exporters/jaeger/recordable.h>
+#include "test/trace/span_shapes.h"
+
+#ifdef BAZEL_BUILD
+#  include "exporters/jaeger/src/thrift_sender.h"
+#  include "exporters/jaeger/src/udp_transport.h"
+#else
+#  include "thrift_sender.h"
+#  include "udp_transport.h"
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace jaeger = opentelemetry::exporter::jaeger;
+using span_shapes::SpanShape;
+
+namespace
+{
+/**
+ * Serializes the batches as UDPTransport does, into a memory buffer which is counted and cleared
+ * instead of being sent.
+ */
+class NullTransport : public jaeger::Transport
+{
+public:
+  explicit NullTransport(uint64_t &bytes)
+      : buffer_(new jaeger::TMemoryBuffer(jaeger::UDPTransport::kUDPPacketMaxLength)),
+        agent_(new jaeger::AgentClient(
+            std::shared_ptr<jaeger::TProtocol>(new jaeger::TCompactProtocol(buffer_)))),
+        bytes_(bytes)
+  {}
+
+  int EmitBatch(const jaeger::thrift::Batch &batch) override
+  {
+    agent_->emitBatch(batch);
+    bytes_ += buffer_->available_read();
+    buffer_->resetBuffer();
+    return static_cast<int>(batch.spans.size());
+  }
+
+  uint32_t MaxPacketSize() const override { return jaeger::UDPTransport::kUDPPacketMaxLength; }
+
+private:
+  std::shared_ptr<jaeger::TMemoryBuffer> buffer_;
+  std::unique_ptr<jaeger::AgentClient> agent_;
+  uint64_t &bytes_;
+};
+
+// Converts batches into Thrift spans and serializes them into UDP packets, without sending them.
+void BM_JaegerSerialization(benchmark::State &state)
+{
+  const auto shape = static_cast<SpanShape>(state.range(0));
+  uint64_t bytes   = 0;
+  jaeger::ThriftSender sender(std::unique_ptr<jaeger::Transport>(new NullTransport(bytes)));
+  std::vector<std::unique_ptr<jaeger::JaegerRecordable>> spans(span_shapes::kSpansPerBatch);
+  for (auto _ : state)
+  {
+    // The sender consumes the recordables, record the next batch outside of the timed region.
+    state.PauseTiming();
+    for (int i = 0; i < span_shapes::kSpansPerBatch; ++i)
+    {
+      spans[i].reset(new jaeger::JaegerRecordable);
+      span_shapes::FillSpan(*spans[i], shape, i);
+    }
+    state.ResumeTiming();
+
+    for (auto &span : spans)
+    {
+      sender.Append(std::move(span));
+    }
+    sender.Flush();
+  }
+  span_shapes::ReportThroughput(state, bytes);
+}
+BENCHMARK(BM_JaegerSerialization)->Apply(span_shapes::ApplyShapes);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -8,11 +8,15 @@
 #include "opentelemetry/sdk/trace/tracer_provider.h"
 
 #ifdef BAZEL_BUILD
+#  include "exporters/jaeger/src/http_transport.h"
 #  include "exporters/jaeger/src/thrift_sender.h"
 #else
+#  include "http_transport.h"
 #  include "thrift_sender.h"
 #endif
 
+#include <thrift/protocol/TBinaryProtocol.h>
+
 #include <gtest/gtest.h>
 #include "gmock/gmock.h"
 
@@ -65,8 +69,36 @@ class MockTransport : public Transport
 public:
   MOCK_METHOD(int, EmitBatch, (const thrift::Batch &), (override));
   MOCK_METHOD(uint32_t, MaxPacketSize, (), (const, override));
+  MOCK_METHOD(void, Flush, (), (override));
 };
 
+class MockHttpClient : public ext::http::client::HttpClientSync
+{
+public:
+  MOCK_METHOD(ext::http::client::Result,
+              Post,
+              (const nostd::string_view &,
+               const ext::http::client::Body &,
+               const ext::http::client::Headers &),
+              (noexcept, override));
+  MOCK_METHOD(ext::http::client::Result,
+              Get,
+              (const nostd::string_view &, const ext::http::client::Headers &),
+              (noexcept, override));
+};
+
+thrift::Batch MakeBatch(int span_count)
+{
+  thrift::Batch batch;
+  batch.process.serviceName = "unit_test_service";
+  for (int i = 0; i < span_count; ++i)
+  {
+    batch.spans.emplace_back();
+    batch.spans.back().operationName = "Test span " + std::to_string(i);
+  }
+  return batch;
+}
+
 // Create spans, let processor call Export()
 TEST_F(JaegerExporterTestPeer, ExportIntegrationTest)
 {
@@ -112,6 +144,89 @@ TEST_F(JaegerExporterTestPeer, ExportIntegrationTest)
   ASSERT_TRUE(child_ctx.IsValid());
 }
 
+// Spans are emitted in a single batch, and the transport is flushed with the sender.
+TEST_F(JaegerExporterTestPeer, ThriftSenderBatchesSpans)
+{
+  auto mock_transport = new MockTransport;
+  EXPECT_CALL(*mock_transport, MaxPacketSize()).WillRepeatedly(Return(65000));
+  ThriftSender sender(std::unique_ptr<MockTransport>{mock_transport});
+
+  EXPECT_CALL(*mock_transport, EmitBatch(_))
+      .Times(Exactly(1))
+      .WillOnce(Invoke([](const thrift::Batch &batch) {
+        EXPECT_EQ(batch.process.serviceName, "unit_test_service");
+        return static_cast<int>(batch.spans.size());
+      }));
+  EXPECT_CALL(*mock_transport, Flush()).Times(AtLeast(1));
+
+  int appended = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    std::unique_ptr<JaegerRecordable> recordable(new JaegerRecordable);
+    recordable->SetName("Test span " + std::to_string(i));
+    recordable->SetResource(resource::Resource::Create({{"service.name", "unit_test_service"}}));
+    appended += sender.Append(std::move(recordable));
+  }
+  EXPECT_EQ(appended, 0);
+  EXPECT_EQ(sender.Flush(), 3);
+}
+
+// The batches emitted within max_batch_delay are sent in one request, which holds a single batch.
+TEST_F(JaegerExporterTestPeer, HttpTransportGathersBatches)
+{
+  auto mock_http_client = new MockHttpClient;
+  ext::http::client::Body body;
+  EXPECT_CALL(*mock_http_client, Post(_, _, _))
+      .Times(Exactly(1))
+      .WillOnce(Invoke([&body](const nostd::string_view &, const ext::http::client::Body &sent,
+                               const ext::http::client::Headers &headers) {
+        EXPECT_EQ(headers.count("Content-Encoding"), 0u);
+        body = sent;
+        return ext::http::client::Result(nullptr, ext::http::client::SessionState::Response);
+      }));
+
+  JaegerExporterOptions options;
+  options.max_batch_delay = std::chrono::hours(1);
+  {
+    HttpTransport transport(
+        options, std::shared_ptr<ext::http::client::HttpClientSync>{mock_http_client});
+    EXPECT_EQ(transport.EmitBatch(MakeBatch(2)), 2);
+    transport.Flush();
+    EXPECT_EQ(transport.EmitBatch(MakeBatch(3)), 3);
+    transport.Flush();
+  }
+
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>(
+      body.data(), static_cast<uint32_t>(body.size()));
+  apache::thrift::protocol::TBinaryProtocol protocol(buffer);
+  thrift::Batch batch;
+  batch.read(&protocol);
+  EXPECT_EQ(batch.process.serviceName, "unit_test_service");
+  ASSERT_EQ(batch.spans.size(), 5u);
+  EXPECT_EQ(batch.spans[4].operationName, "Test span 2");
+}
+
+TEST_F(JaegerExporterTestPeer, HttpTransportCompressesRequests)
+{
+  auto mock_http_client = new MockHttpClient;
+  EXPECT_CALL(*mock_http_client, Post(_, _, _))
+      .Times(Exactly(1))
+      .WillOnce(Invoke([](const nostd::string_view &, const ext::http::client::Body &sent,
+                          const ext::http::client::Headers &headers) {
+        EXPECT_EQ(headers.count("Content-Encoding"), 1u);
+        // The gzip magic bytes
+        EXPECT_EQ(sent.at(0), 0x1f);
+        EXPECT_EQ(sent.at(1), 0x8b);
+        return ext::http::client::Result(nullptr, ext::http::client::SessionState::Response);
+      }));
+
+  JaegerExporterOptions options;
+  options.compression = "gzip";
+  HttpTransport transport(options,
+                          std::shared_ptr<ext::http::client::HttpClientSync>{mock_http_client});
+  EXPECT_EQ(transport.EmitBatch(MakeBatch(100)), 100);
+}
+
 TEST_F(JaegerExporterTestPeer, ShutdownTest)
 {
   auto mock_thrift_sender = new MockThriftSender;
@@ -7,6 +7,10 @@
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -16,20 +20,45 @@ namespace memory
 {
 /**
  * A wrapper class holding in memory exporter data
+ *
+ * By default, spans are kept until GetSpans() consumes them, and spans added to a full buffer are
+ * dropped. In ring mode, the buffer keeps the last `buffer_size` spans: an added span replaces the
+ * oldest one, so that the memory used stays bounded without the spans having to be consumed, and
+ * GetSnapshot() reads the spans without removing or copying them.
  */
 class InMemorySpanData final
 {
 public:
   /**
    * @param buffer_size a required value that sets the size of the CircularBuffer
+   * @param ring true to overwrite the oldest spans once the buffer is full
    */
-  InMemorySpanData(size_t buffer_size) : spans_received_(buffer_size) {}
+  InMemorySpanData(size_t buffer_size, bool ring = false)
+      : spans_received_(ring ? 0 : buffer_size),
+        ring_(ring ? std::max<size_t>(buffer_size, 1) : 0)
+  {}
+
+  /**
+   * @return true if the oldest spans are overwritten once the buffer is full
+   */
+  bool IsRing() const noexcept { return !ring_.empty(); }
 
   /**
    * @param data a required unique pointer to the data to add to the CircularBuffer
    */
   void Add(std::unique_ptr<opentelemetry::sdk::trace::SpanData> data) noexcept
   {
+    if (IsRing())
+    {
+      // Appending takes a slot without locking: concurrent appends overwrite different slots
+      // until the ring wraps around.
+      std::shared_ptr<RingEntry> entry(new RingEntry);
+      entry->sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+      entry->span     = std::move(data);
+      auto &slot      = ring_[entry->sequence % ring_.size()];
+      std::atomic_store(&slot, std::shared_ptr<const RingEntry>(std::move(entry)));
+      return;
+    }
     std::unique_ptr<opentelemetry::sdk::trace::SpanData> span_data(
         static_cast<opentelemetry::sdk::trace::SpanData *>(data.release()));
     spans_received_.Add(span_data);
@@ -38,12 +67,34 @@ class InMemorySpanData final
   /**
    * @return Returns a vector of unique pointers containing all the span data in the
    * CircularBuffer. This operation will empty the Buffer, which is why the data
-   * is returned as unique pointers
+   * is returned as unique pointers. In ring mode, spans still referenced by a snapshot are
+   * removed from the ring but not returned.
    */
   std::vector<std::unique_ptr<opentelemetry::sdk::trace::SpanData>> GetSpans() noexcept
   {
     std::vector<std::unique_ptr<opentelemetry::sdk::trace::SpanData>> res;
 
+    if (IsRing())
+    {
+      std::vector<std::shared_ptr<const RingEntry>> entries;
+      for (auto &slot : ring_)
+      {
+        auto entry = std::atomic_exchange(&slot, std::shared_ptr<const RingEntry>());
+        // Once out of the ring, an entry no snapshot refers to cannot be shared anymore.
+        if (entry != nullptr && entry.use_count() == 1)
+        {
+          entries.push_back(std::move(entry));
+        }
+      }
+      SortBySequence(entries);
+      res.reserve(entries.size());
+      for (auto &entry : entries)
+      {
+        res.push_back(std::move(const_cast<RingEntry &>(*entry).span));
+      }
+      return res;
+    }
+
     // Pointer swap is required because the Consume function requires that the
     // AtomicUniquePointer be set to null
     spans_received_.Consume(
@@ -66,8 +117,60 @@ class InMemorySpanData final
     return res;
   }
 
+  /**
+   * @return Returns the spans of the ring, from the oldest to the most recent one, without
+   * removing them. The spans are shared rather than copied, and stay valid after being
+   * overwritten in the ring. Returns no spans when not in ring mode.
+   */
+  std::vector<std::shared_ptr<const opentelemetry::sdk::trace::SpanData>> GetSnapshot() const
+  {
+    std::vector<std::shared_ptr<const RingEntry>> entries;
+    entries.reserve(ring_.size());
+    for (const auto &slot : ring_)
+    {
+      auto entry = std::atomic_load(&slot);
+      if (entry != nullptr)
+      {
+        entries.push_back(std::move(entry));
+      }
+    }
+    SortBySequence(entries);
+
+    std::vector<std::shared_ptr<const opentelemetry::sdk::trace::SpanData>> res;
+    res.reserve(entries.size());
+    for (const auto &entry : entries)
+    {
+      // Aliases the entry, which owns the span.
+      res.emplace_back(entry, entry->span.get());
+    }
+    return res;
+  }
+
+  /**
+   * @return Returns the number of spans added since the data was created, including those
+   * overwritten in ring mode. Only counted in ring mode.
+   */
+  uint64_t GetAddedCount() const noexcept { return next_sequence_.load(std::memory_order_relaxed); }
+
 private:
+  struct RingEntry
+  {
+    uint64_t sequence;
+    std::unique_ptr<opentelemetry::sdk::trace::SpanData> span;
+  };
+
+  static void SortBySequence(std::vector<std::shared_ptr<const RingEntry>> &entries)
+  {
+    std::sort(entries.begin(), entries.end(),
+              [](const std::shared_ptr<const RingEntry> &lhs,
+                 const std::shared_ptr<const RingEntry> &rhs) {
+                return lhs->sequence < rhs->sequence;
+              });
+  }
+
   opentelemetry::sdk::common::CircularBuffer<opentelemetry::sdk::trace::SpanData> spans_received_;
+  std::vector<std::shared_ptr<const RingEntry>> ring_;
+  std::atomic<uint64_t> next_sequence_{0};
 };
 }  // namespace memory
 }  // namespace exporter
@@ -24,9 +24,11 @@ class InMemorySpanExporter final : public opentelemetry::sdk::trace::SpanExporte
 public:
   /**
    * @param buffer_size an optional value that sets the size of the InMemorySpanData
+   * @param ring true to keep the last buffer_size spans rather than drop the spans exported to a
+   * full InMemorySpanData, see InMemorySpanData
    */
-  InMemorySpanExporter(size_t buffer_size = MAX_BUFFER_SIZE)
-      : data_(new opentelemetry::exporter::memory::InMemorySpanData(buffer_size))
+  InMemorySpanExporter(size_t buffer_size = MAX_BUFFER_SIZE, bool ring = false)
+      : data_(new opentelemetry::exporter::memory::InMemorySpanData(buffer_size, ring))
   {}
 
   /**
@@ -0,0 +1,369 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/common/binary_encoding.h"
+#include "opentelemetry/sdk/common/global_log_handler.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
+#include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace memory
+{
+/**
+ * The capture file of SpanCaptureExporter: the spans a processor exported, to be replayed by
+ * SpanCapture, e.g. by the replay benchmarks, with the shapes, attributes and timing of a real
+ * application rather than synthetic ones.
+ *
+ * The file is the 8 bytes magic `OTSPCAP1` followed by records, all integers in the byte order of
+ * the host. A record is a uint8_t type, a uint32_t payload size and the payload:
+ * - type 1, a resource: a uint32_t id, its schema URL and its attributes,
+ * - type 2, an instrumentation library: a uint32_t id, its name, version and schema URL,
+ * - type 3, a span: the ids of its resource and instrumentation library, written before it, then
+ *   the span as SpanData::AppendBinary encodes it.
+ * Strings are a uint32_t size and their bytes, see common/binary_encoding.h.
+ */
+constexpr char kSpanCaptureMagic[] = "OTSPCAP1";
+
+namespace detail
+{
+enum class SpanCaptureRecord : uint8_t
+{
+  kResource               = 1,
+  kInstrumentationLibrary = 2,
+  kSpan                   = 3
+};
+
+/* A resource made from the attributes of a capture file, without the default SDK attributes. */
+class CapturedResource : public sdk::resource::Resource
+{
+public:
+  CapturedResource(const sdk::resource::ResourceAttributes &attributes,
+                   const std::string &schema_url)
+      : Resource(attributes, schema_url)
+  {}
+};
+}  // namespace detail
+
+/**
+ * An exporter writing the spans it receives into a capture file, see kSpanCaptureMagic. Put it
+ * behind a processor of the application, e.g. next to its usual exporter with a
+ * MultiSpanProcessor, to capture its span stream for the replay benchmarks.
+ */
+class SpanCaptureExporter final : public opentelemetry::sdk::trace::SpanExporter
+{
+public:
+  /**
+   * @param path the capture file, created or truncated
+   */
+  explicit SpanCaptureExporter(const std::string &path)
+      : file_(path, std::ios::binary | std::ios::trunc)
+  {
+    file_.write(kSpanCaptureMagic, sizeof(kSpanCaptureMagic) - 1);
+    if (!file_)
+    {
+      OTEL_INTERNAL_LOG_ERROR("[Span Capture Exporter] Cannot create the capture file " << path);
+    }
+  }
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData());
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (is_shutdown_ || !file_)
+    {
+      return sdk::common::ExportResult::kFailure;
+    }
+    buffer_.clear();
+    for (auto &recordable : recordables)
+    {
+      if (recordable != nullptr)
+      {
+        EncodeSpan(static_cast<const sdk::trace::SpanData &>(*recordable));
+      }
+    }
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    return file_ ? sdk::common::ExportResult::kSuccess : sdk::common::ExportResult::kFailure;
+  }
+
+  bool Shutdown(
+      std::chrono::microseconds /* timeout */ = std::chrono::microseconds::max()) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    is_shutdown_ = true;
+    file_.close();
+    return true;
+  }
+
+private:
+  /* Appends a record of `type` whose payload `encode` appends. */
+  template <class Encode>
+  void AppendRecord(detail::SpanCaptureRecord type, Encode encode)
+  {
+    sdk::common::AppendBinary(buffer_, static_cast<uint8_t>(type));
+    size_t size_offset = buffer_.size();
+    sdk::common::AppendBinary(buffer_, uint32_t{0});
+    encode();
+    uint32_t size = static_cast<uint32_t>(buffer_.size() - size_offset - sizeof(uint32_t));
+    std::memcpy(&buffer_[size_offset], &size, sizeof(size));
+  }
+
+  uint32_t GetResourceId(const sdk::resource::Resource &resource)
+  {
+    auto it = resource_ids_.find(&resource);
+    if (it != resource_ids_.end())
+    {
+      return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(resource_ids_.size());
+    resource_ids_.emplace(&resource, id);
+    AppendRecord(detail::SpanCaptureRecord::kResource, [&] {
+      sdk::common::AppendBinary(buffer_, id);
+      sdk::common::AppendBinaryString(buffer_, resource.GetSchemaURL());
+      sdk::common::AppendBinaryAttributes(buffer_, resource.GetAttributes());
+    });
+    return id;
+  }
+
+  uint32_t GetLibraryId(const sdk::instrumentationlibrary::InstrumentationLibrary &library)
+  {
+    auto it = library_ids_.find(&library);
+    if (it != library_ids_.end())
+    {
+      return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(library_ids_.size());
+    library_ids_.emplace(&library, id);
+    AppendRecord(detail::SpanCaptureRecord::kInstrumentationLibrary, [&] {
+      sdk::common::AppendBinary(buffer_, id);
+      sdk::common::AppendBinaryString(buffer_, library.GetName());
+      sdk::common::AppendBinaryString(buffer_, library.GetVersion());
+      sdk::common::AppendBinaryString(buffer_, library.GetSchemaURL());
+    });
+    return id;
+  }
+
+  void EncodeSpan(const sdk::trace::SpanData &span)
+  {
+    uint32_t resource_id = GetResourceId(span.GetResource());
+    uint32_t library_id  = GetLibraryId(span.GetInstrumentationLibrary());
+    AppendRecord(detail::SpanCaptureRecord::kSpan, [&] {
+      sdk::common::AppendBinary(buffer_, resource_id);
+      sdk::common::AppendBinary(buffer_, library_id);
+      span.AppendBinary(buffer_);
+    });
+  }
+
+  std::mutex lock_;
+  std::ofstream file_;
+  bool is_shutdown_ = false;
+  /* The records of an export, written at once */
+  std::string buffer_;
+  /* The ids of the resources and instrumentation libraries already written, by address */
+  std::map<const sdk::resource::Resource *, uint32_t> resource_ids_;
+  std::map<const sdk::instrumentationlibrary::InstrumentationLibrary *, uint32_t> library_ids_;
+};
+
+/**
+ * The spans of a capture file, loaded in memory to be replayed into the recordables of any
+ * processor or exporter. The capture must outlive the recordables it replays spans into, which
+ * refer to its resources and instrumentation libraries.
+ */
+class SpanCapture
+{
+public:
+  /**
+   * Loads a capture file written by SpanCaptureExporter. A record torn at the end of the file, by
+   * an application which did not shut its exporter down, is ignored.
+   * @return nullptr if the file cannot be read or is not a capture file
+   */
+  static std::unique_ptr<SpanCapture> Load(const std::string &path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const size_t magic_size = sizeof(kSpanCaptureMagic) - 1;
+    if (!file.good() && !file.eof())
+    {
+      OTEL_INTERNAL_LOG_ERROR("[Span Capture] Cannot read the capture file " << path);
+      return nullptr;
+    }
+    if (content.size() < magic_size || content.compare(0, magic_size, kSpanCaptureMagic) != 0)
+    {
+      OTEL_INTERNAL_LOG_ERROR("[Span Capture] " << path << " is not a capture file");
+      return nullptr;
+    }
+
+    std::unique_ptr<SpanCapture> capture(new SpanCapture);
+    sdk::common::BinaryDecoder records(content.data() + magic_size, content.size() - magic_size);
+    while (records.remaining() > 0)
+    {
+      uint8_t type  = 0;
+      uint32_t size = 0;
+      if (!records.GetValue(type) || !records.GetValue(size) || records.remaining() < size)
+      {
+        OTEL_INTERNAL_LOG_WARN("[Span Capture] Ignoring the torn record at the end of " << path);
+        break;
+      }
+      std::vector<char> bytes(size);
+      records.GetBytes(reinterpret_cast<uint8_t *>(bytes.data()), size);
+      sdk::common::BinaryDecoder record(bytes.data(), bytes.size());
+      if (!capture->DecodeRecord(static_cast<detail::SpanCaptureRecord>(type), record))
+      {
+        OTEL_INTERNAL_LOG_ERROR("[Span Capture] Invalid record in " << path);
+        return nullptr;
+      }
+    }
+    return capture;
+  }
+
+  size_t size() const noexcept { return spans_.size(); }
+
+  const sdk::trace::SpanData &GetSpan(size_t index) const noexcept { return *spans_[index]; }
+
+  /**
+   * Returns the time between the end of the first span of the capture and the end of the span at
+   * `index`, which paces a replay at the rate of the application.
+   */
+  std::chrono::nanoseconds GetEndOffset(size_t index) const noexcept
+  {
+    return SpanEnd(*spans_[index]) - first_end_;
+  }
+
+  /**
+   * Records the span at `index` into `target`, as the application recorded it.
+   */
+  void Replay(size_t index, sdk::trace::Recordable &target) const noexcept
+  {
+    const sdk::trace::SpanData &span = *spans_[index];
+    target.SetIdentity(span.GetSpanContext(), span.GetParentSpanId());
+    target.SetName(span.GetName());
+    target.SetSpanKind(span.GetSpanKind());
+    target.SetStartTime(span.GetStartTime());
+    target.SetDuration(span.GetDuration());
+    target.SetStatus(span.GetStatus(), span.GetDescription());
+    target.SetResource(span.GetResource());
+    target.SetInstrumentationLibrary(span.GetInstrumentationLibrary());
+    for (const auto &attribute : span.GetAttributes())
+    {
+      sdk::common::ViewAttributeValue(attribute.second, [&](const common::AttributeValue &value) {
+        target.SetAttribute(attribute.first, value);
+      });
+    }
+    for (const auto &event : span.GetEvents())
+    {
+      target.AddEvent(event.GetName(), event.GetTimestamp(),
+                      sdk::common::OwnedAttributesIterable<sdk::common::FlatAttributeMap>(
+                          event.GetAttributes()));
+    }
+    for (const auto &link : span.GetLinks())
+    {
+      target.AddLink(link.GetSpanContext(),
+                     sdk::common::OwnedAttributesIterable<sdk::common::FlatAttributeMap>(
+                         link.GetAttributes()));
+    }
+    target.SetDroppedCounts(span.GetDroppedAttributesCount(), span.GetDroppedEventsCount(),
+                            span.GetDroppedLinksCount());
+  }
+
+private:
+  SpanCapture() = default;
+
+  static std::chrono::nanoseconds SpanEnd(const sdk::trace::SpanData &span) noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               span.GetStartTime().time_since_epoch()) +
+           span.GetDuration();
+  }
+
+  bool DecodeRecord(detail::SpanCaptureRecord type, sdk::common::BinaryDecoder &record)
+  {
+    switch (type)
+    {
+      case detail::SpanCaptureRecord::kResource: {
+        uint32_t id = 0;
+        std::string schema_url;
+        sdk::resource::ResourceAttributes attributes;
+        if (!record.GetValue(id) || id != resources_.size() || !record.GetString(schema_url) ||
+            !record.GetAttributes(
+                [&](std::string &&key, sdk::common::OwnedAttributeValue &&value) {
+                  attributes[std::move(key)] = std::move(value);
+                }))
+        {
+          return false;
+        }
+        resources_.emplace_back(new detail::CapturedResource(attributes, schema_url));
+        return true;
+      }
+      case detail::SpanCaptureRecord::kInstrumentationLibrary: {
+        uint32_t id = 0;
+        std::string name, version, schema_url;
+        if (!record.GetValue(id) || id != libraries_.size() || !record.GetString(name) ||
+            !record.GetString(version) || !record.GetString(schema_url))
+        {
+          return false;
+        }
+        libraries_.emplace_back(
+            sdk::instrumentationlibrary::InstrumentationLibrary::Create(name, version, schema_url)
+                .release());
+        return true;
+      }
+      case detail::SpanCaptureRecord::kSpan:
+        return DecodeSpan(record);
+      default:
+        // Unknown records, of a later version of the format, are skipped.
+        return true;
+    }
+  }
+
+  bool DecodeSpan(sdk::common::BinaryDecoder &record)
+  {
+    std::unique_ptr<sdk::trace::SpanData> span(new sdk::trace::SpanData);
+    uint32_t resource_id = 0;
+    uint32_t library_id  = 0;
+    if (!record.GetValue(resource_id) || resource_id >= resources_.size() ||
+        !record.GetValue(library_id) || library_id >= libraries_.size() ||
+        !span->ReadBinary(record))
+    {
+      return false;
+    }
+    span->SetResource(*resources_[resource_id]);
+    span->SetInstrumentationLibrary(*libraries_[library_id]);
+    if (spans_.empty())
+    {
+      first_end_ = SpanEnd(*span);
+    }
+    spans_.push_back(std::move(span));
+    return true;
+  }
+
+  std::vector<std::unique_ptr<detail::CapturedResource>> resources_;
+  std::vector<std::unique_ptr<sdk::instrumentationlibrary::InstrumentationLibrary>> libraries_;
+  std::vector<std::unique_ptr<sdk::trace::SpanData>> spans_;
+  std::chrono::nanoseconds first_end_{0};
+};
+}  // namespace memory
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -6,6 +6,8 @@
 #include "opentelemetry/sdk/trace/span_data.h"
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using opentelemetry::exporter::memory::InMemorySpanData;
 using opentelemetry::sdk::trace::Recordable;
@@ -26,3 +28,76 @@ TEST(InMemorySpanData, AddRecordable)
 
   ASSERT_EQ(0, data.GetSpans().size());
 }
+
+TEST(InMemorySpanData, RingKeepsLastSpans)
+{
+  InMemorySpanData data(3, true);
+  ASSERT_TRUE(data.IsRing());
+
+  for (int i = 0; i < 5; ++i)
+  {
+    std::unique_ptr<SpanData> spandata(new SpanData());
+    spandata->SetName("span" + std::to_string(i));
+    data.Add(std::move(spandata));
+  }
+  EXPECT_EQ(5, data.GetAddedCount());
+
+  // Snapshots do not consume the spans.
+  for (int round = 0; round < 2; ++round)
+  {
+    auto snapshot = data.GetSnapshot();
+    ASSERT_EQ(3, snapshot.size());
+    EXPECT_EQ("span2", snapshot[0]->GetName());
+    EXPECT_EQ("span3", snapshot[1]->GetName());
+    EXPECT_EQ("span4", snapshot[2]->GetName());
+  }
+
+  auto spans = data.GetSpans();
+  ASSERT_EQ(3, spans.size());
+  EXPECT_EQ("span2", spans[0]->GetName());
+  EXPECT_EQ("span4", spans[2]->GetName());
+  EXPECT_EQ(0, data.GetSnapshot().size());
+}
+
+TEST(InMemorySpanData, RingSnapshotOutlivesOverwrite)
+{
+  InMemorySpanData data(1, true);
+
+  std::unique_ptr<SpanData> first(new SpanData());
+  first->SetName("first");
+  data.Add(std::move(first));
+  auto snapshot = data.GetSnapshot();
+
+  std::unique_ptr<SpanData> second(new SpanData());
+  second->SetName("second");
+  data.Add(std::move(second));
+
+  ASSERT_EQ(1, snapshot.size());
+  EXPECT_EQ("first", snapshot[0]->GetName());
+  EXPECT_EQ("second", data.GetSnapshot()[0]->GetName());
+}
+
+TEST(InMemorySpanData, RingConcurrentAdd)
+{
+  InMemorySpanData data(64, true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&data] {
+      for (int i = 0; i < 1000; ++i)
+      {
+        data.Add(std::unique_ptr<SpanData>(new SpanData()));
+        if (i % 100 == 0)
+        {
+          EXPECT_LE(data.GetSnapshot().size(), 64);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(4000, data.GetAddedCount());
+  EXPECT_EQ(64, data.GetSnapshot().size());
+}
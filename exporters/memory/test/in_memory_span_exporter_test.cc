@@ -27,3 +27,20 @@ TEST(InMemorySpanExporter, ExportBatch)
   // Consumes all spans in exporter
   ASSERT_EQ(0, exporter.GetData().get()->GetSpans().size());
 }
+
+TEST(InMemorySpanExporter, ExportToRing)
+{
+  InMemorySpanExporter exporter(2, true);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    std::unique_ptr<Recordable> spandata(new SpanData());
+    opentelemetry::nostd::span<std::unique_ptr<Recordable>> batch(&spandata, 1);
+    exporter.Export(batch);
+  }
+
+  // The ring keeps the last spans, which are read without being consumed.
+  ASSERT_EQ(2, exporter.GetData()->GetSnapshot().size());
+  ASSERT_EQ(2, exporter.GetData()->GetSnapshot().size());
+  ASSERT_EQ(3, exporter.GetData()->GetAddedCount());
+}
@@ -0,0 +1,178 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/memory/span_capture.h"
+#include "opentelemetry/common/key_value_iterable_view.h"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using opentelemetry::exporter::memory::SpanCapture;
+using opentelemetry::exporter::memory::SpanCaptureExporter;
+using opentelemetry::sdk::trace::Recordable;
+using opentelemetry::sdk::trace::SpanData;
+namespace common   = opentelemetry::common;
+namespace nostd    = opentelemetry::nostd;
+namespace resource = opentelemetry::sdk::resource;
+namespace trace    = opentelemetry::trace;
+
+namespace
+{
+class SpanCaptureTest : public ::testing::Test
+{
+protected:
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  trace::SpanContext MakeSpanContext(uint8_t trace, uint8_t span)
+  {
+    uint8_t trace_id[trace::TraceId::kSize] = {trace};
+    uint8_t span_id[trace::SpanId::kSize]   = {span};
+    return trace::SpanContext(trace::TraceId(trace_id), trace::SpanId(span_id),
+                              trace::TraceFlags(trace::TraceFlags::kIsSampled), false);
+  }
+
+  // Records a span with attributes of all types, an event and a link.
+  void FillSpan(Recordable &span, uint8_t index)
+  {
+    span.SetIdentity(MakeSpanContext(1, index), trace::SpanId());
+    span.SetResource(resource_);
+    span.SetInstrumentationLibrary(*library_);
+    span.SetName("span " + std::to_string(index));
+    span.SetSpanKind(trace::SpanKind::kServer);
+    span.SetStatus(trace::StatusCode::kError, "failed");
+    span.SetStartTime(common::SystemTimestamp(std::chrono::seconds(1000 + index)));
+    span.SetDuration(std::chrono::milliseconds(5));
+
+    const bool bools[]                 = {true, false};
+    const int64_t ints[]               = {1, -2, 3};
+    const nostd::string_view strings[] = {"a", "bc"};
+    span.SetAttribute("bool", true);
+    span.SetAttribute("int", 42);
+    span.SetAttribute("uint64", uint64_t{7});
+    span.SetAttribute("double", 0.5);
+    span.SetAttribute("string", "value");
+    span.SetAttribute("bools", nostd::span<const bool>(bools));
+    span.SetAttribute("ints", nostd::span<const int64_t>(ints));
+    span.SetAttribute("strings", nostd::span<const nostd::string_view>(strings));
+
+    std::map<std::string, common::AttributeValue> attributes = {{"retry", 2}};
+    span.AddEvent("event", common::SystemTimestamp(std::chrono::seconds(1001)),
+                  common::KeyValueIterableView<decltype(attributes)>(attributes));
+    span.AddLink(MakeSpanContext(2, 3),
+                 common::KeyValueIterableView<decltype(attributes)>(attributes));
+    span.SetDroppedCounts(1, 2, 3);
+  }
+
+  void ExpectSpan(const SpanData &span, uint8_t index)
+  {
+    EXPECT_EQ(MakeSpanContext(1, index), span.GetSpanContext());
+    EXPECT_EQ("span " + std::to_string(index), std::string(span.GetName()));
+    EXPECT_EQ(trace::SpanKind::kServer, span.GetSpanKind());
+    EXPECT_EQ(trace::StatusCode::kError, span.GetStatus());
+    EXPECT_EQ("failed", std::string(span.GetDescription()));
+    EXPECT_EQ(std::chrono::milliseconds(5), span.GetDuration());
+    EXPECT_EQ("value",
+              nostd::get<std::string>(span.GetResource().GetAttributes().at("service.name")));
+    EXPECT_EQ("library", span.GetInstrumentationLibrary().GetName());
+    EXPECT_EQ("1.0", span.GetInstrumentationLibrary().GetVersion());
+
+    auto &attributes = span.GetAttributes();
+    EXPECT_EQ(8, attributes.size());
+    EXPECT_TRUE(nostd::get<bool>(attributes.at("bool")));
+    EXPECT_EQ(42, nostd::get<int32_t>(attributes.at("int")));
+    EXPECT_EQ(7, nostd::get<uint64_t>(attributes.at("uint64")));
+    EXPECT_EQ(0.5, nostd::get<double>(attributes.at("double")));
+    EXPECT_EQ("value", nostd::get<std::string>(attributes.at("string")));
+    EXPECT_EQ(std::vector<bool>({true, false}),
+              nostd::get<std::vector<bool>>(attributes.at("bools")));
+    EXPECT_EQ(std::vector<int64_t>({1, -2, 3}),
+              nostd::get<std::vector<int64_t>>(attributes.at("ints")));
+    EXPECT_EQ(std::vector<std::string>({"a", "bc"}),
+              nostd::get<std::vector<std::string>>(attributes.at("strings")));
+
+    ASSERT_EQ(1, span.GetEvents().size());
+    EXPECT_EQ("event", span.GetEvents()[0].GetName());
+    EXPECT_EQ(2, nostd::get<int32_t>(span.GetEvents()[0].GetAttributes().at("retry")));
+    ASSERT_EQ(1, span.GetLinks().size());
+    EXPECT_EQ(MakeSpanContext(2, 3), span.GetLinks()[0].GetSpanContext());
+    EXPECT_EQ(1, span.GetDroppedAttributesCount());
+    EXPECT_EQ(2, span.GetDroppedEventsCount());
+    EXPECT_EQ(3, span.GetDroppedLinksCount());
+  }
+
+  void Capture(int num_spans)
+  {
+    SpanCaptureExporter exporter(path_);
+    std::vector<std::unique_ptr<Recordable>> batch;
+    for (int i = 0; i < num_spans; ++i)
+    {
+      batch.push_back(exporter.MakeRecordable());
+      FillSpan(*batch.back(), static_cast<uint8_t>(i + 1));
+    }
+    EXPECT_EQ(opentelemetry::sdk::common::ExportResult::kSuccess,
+              exporter.Export(nostd::span<std::unique_ptr<Recordable>>(batch.data(), 1)));
+    EXPECT_EQ(opentelemetry::sdk::common::ExportResult::kSuccess,
+              exporter.Export(nostd::span<std::unique_ptr<Recordable>>(batch.data() + 1,
+                                                                       batch.size() - 1)));
+    EXPECT_TRUE(exporter.Shutdown());
+  }
+
+  std::string path_             = "span_capture_test.bin";
+  resource::Resource resource_ = resource::Resource::Create({{"service.name", "value"}});
+  nostd::unique_ptr<opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary> library_ =
+      opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("library", "1.0");
+};
+}  // namespace
+
+TEST_F(SpanCaptureTest, RoundTrip)
+{
+  Capture(3);
+
+  auto capture = SpanCapture::Load(path_);
+  ASSERT_NE(nullptr, capture);
+  ASSERT_EQ(3, capture->size());
+  for (size_t i = 0; i < capture->size(); ++i)
+  {
+    ExpectSpan(capture->GetSpan(i), static_cast<uint8_t>(i + 1));
+  }
+  // The spans share the resource of the capture.
+  EXPECT_EQ(&capture->GetSpan(0).GetResource(), &capture->GetSpan(2).GetResource());
+  EXPECT_EQ(std::chrono::seconds(2), capture->GetEndOffset(2));
+
+  SpanData replayed;
+  capture->Replay(1, replayed);
+  ExpectSpan(replayed, 2);
+}
+
+TEST_F(SpanCaptureTest, IgnoresATornRecord)
+{
+  Capture(2);
+  std::string content;
+  {
+    std::ifstream file(path_, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size() - 10));
+  }
+
+  auto capture = SpanCapture::Load(path_);
+  ASSERT_NE(nullptr, capture);
+  ASSERT_EQ(1, capture->size());
+  ExpectSpan(capture->GetSpan(0), 1);
+}
+
+TEST_F(SpanCaptureTest, RejectsOtherFiles)
+{
+  {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    file << "not a capture";
+  }
+  EXPECT_EQ(nullptr, SpanCapture::Load(path_));
+  EXPECT_EQ(nullptr, SpanCapture::Load("no_such_span_capture.bin"));
+}
@@ -0,0 +1,105 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace ostream_common
+{
+
+/**
+ * The format of the records printed by the OStream exporters.
+ */
+enum class OStreamFormat
+{
+  // Multi-line, human readable text.
+  kText,
+  // One JSON object per line.
+  kCompactJson
+};
+
+/**
+ * Options of the OStream span and log exporters.
+ */
+struct OStreamExporterOptions
+{
+  OStreamFormat format = OStreamFormat::kText;
+
+  // When true, a batch is formatted into a buffer reused from batch to batch, which is then
+  // written to the ostream and flushed at once. Otherwise each field is written to the ostream.
+  bool buffered = false;
+};
+
+/**
+ * A stream formatting a batch of records into memory, which keeps its capacity from batch to
+ * batch. Not thread-safe: the exporters use it from Export(), which is not called concurrently.
+ */
+class BatchBuffer
+{
+public:
+  BatchBuffer() : stream_(&buffer_) {}
+
+  /**
+   * Clears the buffer.
+   * @return the stream to format the batch into
+   */
+  std::ostream &Begin()
+  {
+    buffer_.Clear();
+    stream_.clear();
+    return stream_;
+  }
+
+  /**
+   * Writes the formatted batch to `sout` with a single write, and flushes it.
+   */
+  void WriteTo(std::ostream &sout)
+  {
+    const std::string &data = buffer_.GetData();
+    sout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    sout.flush();
+  }
+
+private:
+  class StringBuffer : public std::streambuf
+  {
+  public:
+    void Clear() noexcept { data_.clear(); }
+
+    const std::string &GetData() const noexcept { return data_; }
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+      if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+        data_.push_back(traits_type::to_char_type(c));
+      }
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize count) override
+    {
+      data_.append(s, static_cast<size_t>(count));
+      return count;
+    }
+
+  private:
+    std::string data_;
+  };
+
+  StringBuffer buffer_;
+  std::ostream stream_;
+};
+
+}  // namespace ostream_common
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
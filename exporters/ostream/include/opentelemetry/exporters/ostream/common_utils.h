@@ -1,9 +1,11 @@
 // Copyright The OpenTelemetry Authors
 // SPDX-License-Identifier: Apache-2.0
 
+#include <cmath>
 #include <sstream>
 #include <string>
 #include <vector>
+#include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/nostd/variant.h"
 #include "opentelemetry/sdk/common/attribute_utils.h"
 
@@ -61,7 +63,8 @@ class OwnedAttributeValueVisitor
 
 #endif
 
-void print_value(const opentelemetry::sdk::common::OwnedAttributeValue &value, std::ostream &sout)
+inline void print_value(const opentelemetry::sdk::common::OwnedAttributeValue &value,
+                        std::ostream &sout)
 {
 #if __cplusplus < 201402L
   opentelemetry::nostd::visit(OwnedAttributeValueVisitor(sout), value);
@@ -75,6 +78,142 @@ void print_value(const opentelemetry::sdk::common::OwnedAttributeValue &value, s
 #endif
 }
 
+/*
+  print_json_value prints the value of an attribute as JSON, for the compact JSON format of the
+  exporters.
+*/
+
+inline void print_json_string(opentelemetry::nostd::string_view value, std::ostream &sout)
+{
+  static const char kHexDigits[] = "0123456789abcdef";
+  sout << '"';
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        sout << "\\\"";
+        break;
+      case '\\':
+        sout << "\\\\";
+        break;
+      case '\n':
+        sout << "\\n";
+        break;
+      case '\r':
+        sout << "\\r";
+        break;
+      case '\t':
+        sout << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          sout << "\\u00" << kHexDigits[(c >> 4) & 0xf] << kHexDigits[c & 0xf];
+        }
+        else
+        {
+          sout << c;
+        }
+    }
+  }
+  sout << '"';
+}
+
+template <typename T>
+void print_json_value(const T &item, std::ostream &sout)
+{
+  sout << item;
+}
+
+inline void print_json_value(bool item, std::ostream &sout)
+{
+  sout << (item ? "true" : "false");
+}
+
+inline void print_json_value(uint8_t item, std::ostream &sout)
+{
+  sout << static_cast<unsigned>(item);
+}
+
+inline void print_json_value(double item, std::ostream &sout)
+{
+  // JSON has no representation of NaN and infinities.
+  if (std::isfinite(item))
+  {
+    sout << item;
+  }
+  else
+  {
+    sout << "null";
+  }
+}
+
+inline void print_json_value(const std::string &item, std::ostream &sout)
+{
+  print_json_string(item, sout);
+}
+
+template <typename T>
+void print_json_value(const std::vector<T> &vec, std::ostream &sout)
+{
+  sout << '[';
+  bool first = true;
+  for (const auto &v : vec)
+  {
+    if (!first)
+    {
+      sout << ',';
+    }
+    first = false;
+    print_json_value(static_cast<const T &>(v), sout);
+  }
+  sout << ']';
+}
+
+class OwnedAttributeValueJsonVisitor
+{
+public:
+  OwnedAttributeValueJsonVisitor(std::ostream &sout) : sout_(sout) {}
+
+  template <typename T>
+  void operator()(const T &arg)
+  {
+    print_json_value(arg, sout_);
+  }
+
+private:
+  std::ostream &sout_;
+};
+
+inline void print_json_value(const opentelemetry::sdk::common::OwnedAttributeValue &value,
+                             std::ostream &sout)
+{
+  opentelemetry::nostd::visit(OwnedAttributeValueJsonVisitor(sout), value);
+}
+
+/*
+  print_json_attributes prints a map of attributes as a JSON object.
+*/
+template <typename Map>
+void print_json_attributes(const Map &map, std::ostream &sout)
+{
+  sout << '{';
+  bool first = true;
+  for (const auto &kv : map)
+  {
+    if (!first)
+    {
+      sout << ',';
+    }
+    first = false;
+    print_json_string(kv.first, sout);
+    sout << ':';
+    print_json_value(kv.second, sout);
+  }
+  sout << '}';
+}
+
 }  // namespace ostream_common
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
\ No newline at end of file
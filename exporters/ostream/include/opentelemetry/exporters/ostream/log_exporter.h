@@ -5,6 +5,7 @@
 #ifdef ENABLE_LOGS_PREVIEW
 
 #  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/exporters/ostream/buffered_output.h"
 #  include "opentelemetry/nostd/type_traits.h"
 #  include "opentelemetry/sdk/logs/exporter.h"
 #  include "opentelemetry/sdk/logs/log_record.h"
@@ -30,6 +31,13 @@ class OStreamLogExporter final : public opentelemetry::sdk::logs::LogExporter
    */
   explicit OStreamLogExporter(std::ostream &sout = std::cout) noexcept;
 
+  /**
+   * Create an OStreamLogExporter printing the logs in the format, and with the buffering, of
+   * `options`.
+   */
+  OStreamLogExporter(std::ostream &sout,
+                     const ostream_common::OStreamExporterOptions &options) noexcept;
+
   std::unique_ptr<sdk::logs::Recordable> MakeRecordable() noexcept override;
 
   /**
@@ -48,13 +56,25 @@ class OStreamLogExporter final : public opentelemetry::sdk::logs::LogExporter
 private:
   // The OStream to send the logs to
   std::ostream &sout_;
+  // The format of the logs, and whether a batch is buffered before being written
+  const ostream_common::OStreamExporterOptions options_;
+  ostream_common::BatchBuffer buffer_;
   // Whether this exporter has been shut down
   bool is_shutdown_ = false;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool isShutdown() const noexcept;
+  void printLog(const opentelemetry::sdk::logs::LogRecord &log_record, std::ostream &sout);
+
+  void printJsonLog(const opentelemetry::sdk::logs::LogRecord &log_record, std::ostream &sout);
+
   void printAttributes(
       const std::unordered_map<std::string, opentelemetry::sdk::common::OwnedAttributeValue> &map,
-      const std::string prefix = "\n\t");
+      std::ostream &sout,
+      const std::string &prefix = "\n\t");
+
+  void printAttributes(const opentelemetry::sdk::common::FlatOrderedAttributeMap &map,
+                       std::ostream &sout,
+                       const std::string &prefix = "\n\t");
 };
 }  // namespace logs
 }  // namespace exporter
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/exporters/ostream/buffered_output.h"
 #include "opentelemetry/nostd/type_traits.h"
 #include "opentelemetry/sdk/trace/exporter.h"
 #include "opentelemetry/sdk/trace/span_data.h"
@@ -32,6 +33,13 @@ class OStreamSpanExporter final : public opentelemetry::sdk::trace::SpanExporter
    */
   explicit OStreamSpanExporter(std::ostream &sout = std::cout) noexcept;
 
+  /**
+   * Create an OStreamSpanExporter printing the spans in the format, and with the buffering, of
+   * `options`.
+   */
+  OStreamSpanExporter(std::ostream &sout,
+                      const ostream_common::OStreamExporterOptions &options) noexcept;
+
   std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
 
   sdk::common::ExportResult Export(
@@ -43,6 +51,8 @@ class OStreamSpanExporter final : public opentelemetry::sdk::trace::SpanExporter
 
 private:
   std::ostream &sout_;
+  const ostream_common::OStreamExporterOptions options_;
+  ostream_common::BatchBuffer buffer_;
   bool is_shutdown_ = false;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool isShutdown() const noexcept;
@@ -50,20 +60,35 @@ class OStreamSpanExporter final : public opentelemetry::sdk::trace::SpanExporter
   // Mapping status number to the string from api/include/opentelemetry/trace/canonical_code.h
   std::map<int, std::string> statusMap{{0, "Unset"}, {1, "Ok"}, {2, "Error"}};
 
-  // various print helpers
+  // various print helpers, printing to `sout`
+  void printSpan(const opentelemetry::sdk::trace::SpanData &span, std::ostream &sout);
+
+  void printJsonSpan(const opentelemetry::sdk::trace::SpanData &span, std::ostream &sout);
+
   void printAttributes(
       const std::unordered_map<std::string, opentelemetry::sdk::common::OwnedAttributeValue> &map,
-      const std::string prefix = "\n\t");
+      std::ostream &sout,
+      const std::string &prefix = "\n\t");
+
+  void printAttributes(const opentelemetry::sdk::common::FlatOrderedAttributeMap &map,
+                       std::ostream &sout,
+                       const std::string &prefix = "\n\t");
+
+  void printAttributes(const opentelemetry::sdk::common::FlatAttributeMap &map,
+                       std::ostream &sout,
+                       const std::string &prefix);
 
-  void printEvents(const std::vector<opentelemetry::sdk::trace::SpanDataEvent> &events);
+  void printEvents(const opentelemetry::sdk::trace::SpanDataEvents &events, std::ostream &sout);
 
-  void printLinks(const std::vector<opentelemetry::sdk::trace::SpanDataLink> &links);
+  void printLinks(const opentelemetry::sdk::trace::SpanDataLinks &links, std::ostream &sout);
 
-  void printResources(const opentelemetry::sdk::resource::Resource &resources);
+  void printResources(const opentelemetry::sdk::resource::Resource &resources,
+                      std::ostream &sout);
 
   void printInstrumentationLibrary(
       const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
-          &instrumentation_library);
+          &instrumentation_library,
+      std::ostream &sout);
 };
 }  // namespace trace
 }  // namespace exporter
@@ -5,6 +5,7 @@
 #  include "opentelemetry/exporters/ostream/log_exporter.h"
 #  include <mutex>
 #  include "opentelemetry/exporters/ostream/common_utils.h"
+#  include "opentelemetry/sdk/logs/message_template.h"
 #  include "opentelemetry/sdk_config.h"
 
 #  include <iostream>
@@ -21,7 +22,13 @@ namespace logs
 
 /*********************** Constructor ***********************/
 
-OStreamLogExporter::OStreamLogExporter(std::ostream &sout) noexcept : sout_(sout) {}
+OStreamLogExporter::OStreamLogExporter(std::ostream &sout) noexcept : sout_(sout), options_() {}
+
+OStreamLogExporter::OStreamLogExporter(
+    std::ostream &sout,
+    const ostream_common::OStreamExporterOptions &options) noexcept
+    : sout_(sout), options_(options)
+{}
 
 /*********************** Exporter methods ***********************/
 
@@ -40,6 +47,8 @@ sdk::common::ExportResult OStreamLogExporter::Export(
     return sdk::common::ExportResult::kFailure;
   }
 
+  // A buffered batch is formatted in memory, then written at once.
+  std::ostream &sout = options_.buffered ? buffer_.Begin() : sout_;
   for (auto &record : records)
   {
     // Convert recordable to a LogRecord so that the getters of the LogRecord can be used
@@ -52,51 +61,18 @@ sdk::common::ExportResult OStreamLogExporter::Export(
       continue;
     }
 
-    // Convert trace, spanid, traceflags into exportable representation
-    constexpr int trace_id_len    = 32;
-    constexpr int span_id__len    = 16;
-    constexpr int trace_flags_len = 2;
-
-    char trace_id[trace_id_len]       = {0};
-    char span_id[span_id__len]        = {0};
-    char trace_flags[trace_flags_len] = {0};
-
-    log_record->GetTraceId().ToLowerBase16(trace_id);
-    log_record->GetSpanId().ToLowerBase16(span_id);
-    log_record->GetTraceFlags().ToLowerBase16(trace_flags);
-
-    // Print out each field of the log record, noting that severity is separated
-    // into severity_num and severity_text
-    sout_ << "{\n"
-          << "  timestamp     : " << log_record->GetTimestamp().time_since_epoch().count() << "\n"
-          << "  severity_num  : " << static_cast<std::uint32_t>(log_record->GetSeverity()) << "\n"
-          << "  severity_text : ";
-
-    std::uint32_t severity_index = static_cast<std::uint32_t>(log_record->GetSeverity());
-    if (severity_index >= std::extent<decltype(opentelemetry::logs::SeverityNumToText)>::value)
+    if (options_.format == ostream_common::OStreamFormat::kCompactJson)
     {
-      sout_ << "Invalid severity(" << severity_index << ")\n";
+      printJsonLog(*log_record, sout);
     }
     else
     {
-      sout_ << opentelemetry::logs::SeverityNumToText[severity_index] << "\n";
+      printLog(*log_record, sout);
     }
-
-    sout_ << "  body          : " << log_record->GetBody() << "\n"
-          << "  resource      : ";
-
-    printAttributes(log_record->GetResource().GetAttributes());
-
-    sout_ << "\n"
-          << "  attributes    : ";
-
-    printAttributes(log_record->GetAttributes());
-
-    sout_ << "\n"
-          << "  trace_id      : " << std::string(trace_id, trace_id_len) << "\n"
-          << "  span_id       : " << std::string(span_id, span_id__len) << "\n"
-          << "  trace_flags   : " << std::string(trace_flags, trace_flags_len) << "\n"
-          << "}\n";
+  }
+  if (options_.buffered)
+  {
+    buffer_.WriteTo(sout_);
   }
 
   return sdk::common::ExportResult::kSuccess;
@@ -115,14 +91,113 @@ bool OStreamLogExporter::isShutdown() const noexcept
   return is_shutdown_;
 }
 
+// Convert trace, spanid, traceflags into exportable representation
+constexpr int trace_id_len    = 32;
+constexpr int span_id__len    = 16;
+constexpr int trace_flags_len = 2;
+
+void OStreamLogExporter::printLog(const sdklogs::LogRecord &log_record, std::ostream &sout)
+{
+  char trace_id[trace_id_len]       = {0};
+  char span_id[span_id__len]        = {0};
+  char trace_flags[trace_flags_len] = {0};
+
+  log_record.GetTraceId().ToLowerBase16(trace_id);
+  log_record.GetSpanId().ToLowerBase16(span_id);
+  log_record.GetTraceFlags().ToLowerBase16(trace_flags);
+
+  // Print out each field of the log record, noting that severity is separated
+  // into severity_num and severity_text
+  sout << "{\n"
+       << "  timestamp     : " << log_record.GetTimestamp().time_since_epoch().count() << "\n"
+       << "  severity_num  : " << static_cast<std::uint32_t>(log_record.GetSeverity()) << "\n"
+       << "  severity_text : ";
+
+  std::uint32_t severity_index = static_cast<std::uint32_t>(log_record.GetSeverity());
+  if (severity_index >= std::extent<decltype(opentelemetry::logs::SeverityNumToText)>::value)
+  {
+    sout << "Invalid severity(" << severity_index << ")\n";
+  }
+  else
+  {
+    sout << opentelemetry::logs::SeverityNumToText[severity_index] << "\n";
+  }
+
+  // The message of a log written from a message template is formatted here, the JSON formats
+  // keep the template and its arguments.
+  sout << "  body          : "
+       << sdklogs::FormatMessageTemplate(log_record.GetBody(), log_record.GetAttributes()) << "\n"
+       << "  resource      : ";
+
+  printAttributes(log_record.GetResource().GetAttributes(), sout);
+
+  sout << "\n"
+       << "  attributes    : ";
+
+  printAttributes(log_record.GetAttributes(), sout);
+
+  sout << "\n"
+       << "  trace_id      : " << std::string(trace_id, trace_id_len) << "\n"
+       << "  span_id       : " << std::string(span_id, span_id__len) << "\n"
+       << "  trace_flags   : " << std::string(trace_flags, trace_flags_len) << "\n"
+       << "}\n";
+}
+
+void OStreamLogExporter::printJsonLog(const sdklogs::LogRecord &log_record, std::ostream &sout)
+{
+  using ostream_common::print_json_attributes;
+  using ostream_common::print_json_string;
+
+  char trace_id[trace_id_len]       = {0};
+  char span_id[span_id__len]        = {0};
+  char trace_flags[trace_flags_len] = {0};
+
+  log_record.GetTraceId().ToLowerBase16(trace_id);
+  log_record.GetSpanId().ToLowerBase16(span_id);
+  log_record.GetTraceFlags().ToLowerBase16(trace_flags);
+
+  std::uint32_t severity_index = static_cast<std::uint32_t>(log_record.GetSeverity());
+  sout << "{\"timestamp\":" << log_record.GetTimestamp().time_since_epoch().count()
+       << ",\"severity_num\":" << severity_index << ",\"severity_text\":";
+  if (severity_index >= std::extent<decltype(opentelemetry::logs::SeverityNumToText)>::value)
+  {
+    sout << "\"Invalid severity(" << severity_index << ")\"";
+  }
+  else
+  {
+    print_json_string(opentelemetry::logs::SeverityNumToText[severity_index], sout);
+  }
+  sout << ",\"body\":";
+  print_json_string(log_record.GetBody(), sout);
+  sout << ",\"resource\":";
+  print_json_attributes(log_record.GetResource().GetAttributes(), sout);
+  sout << ",\"attributes\":";
+  print_json_attributes(log_record.GetAttributes(), sout);
+  sout << ",\"trace_id\":\"" << nostd::string_view(trace_id, trace_id_len) << "\",\"span_id\":\""
+       << nostd::string_view(span_id, span_id__len) << "\",\"trace_flags\":\""
+       << nostd::string_view(trace_flags, trace_flags_len) << "\"}\n";
+}
+
 void OStreamLogExporter::printAttributes(
     const std::unordered_map<std::string, sdkcommon::OwnedAttributeValue> &map,
-    const std::string prefix)
+    std::ostream &sout,
+    const std::string &prefix)
+{
+  for (const auto &kv : map)
+  {
+    sout << prefix << kv.first << ": ";
+    opentelemetry::exporter::ostream_common::print_value(kv.second, sout);
+  }
+}
+
+void OStreamLogExporter::printAttributes(const sdkcommon::FlatOrderedAttributeMap &map,
+                                         std::ostream &sout,
+                                         const std::string &prefix)
 {
   for (const auto &kv : map)
   {
-    sout_ << prefix << kv.first << ": ";
-    opentelemetry::exporter::ostream_common::print_value(kv.second, sout_);
+    sout << prefix << kv.first << ": ";
+    opentelemetry::exporter::ostream_common::print_value(kv.second, sout);
   }
 }
 
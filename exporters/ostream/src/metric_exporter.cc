@@ -8,6 +8,7 @@
 #  include "opentelemetry/exporters/ostream/metric_exporter.h"
 #  include "opentelemetry/sdk/metrics/aggregation/default_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/histogram_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/sketch_aggregation.h"
 #  include "opentelemetry/sdk_config.h"
 
 namespace
@@ -143,22 +144,91 @@ void OStreamMetricExporter::printPointData(const opentelemetry::sdk::metrics::Po
     {
       sout_ << nostd::get<long>(histogram_point_data.sum_);
     }
+    if (histogram_point_data.record_min_max_ && histogram_point_data.count_ != 0)
+    {
+      if (nostd::holds_alternative<double>(histogram_point_data.min_))
+      {
+        sout_ << "\n  min     : " << nostd::get<double>(histogram_point_data.min_);
+        sout_ << "\n  max     : " << nostd::get<double>(histogram_point_data.max_);
+      }
+      else if (nostd::holds_alternative<long>(histogram_point_data.min_))
+      {
+        sout_ << "\n  min     : " << nostd::get<long>(histogram_point_data.min_);
+        sout_ << "\n  max     : " << nostd::get<long>(histogram_point_data.max_);
+      }
+    }
 
     sout_ << "\n  buckets     : ";
-    if (nostd::holds_alternative<std::list<double>>(histogram_point_data.boundaries_))
+    if (nostd::holds_alternative<sdk::metrics::HistogramBoundaries<double>>(
+            histogram_point_data.boundaries_))
     {
-      auto &double_boundaries = nostd::get<std::list<double>>(histogram_point_data.boundaries_);
+      auto &double_boundaries =
+          nostd::get<sdk::metrics::HistogramBoundaries<double>>(histogram_point_data.boundaries_);
       printVec(sout_, double_boundaries);
     }
-    else if (nostd::holds_alternative<std::list<long>>(histogram_point_data.boundaries_))
+    else if (nostd::holds_alternative<sdk::metrics::HistogramBoundaries<long>>(
+                 histogram_point_data.boundaries_))
     {
-      auto &long_boundaries = nostd::get<std::list<long>>(histogram_point_data.boundaries_);
+      auto &long_boundaries =
+          nostd::get<sdk::metrics::HistogramBoundaries<long>>(histogram_point_data.boundaries_);
       printVec(sout_, long_boundaries);
     }
 
     sout_ << "\n  counts     : ";
     printVec(sout_, histogram_point_data.counts_);
   }
+  else if (nostd::holds_alternative<sdk::metrics::ExponentialHistogramPointData>(point_data))
+  {
+    auto &histogram_point_data =
+        nostd::get<sdk::metrics::ExponentialHistogramPointData>(point_data);
+    sout_ << "\n  type     : ExponentialHistogramPointData";
+    sout_ << "\n  count     : " << histogram_point_data.count_;
+    sout_ << "\n  sum     : ";
+    if (nostd::holds_alternative<double>(histogram_point_data.sum_))
+    {
+      sout_ << nostd::get<double>(histogram_point_data.sum_);
+    }
+    else if (nostd::holds_alternative<long>(histogram_point_data.sum_))
+    {
+      sout_ << nostd::get<long>(histogram_point_data.sum_);
+    }
+    sout_ << "\n  scale     : " << histogram_point_data.scale_;
+    sout_ << "\n  zero count     : " << histogram_point_data.zero_count_;
+    sout_ << "\n  positive offset     : " << histogram_point_data.positive_buckets_.offset_;
+    sout_ << "\n  positive counts     : ";
+    printVec(sout_, histogram_point_data.positive_buckets_.counts_);
+    sout_ << "\n  negative offset     : " << histogram_point_data.negative_buckets_.offset_;
+    sout_ << "\n  negative counts     : ";
+    printVec(sout_, histogram_point_data.negative_buckets_.counts_);
+  }
+  else if (nostd::holds_alternative<sdk::metrics::SketchPointData>(point_data))
+  {
+    auto &sketch_point_data = nostd::get<sdk::metrics::SketchPointData>(point_data);
+    sout_ << "\n  type     : SketchPointData";
+    sout_ << "\n  count     : " << sketch_point_data.count_;
+    sout_ << "\n  sum     : ";
+    if (nostd::holds_alternative<double>(sketch_point_data.sum_))
+    {
+      sout_ << nostd::get<double>(sketch_point_data.sum_);
+    }
+    else if (nostd::holds_alternative<long>(sketch_point_data.sum_))
+    {
+      sout_ << nostd::get<long>(sketch_point_data.sum_);
+    }
+    sout_ << "\n  min     : " << sketch_point_data.min_;
+    sout_ << "\n  max     : " << sketch_point_data.max_;
+    sout_ << "\n  p50     : " << sdk::metrics::SketchQuantile(sketch_point_data, 0.5);
+    sout_ << "\n  p90     : " << sdk::metrics::SketchQuantile(sketch_point_data, 0.9);
+    sout_ << "\n  p99     : " << sdk::metrics::SketchQuantile(sketch_point_data, 0.99);
+    sout_ << "\n  relative accuracy     : " << sketch_point_data.relative_accuracy_;
+    sout_ << "\n  zero count     : " << sketch_point_data.zero_count_;
+    sout_ << "\n  positive offset     : " << sketch_point_data.positive_buckets_.offset_;
+    sout_ << "\n  positive counts     : ";
+    printVec(sout_, sketch_point_data.positive_buckets_.counts_);
+    sout_ << "\n  negative offset     : " << sketch_point_data.negative_buckets_.offset_;
+    sout_ << "\n  negative counts     : ";
+    printVec(sout_, sketch_point_data.negative_buckets_.counts_);
+  }
   else if (nostd::holds_alternative<sdk::metrics::LastValuePointData>(point_data))
   {
     auto last_point_data = nostd::get<sdk::metrics::LastValuePointData>(point_data);
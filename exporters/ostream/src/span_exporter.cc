@@ -37,7 +37,13 @@ std::ostream &operator<<(std::ostream &os, trace_api::SpanKind span_kind)
   return os << "";
 }
 
-OStreamSpanExporter::OStreamSpanExporter(std::ostream &sout) noexcept : sout_(sout) {}
+OStreamSpanExporter::OStreamSpanExporter(std::ostream &sout) noexcept : sout_(sout), options_() {}
+
+OStreamSpanExporter::OStreamSpanExporter(
+    std::ostream &sout,
+    const ostream_common::OStreamExporterOptions &options) noexcept
+    : sout_(sout), options_(options)
+{}
 
 std::unique_ptr<trace_sdk::Recordable> OStreamSpanExporter::MakeRecordable() noexcept
 {
@@ -54,6 +60,8 @@ sdk::common::ExportResult OStreamSpanExporter::Export(
     return sdk::common::ExportResult::kFailure;
   }
 
+  // A buffered batch is formatted in memory, then written at once.
+  std::ostream &sout = options_.buffered ? buffer_.Begin() : sout_;
   for (auto &recordable : spans)
   {
     auto span = std::unique_ptr<trace_sdk::SpanData>(
@@ -61,39 +69,20 @@ sdk::common::ExportResult OStreamSpanExporter::Export(
 
     if (span != nullptr)
     {
-
-      char trace_id[32]       = {0};
-      char span_id[16]        = {0};
-      char parent_span_id[16] = {0};
-
-      span->GetTraceId().ToLowerBase16(trace_id);
-      span->GetSpanId().ToLowerBase16(span_id);
-      span->GetParentSpanId().ToLowerBase16(parent_span_id);
-
-      sout_ << "{"
-            << "\n  name          : " << span->GetName()
-            << "\n  trace_id      : " << std::string(trace_id, 32)
-            << "\n  span_id       : " << std::string(span_id, 16)
-            << "\n  tracestate    : " << span->GetSpanContext().trace_state()->ToHeader()
-            << "\n  parent_span_id: " << std::string(parent_span_id, 16)
-            << "\n  start         : " << span->GetStartTime().time_since_epoch().count()
-            << "\n  duration      : " << span->GetDuration().count()
-            << "\n  description   : " << span->GetDescription()
-            << "\n  span kind     : " << span->GetSpanKind()
-            << "\n  status        : " << statusMap[int(span->GetStatus())]
-            << "\n  attributes    : ";
-      printAttributes(span->GetAttributes());
-      sout_ << "\n  events        : ";
-      printEvents(span->GetEvents());
-      sout_ << "\n  links         : ";
-      printLinks(span->GetLinks());
-      sout_ << "\n  resources     : ";
-      printResources(span->GetResource());
-      sout_ << "\n  instr-lib     : ";
-      printInstrumentationLibrary(span->GetInstrumentationLibrary());
-      sout_ << "\n}\n";
+      if (options_.format == ostream_common::OStreamFormat::kCompactJson)
+      {
+        printJsonSpan(*span, sout);
+      }
+      else
+      {
+        printSpan(*span, sout);
+      }
     }
   }
+  if (options_.buffered)
+  {
+    buffer_.WriteTo(sout_);
+  }
 
   return sdk::common::ExportResult::kSuccess;
 }
@@ -110,31 +99,155 @@ bool OStreamSpanExporter::isShutdown() const noexcept
   const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
   return is_shutdown_;
 }
+
+void OStreamSpanExporter::printSpan(const trace_sdk::SpanData &span, std::ostream &sout)
+{
+  char trace_id[32]       = {0};
+  char span_id[16]        = {0};
+  char parent_span_id[16] = {0};
+
+  span.GetTraceId().ToLowerBase16(trace_id);
+  span.GetSpanId().ToLowerBase16(span_id);
+  span.GetParentSpanId().ToLowerBase16(parent_span_id);
+
+  sout << "{"
+       << "\n  name          : " << span.GetName()
+       << "\n  trace_id      : " << std::string(trace_id, 32)
+       << "\n  span_id       : " << std::string(span_id, 16)
+       << "\n  tracestate    : " << span.GetSpanContext().trace_state()->ToHeader()
+       << "\n  parent_span_id: " << std::string(parent_span_id, 16)
+       << "\n  start         : " << span.GetStartTime().time_since_epoch().count()
+       << "\n  duration      : " << span.GetDuration().count()
+       << "\n  description   : " << span.GetDescription()
+       << "\n  span kind     : " << span.GetSpanKind()
+       << "\n  status        : " << statusMap[int(span.GetStatus())]
+       << "\n  attributes    : ";
+  printAttributes(span.GetAttributes(), sout);
+  sout << "\n  events        : ";
+  printEvents(span.GetEvents(), sout);
+  sout << "\n  links         : ";
+  printLinks(span.GetLinks(), sout);
+  sout << "\n  resources     : ";
+  printResources(span.GetResource(), sout);
+  sout << "\n  instr-lib     : ";
+  printInstrumentationLibrary(span.GetInstrumentationLibrary(), sout);
+  sout << "\n}\n";
+}
+
+void OStreamSpanExporter::printJsonSpan(const trace_sdk::SpanData &span, std::ostream &sout)
+{
+  using ostream_common::print_json_attributes;
+  using ostream_common::print_json_string;
+
+  char trace_id[32]       = {0};
+  char span_id[16]        = {0};
+  char parent_span_id[16] = {0};
+
+  span.GetTraceId().ToLowerBase16(trace_id);
+  span.GetSpanId().ToLowerBase16(span_id);
+  span.GetParentSpanId().ToLowerBase16(parent_span_id);
+
+  sout << "{\"name\":";
+  print_json_string(span.GetName(), sout);
+  sout << ",\"trace_id\":\"" << nostd::string_view(trace_id, 32) << "\",\"span_id\":\""
+       << nostd::string_view(span_id, 16) << "\",\"tracestate\":";
+  print_json_string(span.GetSpanContext().trace_state()->ToHeader(), sout);
+  sout << ",\"parent_span_id\":\"" << nostd::string_view(parent_span_id, 16)
+       << "\",\"start\":" << span.GetStartTime().time_since_epoch().count()
+       << ",\"duration\":" << span.GetDuration().count() << ",\"description\":";
+  print_json_string(span.GetDescription(), sout);
+  sout << ",\"span_kind\":\"" << span.GetSpanKind() << "\",\"status\":\""
+       << statusMap[int(span.GetStatus())] << "\",\"attributes\":";
+  print_json_attributes(span.GetAttributes(), sout);
+
+  sout << ",\"events\":[";
+  bool first = true;
+  for (const auto &event : span.GetEvents())
+  {
+    sout << (first ? "{\"name\":" : ",{\"name\":");
+    first = false;
+    print_json_string(event.GetName(), sout);
+    sout << ",\"timestamp\":" << event.GetTimestamp().time_since_epoch().count()
+         << ",\"attributes\":";
+    print_json_attributes(event.GetAttributes(), sout);
+    sout << '}';
+  }
+
+  sout << "],\"links\":[";
+  first = true;
+  for (const auto &link : span.GetLinks())
+  {
+    char link_trace_id[32] = {0};
+    char link_span_id[16]  = {0};
+    link.GetSpanContext().trace_id().ToLowerBase16(link_trace_id);
+    link.GetSpanContext().span_id().ToLowerBase16(link_span_id);
+    sout << (first ? "{" : ",{") << "\"trace_id\":\"" << nostd::string_view(link_trace_id, 32)
+         << "\",\"span_id\":\"" << nostd::string_view(link_span_id, 16) << "\",\"tracestate\":";
+    first = false;
+    print_json_string(link.GetSpanContext().trace_state()->ToHeader(), sout);
+    sout << ",\"attributes\":";
+    print_json_attributes(link.GetAttributes(), sout);
+    sout << '}';
+  }
+
+  sout << "],\"resources\":";
+  print_json_attributes(span.GetResource().GetAttributes(), sout);
+  const auto &instrumentation_library = span.GetInstrumentationLibrary();
+  sout << ",\"instr_lib\":{\"name\":";
+  print_json_string(instrumentation_library.GetName(), sout);
+  sout << ",\"version\":";
+  print_json_string(instrumentation_library.GetVersion(), sout);
+  sout << "}}\n";
+}
+
 void OStreamSpanExporter::printAttributes(
     const std::unordered_map<std::string, sdkcommon::OwnedAttributeValue> &map,
-    const std::string prefix)
+    std::ostream &sout,
+    const std::string &prefix)
+{
+  for (const auto &kv : map)
+  {
+    sout << prefix << kv.first << ": ";
+    opentelemetry::exporter::ostream_common::print_value(kv.second, sout);
+  }
+}
+
+void OStreamSpanExporter::printAttributes(const sdkcommon::FlatOrderedAttributeMap &map,
+                                          std::ostream &sout,
+                                          const std::string &prefix)
+{
+  for (const auto &kv : map)
+  {
+    sout << prefix << kv.first << ": ";
+    opentelemetry::exporter::ostream_common::print_value(kv.second, sout);
+  }
+}
+
+void OStreamSpanExporter::printAttributes(const sdkcommon::FlatAttributeMap &map,
+                                          std::ostream &sout,
+                                          const std::string &prefix)
 {
   for (const auto &kv : map)
   {
-    sout_ << prefix << kv.first << ": ";
-    opentelemetry::exporter::ostream_common::print_value(kv.second, sout_);
+    sout << prefix << kv.first << ": ";
+    opentelemetry::exporter::ostream_common::print_value(kv.second, sout);
   }
 }
 
-void OStreamSpanExporter::printEvents(const std::vector<trace_sdk::SpanDataEvent> &events)
+void OStreamSpanExporter::printEvents(const trace_sdk::SpanDataEvents &events, std::ostream &sout)
 {
   for (const auto &event : events)
   {
-    sout_ << "\n\t{"
-          << "\n\t  name          : " << event.GetName()
-          << "\n\t  timestamp     : " << event.GetTimestamp().time_since_epoch().count()
-          << "\n\t  attributes    : ";
-    printAttributes(event.GetAttributes(), "\n\t\t");
-    sout_ << "\n\t}";
+    sout << "\n\t{"
+         << "\n\t  name          : " << event.GetName()
+         << "\n\t  timestamp     : " << event.GetTimestamp().time_since_epoch().count()
+         << "\n\t  attributes    : ";
+    printAttributes(event.GetAttributes(), sout, "\n\t\t");
+    sout << "\n\t}";
   }
 }
 
-void OStreamSpanExporter::printLinks(const std::vector<trace_sdk::SpanDataLink> &links)
+void OStreamSpanExporter::printLinks(const trace_sdk::SpanDataLinks &links, std::ostream &sout)
 {
   for (const auto &link : links)
   {
@@ -142,34 +255,36 @@ void OStreamSpanExporter::printLinks(const std::vector<trace_sdk::SpanDataLink>
     char span_id[16]  = {0};
     link.GetSpanContext().trace_id().ToLowerBase16(trace_id);
     link.GetSpanContext().span_id().ToLowerBase16(span_id);
-    sout_ << "\n\t{"
-          << "\n\t  trace_id      : " << std::string(trace_id, 32)
-          << "\n\t  span_id       : " << std::string(span_id, 16)
-          << "\n\t  tracestate    : " << link.GetSpanContext().trace_state()->ToHeader()
-          << "\n\t  attributes    : ";
-    printAttributes(link.GetAttributes(), "\n\t\t");
-    sout_ << "\n\t}";
+    sout << "\n\t{"
+         << "\n\t  trace_id      : " << std::string(trace_id, 32)
+         << "\n\t  span_id       : " << std::string(span_id, 16)
+         << "\n\t  tracestate    : " << link.GetSpanContext().trace_state()->ToHeader()
+         << "\n\t  attributes    : ";
+    printAttributes(link.GetAttributes(), sout, "\n\t\t");
+    sout << "\n\t}";
   }
 }
 
-void OStreamSpanExporter::printResources(const opentelemetry::sdk::resource::Resource &resources)
+void OStreamSpanExporter::printResources(const opentelemetry::sdk::resource::Resource &resources,
+                                         std::ostream &sout)
 {
-  auto attributes = resources.GetAttributes();
+  const auto &attributes = resources.GetAttributes();
   if (attributes.size())
   {
-    printAttributes(attributes, "\n\t");
+    printAttributes(attributes, sout, "\n\t");
   }
 }
 
 void OStreamSpanExporter::printInstrumentationLibrary(
     const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
-        &instrumentation_library)
+        &instrumentation_library,
+    std::ostream &sout)
 {
-  sout_ << instrumentation_library.GetName();
+  sout << instrumentation_library.GetName();
   auto version = instrumentation_library.GetVersion();
   if (version.size())
   {
-    sout_ << "-" << version;
+    sout << "-" << version;
   }
 }
 
@@ -3,6 +3,7 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 
+#  include <algorithm>
 #  include <array>
 #  include "opentelemetry/exporters/ostream/log_exporter.h"
 #  include "opentelemetry/logs/provider.h"
@@ -324,6 +325,64 @@ TEST(OStreamLogExporter, IntegrationTest)
   }
 }
 
+// Test that a buffered exporter prints a batch of logs as compact JSON, one log per line
+TEST(OStreamLogExporter, BufferedCompactJson)
+{
+  std::stringstream output;
+  ostream_common::OStreamExporterOptions options;
+  options.format   = ostream_common::OStreamFormat::kCompactJson;
+  options.buffered = true;
+  OStreamLogExporter exporter(output, options);
+
+  std::unique_ptr<sdklogs::Recordable> records[2] = {exporter.MakeRecordable(),
+                                                     exporter.MakeRecordable()};
+  records[0]->SetSeverity(logs_api::Severity::kTrace);
+  records[0]->SetBody("Message\t1");
+  records[0]->SetAttribute("key", "value");
+  records[1]->SetSeverity(logs_api::Severity::kDebug);
+  records[1]->SetBody("Message 2");
+  exporter.Export(nostd::span<std::unique_ptr<sdklogs::Recordable>>(records, 2));
+
+  std::string out = output.str();
+  ASSERT_EQ(std::count(out.begin(), out.end(), '\n'), 2);
+  EXPECT_EQ(out.find("{\"timestamp\":0,\"severity_num\":1,\"severity_text\":\"TRACE\","
+                     "\"body\":\"Message\\t1\",\"resource\":{"),
+            0);
+  EXPECT_NE(out.find(",\"attributes\":{\"key\":\"value\"},\"trace_id\":"
+                     "\"00000000000000000000000000000000\",\"span_id\":\"0000000000000000\","
+                     "\"trace_flags\":\"00\"}\n{\"timestamp\":0,\"severity_num\":5"),
+            std::string::npos);
+  EXPECT_NE(out.find("\"telemetry.sdk.language\":\"cpp\""), std::string::npos);
+}
+
+// Test that the message of a log written from a message template is formatted, while the JSON
+// formats keep the template and its arguments
+TEST(OStreamLogExporter, FormatsMessageTemplate)
+{
+  std::stringstream output;
+  OStreamLogExporter exporter(output);
+
+  auto record = exporter.MakeRecordable();
+  record->SetSeverity(logs_api::Severity::kInfo);
+  record->SetBody("Request {} took {} ms");
+  record->SetAttribute(logs_api::Logger::GetLogTemplateArgumentKey(0), "/index.html");
+  record->SetAttribute(logs_api::Logger::GetLogTemplateArgumentKey(1), 12);
+  exporter.Export(nostd::span<std::unique_ptr<sdklogs::Recordable>>(&record, 1));
+  EXPECT_NE(output.str().find("  body          : Request /index.html took 12 ms\n"),
+            std::string::npos);
+
+  std::stringstream json_output;
+  ostream_common::OStreamExporterOptions options;
+  options.format = ostream_common::OStreamFormat::kCompactJson;
+  OStreamLogExporter json_exporter(json_output, options);
+  record = json_exporter.MakeRecordable();
+  record->SetBody("Request {} took {} ms");
+  record->SetAttribute(logs_api::Logger::GetLogTemplateArgumentKey(0), "/index.html");
+  json_exporter.Export(nostd::span<std::unique_ptr<sdklogs::Recordable>>(&record, 1));
+  EXPECT_NE(json_output.str().find("\"body\":\"Request {} took {} ms\""), std::string::npos);
+  EXPECT_NE(json_output.str().find("\"log.template.arg.0\":\"/index.html\""), std::string::npos);
+}
+
 }  // namespace logs
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -96,11 +96,15 @@ TEST(OStreamMetricsExporter, ExportHistogramPointData)
   histogram_point_data.count_      = 3;
   histogram_point_data.counts_     = {200, 300, 400, 500};
   histogram_point_data.sum_        = 900.5;
+  histogram_point_data.min_        = 1.5;
+  histogram_point_data.max_        = 35.5;
   metric_sdk::HistogramPointData histogram_point_data2{};
   histogram_point_data2.boundaries_ = std::list<long>{10, 20, 30};
   histogram_point_data2.count_      = 3;
   histogram_point_data2.counts_     = {200, 300, 400, 500};
   histogram_point_data2.sum_        = 900l;
+  histogram_point_data2.min_        = 1l;
+  histogram_point_data2.max_        = 35l;
   metric_sdk::ResourceMetrics data;
   auto resource = opentelemetry::sdk::resource::Resource::Create(
       opentelemetry::sdk::resource::ResourceAttributes{});
@@ -141,6 +145,8 @@ TEST(OStreamMetricsExporter, ExportHistogramPointData)
       "\n  type     : HistogramPointData"
       "\n  count     : 3"
       "\n  sum     : 900.5"
+      "\n  min     : 1.5"
+      "\n  max     : 35.5"
       "\n  buckets     : [10.1, 20.2, 30.2, ]"
       "\n  counts     : [200, 300, 400, 500, ]"
       "\n  attributes\t\t: "
@@ -149,6 +155,8 @@ TEST(OStreamMetricsExporter, ExportHistogramPointData)
       "\n  type     : HistogramPointData"
       "\n  count     : 3"
       "\n  sum     : 900"
+      "\n  min     : 1"
+      "\n  max     : 35"
       "\n  buckets     : [10, 20, 30, ]"
       "\n  counts     : [200, 300, 400, 500, ]"
       "\n  attributes\t\t: "
@@ -157,6 +165,140 @@ TEST(OStreamMetricsExporter, ExportHistogramPointData)
   ASSERT_EQ(stdoutOutput.str(), expected_output);
 }
 
+TEST(OStreamMetricsExporter, ExportExponentialHistogramPointData)
+{
+  auto exporter =
+      std::unique_ptr<metric_sdk::MetricExporter>(new exportermetrics::OStreamMetricExporter);
+
+  metric_sdk::ExponentialHistogramPointData histogram_point_data{};
+  histogram_point_data.count_                    = 7;
+  histogram_point_data.sum_                      = 20.5;
+  histogram_point_data.zero_count_               = 1;
+  histogram_point_data.scale_                    = 2;
+  histogram_point_data.positive_buckets_.offset_ = -3;
+  histogram_point_data.positive_buckets_.counts_ = {2, 0, 4};
+  metric_sdk::ResourceMetrics data;
+  auto resource = opentelemetry::sdk::resource::Resource::Create(
+      opentelemetry::sdk::resource::ResourceAttributes{});
+  data.resource_ = &resource;
+  auto instrumentation_library =
+      opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("library_name",
+                                                                                 "1.2.0");
+  metric_sdk::MetricData metric_data{
+      metric_sdk::InstrumentDescriptor{"library_name", "description", "unit",
+                                       metric_sdk::InstrumentType::kHistogram,
+                                       metric_sdk::InstrumentValueType::kDouble},
+      metric_sdk::AggregationTemporality::kDelta, opentelemetry::common::SystemTimestamp{},
+      opentelemetry::common::SystemTimestamp{},
+      std::vector<metric_sdk::PointDataAttributes>{
+          {metric_sdk::PointAttributes{{"a1", "b1"}}, histogram_point_data}}};
+  data.instrumentation_info_metric_data_ = std::vector<metric_sdk::InstrumentationInfoMetrics>{
+      {instrumentation_library.get(), std::vector<metric_sdk::MetricData>{metric_data}}};
+
+  std::stringstream stdoutOutput;
+  std::streambuf *sbuf = std::cout.rdbuf();
+  std::cout.rdbuf(stdoutOutput.rdbuf());
+
+  auto result = exporter->Export(data);
+  EXPECT_EQ(result, opentelemetry::sdk::common::ExportResult::kSuccess);
+  std::cout.rdbuf(sbuf);
+
+  std::string expected_output =
+      "{"
+      "\n  name\t\t: library_name"
+      "\n  schema url\t: "
+      "\n  version\t: 1.2.0"
+      "\n  start time\t: Thu Jan  1 00:00:00 1970"
+      "\n  end time\t: Thu Jan  1 00:00:00 1970"
+      "\n  name\t\t: library_name"
+      "\n  description\t: description"
+      "\n  unit\t\t: unit"
+      "\n  type     : ExponentialHistogramPointData"
+      "\n  count     : 7"
+      "\n  sum     : 20.5"
+      "\n  scale     : 2"
+      "\n  zero count     : 1"
+      "\n  positive offset     : -3"
+      "\n  positive counts     : [2, 0, 4, ]"
+      "\n  negative offset     : 0"
+      "\n  negative counts     : []"
+      "\n  attributes\t\t: "
+      "\n\ta1: b1"
+      "\n}\n";
+  ASSERT_EQ(stdoutOutput.str(), expected_output);
+}
+
+TEST(OStreamMetricsExporter, ExportSketchPointData)
+{
+  auto exporter =
+      std::unique_ptr<metric_sdk::MetricExporter>(new exportermetrics::OStreamMetricExporter);
+
+  metric_sdk::SketchPointData sketch_point_data{};
+  sketch_point_data.count_                    = 4;
+  sketch_point_data.sum_                      = 7.5;
+  sketch_point_data.zero_count_               = 1;
+  sketch_point_data.min_                      = 0;
+  sketch_point_data.max_                      = 4.5;
+  sketch_point_data.relative_accuracy_        = 0.5;
+  sketch_point_data.positive_buckets_.offset_ = 1;
+  sketch_point_data.positive_buckets_.counts_ = {2, 1};
+  metric_sdk::ResourceMetrics data;
+  auto resource = opentelemetry::sdk::resource::Resource::Create(
+      opentelemetry::sdk::resource::ResourceAttributes{});
+  data.resource_ = &resource;
+  auto instrumentation_library =
+      opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("library_name",
+                                                                                 "1.2.0");
+  metric_sdk::MetricData metric_data{
+      metric_sdk::InstrumentDescriptor{"library_name", "description", "unit",
+                                       metric_sdk::InstrumentType::kHistogram,
+                                       metric_sdk::InstrumentValueType::kDouble},
+      metric_sdk::AggregationTemporality::kDelta, opentelemetry::common::SystemTimestamp{},
+      opentelemetry::common::SystemTimestamp{},
+      std::vector<metric_sdk::PointDataAttributes>{
+          {metric_sdk::PointAttributes{{"a1", "b1"}}, sketch_point_data}}};
+  data.instrumentation_info_metric_data_ = std::vector<metric_sdk::InstrumentationInfoMetrics>{
+      {instrumentation_library.get(), std::vector<metric_sdk::MetricData>{metric_data}}};
+
+  std::stringstream stdoutOutput;
+  std::streambuf *sbuf = std::cout.rdbuf();
+  std::cout.rdbuf(stdoutOutput.rdbuf());
+
+  auto result = exporter->Export(data);
+  EXPECT_EQ(result, opentelemetry::sdk::common::ExportResult::kSuccess);
+  std::cout.rdbuf(sbuf);
+
+  // With gamma = 3, bucket 1 holds (1, 3] and is represented by 1.5.
+  std::string expected_output =
+      "{"
+      "\n  name\t\t: library_name"
+      "\n  schema url\t: "
+      "\n  version\t: 1.2.0"
+      "\n  start time\t: Thu Jan  1 00:00:00 1970"
+      "\n  end time\t: Thu Jan  1 00:00:00 1970"
+      "\n  name\t\t: library_name"
+      "\n  description\t: description"
+      "\n  unit\t\t: unit"
+      "\n  type     : SketchPointData"
+      "\n  count     : 4"
+      "\n  sum     : 7.5"
+      "\n  min     : 0"
+      "\n  max     : 4.5"
+      "\n  p50     : 1.5"
+      "\n  p90     : 1.5"
+      "\n  p99     : 1.5"
+      "\n  relative accuracy     : 0.5"
+      "\n  zero count     : 1"
+      "\n  positive offset     : 1"
+      "\n  positive counts     : [2, 1, ]"
+      "\n  negative offset     : 0"
+      "\n  negative counts     : []"
+      "\n  attributes\t\t: "
+      "\n\ta1: b1"
+      "\n}\n";
+  ASSERT_EQ(stdoutOutput.str(), expected_output);
+}
+
 TEST(OStreamMetricsExporter, ExportLastValuePointData)
 {
   auto exporter =
@@ -396,3 +396,52 @@ TEST(OStreamSpanExporter, PrintSpanToClog)
 
   EXPECT_EQ(captured, kDefaultSpanPrinted);
 }
+
+TEST(OStreamSpanExporter, PrintBufferedBatch)
+{
+  std::stringstream output;
+  opentelemetry::exporter::ostream_common::OStreamExporterOptions options;
+  options.buffered = true;
+  exportertrace::OStreamSpanExporter exporter(output, options);
+
+  for (int batch = 0; batch < 2; ++batch)
+  {
+    std::unique_ptr<trace_sdk::Recordable> spans[2] = {exporter.MakeRecordable(),
+                                                       exporter.MakeRecordable()};
+    exporter.Export(nostd::span<std::unique_ptr<trace_sdk::Recordable>>(spans, 2));
+  }
+
+  // The buffer is reused from batch to batch.
+  EXPECT_EQ(output.str(), std::string(kDefaultSpanPrinted) + kDefaultSpanPrinted +
+                              kDefaultSpanPrinted + kDefaultSpanPrinted);
+}
+
+TEST(OStreamSpanExporter, PrintCompactJson)
+{
+  std::stringstream output;
+  opentelemetry::exporter::ostream_common::OStreamExporterOptions options;
+  options.format   = opentelemetry::exporter::ostream_common::OStreamFormat::kCompactJson;
+  options.buffered = true;
+  exportertrace::OStreamSpanExporter exporter(output, options);
+
+  auto recordable = exporter.MakeRecordable();
+  recordable->SetName("Test \"Span\"\n");
+  const bool flags[] = {true, false};
+  recordable->SetAttribute("flags", nostd::span<const bool>(flags));
+  recordable->AddEvent("event", common::SystemTimestamp(std::chrono::nanoseconds(5)),
+                       common::KeyValueIterableView<std::map<std::string, int>>(
+                           std::map<std::string, int>{{"count", 3}}));
+  TestResource resource(resource::ResourceAttributes({{"key1", "val1"}}));
+  recordable->SetResource(resource);
+  exporter.Export(nostd::span<std::unique_ptr<trace_sdk::Recordable>>(&recordable, 1));
+
+  EXPECT_EQ(output.str(),
+            "{\"name\":\"Test \\\"Span\\\"\\n\","
+            "\"trace_id\":\"00000000000000000000000000000000\",\"span_id\":\"0000000000000000\","
+            "\"tracestate\":\"\",\"parent_span_id\":\"0000000000000000\",\"start\":0,"
+            "\"duration\":0,\"description\":\"\",\"span_kind\":\"Internal\",\"status\":\"Unset\","
+            "\"attributes\":{\"flags\":[true,false]},"
+            "\"events\":[{\"name\":\"event\",\"timestamp\":5,\"attributes\":{\"count\":3}}],"
+            "\"links\":[],\"resources\":{\"key1\":\"val1\"},"
+            "\"instr_lib\":{\"name\":\"unknown_service\",\"version\":\"\"}}\n");
+}
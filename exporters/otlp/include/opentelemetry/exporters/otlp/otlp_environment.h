@@ -21,6 +21,19 @@ namespace exporter
 namespace otlp
 {
 
+/**
+ * Appends the path of a signal, e.g. /v1/traces, to the url of OTEL_EXPORTER_OTLP_ENDPOINT. On a
+ * unix://<socket path> url, the path follows the socket path after a ':'.
+ */
+inline std::string AppendOtlpSignalPath(std::string endpoint, const char *signal_path)
+{
+  if (endpoint.compare(0, 7, "unix://") == 0 && endpoint.find(':', 7) == std::string::npos)
+  {
+    endpoint += ':';
+  }
+  return endpoint + signal_path;
+}
+
 inline const std::string GetOtlpDefaultGrpcEndpoint()
 {
   constexpr char kOtlpTracesEndpointEnv[] = "OTEL_EXPORTER_OTLP_TRACES_ENDPOINT";
@@ -47,7 +60,7 @@ inline const std::string GetOtlpDefaultHttpEndpoint()
     endpoint = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpEndpointEnv);
     if (!endpoint.empty())
     {
-      endpoint += "/v1/traces";
+      endpoint = AppendOtlpSignalPath(endpoint, "/v1/traces");
     }
   }
   return endpoint.size() ? endpoint : kOtlpEndpointDefault;
@@ -221,6 +234,35 @@ inline OtlpHeaders GetOtlpDefaultHeaders()
   return result;
 }
 
+inline const std::string GetOtlpDefaultCompression()
+{
+  constexpr char kOtlpTracesCompressionEnv[] = "OTEL_EXPORTER_OTLP_TRACES_COMPRESSION";
+  constexpr char kOtlpCompressionEnv[]       = "OTEL_EXPORTER_OTLP_COMPRESSION";
+
+  auto compression = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpTracesCompressionEnv);
+  if (compression.empty())
+  {
+    compression = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpCompressionEnv);
+  }
+  return compression.size() ? compression : "none";
+}
+
+/**
+ * The compression level of OTLP payloads, from 1 (fastest) to 9 (smallest). -1, the default,
+ * leaves the level to the compression library.
+ */
+inline int GetOtlpDefaultCompressionLevel()
+{
+  constexpr char kOtlpCompressionLevelEnv[] = "OTEL_EXPORTER_OTLP_COMPRESSION_LEVEL";
+
+  auto level = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpCompressionLevelEnv);
+  if (level.size() == 1 && level[0] >= '1' && level[0] <= '9')
+  {
+    return level[0] - '0';
+  }
+  return -1;
+}
+
 inline const std::string GetOtlpDefaultHttpLogEndpoint()
 {
   constexpr char kOtlpLogsEndpointEnv[] = "OTEL_EXPORTER_OTLP_LOGS_ENDPOINT";
@@ -233,7 +275,7 @@ inline const std::string GetOtlpDefaultHttpLogEndpoint()
     endpoint = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpEndpointEnv);
     if (!endpoint.empty())
     {
-      endpoint += "/v1/logs";
+      endpoint = AppendOtlpSignalPath(endpoint, "/v1/logs");
     }
   }
   return endpoint.size() ? endpoint : kOtlpEndpointDefault;
@@ -266,6 +308,19 @@ inline OtlpHeaders GetOtlpDefaultLogHeaders()
 
   return result;
 }
+
+inline const std::string GetOtlpDefaultLogCompression()
+{
+  constexpr char kOtlpLogsCompressionEnv[] = "OTEL_EXPORTER_OTLP_LOGS_COMPRESSION";
+  constexpr char kOtlpCompressionEnv[]     = "OTEL_EXPORTER_OTLP_COMPRESSION";
+
+  auto compression = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpLogsCompressionEnv);
+  if (compression.empty())
+  {
+    compression = opentelemetry::sdk::common::GetEnvironmentVariable(kOtlpCompressionEnv);
+  }
+  return compression.size() ? compression : "none";
+}
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
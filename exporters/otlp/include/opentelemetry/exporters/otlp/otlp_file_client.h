@@ -0,0 +1,99 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/exporters/otlp/otlp_spill_file.h"
+#include "opentelemetry/sdk/common/exporter_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google
+{
+namespace protobuf
+{
+class Message;
+}
+}  // namespace google
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * Options of the OTLP file exporters.
+ *
+ * Each export is written as one record of the segment files of `directory`: an OTLP
+ * Export*ServiceRequest serialized in protobuf, gzip compressed if `compression` is "gzip". A
+ * compressed record starts with the gzip magic bytes, which no serialized request starts with.
+ * The records are read back with OtlpSpillFile, which frames them with their length.
+ */
+struct OtlpFileExporterOptions
+{
+  // Directory of the segment files, created by the application. Each exporter needs its own.
+  std::string directory;
+
+  // Size of a segment file. An export larger than this gets a segment of its own.
+  std::size_t segment_size = 8 * 1024 * 1024;
+
+  // Maximum size of the segment files together. Beyond it, the oldest segment is dropped.
+  std::size_t max_size = 1024 * 1024 * 1024;
+
+  OtlpSpillSync sync = OtlpSpillSync::kSegment;
+
+  // Compression of the records, "gzip" or "none".
+  std::string compression = "none";
+
+  // Compression level, from 1 (fastest) to 9 (smallest), or -1 for the default level.
+  int compression_level = -1;
+
+  // Records smaller than this many bytes are written uncompressed.
+  std::size_t compression_min_size = 1024;
+};
+
+/**
+ * Writes the OTLP requests of the file exporters to memory-mapped segment files.
+ */
+class OtlpFileClient
+{
+public:
+  explicit OtlpFileClient(const OtlpFileExporterOptions &options);
+
+  /**
+   * Serialize a request, compress it if configured, and append it to the segment files.
+   * @return kFailure if the segment files cannot be written, or if the client is shut down.
+   */
+  sdk::common::ExportResult Export(const google::protobuf::Message &message) noexcept;
+
+  /**
+   * Close the segment files. Later exports fail.
+   */
+  bool Shutdown() noexcept;
+
+  /**
+   * Returns the number of records dropped because the segment files went over max_size.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  const OtlpFileExporterOptions options_;
+
+  mutable std::mutex lock_;
+  std::unique_ptr<OtlpSpillFile> file_;
+  bool is_shutdown_ = false;
+
+  // Buffers of the serialized and compressed requests, reused from export to export.
+  std::vector<uint8_t> body_;
+  std::vector<uint8_t> compressed_body_;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,67 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// We need include exporter.h first, which will include Windows.h with NOMINMAX on Windows
+#include "opentelemetry/sdk/trace/exporter.h"
+
+#include "opentelemetry/exporters/otlp/otlp_file_client.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#include <chrono>
+#include <memory>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The OTLP file exporter writes span data in OpenTelemetry Protocol (OTLP) format to local files,
+ * to be shipped or replayed to a collector by another process.
+ */
+class OtlpFileExporter final : public opentelemetry::sdk::trace::SpanExporter
+{
+public:
+  /**
+   * Create an OtlpFileExporter using the given options.
+   */
+  explicit OtlpFileExporter(const OtlpFileExporterOptions &options);
+
+  /**
+   * Create a span recordable.
+   * @return a newly initialized Recordable object
+   */
+  std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+
+  /**
+   * Export
+   * @param spans a span of unique pointers to span recordables
+   */
+  opentelemetry::sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans) noexcept
+      override;
+
+  /**
+   * Shut down the exporter, closing its files.
+   * @param timeout ignored, as the files are written synchronously.
+   * @return return the status of this operation
+   */
+  bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
+
+  /**
+   * Returns the number of exports dropped because the files went over max_size.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  OtlpFileClient file_client_;
+
+  // The protos of the resources and instrumentation libraries of the exported spans.
+  OtlpProtoCache proto_cache_;
+};
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,67 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/sdk/logs/exporter.h"
+
+#  include "opentelemetry/exporters/otlp/otlp_file_client.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#  include <chrono>
+#  include <memory>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The OTLP file exporter writes log data in OpenTelemetry Protocol (OTLP) format to local files.
+ */
+class OtlpFileLogExporter final : public opentelemetry::sdk::logs::LogExporter
+{
+public:
+  /**
+   * Create an OtlpFileLogExporter using the given options.
+   */
+  explicit OtlpFileLogExporter(const OtlpFileExporterOptions &options);
+
+  /**
+   * Creates a recordable that stores the data in protobuf.
+   * @return a newly initialized Recordable object.
+   */
+  std::unique_ptr<opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
+
+  /**
+   * Exports a vector of log records to the files.
+   * @param records A list of log records.
+   */
+  opentelemetry::sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>> &records) noexcept
+      override;
+
+  /**
+   * Shut down the exporter, closing its files.
+   * @param timeout ignored, as the files are written synchronously.
+   * @return return the status of this operation
+   */
+  bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
+
+  /**
+   * Returns the number of exports dropped because the files went over max_size.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  OtlpFileClient file_client_;
+
+  // The protos of the resources and instrumentation libraries of the exported logs.
+  OtlpProtoCache proto_cache_;
+};
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+#endif
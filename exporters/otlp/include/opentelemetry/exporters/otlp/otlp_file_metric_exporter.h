@@ -0,0 +1,48 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+
+#  include "opentelemetry/exporters/otlp/otlp_file_client.h"
+#  include "opentelemetry/sdk/metrics/metric_exporter.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The OTLP file exporter writes metrics data in OpenTelemetry Protocol (OTLP) format to local
+ * files.
+ */
+class OtlpFileMetricsExporter : public opentelemetry::sdk::metrics::MetricExporter
+{
+public:
+  /**
+   * Create an OtlpFileMetricsExporter using the given options.
+   */
+  explicit OtlpFileMetricsExporter(const OtlpFileExporterOptions &options);
+
+  opentelemetry::sdk::common::ExportResult Export(
+      const opentelemetry::sdk::metrics::ResourceMetrics &data) noexcept override;
+
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Returns the number of exports dropped because the files went over max_size.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  OtlpFileClient file_client_;
+};
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -0,0 +1,82 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <grpcpp/channel.h>
+
+#include "opentelemetry/exporters/otlp/otlp_grpc_exporter_options.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * Creates the gRPC channels of the OTLP exporters.
+ */
+class OtlpGrpcClient
+{
+public:
+  /**
+   * Creates the channel_index-th channel of the pool of options.channel_pool_size channels, or
+   * nullptr if the endpoint is invalid. Each channel of a pool opens its own connections.
+   */
+  static std::shared_ptr<grpc::Channel> MakeChannel(const OtlpGrpcExporterOptions &options,
+                                                    std::size_t channel_index = 0);
+};
+
+/**
+ * The stubs of a service, one per channel of the pool, handed out in turn to the requests so that
+ * they are spread over the connections of the channels.
+ */
+template <class Service>
+class OtlpGrpcStubPool
+{
+public:
+  using StubInterface = typename Service::StubInterface;
+
+  /**
+   * Creates a stub on each of the options.channel_pool_size channels.
+   */
+  void Create(const OtlpGrpcExporterOptions &options)
+  {
+    std::size_t size = options.channel_pool_size > 0 ? options.channel_pool_size : 1;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      stubs_.push_back(Service::NewStub(OtlpGrpcClient::MakeChannel(options, i)));
+    }
+  }
+
+  void Add(std::unique_ptr<StubInterface> stub) { stubs_.push_back(std::move(stub)); }
+
+  bool empty() const noexcept { return stubs_.empty(); }
+
+  std::size_t size() const noexcept { return stubs_.size(); }
+
+  /**
+   * Returns the stub of the next channel, round-robin. The pool must not be empty.
+   */
+  StubInterface &Next() noexcept
+  {
+    if (stubs_.size() == 1)
+    {
+      return *stubs_[0];
+    }
+    return *stubs_[next_.fetch_add(1, std::memory_order_relaxed) % stubs_.size()];
+  }
+
+private:
+  std::vector<std::unique_ptr<StubInterface>> stubs_;
+  std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
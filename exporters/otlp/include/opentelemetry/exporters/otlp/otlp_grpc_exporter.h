@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
 
@@ -15,7 +20,9 @@
 #include "opentelemetry/sdk/trace/exporter.h"
 
 #include "opentelemetry/exporters/otlp/otlp_environment.h"
+#include "opentelemetry/exporters/otlp/otlp_grpc_client.h"
 #include "opentelemetry/exporters/otlp/otlp_grpc_exporter_options.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -52,6 +59,17 @@ class OtlpGrpcExporter final : public opentelemetry::sdk::trace::SpanExporter
   sdk::common::ExportResult Export(
       const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans) noexcept override;
 
+  /**
+   * Export a batch of span recordables in OTLP format, without waiting for the
+   * response. Up to options.max_concurrent_requests requests are kept in
+   * flight on a completion queue, whose thread invokes result_callback.
+   * @param spans a span of unique pointers to span recordables
+   * @param result_callback invoked with the result of the export
+   */
+  void ExportAsync(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
+      std::function<void(sdk::common::ExportResult)> &&result_callback) noexcept override;
+
   /**
    * Shut down the exporter.
    * @param timeout an optional timeout, the default timeout of 0 means that no
@@ -61,6 +79,13 @@ class OtlpGrpcExporter final : public opentelemetry::sdk::trace::SpanExporter
   bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
+  ~OtlpGrpcExporter() override;
+
+  /**
+   * Returns the counters of the retries of the failed exports.
+   */
+  OtlpRetryStatistics GetRetryStatistics() const noexcept;
+
 private:
   // The configuration options associated with this exporter.
   const OtlpGrpcExporterOptions options_;
@@ -68,8 +93,20 @@ class OtlpGrpcExporter final : public opentelemetry::sdk::trace::SpanExporter
   // For testing
   friend class OtlpGrpcExporterTestPeer;
 
-  // Store service stub internally. Useful for testing.
-  std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> trace_service_stub_;
+  // Store service stubs internally, one per channel of the pool. Useful for testing. Unless given
+  // to the constructor, they are created by the first export, see GetStub.
+  OtlpGrpcStubPool<proto::collector::trace::v1::TraceService> trace_service_stubs_;
+  std::once_flag trace_service_stubs_once_;
+
+  /**
+   * Returns the service stub of the next channel of the pool, creating the stubs and their channels
+   * on the first call, so that constructing the exporter does not load the TLS certificates nor
+   * resolve the endpoint. The channels connect in the background, when the first request is sent.
+   */
+  proto::collector::trace::v1::TraceService::StubInterface &GetStub();
+
+  // The protos of the resources and instrumentation libraries of the exported spans.
+  OtlpProtoCache proto_cache_;
 
   /**
    * Create an OtlpGrpcExporter using the specified service stub.
@@ -80,6 +117,35 @@ class OtlpGrpcExporter final : public opentelemetry::sdk::trace::SpanExporter
   bool is_shutdown_ = false;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool isShutdown() const noexcept;
+
+  /* Sets the deadline, metadata and compression of a request on its context, and counts it. */
+  void PrepareContext(grpc::ClientContext &context, std::size_t request_size) noexcept;
+
+  /* Delivers the results of asynchronous requests, until the completion queue is shut down. */
+  void PollCompletionQueue() noexcept;
+
+  /**
+   * Queues a request which failed with status for a retry, if status is transient.
+   * @return whether the request is queued
+   */
+  bool RetryExport(const proto::collector::trace::v1::ExportTraceServiceRequest &request,
+                   const grpc::Status &status) noexcept;
+
+  // Asynchronous requests complete on completion_queue_, polled by completion_thread_, which
+  // are both created by the first ExportAsync call.
+  std::unique_ptr<grpc::CompletionQueue> completion_queue_;
+  std::thread completion_thread_;
+  std::mutex async_mutex_;
+  std::condition_variable async_cv_;
+  std::size_t requests_in_flight_ = 0;
+
+  // The requests sent and the bytes of their payloads, counted by PrepareContext
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> request_bytes_{0};
+
+  // Retries the failed requests. Declared last, so that it stops retrying before the members its
+  // attempts use are destroyed.
+  OtlpRetryQueue retry_queue_;
 };
 }  // namespace otlp
 }  // namespace exporter
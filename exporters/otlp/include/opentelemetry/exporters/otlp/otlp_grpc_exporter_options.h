@@ -4,6 +4,7 @@
 #pragma once
 
 #include "opentelemetry/exporters/otlp/otlp_environment.h"
+#include "opentelemetry/exporters/otlp/otlp_retry_queue.h"
 
 #include <memory>
 
@@ -18,7 +19,8 @@ namespace otlp
  */
 struct OtlpGrpcExporterOptions
 {
-  // The endpoint to export to. By default the OpenTelemetry Collector's default endpoint.
+  // The endpoint to export to. By default the OpenTelemetry Collector's default endpoint. A
+  // collector listening on a Unix domain socket is reached with unix://<socket path>.
   std::string endpoint = GetOtlpDefaultGrpcEndpoint();
   // By default when false, uses grpc::InsecureChannelCredentials(); If true,
   // uses ssl_credentials_cacert_path if non-empty, else uses ssl_credentials_cacert_as_string
@@ -32,8 +34,35 @@ struct OtlpGrpcExporterOptions
   std::chrono::system_clock::duration timeout = GetOtlpDefaultTimeout();
   // Additional HTTP headers
   OtlpHeaders metadata = GetOtlpDefaultHeaders();
+  // Compression of the requests, "gzip" or "none". gRPC compresses with its own default level.
+  std::string compression = GetOtlpDefaultCompression();
+  // Requests smaller than this many bytes are sent uncompressed.
+  std::size_t compression_min_size = 1024;
+  // The maximum number of requests sent by ExportAsync that may be in flight at the same time.
+  // ExportAsync blocks once this many are outstanding.
+  std::size_t max_concurrent_requests = 64;
+  // Number of channels, each with its own connections, over which the requests are spread
+  // round-robin. More than one lifts the limits of a single HTTP/2 connection, and spreads the
+  // requests over several collectors behind a connection-level (L4) load balancer.
+  std::size_t channel_pool_size = 1;
+  // Load balancing policy of the channels, e.g. "round_robin" to resolve all the addresses of the
+  // endpoint with DNS and balance the requests over them. Empty for the gRPC default, which
+  // sends all the requests of a channel to the first address that connects.
+  std::string load_balancing_policy;
+  // Retries of the requests which failed with a transient status, such as UNAVAILABLE, or
+  // RESOURCE_EXHAUSTED with a RetryInfo.
+  OtlpRetryOptions retry;
 };
 
+/**
+ * Returns whether a request of request_size bytes is to be compressed.
+ */
+inline bool ShouldCompressOtlpGrpcRequest(const OtlpGrpcExporterOptions &options,
+                                          std::size_t request_size)
+{
+  return options.compression == "gzip" && request_size >= options.compression_min_size;
+}
+
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
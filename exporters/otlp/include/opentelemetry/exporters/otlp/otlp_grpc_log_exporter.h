@@ -14,7 +14,9 @@
 // clang-format on
 
 #  include "opentelemetry/exporters/otlp/otlp_environment.h"
+#  include "opentelemetry/exporters/otlp/otlp_grpc_client.h"
 #  include "opentelemetry/exporters/otlp/otlp_grpc_exporter_options.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
 #  include "opentelemetry/sdk/logs/exporter.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -69,8 +71,11 @@ class OtlpGrpcLogExporter : public opentelemetry::sdk::logs::LogExporter
   // For testing
   friend class OtlpGrpcLogExporterTestPeer;
 
-  // Store service stub internally. Useful for testing.
-  std::unique_ptr<proto::collector::logs::v1::LogsService::StubInterface> log_service_stub_;
+  // Store service stubs internally, one per channel of the pool. Useful for testing.
+  OtlpGrpcStubPool<proto::collector::logs::v1::LogsService> log_service_stubs_;
+
+  // The protos of the resources and instrumentation libraries of the exported logs.
+  OtlpProtoCache proto_cache_;
 
   /**
    * Create an OtlpGrpcLogExporter using the specified service stub.
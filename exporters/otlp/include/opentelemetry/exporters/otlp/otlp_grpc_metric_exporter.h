@@ -14,7 +14,9 @@
 // clang-format on
 
 #  include "opentelemetry/exporters/otlp/otlp_environment.h"
+#  include "opentelemetry/exporters/otlp/otlp_grpc_client.h"
 #  include "opentelemetry/exporters/otlp/otlp_grpc_metric_exporter_options.h"
+#  include "opentelemetry/exporters/otlp/otlp_metric_attributes_cache.h"
 #  include "opentelemetry/sdk/metrics/metric_exporter.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -55,9 +57,8 @@ class OtlpGrpcMetricsExporter : public opentelemetry::sdk::metrics::MetricExport
   // For testing
   friend class OtlpGrpcExporterTestPeer;
 
-  // Store service stub internally. Useful for testing.
-  std::unique_ptr<proto::collector::metrics::v1::MetricsService::StubInterface>
-      metrics_service_stub_;
+  // Store service stubs internally, one per channel of the pool. Useful for testing.
+  OtlpGrpcStubPool<proto::collector::metrics::v1::MetricsService> metrics_service_stubs_;
 
   /**
    * Create an OtlpGrpcMetricsExporter using the specified service stub.
@@ -66,6 +67,8 @@ class OtlpGrpcMetricsExporter : public opentelemetry::sdk::metrics::MetricExport
    */
   OtlpGrpcMetricsExporter(
       std::unique_ptr<proto::collector::metrics::v1::MetricsService::StubInterface> stub);
+  // The attributes of the series exported by the previous collection. Exports are not concurrent.
+  OtlpMetricAttributesCache attributes_cache_;
   bool is_shutdown_ = false;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool isShutdown() const noexcept;
@@ -21,6 +21,13 @@ struct OtlpGrpcMetricsExporterOptions : public OtlpGrpcExporterOptions
 {
   opentelemetry::sdk::metrics::AggregationTemporality aggregation_temporality =
       opentelemetry::sdk::metrics::AggregationTemporality::kDelta;
+  // The maximum number of points of a request. Larger collections are exported as several
+  // requests, serialized one at a time while the previous ones are in flight, at most
+  // max_concurrent_requests of them. 0 exports each collection as a single request.
+  std::size_t max_points_per_request = 8192;
+  // The maximum number of attribute sets whose KeyValue protos are kept from one collection to
+  // the next, see OtlpMetricAttributesCache. 0 converts the attributes at each collection.
+  std::size_t max_cached_attribute_sets = 65536;
 };
 
 }  // namespace otlp
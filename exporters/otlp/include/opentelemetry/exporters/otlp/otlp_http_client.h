@@ -14,11 +14,16 @@
 #include "opentelemetry/sdk/common/exporter_utils.h"
 
 #include "opentelemetry/exporters/otlp/otlp_environment.h"
+#include "opentelemetry/exporters/otlp/otlp_retry_queue.h"
+#include "opentelemetry/exporters/otlp/otlp_spill_file.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -71,20 +76,96 @@ struct OtlpHttpClientOptions
   // Additional HTTP headers
   OtlpHeaders http_headers = GetOtlpDefaultHeaders();
 
+  // Compression of the request bodies, "gzip" or "none".
+  std::string compression = "none";
+
+  // Compression level, from 1 (fastest) to 9 (smallest), or -1 for the default level.
+  int compression_level = -1;
+
+  // Request bodies smaller than this many bytes are sent uncompressed.
+  std::size_t compression_min_size = 1024;
+
+  // Keep connections to the collector open between requests.
+  bool keep_alive = true;
+
+  // Idle time of a kept-alive connection before TCP keep-alive probes are sent.
+  std::chrono::seconds keep_alive_idle{60};
+
+  // Maximum number of connections opened to the collector, 0 for no limit.
+  std::size_t max_connections_per_host = 0;
+
+  // Negotiate HTTP/2 on TLS connections, and multiplex concurrent requests on one connection.
+  bool http2 = true;
+
+  // Maximum number of requests sent at the same time, 0 for no limit.
+  std::size_t max_requests_in_flight = 64;
+
+  // Maximum number of requests waiting to be sent, 0 for no limit. Beyond it, the oldest waiting
+  // request is dropped.
+  std::size_t max_pending_requests = 256;
+
+  // Retries of the requests which failed with a transient error: no response, or a 429, 502, 503
+  // or 504 status.
+  OtlpRetryOptions retry;
+
+  // Spill file of the requests which failed with a transient error, replayed in order once the
+  // collector is reachable again. When enabled, it is used instead of the retries.
+  OtlpSpillOptions spill;
+
+  // Verify the certificate of the collector when the url is https. Only disable it to test
+  // against a collector with a self-signed certificate.
+  bool ssl_verify_peer = true;
+
+  // Path of the CA certificates to verify the collector with, empty for the default bundle.
+  std::string ssl_ca_cert_path = GetOtlpDefaultSslCertificatePath();
+
+  // Resolve the collector and connect to it when the exporter is created, so that the first
+  // export resumes the TLS session rather than waiting for a full handshake.
+  bool prewarm = false;
+
   inline OtlpHttpClientOptions(nostd::string_view input_url,
                                HttpRequestContentType input_content_type,
                                JsonBytesMappingKind input_json_bytes_mapping,
                                bool input_use_json_name,
                                bool input_console_debug,
                                std::chrono::system_clock::duration input_timeout,
-                               const OtlpHeaders &input_http_headers)
+                               const OtlpHeaders &input_http_headers,
+                               nostd::string_view input_compression = "none",
+                               int input_compression_level = -1,
+                               std::size_t input_compression_min_size = 1024,
+                               bool input_keep_alive = true,
+                               std::chrono::seconds input_keep_alive_idle =
+                                   std::chrono::seconds{60},
+                               std::size_t input_max_connections_per_host = 0,
+                               bool input_http2 = true,
+                               std::size_t input_max_requests_in_flight = 64,
+                               std::size_t input_max_pending_requests = 256,
+                               const OtlpRetryOptions &input_retry = OtlpRetryOptions(),
+                               const OtlpSpillOptions &input_spill = OtlpSpillOptions(),
+                               bool input_ssl_verify_peer = true,
+                               nostd::string_view input_ssl_ca_cert_path = "",
+                               bool input_prewarm = false)
       : url(input_url),
         content_type(input_content_type),
         json_bytes_mapping(input_json_bytes_mapping),
         use_json_name(input_use_json_name),
         console_debug(input_console_debug),
         timeout(input_timeout),
-        http_headers(input_http_headers)
+        http_headers(input_http_headers),
+        compression(input_compression),
+        compression_level(input_compression_level),
+        compression_min_size(input_compression_min_size),
+        keep_alive(input_keep_alive),
+        keep_alive_idle(input_keep_alive_idle),
+        max_connections_per_host(input_max_connections_per_host),
+        http2(input_http2),
+        max_requests_in_flight(input_max_requests_in_flight),
+        max_pending_requests(input_max_pending_requests),
+        retry(input_retry),
+        spill(input_spill),
+        ssl_verify_peer(input_ssl_verify_peer),
+        ssl_ca_cert_path(input_ssl_ca_cert_path),
+        prewarm(input_prewarm)
   {}
 };
 
@@ -114,7 +195,43 @@ class OtlpHttpClient
    */
   bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept;
 
+  /**
+   * Returns the counters of the retries of the failed requests.
+   */
+  OtlpRetryStatistics GetRetryStatistics() const noexcept;
+
+  /**
+   * Serialize a message into the body of its request, as Export does before sending it.
+   * @param message the message to serialize
+   * @param options the content type and the compression of the body
+   * @param body the request body, empty when it was compressed into chunks
+   * @param chunks the gzip compressed request body, if any
+   * @param content_type the Content-Type of the request
+   * @return false if the message could not be serialized
+   */
+  static bool SerializeRequestBody(const google::protobuf::Message &message,
+                                   const OtlpHttpClientOptions &options,
+                                   ext::http::client::Body &body,
+                                   std::vector<ext::http::client::Body> &chunks,
+                                   std::string &content_type) noexcept;
+
 private:
+  /**
+   * Send one request and wait for its response.
+   * @param body the request body, ignored if chunks is not empty
+   * @param chunks the gzip compressed request body
+   * @param content_type the Content-Type of the request
+   */
+  OtlpAttemptResult SendRequestBody(ext::http::client::Body &&body,
+                                    std::vector<ext::http::client::Body> &&chunks,
+                                    const std::string &content_type) noexcept;
+
+  /**
+   * Send the oldest requests of the spill file, until one fails with a transient error or
+   * spill.max_replay_per_export are sent.
+   */
+  void ReplaySpillFile() noexcept;
+
   // Stores if this HTTP client had its Shutdown() method called
   bool is_shutdown_ = false;
 
@@ -126,6 +243,15 @@ class OtlpHttpClient
   // Cached parsed URI
   std::string http_uri_;
   mutable opentelemetry::common::SpinLockMutex lock_;
+  // The spill file, if enabled, and the lock of the export replaying it
+  std::unique_ptr<OtlpSpillFile> spill_file_;
+  std::mutex replay_mutex_;
+  // The requests sent and the bytes of their bodies
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> request_bytes_{0};
+  // Retries the failed requests. Declared last, so that it stops retrying before the members its
+  // attempts use are destroyed.
+  OtlpRetryQueue retry_queue_;
   bool isShutdown() const noexcept;
   // For testing
   friend class OtlpHttpExporterTestPeer;
@@ -7,6 +7,7 @@
 #  include "opentelemetry/sdk/logs/exporter.h"
 
 #  include "opentelemetry/exporters/otlp/otlp_http_client.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
 
 #  include "opentelemetry/exporters/otlp/otlp_environment.h"
 
@@ -29,6 +30,8 @@ struct OtlpHttpLogExporterOptions
   // @see
   // https://github.com/open-telemetry/opentelemetry-specification/blob/main/specification/protocol/otlp.md
   // @see https://github.com/open-telemetry/opentelemetry-collector/tree/main/receiver/otlpreceiver
+  // A collector listening on a Unix domain socket is reached with a unix://<socket path>:<path>
+  // url, e.g. unix:///var/run/otelcol.sock:/v1/logs.
   std::string url = GetOtlpDefaultHttpLogEndpoint();
 
   // By default, post json data
@@ -50,6 +53,53 @@ struct OtlpHttpLogExporterOptions
 
   // Additional HTTP headers
   OtlpHeaders http_headers = GetOtlpDefaultLogHeaders();
+
+  // Compression of the payloads, "gzip" or "none".
+  std::string compression = GetOtlpDefaultLogCompression();
+
+  // Compression level, from 1 (fastest) to 9 (smallest), or -1 for the default level.
+  int compression_level = GetOtlpDefaultCompressionLevel();
+
+  // Payloads smaller than this many bytes are sent uncompressed.
+  std::size_t compression_min_size = 1024;
+
+  // Keep connections to the collector open between requests.
+  bool keep_alive = true;
+
+  // Idle time of a kept-alive connection before TCP keep-alive probes are sent.
+  std::chrono::seconds keep_alive_idle{60};
+
+  // Maximum number of connections opened to the collector, 0 for no limit.
+  std::size_t max_connections_per_host = 0;
+
+  // Negotiate HTTP/2 on TLS connections, and multiplex concurrent requests on one connection.
+  bool http2 = true;
+
+  // Maximum number of requests sent at the same time, 0 for no limit.
+  std::size_t max_requests_in_flight = 64;
+
+  // Maximum number of requests waiting to be sent, 0 for no limit. Beyond it, the oldest waiting
+  // request is dropped.
+  std::size_t max_pending_requests = 256;
+
+  // Retries of the requests which failed with a transient error: no response, or a 429, 502, 503
+  // or 504 status.
+  OtlpRetryOptions retry;
+
+  // Spill file of the requests which failed with a transient error, replayed in order once the
+  // collector is reachable again. When enabled, it is used instead of the retries.
+  OtlpSpillOptions spill;
+
+  // Verify the certificate of the collector when the url is https. Only disable it to test
+  // against a collector with a self-signed certificate.
+  bool ssl_verify_peer = true;
+
+  // Path of the CA certificates to verify the collector with, empty for the default bundle.
+  std::string ssl_ca_cert_path = GetOtlpDefaultSslCertificatePath();
+
+  // Resolve the collector and connect to it when the exporter is created, so that the first
+  // export resumes the TLS session rather than waiting for a full handshake.
+  bool prewarm = false;
 };
 
 /**
@@ -89,12 +139,20 @@ class OtlpHttpLogExporter final : public opentelemetry::sdk::logs::LogExporter
    */
   bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
 
+  /**
+   * Returns the counters of the retries of the failed exports.
+   */
+  OtlpRetryStatistics GetRetryStatistics() const noexcept;
+
 private:
   // Configuration options for the exporter
   const OtlpHttpLogExporterOptions options_;
 
   // Object that stores the HTTP sessions that have been created
   std::unique_ptr<OtlpHttpClient> http_client_;
+
+  // The protos of the resources and instrumentation libraries of the exported logs.
+  OtlpProtoCache proto_cache_;
   // For testing
   friend class OtlpHttpLogExporterTestPeer;
   /**
@@ -14,6 +14,8 @@
 #  include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
 // clang-format on
 
+#  include <memory>
+
 #  include "opentelemetry/sdk/common/attribute_utils.h"
 #  include "opentelemetry/sdk/logs/recordable.h"
 
@@ -29,10 +31,19 @@ namespace otlp
 class OtlpLogRecordable final : public opentelemetry::sdk::logs::Recordable
 {
 public:
+  OtlpLogRecordable() : log_record_(new proto::logs::v1::LogRecord) {}
+
   virtual ~OtlpLogRecordable() = default;
 
-  proto::logs::v1::LogRecord &log_record() noexcept { return log_record_; }
-  const proto::logs::v1::LogRecord &log_record() const noexcept { return log_record_; }
+  proto::logs::v1::LogRecord &log_record() noexcept { return *log_record_; }
+  const proto::logs::v1::LogRecord &log_record() const noexcept { return *log_record_; }
+
+  /**
+   * Releases the log record proto, so that an export request can adopt it instead of
+   * copying it. The recordable must not be used afterwards, except for its resource and
+   * instrumentation library.
+   */
+  proto::logs::v1::LogRecord *ReleaseLogRecord() noexcept { return log_record_.release(); }
 
   /** Dynamically converts the resource of this log into a proto. */
   proto::resource::v1::Resource ProtoResource() const noexcept;
@@ -102,8 +113,25 @@ class OtlpLogRecordable final : public opentelemetry::sdk::logs::Recordable
   const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary &
   GetInstrumentationLibrary() const noexcept;
 
+  /** Returns the exact size of the log record proto. */
+  size_t GetEstimatedSize() const noexcept override
+  {
+    return log_record_ != nullptr ? log_record_->ByteSizeLong() : 0;
+  }
+
+  /** Appends the log record proto, without its resource and instrumentation library. */
+  opentelemetry::sdk::common::JournalRecordType AppendJournalRecord(
+      std::string &out) const noexcept override
+  {
+    if (log_record_ == nullptr || !log_record_->AppendToString(&out))
+    {
+      return opentelemetry::sdk::common::JournalRecordType::kNone;
+    }
+    return opentelemetry::sdk::common::JournalRecordType::kOtlpLogRecord;
+  }
+
 private:
-  proto::logs::v1::LogRecord log_record_;
+  std::unique_ptr<proto::logs::v1::LogRecord> log_record_;
   const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
   // TODO shared resource
   // const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
@@ -0,0 +1,74 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#include "opentelemetry/proto/common/v1/common.pb.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+#include "opentelemetry/sdk/common/attribute_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * Keeps the KeyValue protos of the attribute sets of the metric points from one collection to
+ * the next, keyed by the hash of the attribute set, so that the attributes of a series are only
+ * converted the first time it is exported. An attribute set absent from a collection, e.g.
+ * because its series was evicted, is dropped at the end of that collection.
+ *
+ * It is not thread-safe: an exporter uses it for one export at a time.
+ */
+class OtlpMetricAttributesCache
+{
+public:
+  using KeyValues = google::protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>;
+
+  /**
+   * @param max_entries - The maximum number of attribute sets kept. Beyond it, the attributes of
+   * new sets are converted at each collection.
+   */
+  explicit OtlpMetricAttributesCache(std::size_t max_entries = 65536) noexcept;
+
+  /**
+   * Appends the KeyValue protos of attributes to key_values.
+   */
+  void PopulateAttributes(const opentelemetry::sdk::common::MetricAttributeMap &attributes,
+                          KeyValues *key_values) noexcept;
+
+  /**
+   * Drops the attribute sets which were not populated since the previous call.
+   */
+  void EndCollection() noexcept;
+
+  /**
+   * Returns the number of attribute sets kept.
+   */
+  std::size_t size() const noexcept { return entries_.size(); }
+
+private:
+  struct Entry
+  {
+    opentelemetry::sdk::common::MetricAttributeMap attributes;
+    KeyValues key_values;
+    uint64_t collection = 0;
+  };
+
+  const std::size_t max_entries_;
+  uint64_t collection_ = 0;
+  std::unordered_map<size_t, Entry> entries_;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -11,8 +11,13 @@
 
 #include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
 
+#include "opentelemetry/exporters/otlp/otlp_metric_attributes_cache.h"
+#include "opentelemetry/nostd/function_ref.h"
+#include "opentelemetry/nostd/span.h"
 #include "opentelemetry/sdk/metrics/export/metric_producer.h"
 
+#include <memory>
+
 #ifndef ENABLE_METRICS_PREVIEW
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -26,6 +31,12 @@ namespace otlp
 class OtlpMetricsUtils
 {
 public:
+  using ExportMetricsServiceRequest = proto::collector::metrics::v1::ExportMetricsServiceRequest;
+
+  // Points of a metric, converted on their own when a metric is split across requests. The
+  // overloads converting them take the attributes of the points from attributes_cache when given.
+  using MetricPoints = nostd::span<const opentelemetry::sdk::metrics::PointDataAttributes>;
+
   static opentelemetry::sdk::metrics::AggregationType GetAggregationType(
       const opentelemetry::sdk::metrics::InstrumentType &instrument_type) noexcept;
 
@@ -35,13 +46,50 @@ class OtlpMetricsUtils
   static void ConvertSumMetric(const opentelemetry::sdk::metrics::MetricData &metric_data,
                                proto::metrics::v1::Sum *const sum) noexcept;
 
+  static void ConvertSumMetric(const opentelemetry::sdk::metrics::MetricData &metric_data,
+                               MetricPoints points,
+                               proto::metrics::v1::Sum *const sum,
+                               OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
+
   static void ConvertHistogramMetric(const opentelemetry::sdk::metrics::MetricData &metric_data,
                                      proto::metrics::v1::Histogram *const histogram) noexcept;
 
+  static void ConvertHistogramMetric(
+      const opentelemetry::sdk::metrics::MetricData &metric_data,
+      MetricPoints points,
+      proto::metrics::v1::Histogram *const histogram,
+      OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
+
+  static void ConvertExponentialHistogramMetric(
+      const opentelemetry::sdk::metrics::MetricData &metric_data,
+      proto::metrics::v1::ExponentialHistogram *const histogram) noexcept;
+
+  static void ConvertExponentialHistogramMetric(
+      const opentelemetry::sdk::metrics::MetricData &metric_data,
+      MetricPoints points,
+      proto::metrics::v1::ExponentialHistogram *const histogram,
+      OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
+
+  // Sketches are exported as summaries of their minimum, median, 90th, 95th and 99th percentiles
+  // and maximum.
+  static void ConvertSketchMetric(const opentelemetry::sdk::metrics::MetricData &metric_data,
+                                  proto::metrics::v1::Summary *const summary) noexcept;
+
+  static void ConvertSketchMetric(const opentelemetry::sdk::metrics::MetricData &metric_data,
+                                  MetricPoints points,
+                                  proto::metrics::v1::Summary *const summary,
+                                  OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
+
   static void PopulateInstrumentationInfoMetric(
       const opentelemetry::sdk::metrics::MetricData &metric_data,
       proto::metrics::v1::Metric *metric) noexcept;
 
+  static void PopulateInstrumentationInfoMetric(
+      const opentelemetry::sdk::metrics::MetricData &metric_data,
+      MetricPoints points,
+      proto::metrics::v1::Metric *metric,
+      OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
+
   static void PopulateResourceMetrics(
       const opentelemetry::sdk::metrics::ResourceMetrics &data,
       proto::metrics::v1::ResourceMetrics *proto_resource_metrics) noexcept;
@@ -49,6 +97,19 @@ class OtlpMetricsUtils
   static void PopulateRequest(
       const opentelemetry::sdk::metrics::ResourceMetrics &data,
       proto::collector::metrics::v1::ExportMetricsServiceRequest *request) noexcept;
+
+  /**
+   * Populates the requests of data, each with at most max_points_per_request points, and passes
+   * each to emit as soon as it is full, so that only one request is built at a time. A metric
+   * with more points is split across requests. With max_points_per_request 0, populates a single
+   * request. Stops and returns false as soon as emit returns false. The attributes of the points
+   * are taken from attributes_cache when given, see OtlpMetricAttributesCache.
+   */
+  static bool PopulateRequests(
+      const opentelemetry::sdk::metrics::ResourceMetrics &data,
+      std::size_t max_points_per_request,
+      nostd::function_ref<bool(std::unique_ptr<ExportMetricsServiceRequest> &&)> emit,
+      OtlpMetricAttributesCache *attributes_cache = nullptr) noexcept;
 };
 
 }  // namespace otlp
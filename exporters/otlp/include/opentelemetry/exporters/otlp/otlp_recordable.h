@@ -13,6 +13,8 @@
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/version.h"
 
+#include <memory>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
@@ -21,8 +23,26 @@ namespace otlp
 class OtlpRecordable final : public opentelemetry::sdk::trace::Recordable
 {
 public:
-  proto::trace::v1::Span &span() noexcept { return span_; }
-  const proto::trace::v1::Span &span() const noexcept { return span_; }
+  OtlpRecordable() : span_(new proto::trace::v1::Span) {}
+
+  proto::trace::v1::Span &span() noexcept { return *span_; }
+  const proto::trace::v1::Span &span() const noexcept { return *span_; }
+
+  /**
+   * Releases the span proto, so that an export request can adopt it instead of
+   * copying it. The recordable must not be used afterwards.
+   */
+  proto::trace::v1::Span *ReleaseSpan() noexcept { return span_.release(); }
+
+  /** Returns the resource of this span, nullptr if it was not set. */
+  const opentelemetry::sdk::resource::Resource *GetResource() const noexcept { return resource_; }
+
+  /** Returns the instrumentation library of this span, nullptr if it was not set. */
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *
+  GetInstrumentationLibrary() const noexcept
+  {
+    return instrumentation_library_;
+  }
 
   /** Dynamically converts the resource of this span into a proto. */
   proto::resource::v1::Resource ProtoResource() const noexcept;
@@ -61,8 +81,29 @@ class OtlpRecordable final : public opentelemetry::sdk::trace::Recordable
       const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
           &instrumentation_library) noexcept override;
 
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override;
+
+  /** Returns the exact size of the span proto. */
+  size_t GetEstimatedSize() const noexcept override
+  {
+    return span_ != nullptr ? span_->ByteSizeLong() : 0;
+  }
+
+  opentelemetry::sdk::trace::RecordableGroupingKey GetGroupingKey() const noexcept override;
+
+  /** Appends the span proto, without its resource and instrumentation library. */
+  opentelemetry::sdk::common::JournalRecordType AppendJournalRecord(
+      std::string &out) const noexcept override
+  {
+    if (span_ == nullptr || !span_->AppendToString(&out))
+    {
+      return opentelemetry::sdk::common::JournalRecordType::kNone;
+    }
+    return opentelemetry::sdk::common::JournalRecordType::kOtlpSpan;
+  }
+
 private:
-  proto::trace::v1::Span span_;
+  std::unique_ptr<proto::trace::v1::Span> span_;
   const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
   const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
       *instrumentation_library_ = nullptr;
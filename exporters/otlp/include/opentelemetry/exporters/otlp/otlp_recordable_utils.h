@@ -5,11 +5,16 @@
 
 #include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
 
+#include <google/protobuf/arena.h>
 #include "opentelemetry/proto/collector/logs/v1/logs_service.pb.h"
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
+#include "opentelemetry/proto/common/v1/common.pb.h"
+#include "opentelemetry/proto/resource/v1/resource.pb.h"
 
 #include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
 
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
+#include "opentelemetry/sdk/resource/resource.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 
 #ifdef ENABLE_LOGS_PREVIEW
@@ -17,26 +22,85 @@
 #endif
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
 namespace otlp
 {
+/**
+ * Caches the protos of the resources and instrumentation libraries an exporter sees, keyed by the
+ * address of the SDK objects. Those belong to a provider and do not change while it lives, so an
+ * exporter, which lives no longer than its provider, converts each of them once rather than for
+ * every batch. The returned protos stay valid as long as the cache; it is thread-safe.
+ */
+class OtlpProtoCache
+{
+public:
+  /**
+   * Returns the proto of a resource, empty for a null resource.
+   */
+  const proto::resource::v1::Resource &GetResource(
+      const opentelemetry::sdk::resource::Resource *resource) noexcept;
+
+  /**
+   * Returns the proto of an instrumentation library, empty for a null library.
+   */
+  const proto::common::v1::InstrumentationLibrary &GetInstrumentationLibrary(
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+          *instrumentation_library) noexcept;
+
+  /**
+   * Returns the proto of an instrumentation library as the scope of logs, empty for a null
+   * library.
+   */
+  const proto::common::v1::InstrumentationScope &GetInstrumentationScope(
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+          *instrumentation_library) noexcept;
+
+private:
+  std::mutex lock_;
+  std::unordered_map<const opentelemetry::sdk::resource::Resource *, proto::resource::v1::Resource>
+      resources_;
+  std::unordered_map<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *,
+                     proto::common::v1::InstrumentationLibrary>
+      instrumentation_libraries_;
+  std::unordered_map<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *,
+                     proto::common::v1::InstrumentationScope>
+      instrumentation_scopes_;
+};
+
 /**
  * The OtlpRecordableUtils contains utility functions for OTLP recordable
  */
 class OtlpRecordableUtils
 {
 public:
+  /**
+   * Returns the options of the arena on which exporters allocate their
+   * requests, so that a request and its messages are freed at once.
+   */
+  static google::protobuf::ArenaOptions GetArenaOptions() noexcept;
+
+  /**
+   * Moves the spans of the recordables into request, grouped by resource and
+   * instrumentation library. The request adopts the span protos of the
+   * recordables, and may be allocated on an arena.
+   * @param cache if not null, the resources and instrumentation libraries are
+   * copied from it rather than converted
+   */
   static void PopulateRequest(
       const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans,
-      proto::collector::trace::v1::ExportTraceServiceRequest *request) noexcept;
+      proto::collector::trace::v1::ExportTraceServiceRequest *request,
+      OtlpProtoCache *cache = nullptr) noexcept;
 
 #ifdef ENABLE_LOGS_PREVIEW
   static void PopulateRequest(
       const nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>> &logs,
-      proto::collector::logs::v1::ExportLogsServiceRequest *request) noexcept;
+      proto::collector::logs::v1::ExportLogsServiceRequest *request,
+      OtlpProtoCache *cache = nullptr) noexcept;
 #endif
 };
 }  // namespace otlp
@@ -0,0 +1,157 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * Options of the retries of the exports which failed with a transient error.
+ */
+struct OtlpRetryOptions
+{
+  // Maximum number of attempts of an export, the first one included. 1 disables retries.
+  std::size_t max_attempts = 5;
+
+  // Delay before the first retry. Each following retry waits backoff_multiplier times longer, up
+  // to max_backoff, and the delays are jittered.
+  std::chrono::milliseconds initial_backoff{1000};
+  std::chrono::milliseconds max_backoff{5000};
+  double backoff_multiplier = 1.5;
+
+  // Maximum number of exports waiting for a retry. Beyond it, the oldest one is dropped.
+  std::size_t max_queue_size = 32;
+};
+
+/**
+ * Counters of the requests and the retries of an exporter.
+ */
+struct OtlpRetryStatistics
+{
+  // Number of requests sent, retries included.
+  uint64_t requests = 0;
+
+  // Bytes of the payloads of the requests sent: as compressed by the exporter for OTLP/HTTP, and
+  // before the compression of the gRPC library for OTLP/gRPC.
+  uint64_t request_bytes = 0;
+
+  // Number of retry attempts made.
+  uint64_t retries = 0;
+
+  // Number of exports which succeeded after having been retried.
+  uint64_t recovered = 0;
+
+  // Number of exports which were given up: out of attempts, failed with a permanent error, pushed
+  // out of a full queue, or still waiting at shutdown.
+  uint64_t dropped = 0;
+
+  // Number of exports waiting for a retry.
+  uint64_t queue_size = 0;
+};
+
+enum class OtlpAttemptStatus
+{
+  kSuccess,
+  kRetryableFailure,
+  kFailure,
+};
+
+/**
+ * The outcome of one attempt of an export.
+ */
+struct OtlpAttemptResult
+{
+  OtlpAttemptStatus status = OtlpAttemptStatus::kSuccess;
+
+  // Delay requested by the server before the next attempt, with Retry-After or gRPC RetryInfo.
+  // Zero if the server did not request one.
+  std::chrono::milliseconds retry_delay{0};
+};
+
+/**
+ * Retries exports in the background, so that a collector which is briefly unavailable neither
+ * loses their data nor blocks the exporter.
+ *
+ * An exporter whose export failed with a retryable error hands the queue a function which sends
+ * the export again. The queue calls it on its own thread once the backoff has elapsed, until it
+ * succeeds, fails with a permanent error, or runs out of attempts.
+ */
+class OtlpRetryQueue
+{
+public:
+  using Attempt = std::function<OtlpAttemptResult()>;
+
+  explicit OtlpRetryQueue(const OtlpRetryOptions &options);
+
+  OtlpRetryQueue(const OtlpRetryQueue &)            = delete;
+  OtlpRetryQueue &operator=(const OtlpRetryQueue &) = delete;
+
+  ~OtlpRetryQueue();
+
+  /**
+   * Queue an export whose first attempt failed.
+   * @param attempt sends the export again, and is called from the thread of the queue.
+   * @param result the result of the first attempt.
+   * @return true if the export is queued, false if it cannot be retried and is dropped.
+   */
+  bool Enqueue(Attempt &&attempt, const OtlpAttemptResult &result) noexcept;
+
+  /**
+   * Stop retrying. The attempt in progress, if any, completes; the queued exports are dropped.
+   */
+  void Shutdown() noexcept;
+
+  OtlpRetryStatistics GetStatistics() const noexcept;
+
+  /**
+   * Returns the delay before attempt number attempt, the first retry being attempt 2.
+   */
+  std::chrono::milliseconds GetBackoff(std::size_t attempt,
+                                       const OtlpAttemptResult &result) noexcept;
+
+private:
+  struct Entry
+  {
+    Attempt attempt;
+    std::size_t attempts;
+    std::chrono::steady_clock::time_point due;
+  };
+
+  void Run() noexcept;
+
+  /* GetBackoff, with mutex_ held. */
+  std::chrono::milliseconds ComputeBackoff(std::size_t attempt,
+                                           const OtlpAttemptResult &result) noexcept;
+
+  const OtlpRetryOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+  bool is_shutdown_ = false;
+  // Entries in the order they were queued
+  std::deque<Entry> entries_;
+  std::minstd_rand random_;
+
+  OtlpRetryStatistics statistics_;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
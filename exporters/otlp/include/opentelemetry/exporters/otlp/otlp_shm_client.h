@@ -0,0 +1,61 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/exporters/otlp/otlp_shm_ring.h"
+#include "opentelemetry/sdk/common/exporter_utils.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace google
+{
+namespace protobuf
+{
+class Message;
+}
+}  // namespace google
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * Writes the OTLP requests of the shared-memory exporters to the ring they are the writer of.
+ */
+class OtlpShmClient
+{
+public:
+  explicit OtlpShmClient(const OtlpShmRingOptions &options);
+
+  /**
+   * Serialize a request into the ring, where the reader finds it as a record of type.
+   * @return kFailure if the ring is full or cannot be mapped, or if the client is shut down.
+   */
+  sdk::common::ExportResult Export(OtlpShmRecordType type,
+                                   const google::protobuf::Message &message) noexcept;
+
+  /**
+   * Unmap the ring. Its unread records stay for the reader, and later exports fail.
+   */
+  bool Shutdown() noexcept;
+
+  /**
+   * Returns the number of requests dropped because the ring was full.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  // The ring has a single writer, which exports from several threads take turns being.
+  mutable std::mutex lock_;
+  OtlpShmRing ring_;
+  bool is_open_     = false;
+  bool is_shutdown_ = false;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
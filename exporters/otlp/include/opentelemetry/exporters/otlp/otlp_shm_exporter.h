@@ -0,0 +1,67 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// We need include exporter.h first, which will include Windows.h with NOMINMAX on Windows
+#include "opentelemetry/sdk/trace/exporter.h"
+
+#include "opentelemetry/exporters/otlp/otlp_shm_client.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#include <chrono>
+#include <memory>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The OTLP shared-memory exporter hands span data in OpenTelemetry Protocol (OTLP) format over to
+ * a sidecar process, which reads the ring of OtlpShmRingOptions::path.
+ */
+class OtlpShmExporter final : public opentelemetry::sdk::trace::SpanExporter
+{
+public:
+  /**
+   * Create an OtlpShmExporter using the given options.
+   */
+  explicit OtlpShmExporter(const OtlpShmRingOptions &options);
+
+  /**
+   * Create a span recordable.
+   * @return a newly initialized Recordable object
+   */
+  std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+
+  /**
+   * Export
+   * @param spans a span of unique pointers to span recordables
+   */
+  opentelemetry::sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans) noexcept
+      override;
+
+  /**
+   * Shut down the exporter. The records it wrote stay in the ring for the reader.
+   * @param timeout ignored, as the ring is written synchronously.
+   * @return return the status of this operation
+   */
+  bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
+
+  /**
+   * Returns the number of exports dropped because the ring was full.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  OtlpShmClient shm_client_;
+
+  // The protos of the resources and instrumentation libraries of the exported spans.
+  OtlpProtoCache proto_cache_;
+};
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,68 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/sdk/logs/exporter.h"
+
+#  include "opentelemetry/exporters/otlp/otlp_shm_client.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#  include <chrono>
+#  include <memory>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The OTLP shared-memory exporter hands log data in OpenTelemetry Protocol (OTLP) format over to a
+ * sidecar process, which reads the ring of OtlpShmRingOptions::path.
+ */
+class OtlpShmLogExporter final : public opentelemetry::sdk::logs::LogExporter
+{
+public:
+  /**
+   * Create an OtlpShmLogExporter using the given options.
+   */
+  explicit OtlpShmLogExporter(const OtlpShmRingOptions &options);
+
+  /**
+   * Creates a recordable that stores the data in protobuf.
+   * @return a newly initialized Recordable object.
+   */
+  std::unique_ptr<opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
+
+  /**
+   * Exports a vector of log records to the ring.
+   * @param records A list of log records.
+   */
+  opentelemetry::sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>> &records) noexcept
+      override;
+
+  /**
+   * Shut down the exporter. The records it wrote stay in the ring for the reader.
+   * @param timeout ignored, as the ring is written synchronously.
+   * @return return the status of this operation
+   */
+  bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
+
+  /**
+   * Returns the number of exports dropped because the ring was full.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  OtlpShmClient shm_client_;
+
+  // The protos of the resources and instrumentation libraries of the exported logs.
+  OtlpProtoCache proto_cache_;
+};
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -0,0 +1,155 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * The content of a record of a shared-memory ring.
+ */
+enum class OtlpShmRecordType : uint32_t
+{
+  // Fills the end of the ring when a record does not fit before it. Skipped by readers.
+  kPadding = 0,
+  // A serialized ExportTraceServiceRequest.
+  kTraces = 1,
+  // A serialized ExportLogsServiceRequest.
+  kLogs = 2,
+};
+
+/**
+ * Options of the shared-memory ring exporters.
+ */
+struct OtlpShmRingOptions
+{
+  // File of the ring, on a memory file system shared with the reader, such as /dev/shm or a
+  // Kubernetes emptyDir volume of medium Memory. Each exporter needs its own file.
+  std::string path;
+
+  // Size of the records area of the ring, rounded down to a multiple of 8 bytes. An export larger
+  // than the free space of the ring is dropped.
+  std::size_t size = 4 * 1024 * 1024;
+};
+
+/**
+ * A single-producer, single-consumer ring of records in a memory-mapped file, handing exports
+ * over to a reader process without a copy or a system call.
+ *
+ * The file starts with a 256 bytes header, little-endian on the hosts this is used on:
+ *
+ *   offset  0  magic "OTLPSHM1", written last when the ring is initialized
+ *   offset  8  uint32 version, 1
+ *   offset 12  uint32 size of the header, 256
+ *   offset 16  uint64 size of the records area, a multiple of 8
+ *   offset 24  uint64 generation, incremented each time the writer initializes the ring
+ *   offset 64  atomic uint64 write index, only stored by the writer
+ *   offset 128 atomic uint64 read index, only stored by the reader
+ *   offset 192 atomic uint64 number of records dropped because the ring was full
+ *
+ * The indexes count bytes since the ring was initialized, and never wrap. A record starts at
+ * offset `256 + index % size`, 8 bytes aligned, with a uint32 length of its payload and a uint32
+ * OtlpShmRecordType, followed by the payload and padded to 8 bytes. A record never wraps around:
+ * when one does not fit before the end of the ring, a kPadding record fills the end.
+ *
+ * The writer stores the write index with release semantics once a record is complete, and only
+ * overwrites bytes below the read index plus size. A reader thus:
+ *   1. waits for the magic, checks the version and header size, and remembers the generation,
+ *   2. loads the write index with acquire semantics, and reads the records below it,
+ *   3. stores the read index past the records it consumed with release semantics,
+ *   4. starts over at 1 if the generation changed, as the writer initialized the ring again.
+ *
+ * Shared-memory rings are only supported on POSIX systems; elsewhere OpenWriter() and OpenReader()
+ * fail.
+ */
+class OtlpShmRing
+{
+public:
+  static constexpr std::size_t kHeaderSize       = 256;
+  static constexpr std::size_t kRecordHeaderSize = 8;
+
+  OtlpShmRing() = default;
+
+  OtlpShmRing(const OtlpShmRing &)            = delete;
+  OtlpShmRing &operator=(const OtlpShmRing &) = delete;
+
+  ~OtlpShmRing();
+
+  /**
+   * Map the ring of options.path as its writer, creating or resizing the file as needed. An
+   * existing ring of the same size is kept along with its unread records, others are initialized.
+   * @return false if the file cannot be mapped.
+   */
+  bool OpenWriter(const OtlpShmRingOptions &options) noexcept;
+
+  /**
+   * Map the ring of path as its reader.
+   * @return false if the file cannot be mapped, or is not an initialized ring.
+   */
+  bool OpenReader(const std::string &path) noexcept;
+
+  /**
+   * Reserve size bytes of payload at the write index, to be filled before Commit(). Only one
+   * record can be reserved at a time.
+   * @return nullptr, after counting a dropped record, if the ring has no room for the record.
+   */
+  uint8_t *Reserve(std::size_t size) noexcept;
+
+  /**
+   * Publish the record reserved last, of size bytes at most, to the reader.
+   */
+  void Commit(OtlpShmRecordType type, std::size_t size) noexcept;
+
+  /**
+   * Point payload at the oldest unread record, which stays valid until Pop().
+   * @return false if there is no record.
+   */
+  bool Front(OtlpShmRecordType &type, nostd::span<const uint8_t> &payload) noexcept;
+
+  /**
+   * Release the oldest unread record to the writer.
+   */
+  void Pop() noexcept;
+
+  /**
+   * Returns the number of records dropped because the ring was full.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  struct Header;
+
+  bool Map(const std::string &path, std::size_t file_size, bool create) noexcept;
+
+  void Unmap() noexcept;
+
+  Header *header_       = nullptr;
+  uint8_t *records_     = nullptr;
+  std::size_t size_     = 0;
+  std::size_t map_size_ = 0;
+
+  // Index of the next record, cached from the shared header.
+  uint64_t write_index_ = 0;
+  uint64_t read_index_  = 0;
+  // Offset of the reserved record from write_index_, past the padding it may need.
+  std::size_t reserved_offset_ = 0;
+  // Size of the record returned by Front(), 0 once popped.
+  std::size_t front_size_ = 0;
+  // Generation of the ring the reader reads.
+  uint64_t generation_ = 0;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,141 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+/**
+ * When the spill file flushes its records to disk.
+ */
+enum class OtlpSpillSync
+{
+  // Leave it to the operating system. A crash of the process loses nothing, a crash of the host
+  // may lose the latest records.
+  kNever,
+  // Flush each segment once it is full.
+  kSegment,
+  // Flush each record once it is appended.
+  kAlways,
+};
+
+/**
+ * Options of the spill file, where requests wait on disk while the collector is unreachable.
+ */
+struct OtlpSpillOptions
+{
+  // Directory of the segment files, created by the application. Empty disables the spill file.
+  std::string directory;
+
+  // Size of a segment file. A request larger than this gets a segment of its own.
+  std::size_t segment_size = 8 * 1024 * 1024;
+
+  // Maximum size of the segment files together. Beyond it, the oldest segment is dropped.
+  std::size_t max_size = 256 * 1024 * 1024;
+
+  OtlpSpillSync sync = OtlpSpillSync::kSegment;
+
+  // Maximum number of spilled requests replayed by each export.
+  std::size_t max_replay_per_export = 16;
+};
+
+/**
+ * An append-only queue of records in memory-mapped segment files.
+ *
+ * Records are read back in the order they were appended. Each segment stores how far it was read,
+ * so that the records which remain after a restart are those which were not popped. A record torn
+ * by a crash, detected by its checksum, ends the segment it was written to.
+ *
+ * Spill files are only supported on POSIX systems; elsewhere Open() fails.
+ */
+class OtlpSpillFile
+{
+public:
+  explicit OtlpSpillFile(const OtlpSpillOptions &options);
+
+  OtlpSpillFile(const OtlpSpillFile &)            = delete;
+  OtlpSpillFile &operator=(const OtlpSpillFile &) = delete;
+
+  ~OtlpSpillFile();
+
+  /**
+   * Open the segments left in the directory, and recover their records.
+   * @return false if the directory cannot be used.
+   */
+  bool Open() noexcept;
+
+  /**
+   * Append a record made of the concatenation of parts.
+   * @return false if the record could not be written.
+   */
+  bool Append(const std::vector<nostd::span<const uint8_t>> &parts) noexcept;
+
+  /**
+   * Copy the oldest record into record.
+   * @return false if there is no record.
+   */
+  bool Front(std::vector<uint8_t> &record) noexcept;
+
+  /**
+   * Remove the oldest record, and the segment which it ends.
+   */
+  void Pop() noexcept;
+
+  bool Empty() const noexcept;
+
+  /**
+   * Returns the number of records dropped because the segments went over max_size.
+   */
+  uint64_t GetDroppedCount() const noexcept;
+
+private:
+  struct Segment
+  {
+    uint64_t sequence;
+    int fd;
+    uint8_t *data;
+    std::size_t size;
+    std::size_t read_offset;
+    std::size_t write_offset;
+    std::size_t records;
+  };
+
+  std::string GetPath(uint64_t sequence) const;
+
+  /* Maps the segment file of sequence, creating it with size bytes if create is true. */
+  bool MapSegment(uint64_t sequence, std::size_t size, bool create, Segment &segment) noexcept;
+
+  /* Scans the records of a segment which was just mapped. */
+  void RecoverSegment(Segment &segment) noexcept;
+
+  void CloseSegment(Segment &segment, bool remove) noexcept;
+
+  void Sync(const Segment &segment, std::size_t offset, std::size_t length) noexcept;
+
+  const OtlpSpillOptions options_;
+
+  mutable std::mutex mutex_;
+  // Segments from the oldest to the one appended to
+  std::deque<Segment> segments_;
+  std::size_t total_size_ = 0;
+  uint64_t next_sequence_ = 0;
+  uint64_t dropped_       = 0;
+};
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,128 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_file_client.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#include <google/protobuf/message.h>
+
+#include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+#include <cstring>
+
+#include <zlib.h>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+namespace
+{
+
+OtlpSpillOptions MakeSpillOptions(const OtlpFileExporterOptions &options)
+{
+  OtlpSpillOptions spill;
+  spill.directory    = options.directory;
+  spill.segment_size = options.segment_size;
+  spill.max_size     = options.max_size;
+  spill.sync         = options.sync;
+  return spill;
+}
+
+/**
+ * Compresses body with gzip into output, which keeps its capacity from call to call. Returns false
+ * if compression fails or does not make the body smaller.
+ */
+bool GzipBody(const std::vector<uint8_t> &body, int level, std::vector<uint8_t> &output)
+{
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, level < 0 ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  output.resize(deflateBound(&stream, static_cast<uLong>(body.size())));
+  stream.next_in   = const_cast<Bytef *>(body.data());
+  stream.avail_in  = static_cast<uInt>(body.size());
+  stream.next_out  = output.data();
+  stream.avail_out = static_cast<uInt>(output.size());
+  const int result = deflate(&stream, Z_FINISH);
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  return result == Z_STREAM_END && output.size() < body.size();
+}
+
+}  // namespace
+
+OtlpFileClient::OtlpFileClient(const OtlpFileExporterOptions &options)
+    : options_(options), file_(new OtlpSpillFile(MakeSpillOptions(options)))
+{
+  if (options_.directory.empty() || !file_->Open())
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP FILE Client] Cannot write to directory \""
+                            << options_.directory << "\", exports will fail");
+    file_.reset();
+  }
+}
+
+sdk::common::ExportResult OtlpFileClient::Export(const google::protobuf::Message &message) noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  if (is_shutdown_ || file_ == nullptr)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP FILE Client] Export failed, "
+                            << (is_shutdown_ ? "the exporter is shut down"
+                                             : "the segment files cannot be written"));
+    return sdk::common::ExportResult::kFailure;
+  }
+
+  body_.resize(message.ByteSizeLong());
+  if (!body_.empty() && !message.SerializeWithCachedSizesToArray(
+                            reinterpret_cast<google::protobuf::uint8 *>(body_.data())))
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP FILE Client] Serialization of the request failed");
+    return sdk::common::ExportResult::kFailure;
+  }
+
+  const std::vector<uint8_t> *record = &body_;
+  if (options_.compression == "gzip" && body_.size() >= options_.compression_min_size &&
+      GzipBody(body_, options_.compression_level, compressed_body_))
+  {
+    record = &compressed_body_;
+  }
+
+  if (!file_->Append({nostd::span<const uint8_t>(record->data(), record->size())}))
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP FILE Client] Writing " << record->size()
+                                                          << " bytes to the segment files failed");
+    return sdk::common::ExportResult::kFailure;
+  }
+  return sdk::common::ExportResult::kSuccess;
+}
+
+bool OtlpFileClient::Shutdown() noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  is_shutdown_ = true;
+  // Unmaps the segments, which flushes them to the files.
+  file_.reset();
+  return true;
+}
+
+uint64_t OtlpFileClient::GetDroppedCount() const noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return file_ != nullptr ? file_->GetDroppedCount() : 0;
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,62 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/exporters/otlp/otlp_file_log_exporter.h"
+#  include "opentelemetry/exporters/otlp/otlp_log_recordable.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#  include "opentelemetry/proto/collector/logs/v1/logs_service.pb.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+namespace nostd = opentelemetry::nostd;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+OtlpFileLogExporter::OtlpFileLogExporter(const OtlpFileExporterOptions &options)
+    : file_client_(options)
+{}
+
+std::unique_ptr<opentelemetry::sdk::logs::Recordable> OtlpFileLogExporter::MakeRecordable() noexcept
+{
+  return std::unique_ptr<opentelemetry::sdk::logs::Recordable>(
+      new exporter::otlp::OtlpLogRecordable());
+}
+
+opentelemetry::sdk::common::ExportResult OtlpFileLogExporter::Export(
+    const nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>> &logs) noexcept
+{
+  if (logs.empty())
+  {
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto service_request = google::protobuf::Arena::CreateMessage<
+      proto::collector::logs::v1::ExportLogsServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(logs, service_request, &proto_cache_);
+  return file_client_.Export(*service_request);
+}
+
+bool OtlpFileLogExporter::Shutdown(std::chrono::microseconds) noexcept
+{
+  return file_client_.Shutdown();
+}
+
+uint64_t OtlpFileLogExporter::GetDroppedCount() const noexcept
+{
+  return file_client_.GetDroppedCount();
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+
+#endif
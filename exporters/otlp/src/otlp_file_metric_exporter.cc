@@ -0,0 +1,57 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+
+#  include "opentelemetry/exporters/otlp/otlp_file_metric_exporter.h"
+#  include "opentelemetry/exporters/otlp/otlp_metrics_utils.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#  include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+OtlpFileMetricsExporter::OtlpFileMetricsExporter(const OtlpFileExporterOptions &options)
+    : file_client_(options)
+{}
+
+opentelemetry::sdk::common::ExportResult OtlpFileMetricsExporter::Export(
+    const opentelemetry::sdk::metrics::ResourceMetrics &data) noexcept
+{
+  if (data.instrumentation_info_metric_data_.empty())
+  {
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+  proto::collector::metrics::v1::ExportMetricsServiceRequest request;
+  OtlpMetricsUtils::PopulateRequest(data, &request);
+  return file_client_.Export(request);
+}
+
+bool OtlpFileMetricsExporter::ForceFlush(std::chrono::microseconds) noexcept
+{
+  // Exports are written to the files synchronously.
+  return true;
+}
+
+bool OtlpFileMetricsExporter::Shutdown(std::chrono::microseconds) noexcept
+{
+  return file_client_.Shutdown();
+}
+
+uint64_t OtlpFileMetricsExporter::GetDroppedCount() const noexcept
+{
+  return file_client_.GetDroppedCount();
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+
+#endif
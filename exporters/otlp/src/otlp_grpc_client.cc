@@ -0,0 +1,94 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_grpc_client.h"
+
+#include "opentelemetry/ext/http/common/url_parser.h"
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+#include <grpcpp/grpcpp.h>
+#include <fstream>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+namespace
+{
+std::string get_file_contents(const char *fpath)
+{
+  std::ifstream finstream(fpath);
+  std::string contents;
+  contents.assign((std::istreambuf_iterator<char>(finstream)), std::istreambuf_iterator<char>());
+  finstream.close();
+  return contents;
+}
+}  // namespace
+
+std::shared_ptr<grpc::Channel> OtlpGrpcClient::MakeChannel(const OtlpGrpcExporterOptions &options,
+                                                           std::size_t channel_index)
+{
+  //
+  // Scheme is allowed in OTLP endpoint definition, but is not allowed for creating gRPC channel.
+  // Passing URI with scheme to grpc::CreateChannel could resolve the endpoint to some unexpected
+  // address.
+  //
+
+  ext::http::common::UrlParser url(options.endpoint);
+  if (!url.success_)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP Exporter] invalid endpoint: " << options.endpoint);
+
+    return nullptr;
+  }
+
+  // gRPC connects to unix:<socket path> targets through the Unix domain socket.
+  std::string grpc_target;
+  if (!url.unix_socket_path_.empty())
+  {
+    grpc_target = "unix:" + url.unix_socket_path_;
+  }
+  else
+  {
+    grpc_target = url.host_ + ":" + std::to_string(static_cast<int>(url.port_));
+    if (!options.load_balancing_policy.empty())
+    {
+      // Resolve all the addresses of the host, for the policy to balance the requests over.
+      grpc_target = "dns:///" + grpc_target;
+    }
+  }
+
+  grpc::ChannelArguments args;
+  if (!options.load_balancing_policy.empty())
+  {
+    args.SetLoadBalancingPolicyName(options.load_balancing_policy);
+  }
+  if (options.channel_pool_size > 1)
+  {
+    // Channels with the same arguments share their connections through the global subchannel
+    // pool: give each channel of the pool its own connections.
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    args.SetInt("grpc.opentelemetry.channel_index", static_cast<int>(channel_index));
+  }
+
+  if (options.use_ssl_credentials)
+  {
+    grpc::SslCredentialsOptions ssl_opts;
+    if (options.ssl_credentials_cacert_path.empty())
+    {
+      ssl_opts.pem_root_certs = options.ssl_credentials_cacert_as_string;
+    }
+    else
+    {
+      ssl_opts.pem_root_certs = get_file_contents((options.ssl_credentials_cacert_path).c_str());
+    }
+    return grpc::CreateCustomChannel(grpc_target, grpc::SslCredentials(ssl_opts), args);
+  }
+  return grpc::CreateCustomChannel(grpc_target, grpc::InsecureChannelCredentials(), args);
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -5,11 +5,18 @@
 #include <mutex>
 #include "opentelemetry/exporters/otlp/otlp_recordable.h"
 #include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
-#include "opentelemetry/ext/http/common/url_parser.h"
+#include "opentelemetry/sdk/common/thread_options.h"
 #include "opentelemetry/sdk_config.h"
 
+#include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
 #include <grpcpp/grpcpp.h>
-#include <fstream>
+#include <algorithm>
 #include <sstream>  // std::stringstream
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -18,84 +25,178 @@ namespace exporter
 namespace otlp
 {
 
-// ----------------------------- Helper functions ------------------------------
-static std::string get_file_contents(const char *fpath)
+namespace
 {
-  std::ifstream finstream(fpath);
-  std::string contents;
-  contents.assign((std::istreambuf_iterator<char>(finstream)), std::istreambuf_iterator<char>());
-  finstream.close();
-  return contents;
-}
+using google::protobuf::internal::WireFormatLite;
 
 /**
- * Create gRPC channel from the exporter options.
+ * Calls on_field with the number and the value of each varint or length-delimited field of a
+ * serialized message. The other fields are skipped.
  */
-std::shared_ptr<grpc::Channel> MakeGrpcChannel(const OtlpGrpcExporterOptions &options)
+bool ParseFields(const std::string &message,
+                 const std::function<void(uint32_t, uint64_t, const std::string &)> &on_field)
 {
-  std::shared_ptr<grpc::Channel> channel;
-
-  //
-  // Scheme is allowed in OTLP endpoint definition, but is not allowed for creating gRPC channel.
-  // Passing URI with scheme to grpc::CreateChannel could resolve the endpoint to some unexpected
-  // address.
-  //
-
-  ext::http::common::UrlParser url(options.endpoint);
-  if (!url.success_)
+  google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t *>(message.data()),
+                                               static_cast<int>(message.size()));
+  while (uint32_t tag = input.ReadTag())
   {
-    OTEL_INTERNAL_LOG_ERROR("[OTLP Exporter] invalid endpoint: " << options.endpoint);
-
-    return nullptr;
+    uint32_t number = WireFormatLite::GetTagFieldNumber(tag);
+    switch (WireFormatLite::GetTagWireType(tag))
+    {
+      case WireFormatLite::WIRETYPE_VARINT: {
+        uint64_t value = 0;
+        if (!input.ReadVarint64(&value))
+        {
+          return false;
+        }
+        on_field(number, value, std::string());
+        break;
+      }
+      case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+        uint32_t length = 0;
+        std::string bytes;
+        if (!input.ReadVarint32(&length) || !input.ReadString(&bytes, static_cast<int>(length)))
+        {
+          return false;
+        }
+        on_field(number, 0, bytes);
+        break;
+      }
+      default:
+        if (!WireFormatLite::SkipField(&input, tag))
+        {
+          return false;
+        }
+        break;
+    }
   }
+  return true;
+}
 
-  std::string grpc_target = url.host_ + ":" + std::to_string(static_cast<int>(url.port_));
+/**
+ * Returns the retry_delay (1) of a serialized google.rpc.RetryInfo, a Duration of seconds (1) and
+ * nanos (2).
+ */
+std::chrono::milliseconds ParseRetryDelay(const std::string &retry_info)
+{
+  int64_t seconds = 0;
+  int64_t nanos   = 0;
+  ParseFields(retry_info, [&](uint32_t number, uint64_t, const std::string &retry_delay) {
+    if (number != 1)
+    {
+      return;
+    }
+    ParseFields(retry_delay, [&](uint32_t field, uint64_t value, const std::string &) {
+      if (field == 1)
+      {
+        seconds = static_cast<int64_t>(value);
+      }
+      else if (field == 2)
+      {
+        nanos = static_cast<int32_t>(value);
+      }
+    });
+  });
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds(seconds) +
+                                                               std::chrono::nanoseconds(nanos));
+}
 
-  if (options.use_ssl_credentials)
-  {
-    grpc::SslCredentialsOptions ssl_opts;
-    if (options.ssl_credentials_cacert_path.empty())
+/**
+ * Finds the google.rpc.RetryInfo detail of a status, without depending on the generated code of
+ * google/rpc: error_details is a serialized google.rpc.Status, whose details (3) are Any messages
+ * of a type_url (1) and a value (2).
+ */
+bool GetRetryInfo(const grpc::Status &status, std::chrono::milliseconds &retry_delay)
+{
+  bool has_retry_info = false;
+  ParseFields(status.error_details(), [&](uint32_t number, uint64_t, const std::string &detail) {
+    if (number != 3)
     {
-      ssl_opts.pem_root_certs = options.ssl_credentials_cacert_as_string;
+      return;
     }
-    else
+    std::string type_url;
+    std::string value;
+    ParseFields(detail, [&](uint32_t field, uint64_t, const std::string &bytes) {
+      if (field == 1)
+      {
+        type_url = bytes;
+      }
+      else if (field == 2)
+      {
+        value = bytes;
+      }
+    });
+    if (type_url == "type.googleapis.com/google.rpc.RetryInfo")
     {
-      ssl_opts.pem_root_certs = get_file_contents((options.ssl_credentials_cacert_path).c_str());
+      has_retry_info = true;
+      retry_delay    = ParseRetryDelay(value);
     }
-    channel = grpc::CreateChannel(grpc_target, grpc::SslCredentials(ssl_opts));
-  }
-  else
-  {
-    channel = grpc::CreateChannel(grpc_target, grpc::InsecureChannelCredentials());
-  }
-
-  return channel;
+  });
+  return has_retry_info;
 }
 
 /**
- * Create service stub to communicate with the OpenTelemetry Collector.
+ * Classifies a status as in the OTLP specification: the transient codes are retryable, and
+ * RESOURCE_EXHAUSTED is only when the server tells when to retry.
  */
-std::unique_ptr<proto::collector::trace::v1::TraceService::Stub> MakeTraceServiceStub(
-    const OtlpGrpcExporterOptions &options)
+OtlpAttemptResult GetAttemptResult(const grpc::Status &status)
 {
-  return proto::collector::trace::v1::TraceService::NewStub(MakeGrpcChannel(options));
+  OtlpAttemptResult result;
+  switch (status.error_code())
+  {
+    case grpc::StatusCode::OK:
+      result.status = OtlpAttemptStatus::kSuccess;
+      break;
+    case grpc::StatusCode::CANCELLED:
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+    case grpc::StatusCode::ABORTED:
+    case grpc::StatusCode::OUT_OF_RANGE:
+    case grpc::StatusCode::UNAVAILABLE:
+    case grpc::StatusCode::DATA_LOSS:
+      result.status = OtlpAttemptStatus::kRetryableFailure;
+      GetRetryInfo(status, result.retry_delay);
+      break;
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+      result.status = GetRetryInfo(status, result.retry_delay)
+                          ? OtlpAttemptStatus::kRetryableFailure
+                          : OtlpAttemptStatus::kFailure;
+      break;
+    default:
+      result.status = OtlpAttemptStatus::kFailure;
+      break;
+  }
+  return result;
 }
+}  // namespace
 
 // -------------------------------- Constructors --------------------------------
 
 OtlpGrpcExporter::OtlpGrpcExporter() : OtlpGrpcExporter(OtlpGrpcExporterOptions()) {}
 
 OtlpGrpcExporter::OtlpGrpcExporter(const OtlpGrpcExporterOptions &options)
-    : options_(options), trace_service_stub_(MakeTraceServiceStub(options))
+    : options_(options), retry_queue_(options_.retry)
 {}
 
 OtlpGrpcExporter::OtlpGrpcExporter(
     std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub)
-    : options_(OtlpGrpcExporterOptions()), trace_service_stub_(std::move(stub))
-{}
+    : options_(OtlpGrpcExporterOptions()), retry_queue_(options_.retry)
+{
+  trace_service_stubs_.Add(std::move(stub));
+}
 
 // ----------------------------- Exporter methods ------------------------------
 
+proto::collector::trace::v1::TraceService::StubInterface &OtlpGrpcExporter::GetStub()
+{
+  std::call_once(trace_service_stubs_once_, [this] {
+    if (trace_service_stubs_.empty())
+    {
+      trace_service_stubs_.Create(options_);
+    }
+  });
+  return trace_service_stubs_.Next();
+}
+
 std::unique_ptr<sdk::trace::Recordable> OtlpGrpcExporter::MakeRecordable() noexcept
 {
   return std::unique_ptr<sdk::trace::Recordable>(new OtlpRecordable);
@@ -115,11 +216,167 @@ sdk::common::ExportResult OtlpGrpcExporter::Export(
     return sdk::common::ExportResult::kSuccess;
   }
 
-  proto::collector::trace::v1::ExportTraceServiceRequest request;
-  OtlpRecordableUtils::PopulateRequest(spans, &request);
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto request = google::protobuf::Arena::CreateMessage<
+      proto::collector::trace::v1::ExportTraceServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(spans, request, &proto_cache_);
 
   grpc::ClientContext context;
   proto::collector::trace::v1::ExportTraceServiceResponse response;
+  PrepareContext(context, request->ByteSizeLong());
+
+  grpc::Status status = GetStub().Export(&context, *request, &response);
+
+  if (!status.ok())
+  {
+
+    OTEL_INTERNAL_LOG_ERROR(
+        "[OTLP TRACE GRPC Exporter] Export() failed: " << status.error_message());
+    return RetryExport(*request, status) ? sdk::common::ExportResult::kSuccess
+                                         : sdk::common::ExportResult::kFailure;
+  }
+  return sdk::common::ExportResult::kSuccess;
+}
+
+namespace
+{
+/**
+ * An asynchronous export request, alive until its completion is polled from the completion queue.
+ */
+struct AsyncExportCall
+{
+  using Request  = proto::collector::trace::v1::ExportTraceServiceRequest;
+  using Response = proto::collector::trace::v1::ExportTraceServiceResponse;
+
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  Request *request = google::protobuf::Arena::CreateMessage<Request>(&arena);
+  grpc::ClientContext context;
+  Response response;
+  grpc::Status status;
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>> reader;
+  std::function<void(sdk::common::ExportResult)> result_callback;
+};
+}  // namespace
+
+void OtlpGrpcExporter::ExportAsync(
+    const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &spans,
+    std::function<void(sdk::common::ExportResult)> &&result_callback) noexcept
+{
+  if (isShutdown())
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP gRPC] Exporting " << spans.size()
+                                                     << " span(s) failed, exporter is shutdown");
+    result_callback(sdk::common::ExportResult::kFailure);
+    return;
+  }
+  if (spans.empty())
+  {
+    result_callback(sdk::common::ExportResult::kSuccess);
+    return;
+  }
+
+  std::unique_ptr<AsyncExportCall> call(new (std::nothrow) AsyncExportCall);
+  if (call == nullptr)
+  {
+    result_callback(sdk::common::ExportResult::kFailure);
+    return;
+  }
+  OtlpRecordableUtils::PopulateRequest(spans, call->request, &proto_cache_);
+  PrepareContext(call->context, call->request->ByteSizeLong());
+  call->result_callback = std::move(result_callback);
+
+  {
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    if (completion_queue_ == nullptr)
+    {
+      completion_queue_.reset(new grpc::CompletionQueue);
+      completion_thread_ = std::thread(&OtlpGrpcExporter::PollCompletionQueue, this);
+    }
+    const std::size_t max_requests = (std::max)(options_.max_concurrent_requests, std::size_t{1});
+    async_cv_.wait(lock, [this, max_requests] { return requests_in_flight_ < max_requests; });
+    ++requests_in_flight_;
+  }
+
+  call->reader =
+      GetStub().PrepareAsyncExport(&call->context, *call->request, completion_queue_.get());
+  call->reader->StartCall();
+  // The completion queue hands the call back to PollCompletionQueue, which deletes it. It is
+  // released before the call, as the order the arguments are evaluated in is unspecified.
+  auto tag = call.release();
+  tag->reader->Finish(&tag->response, &tag->status, tag);
+}
+
+void OtlpGrpcExporter::PollCompletionQueue() noexcept
+{
+  sdk::common::ApplyThreadOptions(sdk::common::ThreadOptions(), "otel-otlp-grpc");
+  void *tag = nullptr;
+  bool ok   = false;
+  while (completion_queue_->Next(&tag, &ok))
+  {
+    std::unique_ptr<AsyncExportCall> call(static_cast<AsyncExportCall *>(tag));
+    auto result = sdk::common::ExportResult::kSuccess;
+    if (!ok || !call->status.ok())
+    {
+      OTEL_INTERNAL_LOG_ERROR(
+          "[OTLP TRACE GRPC Exporter] ExportAsync() failed: " << call->status.error_message());
+      result = ok && RetryExport(*call->request, call->status)
+                   ? sdk::common::ExportResult::kSuccess
+                   : sdk::common::ExportResult::kFailure;
+    }
+    call->result_callback(result);
+    call.reset();
+
+    {
+      std::lock_guard<std::mutex> lock(async_mutex_);
+      --requests_in_flight_;
+    }
+    async_cv_.notify_all();
+  }
+}
+
+bool OtlpGrpcExporter::RetryExport(
+    const proto::collector::trace::v1::ExportTraceServiceRequest &request,
+    const grpc::Status &status) noexcept
+{
+  OtlpAttemptResult result = GetAttemptResult(status);
+  if (result.status != OtlpAttemptStatus::kRetryableFailure || options_.retry.max_attempts < 2)
+  {
+    return false;
+  }
+
+  // The request lives in the arena of the failed call, so the retries own a copy of it.
+  std::shared_ptr<proto::collector::trace::v1::ExportTraceServiceRequest> retry_request(
+      new (std::nothrow) proto::collector::trace::v1::ExportTraceServiceRequest(request));
+  if (retry_request == nullptr)
+  {
+    return false;
+  }
+  return retry_queue_.Enqueue(
+      [this, retry_request]() {
+        if (isShutdown())
+        {
+          OtlpAttemptResult shutdown_result;
+          shutdown_result.status = OtlpAttemptStatus::kFailure;
+          return shutdown_result;
+        }
+        grpc::ClientContext context;
+        proto::collector::trace::v1::ExportTraceServiceResponse response;
+        PrepareContext(context, retry_request->ByteSizeLong());
+        return GetAttemptResult(GetStub().Export(&context, *retry_request, &response));
+      },
+      result);
+}
+
+void OtlpGrpcExporter::PrepareContext(grpc::ClientContext &context,
+                                      std::size_t request_size) noexcept
+{
+  requests_.fetch_add(1, std::memory_order_relaxed);
+  request_bytes_.fetch_add(request_size, std::memory_order_relaxed);
+
+  if (ShouldCompressOtlpGrpcRequest(options_, request_size))
+  {
+    context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
 
   if (options_.timeout.count() > 0)
   {
@@ -130,24 +387,54 @@ sdk::common::ExportResult OtlpGrpcExporter::Export(
   {
     context.AddMetadata(header.first, header.second);
   }
+}
 
-  grpc::Status status = trace_service_stub_->Export(&context, request, &response);
-
-  if (!status.ok())
+bool OtlpGrpcExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
   {
+    const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+    is_shutdown_ = true;
+  }
 
-    OTEL_INTERNAL_LOG_ERROR(
-        "[OTLP TRACE GRPC Exporter] Export() failed: " << status.error_message());
-    return sdk::common::ExportResult::kFailure;
+  // The retry in progress, if any, completes, and the requests waiting for a retry are dropped.
+  retry_queue_.Shutdown();
+
+  // Wait for the asynchronous requests in flight, then stop polling for them.
+  bool drained = true;
+  {
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    auto is_drained = [this] { return requests_in_flight_ == 0; };
+    if (timeout == std::chrono::microseconds::zero() ||
+        timeout == (std::chrono::microseconds::max)())
+    {
+      async_cv_.wait(lock, is_drained);
+    }
+    else
+    {
+      drained = async_cv_.wait_for(lock, timeout, is_drained);
+    }
+    if (!drained || completion_queue_ == nullptr)
+    {
+      return drained;
+    }
+    completion_queue_->Shutdown();
   }
-  return sdk::common::ExportResult::kSuccess;
+  completion_thread_.join();
+  completion_queue_.reset();
+  return true;
 }
 
-bool OtlpGrpcExporter::Shutdown(std::chrono::microseconds timeout) noexcept
+OtlpGrpcExporter::~OtlpGrpcExporter()
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  is_shutdown_ = true;
-  return true;
+  Shutdown();
+}
+
+OtlpRetryStatistics OtlpGrpcExporter::GetRetryStatistics() const noexcept
+{
+  OtlpRetryStatistics statistics = retry_queue_.GetStatistics();
+  statistics.requests            = requests_.load(std::memory_order_relaxed);
+  statistics.request_bytes       = request_bytes_.load(std::memory_order_relaxed);
+  return statistics;
 }
 
 bool OtlpGrpcExporter::isShutdown() const noexcept
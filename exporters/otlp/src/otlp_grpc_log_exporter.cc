@@ -18,11 +18,9 @@
 
 // clang-format on
 
-#  include "opentelemetry/ext/http/common/url_parser.h"
 #  include "opentelemetry/sdk/common/global_log_handler.h"
 
 #  include <chrono>
-#  include <fstream>
 #  include <memory>
 
 #  include <grpcpp/grpcpp.h>
@@ -33,86 +31,22 @@ namespace exporter
 namespace otlp
 {
 
-// ----------------------------- Helper functions ------------------------------
-// TODO: move exporters shared function to OTLP common library.
-static std::string get_file_contents(const char *fpath)
-{
-  std::ifstream finstream(fpath);
-  std::string contents;
-  contents.assign((std::istreambuf_iterator<char>(finstream)), std::istreambuf_iterator<char>());
-  finstream.close();
-  return contents;
-}
-
-struct OtlpGrpcExporterOptions;
-
-/**
- * Create gRPC channel from the exporter options.
- */
-static std::shared_ptr<grpc::Channel> MakeGrpcChannel(const OtlpGrpcExporterOptions &options)
-{
-  std::shared_ptr<grpc::Channel> channel;
-
-  //
-  // Scheme is allowed in OTLP endpoint definition, but is not allowed for creating gRPC channel.
-  // Passing URI with scheme to grpc::CreateChannel could resolve the endpoint to some unexpected
-  // address.
-  //
-
-  ext::http::common::UrlParser url(options.endpoint);
-  if (!url.success_)
-  {
-    OTEL_INTERNAL_LOG_ERROR("[OTLP Exporter] invalid endpoint: " << options.endpoint);
-
-    return nullptr;
-  }
-
-  std::string grpc_target = url.host_ + ":" + std::to_string(static_cast<int>(url.port_));
-
-  if (options.use_ssl_credentials)
-  {
-    grpc::SslCredentialsOptions ssl_opts;
-    if (options.ssl_credentials_cacert_path.empty())
-    {
-      ssl_opts.pem_root_certs = options.ssl_credentials_cacert_as_string;
-    }
-    else
-    {
-      ssl_opts.pem_root_certs = get_file_contents((options.ssl_credentials_cacert_path).c_str());
-    }
-    channel = grpc::CreateChannel(grpc_target, grpc::SslCredentials(ssl_opts));
-  }
-  else
-  {
-    channel = grpc::CreateChannel(grpc_target, grpc::InsecureChannelCredentials());
-  }
-
-  return channel;
-}
-
-// ----------------------------- Helper functions ------------------------------
-
-/**
- * Create log service stub to communicate with the OpenTelemetry Collector.
- */
-std::unique_ptr<::opentelemetry::proto::collector::logs::v1::LogsService::Stub> MakeLogServiceStub(
-    const OtlpGrpcExporterOptions &options)
-{
-  return proto::collector::logs::v1::LogsService::NewStub(MakeGrpcChannel(options));
-}
-
 // -------------------------------- Constructors --------------------------------
 
 OtlpGrpcLogExporter::OtlpGrpcLogExporter() : OtlpGrpcLogExporter(OtlpGrpcExporterOptions()) {}
 
 OtlpGrpcLogExporter::OtlpGrpcLogExporter(const OtlpGrpcExporterOptions &options)
-    : options_(options), log_service_stub_(MakeLogServiceStub(options))
-{}
+    : options_(options)
+{
+  log_service_stubs_.Create(options_);
+}
 
 OtlpGrpcLogExporter::OtlpGrpcLogExporter(
     std::unique_ptr<proto::collector::logs::v1::LogsService::StubInterface> stub)
-    : options_(OtlpGrpcExporterOptions()), log_service_stub_(std::move(stub))
-{}
+    : options_(OtlpGrpcExporterOptions())
+{
+  log_service_stubs_.Add(std::move(stub));
+}
 
 // ----------------------------- Exporter methods ------------------------------
 
@@ -136,12 +70,19 @@ opentelemetry::sdk::common::ExportResult OtlpGrpcLogExporter::Export(
     return sdk::common::ExportResult::kSuccess;
   }
 
-  proto::collector::logs::v1::ExportLogsServiceRequest request;
-  OtlpRecordableUtils::PopulateRequest(logs, &request);
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto request = google::protobuf::Arena::CreateMessage<
+      proto::collector::logs::v1::ExportLogsServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(logs, request, &proto_cache_);
 
   grpc::ClientContext context;
   proto::collector::logs::v1::ExportLogsServiceResponse response;
 
+  if (ShouldCompressOtlpGrpcRequest(options_, request->ByteSizeLong()))
+  {
+    context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
+
   if (options_.timeout.count() > 0)
   {
     context.set_deadline(std::chrono::system_clock::now() + options_.timeout);
@@ -151,7 +92,7 @@ opentelemetry::sdk::common::ExportResult OtlpGrpcLogExporter::Export(
   {
     context.AddMetadata(header.first, header.second);
   }
-  grpc::Status status = log_service_stub_->Export(&context, request, &response);
+  grpc::Status status = log_service_stubs_.Next().Export(&context, *request, &response);
 
   if (!status.ok())
   {
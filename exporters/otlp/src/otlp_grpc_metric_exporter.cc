@@ -7,11 +7,10 @@
 #  include "opentelemetry/exporters/otlp/otlp_metrics_utils.h"
 
 #  include <mutex>
-#  include "opentelemetry/ext/http/common/url_parser.h"
 #  include "opentelemetry/sdk_config.h"
 
 #  include <grpcpp/grpcpp.h>
-#  include <fstream>
+#  include <algorithm>
 #  include <sstream>  // std::stringstream
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -21,67 +20,44 @@ namespace otlp
 {
 
 // ----------------------------- Helper functions ------------------------------
-static std::string get_file_contents(const char *fpath)
-{
-  std::ifstream finstream(fpath);
-  std::string contents;
-  contents.assign((std::istreambuf_iterator<char>(finstream)), std::istreambuf_iterator<char>());
-  finstream.close();
-  return contents;
-}
 
 /**
- * Create gRPC channel from the exporter options.
+ * Sets the compression, deadline and metadata of the context of a request of request_size bytes.
  */
-static std::shared_ptr<grpc::Channel> MakeGrpcChannel(const OtlpGrpcMetricsExporterOptions &options)
+static void PrepareContext(const OtlpGrpcMetricsExporterOptions &options,
+                           std::size_t request_size,
+                           grpc::ClientContext *context)
 {
-  std::shared_ptr<grpc::Channel> channel;
-
-  //
-  // Scheme is allowed in OTLP endpoint definition, but is not allowed for creating gRPC channel.
-  // Passing URI with scheme to grpc::CreateChannel could resolve the endpoint to some unexpected
-  // address.
-  //
-
-  ext::http::common::UrlParser url(options.endpoint);
-  if (!url.success_)
+  if (ShouldCompressOtlpGrpcRequest(options, request_size))
   {
-    OTEL_INTERNAL_LOG_ERROR("[OTLP Exporter] invalid endpoint: " << options.endpoint);
-
-    return nullptr;
+    context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
   }
 
-  std::string grpc_target = url.host_ + ":" + std::to_string(static_cast<int>(url.port_));
-
-  if (options.use_ssl_credentials)
+  if (options.timeout.count() > 0)
   {
-    grpc::SslCredentialsOptions ssl_opts;
-    if (options.ssl_credentials_cacert_path.empty())
-    {
-      ssl_opts.pem_root_certs = options.ssl_credentials_cacert_as_string;
-    }
-    else
-    {
-      ssl_opts.pem_root_certs = get_file_contents((options.ssl_credentials_cacert_path).c_str());
-    }
-    channel = grpc::CreateChannel(grpc_target, grpc::SslCredentials(ssl_opts));
+    context->set_deadline(std::chrono::system_clock::now() + options.timeout);
   }
-  else
+
+  for (auto &header : options.metadata)
   {
-    channel = grpc::CreateChannel(grpc_target, grpc::InsecureChannelCredentials());
+    context->AddMetadata(header.first, header.second);
   }
-
-  return channel;
 }
 
 /**
- * Create metrics service stub to communicate with the OpenTelemetry Collector.
+ * A request of an export, alive until its completion is polled from the completion queue.
  */
-std::unique_ptr<::opentelemetry::proto::collector::metrics::v1::MetricsService::Stub>
-MakeMetricsServiceStub(const OtlpGrpcMetricsExporterOptions &options)
+struct MetricsExportCall
 {
-  return proto::collector::metrics::v1::MetricsService::NewStub(MakeGrpcChannel(options));
-}
+  using Request  = proto::collector::metrics::v1::ExportMetricsServiceRequest;
+  using Response = proto::collector::metrics::v1::ExportMetricsServiceResponse;
+
+  std::unique_ptr<Request> request;
+  grpc::ClientContext context;
+  Response response;
+  grpc::Status status;
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<Response>> reader;
+};
 
 // -------------------------------- Constructors --------------------------------
 
@@ -90,13 +66,18 @@ OtlpGrpcMetricsExporter::OtlpGrpcMetricsExporter()
 {}
 
 OtlpGrpcMetricsExporter::OtlpGrpcMetricsExporter(const OtlpGrpcMetricsExporterOptions &options)
-    : options_(options), metrics_service_stub_(MakeMetricsServiceStub(options))
-{}
+    : options_(options), attributes_cache_(options.max_cached_attribute_sets)
+{
+  metrics_service_stubs_.Create(options_);
+}
 
 OtlpGrpcMetricsExporter::OtlpGrpcMetricsExporter(
     std::unique_ptr<proto::collector::metrics::v1::MetricsService::StubInterface> stub)
-    : options_(OtlpGrpcMetricsExporterOptions()), metrics_service_stub_(std::move(stub))
-{}
+    : options_(OtlpGrpcMetricsExporterOptions()),
+      attributes_cache_(options_.max_cached_attribute_sets)
+{
+  metrics_service_stubs_.Add(std::move(stub));
+}
 
 // ----------------------------- Exporter methods ------------------------------
 
@@ -116,31 +97,67 @@ opentelemetry::sdk::common::ExportResult OtlpGrpcMetricsExporter::Export(
     return sdk::common::ExportResult::kSuccess;
   }
 
-  proto::collector::metrics::v1::ExportMetricsServiceRequest request;
-  OtlpMetricsUtils::PopulateRequest(data, &request);
-
-  grpc::ClientContext context;
-  proto::collector::metrics::v1::ExportMetricsServiceResponse response;
+  // Each request is sent as soon as it is serialized, while the next one is built.
+  grpc::CompletionQueue completion_queue;
+  const std::size_t max_requests = (std::max)(options_.max_concurrent_requests, std::size_t{1});
+  std::size_t requests_in_flight = 0;
+  bool success                   = true;
 
-  if (options_.timeout.count() > 0)
+  auto wait_for_request = [&]() {
+    void *tag = nullptr;
+    bool ok   = false;
+    if (!completion_queue.Next(&tag, &ok))
+    {
+      requests_in_flight = 0;
+      return;
+    }
+    std::unique_ptr<MetricsExportCall> call(static_cast<MetricsExportCall *>(tag));
+    --requests_in_flight;
+    if (!ok || !call->status.ok())
+    {
+      OTEL_INTERNAL_LOG_ERROR(
+          "[OTLP METRIC GRPC Exporter] Export() failed: " << call->status.error_message());
+      success = false;
+    }
+  };
+
+  OtlpMetricAttributesCache *attributes_cache =
+      options_.max_cached_attribute_sets > 0 ? &attributes_cache_ : nullptr;
+  bool populated = OtlpMetricsUtils::PopulateRequests(
+      data, options_.max_points_per_request,
+      [&](std::unique_ptr<MetricsExportCall::Request> &&request) {
+        std::unique_ptr<MetricsExportCall> call(new MetricsExportCall);
+        call->request = std::move(request);
+        PrepareContext(options_, call->request->ByteSizeLong(), &call->context);
+        call->reader = metrics_service_stubs_.Next().PrepareAsyncExport(
+            &call->context, *call->request, &completion_queue);
+        call->reader->StartCall();
+        call->reader->Finish(&call->response, &call->status, call.get());
+        call.release();
+        if (++requests_in_flight >= max_requests)
+        {
+          wait_for_request();
+        }
+        // Once a request failed, the collection is not exported whole anyway.
+        return success;
+      },
+      attributes_cache);
+  if (populated && attributes_cache != nullptr)
   {
-    context.set_deadline(std::chrono::system_clock::now() + options_.timeout);
+    attributes_cache->EndCollection();
   }
 
-  for (auto &header : options_.metadata)
+  while (requests_in_flight > 0)
   {
-    context.AddMetadata(header.first, header.second);
+    wait_for_request();
   }
-
-  grpc::Status status = metrics_service_stub_->Export(&context, request, &response);
-
-  if (!status.ok())
+  completion_queue.Shutdown();
+  void *tag = nullptr;
+  bool ok   = false;
+  while (completion_queue.Next(&tag, &ok))
   {
-    OTEL_INTERNAL_LOG_ERROR(
-        "[OTLP METRIC GRPC Exporter] Export() failed: " << status.error_message());
-    return sdk::common::ExportResult::kFailure;
   }
-  return opentelemetry::sdk::common::ExportResult::kSuccess;
+  return success ? sdk::common::ExportResult::kSuccess : sdk::common::ExportResult::kFailure;
 }
 
 }  // namespace otlp
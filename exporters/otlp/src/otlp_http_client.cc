@@ -3,12 +3,6 @@
 
 #include "opentelemetry/exporters/otlp/otlp_http_client.h"
 
-#if defined(HAVE_GSL)
-#  include <gsl/gsl>
-#else
-#  include <assert.h>
-#endif
-
 #include "opentelemetry/ext/http/client/http_client_factory.h"
 #include "opentelemetry/ext/http/common/url_parser.h"
 
@@ -19,7 +13,6 @@
 #include "google/protobuf/reflection.h"
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/stubs/stringpiece.h"
-#include "nlohmann/json.hpp"
 
 #if defined(GOOGLE_PROTOBUF_VERSION) && GOOGLE_PROTOBUF_VERSION >= 3007000
 #  include "google/protobuf/stubs/strutil.h"
@@ -36,10 +29,18 @@ LIBPROTOBUF_EXPORT void Base64Escape(StringPiece src, std::string *dest);
 
 #include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
 
+#include <zlib.h>
+
+#include "opentelemetry/common/hex.h"
 #include "opentelemetry/sdk/common/global_log_handler.h"
 #include "opentelemetry/sdk_config.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 #include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <mutex>
 #include <sstream>
@@ -84,7 +85,13 @@ class ResponseHandler : public http_client::EventHandler
       std::unique_lock<std::mutex> lk(mutex_);
 
       // Store the body of the request
-      body_ = std::string(response.GetBody().begin(), response.GetBody().end());
+      body_        = std::string(response.GetBody().begin(), response.GetBody().end());
+      status_code_ = response.GetStatusCode();
+      response.ForEachHeader("Retry-After", [this](opentelemetry::nostd::string_view,
+                                                   opentelemetry::nostd::string_view value) {
+        retry_after_ = ParseRetryAfter(value);
+        return false;
+      });
 
       if (console_debug_)
       {
@@ -117,6 +124,33 @@ class ResponseHandler : public http_client::EventHandler
     return response_received_;
   }
 
+  /**
+   * Returns the status code of the response
+   */
+  http_client::StatusCode GetStatusCode()
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return status_code_;
+  }
+
+  /**
+   * Returns the delay requested by the Retry-After header of the response, or zero
+   */
+  std::chrono::milliseconds GetRetryAfter()
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return retry_after_;
+  }
+
+  /**
+   * Returns whether the request was cancelled
+   */
+  bool IsCancelled()
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    return is_cancelled_;
+  }
+
   /**
    * Returns the body of the response
    */
@@ -143,6 +177,7 @@ class ResponseHandler : public http_client::EventHandler
       case http_client::SessionState::Cancelled: {
         std::unique_lock<std::mutex> lk(mutex_);
         stop_waiting_ = true;
+        is_cancelled_ = state == http_client::SessionState::Cancelled;
       }
       break;
 
@@ -250,6 +285,28 @@ class ResponseHandler : public http_client::EventHandler
   }
 
 private:
+  /**
+   * Parses a Retry-After header in delay-seconds form. HTTP dates are not supported, and yield the
+   * usual backoff.
+   */
+  static std::chrono::milliseconds ParseRetryAfter(opentelemetry::nostd::string_view value)
+  {
+    int64_t seconds = 0;
+    if (value.empty() || value.size() > 9)
+    {
+      return std::chrono::milliseconds(0);
+    }
+    for (char c : value)
+    {
+      if (c < '0' || c > '9')
+      {
+        return std::chrono::milliseconds(0);
+      }
+      seconds = seconds * 10 + (c - '0');
+    }
+    return std::chrono::seconds(seconds);
+  }
+
   // Define a condition variable and mutex
   std::condition_variable cv_;
   std::mutex mutex_;
@@ -260,6 +317,15 @@ class ResponseHandler : public http_client::EventHandler
   // Whether the response has been received
   bool response_received_ = false;
 
+  // Whether the request was cancelled
+  bool is_cancelled_ = false;
+
+  // The status code of the response
+  http_client::StatusCode status_code_ = 0;
+
+  // The delay requested by the Retry-After header of the response
+  std::chrono::milliseconds retry_after_{0};
+
   // A string to store the response body
   std::string body_ = "";
 
@@ -267,33 +333,11 @@ class ResponseHandler : public http_client::EventHandler
   bool console_debug_ = false;
 };
 
-static inline char HexEncode(unsigned char byte)
-{
-#if defined(HAVE_GSL)
-  Expects(byte <= 16);
-#else
-  assert(byte <= 16);
-#endif
-  if (byte >= 10)
-  {
-    return byte - 10 + 'a';
-  }
-  else
-  {
-    return byte + '0';
-  }
-}
-
 static std::string HexEncode(const std::string &bytes)
 {
-  std::string ret;
-  ret.reserve(bytes.size() * 2);
-  for (std::string::size_type i = 0; i < bytes.size(); ++i)
-  {
-    unsigned char byte = static_cast<unsigned char>(bytes[i]);
-    ret.push_back(HexEncode(byte >> 4));
-    ret.push_back(HexEncode(byte & 0x0f));
-  }
+  std::string ret(bytes.size() * 2, '\0');
+  opentelemetry::common::EncodeLowerHex(reinterpret_cast<const uint8_t *>(bytes.data()),
+                                        bytes.size(), &ret[0]);
   return ret;
 }
 
@@ -330,38 +374,6 @@ static std::string BytesMapping(const std::string &bytes,
   }
 }
 
-static void ConvertGenericFieldToJson(nlohmann::json &value,
-                                      const google::protobuf::Message &message,
-                                      const google::protobuf::FieldDescriptor *field_descriptor,
-                                      const OtlpHttpClientOptions &options);
-
-static void ConvertListFieldToJson(nlohmann::json &value,
-                                   const google::protobuf::Message &message,
-                                   const google::protobuf::FieldDescriptor *field_descriptor,
-                                   const OtlpHttpClientOptions &options);
-
-static void ConvertGenericMessageToJson(nlohmann::json &value,
-                                        const google::protobuf::Message &message,
-                                        const OtlpHttpClientOptions &options)
-{
-  std::vector<const google::protobuf::FieldDescriptor *> fields_with_data;
-  message.GetReflection()->ListFields(message, &fields_with_data);
-  for (std::size_t i = 0; i < fields_with_data.size(); ++i)
-  {
-    const google::protobuf::FieldDescriptor *field_descriptor = fields_with_data[i];
-    nlohmann::json &child_value = options.use_json_name ? value[field_descriptor->json_name()]
-                                                        : value[field_descriptor->name()];
-    if (field_descriptor->is_repeated())
-    {
-      ConvertListFieldToJson(child_value, message, field_descriptor, options);
-    }
-    else
-    {
-      ConvertGenericFieldToJson(child_value, message, field_descriptor, options);
-    }
-  }
-}
-
 bool SerializeToHttpBody(http_client::Body &output, const google::protobuf::Message &message)
 {
   auto body_size = message.ByteSizeLong();
@@ -374,201 +386,516 @@ bool SerializeToHttpBody(http_client::Body &output, const google::protobuf::Mess
   return true;
 }
 
-void ConvertGenericFieldToJson(nlohmann::json &value,
-                               const google::protobuf::Message &message,
-                               const google::protobuf::FieldDescriptor *field_descriptor,
-                               const OtlpHttpClientOptions &options)
+/**
+ * Compresses body with gzip into chunks of at most 64 KiB, so that a large body is not compressed
+ * into one buffer sized for the worst case. Returns false if compression fails or does not make
+ * the body smaller.
+ */
+bool GzipHttpBody(const http_client::Body &body, int level, std::vector<http_client::Body> &chunks)
 {
-  switch (field_descriptor->cpp_type())
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // 16 added to the window bits selects the gzip wrapper, which Content-Encoding: gzip expects.
+  if (deflateInit2(&stream, level < 0 ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
   {
-    case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
-      value = message.GetReflection()->GetInt32(message, field_descriptor);
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
-      // According to Protobuf specs 64-bit integer numbers in JSON-encoded payloads are encoded as
-      // decimal strings, and either numbers or strings are accepted when decoding.
-      value = std::to_string(message.GetReflection()->GetInt64(message, field_descriptor));
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
-      value = message.GetReflection()->GetUInt32(message, field_descriptor);
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: {
-      // According to Protobuf specs 64-bit integer numbers in JSON-encoded payloads are encoded as
-      // decimal strings, and either numbers or strings are accepted when decoding.
-      value = std::to_string(message.GetReflection()->GetUInt64(message, field_descriptor));
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
-      std::string empty;
-      if (field_descriptor->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+    return false;
+  }
+
+  const std::size_t chunk_size = (std::min)(
+      static_cast<std::size_t>(deflateBound(&stream, static_cast<uLong>(body.size()))),
+      std::size_t{64 * 1024});
+  stream.next_in  = const_cast<Bytef *>(body.data());
+  stream.avail_in = static_cast<uInt>(body.size());
+
+  int result = Z_OK;
+  while (result == Z_OK && stream.total_out < body.size())
+  {
+    chunks.emplace_back(chunk_size);
+    stream.next_out  = chunks.back().data();
+    stream.avail_out = static_cast<uInt>(chunk_size);
+    result           = deflate(&stream, Z_FINISH);
+    chunks.back().resize(chunk_size - stream.avail_out);
+  }
+  const std::size_t compressed_size = stream.total_out;
+  deflateEnd(&stream);
+
+  if (result != Z_STREAM_END || compressed_size >= body.size())
+  {
+    chunks.clear();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Writes the OTLP/JSON encoding of a message straight into a request body, field by field, without
+ * building a JSON document or an intermediate string first.
+ */
+class JsonBodyWriter
+{
+public:
+  JsonBodyWriter(http_client::Body &body, const OtlpHttpClientOptions &options)
+      : body_(body), options_(options)
+  {}
+
+  void WriteMessage(const google::protobuf::Message &message)
+  {
+    const google::protobuf::Reflection *reflection = message.GetReflection();
+    std::vector<const google::protobuf::FieldDescriptor *> fields_with_data;
+    reflection->ListFields(message, &fields_with_data);
+
+    WriteChar('{');
+    for (std::size_t i = 0; i < fields_with_data.size(); ++i)
+    {
+      const google::protobuf::FieldDescriptor *field_descriptor = fields_with_data[i];
+      if (i != 0)
       {
-        value = BytesMapping(
-            message.GetReflection()->GetStringReference(message, field_descriptor, &empty),
-            field_descriptor, options.json_bytes_mapping);
+        WriteChar(',');
+      }
+      WriteString(options_.use_json_name ? field_descriptor->json_name()
+                                         : field_descriptor->name());
+      WriteChar(':');
+      if (field_descriptor->is_repeated())
+      {
+        WriteChar('[');
+        const int field_size = reflection->FieldSize(message, field_descriptor);
+        for (int j = 0; j < field_size; ++j)
+        {
+          if (j != 0)
+          {
+            WriteChar(',');
+          }
+          WriteRepeatedValue(message, field_descriptor, j);
+        }
+        WriteChar(']');
       }
       else
       {
-        value = message.GetReflection()->GetStringReference(message, field_descriptor, &empty);
+        WriteValue(message, field_descriptor);
       }
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE: {
-      ConvertGenericMessageToJson(
-          value, message.GetReflection()->GetMessage(message, field_descriptor, nullptr), options);
-      break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
-      value = message.GetReflection()->GetDouble(message, field_descriptor);
-      break;
+    WriteChar('}');
+  }
+
+private:
+  void WriteValue(const google::protobuf::Message &message,
+                  const google::protobuf::FieldDescriptor *field_descriptor)
+  {
+    const google::protobuf::Reflection *reflection = message.GetReflection();
+    switch (field_descriptor->cpp_type())
+    {
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        WriteNumber("%" PRId32, reflection->GetInt32(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        // According to Protobuf specs 64-bit integer numbers in JSON-encoded payloads are encoded
+        // as decimal strings, and either numbers or strings are accepted when decoding.
+        WriteNumber("\"%" PRId64 "\"", reflection->GetInt64(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        WriteNumber("%" PRIu32, reflection->GetUInt32(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        WriteNumber("\"%" PRIu64 "\"", reflection->GetUInt64(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+        std::string scratch;
+        const std::string &value =
+            reflection->GetStringReference(message, field_descriptor, &scratch);
+        WriteStringField(value, field_descriptor);
+        break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+        WriteMessage(reflection->GetMessage(message, field_descriptor, nullptr));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+        WriteDouble(reflection->GetDouble(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+        WriteDouble(reflection->GetFloat(message, field_descriptor));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+        WriteLiteral(reflection->GetBool(message, field_descriptor) ? "true" : "false");
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+        WriteNumber("%d", reflection->GetEnumValue(message, field_descriptor));
+        break;
+      default:
+        WriteLiteral("null");
+        break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
-      value = message.GetReflection()->GetFloat(message, field_descriptor);
-      break;
+  }
+
+  void WriteRepeatedValue(const google::protobuf::Message &message,
+                          const google::protobuf::FieldDescriptor *field_descriptor,
+                          int index)
+  {
+    const google::protobuf::Reflection *reflection = message.GetReflection();
+    switch (field_descriptor->cpp_type())
+    {
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        WriteNumber("%" PRId32, reflection->GetRepeatedInt32(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        WriteNumber("\"%" PRId64 "\"",
+                    reflection->GetRepeatedInt64(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        WriteNumber("%" PRIu32, reflection->GetRepeatedUInt32(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        WriteNumber("\"%" PRIu64 "\"",
+                    reflection->GetRepeatedUInt64(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+        std::string scratch;
+        const std::string &value =
+            reflection->GetRepeatedStringReference(message, field_descriptor, index, &scratch);
+        WriteStringField(value, field_descriptor);
+        break;
+      }
+      case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+        WriteMessage(reflection->GetRepeatedMessage(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+        WriteDouble(reflection->GetRepeatedDouble(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+        WriteDouble(reflection->GetRepeatedFloat(message, field_descriptor, index));
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+        WriteLiteral(reflection->GetRepeatedBool(message, field_descriptor, index) ? "true"
+                                                                                    : "false");
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+        WriteNumber("%d", reflection->GetRepeatedEnumValue(message, field_descriptor, index));
+        break;
+      default:
+        WriteLiteral("null");
+        break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
-      value = message.GetReflection()->GetBool(message, field_descriptor);
-      break;
+  }
+
+  void WriteStringField(const std::string &value,
+                        const google::protobuf::FieldDescriptor *field_descriptor)
+  {
+    if (field_descriptor->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+    {
+      WriteString(BytesMapping(value, field_descriptor, options_.json_bytes_mapping));
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
-      value = message.GetReflection()->GetEnumValue(message, field_descriptor);
-      break;
+    else
+    {
+      WriteString(value);
     }
-    default: {
-      break;
+  }
+
+  template <typename T>
+  void WriteNumber(const char *format, T value)
+  {
+    char buffer[32];
+    int size = snprintf(buffer, sizeof(buffer), format, value);
+    if (size > 0)
+    {
+      body_.insert(body_.end(), buffer, buffer + size);
     }
   }
-}
 
-void ConvertListFieldToJson(nlohmann::json &value,
-                            const google::protobuf::Message &message,
-                            const google::protobuf::FieldDescriptor *field_descriptor,
-                            const OtlpHttpClientOptions &options)
-{
-  auto field_size = message.GetReflection()->FieldSize(message, field_descriptor);
+  void WriteDouble(double value)
+  {
+    if (!std::isfinite(value))
+    {
+      // JSON has no representation of NaN and infinities.
+      WriteLiteral("null");
+      return;
+    }
+    char buffer[32];
+    int size = snprintf(buffer, sizeof(buffer), "%.17g", value);
+    for (int i = 0; i < size; ++i)
+    {
+      // The decimal separator of the C locale may not be a dot.
+      body_.push_back(buffer[i] == ',' ? '.' : static_cast<http_client::Byte>(buffer[i]));
+    }
+  }
 
-  switch (field_descriptor->cpp_type())
+  void WriteLiteral(const char *literal)
   {
-    case google::protobuf::FieldDescriptor::CPPTYPE_INT32: {
-      for (int i = 0; i < field_size; ++i)
-      {
-        value.push_back(message.GetReflection()->GetRepeatedInt32(message, field_descriptor, i));
-      }
+    body_.insert(body_.end(), literal, literal + strlen(literal));
+  }
 
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_INT64: {
-      for (int i = 0; i < field_size; ++i)
-      {
-        // According to Protobuf specs 64-bit integer numbers in JSON-encoded payloads are encoded
-        // as decimal strings, and either numbers or strings are accepted when decoding.
-        value.push_back(std::to_string(
-            message.GetReflection()->GetRepeatedInt64(message, field_descriptor, i)));
-      }
+  void WriteChar(char c) { body_.push_back(static_cast<http_client::Byte>(c)); }
 
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32: {
-      for (int i = 0; i < field_size; ++i)
-      {
-        value.push_back(message.GetReflection()->GetRepeatedUInt32(message, field_descriptor, i));
-      }
+  /**
+   * Writes a quoted and escaped string. Invalid UTF-8 sequences are replaced by U+FFFD.
+   */
+  void WriteString(const std::string &value)
+  {
+    static const char kHexDigits[]   = "0123456789abcdef";
+    static const char kReplacement[] = "\xEF\xBF\xBD";
 
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64: {
-      for (int i = 0; i < field_size; ++i)
+    WriteChar('"');
+    const auto *data  = reinterpret_cast<const unsigned char *>(value.data());
+    const size_t size = value.size();
+    for (size_t i = 0; i < size;)
+    {
+      const unsigned char c = data[i];
+      if (c < 0x80)
       {
-        // According to Protobuf specs 64-bit integer numbers in JSON-encoded payloads are encoded
-        // as decimal strings, and either numbers or strings are accepted when decoding.
-        value.push_back(std::to_string(
-            message.GetReflection()->GetRepeatedUInt64(message, field_descriptor, i)));
+        switch (c)
+        {
+          case '"':
+            WriteLiteral("\\\"");
+            break;
+          case '\\':
+            WriteLiteral("\\\\");
+            break;
+          case '\b':
+            WriteLiteral("\\b");
+            break;
+          case '\f':
+            WriteLiteral("\\f");
+            break;
+          case '\n':
+            WriteLiteral("\\n");
+            break;
+          case '\r':
+            WriteLiteral("\\r");
+            break;
+          case '\t':
+            WriteLiteral("\\t");
+            break;
+          default:
+            if (c < 0x20)
+            {
+              WriteLiteral("\\u00");
+              WriteChar(kHexDigits[c >> 4]);
+              WriteChar(kHexDigits[c & 0x0f]);
+            }
+            else
+            {
+              WriteChar(static_cast<char>(c));
+            }
+            break;
+        }
+        ++i;
+        continue;
       }
 
-      break;
-    }
-    case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
-      std::string empty;
-      if (field_descriptor->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+      const size_t length = Utf8SequenceLength(data + i, size - i);
+      if (length == 0)
       {
-        for (int i = 0; i < field_size; ++i)
-        {
-          value.push_back(BytesMapping(message.GetReflection()->GetRepeatedStringReference(
-                                           message, field_descriptor, i, &empty),
-                                       field_descriptor, options.json_bytes_mapping));
-        }
+        body_.insert(body_.end(), kReplacement, kReplacement + 3);
+        ++i;
       }
       else
       {
-        for (int i = 0; i < field_size; ++i)
-        {
-          value.push_back(message.GetReflection()->GetRepeatedStringReference(
-              message, field_descriptor, i, &empty));
-        }
+        body_.insert(body_.end(), data + i, data + i + length);
+        i += length;
       }
-      break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE: {
-      for (int i = 0; i < field_size; ++i)
-      {
-        nlohmann::json sub_value;
-        ConvertGenericMessageToJson(
-            sub_value, message.GetReflection()->GetRepeatedMessage(message, field_descriptor, i),
-            options);
-        value.push_back(std::move(sub_value));
-      }
+    WriteChar('"');
+  }
 
-      break;
+  /**
+   * Returns the length of the valid UTF-8 sequence of at least two bytes at data, or 0 if the
+   * bytes at data are not one.
+   */
+  static size_t Utf8SequenceLength(const unsigned char *data, size_t size) noexcept
+  {
+    const unsigned char c = data[0];
+    size_t length;
+    unsigned char min_second = 0x80;
+    unsigned char max_second = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF)
+    {
+      length = 2;
+    }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+      length = 3;
+      // Reject overlong encodings and UTF-16 surrogates.
+      min_second = c == 0xE0 ? 0xA0 : 0x80;
+      max_second = c == 0xED ? 0x9F : 0xBF;
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+      length = 4;
+      // Reject overlong encodings and code points above U+10FFFF.
+      min_second = c == 0xF0 ? 0x90 : 0x80;
+      max_second = c == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+      return 0;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE: {
-      for (int i = 0; i < field_size; ++i)
-      {
-        value.push_back(message.GetReflection()->GetRepeatedDouble(message, field_descriptor, i));
-      }
 
-      break;
+    if (size < length || data[1] < min_second || data[1] > max_second)
+    {
+      return 0;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT: {
-      for (int i = 0; i < field_size; ++i)
+    for (size_t i = 2; i < length; ++i)
+    {
+      if (data[i] < 0x80 || data[i] > 0xBF)
       {
-        value.push_back(message.GetReflection()->GetRepeatedFloat(message, field_descriptor, i));
+        return 0;
       }
-
-      break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL: {
-      for (int i = 0; i < field_size; ++i)
+    return length;
+  }
+
+  http_client::Body &body_;
+  const OtlpHttpClientOptions &options_;
+};
+
+/**
+ * Serializes the message into the request body, compressed into chunks when it is worth it.
+ */
+bool MakeRequestBody(const google::protobuf::Message &message,
+                     const OtlpHttpClientOptions &options,
+                     http_client::Body &body,
+                     std::vector<http_client::Body> &chunks,
+                     std::string &content_type)
+{
+  if (options.content_type == HttpRequestContentType::kBinary)
+  {
+    if (SerializeToHttpBody(body, message))
+    {
+      if (options.console_debug)
       {
-        value.push_back(message.GetReflection()->GetRepeatedBool(message, field_descriptor, i));
+        OTEL_INTERNAL_LOG_DEBUG(
+            "[OTLP HTTP Client] Request body(Binary): " << message.Utf8DebugString());
       }
-
-      break;
     }
-    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM: {
-      for (int i = 0; i < field_size; ++i)
+    else
+    {
+      if (options.console_debug)
       {
-        value.push_back(
-            message.GetReflection()->GetRepeatedEnumValue(message, field_descriptor, i));
+        OTEL_INTERNAL_LOG_DEBUG("[OTLP HTTP Client] Serialize body failed(Binary):"
+                                << message.InitializationErrorString());
       }
-      break;
+      return false;
     }
-    default: {
-      break;
+    content_type = kHttpBinaryContentType;
+  }
+  else
+  {
+    // OTLP/JSON payloads are about twice the size of their binary encoding.
+    body.reserve(message.ByteSizeLong() * 2);
+    JsonBodyWriter(body, options).WriteMessage(message);
+    if (options.console_debug)
+    {
+      OTEL_INTERNAL_LOG_DEBUG("[OTLP HTTP Client] Request body(Json)"
+                              << std::string(body.begin(), body.end()));
     }
+    content_type = kHttpJsonContentType;
+  }
+
+  // Tiny bodies are not worth the CPU, and may even grow when compressed.
+  if (options.compression == "gzip" && body.size() >= options.compression_min_size &&
+      GzipHttpBody(body, options.compression_level, chunks))
+  {
+    // The compressed chunks are sent as they are, and the uncompressed body is freed.
+    http_client::Body().swap(body);
   }
+  return true;
+}
+
+/**
+ * Classifies the outcome of a request: throttling and unavailable gateways or collectors are
+ * transient, as are requests which got no response at all.
+ */
+OtlpAttemptStatus GetAttemptStatus(bool response_received,
+                                   bool is_cancelled,
+                                   http_client::StatusCode status_code)
+{
+  if (!response_received)
+  {
+    return is_cancelled ? OtlpAttemptStatus::kFailure : OtlpAttemptStatus::kRetryableFailure;
+  }
+  switch (status_code)
+  {
+    case 429:
+    case 502:
+    case 503:
+    case 504:
+      return OtlpAttemptStatus::kRetryableFailure;
+    default:
+      return status_code >= 400 ? OtlpAttemptStatus::kFailure : OtlpAttemptStatus::kSuccess;
+  }
+}
+
+// The last byte of a spilled request tells how its body is encoded.
+constexpr uint8_t kSpillBinaryFlag = 1;
+constexpr uint8_t kSpillGzipFlag   = 2;
+
+std::unique_ptr<OtlpSpillFile> MakeSpillFile(const OtlpSpillOptions &options)
+{
+  std::unique_ptr<OtlpSpillFile> spill_file;
+  if (!options.directory.empty())
+  {
+    spill_file.reset(new (std::nothrow) OtlpSpillFile(options));
+    if (spill_file != nullptr && !spill_file->Open())
+    {
+      spill_file.reset();
+    }
+  }
+  return spill_file;
+}
+
+bool SpillRequestBody(OtlpSpillFile &spill_file,
+                      const http_client::Body &body,
+                      const std::vector<http_client::Body> &chunks,
+                      const std::string &content_type)
+{
+  const uint8_t flags = (content_type == kHttpBinaryContentType ? kSpillBinaryFlag : 0) |
+                        (chunks.empty() ? 0 : kSpillGzipFlag);
+  std::vector<nostd::span<const uint8_t>> parts;
+  if (chunks.empty())
+  {
+    parts.emplace_back(body.data(), body.size());
+  }
+  for (const auto &chunk : chunks)
+  {
+    parts.emplace_back(chunk.data(), chunk.size());
+  }
+  parts.emplace_back(&flags, 1);
+  return spill_file.Append(parts);
+}
+
+http_client::HttpClientOptions MakeHttpClientOptions(const OtlpHttpClientOptions &options)
+{
+  http_client::HttpClientOptions http_client_options;
+  http_client_options.keep_alive               = options.keep_alive;
+  http_client_options.keep_alive_idle          = options.keep_alive_idle;
+  http_client_options.max_connections_per_host = options.max_connections_per_host;
+  http_client_options.http2                    = options.http2;
+  http_client_options.max_requests_in_flight   = options.max_requests_in_flight;
+  http_client_options.max_pending_requests     = options.max_pending_requests;
+  http_client_options.ssl_verify_peer          = options.ssl_verify_peer;
+  http_client_options.ssl_ca_cert_path         = options.ssl_ca_cert_path;
+  return http_client_options;
 }
 
 }  // namespace
 
 OtlpHttpClient::OtlpHttpClient(OtlpHttpClientOptions &&options)
-    : options_(options), http_client_(http_client::HttpClientFactory::Create())
-{}
+    : options_(options),
+      http_client_(http_client::HttpClientFactory::Create(MakeHttpClientOptions(options_))),
+      spill_file_(MakeSpillFile(options_.spill)),
+      retry_queue_(options_.retry)
+{
+  if (options_.prewarm)
+  {
+    http_client_->Prewarm(options_.url);
+  }
+}
 
 OtlpHttpClient::OtlpHttpClient(OtlpHttpClientOptions &&options,
                                std::shared_ptr<ext::http::client::HttpClient> http_client)
-    : options_(options), http_client_(http_client)
+    : options_(options),
+      http_client_(http_client),
+      spill_file_(MakeSpillFile(options_.spill)),
+      retry_queue_(options_.retry)
 {}
 
 // ----------------------------- HTTP Client methods ------------------------------
@@ -615,45 +942,79 @@ opentelemetry::sdk::common::ExportResult OtlpHttpClient::Export(
   }
 
   http_client::Body body_vec;
+  std::vector<http_client::Body> compressed_chunks;
   std::string content_type;
-  if (options_.content_type == HttpRequestContentType::kBinary)
+  if (!MakeRequestBody(message, options_, body_vec, compressed_chunks, content_type))
   {
-    if (SerializeToHttpBody(body_vec, message))
-    {
-      if (options_.console_debug)
-      {
-        OTEL_INTERNAL_LOG_DEBUG(
-            "[OTLP HTTP Client] Request body(Binary): " << message.Utf8DebugString());
-      }
-    }
-    else
-    {
-      if (options_.console_debug)
-      {
-        OTEL_INTERNAL_LOG_DEBUG("[OTLP HTTP Client] Serialize body failed(Binary):"
-                                << message.InitializationErrorString());
-      }
-      return opentelemetry::sdk::common::ExportResult::kFailure;
-    }
-    content_type = kHttpBinaryContentType;
+    return opentelemetry::sdk::common::ExportResult::kFailure;
   }
-  else
+
+  // While older requests wait in the spill file, newer ones queue behind them to keep the order.
+  if (spill_file_ != nullptr && !spill_file_->Empty())
   {
-    nlohmann::json json_request;
+    bool is_spilled = SpillRequestBody(*spill_file_, body_vec, compressed_chunks, content_type);
+    ReplaySpillFile();
+    return is_spilled ? opentelemetry::sdk::common::ExportResult::kSuccess
+                      : opentelemetry::sdk::common::ExportResult::kFailure;
+  }
 
-    // Convert from proto into json object
-    ConvertGenericMessageToJson(json_request, message, options_);
+  OtlpAttemptResult result =
+      SendRequestBody(std::move(body_vec), std::move(compressed_chunks), content_type);
+  if (result.status == OtlpAttemptStatus::kSuccess)
+  {
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+  if (result.status == OtlpAttemptStatus::kRetryableFailure && spill_file_ != nullptr)
+  {
+    // The failed request took the body, so the message is serialized again to be spilled.
+    body_vec.clear();
+    compressed_chunks.clear();
+    return MakeRequestBody(message, options_, body_vec, compressed_chunks, content_type) &&
+                   SpillRequestBody(*spill_file_, body_vec, compressed_chunks, content_type)
+               ? opentelemetry::sdk::common::ExportResult::kSuccess
+               : opentelemetry::sdk::common::ExportResult::kFailure;
+  }
+  if (result.status != OtlpAttemptStatus::kRetryableFailure || options_.retry.max_attempts < 2)
+  {
+    return opentelemetry::sdk::common::ExportResult::kFailure;
+  }
 
-    std::string post_body_json =
-        json_request.dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace);
-    if (options_.console_debug)
-    {
-      OTEL_INTERNAL_LOG_DEBUG("[OTLP HTTP Client] Request body(Json)" << post_body_json);
-    }
-    body_vec.assign(post_body_json.begin(), post_body_json.end());
-    content_type = kHttpJsonContentType;
+  // The failed request took the body, so the retries serialize the message again, once, and share
+  // it between their attempts.
+  struct RetryBody
+  {
+    http_client::Body body;
+    std::vector<http_client::Body> chunks;
+    std::string content_type;
+  };
+  std::shared_ptr<RetryBody> retry_body(new (std::nothrow) RetryBody);
+  if (retry_body == nullptr ||
+      !MakeRequestBody(message, options_, retry_body->body, retry_body->chunks,
+                       retry_body->content_type))
+  {
+    return opentelemetry::sdk::common::ExportResult::kFailure;
   }
+  bool is_queued = retry_queue_.Enqueue(
+      [this, retry_body]() {
+        if (isShutdown())
+        {
+          OtlpAttemptResult shutdown_result;
+          shutdown_result.status = OtlpAttemptStatus::kFailure;
+          return shutdown_result;
+        }
+        http_client::Body body                = retry_body->body;
+        std::vector<http_client::Body> chunks = retry_body->chunks;
+        return SendRequestBody(std::move(body), std::move(chunks), retry_body->content_type);
+      },
+      result);
+  return is_queued ? opentelemetry::sdk::common::ExportResult::kSuccess
+                   : opentelemetry::sdk::common::ExportResult::kFailure;
+}
 
+OtlpAttemptResult OtlpHttpClient::SendRequestBody(http_client::Body &&body,
+                                                  std::vector<http_client::Body> &&chunks,
+                                                  const std::string &content_type) noexcept
+{
   // Send the request
   auto session = http_client_->CreateSession(options_.url);
   auto request = session->CreateRequest();
@@ -665,8 +1026,24 @@ opentelemetry::sdk::common::ExportResult OtlpHttpClient::Export(
   request->SetUri(http_uri_);
   request->SetTimeoutMs(std::chrono::duration_cast<std::chrono::milliseconds>(options_.timeout));
   request->SetMethod(http_client::Method::Post);
-  request->SetBody(body_vec);
   request->ReplaceHeader("Content-Type", content_type);
+  // The body is ignored when it was compressed into chunks.
+  uint64_t request_bytes = chunks.empty() ? body.size() : 0;
+  for (auto &chunk : chunks)
+  {
+    request_bytes += chunk.size();
+  }
+  requests_.fetch_add(1, std::memory_order_relaxed);
+  request_bytes_.fetch_add(request_bytes, std::memory_order_relaxed);
+  if (!chunks.empty())
+  {
+    request->SetBodyChunks(std::move(chunks));
+    request->ReplaceHeader("Content-Encoding", "gzip");
+  }
+  else
+  {
+    request->SetBody(body);
+  }
 
   // Send the request
   std::unique_ptr<ResponseHandler> handler(new ResponseHandler(options_.console_debug));
@@ -686,14 +1063,51 @@ opentelemetry::sdk::common::ExportResult OtlpHttpClient::Export(
   // End the session
   session->FinishSession();
 
-  // If an error occurred with the HTTP request
-  if (!write_successful)
+  OtlpAttemptResult result;
+  result.status =
+      GetAttemptStatus(write_successful, handler->IsCancelled(), handler->GetStatusCode());
+  if (result.status != OtlpAttemptStatus::kSuccess && write_successful)
   {
-    // TODO: retry logic
-    return opentelemetry::sdk::common::ExportResult::kFailure;
+    OTEL_INTERNAL_LOG_ERROR("[OTLP HTTP Client] Export failed, status code: "
+                            << handler->GetStatusCode());
+  }
+  if (result.status == OtlpAttemptStatus::kRetryableFailure)
+  {
+    result.retry_delay = handler->GetRetryAfter();
+  }
+  return result;
+}
+
+void OtlpHttpClient::ReplaySpillFile() noexcept
+{
+  // One export replays at a time, so that each spilled request is sent once.
+  std::unique_lock<std::mutex> lock(replay_mutex_, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    return;
   }
 
-  return opentelemetry::sdk::common::ExportResult::kSuccess;
+  http_client::Body record;
+  for (std::size_t i = 0; i < options_.spill.max_replay_per_export && spill_file_->Front(record);
+       ++i)
+  {
+    const uint8_t flags = record.back();
+    record.pop_back();
+    std::vector<http_client::Body> chunks;
+    if (flags & kSpillGzipFlag)
+    {
+      chunks.push_back(std::move(record));
+    }
+    OtlpAttemptResult result =
+        SendRequestBody(std::move(record), std::move(chunks),
+                        (flags & kSpillBinaryFlag) ? kHttpBinaryContentType : kHttpJsonContentType);
+    if (result.status == OtlpAttemptStatus::kRetryableFailure)
+    {
+      // Still unreachable: the request stays first in line.
+      return;
+    }
+    spill_file_->Pop();
+  }
 }
 
 bool OtlpHttpClient::Shutdown(std::chrono::microseconds) noexcept
@@ -703,13 +1117,31 @@ bool OtlpHttpClient::Shutdown(std::chrono::microseconds) noexcept
     is_shutdown_ = true;
   }
 
-  // Shutdown the session manager
+  // Shutdown the session manager, and stop retrying once the request in progress is cancelled
   http_client_->CancelAllSessions();
+  retry_queue_.Shutdown();
   http_client_->FinishAllSessions();
 
   return true;
 }
 
+OtlpRetryStatistics OtlpHttpClient::GetRetryStatistics() const noexcept
+{
+  OtlpRetryStatistics statistics = retry_queue_.GetStatistics();
+  statistics.requests            = requests_.load(std::memory_order_relaxed);
+  statistics.request_bytes       = request_bytes_.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+bool OtlpHttpClient::SerializeRequestBody(const google::protobuf::Message &message,
+                                          const OtlpHttpClientOptions &options,
+                                          http_client::Body &body,
+                                          std::vector<http_client::Body> &chunks,
+                                          std::string &content_type) noexcept
+{
+  return MakeRequestBody(message, options, body, chunks, content_type);
+}
+
 bool OtlpHttpClient::isShutdown() const noexcept
 {
   const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
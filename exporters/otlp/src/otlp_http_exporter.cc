@@ -29,7 +29,21 @@ OtlpHttpExporter::OtlpHttpExporter(const OtlpHttpExporterOptions &options)
                                                             options.use_json_name,
                                                             options.console_debug,
                                                             options.timeout,
-                                                            options.http_headers)))
+                                                            options.http_headers,
+                                                            options.compression,
+                                                            options.compression_level,
+                                                            options.compression_min_size,
+                                                            options.keep_alive,
+                                                            options.keep_alive_idle,
+                                                            options.max_connections_per_host,
+                                                            options.http2,
+                                                            options.max_requests_in_flight,
+                                                            options.max_pending_requests,
+                                                            options.retry,
+                                                            options.spill,
+                                                            options.ssl_verify_peer,
+                                                            options.ssl_ca_cert_path,
+                                                            options.prewarm)))
 {}
 
 OtlpHttpExporter::OtlpHttpExporter(std::unique_ptr<OtlpHttpClient> http_client)
@@ -51,9 +65,11 @@ opentelemetry::sdk::common::ExportResult OtlpHttpExporter::Export(
     return opentelemetry::sdk::common::ExportResult::kSuccess;
   }
 
-  proto::collector::trace::v1::ExportTraceServiceRequest service_request;
-  OtlpRecordableUtils::PopulateRequest(spans, &service_request);
-  return http_client_->Export(service_request);
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto service_request = google::protobuf::Arena::CreateMessage<
+      proto::collector::trace::v1::ExportTraceServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(spans, service_request, &proto_cache_);
+  return http_client_->Export(*service_request);
 }
 
 bool OtlpHttpExporter::Shutdown(std::chrono::microseconds timeout) noexcept
@@ -61,6 +77,11 @@ bool OtlpHttpExporter::Shutdown(std::chrono::microseconds timeout) noexcept
   return http_client_->Shutdown(timeout);
 }
 
+OtlpRetryStatistics OtlpHttpExporter::GetRetryStatistics() const noexcept
+{
+  return http_client_->GetRetryStatistics();
+}
+
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -31,7 +31,21 @@ OtlpHttpLogExporter::OtlpHttpLogExporter(const OtlpHttpLogExporterOptions &optio
                                                             options.use_json_name,
                                                             options.console_debug,
                                                             options.timeout,
-                                                            options.http_headers)))
+                                                            options.http_headers,
+                                                            options.compression,
+                                                            options.compression_level,
+                                                            options.compression_min_size,
+                                                            options.keep_alive,
+                                                            options.keep_alive_idle,
+                                                            options.max_connections_per_host,
+                                                            options.http2,
+                                                            options.max_requests_in_flight,
+                                                            options.max_pending_requests,
+                                                            options.retry,
+                                                            options.spill,
+                                                            options.ssl_verify_peer,
+                                                            options.ssl_ca_cert_path,
+                                                            options.prewarm)))
 {}
 
 OtlpHttpLogExporter::OtlpHttpLogExporter(std::unique_ptr<OtlpHttpClient> http_client)
@@ -52,9 +66,11 @@ opentelemetry::sdk::common::ExportResult OtlpHttpLogExporter::Export(
   {
     return opentelemetry::sdk::common::ExportResult::kSuccess;
   }
-  proto::collector::logs::v1::ExportLogsServiceRequest service_request;
-  OtlpRecordableUtils::PopulateRequest(logs, &service_request);
-  return http_client_->Export(service_request);
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto service_request = google::protobuf::Arena::CreateMessage<
+      proto::collector::logs::v1::ExportLogsServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(logs, service_request, &proto_cache_);
+  return http_client_->Export(*service_request);
 }
 
 bool OtlpHttpLogExporter::Shutdown(std::chrono::microseconds timeout) noexcept
@@ -62,6 +78,11 @@ bool OtlpHttpLogExporter::Shutdown(std::chrono::microseconds timeout) noexcept
   return http_client_->Shutdown(timeout);
 }
 
+OtlpRetryStatistics OtlpHttpLogExporter::GetRetryStatistics() const noexcept
+{
+  return http_client_->GetRetryStatistics();
+}
+
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,81 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_metric_attributes_cache.h"
+#include "opentelemetry/exporters/otlp/otlp_populate_attribute_utils.h"
+#include "opentelemetry/sdk/common/attributemap_hash.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+namespace
+{
+void ConvertAttributes(const opentelemetry::sdk::common::MetricAttributeMap &attributes,
+                       OtlpMetricAttributesCache::KeyValues *key_values) noexcept
+{
+  for (auto &kv_attr : attributes)
+  {
+    OtlpPopulateAttributeUtils::PopulateAttribute(key_values->Add(), kv_attr.first,
+                                                  kv_attr.second);
+  }
+}
+}  // namespace
+
+OtlpMetricAttributesCache::OtlpMetricAttributesCache(std::size_t max_entries) noexcept
+    : max_entries_(max_entries)
+{}
+
+void OtlpMetricAttributesCache::PopulateAttributes(
+    const opentelemetry::sdk::common::MetricAttributeMap &attributes,
+    KeyValues *key_values) noexcept
+{
+  if (attributes.empty())
+  {
+    return;
+  }
+
+  size_t hash = opentelemetry::sdk::common::GetHashForAttributeMap(attributes);
+  auto it     = entries_.find(hash);
+  if (it == entries_.end())
+  {
+    if (entries_.size() >= max_entries_)
+    {
+      ConvertAttributes(attributes, key_values);
+      return;
+    }
+    it                    = entries_.emplace(hash, Entry()).first;
+    it->second.attributes = attributes;
+    ConvertAttributes(attributes, &it->second.key_values);
+  }
+  else if (!(it->second.attributes == attributes))
+  {
+    // Another attribute set with the same hash keeps the entry.
+    ConvertAttributes(attributes, key_values);
+    return;
+  }
+
+  it->second.collection = collection_;
+  key_values->MergeFrom(it->second.key_values);
+}
+
+void OtlpMetricAttributesCache::EndCollection() noexcept
+{
+  for (auto it = entries_.begin(); it != entries_.end();)
+  {
+    if (it->second.collection != collection_)
+    {
+      it = entries_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  ++collection_;
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -5,6 +5,10 @@
 #include "opentelemetry/exporters/otlp/otlp_populate_attribute_utils.h"
 
 #ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/aggregation/sketch_aggregation.h"
+
+#  include <algorithm>
+#  include <limits>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 
@@ -14,6 +18,45 @@ namespace otlp
 {
 namespace metric_sdk = opentelemetry::sdk::metrics;
 
+namespace
+{
+// Quantiles of the summaries of sketches. The 0 and 1 quantiles are the exact minimum and maximum.
+constexpr double kSketchSummaryQuantiles[] = {0.0, 0.5, 0.9, 0.95, 0.99, 1.0};
+
+void PopulatePointAttributes(
+    const metric_sdk::PointAttributes &attributes,
+    google::protobuf::RepeatedPtrField<proto::common::v1::KeyValue> *key_values,
+    OtlpMetricAttributesCache *attributes_cache) noexcept
+{
+  if (attributes_cache != nullptr)
+  {
+    attributes_cache->PopulateAttributes(attributes, key_values);
+    return;
+  }
+  for (auto &kv_attr : attributes)
+  {
+    OtlpPopulateAttributeUtils::PopulateAttribute(key_values->Add(), kv_attr.first,
+                                                  kv_attr.second);
+  }
+}
+
+OtlpMetricsUtils::MetricPoints AllPoints(const metric_sdk::MetricData &metric_data) noexcept
+{
+  return OtlpMetricsUtils::MetricPoints(metric_data.point_data_attr_.data(),
+                                        metric_data.point_data_attr_.size());
+}
+
+void PopulateInstrumentationLibrary(
+    const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary &library,
+    proto::metrics::v1::InstrumentationLibraryMetrics *library_metrics) noexcept
+{
+  proto::common::v1::InstrumentationLibrary instrumentation_library;
+  instrumentation_library.set_name(library.GetName());
+  instrumentation_library.set_version(library.GetVersion());
+  *library_metrics->mutable_instrumentation_library() = instrumentation_library;
+}
+}  // namespace
+
 proto::metrics::v1::AggregationTemporality OtlpMetricsUtils::GetProtoAggregationTemporality(
     const opentelemetry::sdk::metrics::AggregationTemporality &aggregation_temporality) noexcept
 {
@@ -49,13 +92,21 @@ metric_sdk::AggregationType OtlpMetricsUtils::GetAggregationType(
 
 void OtlpMetricsUtils::ConvertSumMetric(const metric_sdk::MetricData &metric_data,
                                         proto::metrics::v1::Sum *const sum) noexcept
+{
+  ConvertSumMetric(metric_data, AllPoints(metric_data), sum);
+}
+
+void OtlpMetricsUtils::ConvertSumMetric(const metric_sdk::MetricData &metric_data,
+                                        MetricPoints points,
+                                        proto::metrics::v1::Sum *const sum,
+                                        OtlpMetricAttributesCache *attributes_cache) noexcept
 {
   sum->set_aggregation_temporality(
       GetProtoAggregationTemporality(metric_data.aggregation_temporality));
   sum->set_is_monotonic(true);
   auto start_ts = metric_data.start_ts.time_since_epoch().count();
   auto ts       = metric_data.end_ts.time_since_epoch().count();
-  for (auto &point_data_with_attributes : metric_data.point_data_attr_)
+  for (auto &point_data_with_attributes : points)
   {
     proto::metrics::v1::NumberDataPoint proto_sum_point_data;
     proto_sum_point_data.set_start_time_unix_nano(start_ts);
@@ -71,11 +122,8 @@ void OtlpMetricsUtils::ConvertSumMetric(const metric_sdk::MetricData &metric_dat
       proto_sum_point_data.set_as_double(nostd::get<double>(sum_data.value_));
     }
     // set attributes
-    for (auto &kv_attr : point_data_with_attributes.attributes)
-    {
-      OtlpPopulateAttributeUtils::PopulateAttribute(proto_sum_point_data.add_attributes(),
-                                                    kv_attr.first, kv_attr.second);
-    }
+    PopulatePointAttributes(point_data_with_attributes.attributes,
+                            proto_sum_point_data.mutable_attributes(), attributes_cache);
     *sum->add_data_points() = proto_sum_point_data;
   }
 }
@@ -83,12 +131,21 @@ void OtlpMetricsUtils::ConvertSumMetric(const metric_sdk::MetricData &metric_dat
 void OtlpMetricsUtils::ConvertHistogramMetric(
     const metric_sdk::MetricData &metric_data,
     proto::metrics::v1::Histogram *const histogram) noexcept
+{
+  ConvertHistogramMetric(metric_data, AllPoints(metric_data), histogram);
+}
+
+void OtlpMetricsUtils::ConvertHistogramMetric(
+    const metric_sdk::MetricData &metric_data,
+    MetricPoints points,
+    proto::metrics::v1::Histogram *const histogram,
+    OtlpMetricAttributesCache *attributes_cache) noexcept
 {
   histogram->set_aggregation_temporality(
       GetProtoAggregationTemporality(metric_data.aggregation_temporality));
   auto start_ts = metric_data.start_ts.time_since_epoch().count();
   auto ts       = metric_data.end_ts.time_since_epoch().count();
-  for (auto &point_data_with_attributes : metric_data.point_data_attr_)
+  for (auto &point_data_with_attributes : points)
   {
     proto::metrics::v1::HistogramDataPoint proto_histogram_point_data;
     proto_histogram_point_data.set_start_time_unix_nano(start_ts);
@@ -106,10 +163,26 @@ void OtlpMetricsUtils::ConvertHistogramMetric(
     }
     // count
     proto_histogram_point_data.set_count(histogram_data.count_);
+    // min and max
+    if (histogram_data.record_min_max_ && histogram_data.count_ != 0)
+    {
+      if (nostd::holds_alternative<long>(histogram_data.min_))
+      {
+        proto_histogram_point_data.set_min(nostd::get<long>(histogram_data.min_));
+        proto_histogram_point_data.set_max(nostd::get<long>(histogram_data.max_));
+      }
+      else
+      {
+        proto_histogram_point_data.set_min(nostd::get<double>(histogram_data.min_));
+        proto_histogram_point_data.set_max(nostd::get<double>(histogram_data.max_));
+      }
+    }
     // buckets
-    if ((nostd::holds_alternative<std::list<double>>(histogram_data.boundaries_)))
+    if ((nostd::holds_alternative<sdk::metrics::HistogramBoundaries<double>>(
+            histogram_data.boundaries_)))
     {
-      auto boundaries = nostd::get<std::list<double>>(histogram_data.boundaries_);
+      const auto &boundaries =
+          nostd::get<sdk::metrics::HistogramBoundaries<double>>(histogram_data.boundaries_);
       for (auto bound : boundaries)
       {
         proto_histogram_point_data.add_explicit_bounds(bound);
@@ -117,7 +190,8 @@ void OtlpMetricsUtils::ConvertHistogramMetric(
     }
     else
     {
-      auto boundaries = nostd::get<std::list<long>>(histogram_data.boundaries_);
+      const auto &boundaries =
+          nostd::get<sdk::metrics::HistogramBoundaries<long>>(histogram_data.boundaries_);
       for (auto bound : boundaries)
       {
         proto_histogram_point_data.add_explicit_bounds(bound);
@@ -129,35 +203,172 @@ void OtlpMetricsUtils::ConvertHistogramMetric(
       proto_histogram_point_data.add_bucket_counts(bucket_value);
     }
     // attributes
-    for (auto &kv_attr : point_data_with_attributes.attributes)
+    PopulatePointAttributes(point_data_with_attributes.attributes,
+                            proto_histogram_point_data.mutable_attributes(), attributes_cache);
+    *histogram->add_data_points() = proto_histogram_point_data;
+  }
+}
+
+void OtlpMetricsUtils::ConvertExponentialHistogramMetric(
+    const metric_sdk::MetricData &metric_data,
+    proto::metrics::v1::ExponentialHistogram *const histogram) noexcept
+{
+  ConvertExponentialHistogramMetric(metric_data, AllPoints(metric_data), histogram);
+}
+
+void OtlpMetricsUtils::ConvertExponentialHistogramMetric(
+    const metric_sdk::MetricData &metric_data,
+    MetricPoints points,
+    proto::metrics::v1::ExponentialHistogram *const histogram,
+    OtlpMetricAttributesCache *attributes_cache) noexcept
+{
+  histogram->set_aggregation_temporality(
+      GetProtoAggregationTemporality(metric_data.aggregation_temporality));
+  auto start_ts = metric_data.start_ts.time_since_epoch().count();
+  auto ts       = metric_data.end_ts.time_since_epoch().count();
+  for (auto &point_data_with_attributes : points)
+  {
+    proto::metrics::v1::ExponentialHistogramDataPoint proto_histogram_point_data;
+    proto_histogram_point_data.set_start_time_unix_nano(start_ts);
+    proto_histogram_point_data.set_time_unix_nano(ts);
+    auto &histogram_data = nostd::get<sdk::metrics::ExponentialHistogramPointData>(
+        point_data_with_attributes.point_data);
+    // sum
+    if ((nostd::holds_alternative<long>(histogram_data.sum_)))
+    {
+      proto_histogram_point_data.set_sum(nostd::get<long>(histogram_data.sum_));
+    }
+    else
+    {
+      proto_histogram_point_data.set_sum(nostd::get<double>(histogram_data.sum_));
+    }
+    // count
+    proto_histogram_point_data.set_count(histogram_data.count_);
+    // buckets
+    proto_histogram_point_data.set_scale(histogram_data.scale_);
+    proto_histogram_point_data.set_zero_count(histogram_data.zero_count_);
+    auto positive = proto_histogram_point_data.mutable_positive();
+    positive->set_offset(histogram_data.positive_buckets_.offset_);
+    for (auto bucket_value : histogram_data.positive_buckets_.counts_)
+    {
+      positive->add_bucket_counts(bucket_value);
+    }
+    auto negative = proto_histogram_point_data.mutable_negative();
+    negative->set_offset(histogram_data.negative_buckets_.offset_);
+    for (auto bucket_value : histogram_data.negative_buckets_.counts_)
     {
-      OtlpPopulateAttributeUtils::PopulateAttribute(proto_histogram_point_data.add_attributes(),
-                                                    kv_attr.first, kv_attr.second);
+      negative->add_bucket_counts(bucket_value);
     }
+    // attributes
+    PopulatePointAttributes(point_data_with_attributes.attributes,
+                            proto_histogram_point_data.mutable_attributes(), attributes_cache);
     *histogram->add_data_points() = proto_histogram_point_data;
   }
 }
 
+void OtlpMetricsUtils::ConvertSketchMetric(const metric_sdk::MetricData &metric_data,
+                                           proto::metrics::v1::Summary *const summary) noexcept
+{
+  ConvertSketchMetric(metric_data, AllPoints(metric_data), summary);
+}
+
+void OtlpMetricsUtils::ConvertSketchMetric(const metric_sdk::MetricData &metric_data,
+                                           MetricPoints points,
+                                           proto::metrics::v1::Summary *const summary,
+                                           OtlpMetricAttributesCache *attributes_cache) noexcept
+{
+  auto start_ts = metric_data.start_ts.time_since_epoch().count();
+  auto ts       = metric_data.end_ts.time_since_epoch().count();
+  for (auto &point_data_with_attributes : points)
+  {
+    proto::metrics::v1::SummaryDataPoint proto_summary_point_data;
+    proto_summary_point_data.set_start_time_unix_nano(start_ts);
+    proto_summary_point_data.set_time_unix_nano(ts);
+    auto &sketch_data =
+        nostd::get<sdk::metrics::SketchPointData>(point_data_with_attributes.point_data);
+    // sum
+    if ((nostd::holds_alternative<long>(sketch_data.sum_)))
+    {
+      proto_summary_point_data.set_sum(nostd::get<long>(sketch_data.sum_));
+    }
+    else
+    {
+      proto_summary_point_data.set_sum(nostd::get<double>(sketch_data.sum_));
+    }
+    // count
+    proto_summary_point_data.set_count(sketch_data.count_);
+    // quantiles
+    if (sketch_data.count_ > 0)
+    {
+      for (double quantile : kSketchSummaryQuantiles)
+      {
+        auto quantile_value = proto_summary_point_data.add_quantile_values();
+        quantile_value->set_quantile(quantile);
+        quantile_value->set_value(metric_sdk::SketchQuantile(sketch_data, quantile));
+      }
+    }
+    // attributes
+    PopulatePointAttributes(point_data_with_attributes.attributes,
+                            proto_summary_point_data.mutable_attributes(), attributes_cache);
+    *summary->add_data_points() = proto_summary_point_data;
+  }
+}
+
 void OtlpMetricsUtils::PopulateInstrumentationInfoMetric(
     const opentelemetry::sdk::metrics::MetricData &metric_data,
     proto::metrics::v1::Metric *metric) noexcept
+{
+  PopulateInstrumentationInfoMetric(metric_data, AllPoints(metric_data), metric);
+}
+
+void OtlpMetricsUtils::PopulateInstrumentationInfoMetric(
+    const opentelemetry::sdk::metrics::MetricData &metric_data,
+    MetricPoints points,
+    proto::metrics::v1::Metric *metric,
+    OtlpMetricAttributesCache *attributes_cache) noexcept
 {
   metric->set_name(metric_data.instrument_descriptor.name_);
   metric->set_description(metric_data.instrument_descriptor.description_);
   metric->set_unit(metric_data.instrument_descriptor.unit_);
   auto kind = GetAggregationType(metric_data.instrument_descriptor.type_);
+  // Views may aggregate histograms into exponential histograms, which only the points tell.
+  if (kind == metric_sdk::AggregationType::kHistogram && !metric_data.point_data_attr_.empty() &&
+      nostd::holds_alternative<sdk::metrics::ExponentialHistogramPointData>(
+          metric_data.point_data_attr_.front().point_data))
+  {
+    kind = metric_sdk::AggregationType::kExponentialHistogram;
+  }
+  // Views may aggregate any instrument into a sketch.
+  if (!metric_data.point_data_attr_.empty() &&
+      nostd::holds_alternative<sdk::metrics::SketchPointData>(
+          metric_data.point_data_attr_.front().point_data))
+  {
+    kind = metric_sdk::AggregationType::kSketch;
+  }
   if (kind == metric_sdk::AggregationType::kSum)
   {
     proto::metrics::v1::Sum sum;
-    ConvertSumMetric(metric_data, &sum);
+    ConvertSumMetric(metric_data, points, &sum, attributes_cache);
     *metric->mutable_sum() = sum;
   }
   else if (kind == metric_sdk::AggregationType::kHistogram)
   {
     proto::metrics::v1::Histogram histogram;
-    ConvertHistogramMetric(metric_data, &histogram);
+    ConvertHistogramMetric(metric_data, points, &histogram, attributes_cache);
     *metric->mutable_histogram() = histogram;
   }
+  else if (kind == metric_sdk::AggregationType::kExponentialHistogram)
+  {
+    proto::metrics::v1::ExponentialHistogram histogram;
+    ConvertExponentialHistogramMetric(metric_data, points, &histogram, attributes_cache);
+    *metric->mutable_exponential_histogram() = histogram;
+  }
+  else if (kind == metric_sdk::AggregationType::kSketch)
+  {
+    proto::metrics::v1::Summary summary;
+    ConvertSketchMetric(metric_data, points, &summary, attributes_cache);
+    *metric->mutable_summary() = summary;
+  }
 }
 
 void OtlpMetricsUtils::PopulateResourceMetrics(
@@ -175,11 +386,8 @@ void OtlpMetricsUtils::PopulateResourceMetrics(
       continue;
     }
     auto instrumentation_lib_metrics = resource_metrics->add_instrumentation_library_metrics();
-    proto::common::v1::InstrumentationLibrary instrumentation_library;
-    instrumentation_library.set_name(instrumentation_metrics.instrumentation_library_->GetName());
-    instrumentation_library.set_version(
-        instrumentation_metrics.instrumentation_library_->GetVersion());
-    *instrumentation_lib_metrics->mutable_instrumentation_library() = instrumentation_library;
+    PopulateInstrumentationLibrary(*instrumentation_metrics.instrumentation_library_,
+                                   instrumentation_lib_metrics);
 
     for (auto &metric_data : instrumentation_metrics.metric_data_)
     {
@@ -202,6 +410,75 @@ void OtlpMetricsUtils::PopulateRequest(
   auto resource_metrics = request->add_resource_metrics();
   PopulateResourceMetrics(data, resource_metrics);
 }
+
+bool OtlpMetricsUtils::PopulateRequests(
+    const opentelemetry::sdk::metrics::ResourceMetrics &data,
+    std::size_t max_points_per_request,
+    nostd::function_ref<bool(std::unique_ptr<ExportMetricsServiceRequest> &&)> emit,
+    OtlpMetricAttributesCache *attributes_cache) noexcept
+{
+  if (data.resource_ == nullptr)
+  {
+    return true;
+  }
+  if (max_points_per_request == 0)
+  {
+    max_points_per_request = (std::numeric_limits<std::size_t>::max)();
+  }
+
+  proto::resource::v1::Resource resource;
+  OtlpPopulateAttributeUtils::PopulateAttribute(&resource, *(data.resource_));
+
+  std::unique_ptr<ExportMetricsServiceRequest> request;
+  proto::metrics::v1::ResourceMetrics *resource_metrics = nullptr;
+  std::size_t request_points                            = 0;
+  for (auto &instrumentation_metrics : data.instrumentation_info_metric_data_)
+  {
+    if (instrumentation_metrics.instrumentation_library_ == nullptr)
+    {
+      continue;
+    }
+    proto::metrics::v1::InstrumentationLibraryMetrics *library_metrics = nullptr;
+    for (auto &metric_data : instrumentation_metrics.metric_data_)
+    {
+      // A metric with more points than fit the request goes on in the next ones.
+      MetricPoints points = AllPoints(metric_data);
+      std::size_t begin   = 0;
+      do
+      {
+        if (request == nullptr)
+        {
+          request.reset(new ExportMetricsServiceRequest);
+          resource_metrics                      = request->add_resource_metrics();
+          *resource_metrics->mutable_resource() = resource;
+          library_metrics                       = nullptr;
+        }
+        if (library_metrics == nullptr)
+        {
+          library_metrics = resource_metrics->add_instrumentation_library_metrics();
+          PopulateInstrumentationLibrary(*instrumentation_metrics.instrumentation_library_,
+                                         library_metrics);
+        }
+        std::size_t count =
+            (std::min)(points.size() - begin, max_points_per_request - request_points);
+        PopulateInstrumentationInfoMetric(metric_data, MetricPoints(points.data() + begin, count),
+                                          library_metrics->add_metrics(), attributes_cache);
+        begin += count;
+        request_points += count;
+        if (request_points == max_points_per_request)
+        {
+          if (!emit(std::move(request)))
+          {
+            return false;
+          }
+          request.reset();
+          request_points = 0;
+        }
+      } while (begin < points.size());
+    }
+  }
+  return request == nullptr || emit(std::move(request));
+}
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -17,16 +17,29 @@ namespace otlp
 void OtlpRecordable::SetIdentity(const opentelemetry::trace::SpanContext &span_context,
                                  opentelemetry::trace::SpanId parent_span_id) noexcept
 {
-  span_.set_trace_id(reinterpret_cast<const char *>(span_context.trace_id().Id().data()),
+  span_->set_trace_id(reinterpret_cast<const char *>(span_context.trace_id().Id().data()),
                      trace::TraceId::kSize);
-  span_.set_span_id(reinterpret_cast<const char *>(span_context.span_id().Id().data()),
+  span_->set_span_id(reinterpret_cast<const char *>(span_context.span_id().Id().data()),
                     trace::SpanId::kSize);
   if (parent_span_id.IsValid())
   {
-    span_.set_parent_span_id(reinterpret_cast<const char *>(parent_span_id.Id().data()),
+    span_->set_parent_span_id(reinterpret_cast<const char *>(parent_span_id.Id().data()),
                              trace::SpanId::kSize);
   }
-  span_.set_trace_state(span_context.trace_state()->ToHeader());
+  span_->set_trace_state(span_context.trace_state()->ToHeader());
+}
+
+opentelemetry::sdk::trace::RecordableGroupingKey OtlpRecordable::GetGroupingKey() const noexcept
+{
+  opentelemetry::sdk::trace::RecordableGroupingKey key;
+  key.resource                = resource_;
+  key.instrumentation_library = instrumentation_library_;
+  if (span_ != nullptr && span_->trace_id().size() == trace::TraceId::kSize)
+  {
+    key.trace_id = trace::TraceId(nostd::span<const uint8_t, trace::TraceId::kSize>(
+        reinterpret_cast<const uint8_t *>(span_->trace_id().data()), trace::TraceId::kSize));
+  }
+  return key;
 }
 
 proto::resource::v1::Resource OtlpRecordable::ProtoResource() const noexcept
@@ -82,7 +95,7 @@ void OtlpRecordable::SetResource(const sdk::resource::Resource &resource) noexce
 void OtlpRecordable::SetAttribute(nostd::string_view key,
                                   const common::AttributeValue &value) noexcept
 {
-  auto *attribute = span_.add_attributes();
+  auto *attribute = span_->add_attributes();
   OtlpPopulateAttributeUtils::PopulateAttribute(attribute, key, value);
 }
 
@@ -90,7 +103,7 @@ void OtlpRecordable::AddEvent(nostd::string_view name,
                               common::SystemTimestamp timestamp,
                               const common::KeyValueIterable &attributes) noexcept
 {
-  auto *event = span_.add_events();
+  auto *event = span_->add_events();
   event->set_name(name.data(), name.size());
   event->set_time_unix_nano(timestamp.time_since_epoch().count());
 
@@ -103,7 +116,7 @@ void OtlpRecordable::AddEvent(nostd::string_view name,
 void OtlpRecordable::AddLink(const trace::SpanContext &span_context,
                              const common::KeyValueIterable &attributes) noexcept
 {
-  auto *link = span_.add_links();
+  auto *link = span_->add_links();
   link->set_trace_id(reinterpret_cast<const char *>(span_context.trace_id().Id().data()),
                      trace::TraceId::kSize);
   link->set_span_id(reinterpret_cast<const char *>(span_context.span_id().Id().data()),
@@ -117,16 +130,16 @@ void OtlpRecordable::AddLink(const trace::SpanContext &span_context,
 
 void OtlpRecordable::SetStatus(trace::StatusCode code, nostd::string_view description) noexcept
 {
-  span_.mutable_status()->set_code(proto::trace::v1::Status_StatusCode(code));
+  span_->mutable_status()->set_code(proto::trace::v1::Status_StatusCode(code));
   if (code == trace::StatusCode::kError)
   {
-    span_.mutable_status()->set_message(description.data(), description.size());
+    span_->mutable_status()->set_message(description.data(), description.size());
   }
 }
 
 void OtlpRecordable::SetName(nostd::string_view name) noexcept
 {
-  span_.set_name(name.data(), name.size());
+  span_->set_name(name.data(), name.size());
 }
 
 void OtlpRecordable::SetSpanKind(trace::SpanKind span_kind) noexcept
@@ -162,18 +175,18 @@ void OtlpRecordable::SetSpanKind(trace::SpanKind span_kind) noexcept
       proto_span_kind = proto::trace::v1::Span_SpanKind::Span_SpanKind_SPAN_KIND_UNSPECIFIED;
   }
 
-  span_.set_kind(proto_span_kind);
+  span_->set_kind(proto_span_kind);
 }
 
 void OtlpRecordable::SetStartTime(common::SystemTimestamp start_time) noexcept
 {
-  span_.set_start_time_unix_nano(start_time.time_since_epoch().count());
+  span_->set_start_time_unix_nano(start_time.time_since_epoch().count());
 }
 
 void OtlpRecordable::SetDuration(std::chrono::nanoseconds duration) noexcept
 {
-  const uint64_t unix_end_time = span_.start_time_unix_nano() + duration.count();
-  span_.set_end_time_unix_nano(unix_end_time);
+  const uint64_t unix_end_time = span_->start_time_unix_nano() + duration.count();
+  span_->set_end_time_unix_nano(unix_end_time);
 }
 
 void OtlpRecordable::SetInstrumentationLibrary(
@@ -183,6 +196,13 @@ void OtlpRecordable::SetInstrumentationLibrary(
   instrumentation_library_ = &instrumentation_library;
 }
 
+void OtlpRecordable::SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept
+{
+  span_->set_dropped_attributes_count(attributes);
+  span_->set_dropped_events_count(events);
+  span_->set_dropped_links_count(links);
+}
+
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
@@ -11,10 +11,10 @@
 #include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
 
 #include "opentelemetry/exporters/otlp/otlp_log_recordable.h"
+#include "opentelemetry/exporters/otlp/otlp_populate_attribute_utils.h"
 #include "opentelemetry/exporters/otlp/otlp_recordable.h"
 
-#include <list>
-#include <unordered_map>
+#include <vector>
 
 namespace nostd = opentelemetry::nostd;
 
@@ -26,69 +26,248 @@ namespace otlp
 
 namespace
 {
-struct InstrumentationLibraryPointerHasher
+/**
+ * The groups of the records of a batch: a resource and instrumentation library, with the messages
+ * of the request their records go to. Batches seldom hold more than a few of them, so they are
+ * searched linearly in an array which holds the first kInlineGroups without allocating, rather
+ * than indexed by maps allocated and hashed on every export.
+ */
+template <class ResourceMessage, class ScopeMessage>
+class RequestGroups
 {
-  std::size_t operator()(const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
-                             *instrumentation) const noexcept
+public:
+  struct Group
   {
-    return instrumentation->HashCode();
+    const opentelemetry::sdk::resource::Resource *resource;
+    const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *library;
+    ResourceMessage *resource_message;
+    ScopeMessage *scope_message;
+  };
+
+  /**
+   * Returns the message of the records of a resource and library, or null if there is none yet.
+   * @param by_value whether libraries equal by value share a group, rather than only the same
+   * library
+   */
+  ScopeMessage *FindScope(
+      const opentelemetry::sdk::resource::Resource *resource,
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *library,
+      bool by_value) noexcept
+  {
+    for (size_t i = 0; i < size(); ++i)
+    {
+      const Group &group = At(i);
+      if (group.resource == resource &&
+          (group.library == library ||
+           (by_value && nullptr != group.library && nullptr != library &&
+            *group.library == *library)))
+      {
+        return group.scope_message;
+      }
+    }
+    return nullptr;
   }
-};
 
-struct InstrumentationLibraryPointerEqual
-{
-  std::size_t operator()(
-      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *left,
-      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *right)
-      const noexcept
+  /**
+   * Returns the message of a resource, or null if there is none yet.
+   */
+  ResourceMessage *FindResource(const opentelemetry::sdk::resource::Resource *resource) noexcept
+  {
+    for (size_t i = 0; i < size(); ++i)
+    {
+      if (At(i).resource == resource)
+      {
+        return At(i).resource_message;
+      }
+    }
+    return nullptr;
+  }
+
+  void Add(const Group &group)
+  {
+    if (inline_size_ < kInlineGroups)
+    {
+      inline_groups_[inline_size_++] = group;
+    }
+    else
+    {
+      overflow_groups_.push_back(group);
+    }
+  }
+
+private:
+  static constexpr size_t kInlineGroups = 8;
+
+  size_t size() const noexcept { return inline_size_ + overflow_groups_.size(); }
+
+  const Group &At(size_t index) const noexcept
   {
-    return *left == *right;
+    return index < kInlineGroups ? inline_groups_[index] : overflow_groups_[index - kInlineGroups];
   }
+
+  Group inline_groups_[kInlineGroups];
+  size_t inline_size_ = 0;
+  std::vector<Group> overflow_groups_;
 };
 }  // namespace
 
+const proto::resource::v1::Resource &OtlpProtoCache::GetResource(
+    const opentelemetry::sdk::resource::Resource *resource) noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  auto it = resources_.find(resource);
+  if (it == resources_.end())
+  {
+    it = resources_.emplace(resource, proto::resource::v1::Resource()).first;
+    if (nullptr != resource)
+    {
+      OtlpPopulateAttributeUtils::PopulateAttribute(&it->second, *resource);
+    }
+  }
+  return it->second;
+}
+
+const proto::common::v1::InstrumentationLibrary &OtlpProtoCache::GetInstrumentationLibrary(
+    const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+        *instrumentation_library) noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  auto it = instrumentation_libraries_.find(instrumentation_library);
+  if (it == instrumentation_libraries_.end())
+  {
+    it = instrumentation_libraries_
+             .emplace(instrumentation_library, proto::common::v1::InstrumentationLibrary())
+             .first;
+    if (nullptr != instrumentation_library)
+    {
+      it->second.set_name(instrumentation_library->GetName());
+      it->second.set_version(instrumentation_library->GetVersion());
+    }
+  }
+  return it->second;
+}
+
+const proto::common::v1::InstrumentationScope &OtlpProtoCache::GetInstrumentationScope(
+    const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+        *instrumentation_library) noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  auto it = instrumentation_scopes_.find(instrumentation_library);
+  if (it == instrumentation_scopes_.end())
+  {
+    it = instrumentation_scopes_
+             .emplace(instrumentation_library, proto::common::v1::InstrumentationScope())
+             .first;
+    if (nullptr != instrumentation_library)
+    {
+      it->second.set_name(instrumentation_library->GetName());
+      it->second.set_version(instrumentation_library->GetVersion());
+    }
+  }
+  return it->second;
+}
+
+google::protobuf::ArenaOptions OtlpRecordableUtils::GetArenaOptions() noexcept
+{
+  google::protobuf::ArenaOptions options;
+  // The resource and instrumentation library of a span alone take most of a kilobyte.
+  options.initial_block_size = 1024;
+  // Batches hold hundreds of spans, larger blocks make for fewer allocations.
+  options.max_block_size = 64 * 1024;
+  return options;
+}
+
 void OtlpRecordableUtils::PopulateRequest(
     const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans,
-    proto::collector::trace::v1::ExportTraceServiceRequest *request) noexcept
+    proto::collector::trace::v1::ExportTraceServiceRequest *request,
+    OtlpProtoCache *cache) noexcept
 {
   if (nullptr == request)
   {
     return;
   }
 
+  // Spans are appended to their ResourceSpans and InstrumentationLibrarySpans as they come, so
+  // that each resource and instrumentation library is written once per batch.
+  RequestGroups<proto::trace::v1::ResourceSpans, proto::trace::v1::InstrumentationLibrarySpans>
+      groups;
+
+  // Consecutive spans usually share their resource and instrumentation library.
+  const opentelemetry::sdk::resource::Resource *last_resource = nullptr;
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *last_library = nullptr;
+  proto::trace::v1::InstrumentationLibrarySpans *last_library_spans = nullptr;
+
   for (auto &recordable : spans)
   {
     auto rec = std::unique_ptr<OtlpRecordable>(static_cast<OtlpRecordable *>(recordable.release()));
-    auto resource_span       = request->add_resource_spans();
-    auto instrumentation_lib = resource_span->add_instrumentation_library_spans();
+    auto resource = rec->GetResource();
+    auto library  = rec->GetInstrumentationLibrary();
 
-    *instrumentation_lib->add_spans()                       = std::move(rec->span());
-    *instrumentation_lib->mutable_instrumentation_library() = rec->GetProtoInstrumentationLibrary();
+    if (nullptr == last_library_spans || resource != last_resource || library != last_library)
+    {
+      auto library_spans = groups.FindScope(resource, library, false);
+      if (nullptr == library_spans)
+      {
+        auto resource_spans = groups.FindResource(resource);
+        if (nullptr == resource_spans)
+        {
+          resource_spans = request->add_resource_spans();
+          if (nullptr != cache)
+          {
+            *resource_spans->mutable_resource() = cache->GetResource(resource);
+          }
+          else
+          {
+            *resource_spans->mutable_resource() = rec->ProtoResource();
+          }
+          resource_spans->set_schema_url(rec->GetResourceSchemaURL());
+        }
 
-    instrumentation_lib->set_schema_url(rec->GetInstrumentationLibrarySchemaURL());
+        library_spans = resource_spans->add_instrumentation_library_spans();
+        if (nullptr != cache)
+        {
+          *library_spans->mutable_instrumentation_library() =
+              cache->GetInstrumentationLibrary(library);
+        }
+        else
+        {
+          *library_spans->mutable_instrumentation_library() =
+              rec->GetProtoInstrumentationLibrary();
+        }
+        library_spans->set_schema_url(rec->GetInstrumentationLibrarySchemaURL());
+        groups.Add({resource, library, resource_spans, library_spans});
+      }
+
+      last_resource      = resource;
+      last_library       = library;
+      last_library_spans = library_spans;
+    }
 
-    *resource_span->mutable_resource() = rec->ProtoResource();
-    resource_span->set_schema_url(rec->GetResourceSchemaURL());
+    // The request adopts the span, whichever arena it was allocated on, rather than copying it.
+    last_library_spans->mutable_spans()->AddAllocated(rec->ReleaseSpan());
   }
 }
 
 #ifdef ENABLE_LOGS_PREVIEW
 void OtlpRecordableUtils::PopulateRequest(
     const nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>> &logs,
-    proto::collector::logs::v1::ExportLogsServiceRequest *request) noexcept
+    proto::collector::logs::v1::ExportLogsServiceRequest *request,
+    OtlpProtoCache *cache) noexcept
 {
   if (nullptr == request)
   {
     return;
   }
 
-  using logs_index_by_instrumentation_type =
-      std::unordered_map<const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *,
-                         std::list<std::unique_ptr<OtlpLogRecordable>>,
-                         InstrumentationLibraryPointerHasher, InstrumentationLibraryPointerEqual>;
-  std::unordered_map<const opentelemetry::sdk::resource::Resource *,
-                     logs_index_by_instrumentation_type>
-      logs_index_by_resource;
+  // Records are appended to their ResourceLogs and ScopeLogs as they come, in a single pass: the
+  // resource is converted once per resource and the records are adopted rather than copied.
+  RequestGroups<proto::logs::v1::ResourceLogs, proto::logs::v1::ScopeLogs> groups;
+
+  // Consecutive records usually share their resource and instrumentation library.
+  const opentelemetry::sdk::resource::Resource *last_resource = nullptr;
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *last_instrumentation =
+      nullptr;
+  proto::logs::v1::ScopeLogs *last_scope_logs = nullptr;
 
   for (auto &recordable : logs)
   {
@@ -97,33 +276,48 @@ void OtlpRecordableUtils::PopulateRequest(
     auto instrumentation = &rec->GetInstrumentationLibrary();
     auto resource        = &rec->GetResource();
 
-    logs_index_by_resource[resource][instrumentation].emplace_back(std::move(rec));
-  }
-
-  for (auto &input_resource_log : logs_index_by_resource)
-  {
-    auto output_resource_log = request->add_resource_logs();
-    for (auto &input_scope_log : input_resource_log.second)
+    if (resource != last_resource || instrumentation != last_instrumentation)
     {
-      auto output_scope_log = output_resource_log->add_scope_logs();
-      for (auto &input_log_record : input_scope_log.second)
+      // Records of instrumentation libraries equal by value share their scope.
+      auto scope_logs = groups.FindScope(resource, instrumentation, true);
+      if (nullptr == scope_logs)
       {
-        if (!output_resource_log->has_resource())
+        auto resource_logs = groups.FindResource(resource);
+        if (nullptr == resource_logs)
         {
-          *output_resource_log->mutable_resource() = input_log_record->ProtoResource();
-          output_resource_log->set_schema_url(input_resource_log.first->GetSchemaURL());
+          resource_logs = request->add_resource_logs();
+          if (nullptr != cache)
+          {
+            *resource_logs->mutable_resource() = cache->GetResource(resource);
+          }
+          else
+          {
+            *resource_logs->mutable_resource() = rec->ProtoResource();
+          }
+          resource_logs->set_schema_url(resource->GetSchemaURL());
         }
 
-        if (!output_scope_log->has_scope())
+        scope_logs = resource_logs->add_scope_logs();
+        if (nullptr != cache)
         {
-          output_scope_log->mutable_scope()->set_name(input_scope_log.first->GetName());
-          output_scope_log->mutable_scope()->set_version(input_scope_log.first->GetVersion());
-          output_scope_log->set_schema_url(input_scope_log.first->GetSchemaURL());
+          *scope_logs->mutable_scope() = cache->GetInstrumentationScope(instrumentation);
         }
-
-        *output_scope_log->add_log_records() = std::move(input_log_record->log_record());
+        else
+        {
+          scope_logs->mutable_scope()->set_name(instrumentation->GetName());
+          scope_logs->mutable_scope()->set_version(instrumentation->GetVersion());
+        }
+        scope_logs->set_schema_url(instrumentation->GetSchemaURL());
+        groups.Add({resource, instrumentation, resource_logs, scope_logs});
       }
+
+      last_resource        = resource;
+      last_instrumentation = instrumentation;
+      last_scope_logs      = scope_logs;
     }
+
+    // The request adopts the record, whichever arena it was allocated on, rather than copying it.
+    last_scope_logs->mutable_log_records()->AddAllocated(rec->ReleaseLogRecord());
   }
 }
 #endif
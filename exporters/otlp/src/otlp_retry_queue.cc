@@ -0,0 +1,166 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_retry_queue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+#include "opentelemetry/sdk/common/thread_options.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+OtlpRetryQueue::OtlpRetryQueue(const OtlpRetryOptions &options)
+    : options_(options), random_(std::random_device{}())
+{}
+
+OtlpRetryQueue::~OtlpRetryQueue()
+{
+  Shutdown();
+}
+
+bool OtlpRetryQueue::Enqueue(Attempt &&attempt, const OtlpAttemptResult &result) noexcept
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (is_shutdown_ || result.status != OtlpAttemptStatus::kRetryableFailure ||
+      options_.max_attempts < 2 || options_.max_queue_size == 0)
+  {
+    ++statistics_.dropped;
+    return false;
+  }
+
+  if (entries_.size() >= options_.max_queue_size)
+  {
+    OTEL_INTERNAL_LOG_WARN("[OTLP Retry] Retry queue is full, dropping the oldest export");
+    entries_.pop_front();
+    ++statistics_.dropped;
+  }
+  entries_.push_back(
+      Entry{std::move(attempt), 1, std::chrono::steady_clock::now() + ComputeBackoff(2, result)});
+
+  if (!thread_.joinable())
+  {
+    thread_ = std::thread(&OtlpRetryQueue::Run, this);
+  }
+  lock.unlock();
+  cv_.notify_one();
+  return true;
+}
+
+void OtlpRetryQueue::Shutdown() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_shutdown_)
+    {
+      return;
+    }
+    is_shutdown_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.dropped += entries_.size();
+  entries_.clear();
+}
+
+OtlpRetryStatistics OtlpRetryQueue::GetStatistics() const noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  OtlpRetryStatistics statistics = statistics_;
+  statistics.queue_size          = entries_.size();
+  return statistics;
+}
+
+std::chrono::milliseconds OtlpRetryQueue::GetBackoff(std::size_t attempt,
+                                                     const OtlpAttemptResult &result) noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ComputeBackoff(attempt, result);
+}
+
+std::chrono::milliseconds OtlpRetryQueue::ComputeBackoff(std::size_t attempt,
+                                                         const OtlpAttemptResult &result) noexcept
+{
+  // The server knows best when it will be back.
+  if (result.retry_delay.count() > 0)
+  {
+    return result.retry_delay;
+  }
+
+  double backoff = static_cast<double>(options_.initial_backoff.count()) *
+                   std::pow(options_.backoff_multiplier, static_cast<double>(attempt - 2));
+  backoff        = (std::min)(backoff, static_cast<double>(options_.max_backoff.count()));
+
+  // Jitter between half and all of the backoff, so that exporters which failed together do not
+  // retry together.
+  std::uniform_real_distribution<double> jitter(0.5, 1.0);
+  return std::chrono::milliseconds(static_cast<int64_t>(backoff * jitter(random_)));
+}
+
+void OtlpRetryQueue::Run() noexcept
+{
+  sdk::common::ApplyThreadOptions(sdk::common::ThreadOptions(), "otel-otlp-retry");
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!is_shutdown_)
+  {
+    if (entries_.empty())
+    {
+      cv_.wait(lock);
+      continue;
+    }
+
+    auto next = std::min_element(entries_.begin(), entries_.end(),
+                                 [](const Entry &a, const Entry &b) { return a.due < b.due; });
+    if (next->due > std::chrono::steady_clock::now())
+    {
+      cv_.wait_until(lock, next->due);
+      continue;
+    }
+
+    Entry entry = std::move(*next);
+    entries_.erase(next);
+    ++entry.attempts;
+    ++statistics_.retries;
+
+    lock.unlock();
+    OtlpAttemptResult result = entry.attempt();
+    lock.lock();
+
+    if (result.status == OtlpAttemptStatus::kSuccess)
+    {
+      ++statistics_.recovered;
+    }
+    else if (result.status == OtlpAttemptStatus::kRetryableFailure &&
+             entry.attempts < options_.max_attempts && !is_shutdown_)
+    {
+      entry.due = std::chrono::steady_clock::now() + ComputeBackoff(entry.attempts + 1, result);
+      if (entries_.size() >= options_.max_queue_size)
+      {
+        entries_.pop_front();
+        ++statistics_.dropped;
+      }
+      entries_.push_back(std::move(entry));
+    }
+    else
+    {
+      OTEL_INTERNAL_LOG_ERROR("[OTLP Retry] Dropping an export after " << entry.attempts
+                                                                       << " attempt(s)");
+      ++statistics_.dropped;
+    }
+  }
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
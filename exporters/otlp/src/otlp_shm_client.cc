@@ -0,0 +1,71 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_shm_client.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#include <google/protobuf/message.h>
+
+#include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+OtlpShmClient::OtlpShmClient(const OtlpShmRingOptions &options)
+{
+  is_open_ = !options.path.empty() && ring_.OpenWriter(options);
+  if (!is_open_)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP SHM Client] Cannot map the ring \""
+                            << options.path << "\", exports will fail");
+  }
+}
+
+sdk::common::ExportResult OtlpShmClient::Export(OtlpShmRecordType type,
+                                                const google::protobuf::Message &message) noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  if (is_shutdown_ || !is_open_)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP SHM Client] Export failed, "
+                            << (is_shutdown_ ? "the exporter is shut down"
+                                             : "the ring cannot be mapped"));
+    return sdk::common::ExportResult::kFailure;
+  }
+
+  // The request is serialized in place, where the reader finds it.
+  const std::size_t size = message.ByteSizeLong();
+  uint8_t *payload       = ring_.Reserve(size);
+  if (payload == nullptr)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP SHM Client] Dropping a request of "
+                            << size << " bytes, the ring is full");
+    return sdk::common::ExportResult::kFailure;
+  }
+  message.SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8 *>(payload));
+  ring_.Commit(type, size);
+  return sdk::common::ExportResult::kSuccess;
+}
+
+bool OtlpShmClient::Shutdown() noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  is_shutdown_ = true;
+  return true;
+}
+
+uint64_t OtlpShmClient::GetDroppedCount() const noexcept
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return ring_.GetDroppedCount();
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,57 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_shm_exporter.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
+
+#include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+namespace nostd = opentelemetry::nostd;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+OtlpShmExporter::OtlpShmExporter(const OtlpShmRingOptions &options) : shm_client_(options) {}
+
+std::unique_ptr<opentelemetry::sdk::trace::Recordable> OtlpShmExporter::MakeRecordable() noexcept
+{
+  return std::unique_ptr<opentelemetry::sdk::trace::Recordable>(
+      new exporter::otlp::OtlpRecordable());
+}
+
+opentelemetry::sdk::common::ExportResult OtlpShmExporter::Export(
+    const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans) noexcept
+{
+  if (spans.empty())
+  {
+    return opentelemetry::sdk::common::ExportResult::kSuccess;
+  }
+
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto service_request = google::protobuf::Arena::CreateMessage<
+      proto::collector::trace::v1::ExportTraceServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(spans, service_request, &proto_cache_);
+  return shm_client_.Export(OtlpShmRecordType::kTraces, *service_request);
+}
+
+bool OtlpShmExporter::Shutdown(std::chrono::microseconds) noexcept
+{
+  return shm_client_.Shutdown();
+}
+
+uint64_t OtlpShmExporter::GetDroppedCount() const noexcept
+{
+  return shm_client_.GetDroppedCount();
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,302 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_shm_ring.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+namespace
+{
+constexpr char kRingMagic[]     = "OTLPSHM1";
+constexpr uint32_t kRingVersion = 1;
+
+uint64_t MagicValue()
+{
+  uint64_t value;
+  std::memcpy(&value, kRingMagic, sizeof(value));
+  return value;
+}
+
+std::size_t AlignRecord(std::size_t size)
+{
+  return (size + 7) & ~static_cast<std::size_t>(7);
+}
+}  // namespace
+
+struct OtlpShmRing::Header
+{
+  std::atomic<uint64_t> magic;
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t size;
+  std::atomic<uint64_t> generation;
+  uint8_t reserved0[32];
+  // The indexes are stored by different processes, and live on cache lines of their own.
+  std::atomic<uint64_t> write_index;
+  uint8_t reserved1[56];
+  std::atomic<uint64_t> read_index;
+  uint8_t reserved2[56];
+  std::atomic<uint64_t> dropped;
+  uint8_t reserved3[56];
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "the ring header is shared with processes which do not use std::atomic");
+
+OtlpShmRing::~OtlpShmRing()
+{
+  Unmap();
+}
+
+uint8_t *OtlpShmRing::Reserve(std::size_t size) noexcept
+{
+  if (header_ == nullptr)
+  {
+    return nullptr;
+  }
+  const std::size_t record_size = kRecordHeaderSize + AlignRecord(size);
+  const std::size_t position    = static_cast<std::size_t>(write_index_ % size_);
+  const std::size_t padding     = record_size > size_ - position ? size_ - position : 0;
+  const uint64_t read_index     = header_->read_index.load(std::memory_order_acquire);
+  if (size > (std::numeric_limits<uint32_t>::max)() ||
+      write_index_ - read_index + padding + record_size > size_)
+  {
+    header_->dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  if (padding > 0)
+  {
+    const uint32_t header[2] = {static_cast<uint32_t>(padding - kRecordHeaderSize),
+                                static_cast<uint32_t>(OtlpShmRecordType::kPadding)};
+    std::memcpy(records_ + position, header, sizeof(header));
+  }
+  reserved_offset_ = padding;
+  return records_ + (write_index_ + padding) % size_ + kRecordHeaderSize;
+}
+
+void OtlpShmRing::Commit(OtlpShmRecordType type, std::size_t size) noexcept
+{
+  const uint64_t index     = write_index_ + reserved_offset_;
+  const uint32_t header[2] = {static_cast<uint32_t>(size), static_cast<uint32_t>(type)};
+  std::memcpy(records_ + index % size_, header, sizeof(header));
+  write_index_     = index + kRecordHeaderSize + AlignRecord(size);
+  reserved_offset_ = 0;
+  header_->write_index.store(write_index_, std::memory_order_release);
+}
+
+bool OtlpShmRing::Front(OtlpShmRecordType &type, nostd::span<const uint8_t> &payload) noexcept
+{
+  if (header_ == nullptr || header_->magic.load(std::memory_order_acquire) != MagicValue() ||
+      header_->size != size_)
+  {
+    return false;
+  }
+  const uint64_t generation = header_->generation.load(std::memory_order_relaxed);
+  if (generation != generation_)
+  {
+    // The writer initialized the ring again, and its records start over.
+    generation_ = generation;
+    read_index_ = header_->read_index.load(std::memory_order_relaxed);
+  }
+
+  const uint64_t write_index = header_->write_index.load(std::memory_order_acquire);
+  while (read_index_ < write_index)
+  {
+    const std::size_t position = static_cast<std::size_t>(read_index_ % size_);
+    uint32_t header[2];
+    std::memcpy(header, records_ + position, sizeof(header));
+    const std::size_t record_size = kRecordHeaderSize + AlignRecord(header[0]);
+    if (record_size > size_ - position || record_size > write_index - read_index_)
+    {
+      OTEL_INTERNAL_LOG_ERROR("[OTLP Shm Ring] Skipping the corrupted records of the ring");
+      read_index_ = write_index;
+      header_->read_index.store(read_index_, std::memory_order_release);
+      return false;
+    }
+    if (header[1] == static_cast<uint32_t>(OtlpShmRecordType::kPadding))
+    {
+      read_index_ += record_size;
+      continue;
+    }
+    type        = static_cast<OtlpShmRecordType>(header[1]);
+    payload     = nostd::span<const uint8_t>(records_ + position + kRecordHeaderSize, header[0]);
+    front_size_ = record_size;
+    return true;
+  }
+  return false;
+}
+
+void OtlpShmRing::Pop() noexcept
+{
+  if (header_ == nullptr || front_size_ == 0)
+  {
+    return;
+  }
+  read_index_ += front_size_;
+  front_size_ = 0;
+  header_->read_index.store(read_index_, std::memory_order_release);
+}
+
+uint64_t OtlpShmRing::GetDroppedCount() const noexcept
+{
+  return header_ != nullptr ? header_->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+#if defined(_WIN32)
+
+bool OtlpShmRing::OpenWriter(const OtlpShmRingOptions &) noexcept
+{
+  OTEL_INTERNAL_LOG_ERROR("[OTLP Shm Ring] Shared-memory rings are not supported on this platform");
+  return false;
+}
+
+bool OtlpShmRing::OpenReader(const std::string &) noexcept
+{
+  OTEL_INTERNAL_LOG_ERROR("[OTLP Shm Ring] Shared-memory rings are not supported on this platform");
+  return false;
+}
+
+bool OtlpShmRing::Map(const std::string &, std::size_t, bool) noexcept
+{
+  return false;
+}
+
+void OtlpShmRing::Unmap() noexcept {}
+
+#else
+
+bool OtlpShmRing::OpenWriter(const OtlpShmRingOptions &options) noexcept
+{
+  const std::size_t size = options.size & ~static_cast<std::size_t>(7);
+  if (size < kRecordHeaderSize || !Map(options.path, kHeaderSize + size, true))
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP Shm Ring] Cannot map the ring " << options.path);
+    return false;
+  }
+
+  // Keep the unread records of a ring left by a previous writer, if it is consistent.
+  const uint64_t write_index = header_->write_index.load(std::memory_order_relaxed);
+  const uint64_t read_index  = header_->read_index.load(std::memory_order_relaxed);
+  if (header_->magic.load(std::memory_order_acquire) == MagicValue() &&
+      header_->version == kRingVersion && header_->header_size == kHeaderSize &&
+      header_->size == size_ && read_index <= write_index && write_index - read_index <= size_)
+  {
+    write_index_ = write_index;
+    return true;
+  }
+
+  // The magic is written last, so that readers do not use a ring being initialized.
+  header_->magic.store(0, std::memory_order_relaxed);
+  header_->version     = kRingVersion;
+  header_->header_size = kHeaderSize;
+  header_->size        = size_;
+  header_->write_index.store(0, std::memory_order_relaxed);
+  header_->read_index.store(0, std::memory_order_relaxed);
+  header_->dropped.store(0, std::memory_order_relaxed);
+  header_->generation.fetch_add(1, std::memory_order_relaxed);
+  header_->magic.store(MagicValue(), std::memory_order_release);
+  write_index_ = 0;
+  return true;
+}
+
+bool OtlpShmRing::OpenReader(const std::string &path) noexcept
+{
+  if (!Map(path, 0, false) || header_->magic.load(std::memory_order_acquire) != MagicValue() ||
+      header_->version != kRingVersion || header_->header_size != kHeaderSize ||
+      header_->size != size_)
+  {
+    Unmap();
+    return false;
+  }
+  generation_ = header_->generation.load(std::memory_order_relaxed);
+  read_index_ = header_->read_index.load(std::memory_order_relaxed);
+  return true;
+}
+
+bool OtlpShmRing::Map(const std::string &path, std::size_t file_size, bool create) noexcept
+{
+  static_assert(sizeof(Header) == kHeaderSize,
+                "the layout of the ring header is documented in otlp_shm_ring.h");
+  Unmap();
+  if (!std::atomic<uint64_t>().is_lock_free())
+  {
+    return false;
+  }
+  int fd = open(path.c_str(), create ? O_RDWR | O_CREAT : O_RDWR, 0600);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0)
+  {
+    close(fd);
+    return false;
+  }
+  if (create && static_cast<std::size_t>(file_stat.st_size) != file_size)
+  {
+    if (ftruncate(fd, static_cast<off_t>(file_size)) != 0)
+    {
+      close(fd);
+      return false;
+    }
+  }
+  else if (!create)
+  {
+    file_size = static_cast<std::size_t>(file_stat.st_size);
+    if (file_size < kHeaderSize + kRecordHeaderSize)
+    {
+      close(fd);
+      return false;
+    }
+  }
+
+  void *data = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping outlives the descriptor.
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    return false;
+  }
+  map_size_ = file_size;
+  header_   = static_cast<Header *>(data);
+  records_  = static_cast<uint8_t *>(data) + kHeaderSize;
+  size_     = file_size - kHeaderSize;
+  return true;
+}
+
+void OtlpShmRing::Unmap() noexcept
+{
+  if (header_ != nullptr)
+  {
+    munmap(header_, map_size_);
+  }
+  header_   = nullptr;
+  records_  = nullptr;
+  size_     = 0;
+  map_size_ = 0;
+}
+
+#endif
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,429 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_spill_file.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(_WIN32)
+#  include <dirent.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include <zlib.h>
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+namespace
+{
+// A segment starts with a magic number and the offset of its first unread record.
+constexpr char kSegmentMagic[]           = "OTLPSPL1";
+constexpr std::size_t kReadOffsetOffset  = 8;
+constexpr std::size_t kSegmentHeaderSize = 16;
+
+// A record starts with the length of its payload and the CRC-32 of its payload.
+constexpr std::size_t kRecordHeaderSize = 8;
+
+constexpr char kSegmentPrefix[] = "otlp-";
+constexpr char kSegmentSuffix[] = ".spill";
+
+uint32_t ReadUint32(const uint8_t *data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void WriteUint32(uint8_t *data, uint32_t value)
+{
+  std::memcpy(data, &value, sizeof(value));
+}
+
+uint64_t ReadUint64(const uint8_t *data)
+{
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void WriteUint64(uint8_t *data, uint64_t value)
+{
+  std::memcpy(data, &value, sizeof(value));
+}
+
+uint32_t Checksum(const uint8_t *data, std::size_t length)
+{
+  return static_cast<uint32_t>(crc32(0, data, static_cast<uInt>(length)));
+}
+
+/* Parses the sequence number of a segment file name, returns false for other files. */
+bool ParseSegmentName(const std::string &name, uint64_t &sequence)
+{
+  const std::size_t prefix_size = sizeof(kSegmentPrefix) - 1;
+  const std::size_t suffix_size = sizeof(kSegmentSuffix) - 1;
+  if (name.size() != prefix_size + 20 + suffix_size ||
+      name.compare(0, prefix_size, kSegmentPrefix) != 0 ||
+      name.compare(name.size() - suffix_size, suffix_size, kSegmentSuffix) != 0)
+  {
+    return false;
+  }
+  std::string digits = name.substr(prefix_size, 20);
+  if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    return false;
+  }
+  sequence = std::strtoull(digits.c_str(), nullptr, 10);
+  return true;
+}
+}  // namespace
+
+OtlpSpillFile::OtlpSpillFile(const OtlpSpillOptions &options) : options_(options) {}
+
+OtlpSpillFile::~OtlpSpillFile()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &segment : segments_)
+  {
+    if (options_.sync != OtlpSpillSync::kNever)
+    {
+      Sync(segment, 0, segment.write_offset);
+    }
+    CloseSegment(segment, false);
+  }
+  segments_.clear();
+}
+
+std::string OtlpSpillFile::GetPath(uint64_t sequence) const
+{
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s%020" PRIu64 "%s", kSegmentPrefix, sequence,
+                kSegmentSuffix);
+  return options_.directory + "/" + name;
+}
+
+#if defined(_WIN32)
+
+bool OtlpSpillFile::Open() noexcept
+{
+  OTEL_INTERNAL_LOG_ERROR("[OTLP Spill] Spill files are not supported on this platform");
+  return false;
+}
+
+bool OtlpSpillFile::MapSegment(uint64_t, std::size_t, bool, Segment &) noexcept
+{
+  return false;
+}
+
+void OtlpSpillFile::CloseSegment(Segment &, bool) noexcept {}
+
+void OtlpSpillFile::Sync(const Segment &, std::size_t, std::size_t) noexcept {}
+
+#else
+
+bool OtlpSpillFile::Open() noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  DIR *directory = opendir(options_.directory.c_str());
+  if (directory == nullptr)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[OTLP Spill] Cannot open directory " << options_.directory);
+    return false;
+  }
+  std::vector<uint64_t> sequences;
+  while (struct dirent *entry = readdir(directory))
+  {
+    uint64_t sequence = 0;
+    if (ParseSegmentName(entry->d_name, sequence))
+    {
+      sequences.push_back(sequence);
+    }
+  }
+  closedir(directory);
+  std::sort(sequences.begin(), sequences.end());
+
+  for (uint64_t sequence : sequences)
+  {
+    next_sequence_ = sequence + 1;
+    Segment segment;
+    if (!MapSegment(sequence, 0, false, segment))
+    {
+      OTEL_INTERNAL_LOG_WARN("[OTLP Spill] Removing unreadable segment " << GetPath(sequence));
+      unlink(GetPath(sequence).c_str());
+      continue;
+    }
+    RecoverSegment(segment);
+    if (segment.records == 0)
+    {
+      CloseSegment(segment, true);
+      continue;
+    }
+    total_size_ += segment.size;
+    segments_.push_back(segment);
+  }
+  return true;
+}
+
+bool OtlpSpillFile::MapSegment(uint64_t sequence,
+                               std::size_t size,
+                               bool create,
+                               Segment &segment) noexcept
+{
+  std::string path = GetPath(sequence);
+  int fd           = open(path.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+  if (fd < 0)
+  {
+    return false;
+  }
+  if (create)
+  {
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+      close(fd);
+      unlink(path.c_str());
+      return false;
+    }
+  }
+  else
+  {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) < kSegmentHeaderSize)
+    {
+      close(fd);
+      return false;
+    }
+    size = static_cast<std::size_t>(file_stat.st_size);
+  }
+
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED)
+  {
+    close(fd);
+    if (create)
+    {
+      unlink(path.c_str());
+    }
+    return false;
+  }
+
+  segment.sequence     = sequence;
+  segment.fd           = fd;
+  segment.data         = static_cast<uint8_t *>(data);
+  segment.size         = size;
+  segment.read_offset  = kSegmentHeaderSize;
+  segment.write_offset = kSegmentHeaderSize;
+  segment.records      = 0;
+  if (create)
+  {
+    std::memcpy(segment.data, kSegmentMagic, kReadOffsetOffset);
+    WriteUint64(segment.data + kReadOffsetOffset, kSegmentHeaderSize);
+  }
+  else if (std::memcmp(segment.data, kSegmentMagic, kReadOffsetOffset) != 0)
+  {
+    CloseSegment(segment, false);
+    return false;
+  }
+  return true;
+}
+
+void OtlpSpillFile::CloseSegment(Segment &segment, bool remove) noexcept
+{
+  munmap(segment.data, segment.size);
+  close(segment.fd);
+  if (remove)
+  {
+    unlink(GetPath(segment.sequence).c_str());
+  }
+}
+
+void OtlpSpillFile::Sync(const Segment &segment, std::size_t offset, std::size_t length) noexcept
+{
+  static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t start                  = offset - offset % page_size;
+  msync(segment.data + start, offset + length - start, MS_SYNC);
+}
+
+#endif
+
+void OtlpSpillFile::RecoverSegment(Segment &segment) noexcept
+{
+  uint64_t read_offset = ReadUint64(segment.data + kReadOffsetOffset);
+
+  std::size_t offset = kSegmentHeaderSize;
+  bool is_torn       = false;
+  while (offset + kRecordHeaderSize <= segment.size)
+  {
+    uint32_t length = ReadUint32(segment.data + offset);
+    if (length == 0)
+    {
+      break;
+    }
+    if (length > segment.size - offset - kRecordHeaderSize ||
+        ReadUint32(segment.data + offset + 4) !=
+            Checksum(segment.data + offset + kRecordHeaderSize, length))
+    {
+      is_torn = true;
+      break;
+    }
+    if (offset >= read_offset)
+    {
+      ++segment.records;
+    }
+    offset += kRecordHeaderSize + length;
+  }
+  segment.write_offset = offset;
+  segment.read_offset  = (std::min)(static_cast<std::size_t>(read_offset), offset);
+
+  if (is_torn)
+  {
+    // Clear the torn record, so that the records appended over it are not mistaken for it.
+    OTEL_INTERNAL_LOG_WARN("[OTLP Spill] Truncating torn segment " << GetPath(segment.sequence));
+    std::memset(segment.data + offset, 0, segment.size - offset);
+  }
+}
+
+bool OtlpSpillFile::Append(const std::vector<nostd::span<const uint8_t>> &parts) noexcept
+{
+  std::size_t length = 0;
+  for (const auto &part : parts)
+  {
+    length += part.size();
+  }
+  if (length == 0 || length > UINT32_MAX)
+  {
+    return false;
+  }
+  const std::size_t record_size = kRecordHeaderSize + length;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (segments_.empty() || segments_.back().write_offset + record_size > segments_.back().size)
+  {
+    if (!segments_.empty() && segments_.back().records == 0)
+    {
+      // Full and read: only the segments which remain to be read are kept.
+      total_size_ -= segments_.back().size;
+      CloseSegment(segments_.back(), true);
+      segments_.pop_back();
+    }
+    else if (!segments_.empty() && options_.sync == OtlpSpillSync::kSegment)
+    {
+      Sync(segments_.back(), 0, segments_.back().write_offset);
+    }
+
+    std::size_t size = (std::max)(options_.segment_size, kSegmentHeaderSize + record_size);
+    while (!segments_.empty() && total_size_ + size > options_.max_size)
+    {
+      OTEL_INTERNAL_LOG_WARN("[OTLP Spill] Spill file is full, dropping "
+                             << segments_.front().records << " request(s)");
+      dropped_ += segments_.front().records;
+      total_size_ -= segments_.front().size;
+      CloseSegment(segments_.front(), true);
+      segments_.pop_front();
+    }
+
+    Segment segment;
+    if (!MapSegment(next_sequence_, size, true, segment))
+    {
+      OTEL_INTERNAL_LOG_ERROR("[OTLP Spill] Cannot create segment " << GetPath(next_sequence_));
+      return false;
+    }
+    ++next_sequence_;
+    total_size_ += segment.size;
+    segments_.push_back(segment);
+  }
+
+  // The length is written last: until then, the record reads as the end of the segment.
+  Segment &segment = segments_.back();
+  uint8_t *record  = segment.data + segment.write_offset;
+  uint8_t *payload = record + kRecordHeaderSize;
+  uLong crc        = crc32(0, nullptr, 0);
+  for (const auto &part : parts)
+  {
+    if (part.size() > 0)
+    {
+      std::memcpy(payload, part.data(), part.size());
+      crc = crc32(crc, payload, static_cast<uInt>(part.size()));
+      payload += part.size();
+    }
+  }
+  WriteUint32(record + 4, static_cast<uint32_t>(crc));
+  WriteUint32(record, static_cast<uint32_t>(length));
+
+  if (options_.sync == OtlpSpillSync::kAlways)
+  {
+    Sync(segment, segment.write_offset, record_size);
+  }
+  segment.write_offset += record_size;
+  ++segment.records;
+  return true;
+}
+
+bool OtlpSpillFile::Front(std::vector<uint8_t> &record) noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (segments_.empty() || segments_.front().records == 0)
+  {
+    return false;
+  }
+  const Segment &segment = segments_.front();
+  uint32_t length        = ReadUint32(segment.data + segment.read_offset);
+  const uint8_t *payload = segment.data + segment.read_offset + kRecordHeaderSize;
+  record.assign(payload, payload + length);
+  return true;
+}
+
+void OtlpSpillFile::Pop() noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (segments_.empty() || segments_.front().records == 0)
+  {
+    return;
+  }
+  Segment &segment = segments_.front();
+  segment.read_offset += kRecordHeaderSize + ReadUint32(segment.data + segment.read_offset);
+  --segment.records;
+
+  // Once read, a segment which is not appended to anymore is removed.
+  if (segment.records == 0 && segments_.size() > 1)
+  {
+    total_size_ -= segment.size;
+    CloseSegment(segment, true);
+    segments_.pop_front();
+    return;
+  }
+  WriteUint64(segment.data + kReadOffsetOffset, segment.read_offset);
+  if (options_.sync == OtlpSpillSync::kAlways)
+  {
+    Sync(segment, kReadOffsetOffset, sizeof(uint64_t));
+  }
+}
+
+bool OtlpSpillFile::Empty() const noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::none_of(segments_.begin(), segments_.end(),
+                      [](const Segment &segment) { return segment.records > 0; });
+}
+
+uint64_t OtlpSpillFile::GetDroppedCount() const noexcept
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,161 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#if !defined(_WIN32)
+
+#  include "opentelemetry/exporters/otlp/otlp_file_client.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#  include <google/protobuf/wrappers.pb.h>
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+#  include <gtest/gtest.h>
+#  include <zlib.h>
+
+#  include <dirent.h>
+#  include <unistd.h>
+#  include <cstdlib>
+#  include <cstring>
+#  include <string>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+class OtlpFileClientTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char directory[] = "/tmp/otlp_file_XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    options_.directory    = directory;
+    options_.segment_size = 4096;
+  }
+
+  void TearDown() override
+  {
+    DIR *directory = opendir(options_.directory.c_str());
+    while (directory != nullptr)
+    {
+      struct dirent *entry = readdir(directory);
+      if (entry == nullptr)
+      {
+        closedir(directory);
+        break;
+      }
+      std::string name = entry->d_name;
+      if (name != "." && name != "..")
+      {
+        unlink((options_.directory + "/" + name).c_str());
+      }
+    }
+    rmdir(options_.directory.c_str());
+  }
+
+  std::vector<std::vector<uint8_t>> ReadRecords()
+  {
+    std::vector<std::vector<uint8_t>> records;
+    OtlpSpillOptions spill_options;
+    spill_options.directory    = options_.directory;
+    spill_options.segment_size = options_.segment_size;
+    OtlpSpillFile spill_file(spill_options);
+    EXPECT_TRUE(spill_file.Open());
+    std::vector<uint8_t> record;
+    while (spill_file.Front(record))
+    {
+      records.push_back(record);
+      spill_file.Pop();
+    }
+    return records;
+  }
+
+  static std::string Gunzip(const std::vector<uint8_t> &record)
+  {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    std::string output(64 * 1024, '\0');
+    stream.next_in   = const_cast<Bytef *>(record.data());
+    stream.avail_in  = static_cast<uInt>(record.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+    output.resize(stream.total_out);
+    inflateEnd(&stream);
+    return output;
+  }
+
+  OtlpFileExporterOptions options_;
+};
+
+TEST_F(OtlpFileClientTest, WriteSerializedRequests)
+{
+  OtlpFileClient client(options_);
+  google::protobuf::StringValue message;
+  for (const char *value : {"first", "second"})
+  {
+    message.set_value(value);
+    EXPECT_EQ(client.Export(message), sdk::common::ExportResult::kSuccess);
+  }
+  EXPECT_TRUE(client.Shutdown());
+  EXPECT_EQ(client.Export(message), sdk::common::ExportResult::kFailure);
+
+  auto records = ReadRecords();
+  ASSERT_EQ(records.size(), 2u);
+  google::protobuf::StringValue parsed;
+  ASSERT_TRUE(parsed.ParseFromArray(records[0].data(), static_cast<int>(records[0].size())));
+  EXPECT_EQ(parsed.value(), "first");
+  ASSERT_TRUE(parsed.ParseFromArray(records[1].data(), static_cast<int>(records[1].size())));
+  EXPECT_EQ(parsed.value(), "second");
+}
+
+TEST_F(OtlpFileClientTest, CompressLargeRequests)
+{
+  options_.compression          = "gzip";
+  options_.compression_min_size = 256;
+  OtlpFileClient client(options_);
+
+  google::protobuf::StringValue small_message;
+  small_message.set_value("small");
+  google::protobuf::StringValue large_message;
+  large_message.set_value(std::string(2048, 'x'));
+  EXPECT_EQ(client.Export(small_message), sdk::common::ExportResult::kSuccess);
+  EXPECT_EQ(client.Export(large_message), sdk::common::ExportResult::kSuccess);
+  client.Shutdown();
+
+  auto records = ReadRecords();
+  ASSERT_EQ(records.size(), 2u);
+  google::protobuf::StringValue parsed;
+  ASSERT_TRUE(parsed.ParseFromArray(records[0].data(), static_cast<int>(records[0].size())));
+  EXPECT_EQ(parsed.value(), "small");
+
+  // The compressed record starts with the gzip magic bytes.
+  ASSERT_GT(records[1].size(), 2u);
+  EXPECT_LT(records[1].size(), large_message.ByteSizeLong());
+  EXPECT_EQ(records[1][0], 0x1f);
+  EXPECT_EQ(records[1][1], 0x8b);
+  ASSERT_TRUE(parsed.ParseFromString(Gunzip(records[1])));
+  EXPECT_EQ(parsed.value(), large_message.value());
+}
+
+TEST_F(OtlpFileClientTest, FailWithoutDirectory)
+{
+  OtlpFileExporterOptions options = options_;
+  options.directory               = options_.directory + "/nonexistent";
+  OtlpFileClient client(options);
+  google::protobuf::StringValue message;
+  message.set_value("lost");
+  EXPECT_EQ(client.Export(message), sdk::common::ExportResult::kFailure);
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+
+#endif
@@ -29,7 +29,11 @@
 #  include "opentelemetry/sdk/trace/tracer_provider.h"
 #  include "opentelemetry/trace/provider.h"
 
+#  include <grpcpp/alarm.h>
 #  include <gtest/gtest.h>
+#  include <atomic>
+#  include <thread>
+#  include <vector>
 
 #  if defined(_MSC_VER)
 #    include "opentelemetry/sdk/common/env_variables.h"
@@ -45,6 +49,34 @@ namespace exporter
 namespace otlp
 {
 
+/**
+ * An asynchronous response reader which completes its call right away with the given status.
+ */
+class FakeAsyncResponseReader final : public grpc::ClientAsyncResponseReaderInterface<
+                                          proto::collector::trace::v1::ExportTraceServiceResponse>
+{
+public:
+  FakeAsyncResponseReader(grpc::CompletionQueue *cq, grpc::Status status) : cq_(cq), status_(status)
+  {}
+
+  void StartCall() override {}
+
+  void ReadInitialMetadata(void *) override {}
+
+  void Finish(proto::collector::trace::v1::ExportTraceServiceResponse *,
+              grpc::Status *status,
+              void *tag) override
+  {
+    *status = status_;
+    alarm_.Set(cq_, gpr_now(GPR_CLOCK_MONOTONIC), tag);
+  }
+
+private:
+  grpc::CompletionQueue *cq_;
+  grpc::Status status_;
+  grpc::Alarm alarm_;
+};
+
 class OtlpGrpcExporterTestPeer : public ::testing::Test
 {
 public:
@@ -60,6 +92,13 @@ class OtlpGrpcExporterTestPeer : public ::testing::Test
   {
     return exporter->options_;
   }
+
+  // Add the stub of another channel to the pool of the exporter.
+  void AddStub(sdk::trace::SpanExporter &exporter,
+               std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub)
+  {
+    static_cast<OtlpGrpcExporter &>(exporter).trace_service_stubs_.Add(std::move(stub));
+  }
 };
 
 TEST_F(OtlpGrpcExporterTestPeer, ShutdownTest)
@@ -110,11 +149,115 @@ TEST_F(OtlpGrpcExporterTestPeer, ExportUnitTest)
   nostd::span<std::unique_ptr<sdk::trace::Recordable>> batch_2(&recordable_2, 1);
   EXPECT_CALL(*mock_stub, Export(_, _, _))
       .Times(Exactly(1))
-      .WillOnce(Return(grpc::Status::CANCELLED));
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid")));
   result = exporter->Export(batch_2);
   EXPECT_EQ(sdk::common::ExportResult::kFailure, result);
 }
 
+// Exports are spread round-robin over the channels of the pool
+TEST_F(OtlpGrpcExporterTestPeer, ExportChannelPoolUnitTest)
+{
+  auto mock_stub_1 = new proto::collector::trace::v1::MockTraceServiceStub();
+  auto mock_stub_2 = new proto::collector::trace::v1::MockTraceServiceStub();
+  std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub_interface(
+      mock_stub_1);
+  auto exporter = GetExporter(stub_interface);
+  AddStub(*exporter,
+          std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface>(mock_stub_2));
+
+  EXPECT_CALL(*mock_stub_1, Export(_, _, _))
+      .Times(Exactly(2))
+      .WillRepeatedly(Return(grpc::Status::OK));
+  EXPECT_CALL(*mock_stub_2, Export(_, _, _))
+      .Times(Exactly(2))
+      .WillRepeatedly(Return(grpc::Status::OK));
+  for (int i = 0; i < 4; ++i)
+  {
+    auto recordable = exporter->MakeRecordable();
+    recordable->SetName("Test span");
+    nostd::span<std::unique_ptr<sdk::trace::Recordable>> batch(&recordable, 1);
+    EXPECT_EQ(sdk::common::ExportResult::kSuccess, exporter->Export(batch));
+  }
+}
+
+// Call Export() directly, and let the retry queue retry it
+TEST_F(OtlpGrpcExporterTestPeer, ExportRetryUnitTest)
+{
+  auto mock_stub = new proto::collector::trace::v1::MockTraceServiceStub();
+  std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub_interface(
+      mock_stub);
+  std::unique_ptr<OtlpGrpcExporter> exporter(
+      static_cast<OtlpGrpcExporter *>(GetExporter(stub_interface).release()));
+
+  auto recordable = exporter->MakeRecordable();
+  recordable->SetName("Test span");
+  nostd::span<std::unique_ptr<sdk::trace::Recordable>> batch(&recordable, 1);
+  EXPECT_CALL(*mock_stub, Export(_, _, _))
+      .Times(Exactly(2))
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "unavailable")))
+      .WillOnce(Return(grpc::Status::OK));
+
+  // The export succeeds once it is queued for a retry.
+  auto result = exporter->Export(batch);
+  EXPECT_EQ(sdk::common::ExportResult::kSuccess, result);
+  for (int i = 0; i < 500 && exporter->GetRetryStatistics().recovered == 0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto statistics = exporter->GetRetryStatistics();
+  EXPECT_EQ(1u, statistics.retries);
+  EXPECT_EQ(1u, statistics.recovered);
+  EXPECT_EQ(0u, statistics.dropped);
+  // Both attempts are counted, with the same payload.
+  EXPECT_EQ(2u, statistics.requests);
+  EXPECT_GT(statistics.request_bytes, 0u);
+  EXPECT_EQ(0u, statistics.request_bytes % 2);
+}
+
+// Call ExportAsync() directly
+TEST_F(OtlpGrpcExporterTestPeer, ExportAsyncUnitTest)
+{
+  auto mock_stub = new proto::collector::trace::v1::MockTraceServiceStub();
+  std::unique_ptr<proto::collector::trace::v1::TraceService::StubInterface> stub_interface(
+      mock_stub);
+  auto exporter = GetExporter(stub_interface);
+
+  // gRPC never deletes the readers it hands out, as they live on the arena of their call.
+  std::vector<std::unique_ptr<FakeAsyncResponseReader>> readers;
+  EXPECT_CALL(*mock_stub, PrepareAsyncExportRaw(_, _, _))
+      .WillOnce(Invoke([&readers](grpc::ClientContext *,
+                                  const proto::collector::trace::v1::ExportTraceServiceRequest &,
+                                  grpc::CompletionQueue *cq) {
+        readers.emplace_back(new FakeAsyncResponseReader(cq, grpc::Status::OK));
+        return readers.back().get();
+      }))
+      .WillOnce(Invoke([&readers](grpc::ClientContext *,
+                                  const proto::collector::trace::v1::ExportTraceServiceRequest &,
+                                  grpc::CompletionQueue *cq) {
+        readers.emplace_back(new FakeAsyncResponseReader(
+            cq, grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid")));
+        return readers.back().get();
+      }));
+
+  std::atomic<int> successes{0};
+  std::atomic<int> failures{0};
+  auto callback = [&](sdk::common::ExportResult result) {
+    ++(result == sdk::common::ExportResult::kSuccess ? successes : failures);
+  };
+  for (int i = 0; i < 2; ++i)
+  {
+    auto recordable = exporter->MakeRecordable();
+    recordable->SetName("Test span");
+    nostd::span<std::unique_ptr<sdk::trace::Recordable>> batch(&recordable, 1);
+    exporter->ExportAsync(batch, callback);
+  }
+
+  // Shutdown waits for the requests in flight.
+  EXPECT_TRUE(exporter->Shutdown());
+  EXPECT_EQ(1, successes.load());
+  EXPECT_EQ(1, failures.load());
+}
+
 // Create spans, let processor call Export()
 TEST_F(OtlpGrpcExporterTestPeer, ExportIntegrationTest)
 {
@@ -149,6 +292,23 @@ TEST_F(OtlpGrpcExporterTestPeer, ConfigTest)
   EXPECT_EQ(GetOptions(exporter).endpoint, "localhost:45454");
 }
 
+// Test the channels of a pool
+TEST_F(OtlpGrpcExporterTestPeer, ConfigChannelPoolTest)
+{
+  OtlpGrpcExporterOptions opts;
+  opts.endpoint              = "localhost:45454";
+  opts.channel_pool_size     = 4;
+  opts.load_balancing_policy = "round_robin";
+  OtlpGrpcStubPool<proto::collector::trace::v1::TraceService> stubs;
+  stubs.Create(opts);
+  EXPECT_EQ(stubs.size(), 4u);
+  EXPECT_NE(&stubs.Next(), &stubs.Next());
+
+  EXPECT_NE(OtlpGrpcClient::MakeChannel(opts, 0), OtlpGrpcClient::MakeChannel(opts, 1));
+  opts.endpoint = "unix:///var/run/otelcol.sock";
+  EXPECT_NE(OtlpGrpcClient::MakeChannel(opts), nullptr);
+}
+
 // Test exporter configuration options with use_ssl_credentials
 TEST_F(OtlpGrpcExporterTestPeer, ConfigSslCredentialsTest)
 {
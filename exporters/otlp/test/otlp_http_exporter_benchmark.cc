@@ -0,0 +1,71 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_http_client.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+#include "test/trace/span_shapes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace http_client = opentelemetry::ext::http::client;
+namespace nostd       = opentelemetry::nostd;
+namespace otlp        = opentelemetry::exporter::otlp;
+namespace sdktrace    = opentelemetry::sdk::trace;
+using span_shapes::SpanShape;
+
+namespace
+{
+/**
+ * Converts batches into an ExportTraceServiceRequest and serializes it into the body of the
+ * request of the OTLP/HTTP exporter, with the given content type, without sending it.
+ */
+void BM_OtlpHttpSerialization(benchmark::State &state, otlp::HttpRequestContentType content_type)
+{
+  std::vector<std::unique_ptr<sdktrace::Recordable>> spans;
+  for (int i = 0; i < span_shapes::kSpansPerBatch; ++i)
+  {
+    spans.emplace_back(new otlp::OtlpRecordable);
+    span_shapes::FillSpan(*spans.back(), static_cast<SpanShape>(state.range(0)), i);
+  }
+  otlp::OtlpHttpClientOptions options("http://localhost:4318/v1/traces", content_type,
+                                      otlp::JsonBytesMappingKind::kHexId, false, false,
+                                      std::chrono::seconds(10), otlp::OtlpHeaders());
+  otlp::OtlpProtoCache cache;
+
+  http_client::Body body;
+  std::vector<http_client::Body> chunks;
+  std::string request_content_type;
+  uint64_t bytes = 0;
+  for (auto _ : state)
+  {
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+    otlp::OtlpRecordableUtils::PopulateRequest(
+        nostd::span<std::unique_ptr<sdktrace::Recordable>>(spans.data(), spans.size()), &request,
+        &cache);
+    body.clear();
+    chunks.clear();
+    if (!otlp::OtlpHttpClient::SerializeRequestBody(request, options, body, chunks,
+                                                    request_content_type))
+    {
+      state.SkipWithError("the request could not be serialized");
+      break;
+    }
+    benchmark::DoNotOptimize(body.data());
+    bytes += body.size();
+  }
+  span_shapes::ReportThroughput(state, bytes);
+}
+BENCHMARK_CAPTURE(BM_OtlpHttpSerialization, binary, otlp::HttpRequestContentType::kBinary)
+    ->Apply(span_shapes::ApplyShapes);
+BENCHMARK_CAPTURE(BM_OtlpHttpSerialization, json, otlp::HttpRequestContentType::kJson)
+    ->Apply(span_shapes::ApplyShapes);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -310,6 +310,19 @@ TEST_F(OtlpHttpExporterTestPeer, ConfigFromEnv)
   unsetenv("OTEL_EXPORTER_OTLP_TRACES_HEADERS");
 }
 
+TEST_F(OtlpHttpExporterTestPeer, ConfigFromUnixSocketEnv)
+{
+  setenv("OTEL_EXPORTER_OTLP_ENDPOINT", "unix:///var/run/otelcol.sock", 1);
+  std::unique_ptr<OtlpHttpExporter> exporter(new OtlpHttpExporter());
+  EXPECT_EQ(GetOptions(exporter).url, "unix:///var/run/otelcol.sock:/v1/traces");
+
+  setenv("OTEL_EXPORTER_OTLP_ENDPOINT", "unix:///var/run/otelcol.sock:/otlp", 1);
+  exporter.reset(new OtlpHttpExporter());
+  EXPECT_EQ(GetOptions(exporter).url, "unix:///var/run/otelcol.sock:/otlp/v1/traces");
+
+  unsetenv("OTEL_EXPORTER_OTLP_ENDPOINT");
+}
+
 TEST_F(OtlpHttpExporterTestPeer, ConfigFromTracesEnv)
 {
   const std::string url = "http://localhost:9999/v1/traces";
@@ -6,6 +6,7 @@
 #  include <gtest/gtest.h>
 
 #  include "opentelemetry/exporters/otlp/otlp_log_recordable.h"
+#  include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
 #  include "opentelemetry/sdk/resource/experimental_semantic_conventions.h"
 #  include "opentelemetry/sdk/resource/resource.h"
 
@@ -233,6 +234,40 @@ TYPED_TEST(OtlpLogRecordableIntAttributeTest, SetIntArrayAttribute)
               int_span[i]);
   }
 }
+
+TEST(OtlpLogRecordable, PopulateRequestGroupsOnArena)
+{
+  auto resource_1 = resource::Resource::Create({{"service.name", "one"}});
+  auto resource_2 = resource::Resource::Create({{"service.name", "two"}});
+  auto library_1  = sdk::instrumentationlibrary::InstrumentationLibrary::Create("library_1");
+  auto library_2  = sdk::instrumentationlibrary::InstrumentationLibrary::Create("library_2");
+
+  std::unique_ptr<sdk::logs::Recordable> recordables[4];
+  for (size_t i = 0; i < 4; ++i)
+  {
+    recordables[i].reset(new OtlpLogRecordable);
+    recordables[i]->SetResource(i == 2 ? resource_2 : resource_1);
+    recordables[i]->SetInstrumentationLibrary(i == 1 ? *library_2 : *library_1);
+    recordables[i]->SetBody("log " + std::to_string(i));
+  }
+
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto request = google::protobuf::Arena::CreateMessage<
+      proto::collector::logs::v1::ExportLogsServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(recordables, request);
+
+  ASSERT_EQ(request->resource_logs_size(), 2);
+  auto &resource_logs = request->resource_logs(0);
+  ASSERT_EQ(resource_logs.scope_logs_size(), 2);
+  EXPECT_EQ(resource_logs.scope_logs(0).scope().name(), "library_1");
+  ASSERT_EQ(resource_logs.scope_logs(0).log_records_size(), 2);
+  EXPECT_EQ(resource_logs.scope_logs(0).log_records(0).body().string_value(), "log 0");
+  EXPECT_EQ(resource_logs.scope_logs(0).log_records(1).body().string_value(), "log 3");
+  EXPECT_EQ(resource_logs.scope_logs(1).scope().name(), "library_2");
+  EXPECT_EQ(resource_logs.scope_logs(1).log_records(0).body().string_value(), "log 1");
+  ASSERT_EQ(request->resource_logs(1).scope_logs_size(), 1);
+  EXPECT_EQ(request->resource_logs(1).scope_logs(0).log_records(0).body().string_value(), "log 2");
+}
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
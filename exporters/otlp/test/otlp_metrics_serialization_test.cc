@@ -57,6 +57,8 @@ metrics_sdk::MetricData CreateHistogramAggregationData()
   s_data_1.count_      = 22;
   s_data_1.counts_     = {2, 9, 4, 7};
   s_data_1.boundaries_ = std::list<double>({0.0, 10.0, 20.0, 30.0});
+  s_data_1.min_        = -1.5;
+  s_data_1.max_        = 35.5;
   s_data_2.sum_        = 200.2;
   s_data_2.count_      = 20;
   s_data_2.counts_     = {0, 8, 5, 7};
@@ -78,6 +80,58 @@ metrics_sdk::MetricData CreateHistogramAggregationData()
   return data;
 }
 
+metrics_sdk::MetricData CreateExponentialHistogramAggregationData()
+{
+  metrics_sdk::MetricData data;
+  data.start_ts = opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  metrics_sdk::InstrumentDescriptor inst_desc = {"Histogram", "desc", "unit",
+                                                 metrics_sdk::InstrumentType::kHistogram,
+                                                 metrics_sdk::InstrumentValueType::kDouble};
+  metrics_sdk::ExponentialHistogramPointData s_data_1;
+  s_data_1.sum_                      = 100.2;
+  s_data_1.count_                    = 22;
+  s_data_1.zero_count_               = 2;
+  s_data_1.scale_                    = 3;
+  s_data_1.positive_buckets_.offset_ = -4;
+  s_data_1.positive_buckets_.counts_ = {2, 9, 4, 5};
+
+  data.aggregation_temporality = metrics_sdk::AggregationTemporality::kDelta;
+  data.end_ts = opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  data.instrument_descriptor = inst_desc;
+  metrics_sdk::PointDataAttributes point_data_attr_1;
+  point_data_attr_1.attributes = {{"k1", "v1"}};
+  point_data_attr_1.point_data = s_data_1;
+  data.point_data_attr_.push_back(point_data_attr_1);
+  return data;
+}
+
+metrics_sdk::MetricData CreateSketchAggregationData()
+{
+  metrics_sdk::MetricData data;
+  data.start_ts = opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  metrics_sdk::InstrumentDescriptor inst_desc = {"Counter", "desc", "unit",
+                                                 metrics_sdk::InstrumentType::kCounter,
+                                                 metrics_sdk::InstrumentValueType::kLong};
+  metrics_sdk::SketchPointData s_data_1;
+  s_data_1.sum_                      = 8l;
+  s_data_1.count_                    = 3;
+  s_data_1.zero_count_               = 1;
+  s_data_1.min_                      = 0;
+  s_data_1.max_                      = 6;
+  s_data_1.relative_accuracy_        = 0.5;
+  s_data_1.positive_buckets_.offset_ = 1;
+  s_data_1.positive_buckets_.counts_ = {1, 1};
+
+  data.aggregation_temporality = metrics_sdk::AggregationTemporality::kCumulative;
+  data.end_ts = opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  data.instrument_descriptor = inst_desc;
+  metrics_sdk::PointDataAttributes point_data_attr_1;
+  point_data_attr_1.attributes = {{"k1", "v1"}};
+  point_data_attr_1.point_data = s_data_1;
+  data.point_data_attr_.push_back(point_data_attr_1);
+  return data;
+}
+
 TEST(OtlpMetricsSerializationTest, Counter)
 {
   metrics_sdk::MetricData data = CreateSumAggregationData();
@@ -107,8 +161,142 @@ TEST(OtlpMetricsSerializationTest, Histogram)
     auto proto_number_point = histogram.data_points(i);
     EXPECT_EQ(proto_number_point.sum(), i == 0 ? 100.2 : 200.2);
   }
+  EXPECT_TRUE(histogram.data_points(0).has_min());
+  EXPECT_EQ(histogram.data_points(0).min(), -1.5);
+  EXPECT_EQ(histogram.data_points(0).max(), 35.5);
 
-  EXPECT_EQ(1, 1);
+  // Unknown extremes are not serialized.
+  nostd::get<metrics_sdk::HistogramPointData>(data.point_data_attr_[1].point_data)
+      .record_min_max_ = false;
+  histogram.Clear();
+  otlp_exporter::OtlpMetricsUtils::ConvertHistogramMetric(data, &histogram);
+  EXPECT_TRUE(histogram.data_points(0).has_min());
+  EXPECT_FALSE(histogram.data_points(1).has_min());
+  EXPECT_FALSE(histogram.data_points(1).has_max());
+}
+
+TEST(OtlpMetricsSerializationTest, ExponentialHistogram)
+{
+  metrics_sdk::MetricData data = CreateExponentialHistogramAggregationData();
+  opentelemetry::proto::metrics::v1::Metric metric;
+  otlp_exporter::OtlpMetricsUtils::PopulateInstrumentationInfoMetric(data, &metric);
+  ASSERT_TRUE(metric.has_exponential_histogram());
+  auto &histogram = metric.exponential_histogram();
+  EXPECT_EQ(histogram.aggregation_temporality(),
+            proto::metrics::v1::AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA);
+  ASSERT_EQ(histogram.data_points_size(), 1);
+  auto &proto_point = histogram.data_points(0);
+  EXPECT_EQ(proto_point.sum(), 100.2);
+  EXPECT_EQ(proto_point.count(), 22);
+  EXPECT_EQ(proto_point.zero_count(), 2);
+  EXPECT_EQ(proto_point.scale(), 3);
+  EXPECT_EQ(proto_point.positive().offset(), -4);
+  ASSERT_EQ(proto_point.positive().bucket_counts_size(), 4);
+  EXPECT_EQ(proto_point.positive().bucket_counts(1), 9);
+  EXPECT_EQ(proto_point.negative().bucket_counts_size(), 0);
+}
+
+TEST(OtlpMetricsSerializationTest, Sketch)
+{
+  metrics_sdk::MetricData data = CreateSketchAggregationData();
+  opentelemetry::proto::metrics::v1::Metric metric;
+  otlp_exporter::OtlpMetricsUtils::PopulateInstrumentationInfoMetric(data, &metric);
+  ASSERT_TRUE(metric.has_summary());
+  ASSERT_EQ(metric.summary().data_points_size(), 1);
+  auto &proto_point = metric.summary().data_points(0);
+  EXPECT_EQ(proto_point.sum(), 8);
+  EXPECT_EQ(proto_point.count(), 3);
+  ASSERT_EQ(proto_point.quantile_values_size(), 6);
+  EXPECT_EQ(proto_point.quantile_values(0).quantile(), 0.0);
+  EXPECT_EQ(proto_point.quantile_values(0).value(), 0.0);
+  // With gamma = 3, the median falls in bucket 1 of (1, 3], represented by 1.5.
+  EXPECT_EQ(proto_point.quantile_values(1).quantile(), 0.5);
+  EXPECT_EQ(proto_point.quantile_values(1).value(), 1.5);
+  EXPECT_EQ(proto_point.quantile_values(5).quantile(), 1.0);
+  EXPECT_EQ(proto_point.quantile_values(5).value(), 6.0);
+}
+
+TEST(OtlpMetricsSerializationTest, SplitsRequests)
+{
+  auto resource = resource::Resource::Create({{"service.name", "test"}});
+  auto library  = opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("lib");
+  metrics_sdk::ResourceMetrics data;
+  data.resource_ = &resource;
+  metrics_sdk::InstrumentationInfoMetrics library_metrics;
+  library_metrics.instrumentation_library_ = library.get();
+  library_metrics.metric_data_.push_back(CreateSumAggregationData());
+  auto histogram_data                       = CreateHistogramAggregationData();
+  histogram_data.instrument_descriptor.type_ = metrics_sdk::InstrumentType::kHistogram;
+  library_metrics.metric_data_.push_back(histogram_data);
+  data.instrumentation_info_metric_data_.push_back(library_metrics);
+
+  // The second metric is split across the requests.
+  std::vector<std::unique_ptr<otlp_exporter::OtlpMetricsUtils::ExportMetricsServiceRequest>>
+      requests;
+  EXPECT_TRUE(otlp_exporter::OtlpMetricsUtils::PopulateRequests(
+      data, 3,
+      [&](std::unique_ptr<otlp_exporter::OtlpMetricsUtils::ExportMetricsServiceRequest> &&request) {
+        requests.push_back(std::move(request));
+        return true;
+      }));
+  ASSERT_EQ(requests.size(), 2);
+  for (auto &request : requests)
+  {
+    ASSERT_EQ(request->resource_metrics_size(), 1);
+    auto &resource_metrics = request->resource_metrics(0);
+    EXPECT_GT(resource_metrics.resource().attributes_size(), 0);
+    ASSERT_EQ(resource_metrics.instrumentation_library_metrics_size(), 1);
+    EXPECT_EQ(resource_metrics.instrumentation_library_metrics(0).instrumentation_library().name(),
+              "lib");
+  }
+  auto &first = requests[0]->resource_metrics(0).instrumentation_library_metrics(0);
+  ASSERT_EQ(first.metrics_size(), 2);
+  EXPECT_EQ(first.metrics(0).sum().data_points_size(), 2);
+  EXPECT_EQ(first.metrics(1).histogram().data_points_size(), 1);
+  auto &second = requests[1]->resource_metrics(0).instrumentation_library_metrics(0);
+  ASSERT_EQ(second.metrics_size(), 1);
+  EXPECT_EQ(second.metrics(0).name(), "Histogram");
+  EXPECT_EQ(second.metrics(0).histogram().data_points_size(), 1);
+
+  // Without a limit, a single request holds all the points.
+  requests.clear();
+  EXPECT_TRUE(otlp_exporter::OtlpMetricsUtils::PopulateRequests(
+      data, 0,
+      [&](std::unique_ptr<otlp_exporter::OtlpMetricsUtils::ExportMetricsServiceRequest> &&request) {
+        requests.push_back(std::move(request));
+        return true;
+      }));
+  ASSERT_EQ(requests.size(), 1);
+  EXPECT_EQ(requests[0]->resource_metrics(0).instrumentation_library_metrics(0).metrics_size(), 2);
+}
+
+otlp_exporter::OtlpMetricsUtils::MetricPoints AllPoints(const metrics_sdk::MetricData &data)
+{
+  return otlp_exporter::OtlpMetricsUtils::MetricPoints(data.point_data_attr_.data(),
+                                                       data.point_data_attr_.size());
+}
+
+TEST(OtlpMetricsSerializationTest, CachesAttributes)
+{
+  metrics_sdk::MetricData data = CreateSumAggregationData();
+  otlp_exporter::OtlpMetricAttributesCache cache;
+  opentelemetry::proto::metrics::v1::Sum sum;
+  otlp_exporter::OtlpMetricsUtils::ConvertSumMetric(data, AllPoints(data), &sum, &cache);
+  cache.EndCollection();
+  EXPECT_EQ(cache.size(), 2);
+
+  // The next collection reuses the KeyValues of the same series.
+  data.point_data_attr_.pop_back();
+  sum.Clear();
+  otlp_exporter::OtlpMetricsUtils::ConvertSumMetric(data, AllPoints(data), &sum, &cache);
+  ASSERT_EQ(sum.data_points_size(), 1);
+  ASSERT_EQ(sum.data_points(0).attributes_size(), 1);
+  EXPECT_EQ(sum.data_points(0).attributes(0).key(), "k1");
+  EXPECT_EQ(sum.data_points(0).attributes(0).value().string_value(), "v1");
+
+  // Series absent from a collection are dropped.
+  cache.EndCollection();
+  EXPECT_EQ(cache.size(), 1);
 }
 
 }  // namespace otlp
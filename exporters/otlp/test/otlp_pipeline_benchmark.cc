@@ -0,0 +1,57 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_recordable.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "test/trace/pipeline_benchmark.h"
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace common   = opentelemetry::sdk::common;
+namespace nostd    = opentelemetry::nostd;
+namespace otlp     = opentelemetry::exporter::otlp;
+namespace sdktrace = opentelemetry::sdk::trace;
+
+namespace
+{
+// Serializes the spans the way the OTLP exporters do, without sending them, to measure the
+// pipeline up to the wire format.
+class OtlpSerializingSpanExporter final : public sdktrace::SpanExporter
+{
+public:
+  std::unique_ptr<sdktrace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdktrace::Recordable>(new otlp::OtlpRecordable);
+  }
+
+  common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdktrace::Recordable>> &spans) noexcept override
+  {
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+    otlp::OtlpRecordableUtils::PopulateRequest(spans, &request, &cache_);
+    request.SerializeToString(&buffer_);
+    benchmark::DoNotOptimize(buffer_.data());
+    return common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+private:
+  otlp::OtlpProtoCache cache_;
+  std::string buffer_;
+};
+
+void BM_PipelineOtlpSerializingExporter(benchmark::State &state)
+{
+  pipeline_benchmark::RunPipeline(state, [] {
+    return std::unique_ptr<sdktrace::SpanExporter>(new OtlpSerializingSpanExporter);
+  });
+}
+BENCHMARK(BM_PipelineOtlpSerializingExporter)->Apply(pipeline_benchmark::PipelineArguments);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/exporters/otlp/otlp_recordable.h"
+#include "opentelemetry/exporters/otlp/otlp_recordable_utils.h"
 #include <gtest/gtest.h>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -318,6 +319,75 @@ TYPED_TEST(IntAttributeTest, SetIntArrayAttribute)
     EXPECT_EQ(rec.span().attributes(0).value().array_value().values(i).int_value(), int_span[i]);
   }
 }
+
+TEST(OtlpRecordable, PopulateRequestOnArena)
+{
+  auto resource = resource::Resource::Create({{"service.name", "test"}});
+  auto library  = trace_sdk::InstrumentationLibrary::Create("test_library");
+  std::unique_ptr<trace_sdk::Recordable> recordables[2];
+  for (auto &recordable : recordables)
+  {
+    recordable.reset(new OtlpRecordable);
+    recordable->SetResource(resource);
+    recordable->SetInstrumentationLibrary(*library);
+  }
+  recordables[0]->SetName("span 1");
+  recordables[1]->SetName("span 2");
+
+  google::protobuf::Arena arena{OtlpRecordableUtils::GetArenaOptions()};
+  auto request = google::protobuf::Arena::CreateMessage<
+      proto::collector::trace::v1::ExportTraceServiceRequest>(&arena);
+  OtlpRecordableUtils::PopulateRequest(recordables, request);
+
+  // Spans sharing their resource and instrumentation library are grouped.
+  ASSERT_EQ(request->resource_spans_size(), 1);
+  ASSERT_EQ(request->resource_spans(0).instrumentation_library_spans_size(), 1);
+  auto &library_spans = request->resource_spans(0).instrumentation_library_spans(0);
+  ASSERT_EQ(library_spans.spans_size(), 2);
+  EXPECT_EQ(library_spans.spans(0).name(), "span 1");
+  EXPECT_EQ(library_spans.spans(1).name(), "span 2");
+  EXPECT_EQ(library_spans.instrumentation_library().name(), "test_library");
+}
+
+TEST(OtlpRecordable, PopulateRequestFromProtoCache)
+{
+  auto resource  = resource::Resource::Create({{"service.name", "test"}});
+  auto library_1 = trace_sdk::InstrumentationLibrary::Create("library_1", "1.0");
+  auto library_2 = trace_sdk::InstrumentationLibrary::Create("library_2");
+
+  OtlpProtoCache cache;
+  const auto &proto_resource = cache.GetResource(&resource);
+  EXPECT_EQ(&cache.GetResource(&resource), &proto_resource);
+  EXPECT_EQ(cache.GetResource(nullptr).attributes_size(), 0);
+
+  for (int batch = 0; batch < 2; ++batch)
+  {
+    std::unique_ptr<trace_sdk::Recordable> recordables[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+      recordables[i].reset(new OtlpRecordable);
+      recordables[i]->SetResource(resource);
+      recordables[i]->SetInstrumentationLibrary(i == 1 ? *library_2 : *library_1);
+      recordables[i]->SetName("span " + std::to_string(i));
+    }
+
+    proto::collector::trace::v1::ExportTraceServiceRequest request;
+    OtlpRecordableUtils::PopulateRequest(recordables, &request, &cache);
+
+    ASSERT_EQ(request.resource_spans_size(), 1);
+    auto &resource_spans = request.resource_spans(0);
+    ASSERT_EQ(resource_spans.resource().attributes_size(), proto_resource.attributes_size());
+    EXPECT_EQ(resource_spans.resource().attributes(0).key(), proto_resource.attributes(0).key());
+    ASSERT_EQ(resource_spans.instrumentation_library_spans_size(), 2);
+    auto &library_1_spans = resource_spans.instrumentation_library_spans(0);
+    EXPECT_EQ(library_1_spans.instrumentation_library().name(), "library_1");
+    EXPECT_EQ(library_1_spans.instrumentation_library().version(), "1.0");
+    ASSERT_EQ(library_1_spans.spans_size(), 2);
+    EXPECT_EQ(library_1_spans.spans(1).name(), "span 2");
+    EXPECT_EQ(resource_spans.instrumentation_library_spans(1).instrumentation_library().name(),
+              "library_2");
+  }
+}
 }  // namespace otlp
 }  // namespace exporter
 OPENTELEMETRY_END_NAMESPACE
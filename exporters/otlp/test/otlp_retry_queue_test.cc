@@ -0,0 +1,150 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/otlp/otlp_retry_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+namespace
+{
+OtlpAttemptResult MakeResult(OtlpAttemptStatus status)
+{
+  OtlpAttemptResult result;
+  result.status = status;
+  return result;
+}
+
+OtlpRetryOptions MakeFastOptions()
+{
+  OtlpRetryOptions options;
+  options.initial_backoff = std::chrono::milliseconds(1);
+  options.max_backoff     = std::chrono::milliseconds(2);
+  return options;
+}
+
+template <class Predicate>
+bool WaitFor(Predicate predicate)
+{
+  for (int i = 0; i < 1000 && !predicate(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return predicate();
+}
+}  // namespace
+
+TEST(OtlpRetryQueue, RetriesUntilSuccess)
+{
+  OtlpRetryQueue queue(MakeFastOptions());
+  std::atomic<int> calls{0};
+  ASSERT_TRUE(queue.Enqueue(
+      [&calls]() {
+        return MakeResult(++calls < 2 ? OtlpAttemptStatus::kRetryableFailure
+                                      : OtlpAttemptStatus::kSuccess);
+      },
+      MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+
+  ASSERT_TRUE(WaitFor([&queue] { return queue.GetStatistics().recovered == 1; }));
+  auto statistics = queue.GetStatistics();
+  EXPECT_EQ(statistics.retries, 2u);
+  EXPECT_EQ(statistics.dropped, 0u);
+  EXPECT_EQ(statistics.queue_size, 0u);
+  EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(OtlpRetryQueue, DropsAfterMaxAttempts)
+{
+  auto options         = MakeFastOptions();
+  options.max_attempts = 3;
+  OtlpRetryQueue queue(options);
+  std::atomic<int> calls{0};
+  ASSERT_TRUE(queue.Enqueue(
+      [&calls]() {
+        ++calls;
+        return MakeResult(OtlpAttemptStatus::kRetryableFailure);
+      },
+      MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+
+  ASSERT_TRUE(WaitFor([&queue] { return queue.GetStatistics().dropped == 1; }));
+  EXPECT_EQ(queue.GetStatistics().retries, 2u);
+  EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(OtlpRetryQueue, DropsPermanentFailures)
+{
+  OtlpRetryQueue queue(MakeFastOptions());
+  EXPECT_FALSE(queue.Enqueue([]() { return MakeResult(OtlpAttemptStatus::kSuccess); },
+                             MakeResult(OtlpAttemptStatus::kFailure)));
+
+  std::atomic<int> calls{0};
+  ASSERT_TRUE(queue.Enqueue(
+      [&calls]() {
+        ++calls;
+        return MakeResult(OtlpAttemptStatus::kFailure);
+      },
+      MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+  ASSERT_TRUE(WaitFor([&queue] { return queue.GetStatistics().dropped == 2; }));
+  EXPECT_EQ(calls.load(), 1);
+}
+
+TEST(OtlpRetryQueue, DropsOldestWhenFull)
+{
+  OtlpRetryOptions options;
+  options.initial_backoff = std::chrono::hours(1);
+  options.max_backoff     = std::chrono::hours(1);
+  options.max_queue_size  = 1;
+  OtlpRetryQueue queue(options);
+
+  auto attempt = []() { return MakeResult(OtlpAttemptStatus::kSuccess); };
+  ASSERT_TRUE(queue.Enqueue(attempt, MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+  ASSERT_TRUE(queue.Enqueue(attempt, MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+  auto statistics = queue.GetStatistics();
+  EXPECT_EQ(statistics.dropped, 1u);
+  EXPECT_EQ(statistics.queue_size, 1u);
+
+  // The queued export is dropped at shutdown, and no export is queued afterwards.
+  queue.Shutdown();
+  EXPECT_FALSE(queue.Enqueue(attempt, MakeResult(OtlpAttemptStatus::kRetryableFailure)));
+  statistics = queue.GetStatistics();
+  EXPECT_EQ(statistics.retries, 0u);
+  EXPECT_EQ(statistics.dropped, 3u);
+  EXPECT_EQ(statistics.queue_size, 0u);
+}
+
+TEST(OtlpRetryQueue, Backoff)
+{
+  OtlpRetryQueue queue(OtlpRetryOptions{});
+  auto result = MakeResult(OtlpAttemptStatus::kRetryableFailure);
+
+  // Jittered between half and all of 1s, 1.5s and the 5s maximum.
+  for (int i = 0; i < 100; ++i)
+  {
+    auto first = queue.GetBackoff(2, result).count();
+    EXPECT_GE(first, 500);
+    EXPECT_LE(first, 1000);
+    auto second = queue.GetBackoff(3, result).count();
+    EXPECT_GE(second, 750);
+    EXPECT_LE(second, 1500);
+    auto last = queue.GetBackoff(20, result).count();
+    EXPECT_GE(last, 2500);
+    EXPECT_LE(last, 5000);
+  }
+
+  // A delay requested by the server is used as it is.
+  result.retry_delay = std::chrono::milliseconds(7000);
+  EXPECT_EQ(queue.GetBackoff(2, result).count(), 7000);
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
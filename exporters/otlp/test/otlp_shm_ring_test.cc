@@ -0,0 +1,225 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#if !defined(_WIN32)
+
+#  include "opentelemetry/exporters/otlp/otlp_shm_client.h"
+#  include "opentelemetry/exporters/otlp/otlp_shm_ring.h"
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_prefix.h"
+
+#  include <google/protobuf/wrappers.pb.h>
+
+#  include "opentelemetry/exporters/otlp/protobuf_include_suffix.h"
+
+#  include <gtest/gtest.h>
+
+#  include <unistd.h>
+#  include <cstdlib>
+#  include <cstring>
+#  include <string>
+#  include <thread>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+class OtlpShmRingTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char path[] = "/tmp/otlp_shm_XXXXXX";
+    int fd      = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    options_.path = path;
+    options_.size = 256;
+  }
+
+  void TearDown() override { unlink(options_.path.c_str()); }
+
+  static bool Write(OtlpShmRing &ring, OtlpShmRecordType type, const std::string &record)
+  {
+    uint8_t *payload = ring.Reserve(record.size());
+    if (payload == nullptr)
+    {
+      return false;
+    }
+    std::memcpy(payload, record.data(), record.size());
+    ring.Commit(type, record.size());
+    return true;
+  }
+
+  static std::string Read(OtlpShmRing &ring, OtlpShmRecordType expected_type)
+  {
+    OtlpShmRecordType type;
+    nostd::span<const uint8_t> payload;
+    if (!ring.Front(type, payload))
+    {
+      return "";
+    }
+    EXPECT_EQ(type, expected_type);
+    std::string record(payload.begin(), payload.end());
+    ring.Pop();
+    return record;
+  }
+
+  OtlpShmRingOptions options_;
+};
+
+TEST_F(OtlpShmRingTest, WriteAndReadInOrder)
+{
+  OtlpShmRing writer;
+  ASSERT_TRUE(writer.OpenWriter(options_));
+  OtlpShmRing reader;
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "");
+
+  ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, "spans"));
+  ASSERT_TRUE(Write(writer, OtlpShmRecordType::kLogs, "logs"));
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "spans");
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kLogs), "logs");
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "");
+}
+
+TEST_F(OtlpShmRingTest, WrapAroundWithPadding)
+{
+  OtlpShmRing writer;
+  ASSERT_TRUE(writer.OpenWriter(options_));
+  OtlpShmRing reader;
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+
+  // Records of 48 bytes with their header never end exactly at the end of the 256 bytes ring.
+  for (int i = 0; i < 20; ++i)
+  {
+    std::string record = "record-" + std::to_string(i) + std::string(30, 'x');
+    ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, record));
+    EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), record);
+  }
+  EXPECT_EQ(writer.GetDroppedCount(), 0u);
+}
+
+TEST_F(OtlpShmRingTest, DropWhenFull)
+{
+  OtlpShmRing writer;
+  ASSERT_TRUE(writer.OpenWriter(options_));
+  OtlpShmRing reader;
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+
+  const std::string record(56, 'x');
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, record));
+  }
+  EXPECT_FALSE(Write(writer, OtlpShmRecordType::kTraces, record));
+  EXPECT_FALSE(Write(writer, OtlpShmRecordType::kTraces, std::string(1000, 'x')));
+  EXPECT_EQ(writer.GetDroppedCount(), 2u);
+  EXPECT_EQ(reader.GetDroppedCount(), 2u);
+
+  // Reading a record makes room for another.
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), record);
+  EXPECT_TRUE(Write(writer, OtlpShmRecordType::kTraces, record));
+}
+
+TEST_F(OtlpShmRingTest, RestartWriter)
+{
+  OtlpShmRing reader;
+  {
+    OtlpShmRing writer;
+    ASSERT_TRUE(writer.OpenWriter(options_));
+    ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, "first"));
+    ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, "second"));
+    ASSERT_TRUE(reader.OpenReader(options_.path));
+    EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "first");
+  }
+
+  // A writer of the same ring keeps its unread records.
+  {
+    OtlpShmRing writer;
+    ASSERT_TRUE(writer.OpenWriter(options_));
+    ASSERT_TRUE(Write(writer, OtlpShmRecordType::kTraces, "third"));
+    EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "second");
+    EXPECT_EQ(Read(reader, OtlpShmRecordType::kTraces), "third");
+  }
+
+  // A writer of another size initializes the ring again, which a reader must map again.
+  options_.size = 512;
+  OtlpShmRing writer;
+  ASSERT_TRUE(writer.OpenWriter(options_));
+  ASSERT_TRUE(Write(writer, OtlpShmRecordType::kLogs, "fourth"));
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kLogs), "");
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+  EXPECT_EQ(Read(reader, OtlpShmRecordType::kLogs), "fourth");
+}
+
+TEST_F(OtlpShmRingTest, ConcurrentWriterAndReader)
+{
+  OtlpShmRing writer;
+  ASSERT_TRUE(writer.OpenWriter(options_));
+  OtlpShmRing reader;
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+
+  const int kRecords = 10000;
+  std::thread producer([&writer] {
+    for (int i = 0; i < kRecords;)
+    {
+      if (Write(writer, OtlpShmRecordType::kTraces, std::to_string(i)))
+      {
+        ++i;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int i = 0; i < kRecords;)
+  {
+    OtlpShmRecordType type;
+    nostd::span<const uint8_t> payload;
+    if (!reader.Front(type, payload))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(std::string(payload.begin(), payload.end()), std::to_string(i));
+    reader.Pop();
+    ++i;
+  }
+  producer.join();
+}
+
+TEST_F(OtlpShmRingTest, ClientSerializesInPlace)
+{
+  OtlpShmClient client(options_);
+  OtlpShmRing reader;
+  ASSERT_TRUE(reader.OpenReader(options_.path));
+
+  google::protobuf::StringValue message;
+  message.set_value("request");
+  EXPECT_EQ(client.Export(OtlpShmRecordType::kLogs, message), sdk::common::ExportResult::kSuccess);
+  message.set_value(std::string(1000, 'x'));
+  EXPECT_EQ(client.Export(OtlpShmRecordType::kLogs, message), sdk::common::ExportResult::kFailure);
+  EXPECT_EQ(client.GetDroppedCount(), 1u);
+
+  OtlpShmRecordType type;
+  nostd::span<const uint8_t> payload;
+  ASSERT_TRUE(reader.Front(type, payload));
+  EXPECT_EQ(type, OtlpShmRecordType::kLogs);
+  google::protobuf::StringValue parsed;
+  ASSERT_TRUE(parsed.ParseFromArray(payload.data(), static_cast<int>(payload.size())));
+  EXPECT_EQ(parsed.value(), "request");
+
+  EXPECT_TRUE(client.Shutdown());
+  message.set_value("late");
+  EXPECT_EQ(client.Export(OtlpShmRecordType::kLogs, message), sdk::common::ExportResult::kFailure);
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+
+#endif
@@ -0,0 +1,216 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#if !defined(_WIN32)
+
+#  include "opentelemetry/exporters/otlp/otlp_spill_file.h"
+
+#  include <gtest/gtest.h>
+
+#  include <dirent.h>
+#  include <unistd.h>
+#  include <cstdio>
+#  include <cstdlib>
+#  include <string>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace otlp
+{
+
+class OtlpSpillFileTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    char directory[] = "/tmp/otlp_spill_XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    options_.directory    = directory;
+    options_.segment_size = 64;
+    options_.max_size     = 1024;
+  }
+
+  void TearDown() override
+  {
+    for (const auto &file : ListSegments())
+    {
+      unlink((options_.directory + "/" + file).c_str());
+    }
+    rmdir(options_.directory.c_str());
+  }
+
+  std::vector<std::string> ListSegments()
+  {
+    std::vector<std::string> files;
+    DIR *directory = opendir(options_.directory.c_str());
+    if (directory == nullptr)
+    {
+      return files;
+    }
+    while (struct dirent *entry = readdir(directory))
+    {
+      std::string name = entry->d_name;
+      if (name != "." && name != "..")
+      {
+        files.push_back(name);
+      }
+    }
+    closedir(directory);
+    return files;
+  }
+
+  static bool Append(OtlpSpillFile &spill_file, const std::string &record)
+  {
+    std::vector<nostd::span<const uint8_t>> parts;
+    parts.emplace_back(reinterpret_cast<const uint8_t *>(record.data()), record.size());
+    return spill_file.Append(parts);
+  }
+
+  static std::string Front(OtlpSpillFile &spill_file)
+  {
+    std::vector<uint8_t> record;
+    if (!spill_file.Front(record))
+    {
+      return "";
+    }
+    return std::string(record.begin(), record.end());
+  }
+
+  OtlpSpillOptions options_;
+};
+
+TEST_F(OtlpSpillFileTest, AppendAndPopInOrder)
+{
+  OtlpSpillFile spill_file(options_);
+  ASSERT_TRUE(spill_file.Open());
+  EXPECT_TRUE(spill_file.Empty());
+
+  const std::string head = "head-";
+  const std::string tail = "tail";
+  std::vector<nostd::span<const uint8_t>> parts;
+  parts.emplace_back(reinterpret_cast<const uint8_t *>(head.data()), head.size());
+  parts.emplace_back(reinterpret_cast<const uint8_t *>(tail.data()), tail.size());
+  ASSERT_TRUE(spill_file.Append(parts));
+  ASSERT_TRUE(Append(spill_file, "second"));
+  ASSERT_TRUE(Append(spill_file, "third"));
+
+  EXPECT_FALSE(spill_file.Empty());
+  EXPECT_EQ(Front(spill_file), "head-tail");
+  spill_file.Pop();
+  EXPECT_EQ(Front(spill_file), "second");
+  spill_file.Pop();
+  EXPECT_EQ(Front(spill_file), "third");
+  spill_file.Pop();
+  EXPECT_TRUE(spill_file.Empty());
+  EXPECT_EQ(Front(spill_file), "");
+}
+
+TEST_F(OtlpSpillFileTest, RecoverAfterReopen)
+{
+  {
+    OtlpSpillFile spill_file(options_);
+    ASSERT_TRUE(spill_file.Open());
+    for (const char *record : {"first", "second", "third"})
+    {
+      ASSERT_TRUE(Append(spill_file, record));
+    }
+    spill_file.Pop();
+  }
+
+  // The popped record is not read again.
+  OtlpSpillFile spill_file(options_);
+  ASSERT_TRUE(spill_file.Open());
+  EXPECT_EQ(Front(spill_file), "second");
+  spill_file.Pop();
+  ASSERT_TRUE(Append(spill_file, "fourth"));
+  EXPECT_EQ(Front(spill_file), "third");
+  spill_file.Pop();
+  EXPECT_EQ(Front(spill_file), "fourth");
+  spill_file.Pop();
+  EXPECT_TRUE(spill_file.Empty());
+}
+
+TEST_F(OtlpSpillFileTest, RemoveReadSegments)
+{
+  OtlpSpillFile spill_file(options_);
+  ASSERT_TRUE(spill_file.Open());
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(Append(spill_file, "record-" + std::to_string(i)));
+  }
+  EXPECT_GT(ListSegments().size(), 1u);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(Front(spill_file), "record-" + std::to_string(i));
+    spill_file.Pop();
+  }
+  EXPECT_TRUE(spill_file.Empty());
+  EXPECT_EQ(ListSegments().size(), 1u);
+
+  // A record larger than a segment gets a segment of its own.
+  std::string large(1000, 'x');
+  ASSERT_TRUE(Append(spill_file, large));
+  EXPECT_EQ(Front(spill_file), large);
+}
+
+TEST_F(OtlpSpillFileTest, DropOldestSegmentBeyondMaxSize)
+{
+  options_.max_size = 128;
+  OtlpSpillFile spill_file(options_);
+  ASSERT_TRUE(spill_file.Open());
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(Append(spill_file, "record-" + std::to_string(i)));
+  }
+
+  EXPECT_LE(ListSegments().size(), 2u);
+  EXPECT_GT(spill_file.GetDroppedCount(), 0u);
+  EXPECT_EQ(Front(spill_file), "record-" + std::to_string(spill_file.GetDroppedCount()));
+}
+
+TEST_F(OtlpSpillFileTest, TruncateTornRecord)
+{
+  options_.segment_size = 4096;
+  {
+    OtlpSpillFile spill_file(options_);
+    ASSERT_TRUE(spill_file.Open());
+    ASSERT_TRUE(Append(spill_file, "intact"));
+    ASSERT_TRUE(Append(spill_file, "torn"));
+  }
+
+  // Corrupt the payload of the second record: a 16 bytes segment header, then 8 bytes of record
+  // header and 6 bytes of payload for the first record, and 8 bytes of record header.
+  auto segments = ListSegments();
+  ASSERT_EQ(segments.size(), 1u);
+  FILE *file = std::fopen((options_.directory + "/" + segments[0]).c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fseek(file, 16 + 8 + 6 + 8, SEEK_SET);
+  std::fputc('T', file);
+  std::fclose(file);
+
+  OtlpSpillFile spill_file(options_);
+  ASSERT_TRUE(spill_file.Open());
+  ASSERT_TRUE(Append(spill_file, "appended"));
+  EXPECT_EQ(Front(spill_file), "intact");
+  spill_file.Pop();
+  EXPECT_EQ(Front(spill_file), "appended");
+  spill_file.Pop();
+  EXPECT_TRUE(spill_file.Empty());
+}
+
+TEST_F(OtlpSpillFileTest, OpenMissingDirectory)
+{
+  OtlpSpillOptions options = options_;
+  options.directory += "/missing";
+  OtlpSpillFile spill_file(options);
+  EXPECT_FALSE(spill_file.Open());
+}
+
+}  // namespace otlp
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+
+#endif  // !defined(_WIN32)
@@ -4,13 +4,16 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 
+#  include <chrono>
 #  include <memory>
 #  include <mutex>
+#  include <string>
 #  include <vector>
 
 #  include <prometheus/collectable.h>
 #  include <prometheus/metric_family.h>
 #  include "opentelemetry/exporters/prometheus/exporter_utils.h"
+#  include "opentelemetry/exporters/prometheus/scrape_cache.h"
 
 namespace prometheus_client = ::prometheus;
 
@@ -30,8 +33,13 @@ class PrometheusCollector : public prometheus_client::Collectable
    *
    * This constructor initializes the collection for metrics to export
    * in this class with default capacity
+   *
+   * @param scrape_cache_ttl how long the result of a scrape is served to the following ones,
+   * concurrent scrapes share one collection in any case
    */
-  explicit PrometheusCollector(size_t max_collection_size = 2048);
+  explicit PrometheusCollector(
+      size_t max_collection_size                 = 2048,
+      std::chrono::milliseconds scrape_cache_ttl = std::chrono::milliseconds(0));
 
   /**
    * Collects all metrics data from metricsToCollect collection.
@@ -40,6 +48,14 @@ class PrometheusCollector : public prometheus_client::Collectable
    */
   std::vector<prometheus_client::MetricFamily> Collect() const override;
 
+  /**
+   * Collects all metrics data from metricsToCollect collection, appending it to out in the text
+   * exposition format without building MetricFamily objects.
+   *
+   * @param out the buffer to append to, such as the body of an HTTP response
+   */
+  void CollectText(std::string &out) const;
+
   /**
    * This function is called by export() function and add the collection of
    * records to the metricsToCollect collection
@@ -80,6 +96,22 @@ class PrometheusCollector : public prometheus_client::Collectable
    * Lock when operating the metricsToCollect collection
    */
   mutable std::mutex collection_lock_;
+
+  /**
+   * Sanitized names and labels of the series of the previous collections.
+   */
+  mutable PrometheusNameCache name_cache_;
+
+  /*
+   * Lock when using name_cache_, held while a collection is translated
+   */
+  mutable std::mutex name_cache_lock_;
+
+  /**
+   * Results of the recent scrapes, by Collect and CollectText
+   */
+  mutable PrometheusScrapeCache<std::vector<prometheus_client::MetricFamily>> families_cache_;
+  mutable PrometheusScrapeCache<std::string> text_cache_;
 };
 }  // namespace metrics
 }  // namespace exporter
@@ -3,6 +3,7 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
+#  include <chrono>
 #  include <memory>
 #  include <string>
 #  include <vector>
@@ -44,6 +45,16 @@ struct PrometheusExporterOptions
 {
   // The endpoint the Prometheus backend can collect metrics from
   std::string url = GetPrometheusDefaultHttpEndpoint();
+
+  // Serve url with the Exposer of prometheus-cpp. Applications which serve the metrics from their
+  // own HTTP server set this to false and write the body of the responses with
+  // PrometheusExporter::WriteTextFormat, which skips the MetricFamily objects of prometheus-cpp.
+  bool use_exposer = true;
+
+  // How long the result of a scrape is served to the following scrapes, instead of collecting
+  // again. Scrapes which arrive while another one collects share its result in any case, so that
+  // several Prometheus servers scraping at the same moment trigger a single collection.
+  std::chrono::milliseconds scrape_cache_ttl = std::chrono::milliseconds(0);
 };
 
 class PrometheusExporter : public sdk::metrics::MetricExporter
@@ -78,6 +89,13 @@ class PrometheusExporter : public sdk::metrics::MetricExporter
    */
   bool Shutdown(std::chrono::microseconds timeout = std::chrono::microseconds(0)) noexcept override;
 
+  /**
+   * Appends the metrics exported since the previous scrape to out, in the Prometheus text
+   * exposition format (content type "text/plain; version=0.0.4").
+   * @param out: the buffer to append to, such as the body of an HTTP response
+   */
+  void WriteTextFormat(std::string &out) const;
+
   /**
    * @return: returns a shared_ptr to
    * the PrometheusCollector instance
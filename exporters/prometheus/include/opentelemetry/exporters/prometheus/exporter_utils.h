@@ -6,7 +6,9 @@
 #ifndef ENABLE_METRICS_PREVIEW
 
 #  include <prometheus/metric_family.h>
+#  include <cstdint>
 #  include <string>
+#  include <unordered_map>
 #  include <vector>
 #  include "opentelemetry/metrics/provider.h"
 #  include "opentelemetry/sdk/metrics/meter.h"
@@ -17,6 +19,69 @@ namespace exporter
 {
 namespace metrics
 {
+/**
+ * Sanitized metric names and label sets of the series seen by previous scrapes, so that a scrape
+ * only sanitizes and formats the instruments and attribute sets which are new.
+ *
+ * Entries which are not used between two calls to Sweep() are removed by the second one. This
+ * class is not thread safe.
+ */
+class PrometheusNameCache
+{
+public:
+  /**
+   * Returns the sanitized metric name of an instrument.
+   */
+  const std::string &GetMetricName(const std::string &instrument_name);
+
+  /**
+   * Returns the labels of an attribute set.
+   */
+  const std::vector<::prometheus::ClientMetric::Label> &GetLabels(
+      const sdk::metrics::PointAttributes &attributes);
+
+  /**
+   * Returns the labels of an attribute set in the text exposition format, without braces:
+   * name1="value1",name2="value2".
+   */
+  const std::string &GetLabelText(const sdk::metrics::PointAttributes &attributes);
+
+  /**
+   * Removes the entries which were not used since the previous call.
+   */
+  void Sweep();
+
+  size_t GetMetricNameCount() const { return metric_names_.size(); }
+
+  size_t GetLabelSetCount() const { return label_set_count_; }
+
+private:
+  struct MetricName
+  {
+    std::string sanitized;
+    uint64_t last_used;
+  };
+
+  struct LabelSet
+  {
+    sdk::metrics::PointAttributes attributes;
+    // Each form is built the first time it is requested
+    bool has_labels;
+    bool has_text;
+    std::vector<::prometheus::ClientMetric::Label> labels;
+    std::string text;
+    uint64_t last_used;
+  };
+
+  LabelSet &FindLabelSet(const sdk::metrics::PointAttributes &attributes);
+
+  uint64_t generation_ = 0;
+  std::unordered_map<std::string, MetricName> metric_names_;
+  // Label sets by the hash of their attributes
+  std::unordered_map<size_t, std::vector<LabelSet>> label_sets_;
+  size_t label_set_count_ = 0;
+};
+
 /**
  * The Prometheus Utils contains utility functions for Prometheus Exporter
  */
@@ -33,7 +98,50 @@ class PrometheusExporterUtils
   static std::vector<::prometheus::MetricFamily> TranslateToPrometheus(
       const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data);
 
+  /**
+   * Same as above, taking the names and labels of the series from cache.
+   */
+  static std::vector<::prometheus::MetricFamily> TranslateToPrometheus(
+      const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data,
+      PrometheusNameCache &cache);
+
+  /**
+   * Append metrics data collection to out in the Prometheus text exposition format (version
+   * 0.0.4), without building MetricFamily objects. The output holds the same series as the result
+   * of TranslateToPrometheus.
+   *
+   * @param data a collection of metrics in OpenTelemetry
+   * @param cache the names and labels of the series
+   * @param out the buffer to append to
+   */
+  static void WriteTextFormat(
+      const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data,
+      PrometheusNameCache &cache,
+      std::string &out);
+
+  /**
+   * Same as above, for the metrics of a single collection, such as those passed by
+   * MetricReader::Collect to its callback.
+   */
+  static std::vector<::prometheus::MetricFamily> TranslateToPrometheus(
+      const sdk::metrics::ResourceMetrics &data,
+      PrometheusNameCache &cache);
+
+  static void WriteTextFormat(const sdk::metrics::ResourceMetrics &data,
+                              PrometheusNameCache &cache,
+                              std::string &out);
+
 private:
+  friend class PrometheusNameCache;
+
+  static void TranslateResourceMetrics(const sdk::metrics::ResourceMetrics &data,
+                                       PrometheusNameCache &cache,
+                                       std::vector<::prometheus::MetricFamily> &output);
+
+  static void WriteResourceMetrics(const sdk::metrics::ResourceMetrics &data,
+                                   PrometheusNameCache &cache,
+                                   std::string &out);
+
   /**
    * Sanitize the given metric name or label according to Prometheus rule.
    *
@@ -57,7 +165,7 @@ class PrometheusExporterUtils
    */
   template <typename T>
   static void SetData(std::vector<T> values,
-                      const opentelemetry::sdk::metrics::PointAttributes &labels,
+                      const std::vector<::prometheus::ClientMetric::Label> &labels,
                       ::prometheus::MetricType type,
                       std::chrono::nanoseconds time,
                       ::prometheus::MetricFamily *metric_family);
@@ -70,7 +178,7 @@ class PrometheusExporterUtils
   static void SetData(std::vector<T> values,
                       const opentelemetry::sdk::metrics::ListType &boundaries,
                       const std::vector<uint64_t> &counts,
-                      const opentelemetry::sdk::metrics::PointAttributes &labels,
+                      const std::vector<::prometheus::ClientMetric::Label> &labels,
                       std::chrono::nanoseconds time,
                       ::prometheus::MetricFamily *metric_family);
 
@@ -79,7 +187,30 @@ class PrometheusExporterUtils
    */
   static void SetMetricBasic(::prometheus::ClientMetric &metric,
                              std::chrono::nanoseconds time,
-                             const opentelemetry::sdk::metrics::PointAttributes &labels);
+                             const std::vector<::prometheus::ClientMetric::Label> &labels);
+
+  /**
+   * Append a sample to out in the text exposition format.
+   * @param labels the labels of the series, without braces
+   * @param le the upper bound of a histogram bucket, nullptr for other samples
+   */
+  static void WriteSample(const std::string &name,
+                          const char *suffix,
+                          const std::string &labels,
+                          const double *le,
+                          double value,
+                          int64_t timestamp_ms,
+                          std::string &out);
+
+  /**
+   * Append a value to out the way the text serializer of prometheus-cpp writes it.
+   */
+  static void WriteDouble(double value, std::string &out);
+
+  /**
+   * Append text to out, escaping '\\', '\n' and, if escape_quote is true, '"'.
+   */
+  static void WriteEscaped(const std::string &text, bool escape_quote, std::string &out);
 
   /**
    * Convert attribute value to string
@@ -105,7 +236,7 @@ class PrometheusExporterUtils
    */
   template <typename T, typename U>
   static void SetValue(std::vector<T> values,
-                       const std::list<U> &boundaries,
+                       const opentelemetry::sdk::metrics::HistogramBoundaries<U> &boundaries,
                        const std::vector<uint64_t> &counts,
                        ::prometheus::ClientMetric *metric);
 };
@@ -0,0 +1,74 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+#  include <prometheus/exposer.h>
+#  include <prometheus/metric_family.h>
+#  include "opentelemetry/exporters/prometheus/exporter.h"
+#  include "opentelemetry/sdk/metrics/metric_reader.h"
+#  include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace metrics
+{
+class PrometheusReaderCollectable;
+
+/**
+ * A MetricReader which collects the metrics of the SDK when Prometheus scrapes them, instead of
+ * buffering what a periodic reader exported like PrometheusExporter does. Each scrape sees the
+ * current values, unless a scrape less than options.scrape_cache_ttl old collected them: only the
+ * result of the last scrape is held in memory between two scrapes. Concurrent scrapes share one
+ * collection.
+ *
+ * The reader is added to the MeterProvider, which owns it:
+ *
+ *   meter_provider->AddMetricReader(
+ *       std::unique_ptr<sdk::metrics::MetricReader>(new PrometheusMetricReader(options)));
+ */
+class PrometheusMetricReader : public sdk::metrics::MetricReader
+{
+public:
+  /**
+   * @param options: the endpoint served by the Exposer of prometheus-cpp, if
+   * options.use_exposer is true
+   */
+  explicit PrometheusMetricReader(const PrometheusExporterOptions &options);
+
+  ~PrometheusMetricReader() override;
+
+  /**
+   * Collects the metrics of the SDK.
+   * @return: the metrics as Prometheus metric families, empty once shut down
+   */
+  std::vector<::prometheus::MetricFamily> CollectFamilies() noexcept;
+
+  /**
+   * Collects the metrics of the SDK and appends them to out in the Prometheus text exposition
+   * format, for applications which serve the endpoint themselves.
+   * @param out: the buffer to append to, such as the body of an HTTP response
+   */
+  void WriteTextFormat(std::string &out) noexcept;
+
+private:
+  bool OnForceFlush(std::chrono::microseconds timeout) noexcept override;
+
+  bool OnShutDown(std::chrono::microseconds timeout) noexcept override;
+
+  const PrometheusExporterOptions options_;
+
+  std::shared_ptr<PrometheusReaderCollectable> collectable_;
+
+  // Destroyed first, so that no scrape runs while the reader is destroyed
+  std::unique_ptr<::prometheus::Exposer> exposer_;
+};
+}  // namespace metrics
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+#endif  // ENABLE_METRICS_PREVIEW
@@ -0,0 +1,75 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace metrics
+{
+/**
+ * Coalesces the scrapes of a Prometheus endpoint, so that several servers scraping at the same
+ * moment, e.g. a pair of Prometheus servers and a curl, trigger one collection instead of one each.
+ *
+ * A scrape which arrives while another one collects waits for it and is served its result. The
+ * result is then served to the following scrapes until ttl has elapsed since the collection; with a
+ * ttl of zero, only the concurrent scrapes share a collection.
+ *
+ * @tparam T the result of a scrape, such as the rendered body of the response
+ */
+template <class T>
+class PrometheusScrapeCache
+{
+public:
+  explicit PrometheusScrapeCache(std::chrono::steady_clock::duration ttl) : ttl_(ttl) {}
+
+  /**
+   * Returns the result of the collection in progress, or of a collection which is less than ttl
+   * old, or else calls collect and caches its result.
+   * @param collect: a callable collecting and returning a T
+   */
+  template <class Collect>
+  T Get(Collect collect)
+  {
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> guard(lock_);
+    auto now = std::chrono::steady_clock::now();
+    // A collection completed while this scrape waited for the lock.
+    bool collected = generation_.load(std::memory_order_relaxed) != generation;
+    if (!collected && (generation == 0 || now >= expiry_))
+    {
+      value_  = collect();
+      expiry_ = now + ttl_;
+      generation_.fetch_add(1, std::memory_order_release);
+    }
+    return value_;
+  }
+
+private:
+  const std::chrono::steady_clock::duration ttl_;
+
+  /*
+   * Lock held during a collection, which the concurrent scrapes wait for
+   */
+  std::mutex lock_;
+
+  /**
+   * Number of collections so far, read before waiting for lock_
+   */
+  std::atomic<uint64_t> generation_{0};
+
+  std::chrono::steady_clock::time_point expiry_;
+
+  T value_;
+};
+}  // namespace metrics
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
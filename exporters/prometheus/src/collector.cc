@@ -5,6 +5,8 @@
 
 #  include "opentelemetry/exporters/prometheus/collector.h"
 
+#  include <mutex>
+
 namespace metric_sdk = opentelemetry::sdk::metrics;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -18,8 +20,11 @@ namespace metrics
  * This constructor initializes the collection for metrics to export
  * in this class with default capacity
  */
-PrometheusCollector::PrometheusCollector(size_t max_collection_size)
-    : max_collection_size_(max_collection_size)
+PrometheusCollector::PrometheusCollector(size_t max_collection_size,
+                                         std::chrono::milliseconds scrape_cache_ttl)
+    : max_collection_size_(max_collection_size),
+      families_cache_(scrape_cache_ttl),
+      text_cache_(scrape_cache_ttl)
 {}
 
 /**
@@ -29,22 +34,49 @@ PrometheusCollector::PrometheusCollector(size_t max_collection_size)
  */
 std::vector<prometheus_client::MetricFamily> PrometheusCollector::Collect() const
 {
-  this->collection_lock_.lock();
-  if (metrics_to_collect_.empty())
-  {
+  // Concurrent scrapes share a collection, which would otherwise go to the first one only.
+  return families_cache_.Get([this]() -> std::vector<prometheus_client::MetricFamily> {
+    this->collection_lock_.lock();
+    if (metrics_to_collect_.empty())
+    {
+      this->collection_lock_.unlock();
+      return {};
+    }
+
+    // copy the intermediate collection, and then clear it
+    std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> copied_data;
+    copied_data.swap(metrics_to_collect_);
     this->collection_lock_.unlock();
-    return {};
-  }
 
-  std::vector<prometheus_client::MetricFamily> result;
+    std::lock_guard<std::mutex> guard(name_cache_lock_);
+    return PrometheusExporterUtils::TranslateToPrometheus(copied_data, name_cache_);
+  });
+}
 
-  // copy the intermediate collection, and then clear it
-  std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> copied_data;
-  copied_data.swap(metrics_to_collect_);
-  this->collection_lock_.unlock();
+/**
+ * Collects all metrics data from metricsToCollect collection, appending it to out in the text
+ * exposition format without building MetricFamily objects.
+ *
+ * @param out the buffer to append to, such as the body of an HTTP response
+ */
+void PrometheusCollector::CollectText(std::string &out) const
+{
+  out += text_cache_.Get([this]() -> std::string {
+    std::string text;
+    std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> copied_data;
+    {
+      std::lock_guard<std::mutex> guard(collection_lock_);
+      copied_data.swap(metrics_to_collect_);
+    }
+    if (copied_data.empty())
+    {
+      return text;
+    }
 
-  result = PrometheusExporterUtils::TranslateToPrometheus(copied_data);
-  return result;
+    std::lock_guard<std::mutex> guard(name_cache_lock_);
+    PrometheusExporterUtils::WriteTextFormat(copied_data, name_cache_, text);
+    return text;
+  });
 }
 
 /**
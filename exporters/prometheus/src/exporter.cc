@@ -18,10 +18,13 @@ namespace metrics
 PrometheusExporter::PrometheusExporter(const PrometheusExporterOptions &options)
     : options_(options), is_shutdown_(false)
 {
-  exposer_   = std::unique_ptr<::prometheus::Exposer>(new ::prometheus::Exposer{options_.url});
-  collector_ = std::shared_ptr<PrometheusCollector>(new PrometheusCollector);
-
-  exposer_->RegisterCollectable(collector_);
+  collector_ = std::shared_ptr<PrometheusCollector>(
+      new PrometheusCollector(2048, options_.scrape_cache_ttl));
+  if (options_.use_exposer)
+  {
+    exposer_ = std::unique_ptr<::prometheus::Exposer>(new ::prometheus::Exposer{options_.url});
+    exposer_->RegisterCollectable(collector_);
+  }
 }
 
 /**
@@ -82,6 +85,16 @@ bool PrometheusExporter::Shutdown(std::chrono::microseconds timeout) noexcept
   collector_->GetCollection().clear();
 }
 
+/**
+ * Appends the metrics exported since the previous scrape to out, in the Prometheus text
+ * exposition format.
+ * @param out: the buffer to append to
+ */
+void PrometheusExporter::WriteTextFormat(std::string &out) const
+{
+  collector_->CollectText(out);
+}
+
 /**
  * @return: returns a shared_ptr to
  * the PrometheusCollector instance
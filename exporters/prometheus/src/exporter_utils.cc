@@ -2,24 +2,171 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #ifndef ENABLE_METRICS_PREVIEW
+#  include <algorithm>
+#  include <chrono>
+#  include <cmath>
+#  include <cstdio>
+#  include <limits>
 #  include <sstream>
 #  include <utility>
 #  include <vector>
 
 #  include <prometheus/metric_type.h>
 #  include "opentelemetry/exporters/prometheus/exporter_utils.h"
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
 #  include "opentelemetry/sdk/metrics/export/metric_producer.h"
 
 #  include "opentelemetry/sdk/common/global_log_handler.h"
 
 namespace prometheus_client = ::prometheus;
 namespace metric_sdk        = opentelemetry::sdk::metrics;
+using ClientLabels          = std::vector<prometheus_client::ClientMetric::Label>;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
 {
 namespace metrics
 {
+namespace
+{
+/**
+ * Returns the value of a sum or last value point.
+ */
+const metric_sdk::ValueType &GetPointValue(const metric_sdk::PointType &point_data)
+{
+  if (nostd::holds_alternative<metric_sdk::SumPointData>(point_data))
+  {
+    return nostd::get<metric_sdk::SumPointData>(point_data).value_;
+  }
+  return nostd::get<metric_sdk::LastValuePointData>(point_data).value_;
+}
+
+double ToDouble(const metric_sdk::ValueType &value)
+{
+  if (nostd::holds_alternative<long>(value))
+  {
+    return static_cast<double>(nostd::get<long>(value));
+  }
+  return nostd::get<double>(value);
+}
+
+double GetHistogramSum(const metric_sdk::HistogramPointData &histogram_point_data)
+{
+  if (nostd::holds_alternative<double>(histogram_point_data.sum_))
+  {
+    return nostd::get<double>(histogram_point_data.sum_);
+  }
+  return static_cast<double>(nostd::get<long>(histogram_point_data.sum_));
+}
+}  // namespace
+
+const std::string &PrometheusNameCache::GetMetricName(const std::string &instrument_name)
+{
+  auto it = metric_names_.find(instrument_name);
+  if (it == metric_names_.end())
+  {
+    it = metric_names_
+             .emplace(instrument_name,
+                      MetricName{PrometheusExporterUtils::SanitizeNames(instrument_name), 0})
+             .first;
+  }
+  it->second.last_used = generation_;
+  return it->second.sanitized;
+}
+
+const ClientLabels &PrometheusNameCache::GetLabels(const metric_sdk::PointAttributes &attributes)
+{
+  LabelSet &label_set = FindLabelSet(attributes);
+  if (!label_set.has_labels)
+  {
+    label_set.labels.reserve(attributes.size());
+    for (const auto &attribute : attributes)
+    {
+      prometheus_client::ClientMetric::Label label;
+      label.name  = PrometheusExporterUtils::SanitizeNames(attribute.first);
+      label.value = PrometheusExporterUtils::AttributeValueToString(attribute.second);
+      label_set.labels.emplace_back(std::move(label));
+    }
+    label_set.has_labels = true;
+  }
+  return label_set.labels;
+}
+
+const std::string &PrometheusNameCache::GetLabelText(const metric_sdk::PointAttributes &attributes)
+{
+  LabelSet &label_set = FindLabelSet(attributes);
+  if (!label_set.has_text)
+  {
+    for (const auto &attribute : attributes)
+    {
+      if (!label_set.text.empty())
+      {
+        label_set.text += ',';
+      }
+      label_set.text += PrometheusExporterUtils::SanitizeNames(attribute.first);
+      label_set.text += "=\"";
+      PrometheusExporterUtils::WriteEscaped(
+          PrometheusExporterUtils::AttributeValueToString(attribute.second), true, label_set.text);
+      label_set.text += '"';
+    }
+    label_set.has_text = true;
+  }
+  return label_set.text;
+}
+
+PrometheusNameCache::LabelSet &PrometheusNameCache::FindLabelSet(
+    const metric_sdk::PointAttributes &attributes)
+{
+  auto &bucket = label_sets_[sdk::common::GetHashForAttributeMap(attributes)];
+  for (auto &label_set : bucket)
+  {
+    if (label_set.attributes == attributes)
+    {
+      label_set.last_used = generation_;
+      return label_set;
+    }
+  }
+  bucket.emplace_back(LabelSet{attributes, false, false, {}, {}, generation_});
+  ++label_set_count_;
+  return bucket.back();
+}
+
+void PrometheusNameCache::Sweep()
+{
+  for (auto it = metric_names_.begin(); it != metric_names_.end();)
+  {
+    if (it->second.last_used != generation_)
+    {
+      it = metric_names_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  for (auto it = label_sets_.begin(); it != label_sets_.end();)
+  {
+    auto &bucket    = it->second;
+    size_t size     = bucket.size();
+    uint64_t in_use = generation_;
+    bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                [in_use](const LabelSet &label_set) {
+                                  return label_set.last_used != in_use;
+                                }),
+                 bucket.end());
+    label_set_count_ -= size - bucket.size();
+    if (bucket.empty())
+    {
+      it = label_sets_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  ++generation_;
+}
+
 /**
  * Helper function to convert OpenTelemetry metrics data collection
  * to Prometheus metrics data collection
@@ -29,6 +176,14 @@ namespace metrics
  */
 std::vector<prometheus_client::MetricFamily> PrometheusExporterUtils::TranslateToPrometheus(
     const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data)
+{
+  PrometheusNameCache cache;
+  return TranslateToPrometheus(data, cache);
+}
+
+std::vector<prometheus_client::MetricFamily> PrometheusExporterUtils::TranslateToPrometheus(
+    const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data,
+    PrometheusNameCache &cache)
 {
   if (data.empty())
   {
@@ -41,52 +196,180 @@ std::vector<prometheus_client::MetricFamily> PrometheusExporterUtils::TranslateT
   // iterate through the vector and set result data into it
   for (const auto &r : data)
   {
-    for (const auto &instrumentation_info : r->instrumentation_info_metric_data_)
+    TranslateResourceMetrics(*r, cache, output);
+  }
+  cache.Sweep();
+  return output;
+}
+
+void PrometheusExporterUtils::WriteTextFormat(
+    const std::vector<std::unique_ptr<sdk::metrics::ResourceMetrics>> &data,
+    PrometheusNameCache &cache,
+    std::string &out)
+{
+  if (data.empty())
+  {
+    return;
+  }
+
+  for (const auto &r : data)
+  {
+    WriteResourceMetrics(*r, cache, out);
+  }
+  cache.Sweep();
+}
+
+std::vector<prometheus_client::MetricFamily> PrometheusExporterUtils::TranslateToPrometheus(
+    const sdk::metrics::ResourceMetrics &data,
+    PrometheusNameCache &cache)
+{
+  std::vector<prometheus_client::MetricFamily> output;
+  TranslateResourceMetrics(data, cache, output);
+  cache.Sweep();
+  return output;
+}
+
+void PrometheusExporterUtils::WriteTextFormat(const sdk::metrics::ResourceMetrics &data,
+                                              PrometheusNameCache &cache,
+                                              std::string &out)
+{
+  WriteResourceMetrics(data, cache, out);
+  cache.Sweep();
+}
+
+void PrometheusExporterUtils::TranslateResourceMetrics(
+    const sdk::metrics::ResourceMetrics &data,
+    PrometheusNameCache &cache,
+    std::vector<prometheus_client::MetricFamily> &output)
+{
+  for (const auto &instrumentation_info : data.instrumentation_info_metric_data_)
+  {
+    for (const auto &metric_data : instrumentation_info.metric_data_)
     {
-      for (const auto &metric_data : instrumentation_info.metric_data_)
+      prometheus_client::MetricFamily metric_family;
+      metric_family.name = cache.GetMetricName(metric_data.instrument_descriptor.name_);
+      metric_family.help = metric_data.instrument_descriptor.description_;
+      auto time          = metric_data.start_ts.time_since_epoch();
+      for (const auto &point_data_attr : metric_data.point_data_attr_)
       {
-        auto origin_name = metric_data.instrument_descriptor.name_;
-        auto sanitized   = SanitizeNames(origin_name);
-        prometheus_client::MetricFamily metric_family;
-        metric_family.name = sanitized;
-        metric_family.help = metric_data.instrument_descriptor.description_;
-        auto time          = metric_data.start_ts.time_since_epoch();
-        for (const auto &point_data_attr : metric_data.point_data_attr_)
+        auto kind = getAggregationType(point_data_attr.point_data);
+        if (kind == metric_sdk::AggregationType::kExponentialHistogram ||
+            kind == metric_sdk::AggregationType::kSketch ||
+            kind == metric_sdk::AggregationType::kDrop)
+        {
+          // Not representable with the buckets of a Prometheus histogram, or empty.
+          continue;
+        }
+        const prometheus_client::MetricType type = TranslateType(kind);
+        metric_family.type                       = type;
+        const auto &labels = cache.GetLabels(point_data_attr.attributes);
+        if (type == prometheus_client::MetricType::Histogram)  // Histogram
+        {
+          const auto &histogram_point_data =
+              nostd::get<sdk::metrics::HistogramPointData>(point_data_attr.point_data);
+          double sum = GetHistogramSum(histogram_point_data);
+          SetData(std::vector<double>{sum, (double)histogram_point_data.count_},
+                  histogram_point_data.boundaries_, histogram_point_data.counts_, labels, time,
+                  &metric_family);
+        }
+        else  // Counter, Untyped
+        {
+          std::vector<metric_sdk::ValueType> values{GetPointValue(point_data_attr.point_data)};
+          SetData(values, labels, type, time, &metric_family);
+        }
+      }
+      output.emplace_back(std::move(metric_family));
+    }
+  }
+}
+
+void PrometheusExporterUtils::WriteResourceMetrics(const sdk::metrics::ResourceMetrics &data,
+                                                   PrometheusNameCache &cache,
+                                                   std::string &out)
+{
+  for (const auto &instrumentation_info : data.instrumentation_info_metric_data_)
+  {
+    for (const auto &metric_data : instrumentation_info.metric_data_)
+    {
+      const std::string &name = cache.GetMetricName(metric_data.instrument_descriptor.name_);
+      const std::string &help = metric_data.instrument_descriptor.description_;
+      int64_t timestamp_ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::nanoseconds(metric_data.start_ts.time_since_epoch()))
+              .count();
+      bool has_header = false;
+      for (const auto &point_data_attr : metric_data.point_data_attr_)
+      {
+        auto kind = getAggregationType(point_data_attr.point_data);
+        if (kind == metric_sdk::AggregationType::kExponentialHistogram ||
+            kind == metric_sdk::AggregationType::kSketch ||
+            kind == metric_sdk::AggregationType::kDrop)
+        {
+          continue;
+        }
+        const prometheus_client::MetricType type = TranslateType(kind);
+        if (!has_header)
+        {
+          if (!help.empty())
+          {
+            out += "# HELP ";
+            out += name;
+            out += ' ';
+            WriteEscaped(help, false, out);
+            out += '\n';
+          }
+          out += "# TYPE ";
+          out += name;
+          out += type == prometheus_client::MetricType::Counter     ? " counter\n"
+                 : type == prometheus_client::MetricType::Histogram ? " histogram\n"
+                                                                    : " untyped\n";
+          has_header = true;
+        }
+
+        const std::string &labels = cache.GetLabelText(point_data_attr.attributes);
+        if (type != prometheus_client::MetricType::Histogram)
         {
-          auto kind                                = getAggregationType(point_data_attr.point_data);
-          const prometheus_client::MetricType type = TranslateType(kind);
-          metric_family.type                       = type;
-          if (type == prometheus_client::MetricType::Histogram)  // Histogram
+          WriteSample(name, "", labels, nullptr,
+                      ToDouble(GetPointValue(point_data_attr.point_data)), timestamp_ms, out);
+          continue;
+        }
+
+        const auto &histogram_point_data =
+            nostd::get<sdk::metrics::HistogramPointData>(point_data_attr.point_data);
+        const double count = static_cast<double>(histogram_point_data.count_);
+        WriteSample(name, "_count", labels, nullptr, count, timestamp_ms, out);
+        WriteSample(name, "_sum", labels, nullptr, GetHistogramSum(histogram_point_data),
+                    timestamp_ms, out);
+        std::vector<double> boundaries;
+        if (nostd::holds_alternative<sdk::metrics::HistogramBoundaries<long>>(
+                histogram_point_data.boundaries_))
+        {
+          for (long boundary : nostd::get<sdk::metrics::HistogramBoundaries<long>>(
+                   histogram_point_data.boundaries_))
           {
-            auto histogram_point_data =
-                nostd::get<sdk::metrics::HistogramPointData>(point_data_attr.point_data);
-            auto boundaries = histogram_point_data.boundaries_;
-            auto counts     = histogram_point_data.counts_;
-            double sum      = 0.0;
-            if (nostd::holds_alternative<double>(histogram_point_data.sum_))
-            {
-              sum = nostd::get<double>(histogram_point_data.sum_);
-            }
-            else
-            {
-              sum = nostd::get<long>(histogram_point_data.sum_);
-            }
-            SetData(std::vector<double>{sum, (double)histogram_point_data.count_}, boundaries,
-                    counts, point_data_attr.attributes, time, &metric_family);
+            boundaries.push_back(static_cast<double>(boundary));
           }
-          else  // Counter, Untyped
+        }
+        else
+        {
+          const auto &shared = nostd::get<sdk::metrics::HistogramBoundaries<double>>(
+              histogram_point_data.boundaries_);
+          boundaries.assign(shared.begin(), shared.end());
+        }
+        boundaries.push_back(std::numeric_limits<double>::infinity());
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < boundaries.size(); ++i)
+        {
+          if (i < histogram_point_data.counts_.size())
           {
-            auto sum_point_data =
-                nostd::get<sdk::metrics::SumPointData>(point_data_attr.point_data);
-            std::vector<metric_sdk::ValueType> values{sum_point_data.value_};
-            SetData(values, point_data_attr.attributes, type, time, &metric_family);
+            cumulative += histogram_point_data.counts_[i];
           }
+          WriteSample(name, "_bucket", labels, &boundaries[i], static_cast<double>(cumulative),
+                      timestamp_ms, out);
         }
-        output.emplace_back(metric_family);
       }
     }
   }
-  return output;
 }
 
 /**
@@ -125,6 +408,14 @@ metric_sdk::AggregationType PrometheusExporterUtils::getAggregationType(
   {
     return metric_sdk::AggregationType::kLastValue;
   }
+  else if (nostd::holds_alternative<sdk::metrics::ExponentialHistogramPointData>(point_type))
+  {
+    return metric_sdk::AggregationType::kExponentialHistogram;
+  }
+  else if (nostd::holds_alternative<sdk::metrics::SketchPointData>(point_type))
+  {
+    return metric_sdk::AggregationType::kSketch;
+  }
   return metric_sdk::AggregationType::kDefault;
 }
 
@@ -151,7 +442,7 @@ prometheus_client::MetricType PrometheusExporterUtils::TranslateType(
  */
 template <typename T>
 void PrometheusExporterUtils::SetData(std::vector<T> values,
-                                      const metric_sdk::PointAttributes &labels,
+                                      const ClientLabels &labels,
                                       prometheus_client::MetricType type,
                                       std::chrono::nanoseconds time,
                                       prometheus_client::MetricFamily *metric_family)
@@ -170,20 +461,23 @@ template <typename T>
 void PrometheusExporterUtils::SetData(std::vector<T> values,
                                       const opentelemetry::sdk::metrics::ListType &boundaries,
                                       const std::vector<uint64_t> &counts,
-                                      const metric_sdk::PointAttributes &labels,
+                                      const ClientLabels &labels,
                                       std::chrono::nanoseconds time,
                                       prometheus_client::MetricFamily *metric_family)
 {
   metric_family->metric.emplace_back();
   prometheus_client::ClientMetric &metric = metric_family->metric.back();
   SetMetricBasic(metric, time, labels);
-  if (nostd::holds_alternative<std::list<long>>(boundaries))
+  if (nostd::holds_alternative<opentelemetry::sdk::metrics::HistogramBoundaries<long>>(boundaries))
   {
-    SetValue(values, nostd::get<std::list<long>>(boundaries), counts, &metric);
+    SetValue(values, nostd::get<opentelemetry::sdk::metrics::HistogramBoundaries<long>>(boundaries),
+             counts, &metric);
   }
   else
   {
-    SetValue(values, nostd::get<std::list<double>>(boundaries), counts, &metric);
+    SetValue(values,
+             nostd::get<opentelemetry::sdk::metrics::HistogramBoundaries<double>>(boundaries),
+             counts, &metric);
   }
 }
 
@@ -192,23 +486,90 @@ void PrometheusExporterUtils::SetData(std::vector<T> values,
  */
 void PrometheusExporterUtils::SetMetricBasic(prometheus_client::ClientMetric &metric,
                                              std::chrono::nanoseconds time,
-                                             const metric_sdk::PointAttributes &labels)
+                                             const ClientLabels &labels)
 {
   metric.timestamp_ms = time.count() / 1000000;
+  metric.label        = labels;
+};
 
-  // auto label_pairs = ParseLabel(labels);
-  if (!labels.empty())
+void PrometheusExporterUtils::WriteSample(const std::string &name,
+                                          const char *suffix,
+                                          const std::string &labels,
+                                          const double *le,
+                                          double value,
+                                          int64_t timestamp_ms,
+                                          std::string &out)
+{
+  out += name;
+  out += suffix;
+  if (!labels.empty() || le != nullptr)
   {
-    metric.label.resize(labels.size());
-    size_t i = 0;
-    for (auto const &label : labels)
+    out += '{';
+    out += labels;
+    if (le != nullptr)
     {
-      auto sanitized          = SanitizeNames(label.first);
-      metric.label[i].name    = sanitized;
-      metric.label[i++].value = AttributeValueToString(label.second);
+      out += labels.empty() ? "le=\"" : ",le=\"";
+      WriteDouble(*le, out);
+      out += '"';
     }
+    out += '}';
   }
-};
+  out += ' ';
+  WriteDouble(value, out);
+  if (timestamp_ms != 0)
+  {
+    out += ' ';
+    out += std::to_string(timestamp_ms);
+  }
+  out += '\n';
+}
+
+void PrometheusExporterUtils::WriteDouble(double value, std::string &out)
+{
+  if (std::isnan(value))
+  {
+    out += "Nan";
+  }
+  else if (std::isinf(value))
+  {
+    out += value < 0 ? "-Inf" : "+Inf";
+  }
+  else
+  {
+    char buffer[32];
+    int size = std::snprintf(buffer, sizeof(buffer), "%.*g",
+                             std::numeric_limits<double>::max_digits10 - 1, value);
+    out.append(buffer, static_cast<size_t>(size));
+  }
+}
+
+void PrometheusExporterUtils::WriteEscaped(const std::string &text,
+                                           bool escape_quote,
+                                           std::string &out)
+{
+  for (char c : text)
+  {
+    switch (c)
+    {
+      case '\n':
+        out += "\\n";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        if (escape_quote)
+        {
+          out += "\\\"";
+          break;
+        }
+        out += c;
+        break;
+      default:
+        out += c;
+    }
+  }
+}
 
 std::string PrometheusExporterUtils::AttributeValueToString(
     const opentelemetry::sdk::common::OwnedAttributeValue &value)
@@ -290,7 +651,7 @@ void PrometheusExporterUtils::SetValue(std::vector<T> values,
  */
 template <typename T, typename U>
 void PrometheusExporterUtils::SetValue(std::vector<T> values,
-                                       const std::list<U> &boundaries,
+                                       const sdk::metrics::HistogramBoundaries<U> &boundaries,
                                        const std::vector<uint64_t> &counts,
                                        prometheus_client::ClientMetric *metric)
 {
@@ -0,0 +1,122 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/exporters/prometheus/metric_reader.h"
+
+#  include <mutex>
+
+#  include <prometheus/collectable.h>
+#  include "opentelemetry/exporters/prometheus/exporter_utils.h"
+#  include "opentelemetry/exporters/prometheus/scrape_cache.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace exporter
+{
+namespace metrics
+{
+/**
+ * The collectable registered to the Exposer, which collects the reader on each scrape.
+ */
+class PrometheusReaderCollectable : public ::prometheus::Collectable
+{
+public:
+  PrometheusReaderCollectable(PrometheusMetricReader &reader,
+                              std::chrono::milliseconds scrape_cache_ttl)
+      : families_cache_(scrape_cache_ttl), text_cache_(scrape_cache_ttl), reader_(reader)
+  {}
+
+  std::vector<::prometheus::MetricFamily> Collect() const override
+  {
+    return reader_.CollectFamilies();
+  }
+
+  /**
+   * Sanitized names and labels of the series of the previous scrapes.
+   */
+  PrometheusNameCache name_cache_;
+
+  /*
+   * Lock held during a scrape, which serializes them and protects name_cache_
+   */
+  std::mutex scrape_lock_;
+
+  /**
+   * Results of the recent scrapes, which concurrent scrapes share instead of collecting each
+   */
+  PrometheusScrapeCache<std::vector<::prometheus::MetricFamily>> families_cache_;
+  PrometheusScrapeCache<std::string> text_cache_;
+
+private:
+  PrometheusMetricReader &reader_;
+};
+
+PrometheusMetricReader::PrometheusMetricReader(const PrometheusExporterOptions &options)
+    : options_(options),
+      collectable_(new PrometheusReaderCollectable(*this, options.scrape_cache_ttl))
+{
+  if (options_.use_exposer)
+  {
+    exposer_ = std::unique_ptr<::prometheus::Exposer>(new ::prometheus::Exposer{options_.url});
+    exposer_->RegisterCollectable(collectable_);
+  }
+}
+
+PrometheusMetricReader::~PrometheusMetricReader()
+{
+  exposer_.reset();
+}
+
+std::vector<::prometheus::MetricFamily> PrometheusMetricReader::CollectFamilies() noexcept
+{
+  if (IsShutdown())
+  {
+    return {};
+  }
+
+  return collectable_->families_cache_.Get([this]() {
+    std::vector<::prometheus::MetricFamily> result;
+    std::lock_guard<std::mutex> guard(collectable_->scrape_lock_);
+    Collect([&](sdk::metrics::ResourceMetrics &metric_data) {
+      result =
+          PrometheusExporterUtils::TranslateToPrometheus(metric_data, collectable_->name_cache_);
+      return true;
+    });
+    return result;
+  });
+}
+
+void PrometheusMetricReader::WriteTextFormat(std::string &out) noexcept
+{
+  if (IsShutdown())
+  {
+    return;
+  }
+
+  out += collectable_->text_cache_.Get([this]() {
+    std::string text;
+    std::lock_guard<std::mutex> guard(collectable_->scrape_lock_);
+    Collect([&](sdk::metrics::ResourceMetrics &metric_data) {
+      PrometheusExporterUtils::WriteTextFormat(metric_data, collectable_->name_cache_, text);
+      return true;
+    });
+    return text;
+  });
+}
+
+bool PrometheusMetricReader::OnForceFlush(std::chrono::microseconds /* timeout */) noexcept
+{
+  // Metrics are collected when they are scraped, there is nothing to flush.
+  return true;
+}
+
+bool PrometheusMetricReader::OnShutDown(std::chrono::microseconds /* timeout */) noexcept
+{
+  // Scrapes return nothing once the reader is shut down.
+  return true;
+}
+
+}  // namespace metrics
+}  // namespace exporter
+OPENTELEMETRY_END_NAMESPACE
+#endif  // ENABLE_METRICS_PREVIEW
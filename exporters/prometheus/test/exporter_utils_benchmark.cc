@@ -0,0 +1,114 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#ifndef ENABLE_METRICS_PREVIEW
+#  include <prometheus/text_serializer.h>
+
+#  include "opentelemetry/exporters/prometheus/exporter_utils.h"
+#  include "opentelemetry/sdk/metrics/export/metric_producer.h"
+
+#  include <cstdint>
+#  include <list>
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+namespace metric_sdk = opentelemetry::sdk::metrics;
+using opentelemetry::exporter::metrics::PrometheusExporterUtils;
+using opentelemetry::exporter::metrics::PrometheusNameCache;
+
+namespace
+{
+/**
+ * A scrape of a counter and a histogram with `series` series each, labelled with the attributes
+ * of an HTTP server request.
+ */
+std::vector<std::unique_ptr<metric_sdk::ResourceMetrics>> CreateData(int64_t series)
+{
+  metric_sdk::MetricData counter;
+  counter.instrument_descriptor = {"http.server.request.count", "Requests served", "1",
+                                   metric_sdk::InstrumentType::kCounter,
+                                   metric_sdk::InstrumentValueType::kLong};
+  metric_sdk::MetricData histogram;
+  histogram.instrument_descriptor = {"http.server.duration", "Request durations", "ms",
+                                     metric_sdk::InstrumentType::kHistogram,
+                                     metric_sdk::InstrumentValueType::kDouble};
+  for (int64_t index = 0; index < series; ++index)
+  {
+    metric_sdk::PointAttributes attributes{{{"http.method", "GET"},
+                                            {"http.route", "/api/v1/users/{id}"},
+                                            {"http.status_code", 200},
+                                            {"series", index}}};
+    metric_sdk::SumPointData sum_point_data;
+    sum_point_data.value_ = static_cast<long>(index * 10);
+    counter.point_data_attr_.push_back({attributes, sum_point_data});
+
+    metric_sdk::HistogramPointData histogram_point_data;
+    histogram_point_data.boundaries_ = std::list<double>{0, 5, 10, 25, 50, 75, 100, 250, 500, 1000};
+    histogram_point_data.counts_ = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    histogram_point_data.sum_    = 1234.5;
+    histogram_point_data.count_  = 55;
+    histogram.point_data_attr_.push_back({attributes, histogram_point_data});
+  }
+
+  metric_sdk::InstrumentationInfoMetrics instrumentation_info;
+  instrumentation_info.metric_data_.push_back(counter);
+  instrumentation_info.metric_data_.push_back(histogram);
+
+  std::vector<std::unique_ptr<metric_sdk::ResourceMetrics>> data;
+  data.emplace_back(new metric_sdk::ResourceMetrics);
+  data.back()->instrumentation_info_metric_data_.push_back(instrumentation_info);
+  return data;
+}
+
+void ReportThroughput(benchmark::State &state, uint64_t bytes)
+{
+  // Each scrape has state.range(0) series of each instrument.
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+void Series(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->ArgName("series")->Arg(1)->Arg(1 << 10)->Arg(1 << 14);
+}
+
+// Writes scrapes in the text exposition format directly, as the exporter serves them.
+void BM_PrometheusWriteTextFormat(benchmark::State &state)
+{
+  auto data = CreateData(state.range(0));
+  PrometheusNameCache cache;
+  std::string out;
+  uint64_t bytes = 0;
+  for (auto _ : state)
+  {
+    out.clear();
+    PrometheusExporterUtils::WriteTextFormat(data, cache, out);
+    benchmark::DoNotOptimize(out.data());
+    bytes += out.size();
+  }
+  ReportThroughput(state, bytes);
+}
+BENCHMARK(BM_PrometheusWriteTextFormat)->Apply(Series);
+
+// Translates scrapes into prometheus-cpp metric families, serialized by prometheus-cpp.
+void BM_PrometheusTranslateAndSerialize(benchmark::State &state)
+{
+  auto data = CreateData(state.range(0));
+  PrometheusNameCache cache;
+  prometheus::TextSerializer serializer;
+  uint64_t bytes = 0;
+  for (auto _ : state)
+  {
+    auto families   = PrometheusExporterUtils::TranslateToPrometheus(data, cache);
+    std::string out = serializer.Serialize(families);
+    benchmark::DoNotOptimize(out.data());
+    bytes += out.size();
+  }
+  ReportThroughput(state, bytes);
+}
+BENCHMARK(BM_PrometheusTranslateAndSerialize)->Apply(Series);
+}  // namespace
+#endif
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include <gtest/gtest.h>
+
+#  include "opentelemetry/exporters/prometheus/exporter_utils.h"
+#  include "opentelemetry/sdk/metrics/export/metric_producer.h"
+
+namespace metric_sdk = opentelemetry::sdk::metrics;
+using opentelemetry::exporter::metrics::PrometheusExporterUtils;
+using opentelemetry::exporter::metrics::PrometheusNameCache;
+
+namespace
+{
+std::vector<std::unique_ptr<metric_sdk::ResourceMetrics>> CreateData(bool with_histogram)
+{
+  metric_sdk::SumPointData sum_point_data;
+  sum_point_data.value_ = 10.0;
+  metric_sdk::MetricData counter;
+  counter.instrument_descriptor = {"request.count", "Requests\\served", "1",
+                                   metric_sdk::InstrumentType::kCounter,
+                                   metric_sdk::InstrumentValueType::kDouble};
+  counter.start_ts              = opentelemetry::common::SystemTimestamp(
+      std::chrono::system_clock::time_point(std::chrono::milliseconds(1234)));
+  counter.point_data_attr_.push_back({{{"http.method", "GET"}}, sum_point_data});
+  counter.point_data_attr_.push_back({{{"path", "a\"b"}, {"ok", true}}, sum_point_data});
+
+  metric_sdk::InstrumentationInfoMetrics instrumentation_info;
+  instrumentation_info.metric_data_.push_back(counter);
+
+  if (with_histogram)
+  {
+    metric_sdk::HistogramPointData histogram_point_data;
+    histogram_point_data.boundaries_ = std::list<double>{0.5, 2.0};
+    histogram_point_data.counts_     = {1, 2, 3};
+    histogram_point_data.sum_        = 12.25;
+    histogram_point_data.count_      = 6;
+    metric_sdk::MetricData histogram;
+    histogram.instrument_descriptor = {"latency", "", "ms", metric_sdk::InstrumentType::kHistogram,
+                                       metric_sdk::InstrumentValueType::kDouble};
+    histogram.point_data_attr_.push_back({{}, histogram_point_data});
+    instrumentation_info.metric_data_.push_back(histogram);
+  }
+
+  std::vector<std::unique_ptr<metric_sdk::ResourceMetrics>> data;
+  data.emplace_back(new metric_sdk::ResourceMetrics);
+  data.back()->instrumentation_info_metric_data_.push_back(instrumentation_info);
+  return data;
+}
+}  // namespace
+
+TEST(PrometheusExporterUtils, WriteTextFormat)
+{
+  PrometheusNameCache cache;
+  std::string out;
+  PrometheusExporterUtils::WriteTextFormat(CreateData(true), cache, out);
+  EXPECT_EQ(out,
+            "# HELP request_count Requests\\\\served\n"
+            "# TYPE request_count counter\n"
+            "request_count{http_method=\"GET\"} 10 1234\n"
+            "request_count{ok=\"true\",path=\"a\\\"b\"} 10 1234\n"
+            "# TYPE latency histogram\n"
+            "latency_count 6\n"
+            "latency_sum 12.25\n"
+            "latency_bucket{le=\"0.5\"} 1\n"
+            "latency_bucket{le=\"2\"} 3\n"
+            "latency_bucket{le=\"+Inf\"} 6\n");
+}
+
+TEST(PrometheusExporterUtils, TranslateWithCache)
+{
+  PrometheusNameCache cache;
+  auto families = PrometheusExporterUtils::TranslateToPrometheus(CreateData(true), cache);
+  ASSERT_EQ(families.size(), 2);
+  EXPECT_EQ(families[0].name, "request_count");
+  ASSERT_EQ(families[0].metric.size(), 2);
+  ASSERT_EQ(families[0].metric[0].label.size(), 1);
+  EXPECT_EQ(families[0].metric[0].label[0].name, "http_method");
+  EXPECT_EQ(families[0].metric[0].label[0].value, "GET");
+  EXPECT_EQ(families[0].metric[0].counter.value, 10.0);
+  EXPECT_EQ(cache.GetMetricNameCount(), 2);
+  EXPECT_EQ(cache.GetLabelSetCount(), 3);
+
+  // The series of the previous scrape are reused.
+  PrometheusExporterUtils::TranslateToPrometheus(CreateData(true), cache);
+  EXPECT_EQ(cache.GetMetricNameCount(), 2);
+  EXPECT_EQ(cache.GetLabelSetCount(), 3);
+
+  // Those which are not scraped anymore are dropped.
+  PrometheusExporterUtils::TranslateToPrometheus(CreateData(false), cache);
+  EXPECT_EQ(cache.GetMetricNameCount(), 1);
+  EXPECT_EQ(cache.GetLabelSetCount(), 2);
+}
+
+TEST(PrometheusExporterUtils, LabelTextMatchesLabels)
+{
+  PrometheusNameCache cache;
+  metric_sdk::PointAttributes attributes{{{"a.b", "x\ny"}, {"c-d", 5}}};
+  const auto &labels = cache.GetLabels(attributes);
+  ASSERT_EQ(labels.size(), 2);
+  EXPECT_EQ(labels[0].name, "a_b");
+  EXPECT_EQ(labels[0].value, "x\ny");
+  EXPECT_EQ(labels[1].name, "c_d");
+  EXPECT_EQ(labels[1].value, "5");
+  EXPECT_EQ(cache.GetLabelText(attributes), "a_b=\"x\\ny\",c_d=\"5\"");
+  EXPECT_EQ(cache.GetLabelSetCount(), 1);
+}
+#endif
@@ -0,0 +1,89 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include <gtest/gtest.h>
+
+#  include "opentelemetry/exporters/prometheus/metric_reader.h"
+#  include "opentelemetry/sdk/metrics/meter_provider.h"
+
+namespace metric_sdk = opentelemetry::sdk::metrics;
+using opentelemetry::exporter::metrics::PrometheusExporterOptions;
+using opentelemetry::exporter::metrics::PrometheusMetricReader;
+
+namespace
+{
+PrometheusExporterOptions GetOptions()
+{
+  PrometheusExporterOptions options;
+  options.use_exposer = false;
+  return options;
+}
+}  // namespace
+
+TEST(PrometheusMetricReader, CollectOnScrape)
+{
+  metric_sdk::MeterProvider meter_provider;
+  auto reader = new PrometheusMetricReader(GetOptions());
+  meter_provider.AddMetricReader(std::unique_ptr<metric_sdk::MetricReader>(reader));
+
+  auto counter = meter_provider.GetMeter("meter")->CreateLongCounter("request.count");
+  counter->Add(5);
+
+  std::string out;
+  reader->WriteTextFormat(out);
+  EXPECT_NE(out.find(" counter\n"), std::string::npos);
+  EXPECT_NE(out.find(" 5 "), std::string::npos);
+
+  // The next scrape sees the values recorded since, without any export in between.
+  counter->Add(2);
+  auto families = reader->CollectFamilies();
+  ASSERT_EQ(families.size(), 1);
+  EXPECT_EQ(families[0].type, ::prometheus::MetricType::Counter);
+  ASSERT_EQ(families[0].metric.size(), 1);
+  EXPECT_EQ(families[0].metric[0].counter.value, 7);
+}
+
+TEST(PrometheusMetricReader, ServeScrapeWithinTtl)
+{
+  metric_sdk::MeterProvider meter_provider;
+  auto options             = GetOptions();
+  options.scrape_cache_ttl = std::chrono::hours(1);
+  auto reader              = new PrometheusMetricReader(options);
+  meter_provider.AddMetricReader(std::unique_ptr<metric_sdk::MetricReader>(reader));
+
+  auto counter = meter_provider.GetMeter("meter")->CreateLongCounter("request.count");
+  counter->Add(5);
+  std::string first;
+  reader->WriteTextFormat(first);
+  EXPECT_NE(first.find(" 5 "), std::string::npos);
+
+  // The next scrape is served the result of the first one rather than collecting again.
+  counter->Add(2);
+  std::string second;
+  reader->WriteTextFormat(second);
+  EXPECT_EQ(second, first);
+}
+
+TEST(PrometheusMetricReader, NothingAfterShutdown)
+{
+  metric_sdk::MeterProvider meter_provider;
+  auto reader = new PrometheusMetricReader(GetOptions());
+  meter_provider.AddMetricReader(std::unique_ptr<metric_sdk::MetricReader>(reader));
+  meter_provider.GetMeter("meter")->CreateLongCounter("request.count")->Add(1);
+
+  EXPECT_TRUE(reader->Shutdown());
+  std::string out;
+  reader->WriteTextFormat(out);
+  EXPECT_TRUE(out.empty());
+  EXPECT_TRUE(reader->CollectFamilies().empty());
+}
+
+TEST(PrometheusMetricReader, NothingWithoutMeterProvider)
+{
+  PrometheusMetricReader reader(GetOptions());
+  std::string out;
+  reader.WriteTextFormat(out);
+  EXPECT_TRUE(out.empty());
+}
+#endif
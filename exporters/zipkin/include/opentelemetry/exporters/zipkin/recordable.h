@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "nlohmann/json.hpp"
+#include "opentelemetry/sdk/common/attribute_utils.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/version.h"
 
@@ -14,13 +19,40 @@ namespace zipkin
 {
 using ZipkinSpan = nlohmann::json;
 
+/**
+ * The endpoint of the service which recorded the spans.
+ */
+struct LocalEndpoint
+{
+  std::string service_name;
+  std::string ipv4;
+  std::string ipv6;
+  uint16_t port = 0;
+};
+
 class Recordable final : public sdk::trace::Recordable
 {
 public:
-  const ZipkinSpan &span() const noexcept { return span_; }
+  /**
+   * Returns the span as a JSON object, without its local endpoint. This is meant for tests and
+   * debugging: the exporter encodes spans with WriteJson or WriteProto.
+   */
+  ZipkinSpan span() const;
 
   const std::string &GetServiceName() const noexcept { return service_name_; }
 
+  /**
+   * Append the span to out as a Zipkin v2 JSON object.
+   * @param local_endpoint the local endpoint of the span, nullptr to omit it. The service name of
+   * the resource of the span, if any, replaces the one of local_endpoint.
+   */
+  void WriteJson(std::vector<uint8_t> &out, const LocalEndpoint *local_endpoint) const;
+
+  /**
+   * Append the span to out as a spans field of a Zipkin proto3 ListOfSpans message.
+   */
+  void WriteProto(std::vector<uint8_t> &out, const LocalEndpoint &local_endpoint) const;
+
   void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
                    opentelemetry::trace::SpanId parent_span_id) noexcept override;
 
@@ -52,7 +84,31 @@ class Recordable final : public sdk::trace::Recordable
           &instrumentation_library) noexcept override;
 
 private:
-  ZipkinSpan span_;
+  struct Annotation
+  {
+    // Microseconds since the epoch
+    int64_t timestamp;
+    // The name and attributes of the event, as a JSON object
+    std::string value;
+  };
+
+  // Which of the optional fields are set
+  bool has_identity_  = false;
+  bool has_name_      = false;
+  bool has_timestamp_ = false;
+  bool has_duration_  = false;
+  bool has_kind_      = false;
+
+  opentelemetry::trace::TraceId trace_id_;
+  opentelemetry::trace::SpanId span_id_;
+  opentelemetry::trace::SpanId parent_span_id_;
+  std::string name_;
+  // Microseconds
+  int64_t timestamp_ = 0;
+  int64_t duration_  = 0;
+  opentelemetry::trace::SpanKind kind_ = opentelemetry::trace::SpanKind::kInternal;
+  sdk::common::AttributeMap tags_;
+  std::vector<Annotation> annotations_;
   std::string service_name_;
 };
 }  // namespace zipkin
@@ -10,7 +10,8 @@
 #include "opentelemetry/sdk/trace/exporter.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 
-#include "nlohmann/json.hpp"
+#include <memory>
+#include <mutex>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace exporter
@@ -45,11 +46,20 @@ struct ZipkinExporterOptions
   std::string service_name = "default-service";
   std::string ipv4;
   std::string ipv6;
+  // With TransportFormat::kProtobuf, a content-type of application/json is sent as
+  // application/x-protobuf.
   ext::http::client::Headers headers = {{"content-type", "application/json"}};
+  // Maximum number of requests sent at the same time, 0 for no limit.
+  std::size_t max_requests_in_flight = 64;
+  // Maximum number of requests waiting to be sent, 0 for no limit. Beyond it, the oldest waiting
+  // request is dropped.
+  std::size_t max_pending_requests = 256;
 };
 
+struct LocalEndpoint;
+
 /**
- * The Zipkin exporter exports span data in JSON format as expected by Zipkin
+ * The Zipkin exporter exports span data in the JSON or proto3 format expected by Zipkin.
  */
 class ZipkinExporter final : public opentelemetry::sdk::trace::SpanExporter
 {
@@ -64,6 +74,8 @@ class ZipkinExporter final : public opentelemetry::sdk::trace::SpanExporter
    */
   explicit ZipkinExporter(const ZipkinExporterOptions &options);
 
+  ~ZipkinExporter() override;
+
   /**
    * Create a span recordable.
    * @return a newly initialized Recordable object
@@ -71,7 +83,7 @@ class ZipkinExporter final : public opentelemetry::sdk::trace::SpanExporter
   std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
 
   /**
-   * Export a batch of span recordables in JSON format.
+   * Export a batch of span recordables in the configured format.
    * @param spans a span of unique pointers to span recordables
    */
   sdk::common::ExportResult Export(
@@ -94,7 +106,11 @@ class ZipkinExporter final : public opentelemetry::sdk::trace::SpanExporter
   ZipkinExporterOptions options_;
   std::shared_ptr<opentelemetry::ext::http::client::HttpClientSync> http_client_;
   opentelemetry::ext::http::common::UrlParser url_parser_;
-  nlohmann::json local_end_point_;
+  std::unique_ptr<LocalEndpoint> local_endpoint_;
+
+  // The request body, reused by each export
+  std::mutex body_lock_;
+  opentelemetry::ext::http::client::Body body_;
 
   // For testing
   friend class ZipkinExporterTestPeer;
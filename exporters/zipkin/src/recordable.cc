@@ -4,7 +4,10 @@
 #include "opentelemetry/exporters/zipkin/recordable.h"
 #include "opentelemetry/sdk/resource/experimental_semantic_conventions.h"
 
-#include <map>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -18,174 +21,337 @@ namespace trace_api = opentelemetry::trace;
 namespace common    = opentelemetry::common;
 namespace sdk       = opentelemetry::sdk;
 
-// constexpr needs keys to be constexpr, const is next best to use.
-static const std::map<trace_api::SpanKind, std::string> kSpanKindMap = {
-    {trace_api::SpanKind::kClient, "CLIENT"},
-    {trace_api::SpanKind::kServer, "SERVER"},
-    {trace_api::SpanKind::kConsumer, "CONSUMER"},
-    {trace_api::SpanKind::kProducer, "PRODUCER"},
-};
+namespace
+{
 
-//
-// See `attribute_value.h` for details.
-//
-const int kAttributeValueSize = 16;
+using Buffer = std::vector<uint8_t>;
 
-void Recordable::SetIdentity(const trace_api::SpanContext &span_context,
-                             trace_api::SpanId parent_span_id) noexcept
+// Protobuf wire types
+const uint8_t kVarint          = 0;
+const uint8_t kFixed64         = 1;
+const uint8_t kLengthDelimited = 2;
+
+// Maximum size of a varint encoding a 32 bits length
+const std::size_t kMaxLengthSize = 5;
+
+const char *GetSpanKindName(trace_api::SpanKind span_kind)
 {
-  char trace_id_lower_base16[trace::TraceId::kSize * 2] = {0};
-  span_context.trace_id().ToLowerBase16(trace_id_lower_base16);
-  char span_id_lower_base16[trace::SpanId::kSize * 2] = {0};
-  span_context.span_id().ToLowerBase16(span_id_lower_base16);
-  if (parent_span_id.IsValid())
+  switch (span_kind)
   {
-    char parent_span_id_lower_base16[trace::SpanId::kSize * 2] = {0};
-    parent_span_id.ToLowerBase16(parent_span_id_lower_base16);
-    span_["parentId"] = std::string(parent_span_id_lower_base16, 16);
+    case trace_api::SpanKind::kClient:
+      return "CLIENT";
+    case trace_api::SpanKind::kServer:
+      return "SERVER";
+    case trace_api::SpanKind::kProducer:
+      return "PRODUCER";
+    case trace_api::SpanKind::kConsumer:
+      return "CONSUMER";
+    default:
+      return nullptr;
   }
-
-  span_["id"]      = std::string(span_id_lower_base16, 16);
-  span_["traceId"] = std::string(trace_id_lower_base16, 32);
 }
 
-void PopulateAttribute(nlohmann::json &attribute,
-                       nostd::string_view key,
-                       const common::AttributeValue &value)
+// Values of the Span.Kind enum of zipkin.proto3
+uint64_t GetSpanKindNumber(trace_api::SpanKind span_kind)
 {
-  // Assert size of variant to ensure that this method gets updated if the variant
-  // definition changes
-  static_assert(nostd::variant_size<common::AttributeValue>::value == kAttributeValueSize,
-                "AttributeValue contains unknown type");
-
-  if (nostd::holds_alternative<bool>(value))
+  switch (span_kind)
   {
-    attribute[key.data()] = nostd::get<bool>(value);
+    case trace_api::SpanKind::kClient:
+      return 1;
+    case trace_api::SpanKind::kServer:
+      return 2;
+    case trace_api::SpanKind::kProducer:
+      return 3;
+    case trace_api::SpanKind::kConsumer:
+      return 4;
+    default:
+      return 0;
   }
-  else if (nostd::holds_alternative<int>(value))
-  {
-    attribute[key.data()] = nostd::get<int>(value);
-  }
-  else if (nostd::holds_alternative<int64_t>(value))
-  {
-    attribute[key.data()] = nostd::get<int64_t>(value);
-  }
-  else if (nostd::holds_alternative<unsigned int>(value))
-  {
-    attribute[key.data()] = nostd::get<unsigned int>(value);
-  }
-  else if (nostd::holds_alternative<uint64_t>(value))
-  {
-    attribute[key.data()] = nostd::get<uint64_t>(value);
-  }
-  else if (nostd::holds_alternative<double>(value))
-  {
-    attribute[key.data()] = nostd::get<double>(value);
-  }
-  else if (nostd::holds_alternative<const char *>(value))
+}
+
+void Append(Buffer &out, const char *data, std::size_t size)
+{
+  out.insert(out.end(), reinterpret_cast<const uint8_t *>(data),
+             reinterpret_cast<const uint8_t *>(data) + size);
+}
+
+void Append(Buffer &out, const char *data)
+{
+  Append(out, data, std::strlen(data));
+}
+
+// ------------------------------------ JSON ------------------------------------
+
+// Escapes like nlohmann::json::dump, so that annotation values are unchanged.
+void WriteJsonString(Buffer &out, nostd::string_view value)
+{
+  out.push_back('"');
+  for (char c : value)
   {
-    attribute[key.data()] = nostd::get<const char *>(value);
+    switch (c)
+    {
+      case '"':
+        Append(out, "\\\"", 2);
+        break;
+      case '\\':
+        Append(out, "\\\\", 2);
+        break;
+      case '\b':
+        Append(out, "\\b", 2);
+        break;
+      case '\f':
+        Append(out, "\\f", 2);
+        break;
+      case '\n':
+        Append(out, "\\n", 2);
+        break;
+      case '\r':
+        Append(out, "\\r", 2);
+        break;
+      case '\t':
+        Append(out, "\\t", 2);
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[7];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          Append(out, escaped, 6);
+        }
+        else
+        {
+          out.push_back(static_cast<uint8_t>(c));
+        }
+    }
   }
-  else if (nostd::holds_alternative<nostd::string_view>(value))
+  out.push_back('"');
+}
+
+void WriteJsonInteger(Buffer &out, int64_t value)
+{
+  char digits[24];
+  int size = std::snprintf(digits, sizeof(digits), "%" PRId64, value);
+  Append(out, digits, static_cast<std::size_t>(size));
+}
+
+void WriteJsonInteger(Buffer &out, uint64_t value)
+{
+  char digits[24];
+  int size = std::snprintf(digits, sizeof(digits), "%" PRIu64, value);
+  Append(out, digits, static_cast<std::size_t>(size));
+}
+
+// Writes the shortest representation which reads back as the same double.
+void WriteJsonDouble(Buffer &out, double value)
+{
+  if (value != value || value - value != 0)
   {
-    attribute[key.data()] = nostd::string_view(nostd::get<nostd::string_view>(value).data(),
-                                               nostd::get<nostd::string_view>(value).size());
+    // NaN and infinities, which JSON cannot represent
+    Append(out, "null", 4);
+    return;
   }
-  else if (nostd::holds_alternative<nostd::span<const uint8_t>>(value))
+  char digits[32];
+  int size = 0;
+  for (int precision = 15; precision <= 17; ++precision)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const uint8_t>>(value))
+    size = std::snprintf(digits, sizeof(digits), "%.*g", precision, value);
+    if (std::strtod(digits, nullptr) == value)
     {
-      attribute[key.data()].push_back(val);
+      break;
     }
   }
-  else if (nostd::holds_alternative<nostd::span<const bool>>(value))
+  Append(out, digits, static_cast<std::size_t>(size));
+  if (std::strpbrk(digits, ".e") == nullptr)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const bool>>(value))
-    {
-      attribute[key.data()].push_back(val);
-    }
+    Append(out, ".0", 2);
   }
-  else if (nostd::holds_alternative<nostd::span<const int>>(value))
+}
+
+struct JsonValueWriter
+{
+  Buffer &out;
+
+  void operator()(bool value) { Append(out, value ? "true" : "false"); }
+  void operator()(int32_t value) { WriteJsonInteger(out, static_cast<int64_t>(value)); }
+  void operator()(int64_t value) { WriteJsonInteger(out, value); }
+  void operator()(uint32_t value) { WriteJsonInteger(out, static_cast<uint64_t>(value)); }
+  void operator()(uint64_t value) { WriteJsonInteger(out, value); }
+  void operator()(double value) { WriteJsonDouble(out, value); }
+  void operator()(const std::string &value) { WriteJsonString(out, value); }
+
+  template <class T>
+  void operator()(const std::vector<T> &values)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const int>>(value))
+    out.push_back('[');
+    bool first = true;
+    for (const auto &value : values)
     {
-      attribute[key.data()].push_back(val);
+      if (!first)
+      {
+        out.push_back(',');
+      }
+      first = false;
+      (*this)(value);
     }
+    out.push_back(']');
   }
-  else if (nostd::holds_alternative<nostd::span<const int64_t>>(value))
+};
+
+template <class Map>
+void WriteJsonObject(Buffer &out, const Map &attributes)
+{
+  out.push_back('{');
+  bool first = true;
+  for (const auto &attribute : attributes)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const int64_t>>(value))
+    if (!first)
     {
-      attribute[key.data()].push_back(val);
+      out.push_back(',');
     }
+    first = false;
+    WriteJsonString(out, attribute.first);
+    out.push_back(':');
+    JsonValueWriter writer{out};
+    nostd::visit(writer, attribute.second);
   }
-  else if (nostd::holds_alternative<nostd::span<const unsigned int>>(value))
+  out.push_back('}');
+}
+
+void WriteJsonKey(Buffer &out, const char *key, bool &first)
+{
+  if (!first)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const unsigned int>>(value))
-    {
-      attribute[key.data()].push_back(val);
-    }
+    out.push_back(',');
   }
-  else if (nostd::holds_alternative<nostd::span<const uint64_t>>(value))
+  first = false;
+  out.push_back('"');
+  Append(out, key);
+  Append(out, "\":", 2);
+}
+
+// ---------------------------------- Protobuf ----------------------------------
+
+void WriteVarint(Buffer &out, uint64_t value)
+{
+  while (value >= 0x80)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const uint64_t>>(value))
-    {
-      attribute[key.data()].push_back(val);
-    }
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteTag(Buffer &out, uint32_t field, uint8_t wire_type)
+{
+  WriteVarint(out, (static_cast<uint64_t>(field) << 3) | wire_type);
+}
+
+void WriteVarintField(Buffer &out, uint32_t field, uint64_t value)
+{
+  WriteTag(out, field, kVarint);
+  WriteVarint(out, value);
+}
+
+void WriteFixed64Field(Buffer &out, uint32_t field, uint64_t value)
+{
+  WriteTag(out, field, kFixed64);
+  for (int i = 0; i < 8; ++i)
+  {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
   }
-  else if (nostd::holds_alternative<nostd::span<const double>>(value))
+}
+
+void WriteBytesField(Buffer &out, uint32_t field, const void *data, std::size_t size)
+{
+  WriteTag(out, field, kLengthDelimited);
+  WriteVarint(out, size);
+  Append(out, static_cast<const char *>(data), size);
+}
+
+/**
+ * Starts a length-delimited field whose size is not known yet, by leaving room for the longest
+ * length. Returns where the content starts, to pass to EndMessage.
+ */
+std::size_t BeginMessage(Buffer &out, uint32_t field)
+{
+  WriteTag(out, field, kLengthDelimited);
+  out.resize(out.size() + kMaxLengthSize);
+  return out.size();
+}
+
+/**
+ * Writes the length of a field started by BeginMessage, and moves the content next to it.
+ */
+void EndMessage(Buffer &out, std::size_t start)
+{
+  uint8_t length[kMaxLengthSize];
+  std::size_t length_size = 0;
+  uint64_t size           = out.size() - start;
+  do
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const double>>(value))
+    length[length_size] = static_cast<uint8_t>(size & 0x7f);
+    size >>= 7;
+    if (size != 0)
     {
-      attribute[key.data()].push_back(val);
+      length[length_size] |= 0x80;
     }
-  }
-  else if (nostd::holds_alternative<nostd::span<const nostd::string_view>>(value))
+    ++length_size;
+  } while (size != 0);
+
+  std::size_t length_start = start - kMaxLengthSize;
+  std::memcpy(out.data() + length_start, length, length_size);
+  out.erase(out.begin() + length_start + length_size, out.begin() + start);
+}
+
+bool ParseIpv4(const std::string &address, uint8_t (&bytes)[4])
+{
+  const char *position = address.c_str();
+  for (int i = 0; i < 4; ++i)
   {
-    attribute[key.data()] = {};
-    for (const auto &val : nostd::get<nostd::span<const nostd::string_view>>(value))
+    char *end           = nullptr;
+    unsigned long value = std::strtoul(position, &end, 10);
+    if (end == position || value > 255 || *end != (i == 3 ? '\0' : '.'))
     {
-      attribute[key.data()].push_back(std::string(val.data(), val.size()));
+      return false;
     }
+    bytes[i] = static_cast<uint8_t>(value);
+    position = end + 1;
   }
+  return true;
+}
+
+}  // namespace
+
+void Recordable::SetIdentity(const trace_api::SpanContext &span_context,
+                             trace_api::SpanId parent_span_id) noexcept
+{
+  has_identity_   = true;
+  trace_id_       = span_context.trace_id();
+  span_id_        = span_context.span_id();
+  parent_span_id_ = parent_span_id;
 }
 
 void Recordable::SetAttribute(nostd::string_view key, const common::AttributeValue &value) noexcept
 {
-  if (!span_.contains("tags"))
-  {
-    span_["tags"] = nlohmann::json::object();
-  }
-  PopulateAttribute(span_["tags"], key, value);
+  tags_.SetAttribute(key, value);
 }
 
 void Recordable::AddEvent(nostd::string_view name,
                           common::SystemTimestamp timestamp,
                           const common::KeyValueIterable &attributes) noexcept
 {
-  nlohmann::json attrs = nlohmann::json::object();  // empty object
-  attributes.ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) noexcept {
-    PopulateAttribute(attrs, key, value);
-    return true;
-  });
-
-  nlohmann::json annotation = {{"value", nlohmann::json::object({{name.data(), attrs}}).dump()},
-                               {"timestamp", std::chrono::duration_cast<std::chrono::microseconds>(
-                                                 timestamp.time_since_epoch())
-                                                 .count()}};
+  // The value is the name of the event mapped to its attributes, with sorted keys.
+  Buffer value;
+  value.push_back('{');
+  WriteJsonString(value, name);
+  value.push_back(':');
+  WriteJsonObject(value, sdk::common::OrderedAttributeMap(attributes));
+  value.push_back('}');
 
-  if (!span_.contains("annotations"))
-  {
-    span_["annotations"] = nlohmann::json::array();
-  }
-  span_["annotations"].push_back(annotation);
+  annotations_.push_back(
+      Annotation{std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch())
+                     .count(),
+                 std::string(value.begin(), value.end())});
 }
 
 void Recordable::AddLink(const trace_api::SpanContext &span_context,
@@ -199,17 +365,18 @@ void Recordable::SetStatus(trace::StatusCode code, nostd::string_view descriptio
 {
   if (code != trace::StatusCode::kUnset)
   {
-    span_["tags"]["otel.status_code"] = code;
+    tags_.SetAttribute("otel.status_code", static_cast<int32_t>(code));
     if (code == trace::StatusCode::kError)
     {
-      span_["tags"]["error"] = description;
+      tags_.SetAttribute("error", description);
     }
   }
 }
 
 void Recordable::SetName(nostd::string_view name) noexcept
 {
-  span_["name"] = name.data();
+  has_name_ = true;
+  name_     = std::string(name.data(), name.size());
 }
 
 void Recordable::SetResource(const sdk::resource::Resource &resource) noexcept
@@ -224,29 +391,212 @@ void Recordable::SetResource(const sdk::resource::Resource &resource) noexcept
 
 void Recordable::SetStartTime(common::SystemTimestamp start_time) noexcept
 {
-  span_["timestamp"] =
+  has_timestamp_ = true;
+  timestamp_ =
       std::chrono::duration_cast<std::chrono::microseconds>(start_time.time_since_epoch()).count();
 }
 
 void Recordable::SetDuration(std::chrono::nanoseconds duration) noexcept
 {
-  span_["duration"] = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  has_duration_ = true;
+  duration_     = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
 }
 
 void Recordable::SetSpanKind(trace_api::SpanKind span_kind) noexcept
 {
-  auto span_iter = kSpanKindMap.find(span_kind);
-  if (span_iter != kSpanKindMap.end())
+  if (GetSpanKindName(span_kind) != nullptr)
   {
-    span_["kind"] = span_iter->second;
+    has_kind_ = true;
+    kind_     = span_kind;
   }
 }
 
 void Recordable::SetInstrumentationLibrary(
     const sdk::instrumentationlibrary::InstrumentationLibrary &instrumentation_library) noexcept
 {
-  span_["tags"]["otel.library.name"]    = instrumentation_library.GetName();
-  span_["tags"]["otel.library.version"] = instrumentation_library.GetVersion();
+  tags_.SetAttribute("otel.library.name", instrumentation_library.GetName());
+  tags_.SetAttribute("otel.library.version", instrumentation_library.GetVersion());
+}
+
+ZipkinSpan Recordable::span() const
+{
+  Buffer out;
+  WriteJson(out, nullptr);
+  return nlohmann::json::parse(out.begin(), out.end(), nullptr, false);
+}
+
+void Recordable::WriteJson(std::vector<uint8_t> &out, const LocalEndpoint *local_endpoint) const
+{
+  bool first = true;
+  out.push_back('{');
+  if (has_identity_)
+  {
+    char trace_id[trace_api::TraceId::kSize * 2];
+    trace_id_.ToLowerBase16(trace_id);
+    WriteJsonKey(out, "traceId", first);
+    WriteJsonString(out, nostd::string_view(trace_id, sizeof(trace_id)));
+
+    char span_id[trace_api::SpanId::kSize * 2];
+    if (parent_span_id_.IsValid())
+    {
+      parent_span_id_.ToLowerBase16(span_id);
+      WriteJsonKey(out, "parentId", first);
+      WriteJsonString(out, nostd::string_view(span_id, sizeof(span_id)));
+    }
+    span_id_.ToLowerBase16(span_id);
+    WriteJsonKey(out, "id", first);
+    WriteJsonString(out, nostd::string_view(span_id, sizeof(span_id)));
+  }
+  if (has_kind_)
+  {
+    WriteJsonKey(out, "kind", first);
+    WriteJsonString(out, GetSpanKindName(kind_));
+  }
+  if (has_name_)
+  {
+    WriteJsonKey(out, "name", first);
+    WriteJsonString(out, name_);
+  }
+  if (has_timestamp_)
+  {
+    WriteJsonKey(out, "timestamp", first);
+    WriteJsonInteger(out, timestamp_);
+  }
+  if (has_duration_)
+  {
+    WriteJsonKey(out, "duration", first);
+    WriteJsonInteger(out, duration_);
+  }
+  if (local_endpoint != nullptr)
+  {
+    const std::string &service_name =
+        service_name_.empty() ? local_endpoint->service_name : service_name_;
+    bool first_field = true;
+    WriteJsonKey(out, "localEndpoint", first);
+    out.push_back('{');
+    if (!service_name.empty())
+    {
+      WriteJsonKey(out, "serviceName", first_field);
+      WriteJsonString(out, service_name);
+    }
+    if (!local_endpoint->ipv4.empty())
+    {
+      WriteJsonKey(out, "ipv4", first_field);
+      WriteJsonString(out, local_endpoint->ipv4);
+    }
+    if (!local_endpoint->ipv6.empty())
+    {
+      WriteJsonKey(out, "ipv6", first_field);
+      WriteJsonString(out, local_endpoint->ipv6);
+    }
+    WriteJsonKey(out, "port", first_field);
+    WriteJsonInteger(out, static_cast<uint64_t>(local_endpoint->port));
+    out.push_back('}');
+  }
+  if (!annotations_.empty())
+  {
+    WriteJsonKey(out, "annotations", first);
+    out.push_back('[');
+    for (std::size_t i = 0; i < annotations_.size(); ++i)
+    {
+      if (i != 0)
+      {
+        out.push_back(',');
+      }
+      Append(out, "{\"timestamp\":");
+      WriteJsonInteger(out, annotations_[i].timestamp);
+      Append(out, ",\"value\":");
+      WriteJsonString(out, annotations_[i].value);
+      out.push_back('}');
+    }
+    out.push_back(']');
+  }
+  if (!tags_.empty())
+  {
+    WriteJsonKey(out, "tags", first);
+    WriteJsonObject(out, tags_);
+  }
+  out.push_back('}');
+}
+
+void Recordable::WriteProto(std::vector<uint8_t> &out, const LocalEndpoint &local_endpoint) const
+{
+  // ListOfSpans.spans
+  std::size_t span_start = BeginMessage(out, 1);
+  if (has_identity_)
+  {
+    WriteBytesField(out, 1, trace_id_.Id().data(), trace_api::TraceId::kSize);
+    if (parent_span_id_.IsValid())
+    {
+      WriteBytesField(out, 2, parent_span_id_.Id().data(), trace_api::SpanId::kSize);
+    }
+    WriteBytesField(out, 3, span_id_.Id().data(), trace_api::SpanId::kSize);
+  }
+  if (has_kind_)
+  {
+    WriteVarintField(out, 4, GetSpanKindNumber(kind_));
+  }
+  if (has_name_)
+  {
+    WriteBytesField(out, 5, name_.data(), name_.size());
+  }
+  if (has_timestamp_)
+  {
+    WriteFixed64Field(out, 6, static_cast<uint64_t>(timestamp_));
+  }
+  if (has_duration_)
+  {
+    WriteVarintField(out, 7, static_cast<uint64_t>(duration_));
+  }
+
+  // The proto3 model takes addresses as bytes. Only IPv4 is converted: an IPv6 address is left out.
+  const std::string &service_name =
+      service_name_.empty() ? local_endpoint.service_name : service_name_;
+  std::size_t endpoint_start = BeginMessage(out, 8);
+  if (!service_name.empty())
+  {
+    WriteBytesField(out, 1, service_name.data(), service_name.size());
+  }
+  uint8_t ipv4[4];
+  if (!local_endpoint.ipv4.empty() && ParseIpv4(local_endpoint.ipv4, ipv4))
+  {
+    WriteBytesField(out, 2, ipv4, sizeof(ipv4));
+  }
+  if (local_endpoint.port != 0)
+  {
+    WriteVarintField(out, 4, local_endpoint.port);
+  }
+  EndMessage(out, endpoint_start);
+
+  for (const auto &annotation : annotations_)
+  {
+    std::size_t annotation_start = BeginMessage(out, 10);
+    WriteFixed64Field(out, 1, static_cast<uint64_t>(annotation.timestamp));
+    WriteBytesField(out, 2, annotation.value.data(), annotation.value.size());
+    EndMessage(out, annotation_start);
+  }
+
+  // Tags are a map of strings: values other than strings are written as JSON.
+  Buffer value;
+  for (const auto &tag : tags_)
+  {
+    std::size_t tag_start = BeginMessage(out, 11);
+    WriteBytesField(out, 1, tag.first.data(), tag.first.size());
+    if (nostd::holds_alternative<std::string>(tag.second))
+    {
+      const auto &text = nostd::get<std::string>(tag.second);
+      WriteBytesField(out, 2, text.data(), text.size());
+    }
+    else
+    {
+      value.clear();
+      JsonValueWriter writer{value};
+      nostd::visit(writer, tag.second);
+      WriteBytesField(out, 2, value.data(), value.size());
+    }
+    EndMessage(out, tag_start);
+  }
+  EndMessage(out, span_start);
 }
 
 }  // namespace zipkin
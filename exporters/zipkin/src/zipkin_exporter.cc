@@ -17,12 +17,21 @@ namespace exporter
 namespace zipkin
 {
 
+namespace
+{
+// Above this size, the request body is released after each export rather than reused.
+const std::size_t kMaxRetainedBodySize = 4 * 1024 * 1024;
+}  // namespace
+
 // -------------------------------- Constructors --------------------------------
 
 ZipkinExporter::ZipkinExporter(const ZipkinExporterOptions &options)
     : options_(options), url_parser_(options_.endpoint)
 {
-  http_client_ = ext::http::client::HttpClientFactory::CreateSync();
+  ext::http::client::HttpClientOptions http_client_options;
+  http_client_options.max_requests_in_flight = options_.max_requests_in_flight;
+  http_client_options.max_pending_requests   = options_.max_pending_requests;
+  http_client_ = ext::http::client::HttpClientFactory::CreateSync(http_client_options);
   InitializeLocalEndpoint();
 }
 
@@ -40,6 +49,8 @@ ZipkinExporter::ZipkinExporter(
   InitializeLocalEndpoint();
 }
 
+ZipkinExporter::~ZipkinExporter() = default;
+
 // ----------------------------- Exporter methods ------------------------------
 
 std::unique_ptr<sdk::trace::Recordable> ZipkinExporter::MakeRecordable() noexcept
@@ -56,27 +67,44 @@ sdk::common::ExportResult ZipkinExporter::Export(
                             << spans.size() << " span(s) failed, exporter is shutdown");
     return sdk::common::ExportResult::kFailure;
   }
-  exporter::zipkin::ZipkinSpan json_spans = {};
+  const std::lock_guard<std::mutex> body_guard(body_lock_);
+  body_.clear();
+  const bool protobuf = options_.format == TransportFormat::kProtobuf;
+  if (!protobuf)
+  {
+    body_.push_back('[');
+  }
+  bool first = true;
   for (auto &recordable : spans)
   {
     auto rec = std::unique_ptr<Recordable>(static_cast<Recordable *>(recordable.release()));
-    if (rec != nullptr)
+    if (rec == nullptr)
     {
-      auto json_span = rec->span();
-      // add localEndPoint
-      json_span["localEndpoint"] = local_end_point_;
-      // check service.name
-      auto service_name = rec->GetServiceName();
-      if (service_name.size())
+      continue;
+    }
+    if (protobuf)
+    {
+      rec->WriteProto(body_, *local_endpoint_);
+    }
+    else
+    {
+      if (!first)
       {
-        json_span["localEndpoint"]["serviceName"] = service_name;
+        body_.push_back(',');
       }
-      json_spans.push_back(json_span);
+      rec->WriteJson(body_, local_endpoint_.get());
     }
+    first = false;
+  }
+  if (!protobuf)
+  {
+    body_.push_back(']');
+  }
+  auto result = http_client_->Post(url_parser_.url_, body_, options_.headers);
+  if (body_.capacity() > kMaxRetainedBodySize)
+  {
+    http_client::Body().swap(body_);
   }
-  auto body_s = json_spans.dump();
-  http_client::Body body_v(body_s.begin(), body_s.end());
-  auto result = http_client_->Post(url_parser_.url_, body_v, options_.headers);
   if (result &&
       (result.GetResponse().GetStatusCode() == 200 || result.GetResponse().GetStatusCode() == 202))
   {
@@ -95,19 +123,20 @@ sdk::common::ExportResult ZipkinExporter::Export(
 
 void ZipkinExporter::InitializeLocalEndpoint()
 {
-  if (options_.service_name.length())
-  {
-    local_end_point_["serviceName"] = options_.service_name;
-  }
-  if (options_.ipv4.length())
-  {
-    local_end_point_["ipv4"] = options_.ipv4;
-  }
-  if (options_.ipv6.length())
+  local_endpoint_.reset(new LocalEndpoint);
+  local_endpoint_->service_name = options_.service_name;
+  local_endpoint_->ipv4         = options_.ipv4;
+  local_endpoint_->ipv6         = options_.ipv6;
+  local_endpoint_->port         = url_parser_.port_;
+
+  if (options_.format == TransportFormat::kProtobuf)
   {
-    local_end_point_["ipv6"] = options_.ipv6;
+    auto content_type = options_.headers.find("content-type");
+    if (content_type != options_.headers.end() && content_type->second == "application/json")
+    {
+      content_type->second = "application/x-protobuf";
+    }
   }
-  local_end_point_["port"] = url_parser_.port_;
 }
 
 bool ZipkinExporter::Shutdown(std::chrono::microseconds timeout) noexcept
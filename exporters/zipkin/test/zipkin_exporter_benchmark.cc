@@ -0,0 +1,72 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/zipkin/recordable.h"
+#include "test/trace/span_shapes.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace zipkin = opentelemetry::exporter::zipkin;
+using span_shapes::SpanShape;
+
+namespace
+{
+enum class Format
+{
+  kJson,
+  kProtobuf
+};
+
+// Serializes batches into the request body of the exporter, without sending them.
+void BM_ZipkinSerialization(benchmark::State &state, Format format)
+{
+  std::vector<std::unique_ptr<zipkin::Recordable>> spans;
+  for (int i = 0; i < span_shapes::kSpansPerBatch; ++i)
+  {
+    spans.emplace_back(new zipkin::Recordable);
+    span_shapes::FillSpan(*spans.back(), static_cast<SpanShape>(state.range(0)), i);
+  }
+  zipkin::LocalEndpoint local_endpoint;
+  local_endpoint.service_name = "benchmark";
+  local_endpoint.ipv4         = "192.168.1.1";
+
+  std::vector<uint8_t> body;
+  uint64_t bytes = 0;
+  for (auto _ : state)
+  {
+    body.clear();
+    if (format == Format::kJson)
+    {
+      body.push_back('[');
+      for (auto &span : spans)
+      {
+        if (body.size() > 1)
+        {
+          body.push_back(',');
+        }
+        span->WriteJson(body, &local_endpoint);
+      }
+      body.push_back(']');
+    }
+    else
+    {
+      for (auto &span : spans)
+      {
+        span->WriteProto(body, local_endpoint);
+      }
+    }
+    benchmark::DoNotOptimize(body.data());
+    bytes += body.size();
+  }
+  span_shapes::ReportThroughput(state, bytes);
+}
+BENCHMARK_CAPTURE(BM_ZipkinSerialization, json, Format::kJson)->Apply(span_shapes::ApplyShapes);
+BENCHMARK_CAPTURE(BM_ZipkinSerialization, protobuf, Format::kProtobuf)
+    ->Apply(span_shapes::ApplyShapes);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -283,3 +283,79 @@ TYPED_TEST(ZipkinIntAttributeTest, SetIntArrayAttribute)
   nlohmann::json j_span = {{"tags", {{"int_arr_attr", {4, 5, 6}}}}};
   EXPECT_EQ(rec.span(), j_span);
 }
+
+TEST(ZipkinSpanRecordable, WriteJsonEscapesStrings)
+{
+  zipkin::Recordable rec;
+  rec.SetName("quote\" backslash\\ newline\n control\x01");
+  rec.SetAttribute("double_attr", 2.0);
+
+  std::vector<uint8_t> out;
+  rec.WriteJson(out, nullptr);
+  EXPECT_EQ(std::string(out.begin(), out.end()),
+            "{\"name\":\"quote\\\" backslash\\\\ newline\\n control\\u0001\","
+            "\"tags\":{\"double_attr\":2.0}}");
+  EXPECT_EQ(rec.span()["name"], "quote\" backslash\\ newline\n control\x01");
+}
+
+TEST(ZipkinSpanRecordable, WriteJsonLocalEndpoint)
+{
+  zipkin::LocalEndpoint local_endpoint;
+  local_endpoint.service_name = "default-service";
+  local_endpoint.ipv4         = "10.0.0.1";
+  local_endpoint.port         = 9411;
+
+  zipkin::Recordable rec;
+  std::vector<uint8_t> out;
+  rec.WriteJson(out, &local_endpoint);
+  json expected = {{"localEndpoint",
+                    {{"serviceName", "default-service"}, {"ipv4", "10.0.0.1"}, {"port", 9411}}}};
+  EXPECT_EQ(json::parse(out.begin(), out.end()), expected);
+
+  // The service name of the resource takes precedence.
+  rec.SetResource(opentelemetry::sdk::resource::Resource::Create({{"service.name", "test"}}));
+  out.clear();
+  rec.WriteJson(out, &local_endpoint);
+  EXPECT_EQ(json::parse(out.begin(), out.end())["localEndpoint"]["serviceName"], "test");
+}
+
+TEST(ZipkinSpanRecordable, WriteProto)
+{
+  zipkin::LocalEndpoint local_endpoint;
+  local_endpoint.service_name = "svc";
+  local_endpoint.ipv4         = "10.0.0.1";
+  local_endpoint.port         = 9411;
+
+  zipkin::Recordable rec;
+  const trace::TraceId trace_id(std::array<const uint8_t, trace::TraceId::kSize>(
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}));
+  const trace::SpanId span_id(
+      std::array<const uint8_t, trace::SpanId::kSize>({0, 0, 0, 0, 0, 0, 0, 2}));
+  rec.SetIdentity(trace::SpanContext{trace_id, span_id, trace::TraceFlags{}, false},
+                  trace::SpanId());
+  rec.SetName("op");
+  rec.SetSpanKind(trace::SpanKind::kServer);
+  rec.SetDuration(std::chrono::microseconds(300));
+  rec.SetAttribute("count", 7);
+
+  std::vector<uint8_t> out;
+  rec.WriteProto(out, local_endpoint);
+
+  std::vector<uint8_t> expected = {0x0a, 65,
+                                   // trace_id
+                                   0x0a, 16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+                                   // id
+                                   0x1a, 8, 0, 0, 0, 0, 0, 0, 0, 2,
+                                   // kind
+                                   0x20, 2,
+                                   // name
+                                   0x2a, 2, 'o', 'p',
+                                   // duration
+                                   0x38, 0xac, 0x02,
+                                   // local_endpoint
+                                   0x42, 14, 0x0a, 3, 's', 'v', 'c', 0x12, 4, 10, 0, 0, 1, 0x20,
+                                   0xc3, 0x49,
+                                   // tags
+                                   0x5a, 10, 0x0a, 5, 'c', 'o', 'u', 'n', 't', 0x12, 1, '7'};
+  EXPECT_EQ(out, expected);
+}
@@ -6,10 +6,15 @@
 #include "http_operation_curl.h"
 #include "opentelemetry/ext/http/client/http_client.h"
 #include "opentelemetry/ext/http/common/url_parser.h"
+#include "opentelemetry/sdk/common/fork_handler.h"
 #include "opentelemetry/version.h"
 
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -37,6 +42,13 @@ class Request : public opentelemetry::ext::http::client::Request
   void SetBody(opentelemetry::ext::http::client::Body &body) noexcept override
   {
     body_ = std::move(body);
+    body_chunks_.clear();
+  }
+
+  void SetBodyChunks(std::vector<opentelemetry::ext::http::client::Body> &&chunks) noexcept override
+  {
+    body_.clear();
+    body_chunks_ = std::move(chunks);
   }
 
   void AddHeader(nostd::string_view name, nostd::string_view value) noexcept override
@@ -66,6 +78,8 @@ class Request : public opentelemetry::ext::http::client::Request
 public:
   opentelemetry::ext::http::client::Method method_;
   opentelemetry::ext::http::client::Body body_;
+  // Body made of chunks, read by curl chunk by chunk instead of body_
+  std::vector<opentelemetry::ext::http::client::Body> body_chunks_;
   opentelemetry::ext::http::client::Headers headers_;
   std::string uri_;
   std::chrono::milliseconds timeout_ms_{5000};  // ms
@@ -128,10 +142,11 @@ class Session : public opentelemetry::ext::http::client::Session
 {
 public:
   Session(HttpClient &http_client,
-          std::string scheme      = "http",
-          const std::string &host = "",
-          uint16_t port           = 80)
-      : http_client_(http_client), is_session_active_(false)
+          std::string scheme                  = "http",
+          const std::string &host             = "",
+          uint16_t port                       = 80,
+          const std::string &unix_socket_path = "")
+      : unix_socket_path_(unix_socket_path), http_client_(http_client), is_session_active_(false)
   {
     host_ = scheme + "://" + host + ":" + std::to_string(port) + "/";
   }
@@ -143,33 +158,7 @@ class Session : public opentelemetry::ext::http::client::Session
   }
 
   virtual void SendRequest(
-      opentelemetry::ext::http::client::EventHandler &callback) noexcept override
-  {
-    is_session_active_ = true;
-    std::string url    = host_ + std::string(http_request_->uri_);
-    auto callback_ptr  = &callback;
-    curl_operation_.reset(new HttpOperation(
-        http_request_->method_, url, callback_ptr, RequestMode::Async, http_request_->headers_,
-        http_request_->body_, false, http_request_->timeout_ms_));
-    curl_operation_->SendAsync([this, callback_ptr](HttpOperation &operation) {
-      if (operation.WasAborted())
-      {
-        // Manually cancelled
-        callback_ptr->OnEvent(opentelemetry::ext::http::client::SessionState::Cancelled, "");
-      }
-
-      if (operation.GetResponseCode() >= CURL_LAST)
-      {
-        // we have a http response
-        auto response          = std::unique_ptr<Response>(new Response());
-        response->headers_     = operation.GetResponseHeaders();
-        response->body_        = operation.GetResponseBody();
-        response->status_code_ = operation.GetResponseCode();
-        callback_ptr->OnResponse(*response);
-      }
-      is_session_active_ = false;
-    });
-  }
+      opentelemetry::ext::http::client::EventHandler &callback) noexcept override;
 
   virtual bool CancelSession() noexcept override;
 
@@ -191,76 +180,37 @@ class Session : public opentelemetry::ext::http::client::Session
 private:
   std::shared_ptr<Request> http_request_;
   std::string host_;
+  std::string unix_socket_path_;
   std::unique_ptr<HttpOperation> curl_operation_;
   uint64_t session_id_;
   HttpClient &http_client_;
   bool is_session_active_;
 };
 
-class HttpClientSync : public opentelemetry::ext::http::client::HttpClientSync
-{
-public:
-  HttpClientSync() { curl_global_init(CURL_GLOBAL_ALL); }
-
-  opentelemetry::ext::http::client::Result Get(
-      const nostd::string_view &url,
-      const opentelemetry::ext::http::client::Headers &headers) noexcept override
-  {
-    opentelemetry::ext::http::client::Body body;
-    HttpOperation curl_operation(opentelemetry::ext::http::client::Method::Get, url.data(), nullptr,
-                                 RequestMode::Sync, headers, body);
-    curl_operation.SendSync();
-    auto session_state = curl_operation.GetSessionState();
-    if (curl_operation.WasAborted())
-    {
-      session_state = opentelemetry::ext::http::client::SessionState::Cancelled;
-    }
-    auto response = std::unique_ptr<Response>(new Response());
-    if (curl_operation.GetResponseCode() >= CURL_LAST)
-    {
-      // we have a http response
-
-      response->headers_     = curl_operation.GetResponseHeaders();
-      response->body_        = curl_operation.GetResponseBody();
-      response->status_code_ = curl_operation.GetResponseCode();
-    }
-    return opentelemetry::ext::http::client::Result(std::move(response), session_state);
-  }
-
-  opentelemetry::ext::http::client::Result Post(
-      const nostd::string_view &url,
-      const Body &body,
-      const opentelemetry::ext::http::client::Headers &headers) noexcept override
-  {
-    HttpOperation curl_operation(opentelemetry::ext::http::client::Method::Post, url.data(),
-                                 nullptr, RequestMode::Sync, headers, body);
-    curl_operation.SendSync();
-    auto session_state = curl_operation.GetSessionState();
-    if (curl_operation.WasAborted())
-    {
-      session_state = opentelemetry::ext::http::client::SessionState::Cancelled;
-    }
-    auto response = std::unique_ptr<Response>(new Response());
-    if (curl_operation.GetResponseCode() >= CURL_LAST)
-    {
-      // we have a http response
-
-      response->headers_     = curl_operation.GetResponseHeaders();
-      response->body_        = curl_operation.GetResponseBody();
-      response->status_code_ = curl_operation.GetResponseCode();
-    }
-
-    return opentelemetry::ext::http::client::Result(std::move(response), session_state);
-  }
-
-  ~HttpClientSync() { curl_global_cleanup(); }
-};
-
+/**
+ * Sends the requests of its sessions asynchronously. All the requests are performed by one curl
+ * multi handle, on a thread started with the first request, so that they share the connection
+ * cache of the multi handle: connections to a host are kept alive and reused from one session to
+ * the next, and concurrent requests are multiplexed on HTTP/2 connections.
+ *
+ * At most options.max_requests_in_flight requests are performed at the same time, the others wait
+ * in a queue. When a collector is down, requests pile up in the queue rather than in threads and
+ * sockets, and once the queue is full the oldest request is dropped: it fails as cancelled.
+ *
+ * Curl is initialized, and the thread started, by the first request rather than by the
+ * constructor, so that creating a client costs little to applications which start quickly. The
+ * connections are then set up on the thread, without blocking the caller. The requests share a
+ * DNS cache and TLS sessions, which Prewarm fills ahead of the first request.
+ *
+ * The thread is stopped before a fork and restarted afterwards. The child starts over with a new
+ * multi handle, without the connections and requests of the parent, so that it never writes to
+ * the sockets the parent uses.
+ */
 class HttpClient : public opentelemetry::ext::http::client::HttpClient
 {
 public:
-  // The call (curl_global_init) is not thread safe. Ensure this is called only once.
-  HttpClient() : next_session_id_{0} { curl_global_init(CURL_GLOBAL_ALL); }
+  HttpClient(const opentelemetry::ext::http::client::HttpClientOptions &options =
+                 opentelemetry::ext::http::client::HttpClientOptions());
 
   std::shared_ptr<opentelemetry::ext::http::client::Session> CreateSession(
       nostd::string_view url) noexcept override
@@ -270,8 +220,10 @@ class HttpClient : public opentelemetry::ext::http::client::HttpClient
     {
       return std::make_shared<Session>(*this);
     }
-    auto session =
-        std::make_shared<Session>(*this, parsedUrl.scheme_, parsedUrl.host_, parsedUrl.port_);
+    // Requests over a Unix domain socket are plain HTTP requests.
+    auto session = std::make_shared<Session>(
+        *this, parsedUrl.unix_socket_path_.empty() ? parsedUrl.scheme_ : "http", parsedUrl.host_,
+        parsedUrl.port_, parsedUrl.unix_socket_path_);
     auto session_id = ++next_session_id_;
     session->SetId(session_id);
     sessions_.insert({session_id, session});
@@ -280,7 +232,9 @@ class HttpClient : public opentelemetry::ext::http::client::HttpClient
 
   bool CancelAllSessions() noexcept override
   {
-    for (auto &session : sessions_)
+    // CancelSession removes the session from sessions_, iterate over a copy.
+    auto sessions = sessions_;
+    for (auto &session : sessions)
     {
       session.second->CancelSession();
     }
@@ -289,7 +243,9 @@ class HttpClient : public opentelemetry::ext::http::client::HttpClient
 
   bool FinishAllSessions() noexcept override
   {
-    for (auto &session : sessions_)
+    // FinishSession removes the session from sessions_, iterate over a copy.
+    auto sessions = sessions_;
+    for (auto &session : sessions)
     {
       session.second->FinishSession();
     }
@@ -302,11 +258,123 @@ class HttpClient : public opentelemetry::ext::http::client::HttpClient
     sessions_.erase(session_id);
   }
 
-  ~HttpClient() { curl_global_cleanup(); }
+  const opentelemetry::ext::http::client::HttpClientOptions &GetOptions() const noexcept
+  {
+    return options_;
+  }
+
+  /**
+   * Initialize curl and the multi handle, if not done yet. Must be called before the first
+   * HttpOperation of the client is created.
+   */
+  void Initialize();
+
+  /**
+   * Connects to the server of url on the thread of the multi handle, without sending a request,
+   * which fills the DNS cache and the TLS sessions the requests of the client share.
+   */
+  void Prewarm(nostd::string_view url) noexcept override;
+
+  /**
+   * Hand a request prepared by HttpOperation::PrepareAsync to the multi handle. The operation
+   * is completed on the thread of the multi handle, or on the calling thread if it is dropped
+   * right away, and must outlive its completion. It shares the DNS cache and TLS sessions of
+   * the client.
+   */
+  void StartOperation(HttpOperation &operation);
+
+  ~HttpClient();
 
 private:
+  /**
+   * Perform the requests until the client is destroyed.
+   */
+  void PerformOperations();
+
+  /**
+   * Create and configure multi_handle_.
+   */
+  void InitMultiHandle();
+
+  /**
+   * Called before a fork: stops the thread, leaving the requests in the multi handle, and holds
+   * mutex_ until after the fork.
+   */
+  void PrepareFork();
+
+  /**
+   * Called in the parent after a fork: restarts the thread if requests are left.
+   */
+  void ParentAfterFork();
+
+  /**
+   * Called in the child after a fork: abandons the multi handle of the parent, with its
+   * connections, for a new one, and completes the requests of the parent as aborted.
+   */
+  void ChildAfterFork();
+
+  const opentelemetry::ext::http::client::HttpClientOptions options_;
   std::atomic<uint64_t> next_session_id_;
   std::map<uint64_t, std::shared_ptr<Session>> sessions_;
+
+  bool is_initialized_;
+  CURLM *multi_handle_;
+  // Shared by the operations of the client, created along with the multi handle
+  std::shared_ptr<CurlShare> share_;
+  // Connections opened by Prewarm, owned until the client is destroyed, with their empty
+  // headers and body
+  opentelemetry::ext::http::client::Headers prewarm_headers_;
+  opentelemetry::ext::http::client::Body prewarm_body_;
+  std::vector<std::unique_ptr<HttpOperation>> prewarm_operations_;
+  std::thread thread_;
+  std::mutex mutex_;
+  bool is_stopping_;
+  // Set while a fork is in progress, to keep the thread stopped
+  bool is_paused_;
+  // Operations waiting to be added to the multi handle, oldest first
+  std::deque<HttpOperation *> pending_operations_;
+  // Operations performed by the multi handle, only used by thread_
+  std::vector<HttpOperation *> running_operations_;
+  // Reset first by the destructor, so that no fork stops the thread while it is joined
+  std::unique_ptr<sdk::common::ForkHandlerRegistration> fork_handler_;
+};
+
+/**
+ * Sends requests synchronously. The requests are performed by the multi handle of an HttpClient,
+ * so that they share its connections and are bound by its limits.
+ */
+class HttpClientSync : public opentelemetry::ext::http::client::HttpClientSync
+{
+public:
+  HttpClientSync(const opentelemetry::ext::http::client::HttpClientOptions &options =
+                     opentelemetry::ext::http::client::HttpClientOptions())
+      : http_client_(options)
+  {}
+
+  opentelemetry::ext::http::client::Result Get(
+      const nostd::string_view &url,
+      const opentelemetry::ext::http::client::Headers &headers) noexcept override
+  {
+    opentelemetry::ext::http::client::Body body;
+    return Send(opentelemetry::ext::http::client::Method::Get, url, body, headers);
+  }
+
+  opentelemetry::ext::http::client::Result Post(
+      const nostd::string_view &url,
+      const Body &body,
+      const opentelemetry::ext::http::client::Headers &headers) noexcept override
+  {
+    return Send(opentelemetry::ext::http::client::Method::Post, url, body, headers);
+  }
+
+private:
+  opentelemetry::ext::http::client::Result Send(
+      opentelemetry::ext::http::client::Method method,
+      const nostd::string_view &url,
+      const Body &body,
+      const opentelemetry::ext::http::client::Headers &headers) noexcept;
+
+  HttpClient http_client_;
 };
 
 }  // namespace curl
@@ -7,19 +7,18 @@
 #include "opentelemetry/ext/http/client/http_client.h"
 #include "opentelemetry/version.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <vector>
-#ifdef _WIN32
-#  include <io.h>
-#  include <winsock2.h>
-#else
-#  include <poll.h>
-#  include <unistd.h>
-#endif
 #include <curl/curl.h>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -41,6 +40,55 @@ enum class RequestMode
   Async
 };
 
+/**
+ * A curl share handle, through which the operations of a client share their DNS cache and their
+ * TLS sessions: requests to a host resolved, or connected to, by a previous request skip the name
+ * resolution and resume the TLS session rather than performing a full handshake. It is cleaned up
+ * once the last operation using it is destroyed.
+ */
+class CurlShare
+{
+public:
+  CurlShare() : handle_(curl_share_init())
+  {
+    if (handle_ != nullptr)
+    {
+      curl_share_setopt(handle_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(handle_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+      curl_share_setopt(handle_, CURLSHOPT_LOCKFUNC, &CurlShare::Lock);
+      curl_share_setopt(handle_, CURLSHOPT_UNLOCKFUNC, &CurlShare::Unlock);
+      curl_share_setopt(handle_, CURLSHOPT_USERDATA, this);
+    }
+  }
+
+  CurlShare(const CurlShare &)            = delete;
+  CurlShare &operator=(const CurlShare &) = delete;
+
+  ~CurlShare()
+  {
+    if (handle_ != nullptr)
+    {
+      curl_share_cleanup(handle_);
+    }
+  }
+
+  CURLSH *GetHandle() const noexcept { return handle_; }
+
+private:
+  static void Lock(CURL *, curl_lock_data data, curl_lock_access, void *userptr)
+  {
+    static_cast<CurlShare *>(userptr)->mutexes_[data].lock();
+  }
+
+  static void Unlock(CURL *, curl_lock_data data, void *userptr)
+  {
+    static_cast<CurlShare *>(userptr)->mutexes_[data].unlock();
+  }
+
+  CURLSH *handle_;
+  std::mutex mutexes_[CURL_LOCK_DATA_LAST];
+};
+
 class HttpOperation
 {
 public:
@@ -69,6 +117,7 @@ class HttpOperation
    * @param body  Reques Body
    * @param raw_response whether to parse the response
    * @param httpConnTimeout   HTTP connection timeout in seconds
+   * @param options  Connection options
    */
   HttpOperation(opentelemetry::ext::http::client::Method method,
                 std::string url,
@@ -81,12 +130,15 @@ class HttpOperation
                     opentelemetry::ext::http::client::Body(),
                 // Default connectivity and response size options
                 bool is_raw_response                        = false,
-                std::chrono::milliseconds http_conn_timeout = default_http_conn_timeout)
+                std::chrono::milliseconds http_conn_timeout = default_http_conn_timeout,
+                const opentelemetry::ext::http::client::HttpClientOptions &options =
+                    opentelemetry::ext::http::client::HttpClientOptions())
       : is_aborted_(false),
         is_finished_(false),
         // Optional connection params
         is_raw_response_(is_raw_response),
         http_conn_timeout_(http_conn_timeout),
+        options_(options),
         request_mode_(request_mode),
         curl_(nullptr),
         // Result
@@ -97,7 +149,6 @@ class HttpOperation
         // Local vars
         request_headers_(request_headers),
         request_body_(request_body),
-        sockfd_(0),
         nread_(0)
   {
     /* get a curl handle */
@@ -114,9 +165,12 @@ class HttpOperation
     // Specify target URL
     curl_easy_setopt(curl_, CURLOPT_URL, url_.c_str());
 
-    // TODO: support ssl cert verification for https request
-    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYPEER, 0);  // 1L
-    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYHOST, 0);  // 2L
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYPEER, options_.ssl_verify_peer ? 1L : 0L);
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYHOST, options_.ssl_verify_peer ? 2L : 0L);
+    if (!options_.ssl_ca_cert_path.empty())
+    {
+      curl_easy_setopt(curl_, CURLOPT_CAINFO, options_.ssl_ca_cert_path.c_str());
+    }
 
     // Specify our custom headers
     for (auto &kv : this->request_headers_)
@@ -167,131 +221,96 @@ class HttpOperation
   }
 
   /**
-   * Send request synchronously
+   * Send a body made of chunks instead of the request body. The chunks are read by curl as the
+   * request is sent, without being copied into one buffer, and must outlive the operation.
    */
-  long Send()
+  void SetRequestBodyChunks(const std::vector<opentelemetry::ext::http::client::Body> &chunks)
   {
-    ReleaseResponse();
-    // Request buffer
-    const void *request   = (request_body_.empty()) ? NULL : &request_body_[0];
-    const size_t req_size = request_body_.size();
-    if (!curl_)
+    request_body_chunks_ = &chunks;
+  }
+
+  /**
+   * Connect to the Unix domain socket at path, e.g. of a node-local collector, instead of the host
+   * of the url, which is still sent in the Host header.
+   */
+  void SetUnixSocketPath(const std::string &path)
+  {
+    if (curl_ != nullptr)
     {
-      res_ = CURLE_FAILED_INIT;
-      DispatchEvent(opentelemetry::ext::http::client::SessionState::SendFailed);
-      return res_;
+      curl_easy_setopt(curl_, CURLOPT_UNIX_SOCKET_PATH, path.c_str());
     }
+  }
 
-    // TODO: control local port to use
-    // curl_easy_setopt(curl, CURLOPT_LOCALPORT, dcf_port);
-
-    // Perform initial connect, handling the timeout if needed
-    curl_easy_setopt(curl_, CURLOPT_CONNECT_ONLY, 1L);
-    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, http_conn_timeout_.count());
-    DispatchEvent(opentelemetry::ext::http::client::SessionState::Connecting);
-    res_ = curl_easy_perform(curl_);
-    if (CURLE_OK != res_)
+  /**
+   * Share the DNS cache and the TLS sessions of share with the other operations of the client.
+   */
+  void SetShare(std::shared_ptr<CurlShare> share)
+  {
+    share_ = std::move(share);
+    if (curl_ != nullptr && share_ != nullptr)
     {
-      DispatchEvent(opentelemetry::ext::http::client::SessionState::ConnectFailed,
-                    curl_easy_strerror(res_));  // couldn't connect - stage 1
-      return res_;
+      curl_easy_setopt(curl_, CURLOPT_SHARE, share_->GetHandle());
     }
+  }
 
-    /* Extract the socket from the curl handle - we'll need it for waiting.
-     * Note that this API takes a pointer to a 'long' while we use
-     * curl_socket_t for sockets otherwise.
-     */
-    long sockextr = 0;
-    res_          = curl_easy_getinfo(curl_, CURLINFO_LASTSOCKET, &sockextr);
-
-    if (CURLE_OK != res_)
+  /**
+   * Only connect to the server, without sending a request: see HttpClient::Prewarm.
+   */
+  void SetConnectOnly()
+  {
+    if (curl_ != nullptr)
     {
-      DispatchEvent(opentelemetry::ext::http::client::SessionState::ConnectFailed,
-                    curl_easy_strerror(res_));  // couldn't connect - stage 2
-      return res_;
+      curl_easy_setopt(curl_, CURLOPT_CONNECT_ONLY, 1L);
     }
+  }
 
-    /* wait for the socket to become ready for sending */
-    sockfd_ = sockextr;
-    if (!WaitOnSocket(sockfd_, 0, static_cast<long>(http_conn_timeout_.count())) || is_aborted_)
+  /**
+   * Send request synchronously
+   */
+  long Send()
+  {
+    ReleaseResponse();
+    if (!Prepare())
     {
-      res_ = CURLE_OPERATION_TIMEDOUT;
-      DispatchEvent(
-          opentelemetry::ext::http::client::SessionState::ConnectFailed,
-          " Is aborted: " + std::to_string(is_aborted_.load()));  // couldn't connect - stage 3
+      DispatchEvent(opentelemetry::ext::http::client::SessionState::SendFailed);
       return res_;
     }
 
-    DispatchEvent(opentelemetry::ext::http::client::SessionState::Connected);
-    // once connection is there - switch back to easy perform for HTTP post
-    curl_easy_setopt(curl_, CURLOPT_CONNECT_ONLY, 0);
-
-    // send all data to our callback function
-    if (is_raw_response_)
-    {
-      curl_easy_setopt(curl_, CURLOPT_HEADER, true);
-      curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, (void *)&WriteMemoryCallback);
-      curl_easy_setopt(curl_, CURLOPT_WRITEDATA, (void *)&raw_response_);
-    }
-    else
-    {
-      curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, (void *)&WriteVectorCallback);
-      curl_easy_setopt(curl_, CURLOPT_HEADERDATA, (void *)&resp_headers_);
-      curl_easy_setopt(curl_, CURLOPT_WRITEDATA, (void *)&resp_body_);
-    }
+    // A single perform connects, or reuses a kept-alive connection, and sends the request.
+    DispatchEvent(opentelemetry::ext::http::client::SessionState::Connecting);
+    return Complete(curl_easy_perform(curl_));
+  }
 
-    // TODO: only two methods supported for now - POST and GET
-    if (method_ == opentelemetry::ext::http::client::Method::Post)
-    {
-      // POST
-      curl_easy_setopt(curl_, CURLOPT_POST, true);
-      curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, (const char *)request);
-      curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE, req_size);
-    }
-    else if (method_ == opentelemetry::ext::http::client::Method::Get)
-    {
-      // GET
-    }
-    else
+  /**
+   * Prepare the request to be performed by a curl multi handle. The caller adds the handle to
+   * its multi handle, and calls CompleteAsync once the transfer is done.
+   * @return false if the request cannot be sent, in which case it is not completed.
+   */
+  bool PrepareAsync(std::function<void(HttpOperation &)> callback)
+  {
+    ReleaseResponse();
+    async_callback_ = std::move(callback);
+    async_result_   = std::promise<long>();
+    result_         = async_result_.get_future();
+    if (!Prepare())
     {
-      res_ = CURLE_UNSUPPORTED_PROTOCOL;
-      return res_;
+      return false;
     }
+    DispatchEvent(opentelemetry::ext::http::client::SessionState::Connecting);
+    return true;
+  }
 
-    // abort if slower than 4kb/sec during 30 seconds
-    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_TIME, 30L);
-    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_LIMIT, 4096);
-    DispatchEvent(opentelemetry::ext::http::client::SessionState::Sending);
-
-    res_ = curl_easy_perform(curl_);
-    if (CURLE_OK != res_)
+  /**
+   * Complete a request prepared by PrepareAsync, once its transfer is done or abandoned.
+   */
+  void CompleteAsync(CURLcode code)
+  {
+    long result = Complete(code);
+    if (async_callback_ != nullptr)
     {
-      DispatchEvent(opentelemetry::ext::http::client::SessionState::SendFailed,
-                    curl_easy_strerror(res_));
-      return res_;
+      async_callback_(*this);
     }
-
-    /* Code snippet to parse raw HTTP response. This might come in handy
-     * if we ever consider to handle the raw upload instead of curl_easy_perform
-   ...
-   std::string resp((const char *)response);
-   std::regex http_status_regex(HTTP_STATUS_REGEXP);
-   std::smatch match;
-   if(std::regex_search(resp, match, http_status_regex))
-     http_code = std::stol(match[1]);
-   ...
-     */
-
-    /* libcurl is nice enough to parse the http response code itself: */
-    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &res_);
-    // We got some response from server. Dump the contents.
-    DispatchEvent(opentelemetry::ext::http::client::SessionState::Response);
-
-    // This function returns:
-    // - on success: HTTP status code.
-    // - on failure: CURL error code.
-    // The two sets of enums (CURLE, HTTP codes) - do not intersect, so we collapse them in one set.
-    return res_;
+    async_result_.set_value(result);
   }
 
   std::future<long> &SendAsync(std::function<void(HttpOperation &)> callback = nullptr)
@@ -384,31 +403,23 @@ class HttpOperation
   }
 
   /**
-   * Abort request in connecting or reading state.
+   * Abort request in connecting or reading state. The transfer stops the next time curl reports
+   * its progress, leaving kept-alive connections of other requests untouched.
    */
-  void Abort()
-  {
-    is_aborted_ = true;
-    if (curl_ != nullptr)
-    {
-      // Simply close the socket - connection reset by peer
-      if (sockfd_)
-      {
-#if defined(_WIN32)
-        ::closesocket(sockfd_);
-#else
-        ::close(sockfd_);
-#endif
-        sockfd_ = 0;
-      }
-    }
-  }
+  void Abort() { is_aborted_ = true; }
 
   CURL *GetHandle() { return curl_; }
 
+  /**
+   * Give up the CURL handle without cleaning it up, e.g. in a forked child, where cleaning up a
+   * handle added to the multi handle of the parent would close a connection shared with it.
+   */
+  void LeakHandle() noexcept { curl_ = nullptr; }
+
 protected:
   const bool is_raw_response_;  // Do not split response headers from response body
   const std::chrono::milliseconds http_conn_timeout_;  // Timeout for connect.  Default: 5000ms
+  const opentelemetry::ext::http::client::HttpClientOptions options_;
   RequestMode request_mode_;
 
   CURL *curl_;    // Local curl instance
@@ -422,6 +433,10 @@ class HttpOperation
   const Headers &request_headers_;
   const opentelemetry::ext::http::client::Body &request_body_;
   struct curl_slist *headers_chunk_ = nullptr;
+  const std::vector<opentelemetry::ext::http::client::Body> *request_body_chunks_ = nullptr;
+  // Position of the next byte of the chunks to send
+  size_t body_chunk_index_  = 0;
+  size_t body_chunk_offset_ = 0;
   opentelemetry::ext::http::client::SessionState session_state_;
 
   // Processed response headers and body
@@ -429,96 +444,224 @@ class HttpOperation
   std::vector<uint8_t> resp_body_;
   std::vector<uint8_t> raw_response_;
 
-  // Socket parameters
-  curl_socket_t sockfd_;
-
   curl_off_t nread_;
   size_t sendlen_ = 0;  // # bytes sent by client
   size_t acklen_  = 0;  // # bytes ack by server
 
   std::future<long> result_;
 
+  // Completion of a request performed by a curl multi handle
+  std::function<void(HttpOperation &)> async_callback_;
+  std::promise<long> async_result_;
+
+  // Destroyed after the curl handle, which uses it, is cleaned up
+  std::shared_ptr<CurlShare> share_;
+
   /**
-   * Helper routine to wait for data on socket
-   *
-   * @param sockfd
-   * @param for_recv
-   * @param timeout_ms
-   * @return true if expected events occur, false if timeout or error happen
+   * Set the options of the transfer which depend on the request.
+   * @return false if the request cannot be sent.
    */
-  static bool WaitOnSocket(curl_socket_t sockfd, int for_recv, long timeout_ms)
+  bool Prepare()
   {
-    bool res = false;
+    if (!curl_)
+    {
+      res_ = CURLE_FAILED_INIT;
+      return false;
+    }
 
-#if defined(_WIN32)
+    // send all data to our callback function
+    if (is_raw_response_)
+    {
+      curl_easy_setopt(curl_, CURLOPT_HEADER, true);
+      curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, (void *)&WriteMemoryCallback);
+      curl_easy_setopt(curl_, CURLOPT_WRITEDATA, (void *)&raw_response_);
+    }
+    else
+    {
+      curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, (void *)&WriteVectorCallback);
+      curl_easy_setopt(curl_, CURLOPT_HEADERDATA, (void *)&resp_headers_);
+      curl_easy_setopt(curl_, CURLOPT_WRITEDATA, (void *)&resp_body_);
+    }
 
-    if (sockfd > FD_SETSIZE)
+    // TODO: only two methods supported for now - POST and GET
+    if (method_ == opentelemetry::ext::http::client::Method::Post &&
+        request_body_chunks_ != nullptr)
+    {
+      // POST, with the body read from the chunks. Seeking lets curl send the body again, when a
+      // kept-alive connection turns out to be closed.
+      curl_off_t size = 0;
+      for (const auto &chunk : *request_body_chunks_)
+      {
+        size += static_cast<curl_off_t>(chunk.size());
+      }
+      SeekBodyChunks(0);
+      curl_easy_setopt(curl_, CURLOPT_POST, 1L);
+      curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE_LARGE, size);
+      curl_easy_setopt(curl_, CURLOPT_READFUNCTION, &ReadBodyChunksCallback);
+      curl_easy_setopt(curl_, CURLOPT_READDATA, (void *)this);
+      curl_easy_setopt(curl_, CURLOPT_SEEKFUNCTION, &SeekBodyChunksCallback);
+      curl_easy_setopt(curl_, CURLOPT_SEEKDATA, (void *)this);
+    }
+    else if (method_ == opentelemetry::ext::http::client::Method::Post)
+    {
+      // POST
+      const void *request = (request_body_.empty()) ? NULL : &request_body_[0];
+      curl_easy_setopt(curl_, CURLOPT_POST, true);
+      curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, (const char *)request);
+      curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE_LARGE,
+                       static_cast<curl_off_t>(request_body_.size()));
+    }
+    else if (method_ == opentelemetry::ext::http::client::Method::Get)
+    {
+      // GET
+    }
+    else
+    {
+      res_ = CURLE_UNSUPPORTED_PROTOCOL;
       return false;
+    }
 
-    struct timeval tv;
-    fd_set infd, outfd, errfd;
-
-    tv.tv_sec  = timeout_ms / 1000;
-    tv.tv_usec = (timeout_ms % 1000) * 1000;
+    const long timeout_ms = static_cast<long>(http_conn_timeout_.count());
+    curl_easy_setopt(curl_, CURLOPT_CONNECTTIMEOUT_MS, timeout_ms);
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, timeout_ms);
+    // abort if slower than 4kb/sec during 30 seconds
+    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_TIME, 30L);
+    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_LIMIT, 4096L);
 
-    FD_ZERO(&infd);
-    FD_ZERO(&outfd);
-    FD_ZERO(&errfd);
+    // Abort() is checked whenever curl reports progress
+    curl_easy_setopt(curl_, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFOFUNCTION, &ProgressCallback);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFODATA, (void *)this);
 
-    FD_SET(sockfd, &errfd); /* always check for error */
+    // Connections are kept in the connection cache of the handle, or of the multi handle which
+    // performs it, and reused by the next requests to the same host.
+    if (options_.keep_alive)
+    {
+      const long keep_alive_idle = static_cast<long>(options_.keep_alive_idle.count());
+      curl_easy_setopt(curl_, CURLOPT_TCP_KEEPALIVE, 1L);
+      curl_easy_setopt(curl_, CURLOPT_TCP_KEEPIDLE, keep_alive_idle);
+      curl_easy_setopt(curl_, CURLOPT_TCP_KEEPINTVL, keep_alive_idle);
+    }
+    else
+    {
+      curl_easy_setopt(curl_, CURLOPT_FORBID_REUSE, 1L);
+    }
 
-    if (for_recv)
+    if (options_.http2)
     {
-      FD_SET(sockfd, &infd);
+      // Wait for a connection which may be multiplexed rather than opening another one.
+      curl_easy_setopt(curl_, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+      curl_easy_setopt(curl_, CURLOPT_PIPEWAIT, 1L);
     }
     else
     {
-      FD_SET(sockfd, &outfd);
+      curl_easy_setopt(curl_, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_1_1);
     }
+    return true;
+  }
 
-    /* select() returns the number of signalled sockets or -1 */
-    if (select((int)sockfd + 1, &infd, &outfd, &errfd, &tv) > 0)
+  /**
+   * Dispatch the outcome of a transfer.
+   * @return the HTTP status code on success, the curl error code on failure.
+   */
+  long Complete(CURLcode code)
+  {
+    if (CURLE_OK != code)
     {
-      if (for_recv)
-      {
-        res = (0 != FD_ISSET(sockfd, &infd));
-      }
-      else
-      {
-        res = (0 != FD_ISSET(sockfd, &outfd));
-      }
+      return Fail(code);
     }
 
-#else
+    /* libcurl is nice enough to parse the http response code itself: */
+    long response_code = 0;
+    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &response_code);
+    res_ = static_cast<CURLcode>(response_code);
+    // We got some response from server. Dump the contents.
+    DispatchEvent(opentelemetry::ext::http::client::SessionState::Response);
 
-    struct pollfd fds[1];
-    ::memset(fds, 0, sizeof(fds));
+    // This function returns:
+    // - on success: HTTP status code.
+    // - on failure: CURL error code.
+    // The two sets of enums (CURLE, HTTP codes) - do not intersect, so we collapse them in one set.
+    return res_;
+  }
 
-    fds[0].fd = sockfd;
-    if (for_recv)
+  long Fail(CURLcode code)
+  {
+    res_ = code;
+
+    // Tell failures to connect from failures to send on a connection.
+    curl_off_t connect_time = 0;
+    bool is_connect_failure = code == CURLE_COULDNT_RESOLVE_PROXY ||
+                              code == CURLE_COULDNT_RESOLVE_HOST || code == CURLE_COULDNT_CONNECT;
+    if (!is_connect_failure && curl_ != nullptr &&
+        curl_easy_getinfo(curl_, CURLINFO_CONNECT_TIME_T, &connect_time) == CURLE_OK)
     {
-      fds[0].events = POLLIN;
+      is_connect_failure = connect_time == 0;
     }
-    else
+    DispatchEvent(is_connect_failure
+                      ? opentelemetry::ext::http::client::SessionState::ConnectFailed
+                      : opentelemetry::ext::http::client::SessionState::SendFailed,
+                  is_aborted_ ? " Is aborted: true" : curl_easy_strerror(code));
+    return res_;
+  }
+
+  /**
+   * Move the position of the next byte of the body chunks to send.
+   * @return false if offset is past the end of the body.
+   */
+  bool SeekBodyChunks(curl_off_t offset)
+  {
+    body_chunk_index_  = 0;
+    body_chunk_offset_ = 0;
+    while (body_chunk_index_ < request_body_chunks_->size() &&
+           static_cast<size_t>(offset) >= (*request_body_chunks_)[body_chunk_index_].size())
     {
-      fds[0].events = POLLOUT;
+      offset -= static_cast<curl_off_t>((*request_body_chunks_)[body_chunk_index_].size());
+      ++body_chunk_index_;
     }
+    body_chunk_offset_ = static_cast<size_t>(offset);
+    return body_chunk_index_ < request_body_chunks_->size() || offset == 0;
+  }
 
-    if (poll(fds, 1, timeout_ms) > 0)
+  static size_t ReadBodyChunksCallback(char *buffer, size_t size, size_t nitems, void *userp)
+  {
+    HttpOperation *operation = static_cast<HttpOperation *>(userp);
+    const auto &chunks       = *operation->request_body_chunks_;
+    size_t capacity          = size * nitems;
+    size_t read_size         = 0;
+    while (capacity > 0 && operation->body_chunk_index_ < chunks.size())
     {
-      if (for_recv)
+      const auto &chunk = chunks[operation->body_chunk_index_];
+      size_t count      = (std::min)(capacity, chunk.size() - operation->body_chunk_offset_);
+      std::memcpy(buffer + read_size, chunk.data() + operation->body_chunk_offset_, count);
+      read_size                     += count;
+      capacity                      -= count;
+      operation->body_chunk_offset_ += count;
+      if (operation->body_chunk_offset_ == chunk.size())
       {
-        res = (0 != (fds[0].revents & POLLIN));
-      }
-      else
-      {
-        res = (0 != (fds[0].revents & POLLOUT));
+        ++operation->body_chunk_index_;
+        operation->body_chunk_offset_ = 0;
       }
     }
+    return read_size;
+  }
 
-#endif
+  static int SeekBodyChunksCallback(void *userp, curl_off_t offset, int origin)
+  {
+    HttpOperation *operation = static_cast<HttpOperation *>(userp);
+    if (origin != SEEK_SET || offset < 0 || !operation->SeekBodyChunks(offset))
+    {
+      return CURL_SEEKFUNC_CANTSEEK;
+    }
+    return CURL_SEEKFUNC_OK;
+  }
 
-    return res;
+  /**
+   * Progress callback, which aborts the transfer once Abort() is called.
+   */
+  static int ProgressCallback(void *clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+  {
+    return static_cast<HttpOperation *>(clientp)->is_aborted_ ? 1 : 0;
   }
 
   /**
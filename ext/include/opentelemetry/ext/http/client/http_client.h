@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <map>
 #include <string>
 #include <vector>
@@ -119,6 +120,28 @@ class Request
 
   virtual void SetBody(Body &body) noexcept = 0;
 
+  /**
+   * Set a body made of chunks sent one after the other, so that a body produced in pieces does
+   * not have to be copied into one buffer first. The request takes ownership of the chunks.
+   * Clients which cannot send chunks send their concatenation.
+   */
+  virtual void SetBodyChunks(std::vector<Body> &&chunks) noexcept
+  {
+    std::size_t size = 0;
+    for (const auto &chunk : chunks)
+    {
+      size += chunk.size();
+    }
+    Body body;
+    body.reserve(size);
+    for (const auto &chunk : chunks)
+    {
+      body.insert(body.end(), chunk.begin(), chunk.end());
+    }
+    chunks.clear();
+    SetBody(body);
+  }
+
   virtual void AddHeader(nostd::string_view name, nostd::string_view value) noexcept = 0;
 
   virtual void ReplaceHeader(nostd::string_view name, nostd::string_view value) noexcept = 0;
@@ -223,6 +246,42 @@ class Session
   virtual ~Session() = default;
 };
 
+/**
+ * Options of the connections opened by an HttpClient.
+ */
+struct HttpClientOptions
+{
+  // Keep connections open once a request is done, so that the next requests to the same host
+  // do not pay for a new TCP and TLS handshake.
+  bool keep_alive = true;
+
+  // Idle time of a kept-alive connection before TCP keep-alive probes are sent, and interval of
+  // the probes.
+  std::chrono::seconds keep_alive_idle{60};
+
+  // Maximum number of connections opened to one host, 0 for no limit. Requests beyond the limit
+  // wait for a connection to be free.
+  std::size_t max_connections_per_host = 0;
+
+  // Negotiate HTTP/2 on TLS connections, and multiplex the concurrent requests to a host on one
+  // connection. Plain HTTP connections always use HTTP/1.1.
+  bool http2 = true;
+
+  // Maximum number of requests performed at the same time, 0 for no limit.
+  std::size_t max_requests_in_flight = 64;
+
+  // Maximum number of requests waiting for one of the max_requests_in_flight, 0 for no limit.
+  // Once the queue is full, the oldest waiting request is dropped to make room for the newest.
+  std::size_t max_pending_requests = 256;
+
+  // Verify the certificate of TLS servers, and that it is issued for their host name. Only
+  // disable it to test against servers with self-signed certificates.
+  bool ssl_verify_peer = true;
+
+  // Path of the CA certificates to verify the servers with, empty for the default bundle.
+  std::string ssl_ca_cert_path;
+};
+
 class HttpClient
 {
 public:
@@ -232,6 +291,12 @@ class HttpClient
 
   virtual bool FinishAllSessions() noexcept = 0;
 
+  /**
+   * Connect to the server of url in the background, ahead of the first request, so that the
+   * requests do not wait for the server name to be resolved nor for a full TLS handshake.
+   */
+  virtual void Prewarm(nostd::string_view /* url */) noexcept {}
+
   virtual ~HttpClient() = default;
 };
 
@@ -16,8 +16,12 @@ class HttpClientFactory
 public:
   static std::shared_ptr<HttpClientSync> CreateSync();
 
+  static std::shared_ptr<HttpClientSync> CreateSync(const HttpClientOptions &options);
+
   static std::shared_ptr<HttpClient> Create();
 
+  static std::shared_ptr<HttpClient> Create(const HttpClientOptions &options);
+
   static std::shared_ptr<HttpClient> CreateNoSend();
 };
 }  // namespace client
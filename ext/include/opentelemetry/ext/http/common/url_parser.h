@@ -19,6 +19,7 @@ namespace common
 // host:port/path1
 // host:port ( path defaults to "/")
 // host:port?
+// unix:///var/run/socket:/path1?key1=val1 (HTTP over the Unix domain socket /var/run/socket)
 
 class UrlParser
 {
@@ -29,6 +30,8 @@ class UrlParser
   std::string path_;
   uint16_t port_;
   std::string query_;
+  // Path of the Unix domain socket of unix:// urls, empty otherwise.
+  std::string unix_socket_path_;
   bool success_;
 
   UrlParser(std::string url) : url_(url), success_(true)
@@ -51,6 +54,12 @@ class UrlParser
       cpos    = pos + 3;
     }
 
+    if (scheme_ == "unix")
+    {
+      ParseUnixSocketUrl(cpos);
+      return;
+    }
+
     // credentials
     pos = url_.find_first_of("@", cpos);
     if (pos != std::string::npos)
@@ -123,6 +132,42 @@ class UrlParser
       query_ = std::string(url_.begin() + cpos, url_.begin() + url_.length());
     }
   }
+
+private:
+  // unix://<socket path>[:<path>[?<query>]]: the socket path runs up to the first ':', and the
+  // requests are sent to localhost through the socket.
+  void ParseUnixSocketUrl(size_t cpos)
+  {
+    host_ = "localhost";
+    port_ = 80;
+    path_ = "/";
+
+    size_t pos        = url_.find(':', cpos);
+    unix_socket_path_ = url_.substr(cpos, pos == std::string::npos ? pos : pos - cpos);
+    if (unix_socket_path_.empty())
+    {
+      success_ = false;
+      return;
+    }
+    if (pos == std::string::npos)
+    {
+      return;
+    }
+    cpos = pos + 1;
+    pos  = url_.find('?', cpos);
+    if (pos != std::string::npos)
+    {
+      query_ = url_.substr(pos + 1);
+    }
+    if (pos > cpos)
+    {
+      path_ = url_.substr(cpos, pos == std::string::npos ? pos : pos - cpos);
+      if (path_[0] != '/')
+      {
+        path_.insert(0, "/");
+      }
+    }
+  }
 };
 
 }  // namespace common
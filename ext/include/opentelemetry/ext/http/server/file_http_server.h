@@ -41,34 +41,15 @@ class FileHttpServer : public HTTP_SERVER_NS::HttpServer
 private:
   /**
    * Return whether a file is found whose location is searched for relative to
-   * where the executable was triggered. If the file is valid, fill result with
-   * the file data/information required to display it on a webpage
+   * where the executable was triggered. The file itself is read by the server
+   * as it sends the response, without copying it into the response body.
    * @param name of the file to look for,
-   * @param resulting file information, necessary for displaying them on a
-   * webpage
-   * @returns whether a file was found and result filled with display
-   * information
+   * @returns whether a file was found
    */
-  bool FileGetSuccess(const std::string &filename, std::vector<char> &result)
+  bool FileExists(const std::string &filename)
   {
-#ifdef _WIN32
-    std::replace(filename.begin(), filename.end(), '/', '\\');
-#endif
-    std::streampos size;
-    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
-    if (file.is_open())
-    {
-      size = file.tellg();
-      if (size)
-      {
-        result.resize(size);
-        file.seekg(0, std::ios::beg);
-        file.read(result.data(), size);
-      }
-      file.close();
-      return true;
-    }
-    return false;
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    return file.is_open();
   };
 
   /**
@@ -117,11 +98,10 @@ class FileHttpServer : public HTTP_SERVER_NS::HttpServer
         auto f        = GetFileName(req.uri);
         auto filename = f.c_str() + 1;
 
-        std::vector<char> content;
-        if (FileGetSuccess(filename, content))
+        if (FileExists(filename))
         {
           resp.headers[HTTP_SERVER_NS::CONTENT_TYPE] = GetMimeContentType(filename);
-          resp.body                                  = std::string(content.data(), content.size());
+          resp.bodyFile                              = filename;
           resp.code                                  = 200;
           resp.message = HTTP_SERVER_NS::HttpServer::getDefaultResponseMessage(resp.code);
           return resp.code;
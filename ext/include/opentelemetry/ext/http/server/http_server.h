@@ -3,12 +3,20 @@
 
 #pragma once
 
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 
 #include "socket_tools.h"
 
+#ifdef __linux__
+#  include <sys/sendfile.h>
+#  include <sys/stat.h>
+#endif
+
 #ifdef HAVE_HTTP_DEBUG
 #  ifdef LOG_TRACE
 #    undef LOG_TRACE
@@ -43,6 +51,8 @@ struct HttpResponse
   std::string message;
   std::map<std::string, std::string> headers;
   std::string body;
+  // If set, the body is the content of this file instead, sent with sendfile() where available.
+  std::string bodyFile;
 };
 
 using CallbackFunction = std::function<int(HttpRequest const &request, HttpResponse &response)>;
@@ -83,8 +93,9 @@ class HttpRequestCallback
 // Goals:
 //   - Support enough of HTTP to be used as a mock
 //   - Be flexible to allow creating various test scenarios
+//   - Serve concurrent scrapes: on Linux, setThreadCount() runs one reactor per
+//     thread, each with its own listening socket on the port (SO_REUSEPORT)
 // Out of scope:
-//   - Performance
 //   - Full support of RFC 7230-7237
 class HttpServer : private SocketTools::Reactor::SocketCallback
 {
@@ -109,6 +120,10 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     bool keepalive;
     HttpRequest request;
     HttpResponse response;
+    // The file of response.bodyFile while it is being sent.
+    int bodyFd           = -1;
+    long long bodyOffset = 0;
+    size_t bodyRemaining = 0;
   };
 
   std::string m_serverHost;
@@ -156,9 +171,32 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
   std::map<SocketTools::Socket, Connection> m_connections;
   size_t m_maxRequestHeadersSize, m_maxRequestContentSize;
 
+  // The servers running the additional reactor threads, which share the handlers and settings of
+  // this one through m_owner.
+  std::vector<std::unique_ptr<HttpServer>> m_workers;
+  HttpServer *m_owner = nullptr;
+
+  HttpServer &owner() { return m_owner ? *m_owner : *this; }
+
 public:
   void setKeepalive(bool keepAlive) { allowKeepalive = keepAlive; }
 
+  /**
+   * Handle connections on `count` reactor threads. Must be called before addListeningPort().
+   * Only supported on Linux, where each thread listens on its own socket bound with SO_REUSEPORT;
+   * elsewhere one thread is used.
+   */
+  void setThreadCount(size_t count)
+  {
+#if defined(__linux__) && defined(SO_REUSEPORT)
+    while (m_workers.size() + 1 < count)
+    {
+      m_workers.emplace_back(new HttpServer());
+      m_workers.back()->m_owner = this;
+    }
+#endif
+  }
+
   HttpServer()
       : m_serverHost("unnamed"),
         allowKeepalive(true),
@@ -195,16 +233,35 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     SocketTools::Socket socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     socket.setNonBlocking();
     socket.setReuseAddr();
+    if (!m_workers.empty())
+    {
+      socket.setReusePort();
+    }
 
     SocketTools::SocketAddr addr(0, port);
     socket.bind(addr);
     socket.getsockname(addr);
 
-    socket.listen(10);
+    socket.listen(128);
     m_listeningSockets.push_back(socket);
     m_reactor.addSocket(socket, SocketTools::Reactor::Acceptable);
     LOG_INFO("HttpServer: Listening on %s", addr.toString().c_str());
 
+    // The workers listen on the port this socket was bound to, which may have been chosen by the
+    // system.
+    for (auto &worker : m_workers)
+    {
+      SocketTools::Socket workerSocket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+      workerSocket.setNonBlocking();
+      workerSocket.setReuseAddr();
+      workerSocket.setReusePort();
+      SocketTools::SocketAddr workerAddr(0, addr.port());
+      workerSocket.bind(workerAddr);
+      workerSocket.listen(128);
+      worker->m_listeningSockets.push_back(workerSocket);
+      worker->m_reactor.addSocket(workerSocket, SocketTools::Reactor::Acceptable);
+    }
+
     return addr.port();
   }
 
@@ -231,9 +288,23 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     return (*this);
   };
 
-  void start() { m_reactor.start(); }
+  void start()
+  {
+    m_reactor.start();
+    for (auto &worker : m_workers)
+    {
+      worker->start();
+    }
+  }
 
-  void stop() { m_reactor.stop(); }
+  void stop()
+  {
+    for (auto &worker : m_workers)
+    {
+      worker->stop();
+    }
+    m_reactor.stop();
+  }
 
 protected:
   virtual void onSocketAcceptable(SocketTools::Socket socket) override
@@ -247,6 +318,9 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     if (socket.accept(csocket, caddr))
     {
       csocket.setNonBlocking();
+      // Responses are written whole: do not delay the last segment of one on a kept-alive
+      // connection.
+      csocket.setNoDelay();
       Connection &conn    = m_connections[csocket];
       conn.socket         = csocket;
       conn.state          = Connection::Idle;
@@ -355,6 +429,7 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     {
       LOG_WARN("HttpServer: [%s] connection closed unexpectedly", conn.request.client.c_str());
     }
+    closeBodyFile(conn);
     m_reactor.removeSocket(conn.socket);
     auto connIt = m_connections.find(conn.socket);
     conn.socket.close();
@@ -382,7 +457,7 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
           ofs    = conn.receiveBuffer.find("\n\n");
         }
         size_t headersLen = (ofs != std::string::npos) ? ofs : conn.receiveBuffer.length();
-        if (headersLen > m_maxRequestHeadersSize)
+        if (headersLen > owner().m_maxRequestHeadersSize)
         {
           LOG_WARN("HttpServer: [%s] headers too long - %u", conn.request.client.c_str(),
                    static_cast<unsigned>(headersLen));
@@ -432,7 +507,7 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
         {
           conn.contentLength = 0;
         }
-        if (conn.contentLength > m_maxRequestContentSize)
+        if (conn.contentLength > owner().m_maxRequestContentSize)
         {
           LOG_WARN("HttpServer: [%s] content too long - %u", conn.request.client.c_str(),
                    static_cast<unsigned>(conn.contentLength));
@@ -529,12 +604,12 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
 
       if (conn.state == Connection::SendingBody)
       {
-        if (sendMore(conn))
+        if (sendMore(conn) || sendFileMore(conn))
         {
           return;
         }
 
-        conn.keepalive &= allowKeepalive;
+        conn.keepalive &= owner().allowKeepalive;
 
         if (conn.keepalive)
         {
@@ -710,11 +785,12 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
     conn.response.message.clear();
     conn.response.headers.clear();
     conn.response.body.clear();
+    conn.response.bodyFile.clear();
 
     if (conn.response.code == 0)
     {
       conn.response.code = 404;  // Not Found
-      for (auto &handler : m_handlers)
+      for (auto &handler : owner().m_handlers)
       {
         if (conn.request.uri.length() >= handler.first.length() &&
             strncmp(conn.request.uri.c_str(), handler.first.c_str(), handler.first.length()) == 0)
@@ -739,15 +815,114 @@ class HttpServer : private SocketTools::Reactor::SocketCallback
       }
     }
 
+    size_t contentLength = conn.response.body.size();
+    if (!conn.response.bodyFile.empty())
+    {
+      if (openBodyFile(conn))
+      {
+        contentLength = conn.bodyRemaining;
+      }
+      else
+      {
+        LOG_WARN("HttpServer: [%s] cannot open %s", conn.request.client.c_str(),
+                 conn.response.bodyFile.c_str());
+        conn.response.code                  = 404;  // Not Found
+        conn.response.message               = getDefaultResponseMessage(conn.response.code);
+        conn.response.headers[CONTENT_TYPE] = CONTENT_TYPE_TEXT;
+        conn.response.body                  = conn.response.message;
+        contentLength                       = conn.response.body.size();
+      }
+    }
+
     if (conn.response.message.empty())
     {
       conn.response.message = getDefaultResponseMessage(conn.response.code);
     }
 
-    conn.response.headers["Host"]           = m_serverHost;
+    conn.response.headers["Host"]           = owner().m_serverHost;
     conn.response.headers["Connection"]     = (conn.keepalive ? "keep-alive" : "close");
     conn.response.headers["Date"]           = formatTimestamp(time(nullptr));
-    conn.response.headers["Content-Length"] = std::to_string(conn.response.body.size());
+    conn.response.headers["Content-Length"] = std::to_string(contentLength);
+  }
+
+  /**
+   * Opens the file of response.bodyFile to send it as the body. Where sendfile() is not
+   * available, the file is read into response.body instead.
+   */
+  bool openBodyFile(Connection &conn)
+  {
+    conn.response.body.clear();
+#ifdef __linux__
+    int fd = ::open(conn.response.bodyFile.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+      if (fd >= 0)
+      {
+        ::close(fd);
+      }
+      return false;
+    }
+    conn.bodyFd        = fd;
+    conn.bodyOffset    = 0;
+    conn.bodyRemaining = static_cast<size_t>(st.st_size);
+    return true;
+#else
+    std::ifstream file(conn.response.bodyFile, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+    conn.response.body.assign(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+    conn.response.bodyFile.clear();
+    return true;
+#endif
+  }
+
+  /**
+   * Sends the rest of the body file, if any, from the page cache to the socket.
+   * @return true if the socket must become writable again to send the rest
+   */
+  bool sendFileMore(Connection &conn)
+  {
+#ifdef __linux__
+    while (conn.bodyRemaining > 0)
+    {
+      off_t offset = static_cast<off_t>(conn.bodyOffset);
+      ssize_t sent = ::sendfile(conn.socket.m_sock, conn.bodyFd, &offset, conn.bodyRemaining);
+      if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      {
+        m_reactor.addSocket(conn.socket,
+                            SocketTools::Reactor::Writable | SocketTools::Reactor::Closed);
+        return true;
+      }
+      if (sent <= 0)
+      {
+        // The file was truncated or the socket failed: the body cannot be completed.
+        LOG_WARN("HttpServer: [%s] cannot send %s", conn.request.client.c_str(),
+                 conn.response.bodyFile.c_str());
+        conn.keepalive = false;
+        break;
+      }
+      conn.bodyOffset = offset;
+      conn.bodyRemaining -= static_cast<size_t>(sent);
+    }
+#endif
+    closeBodyFile(conn);
+    return false;
+  }
+
+  void closeBodyFile(Connection &conn)
+  {
+#ifdef __linux__
+    if (conn.bodyFd >= 0)
+    {
+      ::close(conn.bodyFd);
+      conn.bodyFd = -1;
+    }
+#endif
+    conn.bodyRemaining = 0;
   }
 
   static std::string formatTimestamp(time_t time)
@@ -308,6 +308,22 @@ struct Socket
                          sizeof(value)) == 0);
   }
 
+  /// <summary>
+  /// Lets several sockets listen on the same port, the kernel spreading the
+  /// incoming connections over them. Only supported on Linux.
+  /// </summary>
+  bool setReusePort()
+  {
+    assert(m_sock != Invalid);
+#if defined(__linux__) && defined(SO_REUSEPORT)
+    int value = 1;
+    return (::setsockopt(m_sock, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char *>(&value),
+                         sizeof(value)) == 0);
+#else
+    return false;
+#endif
+  }
+
   bool setNoDelay()
   {
     assert(m_sock != Invalid);
@@ -742,7 +758,7 @@ struct Reactor : protected common::Thread
 #endif
 
 #ifdef __linux__
-      epoll_event events[4];
+      epoll_event events[64];
       int result = ::epoll_wait(m_epollFd, events, sizeof(events) / sizeof(events[0]), 500);
       if (result == 0 || (result == -1 && errno == EINTR))
       {
@@ -753,7 +769,11 @@ struct Reactor : protected common::Thread
       for (int i = 0; i < result; i++)
       {
         auto it = std::find(m_sockets.begin(), m_sockets.end(), events[i].data.fd);
-        assert(it != m_sockets.end());
+        if (it == m_sockets.end())
+        {
+          // Removed while handling a previous event of the batch.
+          continue;
+        }
         Socket socket = it->socket;
         int flags     = it->flags;
 
@@ -93,8 +93,11 @@ class TracezDataAggregator
    * name if changed while it is running will not be updated in the data
    * aggregator till the span is completed.
    * @param running_spans is the running spans to be aggregated.
+   * @param running_sample_interval is the number of started spans each running span stands for,
+   * by which the running span count is scaled.
    */
-  void AggregateRunningSpans(std::unordered_set<ThreadsafeSpanData *> &running_spans);
+  void AggregateRunningSpans(std::unordered_set<ThreadsafeSpanData *> &running_spans,
+                             size_t running_sample_interval = 1);
 
   /**
    * AggregateStatusOKSpans is the function called to update the data of spans
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <unordered_set>
@@ -11,6 +13,7 @@
 #include <vector>
 
 #include "opentelemetry/ext/zpages/threadsafe_span_data.h"
+#include "opentelemetry/ext/zpages/tracez_span_stats.h"
 #include "opentelemetry/sdk/trace/processor.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 
@@ -22,20 +25,42 @@ namespace zpages
 /*
  * The span processor passes and stores running and completed recordables (casted as span_data)
  * to be used by the TraceZ Data Aggregator.
+ *
+ * Spans are spread over shards by address, each with its own lock, so that concurrent spans
+ * rarely contend. Only one in running_sample_interval started spans is tracked as running:
+ * the others take no lock until they end.
+ *
+ * When completed spans are counted on end, they are counted and sampled by a TracezSpanStats as
+ * they end, instead of being kept until the next snapshot.
  */
 class TracezSharedData
 {
 public:
+  static constexpr size_t kDefaultShardCount = 16;
+
   struct CollectedSpans
   {
     std::unordered_set<ThreadsafeSpanData *> running;
     std::vector<std::unique_ptr<ThreadsafeSpanData>> completed;
+    // Each running span stands for this number of started spans.
+    size_t running_sample_interval = 1;
   };
 
   /*
    * Initialize a shared data storage.
+   * @param running_sample_interval track one in this number of running spans, all if 1
+   * @param shard_count the number of independently locked shards
+   * @param count_completed_on_end count completed spans as they end rather than returning them
+   * in snapshots
    */
-  explicit TracezSharedData() noexcept {}
+  explicit TracezSharedData(size_t running_sample_interval = 1,
+                            size_t shard_count             = kDefaultShardCount,
+                            bool count_completed_on_end    = false) noexcept
+      : running_sample_interval_(running_sample_interval > 0 ? running_sample_interval : 1),
+        shard_count_(shard_count > 0 ? shard_count : 1),
+        shards_(new Shard[shard_count_]),
+        span_stats_(count_completed_on_end ? new TracezSpanStats() : nullptr)
+  {}
 
   /*
    * Called when a span has been started.
@@ -50,17 +75,41 @@ class TracezSharedData
   /*
    * Returns a snapshot of all spans stored. This snapshot has a copy of the
    * stored running_spans and gives ownership of completed spans to the caller.
-   * Stored completed_spans are cleared from the processor. Currently,
-   * copy-on-write is utilized where possible to minimize contention, but locks
-   * may be added in the future.
-   * @return snapshot of all currently running spans and newly completed spans
+   * Stored completed_spans are cleared from the processor. The shards are
+   * collected one after the other, so that at most one of them is locked at a
+   * time: the snapshot is not taken at a single instant.
+   * @return snapshot of the sampled running spans and newly completed spans
    * (spans never sent while complete) at the time that the function is called
    */
   CollectedSpans GetSpanSnapshot() noexcept;
 
+  /*
+   * @return the counts of completed spans, or nullptr if completed spans are not counted on end
+   * but returned by GetSpanSnapshot.
+   */
+  const TracezSpanStats *GetSpanStats() const noexcept { return span_stats_.get(); }
+
 private:
-  mutable std::mutex mtx_;
-  CollectedSpans spans_;
+  struct Shard
+  {
+    std::mutex mtx;
+    std::unordered_set<ThreadsafeSpanData *> running;
+    // The completed spans with their completion sequence number.
+    std::vector<std::pair<uint64_t, std::unique_ptr<ThreadsafeSpanData>>> completed;
+  };
+
+  Shard &GetShard(const ThreadsafeSpanData *span) noexcept
+  {
+    // The low bits of an address are the same for all the allocations of a size class.
+    return shards_[(reinterpret_cast<uintptr_t>(span) >> 6) % shard_count_];
+  }
+
+  const size_t running_sample_interval_;
+  const size_t shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+  std::unique_ptr<TracezSpanStats> span_stats_;
+  // Orders the completed spans of all shards, which are reported in the order they ended.
+  std::atomic<uint64_t> completed_count_{0};
 };
 }  // namespace zpages
 }  // namespace ext
@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/ext/zpages/latency_boundaries.h"
+#include "opentelemetry/ext/zpages/threadsafe_span_data.h"
+#include "opentelemetry/ext/zpages/tracez_data.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/shared_spin_lock_mutex.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace ext
+{
+namespace zpages
+{
+/**
+ * The counts and sample spans of completed spans, by span name, updated as spans end.
+ *
+ * The latency and error counts of a name are atomics. Each latency bucket and the errors of a
+ * name keep at most kMaxNumberOfSampleSpans sample spans, chosen by reservoir sampling among all
+ * the spans they counted: a span which is not sampled is destroyed as it ends, and a sampled one
+ * is moved into its slot rather than copied.
+ */
+class TracezSpanStats
+{
+public:
+  /*
+   * Counts a completed span, which may be kept as a sample.
+   */
+  void OnEnd(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept;
+
+  /*
+   * Sets the completed span counts and samples of each span name in `data`, adding entries for
+   * the names it does not have yet. The samples are copied.
+   */
+  void CopyInto(std::map<std::string, TracezData> &data) const;
+
+  /*
+   * @return the latency bucket of a span duration.
+   */
+  static LatencyBoundary FindLatencyBoundary(std::chrono::nanoseconds duration) noexcept;
+
+private:
+  using StatsLock   = opentelemetry::sdk::common::SharedSpinLockMutex;
+  using SharedGuard = opentelemetry::sdk::common::SharedSpinLockGuard<StatsLock>;
+
+  /* Up to kMaxNumberOfSampleSpans spans, uniformly sampled among those offered. */
+  class SampleReservoir
+  {
+  public:
+    void Offer(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept;
+
+    void CopyTo(std::list<ThreadsafeSpanData> &samples) const;
+
+  private:
+    std::atomic<uint64_t> offered_{0};
+    mutable opentelemetry::common::SpinLockMutex lock_;
+    std::array<std::unique_ptr<ThreadsafeSpanData>, kMaxNumberOfSampleSpans> slots_;
+  };
+
+  struct SpanNameStats
+  {
+    std::atomic<uint64_t> error_count{0};
+    std::array<std::atomic<uint64_t>, kLatencyBoundaries.size()> latency_counts;
+    SampleReservoir error_samples;
+    std::array<SampleReservoir, kLatencyBoundaries.size()> latency_samples;
+
+    SpanNameStats() noexcept
+    {
+      for (auto &count : latency_counts)
+      {
+        count.store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  SpanNameStats &GetStats(nostd::string_view name);
+
+  // Entries are only added, so that a SpanNameStats found under the lock stays valid after.
+  mutable StatsLock lock_;
+  std::unordered_map<std::string, std::unique_ptr<SpanNameStats>> stats_;
+};
+}  // namespace zpages
+}  // namespace ext
+OPENTELEMETRY_END_NAMESPACE
@@ -77,7 +77,8 @@ class ZPages
   ZPages()
   {
     // Construct shared data nd start tracez webserver.
-    tracez_shared_ = std::make_shared<TracezSharedData>();
+    tracez_shared_ = std::make_shared<TracezSharedData>(1, TracezSharedData::kDefaultShardCount,
+                                                        true /* count_completed_on_end */);
     auto tracez_aggregator =
         std::unique_ptr<TracezDataAggregator>(new TracezDataAggregator(tracez_shared_));
     tracez_server_ =
@@ -2,17 +2,420 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/ext/http/client/curl/http_client_curl.h"
+#include "opentelemetry/sdk/common/thread_options.h"
 
-bool opentelemetry::ext::http::client::curl::Session::CancelSession() noexcept
+#include <algorithm>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace ext
+{
+namespace http
+{
+namespace client
+{
+namespace curl
+{
+namespace
+{
+// curl_global_init and curl_global_cleanup are not thread safe.
+std::mutex &GetCurlGlobalMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+}  // namespace
+
+void Session::SendRequest(opentelemetry::ext::http::client::EventHandler &callback) noexcept
+{
+  http_client_.Initialize();
+  is_session_active_ = true;
+  std::string url    = host_ + std::string(http_request_->uri_);
+  auto callback_ptr  = &callback;
+  curl_operation_.reset(new HttpOperation(http_request_->method_, url, callback_ptr,
+                                          RequestMode::Async, http_request_->headers_,
+                                          http_request_->body_, false, http_request_->timeout_ms_,
+                                          http_client_.GetOptions()));
+  if (!http_request_->body_chunks_.empty())
+  {
+    curl_operation_->SetRequestBodyChunks(http_request_->body_chunks_);
+  }
+  if (!unix_socket_path_.empty())
+  {
+    curl_operation_->SetUnixSocketPath(unix_socket_path_);
+  }
+  bool is_prepared = curl_operation_->PrepareAsync([this, callback_ptr](HttpOperation &operation) {
+    if (operation.WasAborted())
+    {
+      // Manually cancelled
+      callback_ptr->OnEvent(opentelemetry::ext::http::client::SessionState::Cancelled, "");
+    }
+
+    if (operation.GetResponseCode() >= CURL_LAST)
+    {
+      // we have a http response
+      auto response          = std::unique_ptr<Response>(new Response());
+      response->headers_     = operation.GetResponseHeaders();
+      response->body_        = operation.GetResponseBody();
+      response->status_code_ = operation.GetResponseCode();
+      callback_ptr->OnResponse(*response);
+    }
+    is_session_active_ = false;
+  });
+
+  if (is_prepared)
+  {
+    http_client_.StartOperation(*curl_operation_);
+  }
+  else
+  {
+    curl_operation_->CompleteAsync(static_cast<CURLcode>(curl_operation_->GetResponseCode()));
+  }
+}
+
+bool Session::CancelSession() noexcept
 {
   curl_operation_->Abort();
   http_client_.CleanupSession(session_id_);
   return true;
 }
 
-bool opentelemetry::ext::http::client::curl::Session::FinishSession() noexcept
+bool Session::FinishSession() noexcept
 {
   curl_operation_->Finish();
   http_client_.CleanupSession(session_id_);
   return true;
 }
+
+opentelemetry::ext::http::client::Result HttpClientSync::Send(
+    opentelemetry::ext::http::client::Method method,
+    const nostd::string_view &url,
+    const Body &body,
+    const opentelemetry::ext::http::client::Headers &headers) noexcept
+{
+  http_client_.Initialize();
+  std::string request_url(url);
+  std::string unix_socket_path;
+  if (url.substr(0, 7) == "unix://")
+  {
+    // Requests over a Unix domain socket are plain HTTP requests.
+    common::UrlParser parsed_url(request_url);
+    unix_socket_path = parsed_url.unix_socket_path_;
+    request_url      = "http://localhost" + parsed_url.path_;
+    if (!parsed_url.query_.empty())
+    {
+      request_url += "?" + parsed_url.query_;
+    }
+  }
+  HttpOperation curl_operation(method, request_url, nullptr, RequestMode::Sync, headers, body,
+                               false, default_http_conn_timeout, http_client_.GetOptions());
+  if (!unix_socket_path.empty())
+  {
+    curl_operation.SetUnixSocketPath(unix_socket_path);
+  }
+  if (curl_operation.PrepareAsync(nullptr))
+  {
+    http_client_.StartOperation(curl_operation);
+  }
+  else
+  {
+    curl_operation.CompleteAsync(static_cast<CURLcode>(curl_operation.GetResponseCode()));
+  }
+  curl_operation.Finish();
+
+  auto session_state = curl_operation.GetSessionState();
+  if (curl_operation.WasAborted())
+  {
+    session_state = opentelemetry::ext::http::client::SessionState::Cancelled;
+  }
+  auto response = std::unique_ptr<Response>(new Response());
+  if (curl_operation.GetResponseCode() >= CURL_LAST)
+  {
+    // we have a http response
+    response->headers_     = curl_operation.GetResponseHeaders();
+    response->body_        = curl_operation.GetResponseBody();
+    response->status_code_ = curl_operation.GetResponseCode();
+  }
+  return opentelemetry::ext::http::client::Result(std::move(response), session_state);
+}
+
+HttpClient::HttpClient(const opentelemetry::ext::http::client::HttpClientOptions &options)
+    : options_(options),
+      next_session_id_{0},
+      is_initialized_(false),
+      multi_handle_(nullptr),
+      is_stopping_(false),
+      is_paused_(false)
+{
+  fork_handler_.reset(new sdk::common::ForkHandlerRegistration(
+      [this] { PrepareFork(); }, [this] { ParentAfterFork(); }, [this] { ChildAfterFork(); }));
+}
+
+void HttpClient::Initialize()
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (is_initialized_)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> global_guard(GetCurlGlobalMutex());
+    curl_global_init(CURL_GLOBAL_ALL);
+  }
+  InitMultiHandle();
+  share_          = std::make_shared<CurlShare>();
+  is_initialized_ = true;
+}
+
+void HttpClient::Prewarm(nostd::string_view url) noexcept
+{
+  common::UrlParser parsed_url{std::string(url)};
+  if (!parsed_url.success_)
+  {
+    return;
+  }
+  Initialize();
+  std::string base_url =
+      parsed_url.unix_socket_path_.empty()
+          ? parsed_url.scheme_ + "://" + parsed_url.host_ + ":" + std::to_string(parsed_url.port_)
+          : "http://localhost";
+
+  HttpOperation *operation = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    prewarm_operations_.emplace_back(new HttpOperation(
+        opentelemetry::ext::http::client::Method::Get, base_url, nullptr, RequestMode::Async,
+        prewarm_headers_, prewarm_body_, false, default_http_conn_timeout, options_));
+    operation = prewarm_operations_.back().get();
+  }
+  operation->SetConnectOnly();
+  if (!parsed_url.unix_socket_path_.empty())
+  {
+    operation->SetUnixSocketPath(parsed_url.unix_socket_path_);
+  }
+  if (operation->PrepareAsync(nullptr))
+  {
+    StartOperation(*operation);
+  }
+  else
+  {
+    operation->CompleteAsync(static_cast<CURLcode>(operation->GetResponseCode()));
+  }
+}
+
+void HttpClient::InitMultiHandle()
+{
+  multi_handle_ = curl_multi_init();
+  if (multi_handle_ != nullptr)
+  {
+    curl_multi_setopt(multi_handle_, CURLMOPT_PIPELINING,
+                      options_.http2 ? long{CURLPIPE_MULTIPLEX} : long{CURLPIPE_NOTHING});
+    curl_multi_setopt(multi_handle_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(options_.max_connections_per_host));
+  }
+}
+
+HttpClient::~HttpClient()
+{
+  fork_handler_.reset();
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    is_stopping_ = true;
+  }
+  if (thread_.joinable())
+  {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(multi_handle_);
+#endif
+    thread_.join();
+  }
+  prewarm_operations_.clear();
+  share_.reset();
+  if (multi_handle_ != nullptr)
+  {
+    curl_multi_cleanup(multi_handle_);
+  }
+  if (is_initialized_)
+  {
+    std::lock_guard<std::mutex> global_guard(GetCurlGlobalMutex());
+    curl_global_cleanup();
+  }
+}
+
+void HttpClient::StartOperation(HttpOperation &operation)
+{
+  operation.SetShare(share_);
+  bool operation_started           = false;
+  HttpOperation *dropped_operation = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (multi_handle_ != nullptr && !is_stopping_)
+    {
+      pending_operations_.push_back(&operation);
+      if (options_.max_pending_requests > 0 &&
+          pending_operations_.size() > options_.max_pending_requests)
+      {
+        dropped_operation = pending_operations_.front();
+        pending_operations_.pop_front();
+      }
+      if (!thread_.joinable() && !is_paused_)
+      {
+        thread_ = std::thread(&HttpClient::PerformOperations, this);
+      }
+      operation_started = true;
+    }
+  }
+  if (dropped_operation != nullptr)
+  {
+    dropped_operation->Abort();
+    dropped_operation->CompleteAsync(CURLE_ABORTED_BY_CALLBACK);
+  }
+  if (!operation_started)
+  {
+    operation.CompleteAsync(CURLE_FAILED_INIT);
+    return;
+  }
+#if LIBCURL_VERSION_NUM >= 0x074400
+  curl_multi_wakeup(multi_handle_);
+#endif
+}
+
+void HttpClient::PerformOperations()
+{
+  opentelemetry::sdk::common::ApplyThreadOptions(opentelemetry::sdk::common::ThreadOptions(),
+                                                 "otel-curl");
+  std::vector<HttpOperation *> operations;
+  for (;;)
+  {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (is_paused_)
+      {
+        // The requests are left in the multi handle, for the thread restarted after the fork.
+        return;
+      }
+      if (is_stopping_)
+      {
+        break;
+      }
+      while (!pending_operations_.empty() &&
+             (options_.max_requests_in_flight == 0 ||
+              running_operations_.size() + operations.size() < options_.max_requests_in_flight))
+      {
+        operations.push_back(pending_operations_.front());
+        pending_operations_.pop_front();
+      }
+    }
+    for (HttpOperation *operation : operations)
+    {
+      curl_easy_setopt(operation->GetHandle(), CURLOPT_PRIVATE, operation);
+      curl_multi_add_handle(multi_handle_, operation->GetHandle());
+      running_operations_.push_back(operation);
+    }
+    operations.clear();
+
+    int still_running = 0;
+    curl_multi_perform(multi_handle_, &still_running);
+
+    int messages_left = 0;
+    while (CURLMsg *message = curl_multi_info_read(multi_handle_, &messages_left))
+    {
+      if (message->msg != CURLMSG_DONE)
+      {
+        continue;
+      }
+      HttpOperation *operation = nullptr;
+      curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &operation);
+      CURLcode code = message->data.result;
+      curl_multi_remove_handle(multi_handle_, message->easy_handle);
+      running_operations_.erase(
+          std::find(running_operations_.begin(), running_operations_.end(), operation));
+      operation->CompleteAsync(code);
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_poll(multi_handle_, nullptr, 0, 1000, nullptr);
+#else
+    // Without curl_multi_wakeup, new operations are only picked up once the wait times out.
+    curl_multi_wait(multi_handle_, nullptr, 0, 10, nullptr);
+#endif
+  }
+
+  // Abandon the operations which did not complete, so that their sessions stop waiting.
+  for (HttpOperation *operation : running_operations_)
+  {
+    curl_multi_remove_handle(multi_handle_, operation->GetHandle());
+    operation->CompleteAsync(CURLE_ABORTED_BY_CALLBACK);
+  }
+  running_operations_.clear();
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    operations.assign(pending_operations_.begin(), pending_operations_.end());
+    pending_operations_.clear();
+  }
+  for (HttpOperation *operation : operations)
+  {
+    operation->CompleteAsync(CURLE_ABORTED_BY_CALLBACK);
+  }
+}
+
+void HttpClient::PrepareFork()
+{
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    is_paused_ = true;
+    thread.swap(thread_);
+  }
+  if (thread.joinable())
+  {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(multi_handle_);
+#endif
+    thread.join();
+  }
+  // Released by ParentAfterFork or ChildAfterFork.
+  mutex_.lock();
+}
+
+void HttpClient::ParentAfterFork()
+{
+  is_paused_ = false;
+  if (!is_stopping_ && (!running_operations_.empty() || !pending_operations_.empty()))
+  {
+    thread_ = std::thread(&HttpClient::PerformOperations, this);
+  }
+  mutex_.unlock();
+}
+
+void HttpClient::ChildAfterFork()
+{
+  is_paused_ = false;
+  // Cleaning up the multi handle would close the connections it shares with the parent, e.g.
+  // with a TLS close notify, so it is leaked along with the handles of the running requests.
+  std::vector<HttpOperation *> operations(running_operations_.begin(), running_operations_.end());
+  for (HttpOperation *operation : operations)
+  {
+    operation->LeakHandle();
+  }
+  operations.insert(operations.end(), pending_operations_.begin(), pending_operations_.end());
+  running_operations_.clear();
+  pending_operations_.clear();
+  if (is_initialized_)
+  {
+    InitMultiHandle();
+  }
+  mutex_.unlock();
+
+  // Abandon the requests of the parent, so that their sessions stop waiting in the child.
+  for (HttpOperation *operation : operations)
+  {
+    operation->CompleteAsync(CURLE_ABORTED_BY_CALLBACK);
+  }
+}
+
+}  // namespace curl
+}  // namespace client
+}  // namespace http
+}  // namespace ext
+OPENTELEMETRY_END_NAMESPACE
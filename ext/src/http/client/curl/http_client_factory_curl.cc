@@ -12,7 +12,19 @@ std::shared_ptr<http_client::HttpClient> http_client::HttpClientFactory::Create(
   return std::make_shared<http_client::curl::HttpClient>();
 }
 
+std::shared_ptr<http_client::HttpClient> http_client::HttpClientFactory::Create(
+    const http_client::HttpClientOptions &options)
+{
+  return std::make_shared<http_client::curl::HttpClient>(options);
+}
+
 std::shared_ptr<http_client::HttpClientSync> http_client::HttpClientFactory::CreateSync()
 {
   return std::make_shared<http_client::curl::HttpClientSync>();
 }
+
+std::shared_ptr<http_client::HttpClientSync> http_client::HttpClientFactory::CreateSync(
+    const http_client::HttpClientOptions &options)
+{
+  return std::make_shared<http_client::curl::HttpClientSync>(options);
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/ext/zpages/tracez_data_aggregator.h"
+#include "opentelemetry/sdk/common/thread_options.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
@@ -17,6 +18,8 @@ TracezDataAggregator::TracezDataAggregator(std::shared_ptr<TracezSharedData> sha
   // Start a thread that calls AggregateSpans periodically or till notified.
   execute_.store(true, std::memory_order_release);
   aggregate_spans_thread_ = std::thread([this, update_interval]() {
+    opentelemetry::sdk::common::ApplyThreadOptions(opentelemetry::sdk::common::ThreadOptions(),
+                                                   "otel-zpages");
     while (execute_.load(std::memory_order_acquire))
     {
       std::unique_lock<std::mutex> lock(mtx_);
@@ -46,13 +49,7 @@ std::map<std::string, TracezData> TracezDataAggregator::GetAggregatedTracezData(
 LatencyBoundary TracezDataAggregator::FindLatencyBoundary(
     std::unique_ptr<ThreadsafeSpanData> &span_data)
 {
-  const auto &span_data_duration = span_data->GetDuration();
-  for (unsigned int boundary = 0; boundary < kLatencyBoundaries.size() - 1; boundary++)
-  {
-    if (span_data_duration < kLatencyBoundaries[boundary + 1])
-      return (LatencyBoundary)boundary;
-  }
-  return LatencyBoundary::k100SecondToMax;
+  return TracezSpanStats::FindLatencyBoundary(span_data->GetDuration());
 }
 
 void TracezDataAggregator::InsertIntoSampleSpanList(std::list<ThreadsafeSpanData> &sample_spans,
@@ -136,7 +133,8 @@ void TracezDataAggregator::AggregateCompletedSpans(
 }
 
 void TracezDataAggregator::AggregateRunningSpans(
-    std::unordered_set<ThreadsafeSpanData *> &running_spans)
+    std::unordered_set<ThreadsafeSpanData *> &running_spans,
+    size_t running_sample_interval)
 {
   for (auto &running_span : running_spans)
   {
@@ -150,7 +148,7 @@ void TracezDataAggregator::AggregateRunningSpans(
     auto &tracez_data = aggregated_tracez_data_[span_name];
     InsertIntoSampleSpanList(aggregated_tracez_data_[span_name].sample_running_spans,
                              *running_span);
-    tracez_data.running_span_count++;
+    tracez_data.running_span_count += static_cast<unsigned int>(running_sample_interval);
   }
 }
 
@@ -180,8 +178,17 @@ void TracezDataAggregator::AggregateSpans()
    *     Completed spans will not be seen more than once
    **/
   ClearRunningSpanData();
-  AggregateCompletedSpans(span_snapshot.completed);
-  AggregateRunningSpans(span_snapshot.running);
+  const TracezSpanStats *span_stats = tracez_shared_data_->GetSpanStats();
+  if (span_stats != nullptr)
+  {
+    // Completed spans were counted as they ended.
+    span_stats->CopyInto(aggregated_tracez_data_);
+  }
+  else
+  {
+    AggregateCompletedSpans(span_snapshot.completed);
+  }
+  AggregateRunningSpans(span_snapshot.running, span_snapshot.running_sample_interval);
 }
 
 }  // namespace zpages
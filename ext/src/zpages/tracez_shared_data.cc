@@ -3,6 +3,9 @@
 
 #include "opentelemetry/ext/zpages/tracez_shared_data.h"
 
+#include <algorithm>
+#include <iterator>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace ext
 {
@@ -11,28 +14,72 @@ namespace zpages
 
 void TracezSharedData::OnStart(ThreadsafeSpanData *span) noexcept
 {
-  std::lock_guard<std::mutex> lock(mtx_);
-  spans_.running.insert(span);
+  if (running_sample_interval_ > 1)
+  {
+    // Counted per thread, so that unsampled spans touch no shared state.
+    static thread_local size_t started = 0;
+    if (started++ % running_sample_interval_ != 0)
+    {
+      return;
+    }
+  }
+  Shard &shard = GetShard(span);
+  std::lock_guard<std::mutex> lock(shard.mtx);
+  shard.running.insert(span);
 }
 
 void TracezSharedData::OnEnd(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept
 {
-  std::lock_guard<std::mutex> lock(mtx_);
-  auto span_it = spans_.running.find(span.get());
-  if (span_it != spans_.running.end())
+  Shard &shard = GetShard(span.get());
+  std::unique_lock<std::mutex> lock(shard.mtx);
+  auto span_it = shard.running.find(span.get());
+  if (span_it != shard.running.end())
+  {
+    shard.running.erase(span_it);
+  }
+  else if (running_sample_interval_ == 1)
+  {
+    // Every started span is tracked: this one was never started.
+    return;
+  }
+  if (span_stats_)
   {
-    spans_.running.erase(span_it);
-    spans_.completed.push_back(std::unique_ptr<ThreadsafeSpanData>(span.release()));
+    lock.unlock();
+    span_stats_->OnEnd(std::move(span));
+    return;
   }
+  shard.completed.emplace_back(completed_count_.fetch_add(1, std::memory_order_relaxed),
+                               std::unique_ptr<ThreadsafeSpanData>(span.release()));
 }
 
 TracezSharedData::CollectedSpans TracezSharedData::GetSpanSnapshot() noexcept
 {
   CollectedSpans snapshot;
-  std::lock_guard<std::mutex> lock(mtx_);
-  snapshot.running   = spans_.running;
-  snapshot.completed = std::move(spans_.completed);
-  spans_.completed.clear();
+  snapshot.running_sample_interval = running_sample_interval_;
+  std::vector<std::pair<uint64_t, std::unique_ptr<ThreadsafeSpanData>>> completed;
+  std::vector<std::pair<uint64_t, std::unique_ptr<ThreadsafeSpanData>>> shard_completed;
+  for (size_t i = 0; i < shard_count_; ++i)
+  {
+    Shard &shard = shards_[i];
+    {
+      std::lock_guard<std::mutex> lock(shard.mtx);
+      snapshot.running.insert(shard.running.begin(), shard.running.end());
+      shard_completed.swap(shard.completed);
+    }
+    std::move(shard_completed.begin(), shard_completed.end(), std::back_inserter(completed));
+    shard_completed.clear();
+  }
+
+  std::sort(completed.begin(), completed.end(),
+            [](const std::pair<uint64_t, std::unique_ptr<ThreadsafeSpanData>> &a,
+               const std::pair<uint64_t, std::unique_ptr<ThreadsafeSpanData>> &b) {
+              return a.first < b.first;
+            });
+  snapshot.completed.reserve(completed.size());
+  for (auto &span : completed)
+  {
+    snapshot.completed.push_back(std::move(span.second));
+  }
   return snapshot;
 }
 
@@ -0,0 +1,131 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/ext/zpages/tracez_span_stats.h"
+
+#include <chrono>
+#include <mutex>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace ext
+{
+namespace zpages
+{
+namespace
+{
+/* A per-thread xorshift generator, enough to pick which samples to replace. */
+uint64_t NextRandom() noexcept
+{
+  static thread_local uint64_t state =
+      static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+}  // namespace
+
+void TracezSpanStats::SampleReservoir::Offer(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept
+{
+  // Algorithm R: the n-th span offered replaces a sample with probability size / n.
+  uint64_t offered = offered_.fetch_add(1, std::memory_order_relaxed);
+  uint64_t slot    = offered;
+  if (offered >= slots_.size())
+  {
+    slot = NextRandom() % (offered + 1);
+    if (slot >= slots_.size())
+    {
+      return;
+    }
+  }
+  // The evicted sample is destroyed once the lock is released.
+  std::unique_ptr<ThreadsafeSpanData> evicted;
+  {
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    evicted      = std::move(slots_[slot]);
+    slots_[slot] = std::move(span);
+  }
+}
+
+void TracezSpanStats::SampleReservoir::CopyTo(std::list<ThreadsafeSpanData> &samples) const
+{
+  samples.clear();
+  std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+  for (auto &slot : slots_)
+  {
+    if (slot)
+    {
+      samples.push_back(ThreadsafeSpanData(*slot));
+    }
+  }
+}
+
+LatencyBoundary TracezSpanStats::FindLatencyBoundary(std::chrono::nanoseconds duration) noexcept
+{
+  for (unsigned int boundary = 0; boundary < kLatencyBoundaries.size() - 1; boundary++)
+  {
+    if (duration < kLatencyBoundaries[boundary + 1])
+      return (LatencyBoundary)boundary;
+  }
+  return LatencyBoundary::k100SecondToMax;
+}
+
+TracezSpanStats::SpanNameStats &TracezSpanStats::GetStats(nostd::string_view name)
+{
+  std::string key(name.data(), name.size());
+  {
+    SharedGuard guard(lock_);
+    auto it = stats_.find(key);
+    if (it != stats_.end())
+    {
+      return *it->second;
+    }
+  }
+  std::lock_guard<StatsLock> guard(lock_);
+  auto &stats = stats_[std::move(key)];
+  if (!stats)
+  {
+    stats.reset(new SpanNameStats());
+  }
+  return *stats;
+}
+
+void TracezSpanStats::OnEnd(std::unique_ptr<ThreadsafeSpanData> &&span) noexcept
+{
+  SpanNameStats &stats = GetStats(span->GetName());
+  auto status          = span->GetStatus();
+  if (status == trace::StatusCode::kOk || status == trace::StatusCode::kUnset)
+  {
+    auto boundary = FindLatencyBoundary(span->GetDuration());
+    stats.latency_counts[boundary].fetch_add(1, std::memory_order_relaxed);
+    stats.latency_samples[boundary].Offer(std::move(span));
+  }
+  else
+  {
+    stats.error_count.fetch_add(1, std::memory_order_relaxed);
+    stats.error_samples.Offer(std::move(span));
+  }
+}
+
+void TracezSpanStats::CopyInto(std::map<std::string, TracezData> &data) const
+{
+  SharedGuard guard(lock_);
+  for (auto &kv : stats_)
+  {
+    const SpanNameStats &stats = *kv.second;
+    TracezData &tracez_data    = data[kv.first];
+    tracez_data.error_span_count =
+        static_cast<unsigned int>(stats.error_count.load(std::memory_order_relaxed));
+    stats.error_samples.CopyTo(tracez_data.sample_error_spans);
+    for (size_t i = 0; i < kLatencyBoundaries.size(); ++i)
+    {
+      tracez_data.completed_span_count_per_latency_bucket[i] =
+          static_cast<unsigned int>(stats.latency_counts[i].load(std::memory_order_relaxed));
+      stats.latency_samples[i].CopyTo(tracez_data.sample_latency_spans[i]);
+    }
+  }
+}
+
+}  // namespace zpages
+}  // namespace ext
+OPENTELEMETRY_END_NAMESPACE
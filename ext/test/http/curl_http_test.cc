@@ -14,6 +14,11 @@
 #include <thread>
 #include <vector>
 
+#ifdef __unix__
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
 #define HTTP_PORT 19000
 
 #include <gtest/gtest.h>
@@ -54,6 +59,35 @@ class PostEventHandler : public CustomEventHandler
   }
 };
 
+class DroppedEventHandler : public CustomEventHandler
+{
+public:
+  void OnResponse(http_client::Response &response) noexcept override { is_called_ = true; }
+  void OnEvent(http_client::SessionState state, nostd::string_view reason) noexcept override
+  {
+    if (state == http_client::SessionState::Cancelled)
+    {
+      is_cancelled_ = true;
+    }
+  }
+  bool is_cancelled_ = false;
+};
+
+class FailedEventHandler : public CustomEventHandler
+{
+public:
+  void OnResponse(http_client::Response &response) noexcept override { is_called_ = true; }
+  void OnEvent(http_client::SessionState state, nostd::string_view reason) noexcept override
+  {
+    if (state == http_client::SessionState::SendFailed ||
+        state == http_client::SessionState::ConnectFailed)
+    {
+      is_failed_ = true;
+    }
+  }
+  bool is_failed_ = false;
+};
+
 class BasicCurlHttpTests : public ::testing::Test, public HTTP_SERVER_NS::HttpRequestCallback
 {
 protected:
@@ -84,6 +118,7 @@ class BasicCurlHttpTests : public ::testing::Test, public HTTP_SERVER_NS::HttpRe
     server_.addHandler("/simple/", *this);
     server_.addHandler("/get/", *this);
     server_.addHandler("/post/", *this);
+    server_.addHandler("/slow/", *this);
     server_.start();
     is_running_ = true;
   }
@@ -117,6 +152,17 @@ class BasicCurlHttpTests : public ::testing::Test, public HTTP_SERVER_NS::HttpRe
       response_status                  = 200;
     }
 
+    if (request.uri == "/slow/")
+    {
+      {
+        std::unique_lock<std::mutex> lk(mtx_requests);
+        received_requests_.push_back(request);
+      }
+      cv_got_events.notify_one();
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      response_status = 200;
+    }
+
     cv_got_events.notify_one();
 
     return response_status;
@@ -204,6 +250,24 @@ TEST_F(BasicCurlHttpTests, SendGetRequest)
   delete handler;
 }
 
+TEST_F(BasicCurlHttpTests, PrewarmThenSendGetRequest)
+{
+  received_requests_.clear();
+  curl::HttpClient http_client;
+  // Connects without sending a request.
+  http_client.Prewarm("http://127.0.0.1:19000/get/");
+
+  auto session = http_client.CreateSession("http://127.0.0.1:19000");
+  auto request = session->CreateRequest();
+  request->SetUri("get/");
+  GetEventHandler handler;
+  session->SendRequest(handler);
+  ASSERT_TRUE(waitForRequests(30, 1));
+  session->FinishSession();
+  ASSERT_TRUE(handler.is_called_);
+  EXPECT_EQ(received_requests_.size(), 1);
+}
+
 TEST_F(BasicCurlHttpTests, SendPostRequest)
 {
   received_requests_.clear();
@@ -231,6 +295,137 @@ TEST_F(BasicCurlHttpTests, SendPostRequest)
   delete handler;
 }
 
+TEST_F(BasicCurlHttpTests, SendPostRequestChunks)
+{
+  received_requests_.clear();
+  auto session_manager = http_client::HttpClientFactory::Create();
+  EXPECT_TRUE(session_manager != nullptr);
+
+  auto session = session_manager->CreateSession("http://127.0.0.1:19000");
+  auto request = session->CreateRequest();
+  request->SetUri("post/");
+  request->SetMethod(http_client::Method::Post);
+
+  const char *b1 = "test-";
+  const char *b2 = "data";
+  std::vector<http_client::Body> chunks;
+  chunks.emplace_back(b1, b1 + strlen(b1));
+  chunks.emplace_back();
+  chunks.emplace_back(b2, b2 + strlen(b2));
+  request->SetBodyChunks(std::move(chunks));
+  request->AddHeader("Content-Type", "text/plain");
+  PostEventHandler *handler = new PostEventHandler();
+  session->SendRequest(*handler);
+  ASSERT_TRUE(waitForRequests(30, 1));
+  session->FinishSession();
+  ASSERT_TRUE(handler->is_called_);
+  {
+    std::unique_lock<std::mutex> lk(mtx_requests);
+    ASSERT_EQ(received_requests_[0].content, "test-data");
+  }
+
+  delete handler;
+}
+
+TEST_F(BasicCurlHttpTests, SendConcurrentRequests)
+{
+  received_requests_.clear();
+  http_client::HttpClientOptions options;
+  options.max_connections_per_host = 2;
+  auto session_manager             = http_client::HttpClientFactory::Create(options);
+  EXPECT_TRUE(session_manager != nullptr);
+
+  // All the requests are performed by the multi handle of the client, at most two at a time.
+  std::vector<std::shared_ptr<http_client::Session>> sessions;
+  std::vector<std::unique_ptr<GetEventHandler>> handlers;
+  for (int i = 0; i < 4; ++i)
+  {
+    auto session = session_manager->CreateSession("http://127.0.0.1:19000");
+    auto request = session->CreateRequest();
+    request->SetUri("get/");
+    handlers.emplace_back(new GetEventHandler());
+    session->SendRequest(*handlers.back());
+    sessions.push_back(session);
+  }
+  ASSERT_TRUE(waitForRequests(30, 4));
+  for (auto &session : sessions)
+  {
+    session->FinishSession();
+  }
+  for (auto &handler : handlers)
+  {
+    ASSERT_TRUE(handler->is_called_);
+  }
+}
+
+TEST_F(BasicCurlHttpTests, DropOldestPendingRequest)
+{
+  received_requests_.clear();
+  http_client::HttpClientOptions options;
+  options.max_requests_in_flight = 1;
+  options.max_pending_requests   = 1;
+  auto session_manager           = http_client::HttpClientFactory::Create(options);
+
+  std::vector<std::shared_ptr<http_client::Session>> sessions;
+  std::vector<std::unique_ptr<DroppedEventHandler>> handlers;
+  auto send = [&](const char *uri) {
+    auto session = session_manager->CreateSession("http://127.0.0.1:19000");
+    auto request = session->CreateRequest();
+    request->SetUri(uri);
+    handlers.emplace_back(new DroppedEventHandler());
+    session->SendRequest(*handlers.back());
+    sessions.push_back(session);
+  };
+
+  // The slow request takes the only slot, the second one waits and is dropped for the third.
+  send("slow/");
+  ASSERT_TRUE(waitForRequests(30, 1));
+  send("get/");
+  send("get/");
+  for (auto &session : sessions)
+  {
+    session->FinishSession();
+  }
+
+  EXPECT_TRUE(handlers[0]->is_called_);
+  EXPECT_FALSE(handlers[1]->is_called_);
+  EXPECT_TRUE(handlers[1]->is_cancelled_);
+  EXPECT_TRUE(handlers[2]->is_called_);
+  EXPECT_FALSE(handlers[2]->is_cancelled_);
+}
+
+#ifdef __unix__
+TEST_F(BasicCurlHttpTests, ForkWithRequestInFlight)
+{
+  received_requests_.clear();
+  auto session_manager = http_client::HttpClientFactory::Create();
+  auto session         = session_manager->CreateSession("http://127.0.0.1:19000");
+  auto request         = session->CreateRequest();
+  request->SetUri("slow/");
+  FailedEventHandler handler;
+  session->SendRequest(handler);
+  ASSERT_TRUE(waitForRequests(30, 1));
+
+  // The child abandons the request of the parent instead of waiting for it forever.
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    session->FinishSession();
+    _exit(!handler.is_called_ && handler.is_failed_ ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ASSERT_GT(pid, 0);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+
+  // The parent still gets the response.
+  session->FinishSession();
+  EXPECT_TRUE(handler.is_called_);
+  EXPECT_FALSE(handler.is_failed_);
+}
+#endif
+
 TEST_F(BasicCurlHttpTests, RequestTimeout)
 {
   received_requests_.clear();
@@ -127,3 +127,25 @@ TEST(UrlParserTests, BasicTests)
     ASSERT_EQ(url.query_, url_properties["query"]);
   }
 }
+
+TEST(UrlParserTests, UnixSocketTests)
+{
+  http_common::UrlParser url("unix:///var/run/otelcol.sock:/v1/traces?q1=a1");
+  ASSERT_TRUE(url.success_);
+  EXPECT_EQ(url.scheme_, "unix");
+  EXPECT_EQ(url.unix_socket_path_, "/var/run/otelcol.sock");
+  EXPECT_EQ(url.host_, "localhost");
+  EXPECT_EQ(url.path_, "/v1/traces");
+  EXPECT_EQ(url.query_, "q1=a1");
+
+  url = http_common::UrlParser("unix://otelcol.sock");
+  ASSERT_TRUE(url.success_);
+  EXPECT_EQ(url.unix_socket_path_, "otelcol.sock");
+  EXPECT_EQ(url.path_, "/");
+
+  url = http_common::UrlParser("unix:///var/run/otelcol.sock:v1/logs");
+  EXPECT_EQ(url.path_, "/v1/logs");
+
+  EXPECT_FALSE(http_common::UrlParser("unix://").success_);
+  EXPECT_TRUE(http_common::UrlParser("http://localhost:4318").unix_socket_path_.empty());
+}
@@ -644,3 +644,31 @@ TEST_F(TracezProcessor, RunningSnapshotCompletedThreadSafety)
 
   EndAllSpans(spans2);
 }
+
+/*
+ * Test that with a running sample interval, only some of the started spans are tracked as
+ * running, while all ended spans are completed.
+ */
+TEST(TracezSharedData, SampledRunningSpans)
+{
+  std::shared_ptr<TracezSharedData> data(new TracezSharedData(4, 3));
+  TracezSpanProcessor sampled_processor(data);
+  auto parent_context = opentelemetry::trace::SpanContext::GetInvalid();
+
+  std::vector<std::unique_ptr<Recordable>> spans;
+  for (int i = 0; i < 8; i++)
+  {
+    spans.push_back(sampled_processor.MakeRecordable());
+    sampled_processor.OnStart(*spans.back(), parent_context);
+  }
+  auto snapshot = data->GetSpanSnapshot();
+  EXPECT_EQ(snapshot.running.size(), 2);
+  EXPECT_EQ(snapshot.completed.size(), 0);
+  EXPECT_EQ(snapshot.running_sample_interval, 4);
+
+  for (auto &span : spans)
+    sampled_processor.OnEnd(std::move(span));
+  snapshot = data->GetSpanSnapshot();
+  EXPECT_EQ(snapshot.running.size(), 0);
+  EXPECT_EQ(snapshot.completed.size(), 8);
+}
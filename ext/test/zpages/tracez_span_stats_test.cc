@@ -0,0 +1,79 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/ext/zpages/tracez_span_stats.h"
+#include "opentelemetry/ext/zpages/tracez_data_aggregator.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace opentelemetry::ext::zpages;
+namespace trace_api = opentelemetry::trace;
+
+namespace
+{
+std::unique_ptr<ThreadsafeSpanData> MakeSpan(
+    opentelemetry::nostd::string_view name,
+    std::chrono::nanoseconds duration,
+    trace_api::StatusCode status = trace_api::StatusCode::kOk)
+{
+  std::unique_ptr<ThreadsafeSpanData> span(new ThreadsafeSpanData());
+  span->SetName(name);
+  span->SetDuration(duration);
+  span->SetStatus(status, "");
+  return span;
+}
+}  // namespace
+
+TEST(TracezSpanStats, CountsByNameAndLatency)
+{
+  TracezSpanStats stats;
+  stats.OnEnd(MakeSpan("a", microseconds(1)));
+  stats.OnEnd(MakeSpan("a", microseconds(2)));
+  stats.OnEnd(MakeSpan("a", milliseconds(2)));
+  stats.OnEnd(MakeSpan("a", microseconds(1), trace_api::StatusCode::kError));
+  stats.OnEnd(MakeSpan("b", seconds(200)));
+
+  std::map<std::string, TracezData> data;
+  stats.CopyInto(data);
+  ASSERT_EQ(data.size(), 2);
+  auto &a = data["a"];
+  EXPECT_EQ(a.completed_span_count_per_latency_bucket[k0MicroTo10Micro], 2);
+  EXPECT_EQ(a.completed_span_count_per_latency_bucket[k1MilliTo10Milli], 1);
+  EXPECT_EQ(a.error_span_count, 1);
+  EXPECT_EQ(a.sample_latency_spans[k0MicroTo10Micro].size(), 2);
+  EXPECT_EQ(a.sample_error_spans.size(), 1);
+  EXPECT_EQ(data["b"].completed_span_count_per_latency_bucket[k100SecondToMax], 1);
+}
+
+TEST(TracezSpanStats, SamplesAreBounded)
+{
+  TracezSpanStats stats;
+  for (int i = 0; i < 100; i++)
+  {
+    stats.OnEnd(MakeSpan("a", microseconds(1)));
+  }
+
+  std::map<std::string, TracezData> data;
+  stats.CopyInto(data);
+  EXPECT_EQ(data["a"].completed_span_count_per_latency_bucket[k0MicroTo10Micro], 100);
+  EXPECT_EQ(data["a"].sample_latency_spans[k0MicroTo10Micro].size(), kMaxNumberOfSampleSpans);
+}
+
+TEST(TracezSpanStats, SharedDataCountsOnEnd)
+{
+  std::shared_ptr<TracezSharedData> shared_data(
+      new TracezSharedData(1, TracezSharedData::kDefaultShardCount, true));
+  for (int i = 0; i < 3; i++)
+  {
+    auto span = MakeSpan("span", microseconds(1));
+    shared_data->OnStart(span.get());
+    shared_data->OnEnd(std::move(span));
+  }
+  EXPECT_EQ(shared_data->GetSpanSnapshot().completed.size(), 0);
+
+  TracezDataAggregator aggregator(shared_data, milliseconds(10));
+  std::this_thread::sleep_for(milliseconds(50));
+  auto data = aggregator.GetAggregatedTracezData();
+  EXPECT_EQ(data["span"].completed_span_count_per_latency_bucket[k0MicroTo10Micro], 3);
+}
@@ -66,7 +66,7 @@ class CounterAggregator final : public Aggregator<T>
    * @param other, the aggregator with merge with
    * @return none
    */
-  void merge(CounterAggregator other)
+  void merge(const CounterAggregator &other)
   {
     if (this->agg_kind_ == other.agg_kind_)
     {
@@ -94,7 +94,7 @@ class GaugeAggregator : public Aggregator<T>
    *
    * @param other the aggregator to merge with this aggregator
    */
-  void merge(GaugeAggregator<T> other)
+  void merge(const GaugeAggregator<T> &other)
   {
     if (this->kind_ == other.kind_)
     {
@@ -114,7 +114,7 @@ class HistogramAggregator final : public Aggregator<T>
    * @param other, the aggregator with merge with
    * @return none
    */
-  void merge(HistogramAggregator other)
+  void merge(const HistogramAggregator &other)
   {
     this->mu_.lock();
 
@@ -152,7 +152,7 @@ class SketchAggregator final : public Aggregator<T>
    * @param other, the aggregator with merge with
    * @return none
    */
-  void merge(SketchAggregator other)
+  void merge(const SketchAggregator &other)
   {
     if (gamma != other.gamma)
     {
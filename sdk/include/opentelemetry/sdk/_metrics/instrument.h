@@ -4,9 +4,11 @@
 #pragma once
 #ifdef ENABLE_METRICS_PREVIEW
 
+#  include <atomic>
 #  include <iostream>
 #  include <map>
 #  include <memory>
+#  include <mutex>
 #  include <sstream>
 #  include <string>
 #  include <unordered_map>
@@ -91,12 +93,7 @@ class BoundSynchronousInstrument
    * @param none
    * @return void
    */
-  virtual void unbind() override
-  {
-    this->mu_.lock();
-    ref_ -= 1;
-    this->mu_.unlock();
-  }
+  virtual void unbind() override { ref_.fetch_sub(1, std::memory_order_acq_rel); }
 
   /**
    * Increments the reference count. This function is used when binding or instantiating.
@@ -104,42 +101,56 @@ class BoundSynchronousInstrument
    * @param none
    * @return void
    */
-  virtual void inc_ref() override
-  {
-    this->mu_.lock();
-    ref_ += 1;
-    this->mu_.unlock();
-  }
+  virtual void inc_ref() override { ref_.fetch_add(1, std::memory_order_acq_rel); }
 
   /**
    * Returns the current reference count of the instrument.  This value is used to
    * later in the pipeline remove stale instruments.
    *
    * @param none
-   * @return current ref count of the instrument
+   * @return current ref count of the instrument, -1 once it was pruned
+   */
+  virtual int get_ref() override { return ref_.load(std::memory_order_acquire); }
+
+  /**
+   * Increments the reference count unless the instrument was pruned by TryRetire().
+   *
+   * @return false if the instrument was pruned, and must not be handed out anymore
+   */
+  bool TryAcquire() noexcept
+  {
+    int ref = ref_.load(std::memory_order_acquire);
+    while (ref >= 0)
+    {
+      if (ref_.compare_exchange_weak(ref, ref + 1, std::memory_order_acq_rel))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Marks the instrument as pruned if it has no reference, so that a concurrent TryAcquire()
+   * cannot hand it out again.
+   *
+   * @return true if the instrument had no reference and is now pruned
    */
-  virtual int get_ref() override
+  bool TryRetire() noexcept
   {
-    this->mu_.lock();
-    auto ret = ref_;
-    this->mu_.unlock();
-    return ret;
+    int ref = 0;
+    return ref_.compare_exchange_strong(ref, -1, std::memory_order_acq_rel);
   }
 
   /**
    * Records a single synchronous metric event via a call to the aggregator.
    * Since this is a bound synchronous instrument, labels are not required in
-   * metric capture calls.
+   * metric capture calls. The aggregator synchronizes its own updates.
    *
    * @param value is the numerical representation of the metric being captured
    * @return void
    */
-  virtual void update(T value) override
-  {
-    this->mu_.lock();
-    agg_->update(value);
-    this->mu_.unlock();
-  }
+  virtual void update(T value) override { agg_->update(value); }
 
   /**
    * Returns the aggregator responsible for meaningfully combining update values.
@@ -151,7 +162,117 @@ class BoundSynchronousInstrument
 
 private:
   std::shared_ptr<Aggregator<T>> agg_;
-  int ref_ = 0;
+  std::atomic<int> ref_{0};
+};
+
+/**
+ * The bound instruments of a synchronous instrument, identified by the string of their labels.
+ *
+ * Lookups read an immutable snapshot of the map, loaded atomically, so that recording with labels
+ * which are already bound takes no lock. Binding new labels and pruning unreferenced instruments
+ * copy the snapshot under a mutex and publish the copy.
+ *
+ * @tparam T The numeric type of the instrument.
+ * @tparam ApiBoundT The API type of the bound instruments handed out.
+ * @tparam SdkBoundT The SDK type of the bound instruments created.
+ */
+template <class T, class ApiBoundT, class SdkBoundT>
+class BoundInstrumentMap
+{
+public:
+  BoundInstrumentMap() : snapshot_(std::make_shared<Map>()) {}
+
+  /**
+   * Returns the bound instrument of labels with an additional reference, creating it if needed.
+   */
+  nostd::shared_ptr<ApiBoundT> Bind(const std::string &labels,
+                                    const std::string &name,
+                                    const std::string &description,
+                                    const std::string &unit,
+                                    bool enabled)
+  {
+    std::shared_ptr<const Map> snapshot = std::atomic_load(&snapshot_);
+    auto entry                          = snapshot->find(labels);
+    if (entry != snapshot->end() && entry->second.bound->TryAcquire())
+    {
+      return entry->second.instrument;
+    }
+
+    std::lock_guard<std::mutex> guard(mu_);
+    // Instruments are only pruned under the mutex, so the ones of the current snapshot are live.
+    snapshot = std::atomic_load(&snapshot_);
+    entry    = snapshot->find(labels);
+    if (entry != snapshot->end() && entry->second.bound->TryAcquire())
+    {
+      return entry->second.instrument;
+    }
+    SdkBoundT *bound = new SdkBoundT(name, description, unit, enabled);
+    std::shared_ptr<ApiBoundT> instrument{std::shared_ptr<SdkBoundT>(bound)};
+    Entry created{nostd::shared_ptr<ApiBoundT>(std::move(instrument)), bound};
+    std::shared_ptr<Map> copy = std::make_shared<Map>(*snapshot);
+    (*copy)[labels]           = created;
+    std::atomic_store(&snapshot_, std::shared_ptr<const Map>(std::move(copy)));
+    return created.instrument;
+  }
+
+  /**
+   * Checkpoints the updated instruments into records, and prunes the instruments which have no
+   * reference left.
+   */
+  std::vector<Record> Checkpoint()
+  {
+    std::vector<Record> records;
+    std::lock_guard<std::mutex> guard(mu_);
+    std::shared_ptr<const Map> snapshot = std::atomic_load(&snapshot_);
+    std::shared_ptr<Map> retained;
+    for (const auto &entry : *snapshot)
+    {
+      BoundSynchronousInstrument<T> *bound = entry.second.bound;
+      if (bound->TryRetire())
+      {
+        if (!retained)
+        {
+          retained = std::make_shared<Map>(*snapshot);
+        }
+        retained->erase(entry.first);
+      }
+      auto agg_ptr = bound->GetAggregator();
+      if (agg_ptr->is_updated())
+      {
+        agg_ptr->checkpoint();
+        records.emplace_back(bound->GetName(), bound->GetDescription(), entry.first, agg_ptr);
+      }
+    }
+    if (retained)
+    {
+      std::atomic_store(&snapshot_, std::shared_ptr<const Map>(std::move(retained)));
+    }
+    return records;
+  }
+
+  /**
+   * Returns the bound instrument of labels, or a null pointer if they are not bound.
+   */
+  nostd::shared_ptr<ApiBoundT> operator[](const std::string &labels) const
+  {
+    std::shared_ptr<const Map> snapshot = std::atomic_load(&snapshot_);
+    auto entry                          = snapshot->find(labels);
+    return entry != snapshot->end() ? entry->second.instrument : nostd::shared_ptr<ApiBoundT>();
+  }
+
+  std::size_t size() const { return std::atomic_load(&snapshot_)->size(); }
+
+private:
+  struct Entry
+  {
+    nostd::shared_ptr<ApiBoundT> instrument;
+    // The SDK view of instrument, which avoids a cast on lookups.
+    BoundSynchronousInstrument<T> *bound;
+  };
+  using Map = std::unordered_map<std::string, Entry>;
+
+  std::shared_ptr<const Map> snapshot_;
+  std::mutex mu_;
 };
 
 template <class T>
@@ -280,26 +401,33 @@ inline std::string mapToString(const std::map<std::string, std::string> &conv)
 
 inline std::string KvToString(const opentelemetry::common::KeyValueIterable &kv) noexcept
 {
-  std::stringstream ss;
-  ss << "{";
-  size_t size = kv.size();
-  if (size)
-  {
-    size_t i = 1;
-    kv.ForEachKeyValue(
-        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
-          ss << key << ":";
-          print_value(ss, value, true);
-          if (size != i)
-          {
-            ss << ",";
-          }
-          i++;
-          return true;
-        });
-  };
-  ss << "}";
-  return ss.str();
+  std::string labels;
+  labels.reserve(64);
+  labels += '{';
+  bool first = true;
+  kv.ForEachKeyValue(
+      [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+        if (!first)
+        {
+          labels += ',';
+        }
+        first = false;
+        labels.append(key.data(), key.size());
+        labels += ':';
+        if (!nostd::holds_alternative<nostd::string_view>(value))
+        {
+#  if __EXCEPTIONS
+          throw std::invalid_argument("Labels must be strings");
+#  else
+          std::terminate();
+#  endif
+        }
+        nostd::string_view str = nostd::get<nostd::string_view>(value);
+        labels.append(str.data(), str.size());
+        return true;
+      });
+  labels += '}';
+  return labels;
 }
 
 #  if defined(_MSC_VER)
@@ -297,17 +297,17 @@ class Meter : public opentelemetry::metrics::Meter
   void CollectMetrics(std::vector<Record> &records);
 
   /**
-   * Helper function to collect Records from a single synchronous instrument
+   * Helper function to collect Records from the synchronous instruments of a type. The instruments
+   * are only looked up under metrics_lock_, and checkpointed once it is released.
    *
-   * @tparam T The integral type of the instrument to collect from.
-   * @param i A map iterator pointing to the instrument to collect from
+   * @tparam T The integral type of the instruments to collect from.
+   * @param metrics The map of the instruments to collect from
    * @param records The vector to add the new records to.
    */
   template <typename T>
-  void CollectSingleSyncInstrument(
-      typename std::map<std::string,
-                        std::shared_ptr<opentelemetry::metrics::SynchronousInstrument<T>>>::iterator
-          i,
+  void CollectSyncInstruments(
+      std::map<std::string, std::shared_ptr<opentelemetry::metrics::SynchronousInstrument<T>>>
+          &metrics,
       std::vector<Record> &records);
 
   /**
@@ -319,17 +319,17 @@ class Meter : public opentelemetry::metrics::Meter
   void CollectObservers(std::vector<Record> &records);
 
   /**
-   * Helper function to collect Records from a single asynchronous instrument
+   * Helper function to collect Records from the asynchronous instruments of a type. The instruments
+   * are only looked up under observers_lock_, and run once it is released.
    *
-   * @tparam T The integral type of the instrument to collect from.
-   * @param i A map iterator pointing to the instrument to collect from
+   * @tparam T The integral type of the instruments to collect from.
+   * @param observers The map of the instruments to collect from
    * @param records The vector to add the new records to.
    */
   template <typename T>
-  void CollectSingleAsyncInstrument(
-      typename std::map<
-          std::string,
-          std::shared_ptr<opentelemetry::metrics::AsynchronousInstrument<T>>>::iterator i,
+  void CollectAsyncInstruments(
+      std::map<std::string, std::shared_ptr<opentelemetry::metrics::AsynchronousInstrument<T>>>
+          &observers,
       std::vector<Record> &records);
 
   /**
@@ -102,23 +102,8 @@ class Counter final : public SynchronousInstrument<T>, public opentelemetry::met
   virtual nostd::shared_ptr<opentelemetry::metrics::BoundCounter<T>> bindCounter(
       const opentelemetry::common::KeyValueIterable &labels) override
   {
-    this->mu_.lock();
-    std::string labelset = KvToString(labels);
-    if (boundInstruments_.find(labelset) == boundInstruments_.end())
-    {
-      auto sp1 = nostd::shared_ptr<opentelemetry::metrics::BoundCounter<T>>(
-          new BoundCounter<T>(this->name_, this->description_, this->unit_, this->enabled_));
-      boundInstruments_[labelset] = sp1;
-      this->mu_.unlock();
-      return sp1;
-    }
-    else
-    {
-      boundInstruments_[labelset]->inc_ref();
-      auto ret = boundInstruments_[labelset];
-      this->mu_.unlock();
-      return ret;
-    }
+    return boundInstruments_.Bind(KvToString(labels), this->name_, this->description_, this->unit_,
+                                  this->enabled_);
   }
 
   /*
@@ -147,35 +132,7 @@ class Counter final : public SynchronousInstrument<T>, public opentelemetry::met
     }
   }
 
-  virtual std::vector<Record> GetRecords() override
-  {
-    this->mu_.lock();
-    std::vector<Record> ret;
-    std::vector<std::string> toDelete;
-    for (const auto &x : boundInstruments_)
-    {
-      if (x.second->get_ref() == 0)
-      {
-        toDelete.push_back(x.first);
-      }
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      auto agg_ptr = dynamic_cast<BoundCounter<T> *>(x.second.get())->GetAggregator();
-#  else
-      auto agg_ptr = static_cast<BoundCounter<T> *>(x.second.get())->GetAggregator();
-#  endif
-      if (agg_ptr->is_updated())
-      {
-        agg_ptr->checkpoint();
-        ret.push_back(Record(x.second->GetName(), x.second->GetDescription(), x.first, agg_ptr));
-      }
-    }
-    for (const auto &x : toDelete)
-    {
-      boundInstruments_.erase(x);
-    }
-    this->mu_.unlock();
-    return ret;
-  }
+  virtual std::vector<Record> GetRecords() override { return boundInstruments_.Checkpoint(); }
 
   virtual void update(T val, const opentelemetry::common::KeyValueIterable &labels) override
   {
@@ -184,8 +141,7 @@ class Counter final : public SynchronousInstrument<T>, public opentelemetry::met
 
   // A collection of the bound instruments created by this unbound instrument identified by their
   // labels.
-  std::unordered_map<std::string, nostd::shared_ptr<opentelemetry::metrics::BoundCounter<T>>>
-      boundInstruments_;
+  BoundInstrumentMap<T, opentelemetry::metrics::BoundCounter<T>, BoundCounter<T>> boundInstruments_;
 };
 
 template <class T>
@@ -248,23 +204,8 @@ class UpDownCounter final : public SynchronousInstrument<T>,
   nostd::shared_ptr<opentelemetry::metrics::BoundUpDownCounter<T>> bindUpDownCounter(
       const opentelemetry::common::KeyValueIterable &labels) override
   {
-    this->mu_.lock();
-    std::string labelset = KvToString(labels);
-    if (boundInstruments_.find(labelset) == boundInstruments_.end())
-    {
-      auto sp1 = nostd::shared_ptr<opentelemetry::metrics::BoundUpDownCounter<T>>(
-          new BoundUpDownCounter<T>(this->name_, this->description_, this->unit_, this->enabled_));
-      boundInstruments_[labelset] = sp1;
-      this->mu_.unlock();
-      return sp1;
-    }
-    else
-    {
-      boundInstruments_[labelset]->inc_ref();
-      auto ret = boundInstruments_[labelset];
-      this->mu_.unlock();
-      return ret;
-    }
+    return boundInstruments_.Bind(KvToString(labels), this->name_, this->description_, this->unit_,
+                                  this->enabled_);
   }
 
   /*
@@ -282,42 +223,14 @@ class UpDownCounter final : public SynchronousInstrument<T>,
     sp->unbind();
   }
 
-  virtual std::vector<Record> GetRecords() override
-  {
-    this->mu_.lock();
-    std::vector<Record> ret;
-    std::vector<std::string> toDelete;
-    for (const auto &x : boundInstruments_)
-    {
-      if (x.second->get_ref() == 0)
-      {
-        toDelete.push_back(x.first);
-      }
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      auto agg_ptr = dynamic_cast<BoundUpDownCounter<T> *>(x.second.get())->GetAggregator();
-#  else
-      auto agg_ptr = static_cast<BoundUpDownCounter<T> *>(x.second.get())->GetAggregator();
-#  endif
-      if (agg_ptr->is_updated())
-      {
-        agg_ptr->checkpoint();
-        ret.push_back(Record(x.second->GetName(), x.second->GetDescription(), x.first, agg_ptr));
-      }
-    }
-    for (const auto &x : toDelete)
-    {
-      boundInstruments_.erase(x);
-    }
-    this->mu_.unlock();
-    return ret;
-  }
+  virtual std::vector<Record> GetRecords() override { return boundInstruments_.Checkpoint(); }
 
   virtual void update(T val, const opentelemetry::common::KeyValueIterable &labels) override
   {
     add(val, labels);
   }
 
-  std::unordered_map<std::string, nostd::shared_ptr<opentelemetry::metrics::BoundUpDownCounter<T>>>
+  BoundInstrumentMap<T, opentelemetry::metrics::BoundUpDownCounter<T>, BoundUpDownCounter<T>>
       boundInstruments_;
 };
 
@@ -382,23 +295,8 @@ class ValueRecorder final : public SynchronousInstrument<T>,
   nostd::shared_ptr<opentelemetry::metrics::BoundValueRecorder<T>> bindValueRecorder(
       const opentelemetry::common::KeyValueIterable &labels) override
   {
-    this->mu_.lock();
-    std::string labelset = KvToString(labels);
-    if (boundInstruments_.find(labelset) == boundInstruments_.end())
-    {
-      auto sp1 = nostd::shared_ptr<opentelemetry::metrics::BoundValueRecorder<T>>(
-          new BoundValueRecorder<T>(this->name_, this->description_, this->unit_, this->enabled_));
-      boundInstruments_[labelset] = sp1;
-      this->mu_.unlock();
-      return sp1;
-    }
-    else
-    {
-      boundInstruments_[labelset]->inc_ref();
-      auto ret = boundInstruments_[labelset];
-      this->mu_.unlock();
-      return ret;
-    }
+    return boundInstruments_.Bind(KvToString(labels), this->name_, this->description_, this->unit_,
+                                  this->enabled_);
   }
 
   /*
@@ -416,42 +314,14 @@ class ValueRecorder final : public SynchronousInstrument<T>,
     sp->unbind();
   }
 
-  virtual std::vector<Record> GetRecords() override
-  {
-    this->mu_.lock();
-    std::vector<Record> ret;
-    std::vector<std::string> toDelete;
-    for (const auto &x : boundInstruments_)
-    {
-      if (x.second->get_ref() == 0)
-      {
-        toDelete.push_back(x.first);
-      }
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      auto agg_ptr = dynamic_cast<BoundValueRecorder<T> *>(x.second.get())->GetAggregator();
-#  else
-      auto agg_ptr = static_cast<BoundValueRecorder<T> *>(x.second.get())->GetAggregator();
-#  endif
-      if (agg_ptr->is_updated())
-      {
-        agg_ptr->checkpoint();
-        ret.push_back(Record(x.second->GetName(), x.second->GetDescription(), x.first, agg_ptr));
-      }
-    }
-    for (const auto &x : toDelete)
-    {
-      boundInstruments_.erase(x);
-    }
-    this->mu_.unlock();
-    return ret;
-  }
+  virtual std::vector<Record> GetRecords() override { return boundInstruments_.Checkpoint(); }
 
   virtual void update(T value, const opentelemetry::common::KeyValueIterable &labels) override
   {
     record(value, labels);
   }
 
-  std::unordered_map<std::string, nostd::shared_ptr<opentelemetry::metrics::BoundValueRecorder<T>>>
+  BoundInstrumentMap<T, opentelemetry::metrics::BoundValueRecorder<T>, BoundValueRecorder<T>>
       boundInstruments_;
 };
 
@@ -4,7 +4,10 @@
 #pragma once
 #ifdef ENABLE_METRICS_PREVIEW
 
-#  include <map>
+#  include <cstdint>
+#  include <string>
+#  include <unordered_map>
+#  include <utility>
 
 #  include "opentelemetry/common/macros.h"
 #  include "opentelemetry/sdk/_metrics/aggregator/counter_aggregator.h"
@@ -15,6 +18,7 @@
 #  include "opentelemetry/sdk/_metrics/aggregator/sketch_aggregator.h"
 #  include "opentelemetry/sdk/_metrics/processor.h"
 #  include "opentelemetry/sdk/_metrics/record.h"
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
 #  include "opentelemetry/version.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -25,44 +29,47 @@ namespace sdk
 namespace metrics
 {
 
+/**
+ * The key of the records merged together by the processor. Its hash is computed once, when the
+ * key is built from a record, and compared before the strings are.
+ */
 struct KeyStruct
 {
   std::string name;
   std::string description;
   std::string labels;
   opentelemetry::metrics::InstrumentKind ins_kind;
+  std::size_t hash;
 
   // constructor
   KeyStruct(std::string name,
             std::string description,
             std::string labels,
             opentelemetry::metrics::InstrumentKind ins_kind)
+      : name(std::move(name)),
+        description(std::move(description)),
+        labels(std::move(labels)),
+        ins_kind(ins_kind)
   {
-    this->name        = name;
-    this->description = description;
-    this->labels      = labels;
-    this->ins_kind    = ins_kind;
+    uint64_t seed = static_cast<uint64_t>(ins_kind);
+    opentelemetry::sdk::common::HashBytes(seed, this->name.data(), this->name.size());
+    opentelemetry::sdk::common::HashBytes(seed, this->description.data(),
+                                          this->description.size());
+    opentelemetry::sdk::common::HashBytes(seed, this->labels.data(), this->labels.size());
+    hash = static_cast<std::size_t>(opentelemetry::sdk::common::FinalizeHash(seed));
   }
 
   // operator== is required to compare keys in case of hash collision
   bool operator==(const KeyStruct &p) const
   {
-    return name == p.name && description == p.description && labels == p.labels &&
-           ins_kind == p.ins_kind;
+    return hash == p.hash && ins_kind == p.ins_kind && name == p.name && labels == p.labels &&
+           description == p.description;
   }
 };
 
 struct KeyStruct_Hash
 {
-  std::size_t operator()(const KeyStruct &keystruct) const
-  {
-    std::size_t name_size   = keystruct.name.length();
-    std::size_t desc_size   = keystruct.description.length();
-    std::size_t labels_size = keystruct.labels.length();
-    std::size_t ins_size    = (int)keystruct.ins_kind;
-
-    return (name_size ^ desc_size ^ labels_size) + ins_size;
-  }
+  std::size_t operator()(const KeyStruct &keystruct) const { return keystruct.hash; }
 };
 
 class UngroupedMetricsProcessor : public MetricsProcessor
@@ -86,7 +93,7 @@ class UngroupedMetricsProcessor : public MetricsProcessor
    * unpack the variant then get the instrument from the Aggreagtor.
    */
   opentelemetry::metrics::InstrumentKind get_instrument(
-      opentelemetry::sdk::metrics::AggregatorVariant aggregator)
+      const opentelemetry::sdk::metrics::AggregatorVariant &aggregator)
   {
     if (nostd::holds_alternative<std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<short>>>(
             aggregator))
@@ -124,7 +131,7 @@ class UngroupedMetricsProcessor : public MetricsProcessor
    */
   template <typename T>
   std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> aggregator_copy(
-      std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> aggregator)
+      const std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> &aggregator)
   {
     auto ins_kind = aggregator->get_instrument_kind();
     auto agg_kind = aggregator->get_aggregator_kind();
@@ -206,156 +213,86 @@ class UngroupedMetricsProcessor : public MetricsProcessor
   };
 
   /**
-   * merge_aggreagtors takes in two shared pointers to aggregators of the same kind.
-   * We first need to dynamically cast to the actual Aggregator that is held in the
-   * Aggregator<T> wrapper. Then we must get the underlying pointer from the shared
-   * pointer and merge them together.
+   * merge_variant merges the aggregator of a record into the aggregator of the batch map which
+   * holds the same type of values, in place.
    */
+  void merge_variant(opentelemetry::sdk::metrics::AggregatorVariant &batch_value,
+                     const opentelemetry::sdk::metrics::AggregatorVariant &aggregator)
+  {
+    merge_alternative<short>(batch_value, aggregator) ||
+        merge_alternative<int>(batch_value, aggregator) ||
+        merge_alternative<float>(batch_value, aggregator) ||
+        merge_alternative<double>(batch_value, aggregator);
+  }
+
   template <typename T>
-  void merge_aggregators(std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> batch_agg,
-                         std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> record_agg)
+  bool merge_alternative(opentelemetry::sdk::metrics::AggregatorVariant &batch_value,
+                         const opentelemetry::sdk::metrics::AggregatorVariant &aggregator)
   {
-    auto agg_kind = batch_agg->get_aggregator_kind();
-    if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::Counter)
+    using AggregatorPtr = std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>>;
+    if (!nostd::holds_alternative<AggregatorPtr>(aggregator) ||
+        !nostd::holds_alternative<AggregatorPtr>(batch_value))
     {
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::CounterAggregator<T>> temp_batch_agg_counter =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::CounterAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::CounterAggregator<T>> temp_record_agg_counter =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::CounterAggregator<T>>(record_agg);
-#  else
-      std::shared_ptr<opentelemetry::sdk::metrics::CounterAggregator<T>> temp_batch_agg_counter =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::CounterAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::CounterAggregator<T>> temp_record_agg_counter =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::CounterAggregator<T>>(record_agg);
-#  endif
-      auto temp_batch_agg_raw_counter  = temp_batch_agg_counter.get();
-      auto temp_record_agg_raw_counter = temp_record_agg_counter.get();
-
-      temp_batch_agg_raw_counter->merge(*temp_record_agg_raw_counter);
+      return false;
     }
-    else if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::MinMaxSumCount)
-    {
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>
-          temp_batch_agg_mmsc =
-              std::dynamic_pointer_cast<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>(
-                  batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>
-          temp_record_agg_mmsc =
-              std::dynamic_pointer_cast<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>(
-                  record_agg);
-#  else
-      std::shared_ptr<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>
-          temp_batch_agg_mmsc =
-              std::static_pointer_cast<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>(
-                  batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>
-          temp_record_agg_mmsc =
-              std::static_pointer_cast<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>(
-                  record_agg);
-#  endif
-
-      auto temp_batch_agg_raw_mmsc  = temp_batch_agg_mmsc.get();
-      auto temp_record_agg_raw_mmsc = temp_record_agg_mmsc.get();
+    merge_aggregators<T>(nostd::get<AggregatorPtr>(batch_value),
+                         nostd::get<AggregatorPtr>(aggregator));
+    return true;
+  }
 
-      temp_batch_agg_raw_mmsc->merge(*temp_record_agg_raw_mmsc);
-    }
-    else if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::Gauge)
+  /**
+   * merge_aggreagtors takes in two shared pointers to aggregators of the same kind.
+   * We first need to cast to the actual Aggregator that is held in the Aggregator<T>
+   * wrapper, then merge them together. The aggregators are cast without copying the
+   * shared pointers.
+   */
+  template <typename T>
+  void merge_aggregators(
+      const std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> &batch_agg,
+      const std::shared_ptr<opentelemetry::sdk::metrics::Aggregator<T>> &record_agg)
+  {
+    switch (batch_agg->get_aggregator_kind())
     {
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::GaugeAggregator<T>> temp_batch_agg_gauge =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::GaugeAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::GaugeAggregator<T>> temp_record_agg_gauge =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::GaugeAggregator<T>>(record_agg);
-#  else
-      std::shared_ptr<opentelemetry::sdk::metrics::GaugeAggregator<T>> temp_batch_agg_gauge =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::GaugeAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::GaugeAggregator<T>> temp_record_agg_gauge =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::GaugeAggregator<T>>(record_agg);
-#  endif
-
-      auto temp_batch_agg_raw_gauge  = temp_batch_agg_gauge.get();
-      auto temp_record_agg_raw_gauge = temp_record_agg_gauge.get();
-
-      temp_batch_agg_raw_gauge->merge(*temp_record_agg_raw_gauge);
+      case opentelemetry::sdk::metrics::AggregatorKind::Counter:
+        merge_as<opentelemetry::sdk::metrics::CounterAggregator<T>>(*batch_agg, *record_agg);
+        break;
+      case opentelemetry::sdk::metrics::AggregatorKind::MinMaxSumCount:
+        merge_as<opentelemetry::sdk::metrics::MinMaxSumCountAggregator<T>>(*batch_agg,
+                                                                           *record_agg);
+        break;
+      case opentelemetry::sdk::metrics::AggregatorKind::Gauge:
+        merge_as<opentelemetry::sdk::metrics::GaugeAggregator<T>>(*batch_agg, *record_agg);
+        break;
+      case opentelemetry::sdk::metrics::AggregatorKind::Sketch:
+        merge_as<opentelemetry::sdk::metrics::SketchAggregator<T>>(*batch_agg, *record_agg);
+        break;
+      case opentelemetry::sdk::metrics::AggregatorKind::Histogram:
+        merge_as<opentelemetry::sdk::metrics::HistogramAggregator<T>>(*batch_agg, *record_agg);
+        break;
+      case opentelemetry::sdk::metrics::AggregatorKind::Exact:
+        merge_as<opentelemetry::sdk::metrics::ExactAggregator<T>>(*batch_agg, *record_agg);
+        break;
+      default:
+        break;
     }
-    else if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::Sketch)
-    {
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::SketchAggregator<T>> temp_batch_agg_sketch =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::SketchAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::SketchAggregator<T>> temp_record_agg_sketch =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::SketchAggregator<T>>(record_agg);
-#  else
-      std::shared_ptr<opentelemetry::sdk::metrics::SketchAggregator<T>> temp_batch_agg_sketch =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::SketchAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::SketchAggregator<T>> temp_record_agg_sketch =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::SketchAggregator<T>>(record_agg);
-#  endif
-      auto temp_batch_agg_raw_sketch  = temp_batch_agg_sketch.get();
-      auto temp_record_agg_raw_sketch = temp_record_agg_sketch.get();
+  }
 
-      temp_batch_agg_raw_sketch->merge(*temp_record_agg_raw_sketch);
-    }
-    else if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::Histogram)
-    {
+  template <typename AggregatorType, typename T>
+  static void merge_as(opentelemetry::sdk::metrics::Aggregator<T> &batch_agg,
+                       opentelemetry::sdk::metrics::Aggregator<T> &record_agg)
+  {
 #  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::HistogramAggregator<T>>
-          temp_batch_agg_histogram =
-              std::dynamic_pointer_cast<opentelemetry::sdk::metrics::HistogramAggregator<T>>(
-                  batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::HistogramAggregator<T>>
-          temp_record_agg_histogram =
-              std::dynamic_pointer_cast<opentelemetry::sdk::metrics::HistogramAggregator<T>>(
-                  record_agg);
-#  else
-      std::shared_ptr<opentelemetry::sdk::metrics::HistogramAggregator<T>>
-          temp_batch_agg_histogram =
-              std::static_pointer_cast<opentelemetry::sdk::metrics::HistogramAggregator<T>>(
-                  batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::HistogramAggregator<T>>
-          temp_record_agg_histogram =
-              std::static_pointer_cast<opentelemetry::sdk::metrics::HistogramAggregator<T>>(
-                  record_agg);
-#  endif
-
-      auto temp_batch_agg_raw_histogram  = temp_batch_agg_histogram.get();
-      auto temp_record_agg_raw_histogram = temp_record_agg_histogram.get();
-
-      temp_batch_agg_raw_histogram->merge(*temp_record_agg_raw_histogram);
-    }
-    else if (agg_kind == opentelemetry::sdk::metrics::AggregatorKind::Exact)
+    auto batch_agg_raw  = dynamic_cast<AggregatorType *>(&batch_agg);
+    auto record_agg_raw = dynamic_cast<AggregatorType *>(&record_agg);
+    if (batch_agg_raw == nullptr || record_agg_raw == nullptr)
     {
-#  ifdef OPENTELEMETRY_RTTI_ENABLED
-      std::shared_ptr<opentelemetry::sdk::metrics::ExactAggregator<T>> temp_batch_agg_exact =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::ExactAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::ExactAggregator<T>> temp_record_agg_exact =
-          std::dynamic_pointer_cast<opentelemetry::sdk::metrics::ExactAggregator<T>>(record_agg);
+      return;
+    }
 #  else
-      std::shared_ptr<opentelemetry::sdk::metrics::ExactAggregator<T>> temp_batch_agg_exact =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::ExactAggregator<T>>(batch_agg);
-
-      std::shared_ptr<opentelemetry::sdk::metrics::ExactAggregator<T>> temp_record_agg_exact =
-          std::static_pointer_cast<opentelemetry::sdk::metrics::ExactAggregator<T>>(record_agg);
+    auto batch_agg_raw  = static_cast<AggregatorType *>(&batch_agg);
+    auto record_agg_raw = static_cast<AggregatorType *>(&record_agg);
 #  endif
-
-      auto temp_batch_agg_raw_exact  = temp_batch_agg_exact.get();
-      auto temp_record_agg_raw_exact = temp_record_agg_exact.get();
-
-      temp_batch_agg_raw_exact->merge(*temp_record_agg_raw_exact);
-    }
+    batch_agg_raw->merge(*record_agg_raw);
   }
 };
 }  // namespace metrics
@@ -0,0 +1,131 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Picks the export batch size and the delay between exports of a batch processor from the
+ * observed arrival rate and exporter latency, within configured bounds.
+ *
+ * - The delay is the time it takes to accumulate a maximal batch at the current arrival rate, so
+ *   spikes shorten it (down to min_delay) and quiet periods stretch it (up to max_delay).
+ * - The batch size is what must be exported per cycle to keep up with the arrival rate, given one
+ *   delay plus one export per cycle, with some headroom. Slow exporters thus get larger batches.
+ *
+ * Rates and latencies are smoothed with an exponentially weighted moving average. This class is
+ * not thread-safe; it is meant to be owned by the processor's worker thread.
+ */
+class AdaptiveBatchScheduler
+{
+public:
+  AdaptiveBatchScheduler(size_t min_batch_size,
+                         size_t max_batch_size,
+                         std::chrono::milliseconds min_delay,
+                         std::chrono::milliseconds max_delay) noexcept
+      : min_batch_size_(min_batch_size < max_batch_size ? min_batch_size : max_batch_size),
+        max_batch_size_(max_batch_size),
+        min_delay_(min_delay < max_delay ? min_delay : max_delay),
+        max_delay_(max_delay),
+        batch_size_(max_batch_size_),
+        delay_(max_delay_)
+  {}
+
+  /**
+   * Feeds the observations of one worker cycle.
+   * @param items_arrived the number of items enqueued since the previous update
+   * @param elapsed the time since the previous update
+   * @param export_duration the time the exporter took during this cycle
+   */
+  void Update(uint64_t items_arrived,
+              std::chrono::steady_clock::duration elapsed,
+              std::chrono::steady_clock::duration export_duration) noexcept
+  {
+    double elapsed_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    if (elapsed_ms <= 0)
+    {
+      return;
+    }
+    double rate       = static_cast<double>(items_arrived) / elapsed_ms;
+    double latency_ms = std::chrono::duration<double, std::milli>(export_duration).count();
+    if (has_samples_)
+    {
+      rate_per_ms_ += kSmoothing * (rate - rate_per_ms_);
+      export_latency_ms_ += kSmoothing * (latency_ms - export_latency_ms_);
+    }
+    else
+    {
+      rate_per_ms_       = rate;
+      export_latency_ms_ = latency_ms;
+      has_samples_       = true;
+    }
+
+    double delay_ms = static_cast<double>(max_delay_.count());
+    if (rate_per_ms_ > 0)
+    {
+      double fill_time_ms = static_cast<double>(max_batch_size_) / rate_per_ms_;
+      if (fill_time_ms < delay_ms)
+      {
+        delay_ms = fill_time_ms;
+      }
+    }
+    if (delay_ms < static_cast<double>(min_delay_.count()))
+    {
+      delay_ms = static_cast<double>(min_delay_.count());
+    }
+    delay_ = std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(delay_ms));
+
+    double batch_size = rate_per_ms_ * (delay_ms + export_latency_ms_) * kHeadroom;
+    if (batch_size >= static_cast<double>(max_batch_size_))
+    {
+      batch_size_ = max_batch_size_;
+    }
+    else if (batch_size <= static_cast<double>(min_batch_size_))
+    {
+      batch_size_ = min_batch_size_;
+    }
+    else
+    {
+      batch_size_ = static_cast<size_t>(batch_size);
+    }
+  }
+
+  /**
+   * @return the number of items to export per cycle.
+   */
+  size_t batch_size() const noexcept { return batch_size_; }
+
+  /**
+   * @return the delay between two consecutive exports.
+   */
+  std::chrono::milliseconds schedule_delay() const noexcept { return delay_; }
+
+private:
+  static constexpr double kSmoothing = 0.3;
+  static constexpr double kHeadroom  = 1.5;
+
+  const size_t min_batch_size_;
+  const size_t max_batch_size_;
+  const std::chrono::milliseconds min_delay_;
+  const std::chrono::milliseconds max_delay_;
+
+  size_t batch_size_;
+  std::chrono::milliseconds delay_;
+
+  bool has_samples_         = false;
+  double rate_per_ms_       = 0;
+  double export_latency_ms_ = 0;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,197 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A bump allocator. Allocations are carved out of blocks in order and are
+ * only freed all at once, when the arena is reset or destroyed. Destructors of
+ * the objects placed in the arena are not run.
+ *
+ * The first block may be provided by the owner, so that an arena embedded in
+ * an object does not allocate until it outgrows it. Further blocks are taken
+ * from the heap, doubling in size up to kMaxBlockSize.
+ *
+ * This class is not thread-safe.
+ */
+class Arena
+{
+public:
+  static constexpr size_t kMinBlockSize = 256;
+  static constexpr size_t kMaxBlockSize = 64 * 1024;
+
+  Arena() noexcept = default;
+
+  /**
+   * @param initial_block memory used before any heap block, which must outlive the arena.
+   * @param size the size of initial_block in bytes.
+   */
+  Arena(void *initial_block, size_t size) noexcept
+      : initial_block_(static_cast<char *>(initial_block)),
+        initial_size_(size),
+        current_(initial_block_),
+        end_(initial_block_ + size)
+  {}
+
+  Arena(const Arena &)            = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  ~Arena() { ReleaseBlocks(); }
+
+  /**
+   * Allocates size bytes aligned on alignment, which must be a power of two.
+   * @return the allocated memory, or nullptr if the heap is exhausted.
+   */
+  void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept
+  {
+    char *aligned = Align(current_, alignment);
+    if (aligned == nullptr || aligned > end_ || static_cast<size_t>(end_ - aligned) < size)
+    {
+      if (!AddBlock(size + alignment))
+      {
+        return nullptr;
+      }
+      aligned = Align(current_, alignment);
+    }
+    current_ = aligned + size;
+    return aligned;
+  }
+
+  /**
+   * Allocates an uninitialized array of count objects of type T.
+   */
+  template <typename T>
+  T *AllocateArray(size_t count) noexcept
+  {
+    return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  /**
+   * Copies a string into the arena.
+   * @return a view of the copy, or an empty view if the heap is exhausted.
+   */
+  nostd::string_view CopyString(nostd::string_view str) noexcept
+  {
+    if (str.empty())
+    {
+      return nostd::string_view();
+    }
+    char *copy = AllocateArray<char>(str.size());
+    if (copy == nullptr)
+    {
+      return nostd::string_view();
+    }
+    std::memcpy(copy, str.data(), str.size());
+    return nostd::string_view(copy, str.size());
+  }
+
+  /**
+   * Copies an array of trivially copyable values into the arena.
+   * @return a view of the copy, or an empty view if the heap is exhausted.
+   */
+  template <typename T>
+  nostd::span<const T> CopySpan(nostd::span<const T> values) noexcept
+  {
+    if (values.empty())
+    {
+      return nostd::span<const T>();
+    }
+    T *copy = AllocateArray<T>(values.size());
+    if (copy == nullptr)
+    {
+      return nostd::span<const T>();
+    }
+    std::memcpy(copy, values.data(), sizeof(T) * values.size());
+    return nostd::span<const T>(copy, values.size());
+  }
+
+  /**
+   * Returns the number of bytes taken from the heap.
+   */
+  size_t GetHeapSize() const noexcept { return heap_size_; }
+
+  /**
+   * Frees all the allocations at once. The initial block is kept, heap blocks
+   * are returned to the heap.
+   */
+  void Reset() noexcept
+  {
+    ReleaseBlocks();
+    current_ = initial_block_;
+    end_     = initial_block_ + initial_size_;
+  }
+
+private:
+  /* Header of the blocks taken from the heap, followed by their memory. */
+  struct Block
+  {
+    Block *next;
+  };
+
+  static char *Align(char *ptr, size_t alignment) noexcept
+  {
+    if (ptr == nullptr)
+    {
+      return nullptr;
+    }
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    return ptr + ((alignment - address % alignment) % alignment);
+  }
+
+  bool AddBlock(size_t min_size) noexcept
+  {
+    const size_t size = (std::max)(min_size, next_block_size_);
+    void *memory      = ::operator new(sizeof(Block) + size, std::nothrow);
+    if (memory == nullptr)
+    {
+      return false;
+    }
+    Block *block     = static_cast<Block *>(memory);
+    block->next      = blocks_;
+    blocks_          = block;
+    current_         = reinterpret_cast<char *>(block + 1);
+    end_             = current_ + size;
+    heap_size_      += sizeof(Block) + size;
+    next_block_size_ =
+        next_block_size_ < kMaxBlockSize / 2 ? next_block_size_ * 2 : size_t{kMaxBlockSize};
+    return true;
+  }
+
+  void ReleaseBlocks() noexcept
+  {
+    while (blocks_ != nullptr)
+    {
+      Block *next = blocks_->next;
+      ::operator delete(blocks_);
+      blocks_ = next;
+    }
+    heap_size_       = 0;
+    next_block_size_ = kMinBlockSize;
+  }
+
+  char *initial_block_    = nullptr;
+  size_t initial_size_    = 0;
+  char *current_          = nullptr;
+  char *end_              = nullptr;
+  Block *blocks_          = nullptr;
+  size_t heap_size_       = 0;
+  size_t next_block_size_ = kMinBlockSize;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -66,6 +66,19 @@ class AtomicUniquePtr
    */
   void Swap(std::unique_ptr<T> &other) noexcept { other.reset(ptr_.exchange(other.release())); }
 
+  /**
+   * Take ownership of the pointer, leaving null, without synchronizing with other threads. The
+   * caller must have exclusive access to this pointer, and publish the change with a release
+   * operation of its own.
+   * @return the pointer managed until now
+   */
+  T *ReleaseRelaxed() noexcept
+  {
+    T *ptr = ptr_.load(std::memory_order_relaxed);
+    ptr_.store(nullptr, std::memory_order_relaxed);
+    return ptr;
+  }
+
   /**
    * Set the pointer to a new value and delete the current value if non-null.
    * @param ptr the new pointer value to set
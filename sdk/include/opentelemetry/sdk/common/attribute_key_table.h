@@ -0,0 +1,134 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "opentelemetry/common/attribute_key.h"
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/shared_spin_lock_mutex.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A process-wide table of interned attribute keys. Each distinct key is
+ * copied once and given a small integer id, so that recordables can store the
+ * id instead of a copy of the key, and exporters which encode keys with a
+ * dictionary can use the id directly.
+ *
+ * Interned keys are never freed. To bound the memory taken by high-cardinality
+ * keys, the table holds at most kMaxKeys keys; Intern returns kInvalidKeyId
+ * once it is full, and callers then keep their own copy of the key.
+ *
+ * Looking up the key of an id does not lock. Interning a key which is already
+ * in the table takes a shared lock, except for the keys the table is created
+ * with: the process-wide table is created with the keys of the semantic
+ * conventions, so that their compile-time AttributeKey ids are their ids in
+ * the table.
+ */
+class AttributeKeyTable
+{
+public:
+  using KeyId = uint32_t;
+
+  static constexpr KeyId kInvalidKeyId = UINT32_MAX;
+  static constexpr size_t kMaxKeys     = 1 << 16;
+
+  /**
+   * Returns the table shared by the whole process.
+   */
+  static AttributeKeyTable &GetInstance() noexcept;
+
+  AttributeKeyTable() noexcept;
+
+  /**
+   * Creates a table holding `keys`, the id of each being its index in `keys`.
+   * The ids of the AttributeKey must be these indices.
+   */
+  explicit AttributeKeyTable(nostd::span<const opentelemetry::common::AttributeKey> keys) noexcept;
+
+  ~AttributeKeyTable();
+
+  AttributeKeyTable(const AttributeKeyTable &)            = delete;
+  AttributeKeyTable &operator=(const AttributeKeyTable &) = delete;
+
+  /**
+   * Returns the id of key, adding the key to the table if it is not in it yet.
+   * @return the id of the key, or kInvalidKeyId if the table is full.
+   */
+  KeyId Intern(nostd::string_view key) noexcept;
+
+  /**
+   * Returns the id of key. The id of a key the table was created with is
+   * returned without a lookup.
+   */
+  KeyId Intern(const opentelemetry::common::AttributeKey &key) noexcept
+  {
+    if (key.id() < num_initial_keys_)
+    {
+      return key.id();
+    }
+    return Intern(key.name());
+  }
+
+  /**
+   * Returns the id of key, or kInvalidKeyId if the key was never interned.
+   */
+  KeyId Find(nostd::string_view key) const noexcept;
+
+  /**
+   * Returns the key of an id returned by Intern. The view is valid for the
+   * lifetime of the table.
+   */
+  nostd::string_view GetKey(KeyId id) const noexcept
+  {
+    const Entry *chunk = chunks_[id / kChunkSize].load(std::memory_order_acquire);
+    return nostd::string_view(chunk[id % kChunkSize].data, chunk[id % kChunkSize].size);
+  }
+
+  /**
+   * Returns the number of interned keys.
+   */
+  size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+private:
+  static constexpr size_t kChunkSize = 1024;
+  static constexpr size_t kNumChunks = kMaxKeys / kChunkSize;
+
+  struct Entry
+  {
+    const char *data;
+    size_t size;
+  };
+
+  // FNV-1a, like AttributeKey::hash().
+  struct KeyHash
+  {
+    size_t operator()(nostd::string_view key) const noexcept;
+  };
+
+  // Ids are grouped in chunks allocated on demand, so that the key of an id
+  // stays at the same address as the table grows.
+  std::atomic<Entry *> chunks_[kNumChunks];
+  std::atomic<size_t> size_{0};
+  size_t num_initial_keys_ = 0;
+
+  mutable SharedSpinLockMutex lock_;
+  // Keys are views of storage_, which never moves.
+  std::unordered_map<nostd::string_view, KeyId, KeyHash> ids_;
+  std::vector<std::unique_ptr<char[]>> storage_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -75,7 +78,7 @@ struct AttributeConverter
   {
     return OwnedAttributeValue(std::string(v));
   }
-  OwnedAttributeValue operator()(std::string v) { return OwnedAttributeValue(v); }
+  OwnedAttributeValue operator()(std::string v) { return OwnedAttributeValue(std::move(v)); }
   OwnedAttributeValue operator()(const char *v) { return OwnedAttributeValue(std::string(v)); }
   OwnedAttributeValue operator()(nostd::span<const uint8_t> v) { return convertSpan<uint8_t>(v); }
   OwnedAttributeValue operator()(nostd::span<const bool> v) { return convertSpan<bool>(v); }
@@ -89,14 +92,193 @@ struct AttributeConverter
     return convertSpan<std::string>(v);
   }
 
+  // Arrays are referenced by AttributeValue until here, where the recordable takes ownership: this
+  // is their only copy.
   template <typename T, typename U = T>
   OwnedAttributeValue convertSpan(nostd::span<const U> vals)
   {
-    const std::vector<T> copy(vals.begin(), vals.end());
+    std::vector<T> copy(vals.begin(), vals.end());
     return OwnedAttributeValue(std::move(copy));
   }
 };
 
+/**
+ * Creates an owned copy of `value`, like visiting it with AttributeConverter. The scalar and
+ * string alternatives, which most attributes hold, are dispatched with a switch on the index of
+ * the variant, which the compiler inlines, instead of the generic visitation of nostd::variant.
+ */
+inline OwnedAttributeValue ConvertAttributeValue(const opentelemetry::common::AttributeValue &value)
+{
+  switch (value.index())
+  {
+    case opentelemetry::common::kTypeBool:
+      return OwnedAttributeValue(*nostd::get_if<bool>(&value));
+    case opentelemetry::common::kTypeInt:
+      return OwnedAttributeValue(*nostd::get_if<int32_t>(&value));
+    case opentelemetry::common::kTypeInt64:
+      return OwnedAttributeValue(*nostd::get_if<int64_t>(&value));
+    case opentelemetry::common::kTypeUInt:
+      return OwnedAttributeValue(*nostd::get_if<uint32_t>(&value));
+    case opentelemetry::common::kTypeDouble:
+      return OwnedAttributeValue(*nostd::get_if<double>(&value));
+    case opentelemetry::common::kTypeCString:
+      return OwnedAttributeValue(std::string(*nostd::get_if<const char *>(&value)));
+    case opentelemetry::common::kTypeString: {
+      nostd::string_view str = *nostd::get_if<nostd::string_view>(&value);
+      return OwnedAttributeValue(std::string(str.data(), str.size()));
+    }
+    default:
+      AttributeConverter converter;
+      return nostd::visit(converter, value);
+  }
+}
+
+/**
+ * Calls a callback with a non-owning AttributeValue referring to an OwnedAttributeValue. Arrays of
+ * booleans and strings are copied into a temporary array for the duration of the call.
+ */
+template <class Callback>
+struct AttributeValueViewer
+{
+  Callback &callback;
+
+  template <class T>
+  void operator()(const T &value)
+  {
+    callback(opentelemetry::common::AttributeValue(value));
+  }
+
+  void operator()(const std::string &value) { callback(nostd::string_view(value)); }
+
+  template <class T>
+  void operator()(const std::vector<T> &values)
+  {
+    callback(nostd::span<const T>(values.data(), values.size()));
+  }
+
+  void operator()(const std::vector<bool> &values)
+  {
+    std::unique_ptr<bool[]> copy(new bool[values.size()]);
+    std::copy(values.begin(), values.end(), copy.get());
+    callback(nostd::span<const bool>(copy.get(), values.size()));
+  }
+
+  void operator()(const std::vector<std::string> &values)
+  {
+    std::vector<nostd::string_view> views(values.begin(), values.end());
+    callback(nostd::span<const nostd::string_view>(views.data(), views.size()));
+  }
+};
+
+template <class Callback>
+void ViewAttributeValue(const OwnedAttributeValue &value, Callback &&callback)
+{
+  nostd::visit(AttributeValueViewer<Callback>{callback}, value);
+}
+
+/* Presents owned attributes as a KeyValueIterable, to record them into a recordable. */
+template <class Map>
+class OwnedAttributesIterable final : public opentelemetry::common::KeyValueIterable
+{
+public:
+  explicit OwnedAttributesIterable(const Map &attributes) : attributes_(attributes) {}
+
+  bool ForEachKeyValue(
+      nostd::function_ref<bool(nostd::string_view, opentelemetry::common::AttributeValue)>
+          callback) const noexcept override
+  {
+    for (const auto &attribute : attributes_)
+    {
+      bool proceed = true;
+      ViewAttributeValue(attribute.second, [&](const opentelemetry::common::AttributeValue &value) {
+        proceed = callback(attribute.first, value);
+      });
+      if (!proceed)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const noexcept override { return attributes_.size(); }
+
+private:
+  const Map &attributes_;
+};
+
+/**
+ * Estimates the number of bytes of an attribute value, owned or not, once serialized by an
+ * exporter: the bytes of its scalars, strings and elements, without the framing of the encoding.
+ */
+struct AttributeValueSizeEstimator
+{
+  template <class T>
+  size_t operator()(const T &) const noexcept
+  {
+    return sizeof(T);
+  }
+
+  size_t operator()(const char *v) const noexcept { return std::strlen(v); }
+
+  size_t operator()(nostd::string_view v) const noexcept { return v.size(); }
+
+  size_t operator()(const std::string &v) const noexcept { return v.size(); }
+
+  template <class T>
+  size_t operator()(nostd::span<const T> v) const noexcept
+  {
+    return v.size() * sizeof(T);
+  }
+
+  size_t operator()(nostd::span<const nostd::string_view> v) const noexcept
+  {
+    size_t size = 0;
+    for (auto &element : v)
+    {
+      size += element.size();
+    }
+    return size;
+  }
+
+  template <class T>
+  size_t operator()(const std::vector<T> &v) const noexcept
+  {
+    return v.size() * sizeof(T);
+  }
+
+  size_t operator()(const std::vector<bool> &v) const noexcept { return v.size(); }
+
+  size_t operator()(const std::vector<std::string> &v) const noexcept
+  {
+    size_t size = 0;
+    for (auto &element : v)
+    {
+      size += element.size();
+    }
+    return size;
+  }
+};
+
+/* The bytes an exporter is assumed to add to each attribute, for the tags and lengths. */
+constexpr size_t kEstimatedAttributeOverhead = 8;
+
+/**
+ * Estimates the number of bytes of the attributes of a map, e.g. an AttributeMap, once serialized
+ * by an exporter.
+ */
+template <class Map>
+inline size_t EstimateAttributesSize(const Map &attributes) noexcept
+{
+  size_t size = 0;
+  for (auto &kv : attributes)
+  {
+    size += kEstimatedAttributeOverhead + kv.first.size() +
+            nostd::visit(AttributeValueSizeEstimator(), kv.second);
+  }
+  return size;
+}
+
 /**
  * Class for storing attributes.
  */
@@ -138,11 +320,8 @@ class AttributeMap : public std::unordered_map<std::string, OwnedAttributeValue>
   void SetAttribute(nostd::string_view key,
                     const opentelemetry::common::AttributeValue &value) noexcept
   {
-    (*this)[std::string(key)] = nostd::visit(converter_, value);
+    (*this)[std::string(key)] = ConvertAttributeValue(value);
   }
-
-private:
-  AttributeConverter converter_;
 };
 
 /**
@@ -187,13 +366,269 @@ class OrderedAttributeMap : public std::map<std::string, OwnedAttributeValue>
   void SetAttribute(nostd::string_view key,
                     const opentelemetry::common::AttributeValue &value) noexcept
   {
-    (*this)[std::string(key)] = nostd::visit(converter_, value);
+    (*this)[std::string(key)] = ConvertAttributeValue(value);
+  }
+};
+
+/**
+ * Class for storing a few attributes, such as those of span events and links, as a vector of
+ * key/value pairs in insertion order. Lookups are linear, which beats hashing for a handful of
+ * keys and saves the node and bucket allocations of an unordered_map.
+ */
+class FlatAttributeMap : public std::vector<std::pair<std::string, OwnedAttributeValue>>
+{
+public:
+  // Contruct empty attribute map
+  FlatAttributeMap() : std::vector<std::pair<std::string, OwnedAttributeValue>>(){};
+
+  // Contruct attribute map and populate with attributes
+  FlatAttributeMap(const opentelemetry::common::KeyValueIterable &attributes) : FlatAttributeMap()
+  {
+    reserve(attributes.size());
+    attributes.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          SetAttribute(key, value);
+          return true;
+        });
+  }
+
+  // Returns a reference to this map
+  const std::vector<std::pair<std::string, OwnedAttributeValue>> &GetAttributes() const noexcept
+  {
+    return (*this);
+  }
+
+  // Returns the entry for key, or end() if there is none
+  const_iterator find(nostd::string_view key) const noexcept
+  {
+    for (auto it = begin(); it != end(); ++it)
+    {
+      if (nostd::string_view(it->first) == key)
+      {
+        return it;
+      }
+    }
+    return end();
+  }
+
+  // Returns the value for key. Like unordered_map::at, the key must be present.
+  const OwnedAttributeValue &at(nostd::string_view key) const
+  {
+    auto it = find(key);
+    if (it == end())
+    {
+      // Out of range: throws std::out_of_range like the other attribute maps.
+      return std::vector<std::pair<std::string, OwnedAttributeValue>>::at(size()).second;
+    }
+    return it->second;
+  }
+
+  // Convert non-owning key-value to owning std::string(key) and OwnedAttributeValue(value),
+  // replacing the value of an existing key
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept
+  {
+    for (auto &kv : *this)
+    {
+      if (nostd::string_view(kv.first) == key)
+      {
+        kv.second = ConvertAttributeValue(value);
+        return;
+      }
+    }
+    emplace_back(std::string(key), ConvertAttributeValue(value));
+  }
+};
+
+/**
+ * A flat alternative to OrderedAttributeMap and AttributeMap: the attributes are kept in a single
+ * vector sorted by key, so iteration visits them in the same order as OrderedAttributeMap. For the
+ * handful of attributes a span, log or metric point usually has, a binary search over contiguous
+ * memory beats a node-based map, and building the map takes one allocation instead of one per
+ * attribute. Short keys are stored inline by std::string.
+ *
+ * It provides the subset of the std::map interface the SDK and its exporters use. Keys must not be
+ * modified through the iterators, which would break the ordering.
+ */
+class FlatOrderedAttributeMap
+{
+public:
+  using key_type       = std::string;
+  using mapped_type    = OwnedAttributeValue;
+  using value_type     = std::pair<std::string, OwnedAttributeValue>;
+  using iterator       = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+  using size_type      = size_t;
+
+  // Contruct empty attribute map
+  FlatOrderedAttributeMap() = default;
+
+  // Contruct attribute map and populate with attributes
+  FlatOrderedAttributeMap(const opentelemetry::common::KeyValueIterable &attributes)
+  {
+    entries_.reserve(attributes.size());
+    attributes.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          SetAttribute(key, value);
+          return true;
+        });
+  }
+
+  // Construct map from initializer list by applying `SetAttribute` transform for every attribute
+  FlatOrderedAttributeMap(
+      std::initializer_list<std::pair<nostd::string_view, opentelemetry::common::AttributeValue>>
+          attributes)
+  {
+    entries_.reserve(attributes.size());
+    for (auto &kv : attributes)
+    {
+      SetAttribute(kv.first, kv.second);
+    }
+  }
+
+  // Returns a reference to this map
+  const FlatOrderedAttributeMap &GetAttributes() const noexcept { return *this; }
+
+  // Convert non-owning key-value to owning std::string(key) and OwnedAttributeValue(value)
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept
+  {
+    (*this)[key] = ConvertAttributeValue(value);
+  }
+
+  iterator begin() noexcept { return entries_.begin(); }
+  const_iterator begin() const noexcept { return entries_.begin(); }
+  iterator end() noexcept { return entries_.end(); }
+  const_iterator end() const noexcept { return entries_.end(); }
+
+  size_t size() const noexcept { return entries_.size(); }
+
+  bool empty() const noexcept { return entries_.empty(); }
+
+  void clear() noexcept { entries_.clear(); }
+
+  void reserve(size_t size) { entries_.reserve(size); }
+
+  iterator find(nostd::string_view key) noexcept
+  {
+    if (entries_.size() <= kLinearFindSize)
+    {
+      // Comparing the sizes first rejects most keys without touching their characters, and the
+      // scan has none of the unpredictable branches of a binary search.
+      for (auto it = entries_.begin(); it != entries_.end(); ++it)
+      {
+        if (KeyEquals(it->first, key))
+        {
+          return it;
+        }
+      }
+      return entries_.end();
+    }
+    auto it = LowerBound(key);
+    return it != entries_.end() && KeyEquals(it->first, key) ? it : entries_.end();
+  }
+
+  const_iterator find(nostd::string_view key) const noexcept
+  {
+    return const_cast<FlatOrderedAttributeMap *>(this)->find(key);
+  }
+
+  size_t count(nostd::string_view key) const noexcept { return find(key) == end() ? 0 : 1; }
+
+  // Returns the value for key. Like std::map::at, the key must be present.
+  const OwnedAttributeValue &at(nostd::string_view key) const
+  {
+    auto it = find(key);
+    if (it == end())
+    {
+      // Out of range: throws std::out_of_range like the other attribute maps.
+      return entries_.at(entries_.size()).second;
+    }
+    return it->second;
+  }
+
+  // Returns the value for key, inserting a default value if the key is not present.
+  OwnedAttributeValue &operator[](nostd::string_view key)
+  {
+    auto it = LowerBound(key);
+    if (it == entries_.end() || !KeyEquals(it->first, key))
+    {
+      it = entries_.emplace(it, std::string(key.data(), key.size()), OwnedAttributeValue());
+    }
+    return it->second;
+  }
+
+  // Inserts kv unless its key is present, like std::map::insert.
+  std::pair<iterator, bool> insert(const value_type &kv)
+  {
+    auto it = LowerBound(kv.first);
+    if (it != entries_.end() && KeyEquals(it->first, kv.first))
+    {
+      return {it, false};
+    }
+    return {entries_.insert(it, kv), true};
+  }
+
+  size_t erase(nostd::string_view key) noexcept
+  {
+    auto it = find(key);
+    if (it == entries_.end())
+    {
+      return 0;
+    }
+    entries_.erase(it);
+    return 1;
+  }
+
+  bool operator==(const FlatOrderedAttributeMap &other) const noexcept
+  {
+    return entries_ == other.entries_;
+  }
+
+  bool operator!=(const FlatOrderedAttributeMap &other) const noexcept
+  {
+    return !(*this == other);
   }
 
 private:
-  AttributeConverter converter_;
+  // Up to this many attributes, find() scans the map instead of searching it.
+  static constexpr size_t kLinearFindSize = 16;
+
+  static bool KeyEquals(const std::string &a, nostd::string_view b) noexcept
+  {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+  }
+
+  static bool KeyLess(const value_type &entry, nostd::string_view key) noexcept
+  {
+    size_t size = entry.first.size() < key.size() ? entry.first.size() : key.size();
+    int result  = std::memcmp(entry.first.data(), key.data(), size);
+    return result < 0 || (result == 0 && entry.first.size() < key.size());
+  }
+
+  iterator LowerBound(nostd::string_view key) noexcept
+  {
+    return std::lower_bound(entries_.begin(), entries_.end(), key, KeyLess);
+  }
+
+  std::vector<value_type> entries_;
 };
 
+/**
+ * The attribute maps of spans, logs and metric points. They are FlatOrderedAttributeMap when the
+ * SDK is built with ENABLE_FLAT_ATTRIBUTE_MAP (the WITH_FLAT_ATTRIBUTE_MAP CMake option), and the
+ * node-based maps otherwise.
+ */
+#ifdef ENABLE_FLAT_ATTRIBUTE_MAP
+using SpanAttributeMap   = FlatOrderedAttributeMap;
+using LogAttributeMap    = FlatOrderedAttributeMap;
+using MetricAttributeMap = FlatOrderedAttributeMap;
+#else
+using SpanAttributeMap   = AttributeMap;
+using LogAttributeMap    = AttributeMap;
+using MetricAttributeMap = OrderedAttributeMap;
+#endif
+
 }  // namespace common
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
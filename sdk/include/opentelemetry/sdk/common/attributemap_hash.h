@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include "opentelemetry/nostd/function_ref.h"
 #include "opentelemetry/sdk/common/attribute_utils.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -13,50 +16,314 @@ namespace sdk
 namespace common
 {
 
+// reference -
+// https://www.boost.org/doc/libs/1_37_0/doc/html/hash/reference.html#boost.hash_combine
+inline void CombineHash(size_t &seed, size_t value)
+{
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// Attributes are hashed 64 bits at a time, MurmurHash64A style: each word is folded into the
+// running hash with a multiply and a shift, and the hash of an attribute is finalized once with
+// the MurmurHash3 64-bit finalizer. This reads the raw bytes of strings a word at a time instead
+// of a byte at a time, and avoids a std::hash call and a combine step per value.
+constexpr uint64_t kAttributeHashMultiplier = 0xc6a4a7935bd1e995ULL;
+
+inline void HashWord(uint64_t &seed, uint64_t word)
+{
+  seed = (seed ^ word) * kAttributeHashMultiplier;
+  seed ^= seed >> 47;
+}
+
+// The last word holds the trailing bytes and the low byte of the size, so that consecutive
+// strings hash differently when split differently.
+inline void HashBytes(uint64_t &seed, const char *data, size_t size)
+{
+  uint64_t last = static_cast<uint64_t>(size & 0xff) << 56;
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    HashWord(seed, word);
+  }
+  for (size_t i = 0; i < size; i++)
+  {
+    last |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+  }
+  HashWord(seed, last);
+}
+
+inline uint64_t FinalizeHash(uint64_t seed)
+{
+  seed ^= seed >> 33;
+  seed *= 0xff51afd7ed558ccdULL;
+  seed ^= seed >> 33;
+  seed *= 0xc4ceb9fe1a85ec53ULL;
+  seed ^= seed >> 33;
+  return seed;
+}
+
+// Hashes the characters of a string. Owned strings and string views share this function so that
+// an attribute hashes the same whether it is owned or not.
+inline size_t GetHashForString(const char *data, size_t size)
+{
+  uint64_t seed = 0;
+  HashBytes(seed, data, size);
+  return static_cast<size_t>(FinalizeHash(seed));
+}
+
+// Booleans and integers.
 template <class T>
-inline void GetHashForAttributeValue(size_t &seed, const T arg)
+inline void GetHashForAttributeValue(uint64_t &seed, const T arg)
+{
+  HashWord(seed, static_cast<uint64_t>(arg));
+}
+
+inline void GetHashForAttributeValue(uint64_t &seed, double arg)
+{
+  // 0.0 and -0.0 compare equal, so they must hash alike.
+  if (arg == 0)
+  {
+    arg = 0;
+  }
+  uint64_t word;
+  std::memcpy(&word, &arg, sizeof(uint64_t));
+  HashWord(seed, word);
+}
+
+inline void GetHashForAttributeValue(uint64_t &seed, nostd::string_view arg)
+{
+  HashBytes(seed, arg.data(), arg.size());
+}
+
+inline void GetHashForAttributeValue(uint64_t &seed, const std::string &arg)
+{
+  HashBytes(seed, arg.data(), arg.size());
+}
+
+inline void GetHashForAttributeValue(uint64_t &seed, const char *arg)
+{
+  GetHashForAttributeValue(seed, nostd::string_view(arg));
+}
+
+template <class T>
+inline void GetHashForAttributeValue(uint64_t &seed, const std::vector<T> &arg)
+{
+  for (const auto &v : arg)
+  {
+    GetHashForAttributeValue(seed, v);
+  }
+}
+
+inline void GetHashForAttributeValue(uint64_t &seed, const std::vector<bool> &arg)
 {
-  std::hash<T> hasher;
-  // reference -
-  // https://www.boost.org/doc/libs/1_37_0/doc/html/hash/reference.html#boost.hash_combine
-  seed ^= hasher(arg) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  for (bool v : arg)
+  {
+    GetHashForAttributeValue(seed, v);
+  }
 }
 
 template <class T>
-inline void GetHashForAttributeValue(size_t &seed, const std::vector<T> &arg)
+inline void GetHashForAttributeValue(uint64_t &seed, nostd::span<const T> arg)
 {
-  for (auto v : arg)
+  for (const auto &v : arg)
   {
-    GetHashForAttributeValue<T>(seed, v);
+    GetHashForAttributeValue(seed, v);
   }
 }
 
 struct GetHashForAttributeValueVisitor
 {
-  GetHashForAttributeValueVisitor(size_t &seed) : seed_(seed) {}
+  GetHashForAttributeValueVisitor(uint64_t &seed) : seed_(seed) {}
   template <class T>
   void operator()(T &v)
   {
     GetHashForAttributeValue(seed_, v);
   }
-  size_t &seed_;
+  uint64_t &seed_;
 };
 
-// Calculate hash of keys and values of attribute map
-inline size_t GetHashForAttributeMap(const OrderedAttributeMap &attribute_map)
+// Hash of one attribute. Both the owned (OwnedAttributeValue) and the non-owning (AttributeValue)
+// representation of a value give the same hash.
+template <class Value>
+inline size_t GetHashForAttribute(nostd::string_view key, const Value &value)
+{
+  uint64_t seed = 0;
+  GetHashForAttributeValue(seed, key);
+  nostd::visit(GetHashForAttributeValueVisitor(seed), value);
+  return static_cast<size_t>(FinalizeHash(seed));
+}
+
+// Calculate hash of keys and values of attribute map (OrderedAttributeMap or
+// FlatOrderedAttributeMap). The attribute hashes are summed, so the result does not depend on the
+// order in which the attributes are visited. This lets GetHashForAttributeMap(KeyValueIterable)
+// below match it without sorting, and both map types hash alike.
+template <class Map>
+inline size_t GetHashForAttributeMap(const Map &attribute_map)
 {
   size_t seed = 0UL;
   for (auto &kv : attribute_map)
   {
-    std::hash<std::string> hasher;
-    // reference -
-    // https://www.boost.org/doc/libs/1_37_0/doc/html/hash/reference.html#boost.hash_combine
-    seed ^= hasher(kv.first) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    nostd::visit(GetHashForAttributeValueVisitor(seed), kv.second);
+    seed += GetHashForAttribute(kv.first, kv.second);
   }
   return seed;
 }
 
+/**
+ * Calculate the hash of the attribute map that OrderedAttributeMap(attributes) would build after
+ * dropping the keys rejected by `is_key_present_callback`, without building it.
+ *
+ * If `attributes` yields the same key more than once the result differs from the hash of the
+ * map, which keeps only one value per key; callers must tolerate such a miss.
+ */
+inline size_t GetHashForAttributeMap(
+    const opentelemetry::common::KeyValueIterable &attributes,
+    nostd::function_ref<bool(nostd::string_view)> is_key_present_callback)
+{
+  size_t seed = 0UL;
+  attributes.ForEachKeyValue(
+      [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+        if (is_key_present_callback(key))
+        {
+          seed += GetHashForAttribute(key, value);
+        }
+        return true;
+      });
+  return seed;
+}
+
+/**
+ * Compares a non-owning AttributeValue with the OwnedAttributeValue AttributeConverter would
+ * create from it.
+ */
+class AttributeValueEqualityVisitor
+{
+public:
+  AttributeValueEqualityVisitor(const OwnedAttributeValue &owned) : owned_(owned) {}
+
+  template <class T>
+  bool operator()(T v) const
+  {
+    return nostd::holds_alternative<T>(owned_) && nostd::get<T>(owned_) == v;
+  }
+
+  bool operator()(nostd::string_view v) const
+  {
+    if (!nostd::holds_alternative<std::string>(owned_))
+    {
+      return false;
+    }
+    const std::string &s = nostd::get<std::string>(owned_);
+    return s.size() == v.size() && s.compare(0, s.size(), v.data(), v.size()) == 0;
+  }
+
+  bool operator()(const char *v) const { return (*this)(nostd::string_view(v)); }
+
+  template <class T>
+  bool operator()(nostd::span<const T> v) const
+  {
+    return CompareSpan<T>(v);
+  }
+
+  bool operator()(nostd::span<const nostd::string_view> v) const
+  {
+    if (!nostd::holds_alternative<std::vector<std::string>>(owned_))
+    {
+      return false;
+    }
+    const std::vector<std::string> &owned = nostd::get<std::vector<std::string>>(owned_);
+    if (owned.size() != v.size())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < owned.size(); i++)
+    {
+      if (owned[i].size() != v[i].size() ||
+          owned[i].compare(0, owned[i].size(), v[i].data(), v[i].size()) != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  template <class T>
+  bool CompareSpan(nostd::span<const T> v) const
+  {
+    if (!nostd::holds_alternative<std::vector<T>>(owned_))
+    {
+      return false;
+    }
+    const std::vector<T> &owned = nostd::get<std::vector<T>>(owned_);
+    if (owned.size() != v.size())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < owned.size(); i++)
+    {
+      if (owned[i] != v[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const OwnedAttributeValue &owned_;
+};
+
+/**
+ * @return true if Map(attributes), restricted to the keys accepted by `is_key_present_callback`,
+ * would be equal to `attribute_map`, without building it. Map is OrderedAttributeMap or
+ * FlatOrderedAttributeMap.
+ *
+ * The comparison is conservative: inputs that yield the same key more than once, and maps with
+ * more than 64 attributes, always compare unequal, so callers must be prepared to fall back to
+ * building the map.
+ */
+template <class Map>
+inline bool AttributeMapEquals(
+    const Map &attribute_map,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    nostd::function_ref<bool(nostd::string_view)> is_key_present_callback)
+{
+  if (attribute_map.size() > 64)
+  {
+    return false;
+  }
+  // One bit per entry of attribute_map, set once an attribute matched it.
+  uint64_t matched = 0;
+  size_t count     = 0;
+  bool equal       = attributes.ForEachKeyValue(
+      [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+        if (!is_key_present_callback(key))
+        {
+          return true;
+        }
+        ++count;
+        // Attribute sets are small, so a linear scan is cheaper than materializing a std::string
+        // key for map::find.
+        uint64_t bit = 1;
+        for (auto &kv : attribute_map)
+        {
+          if (kv.first.size() == key.size() &&
+              kv.first.compare(0, kv.first.size(), key.data(), key.size()) == 0)
+          {
+            if ((matched & bit) != 0)
+            {
+              return false;
+            }
+            matched |= bit;
+            return nostd::visit(AttributeValueEqualityVisitor(kv.second), value);
+          }
+          bit <<= 1;
+        }
+        return false;
+      });
+  return equal && count == attribute_map.size();
+}
+
 }  // namespace common
 }  // namespace sdk
-OPENTELEMETRY_END_NAMESPACE
\ No newline at end of file
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,74 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * How far behind a batch processor is, published by the processor and read by whoever wants to
+ * produce less for it, e.g. the BackpressureSampler, before paying for the data it would drop.
+ *
+ * The level is the larger of two ratios, each in [0, 1]:
+ * - the occupancy of the queue, 1 once data is dropped because the queue is full;
+ * - the export lag, the share of the export cycle the worker spends exporting, 1 once it cannot
+ *   export a batch within the schedule delay.
+ *
+ * Reads and writes are relaxed atomic operations: the level is a hint, not a synchronization.
+ */
+class BackpressureSignal
+{
+public:
+  /** Returns the backpressure level, 0 when idle, 1 when the processor drops data. */
+  double GetLevel() const noexcept
+  {
+    return (std::max)(queue_occupancy_.load(std::memory_order_relaxed),
+                      export_lag_.load(std::memory_order_relaxed));
+  }
+
+  double GetQueueOccupancy() const noexcept
+  {
+    return queue_occupancy_.load(std::memory_order_relaxed);
+  }
+
+  double GetExportLag() const noexcept { return export_lag_.load(std::memory_order_relaxed); }
+
+  void SetQueueOccupancy(double occupancy) noexcept
+  {
+    queue_occupancy_.store(Clamp(occupancy), std::memory_order_relaxed);
+  }
+
+  void SetExportLag(double lag) noexcept
+  {
+    export_lag_.store(Clamp(lag), std::memory_order_relaxed);
+  }
+
+  /**
+   * Marks the queue full, e.g. when data is dropped, without writing the shared value again
+   * while it already is.
+   */
+  void SetQueueFull() noexcept
+  {
+    if (queue_occupancy_.load(std::memory_order_relaxed) < 1.0)
+    {
+      queue_occupancy_.store(1.0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static double Clamp(double ratio) noexcept { return (std::min)((std::max)(ratio, 0.0), 1.0); }
+
+  std::atomic<double> queue_occupancy_{0.0};
+  std::atomic<double> export_lag_{0.0};
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,147 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "opentelemetry/sdk/common/exporter_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A snapshot of the counters of a batch processor (BatchSpanProcessor, BatchLogProcessor).
+ *
+ * The counters are read one by one with relaxed loads while the processor keeps running, so a
+ * snapshot is not necessarily consistent across fields (e.g. exported + dropped + queue_size may
+ * briefly differ from enqueued).
+ */
+struct BatchProcessorStats
+{
+  /* Number of export duration buckets; see ExportDurationBucketBound. */
+  static constexpr size_t kExportDurationBucketCount = 13;
+
+  /**
+   * @return the inclusive upper bound of the export duration bucket at `index`. The last bucket
+   * has no upper bound and returns std::chrono::milliseconds::max().
+   */
+  static std::chrono::milliseconds ExportDurationBucketBound(size_t index) noexcept
+  {
+    static const std::chrono::milliseconds::rep kBounds[kExportDurationBucketCount - 1] = {
+        1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+    return index < kExportDurationBucketCount - 1 ? std::chrono::milliseconds(kBounds[index])
+                                                  : std::chrono::milliseconds::max();
+  }
+
+  /* Items accepted into the queue */
+  uint64_t enqueued = 0;
+  /* Items rejected because the queue was full */
+  uint64_t dropped = 0;
+  /* Items passed to the exporter */
+  uint64_t exported = 0;
+  /* Items passed to the exporter in batches that reported a failure */
+  uint64_t export_failed = 0;
+
+  /* Number of batches passed to the exporter */
+  uint64_t export_count = 0;
+  /* Size of the largest batch passed to the exporter */
+  uint64_t max_batch_size = 0;
+  /* Total time spent in the exporter across all batches */
+  std::chrono::microseconds total_export_duration{0};
+  /* Number of exports per duration bucket */
+  std::array<uint64_t, kExportDurationBucketCount> export_duration_counts{};
+
+  /* Items currently waiting in the queue */
+  uint64_t queue_size = 0;
+  /* Capacity of the queue */
+  uint64_t max_queue_size = 0;
+};
+
+/**
+ * The counters behind BatchProcessorStats. All updates are relaxed atomics. The number of enqueued
+ * items and the queue occupancy are not tracked here: processors derive them from their queue,
+ * which keeps the successful enqueue path free of extra shared writes.
+ */
+class BatchProcessorStatsRecorder
+{
+public:
+  void RecordDropped() noexcept { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+  /**
+   * Records one batch handed to the exporter.
+   * @param batch_size the number of items in the batch
+   * @param duration the time the exporter took to complete the batch
+   * @param result the result reported by the exporter
+   */
+  void RecordExport(size_t batch_size,
+                    std::chrono::steady_clock::duration duration,
+                    ExportResult result) noexcept
+  {
+    exported_.fetch_add(batch_size, std::memory_order_relaxed);
+    if (result != ExportResult::kSuccess)
+    {
+      export_failed_.fetch_add(batch_size, std::memory_order_relaxed);
+    }
+    export_count_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max_batch_size = max_batch_size_.load(std::memory_order_relaxed);
+    while (batch_size > max_batch_size &&
+           !max_batch_size_.compare_exchange_weak(max_batch_size, batch_size,
+                                                  std::memory_order_relaxed))
+    {
+    }
+
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    total_export_duration_us_.fetch_add(static_cast<uint64_t>(micros.count()),
+                                        std::memory_order_relaxed);
+
+    size_t bucket = 0;
+    while (bucket < BatchProcessorStats::kExportDurationBucketCount - 1 &&
+           micros > BatchProcessorStats::ExportDurationBucketBound(bucket))
+    {
+      ++bucket;
+    }
+    export_duration_counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return a snapshot of the recorded counters. `enqueued`, `queue_size` and `max_queue_size`
+   * are left for the caller to fill in.
+   */
+  BatchProcessorStats GetStats() const noexcept
+  {
+    BatchProcessorStats stats;
+    stats.dropped        = dropped_.load(std::memory_order_relaxed);
+    stats.exported       = exported_.load(std::memory_order_relaxed);
+    stats.export_failed  = export_failed_.load(std::memory_order_relaxed);
+    stats.export_count   = export_count_.load(std::memory_order_relaxed);
+    stats.max_batch_size = max_batch_size_.load(std::memory_order_relaxed);
+    stats.total_export_duration =
+        std::chrono::microseconds(total_export_duration_us_.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < BatchProcessorStats::kExportDurationBucketCount; ++i)
+    {
+      stats.export_duration_counts[i] = export_duration_counts_[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+private:
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> exported_{0};
+  std::atomic<uint64_t> export_failed_{0};
+  std::atomic<uint64_t> export_count_{0};
+  std::atomic<uint64_t> max_batch_size_{0};
+  std::atomic<uint64_t> total_export_duration_us_{0};
+  std::array<std::atomic<uint64_t>, BatchProcessorStats::kExportDurationBucketCount>
+      export_duration_counts_{};
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
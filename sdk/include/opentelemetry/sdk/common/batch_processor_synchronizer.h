@@ -0,0 +1,249 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Coordinates the producer threads, the ForceFlush callers and the single background worker of a
+ * batch processor (BatchSpanProcessor, BatchLogProcessor). The worker is a thread of its own
+ * sleeping in WaitForWork(), or a task of an ExportExecutor calling TakeWork() when it runs.
+ *
+ * Force flushes are tracked with two generation counters: every ForceFlush call takes a new
+ * "requested" generation and blocks until the worker reports a "completed" generation at least as
+ * large, or until its timeout expires. Neither side spins; both block on condition variables.
+ */
+class BatchProcessorSynchronizer
+{
+public:
+  /**
+   * Wakes up the worker before its scheduled delay expires, e.g. because the queue is filling up.
+   * Safe to call from any thread. Only the first call after the worker last woke up takes the
+   * lock and notifies; later calls are a single atomic exchange.
+   */
+  void WakeUp() noexcept
+  {
+    if (!is_wakeup_pending_.exchange(true, std::memory_order_acq_rel))
+    {
+      // Taking the lock orders this wake up with the worker's predicate check, so the
+      // notification cannot be lost while the worker is about to go to sleep.
+      {
+        std::lock_guard<std::mutex> guard(m_);
+        NotifyWorkerTask();
+      }
+      worker_cv_.notify_one();
+    }
+  }
+
+  /**
+   * Asks the worker to export everything queued so far and waits for it to finish.
+   * @param timeout the maximum time to wait for the worker.
+   * @return true if the flush completed within the timeout; false if it timed out or the worker
+   * has already stopped.
+   */
+  bool ForceFlush(std::chrono::microseconds timeout) noexcept
+  {
+    std::unique_lock<std::mutex> lk(m_);
+    if (is_stopped_)
+    {
+      return false;
+    }
+    uint64_t generation = ++flush_requested_generation_;
+    NotifyWorkerTask();
+    worker_cv_.notify_one();
+    return WaitFor(flush_cv_, lk, timeout,
+                   [this, generation] { return flush_completed_generation_ >= generation; });
+  }
+
+  /**
+   * Asks the worker to stop. The worker is expected to drain its queue and call Stop().
+   */
+  void RequestShutdown() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_);
+      is_shutdown_requested_ = true;
+      NotifyWorkerTask();
+    }
+    worker_cv_.notify_one();
+  }
+
+  /**
+   * Asks the worker to return without draining its queue, so that it can be joined before a fork.
+   * The request holds until ParentAfterFork or ChildAfterFork.
+   */
+  void RequestPause() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_);
+      is_pause_requested_.store(true, std::memory_order_release);
+    }
+    worker_cv_.notify_one();
+  }
+
+  /**
+   * @return true if the worker must return, leaving its queue to the worker started after a fork.
+   */
+  bool IsPauseRequested() const noexcept
+  {
+    return is_pause_requested_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Called before a fork, once the worker has been joined. Holds the lock until after the fork, so
+   * that the child does not inherit it locked by a thread which was not duplicated.
+   */
+  void PrepareFork() noexcept { m_.lock(); }
+
+  /**
+   * Called in the parent after a fork, before starting a new worker.
+   */
+  void ParentAfterFork() noexcept
+  {
+    is_pause_requested_.store(false, std::memory_order_relaxed);
+    m_.unlock();
+  }
+
+  /**
+   * Called in the child after a fork, before starting a new worker. The threads waiting for force
+   * flushes were not duplicated, so their flushes are considered complete.
+   */
+  void ChildAfterFork() noexcept
+  {
+    is_pause_requested_.store(false, std::memory_order_relaxed);
+    is_wakeup_pending_.store(false, std::memory_order_relaxed);
+    flush_completed_generation_ = flush_requested_generation_;
+    m_.unlock();
+  }
+
+  /**
+   * Called by the worker to sleep until a wake up, a force flush, a shutdown or pause request, or
+   * the timeout, whichever comes first.
+   * @return the force flush generation the worker must complete after its next export, or 0 if no
+   * force flush is pending.
+   */
+  uint64_t WaitForWork(std::chrono::microseconds timeout) noexcept
+  {
+    std::unique_lock<std::mutex> lk(m_);
+    WaitFor(worker_cv_, lk, timeout, [this] {
+      return is_shutdown_requested_ || flush_requested_generation_ > flush_completed_generation_ ||
+             is_wakeup_pending_.load(std::memory_order_acquire) ||
+             is_pause_requested_.load(std::memory_order_relaxed);
+    });
+    is_wakeup_pending_.store(false, std::memory_order_release);
+    return flush_requested_generation_ > flush_completed_generation_ ? flush_requested_generation_
+                                                                      : 0;
+  }
+
+  /**
+   * Sets the function run, with the lock held, to wake up a worker running as a task of an
+   * ExportExecutor. It is run right away if the worker has work pending.
+   */
+  void SetWorkerTask(std::function<void()> wake_up) noexcept
+  {
+    std::lock_guard<std::mutex> guard(m_);
+    wake_up_task_ = std::move(wake_up);
+    if (is_shutdown_requested_ || flush_requested_generation_ > flush_completed_generation_ ||
+        is_wakeup_pending_.load(std::memory_order_acquire))
+    {
+      NotifyWorkerTask();
+    }
+  }
+
+  /**
+   * Called by a worker running as a task, the counterpart of WaitForWork() without waiting.
+   * @return the force flush generation the worker must complete after its next export, or 0 if no
+   * force flush is pending.
+   */
+  uint64_t TakeWork() noexcept { return WaitForWork(std::chrono::microseconds::zero()); }
+
+  /**
+   * Called by the worker once everything queued before the force flush `generation` was requested
+   * has been exported. Releases all ForceFlush callers waiting on that generation or older ones.
+   */
+  void NotifyFlushCompleted(uint64_t generation) noexcept
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_);
+      if (generation > flush_completed_generation_)
+      {
+        flush_completed_generation_ = generation;
+      }
+    }
+    flush_cv_.notify_all();
+  }
+
+  /**
+   * Called by the worker right before it exits, after draining its queue. Completes every pending
+   * force flush; later ForceFlush calls return false immediately.
+   */
+  void Stop() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_);
+      is_stopped_                 = true;
+      flush_completed_generation_ = flush_requested_generation_;
+    }
+    flush_cv_.notify_all();
+  }
+
+private:
+  /**
+   * Waits on `cv` until `pred` holds or `timeout` expires. Timeouts too long to be represented
+   * as a steady_clock deadline, such as std::chrono::microseconds::max(), wait without a deadline.
+   */
+  template <class Predicate>
+  static bool WaitFor(std::condition_variable &cv,
+                      std::unique_lock<std::mutex> &lk,
+                      std::chrono::microseconds timeout,
+                      Predicate pred)
+  {
+    if (timeout <= std::chrono::microseconds::zero())
+    {
+      return pred();
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (timeout >= std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::time_point::max() - now))
+    {
+      cv.wait(lk, pred);
+      return true;
+    }
+    return cv.wait_until(lk, now + timeout, pred);
+  }
+
+  /* Wakes up the worker task, if any. m_ must be held. */
+  void NotifyWorkerTask() noexcept
+  {
+    if (wake_up_task_)
+    {
+      wake_up_task_();
+    }
+  }
+
+  std::mutex m_;
+  std::condition_variable worker_cv_, flush_cv_;
+  std::function<void()> wake_up_task_;
+  std::atomic<bool> is_wakeup_pending_{false};
+  std::atomic<bool> is_pause_requested_{false};
+  uint64_t flush_requested_generation_ = 0;
+  uint64_t flush_completed_generation_ = 0;
+  bool is_shutdown_requested_          = false;
+  bool is_stopped_                     = false;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,280 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/nostd/function_ref.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/nostd/variant.h"
+#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A compact binary encoding of telemetry, for files read back by the same build such as span
+ * captures and record journals: integers in the byte order of the host, strings and arrays as a
+ * uint32_t count followed by their elements, booleans as one byte. Attributes are a uint32_t count
+ * of keys, each followed by the uint8_t OwnedAttributeType of its value and the value.
+ */
+template <class T>
+inline void AppendBinary(std::string &out, T value)
+{
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+inline void AppendBinaryString(std::string &out, nostd::string_view value)
+{
+  AppendBinary(out, static_cast<uint32_t>(value.size()));
+  out.append(value.data(), value.size());
+}
+
+inline void AppendBinaryBytes(std::string &out, const uint8_t *bytes, size_t size)
+{
+  out.append(reinterpret_cast<const char *>(bytes), size);
+}
+
+/* Appends the value of an attribute, after its type. */
+struct BinaryAttributeValueEncoder
+{
+  std::string &out;
+
+  void operator()(bool value) { AppendBinary(out, static_cast<uint8_t>(value ? 1 : 0)); }
+
+  template <class T>
+  void operator()(const T &value)
+  {
+    AppendBinary(out, value);
+  }
+
+  void operator()(const std::string &value) { AppendBinaryString(out, value); }
+
+  template <class T>
+  void operator()(const std::vector<T> &values)
+  {
+    AppendBinary(out, static_cast<uint32_t>(values.size()));
+    for (const T &value : values)
+    {
+      AppendBinary(out, value);
+    }
+  }
+
+  void operator()(const std::vector<bool> &values)
+  {
+    AppendBinary(out, static_cast<uint32_t>(values.size()));
+    for (bool value : values)
+    {
+      AppendBinary(out, static_cast<uint8_t>(value ? 1 : 0));
+    }
+  }
+
+  void operator()(const std::vector<std::string> &values)
+  {
+    AppendBinary(out, static_cast<uint32_t>(values.size()));
+    for (const std::string &value : values)
+    {
+      AppendBinaryString(out, value);
+    }
+  }
+};
+
+/* Appends a map of keys to OwnedAttributeValue. */
+template <class Map>
+inline void AppendBinaryAttributes(std::string &out, const Map &attributes)
+{
+  AppendBinary(out, static_cast<uint32_t>(attributes.size()));
+  for (const auto &attribute : attributes)
+  {
+    AppendBinaryString(out, attribute.first);
+    AppendBinary(out, static_cast<uint8_t>(attribute.second.index()));
+    nostd::visit(BinaryAttributeValueEncoder{out}, attribute.second);
+  }
+}
+
+/* Reads the binary encoding, failing on any field past the end of the data. */
+class BinaryDecoder
+{
+public:
+  BinaryDecoder(const char *data, size_t size) : pos_(data), end_(data + size) {}
+
+  size_t remaining() const noexcept { return static_cast<size_t>(end_ - pos_); }
+
+  template <class T>
+  bool GetValue(T &value) noexcept
+  {
+    if (remaining() < sizeof(value))
+    {
+      return false;
+    }
+    std::memcpy(&value, pos_, sizeof(value));
+    pos_ += sizeof(value);
+    return true;
+  }
+
+  bool GetString(std::string &value)
+  {
+    uint32_t size = 0;
+    if (!GetValue(size) || remaining() < size)
+    {
+      return false;
+    }
+    value.assign(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool GetBytes(uint8_t *bytes, size_t size) noexcept
+  {
+    if (remaining() < size)
+    {
+      return false;
+    }
+    std::memcpy(bytes, pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool GetAttributeValue(OwnedAttributeValue &value)
+  {
+    uint8_t type = 0;
+    if (!GetValue(type))
+    {
+      return false;
+    }
+    switch (type)
+    {
+      case kTypeBool: {
+        uint8_t scalar = 0;
+        bool ok        = GetValue(scalar);
+        value          = scalar != 0;
+        return ok;
+      }
+      case kTypeInt:
+        return GetScalar<int32_t>(value);
+      case kTypeUInt:
+        return GetScalar<uint32_t>(value);
+      case kTypeInt64:
+        return GetScalar<int64_t>(value);
+      case kTypeDouble:
+        return GetScalar<double>(value);
+      case kTypeString: {
+        std::string string;
+        bool ok = GetString(string);
+        value   = std::move(string);
+        return ok;
+      }
+      case kTypeSpanBool: {
+        uint32_t count = 0;
+        if (!GetValue(count) || remaining() < count)
+        {
+          return false;
+        }
+        std::vector<bool> values(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          values[i] = pos_[i] != 0;
+        }
+        pos_ += count;
+        value = std::move(values);
+        return true;
+      }
+      case kTypeSpanInt:
+        return GetVector<int32_t>(value);
+      case kTypeSpanUInt:
+        return GetVector<uint32_t>(value);
+      case kTypeSpanInt64:
+        return GetVector<int64_t>(value);
+      case kTypeSpanDouble:
+        return GetVector<double>(value);
+      case kTypeSpanString: {
+        uint32_t count = 0;
+        if (!GetValue(count) || remaining() / sizeof(uint32_t) < count)
+        {
+          return false;
+        }
+        std::vector<std::string> values(count);
+        for (auto &string : values)
+        {
+          if (!GetString(string))
+          {
+            return false;
+          }
+        }
+        value = std::move(values);
+        return true;
+      }
+      case kTypeUInt64:
+        return GetScalar<uint64_t>(value);
+      case kTypeSpanUInt64:
+        return GetVector<uint64_t>(value);
+      case kTypeSpanByte:
+        return GetVector<uint8_t>(value);
+      default:
+        return false;
+    }
+  }
+
+  /* Reads attributes, calling `add` with each key and value. */
+  bool GetAttributes(nostd::function_ref<void(std::string &&, OwnedAttributeValue &&)> add)
+  {
+    uint32_t count = 0;
+    if (!GetValue(count))
+    {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      std::string key;
+      OwnedAttributeValue value;
+      if (!GetString(key) || !GetAttributeValue(value))
+      {
+        return false;
+      }
+      add(std::move(key), std::move(value));
+    }
+    return true;
+  }
+
+private:
+  template <class T>
+  bool GetScalar(OwnedAttributeValue &value) noexcept
+  {
+    T scalar{};
+    bool ok = GetValue(scalar);
+    value   = scalar;
+    return ok;
+  }
+
+  template <class T>
+  bool GetVector(OwnedAttributeValue &value)
+  {
+    uint32_t count = 0;
+    if (!GetValue(count) || remaining() / sizeof(T) < count)
+    {
+      return false;
+    }
+    std::vector<T> values(count);
+    if (count > 0)
+    {
+      std::memcpy(values.data(), pos_, count * sizeof(T));
+    }
+    pos_ += count * sizeof(T);
+    value = std::move(values);
+    return true;
+  }
+
+  const char *pos_;
+  const char *end_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
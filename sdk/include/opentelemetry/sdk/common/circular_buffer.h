@@ -6,6 +6,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "opentelemetry/sdk/common/atomic_unique_ptr.h"
 #include "opentelemetry/sdk/common/circular_buffer_range.h"
@@ -74,6 +75,32 @@ class CircularBuffer
     });
   }
 
+  /**
+   * Moves up to n elements from the circular buffer's tail to the end of out, in order. Unlike
+   * Consume, the elements are taken from their slots without an atomic exchange each: the slots
+   * are handed back to the producers all at once, by a single release of the tail.
+   * @param n the maximum number of elements to move
+   * @param out the vector receiving the elements, which the caller may reuse across calls
+   * @return the number of elements moved
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  size_t ConsumeInto(size_t n, std::vector<std::unique_ptr<T>> &out) noexcept
+  {
+    size_t available = size();
+    if (n > available)
+    {
+      n = available;
+    }
+    out.reserve(out.size() + n);
+    PeekImpl().Take(n).ForEach([&out](AtomicUniquePtr<T> &ptr) noexcept {
+      out.emplace_back(ptr.ReleaseRelaxed());
+      return true;
+    });
+    tail_.fetch_add(n, std::memory_order_release);
+    return n;
+  }
+
   /**
    * Adds an element into the circular buffer.
    * @param ptr a pointer to the element to add
@@ -115,6 +142,59 @@ class CircularBuffer
     return true;
   }
 
+  /**
+   * Adds the first elements of a vector, as many as fit, with a single update of the head: the
+   * slots are claimed one by one, then published to the consumer all at once, so that producers
+   * adding batches contend on the head once per batch rather than once per element.
+   * @param elements the elements to add; the first ones, which were added, are left null
+   * @return the number of elements added
+   */
+  size_t AddBatch(std::vector<std::unique_ptr<T>> &elements) noexcept
+  {
+    while (true)
+    {
+      uint64_t tail = tail_;
+      uint64_t head = head_;
+
+      if (head - tail >= capacity_ - 1)
+      {
+        return 0;
+      }
+      size_t n = static_cast<size_t>(capacity_ - 1 - (head - tail));
+      if (n > elements.size())
+      {
+        n = elements.size();
+      }
+      if (n == 0)
+      {
+        return 0;
+      }
+
+      size_t claimed = 0;
+      while (claimed < n && data_[(head + claimed) % capacity_].SwapIfNull(elements[claimed]))
+      {
+        ++claimed;
+      }
+      if (claimed == n)
+      {
+        auto expected_head = head;
+        if (head_.compare_exchange_weak(expected_head, head + n, std::memory_order_release,
+                                        std::memory_order_relaxed))
+        {
+          return n;
+        }
+      }
+
+      // Another producer took one of the slots or moved the head, so we undo the swaps and
+      // attempt to add again.
+      while (claimed > 0)
+      {
+        --claimed;
+        data_[(head + claimed) % capacity_].Swap(elements[claimed]);
+      }
+    }
+  }
+
   /**
    * Clear the circular buffer.
    *
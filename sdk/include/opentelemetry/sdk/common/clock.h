@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/common/timestamp.h"
+#include "opentelemetry/version.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#  include <time.h>
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+
+/** Clock provides the current time for the timestamps of the telemetry recorded by the SDK. */
+class Clock
+{
+public:
+  virtual ~Clock() = default;
+
+  /** Returns the current wall-clock time. */
+  virtual opentelemetry::common::SystemTimestamp SystemNow() noexcept = 0;
+
+  /** Returns the current time of a monotonic clock, to measure durations. */
+  virtual opentelemetry::common::SteadyTimestamp SteadyNow() noexcept = 0;
+};
+
+/** The std::chrono system and steady clocks. This is the default clock. */
+class PreciseClock final : public Clock
+{
+public:
+  opentelemetry::common::SystemTimestamp SystemNow() noexcept override
+  {
+    return opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  }
+
+  opentelemetry::common::SteadyTimestamp SteadyNow() noexcept override
+  {
+    return opentelemetry::common::SteadyTimestamp(std::chrono::steady_clock::now());
+  }
+};
+
+/**
+ * The clocks the kernel caches at every tick, which are read without querying the time source.
+ * Reads are cheaper than those of PreciseClock, most of all where the time source is slow to
+ * query (e.g. some virtual machines), but only advance once per tick, i.e. every 1 to 10 ms.
+ *
+ * On Linux, these are CLOCK_REALTIME_COARSE and CLOCK_MONOTONIC_COARSE. Elsewhere, this is the
+ * same as PreciseClock.
+ */
+class CoarseClock final : public Clock
+{
+public:
+  opentelemetry::common::SystemTimestamp SystemNow() noexcept override
+  {
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0)
+    {
+      return opentelemetry::common::SystemTimestamp(ToNanoseconds(ts));
+    }
+#endif
+    return opentelemetry::common::SystemTimestamp(std::chrono::system_clock::now());
+  }
+
+  opentelemetry::common::SteadyTimestamp SteadyNow() noexcept override
+  {
+#if defined(__linux__) && defined(CLOCK_MONOTONIC_COARSE)
+    // std::chrono::steady_clock is CLOCK_MONOTONIC on Linux, so the coarse clock shares its epoch.
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+    {
+      return opentelemetry::common::SteadyTimestamp(ToNanoseconds(ts));
+    }
+#endif
+    return opentelemetry::common::SteadyTimestamp(std::chrono::steady_clock::now());
+  }
+
+private:
+#ifdef __linux__
+  static std::chrono::nanoseconds ToNanoseconds(const struct timespec &ts) noexcept
+  {
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+  }
+#endif
+};
+
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,52 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Splits a batch of recordables into consecutive batches whose estimated sizes, as returned by
+ * GetEstimatedSize(), add up to at most `max_batch_bytes`, and passes each to `export_batch`, in
+ * order. A recordable larger than `max_batch_bytes` is passed alone, and recordables of unknown
+ * size count for 0. With `max_batch_bytes` 0 the batch is passed whole, even when empty.
+ */
+template <class T, class ExportBatch>
+void ForEachExportBatch(std::vector<std::unique_ptr<T>> &recordables,
+                        size_t max_batch_bytes,
+                        ExportBatch &&export_batch)
+{
+  std::unique_ptr<T> *data = recordables.data();
+  if (max_batch_bytes == 0 || recordables.size() <= 1)
+  {
+    export_batch(nostd::span<std::unique_ptr<T>>(data, recordables.size()));
+    return;
+  }
+
+  size_t begin = 0;
+  size_t bytes = 0;
+  for (size_t i = 0; i < recordables.size(); ++i)
+  {
+    size_t size = recordables[i] != nullptr ? recordables[i]->GetEstimatedSize() : 0;
+    if (i > begin && bytes + size > max_batch_bytes)
+    {
+      export_batch(nostd::span<std::unique_ptr<T>>(data + begin, i - begin));
+      begin = i;
+      bytes = 0;
+    }
+    bytes += size;
+  }
+  export_batch(nostd::span<std::unique_ptr<T>>(data + begin, recordables.size() - begin));
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,138 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "opentelemetry/sdk/common/fork_handler.h"
+#include "opentelemetry/sdk/common/thread_options.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A bounded pool of threads running the periodic work of several batch processors and metric
+ * readers, instead of a thread of their own each.
+ *
+ * A task is a function returning the delay until its next run, kWhenWokenUp to only run again
+ * once woken up. The executor runs each task on one of its threads when its delay expires or when
+ * WakeUp() is called, whichever comes first, and never runs a task on two threads at the same
+ * time: a task woken up while it runs is run again right after. Each task keeps its own
+ * scheduling and backpressure: one blocking in an export occupies a thread until it returns, so
+ * the pool should have as many threads as exports expected to block at the same time.
+ *
+ * The threads are started with the first task. They are stopped before the process forks, once
+ * the running tasks return, and started again afterwards, see ForkHandlerRegistration. An
+ * executor must outlive its tasks, and must not be destroyed by one of them.
+ */
+class ExportExecutor
+{
+public:
+  /* Returned by a task to only run again once woken up. */
+  static constexpr std::chrono::microseconds kWhenWokenUp = std::chrono::microseconds::max();
+
+  using TaskFunction = std::function<std::chrono::microseconds()>;
+
+  class Task;
+
+  /**
+   * @param num_threads the number of threads of the pool, at least 1.
+   * @param thread_options the name, CPU affinity and niceness of the threads, named
+   * "otel-executor" by default.
+   */
+  explicit ExportExecutor(size_t num_threads                  = 1,
+                          const ThreadOptions &thread_options = ThreadOptions());
+
+  ExportExecutor(const ExportExecutor &)            = delete;
+  ExportExecutor &operator=(const ExportExecutor &) = delete;
+
+  ~ExportExecutor();
+
+  /**
+   * Adds a task, first run after `delay`, or kWhenWokenUp.
+   */
+  std::shared_ptr<Task> AddTask(TaskFunction function, std::chrono::microseconds delay);
+
+  /**
+   * Runs the task as soon as a thread is available, or again right after its current run. Does
+   * nothing on a suspended task. Safe to call from any thread, including from a task.
+   */
+  void WakeUp(const std::shared_ptr<Task> &task) noexcept;
+
+  /**
+   * Stops running the task, until ResumeTask(). Waits for its current run to return, unless called
+   * by the task itself. A task no longer needed is suspended before its handle is released.
+   */
+  void SuspendTask(const std::shared_ptr<Task> &task) noexcept;
+
+  /**
+   * Runs a suspended task again, first after `delay`.
+   */
+  void ResumeTask(const std::shared_ptr<Task> &task, std::chrono::microseconds delay) noexcept;
+
+  size_t GetThreadCount() const noexcept { return num_threads_; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Timer
+  {
+    Clock::time_point deadline;
+    // The generation of the task the timer was set for: timers of older generations are stale.
+    uint64_t generation;
+    std::shared_ptr<Task> task;
+
+    bool operator>(const Timer &other) const noexcept { return deadline > other.deadline; }
+  };
+
+  /* Runs the tasks, on each thread of the pool. */
+  void DoWork();
+
+  /* Starts the threads. m_ must be held. */
+  void StartThreads();
+
+  /* Stops the threads once the running tasks return. m_ must not be held. */
+  void StopThreads();
+
+  /* Schedules an idle task to run after `delay`. m_ must be held. */
+  void ScheduleLocked(const std::shared_ptr<Task> &task, std::chrono::microseconds delay);
+
+  /* Queues an idle task to run as soon as possible. m_ must be held. */
+  void QueueLocked(const std::shared_ptr<Task> &task);
+
+  /* Called around forks. */
+  void PrepareFork();
+  void AfterFork();
+
+  const size_t num_threads_;
+  const ThreadOptions thread_options_;
+
+  std::mutex m_;
+  std::condition_variable work_cv_;
+  // Notified when a task returns, for SuspendTask.
+  std::condition_variable done_cv_;
+  std::deque<std::shared_ptr<Task>> ready_;
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+  bool stopping_            = false;
+  bool are_threads_started_ = false;
+  std::vector<std::thread> threads_;
+
+  /* Stops and restarts the threads around forks. Declared last, to be unregistered first. */
+  ForkHandlerRegistration fork_handler_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
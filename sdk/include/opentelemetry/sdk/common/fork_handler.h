@@ -0,0 +1,53 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+
+/**
+ * Registers callbacks run around fork() for as long as it lives, so that the objects owning
+ * background threads can stop them before the process forks and start them again afterwards:
+ * only the thread calling fork() is duplicated in the child.
+ *
+ * Like the handlers of pthread_atfork, the `prepare` callbacks of the live registrations are run
+ * in the reverse order of registration, and the `parent` and `child` callbacks in the order of
+ * registration. A process-wide lock is held from before the `prepare` callbacks until after the
+ * `parent` or `child` ones, so destroying a registration waits for a fork in progress, and the
+ * callbacks must not create or destroy registrations. Forks are not intercepted on Windows.
+ */
+class ForkHandlerRegistration
+{
+public:
+  ForkHandlerRegistration(std::function<void()> prepare,
+                          std::function<void()> parent,
+                          std::function<void()> child);
+
+  ForkHandlerRegistration(const ForkHandlerRegistration &) = delete;
+  ForkHandlerRegistration &operator=(const ForkHandlerRegistration &) = delete;
+
+  ~ForkHandlerRegistration();
+
+  void Prepare() const { prepare_(); }
+
+  void Parent() const { parent_(); }
+
+  void Child() const { child_(); }
+
+private:
+  std::function<void()> prepare_;
+  std::function<void()> parent_;
+  std::function<void()> child_;
+};
+
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
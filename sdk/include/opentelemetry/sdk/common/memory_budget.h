@@ -0,0 +1,205 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * The priority of the memory a component charges to a MemoryBudget. As the budget fills up,
+ * charges are refused in this order, so that low priority data is dropped first.
+ */
+enum class MemoryPriority
+{
+  // Refused once the budget is kElevated, e.g. log records.
+  kLow,
+  // Refused once the budget is kCritical, e.g. spans and metric series.
+  kNormal,
+  // Refused once the budget is exhausted, e.g. the spans of a priority queue.
+  kHigh
+};
+
+/** How full a MemoryBudget is. */
+enum class MemoryPressure
+{
+  kNone,
+  // Past MemoryBudget::kElevatedPercent of the limit: kLow charges are refused.
+  kElevated,
+  // Past MemoryBudget::kCriticalPercent of the limit: kNormal charges are refused as well.
+  kCritical
+};
+
+/**
+ * A memory limit shared by the buffers of several components, e.g. the queues of the batch span
+ * and log processors and the series of the metric storages, so that they can be sized against
+ * the memory of the process as a whole rather than each against a worst case of its own.
+ *
+ * Components charge the estimated size of the data they buffer before buffering it, and drop
+ * the data when the charge is refused; they release the charge once the data is gone, e.g.
+ * exported. A charge is refused when it would take the usage past the share of the limit of its
+ * priority, so data is dropped in priority order as the budget fills up.
+ *
+ * Listeners are notified when the pressure changes, e.g. to shed load or to export early.
+ *
+ * This class is thread-safe. Charges and releases are an atomic operation on the usage, plus a
+ * lock when the pressure changes.
+ */
+class MemoryBudget
+{
+public:
+  using PressureListener = std::function<void(MemoryPressure)>;
+
+  static constexpr size_t kElevatedPercent = 70;
+  static constexpr size_t kCriticalPercent = 85;
+
+  /**
+   * @param limit_bytes - The total of the charges that may be held at once.
+   */
+  explicit MemoryBudget(size_t limit_bytes) noexcept
+      : limit_(limit_bytes),
+        elevated_threshold_(limit_bytes / 100 * kElevatedPercent +
+                            limit_bytes % 100 * kElevatedPercent / 100),
+        critical_threshold_(limit_bytes / 100 * kCriticalPercent +
+                            limit_bytes % 100 * kCriticalPercent / 100)
+  {}
+
+  /**
+   * Charges `bytes` at `priority`.
+   * @return false, charging nothing, if the usage would then exceed the share of the limit
+   * `priority` may use.
+   */
+  bool TryCharge(size_t bytes, MemoryPriority priority) noexcept
+  {
+    const size_t threshold = GetThreshold(priority);
+    size_t usage           = usage_.load(std::memory_order_relaxed);
+    do
+    {
+      if (bytes > threshold || usage > threshold - bytes)
+      {
+        refused_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!usage_.compare_exchange_weak(usage, usage + bytes, std::memory_order_relaxed));
+    UpdatePressure(usage + bytes);
+    return true;
+  }
+
+  /**
+   * Charges `bytes` even past the limit, for memory that cannot be dropped.
+   */
+  void Charge(size_t bytes) noexcept
+  {
+    UpdatePressure(usage_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  }
+
+  /**
+   * Releases `bytes` charged earlier.
+   */
+  void Release(size_t bytes) noexcept
+  {
+    UpdatePressure(usage_.fetch_sub(bytes, std::memory_order_relaxed) - bytes);
+  }
+
+  size_t GetLimit() const noexcept { return limit_; }
+
+  size_t GetUsage() const noexcept { return usage_.load(std::memory_order_relaxed); }
+
+  /** Returns the number of charges refused so far. */
+  size_t GetRefusedCount() const noexcept { return refused_.load(std::memory_order_relaxed); }
+
+  MemoryPressure GetPressure() const noexcept { return GetPressure(GetUsage()); }
+
+  /**
+   * Registers `listener`, called with the new pressure each time it changes, on the thread whose
+   * charge or release changed it. Listeners must return quickly and must not use the budget.
+   * @return the id to pass to RemovePressureListener.
+   */
+  size_t AddPressureListener(PressureListener listener)
+  {
+    std::lock_guard<std::mutex> guard(listeners_lock_);
+    listeners_.emplace_back(++last_listener_id_, std::move(listener));
+    return last_listener_id_;
+  }
+
+  /**
+   * Unregisters a listener. Once this returns, the listener is not being called, nor will be.
+   */
+  void RemovePressureListener(size_t id)
+  {
+    std::lock_guard<std::mutex> guard(listeners_lock_);
+    for (auto it = listeners_.begin(); it != listeners_.end(); ++it)
+    {
+      if (it->first == id)
+      {
+        listeners_.erase(it);
+        return;
+      }
+    }
+  }
+
+private:
+  size_t GetThreshold(MemoryPriority priority) const noexcept
+  {
+    switch (priority)
+    {
+      case MemoryPriority::kLow:
+        return elevated_threshold_;
+      case MemoryPriority::kNormal:
+        return critical_threshold_;
+      default:
+        return limit_;
+    }
+  }
+
+  MemoryPressure GetPressure(size_t usage) const noexcept
+  {
+    return usage > critical_threshold_   ? MemoryPressure::kCritical
+           : usage > elevated_threshold_ ? MemoryPressure::kElevated
+                                         : MemoryPressure::kNone;
+  }
+
+  void UpdatePressure(size_t usage) noexcept
+  {
+    if (GetPressure(usage) == pressure_.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    // Concurrent changes may have reverted it: notify the pressure of the current usage, once.
+    std::lock_guard<std::mutex> guard(listeners_lock_);
+    MemoryPressure pressure = GetPressure();
+    if (pressure_.exchange(pressure, std::memory_order_relaxed) == pressure)
+    {
+      return;
+    }
+    for (auto &listener : listeners_)
+    {
+      listener.second(pressure);
+    }
+  }
+
+  const size_t limit_;
+  const size_t elevated_threshold_;
+  const size_t critical_threshold_;
+  std::atomic<size_t> usage_{0};
+  std::atomic<size_t> refused_{0};
+  std::atomic<MemoryPressure> pressure_{MemoryPressure::kNone};
+
+  std::mutex listeners_lock_;
+  size_t last_listener_id_ = 0;
+  std::vector<std::pair<size_t, PressureListener>> listeners_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
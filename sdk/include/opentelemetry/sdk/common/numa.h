@@ -0,0 +1,31 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Returns the number of NUMA nodes of the host, read once from the topology the kernel exposes.
+ * This is 1 where the topology is unknown, i.e. outside of Linux.
+ */
+size_t GetNumaNodeCount() noexcept;
+
+/**
+ * Returns the index, in [0, GetNumaNodeCount()), of the NUMA node of the CPU the calling thread
+ * runs on. Nodes are numbered densely, whatever their ids in the kernel.
+ *
+ * The node is cached per thread and only looked up again every few calls, so a thread which
+ * migrated to another node may be reported on its previous node for a short while.
+ */
+size_t GetCurrentNumaNode() noexcept;
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
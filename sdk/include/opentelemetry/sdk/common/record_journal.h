@@ -0,0 +1,106 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "opentelemetry/nostd/function_ref.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/* The encodings of the records of a RecordJournal. */
+enum class JournalRecordType : uint8_t
+{
+  // Not journaled: the recordable cannot encode itself.
+  kNone = 0,
+  // A span as SpanData::AppendBinary encodes it.
+  kSpan = 1,
+  // A log record as LogRecord::AppendBinary encodes it.
+  kLogRecord = 2,
+  // A serialized opentelemetry.proto.trace.v1.Span.
+  kOtlpSpan = 3,
+  // A serialized opentelemetry.proto.logs.v1.LogRecord.
+  kOtlpLogRecord = 4
+};
+
+/**
+ * A ring of records in a memory-mapped file, into which the batch processors write the spans and
+ * logs they queue (see BatchSpanProcessorOptions::journal), so that those still in the queue when
+ * the process crashes can be recovered from the file afterwards with Recover().
+ *
+ * Appending a record copies it into the mapping, with no system call: the records reach the file
+ * through the page cache of the kernel, which outlives the process but not the machine. Once the
+ * ring is full, the oldest records are overwritten. Appending is thread-safe and lock-free.
+ *
+ * The file is a 64 bytes header, the magic `OTJRNL01`, the uint64_t capacity of the ring and the
+ * uint64_t count of bytes ever appended, followed by the ring. Each record is 8 bytes aligned and
+ * starts with a 16 bytes header: the uint64_t position at which it was appended, a uint32_t
+ * holding the type in its high byte and the payload size below, and the uint32_t FNV-1a hash of
+ * the payload. Records never wrap around the end of the ring. Only Linux and other POSIX systems
+ * are supported.
+ */
+class RecordJournal
+{
+public:
+  /**
+   * Creates, or truncates, the journal file at `path` with a ring of `capacity` bytes.
+   * @return nullptr if the file cannot be created and mapped
+   */
+  static std::shared_ptr<RecordJournal> Open(const std::string &path, size_t capacity) noexcept;
+
+  /**
+   * Reads the records of a journal file, from the oldest to the newest, skipping those torn or
+   * partly overwritten.
+   * @return false if the file cannot be read or is not a journal
+   */
+  static bool Recover(const std::string &path,
+                      nostd::function_ref<void(JournalRecordType, nostd::string_view)> callback);
+
+  ~RecordJournal();
+
+  /**
+   * Appends a record, or drops it if it is larger than the ring.
+   * @return whether the record was appended
+   */
+  bool Append(JournalRecordType type, nostd::string_view payload) noexcept;
+
+  /**
+   * Appends the record of a span or log recordable, encoded by its AppendJournalRecord into a
+   * buffer of the calling thread, unless the recordable cannot encode itself.
+   */
+  template <class Recordable>
+  void AppendRecordable(const Recordable &recordable) noexcept
+  {
+    static thread_local std::string buffer;
+    buffer.clear();
+    JournalRecordType type = recordable.AppendJournalRecord(buffer);
+    if (type != JournalRecordType::kNone)
+    {
+      Append(type, buffer);
+    }
+  }
+
+  size_t GetCapacity() const noexcept { return capacity_; }
+
+private:
+  RecordJournal(int fd, uint8_t *data, size_t capacity) noexcept;
+
+  std::atomic<uint64_t> &Head() noexcept;
+
+  int fd_;
+  uint8_t *data_;
+  size_t capacity_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,152 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/*
+ * A free list of exported recordables, kept by a processor so that the recordables of the next
+ * spans or logs reuse their memory instead of being allocated again by the exporter.
+ *
+ * T is a Recordable type with a `bool Reset() noexcept` method: only the recordables whose Reset()
+ * returns true are kept. The list is split into shards, each guarded by its own spin lock; threads
+ * take recordables from their own shard first, so that threads on different shards do not contend
+ * on the same lock.
+ */
+template <class T>
+class RecordablePool
+{
+public:
+  /**
+   * @param max_size the total number of recordables kept, split evenly between the shards. The
+   * pool keeps nothing when it is 0.
+   * @param num_shards the number of shards; 0 is treated as 1.
+   */
+  RecordablePool(size_t max_size, size_t num_shards)
+  {
+    if (num_shards == 0)
+    {
+      num_shards = 1;
+    }
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+      size_t shard_size = max_size / num_shards + (i < max_size % num_shards ? 1 : 0);
+      shards_.emplace_back(new Shard(shard_size));
+    }
+  }
+
+  /**
+   * Takes a recordable out of the pool, trying the shard of the calling thread first.
+   * @return a reset recordable, or nullptr if the pool is empty.
+   */
+  std::unique_ptr<T> Take() noexcept
+  {
+    size_t num_shards = shards_.size();
+    size_t index      = num_shards == 1 ? 0 : GetThreadShardSeed() % num_shards;
+    for (size_t attempt = 0; attempt < num_shards; ++attempt)
+    {
+      Shard &shard = *shards_[index];
+      if (shard.count.load(std::memory_order_relaxed) != 0)
+      {
+        std::lock_guard<opentelemetry::common::SpinLockMutex> guard(shard.lock);
+        if (!shard.records.empty())
+        {
+          std::unique_ptr<T> record = std::move(shard.records.back());
+          shard.records.pop_back();
+          shard.count.store(shard.records.size(), std::memory_order_relaxed);
+          return record;
+        }
+      }
+      index = (index + 1) % num_shards;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Resets the recordables left in `records` and moves those which can be reused into the pool,
+   * spreading them between the shards. Null recordables are skipped; the recordables which cannot
+   * be reset, or for which there is no room, are left in `records`.
+   */
+  void Recycle(nostd::span<std::unique_ptr<T>> records) noexcept
+  {
+    size_t num_shards = shards_.size();
+    for (auto &record : records)
+    {
+      if (record == nullptr || !record->Reset())
+      {
+        continue;
+      }
+      for (size_t attempt = 0; attempt < num_shards; ++attempt)
+      {
+        Shard &shard = *shards_[next_shard_];
+        next_shard_  = (next_shard_ + 1) % num_shards;
+        std::lock_guard<opentelemetry::common::SpinLockMutex> guard(shard.lock);
+        if (shard.records.size() < shard.max_size)
+        {
+          shard.records.push_back(std::move(record));
+          shard.count.store(shard.records.size(), std::memory_order_relaxed);
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * @return the number of recordables in the pool across all shards.
+   */
+  size_t size() const noexcept
+  {
+    size_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->count.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+private:
+  struct Shard
+  {
+    explicit Shard(size_t size) : max_size(size) { records.reserve(size); }
+
+    const size_t max_size;
+    opentelemetry::common::SpinLockMutex lock;
+    std::vector<std::unique_ptr<T>> records;
+    // The size of records, read without the lock to skip empty shards.
+    std::atomic<size_t> count{0};
+  };
+
+  // Each shard is allocated separately so that the locks of neighbouring shards do not share a
+  // cache line.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  // Only touched by Recycle, which is called by a single thread at a time.
+  size_t next_shard_ = 0;
+
+  /**
+   * Threads are assigned a shard seed round-robin on first use, which spreads
+   * them more evenly than hashing the thread id.
+   */
+  static size_t GetThreadShardSeed() noexcept
+  {
+    static std::atomic<size_t> next_seed{0};
+    static thread_local size_t seed = next_seed.fetch_add(1, std::memory_order_relaxed);
+    return seed;
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
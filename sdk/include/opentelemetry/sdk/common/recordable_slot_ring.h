@@ -0,0 +1,194 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "opentelemetry/nostd/span.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/*
+ * A fixed ring of slots holding reusable recordables, all made when the ring is created, so that a
+ * processor records its spans or logs into memory allocated once and for all.
+ *
+ * Each slot carries a sequence number, as in a disruptor: a thread claims the slot of the next
+ * position by incrementing the position, takes the recordable out of it and publishes the slot as
+ * free by advancing its sequence; the recordables given back are published the same way at the
+ * other end of the ring. Neither side takes a lock, and a slot is only touched by the thread which
+ * claimed it.
+ *
+ * T is a Recordable type with a `bool Reset() noexcept` method: only the recordables whose Reset()
+ * returns true are given back to the ring.
+ */
+template <class T>
+class RecordableSlotRing
+{
+public:
+  /**
+   * @param size the number of slots; 0 is treated as 1.
+   * @param make a callable returning a std::unique_ptr<T>, called once per slot to fill the ring.
+   */
+  template <class Make>
+  RecordableSlotRing(size_t size, Make make) : slots_(size == 0 ? 1 : size)
+  {
+    size_t filled = 0;
+    for (size_t i = 0; i < slots_.size(); ++i)
+    {
+      std::unique_ptr<T> record = make();
+      if (record != nullptr)
+      {
+        slots_[filled].record = std::move(record);
+        slots_[filled].sequence.store(filled + 1, std::memory_order_relaxed);
+        ++filled;
+      }
+    }
+    // The slots the factory did not fill are free, after the filled ones.
+    for (size_t i = filled; i < slots_.size(); ++i)
+    {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    take_position_.store(0, std::memory_order_relaxed);
+    give_position_.store(filled, std::memory_order_relaxed);
+  }
+
+  /**
+   * Takes the recordable of the next filled slot. Safe to call from any thread.
+   * @return a reset recordable, or nullptr if all the recordables are taken.
+   */
+  std::unique_ptr<T> Take() noexcept
+  {
+    uint64_t position = take_position_.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Slot &slot        = slots_[position % slots_.size()];
+      uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == position + 1)
+      {
+        if (take_position_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+        {
+          std::unique_ptr<T> record = std::move(slot.record);
+          slot.sequence.store(position + slots_.size(), std::memory_order_release);
+          return record;
+        }
+      }
+      else if (sequence < position + 1 &&
+               give_position_.load(std::memory_order_acquire) <= position)
+      {
+        // No recordable was given back for the slot: the ring is empty.
+        return nullptr;
+      }
+      else
+      {
+        // Another thread took the slot, or one is giving a recordable back to it.
+        position = take_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Resets the recordables left in `records` and gives those which can be reused back to the
+   * ring. Null recordables are skipped; the recordables which cannot be reset, or for which there
+   * is no free slot, are left in `records`. Safe to call from any thread.
+   */
+  void Recycle(nostd::span<std::unique_ptr<T>> records) noexcept
+  {
+    for (auto &record : records)
+    {
+      if (record == nullptr || !record->Reset())
+      {
+        continue;
+      }
+      if (!Give(record))
+      {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @return the number of recordables in the ring, which may be stale when other threads take or
+   * give recordables at the same time.
+   */
+  size_t size() const noexcept
+  {
+    uint64_t take = take_position_.load(std::memory_order_relaxed);
+    uint64_t give = give_position_.load(std::memory_order_relaxed);
+    return give > take ? static_cast<size_t>(give - take) : 0;
+  }
+
+  /**
+   * @return the number of slots of the ring.
+   */
+  size_t max_size() const noexcept { return slots_.size(); }
+
+private:
+  struct Slot
+  {
+    // The position the slot is free for, or that position plus one once it holds a recordable.
+    std::atomic<uint64_t> sequence{0};
+    std::unique_ptr<T> record;
+  };
+
+  /**
+   * Moves record into the next free slot.
+   * @return false, leaving record as it is, if no slot is free.
+   */
+  bool Give(std::unique_ptr<T> &record) noexcept
+  {
+    uint64_t position = give_position_.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Slot &slot        = slots_[position % slots_.size()];
+      uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == position)
+      {
+        if (give_position_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+        {
+          slot.record = std::move(record);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (sequence < position && IsFull())
+      {
+        // The recordable of the slot was not taken: the ring is full.
+        return false;
+      }
+      else
+      {
+        // Another thread gave a recordable to the slot, or one is taking the recordable out of it.
+        position = give_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @return true if no slot is free, rather than about to be freed by a thread taking a recordable.
+   */
+  bool IsFull() const noexcept
+  {
+    // Read give_position_ first: the recordables taken since only make the ring look less full,
+    // and the caller tries again. take_position_ may then be ahead of give.
+    uint64_t give = give_position_.load(std::memory_order_acquire);
+    uint64_t take = take_position_.load(std::memory_order_acquire);
+    return give >= take && give - take >= slots_.size();
+  }
+
+  std::vector<Slot> slots_;
+  std::atomic<uint64_t> take_position_{0};
+  std::atomic<uint64_t> give_position_{0};
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,190 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+// Generated by buildscripts/semantic-convention/generate_attribute_keys.py, do not edit.
+
+#pragma once
+
+#include "opentelemetry/common/attribute_key.h"
+#include "opentelemetry/sdk/resource/experimental_semantic_conventions.h"
+#include "opentelemetry/trace/experimental_semantic_conventions.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+
+/**
+ * The attribute keys of the semantic conventions, in the order of their ids.
+ */
+constexpr opentelemetry::common::AttributeKey kSemanticAttributeKeys[] = {
+    opentelemetry::trace::attribute_keys::kNetTransport,
+    opentelemetry::trace::attribute_keys::kNetPeerIp,
+    opentelemetry::trace::attribute_keys::kNetPeerPort,
+    opentelemetry::trace::attribute_keys::kNetPeerName,
+    opentelemetry::trace::attribute_keys::kNetHostIp,
+    opentelemetry::trace::attribute_keys::kNetHostPort,
+    opentelemetry::trace::attribute_keys::kNetHostName,
+    opentelemetry::trace::attribute_keys::kEnduserId,
+    opentelemetry::trace::attribute_keys::kEnduserRole,
+    opentelemetry::trace::attribute_keys::kEnduserScope,
+    opentelemetry::trace::attribute_keys::kPeerService,
+    opentelemetry::trace::attribute_keys::kThreadId,
+    opentelemetry::trace::attribute_keys::kThreadName,
+    opentelemetry::trace::attribute_keys::kCodeFunction,
+    opentelemetry::trace::attribute_keys::kCodeNamespace,
+    opentelemetry::trace::attribute_keys::kCodeFilepath,
+    opentelemetry::trace::attribute_keys::kCodeLineno,
+    opentelemetry::trace::attribute_keys::kHttpMethod,
+    opentelemetry::trace::attribute_keys::kHttpUrl,
+    opentelemetry::trace::attribute_keys::kHttpTarget,
+    opentelemetry::trace::attribute_keys::kHttpHost,
+    opentelemetry::trace::attribute_keys::kHttpScheme,
+    opentelemetry::trace::attribute_keys::kHttpStatusCode,
+    opentelemetry::trace::attribute_keys::kHttpFlavor,
+    opentelemetry::trace::attribute_keys::kHttpUserAgent,
+    opentelemetry::trace::attribute_keys::kHttpRequestContentLength,
+    opentelemetry::trace::attribute_keys::kHttpRequestContentLengthUncompressed,
+    opentelemetry::trace::attribute_keys::kHttpResponseContentLength,
+    opentelemetry::trace::attribute_keys::kHttpResponseContentLengthUncompressed,
+    opentelemetry::trace::attribute_keys::kHttpServerName,
+    opentelemetry::trace::attribute_keys::kHttpRoute,
+    opentelemetry::trace::attribute_keys::kHttpClientIp,
+    opentelemetry::trace::attribute_keys::kDbSystem,
+    opentelemetry::trace::attribute_keys::kDbConnectionString,
+    opentelemetry::trace::attribute_keys::kDbUser,
+    opentelemetry::trace::attribute_keys::kDbMssqlInstanceName,
+    opentelemetry::trace::attribute_keys::kDbJdbcDriverClassname,
+    opentelemetry::trace::attribute_keys::kDbName,
+    opentelemetry::trace::attribute_keys::kDbStatement,
+    opentelemetry::trace::attribute_keys::kDbOperation,
+    opentelemetry::trace::attribute_keys::kDbHbaseNamespace,
+    opentelemetry::trace::attribute_keys::kDbRedisDatabaseIndex,
+    opentelemetry::trace::attribute_keys::kDbMongodbCollection,
+    opentelemetry::trace::attribute_keys::kDbCassandraKeyspace,
+    opentelemetry::trace::attribute_keys::kDbCassandraPageSize,
+    opentelemetry::trace::attribute_keys::kDbCassandraConsistencyLevel,
+    opentelemetry::trace::attribute_keys::kDbCassandraTable,
+    opentelemetry::trace::attribute_keys::kDbCassandraIdempotence,
+    opentelemetry::trace::attribute_keys::kDbCassandraSpeculativeExecutionCount,
+    opentelemetry::trace::attribute_keys::kDbCassandraCoordinatorId,
+    opentelemetry::trace::attribute_keys::kDbCassandraCoordinatorDC,
+    opentelemetry::trace::attribute_keys::kRpcSystem,
+    opentelemetry::trace::attribute_keys::kRpcService,
+    opentelemetry::trace::attribute_keys::kRpcMethod,
+    opentelemetry::trace::attribute_keys::kRpcGrpcStatusCode,
+    opentelemetry::trace::attribute_keys::kRpcJsonrpcVersion,
+    opentelemetry::trace::attribute_keys::kRpcJsonrpcRequestId,
+    opentelemetry::trace::attribute_keys::kRpcJsonrpcErrorCode,
+    opentelemetry::trace::attribute_keys::kRpcJsonrpcErrorMessage,
+    opentelemetry::trace::attribute_keys::kFaasTrigger,
+    opentelemetry::trace::attribute_keys::kFaasExecution,
+    opentelemetry::trace::attribute_keys::kFaasColdStart,
+    opentelemetry::trace::attribute_keys::kFaasInvokedName,
+    opentelemetry::trace::attribute_keys::kFaasInvokedProvider,
+    opentelemetry::trace::attribute_keys::kFaasInvokedRegion,
+    opentelemetry::trace::attribute_keys::kFaasDocumentCollection,
+    opentelemetry::trace::attribute_keys::kFaasDocumentOperation,
+    opentelemetry::trace::attribute_keys::kFaasDocumentTime,
+    opentelemetry::trace::attribute_keys::kFaasDocumentName,
+    opentelemetry::trace::attribute_keys::kFaasTime,
+    opentelemetry::trace::attribute_keys::kFaasCron,
+    opentelemetry::trace::attribute_keys::kMessagingSystem,
+    opentelemetry::trace::attribute_keys::kMessagingDestination,
+    opentelemetry::trace::attribute_keys::kMessagingDestinationKind,
+    opentelemetry::trace::attribute_keys::kMessagingTempDestination,
+    opentelemetry::trace::attribute_keys::kMessagingProtocol,
+    opentelemetry::trace::attribute_keys::kMessagingProtocolVersion,
+    opentelemetry::trace::attribute_keys::kMessagingUrl,
+    opentelemetry::trace::attribute_keys::kMessagingMessageId,
+    opentelemetry::trace::attribute_keys::kMessagingConversationId,
+    opentelemetry::trace::attribute_keys::kMessagingPayloadSize,
+    opentelemetry::trace::attribute_keys::kMessagingPayloadCompressedSize,
+    opentelemetry::trace::attribute_keys::kMessagingOperation,
+    opentelemetry::trace::attribute_keys::kMessagingRabbitMQRoutingKey,
+    opentelemetry::trace::attribute_keys::kMessagingKafkaMessageKey,
+    opentelemetry::trace::attribute_keys::kMessagingKafkaConsumerGroup,
+    opentelemetry::trace::attribute_keys::kMessagingKafkaClientId,
+    opentelemetry::trace::attribute_keys::kMessagingKafkaPartition,
+    opentelemetry::trace::attribute_keys::kMessagingKafkaTombstone,
+    opentelemetry::trace::attribute_keys::kExceptionType,
+    opentelemetry::trace::attribute_keys::kExceptionMessage,
+    opentelemetry::trace::attribute_keys::kExceptionStacktrace,
+    opentelemetry::trace::attribute_keys::kExceptionEscapted,
+    opentelemetry::sdk::resource::attribute_keys::kServiceName,
+    opentelemetry::sdk::resource::attribute_keys::kServiceNamespace,
+    opentelemetry::sdk::resource::attribute_keys::kServiceInstance,
+    opentelemetry::sdk::resource::attribute_keys::kServiceVersion,
+    opentelemetry::sdk::resource::attribute_keys::kTelemetrySdkName,
+    opentelemetry::sdk::resource::attribute_keys::kTelemetrySdkLanguage,
+    opentelemetry::sdk::resource::attribute_keys::kTelemetrySdkVersion,
+    opentelemetry::sdk::resource::attribute_keys::kTelemetryAutoVersion,
+    opentelemetry::sdk::resource::attribute_keys::kContainerName,
+    opentelemetry::sdk::resource::attribute_keys::kContainerId,
+    opentelemetry::sdk::resource::attribute_keys::kContainerRuntime,
+    opentelemetry::sdk::resource::attribute_keys::kContainerImageName,
+    opentelemetry::sdk::resource::attribute_keys::kContainerImageTag,
+    opentelemetry::sdk::resource::attribute_keys::kFaasName,
+    opentelemetry::sdk::resource::attribute_keys::kFaasId,
+    opentelemetry::sdk::resource::attribute_keys::kFaasVersion,
+    opentelemetry::sdk::resource::attribute_keys::kFaasInstance,
+    opentelemetry::sdk::resource::attribute_keys::kFaasMaxMemory,
+    opentelemetry::sdk::resource::attribute_keys::kProcessId,
+    opentelemetry::sdk::resource::attribute_keys::kProcessExecutableName,
+    opentelemetry::sdk::resource::attribute_keys::kProcessExecutablePath,
+    opentelemetry::sdk::resource::attribute_keys::kProcessCommand,
+    opentelemetry::sdk::resource::attribute_keys::kProcessCommandLine,
+    opentelemetry::sdk::resource::attribute_keys::kProcessCommandArgs,
+    opentelemetry::sdk::resource::attribute_keys::kProcessOwner,
+    opentelemetry::sdk::resource::attribute_keys::kProcessRuntimeName,
+    opentelemetry::sdk::resource::attribute_keys::kProcessRuntimeVersion,
+    opentelemetry::sdk::resource::attribute_keys::kProcessRuntimeDescription,
+    opentelemetry::sdk::resource::attribute_keys::kWebEngineName,
+    opentelemetry::sdk::resource::attribute_keys::kWebEngineVersion,
+    opentelemetry::sdk::resource::attribute_keys::kWebEngineDescription,
+    opentelemetry::sdk::resource::attribute_keys::kHostId,
+    opentelemetry::sdk::resource::attribute_keys::kHostName,
+    opentelemetry::sdk::resource::attribute_keys::kHostType,
+    opentelemetry::sdk::resource::attribute_keys::kHostArch,
+    opentelemetry::sdk::resource::attribute_keys::kHostImageName,
+    opentelemetry::sdk::resource::attribute_keys::kHostImageId,
+    opentelemetry::sdk::resource::attribute_keys::kHostImageVersion,
+    opentelemetry::sdk::resource::attribute_keys::kOsType,
+    opentelemetry::sdk::resource::attribute_keys::kOsDescription,
+    opentelemetry::sdk::resource::attribute_keys::kOsName,
+    opentelemetry::sdk::resource::attribute_keys::kOsVersion,
+    opentelemetry::sdk::resource::attribute_keys::kDeviceId,
+    opentelemetry::sdk::resource::attribute_keys::kDeviceModelIdentifier,
+    opentelemetry::sdk::resource::attribute_keys::kDeviceModelName,
+    opentelemetry::sdk::resource::attribute_keys::kCloudProvider,
+    opentelemetry::sdk::resource::attribute_keys::kCloudAccountId,
+    opentelemetry::sdk::resource::attribute_keys::kCloudRegion,
+    opentelemetry::sdk::resource::attribute_keys::kCloudAvailabilityZone,
+    opentelemetry::sdk::resource::attribute_keys::kCloudPlatform,
+    opentelemetry::sdk::resource::attribute_keys::kDeploymentEnvironment,
+    opentelemetry::sdk::resource::attribute_keys::kK8sClusterName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sNodeName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sNodeUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sNamespaceName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sPodUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sPodName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sContainerName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sReplicaSetUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sReplicaSetName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sDeploymentUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sDeploymentName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sStatefulSetUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sStatefulSetName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sDaemonSetUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sDaemonSetName,
+    opentelemetry::sdk::resource::attribute_keys::kK8sJobUid,
+    opentelemetry::sdk::resource::attribute_keys::kK8sJobName,
+    opentelemetry::sdk::resource::attribute_keys::kCronjobUid,
+    opentelemetry::sdk::resource::attribute_keys::kCronjobName,
+};
+
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,356 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/*
+ * A multi-producer, single-consumer queue made of several independent lock-free
+ * CircularBuffer shards. Each producer thread is pinned to one shard, so that
+ * threads on different shards never contend on the same head/tail cache lines.
+ * The consumer drains the shards round-robin.
+ *
+ * With a single shard this behaves exactly like a CircularBuffer, including the
+ * FIFO ordering of the elements. With several shards, ordering is only
+ * preserved between elements added by the same thread.
+ */
+template <class T>
+class ShardedCircularBuffer
+{
+public:
+  /**
+   * @param max_size the total number of elements the buffer can hold, split
+   * evenly between the shards.
+   * @param num_shards the number of shards; 0 is treated as 1.
+   */
+  ShardedCircularBuffer(size_t max_size, size_t num_shards)
+  {
+    if (num_shards == 0)
+    {
+      num_shards = 1;
+    }
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i)
+    {
+      size_t shard_size = max_size / num_shards + (i < max_size % num_shards ? 1 : 0);
+      shards_.emplace_back(new CircularBuffer<T>(shard_size));
+    }
+  }
+
+  /**
+   * Adds an element into the shard of the calling thread. If that shard is
+   * full, the remaining shards are tried in turn before giving up.
+   * @param ptr a pointer to the element to add
+   * @return true if the element was successfully added; false, otherwise.
+   */
+  bool Add(std::unique_ptr<T> &ptr) noexcept { return AddToShard(ptr) != nullptr; }
+
+  /**
+   * Same as Add, but returns the shard the element was added to, or nullptr if
+   * every shard was full. This lets callers check the fill level of the shard
+   * they just touched without reading the other shards' counters.
+   */
+  const CircularBuffer<T> *AddToShard(std::unique_ptr<T> &ptr) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    size_t index            = num_shards == 1 ? 0 : GetThreadShardSeed() % num_shards;
+    for (size_t attempt = 0; attempt < num_shards; ++attempt)
+    {
+      CircularBuffer<T> &shard = *shards_[index];
+      if (shard.Add(ptr))
+      {
+        return &shard;
+      }
+      if (++index == num_shards)
+      {
+        index = 0;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Adds an element into the shard at `index` only, e.g. the shard of a tenant, without falling
+   * back to the other shards when it is full.
+   * @return the shard, or nullptr if it was full
+   */
+  const CircularBuffer<T> *AddToShardAt(size_t index, std::unique_ptr<T> &ptr) noexcept
+  {
+    CircularBuffer<T> &shard = *shards_[index % shards_.size()];
+    return shard.Add(ptr) ? &shard : nullptr;
+  }
+
+  /**
+   * Adds the elements of a vector at once into the shard of the calling thread, then into the
+   * remaining shards in turn for the elements which do not fit. See CircularBuffer::AddBatch.
+   * @param elements the elements to add; the first ones, which were added, are left null, and the
+   * ones which did not fit in any shard follow them
+   * @return the number of elements added
+   */
+  size_t AddBatch(std::vector<std::unique_ptr<T>> &elements) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    size_t index            = num_shards == 1 ? 0 : GetThreadShardSeed() % num_shards;
+    size_t added            = shards_[index]->AddBatch(elements);
+    if (added == elements.size() || num_shards == 1)
+    {
+      return added;
+    }
+
+    // Keep the elements left over at the front, for the next shards.
+    std::vector<std::unique_ptr<T>> rest;
+    rest.reserve(elements.size() - added);
+    for (size_t i = added; i < elements.size(); ++i)
+    {
+      rest.emplace_back(std::move(elements[i]));
+    }
+    for (size_t attempt = 1; attempt < num_shards && !rest.empty(); ++attempt)
+    {
+      if (++index == num_shards)
+      {
+        index = 0;
+      }
+      size_t shard_added = shards_[index]->AddBatch(rest);
+      rest.erase(rest.begin(), rest.begin() + shard_added);
+      added += shard_added;
+    }
+    for (size_t i = 0; i < rest.size(); ++i)
+    {
+      elements[added + i] = std::move(rest[i]);
+    }
+    return added;
+  }
+
+  /**
+   * Consume up to n elements, visiting the shards round-robin starting after
+   * the shard the previous call stopped at.
+   * @param n the maximum number of elements to consume
+   * @param callback the callback to invoke with a CircularBufferRange for each
+   * shard that elements were consumed from.
+   *
+   * Note: The callback must set the passed AtomicUniquePtr to null.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  template <class Callback>
+  void Consume(size_t n, Callback callback) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    for (size_t visited = 0; visited < num_shards && n > 0; ++visited)
+    {
+      CircularBuffer<T> &shard = *shards_[next_shard_];
+      if (++next_shard_ == num_shards)
+      {
+        next_shard_ = 0;
+      }
+      size_t available = shard.size();
+      size_t count     = available < n ? available : n;
+      if (count == 0)
+      {
+        continue;
+      }
+      shard.Consume(count, callback);
+      n -= count;
+    }
+  }
+
+  /**
+   * Moves up to n elements to the end of out, visiting the shards round-robin
+   * like Consume. See CircularBuffer::ConsumeInto.
+   * @return the number of elements moved
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  size_t ConsumeInto(size_t n, std::vector<std::unique_ptr<T>> &out) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    size_t consumed         = 0;
+    for (size_t visited = 0; visited < num_shards && consumed < n; ++visited)
+    {
+      CircularBuffer<T> &shard = *shards_[next_shard_];
+      if (++next_shard_ == num_shards)
+      {
+        next_shard_ = 0;
+      }
+      consumed += shard.ConsumeInto(n - consumed, out);
+    }
+    return consumed;
+  }
+
+  /**
+   * Moves up to n elements to the end of out with deficit round-robin: each turn of a shard grants
+   * it `quantum` elements, and a shard whose turn is cut short by the n elements keeps its turn
+   * and the rest of its credit for the next call. Every non-empty shard thus gets the same share
+   * of the elements consumed, however many it holds. A shard found empty loses its credit.
+   * @return the number of elements moved
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  size_t ConsumeFairInto(size_t n, size_t quantum, std::vector<std::unique_ptr<T>> &out) noexcept
+  {
+    const size_t num_shards = shards_.size();
+    if (deficits_.size() != num_shards)
+    {
+      deficits_.assign(num_shards, 0);
+    }
+    if (quantum == 0)
+    {
+      quantum = 1;
+    }
+    size_t consumed = 0;
+    bool progress   = true;
+    while (consumed < n && progress)
+    {
+      progress = false;
+      for (size_t visited = 0; visited < num_shards && consumed < n; ++visited)
+      {
+        CircularBuffer<T> &shard = *shards_[next_shard_];
+        size_t &deficit          = deficits_[next_shard_];
+        if (deficit == 0)
+        {
+          deficit = quantum;
+        }
+        size_t count = deficit < n - consumed ? deficit : n - consumed;
+        size_t moved = shard.ConsumeInto(count, out);
+        consumed += moved;
+        deficit -= moved;
+        progress = progress || moved > 0;
+        if (moved == count && deficit > 0)
+        {
+          // The n elements ran out during the turn of this shard, which goes on next call.
+          return consumed;
+        }
+        deficit = 0;
+        if (++next_shard_ == num_shards)
+        {
+          next_shard_ = 0;
+        }
+      }
+    }
+    return consumed;
+  }
+
+  /**
+   * Consume up to n elements, discarding them.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  void Consume(size_t n) noexcept
+  {
+    Consume(n, [](CircularBufferRange<AtomicUniquePtr<T>> &range) noexcept {
+      range.ForEach([](AtomicUniquePtr<T> &ptr) noexcept {
+        ptr.Reset();
+        return true;
+      });
+    });
+  }
+
+  /**
+   * Clear every shard.
+   *
+   * Note: This method must only be called from the consumer thread.
+   */
+  void Clear() noexcept
+  {
+    for (auto &shard : shards_)
+    {
+      shard->Clear();
+    }
+  }
+
+  /**
+   * @return the maximum number of elements that can be stored in the buffer.
+   */
+  size_t max_size() const noexcept
+  {
+    size_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->max_size();
+    }
+    return result;
+  }
+
+  /**
+   * @return true if every shard is empty.
+   */
+  bool empty() const noexcept
+  {
+    for (auto &shard : shards_)
+    {
+      if (!shard->empty())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @return the number of elements stored across all shards.
+   *
+   * Note: this method will only return a correct snapshot of the size if called
+   * from the consumer thread.
+   */
+  size_t size() const noexcept
+  {
+    size_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->size();
+    }
+    return result;
+  }
+
+  /**
+   * @return the number of elements added to the buffer across all shards.
+   */
+  uint64_t production_count() const noexcept
+  {
+    uint64_t result = 0;
+    for (auto &shard : shards_)
+    {
+      result += shard->production_count();
+    }
+    return result;
+  }
+
+  /**
+   * @return the number of shards.
+   */
+  size_t num_shards() const noexcept { return shards_.size(); }
+
+private:
+  // Each shard is allocated separately so that the head/tail counters of
+  // neighbouring shards do not share a cache line.
+  std::vector<std::unique_ptr<CircularBuffer<T>>> shards_;
+  size_t next_shard_ = 0;
+  // The credit left to each shard by ConsumeFairInto.
+  std::vector<size_t> deficits_;
+
+  /**
+   * Threads are assigned a shard seed round-robin on first use, which spreads
+   * them more evenly than hashing the thread id.
+   */
+  static size_t GetThreadShardSeed() noexcept
+  {
+    static std::atomic<size_t> next_seed{0};
+    static thread_local size_t seed = next_seed.fetch_add(1, std::memory_order_relaxed);
+    return seed;
+  }
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,85 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Returns the time left until `deadline`, zero once it has passed.
+ */
+inline std::chrono::microseconds GetRemainingTime(
+    std::chrono::steady_clock::time_point deadline) noexcept
+{
+  auto now = std::chrono::steady_clock::now();
+  return deadline > now ? std::chrono::duration_cast<std::chrono::microseconds>(deadline - now)
+                        : std::chrono::microseconds::zero();
+}
+
+/**
+ * Returns the point in time `timeout` from now, or the largest one if that would overflow.
+ */
+inline std::chrono::steady_clock::time_point GetDeadline(std::chrono::microseconds timeout) noexcept
+{
+  auto now = std::chrono::steady_clock::now();
+  if (timeout >= std::chrono::duration_cast<std::chrono::microseconds>(
+                     (std::chrono::steady_clock::time_point::max)() - now))
+  {
+    return (std::chrono::steady_clock::time_point::max)();
+  }
+  return now + timeout;
+}
+
+/**
+ * Runs `operation(index, timeout)` for each index in [0, count) at once, e.g. to flush or shut
+ * down the children of a composite processor, so that the whole takes as long as the slowest
+ * child rather than the sum of them. Each child is given the time left until a deadline shared
+ * by all, `timeout` from now.
+ *
+ * The first child runs on the calling thread, the others on threads of their own. The children
+ * must honor their timeout: this returns once all of them have returned.
+ *
+ * @return for each child, whether it succeeded, i.e. returned true before the deadline.
+ */
+template <class Operation>
+std::vector<bool> RunWithSharedDeadline(size_t count,
+                                        std::chrono::microseconds timeout,
+                                        Operation operation)
+{
+  const auto deadline = GetDeadline(timeout);
+  // Not a vector<bool>: each thread writes an element of its own.
+  std::vector<char> succeeded(count, 0);
+  auto run = [&](size_t index) {
+    bool result      = operation(index, GetRemainingTime(deadline));
+    succeeded[index] = result && std::chrono::steady_clock::now() <= deadline;
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(count > 0 ? count - 1 : 0);
+  for (size_t i = 1; i < count; ++i)
+  {
+    threads.emplace_back(run, i);
+  }
+  if (count > 0)
+  {
+    run(0);
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  return std::vector<bool>(succeeded.begin(), succeeded.end());
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
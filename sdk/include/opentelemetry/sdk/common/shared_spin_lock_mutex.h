@@ -0,0 +1,129 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A reader-writer lock built on a single atomic word, for read-mostly data such as metric series
+ * lookups. Any number of readers may hold the lock at once; a writer holds it alone. Writers are
+ * preferred: once a writer is waiting, new readers back off until it is done, so a steady stream
+ * of readers cannot starve it.
+ *
+ * Waiting uses the same back-off strategy as opentelemetry::common::SpinLockMutex.
+ *
+ * This class implements the `Lockable` and `SharedLockable` (lock_shared / try_lock_shared /
+ * unlock_shared) requirements, so it can be used with std::lock_guard for exclusive access and
+ * with SharedSpinLockGuard for shared access.
+ */
+class SharedSpinLockMutex
+{
+public:
+  SharedSpinLockMutex() noexcept {}
+  SharedSpinLockMutex(const SharedSpinLockMutex &) = delete;
+  SharedSpinLockMutex &operator=(const SharedSpinLockMutex &) = delete;
+
+  bool try_lock() noexcept
+  {
+    uint32_t expected = 0;
+    return state_.compare_exchange_strong(expected, kWriter, std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  void lock() noexcept
+  {
+    // Claim the writer bit first, which stops new readers, then wait for the readers to leave.
+    Wait([this] {
+      return (state_.fetch_or(kWriter, std::memory_order_acquire) & kWriter) == 0;
+    });
+    Wait([this] { return state_.load(std::memory_order_acquire) == kWriter; });
+  }
+
+  void unlock() noexcept { state_.fetch_and(~kWriter, std::memory_order_release); }
+
+  bool try_lock_shared() noexcept
+  {
+    if ((state_.load(std::memory_order_relaxed) & kWriter) != 0)
+    {
+      return false;
+    }
+    if ((state_.fetch_add(1, std::memory_order_acquire) & kWriter) == 0)
+    {
+      return true;
+    }
+    // A writer got in between; step back so that it can proceed.
+    state_.fetch_sub(1, std::memory_order_release);
+    return false;
+  }
+
+  void lock_shared() noexcept
+  {
+    Wait([this] { return try_lock_shared(); });
+  }
+
+  void unlock_shared() noexcept { state_.fetch_sub(1, std::memory_order_release); }
+
+private:
+  static constexpr uint32_t kWriter = 0x80000000u;
+
+  template <class TryAcquire>
+  static void Wait(TryAcquire try_acquire) noexcept
+  {
+    for (;;)
+    {
+      for (int i = 0; i < opentelemetry::common::SPINLOCK_FAST_ITERATIONS; ++i)
+      {
+        if (try_acquire())
+        {
+          return;
+        }
+      }
+      std::this_thread::yield();
+      if (try_acquire())
+      {
+        return;
+      }
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(opentelemetry::common::SPINLOCK_SLEEP_MS));
+    }
+  }
+
+  // The top bit is set while a writer holds or waits for the lock; the remaining bits count the
+  // readers.
+  std::atomic<uint32_t> state_{0};
+};
+
+/**
+ * RAII guard holding a SharedSpinLockMutex (or any SharedLockable) in shared mode.
+ */
+template <class SharedMutex>
+class SharedSpinLockGuard
+{
+public:
+  explicit SharedSpinLockGuard(SharedMutex &mutex) noexcept : mutex_(mutex)
+  {
+    mutex_.lock_shared();
+  }
+  ~SharedSpinLockGuard() noexcept { mutex_.unlock_shared(); }
+
+  SharedSpinLockGuard(const SharedSpinLockGuard &) = delete;
+  SharedSpinLockGuard &operator=(const SharedSpinLockGuard &) = delete;
+
+private:
+  SharedMutex &mutex_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
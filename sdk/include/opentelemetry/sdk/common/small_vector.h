@@ -0,0 +1,237 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * A vector whose first N elements are stored in the object itself. It only allocates once it
+ * grows beyond N elements, and then keeps its heap buffer until it is destroyed: clear() keeps the
+ * capacity, like std::vector.
+ *
+ * Only the subset of the std::vector interface needed by the SDK is provided. Iterators are
+ * pointers, and are invalidated when the vector grows.
+ */
+template <class T, size_t N>
+class SmallVector
+{
+  static_assert(N > 0, "SmallVector needs an inline capacity");
+
+public:
+  using value_type      = T;
+  using size_type       = size_t;
+  using reference       = T &;
+  using const_reference = const T &;
+  using iterator        = T *;
+  using const_iterator  = const T *;
+
+  SmallVector() noexcept = default;
+
+  SmallVector(const SmallVector &other) : SmallVector() { *this = other; }
+
+  SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+      : SmallVector()
+  {
+    MoveFrom(other);
+  }
+
+  SmallVector &operator=(const SmallVector &other)
+  {
+    if (this != &other)
+    {
+      clear();
+      reserve(other.size_);
+      for (const T &value : other)
+      {
+        new (data_ + size_) T(value);
+        ++size_;
+      }
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &other)
+    {
+      clear();
+      ReleaseHeap();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector()
+  {
+    clear();
+    ReleaseHeap();
+  }
+
+  size_t size() const noexcept { return size_; }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_t capacity() const noexcept { return capacity_; }
+
+  /**
+   * @return true if the elements are stored in the object itself, false once it allocated.
+   */
+  bool is_inline() const noexcept { return data_ == InlineData(); }
+
+  T *data() noexcept { return data_; }
+  const T *data() const noexcept { return data_; }
+
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  T &operator[](size_t index) noexcept { return data_[index]; }
+  const T &operator[](size_t index) const noexcept { return data_[index]; }
+
+  T &front() noexcept { return data_[0]; }
+  const T &front() const noexcept { return data_[0]; }
+  T &back() noexcept { return data_[size_ - 1]; }
+  const T &back() const noexcept { return data_[size_ - 1]; }
+
+  /**
+   * Like std::vector::at, checks the index: throws std::out_of_range, or terminates when built
+   * without exceptions.
+   */
+  const T &at(size_t index) const
+  {
+    if (index >= size_)
+    {
+#if __EXCEPTIONS
+      throw std::out_of_range("SmallVector::at");
+#else
+      std::terminate();
+#endif
+    }
+    return data_[index];
+  }
+
+  T &at(size_t index)
+  {
+    return const_cast<T &>(static_cast<const SmallVector &>(*this).at(index));
+  }
+
+  void reserve(size_t capacity)
+  {
+    if (capacity > capacity_)
+    {
+      T *buffer = static_cast<T *>(::operator new(capacity * sizeof(T)));
+      MoveElementsTo(buffer);
+      data_     = buffer;
+      capacity_ = capacity;
+    }
+  }
+
+  template <class... Args>
+  T &emplace_back(Args &&... args)
+  {
+    if (size_ == capacity_)
+    {
+      // The new element is constructed before the others are moved, in case the arguments refer
+      // to an element of this vector.
+      size_t capacity = capacity_ * 2;
+      T *buffer       = static_cast<T *>(::operator new(capacity * sizeof(T)));
+      new (buffer + size_) T(std::forward<Args>(args)...);
+      MoveElementsTo(buffer);
+      data_     = buffer;
+      capacity_ = capacity;
+    }
+    else
+    {
+      new (data_ + size_) T(std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  /**
+   * Destroys the elements, keeping the capacity.
+   */
+  void clear() noexcept
+  {
+    for (size_t i = 0; i < size_; ++i)
+    {
+      data_[i].~T();
+    }
+    size_ = 0;
+  }
+
+private:
+  T *InlineData() noexcept { return reinterpret_cast<T *>(inline_storage_); }
+
+  const T *InlineData() const noexcept { return reinterpret_cast<const T *>(inline_storage_); }
+
+  /* Moves the elements into `buffer` and releases the current heap buffer, if any. */
+  void MoveElementsTo(T *buffer) noexcept
+  {
+    for (size_t i = 0; i < size_; ++i)
+    {
+      new (buffer + i) T(std::move(data_[i]));
+      data_[i].~T();
+    }
+    if (!is_inline())
+    {
+      ::operator delete(data_);
+    }
+  }
+
+  void ReleaseHeap() noexcept
+  {
+    if (!is_inline())
+    {
+      ::operator delete(data_);
+      data_     = InlineData();
+      capacity_ = N;
+    }
+  }
+
+  /* Takes the elements of `other`, which must be empty with no heap buffer. */
+  void MoveFrom(SmallVector &other)
+  {
+    if (other.is_inline())
+    {
+      for (size_t i = 0; i < other.size_; ++i)
+      {
+        new (data_ + i) T(std::move(other.data_[i]));
+      }
+      size_ = other.size_;
+      other.clear();
+      return;
+    }
+    data_           = other.data_;
+    size_           = other.size_;
+    capacity_       = other.capacity_;
+    other.data_     = other.InlineData();
+    other.size_     = 0;
+    other.capacity_ = N;
+  }
+
+  alignas(T) unsigned char inline_storage_[N * sizeof(T)];
+  T *data_         = InlineData();
+  size_t size_     = 0;
+  size_t capacity_ = N;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,41 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Process-wide switch turning the telemetry of the SDK off and back on at runtime, e.g. during an
+ * incident, including for the tracers, loggers and instruments libraries already hold.
+ *
+ * While it is off, Tracer::StartSpan returns a shared invalid span, Logger::Enabled returns false
+ * so that Logger::Log returns at once, and the synchronous instruments drop their measurements;
+ * none of them allocates. The switch is a single atomic flag, read before anything else.
+ */
+class TelemetrySwitch
+{
+public:
+  /**
+   * @return false if telemetry is switched off. On by default.
+   */
+  static bool IsEnabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Switches telemetry on or off, taking effect in every thread shortly after.
+   */
+  static void SetEnabled(bool enabled) noexcept;
+
+private:
+  static std::atomic<bool> enabled_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,66 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * Counts the items a processor dropped for each tenant, e.g. with fair queuing. Dropping is the
+ * slow path of a processor, so the counts are kept under a lock. Past max_tenants distinct
+ * tenants, the drops of the new ones are counted under kOtherTenants, to bound the memory a
+ * stream of unique keys may take.
+ */
+class TenantDropCounter
+{
+public:
+  /* The tenant the drops of the tenants beyond max_tenants are counted under. */
+  static constexpr const char *kOtherTenants = "<other>";
+
+  explicit TenantDropCounter(size_t max_tenants) : max_tenants_(max_tenants) {}
+
+  void RecordDropped(const std::string &tenant)
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = drops_.find(tenant);
+    if (it != drops_.end())
+    {
+      ++it->second;
+    }
+    else if (drops_.size() < max_tenants_)
+    {
+      drops_.emplace(tenant, 1);
+    }
+    else
+    {
+      ++drops_[kOtherTenants];
+    }
+  }
+
+  /* Returns the number of items dropped for each tenant which had drops. */
+  std::map<std::string, uint64_t> GetDrops() const
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    return std::map<std::string, uint64_t>(drops_.begin(), drops_.end());
+  }
+
+private:
+  const size_t max_tenants_;
+  mutable std::mutex lock_;
+  std::unordered_map<std::string, uint64_t> drops_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
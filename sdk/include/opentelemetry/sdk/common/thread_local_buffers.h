@@ -0,0 +1,202 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "opentelemetry/common/spin_lock_mutex.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/*
+ * Small per-thread buffers in front of the queue of a processor: each thread adds its elements to
+ * its own buffer, and hands the buffer off to the processor in bulk once it holds batch_size
+ * elements. A thread only touches the lock of its own buffer, which no other thread takes except
+ * to flush it, so adding an element costs no contended atomic operation.
+ *
+ * Elements wait in the buffers until they are handed off, which happens:
+ * - on the adding thread, when its buffer is full,
+ * - on the calling thread, for every buffer, at each Flush(); processors call it from their worker
+ *   thread at each export cycle, which also collects the buffers of idle threads,
+ * - on the exiting thread, for its buffers, when a thread exits.
+ *
+ * Each thread keeps its buffers in a thread-local list, one per ThreadLocalBuffers it added to,
+ * which are shared with the registry of their ThreadLocalBuffers. The buffers of an exited thread
+ * are removed from the registry by the next Flush(), and those of a destroyed ThreadLocalBuffers
+ * from the list by the next thread-local buffer its thread registers.
+ */
+template <class T>
+class ThreadLocalBuffers
+{
+public:
+  using Batch = std::vector<std::unique_ptr<T>>;
+
+  /**
+   * @param batch_size the number of elements a thread buffers before handing them off.
+   * @param hand_off receives the elements of a buffer, which it must leave empty. It is called
+   * with the lock of the buffer held, from the thread which filled, flushed or exited it.
+   */
+  ThreadLocalBuffers(size_t batch_size, std::function<void(Batch &)> hand_off)
+      : batch_size_(batch_size == 0 ? 1 : batch_size), hand_off_(std::move(hand_off))
+  {}
+
+  ThreadLocalBuffers(const ThreadLocalBuffers &)            = delete;
+  ThreadLocalBuffers &operator=(const ThreadLocalBuffers &) = delete;
+
+  /**
+   * Detaches the buffers, dropping their elements: the owner must Flush() first to keep them.
+   */
+  ~ThreadLocalBuffers()
+  {
+    std::lock_guard<std::mutex> registry_guard(registry_lock_);
+    for (auto &buffer : registry_)
+    {
+      std::lock_guard<opentelemetry::common::SpinLockMutex> guard(buffer->lock);
+      buffer->owner.store(nullptr, std::memory_order_relaxed);
+      buffer->elements.clear();
+    }
+  }
+
+  /**
+   * Adds an element to the buffer of the calling thread, and hands the buffer off if it is full.
+   */
+  void Add(std::unique_ptr<T> &&element) noexcept
+  {
+    Buffer &buffer = GetThreadBuffer();
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(buffer.lock);
+    buffer.elements.push_back(std::move(element));
+    if (buffer.elements.size() >= batch_size_)
+    {
+      hand_off_(buffer.elements);
+    }
+  }
+
+  /**
+   * Hands off the elements of the buffers of every thread, from the calling thread.
+   */
+  void Flush() noexcept
+  {
+    std::lock_guard<std::mutex> registry_guard(registry_lock_);
+    auto flush = [this](const std::shared_ptr<Buffer> &buffer) {
+      std::lock_guard<opentelemetry::common::SpinLockMutex> guard(buffer->lock);
+      if (!buffer->elements.empty())
+      {
+        hand_off_(buffer->elements);
+      }
+      return buffer->exited;
+    };
+    registry_.erase(std::remove_if(registry_.begin(), registry_.end(), flush), registry_.end());
+  }
+
+  /**
+   * Locks every buffer before a fork, so that no thread holds one of their locks across it.
+   * Released by AfterFork.
+   */
+  void PrepareFork() noexcept
+  {
+    registry_lock_.lock();
+    for (auto &buffer : registry_)
+    {
+      buffer->lock.lock();
+    }
+  }
+
+  /**
+   * Unlocks the buffers after a fork. In the child, the elements buffered by the threads of the
+   * parent are dropped: the parent exports them.
+   */
+  void AfterFork(bool is_child) noexcept
+  {
+    for (auto &buffer : registry_)
+    {
+      if (is_child)
+      {
+        buffer->elements.clear();
+      }
+      buffer->lock.unlock();
+    }
+    registry_lock_.unlock();
+  }
+
+private:
+  struct Buffer
+  {
+    opentelemetry::common::SpinLockMutex lock;
+    /* The ThreadLocalBuffers of the buffer, null once it is destroyed. Guarded by lock, read
+     * without it by the thread of the buffer to find its buffer. */
+    std::atomic<ThreadLocalBuffers *> owner;
+    /* Whether the thread of the buffer exited. Guarded by lock. */
+    bool exited = false;
+    Batch elements;
+  };
+
+  /* The buffers of a thread, handed off when it exits. */
+  struct ThreadBuffers
+  {
+    std::vector<std::shared_ptr<Buffer>> buffers;
+
+    ~ThreadBuffers()
+    {
+      for (auto &buffer : buffers)
+      {
+        std::lock_guard<opentelemetry::common::SpinLockMutex> guard(buffer->lock);
+        ThreadLocalBuffers *owner = buffer->owner.load(std::memory_order_relaxed);
+        if (owner != nullptr && !buffer->elements.empty())
+        {
+          owner->hand_off_(buffer->elements);
+        }
+        buffer->exited = true;
+      }
+    }
+  };
+
+  Buffer &GetThreadBuffer() noexcept
+  {
+    static thread_local ThreadBuffers thread_buffers;
+    auto &buffers = thread_buffers.buffers;
+    for (auto &buffer : buffers)
+    {
+      if (buffer->owner.load(std::memory_order_relaxed) == this)
+      {
+        return *buffer;
+      }
+    }
+
+    // First element of this thread: forget the buffers of destroyed owners, and register a new
+    // buffer.
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::shared_ptr<Buffer> &buffer) {
+                                   return buffer->owner.load(std::memory_order_relaxed) == nullptr;
+                                 }),
+                  buffers.end());
+    std::shared_ptr<Buffer> buffer(new Buffer);
+    buffer->owner.store(this, std::memory_order_relaxed);
+    buffer->elements.reserve(batch_size_);
+    {
+      std::lock_guard<std::mutex> registry_guard(registry_lock_);
+      registry_.push_back(buffer);
+    }
+    buffers.push_back(buffer);
+    return *buffer;
+  }
+
+  const size_t batch_size_;
+  const std::function<void(Batch &)> hand_off_;
+
+  /* Guards registry_. Always taken before the lock of a buffer. */
+  std::mutex registry_lock_;
+  std::vector<std::shared_ptr<Buffer>> registry_;
+};
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,64 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+/**
+ * The name, CPU affinity and priority of a background thread of the SDK: the worker threads of
+ * the batch processors, metric readers and export executors, the threads of the curl HTTP client
+ * and of zPages, so that telemetry work can be kept off the cores of latency-critical threads.
+ *
+ * Each field left to its default falls back on the process-wide defaults set with
+ * SetDefaultThreadOptions(), and these leave the thread as created: with the affinity and
+ * priority of the thread starting it.
+ */
+struct ThreadOptions
+{
+  /**
+   * The name of the thread, truncated to 15 characters on Linux. Empty for the name the SDK gives
+   * the thread, such as "otel-bsp" for a batch span processor.
+   */
+  std::string name;
+
+  /* The CPUs the thread may run on, empty to keep the affinity it inherits. Linux only. */
+  std::vector<int> cpu_affinity;
+
+  /* Whether to set the niceness of the thread to `nice`, from -20 to 19. Linux only. */
+  bool set_nice = false;
+  int nice      = 0;
+
+  /**
+   * Called on the thread once the above are applied, with its name, for anything else such as a
+   * real-time scheduling policy or a cgroup. Must not throw.
+   */
+  std::function<void(const std::string &name)> on_start;
+};
+
+/**
+ * Sets the options of the background threads the SDK starts afterwards, for the fields their own
+ * options leave to default. Threads already running are left unchanged.
+ */
+void SetDefaultThreadOptions(const ThreadOptions &options);
+
+ThreadOptions GetDefaultThreadOptions();
+
+/**
+ * Applies `options` to the calling thread, falling back on the process-wide defaults field by
+ * field, and on `default_name` for the name. Called first by each background thread of the SDK.
+ * Failures are logged, and leave the thread running as it is.
+ */
+void ApplyThreadOptions(const ThreadOptions &options, const char *default_name) noexcept;
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,46 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+/**
+ * Static tracepoints on the hot paths of the SDK, to observe it from the outside with perf,
+ * bpftrace or SystemTap without rebuilding it:
+ *
+ *   bpftrace -e 'usdt:./app:opentelemetry:batch_span_processor__drop { @drops = count(); }'
+ *
+ * They are USDT probes of the "opentelemetry" provider, only compiled in when the SDK is built with
+ * ENABLE_SDK_TRACEPOINTS (WITH_SDK_TRACEPOINTS in CMake, --//sdk:with_tracepoints in Bazel) on
+ * Linux with <sys/sdt.h> (systemtap-sdt-dev). A probe compiles to a single nop which a tracer
+ * patches when attached, its arguments are only evaluated into registers or the stack, so they
+ * must be cheap. Otherwise the macros expand to nothing.
+ *
+ * Probes:
+ * - span__start(trace_id, span_id): pointers to the 16 and 8 bytes of the ids of the started span,
+ * - span__end(trace_id, span_id, duration_ns): same, when the span is passed to its processor,
+ * - batch_span_processor__enqueue(queue_size) and batch_span_processor__drop(),
+ * - batch_log_processor__enqueue(queue_size) and batch_log_processor__drop(),
+ * - export__begin(signal, batch_size) and export__end(signal, batch_size, result), around the
+ *   exports of the batch processors, signal being "traces" or "logs",
+ * - collect__begin() and collect__end(duration_ns), around the collections of a metric reader,
+ * - log__emit(severity): a log record passed the severity check of its logger.
+ */
+
+#if defined(ENABLE_SDK_TRACEPOINTS) && defined(__linux__) && defined(__has_include)
+#  if __has_include(<sys/sdt.h>)
+#    include <sys/sdt.h>
+#    define OPENTELEMETRY_SDK_HAVE_TRACEPOINTS
+#  endif
+#endif
+
+#ifdef OPENTELEMETRY_SDK_HAVE_TRACEPOINTS
+#  define OTEL_SDK_TRACEPOINT0(name) DTRACE_PROBE(opentelemetry, name)
+#  define OTEL_SDK_TRACEPOINT1(name, a) DTRACE_PROBE1(opentelemetry, name, a)
+#  define OTEL_SDK_TRACEPOINT2(name, a, b) DTRACE_PROBE2(opentelemetry, name, a, b)
+#  define OTEL_SDK_TRACEPOINT3(name, a, b, c) DTRACE_PROBE3(opentelemetry, name, a, b, c)
+#else
+#  define OTEL_SDK_TRACEPOINT0(name)
+#  define OTEL_SDK_TRACEPOINT1(name, a)
+#  define OTEL_SDK_TRACEPOINT2(name, a, b)
+#  define OTEL_SDK_TRACEPOINT3(name, a, b, c)
+#endif
@@ -0,0 +1,106 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/attributemap_hash.h"
+#include "opentelemetry/version.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+
+namespace sdk
+{
+namespace instrumentationlibrary
+{
+
+/**
+ * The tracers, loggers or meters of a provider, keyed by the hash of their instrumentation
+ * library.
+ *
+ * Lookups search an immutable snapshot of the map, loaded atomically, and take no lock, so that
+ * getting an existing tracer from many threads does not serialize them. Insertions, which only
+ * happen once per instrumentation library, copy the snapshot under a mutex.
+ */
+template <class T>
+class InstrumentationLibraryMap
+{
+public:
+  /**
+   * @return the hash of an instrumentation library, and of the `name` of the object it is the
+   * library of, if any.
+   */
+  static size_t Hash(nostd::string_view library_name,
+                     nostd::string_view library_version,
+                     nostd::string_view schema_url,
+                     nostd::string_view name = "") noexcept
+  {
+    uint64_t seed = 0;
+    sdk::common::HashBytes(seed, library_name.data(), library_name.size());
+    sdk::common::HashBytes(seed, library_version.data(), library_version.size());
+    sdk::common::HashBytes(seed, schema_url.data(), schema_url.size());
+    sdk::common::HashBytes(seed, name.data(), name.size());
+    return static_cast<size_t>(sdk::common::FinalizeHash(seed));
+  }
+
+  /**
+   * @return the object of hash `hash` for which `equal` returns true, or nullptr.
+   */
+  template <class Equal>
+  std::shared_ptr<T> Find(size_t hash, Equal equal) const noexcept
+  {
+    auto snapshot = snapshot_.load();
+    auto range    = snapshot->equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (equal(*it->second))
+      {
+        return it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @return the object of hash `hash` for which `equal` returns true, inserting the one returned
+   * by `create` if there is none.
+   */
+  template <class Equal, class Create>
+  std::shared_ptr<T> FindOrInsert(size_t hash, Equal equal, Create create) noexcept
+  {
+    std::shared_ptr<T> value = Find(hash, equal);
+    if (value)
+    {
+      return value;
+    }
+    std::lock_guard<std::mutex> guard(lock_);
+    // Another thread may have inserted it while no lock was held.
+    value = Find(hash, equal);
+    if (value)
+    {
+      return value;
+    }
+    value = create();
+    std::shared_ptr<Map> snapshot(new Map(*snapshot_.load()));
+    snapshot->emplace(hash, value);
+    snapshot_.store(std::move(snapshot));
+    return value;
+  }
+
+private:
+  using Map = std::unordered_multimap<size_t, std::shared_ptr<T>>;
+
+  sdk::common::AtomicSharedPtr<const Map> snapshot_{std::shared_ptr<const Map>(new Map())};
+  std::mutex lock_;
+};
+
+}  // namespace instrumentationlibrary
+}  // namespace sdk
+
+OPENTELEMETRY_END_NAMESPACE
@@ -4,12 +4,20 @@
 #pragma once
 #ifdef ENABLE_LOGS_PREVIEW
 
+#  include "opentelemetry/sdk/common/batch_processor_stats.h"
+#  include "opentelemetry/sdk/common/batch_processor_synchronizer.h"
+#  include "opentelemetry/sdk/common/export_executor.h"
+#  include "opentelemetry/sdk/common/fork_handler.h"
 #  include "opentelemetry/sdk/common/circular_buffer.h"
+#  include "opentelemetry/sdk/common/record_journal.h"
+#  include "opentelemetry/sdk/common/recordable_pool.h"
+#  include "opentelemetry/sdk/common/recordable_slot_ring.h"
+#  include "opentelemetry/sdk/common/thread_options.h"
 #  include "opentelemetry/sdk/logs/exporter.h"
 #  include "opentelemetry/sdk/logs/processor.h"
 
 #  include <atomic>
-#  include <condition_variable>
+#  include <mutex>
 #  include <thread>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -36,14 +44,41 @@ class BatchLogProcessor : public LogProcessor
    * @param scheduled_delay_millis - The time interval between two consecutive exports.
    * @param max_export_batch_size - The maximum batch size of every export. It must be smaller or
    * equal to max_queue_size
+   * @param max_recycled_recordables - The maximum number of exported recordables kept to record
+   * later logs, those left in the batch by the exporter whose Recordable::Reset() returns true.
+   * 0 disables the reuse.
+   * @param max_export_batch_bytes - The maximum estimated size in bytes of the logs of an export,
+   * see Recordable::GetEstimatedSize. Larger batches are split into several exports, a log larger
+   * than it is exported alone. 0 disables the split.
+   * @param preallocate_recordables - Whether to make max_queue_size recordables up front, kept in
+   * a fixed ring of slots which MakeRecordable takes them from and the exported recordables are
+   * given back to, so that logging at a high rate neither allocates nor frees recordables. Only
+   * worthwhile with an exporter whose Recordable::Reset() returns true.
+   * @param executor - An executor, possibly shared with other processors and metric readers,
+   * running the export cycles instead of a worker thread of the processor. Null runs a worker
+   * thread.
+   * @param thread_options - The name, CPU affinity and niceness of the worker thread, named
+   * "otel-blp" by default. Unused with an executor.
+   * @param journal - A journal the logs are written to as they are queued, in the encoding of
+   * their recordable, see Recordable::AppendJournalRecord, so that the logs a crash lost can be
+   * recovered from its file. It keeps the latest logs queued, exported or not. Null disables it.
    */
   explicit BatchLogProcessor(
       std::unique_ptr<LogExporter> &&exporter,
       const size_t max_queue_size                            = 2048,
       const std::chrono::milliseconds scheduled_delay_millis = std::chrono::milliseconds(5000),
-      const size_t max_export_batch_size                     = 512);
+      const size_t max_export_batch_size                     = 512,
+      const size_t max_recycled_recordables                  = 2048,
+      const size_t max_export_batch_bytes                    = 0,
+      const bool preallocate_recordables                     = false,
+      std::shared_ptr<common::ExportExecutor> executor       = nullptr,
+      const common::ThreadOptions &thread_options            = common::ThreadOptions(),
+      std::shared_ptr<common::RecordJournal> journal         = nullptr);
 
-  /** Makes a new recordable **/
+  /**
+   * Takes a recordable from the preallocated slots, or reuses the recordable of an exported log,
+   * or makes a new recordable
+   */
   std::unique_ptr<Recordable> MakeRecordable() noexcept override;
 
   /**
@@ -54,9 +89,10 @@ class BatchLogProcessor : public LogProcessor
   void OnReceive(std::unique_ptr<Recordable> &&record) noexcept override;
 
   /**
-   * Export all log records that have not been exported yet.
+   * Export all log records that have not been exported yet. Blocks until the worker thread has
+   * exported them or `timeout` expires.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * @return true if all log records were exported within the timeout, false otherwise.
    */
   bool ForceFlush(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -71,6 +107,13 @@ class BatchLogProcessor : public LogProcessor
   bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
+  /**
+   * Returns a snapshot of the processor's counters: log records enqueued, dropped because the queue
+   * was full and exported, export durations and batch sizes, and the current queue occupancy.
+   * Safe to call from any thread.
+   */
+  common::BatchProcessorStats GetStats() const noexcept;
+
   /**
    * Class destructor which invokes the Shutdown() method.
    */
@@ -82,16 +125,59 @@ class BatchLogProcessor : public LogProcessor
    */
   void DoBackgroundWork();
 
+  /**
+   * Runs an export cycle of the worker, once woken up with the force flush `flush_generation`, or
+   * 0, and sets worker_timeout_ to the delay until the next cycle.
+   *
+   * @return false if the worker must stop, because of a shutdown or a fork.
+   */
+  bool RunCycle(uint64_t flush_generation);
+
+  /**
+   * The task run by executor_, running an export cycle.
+   *
+   * @return the delay until the next cycle.
+   */
+  std::chrono::microseconds RunWorkerTask();
+
+  /**
+   * Starts the worker thread, or adds the task of executor_. It is started by the first log
+   * record rather than by the constructor, so that creating a processor is cheap and processors
+   * which never see a log record cost no thread.
+   */
+  void StartWorker() noexcept;
+
+  /**
+   * Starts the worker thread again after a fork, or resumes the task of executor_.
+   */
+  void RestartWorker();
+
   /**
    * Exports all logs to the configured exporter.
    *
    * @param was_force_flush_called - A flag to check if the current export is the result
-   *                                 of a call to ForceFlush method. If true, then we have to
-   *                                 notify the main thread to wake it up in the ForceFlush
-   *                                 method.
+   *                                 of a call to ForceFlush method. If true, then everything in
+   *                                 the buffer is exported regardless of max_export_batch_size.
    */
   void Export(const bool was_for_flush_called);
 
+  /**
+   * Called before a fork: stops the worker thread, leaving the queued log records to the worker
+   * started after the fork. Holds shutdown_m_ until after the fork.
+   */
+  void PrepareFork();
+
+  /**
+   * Called in the parent after a fork: starts a new worker thread.
+   */
+  void ParentAfterFork();
+
+  /**
+   * Called in the child after a fork: drops the log records queued by the parent, which exports
+   * them, and starts a new worker thread.
+   */
+  void ChildAfterFork();
+
   /**
    * Called when Shutdown() is invoked. Completely drains the queue of all log records and
    * passes them to the exporter.
@@ -105,21 +191,47 @@ class BatchLogProcessor : public LogProcessor
   const size_t max_queue_size_;
   const std::chrono::milliseconds scheduled_delay_millis_;
   const size_t max_export_batch_size_;
+  const size_t max_export_batch_bytes_;
+
+  /* The delay until the next export cycle, only touched by the worker */
+  std::chrono::milliseconds worker_timeout_;
 
   /* Synchronization primitives */
-  std::condition_variable cv_, force_flush_cv_;
-  std::mutex cv_m_, force_flush_cv_m_, shutdown_m_;
+  std::mutex shutdown_m_;
+  common::BatchProcessorSynchronizer synchronizer_;
 
   /* The buffer/queue to which the ended logs are added */
   common::CircularBuffer<Recordable> buffer_;
 
+  /* The batch being exported, reused by each export of the worker thread */
+  std::vector<std::unique_ptr<Recordable>> export_batch_;
+
+  /* The exported recordables waiting to be reused by MakeRecordable */
+  common::RecordablePool<Recordable> recycled_;
+
+  /* The preallocated recordables, null unless preallocate_recordables was set */
+  std::unique_ptr<common::RecordableSlotRing<Recordable>> slots_;
+
   /* Important boolean flags to handle the workflow of the processor */
   std::atomic<bool> is_shutdown_{false};
-  std::atomic<bool> is_force_flush_{false};
-  std::atomic<bool> is_force_flush_notified_{false};
+  std::atomic<bool> is_worker_started_{false};
 
-  /* The background worker thread */
+  /* Counters behind GetStats() */
+  common::BatchProcessorStatsRecorder stats_;
+
+  /* The journal of the queued logs, or null */
+  std::shared_ptr<common::RecordJournal> journal_;
+
+  /* The background worker thread, and its options */
   std::thread worker_thread_;
+  const common::ThreadOptions thread_options_;
+
+  /* The executor running the worker as a task instead, and that task, both null with a thread */
+  std::shared_ptr<common::ExportExecutor> executor_;
+  std::shared_ptr<common::ExportExecutor::Task> worker_task_;
+
+  /* Stops and restarts worker_thread_ around forks. Declared last, to be unregistered first. */
+  common::ForkHandlerRegistration fork_handler_;
 };
 
 }  // namespace logs
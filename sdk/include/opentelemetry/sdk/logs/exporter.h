@@ -37,7 +37,8 @@ class LogExporter
 
   /**
    * Exports the batch of log records to their export destination.
-   * This method must not be called concurrently for the same exporter instance.
+   * This method must not be called concurrently for the same exporter instance, unless
+   * IsExportThreadSafe() returns true.
    * The exporter may attempt to retry sending the batch, but should drop
    * and return kFailure after a certain timeout.
    * @param records a span of unique pointers to log records
@@ -46,6 +47,21 @@ class LogExporter
   virtual sdk::common::ExportResult Export(
       const nostd::span<std::unique_ptr<Recordable>> &records) noexcept = 0;
 
+  /**
+   * Called by the processors with the records of a batch once Export returned, so that exporters
+   * which pool their recordables (see LogRecordPool) can take them back. Records which Export
+   * moved out of the batch are null. By default the records are destroyed by the processor.
+   * @param records the records of the batch
+   */
+  virtual void Recycle(nostd::span<std::unique_ptr<Recordable>> /* records */) noexcept {}
+
+  /**
+   * Whether Export and Recycle may be called concurrently from several threads, e.g. for exporters
+   * writing each batch with a single thread-safe call. The SimpleLogProcessor then exports the
+   * records of concurrent callers concurrently instead of one at a time. False by default.
+   */
+  virtual bool IsExportThreadSafe() const noexcept { return false; }
+
   /**
    * Marks the exporter as ShutDown and cleans up any resources as required.
    * Shutdown should be called only once for each Exporter instance.
@@ -7,6 +7,7 @@
 #  include <map>
 #  include <unordered_map>
 #  include "opentelemetry/sdk/common/attribute_utils.h"
+#  include "opentelemetry/sdk/common/binary_encoding.h"
 #  include "opentelemetry/sdk/logs/recordable.h"
 #  include "opentelemetry/sdk/resource/resource.h"
 #  include "opentelemetry/version.h"
@@ -30,7 +31,7 @@ class LogRecord final : public Recordable
   // except the severity field, which must be set manually (an enum with no default value).
   opentelemetry::logs::Severity severity_                 = opentelemetry::logs::Severity::kInvalid;
   const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
-  common::AttributeMap attributes_map_;
+  common::LogAttributeMap attributes_map_;
   std::string body_;  // Currently a simple string, but should be changed to "Any" type
   opentelemetry::trace::TraceId trace_id_;
   opentelemetry::trace::SpanId span_id_;
@@ -53,7 +54,10 @@ class LogRecord final : public Recordable
    * Set body field for this log.
    * @param message the body to set
    */
-  void SetBody(nostd::string_view message) noexcept override { body_ = std::string(message); }
+  void SetBody(nostd::string_view message) noexcept override
+  {
+    body_.assign(message.data(), message.size());
+  }
 
   /**
    * Set Resource of this log
@@ -112,6 +116,64 @@ class LogRecord final : public Recordable
     timestamp_ = timestamp;
   }
 
+  size_t GetEstimatedSize() const noexcept override
+  {
+    // The timestamp, severity, trace and span ids, flags and framing of the log.
+    return 48 + body_.size() + common::EstimateAttributesSize(attributes_map_);
+  }
+
+  common::JournalRecordType AppendJournalRecord(std::string &out) const noexcept override
+  {
+    AppendBinary(out);
+    return common::JournalRecordType::kLogRecord;
+  }
+
+  /**
+   * Appends the log, without its resource and instrumentation library, in the binary encoding of
+   * common/binary_encoding.h: its int64_t timestamp since the epoch in nanoseconds, uint8_t
+   * severity, trace id, span id, uint8_t trace flags, body and attributes.
+   */
+  void AppendBinary(std::string &out) const
+  {
+    common::AppendBinary(out, static_cast<int64_t>(timestamp_.time_since_epoch().count()));
+    common::AppendBinary(out, static_cast<uint8_t>(severity_));
+    common::AppendBinaryBytes(out, trace_id_.Id().data(), opentelemetry::trace::TraceId::kSize);
+    common::AppendBinaryBytes(out, span_id_.Id().data(), opentelemetry::trace::SpanId::kSize);
+    common::AppendBinary(out, trace_flags_.flags());
+    common::AppendBinaryString(out, body_);
+    common::AppendBinaryAttributes(out, attributes_map_);
+  }
+
+  /**
+   * Records a log appended by AppendBinary, leaving the resource and instrumentation library as
+   * they are.
+   * @return false if the encoding is truncated or invalid
+   */
+  bool ReadBinary(common::BinaryDecoder &in)
+  {
+    int64_t timestamp = 0;
+    uint8_t severity  = 0;
+    uint8_t trace_id[opentelemetry::trace::TraceId::kSize];
+    uint8_t span_id[opentelemetry::trace::SpanId::kSize];
+    uint8_t trace_flags = 0;
+    if (!in.GetValue(timestamp) || !in.GetValue(severity) ||
+        !in.GetBytes(trace_id, sizeof(trace_id)) || !in.GetBytes(span_id, sizeof(span_id)) ||
+        !in.GetValue(trace_flags) || !in.GetString(body_))
+    {
+      return false;
+    }
+    timestamp_   = opentelemetry::common::SystemTimestamp(std::chrono::nanoseconds(timestamp));
+    severity_    = static_cast<opentelemetry::logs::Severity>(severity);
+    trace_id_    = opentelemetry::trace::TraceId(trace_id);
+    span_id_     = opentelemetry::trace::SpanId(span_id);
+    trace_flags_ = opentelemetry::trace::TraceFlags(trace_flags);
+    return in.GetAttributes([&](std::string &&key, common::OwnedAttributeValue &&value) {
+      common::ViewAttributeValue(value, [&](const opentelemetry::common::AttributeValue &view) {
+        attributes_map_.SetAttribute(key, view);
+      });
+    });
+  }
+
   /************************** Getters for each field ****************************/
 
   /**
@@ -143,10 +205,7 @@ class LogRecord final : public Recordable
    * Get the attributes for this log
    * @return the attributes for this log
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attributes_map_.GetAttributes();
-  }
+  const common::LogAttributeMap &GetAttributes() const noexcept { return attributes_map_; }
 
   /**
    * Get the trace id for this log
@@ -183,6 +242,24 @@ class LogRecord final : public Recordable
     instrumentation_library_ = &instrumentation_library;
   }
 
+  /**
+   * Clear all the fields of this log, keeping the memory of the body and the attribute map.
+   * @return true
+   */
+  bool Reset() noexcept override
+  {
+    severity_ = opentelemetry::logs::Severity::kInvalid;
+    resource_ = nullptr;
+    attributes_map_.clear();
+    body_.clear();
+    trace_id_                = opentelemetry::trace::TraceId();
+    span_id_                 = opentelemetry::trace::SpanId();
+    trace_flags_             = opentelemetry::trace::TraceFlags();
+    timestamp_               = opentelemetry::common::SystemTimestamp();
+    instrumentation_library_ = nullptr;
+    return true;
+  }
+
 private:
   const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
       *instrumentation_library_ = nullptr;
@@ -5,10 +5,12 @@
 #ifdef ENABLE_LOGS_PREVIEW
 
 #  include "opentelemetry/logs/logger.h"
+#  include "opentelemetry/sdk/common/telemetry_switch.h"
 #  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #  include "opentelemetry/sdk/logs/logger_context.h"
 #  include "opentelemetry/sdk/logs/logger_provider.h"
 
+#  include <atomic>
 #  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -37,6 +39,31 @@ class Logger final : public opentelemetry::logs::Logger
    */
   const opentelemetry::nostd::string_view GetName() noexcept override;
 
+  /**
+   * Returns whether a log event of the given severity would be passed to the processor: the
+   * logger has a processor, and the severity is at least the minimum severity of the logger.
+   */
+  bool Enabled(opentelemetry::logs::Severity severity) const noexcept override
+  {
+    return common::TelemetrySwitch::IsEnabled() && context_ != nullptr &&
+           severity >= minimum_severity_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Sets the minimum severity of the log events recorded by this logger. Log events below it are
+   * dropped by Log before any recordable is made. Defaults to kInvalid, which records everything.
+   */
+  void SetMinimumSeverity(opentelemetry::logs::Severity severity) noexcept
+  {
+    minimum_severity_.store(severity, std::memory_order_relaxed);
+  }
+
+  /** Returns the minimum severity of the log events recorded by this logger */
+  opentelemetry::logs::Severity GetMinimumSeverity() const noexcept
+  {
+    return minimum_severity_.load(std::memory_order_relaxed);
+  }
+
   /**
    * Writes a log record into the processor.
    * @param severity the severity level of the log event.
@@ -69,6 +96,9 @@ class Logger final : public opentelemetry::logs::Logger
   // logger-context.
   std::unique_ptr<instrumentationlibrary::InstrumentationLibrary> instrumentation_library_;
   std::shared_ptr<LoggerContext> context_;
+
+  std::atomic<opentelemetry::logs::Severity> minimum_severity_{
+      opentelemetry::logs::Severity::kInvalid};
 };
 
 }  // namespace logs
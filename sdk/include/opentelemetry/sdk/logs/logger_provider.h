@@ -13,6 +13,7 @@
 #  include "opentelemetry/logs/noop.h"
 #  include "opentelemetry/nostd/shared_ptr.h"
 #  include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library_map.h"
 #  include "opentelemetry/sdk/logs/logger.h"
 #  include "opentelemetry/sdk/logs/logger_context.h"
 #  include "opentelemetry/sdk/logs/processor.h"
@@ -121,9 +122,8 @@ class LoggerProvider final : public opentelemetry::logs::LoggerProvider
 
 private:
   // order of declaration is important here - loggers should destroy only after context.
-  std::vector<std::shared_ptr<opentelemetry::sdk::logs::Logger>> loggers_;
+  instrumentationlibrary::InstrumentationLibraryMap<opentelemetry::sdk::logs::Logger> loggers_;
   std::shared_ptr<sdk::logs::LoggerContext> context_;
-  std::mutex lock_;
 };
 }  // namespace logs
 }  // namespace sdk
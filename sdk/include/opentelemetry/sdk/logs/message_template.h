@@ -0,0 +1,130 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include <sstream>
+#  include <string>
+#  include <vector>
+
+#  include "opentelemetry/logs/logger.h"
+#  include "opentelemetry/nostd/string_view.h"
+#  include "opentelemetry/sdk/common/attribute_utils.h"
+#  include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+namespace detail
+{
+template <class T>
+void AppendTemplateArgument(const T &value, std::ostringstream &out)
+{
+  out << value;
+}
+
+inline void AppendTemplateArgument(bool value, std::ostringstream &out)
+{
+  out << (value ? "true" : "false");
+}
+
+inline void AppendTemplateArgument(uint8_t value, std::ostringstream &out)
+{
+  out << static_cast<unsigned>(value);
+}
+
+template <class T>
+void AppendTemplateArgument(const std::vector<T> &values, std::ostringstream &out)
+{
+  out << '[';
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (i > 0)
+    {
+      out << ", ";
+    }
+    AppendTemplateArgument(static_cast<const T &>(values[i]), out);
+  }
+  out << ']';
+}
+
+// std::vector<bool> holds no bools to refer to.
+inline void AppendTemplateArgument(const std::vector<bool> &values, std::ostringstream &out)
+{
+  out << '[';
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    out << (i > 0 ? ", " : "") << (values[i] ? "true" : "false");
+  }
+  out << ']';
+}
+
+// Appends the value of an OwnedAttributeValue to out.
+struct TemplateArgumentAppender
+{
+  std::ostringstream &out;
+
+  template <class T>
+  void operator()(const T &value)
+  {
+    AppendTemplateArgument(value, out);
+  }
+};
+}  // namespace detail
+
+/**
+ * Formats the message of a log written by opentelemetry::logs::Logger::LogTemplate: replaces each
+ * {} placeholder of the message template, its body, by the argument of the same rank among its
+ * attributes. Placeholders without an argument are left as they are.
+ *
+ * Exporters call it for the backends which expect the message formatted; the application thread
+ * only stores the template and the arguments.
+ * @param message_template the body of the log
+ * @param attributes the attributes of the log, e.g. LogRecord::GetAttributes()
+ * @return the formatted message
+ */
+template <class AttributeMap>
+std::string FormatMessageTemplate(nostd::string_view message_template,
+                                  const AttributeMap &attributes)
+{
+  size_t pos = message_template.find('{');
+  if (pos == nostd::string_view::npos)
+  {
+    return std::string(message_template.data(), message_template.size());
+  }
+
+  std::ostringstream out;
+  size_t argument = 0;
+  size_t start    = 0;
+  while (pos != nostd::string_view::npos)
+  {
+    if (pos + 1 == message_template.size() || message_template[pos + 1] != '}')
+    {
+      pos = message_template.find('{', pos + 1);
+      continue;
+    }
+    out << message_template.substr(start, pos - start);
+    start = pos + 2;
+    pos   = message_template.find('{', start);
+
+    auto it = argument < opentelemetry::logs::Logger::kMaxLogTemplateArguments
+                  ? attributes.find(std::string(
+                        opentelemetry::logs::Logger::GetLogTemplateArgumentKey(argument++)))
+                  : attributes.end();
+    if (it == attributes.end())
+    {
+      out << "{}";
+      continue;
+    }
+    nostd::visit(detail::TemplateArgumentAppender{out}, it->second);
+  }
+  out << message_template.substr(start);
+  return out.str();
+}
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -5,6 +5,7 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 
+#  include <functional>
 #  include <memory>
 #  include <vector>
 
@@ -19,6 +20,19 @@ namespace sdk
 namespace logs
 {
 
+/** Instantiation options. */
+struct MultiLogProcessorOptions
+{
+  /**
+   * Whether to record each log once, instead of once per processor. The log is recorded into a
+   * PooledLogRecord, and each processor receives a SharedLogRecord referring to it; the processors
+   * replay it into a recordable of their own exporter, the batch processor doing so on its worker
+   * thread. Every processor must then be a BatchLogProcessor, a SimpleLogProcessor or a processor
+   * which handles Recordable::GetSharedLogRecord.
+   */
+  bool fan_out = false;
+};
+
 /**
  * Log processor allow hooks for receive method invocations.
  *
@@ -28,7 +42,8 @@ namespace logs
 class MultiLogProcessor : public LogProcessor
 {
 public:
-  MultiLogProcessor(std::vector<std::unique_ptr<LogProcessor>> &&processors);
+  MultiLogProcessor(std::vector<std::unique_ptr<LogProcessor>> &&processors,
+                    const MultiLogProcessorOptions &options = MultiLogProcessorOptions());
   ~MultiLogProcessor();
 
   void AddProcessor(std::unique_ptr<LogProcessor> &&processor);
@@ -42,7 +57,8 @@ class MultiLogProcessor : public LogProcessor
   void OnReceive(std::unique_ptr<Recordable> &&record) noexcept override;
 
   /**
-   * Exports all log records that have not yet been exported to the configured Exporter.
+   * Exports all log records that have not yet been exported to the configured Exporter. The
+   * processors are flushed concurrently, each until the same deadline.
    * @param timeout that the forceflush is required to finish within.
    * @return a result code indicating whether it succeeded, failed or timed out
    */
@@ -50,7 +66,8 @@ class MultiLogProcessor : public LogProcessor
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
   /**
-   * Shuts down the processor and does any cleanup required.
+   * Shuts down the processor and does any cleanup required. The processors are shut down
+   * concurrently, each until the same deadline.
    * ShutDown should only be called once for each processor.
    * @param timeout minimum amount of microseconds to wait for
    * shutdown before giving up and returning failure.
@@ -60,7 +77,17 @@ class MultiLogProcessor : public LogProcessor
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
 private:
+  /**
+   * Runs `operation` on each processor concurrently, and logs the processors which failed or
+   * missed the deadline, `timeout` from now.
+   */
+  bool ForEachProcessorConcurrently(
+      const char *name,
+      std::chrono::microseconds timeout,
+      const std::function<bool(LogProcessor &, std::chrono::microseconds)> &operation) noexcept;
+
   std::vector<std::unique_ptr<LogProcessor>> processors_;
+  const bool fan_out_;
 };
 }  // namespace logs
 }  // namespace sdk
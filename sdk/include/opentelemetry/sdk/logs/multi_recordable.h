@@ -47,6 +47,12 @@ class MultiRecordable final : public Recordable
    */
   void SetBody(nostd::string_view message) noexcept override;
 
+  /**
+   * Set body field for this log, keeping the type of the value.
+   * @param message the body to set
+   */
+  void SetBodyValue(const opentelemetry::common::AttributeValue &message) noexcept override;
+
   /**
    * Set Resource of this log
    * @param Resource the resource to set
@@ -0,0 +1,215 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include <array>
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/nostd/function_ref.h"
+#  include "opentelemetry/nostd/span.h"
+#  include "opentelemetry/sdk/common/attribute_utils.h"
+#  include "opentelemetry/sdk/logs/recordable.h"
+#  include "opentelemetry/sdk/resource/resource.h"
+#  include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+
+/**
+ * A Recordable meant to be reused: its body keeps the type it was given, and its first
+ * kInlineAttributes attributes are stored in the record itself rather than in a hash map. Reset()
+ * clears the record but keeps the capacity of its strings and vectors, so that a record taken
+ * from a LogRecordPool usually does not allocate at all.
+ */
+class PooledLogRecord final : public Recordable
+{
+public:
+  static constexpr size_t kInlineAttributes = 8;
+
+  void SetTimestamp(opentelemetry::common::SystemTimestamp timestamp) noexcept override
+  {
+    timestamp_ = timestamp;
+  }
+
+  void SetSeverity(opentelemetry::logs::Severity severity) noexcept override
+  {
+    severity_ = severity;
+  }
+
+  void SetBody(nostd::string_view message) noexcept override;
+
+  void SetBodyValue(const opentelemetry::common::AttributeValue &message) noexcept override;
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept override
+  {
+    resource_ = &resource;
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override;
+
+  void SetTraceId(opentelemetry::trace::TraceId trace_id) noexcept override
+  {
+    trace_id_ = trace_id;
+  }
+
+  void SetSpanId(opentelemetry::trace::SpanId span_id) noexcept override { span_id_ = span_id; }
+
+  void SetTraceFlags(opentelemetry::trace::TraceFlags trace_flags) noexcept override
+  {
+    trace_flags_ = trace_flags;
+  }
+
+  void SetInstrumentationLibrary(
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+          &instrumentation_library) noexcept override
+  {
+    instrumentation_library_ = &instrumentation_library;
+  }
+
+  opentelemetry::common::SystemTimestamp GetTimestamp() const noexcept { return timestamp_; }
+
+  opentelemetry::logs::Severity GetSeverity() const noexcept { return severity_; }
+
+  /**
+   * Get the body of this log, a string unless it was set with SetBodyValue.
+   */
+  const common::OwnedAttributeValue &GetBody() const noexcept { return body_; }
+
+  const opentelemetry::sdk::resource::Resource &GetResource() const noexcept
+  {
+    if (nullptr == resource_)
+    {
+      return sdk::resource::Resource::GetDefault();
+    }
+    return *resource_;
+  }
+
+  opentelemetry::trace::TraceId GetTraceId() const noexcept { return trace_id_; }
+
+  opentelemetry::trace::SpanId GetSpanId() const noexcept { return span_id_; }
+
+  opentelemetry::trace::TraceFlags GetTraceFlags() const noexcept { return trace_flags_; }
+
+  /**
+   * Get the instrumentation library of this log, nullptr if it was not set.
+   */
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary *
+  GetInstrumentationLibrary() const noexcept
+  {
+    return instrumentation_library_;
+  }
+
+  size_t GetAttributeCount() const noexcept { return attribute_count_; }
+
+  /**
+   * Iterate over the attributes in the order they were first set.
+   * @param callback called with each attribute, returns false to stop the iteration
+   */
+  void ForEachAttribute(
+      nostd::function_ref<bool(nostd::string_view, const common::OwnedAttributeValue &)> callback)
+      const noexcept;
+
+  /**
+   * Records this log into another recordable, as if the log had been recorded there in the first
+   * place.
+   */
+  void Replay(Recordable &target) const noexcept;
+
+  /**
+   * Clear all the fields of this log, keeping the memory of the body and attributes.
+   * @return true
+   */
+  bool Reset() noexcept override;
+
+private:
+  struct Attribute
+  {
+    std::string key;
+    common::OwnedAttributeValue value;
+  };
+
+  Attribute &GetAttribute(size_t index) noexcept
+  {
+    return index < kInlineAttributes ? inline_attributes_[index]
+                                     : overflow_attributes_[index - kInlineAttributes];
+  }
+
+  const Attribute &GetAttribute(size_t index) const noexcept
+  {
+    return index < kInlineAttributes ? inline_attributes_[index]
+                                     : overflow_attributes_[index - kInlineAttributes];
+  }
+
+  opentelemetry::common::SystemTimestamp timestamp_;
+  opentelemetry::logs::Severity severity_                 = opentelemetry::logs::Severity::kInvalid;
+  common::OwnedAttributeValue body_                       = std::string();
+  const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
+  opentelemetry::trace::TraceId trace_id_;
+  opentelemetry::trace::SpanId span_id_;
+  opentelemetry::trace::TraceFlags trace_flags_;
+  const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+      *instrumentation_library_ = nullptr;
+
+  size_t attribute_count_ = 0;
+  std::array<Attribute, kInlineAttributes> inline_attributes_;
+  // Attributes beyond kInlineAttributes. Its elements are kept by Reset() to be reused.
+  std::vector<Attribute> overflow_attributes_;
+};
+
+/**
+ * A thread-safe pool of PooledLogRecord, for exporters which recycle their recordables:
+ *
+ *   std::unique_ptr<Recordable> MakeRecordable() noexcept override
+ *   {
+ *     return pool_.MakeRecordable();
+ *   }
+ *
+ *   void Recycle(nostd::span<std::unique_ptr<Recordable>> records) noexcept override
+ *   {
+ *     pool_.Recycle(records);
+ *   }
+ */
+class LogRecordPool
+{
+public:
+  /**
+   * @param max_size the maximum number of records kept for reuse
+   */
+  explicit LogRecordPool(size_t max_size = 2048) : max_size_(max_size) {}
+
+  /**
+   * Returns a record of the pool, or a new one if the pool is empty.
+   */
+  std::unique_ptr<Recordable> MakeRecordable() noexcept;
+
+  /**
+   * Returns records to the pool, resetting them. The records must have been made by
+   * MakeRecordable of this pool; null records are skipped, and those beyond max_size are
+   * destroyed.
+   */
+  void Recycle(nostd::span<std::unique_ptr<Recordable>> records) noexcept;
+
+  /**
+   * Returns the number of records waiting to be reused.
+   */
+  size_t GetSize() const noexcept;
+
+private:
+  const size_t max_size_;
+  mutable opentelemetry::common::SpinLockMutex lock_;
+  std::vector<std::unique_ptr<PooledLogRecord>> free_records_;
+};
+
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
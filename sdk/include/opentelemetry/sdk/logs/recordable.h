@@ -9,6 +9,7 @@
 #  include "opentelemetry/common/timestamp.h"
 #  include "opentelemetry/logs/severity.h"
 #  include "opentelemetry/sdk/common/empty_attributes.h"
+#  include "opentelemetry/sdk/common/record_journal.h"
 #  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #  include "opentelemetry/sdk/resource/resource.h"
 #  include "opentelemetry/trace/span.h"
@@ -18,11 +19,15 @@
 #  include "opentelemetry/trace/trace_id.h"
 #  include "opentelemetry/version.h"
 
+#  include <string>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace logs
 {
+class PooledLogRecord;
+
 /**
  * Maintains a representation of a log in a format that can be processed by a recorder.
  *
@@ -51,6 +56,24 @@ class Recordable
    */
   virtual void SetBody(nostd::string_view message) noexcept = 0;
 
+  /**
+   * Set body field for this log, keeping the type of the value. Recordables which only store
+   * strings may leave this to the default implementation, which forwards string values to
+   * SetBody and ignores the others.
+   * @param message the body to set
+   */
+  virtual void SetBodyValue(const opentelemetry::common::AttributeValue &message) noexcept
+  {
+    if (nostd::holds_alternative<nostd::string_view>(message))
+    {
+      SetBody(nostd::get<nostd::string_view>(message));
+    }
+    else if (nostd::holds_alternative<const char *>(message))
+    {
+      SetBody(nostd::get<const char *>(message));
+    }
+  }
+
   /**
    * Set Resource of this log
    * @param Resource the resource to set
@@ -90,6 +113,39 @@ class Recordable
   virtual void SetInstrumentationLibrary(
       const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
           &instrumentation_library) noexcept = 0;
+
+  /**
+   * Clear the recordable so that it can record another log, keeping the memory it allocated.
+   * Processors call it once the recordable was exported, and reuse it if it returns true.
+   * @return false if the recordable cannot be reused, the default
+   */
+  virtual bool Reset() noexcept { return false; }
+
+  /**
+   * Returns the log this recordable stands for when the log was recorded once and shared between
+   * several processors, see MultiLogProcessorOptions::fan_out. Processors replay it into a
+   * recordable of their own exporter before exporting it.
+   * @return nullptr if the recordable holds its own log, the default
+   */
+  virtual const PooledLogRecord *GetSharedLogRecord() const noexcept { return nullptr; }
+
+  /**
+   * Estimates the number of bytes of the log once serialized by the exporter. Batch processors
+   * use it to keep the payload of each export under their max_export_batch_bytes.
+   * @return 0 if the size is unknown, the default
+   */
+  virtual size_t GetEstimatedSize() const noexcept { return 0; }
+
+  /**
+   * Appends the log to `out` in an encoding of the recordable, for the journal of a batch
+   * processor, see the journal of BatchLogProcessor.
+   * @return the type of the encoding, JournalRecordType::kNone if the recordable cannot encode
+   * itself, the default, which leaves the log out of the journal
+   */
+  virtual common::JournalRecordType AppendJournalRecord(std::string & /* out */) const noexcept
+  {
+    return common::JournalRecordType::kNone;
+  }
 };
 }  // namespace logs
 }  // namespace sdk
@@ -0,0 +1,87 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include <memory>
+
+#  include "opentelemetry/sdk/logs/pooled_log_record.h"
+#  include "opentelemetry/sdk/logs/recordable.h"
+#  include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+/**
+ * A reference to a log which was recorded once into a PooledLogRecord, and is shared by the
+ * processors of a fan-out MultiLogProcessor. The log is immutable: the setters do nothing. It is
+ * destroyed along with the last SharedLogRecord referring to it.
+ */
+class SharedLogRecord final : public Recordable
+{
+public:
+  explicit SharedLogRecord(std::shared_ptr<const PooledLogRecord> record) noexcept
+      : record_(std::move(record))
+  {}
+
+  const PooledLogRecord *GetSharedLogRecord() const noexcept override { return record_.get(); }
+
+  void SetTimestamp(opentelemetry::common::SystemTimestamp /* timestamp */) noexcept override {}
+
+  void SetSeverity(opentelemetry::logs::Severity /* severity */) noexcept override {}
+
+  void SetBody(nostd::string_view /* message */) noexcept override {}
+
+  void SetResource(const opentelemetry::sdk::resource::Resource & /* resource */) noexcept override
+  {}
+
+  void SetAttribute(nostd::string_view /* key */,
+                    const opentelemetry::common::AttributeValue & /* value */) noexcept override
+  {}
+
+  void SetTraceId(opentelemetry::trace::TraceId /* trace_id */) noexcept override {}
+
+  void SetSpanId(opentelemetry::trace::SpanId /* span_id */) noexcept override {}
+
+  void SetTraceFlags(opentelemetry::trace::TraceFlags /* trace_flags */) noexcept override {}
+
+  void SetInstrumentationLibrary(
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+          & /* instrumentation_library */) noexcept override
+  {}
+
+private:
+  std::shared_ptr<const PooledLogRecord> record_;
+};
+
+/**
+ * Replaces a recordable standing for a shared log with a recordable made by `make_recordable`,
+ * into which the shared log is replayed. Other recordables are left as they are.
+ */
+template <class MakeRecordable>
+void ResolveSharedRecordable(std::unique_ptr<Recordable> &recordable,
+                             MakeRecordable &&make_recordable) noexcept
+{
+  if (recordable == nullptr)
+  {
+    return;
+  }
+  const PooledLogRecord *record = recordable->GetSharedLogRecord();
+  if (record == nullptr)
+  {
+    return;
+  }
+  std::unique_ptr<Recordable> own = make_recordable();
+  if (own != nullptr)
+  {
+    record->Replay(*own);
+  }
+  recordable = std::move(own);
+}
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
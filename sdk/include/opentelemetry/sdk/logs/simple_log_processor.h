@@ -22,7 +22,8 @@ namespace logs
  * LogExporter.
  *
  * All calls to the configured LogExporter are synchronized using a
- * spin-lock on an atomic_flag.
+ * spin-lock on an atomic_flag, unless the exporter reports a thread-safe
+ * export with LogExporter::IsExportThreadSafe().
  */
 class SimpleLogProcessor : public LogProcessor
 {
@@ -42,8 +43,12 @@ class SimpleLogProcessor : public LogProcessor
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
 private:
+  void ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch) noexcept;
+
   // The configured exporter
   std::unique_ptr<LogExporter> exporter_;
+  // Whether the exporter may be called concurrently, without taking lock_
+  const bool concurrent_export_;
   // The lock used to ensure the exporter is not called concurrently
   opentelemetry::common::SpinLockMutex lock_;
   // The atomic boolean flag to ensure the ShutDown() function is only called once
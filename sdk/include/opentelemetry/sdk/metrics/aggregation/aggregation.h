@@ -11,6 +11,10 @@ namespace sdk
 {
 namespace metrics
 {
+// Lock-free aggregations pad their state to this size, so that the values of series allocated
+// next to each other do not share a cache line.
+constexpr size_t kAggregationCacheLineSize = 64;
+
 class Aggregation
 {
 public:
@@ -30,6 +34,17 @@ class Aggregation
 
   virtual std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept = 0;
 
+  /**
+   * Merges the delta aggregation into this aggregation in place, with the same result as Merge
+   * but without copying this aggregation's state or allocating a new one.
+   *
+   * Recordings into this aggregation may continue concurrently, but only one thread at a time
+   * may merge into it.
+   *
+   * @param delta the newly captured (delta) aggregation, of the same type as this one.
+   */
+  virtual void MergeFrom(const Aggregation &delta) noexcept = 0;
+
   /**
    * Returns a new delta aggregation by comparing two cumulative measurements.
    *
@@ -6,8 +6,10 @@
 #  include "opentelemetry/common/spin_lock_mutex.h"
 #  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/drop_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/exponential_histogram_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/histogram_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/lastvalue_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/sketch_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/sum_aggregation.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
 
@@ -49,8 +51,9 @@ class DefaultAggregation
     };
   }
 
-  static std::unique_ptr<Aggregation> CreateAggregation(AggregationType aggregation_type,
-                                                        InstrumentDescriptor instrument_descriptor)
+  static std::unique_ptr<Aggregation> CreateAggregation(
+      AggregationType aggregation_type,
+      const InstrumentDescriptor &instrument_descriptor)
   {
     switch (aggregation_type)
     {
@@ -67,6 +70,26 @@ class DefaultAggregation
           return std::unique_ptr<Aggregation>(new DoubleHistogramAggregation());
         }
         break;
+      case AggregationType::kExponentialHistogram:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(new LongExponentialHistogramAggregation());
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(new DoubleExponentialHistogramAggregation());
+        }
+        break;
+      case AggregationType::kSketch:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(new LongSketchAggregation());
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(new DoubleSketchAggregation());
+        }
+        break;
       case AggregationType::kLastValue:
         if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
         {
@@ -87,15 +110,52 @@ class DefaultAggregation
           return std::unique_ptr<Aggregation>(new DoubleSumAggregation());
         }
         break;
+      case AggregationType::kStripedSum:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(new LongStripedSumAggregation());
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(new DoubleStripedSumAggregation());
+        }
+        break;
       default:
         return DefaultAggregation::CreateAggregation(instrument_descriptor);
     }
   }
 
-  static std::unique_ptr<Aggregation> CloneAggregation(AggregationType aggregation_type,
-                                                       InstrumentDescriptor instrument_descriptor,
-                                                       const Aggregation &to_copy)
+  /**
+   * @return the aggregation type CreateAggregation(instrument_descriptor) uses for instruments of
+   * `instrument_type`.
+   */
+  static AggregationType GetDefaultAggregationType(InstrumentType instrument_type)
+  {
+    switch (instrument_type)
+    {
+      case InstrumentType::kCounter:
+      case InstrumentType::kUpDownCounter:
+      case InstrumentType::kObservableCounter:
+      case InstrumentType::kObservableUpDownCounter:
+        return AggregationType::kSum;
+      case InstrumentType::kHistogram:
+        return AggregationType::kHistogram;
+      case InstrumentType::kObservableGauge:
+        return AggregationType::kLastValue;
+      default:
+        return AggregationType::kDrop;
+    }
+  }
+
+  static std::unique_ptr<Aggregation> CloneAggregation(
+      AggregationType aggregation_type,
+      const InstrumentDescriptor &instrument_descriptor,
+      const Aggregation &to_copy)
   {
+    if (aggregation_type == AggregationType::kDefault)
+    {
+      aggregation_type = GetDefaultAggregationType(instrument_descriptor.type_);
+    }
     const PointType point_data = to_copy.ToPoint();
     switch (aggregation_type)
     {
@@ -112,6 +172,28 @@ class DefaultAggregation
           return std::unique_ptr<Aggregation>(
               new DoubleHistogramAggregation(nostd::get<HistogramPointData>(point_data)));
         }
+      case AggregationType::kExponentialHistogram:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(new LongExponentialHistogramAggregation(
+              nostd::get<ExponentialHistogramPointData>(point_data)));
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(new DoubleExponentialHistogramAggregation(
+              nostd::get<ExponentialHistogramPointData>(point_data)));
+        }
+      case AggregationType::kSketch:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(
+              new LongSketchAggregation(nostd::get<SketchPointData>(point_data)));
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(
+              new DoubleSketchAggregation(nostd::get<SketchPointData>(point_data)));
+        }
       case AggregationType::kLastValue:
         if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
         {
@@ -134,6 +216,17 @@ class DefaultAggregation
           return std::unique_ptr<Aggregation>(
               new DoubleSumAggregation(nostd::get<SumPointData>(point_data)));
         }
+      case AggregationType::kStripedSum:
+        if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+        {
+          return std::unique_ptr<Aggregation>(
+              new LongStripedSumAggregation(nostd::get<SumPointData>(point_data)));
+        }
+        else
+        {
+          return std::unique_ptr<Aggregation>(
+              new DoubleStripedSumAggregation(nostd::get<SumPointData>(point_data)));
+        }
       default:
         return DefaultAggregation::CreateAggregation(instrument_descriptor);
     }
@@ -34,6 +34,8 @@ class DropAggregation : public Aggregation
     return std::unique_ptr<Aggregation>(new DropAggregation());
   }
 
+  void MergeFrom(const Aggregation &) noexcept override {}
+
   std::unique_ptr<Aggregation> Diff(const Aggregation &) const noexcept override
   {
     return std::unique_ptr<Aggregation>(new DropAggregation());
@@ -0,0 +1,128 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
+
+#  include <cstdint>
+#  include <mutex>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/* Scale new exponential histograms start at, the finest the aggregation uses. */
+constexpr int32_t kExponentialHistogramMaxScale = 20;
+
+/* Default maximum number of buckets per sign of an exponential histogram. Sizes below 2 are
+ * raised to 2. */
+constexpr size_t kExponentialHistogramMaxSize = 160;
+
+/**
+ * @return the index of the bucket that the positive, finite `value` falls in at `scale`, i.e. the
+ * i such that 2^(i * 2^-scale) < value <= 2^((i + 1) * 2^-scale).
+ *
+ * For scales <= 0 the index is computed from the IEEE-754 exponent and mantissa bits alone. For
+ * positive scales, values that are not exact powers of two need one log2.
+ */
+int32_t ExponentialHistogramIndex(double value, int32_t scale) noexcept;
+
+/**
+ * Lowers the scale of `point` by `change`, merging each group of 2^change neighbouring buckets
+ * into one.
+ */
+void ExponentialHistogramDownscale(ExponentialHistogramPointData &point, int32_t change) noexcept;
+
+/**
+ * Records `value` into `point`, lowering its scale as needed to keep the buckets of each sign
+ * within `max_size`. NaN and infinite values are ignored.
+ */
+template <class T>
+void ExponentialHistogramRecord(ExponentialHistogramPointData &point,
+                                T value,
+                                size_t max_size) noexcept;
+
+/**
+ * Merges `delta` into `current` at the finer of the scales that keeps the buckets of each sign
+ * of the result within `max_size`.
+ */
+template <class T>
+void ExponentialHistogramMerge(ExponentialHistogramPointData &current,
+                               ExponentialHistogramPointData delta,
+                               size_t max_size) noexcept;
+
+/**
+ * Turns `next` into the difference `next` - `current`. `next` is expected to be a later state of
+ * the same series as `current`, with every count at least as large.
+ */
+template <class T>
+void ExponentialHistogramDiff(ExponentialHistogramPointData current,
+                              ExponentialHistogramPointData &next,
+                              size_t max_size) noexcept;
+
+class LongExponentialHistogramAggregation : public Aggregation
+{
+public:
+  LongExponentialHistogramAggregation(size_t max_size = kExponentialHistogramMaxSize);
+  LongExponentialHistogramAggregation(ExponentialHistogramPointData &&);
+  LongExponentialHistogramAggregation(const ExponentialHistogramPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override;
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override {}
+
+  /* Returns the result of merge of the existing aggregation with delta aggregation. The two may
+   * have different scales. */
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  /* Returns the new delta aggregation by comparing existing aggregation with next aggregation.
+   * Bucket counts of `next` should be at least those of the current aggregation. */
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  mutable opentelemetry::common::SpinLockMutex lock_;
+  ExponentialHistogramPointData point_data_;
+  size_t max_size_;
+};
+
+class DoubleExponentialHistogramAggregation : public Aggregation
+{
+public:
+  DoubleExponentialHistogramAggregation(size_t max_size = kExponentialHistogramMaxSize);
+  DoubleExponentialHistogramAggregation(ExponentialHistogramPointData &&);
+  DoubleExponentialHistogramAggregation(const ExponentialHistogramPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override {}
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override;
+
+  /* Returns the result of merge of the existing aggregation with delta aggregation. The two may
+   * have different scales. */
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  /* Returns the new delta aggregation by comparing existing aggregation with next aggregation.
+   * Bucket counts of `next` should be at least those of the current aggregation. */
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  mutable opentelemetry::common::SpinLockMutex lock_;
+  ExponentialHistogramPointData point_data_;
+  size_t max_size_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
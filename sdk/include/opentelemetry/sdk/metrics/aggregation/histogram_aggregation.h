@@ -7,6 +7,7 @@
 #  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
 
 #  include <mutex>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -14,6 +15,38 @@ namespace sdk
 namespace metrics
 {
 
+/**
+ * @return the index of the bucket `value` falls in: the number of `boundaries` less than or equal
+ * to `value`, where `boundaries` is sorted in increasing order. Bucket i thus holds the values in
+ * [boundaries[i - 1], boundaries[i]), and the last bucket the values not below the last boundary.
+ *
+ * Short boundary lists are scanned with a comparison count the compiler can vectorize; longer
+ * ones with a branchless binary search. Neither has data-dependent branches.
+ */
+template <class T>
+size_t HistogramBucketIndex(const std::vector<T> &boundaries, T value) noexcept
+{
+  const T *data = boundaries.data();
+  size_t size   = boundaries.size();
+  if (size <= 8)
+  {
+    size_t index = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+      index += static_cast<size_t>(data[i] <= value);
+    }
+    return index;
+  }
+  const T *base = data;
+  while (size > 1)
+  {
+    size_t half = size / 2;
+    base        = (base[half] <= value) ? base + half : base;
+    size -= half;
+  }
+  return static_cast<size_t>(base - data) + static_cast<size_t>(*base <= value);
+}
+
 class LongHistogramAggregation : public Aggregation
 {
 public:
@@ -29,6 +62,8 @@ class LongHistogramAggregation : public Aggregation
    * boundaries */
   std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
 
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
   /* Returns the new delta aggregation by comparing existing aggregation with next aggregation with
    * same boundaries. Data points for `next` aggregation (sum , bucket-counts) should be more than
    * the current aggregation - which is the normal scenario as measurements values are monotonic
@@ -39,8 +74,10 @@ class LongHistogramAggregation : public Aggregation
   PointType ToPoint() const noexcept override;
 
 private:
-  opentelemetry::common::SpinLockMutex lock_;
+  mutable opentelemetry::common::SpinLockMutex lock_;
   HistogramPointData point_data_;
+  // The boundaries shared by point_data_, for the bucket lookup.
+  const std::vector<long> *bucket_boundaries_;
 };
 
 class DoubleHistogramAggregation : public Aggregation
@@ -58,6 +95,8 @@ class DoubleHistogramAggregation : public Aggregation
    * boundaries */
   std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
 
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
   /* Returns the new delta aggregation by comparing existing aggregation with next aggregation with
    * same boundaries. Data points for `next` aggregation (sum , bucket-counts) should be more than
    * the current aggregation - which is the normal scenario as measurements values are monotonic
@@ -70,31 +109,72 @@ class DoubleHistogramAggregation : public Aggregation
 private:
   mutable opentelemetry::common::SpinLockMutex lock_;
   mutable HistogramPointData point_data_;
+  // The boundaries shared by point_data_, for the bucket lookup.
+  const std::vector<double> *bucket_boundaries_;
 };
 
+/**
+ * Merges `delta` into `current`, writing the result to `merge`, which may be `current`. The
+ * minimum and maximum of the result are those of the non-empty points, and are recorded when all
+ * of them record theirs.
+ */
 template <class T>
-void HistogramMerge(HistogramPointData &current,
-                    HistogramPointData &delta,
+void HistogramMerge(const HistogramPointData &current,
+                    const HistogramPointData &delta,
                     HistogramPointData &merge)
 {
   for (size_t i = 0; i < current.counts_.size(); i++)
   {
     merge.counts_[i] = current.counts_[i] + delta.counts_[i];
   }
-  merge.boundaries_ = current.boundaries_;
-  merge.sum_        = nostd::get<T>(current.sum_) + nostd::get<T>(delta.sum_);
-  merge.count_      = current.count_ + delta.count_;
+  if (&merge != &current)
+  {
+    merge.boundaries_ = current.boundaries_;
+  }
+  if (delta.count_ != 0 &&
+      (current.count_ == 0 || nostd::get<T>(delta.min_) < nostd::get<T>(current.min_)))
+  {
+    merge.min_ = delta.min_;
+  }
+  else if (&merge != &current)
+  {
+    merge.min_ = current.min_;
+  }
+  if (delta.count_ != 0 &&
+      (current.count_ == 0 || nostd::get<T>(delta.max_) > nostd::get<T>(current.max_)))
+  {
+    merge.max_ = delta.max_;
+  }
+  else if (&merge != &current)
+  {
+    merge.max_ = current.max_;
+  }
+  merge.record_min_max_ = (current.count_ == 0 || current.record_min_max_) &&
+                          (delta.count_ == 0 || delta.record_min_max_);
+  merge.sum_            = nostd::get<T>(current.sum_) + nostd::get<T>(delta.sum_);
+  merge.count_          = current.count_ + delta.count_;
 }
 
+/**
+ * Writes `next` - `current` to `diff`. As the minimum and maximum of the measurements between the
+ * two points are not known, they are only recorded when `current` is empty.
+ */
 template <class T>
-void HistogramDiff(HistogramPointData &current, HistogramPointData &next, HistogramPointData &diff)
+void HistogramDiff(const HistogramPointData &current,
+                   const HistogramPointData &next,
+                   HistogramPointData &diff)
 {
   for (size_t i = 0; i < current.counts_.size(); i++)
   {
     diff.counts_[i] = next.counts_[i] - current.counts_[i];
   }
   diff.boundaries_ = current.boundaries_;
+  diff.sum_        = nostd::get<T>(next.sum_) - nostd::get<T>(current.sum_);
   diff.count_      = next.count_ - current.count_;
+  // The extremes of `next` are those of the difference only when `current` is empty.
+  diff.min_            = next.min_;
+  diff.max_            = next.max_;
+  diff.record_min_max_ = next.record_min_max_ && current.count_ == 0;
 }
 
 }  // namespace metrics
@@ -3,16 +3,18 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
-#  include "opentelemetry/common/spin_lock_mutex.h"
 #  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
 
-#  include <mutex>
+#  include <atomic>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
+/**
+ * Last long measurement, kept in a single atomic. Concurrent measurements race; one of them wins.
+ */
 class LongLastValueAggregation : public Aggregation
 {
 public:
@@ -26,15 +28,23 @@ class LongLastValueAggregation : public Aggregation
 
   std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
 
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
   std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
 
   PointType ToPoint() const noexcept override;
 
 private:
-  opentelemetry::common::SpinLockMutex lock_;
-  LastValuePointData point_data_;
+  std::atomic<long> value_;
+  std::atomic<bool> is_lastvalue_valid_;
+  opentelemetry::common::SystemTimestamp sample_ts_;
+  char padding_[kAggregationCacheLineSize - sizeof(std::atomic<long>) - sizeof(std::atomic<bool>)];
 };
 
+/**
+ * Last double measurement, kept in a single atomic. Concurrent measurements race; one of them
+ * wins.
+ */
 class DoubleLastValueAggregation : public Aggregation
 {
 public:
@@ -46,15 +56,20 @@ class DoubleLastValueAggregation : public Aggregation
 
   void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override;
 
-  virtual std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
 
-  virtual std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
 
   PointType ToPoint() const noexcept override;
 
 private:
-  mutable opentelemetry::common::SpinLockMutex lock_;
-  mutable LastValuePointData point_data_;
+  std::atomic<double> value_;
+  std::atomic<bool> is_lastvalue_valid_;
+  opentelemetry::common::SystemTimestamp sample_ts_;
+  char padding_[kAggregationCacheLineSize - sizeof(std::atomic<double>) -
+                sizeof(std::atomic<bool>)];
 };
 
 }  // namespace metrics
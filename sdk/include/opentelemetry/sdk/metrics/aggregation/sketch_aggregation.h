@@ -0,0 +1,135 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
+
+#  include <cstdint>
+#  include <mutex>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/* Default relative accuracy of the quantiles of a sketch. Accuracies outside (0, 0.5] are replaced
+ * with it. */
+constexpr double kSketchRelativeAccuracy = 0.01;
+
+/* Default maximum number of buckets per sign of a sketch. At the default accuracy, 2048 buckets
+ * cover values from 1 to about 10^17 without collapsing. Sizes below 2 are raised to 2. */
+constexpr size_t kSketchMaxSize = 2048;
+
+/**
+ * @return the multiplier of ln(value) that gives the bucket index of value in a sketch of
+ * `relative_accuracy`, i.e. 1 / ln(gamma).
+ */
+double SketchIndexMultiplier(double relative_accuracy) noexcept;
+
+/**
+ * @return the index of the bucket that the positive, finite `value` falls in, i.e. the i such that
+ * gamma^(i - 1) < value <= gamma^i, with `multiplier` from SketchIndexMultiplier().
+ */
+int32_t SketchIndex(double value, double multiplier) noexcept;
+
+/**
+ * @return the value representing bucket `index` of a sketch of `relative_accuracy`, within
+ * `relative_accuracy` of every value of the bucket.
+ */
+double SketchValue(int32_t index, double relative_accuracy) noexcept;
+
+/**
+ * Records `value` into `point`, collapsing the lowest buckets of its sign to keep them within
+ * `max_size`. NaN and infinite values are ignored.
+ */
+template <class T>
+void SketchRecord(SketchPointData &point, T value, double multiplier, size_t max_size) noexcept;
+
+/**
+ * Merges `delta` into `current`, keeping the buckets of each sign of the result within `max_size`.
+ */
+template <class T>
+void SketchMerge(SketchPointData &current, const SketchPointData &delta, size_t max_size) noexcept;
+
+/**
+ * Turns `next` into the difference `next` - `current`. `next` is expected to be a later state of
+ * the same series as `current`, with every count at least as large. The minimum and maximum of
+ * `next` are kept, as those of the difference are not known.
+ */
+template <class T>
+void SketchDiff(const SketchPointData &current, SketchPointData &next) noexcept;
+
+/**
+ * @return the estimate of the `q`-quantile of the measurements of `point`, for `q` in [0, 1], or
+ * NaN if `point` is empty. The lowest and highest ranks return the exact minimum and maximum
+ * measurements, which also bound the other estimates.
+ */
+double SketchQuantile(const SketchPointData &point, double q) noexcept;
+
+class LongSketchAggregation : public Aggregation
+{
+public:
+  LongSketchAggregation(double relative_accuracy = kSketchRelativeAccuracy,
+                        size_t max_size          = kSketchMaxSize);
+  LongSketchAggregation(SketchPointData &&);
+  LongSketchAggregation(const SketchPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override;
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override {}
+
+  /* Returns the result of merge of the existing aggregation with delta aggregation. */
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  /* Returns the new delta aggregation by comparing existing aggregation with next aggregation.
+   * Bucket counts of `next` should be at least those of the current aggregation. */
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  mutable opentelemetry::common::SpinLockMutex lock_;
+  SketchPointData point_data_;
+  double multiplier_;
+  size_t max_size_;
+};
+
+class DoubleSketchAggregation : public Aggregation
+{
+public:
+  DoubleSketchAggregation(double relative_accuracy = kSketchRelativeAccuracy,
+                          size_t max_size          = kSketchMaxSize);
+  DoubleSketchAggregation(SketchPointData &&);
+  DoubleSketchAggregation(const SketchPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override {}
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override;
+
+  /* Returns the result of merge of the existing aggregation with delta aggregation. */
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  /* Returns the new delta aggregation by comparing existing aggregation with next aggregation.
+   * Bucket counts of `next` should be at least those of the current aggregation. */
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  mutable opentelemetry::common::SpinLockMutex lock_;
+  SketchPointData point_data_;
+  double multiplier_;
+  size_t max_size_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -3,10 +3,10 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
-#  include "opentelemetry/common/spin_lock_mutex.h"
 #  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
 
-#  include <mutex>
+#  include <atomic>
+#  include <cstddef>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -14,6 +14,9 @@ namespace sdk
 namespace metrics
 {
 
+/**
+ * Sum of long measurements, kept in a single atomic updated with relaxed fetch_add.
+ */
 class LongSumAggregation : public Aggregation
 {
 public:
@@ -21,21 +24,29 @@ class LongSumAggregation : public Aggregation
   LongSumAggregation(SumPointData &&);
   LongSumAggregation(const SumPointData &);
 
-  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override;
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override
+  {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
 
   void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override {}
 
   std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
 
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
   std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
 
   PointType ToPoint() const noexcept override;
 
 private:
-  opentelemetry::common::SpinLockMutex lock_;
-  SumPointData point_data_;
+  std::atomic<long> value_;
+  char padding_[kAggregationCacheLineSize - sizeof(std::atomic<long>)];
 };
 
+/**
+ * Sum of double measurements, kept in a single atomic updated with a compare-and-swap loop.
+ */
 class DoubleSumAggregation : public Aggregation
 {
 public:
@@ -45,17 +56,124 @@ class DoubleSumAggregation : public Aggregation
 
   void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override {}
 
-  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override;
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override
+  {
+    // std::atomic<double>::fetch_add is C++20; a weak CAS loop compiles to the same instructions.
+    double current = value_.load(std::memory_order_relaxed);
+    while (!value_.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  std::atomic<double> value_;
+  char padding_[kAggregationCacheLineSize - sizeof(std::atomic<double>)];
+};
+
+// Number of cells of the striped sums.
+constexpr size_t kSumStripeCount = 16;
+
+/**
+ * @return the cell of the striped sums the calling thread records into. Threads are assigned a
+ * cell round-robin on first use, which spreads them more evenly than hashing the thread id.
+ */
+inline size_t GetSumStripe() noexcept
+{
+  static std::atomic<size_t> next_stripe{0};
+  static thread_local size_t stripe =
+      next_stripe.fetch_add(1, std::memory_order_relaxed) % kSumStripeCount;
+  return stripe;
+}
+
+/**
+ * Sum of long measurements striped over kSumStripeCount atomics, each on its own cache line, which
+ * are added up when the sum is read. Threads recording into the same series at the same time then
+ * mostly update different cache lines, rather than all bouncing the line of a single atomic. It
+ * takes kSumStripeCount cache lines per series: select it with a view for the few hottest
+ * counters only.
+ */
+class LongStripedSumAggregation : public Aggregation
+{
+public:
+  LongStripedSumAggregation();
+  LongStripedSumAggregation(SumPointData &&);
+  LongStripedSumAggregation(const SumPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override
+  {
+    cells_[GetSumStripe()].value.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override {}
+
+  std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
+
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
+  std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
+
+  PointType ToPoint() const noexcept override;
+
+private:
+  long Load() const noexcept;
+
+  struct Cell
+  {
+    std::atomic<long> value{0};
+    char padding[kAggregationCacheLineSize - sizeof(std::atomic<long>)];
+  };
+
+  Cell cells_[kSumStripeCount];
+};
+
+/**
+ * Sum of double measurements striped like LongStripedSumAggregation, each cell updated with a
+ * compare-and-swap loop.
+ */
+class DoubleStripedSumAggregation : public Aggregation
+{
+public:
+  DoubleStripedSumAggregation();
+  DoubleStripedSumAggregation(SumPointData &&);
+  DoubleStripedSumAggregation(const SumPointData &);
+
+  void Aggregate(long value, const PointAttributes &attributes = {}) noexcept override {}
+
+  void Aggregate(double value, const PointAttributes &attributes = {}) noexcept override
+  {
+    std::atomic<double> &cell = cells_[GetSumStripe()].value;
+    double current            = cell.load(std::memory_order_relaxed);
+    while (!cell.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+    {
+    }
+  }
 
   std::unique_ptr<Aggregation> Merge(const Aggregation &delta) const noexcept override;
 
+  void MergeFrom(const Aggregation &delta) noexcept override;
+
   std::unique_ptr<Aggregation> Diff(const Aggregation &next) const noexcept override;
 
   PointType ToPoint() const noexcept override;
 
 private:
-  mutable opentelemetry::common::SpinLockMutex lock_;
-  SumPointData point_data_;
+  double Load() const noexcept;
+
+  struct Cell
+  {
+    std::atomic<double> value{0.0};
+    char padding[kAggregationCacheLineSize - sizeof(std::atomic<double>)];
+  };
+
+  Cell cells_[kSumStripeCount];
 };
 
 }  // namespace metrics
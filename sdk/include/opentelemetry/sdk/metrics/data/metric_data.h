@@ -17,9 +17,13 @@ namespace sdk
 namespace metrics
 {
 
-using PointAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
-using PointType       = opentelemetry::nostd::
-    variant<SumPointData, HistogramPointData, LastValuePointData, DropPointData>;
+using PointAttributes = opentelemetry::sdk::common::MetricAttributeMap;
+using PointType       = opentelemetry::nostd::variant<SumPointData,
+                                                      HistogramPointData,
+                                                      LastValuePointData,
+                                                      ExponentialHistogramPointData,
+                                                      SketchPointData,
+                                                      DropPointData>;
 
 struct PointDataAttributes
 {
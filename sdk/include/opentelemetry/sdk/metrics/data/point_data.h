@@ -8,7 +8,11 @@
 #  include "opentelemetry/sdk/metrics/instruments.h"
 #  include "opentelemetry/version.h"
 
+#  include <cstdint>
+#  include <initializer_list>
 #  include <list>
+#  include <memory>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -16,8 +20,58 @@ namespace sdk
 namespace metrics
 {
 
+/**
+ * The bucket boundaries of a histogram: an immutable, contiguous array shared by the copies, so
+ * that all the series of an instrument, and the points collected from them, refer to the same
+ * boundaries rather than each holding their own.
+ */
+template <class T>
+class HistogramBoundaries
+{
+public:
+  using value_type     = T;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  HistogramBoundaries() = default;
+  HistogramBoundaries(std::vector<T> boundaries)
+      : boundaries_(std::make_shared<const std::vector<T>>(std::move(boundaries)))
+  {}
+  HistogramBoundaries(std::initializer_list<T> boundaries)
+      : HistogramBoundaries(std::vector<T>(boundaries))
+  {}
+  HistogramBoundaries(const std::list<T> &boundaries)
+      : HistogramBoundaries(std::vector<T>(boundaries.begin(), boundaries.end()))
+  {}
+
+  const std::vector<T> &get() const noexcept { return boundaries_ ? *boundaries_ : Empty(); }
+
+  const_iterator begin() const noexcept { return get().begin(); }
+  const_iterator end() const noexcept { return get().end(); }
+  size_t size() const noexcept { return get().size(); }
+  bool empty() const noexcept { return get().empty(); }
+  const T &operator[](size_t i) const noexcept { return get()[i]; }
+
+  friend bool operator==(const HistogramBoundaries &lhs, const HistogramBoundaries &rhs) noexcept
+  {
+    return lhs.boundaries_ == rhs.boundaries_ || lhs.get() == rhs.get();
+  }
+  friend bool operator!=(const HistogramBoundaries &lhs, const HistogramBoundaries &rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  static const std::vector<T> &Empty() noexcept
+  {
+    static const std::vector<T> empty;
+    return empty;
+  }
+
+  std::shared_ptr<const std::vector<T>> boundaries_;
+};
+
 using ValueType = nostd::variant<long, double>;
-using ListType  = nostd::variant<std::list<long>, std::list<double>>;
+using ListType  = nostd::variant<HistogramBoundaries<long>, HistogramBoundaries<double>>;
 
 // TODO: remove ctors and initializers from below classes when GCC<5 stops shipping on Ubuntu
 
@@ -60,6 +114,77 @@ class HistogramPointData
   ValueType sum_                = {};
   std::vector<uint64_t> counts_ = {};
   uint64_t count_               = {};
+  // Smallest and largest measurements, of the type of sum_. Only meaningful when count_ is not 0
+  // and record_min_max_ is set, which it is not for a difference of two cumulative points.
+  ValueType min_       = {};
+  ValueType max_       = {};
+  bool record_min_max_ = true;
+};
+
+/**
+ * A contiguous range of exponential histogram buckets: counts_[i] is the count of the bucket with
+ * index offset_ + i.
+ */
+class ExponentialHistogramBuckets
+{
+public:
+  // TODO: remove ctors and initializers when GCC<5 stops shipping on Ubuntu
+  ExponentialHistogramBuckets(ExponentialHistogramBuckets &&) = default;
+  ExponentialHistogramBuckets &operator=(ExponentialHistogramBuckets &&) = default;
+  ExponentialHistogramBuckets(const ExponentialHistogramBuckets &)       = default;
+  ExponentialHistogramBuckets &operator=(const ExponentialHistogramBuckets &) = default;
+  ExponentialHistogramBuckets()                                               = default;
+
+  int32_t offset_               = {};
+  std::vector<uint64_t> counts_ = {};
+};
+
+/**
+ * Base-2 exponential histogram. At scale s, bucket i of positive_buckets_ counts the values in
+ * (2^(i * 2^-s), 2^((i + 1) * 2^-s)]; negative_buckets_ counts the absolute values of negative
+ * measurements the same way, and zero_count_ counts the zeros.
+ */
+class ExponentialHistogramPointData
+{
+public:
+  // TODO: remove ctors and initializers when GCC<5 stops shipping on Ubuntu
+  ExponentialHistogramPointData(ExponentialHistogramPointData &&) = default;
+  ExponentialHistogramPointData &operator=(ExponentialHistogramPointData &&) = default;
+  ExponentialHistogramPointData(const ExponentialHistogramPointData &)       = default;
+  ExponentialHistogramPointData()                                            = default;
+
+  ValueType sum_                                 = {};
+  uint64_t count_                                = {};
+  uint64_t zero_count_                           = {};
+  int32_t scale_                                 = {};
+  ExponentialHistogramBuckets positive_buckets_ = {};
+  ExponentialHistogramBuckets negative_buckets_ = {};
+};
+
+/**
+ * DDSketch of the measurements. With gamma = (1 + relative_accuracy_) / (1 - relative_accuracy_),
+ * bucket i of positive_buckets_ counts the values in (gamma^(i - 1), gamma^i], negative_buckets_
+ * counts the absolute values of negative measurements the same way, and zero_count_ counts the
+ * zeros. The quantiles estimated from the buckets are within relative_accuracy_ of the exact ones,
+ * except in the lowest buckets of each sign, which absorb the values below the bucket budget.
+ */
+class SketchPointData
+{
+public:
+  // TODO: remove ctors and initializers when GCC<5 stops shipping on Ubuntu
+  SketchPointData(SketchPointData &&) = default;
+  SketchPointData &operator=(SketchPointData &&) = default;
+  SketchPointData(const SketchPointData &)       = default;
+  SketchPointData()                              = default;
+
+  ValueType sum_                                 = {};
+  uint64_t count_                                = {};
+  uint64_t zero_count_                           = {};
+  double min_                                    = {};
+  double max_                                    = {};
+  double relative_accuracy_                      = {};
+  ExponentialHistogramBuckets positive_buckets_ = {};
+  ExponentialHistogramBuckets negative_buckets_ = {};
 };
 
 class DropPointData
@@ -0,0 +1,64 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/nostd/shared_ptr.h"
+#  include "opentelemetry/sdk/common/clock.h"
+#  include "opentelemetry/sdk/metrics/exemplar/reservoir.h"
+#  include "opentelemetry/sdk/metrics/exemplar/reservoir_cell.h"
+
+#  include <memory>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * A reservoir keeping the last measurement offered to each bucket of a histogram with the given
+ * boundaries, so that every bucket the exported histogram shows can have an exemplar. The
+ * timestamps of the exemplars are read from `clock`.
+ */
+class AlignedHistogramBucketExemplarReservoir final : public ExemplarReservoir
+{
+public:
+  static nostd::shared_ptr<ExemplarReservoir> GetAlignedHistogramBucketExemplarReservoir(
+      std::vector<double> boundaries,
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::make_shared<opentelemetry::sdk::common::PreciseClock>())
+  {
+    return nostd::shared_ptr<ExemplarReservoir>{
+        new AlignedHistogramBucketExemplarReservoir(std::move(boundaries), std::move(clock))};
+  }
+
+  explicit AlignedHistogramBucketExemplarReservoir(
+      std::vector<double> boundaries,
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::make_shared<opentelemetry::sdk::common::PreciseClock>())
+      : boundaries_(std::move(boundaries)), cells_(boundaries_.size() + 1), clock_(std::move(clock))
+  {}
+
+  void OfferMeasurement(long value,
+                        const opentelemetry::common::KeyValueIterable &attributes,
+                        const opentelemetry::context::Context &context) noexcept override;
+
+  void OfferMeasurement(double value,
+                        const opentelemetry::common::KeyValueIterable &attributes,
+                        const opentelemetry::context::Context &context) noexcept override;
+
+  std::vector<ExemplarData> CollectAndReset(
+      const MetricAttributes &pointAttributes) noexcept override;
+
+private:
+  std::vector<double> boundaries_;
+  std::vector<ReservoirCell> cells_;
+  std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
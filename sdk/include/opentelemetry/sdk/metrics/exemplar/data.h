@@ -5,14 +5,16 @@
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/common/timestamp.h"
 #  include "opentelemetry/context/context.h"
+#  include "opentelemetry/nostd/variant.h"
 #  include "opentelemetry/sdk/common/attribute_utils.h"
+#  include "opentelemetry/trace/span_context.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
-using MetricAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
+using MetricAttributes = opentelemetry::sdk::common::MetricAttributeMap;
 /**
  * A sample input measurement.
  *
@@ -22,21 +24,43 @@ using MetricAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
 class ExemplarData
 {
 public:
+  ExemplarData(MetricAttributes filtered_attributes,
+               opentelemetry::common::SystemTimestamp epoch_nanos,
+               opentelemetry::trace::SpanContext span_context,
+               nostd::variant<long, double> value)
+      : filtered_attributes_(std::move(filtered_attributes)),
+        epoch_nanos_(epoch_nanos),
+        span_context_(span_context),
+        value_(value)
+  {}
+
   /**
    * The set of key/value pairs that were filtered out by the aggregator, but recorded alongside the
    * original measurement. Only key/value pairs that were filtered out by the aggregator should be
    * included
    */
-  MetricAttributes GetFilteredAttributes();
+  const MetricAttributes &GetFilteredAttributes() const noexcept { return filtered_attributes_; }
 
   /** Returns the timestamp in nanos when measurement was collected. */
-  opentelemetry::common::SystemTimestamp GetEpochNanos();
+  opentelemetry::common::SystemTimestamp GetEpochNanos() const noexcept { return epoch_nanos_; }
 
   /**
    * Returns the SpanContext associated with this exemplar. If the exemplar was not recorded
-   * inside a sampled trace, the Context will be invalid.
+   * inside a span, the SpanContext will be invalid.
    */
-  opentelemetry::context::Context GetSpanContext();
+  const opentelemetry::trace::SpanContext &GetSpanContext() const noexcept
+  {
+    return span_context_;
+  }
+
+  /** Returns the value of the measurement. */
+  nostd::variant<long, double> GetValue() const noexcept { return value_; }
+
+private:
+  MetricAttributes filtered_attributes_;
+  opentelemetry::common::SystemTimestamp epoch_nanos_;
+  opentelemetry::trace::SpanContext span_context_;
+  nostd::variant<long, double> value_;
 };
 
 }  // namespace metrics
@@ -11,7 +11,7 @@ namespace sdk
 {
 namespace metrics
 {
-using MetricAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
+using MetricAttributes = opentelemetry::sdk::common::MetricAttributeMap;
 
 /**
  * Exemplar filters are used to pre-filter measurements before attempting to store them in a
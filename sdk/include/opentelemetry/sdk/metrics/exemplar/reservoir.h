@@ -4,6 +4,7 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 #  include <vector>
+#  include "opentelemetry/common/key_value_iterable.h"
 #  include "opentelemetry/sdk/metrics/exemplar/data.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -15,6 +16,9 @@ namespace metrics
  * An interface for an exemplar reservoir of samples.
  *
  * <p>This represents a reservoir for a specific "point" of metric data.
+ *
+ * Measurements are offered on the recording path: implementations should only read the clock and
+ * the context, and copy the attributes, for the measurements they actually keep.
  */
 class ExemplarReservoir
 {
@@ -22,18 +26,14 @@ class ExemplarReservoir
   virtual ~ExemplarReservoir() = default;
 
   /** Offers a long measurement to be sampled. */
-  virtual void OfferMeasurement(
-      long value,
-      const MetricAttributes &attributes,
-      const opentelemetry::context::Context &context,
-      const opentelemetry::common::SystemTimestamp &timestamp) noexcept = 0;
+  virtual void OfferMeasurement(long value,
+                                const opentelemetry::common::KeyValueIterable &attributes,
+                                const opentelemetry::context::Context &context) noexcept = 0;
 
   /** Offers a double measurement to be sampled. */
-  virtual void OfferMeasurement(
-      double value,
-      const MetricAttributes &attributes,
-      const opentelemetry::context::Context &context,
-      const opentelemetry::common::SystemTimestamp &timestamp) noexcept = 0;
+  virtual void OfferMeasurement(double value,
+                                const opentelemetry::common::KeyValueIterable &attributes,
+                                const opentelemetry::context::Context &context) noexcept = 0;
 
   /**
    * Builds vector of Exemplars for exporting from the current reservoir.
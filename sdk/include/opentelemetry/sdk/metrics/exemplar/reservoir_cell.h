@@ -0,0 +1,99 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/common/key_value_iterable.h"
+#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/context/context.h"
+#  include "opentelemetry/sdk/common/clock.h"
+#  include "opentelemetry/sdk/metrics/exemplar/data.h"
+#  include "opentelemetry/trace/context.h"
+
+#  include <mutex>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * A slot of an exemplar reservoir, holding at most one measurement.
+ *
+ * Recording never waits: a measurement that finds the cell busy, with another recording or a
+ * collection, is dropped. The clock and the context are only read for measurements that are
+ * kept.
+ */
+class ReservoirCell
+{
+public:
+  template <class T>
+  void RecordMeasurement(T value,
+                         const opentelemetry::common::KeyValueIterable &attributes,
+                         const opentelemetry::context::Context &context,
+                         opentelemetry::sdk::common::Clock &clock) noexcept
+  {
+    if (!lock_.try_lock())
+    {
+      return;
+    }
+    value_ = value;
+    attributes_.clear();
+    attributes.ForEachKeyValue(
+        [this](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          attributes_.SetAttribute(key, value);
+          return true;
+        });
+    span_context_    = opentelemetry::trace::GetSpan(context)->GetContext();
+    epoch_nanos_     = clock.SystemNow();
+    has_measurement_ = true;
+    lock_.unlock();
+  }
+
+  /**
+   * Moves the measurement of the cell to `exemplars` if it was recorded with all of
+   * `point_attributes`, leaving out these attributes.
+   */
+  void CollectAndReset(const MetricAttributes &point_attributes,
+                       std::vector<ExemplarData> &exemplars) noexcept
+  {
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    if (!has_measurement_)
+    {
+      return;
+    }
+    for (auto &kv : point_attributes)
+    {
+      auto attribute = attributes_.find(kv.first);
+      if (attribute == attributes_.end() || attribute->second != kv.second)
+      {
+        return;
+      }
+    }
+    MetricAttributes filtered_attributes;
+    for (auto &kv : attributes_)
+    {
+      if (point_attributes.find(kv.first) == point_attributes.end())
+      {
+        filtered_attributes.insert(kv);
+      }
+    }
+    exemplars.emplace_back(std::move(filtered_attributes), epoch_nanos_, span_context_, value_);
+    has_measurement_ = false;
+  }
+
+private:
+  opentelemetry::common::SpinLockMutex lock_;
+  bool has_measurement_ = false;
+  nostd::variant<long, double> value_;
+  MetricAttributes attributes_;
+  opentelemetry::trace::SpanContext span_context_{false, false};
+  opentelemetry::common::SystemTimestamp epoch_nanos_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
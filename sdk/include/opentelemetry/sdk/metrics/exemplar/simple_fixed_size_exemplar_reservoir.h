@@ -0,0 +1,73 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/nostd/shared_ptr.h"
+#  include "opentelemetry/sdk/common/clock.h"
+#  include "opentelemetry/sdk/metrics/exemplar/reservoir.h"
+#  include "opentelemetry/sdk/metrics/exemplar/reservoir_cell.h"
+
+#  include <atomic>
+#  include <cstdint>
+#  include <memory>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * A reservoir keeping a uniform sample of `size` of the measurements offered since the last
+ * collection (reservoir sampling, algorithm R). A measurement only takes a cell once it is
+ * selected, so that offering costs an atomic increment and, past the first `size` measurements,
+ * one random number.
+ *
+ * The timestamps of the exemplars are read from `clock`, e.g. a CoarseClock where reading the
+ * precise clock on every sampled measurement is too slow.
+ */
+class SimpleFixedSizeExemplarReservoir final : public ExemplarReservoir
+{
+public:
+  static nostd::shared_ptr<ExemplarReservoir> GetSimpleFixedSizeExemplarReservoir(
+      size_t size,
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::make_shared<opentelemetry::sdk::common::PreciseClock>())
+  {
+    return nostd::shared_ptr<ExemplarReservoir>{
+        new SimpleFixedSizeExemplarReservoir(size, std::move(clock))};
+  }
+
+  explicit SimpleFixedSizeExemplarReservoir(
+      size_t size,
+      std::shared_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::make_shared<opentelemetry::sdk::common::PreciseClock>())
+      : cells_(size), clock_(std::move(clock))
+  {}
+
+  void OfferMeasurement(long value,
+                        const opentelemetry::common::KeyValueIterable &attributes,
+                        const opentelemetry::context::Context &context) noexcept override;
+
+  void OfferMeasurement(double value,
+                        const opentelemetry::common::KeyValueIterable &attributes,
+                        const opentelemetry::context::Context &context) noexcept override;
+
+  std::vector<ExemplarData> CollectAndReset(
+      const MetricAttributes &pointAttributes) noexcept override;
+
+private:
+  // Index of the cell the next measurement goes to, or cells_.size() if it is not sampled.
+  size_t NextCellIndex() noexcept;
+
+  std::vector<ReservoirCell> cells_;
+  std::shared_ptr<opentelemetry::sdk::common::Clock> clock_;
+  std::atomic<uint64_t> num_measurements_{0};
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
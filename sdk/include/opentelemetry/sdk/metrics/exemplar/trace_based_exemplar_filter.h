@@ -0,0 +1,69 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/context/runtime_context.h"
+#  include "opentelemetry/sdk/metrics/exemplar/filter.h"
+#  include "opentelemetry/trace/context.h"
+#  include "opentelemetry/trace/span.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * Keeps the measurements recorded inside a sampled span.
+ *
+ * The span is the one of the context passed to the instrument, e.g. Counter::Add(value, context).
+ * Measurements recorded without a span in their context, e.g. by Counter::Add(value), belong to
+ * the active span, whose sampled flag the runtime context caches: unsampled measurements then
+ * cost a single thread-local load.
+ */
+class TraceBasedExemplarFilter final : public ExemplarFilter
+{
+public:
+  static nostd::shared_ptr<ExemplarFilter> GetTraceBasedExemplarFilter()
+  {
+    static nostd::shared_ptr<ExemplarFilter> traceBasedExemplarFilter{
+        new TraceBasedExemplarFilter{}};
+    return traceBasedExemplarFilter;
+  }
+
+  bool ShouldSampleMeasurement(long /* value */,
+                               const MetricAttributes & /* attributes */,
+                               const opentelemetry::context::Context &context) noexcept override
+  {
+    return IsSampled(context);
+  }
+
+  bool ShouldSampleMeasurement(double /* value */,
+                               const MetricAttributes & /* attributes */,
+                               const opentelemetry::context::Context &context) noexcept override
+  {
+    return IsSampled(context);
+  }
+
+private:
+  explicit TraceBasedExemplarFilter() = default;
+
+  static bool IsSampled(const opentelemetry::context::Context &context) noexcept
+  {
+    const opentelemetry::context::ContextValue *value =
+        context.FindValue(opentelemetry::trace::GetSpanContextKey());
+    const nostd::shared_ptr<opentelemetry::trace::Span> *span =
+        value == nullptr ? nullptr
+                         : nostd::get_if<nostd::shared_ptr<opentelemetry::trace::Span>>(value);
+    if (span != nullptr && *span)
+    {
+      return (*span)->GetContext().IsSampled();
+    }
+    return opentelemetry::context::RuntimeContext::GetActiveTraceFlags().IsSampled();
+  }
+};
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -4,12 +4,16 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 
+#  include "opentelemetry/sdk/common/export_executor.h"
+#  include "opentelemetry/sdk/common/fork_handler.h"
+#  include "opentelemetry/sdk/common/thread_options.h"
 #  include "opentelemetry/sdk/metrics/metric_reader.h"
 #  include "opentelemetry/version.h"
 
 #  include <atomic>
 #  include <chrono>
 #  include <condition_variable>
+#  include <mutex>
 #  include <thread>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -32,10 +36,48 @@ struct PeriodicExportingMetricReaderOptions
   std::chrono::milliseconds export_interval_millis =
       std::chrono::milliseconds(kExportIntervalMillis);
 
-  /*  how long the export can run before it is cancelled. */
+  /* How long a collection and the wait for the previous export may take before the collected
+   * metrics are dropped. An export which runs longer is reported once it returned, but not
+   * cancelled: the exporter bounds its own requests, e.g. with its timeout option. */
   std::chrono::milliseconds export_timeout_millis = std::chrono::milliseconds(kExportTimeOutMillis);
+
+  /* Whether the collections happen at the multiples of export_interval_millis since the epoch of
+   * the system clock, so that the readers of several hosts with the same interval collect at the
+   * same time. Otherwise, the first collection happens when the reader starts. */
+  bool align_to_wall_clock = false;
+
+  /* Whether the cumulative series without new measurements since they were last exported are
+   * left out of the exports, see MetricReader::SetChangedOnlyExport. */
+  bool export_changed_only = false;
+
+  /* With export_changed_only, the number of collections after which an unchanged series is
+   * exported again, so that the backends do not consider it stale. */
+  size_t changed_only_keepalive_collections = 10;
+
+  /* An executor, possibly shared with batch processors and other readers, running the
+   * collections and the exports as two tasks instead of two threads of the reader. Null runs
+   * the threads. */
+  std::shared_ptr<sdk::common::ExportExecutor> executor;
+
+  /* The name, CPU affinity and niceness of the collection and export threads, named
+   * "otel-collect" and "otel-export" by default. Unused with an executor. */
+  sdk::common::ThreadOptions thread_options;
 };
 
+/**
+ * A MetricReader collecting the metrics every export interval, and exporting them to a push
+ * exporter.
+ *
+ * Collection and export run on two threads, so that collection N + 1 happens on time while export
+ * N is still running. One collection may wait for the export at most: a collection due while
+ * another is waiting is skipped, which leaves its delta metrics to the next one. A collection
+ * which takes longer than the export timeout, or waits longer than it for the previous export, is
+ * dropped, so that no export starts later than the export timeout after its collection. An export
+ * running longer than the export timeout is logged, not cancelled.
+ *
+ * With an executor, collection and export are two of its tasks rather than two threads, and still
+ * run concurrently if the executor has several threads.
+ */
 class PeriodicExportingMetricReader : public MetricReader
 {
 
@@ -45,6 +87,9 @@ class PeriodicExportingMetricReader : public MetricReader
       const PeriodicExportingMetricReaderOptions &option,
       AggregationTemporality aggregation_temporality = AggregationTemporality::kCumulative);
 
+  /* Stops the tasks of the executor, if the reader was not shut down. */
+  ~PeriodicExportingMetricReader() override;
+
 private:
   bool OnForceFlush(std::chrono::microseconds timeout) noexcept override;
 
@@ -55,15 +100,80 @@ class PeriodicExportingMetricReader : public MetricReader
   std::unique_ptr<MetricExporter> exporter_;
   std::chrono::milliseconds export_interval_millis_;
   std::chrono::milliseconds export_timeout_millis_;
+  bool align_to_wall_clock_;
 
   void DoBackgroundWork();
 
-  /* The background worker thread */
+  void DoExportWork();
+
+  /* The tasks of executor_ collecting and exporting the metrics. */
+  std::chrono::microseconds RunCollectTask();
+  std::chrono::microseconds RunExportTask();
+
+  /* Collects the metrics and hands them over to the export thread. */
+  void CollectAndQueue();
+
+  /* Exports the pending metrics, unlocking `lk` of export_m_ meanwhile. */
+  void ExportPendingMetrics(std::unique_lock<std::mutex> &lk);
+
+  /* @return the time of the first collection. */
+  std::chrono::steady_clock::time_point FirstCollection() const noexcept;
+
+  /* Starts the worker and export threads, or the tasks of executor_. threads_m_ must be held. */
+  void StartThreads();
+
+  /* Stops the worker thread, then the export thread once it exported the last metrics
+   * collected, or the tasks of executor_. threads_m_ must be held. */
+  void StopThreads();
+
+  /* Called before a fork: stops the threads, holding threads_m_ until after the fork. */
+  void PrepareFork();
+
+  /* Called in the parent and in the child after a fork: restarts the threads stopped by
+   * PrepareFork. */
+  void AfterFork();
+
+  /* @return the time of the first collection after `last_collection`. */
+  std::chrono::steady_clock::time_point NextCollection(
+      std::chrono::steady_clock::time_point last_collection) const noexcept;
+
+  /* Guards the start and stop of the threads, against forks */
+  std::mutex threads_m_;
+  bool are_threads_paused_ = false;
+
+  /* The background worker thread, collecting the metrics */
   std::thread worker_thread_;
 
-  /* Synchronization primitives */
+  /* The export thread */
+  std::thread export_thread_;
+
+  /* The options of both threads */
+  const sdk::common::ThreadOptions thread_options_;
+
+  /* The executor running the collections and exports as tasks instead, and the time of the next
+   * collection, only touched by the collection task */
+  std::shared_ptr<sdk::common::ExportExecutor> executor_;
+  std::shared_ptr<sdk::common::ExportExecutor::Task> collect_task_;
+  std::shared_ptr<sdk::common::ExportExecutor::Task> export_task_;
+  std::chrono::steady_clock::time_point next_collection_;
+
+  /* Synchronization primitives of the worker thread */
   std::condition_variable cv_;
   std::mutex cv_m_;
+  bool stopping_ = false;
+
+  /* The metrics collected and waiting for the export thread, guarded by export_m_, and the ones
+   * being exported, only accessed by the export thread. */
+  std::condition_variable export_cv_;
+  std::mutex export_m_;
+  ResourceMetrics pending_metrics_;
+  bool has_pending_metrics_ = false;
+  std::chrono::steady_clock::time_point pending_collection_time_;
+  bool export_stopping_ = false;
+  ResourceMetrics exporting_metrics_;
+
+  /* Stops and restarts the threads around forks. Declared last, to be unregistered first. */
+  sdk::common::ForkHandlerRegistration fork_handler_;
 };
 
 }  // namespace metrics
@@ -33,6 +33,10 @@ enum class AggregationType
   kHistogram,
   kLastValue,
   kSum,
+  kExponentialHistogram,
+  kSketch,
+  // A sum striped over per-thread cells, for the counters recorded into from many threads at once.
+  kStripedSum,
   kDefault
 };
 
@@ -52,7 +56,7 @@ struct InstrumentDescriptor
   InstrumentValueType value_type_;
 };
 
-using MetricAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
+using MetricAttributes = opentelemetry::sdk::common::MetricAttributeMap;
 
 /*class InstrumentSelector {
 public:
@@ -0,0 +1,129 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/metrics/meter.h"
+#  include "opentelemetry/nostd/shared_ptr.h"
+#  include "opentelemetry/nostd/string_view.h"
+#  include "opentelemetry/sdk/common/batch_processor_stats.h"
+#  include "opentelemetry/version.h"
+
+#  include <cstdint>
+#  include <functional>
+#  include <memory>
+#  include <mutex>
+#  include <string>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+class MetricReader;
+
+/**
+ * Counters of an exporter, reported by InternalMetrics.
+ */
+struct ExporterStats
+{
+  /* Number of requests sent, retries included */
+  uint64_t requests = 0;
+  /* Bytes of the payloads of the requests sent */
+  uint64_t request_bytes = 0;
+  /* Number of retries of failed requests */
+  uint64_t retries = 0;
+  /* Number of requests given up */
+  uint64_t dropped = 0;
+  /* Number of requests waiting for a retry */
+  uint64_t retry_queue_size = 0;
+};
+
+/**
+ * Self-telemetry of the SDK: reports the counters the batch processors, the exporters and the
+ * metric readers keep anyway as metrics of the given meter, which are named "otel.sdk.*" and
+ * attributed with the name each component is added with:
+ * - otel.sdk.processor.*: the queue size and capacity, the items enqueued, dropped, exported and
+ *   failed, the exports and the time they took,
+ * - otel.sdk.exporter.*: the requests, the bytes of their payloads, the retries, the requests
+ *   given up and waiting for a retry,
+ * - otel.sdk.metric_reader.*: the collections and the time they took, and the series of each
+ *   instrument in the last collection.
+ *
+ * It is opt-in: the components are only read by the callbacks of the observable instruments, at
+ * each collection of the meter's provider, so nothing is added to their hot paths.
+ *
+ * As for any instrument, the metrics are only reported under these names through a view which
+ * keeps them, e.g. an unnamed View of the observable counters and gauges of the meter.
+ *
+ * The instruments cannot be removed from the meter, so an InternalMetrics must live as long as
+ * its meter's provider collects, and the components as long as it.
+ */
+class InternalMetrics
+{
+public:
+  explicit InternalMetrics(nostd::shared_ptr<opentelemetry::metrics::Meter> meter);
+
+  InternalMetrics(const InternalMetrics &) = delete;
+  InternalMetrics &operator=(const InternalMetrics &) = delete;
+
+  /**
+   * Reports the counters of a batch processor, e.g. a BatchSpanProcessor or a BatchLogProcessor.
+   * @param name the value of the "processor" attribute of its metrics
+   * @param get_stats returns the counters of the processor
+   */
+  void AddBatchProcessor(nostd::string_view name,
+                         std::function<common::BatchProcessorStats()> get_stats);
+
+  /**
+   * Reports the counters of an exporter.
+   * @param name the value of the "exporter" attribute of its metrics
+   * @param get_stats returns the counters of the exporter
+   */
+  void AddExporter(nostd::string_view name, std::function<ExporterStats()> get_stats);
+
+  /**
+   * Reports the collections of a metric reader, and enables the tracking of its series.
+   * @param name the value of the "reader" attribute of its metrics
+   * @param reader the metric reader
+   */
+  void AddMetricReader(nostd::string_view name, MetricReader &reader);
+
+private:
+  template <class Stats>
+  struct Source
+  {
+    std::string name;
+    std::function<Stats()> get_stats;
+  };
+
+  template <uint64_t common::BatchProcessorStats::*field>
+  static void ObserveProcessors(opentelemetry::metrics::ObserverResult<long> &result, void *state);
+
+  template <uint64_t ExporterStats::*field>
+  static void ObserveExporters(opentelemetry::metrics::ObserverResult<long> &result, void *state);
+
+  static void ObserveExportDuration(opentelemetry::metrics::ObserverResult<double> &result,
+                                    void *state);
+
+  static void ObserveCollections(opentelemetry::metrics::ObserverResult<long> &result,
+                                 void *state);
+
+  static void ObserveCollectionDuration(opentelemetry::metrics::ObserverResult<double> &result,
+                                        void *state);
+
+  static void ObserveSeries(opentelemetry::metrics::ObserverResult<long> &result, void *state);
+
+  nostd::shared_ptr<opentelemetry::metrics::Meter> meter_;
+  std::mutex lock_;
+  std::vector<Source<common::BatchProcessorStats>> processors_;
+  std::vector<Source<ExporterStats>> exporters_;
+  std::vector<std::pair<std::string, MetricReader *>> readers_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -4,11 +4,14 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 #  include <chrono>
+#  include <type_traits>
+#  include <vector>
 #  include "opentelemetry/metrics/meter.h"
 #  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
 #  include "opentelemetry/sdk/metrics/meter_context.h"
 #  include "opentelemetry/sdk/metrics/state/async_metric_storage.h"
+#  include "opentelemetry/sdk/metrics/state/batch_observable_callback.h"
 
 #  include "opentelemetry/sdk/resource/resource.h"
 #  include "opentelemetry/version.h"
@@ -104,6 +107,23 @@ class Meter final : public opentelemetry::metrics::Meter
       nostd::string_view unit        = "",
       void *state                    = nullptr) noexcept override;
 
+  using opentelemetry::metrics::Meter::CreateBatchObservableInstruments;
+
+  void CreateBatchObservableInstruments(
+      nostd::span<const opentelemetry::metrics::BatchObservableInstrument> instruments,
+      void (*callback)(opentelemetry::metrics::BatchObserverResult &, void *),
+      void *state = nullptr) noexcept override;
+
+  using opentelemetry::metrics::Meter::RecordBatch;
+
+  /**
+   * Records `measurements` with the attributes hashed once, rather than once per instrument. The
+   * instruments must have been created by a meter of this SDK.
+   */
+  void RecordBatch(const opentelemetry::common::KeyValueIterable &attributes,
+                   nostd::span<const opentelemetry::metrics::SyncMeasurement> measurements,
+                   const opentelemetry::context::Context &context) noexcept override;
+
   /** Returns the associated instruementation library */
   const sdk::instrumentationlibrary::InstrumentationLibrary *GetInstrumentationLibrary()
       const noexcept;
@@ -112,14 +132,37 @@ class Meter final : public opentelemetry::metrics::Meter
   std::vector<MetricData> Collect(CollectorHandle *collector,
                                   opentelemetry::common::SystemTimestamp collect_ts) noexcept;
 
+  /**
+   * Collects metrics across all the instruments configured for the meter into `metric_data`,
+   * replacing its content. The MetricData already in `metric_data` are handed to the storages as
+   * buffers for their next collection, so that collecting into the same vector every time
+   * allocates little once the set of instruments settled.
+   */
+  void Collect(CollectorHandle *collector,
+               opentelemetry::common::SystemTimestamp collect_ts,
+               std::vector<MetricData> &metric_data) noexcept;
+
 private:
   // order of declaration is important here - instrumentation library should destroy after
   // meter-context.
   std::unique_ptr<sdk::instrumentationlibrary::InstrumentationLibrary> instrumentation_library_;
   std::shared_ptr<sdk::metrics::MeterContext> meter_context_;
+  // Callbacks of the instruments created by CreateBatchObservableInstruments, which outlive their
+  // storages.
+  std::vector<std::unique_ptr<BatchObservableCallback>> batch_callbacks_;
   // Mapping between instrument-name and Aggregation Storage.
   std::unordered_map<std::string, std::shared_ptr<MetricStorage>> storage_registry_;
 
+  // The storages of a synchronous instrument, one per matching view.
+  struct SyncInstrumentStorages
+  {
+    InstrumentDescriptor instrument_descriptor;
+    std::vector<std::shared_ptr<WritableMetricStorage>> storages;
+  };
+  // Mapping between instrument-name and the storages of the first synchronous instrument created
+  // with that name, shared by the instruments created again with the same descriptor.
+  std::unordered_map<std::string, SyncInstrumentStorages> sync_instrument_storages_;
+
   std::unique_ptr<WritableMetricStorage> RegisterMetricStorage(
       InstrumentDescriptor &instrument_descriptor);
 
@@ -127,12 +170,14 @@ class Meter final : public opentelemetry::metrics::Meter
   void RegisterAsyncMetricStorage(InstrumentDescriptor &instrument_descriptor,
                                   void (*callback)(opentelemetry::metrics::ObserverResult<T> &,
                                                    void *),
-                                  void *state = nullptr)
+                                  void *state                    = nullptr,
+                                  BatchObservableCallback *batch = nullptr,
+                                  size_t index_in_batch          = 0)
   {
     auto view_registry = meter_context_->GetViewRegistry();
     auto success       = view_registry->FindViews(
         instrument_descriptor, *instrumentation_library_,
-        [this, &instrument_descriptor, callback, state](const View &view) {
+        [this, &instrument_descriptor, callback, state, batch, index_in_batch](const View &view) {
           auto view_instr_desc = instrument_descriptor;
           if (!view.GetName().empty())
           {
@@ -142,9 +187,18 @@ class Meter final : public opentelemetry::metrics::Meter
           {
             view_instr_desc.description_ = view.GetDescription();
           }
+          // Every storage of an instrument of a batch callback subscribes to it on its own.
+          void *storage_state =
+              batch ? batch->Subscribe(index_in_batch, std::is_same<T, double>::value,
+                                       &view.GetAttributesProcessor())
+                    : state;
           auto storage = std::shared_ptr<AsyncMetricStorage<T>>(
               new AsyncMetricStorage<T>(view_instr_desc, view.GetAggregationType(), callback,
-                                        &view.GetAttributesProcessor(), state));
+                                        &view.GetAttributesProcessor(), storage_state,
+                                        view.GetAggregationCardinalityLimit(),
+                                        view.GetMaxIdleCollections()));
+          storage->SetCallbackExecutor(meter_context_->GetObservableCallbackExecutor(),
+                                       meter_context_->GetObservableCallbackTimeout());
           storage_registry_[instrument_descriptor.name_] = storage;
           return true;
         });
@@ -5,7 +5,9 @@
 #ifndef ENABLE_METRICS_PREVIEW
 
 #  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/sdk/common/memory_budget.h"
 #  include "opentelemetry/sdk/metrics/state/metric_collector.h"
+#  include "opentelemetry/sdk/metrics/state/observable_callback_executor.h"
 #  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
 #  include "opentelemetry/sdk/metrics/view/meter_selector.h"
 #  include "opentelemetry/sdk/metrics/view/view_registry.h"
@@ -74,6 +76,76 @@ class MeterContext : public std::enable_shared_from_this<MeterContext>
    */
   opentelemetry::common::SystemTimestamp GetSDKStartTime() noexcept;
 
+  /**
+   * Sets the number of threads that collect the instruments of a meter, the reader's thread
+   * included. With more than one, the instruments are collected in parallel, so the callbacks of
+   * observable instruments may run concurrently. The other threads are started here and reused by
+   * every collection; if the system fails to start some, fewer collect. The default is 1.
+   * Note: This method is not thread safe, and should ideally be called from main thread.
+   */
+  void SetCollectionParallelism(size_t parallelism) noexcept;
+
+  /**
+   * Obtain the number of threads that collect the instruments of a meter.
+   */
+  size_t GetCollectionParallelism() const noexcept;
+
+  /**
+   * Obtain the threads that collect the instruments of a meter along with the reader's thread, or
+   * nullptr if only the reader's thread collects them.
+   */
+  ObservableCallbackExecutor *GetCollectionExecutor() const noexcept;
+
+  /**
+   * Makes the storages of the synchronous instruments created afterwards keep their delta
+   * aggregations in one partition per NUMA node, recorded into by the threads running on the
+   * node and merged on collection, so that recording does not move the cache lines of the
+   * aggregations across nodes. This costs memory per node and the merge, and keeps the
+   * cumulative totals in the temporal storage. It has no effect on hosts with a single node.
+   * Note: This method is not thread safe, and should ideally be called from main thread, before
+   * any synchronous instrument is created.
+   */
+  void SetNumaAwareStorage(bool numa_aware) noexcept;
+
+  /**
+   * Obtain the number of partitions of the storages of synchronous instruments.
+   */
+  size_t GetStoragePartitionCount() const noexcept;
+
+  /**
+   * Charges the series of the synchronous instruments created afterwards to `memory_budget`,
+   * which may be shared with other components. New attribute sets whose charge is refused are
+   * folded into the overflow series, see AttributesHashMap.
+   * Note: This method is not thread safe, and should ideally be called from main thread, before
+   * any synchronous instrument is created.
+   */
+  void SetMemoryBudget(std::shared_ptr<opentelemetry::sdk::common::MemoryBudget> memory_budget)
+      noexcept;
+
+  /**
+   * Obtain the memory budget of the series of synchronous instruments, or nullptr.
+   */
+  const std::shared_ptr<opentelemetry::sdk::common::MemoryBudget> &GetMemoryBudget()
+      const noexcept;
+
+  /**
+   * Configures how the callbacks of observable instruments created afterwards are run.
+   * Note: This method is not thread safe, and should ideally be called from main thread, before
+   * any observable instrument is created.
+   */
+  void SetObservableCallbackOptions(const ObservableCallbackOptions &options) noexcept;
+
+  /**
+   * Obtain the executor running the callbacks of observable instruments, or nullptr if they run
+   * inline.
+   */
+  ObservableCallbackExecutor *GetObservableCallbackExecutor() const noexcept;
+
+  /**
+   * Obtain the time a collection waits for the callback of an observable instrument.
+   */
+  std::chrono::milliseconds GetObservableCallbackTimeout() const noexcept;
+
   /**
    * Attaches a metric reader to list of configured readers for this Meter context.
    * @param reader The metric reader for this meter context. This
@@ -122,6 +194,12 @@ class MeterContext : public std::enable_shared_from_this<MeterContext>
   std::unique_ptr<ViewRegistry> views_;
   opentelemetry::common::SystemTimestamp sdk_start_ts_;
   std::vector<std::shared_ptr<Meter>> meters_;
+  size_t collection_parallelism_  = 1;
+  size_t storage_partition_count_ = 1;
+  std::shared_ptr<opentelemetry::sdk::common::MemoryBudget> memory_budget_;
+  std::unique_ptr<ObservableCallbackExecutor> collection_executor_;
+  std::unique_ptr<ObservableCallbackExecutor> observable_callback_executor_;
+  std::chrono::milliseconds observable_callback_timeout_{0};
 
   std::atomic_flag shutdown_latch_ = ATOMIC_FLAG_INIT;
   opentelemetry::common::SpinLockMutex forceflush_lock_;
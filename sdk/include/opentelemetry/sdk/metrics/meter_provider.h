@@ -9,6 +9,7 @@
 #  include "opentelemetry/metrics/meter.h"
 #  include "opentelemetry/metrics/meter_provider.h"
 #  include "opentelemetry/nostd/shared_ptr.h"
+#  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library_map.h"
 #  include "opentelemetry/sdk/metrics/meter.h"
 #  include "opentelemetry/sdk/metrics/meter_context.h"
 #  include "opentelemetry/sdk/resource/resource.h"
@@ -87,7 +88,8 @@ class MeterProvider final : public opentelemetry::metrics::MeterProvider
 
 private:
   std::shared_ptr<sdk::metrics::MeterContext> context_;
-  std::mutex lock_;
+  // Index of the meters of context_, by instrumentation library.
+  instrumentationlibrary::InstrumentationLibraryMap<Meter> meters_;
 };
 }  // namespace metrics
 }  // namespace sdk
@@ -10,8 +10,13 @@
 #  include "opentelemetry/sdk/metrics/instruments.h"
 #  include "opentelemetry/version.h"
 
+#  include <atomic>
 #  include <chrono>
+#  include <cstdint>
 #  include <memory>
+#  include <mutex>
+#  include <string>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -19,6 +24,29 @@ namespace sdk
 namespace metrics
 {
 
+/**
+ * Counters of the collections of a MetricReader, see MetricReader::GetStats.
+ */
+struct MetricReaderStats
+{
+  /* The series an instrument reported in the last collection */
+  struct InstrumentSeries
+  {
+    std::string meter_name;
+    std::string instrument_name;
+    size_t series;
+  };
+
+  /* Number of collections */
+  uint64_t collections = 0;
+  /* Time the last collection took to aggregate the metrics, the callback excluded */
+  std::chrono::microseconds last_collection_duration{0};
+  /* Time all the collections took to aggregate the metrics */
+  std::chrono::microseconds total_collection_duration{0};
+  /* The series of each instrument in the last collection, if tracked; see SetSeriesTracking */
+  std::vector<InstrumentSeries> series;
+};
+
 /**
  * MetricReader defines the interface to collect metrics from SDK
  */
@@ -38,6 +66,30 @@ class MetricReader
 
   AggregationTemporality GetAggregationTemporality() const noexcept;
 
+  /**
+   * @return the counters of the collections of this reader.
+   */
+  MetricReaderStats GetStats() const;
+
+  /**
+   * Enables or disables counting the series of each instrument on each collection, which is off
+   * by default.
+   */
+  void SetSeriesTracking(bool enabled) noexcept;
+
+  /**
+   * Makes the cumulative collections leave out the series without new measurements since they
+   * were last reported, except once every `keepalive_collections` collections, so that the
+   * backends do not consider them stale. Export volume then follows the activity rather than the
+   * cardinality. 0, the default, reports every series at every collection.
+   */
+  void SetChangedOnlyExport(size_t keepalive_collections) noexcept;
+
+  /**
+   * @return the keepalive set by SetChangedOnlyExport, 0 if every series is reported.
+   */
+  size_t GetUnchangedSeriesKeepalive() const noexcept;
+
   /**
    * Shutdown the meter reader.
    */
@@ -65,6 +117,10 @@ class MetricReader
   AggregationTemporality aggregation_temporality_;
   mutable opentelemetry::common::SpinLockMutex lock_;
   bool shutdown_;
+  std::atomic<bool> track_series_{false};
+  std::atomic<size_t> unchanged_keepalive_{0};
+  mutable std::mutex stats_lock_;
+  MetricReaderStats stats_;
 };
 }  // namespace metrics
 }  // namespace sdk
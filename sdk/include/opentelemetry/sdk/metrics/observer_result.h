@@ -36,6 +36,9 @@ class ObserverResult final : public opentelemetry::metrics::ObserverResult<T>
     return data_;
   }
 
+  /* Exchanges the observations with `other`, which has the same attributes processor. */
+  void Swap(ObserverResult &other) noexcept { data_.swap(other.data_); }
+
 private:
   std::unordered_map<MetricAttributes, T, AttributeHashGenerator> data_;
 
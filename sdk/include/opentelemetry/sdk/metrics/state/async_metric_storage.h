@@ -4,16 +4,22 @@
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/common/global_log_handler.h"
 #  include "opentelemetry/sdk/metrics/aggregation/default_aggregation.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
 #  include "opentelemetry/sdk/metrics/observer_result.h"
 #  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
+#  include "opentelemetry/sdk/metrics/state/cumulative_to_delta_table.h"
 #  include "opentelemetry/sdk/metrics/state/metric_collector.h"
 #  include "opentelemetry/sdk/metrics/state/metric_storage.h"
+#  include "opentelemetry/sdk/metrics/state/observable_callback_executor.h"
 #  include "opentelemetry/sdk/metrics/state/temporal_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
 
+#  include <chrono>
+#  include <condition_variable>
 #  include <memory>
+#  include <mutex>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -30,63 +36,294 @@ class AsyncMetricStorage : public MetricStorage
                      void (*measurement_callback)(opentelemetry::metrics::ObserverResult<T> &,
                                                   void *),
                      const AttributesProcessor *attributes_processor,
-                     void *state = nullptr)
+                     void *state                 = nullptr,
+                     size_t attributes_limit     = kAggregationCardinalityLimit,
+                     size_t max_idle_collections = 0)
       : instrument_descriptor_(instrument_descriptor),
         aggregation_type_{aggregation_type},
         measurement_collection_callback_{measurement_callback},
         attributes_processor_{attributes_processor},
         state_{state},
-        cumulative_hash_map_(new AttributesHashMap()),
-        temporal_metric_storage_(instrument_descriptor)
+        attributes_limit_{attributes_limit},
+        is_sum_{IsSum(aggregation_type, instrument_descriptor)},
+        cumulative_hash_map_(is_sum_ ? nullptr
+                                     : new AttributesHashMap(AttributesHashMap::kDefaultShardCount,
+                                                             attributes_limit)),
+        sum_table_(attributes_limit),
+        temporal_metric_storage_(instrument_descriptor,
+                                 aggregation_type,
+                                 attributes_limit,
+                                 max_idle_collections)
   {}
 
   bool Collect(CollectorHandle *collector,
                nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                opentelemetry::common::SystemTimestamp sdk_start_ts,
                opentelemetry::common::SystemTimestamp collection_ts,
-               nostd::function_ref<bool(MetricData)> metric_collection_callback) noexcept override
+               nostd::function_ref<bool(MetricData &)> metric_collection_callback) noexcept override
   {
-    opentelemetry::sdk::metrics::ObserverResult<T> ob_res(attributes_processor_);
-
-    // read the measurement using configured callback
-    measurement_collection_callback_(ob_res, state_);
-    std::shared_ptr<AttributesHashMap> delta_hash_map(new AttributesHashMap());
+    std::shared_ptr<CallbackRun> run = TakeCallbackRun();
+    if (!run)
+    {
+      return true;
+    }
+    auto &ob_res = run->result;
+    std::shared_ptr<AttributesHashMap> delta_hash_map(
+        new AttributesHashMap(AttributesHashMap::kDefaultShardCount, attributes_limit_));
+    if (is_sum_)
+    {
+      RecordSums(ob_res, *delta_hash_map);
+      return temporal_metric_storage_.buildMetrics(collector, collectors, sdk_start_ts,
+                                                   collection_ts, std::move(delta_hash_map),
+                                                   metric_collection_callback);
+    }
+    // Observations of new attribute sets past the cardinality limit are aggregated together as
+    // the observation of the overflow series.
+    std::unique_ptr<Aggregation> overflow;
+    size_t overflow_count = 0;
     // process the read measurements - aggregate and store in hashmap
     for (auto &measurement : ob_res.GetMeasurements())
     {
+      if (cumulative_hash_map_->IsFull() && !cumulative_hash_map_->Has(measurement.first) &&
+          measurement.first != AttributesHashMap::GetOverflowAttributes())
+      {
+        if (!overflow)
+        {
+          overflow =
+              DefaultAggregation::CreateAggregation(aggregation_type_, instrument_descriptor_);
+        }
+        overflow->Aggregate(measurement.second);
+        overflow_count++;
+        continue;
+      }
       auto aggr = DefaultAggregation::CreateAggregation(aggregation_type_, instrument_descriptor_);
       aggr->Aggregate(measurement.second);
-      auto prev = cumulative_hash_map_->Get(measurement.first);
-      if (prev)
+      Record(measurement.first, std::move(aggr), *delta_hash_map);
+    }
+    if (overflow)
+    {
+      OTEL_INTERNAL_LOG_WARN("[AsyncMetricStorage::Collect] - "
+                             << overflow_count << " observations of instrument "
+                             << instrument_descriptor_.name_
+                             << " exceeded the cardinality limit and were folded into the "
+                                "overflow series");
+      Record(AttributesHashMap::GetOverflowAttributes(), std::move(overflow), *delta_hash_map);
+    }
+
+    return temporal_metric_storage_.buildMetrics(collector, collectors, sdk_start_ts, collection_ts,
+                                                 std::move(delta_hash_map),
+                                                 metric_collection_callback);
+  }
+
+  /**
+   * Makes the callback of the instrument run on `executor`, and collections wait at most
+   * `timeout` for it (0 for no limit). Without executor, the callback runs inline in Collect().
+   */
+  void SetCallbackExecutor(ObservableCallbackExecutor *executor,
+                           std::chrono::milliseconds timeout) noexcept
+  {
+    executor_ = executor;
+    timeout_  = timeout;
+  }
+
+  /* Starts the callback on the executor, unless it still runs from a previous collection. */
+  void BeginCollect() noexcept override
+  {
+    std::lock_guard<std::mutex> guard(run_lock_);
+    if (executor_ && !pending_run_)
+    {
+      pending_run_ = StartCallbackRun();
+    }
+  }
+
+  /* Returns how long the callback took the last time it completed. */
+  std::chrono::nanoseconds GetLastCallbackDuration() const noexcept
+  {
+    std::lock_guard<std::mutex> guard(run_lock_);
+    return last_run_ ? last_run_->duration : std::chrono::nanoseconds::zero();
+  }
+
+private:
+  // One invocation of the callback. It is shared with the executor thread, so that a callback
+  // that outlives its deadline still has somewhere to write to.
+  struct CallbackRun
+  {
+    explicit CallbackRun(const AttributesProcessor *attributes_processor)
+        : result(attributes_processor)
+    {}
+
+    opentelemetry::sdk::metrics::ObserverResult<T> result;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds duration{0};
+    std::mutex lock;
+    std::condition_variable done_cv;
+    bool done = false;
+  };
+
+  std::shared_ptr<CallbackRun> StartCallbackRun()
+  {
+    std::shared_ptr<CallbackRun> run(new CallbackRun(attributes_processor_));
+    run->start    = std::chrono::steady_clock::now();
+    auto callback = measurement_collection_callback_;
+    void *state   = state_;
+    executor_->Submit([run, callback, state]() {
+      callback(run->result, state);
+      std::lock_guard<std::mutex> guard(run->lock);
+      run->duration = std::chrono::steady_clock::now() - run->start;
+      run->done     = true;
+      run->done_cv.notify_all();
+    });
+    return run;
+  }
+
+  // Returns the run whose observations this collection reports: the callback run inline, the
+  // pending run once it completed within its deadline, or else the last completed run, if any.
+  std::shared_ptr<CallbackRun> TakeCallbackRun()
+  {
+    if (!executor_)
+    {
+      std::shared_ptr<CallbackRun> run(new CallbackRun(attributes_processor_));
+      run->start = std::chrono::steady_clock::now();
+      measurement_collection_callback_(run->result, state_);
+      run->duration = std::chrono::steady_clock::now() - run->start;
+      std::lock_guard<std::mutex> guard(run_lock_);
+      last_run_ = run;
+      return run;
+    }
+
+    std::shared_ptr<CallbackRun> run;
+    {
+      std::lock_guard<std::mutex> guard(run_lock_);
+      if (!pending_run_)
+      {
+        pending_run_ = StartCallbackRun();
+      }
+      run = pending_run_;
+    }
+    bool done;
+    {
+      std::unique_lock<std::mutex> lock(run->lock);
+      auto is_done = [&run] { return run->done; };
+      if (timeout_.count() > 0)
       {
-        auto delta = prev->Diff(*aggr);
-        cumulative_hash_map_->Set(measurement.first,
-                                  DefaultAggregation::CloneAggregation(
-                                      aggregation_type_, instrument_descriptor_, *delta));
-        delta_hash_map->Set(measurement.first, std::move(delta));
+        done = run->done_cv.wait_until(lock, run->start + timeout_, is_done);
       }
       else
       {
-        cumulative_hash_map_->Set(
-            measurement.first,
-            DefaultAggregation::CloneAggregation(aggregation_type_, instrument_descriptor_, *aggr));
-        delta_hash_map->Set(measurement.first, std::move(aggr));
+        run->done_cv.wait(lock, is_done);
+        done = true;
       }
     }
 
-    return temporal_metric_storage_.buildMetrics(collector, collectors, sdk_start_ts, collection_ts,
-                                                 std::move(delta_hash_map),
-                                                 metric_collection_callback);
+    std::lock_guard<std::mutex> guard(run_lock_);
+    if (done)
+    {
+      if (pending_run_ == run)
+      {
+        pending_run_.reset();
+      }
+      last_run_ = run;
+      return run;
+    }
+    OTEL_INTERNAL_LOG_WARN("[AsyncMetricStorage::Collect] - The callback of instrument "
+                           << instrument_descriptor_.name_ << " did not complete within "
+                           << timeout_.count() << " ms, reporting its last observations");
+    return last_run_;
+  }
+
+  static bool IsSum(AggregationType aggregation_type,
+                    const InstrumentDescriptor &instrument_descriptor) noexcept
+  {
+    return aggregation_type == AggregationType::kSum ||
+           (aggregation_type == AggregationType::kDefault &&
+            (instrument_descriptor.type_ == InstrumentType::kObservableCounter ||
+             instrument_descriptor.type_ == InstrumentType::kObservableUpDownCounter));
+  }
+
+  // Turns the cumulative observations of a sum into deltas against sum_table_, and records them
+  // into `delta_hash_map`.
+  void RecordSums(opentelemetry::sdk::metrics::ObserverResult<T> &ob_res,
+                  AttributesHashMap &delta_hash_map)
+  {
+    std::lock_guard<std::mutex> guard(sum_table_lock_);
+    // Observations of new attribute sets past the cardinality limit add up to the cumulative
+    // value of the overflow series.
+    T overflow            = 0;
+    size_t overflow_count = 0;
+    for (auto &measurement : ob_res.GetMeasurements())
+    {
+      if (sum_table_.IsFull() && !sum_table_.Has(measurement.first) &&
+          measurement.first != AttributesHashMap::GetOverflowAttributes())
+      {
+        overflow += measurement.second;
+        overflow_count++;
+        continue;
+      }
+      RecordSum(measurement.first, sum_table_.Update(measurement.first, measurement.second),
+                delta_hash_map);
+    }
+    if (overflow_count > 0)
+    {
+      OTEL_INTERNAL_LOG_WARN("[AsyncMetricStorage::Collect] - "
+                             << overflow_count << " observations of instrument "
+                             << instrument_descriptor_.name_
+                             << " exceeded the cardinality limit and were folded into the "
+                                "overflow series");
+      const MetricAttributes &attributes = AttributesHashMap::GetOverflowAttributes();
+      RecordSum(attributes, sum_table_.Update(attributes, overflow), delta_hash_map);
+    }
+  }
+
+  void RecordSum(const MetricAttributes &attributes, T delta, AttributesHashMap &delta_hash_map)
+  {
+    auto aggr = DefaultAggregation::CreateAggregation(aggregation_type_, instrument_descriptor_);
+    aggr->Aggregate(delta);
+    delta_hash_map.Set(attributes, std::move(aggr));
+  }
+
+  // Stores the observation `aggr` of `attributes` as the new cumulative value, and its difference
+  // with the previous one into `delta_hash_map`.
+  void Record(const MetricAttributes &attributes,
+              std::unique_ptr<Aggregation> aggr,
+              AttributesHashMap &delta_hash_map)
+  {
+    auto prev = cumulative_hash_map_->Get(attributes);
+    if (prev)
+    {
+      auto delta = prev->Diff(*aggr);
+      cumulative_hash_map_->Set(attributes, DefaultAggregation::CloneAggregation(
+                                                aggregation_type_, instrument_descriptor_, *delta));
+      delta_hash_map.Set(attributes, std::move(delta));
+    }
+    else
+    {
+      cumulative_hash_map_->Set(
+          attributes,
+          DefaultAggregation::CloneAggregation(aggregation_type_, instrument_descriptor_, *aggr));
+      delta_hash_map.Set(attributes, std::move(aggr));
+    }
   }
 
-private:
   InstrumentDescriptor instrument_descriptor_;
   AggregationType aggregation_type_;
   void (*measurement_collection_callback_)(opentelemetry::metrics::ObserverResult<T> &, void *);
   const AttributesProcessor *attributes_processor_;
   void *state_;
+  size_t attributes_limit_;
+  // Sums keep their last cumulative values in sum_table_, the other aggregations their last
+  // observations in cumulative_hash_map_.
+  bool is_sum_;
   std::unique_ptr<AttributesHashMap> cumulative_hash_map_;
+  CumulativeToDeltaTable<T> sum_table_;
+  std::mutex sum_table_lock_;
   TemporalMetricStorage temporal_metric_storage_;
+
+  ObservableCallbackExecutor *executor_ = nullptr;
+  std::chrono::milliseconds timeout_{0};
+  mutable std::mutex run_lock_;
+  // The callback run started and not yet reported, and the last completed run.
+  std::shared_ptr<CallbackRun> pending_run_;
+  std::shared_ptr<CallbackRun> last_run_;
 };
 
 }  // namespace metrics
@@ -3,25 +3,33 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
-#  include "opentelemetry/common/spin_lock_mutex.h"
 #  include "opentelemetry/nostd/function_ref.h"
 #  include "opentelemetry/sdk/common/attribute_utils.h"
 #  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/common/memory_budget.h"
+#  include "opentelemetry/sdk/common/shared_spin_lock_mutex.h"
 #  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
+#  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
 #  include "opentelemetry/version.h"
 
+#  include <atomic>
 #  include <functional>
 #  include <memory>
 #  include <mutex>
 #  include <unordered_map>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
-using opentelemetry::sdk::common::OrderedAttributeMap;
+/* Default maximum number of series, including the overflow series, an AttributesHashMap holds. */
+constexpr size_t kAggregationCardinalityLimit = 2000;
+
+/* Attribute of the series that the attribute sets past the cardinality limit are folded into. */
+constexpr const char *kAttributesLimitOverflowKey = "otel.metric.overflow";
 
 class AttributeHashGenerator
 {
@@ -32,57 +40,189 @@ class AttributeHashGenerator
   }
 };
 
+/**
+ * A concurrent map from attribute sets to aggregations.
+ *
+ * The entries are spread over a fixed number of shards keyed by the attribute hash, each guarded
+ * by its own reader-writer lock. Looking up an existing series only takes a shared lock on its
+ * shard, so concurrent recordings into existing series do not serialize on this map; inserting a
+ * new series takes the exclusive lock of a single shard.
+ *
+ * GetOrSetDefault() creates at most `attributes_limit` - 1 series. Past that, lookups of new
+ * attribute sets return the overflow series, whose only attribute is
+ * {kAttributesLimitOverflowKey, true}, so the map holds at most `attributes_limit` series.
+ *
+ * With a MemoryBudget, each series is charged its estimated size, see EstimateSeriesBytes(), and
+ * new attribute sets whose charge is refused also get the overflow series.
+ */
 class AttributesHashMap
 {
 public:
-  Aggregation *Get(const MetricAttributes &attributes) const
+  static constexpr size_t kDefaultShardCount = 8;
+
+  explicit AttributesHashMap(
+      size_t num_shards                                   = kDefaultShardCount,
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr)
+      : attributes_limit_(attributes_limit < 2 ? 2 : attributes_limit),
+        memory_budget_(std::move(memory_budget))
+  {
+    if (num_shards == 0)
+    {
+      num_shards = 1;
+    }
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; i++)
+    {
+      shards_.emplace_back(new Shard);
+    }
+  }
+
+  ~AttributesHashMap()
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-    auto it = hash_map_.find(attributes);
-    if (it != hash_map_.end())
+    if (memory_budget_ != nullptr)
     {
-      return it->second.get();
+      memory_budget_->Release(charged_bytes_.load(std::memory_order_relaxed));
     }
-    return nullptr;
   }
 
   /**
-   * @return check if key is present in hash
-   *
+   * @return the number of bytes charged to the memory budget for a series with `attributes`:
+   * the entry and its aggregation, plus each attribute and the characters of its key.
    */
-  bool Has(const MetricAttributes &attributes) const
+  static size_t EstimateSeriesBytes(const MetricAttributes &attributes) noexcept
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-    return (hash_map_.find(attributes) == hash_map_.end()) ? false : true;
+    size_t bytes = 256;
+    for (const auto &attribute : attributes)
+    {
+      bytes += 64 + attribute.first.size();
+    }
+    return bytes;
   }
 
+  Aggregation *Get(const MetricAttributes &attributes) const
+  {
+    size_t hash        = opentelemetry::sdk::common::GetHashForAttributeMap(attributes);
+    const Shard &shard = GetShard(hash);
+    SharedGuard guard(shard.lock);
+    auto entry = shard.Find(hash, attributes);
+    return entry ? entry->second.get() : nullptr;
+  }
+
+  /**
+   * @return check if key is present in hash
+   *
+   */
+  bool Has(const MetricAttributes &attributes) const { return Get(attributes) != nullptr; }
+
   /**
    * @return the pointer to value for given key if present.
    * If not present, it uses the provided callback to generate
    * value and store in the hash
    */
-  Aggregation *GetOrSetDefault(const MetricAttributes &attributes,
-                               std::function<std::unique_ptr<Aggregation>()> aggregation_callback)
+  Aggregation *GetOrSetDefault(
+      const MetricAttributes &attributes,
+      const std::function<std::unique_ptr<Aggregation>()> &aggregation_callback)
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    return GetOrSetDefault(opentelemetry::sdk::common::GetHashForAttributeMap(attributes),
+                           attributes, aggregation_callback);
+  }
 
-    auto it = hash_map_.find(attributes);
-    if (it != hash_map_.end())
+  /**
+   * Like GetOrSetDefault(attributes, aggregation_callback), for attributes whose hash is already
+   * known, such as those iterated by GetAllEntriesWithHash() of another map.
+   * @param hash must be GetHashForAttributeMap(attributes)
+   */
+  Aggregation *GetOrSetDefault(
+      size_t hash,
+      const MetricAttributes &attributes,
+      const std::function<std::unique_ptr<Aggregation>()> &aggregation_callback)
+  {
+    Shard &shard = GetShard(hash);
     {
-      return it->second.get();
+      SharedGuard guard(shard.lock);
+      auto entry = shard.Find(hash, attributes);
+      if (entry)
+      {
+        return entry->second.get();
+      }
     }
+    return Insert(hash, MetricAttributes(attributes), aggregation_callback);
+  }
 
-    hash_map_[attributes] = std::move(aggregation_callback());
-    return hash_map_[attributes].get();
+  /**
+   * @return the pointer to value for the attributes that `attributes_processor` would produce
+   * from `attributes`. Existing series are found without calling the processor or allocating;
+   * only a new series materializes its MetricAttributes.
+   */
+  Aggregation *GetOrSetDefault(
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const AttributesProcessor *attributes_processor,
+      const std::function<std::unique_ptr<Aggregation>()> &aggregation_callback)
+  {
+    auto is_key_present = [attributes_processor](nostd::string_view key) {
+      return attributes_processor->isPresent(key);
+    };
+    return GetOrSetDefault(
+        opentelemetry::sdk::common::GetHashForAttributeMap(attributes, is_key_present), attributes,
+        attributes_processor, aggregation_callback);
   }
 
   /**
-   * Set the value for given key, overwriting the value if already present
+   * Like GetOrSetDefault(attributes, attributes_processor, aggregation_callback), for attributes
+   * whose hash is already known, such as those of HashedAttributes.
+   * @param hash must be the hash of the attributes that `attributes_processor` keeps
+   */
+  Aggregation *GetOrSetDefault(
+      size_t hash,
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const AttributesProcessor *attributes_processor,
+      const std::function<std::unique_ptr<Aggregation>()> &aggregation_callback)
+  {
+    auto is_key_present = [attributes_processor](nostd::string_view key) {
+      return attributes_processor->isPresent(key);
+    };
+    Shard &shard = GetShard(hash);
+    {
+      SharedGuard guard(shard.lock);
+      auto range = shard.hash_map.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (opentelemetry::sdk::common::AttributeMapEquals(it->second.first, attributes,
+                                                           is_key_present))
+        {
+          return it->second.second.get();
+        }
+      }
+    }
+
+    // A new series, or attributes the allocation-free comparison cannot handle (see
+    // AttributeMapEquals): fall back to the owned attributes, whose hash is authoritative.
+    return GetOrSetDefault(attributes_processor->process(attributes), aggregation_callback);
+  }
+
+  /**
+   * Set the value for given key, overwriting the value if already present. The cardinality limit
+   * does not apply.
    */
   void Set(const MetricAttributes &attributes, std::unique_ptr<Aggregation> value)
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-    hash_map_[attributes] = std::move(value);
+    size_t hash  = opentelemetry::sdk::common::GetHashForAttributeMap(attributes);
+    Shard &shard = GetShard(hash);
+    ExclusiveGuard guard(shard.lock);
+    auto entry = shard.Find(hash, attributes);
+    if (entry)
+    {
+      entry->second = std::move(value);
+      return;
+    }
+    if (attributes != GetOverflowAttributes())
+    {
+      regular_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    ChargeSeries(attributes);
+    shard.hash_map.emplace(hash, Entry(attributes, std::move(value)));
+    size_.fetch_add(1, std::memory_order_relaxed);
   }
 
   /**
@@ -91,31 +231,223 @@ class AttributesHashMap
   bool GetAllEnteries(
       nostd::function_ref<bool(const MetricAttributes &, Aggregation &)> callback) const
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-    for (auto &kv : hash_map_)
+    for (auto &shard : shards_)
     {
-      if (!callback(kv.first, *(kv.second.get())))
+      SharedGuard guard(shard->lock);
+      for (auto &kv : shard->hash_map)
       {
-        return false;  // callback is not prepared to consume data
+        if (!callback(kv.second.first, *(kv.second.second.get())))
+        {
+          return false;  // callback is not prepared to consume data
+        }
       }
     }
     return true;
   }
 
+  /**
+   * Like GetAllEnteries(), also yielding the hash of the attributes stored with each entry, so
+   * that merging the entries into another map does not hash the attributes again.
+   */
+  bool GetAllEntriesWithHash(
+      nostd::function_ref<bool(size_t, const MetricAttributes &, Aggregation &)> callback) const
+  {
+    for (auto &shard : shards_)
+    {
+      SharedGuard guard(shard->lock);
+      for (auto &kv : shard->hash_map)
+      {
+        if (!callback(kv.first, kv.second.first, *(kv.second.second.get())))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Removes the entries for which `predicate` returns true.
+   * @return the number of removed entries.
+   */
+  size_t EraseIf(nostd::function_ref<bool(const MetricAttributes &, Aggregation &)> predicate)
+  {
+    size_t erased = 0;
+    for (auto &shard : shards_)
+    {
+      ExclusiveGuard guard(shard->lock);
+      for (auto it = shard->hash_map.begin(); it != shard->hash_map.end();)
+      {
+        if (!predicate(it->second.first, *it->second.second))
+        {
+          ++it;
+          continue;
+        }
+        if (it->second.first != GetOverflowAttributes())
+        {
+          regular_size_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (memory_budget_ != nullptr)
+        {
+          size_t bytes = EstimateSeriesBytes(it->second.first);
+          charged_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+          memory_budget_->Release(bytes);
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        it = shard->hash_map.erase(it);
+        erased++;
+      }
+    }
+    return erased;
+  }
+
   /**
    * Return the size of hash.
    */
-  size_t Size()
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  size_t GetAttributesLimit() const noexcept { return attributes_limit_; }
+
+  /**
+   * @return true if GetOrSetDefault() folds new attribute sets into the overflow series.
+   */
+  bool IsFull() const noexcept
+  {
+    return regular_size_.load(std::memory_order_relaxed) >= attributes_limit_ - 1;
+  }
+
+  /**
+   * @return the number of GetOrSetDefault() calls for a new attribute set that returned the
+   * overflow series instead.
+   */
+  size_t OverflowCount() const noexcept
+  {
+    return overflow_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the attributes of the overflow series.
+   */
+  static const MetricAttributes &GetOverflowAttributes()
   {
-    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-    return hash_map_.size();
+    static const MetricAttributes overflow_attributes = {{kAttributesLimitOverflowKey, true}};
+    return overflow_attributes;
+  }
+
+  /**
+   * @return the hash of GetOverflowAttributes(), computed once.
+   */
+  static size_t GetOverflowHash()
+  {
+    static const size_t overflow_hash =
+        opentelemetry::sdk::common::GetHashForAttributeMap(GetOverflowAttributes());
+    return overflow_hash;
   }
 
 private:
-  std::unordered_map<MetricAttributes, std::unique_ptr<Aggregation>, AttributeHashGenerator>
-      hash_map_;
+  using ShardLock      = opentelemetry::sdk::common::SharedSpinLockMutex;
+  using SharedGuard    = opentelemetry::sdk::common::SharedSpinLockGuard<ShardLock>;
+  using ExclusiveGuard = std::lock_guard<ShardLock>;
+  using Entry          = std::pair<MetricAttributes, std::unique_ptr<Aggregation>>;
+
+  // Entries are keyed by the hash of their attributes, computed once per operation and shared
+  // with the shard selection; colliding entries are told apart by comparing the attributes.
+  struct Shard
+  {
+    std::unordered_multimap<size_t, Entry> hash_map;
+    mutable ShardLock lock;
+
+    Entry *Find(size_t hash, const MetricAttributes &attributes)
+    {
+      auto range = hash_map.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second.first == attributes)
+        {
+          return &it->second;
+        }
+      }
+      return nullptr;
+    }
+
+    const Entry *Find(size_t hash, const MetricAttributes &attributes) const
+    {
+      return const_cast<Shard *>(this)->Find(hash, attributes);
+    }
+
+  };
+
+  Aggregation *Insert(size_t hash,
+                      MetricAttributes &&attributes,
+                      const std::function<std::unique_ptr<Aggregation>()> &aggregation_callback)
+  {
+    Shard &shard = GetShard(hash);
+    {
+      ExclusiveGuard guard(shard.lock);
+      // Another thread may have inserted the series while no lock was held.
+      auto entry = shard.Find(hash, attributes);
+      if (entry)
+      {
+        return entry->second.get();
+      }
+      // Reserve a slot first, so that concurrent insertions into other shards cannot exceed the
+      // limit together. The overflow series has a slot of its own, and is always charged.
+      bool is_overflow = attributes == GetOverflowAttributes();
+      if (is_overflow)
+      {
+        ChargeSeries(attributes);
+      }
+      if (is_overflow ||
+          (regular_size_.fetch_add(1, std::memory_order_relaxed) < attributes_limit_ - 1 &&
+           TryChargeSeries(attributes)))
+      {
+        auto it =
+            shard.hash_map.emplace(hash, Entry(std::move(attributes), aggregation_callback()));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return it->second.second.get();
+      }
+      regular_size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    overflow_count_.fetch_add(1, std::memory_order_relaxed);
+    return GetOrSetDefault(GetOverflowHash(), GetOverflowAttributes(), aggregation_callback);
+  }
+
+  bool TryChargeSeries(const MetricAttributes &attributes) noexcept
+  {
+    if (memory_budget_ == nullptr)
+    {
+      return true;
+    }
+    size_t bytes = EstimateSeriesBytes(attributes);
+    if (!memory_budget_->TryCharge(bytes, common::MemoryPriority::kNormal))
+    {
+      return false;
+    }
+    charged_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    return true;
+  }
+
+  void ChargeSeries(const MetricAttributes &attributes) noexcept
+  {
+    if (memory_budget_ != nullptr)
+    {
+      size_t bytes = EstimateSeriesBytes(attributes);
+      memory_budget_->Charge(bytes);
+      charged_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+  }
+
+  Shard &GetShard(size_t hash) const { return *shards_[hash % shards_.size()]; }
 
-  mutable opentelemetry::common::SpinLockMutex lock_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_t attributes_limit_;
+  std::shared_ptr<common::MemoryBudget> memory_budget_;
+  // Total charged to memory_budget_ for the series of the map.
+  std::atomic<size_t> charged_bytes_{0};
+  std::atomic<size_t> size_{0};
+  // Number of series other than the overflow series, including reserved slots.
+  std::atomic<size_t> regular_size_{0};
+  std::atomic<size_t> overflow_count_{0};
 };
 }  // namespace metrics
 
@@ -0,0 +1,110 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/metrics/observer_result.h"
+#  include "opentelemetry/sdk/metrics/observer_result.h"
+#  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
+#  include "opentelemetry/version.h"
+
+#  include <memory>
+#  include <mutex>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+/**
+ * Runs the callback of the instruments created by Meter::CreateBatchObservableInstruments once for
+ * all of their storages.
+ *
+ * Each storage of these instruments (one per view) is subscribed to the callback, and observes
+ * through Observe<T>() with its subscriber as state. The first storage to observe runs the
+ * callback for all the subscribers; the following ones take the observations that run left for
+ * them, and only a storage whose observations were already taken runs the callback again. Since a
+ * collection observes every storage once, the callback runs once per collection.
+ */
+class BatchObservableCallback
+{
+public:
+  class Subscriber;
+
+  BatchObservableCallback(void (*callback)(opentelemetry::metrics::BatchObserverResult &, void *),
+                          void *state,
+                          size_t instrument_count) noexcept;
+
+  /**
+   * Subscribes a storage of the instrument at `index`, whose observations are processed by
+   * `attributes_processor`.
+   * @return the state to create the storage with, along with the callback Observe<T>. It is valid
+   * as long as this object.
+   */
+  Subscriber *Subscribe(size_t index,
+                        bool is_double,
+                        const AttributesProcessor *attributes_processor);
+
+  /* The callback of the storages of the instruments. */
+  template <class T>
+  static void Observe(opentelemetry::metrics::ObserverResult<T> &result, void *subscriber) noexcept;
+
+private:
+  template <class T>
+  class MultiObserverResult;
+  class Result;
+
+  void Run();
+
+  void Take(Subscriber &subscriber, ObserverResult<long> &result);
+
+  void Take(Subscriber &subscriber, ObserverResult<double> &result);
+
+  void (*callback_)(opentelemetry::metrics::BatchObserverResult &, void *);
+  void *state_;
+  const size_t instrument_count_;
+  // Serializes the runs of the callback, and the accesses to the observations they leave.
+  std::mutex lock_;
+  std::vector<std::unique_ptr<Subscriber>> subscribers_;
+};
+
+class BatchObservableCallback::Subscriber
+{
+public:
+  Subscriber(BatchObservableCallback *batch,
+             size_t index,
+             bool is_double,
+             const AttributesProcessor *attributes_processor) noexcept
+      : batch_(batch),
+        index_(index),
+        is_double_(is_double),
+        attributes_processor_(attributes_processor)
+  {}
+
+private:
+  friend class BatchObservableCallback;
+
+  BatchObservableCallback *batch_;
+  const size_t index_;
+  const bool is_double_;
+  const AttributesProcessor *attributes_processor_;
+  // The observations of the last run of the callback, until taken.
+  std::unique_ptr<ObserverResult<long>> long_result_;
+  std::unique_ptr<ObserverResult<double>> double_result_;
+  bool pending_ = false;
+};
+
+template <class T>
+void BatchObservableCallback::Observe(opentelemetry::metrics::ObserverResult<T> &result,
+                                      void *subscriber) noexcept
+{
+  // The storages observe into results of the SDK.
+  auto &self = *static_cast<Subscriber *>(subscriber);
+  self.batch_->Take(self, static_cast<ObserverResult<T> &>(result));
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
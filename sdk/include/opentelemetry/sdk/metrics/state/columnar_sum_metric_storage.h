@@ -0,0 +1,446 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/common/global_log_handler.h"
+#  include "opentelemetry/sdk/common/shared_spin_lock_mutex.h"
+#  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
+#  include "opentelemetry/sdk/metrics/state/metric_collector.h"
+#  include "opentelemetry/sdk/metrics/state/metric_storage.h"
+#  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
+
+#  include <atomic>
+#  include <cstdint>
+#  include <memory>
+#  include <mutex>
+#  include <unordered_map>
+#  include <utility>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+/* Largest cardinality limit of a ColumnarSumMetricStorage. */
+constexpr size_t kColumnarStorageMaxSeries = size_t{1} << 24;
+
+/* Number of series of a block of ColumnarSumMetricStorage. */
+constexpr size_t kColumnarStorageBlockSize = 1024;
+
+/**
+ * Storage of a synchronous counter or up-down counter aggregated as a sum, laid out in columns
+ * instead of one Aggregation per series.
+ *
+ * Each series gets an id when first recorded into, from a dictionary of attribute sets, and keeps
+ * it for the lifetime of the storage. Its running total is the atomic at that index of the value
+ * column, stored in blocks of kColumnarStorageBlockSize series allocated as series are added, and
+ * never moved. A series thus costs its dictionary entry and one value, rather than a heap
+ * allocated, cache line sized aggregation, and a collection scans the columns linearly.
+ *
+ * Every collector keeps the totals it last reported, as a column of its own when it needs them:
+ * a delta collector reports the series whose total changed since, as the difference, and a
+ * collector leaving out the unchanged series compares them with the current totals.
+ *
+ * Series are never evicted, and measurements carry no exemplars. The storage is selected by the
+ * views asking for it, see View::UsesColumnarStorage().
+ */
+template <class T>
+class ColumnarSumMetricStorage : public MetricStorage, public WritableMetricStorage
+{
+public:
+  ColumnarSumMetricStorage(InstrumentDescriptor instrument_descriptor,
+                           const AttributesProcessor *attributes_processor,
+                           size_t attributes_limit = kAggregationCardinalityLimit)
+      : instrument_descriptor_(instrument_descriptor),
+        attributes_processor_(attributes_processor),
+        attributes_limit_((std::min)(attributes_limit, kColumnarStorageMaxSeries)),
+        blocks_(new std::atomic<Block *>[(attributes_limit_ + kColumnarStorageBlockSize - 1) /
+                                         kColumnarStorageBlockSize])
+  {
+    for (size_t i = 0; i < BlockCount(); ++i)
+    {
+      blocks_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < AttributesHashMap::kDefaultShardCount; ++i)
+    {
+      shards_.emplace_back(new Shard());
+    }
+  }
+
+  ~ColumnarSumMetricStorage() override
+  {
+    for (size_t i = 0; i < BlockCount(); ++i)
+    {
+      delete blocks_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  void RecordLong(long value, const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kLong)
+    {
+      Add(GetEmptySeries(), static_cast<T>(value));
+    }
+  }
+
+  void RecordLong(long value,
+                  const opentelemetry::common::KeyValueIterable &attributes,
+                  const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kLong)
+    {
+      Add(GetSeries(attributes, GetHash(attributes)), static_cast<T>(value));
+    }
+  }
+
+  void RecordLong(long value,
+                  const HashedAttributes &attributes,
+                  const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kLong)
+    {
+      Add(GetSeries(attributes.GetAttributes(), attributes.GetHash(attributes_processor_)),
+          static_cast<T>(value));
+    }
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kDouble)
+    {
+      Add(GetEmptySeries(), static_cast<T>(value));
+    }
+  }
+
+  void RecordDouble(double value,
+                    const opentelemetry::common::KeyValueIterable &attributes,
+                    const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kDouble)
+    {
+      Add(GetSeries(attributes, GetHash(attributes)), static_cast<T>(value));
+    }
+  }
+
+  void RecordDouble(double value,
+                    const HashedAttributes &attributes,
+                    const opentelemetry::context::Context &) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kDouble)
+    {
+      Add(GetSeries(attributes.GetAttributes(), attributes.GetHash(attributes_processor_)),
+          static_cast<T>(value));
+    }
+  }
+
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    // Series are never evicted: the handle records straight into the value of the series.
+    return std::unique_ptr<BoundWritableMetricStorage>(
+        new BoundStorage(*this, GetSeries(attributes, GetHash(attributes))));
+  }
+
+  bool Collect(CollectorHandle *collector,
+               nostd::span<std::shared_ptr<CollectorHandle>>,
+               opentelemetry::common::SystemTimestamp sdk_start_ts,
+               opentelemetry::common::SystemTimestamp collection_ts,
+               nostd::function_ref<bool(MetricData &)> callback) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(collect_lock_);
+    auto it = collectors_.find(collector);
+    if (it == collectors_.end())
+    {
+      it = collectors_.insert(std::make_pair(collector, CollectorState{})).first;
+      it->second.collection_ts = sdk_start_ts;
+    }
+    CollectorState &state = it->second;
+
+    const AggregationTemporality temporality = collector->GetAggregationTemporality();
+    const bool delta           = temporality == AggregationTemporality::kDelta;
+    const size_t keepalive     = delta ? 0 : collector->GetUnchangedSeriesKeepalive();
+    const uint64_t collection  = ++state.collection_count;
+    const size_t series_count  = size_.load(std::memory_order_acquire);
+    if (delta || keepalive > 0)
+    {
+      state.reported_values.resize(series_count, T{});
+    }
+    if (keepalive > 0)
+    {
+      state.reported_collections.resize(series_count, 0);
+    }
+
+    MetricData &metric_data             = state.metric_data;
+    metric_data.instrument_descriptor   = instrument_descriptor_;
+    metric_data.aggregation_temporality = temporality;
+    metric_data.start_ts                = state.collection_ts;
+    metric_data.end_ts                  = collection_ts;
+    state.collection_ts                 = collection_ts;
+    // Assign over the points of the previous collection rather than rebuilding them.
+    auto &points = metric_data.point_data_attr_;
+    size_t used  = 0;
+    for (size_t id = 0; id < series_count; ++id)
+    {
+      const Block &block = *blocks_[id / kColumnarStorageBlockSize].load(std::memory_order_acquire);
+      const size_t index = id % kColumnarStorageBlockSize;
+      T value            = block.values[index].load(std::memory_order_relaxed);
+      T point_value      = value;
+      if (delta)
+      {
+        point_value = value - state.reported_values[id];
+        if (point_value == T{})
+        {
+          continue;
+        }
+        state.reported_values[id] = value;
+      }
+      else if (keepalive > 0)
+      {
+        uint64_t &reported_collection = state.reported_collections[id];
+        if (reported_collection != 0 && state.reported_values[id] == value &&
+            collection - reported_collection < keepalive)
+        {
+          continue;
+        }
+        state.reported_values[id] = value;
+        reported_collection       = collection;
+      }
+
+      if (used == points.size())
+      {
+        points.emplace_back();
+      }
+      SumPointData point;
+      point.value_            = point_value;
+      points[used].point_data = std::move(point);
+      points[used].attributes = *block.attributes[index];
+      used++;
+    }
+    points.erase(points.begin() + used, points.end());
+    return callback(metric_data);
+  }
+
+  /* Number of series created so far, including the overflow series. */
+  size_t GetSeriesCount() const noexcept { return size_.load(std::memory_order_acquire); }
+
+private:
+  using ShardLock      = opentelemetry::sdk::common::SharedSpinLockMutex;
+  using SharedGuard    = opentelemetry::sdk::common::SharedSpinLockGuard<ShardLock>;
+  using ExclusiveGuard = std::lock_guard<ShardLock>;
+
+  static constexpr uint32_t kNoSeries = UINT32_MAX;
+
+  // The columns of kColumnarStorageBlockSize consecutive series.
+  struct Block
+  {
+    Block()
+    {
+      for (auto &value : values)
+      {
+        value.store(T{}, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic<T> values[kColumnarStorageBlockSize];
+    // The attributes of the series, owned by the dictionary.
+    const MetricAttributes *attributes[kColumnarStorageBlockSize];
+  };
+
+  // A shard of the dictionary from the attribute sets to their series ids, keyed by the hash of
+  // the attributes.
+  struct Shard
+  {
+    std::unordered_multimap<size_t, std::pair<MetricAttributes, uint32_t>> series;
+    mutable ShardLock lock;
+  };
+
+  struct CollectorState
+  {
+    opentelemetry::common::SystemTimestamp collection_ts;
+    uint64_t collection_count = 0;
+    // Per series, the total last reported and, when unchanged series are left out, the
+    // collection it was reported at (0 for never).
+    std::vector<T> reported_values;
+    std::vector<uint64_t> reported_collections;
+    // Reused across collections.
+    MetricData metric_data;
+  };
+
+  class BoundStorage : public BoundWritableMetricStorage
+  {
+  public:
+    BoundStorage(ColumnarSumMetricStorage &storage, uint32_t id) : storage_(storage), id_(id) {}
+
+    void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override
+    {
+      storage_.RecordLong(value, context, id_);
+    }
+
+    void RecordDouble(double value,
+                      const opentelemetry::context::Context &context) noexcept override
+    {
+      storage_.RecordDouble(value, context, id_);
+    }
+
+  private:
+    ColumnarSumMetricStorage &storage_;
+    const uint32_t id_;
+  };
+
+  size_t BlockCount() const noexcept
+  {
+    return (attributes_limit_ + kColumnarStorageBlockSize - 1) / kColumnarStorageBlockSize;
+  }
+
+  size_t GetHash(const opentelemetry::common::KeyValueIterable &attributes) const noexcept
+  {
+    return opentelemetry::sdk::common::GetHashForAttributeMap(
+        attributes,
+        [this](nostd::string_view key) { return attributes_processor_->isPresent(key); });
+  }
+
+  void RecordLong(long value, const opentelemetry::context::Context &, uint32_t id) noexcept
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kLong)
+    {
+      Add(id, static_cast<T>(value));
+    }
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &, uint32_t id) noexcept
+  {
+    if (instrument_descriptor_.value_type_ == InstrumentValueType::kDouble)
+    {
+      Add(id, static_cast<T>(value));
+    }
+  }
+
+  void Add(uint32_t id, T value) noexcept
+  {
+    std::atomic<T> &total = blocks_[id / kColumnarStorageBlockSize]
+                                .load(std::memory_order_acquire)
+                                ->values[id % kColumnarStorageBlockSize];
+    T current = total.load(std::memory_order_relaxed);
+    while (!total.compare_exchange_weak(current, current + value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  uint32_t GetEmptySeries()
+  {
+    uint32_t id = empty_series_.load(std::memory_order_acquire);
+    if (id == kNoSeries)
+    {
+      MetricAttributes attributes;
+      size_t hash = opentelemetry::sdk::common::GetHashForAttributeMap(attributes);
+      id          = GetSeries(hash, std::move(attributes));
+      empty_series_.store(id, std::memory_order_release);
+    }
+    return id;
+  }
+
+  // @return the series of the attributes that attributes_processor_ keeps from `attributes`,
+  // whose hash is `hash`. Existing series are found without calling the processor or allocating.
+  uint32_t GetSeries(const opentelemetry::common::KeyValueIterable &attributes, size_t hash)
+  {
+    auto is_key_present = [this](nostd::string_view key) {
+      return attributes_processor_->isPresent(key);
+    };
+    Shard &shard = GetShard(hash);
+    {
+      SharedGuard guard(shard.lock);
+      auto range = shard.series.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (opentelemetry::sdk::common::AttributeMapEquals(it->second.first, attributes,
+                                                           is_key_present))
+        {
+          return it->second.second;
+        }
+      }
+    }
+
+    // A new series, or attributes the allocation-free comparison cannot handle (see
+    // AttributeMapEquals): fall back to the owned attributes, whose hash is authoritative.
+    MetricAttributes owned = attributes_processor_->process(attributes);
+    size_t owned_hash      = opentelemetry::sdk::common::GetHashForAttributeMap(owned);
+    return GetSeries(owned_hash, std::move(owned));
+  }
+
+  // @return the series of `attributes`, whose hash is `hash`, creating it if needed. Past the
+  // cardinality limit, new attribute sets get the overflow series.
+  uint32_t GetSeries(size_t hash, MetricAttributes &&attributes)
+  {
+    Shard &shard = GetShard(hash);
+    {
+      ExclusiveGuard guard(shard.lock);
+      auto range = shard.series.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second.first == attributes)
+        {
+          return it->second.second;
+        }
+      }
+
+      std::lock_guard<std::mutex> insert_guard(insert_lock_);
+      const bool is_overflow = attributes == AttributesHashMap::GetOverflowAttributes();
+      if (is_overflow || regular_size_ < attributes_limit_ - 1)
+      {
+        uint32_t id = static_cast<uint32_t>(size_.load(std::memory_order_relaxed));
+        auto &block = blocks_[id / kColumnarStorageBlockSize];
+        if (block.load(std::memory_order_relaxed) == nullptr)
+        {
+          block.store(new Block(), std::memory_order_release);
+        }
+        auto it = shard.series.emplace(hash, std::make_pair(std::move(attributes), id));
+        block.load(std::memory_order_relaxed)->attributes[id % kColumnarStorageBlockSize] =
+            &it->second.first;
+        if (!is_overflow)
+        {
+          regular_size_++;
+        }
+        // Publishes the series to the collections.
+        size_.store(id + 1, std::memory_order_release);
+        return id;
+      }
+    }
+
+    if (overflow_count_.fetch_add(1, std::memory_order_relaxed) == 0)
+    {
+      OTEL_INTERNAL_LOG_WARN("[ColumnarSumMetricStorage] - Instrument "
+                             << instrument_descriptor_.name_ << " reached its cardinality limit "
+                             << attributes_limit_
+                             << ", new attribute sets are folded into the overflow series");
+    }
+    return GetSeries(AttributesHashMap::GetOverflowHash(),
+                     MetricAttributes(AttributesHashMap::GetOverflowAttributes()));
+  }
+
+  Shard &GetShard(size_t hash) const { return *shards_[hash % shards_.size()]; }
+
+  InstrumentDescriptor instrument_descriptor_;
+  const AttributesProcessor *attributes_processor_;
+  const size_t attributes_limit_;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::unique_ptr<std::atomic<Block *>[]> blocks_;
+  // Number of series, whose columns are all set. Only grows, under insert_lock_.
+  std::atomic<size_t> size_{0};
+  std::mutex insert_lock_;
+  // Number of series other than the overflow series, under insert_lock_.
+  size_t regular_size_ = 0;
+  std::atomic<size_t> overflow_count_{0};
+  std::atomic<uint32_t> empty_series_{kNoSeries};
+
+  std::mutex collect_lock_;
+  std::unordered_map<CollectorHandle *, CollectorState> collectors_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
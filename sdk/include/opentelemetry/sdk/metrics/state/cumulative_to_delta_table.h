@@ -0,0 +1,88 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
+#  include "opentelemetry/version.h"
+
+#  include <unordered_map>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * The last cumulative value observed for each series of an asynchronous sum, from which each
+ * new observation is turned into a delta in place.
+ *
+ * The values are held in one contiguous slot per series, looked up by attribute set; a series
+ * keeps its slot for the lifetime of the table. Like AttributesHashMap, the table holds at most
+ * `attributes_limit` - 1 series besides the overflow series. Not thread-safe.
+ */
+template <class T>
+class CumulativeToDeltaTable
+{
+public:
+  explicit CumulativeToDeltaTable(size_t attributes_limit = kAggregationCardinalityLimit)
+      : attributes_limit_(attributes_limit < 2 ? 2 : attributes_limit)
+  {}
+
+  /**
+   * @return true if `attributes` has a slot.
+   */
+  bool Has(const MetricAttributes &attributes) const
+  {
+    return slots_.find(attributes) != slots_.end();
+  }
+
+  /**
+   * @return true if no slot is left for a new attribute set other than the overflow series.
+   */
+  bool IsFull() const noexcept { return regular_size_ >= attributes_limit_ - 1; }
+
+  /**
+   * @return the number of series in the table.
+   */
+  size_t Size() const noexcept { return values_.size(); }
+
+  size_t GetAttributesLimit() const noexcept { return attributes_limit_; }
+
+  /**
+   * Stores `cumulative` as the last value of `attributes`.
+   * @return the difference with the previous value, or `cumulative` for a new series.
+   */
+  T Update(const MetricAttributes &attributes, T cumulative)
+  {
+    auto it = slots_.find(attributes);
+    if (it == slots_.end())
+    {
+      slots_.emplace(attributes, values_.size());
+      values_.push_back(cumulative);
+      if (attributes != AttributesHashMap::GetOverflowAttributes())
+      {
+        ++regular_size_;
+      }
+      return cumulative;
+    }
+    T &last = values_[it->second];
+    T delta = cumulative - last;
+    last    = cumulative;
+    return delta;
+  }
+
+private:
+  size_t attributes_limit_;
+  size_t regular_size_ = 0;
+  // Index of the slot of each series in values_.
+  std::unordered_map<MetricAttributes, size_t, AttributeHashGenerator> slots_;
+  std::vector<T> values_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -0,0 +1,140 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/aggregation/aggregation.h"
+#  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
+#  include "opentelemetry/version.h"
+
+#  include <atomic>
+#  include <cstddef>
+#  include <cstdint>
+#  include <memory>
+#  include <mutex>
+#  include <thread>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * The delta AttributesHashMap of a synchronous storage, double-buffered so that collection can
+ * take the recorded series away without racing with recording threads.
+ *
+ * Recording threads enter the buffer that is active when they start, record into its map, and
+ * leave. Swap() makes the other buffer, holding an empty map, active, then waits for the threads
+ * still inside the previous buffer to leave before handing out its map. Recording thus never
+ * waits for a collection, and a collection only waits for the recordings already in flight; no
+ * lock is held over the series set.
+ */
+class DoubleBufferedAttributesHashMap
+{
+public:
+  explicit DoubleBufferedAttributesHashMap(
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr)
+      : attributes_limit_(attributes_limit), memory_budget_(std::move(memory_budget))
+  {
+    buffers_[0].map.reset(NewMap());
+    buffers_[1].map.reset(NewMap());
+  }
+
+#  ifndef __cpp_aligned_new
+  // Before C++17, new only aligns to alignof(std::max_align_t), not to the cache line of the
+  // buffers: over-allocate, and keep the allocated block right before the object.
+  static void *operator new(size_t size)
+  {
+    const size_t alignment = alignof(DoubleBufferedAttributesHashMap);
+    void *block            = ::operator new(size + sizeof(void *) + alignment - 1);
+    uintptr_t start        = reinterpret_cast<uintptr_t>(block) + sizeof(void *);
+    void *object = reinterpret_cast<void *>((start + alignment - 1) / alignment * alignment);
+    static_cast<void **>(object)[-1] = block;
+    return object;
+  }
+
+  static void operator delete(void *object) noexcept
+  {
+    ::operator delete(static_cast<void **>(object)[-1]);
+  }
+#  endif
+
+  /**
+   * Calls `callback` with the active map. The map is not handed out by Swap() before `callback`
+   * returns, so the aggregations it returns remain valid until then.
+   */
+  template <class Callback>
+  void Update(Callback callback) noexcept
+  {
+    Buffer &buffer = Enter();
+    callback(*buffer.map);
+    buffer.writers.fetch_sub(1, std::memory_order_release);
+  }
+
+  /**
+   * Replaces the active map with an empty one.
+   * @return the map that was active, after every recording into it has completed.
+   */
+  std::unique_ptr<AttributesHashMap> Swap() noexcept
+  {
+    std::lock_guard<std::mutex> guard(swap_lock_);
+    uint32_t previous = active_.load(std::memory_order_relaxed);
+    active_.store(previous ^ 1, std::memory_order_seq_cst);
+
+    Buffer &buffer = buffers_[previous];
+    while (buffer.writers.load(std::memory_order_seq_cst) != 0)
+    {
+      std::this_thread::yield();
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::unique_ptr<AttributesHashMap> map(std::move(buffer.map));
+    // Ready for the next swap, allocated here rather than on a recording thread.
+    buffer.map.reset(NewMap());
+    return map;
+  }
+
+private:
+  // Each on a cache line of its own, as the threads recording into one buffer update its count.
+  struct alignas(kAggregationCacheLineSize) Buffer
+  {
+    // Number of recording threads inside this buffer, or about to check whether they may be.
+    std::atomic<uint32_t> writers{0};
+    std::unique_ptr<AttributesHashMap> map;
+  };
+
+  AttributesHashMap *NewMap() const
+  {
+    return new AttributesHashMap(AttributesHashMap::kDefaultShardCount, attributes_limit_,
+                                 memory_budget_);
+  }
+
+  Buffer &Enter() noexcept
+  {
+    for (;;)
+    {
+      uint32_t index = active_.load(std::memory_order_seq_cst);
+      Buffer &buffer = buffers_[index];
+      buffer.writers.fetch_add(1, std::memory_order_seq_cst);
+      // A Swap() that started before the increment was visible may not wait for this thread:
+      // only stay if the buffer is still active.
+      if (active_.load(std::memory_order_seq_cst) == index)
+      {
+        return buffer;
+      }
+      buffer.writers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  size_t attributes_limit_;
+  std::shared_ptr<common::MemoryBudget> memory_budget_;
+  Buffer buffers_[2];
+  std::atomic<uint32_t> active_{0};
+  std::mutex swap_lock_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -0,0 +1,72 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/common/key_value_iterable.h"
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
+#  include "opentelemetry/version.h"
+
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+/**
+ * The attributes shared by the measurements of Meter::RecordBatch, along with the hash of each
+ * attribute. The hash of a set of attributes is the sum of the hashes of its attributes (see
+ * GetHashForAttributeMap), so the storage of each instrument derives the hash of the attributes
+ * its processor keeps without hashing their values again.
+ *
+ * It refers to the attributes, which must outlive it.
+ */
+class HashedAttributes
+{
+public:
+  explicit HashedAttributes(const opentelemetry::common::KeyValueIterable &attributes)
+      : attributes_(attributes)
+  {
+    hashes_.reserve(attributes.size());
+    attributes.ForEachKeyValue(
+        [this](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          hashes_.push_back(opentelemetry::sdk::common::GetHashForAttribute(key, value));
+          return true;
+        });
+  }
+
+  const opentelemetry::common::KeyValueIterable &GetAttributes() const noexcept
+  {
+    return attributes_;
+  }
+
+  /**
+   * @return GetHashForAttributeMap() of the attributes kept by `attributes_processor`.
+   */
+  size_t GetHash(const AttributesProcessor *attributes_processor) const noexcept
+  {
+    size_t hash  = 0;
+    size_t index = 0;
+    attributes_.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue) noexcept {
+          if (index < hashes_.size() && attributes_processor->isPresent(key))
+          {
+            hash += hashes_[index];
+          }
+          ++index;
+          return true;
+        });
+    return hash;
+  }
+
+private:
+  const opentelemetry::common::KeyValueIterable &attributes_;
+  std::vector<size_t> hashes_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -6,6 +6,8 @@
 #  include "opentelemetry/sdk/metrics/data/metric_data.h"
 #  include "opentelemetry/sdk/metrics/export/metric_producer.h"
 
+#  include <mutex>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -19,6 +21,13 @@ class CollectorHandle
 {
 public:
   virtual AggregationTemporality GetAggregationTemporality() noexcept = 0;
+
+  /**
+   * @return 0 to report every series in the cumulative collections, or the number of collections
+   * after which a series without new measurements is reported again, see
+   * MetricReader::SetChangedOnlyExport.
+   */
+  virtual size_t GetUnchangedSeriesKeepalive() noexcept { return 0; }
 };
 
 /**
@@ -35,10 +44,15 @@ class MetricCollector : public MetricProducer, public CollectorHandle
 
   AggregationTemporality GetAggregationTemporality() noexcept override;
 
+  size_t GetUnchangedSeriesKeepalive() noexcept override;
+
   /**
    * The callback to be called for each metric exporter. This will only be those
    * metrics that have been produced since the last time this method was called.
    *
+   * The ResourceMetrics passed to the callback is only valid during the call: it is reused, with
+   * the storage of its content, by the next collection.
+   *
    * @return a status of completion of method.
    */
   bool Collect(nostd::function_ref<bool(ResourceMetrics &metric_data)> callback) noexcept override;
@@ -50,6 +64,9 @@ class MetricCollector : public MetricProducer, public CollectorHandle
 private:
   std::shared_ptr<MeterContext> meter_context_;
   std::shared_ptr<MetricReader> metric_reader_;
+  // Reused by every collection; the lock serializes the collections using it.
+  ResourceMetrics resource_metrics_;
+  std::mutex collect_lock_;
 };
 }  // namespace metrics
 }  // namespace sdk
@@ -8,6 +8,9 @@
 #  include "opentelemetry/context/context.h"
 #  include "opentelemetry/sdk/metrics/data/metric_data.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
+#  include "opentelemetry/sdk/metrics/state/hashed_attributes.h"
+
+#  include <memory>
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -20,12 +23,31 @@ class CollectorHandle;
 class MetricStorage
 {
 public:
-  /* collect the metrics from this storage */
+  virtual ~MetricStorage() = default;
+
+  /* Called on all the storages of a meter before any of them is collected, so that storages can
+   * start slow work, such as running callbacks, concurrently. */
+  virtual void BeginCollect() noexcept {}
+
+  /* collect the metrics from this storage. The callback may swap the MetricData it receives with
+   * a buffer of its own; the storage then reuses that buffer for a later collection. */
   virtual bool Collect(CollectorHandle *collector,
                        nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                        opentelemetry::common::SystemTimestamp sdk_start_ts,
                        opentelemetry::common::SystemTimestamp collection_ts,
-                       nostd::function_ref<bool(MetricData)> callback) noexcept = 0;
+                       nostd::function_ref<bool(MetricData &)> callback) noexcept = 0;
+};
+
+/* A series of a WritableMetricStorage resolved once for a fixed set of attributes */
+class BoundWritableMetricStorage
+{
+public:
+  virtual void RecordLong(long value, const opentelemetry::context::Context &context) noexcept = 0;
+
+  virtual void RecordDouble(double value,
+                            const opentelemetry::context::Context &context) noexcept = 0;
+
+  virtual ~BoundWritableMetricStorage() = default;
 };
 
 class WritableMetricStorage
@@ -44,6 +66,26 @@ class WritableMetricStorage
                             const opentelemetry::common::KeyValueIterable &attributes,
                             const opentelemetry::context::Context &context) noexcept = 0;
 
+  /* Like RecordLong(value, attributes, context), for attributes hashed once for several storages
+   * by Meter::RecordBatch */
+  virtual void RecordLong(long value,
+                          const HashedAttributes &attributes,
+                          const opentelemetry::context::Context &context) noexcept
+  {
+    RecordLong(value, attributes.GetAttributes(), context);
+  }
+
+  virtual void RecordDouble(double value,
+                            const HashedAttributes &attributes,
+                            const opentelemetry::context::Context &context) noexcept
+  {
+    RecordDouble(value, attributes.GetAttributes(), context);
+  }
+
+  /* Resolve the series for `attributes`, to record into it without looking it up again */
+  virtual std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept = 0;
+
   virtual ~WritableMetricStorage() = default;
 };
 
@@ -54,13 +96,22 @@ class NoopMetricStorage : public MetricStorage
                nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                opentelemetry::common::SystemTimestamp sdk_start_ts,
                opentelemetry::common::SystemTimestamp collection_ts,
-               nostd::function_ref<bool(MetricData)> callback) noexcept override
+               nostd::function_ref<bool(MetricData &)> callback) noexcept override
   {
     MetricData metric_data;
-    return callback(std::move(metric_data));
+    return callback(metric_data);
   }
 };
 
+class NoopBoundWritableMetricStorage : public BoundWritableMetricStorage
+{
+public:
+  void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override {}
+
+  void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
+  {}
+};
+
 class NoopWritableMetricStorage : public WritableMetricStorage
 {
 public:
@@ -78,6 +129,12 @@ class NoopWritableMetricStorage : public WritableMetricStorage
                     const opentelemetry::common::KeyValueIterable &attributes,
                     const opentelemetry::context::Context &context) noexcept override
   {}
+
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    return std::unique_ptr<BoundWritableMetricStorage>(new NoopBoundWritableMetricStorage());
+  }
 };
 
 }  // namespace metrics
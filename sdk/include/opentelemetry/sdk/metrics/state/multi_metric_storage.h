@@ -8,6 +8,7 @@
 #  include "opentelemetry/sdk/metrics/state/metric_storage.h"
 
 #  include <memory>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -15,6 +16,34 @@ namespace sdk
 namespace metrics
 {
 
+class MultiBoundMetricStorage : public BoundWritableMetricStorage
+{
+public:
+  void AddStorage(std::unique_ptr<BoundWritableMetricStorage> storage)
+  {
+    storages_.push_back(std::move(storage));
+  }
+
+  void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override
+  {
+    for (auto &s : storages_)
+    {
+      s->RecordLong(value, context);
+    }
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
+  {
+    for (auto &s : storages_)
+    {
+      s->RecordDouble(value, context);
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<BoundWritableMetricStorage>> storages_;
+};
+
 class MultiMetricStorage : public WritableMetricStorage
 {
 public:
@@ -58,6 +87,37 @@ class MultiMetricStorage : public WritableMetricStorage
     }
   }
 
+  void RecordLong(long value,
+                  const HashedAttributes &attributes,
+                  const opentelemetry::context::Context &context) noexcept override
+  {
+    for (auto &s : storages_)
+    {
+      s->RecordLong(value, attributes, context);
+    }
+  }
+
+  void RecordDouble(double value,
+                    const HashedAttributes &attributes,
+                    const opentelemetry::context::Context &context) noexcept override
+  {
+    for (auto &s : storages_)
+    {
+      s->RecordDouble(value, attributes, context);
+    }
+  }
+
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    std::unique_ptr<MultiBoundMetricStorage> bound(new MultiBoundMetricStorage());
+    for (auto &s : storages_)
+    {
+      bound->AddStorage(s->Bind(attributes));
+    }
+    return std::move(bound);
+  }
+
 private:
   std::vector<std::shared_ptr<WritableMetricStorage>> storages_;
 };
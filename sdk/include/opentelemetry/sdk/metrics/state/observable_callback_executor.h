@@ -0,0 +1,80 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/version.h"
+
+#  include <chrono>
+#  include <condition_variable>
+#  include <deque>
+#  include <functional>
+#  include <mutex>
+#  include <thread>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * Configuration of the callbacks of observable instruments.
+ */
+struct ObservableCallbackOptions
+{
+  // Number of threads running the callbacks. 0 runs each callback inline, on the collecting
+  // thread, without deadline.
+  size_t num_threads = 0;
+
+  // Time a collection waits for a callback. A late callback keeps running, and the collection
+  // reports the last observations of the instrument instead. 0 waits as long as the callback
+  // runs.
+  std::chrono::milliseconds timeout{0};
+};
+
+/**
+ * A fixed pool of threads running the tasks of collections: the callbacks of observable
+ * instruments, so that the callbacks of a collection run concurrently and a slow one does not
+ * delay the others, or the collection of the instruments of a meter in parallel, see
+ * MeterContext::SetCollectionParallelism().
+ *
+ * Tasks still queued when the executor is destroyed are dropped; running ones are waited for.
+ */
+class ObservableCallbackExecutor
+{
+public:
+  /**
+   * Starts `num_threads` threads named `thread_name`, or fewer if the system fails to create them,
+   * see GetThreadCount().
+   */
+  explicit ObservableCallbackExecutor(size_t num_threads,
+                                      const char *thread_name = "otel-callbacks");
+
+  ~ObservableCallbackExecutor();
+
+  ObservableCallbackExecutor(const ObservableCallbackExecutor &) = delete;
+  ObservableCallbackExecutor &operator=(const ObservableCallbackExecutor &) = delete;
+
+  /* Queues `task` to run on one of the threads of the executor. */
+  void Submit(std::function<void()> task);
+
+  /* Returns the number of threads of the executor. A task submitted to none never runs. */
+  size_t GetThreadCount() const noexcept { return workers_.size(); }
+
+private:
+  void DoWork();
+
+  const char *thread_name_;
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopped_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -0,0 +1,101 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/common/numa.h"
+#  include "opentelemetry/sdk/metrics/state/double_buffered_attributes_hashmap.h"
+#  include "opentelemetry/version.h"
+
+#  include <functional>
+#  include <memory>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+/**
+ * The delta AttributesHashMap of a synchronous storage, split in partitions each recorded into
+ * by the threads running on one NUMA node, so that the aggregations of a series are not shared
+ * across nodes while recording. Each partition is a DoubleBufferedAttributesHashMap; Swap()
+ * merges the maps of all the partitions taken away.
+ *
+ * With a single partition, this is a DoubleBufferedAttributesHashMap.
+ */
+class PartitionedAttributesHashMap
+{
+public:
+  explicit PartitionedAttributesHashMap(
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      size_t partition_count                              = 1,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr)
+  {
+    for (size_t i = 0; i < (partition_count == 0 ? 1 : partition_count); ++i)
+    {
+      partitions_.emplace_back(
+          new DoubleBufferedAttributesHashMap(attributes_limit, memory_budget));
+    }
+  }
+
+  size_t GetPartitionCount() const noexcept { return partitions_.size(); }
+
+  /**
+   * Calls `callback` with the active map of the partition of the NUMA node of the calling thread.
+   */
+  template <class Callback>
+  void Update(Callback callback) noexcept
+  {
+    size_t partition =
+        partitions_.size() == 1 ? 0 : common::GetCurrentNumaNode() % partitions_.size();
+    partitions_[partition]->Update(callback);
+  }
+
+  /**
+   * Calls `callback` with the active map of the `partition`-th partition.
+   */
+  template <class Callback>
+  void Update(size_t partition, Callback callback) noexcept
+  {
+    partitions_[partition]->Update(callback);
+  }
+
+  /**
+   * Replaces the active maps of all the partitions with empty ones.
+   * @param create_aggregation creates the aggregations of the merged map, empty.
+   * @param overflow_count set to the measurements folded into the overflow series of the maps.
+   * @return the maps that were active, merged into one, after every recording into them has
+   * completed.
+   */
+  std::unique_ptr<AttributesHashMap> Swap(
+      const std::function<std::unique_ptr<Aggregation>()> &create_aggregation,
+      size_t &overflow_count) noexcept
+  {
+    std::unique_ptr<AttributesHashMap> merged = partitions_[0]->Swap();
+    overflow_count = 0;
+    for (size_t i = 1; i < partitions_.size(); ++i)
+    {
+      std::unique_ptr<AttributesHashMap> map = partitions_[i]->Swap();
+      overflow_count += map->OverflowCount();
+      // The hashes stored in `map` are reused rather than computed again for each merge.
+      map->GetAllEntriesWithHash(
+          [&](size_t hash, const MetricAttributes &attributes, Aggregation &aggregation) {
+            merged->GetOrSetDefault(hash, attributes, create_aggregation)->MergeFrom(aggregation);
+            return true;
+          });
+    }
+    // Includes the series of the other maps folded into the overflow series of the merged map.
+    overflow_count += merged->OverflowCount();
+    return merged;
+  }
+
+private:
+  std::vector<std::unique_ptr<DoubleBufferedAttributesHashMap>> partitions_;
+};
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -5,37 +5,76 @@
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/common/key_value_iterable_view.h"
 #  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/common/empty_attributes.h"
 #  include "opentelemetry/sdk/metrics/aggregation/default_aggregation.h"
 #  include "opentelemetry/sdk/metrics/exemplar/reservoir.h"
 #  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
 #  include "opentelemetry/sdk/metrics/state/metric_collector.h"
 #  include "opentelemetry/sdk/metrics/state/metric_storage.h"
+#  include "opentelemetry/sdk/metrics/state/partitioned_attributes_hashmap.h"
 
 #  include "opentelemetry/sdk/metrics/state/temporal_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
 
+#  include <atomic>
 #  include <list>
 #  include <memory>
+#  include <mutex>
+#  include <vector>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
+/**
+ * Storage of a synchronous instrument for one view. It accepts measurements of the value type of
+ * the instrument, and aggregates them through the Aggregation interface.
+ *
+ * Create() returns a TypedSyncMetricStorage instead when the value type and aggregation of the
+ * view are known, which avoids those runtime dispatches on the record path.
+ *
+ * With several partitions, typically one per NUMA node, the threads of each node record into
+ * aggregations of their own, merged on collection.
+ */
 class SyncMetricStorage : public MetricStorage, public WritableMetricStorage
 {
 
 public:
-  SyncMetricStorage(InstrumentDescriptor instrument_descriptor,
-                    const AggregationType aggregation_type,
-                    const AttributesProcessor *attributes_processor,
-                    nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir)
-      : instrument_descriptor_(instrument_descriptor),
-        aggregation_type_{aggregation_type},
-        attributes_hashmap_(new AttributesHashMap()),
+  /**
+   * @return the storage for `instrument_descriptor` aggregated with `aggregation_type`,
+   * specialized for both when possible.
+   */
+  static std::shared_ptr<SyncMetricStorage> Create(
+      InstrumentDescriptor instrument_descriptor,
+      const AggregationType aggregation_type,
+      const AttributesProcessor *attributes_processor,
+      nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir,
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      size_t max_idle_collections                         = 0,
+      size_t partition_count                              = 1,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr);
+
+  SyncMetricStorage(
+      InstrumentDescriptor instrument_descriptor,
+      const AggregationType aggregation_type,
+      const AttributesProcessor *attributes_processor,
+      nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir,
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      size_t max_idle_collections                         = 0,
+      size_t partition_count                              = 1,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr)
+      : attributes_hashmap_(attributes_limit, partition_count, std::move(memory_budget)),
         attributes_processor_{attributes_processor},
         exemplar_reservoir_(exemplar_reservoir),
-        temporal_metric_storage_(instrument_descriptor)
+        instrument_descriptor_(instrument_descriptor),
+        aggregation_type_{aggregation_type},
+        temporal_metric_storage_(instrument_descriptor,
+                                 aggregation_type,
+                                 attributes_limit,
+                                 max_idle_collections),
+        cumulative_in_place_(max_idle_collections == 0 &&
+                             attributes_hashmap_.GetPartitionCount() == 1)
 
   {
     create_default_aggregation_ = [&]() -> std::unique_ptr<Aggregation> {
@@ -50,8 +89,11 @@ class SyncMetricStorage : public MetricStorage, public WritableMetricStorage
     {
       return;
     }
-    exemplar_reservoir_->OfferMeasurement(value, {}, context, std::chrono::system_clock::now());
-    attributes_hashmap_->GetOrSetDefault({}, create_default_aggregation_)->Aggregate(value);
+    exemplar_reservoir_->OfferMeasurement(value, opentelemetry::sdk::GetEmptyAttributes(),
+                                          context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault({}, create_default_aggregation_)->Aggregate(value);
+    });
   }
 
   void RecordLong(long value,
@@ -63,10 +105,11 @@ class SyncMetricStorage : public MetricStorage, public WritableMetricStorage
       return;
     }
 
-    exemplar_reservoir_->OfferMeasurement(value, attributes, context,
-                                          std::chrono::system_clock::now());
-    auto attr = attributes_processor_->process(attributes);
-    attributes_hashmap_->GetOrSetDefault(attr, create_default_aggregation_)->Aggregate(value);
+    exemplar_reservoir_->OfferMeasurement(value, attributes, context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault(attributes, attributes_processor_, create_default_aggregation_)
+          ->Aggregate(value);
+    });
   }
 
   void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
@@ -75,42 +118,254 @@ class SyncMetricStorage : public MetricStorage, public WritableMetricStorage
     {
       return;
     }
-    exemplar_reservoir_->OfferMeasurement(value, {}, context, std::chrono::system_clock::now());
-    attributes_hashmap_->GetOrSetDefault({}, create_default_aggregation_)->Aggregate(value);
+    exemplar_reservoir_->OfferMeasurement(value, opentelemetry::sdk::GetEmptyAttributes(),
+                                          context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault({}, create_default_aggregation_)->Aggregate(value);
+    });
   }
 
   void RecordDouble(double value,
                     const opentelemetry::common::KeyValueIterable &attributes,
                     const opentelemetry::context::Context &context) noexcept override
   {
-    exemplar_reservoir_->OfferMeasurement(value, attributes, context,
-                                          std::chrono::system_clock::now());
     if (instrument_descriptor_.value_type_ != InstrumentValueType::kDouble)
     {
       return;
     }
-    exemplar_reservoir_->OfferMeasurement(value, attributes, context,
-                                          std::chrono::system_clock::now());
-    auto attr = attributes_processor_->process(attributes);
-    attributes_hashmap_->GetOrSetDefault(attr, create_default_aggregation_)->Aggregate(value);
+    exemplar_reservoir_->OfferMeasurement(value, attributes, context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault(attributes, attributes_processor_, create_default_aggregation_)
+          ->Aggregate(value);
+    });
+  }
+
+  void RecordLong(long value,
+                  const HashedAttributes &attributes,
+                  const opentelemetry::context::Context &context) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ != InstrumentValueType::kLong)
+    {
+      return;
+    }
+    exemplar_reservoir_->OfferMeasurement(value, attributes.GetAttributes(), context);
+    size_t hash = attributes.GetHash(attributes_processor_);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault(hash, attributes.GetAttributes(), attributes_processor_,
+                          create_default_aggregation_)
+          ->Aggregate(value);
+    });
+  }
+
+  void RecordDouble(double value,
+                    const HashedAttributes &attributes,
+                    const opentelemetry::context::Context &context) noexcept override
+  {
+    if (instrument_descriptor_.value_type_ != InstrumentValueType::kDouble)
+    {
+      return;
+    }
+    exemplar_reservoir_->OfferMeasurement(value, attributes.GetAttributes(), context);
+    size_t hash = attributes.GetHash(attributes_processor_);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      map.GetOrSetDefault(hash, attributes.GetAttributes(), attributes_processor_,
+                          create_default_aggregation_)
+          ->Aggregate(value);
+    });
   }
 
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
+
   bool Collect(CollectorHandle *collector,
                nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                opentelemetry::common::SystemTimestamp sdk_start_ts,
                opentelemetry::common::SystemTimestamp collection_ts,
-               nostd::function_ref<bool(MetricData)> callback) noexcept override;
+               nostd::function_ref<bool(MetricData &)> callback) noexcept override;
 
-private:
-  InstrumentDescriptor instrument_descriptor_;
-  AggregationType aggregation_type_;
-
-  // hashmap to maintain the metrics for delta collection (i.e, collection since last Collect call)
-  std::unique_ptr<AttributesHashMap> attributes_hashmap_;
+protected:
+  // Hashmap to maintain the metrics for delta collection (i.e, collection since last Collect
+  // call), or the running totals when cumulative_in_place_ is set. Its aggregations are all
+  // created by create_default_aggregation_.
+  PartitionedAttributesHashMap attributes_hashmap_;
   const AttributesProcessor *attributes_processor_;
   std::function<std::unique_ptr<Aggregation>()> create_default_aggregation_;
   nostd::shared_ptr<ExemplarReservoir> exemplar_reservoir_;
+
+private:
+  // A series recorded into through bound handles. It is shared by the storage and its handles, so
+  // its aggregation is never replaced or freed while a handle may still record into it: it stays
+  // cumulative since Bind, and Collect reports the difference with the previous collection.
+  struct BoundSeries
+  {
+    BoundSeries(MetricAttributes &&attributes,
+                std::unique_ptr<Aggregation> &&aggregation,
+                std::unique_ptr<Aggregation> &&last_collected)
+        : attributes(std::move(attributes)),
+          aggregation(std::move(aggregation)),
+          last_collected(std::move(last_collected))
+    {}
+
+    const MetricAttributes attributes;
+    const std::unique_ptr<Aggregation> aggregation;
+    // Value of `aggregation` at the previous collection; only accessed by Collect.
+    std::unique_ptr<Aggregation> last_collected;
+    // Set by every recording, cleared by Collect, so that idle series report nothing.
+    std::atomic<bool> updated{false};
+  };
+
+  class BoundStorage;
+
+  // Report what the bound series recorded since the previous collection into `delta_metrics`,
+  // and forget the series whose handles are all gone.
+  void CollectBoundSeries(AttributesHashMap &delta_metrics) noexcept;
+
+  // Warn about the `overflow_count` measurements folded into the overflow series, past the
+  // `reported` ones already warned about.
+  void WarnOverflow(size_t overflow_count, size_t reported) const noexcept;
+
+  InstrumentDescriptor instrument_descriptor_;
+  AggregationType aggregation_type_;
   TemporalMetricStorage temporal_metric_storage_;
+
+  // Serializes the collections.
+  std::mutex collect_lock_;
+  // While every collector is cumulative, the active map of attributes_hashmap_ is never swapped:
+  // it keeps the running totals, which are reported as is. Cleared for good by the first delta
+  // collector, or when idle series are evicted, which needs the temporal storage, or when the
+  // totals are split across partitions.
+  bool cumulative_in_place_;
+  // Measurements folded into the overflow series of the running totals so far.
+  size_t cumulative_overflow_count_ = 0;
+
+  std::mutex bound_series_lock_;
+  std::vector<std::shared_ptr<BoundSeries>> bound_series_;
+};
+
+/**
+ * A SyncMetricStorage for `T` measurements aggregated with `AggregationT`.
+ *
+ * Measurements of the other value type are discarded by overload resolution rather than checked
+ * on every call, and the aggregations are updated with a direct, inlinable call to
+ * AggregationT::Aggregate instead of a virtual one.
+ */
+template <class T, class AggregationT>
+class TypedSyncMetricStorage : public SyncMetricStorage
+{
+public:
+  TypedSyncMetricStorage(
+      InstrumentDescriptor instrument_descriptor,
+      const AggregationType aggregation_type,
+      const AttributesProcessor *attributes_processor,
+      nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir,
+      size_t attributes_limit                             = kAggregationCardinalityLimit,
+      size_t max_idle_collections                         = 0,
+      size_t partition_count                              = 1,
+      std::shared_ptr<common::MemoryBudget> memory_budget = nullptr)
+      : SyncMetricStorage(instrument_descriptor,
+                          aggregation_type,
+                          attributes_processor,
+                          std::move(exemplar_reservoir),
+                          attributes_limit,
+                          max_idle_collections,
+                          partition_count,
+                          std::move(memory_budget))
+  {
+    // Guarantees the downcast in Record(), whatever DefaultAggregation would have created.
+    create_default_aggregation_ = []() -> std::unique_ptr<Aggregation> {
+      return std::unique_ptr<Aggregation>(new AggregationT());
+    };
+  }
+
+  void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, context);
+  }
+
+  void RecordLong(long value,
+                  const opentelemetry::common::KeyValueIterable &attributes,
+                  const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, attributes, context);
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, context);
+  }
+
+  void RecordDouble(double value,
+                    const opentelemetry::common::KeyValueIterable &attributes,
+                    const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, attributes, context);
+  }
+
+  void RecordLong(long value,
+                  const HashedAttributes &attributes,
+                  const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, attributes, context);
+  }
+
+  void RecordDouble(double value,
+                    const HashedAttributes &attributes,
+                    const opentelemetry::context::Context &context) noexcept override
+  {
+    Record(value, attributes, context);
+  }
+
+private:
+  void Record(T value, const opentelemetry::context::Context &context) noexcept
+  {
+    exemplar_reservoir_->OfferMeasurement(value, opentelemetry::sdk::GetEmptyAttributes(),
+                                          context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      static_cast<AggregationT *>(map.GetOrSetDefault({}, create_default_aggregation_))
+          ->AggregationT::Aggregate(value);
+    });
+  }
+
+  void Record(T value,
+              const opentelemetry::common::KeyValueIterable &attributes,
+              const opentelemetry::context::Context &context) noexcept
+  {
+    exemplar_reservoir_->OfferMeasurement(value, attributes, context);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      static_cast<AggregationT *>(
+          map.GetOrSetDefault(attributes, attributes_processor_, create_default_aggregation_))
+          ->AggregationT::Aggregate(value);
+    });
+  }
+
+  void Record(T value,
+              const HashedAttributes &attributes,
+              const opentelemetry::context::Context &context) noexcept
+  {
+    exemplar_reservoir_->OfferMeasurement(value, attributes.GetAttributes(), context);
+    size_t hash = attributes.GetHash(attributes_processor_);
+    attributes_hashmap_.Update([&](AttributesHashMap &map) {
+      static_cast<AggregationT *>(map.GetOrSetDefault(hash, attributes.GetAttributes(),
+                                                      attributes_processor_,
+                                                      create_default_aggregation_))
+          ->AggregationT::Aggregate(value);
+    });
+  }
+
+  // Measurements of the other value type.
+  template <class Other>
+  void Record(Other, const opentelemetry::context::Context &) noexcept
+  {}
+
+  template <class Other>
+  void Record(Other,
+              const opentelemetry::common::KeyValueIterable &,
+              const opentelemetry::context::Context &) noexcept
+  {}
+
+  template <class Other>
+  void Record(Other, const HashedAttributes &, const opentelemetry::context::Context &) noexcept
+  {}
 };
 
 }  // namespace metrics
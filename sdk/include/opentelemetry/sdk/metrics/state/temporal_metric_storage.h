@@ -6,7 +6,10 @@
 #  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
 #  include "opentelemetry/sdk/metrics/state/metric_collector.h"
 
+#  include <cstdint>
+#  include <deque>
 #  include <memory>
+#  include <unordered_map>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -14,30 +17,107 @@ namespace sdk
 namespace metrics
 {
 
-struct LastReportedMetrics
+struct CumulativeMetrics
 {
+  // The cumulative metrics, shared by all the cumulative collectors.
   std::unique_ptr<AttributesHashMap> attributes_map;
+  // Sequence number of the first delta map not merged in `attributes_map` yet.
+  uint64_t next_delta = 0;
+  // Number of cumulative collections so far, and the collection in which each series of
+  // `attributes_map` was last updated. Only maintained when idle series are evicted.
+  uint64_t collection_count = 0;
+  std::unordered_map<const Aggregation *, uint64_t> last_updates;
+};
+
+// A series reported to a collector which leaves out the unchanged cumulative series.
+struct ReportedSeries
+{
+  size_t attributes_hash = 0;
+  // Changes with every measurement aggregated in the series, as of its last report.
+  uint64_t fingerprint = 0;
+  // The collections of the collector in which the series was last reported, and last seen.
+  uint64_t reported_collection = 0;
+  uint64_t seen_collection     = 0;
+};
+
+struct LastReportedMetrics
+{
   opentelemetry::common::SystemTimestamp collection_ts;
+  // Sequence number of the first delta map not reported yet; unused for cumulative collectors.
+  uint64_t next_delta = 0;
+  // The metrics are reported in this buffer, refilled in place by every collection so that its
+  // strings, vectors and attribute maps keep their storage.
+  MetricData metric_data;
+  // Only maintained for the collectors leaving out the unchanged cumulative series: number of
+  // their collections so far, and the series they reported, by aggregation.
+  uint64_t collection_count = 0;
+  std::unordered_map<const Aggregation *, ReportedSeries> reported_series;
 };
 
 class TemporalMetricStorage
 {
 public:
-  TemporalMetricStorage(InstrumentDescriptor instrument_descriptor);
+  TemporalMetricStorage(InstrumentDescriptor instrument_descriptor,
+                        AggregationType aggregation_type = AggregationType::kDefault,
+                        size_t attributes_limit          = kAggregationCardinalityLimit,
+                        size_t max_idle_collections      = 0);
 
   bool buildMetrics(CollectorHandle *collector,
                     nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                     opentelemetry::common::SystemTimestamp sdk_start_ts,
                     opentelemetry::common::SystemTimestamp collection_ts,
                     std::shared_ptr<AttributesHashMap> delta_metrics,
-                    nostd::function_ref<bool(MetricData)> callback) noexcept;
+                    nostd::function_ref<bool(MetricData &)> callback) noexcept;
+
+  /**
+   * Reports `cumulative_metrics`, the running totals kept by a storage whose collectors are all
+   * cumulative, to `collector`, without stashing or merging them.
+   */
+  bool buildCumulativeMetrics(CollectorHandle *collector,
+                              opentelemetry::common::SystemTimestamp sdk_start_ts,
+                              opentelemetry::common::SystemTimestamp collection_ts,
+                              const AttributesHashMap &cumulative_metrics,
+                              nostd::function_ref<bool(MetricData &)> callback) noexcept;
 
 private:
+  // Fills the buffer of `reported` with `metrics`, collected at `collection_ts`, and calls
+  // `callback` with it. With `unchanged_keepalive` set, cumulative series without new
+  // measurements since the previous report are left out, unless they were last reported
+  // `unchanged_keepalive` collections ago.
+  bool ReportMetrics(LastReportedMetrics &reported,
+                     size_t unchanged_keepalive,
+                     AggregationTemporality aggregation_temporality,
+                     opentelemetry::common::SystemTimestamp collection_ts,
+                     const AttributesHashMap &metrics,
+                     nostd::function_ref<bool(MetricData &)> callback) noexcept;
+
+  // Merges every entry of `delta` into the matching entry of `target`, in place. Entries of new
+  // attribute sets past the cardinality limit of `target` are merged into its overflow series.
+  // If `cumulative` is set, the merged series are marked as updated in its current collection.
+  void MergeInto(AttributesHashMap &target,
+                 const AttributesHashMap &delta,
+                 CumulativeMetrics *cumulative = nullptr) const noexcept;
+
+  // Drops the cumulative series not updated in the last max_idle_collections_ collections.
+  void EvictIdleSeries(CumulativeMetrics &cumulative) const noexcept;
+
+  // Drops the delta maps already reported to every collector in `collectors`, and the state of
+  // the collectors no longer in it.
+  void TrimUnreportedDeltas(nostd::span<std::shared_ptr<CollectorHandle>> collectors) noexcept;
+
   InstrumentDescriptor instrument_descriptor_;
+  AggregationType aggregation_type_;
+  size_t attributes_limit_;
+  // Number of cumulative collections, by any cumulative collector, a cumulative series may go
+  // without update before it's dropped; 0 keeps series forever.
+  size_t max_idle_collections_;
 
-  // unreported metrics stash for all the collectors
-  std::unordered_map<CollectorHandle *, std::list<std::shared_ptr<AttributesHashMap>>>
-      unreported_metrics_;
+  // Delta maps not reported to every collector yet, oldest first. unreported_deltas_[i] has the
+  // sequence number first_delta_ + i. Each delta map is collected once for all the collectors.
+  std::deque<std::shared_ptr<AttributesHashMap>> unreported_deltas_;
+  uint64_t first_delta_ = 0;
+  // The cumulative collectors report the same metrics, merged once from the delta maps.
+  CumulativeMetrics cumulative_metrics_;
   // last reported metrics stash for all the collectors.
   std::unordered_map<CollectorHandle *, LastReportedMetrics> last_reported_metrics_;
 
@@ -18,6 +18,8 @@ namespace metrics
 
 // forward declaration
 class WritableMetricStorage;
+class BoundWritableMetricStorage;
+class HashedAttributes;
 
 class Synchronous
 {
@@ -27,11 +29,73 @@ class Synchronous
       : instrument_descriptor_(instrument_descriptor), storage_(std::move(storage))
   {}
 
+  /* Record a value of Meter::RecordBatch, whose validity the meter checked */
+  void RecordLong(long value,
+                  const HashedAttributes &attributes,
+                  const opentelemetry::context::Context &context) noexcept;
+
+  void RecordDouble(double value,
+                    const HashedAttributes &attributes,
+                    const opentelemetry::context::Context &context) noexcept;
+
 protected:
   InstrumentDescriptor instrument_descriptor_;
   std::unique_ptr<WritableMetricStorage> storage_;
 };
 
+class BoundSynchronous
+{
+public:
+  BoundSynchronous(InstrumentDescriptor instrument_descriptor,
+                   std::unique_ptr<BoundWritableMetricStorage> storage);
+  ~BoundSynchronous();
+
+protected:
+  InstrumentDescriptor instrument_descriptor_;
+  std::unique_ptr<BoundWritableMetricStorage> storage_;
+};
+
+class LongBoundCounter : public BoundSynchronous, public opentelemetry::metrics::BoundCounter<long>
+{
+public:
+  LongBoundCounter(InstrumentDescriptor instrument_descriptor,
+                   std::unique_ptr<BoundWritableMetricStorage> storage);
+
+  void Add(long value) noexcept override;
+  void Add(long value, const opentelemetry::context::Context &context) noexcept override;
+};
+
+class DoubleBoundCounter : public BoundSynchronous,
+                           public opentelemetry::metrics::BoundCounter<double>
+{
+public:
+  DoubleBoundCounter(InstrumentDescriptor instrument_descriptor,
+                     std::unique_ptr<BoundWritableMetricStorage> storage);
+
+  void Add(double value) noexcept override;
+  void Add(double value, const opentelemetry::context::Context &context) noexcept override;
+};
+
+class LongBoundHistogram : public BoundSynchronous,
+                           public opentelemetry::metrics::BoundHistogram<long>
+{
+public:
+  LongBoundHistogram(InstrumentDescriptor instrument_descriptor,
+                     std::unique_ptr<BoundWritableMetricStorage> storage);
+
+  void Record(long value, const opentelemetry::context::Context &context) noexcept override;
+};
+
+class DoubleBoundHistogram : public BoundSynchronous,
+                             public opentelemetry::metrics::BoundHistogram<double>
+{
+public:
+  DoubleBoundHistogram(InstrumentDescriptor instrument_descriptor,
+                       std::unique_ptr<BoundWritableMetricStorage> storage);
+
+  void Record(double value, const opentelemetry::context::Context &context) noexcept override;
+};
+
 class LongCounter : public Synchronous, public opentelemetry::metrics::Counter<long>
 {
 public:
@@ -45,6 +109,9 @@ class LongCounter : public Synchronous, public opentelemetry::metrics::Counter<l
 
   void Add(long value) noexcept override;
   void Add(long value, const opentelemetry::context::Context &context) noexcept override;
+
+  nostd::shared_ptr<opentelemetry::metrics::BoundCounter<long>> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
 };
 
 class DoubleCounter : public Synchronous, public opentelemetry::metrics::Counter<double>
@@ -62,6 +129,9 @@ class DoubleCounter : public Synchronous, public opentelemetry::metrics::Counter
 
   void Add(double value) noexcept override;
   void Add(double value, const opentelemetry::context::Context &context) noexcept override;
+
+  nostd::shared_ptr<opentelemetry::metrics::BoundCounter<double>> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
 };
 
 class LongUpDownCounter : public Synchronous, public opentelemetry::metrics::UpDownCounter<long>
@@ -106,6 +176,9 @@ class LongHistogram : public Synchronous, public opentelemetry::metrics::Histogr
               const opentelemetry::context::Context &context) noexcept override;
 
   void Record(long value, const opentelemetry::context::Context &context) noexcept override;
+
+  nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<long>> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
 };
 
 class DoubleHistogram : public Synchronous, public opentelemetry::metrics::Histogram<double>
@@ -119,6 +192,9 @@ class DoubleHistogram : public Synchronous, public opentelemetry::metrics::Histo
               const opentelemetry::context::Context &context) noexcept override;
 
   void Record(double value, const opentelemetry::context::Context &context) noexcept override;
+
+  nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<double>> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
 };
 
 }  // namespace metrics
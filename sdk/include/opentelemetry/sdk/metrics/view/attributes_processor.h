@@ -3,13 +3,20 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
+#  include <array>
+#  include <cstdint>
+#  include <string>
+#  include <unordered_map>
+#  include <vector>
+
+#  include "opentelemetry/common/key_value_iterable_view.h"
 #  include "opentelemetry/sdk/common/attribute_utils.h"
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
-using MetricAttributes = opentelemetry::sdk::common::OrderedAttributeMap;
+using MetricAttributes = opentelemetry::sdk::common::MetricAttributeMap;
 
 /**
  * The AttributesProcessor is responsible for customizing which
@@ -24,6 +31,18 @@ class AttributesProcessor
   virtual MetricAttributes process(
       const opentelemetry::common::KeyValueIterable &attributes) const noexcept = 0;
 
+  // Check whether the given attribute key is kept by process().
+  // process() must return exactly the input attributes whose keys are accepted here; this lets
+  // the storage look up existing series without calling process(). By default, process() is asked
+  // about the key alone: processors override this with a cheaper lookup.
+  virtual bool isPresent(nostd::string_view key) const noexcept
+  {
+    std::array<std::pair<nostd::string_view, bool>, 1> attribute = {{{key, true}}};
+    return !process(
+                opentelemetry::common::KeyValueIterableView<decltype(attribute)>(attribute))
+                .empty();
+  }
+
   virtual ~AttributesProcessor() = default;
 };
 
@@ -40,11 +59,17 @@ class DefaultAttributesProcessor : public AttributesProcessor
     MetricAttributes result(attributes);
     return result;
   }
+
+  bool isPresent(nostd::string_view /* key */) const noexcept override { return true; }
 };
 
 /**
  * FilteringAttributesProcessor  filters by allowed attribute names and drops any names
  * that are not in the allow list.
+ *
+ * The allow list is compiled into a perfect hash table, whose seed is chosen so that no two
+ * allowed keys share a slot: a key is looked up with one hash and at most one comparison, without
+ * copying it. Keys whose length no allowed key has are rejected before hashing.
  */
 
 class FilteringAttributesProcessor : public AttributesProcessor
@@ -52,8 +77,14 @@ class FilteringAttributesProcessor : public AttributesProcessor
 public:
   FilteringAttributesProcessor(
       const std::unordered_map<std::string, bool> allowed_attribute_keys = {})
-      : allowed_attribute_keys_(std::move(allowed_attribute_keys))
-  {}
+  {
+    for (auto &kv : allowed_attribute_keys)
+    {
+      length_mask_ |= LengthBit(kv.first.size());
+      allowed_keys_.push_back(kv.first);
+    }
+    BuildTable();
+  }
 
   MetricAttributes process(
       const opentelemetry::common::KeyValueIterable &attributes) const noexcept override
@@ -61,7 +92,7 @@ class FilteringAttributesProcessor : public AttributesProcessor
     MetricAttributes result;
     attributes.ForEachKeyValue(
         [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
-          if (allowed_attribute_keys_.find(key.data()) != allowed_attribute_keys_.end())
+          if (isPresent(key))
           {
             result.SetAttribute(key, value);
             return true;
@@ -71,8 +102,73 @@ class FilteringAttributesProcessor : public AttributesProcessor
     return result;
   }
 
+  bool isPresent(nostd::string_view key) const noexcept override
+  {
+    if ((length_mask_ & LengthBit(key.size())) == 0)
+    {
+      return false;
+    }
+    uint32_t index = slots_[Hash(key, seed_) & slot_mask_];
+    return index != kEmptySlot && nostd::string_view(allowed_keys_[index]) == key;
+  }
+
 private:
-  std::unordered_map<std::string, bool> allowed_attribute_keys_;
+  static constexpr uint32_t kEmptySlot = 0xFFFFFFFF;
+
+  static uint64_t LengthBit(size_t length) noexcept
+  {
+    return uint64_t(1) << (length < 63 ? length : 63);
+  }
+
+  /* FNV-1a, with the seed mixed into the offset basis. */
+  static size_t Hash(nostd::string_view key, uint64_t seed) noexcept
+  {
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+    for (char c : key)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  /* Finds a seed for which the allowed keys hash to distinct slots, growing the table if needed. */
+  void BuildTable()
+  {
+    size_t size = 1;
+    while (size < 2 * allowed_keys_.size())
+    {
+      size *= 2;
+    }
+    for (;; size *= 2)
+    {
+      for (uint64_t seed = 0; seed < 16; ++seed)
+      {
+        slots_.assign(size, static_cast<uint32_t>(kEmptySlot));
+        bool collision = false;
+        for (uint32_t i = 0; i < allowed_keys_.size() && !collision; ++i)
+        {
+          uint32_t &slot = slots_[Hash(allowed_keys_[i], seed) & (size - 1)];
+          collision      = slot != kEmptySlot;
+          slot           = i;
+        }
+        if (!collision)
+        {
+          seed_      = seed;
+          slot_mask_ = size - 1;
+          return;
+        }
+      }
+    }
+  }
+
+  std::vector<std::string> allowed_keys_;
+  // Index in allowed_keys_ of the key hashing to each slot, kEmptySlot if none.
+  std::vector<uint32_t> slots_;
+  size_t slot_mask_ = 0;
+  uint64_t seed_    = 0;
+  // Bit min(length, 63) is set for the length of each allowed key.
+  uint64_t length_mask_ = 0;
 };
 
 }  // namespace metrics
@@ -3,14 +3,8 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
+#  include <string>
 #  include <vector>
-#  if (__GNUC__ == 4 && (__GNUC_MINOR__ == 8 || __GNUC_MINOR__ == 9))
-#    define HAVE_WORKING_REGEX 0
-#    include "opentelemetry/sdk/common/global_log_handler.h"
-#  else
-#    include <regex>
-#    define HAVE_WORKING_REGEX 1
-#  endif
 
 #  include "opentelemetry/nostd/string_view.h"
 
@@ -24,30 +18,125 @@ class Predicate
 public:
   virtual ~Predicate()                                                        = default;
   virtual bool Match(opentelemetry::nostd::string_view string) const noexcept = 0;
+
+  /**
+   * @return the only string this predicate matches, or nullptr if it matches none or several.
+   * Lets callers index the strings of exact predicates in a hash map instead of trying each.
+   */
+  virtual const std::string *GetExactMatch() const noexcept { return nullptr; }
 };
 
+/**
+ * Matches a wildcard pattern, where '*' matches any sequence of characters and '?' any single
+ * character. The pattern is split once, at construction, into the literal segments between its
+ * '*'; a match then scans the string once for each segment in turn, with no backtracking.
+ */
 class PatternPredicate : public Predicate
 {
 public:
-  PatternPredicate(opentelemetry::nostd::string_view pattern) : reg_key_{pattern.data()} {}
+  PatternPredicate(opentelemetry::nostd::string_view pattern)
+  {
+    std::string segment;
+    for (char c : pattern)
+    {
+      if (c != '*')
+      {
+        segment += c;
+        continue;
+      }
+      has_star_ = true;
+      if (segments_.empty() && segment.empty())
+      {
+        leading_star_ = true;
+      }
+      if (!segment.empty())
+      {
+        segments_.push_back(std::move(segment));
+        segment.clear();
+      }
+    }
+    trailing_star_ = !pattern.empty() && pattern[pattern.size() - 1] == '*';
+    if (!segment.empty())
+    {
+      segments_.push_back(std::move(segment));
+    }
+  }
+
   bool Match(opentelemetry::nostd::string_view str) const noexcept override
   {
-#  if HAVE_WORKING_REGEX
-    return std::regex_match(str.data(), reg_key_);
-#  else
-    // TBD - Support regex match for GCC4.8
-    OTEL_INTERNAL_LOG_ERROR(
-        "PatternPredicate::Match - failed. std::regex not fully supported for this compiler.");
-    return false;  // not supported
-#  endif
+    if (!has_star_)
+    {
+      return segments_.empty() ? str.empty()
+                               : str.size() == segments_[0].size() && MatchAt(segments_[0], str, 0);
+    }
+
+    // The first segment is anchored at the start of the string, unless the pattern starts with a
+    // '*', and the last one at its end, unless the pattern ends with a '*'.
+    size_t first = 0;
+    size_t last  = segments_.size();
+    size_t begin = 0;
+    size_t end   = str.size();
+    if (!leading_star_)
+    {
+      if (!MatchAt(segments_[0], str, 0))
+      {
+        return false;
+      }
+      begin = segments_[0].size();
+      ++first;
+    }
+    if (!trailing_star_)
+    {
+      const std::string &segment = segments_[last - 1];
+      if (segment.size() > end - begin || !MatchAt(segment, str, end - segment.size()))
+      {
+        return false;
+      }
+      end -= segment.size();
+      --last;
+    }
+    // The other segments match the leftmost occurrence after the previous one: matching any later
+    // occurrence would only leave less of the string to the following segments.
+    for (size_t i = first; i < last; ++i)
+    {
+      const std::string &segment = segments_[i];
+      while (begin + segment.size() <= end && !MatchAt(segment, str, begin))
+      {
+        ++begin;
+      }
+      if (begin + segment.size() > end)
+      {
+        return false;
+      }
+      begin += segment.size();
+    }
+    return true;
   }
 
 private:
-#  if HAVE_WORKING_REGEX
-  std::regex reg_key_;
-#  else
-  std::string reg_key_;
-#  endif
+  /* Matches a segment, in which '?' matches any character, at a position of str. */
+  static bool MatchAt(const std::string &segment,
+                      opentelemetry::nostd::string_view str,
+                      size_t position) noexcept
+  {
+    if (position + segment.size() > str.size())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < segment.size(); ++i)
+    {
+      if (segment[i] != '?' && segment[i] != str[position + i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<std::string> segments_;
+  bool has_star_      = false;
+  bool leading_star_  = false;
+  bool trailing_star_ = false;
 };
 
 class ExactPredicate : public Predicate
@@ -63,6 +152,8 @@ class ExactPredicate : public Predicate
     return false;
   }
 
+  const std::string *GetExactMatch() const noexcept override { return &pattern_; }
+
 private:
   std::string pattern_;
 };
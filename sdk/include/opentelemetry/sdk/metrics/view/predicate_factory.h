@@ -28,6 +28,12 @@ class PredicateFactory
     {
       return std::move(std::unique_ptr<Predicate>(new MatchEverythingPattern()));
     }
+    // A pattern without wildcards matches one name, which ViewRegistry looks up in a hash map.
+    if (type == PredicateType::kPattern && pattern.find('*') == nostd::string_view::npos &&
+        pattern.find('?') == nostd::string_view::npos)
+    {
+      return std::move(std::unique_ptr<Predicate>(new ExactPredicate(pattern)));
+    }
     if (type == PredicateType::kPattern)
     {
       return std::move(std::unique_ptr<Predicate>(new PatternPredicate(pattern)));
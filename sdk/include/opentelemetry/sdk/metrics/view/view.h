@@ -6,6 +6,7 @@
 #  include "opentelemetry/nostd/string_view.h"
 #  include "opentelemetry/sdk/metrics/aggregation/default_aggregation.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
+#  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
 #  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -26,11 +27,17 @@ class View
        AggregationType aggregation_type = AggregationType::kDefault,
        std::unique_ptr<opentelemetry::sdk::metrics::AttributesProcessor> attributes_processor =
            std::unique_ptr<opentelemetry::sdk::metrics::AttributesProcessor>(
-               new opentelemetry::sdk::metrics::DefaultAttributesProcessor()))
+               new opentelemetry::sdk::metrics::DefaultAttributesProcessor()),
+       size_t aggregation_cardinality_limit = kAggregationCardinalityLimit,
+       size_t max_idle_collections          = 0,
+       bool columnar_storage                = false)
       : name_(name),
         description_(description),
         aggregation_type_{aggregation_type},
-        attributes_processor_{std::move(attributes_processor)}
+        attributes_processor_{std::move(attributes_processor)},
+        aggregation_cardinality_limit_{aggregation_cardinality_limit},
+        max_idle_collections_{max_idle_collections},
+        columnar_storage_{columnar_storage}
   {}
 
   virtual std::string GetName() const noexcept { return name_; }
@@ -45,11 +52,30 @@ class View
     return *attributes_processor_.get();
   }
 
+  /* Maximum number of series, including the overflow series, the view aggregates per
+   * collection cycle and reports to a cumulative reader. */
+  virtual size_t GetAggregationCardinalityLimit() const noexcept
+  {
+    return aggregation_cardinality_limit_;
+  }
+
+  /* Number of collections a series may go without measurements before cumulative readers stop
+   * reporting it. 0 keeps the series forever. */
+  virtual size_t GetMaxIdleCollections() const noexcept { return max_idle_collections_; }
+
+  /* Whether the view aggregates the sums of synchronous counters and up-down counters in a
+   * ColumnarSumMetricStorage, which takes less memory per series and scans them faster on
+   * collection. Ignored for other instruments and aggregations, and when series are evicted. */
+  virtual bool UsesColumnarStorage() const noexcept { return columnar_storage_; }
+
 private:
   std::string name_;
   std::string description_;
   AggregationType aggregation_type_;
   std::unique_ptr<opentelemetry::sdk::metrics::AttributesProcessor> attributes_processor_;
+  size_t aggregation_cardinality_limit_;
+  size_t max_idle_collections_;
+  bool columnar_storage_;
 };
 }  // namespace metrics
 }  // namespace sdk
@@ -3,7 +3,11 @@
 
 #pragma once
 #ifndef ENABLE_METRICS_PREVIEW
+#  include <memory>
+#  include <mutex>
+#  include <string>
 #  include <unordered_map>
+#  include <vector>
 #  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
 #  include "opentelemetry/sdk/metrics/view/meter_selector.h"
@@ -29,6 +33,13 @@ struct RegisteredView
   std::unique_ptr<opentelemetry::sdk::metrics::View> view_;
 };
 
+/**
+ * The views of a meter provider, and the views resolved for each instrument.
+ *
+ * Views whose instrument selector names one instrument are indexed by that name, so that an
+ * instrument is only matched against the views naming it and those with a wildcard pattern. The
+ * views found for an instrument are cached by meter and instrument, until a view is added.
+ */
 class ViewRegistry
 {
 public:
@@ -36,11 +47,23 @@ class ViewRegistry
                std::unique_ptr<opentelemetry::sdk::metrics::MeterSelector> meter_selector,
                std::unique_ptr<opentelemetry::sdk::metrics::View> view)
   {
-    // TBD - thread-safe ?
-
     auto registered_view = std::unique_ptr<RegisteredView>(new RegisteredView{
         std::move(instrument_selector), std::move(meter_selector), std::move(view)});
+
+    std::lock_guard<std::mutex> guard(lock_);
+    const size_t index = registered_views_.size();
+    const std::string *name =
+        registered_view->instrument_selector_->GetNameFilter()->GetExactMatch();
+    if (name != nullptr)
+    {
+      views_by_name_[*name].push_back(index);
+    }
+    else
+    {
+      wildcard_views_.push_back(index);
+    }
     registered_views_.push_back(std::move(registered_view));
+    resolved_views_.clear();
   }
 
   bool FindViews(const opentelemetry::sdk::metrics::InstrumentDescriptor &instrument_descriptor,
@@ -48,21 +71,17 @@ class ViewRegistry
                      &instrumentation_library,
                  nostd::function_ref<bool(const View &)> callback) const
   {
-    bool found = false;
-    for (auto const &registered_view : registered_views_)
+    std::shared_ptr<const std::vector<const View *>> views =
+        ResolveViews(instrument_descriptor, instrumentation_library);
+    for (const View *view : *views)
     {
-      if (MatchMeter(registered_view->meter_selector_.get(), instrumentation_library) &&
-          MatchInstrument(registered_view->instrument_selector_.get(), instrument_descriptor))
+      if (!callback(*view))
       {
-        found = true;
-        if (!callback(*(registered_view->view_.get())))
-        {
-          return false;
-        }
+        return false;
       }
     }
     // return default view if none found;
-    if (!found)
+    if (views->empty())
     {
       static View view("otel-default-view");
       if (!callback(view))
@@ -76,7 +95,79 @@ class ViewRegistry
   ~ViewRegistry() = default;
 
 private:
+  // Beyond this number of instruments, the cache is cleared rather than grown.
+  static constexpr size_t kMaxResolvedViews = 4096;
+
+  std::shared_ptr<const std::vector<const View *>> ResolveViews(
+      const opentelemetry::sdk::metrics::InstrumentDescriptor &instrument_descriptor,
+      const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
+          &instrumentation_library) const
+  {
+    std::string key;
+    key.reserve(instrumentation_library.GetName().size() +
+                instrumentation_library.GetVersion().size() +
+                instrumentation_library.GetSchemaURL().size() + instrument_descriptor.name_.size() +
+                4);
+    key.append(instrumentation_library.GetName()).push_back('\0');
+    key.append(instrumentation_library.GetVersion()).push_back('\0');
+    key.append(instrumentation_library.GetSchemaURL()).push_back('\0');
+    key.append(instrument_descriptor.name_)
+        .push_back(static_cast<char>(instrument_descriptor.type_));
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto cached = resolved_views_.find(key);
+    if (cached != resolved_views_.end())
+    {
+      return cached->second;
+    }
+
+    // The views naming the instrument and the wildcard views are merged back in registration
+    // order, in which they are reported.
+    static const std::vector<size_t> kNoViews;
+    auto named = views_by_name_.find(instrument_descriptor.name_);
+    const std::vector<size_t> &named_views =
+        named == views_by_name_.end() ? kNoViews : named->second;
+    std::shared_ptr<std::vector<const View *>> views(new std::vector<const View *>());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < named_views.size() || j < wildcard_views_.size())
+    {
+      size_t index;
+      if (j == wildcard_views_.size() ||
+          (i < named_views.size() && named_views[i] < wildcard_views_[j]))
+      {
+        index = named_views[i++];
+      }
+      else
+      {
+        index = wildcard_views_[j++];
+      }
+      const RegisteredView &registered_view = *registered_views_[index];
+      if (MatchMeter(registered_view.meter_selector_.get(), instrumentation_library) &&
+          MatchInstrument(registered_view.instrument_selector_.get(), instrument_descriptor))
+      {
+        views->push_back(registered_view.view_.get());
+      }
+    }
+
+    if (resolved_views_.size() >= kMaxResolvedViews)
+    {
+      resolved_views_.clear();
+    }
+    resolved_views_.emplace(std::move(key), views);
+    return views;
+  }
+
   std::vector<std::unique_ptr<RegisteredView>> registered_views_;
+  // Indexes in registered_views_ of the views selecting instruments by exact name, by that name.
+  std::unordered_map<std::string, std::vector<size_t>> views_by_name_;
+  // Indexes in registered_views_ of the other views.
+  std::vector<size_t> wildcard_views_;
+  // The views matching an instrument, by meter name, version, schema, instrument name and type.
+  mutable std::unordered_map<std::string, std::shared_ptr<const std::vector<const View *>>>
+      resolved_views_;
+  mutable std::mutex lock_;
+
   static bool MatchMeter(opentelemetry::sdk::metrics::MeterSelector *selector,
                          const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary
                              &instrumentation_library)
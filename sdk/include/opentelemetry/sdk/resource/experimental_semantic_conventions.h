@@ -12,6 +12,7 @@
 #include <type_traits>
 #include <unordered_map>
 
+#include "opentelemetry/common/attribute_key.h"
 #include "opentelemetry/common/string_util.h"
 #include "opentelemetry/version.h"
 
@@ -136,6 +137,89 @@ inline const char *attr(uint32_t attr)
 {
   return (attribute_ids.find(attr) != attribute_ids.end()) ? attribute_ids.at(attr) : "";
 }
+
+// BEGIN GENERATED ATTRIBUTE KEYS
+// Generated by buildscripts/semantic-convention/generate_attribute_keys.py, do not edit.
+namespace attribute_keys
+{
+constexpr opentelemetry::common::AttributeKey kServiceName{"service.name", 93};
+constexpr opentelemetry::common::AttributeKey kServiceNamespace{"service.namespace", 94};
+constexpr opentelemetry::common::AttributeKey kServiceInstance{"service.instance.id", 95};
+constexpr opentelemetry::common::AttributeKey kServiceVersion{"service.version", 96};
+constexpr opentelemetry::common::AttributeKey kTelemetrySdkName{"telemetry.sdk.name", 97};
+constexpr opentelemetry::common::AttributeKey kTelemetrySdkLanguage{"telemetry.sdk.language", 98};
+constexpr opentelemetry::common::AttributeKey kTelemetrySdkVersion{"telemetry.sdk.version", 99};
+constexpr opentelemetry::common::AttributeKey kTelemetryAutoVersion{"telemetry.auto.version", 100};
+constexpr opentelemetry::common::AttributeKey kContainerName{"container.name", 101};
+constexpr opentelemetry::common::AttributeKey kContainerId{"container.id", 102};
+constexpr opentelemetry::common::AttributeKey kContainerRuntime{"container.runtime", 103};
+constexpr opentelemetry::common::AttributeKey kContainerImageName{"container.image.name", 104};
+constexpr opentelemetry::common::AttributeKey kContainerImageTag{"container.image.tag", 105};
+constexpr opentelemetry::common::AttributeKey kFaasName{"faas.name", 106};
+constexpr opentelemetry::common::AttributeKey kFaasId{"faas.id", 107};
+constexpr opentelemetry::common::AttributeKey kFaasVersion{"faas.version", 108};
+constexpr opentelemetry::common::AttributeKey kFaasInstance{"faas.instance", 109};
+constexpr opentelemetry::common::AttributeKey kFaasMaxMemory{"faas.max_memory", 110};
+constexpr opentelemetry::common::AttributeKey kProcessId{"process.pid", 111};
+constexpr opentelemetry::common::AttributeKey kProcessExecutableName{
+    "process.executable.name", 112};
+constexpr opentelemetry::common::AttributeKey kProcessExecutablePath{
+    "process.executable.path", 113};
+constexpr opentelemetry::common::AttributeKey kProcessCommand{"process.command", 114};
+constexpr opentelemetry::common::AttributeKey kProcessCommandLine{"process.command_line", 115};
+constexpr opentelemetry::common::AttributeKey kProcessCommandArgs{"process.command_args", 116};
+constexpr opentelemetry::common::AttributeKey kProcessOwner{"process.owner", 117};
+constexpr opentelemetry::common::AttributeKey kProcessRuntimeName{"process.runtime.name", 118};
+constexpr opentelemetry::common::AttributeKey kProcessRuntimeVersion{
+    "process.runtime.version", 119};
+constexpr opentelemetry::common::AttributeKey kProcessRuntimeDescription{
+    "process.runtime.description", 120};
+constexpr opentelemetry::common::AttributeKey kWebEngineName{"webengine.name", 121};
+constexpr opentelemetry::common::AttributeKey kWebEngineVersion{"webengine.version", 122};
+constexpr opentelemetry::common::AttributeKey kWebEngineDescription{"webengine.description", 123};
+constexpr opentelemetry::common::AttributeKey kHostId{"host.id", 124};
+constexpr opentelemetry::common::AttributeKey kHostName{"host.name", 125};
+constexpr opentelemetry::common::AttributeKey kHostType{"host.type", 126};
+constexpr opentelemetry::common::AttributeKey kHostArch{"host.arch", 127};
+constexpr opentelemetry::common::AttributeKey kHostImageName{"host.image.name", 128};
+constexpr opentelemetry::common::AttributeKey kHostImageId{"host.image.id", 129};
+constexpr opentelemetry::common::AttributeKey kHostImageVersion{"host.image.version", 130};
+constexpr opentelemetry::common::AttributeKey kOsType{"os.type", 131};
+constexpr opentelemetry::common::AttributeKey kOsDescription{"os.description", 132};
+constexpr opentelemetry::common::AttributeKey kOsName{"os.name", 133};
+constexpr opentelemetry::common::AttributeKey kOsVersion{"os.version", 134};
+constexpr opentelemetry::common::AttributeKey kDeviceId{"device.id", 135};
+constexpr opentelemetry::common::AttributeKey kDeviceModelIdentifier{
+    "device.model.identifier", 136};
+constexpr opentelemetry::common::AttributeKey kDeviceModelName{"device.model.name", 137};
+constexpr opentelemetry::common::AttributeKey kCloudProvider{"cloud.provider", 138};
+constexpr opentelemetry::common::AttributeKey kCloudAccountId{"cloud.account.id", 139};
+constexpr opentelemetry::common::AttributeKey kCloudRegion{"cloud.region", 140};
+constexpr opentelemetry::common::AttributeKey kCloudAvailabilityZone{
+    "cloud.availability_zone", 141};
+constexpr opentelemetry::common::AttributeKey kCloudPlatform{"cloud.platform", 142};
+constexpr opentelemetry::common::AttributeKey kDeploymentEnvironment{"deployment.environment", 143};
+constexpr opentelemetry::common::AttributeKey kK8sClusterName{"k8s.cluster.name", 144};
+constexpr opentelemetry::common::AttributeKey kK8sNodeName{"k8s.node.name", 145};
+constexpr opentelemetry::common::AttributeKey kK8sNodeUid{"k8s.node.uid", 146};
+constexpr opentelemetry::common::AttributeKey kK8sNamespaceName{"k8s.namespace.name", 147};
+constexpr opentelemetry::common::AttributeKey kK8sPodUid{"k8s.pod.uid", 148};
+constexpr opentelemetry::common::AttributeKey kK8sPodName{"k8s.pod.name", 149};
+constexpr opentelemetry::common::AttributeKey kK8sContainerName{"k8s.container.name", 150};
+constexpr opentelemetry::common::AttributeKey kK8sReplicaSetUid{"k8s.replicaset.uid", 151};
+constexpr opentelemetry::common::AttributeKey kK8sReplicaSetName{"k8s.replicaset.name", 152};
+constexpr opentelemetry::common::AttributeKey kK8sDeploymentUid{"k8s.deployment.uid", 153};
+constexpr opentelemetry::common::AttributeKey kK8sDeploymentName{"k8s.deployment.name", 154};
+constexpr opentelemetry::common::AttributeKey kK8sStatefulSetUid{"k8s.statefulset.uid", 155};
+constexpr opentelemetry::common::AttributeKey kK8sStatefulSetName{"k8s.statefulset.name", 156};
+constexpr opentelemetry::common::AttributeKey kK8sDaemonSetUid{"k8s.daemonset.uid", 157};
+constexpr opentelemetry::common::AttributeKey kK8sDaemonSetName{"k8s.daemonset.name", 158};
+constexpr opentelemetry::common::AttributeKey kK8sJobUid{"k8s.job.uid", 159};
+constexpr opentelemetry::common::AttributeKey kK8sJobName{"k8s.job.name", 160};
+constexpr opentelemetry::common::AttributeKey kCronjobUid{"k8s.cronjob.id", 161};
+constexpr opentelemetry::common::AttributeKey kCronjobName{"k8s.cronjob.name", 162};
+}  // namespace attribute_keys
+// END GENERATED ATTRIBUTE KEYS
 }  // namespace resource
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
\ No newline at end of file
@@ -79,6 +79,7 @@ class Resource
   std::string schema_url_;
 
   friend class OTELResourceDetector;
+  friend class CachedResourceDetector;
 };
 
 }  // namespace resource
@@ -6,6 +6,11 @@
 #include "opentelemetry/nostd/unique_ptr.h"
 #include "opentelemetry/version.h"
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -20,6 +25,8 @@ class Resource;
 class ResourceDetector
 {
 public:
+  virtual ~ResourceDetector() = default;
+
   virtual Resource Detect() = 0;
 };
 
@@ -33,6 +40,56 @@ class OTELResourceDetector : public ResourceDetector
   Resource Detect() noexcept override;
 };
 
+/**
+ * ParallelResourceDetector runs several detectors concurrently, each on its own thread, and
+ * merges their resources in the order of the detectors: on a conflict, the attribute of the later
+ * detector wins, as with Resource::Merge.
+ *
+ * Detectors which have not finished by the timeout are left running in the background and their
+ * resources are ignored, so that a slow probe does not hold up the startup of the process. The
+ * detectors are shared with those threads, and must be thread-safe if Detect is called again.
+ */
+class ParallelResourceDetector : public ResourceDetector
+{
+public:
+  explicit ParallelResourceDetector(
+      std::vector<std::shared_ptr<ResourceDetector>> detectors,
+      std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) noexcept;
+
+  Resource Detect() noexcept override;
+
+private:
+  std::vector<std::shared_ptr<ResourceDetector>> detectors_;
+  std::chrono::milliseconds timeout_;
+};
+
+/**
+ * CachedResourceDetector stores the resource of another detector in a file, so that the processes
+ * started before the file expires read it instead of running the detector again.
+ *
+ * The file is replaced atomically. A missing, expired or unreadable file is ignored. Resources
+ * with array attributes are returned but not cached.
+ */
+class CachedResourceDetector : public ResourceDetector
+{
+public:
+  /**
+   * @param detector the detector whose resource is cached
+   * @param path the path of the cache file
+   * @param max_age the age after which the cache file is ignored and rewritten
+   */
+  CachedResourceDetector(std::shared_ptr<ResourceDetector> detector,
+                         std::string path,
+                         std::chrono::seconds max_age = std::chrono::hours(24)) noexcept;
+
+  Resource Detect() noexcept override;
+
+private:
+  std::shared_ptr<ResourceDetector> detector_;
+  std::string path_;
+  std::chrono::seconds max_age_;
+};
+
 }  // namespace resource
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
\ No newline at end of file
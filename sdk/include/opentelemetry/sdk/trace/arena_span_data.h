@@ -0,0 +1,491 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <new>
+
+#include "opentelemetry/common/attribute_value.h"
+#include "opentelemetry/common/key_value_iterable.h"
+#include "opentelemetry/common/timestamp.h"
+#include "opentelemetry/nostd/function_ref.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/sdk/common/arena.h"
+#include "opentelemetry/sdk/common/attribute_key_table.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/trace/span_context.h"
+#include "opentelemetry/trace/span_id.h"
+#include "opentelemetry/trace/trace_id.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A list of attributes whose values are stored in an Arena. Keys are interned
+ * in the process-wide AttributeKeyTable rather than copied, and only copied into
+ * the arena once the table is full. Setting an existing key replaces its value.
+ */
+class ArenaAttributes final : public opentelemetry::common::KeyValueIterable
+{
+public:
+  /**
+   * Copies the key and the value into the arena and sets the attribute.
+   */
+  void SetAttribute(common::Arena &arena,
+                    nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept
+  {
+    auto &key_table = common::AttributeKeyTable::GetInstance();
+    const common::AttributeKeyTable::KeyId key_id = key_table.Intern(key);
+    opentelemetry::common::AttributeValue copy   = nostd::visit(ValueCopier{arena}, value);
+    for (Attribute *attribute = head_; attribute != nullptr; attribute = attribute->next)
+    {
+      if (key_id != common::AttributeKeyTable::kInvalidKeyId ? attribute->key_id == key_id
+                                                             : attribute->key == key)
+      {
+        attribute->value = copy;
+        return;
+      }
+    }
+
+    void *memory = arena.Allocate(sizeof(Attribute), alignof(Attribute));
+    if (memory == nullptr)
+    {
+      return;
+    }
+    nostd::string_view stored_key = key_id != common::AttributeKeyTable::kInvalidKeyId
+                                        ? key_table.GetKey(key_id)
+                                        : arena.CopyString(key);
+    Attribute *attribute = new (memory) Attribute{key_id, stored_key, copy, nullptr};
+    if (tail_ == nullptr)
+    {
+      head_ = attribute;
+    }
+    else
+    {
+      tail_->next = attribute;
+    }
+    tail_ = attribute;
+    ++size_;
+  }
+
+  /**
+   * Copies all the attributes of an iterable into the arena.
+   */
+  void SetAttributes(common::Arena &arena,
+                     const opentelemetry::common::KeyValueIterable &attributes) noexcept
+  {
+    attributes.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          SetAttribute(arena, key, value);
+          return true;
+        });
+  }
+
+  bool ForEachKeyValue(nostd::function_ref<bool(nostd::string_view,
+                                                opentelemetry::common::AttributeValue)> callback)
+      const noexcept override
+  {
+    for (const Attribute *attribute = head_; attribute != nullptr; attribute = attribute->next)
+    {
+      if (!callback(attribute->key, attribute->value))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Visits the attributes along with the AttributeKeyTable ids of their keys,
+   * for exporters which encode keys with a dictionary. The id is
+   * AttributeKeyTable::kInvalidKeyId for keys which could not be interned.
+   */
+  bool ForEachKeyIdValue(
+      nostd::function_ref<bool(common::AttributeKeyTable::KeyId,
+                               nostd::string_view,
+                               opentelemetry::common::AttributeValue)> callback) const noexcept
+  {
+    for (const Attribute *attribute = head_; attribute != nullptr; attribute = attribute->next)
+    {
+      if (!callback(attribute->key_id, attribute->key, attribute->value))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const noexcept override { return size_; }
+
+private:
+  struct Attribute
+  {
+    common::AttributeKeyTable::KeyId key_id;
+    nostd::string_view key;
+    opentelemetry::common::AttributeValue value;
+    Attribute *next;
+  };
+
+  /* Copies the strings and arrays a value refers to into the arena. */
+  struct ValueCopier
+  {
+    common::Arena &arena;
+
+    template <typename T>
+    opentelemetry::common::AttributeValue operator()(T value) noexcept
+    {
+      return value;
+    }
+
+    template <typename T>
+    opentelemetry::common::AttributeValue operator()(nostd::span<const T> values) noexcept
+    {
+      return arena.CopySpan(values);
+    }
+
+    opentelemetry::common::AttributeValue operator()(const char *value) noexcept
+    {
+      return arena.CopyString(value);
+    }
+
+    opentelemetry::common::AttributeValue operator()(nostd::string_view value) noexcept
+    {
+      return arena.CopyString(value);
+    }
+
+    opentelemetry::common::AttributeValue operator()(
+        nostd::span<const nostd::string_view> values) noexcept
+    {
+      nostd::string_view *copy = arena.AllocateArray<nostd::string_view>(values.size());
+      if (copy == nullptr)
+      {
+        return nostd::span<const nostd::string_view>();
+      }
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        new (copy + i) nostd::string_view(arena.CopyString(values[i]));
+      }
+      return nostd::span<const nostd::string_view>(copy, values.size());
+    }
+  };
+
+  Attribute *head_ = nullptr;
+  Attribute *tail_ = nullptr;
+  size_t size_     = 0;
+};
+
+/**
+ * Event of an ArenaSpanData.
+ */
+class ArenaSpanDataEvent
+{
+public:
+  ArenaSpanDataEvent(nostd::string_view name, opentelemetry::common::SystemTimestamp timestamp)
+      : name_(name), timestamp_(timestamp)
+  {}
+
+  nostd::string_view GetName() const noexcept { return name_; }
+
+  opentelemetry::common::SystemTimestamp GetTimestamp() const noexcept { return timestamp_; }
+
+  const ArenaAttributes &GetAttributes() const noexcept { return attributes_; }
+
+private:
+  friend class ArenaSpanData;
+
+  nostd::string_view name_;
+  opentelemetry::common::SystemTimestamp timestamp_;
+  ArenaAttributes attributes_;
+  ArenaSpanDataEvent *next_ = nullptr;
+};
+
+/**
+ * Link of an ArenaSpanData.
+ */
+class ArenaSpanDataLink
+{
+public:
+  explicit ArenaSpanDataLink(const opentelemetry::trace::SpanContext &span_context)
+      : span_context_(span_context)
+  {}
+
+  const opentelemetry::trace::SpanContext &GetSpanContext() const noexcept { return span_context_; }
+
+  const ArenaAttributes &GetAttributes() const noexcept { return attributes_; }
+
+private:
+  friend class ArenaSpanData;
+
+  opentelemetry::trace::SpanContext span_context_;
+  ArenaAttributes attributes_;
+  ArenaSpanDataLink *next_ = nullptr;
+};
+
+/**
+ * A representation of all data collected by a span, like SpanData, whose
+ * strings, attributes, events and links are stored in an arena owned by the
+ * span rather than in separately allocated containers. The arena starts with
+ * a block embedded in the object, so that a typical span takes a single heap
+ * allocation, and is released at once when the recordable is destroyed after
+ * export.
+ *
+ * Attributes are exposed as KeyValueIterable, and events and links are
+ * visited in the order they were added.
+ */
+class ArenaSpanData final : public Recordable
+{
+public:
+  /* The size of the arena block embedded in each ArenaSpanData. */
+  static constexpr size_t kInlineArenaSize = 1024;
+
+  ArenaSpanData() noexcept : arena_(inline_block_, sizeof(inline_block_)) {}
+
+  ArenaSpanData(const ArenaSpanData &)            = delete;
+  ArenaSpanData &operator=(const ArenaSpanData &) = delete;
+
+  ~ArenaSpanData() override
+  {
+    // Links hold a reference to their trace state, the rest of the arena needs no destruction.
+    ArenaSpanDataLink *link = links_head_;
+    while (link != nullptr)
+    {
+      ArenaSpanDataLink *next = link->next_;
+      link->~ArenaSpanDataLink();
+      link = next;
+    }
+  }
+
+  opentelemetry::trace::TraceId GetTraceId() const noexcept { return span_context_.trace_id(); }
+
+  opentelemetry::trace::SpanId GetSpanId() const noexcept { return span_context_.span_id(); }
+
+  const opentelemetry::trace::SpanContext &GetSpanContext() const noexcept { return span_context_; }
+
+  opentelemetry::trace::SpanId GetParentSpanId() const noexcept { return parent_span_id_; }
+
+  nostd::string_view GetName() const noexcept { return name_; }
+
+  opentelemetry::trace::SpanKind GetSpanKind() const noexcept { return span_kind_; }
+
+  opentelemetry::trace::StatusCode GetStatus() const noexcept { return status_code_; }
+
+  nostd::string_view GetDescription() const noexcept { return status_desc_; }
+
+  const opentelemetry::sdk::resource::Resource *GetResource() const noexcept { return resource_; }
+
+  const InstrumentationLibrary *GetInstrumentationLibrary() const noexcept
+  {
+    return instrumentation_library_;
+  }
+
+  opentelemetry::common::SystemTimestamp GetStartTime() const noexcept { return start_time_; }
+
+  std::chrono::nanoseconds GetDuration() const noexcept { return duration_; }
+
+  const ArenaAttributes &GetAttributes() const noexcept { return attributes_; }
+
+  /**
+   * Visits the events of the span in the order they were added.
+   */
+  bool ForEachEvent(
+      nostd::function_ref<bool(const ArenaSpanDataEvent &)> callback) const noexcept
+  {
+    for (const ArenaSpanDataEvent *event = events_head_; event != nullptr; event = event->next_)
+    {
+      if (!callback(*event))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Visits the links of the span in the order they were added.
+   */
+  bool ForEachLink(nostd::function_ref<bool(const ArenaSpanDataLink &)> callback) const noexcept
+  {
+    for (const ArenaSpanDataLink *link = links_head_; link != nullptr; link = link->next_)
+    {
+      if (!callback(*link))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint32_t GetDroppedAttributesCount() const noexcept { return dropped_attributes_count_; }
+
+  uint32_t GetDroppedEventsCount() const noexcept { return dropped_events_count_; }
+
+  uint32_t GetDroppedLinksCount() const noexcept { return dropped_links_count_; }
+
+  /**
+   * Records this span into another recordable, as if the span had been recorded there in the
+   * first place.
+   */
+  void Replay(Recordable &target) const noexcept
+  {
+    target.SetIdentity(span_context_, parent_span_id_);
+    target.SetName(name_);
+    target.SetSpanKind(span_kind_);
+    target.SetStartTime(start_time_);
+    target.SetDuration(duration_);
+    target.SetStatus(status_code_, status_desc_);
+    if (resource_ != nullptr)
+    {
+      target.SetResource(*resource_);
+    }
+    if (instrumentation_library_ != nullptr)
+    {
+      target.SetInstrumentationLibrary(*instrumentation_library_);
+    }
+    attributes_.ForEachKeyValue(
+        [&](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+          target.SetAttribute(key, value);
+          return true;
+        });
+    for (const ArenaSpanDataEvent *event = events_head_; event != nullptr; event = event->next_)
+    {
+      target.AddEvent(event->name_, event->timestamp_, event->attributes_);
+    }
+    for (const ArenaSpanDataLink *link = links_head_; link != nullptr; link = link->next_)
+    {
+      target.AddLink(link->span_context_, link->attributes_);
+    }
+    target.SetDroppedCounts(dropped_attributes_count_, dropped_events_count_,
+                            dropped_links_count_);
+  }
+
+  /**
+   * Returns the number of bytes the arena took from the heap once the inline
+   * block was full.
+   */
+  size_t GetArenaHeapSize() const noexcept { return arena_.GetHeapSize(); }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
+                   opentelemetry::trace::SpanId parent_span_id) noexcept override
+  {
+    span_context_   = span_context;
+    parent_span_id_ = parent_span_id;
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    attributes_.SetAttribute(arena_, key, value);
+  }
+
+  void AddEvent(nostd::string_view name,
+                opentelemetry::common::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    void *memory = arena_.Allocate(sizeof(ArenaSpanDataEvent), alignof(ArenaSpanDataEvent));
+    if (memory == nullptr)
+    {
+      return;
+    }
+    auto event = new (memory) ArenaSpanDataEvent(arena_.CopyString(name), timestamp);
+    event->attributes_.SetAttributes(arena_, attributes);
+    if (events_tail_ == nullptr)
+    {
+      events_head_ = event;
+    }
+    else
+    {
+      events_tail_->next_ = event;
+    }
+    events_tail_ = event;
+  }
+
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    void *memory = arena_.Allocate(sizeof(ArenaSpanDataLink), alignof(ArenaSpanDataLink));
+    if (memory == nullptr)
+    {
+      return;
+    }
+    auto link = new (memory) ArenaSpanDataLink(span_context);
+    link->attributes_.SetAttributes(arena_, attributes);
+    if (links_tail_ == nullptr)
+    {
+      links_head_ = link;
+    }
+    else
+    {
+      links_tail_->next_ = link;
+    }
+    links_tail_ = link;
+  }
+
+  void SetStatus(opentelemetry::trace::StatusCode code,
+                 nostd::string_view description) noexcept override
+  {
+    status_code_ = code;
+    status_desc_ = arena_.CopyString(description);
+  }
+
+  void SetName(nostd::string_view name) noexcept override { name_ = arena_.CopyString(name); }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    span_kind_ = span_kind;
+  }
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept override
+  {
+    resource_ = &resource;
+  }
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp start_time) noexcept override
+  {
+    start_time_ = start_time;
+  }
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override { duration_ = duration; }
+
+  void SetInstrumentationLibrary(
+      const InstrumentationLibrary &instrumentation_library) noexcept override
+  {
+    instrumentation_library_ = &instrumentation_library;
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    dropped_attributes_count_ = attributes;
+    dropped_events_count_     = events;
+    dropped_links_count_      = links;
+  }
+
+private:
+  alignas(std::max_align_t) char inline_block_[kInlineArenaSize];
+  common::Arena arena_;
+
+  opentelemetry::trace::SpanContext span_context_{false, false};
+  opentelemetry::trace::SpanId parent_span_id_;
+  opentelemetry::common::SystemTimestamp start_time_;
+  std::chrono::nanoseconds duration_{0};
+  nostd::string_view name_;
+  opentelemetry::trace::StatusCode status_code_{opentelemetry::trace::StatusCode::kUnset};
+  nostd::string_view status_desc_;
+  ArenaAttributes attributes_;
+  ArenaSpanDataEvent *events_head_ = nullptr;
+  ArenaSpanDataEvent *events_tail_ = nullptr;
+  ArenaSpanDataLink *links_head_   = nullptr;
+  ArenaSpanDataLink *links_tail_   = nullptr;
+  opentelemetry::trace::SpanKind span_kind_{opentelemetry::trace::SpanKind::kInternal};
+  const opentelemetry::sdk::resource::Resource *resource_ = nullptr;
+  const InstrumentationLibrary *instrumentation_library_  = nullptr;
+  uint32_t dropped_attributes_count_                      = 0;
+  uint32_t dropped_events_count_                          = 0;
+  uint32_t dropped_links_count_                           = 0;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -3,12 +3,31 @@
 
 #pragma once
 
-#include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/adaptive_batch_scheduler.h"
+#include "opentelemetry/sdk/common/backpressure_signal.h"
+#include "opentelemetry/sdk/common/batch_processor_stats.h"
+#include "opentelemetry/sdk/common/batch_processor_synchronizer.h"
+#include "opentelemetry/sdk/common/export_executor.h"
+#include "opentelemetry/sdk/common/fork_handler.h"
+#include "opentelemetry/sdk/common/memory_budget.h"
+#include "opentelemetry/sdk/common/record_journal.h"
+#include "opentelemetry/sdk/common/recordable_pool.h"
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
+#include "opentelemetry/sdk/common/tenant_drop_counter.h"
+#include "opentelemetry/sdk/common/thread_local_buffers.h"
+#include "opentelemetry/sdk/common/thread_options.h"
 #include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/important_span_recordable.h"
 #include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/shared_recordable.h"
+#include "opentelemetry/sdk/trace/tenant_span_recordable.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -18,6 +37,32 @@ namespace sdk
 namespace trace
 {
 
+/**
+ * The fair queuing of a BatchSpanProcessor, for processes serving several tenants, so that a
+ * tenant ending many spans cannot crowd the spans of the others out of the queue.
+ */
+struct FairQueuingOptions
+{
+  /**
+   * The span attribute, or else resource attribute, naming the tenant of a span, see TenantKey.
+   * Empty disables fair queuing.
+   */
+  std::string key;
+
+  /**
+   * The number of sub-queues the tenants are hashed into, which split max_queue_size evenly. A
+   * full sub-queue drops the spans of its tenants only. Tenants sharing a sub-queue share its
+   * room and its turns.
+   */
+  size_t num_queues = 16;
+
+  /* The spans exported from a sub-queue at each of its turns of deficit round-robin. */
+  size_t quantum = 16;
+
+  /* The number of distinct tenants whose drops are counted apart, see TenantDropCounter. */
+  size_t max_tracked_tenants = 1024;
+};
+
 /**
  * Struct to hold batch SpanProcessor options.
  */
@@ -37,6 +82,147 @@ struct BatchSpanProcessorOptions
    * equal to max_queue_size.
    */
   size_t max_export_batch_size = 512;
+
+  /**
+   * The number of independent shards the queue is split into. Ending threads are spread across
+   * the shards, which removes the contention on a single queue head when many threads end spans
+   * concurrently; the worker thread drains the shards round-robin. max_queue_size is divided
+   * evenly between the shards. With more than one shard, spans ended on different threads are no
+   * longer exported in strict end order.
+   */
+  size_t num_queue_shards = 1;
+
+  /**
+   * The maximum number of batches handed to SpanExporter::ExportAsync that may be in flight at the
+   * same time. With the default of 1, the worker thread calls SpanExporter::Export synchronously.
+   * With larger values, the worker keeps collecting and handing off batches while earlier ones are
+   * still being exported, and only blocks once this many are outstanding. This bounds the number
+   * of batches held by the exporter, not their memory: see max_in_flight_export_bytes.
+   */
+  size_t max_concurrent_exports = 1;
+
+  /**
+   * With max_concurrent_exports, the maximum estimated size in bytes of the spans handed to
+   * SpanExporter::ExportAsync whose export has not completed yet, see
+   * Recordable::GetEstimatedSize. The worker waits for earlier exports to complete before handing
+   * off a batch which would exceed it, and always hands off a batch once none is in flight, so a
+   * batch larger than it is exported alone. 0 disables the limit.
+   */
+  size_t max_in_flight_export_bytes = 0;
+
+  /**
+   * Whether to adapt the batch size and the delay between exports to the observed span arrival
+   * rate and exporter latency. When enabled, max_export_batch_size and schedule_delay_millis become
+   * upper bounds, and min_export_batch_size and min_schedule_delay_millis the lower bounds.
+   * Spikes shorten the delay and grow the batches; quiet periods do the opposite.
+   */
+  bool adaptive_batching = false;
+
+  /* The lower bound of the batch size in adaptive mode. */
+  size_t min_export_batch_size = 64;
+
+  /* The lower bound of the delay between two consecutive exports in adaptive mode. */
+  std::chrono::milliseconds min_schedule_delay_millis = std::chrono::milliseconds(100);
+
+  /**
+   * The maximum number of exported recordables kept to record later spans. After a synchronous
+   * export, the recordables left in the batch whose Recordable::Reset() returns true are kept, and
+   * MakeRecordable hands them out before asking the exporter for new ones. 0 disables the reuse.
+   */
+  size_t max_recycled_recordables = 2048;
+
+  /**
+   * The number of spans each thread buffers before handing them off to the queue all at once. A
+   * thread ending spans then only synchronizes with the other threads once per this many spans.
+   * The spans of idle threads are handed off by the worker thread at each export cycle, ForceFlush
+   * and Shutdown, and those of exiting threads by these threads. 0 disables the buffering.
+   */
+  size_t thread_local_buffer_size = 0;
+
+  /**
+   * The size of a partition of the queue, in addition to max_queue_size, reserved to the spans
+   * matching priority_rules. They are queued there first, and only take room in the rest of the
+   * queue once the partition is full, so that when the queue overflows the other spans are dropped
+   * first. They are also exported first. 0 disables the partition and the rules, which are
+   * otherwise checked for each span through a wrapper of its recordable.
+   */
+  size_t max_priority_queue_size = 0;
+
+  /* The spans queued in the reserved partition: by default, those ended with an error status. */
+  ImportantSpanRules priority_rules;
+
+  /**
+   * Whether to defer the making of the exporter's recordables to the worker thread. Spans are then
+   * recorded into an ArenaSpanData, a compact log of their operations in an arena with interned
+   * attribute keys, which the worker replays into a recordable of the exporter right before the
+   * export. The threads ending spans no longer build the exporter's representation, e.g. protobuf
+   * messages, at the cost of copying each span once more. Recordables are still recycled, by the
+   * worker thread only.
+   */
+  bool deferred_recordables = false;
+
+  /**
+   * The maximum estimated size in bytes of the spans of an export, see
+   * Recordable::GetEstimatedSize. A batch of max_export_batch_size spans which exceeds it is
+   * split into several exports, e.g. to stay under the message size limit of a collector. A span
+   * larger than it is exported alone. 0 disables the split.
+   */
+  size_t max_export_batch_bytes = 0;
+
+  /**
+   * Whether to group the spans of each export by resource, instrumentation library and trace,
+   * see Recordable::GetGroupingKey, so that the spans of a trace are contiguous in the exports:
+   * they compress better, and a tail-sampling collector receives them together. Spans keep their
+   * order within a group, and recordables without a grouping key form one group.
+   */
+  bool group_by_trace = false;
+
+  /**
+   * A memory budget, possibly shared with other components, that the queued spans are charged
+   * to: kSpanOverheadBytes plus Recordable::GetEstimatedSize, at MemoryPriority::kHigh for the
+   * spans matching priority_rules and kNormal for the others. Spans whose charge is refused are
+   * dropped, and the worker exports early once the budget is under pressure. Null disables it.
+   */
+  std::shared_ptr<common::MemoryBudget> memory_budget;
+
+  /**
+   * A signal the processor publishes its backpressure to: the occupancy of the queue after each
+   * export cycle, or 1 when a span is dropped, and the time spent exporting over the schedule
+   * delay. Pass it to a BackpressureSampler to shed spans before they are built. Null disables
+   * it.
+   */
+  std::shared_ptr<common::BackpressureSignal> backpressure_signal;
+
+  /**
+   * An executor, possibly shared with other processors and metric readers, running the export
+   * cycles of the processor instead of a worker thread of its own. The cycles are the same: the
+   * processor keeps its schedule delay, wake ups, force flushes and backpressure. Null runs a
+   * worker thread.
+   */
+  std::shared_ptr<common::ExportExecutor> executor;
+
+  /**
+   * A journal the spans are written to as they are queued, in the encoding of their recordable,
+   * see Recordable::AppendJournalRecord, so that the spans a crash lost can be recovered from its
+   * file. The journal keeps the latest spans queued, exported or not: size its ring to hold more
+   * than max_queue_size of them. Deferred recordables, and exporter recordables without an
+   * encoding, are not journaled. Null disables it.
+   */
+  std::shared_ptr<common::RecordJournal> journal;
+
+  /**
+   * The name, CPU affinity and niceness of the worker thread, named "otel-bsp" by default. Unused
+   * with an executor, whose threads have options of their own.
+   */
+  common::ThreadOptions thread_options;
+
+  /**
+   * Queues the spans of each tenant apart, in sub-queues that exports drain with deficit
+   * round-robin, and counts the spans dropped for each tenant, see
+   * BatchSpanProcessor::GetTenantDrops. Enqueuing stays a lock-free push into the sub-queue of the
+   * tenant. num_queue_shards and thread_local_buffer_size are ignored with fair queuing.
+   */
+  FairQueuingOptions fair_queuing;
 };
 
 /**
@@ -46,6 +232,9 @@ struct BatchSpanProcessorOptions
 class BatchSpanProcessor : public SpanProcessor
 {
 public:
+  /* The bytes charged to the memory budget for a queued span, on top of its estimated size. */
+  static constexpr size_t kSpanOverheadBytes = 256;
+
   /**
    * Creates a batch span processor by configuring the specified exporter and other parameters
    * as per the official, language-agnostic opentelemetry specs.
@@ -57,7 +246,10 @@ class BatchSpanProcessor : public SpanProcessor
                      const BatchSpanProcessorOptions &options);
 
   /**
-   * Requests a Recordable(Span) from the configured exporter.
+   * Reuses a recordable of an exported span, or requests a Recordable(Span) from the configured
+   * exporter, or with deferred_recordables makes an ArenaSpanData. With fair queuing, the
+   * recordable is wrapped to find the tenant of the span, and with a priority partition to check
+   * the priority rules.
    *
    * @return A recordable generated by the backend exporter
    */
@@ -82,9 +274,10 @@ class BatchSpanProcessor : public SpanProcessor
   void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
 
   /**
-   * Export all ended spans that have not been exported yet.
+   * Export all ended spans that have not been exported yet. Blocks until the worker thread has
+   * exported them or `timeout` expires.
    *
-   * NOTE: Timeout functionality not supported yet.
+   * @return true if all spans were exported within the timeout, false otherwise.
    */
   bool ForceFlush(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
@@ -99,6 +292,19 @@ class BatchSpanProcessor : public SpanProcessor
   bool Shutdown(
       std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override;
 
+  /**
+   * Returns a snapshot of the processor's counters: spans enqueued, dropped because the queue was
+   * full and exported, export durations and batch sizes, and the current queue occupancy.
+   * Safe to call from any thread.
+   */
+  common::BatchProcessorStats GetStats() const noexcept;
+
+  /**
+   * Returns the number of spans dropped for each tenant which had drops, with fair queuing. Safe
+   * to call from any thread.
+   */
+  std::map<std::string, uint64_t> GetTenantDrops() const;
+
   /**
    * Class destructor which invokes the Shutdown() method. The Shutdown() method is supposed to be
    * invoked when the Tracer is shutdown (as per other languages), but the C++ Tracer only takes
@@ -113,22 +319,158 @@ class BatchSpanProcessor : public SpanProcessor
    */
   void DoBackgroundWork();
 
+  /**
+   * Runs an export cycle of the worker, once woken up with the force flush `flush_generation`, or
+   * 0, and sets worker_timeout_ to the delay until the next cycle.
+   *
+   * @return false if the worker must stop, because of a shutdown or a fork.
+   */
+  bool RunCycle(uint64_t flush_generation);
+
+  /**
+   * The task run by executor_, running an export cycle.
+   *
+   * @return the delay until the next cycle.
+   */
+  std::chrono::microseconds RunWorkerTask();
+
+  /**
+   * Resets the schedule of the worker, when it starts.
+   */
+  void ResetWorkerSchedule() noexcept;
+
+  /**
+   * Starts the worker thread, or adds the task of executor_. It is started by the first span
+   * rather than by the constructor, so that creating a processor is cheap and processors which
+   * never see a span cost no thread.
+   */
+  void StartWorker() noexcept;
+
   /**
    * Exports all ended spans to the configured exporter.
    *
    * @param was_force_flush_called - A flag to check if the current export is the result
-   *                                 of a call to ForceFlush method. If true, then we have to
-   *                                 notify the main thread to wake it up in the ForceFlush
-   *                                 method.
+   *                                 of a call to ForceFlush method. If true, then everything in
+   *                                 the buffer is exported regardless of max_export_batch_size.
    */
   void Export(const bool was_for_flush_called);
 
+  /**
+   * Passes a batch of at most max_export_batch_bytes to the exporter, synchronously, or
+   * asynchronously with max_concurrent_exports.
+   */
+  void ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch);
+
+  /**
+   * Reorders `spans` by their grouping keys, keeping the order of the spans of a group.
+   */
+  void GroupByTrace(std::vector<std::unique_ptr<Recordable>> &spans);
+
+  /**
+   * Called before a fork: stops the worker thread, leaving the queued spans to the worker started
+   * after the fork. Holds shutdown_m_ until after the fork.
+   */
+  void PrepareFork();
+
+  /**
+   * Called in the parent after a fork: starts a new worker thread.
+   */
+  void ParentAfterFork();
+
+  /**
+   * Starts the worker thread again after a fork, or resumes the task of executor_.
+   */
+  void RestartWorker();
+
+  /**
+   * Called in the child after a fork: drops the spans queued by the parent, which exports them,
+   * and starts a new worker thread.
+   */
+  void ChildAfterFork();
+
   /**
    * Called when Shutdown() is invoked. Completely drains the queue of all its ended spans and
    * passes them to the exporter.
    */
   void DrainQueue();
 
+  /**
+   * Feeds the adaptive scheduler with the observations of the current worker cycle and updates
+   * the batch size used by Export.
+   *
+   * @param export_duration - The time spent exporting during this cycle.
+   * @return the delay until the next export.
+   */
+  std::chrono::milliseconds UpdateAdaptiveSchedule(
+      std::chrono::steady_clock::duration export_duration);
+
+  /**
+   * Publishes the backpressure of the current worker cycle to backpressure_signal_, if any.
+   */
+  void PublishBackpressure(std::chrono::steady_clock::duration export_duration,
+                           std::chrono::milliseconds schedule_delay) noexcept;
+
+  /**
+   * Accounts for a span dropped.
+   */
+  void RecordDropped() noexcept;
+
+  /**
+   * Blocks until at most `max_in_flight` asynchronous exports are outstanding, and, with
+   * max_in_flight_export_bytes, until `batch_bytes` more fit under it or none is outstanding.
+   */
+  void WaitForAsyncExports(size_t max_in_flight, size_t batch_bytes = 0);
+
+  /**
+   * Reuses a recordable of an exported span, or requests one from the exporter.
+   */
+  std::unique_ptr<Recordable> MakeExporterRecordable() noexcept;
+
+  /**
+   * Moves the spans of a thread-local buffer into the queue, dropping those which do not fit.
+   */
+  void HandOff(std::vector<std::unique_ptr<Recordable>> &spans) noexcept;
+
+  /**
+   * Replaces a span with the recordable wrapped by MakeRecordable, and returns whether it matches
+   * the priority rules.
+   */
+  bool UnwrapPrioritySpan(std::unique_ptr<Recordable> &span) const noexcept;
+
+  /**
+   * Replaces a span with the recordable wrapped by MakeRecordable, and moves its tenant into
+   * `tenant`.
+   */
+  void UnwrapTenantSpan(std::unique_ptr<Recordable> &span, std::string &tenant) const noexcept;
+
+  /**
+   * Wakes the worker thread up if the shard a span was just added to is at least half full.
+   */
+  void WakeUpIfHalfFull(const common::CircularBuffer<Recordable> &shard) noexcept;
+
+  /**
+   * Returns the bytes charged to memory_budget_ for a queued span.
+   */
+  static size_t GetChargedBytes(const Recordable &span) noexcept
+  {
+    return kSpanOverheadBytes + span.GetEstimatedSize();
+  }
+
+  /**
+   * Releases the charges of spans taken out of the queue, if there is a memory budget.
+   */
+  void ReleaseCharges(nostd::span<const std::unique_ptr<Recordable>> spans) noexcept;
+
+  /* State shared with the completion callbacks of in-flight asynchronous exports. The callbacks
+   * hold their own reference, so a late completion never touches a destroyed processor. */
+  struct AsyncExportState
+  {
+    std::mutex m;
+    std::condition_variable cv;
+    size_t in_flight       = 0;
+    size_t in_flight_bytes = 0;
+  };
+
   /* The configured backend exporter */
   std::unique_ptr<SpanExporter> exporter_;
 
@@ -136,21 +478,81 @@ class BatchSpanProcessor : public SpanProcessor
   const size_t max_queue_size_;
   const std::chrono::milliseconds schedule_delay_millis_;
   const size_t max_export_batch_size_;
+  const size_t max_concurrent_exports_;
+  const size_t max_in_flight_export_bytes_;
+  const bool deferred_recordables_;
+  const size_t max_export_batch_bytes_;
+  const bool group_by_trace_;
+
+  /* Adaptive batching state, only touched by the worker thread. The scheduler is null when
+   * adaptive batching is disabled. */
+  std::unique_ptr<common::AdaptiveBatchScheduler> adaptive_scheduler_;
+  size_t export_batch_size_;
+  uint64_t last_production_count_ = 0;
+  std::chrono::steady_clock::time_point last_adaptive_update_;
+
+  /* The delay between two export cycles, and until the next one, only touched by the worker. */
+  std::chrono::milliseconds worker_schedule_delay_;
+  std::chrono::milliseconds worker_timeout_;
 
   /* Synchronization primitives */
-  std::condition_variable cv_, force_flush_cv_;
-  std::mutex cv_m_, force_flush_cv_m_, shutdown_m_;
+  std::mutex shutdown_m_;
+  std::shared_ptr<AsyncExportState> async_export_state_;
+  common::BatchProcessorSynchronizer synchronizer_;
 
   /* The buffer/queue to which the ended spans are added */
-  common::CircularBuffer<Recordable> buffer_;
+  common::ShardedCircularBuffer<Recordable> buffer_;
+
+  /* The partition of the queue reserved to the spans matching priority_rules_ */
+  const ImportantSpanRules priority_rules_;
+  common::ShardedCircularBuffer<Recordable> priority_buffer_;
+
+  /* The batch being exported, reused by each export of the worker thread */
+  std::vector<std::unique_ptr<Recordable>> export_batch_;
+
+  /* The grouping keys of export_batch_ with the position of their span, and the spans reordered
+   * by them, reused by each export with group_by_trace */
+  std::vector<std::pair<RecordableGroupingKey, size_t>> grouping_keys_;
+  std::vector<std::unique_ptr<Recordable>> grouped_batch_;
+
+  /* The exported recordables waiting to be reused by MakeRecordable */
+  common::RecordablePool<Recordable> recycled_;
 
   /* Important boolean flags to handle the workflow of the processor */
   std::atomic<bool> is_shutdown_{false};
-  std::atomic<bool> is_force_flush_{false};
-  std::atomic<bool> is_force_flush_notified_{false};
+  std::atomic<bool> is_worker_started_{false};
+
+  /* Counters behind GetStats(), shared with the completion callbacks of asynchronous exports */
+  std::shared_ptr<common::BatchProcessorStatsRecorder> stats_;
 
-  /* The background worker thread */
+  /* The background worker thread, and its options */
   std::thread worker_thread_;
+  const common::ThreadOptions thread_options_;
+
+  /* The executor running the worker as a task instead, and that task, both null with a thread */
+  std::shared_ptr<common::ExportExecutor> executor_;
+  std::shared_ptr<common::ExportExecutor::Task> worker_task_;
+
+  /* The buffers of the threads ending spans, null unless thread_local_buffer_size is set */
+  std::unique_ptr<common::ThreadLocalBuffers<Recordable>> local_buffers_;
+
+  /* The budget the queued spans are charged to, and the id of the listener of its pressure */
+  std::shared_ptr<common::MemoryBudget> memory_budget_;
+  size_t pressure_listener_id_ = 0;
+
+  /* Where the backpressure is published, null if nobody reads it */
+  std::shared_ptr<common::BackpressureSignal> backpressure_signal_;
+
+  /* How the tenants of the spans are found, the turns of their sub-queues and their drops */
+  const TenantKey tenant_key_;
+  const size_t fair_queue_quantum_;
+  std::unique_ptr<common::TenantDropCounter> tenant_drops_;
+
+  /* The journal of the queued spans, or null. */
+  std::shared_ptr<common::RecordJournal> journal_;
+
+  /* Stops and restarts worker_thread_ around forks. Declared last, to be unregistered first. */
+  common::ForkHandlerRegistration fork_handler_;
 };
 
 }  // namespace trace
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include "opentelemetry/nostd/span.h"
 #include "opentelemetry/sdk/common/exporter_utils.h"
@@ -42,6 +43,28 @@ class SpanExporter
       const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>>
           &spans) noexcept = 0;
 
+  /**
+   * Exports a batch of span recordables without waiting for the export to complete.
+   *
+   * Exporters that can keep several requests in flight (e.g. to a remote collector) override this
+   * method. The recordables must be taken out of `spans` before this method returns. Unlike
+   * Export, this method may be called again before the previous batch completed, up to the
+   * concurrency configured on the calling processor.
+   *
+   * The default implementation calls Export synchronously and then invokes the callback.
+   *
+   * @param spans a span of unique pointers to span recordables
+   * @param result_callback invoked exactly once with the result of the export, possibly from
+   * another thread. It must not throw.
+   */
+  virtual void ExportAsync(
+      const nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>> &spans,
+      std::function<void(sdk::common::ExportResult)> &&result_callback) noexcept
+  {
+    auto result = Export(spans);
+    result_callback(result);
+  }
+
   /**
    * Shut down the exporter.
    * @param timeout an optional timeout.
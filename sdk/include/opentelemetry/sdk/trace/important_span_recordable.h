@@ -0,0 +1,183 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "opentelemetry/sdk/trace/arena_span_data.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * What makes an ended span important enough to be kept over the others: an error status, a
+ * duration reaching a threshold, or one of a set of attributes.
+ */
+struct ImportantSpanRules
+{
+  /* Spans ended with StatusCode::kError are important. */
+  bool errors = true;
+
+  /* Spans lasting at least this long are important. */
+  std::chrono::nanoseconds latency_threshold = std::chrono::nanoseconds::max();
+
+  /* Spans setting an attribute with one of these keys are important. */
+  std::vector<std::string> attribute_keys;
+
+  bool IsImportantStatus(opentelemetry::trace::StatusCode code) const noexcept
+  {
+    return errors && code == opentelemetry::trace::StatusCode::kError;
+  }
+
+  bool IsImportantDuration(std::chrono::nanoseconds duration) const noexcept
+  {
+    return duration >= latency_threshold;
+  }
+
+  bool IsImportantAttribute(nostd::string_view key) const noexcept
+  {
+    for (const auto &attribute_key : attribute_keys)
+    {
+      if (key == attribute_key)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Whether a span recorded once for several processors, see SharedRecordable, is important.
+   */
+  bool IsImportant(const ArenaSpanData &span) const noexcept
+  {
+    if (IsImportantStatus(span.GetStatus()) || IsImportantDuration(span.GetDuration()))
+    {
+      return true;
+    }
+    if (attribute_keys.empty())
+    {
+      return false;
+    }
+    return !span.GetAttributes().ForEachKeyValue(
+        [this](nostd::string_view key, opentelemetry::common::AttributeValue) noexcept {
+          return !IsImportantAttribute(key);
+        });
+  }
+};
+
+/**
+ * Forwards to the recordable of a processor, and records whether the span is important according
+ * to the given rules, which must outlive it.
+ */
+class ImportantSpanRecordable : public Recordable
+{
+public:
+  ImportantSpanRecordable(std::unique_ptr<Recordable> &&recordable,
+                          const ImportantSpanRules &rules) noexcept
+      : recordable_(std::move(recordable)), rules_(rules)
+  {}
+
+  Recordable &GetRecordable() noexcept { return *recordable_; }
+
+  std::unique_ptr<Recordable> ReleaseRecordable() noexcept { return std::move(recordable_); }
+
+  bool IsImportant() const noexcept { return important_; }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
+                   opentelemetry::trace::SpanId parent_span_id) noexcept override
+  {
+    recordable_->SetIdentity(span_context, parent_span_id);
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    if (rules_.IsImportantAttribute(key))
+    {
+      important_ = true;
+    }
+    recordable_->SetAttribute(key, value);
+  }
+
+  void AddEvent(nostd::string_view name,
+                opentelemetry::common::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    recordable_->AddEvent(name, timestamp, attributes);
+  }
+
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    recordable_->AddLink(span_context, attributes);
+  }
+
+  void SetStatus(opentelemetry::trace::StatusCode code,
+                 nostd::string_view description) noexcept override
+  {
+    if (rules_.IsImportantStatus(code))
+    {
+      important_ = true;
+    }
+    recordable_->SetStatus(code, description);
+  }
+
+  void SetName(nostd::string_view name) noexcept override { recordable_->SetName(name); }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    recordable_->SetSpanKind(span_kind);
+  }
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept override
+  {
+    recordable_->SetResource(resource);
+  }
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp start_time) noexcept override
+  {
+    recordable_->SetStartTime(start_time);
+  }
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override
+  {
+    if (rules_.IsImportantDuration(duration))
+    {
+      important_ = true;
+    }
+    recordable_->SetDuration(duration);
+  }
+
+  void SetInstrumentationLibrary(
+      const InstrumentationLibrary &instrumentation_library) noexcept override
+  {
+    recordable_->SetInstrumentationLibrary(instrumentation_library);
+  }
+
+  void Reserve(size_t attributes, size_t events) noexcept override
+  {
+    recordable_->Reserve(attributes, events);
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    recordable_->SetDroppedCounts(attributes, events, links);
+  }
+
+private:
+  std::unique_ptr<Recordable> recordable_;
+  const ImportantSpanRules &rules_;
+  bool important_ = false;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -153,6 +153,22 @@ class MultiRecordable : public Recordable
     }
   }
 
+  void Reserve(size_t attributes, size_t events) noexcept override
+  {
+    for (auto &recordable : recordables_)
+    {
+      recordable.second->Reserve(attributes, events);
+    }
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    for (auto &recordable : recordables_)
+    {
+      recordable.second->SetDroppedCounts(attributes, events, links);
+    }
+  }
+
 private:
   std::map<std::size_t, std::unique_ptr<Recordable>> recordables_;
 };
@@ -6,8 +6,12 @@
 #include <mutex>
 #include <vector>
 
+#include "opentelemetry/sdk/common/global_log_handler.h"
+#include "opentelemetry/sdk/common/shared_deadline.h"
+#include "opentelemetry/sdk/trace/arena_span_data.h"
 #include "opentelemetry/sdk/trace/multi_recordable.h"
 #include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/shared_recordable.h"
 
 #include <iostream>
 
@@ -19,7 +23,16 @@ namespace trace
 
 /** Instantiation options. */
 struct MultiSpanProcessorOptions
-{};
+{
+  /**
+   * Whether to record each span once, instead of once per processor. The span is recorded into an
+   * ArenaSpanData, and each processor receives a SharedRecordable referring to it when the span
+   * ends; the processors replay it into a recordable of their own exporter, the batch processor
+   * doing so on its worker thread. Every processor must then be a BatchSpanProcessor, a
+   * SimpleSpanProcessor or a processor which handles Recordable::GetSharedSpanData.
+   */
+  bool fan_out = false;
+};
 
 /**
  * Span processor allow hooks for span start and end method invocations.
@@ -30,8 +43,9 @@ struct MultiSpanProcessorOptions
 class MultiSpanProcessor : public SpanProcessor
 {
 public:
-  MultiSpanProcessor(std::vector<std::unique_ptr<SpanProcessor>> &&processors)
-      : head_(nullptr), tail_(nullptr), count_(0)
+  MultiSpanProcessor(std::vector<std::unique_ptr<SpanProcessor>> &&processors,
+                     const MultiSpanProcessorOptions &options = MultiSpanProcessorOptions())
+      : head_(nullptr), tail_(nullptr), count_(0), fan_out_(options.fan_out)
   {
     for (auto &processor : processors)
     {
@@ -60,6 +74,10 @@ class MultiSpanProcessor : public SpanProcessor
 
   std::unique_ptr<Recordable> MakeRecordable() noexcept override
   {
+    if (fan_out_)
+    {
+      return std::unique_ptr<Recordable>(new ArenaSpanData);
+    }
     auto recordable       = std::unique_ptr<Recordable>(new MultiRecordable);
     auto multi_recordable = static_cast<MultiRecordable *>(recordable.get());
     ProcessorNode *node   = head_;
@@ -75,6 +93,14 @@ class MultiSpanProcessor : public SpanProcessor
   virtual void OnStart(Recordable &span,
                        const opentelemetry::trace::SpanContext &parent_context) noexcept override
   {
+    if (fan_out_)
+    {
+      for (ProcessorNode *node = head_; node != nullptr; node = node->next_)
+      {
+        node->value_->OnStart(span, parent_context);
+      }
+      return;
+    }
     auto multi_recordable = static_cast<MultiRecordable *>(&span);
     ProcessorNode *node   = head_;
     while (node != nullptr)
@@ -91,6 +117,16 @@ class MultiSpanProcessor : public SpanProcessor
 
   virtual void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override
   {
+    if (fan_out_)
+    {
+      std::shared_ptr<const ArenaSpanData> span_data(
+          static_cast<ArenaSpanData *>(span.release()));
+      for (ProcessorNode *node = head_; node != nullptr; node = node->next_)
+      {
+        node->value_->OnEnd(std::unique_ptr<Recordable>(new SharedRecordable(span_data)));
+      }
+      return;
+    }
     auto multi_recordable = static_cast<MultiRecordable *>(span.release());
     ProcessorNode *node   = head_;
     while (node != nullptr)
@@ -106,32 +142,30 @@ class MultiSpanProcessor : public SpanProcessor
     delete multi_recordable;
   }
 
+  /**
+   * Flushes the processors concurrently, each until the same deadline, `timeout` from now.
+   * @return false if any processor failed or missed the deadline; each is logged.
+   */
   bool ForceFlush(
       std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override
   {
-    bool result         = true;
-    ProcessorNode *node = head_;
-    while (node != nullptr)
-    {
-      auto processor = node->value_.get();
-      result |= processor->ForceFlush(timeout);
-      node = node->next_;
-    }
-    return result;
+    return ForEachProcessorConcurrently(
+        "ForceFlush", timeout, [](SpanProcessor &processor, std::chrono::microseconds remaining) {
+          return processor.ForceFlush(remaining);
+        });
   }
 
+  /**
+   * Shuts the processors down concurrently, each until the same deadline, `timeout` from now.
+   * @return false if any processor failed or missed the deadline; each is logged.
+   */
   bool Shutdown(
       std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override
   {
-    bool result         = true;
-    ProcessorNode *node = head_;
-    while (node != nullptr)
-    {
-      auto processor = node->value_.get();
-      result |= processor->Shutdown(timeout);
-      node = node->next_;
-    }
-    return result;
+    return ForEachProcessorConcurrently(
+        "Shutdown", timeout, [](SpanProcessor &processor, std::chrono::microseconds remaining) {
+          return processor.Shutdown(remaining);
+        });
   }
 
   ~MultiSpanProcessor()
@@ -152,6 +186,34 @@ class MultiSpanProcessor : public SpanProcessor
     {}
   };
 
+  template <class Operation>
+  bool ForEachProcessorConcurrently(const char *name,
+                                    std::chrono::microseconds timeout,
+                                    Operation operation) noexcept
+  {
+    std::vector<SpanProcessor *> processors;
+    for (ProcessorNode *node = head_; node != nullptr; node = node->next_)
+    {
+      processors.push_back(node->value_.get());
+    }
+    auto run = [&](size_t index, std::chrono::microseconds remaining) {
+      return operation(*processors[index], remaining);
+    };
+    std::vector<bool> succeeded = common::RunWithSharedDeadline(processors.size(), timeout, run);
+
+    bool result = true;
+    for (size_t i = 0; i < succeeded.size(); ++i)
+    {
+      if (!succeeded[i])
+      {
+        OTEL_INTERNAL_LOG_WARN("[MultiSpanProcessor::" << name << "] processor " << i
+                                                       << " failed or missed the deadline");
+        result = false;
+      }
+    }
+    return result;
+  }
+
   void Cleanup()
   {
     if (count_)
@@ -181,6 +243,7 @@ class MultiSpanProcessor : public SpanProcessor
 
   ProcessorNode *head_, *tail_;
   size_t count_;
+  const bool fan_out_;
 };
 }  // namespace trace
 }  // namespace sdk
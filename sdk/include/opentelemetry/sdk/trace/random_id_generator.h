@@ -13,9 +13,18 @@ namespace trace
 class RandomIdGenerator : public IdGenerator
 {
 public:
+  /**
+   * @param buffered whether to take the ids from a per-thread buffer of random numbers, filled
+   * in bulk, rather than generating the random numbers of each id when it is requested.
+   */
+  explicit RandomIdGenerator(bool buffered = false) noexcept : buffered_(buffered) {}
+
   opentelemetry::trace::SpanId GenerateSpanId() noexcept override;
 
   opentelemetry::trace::TraceId GenerateTraceId() noexcept override;
+
+private:
+  bool buffered_;
 };
 
 }  // namespace trace
@@ -8,6 +8,7 @@
 #include "opentelemetry/common/timestamp.h"
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/empty_attributes.h"
+#include "opentelemetry/sdk/common/record_journal.h"
 #include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #include "opentelemetry/sdk/resource/resource.h"
 #include "opentelemetry/trace/canonical_code.h"
@@ -18,6 +19,7 @@
 #include "opentelemetry/version.h"
 
 #include <map>
+#include <string>
 
 // TODO: Create generic short pattern for opentelemetry::common and opentelemetry::trace
 
@@ -29,6 +31,20 @@ namespace trace
 
 using namespace opentelemetry::sdk::instrumentationlibrary;
 
+class ArenaSpanData;
+
+/**
+ * The resource, instrumentation library and trace of a span, by which batch processors group the
+ * spans of each export, see BatchSpanProcessorOptions::group_by_trace. The resource and the
+ * instrumentation library are compared by address: they are shared by all the spans of a tracer.
+ */
+struct RecordableGroupingKey
+{
+  const opentelemetry::sdk::resource::Resource *resource = nullptr;
+  const InstrumentationLibrary *instrumentation_library  = nullptr;
+  opentelemetry::trace::TraceId trace_id;
+};
+
 /**
  * Maintains a representation of a span in a format that can be processed by a recorder.
  *
@@ -146,6 +162,68 @@ class Recordable
    */
   virtual void SetInstrumentationLibrary(
       const InstrumentationLibrary &instrumentation_library) noexcept = 0;
+
+  /**
+   * Set the number of attributes, events and links the span dropped because of
+   * its SpanLimits. Only called when the span dropped something.
+   * @param attributes the number of dropped attributes
+   * @param events the number of dropped events
+   * @param links the number of dropped links
+   */
+  virtual void SetDroppedCounts(uint32_t /* attributes */,
+                                uint32_t /* events */,
+                                uint32_t /* links */) noexcept
+  {}
+
+  /**
+   * Reserve room for the attributes and events the span is expected to record, see
+   * StartSpanOptions::expected_attributes. Called before any attribute is set, when the span was
+   * given a hint.
+   * @param attributes the expected number of attributes
+   * @param events the expected number of events
+   */
+  virtual void Reserve(size_t /* attributes */, size_t /* events */) noexcept {}
+
+  /**
+   * Clear the recordable so that it can record another span, keeping the memory it allocated.
+   * Processors call it once the recordable was exported, and reuse it if it returns true.
+   * @return false if the recordable cannot be reused, the default
+   */
+  virtual bool Reset() noexcept { return false; }
+
+  /**
+   * Returns the span this recordable stands for when the span was recorded once and shared
+   * between several processors, see MultiSpanProcessorOptions::fan_out. Processors replay it into
+   * a recordable of their own exporter before exporting it.
+   * @return nullptr if the recordable holds its own span, the default
+   */
+  virtual const ArenaSpanData *GetSharedSpanData() const noexcept { return nullptr; }
+
+  /**
+   * Estimates the number of bytes of the span once serialized by the exporter. Batch processors
+   * use it to keep the payload of each export under their max_export_batch_bytes.
+   * @return 0 if the size is unknown, the default
+   */
+  virtual size_t GetEstimatedSize() const noexcept { return 0; }
+
+  /**
+   * Returns the resource, instrumentation library and trace of the span, by which batch processors
+   * group the spans of each export.
+   * @return null pointers and an invalid trace id if the recordable does not keep them, the
+   * default, which leaves the span in its place
+   */
+  virtual RecordableGroupingKey GetGroupingKey() const noexcept { return {}; }
+
+  /**
+   * Appends the span to `out` in an encoding of the recordable, for the journal of a batch
+   * processor, see BatchSpanProcessorOptions::journal.
+   * @return the type of the encoding, JournalRecordType::kNone if the recordable cannot encode
+   * itself, the default, which leaves the span out of the journal
+   */
+  virtual common::JournalRecordType AppendJournalRecord(std::string & /* out */) const noexcept
+  {
+    return common::JournalRecordType::kNone;
+  }
 };
 }  // namespace trace
 }  // namespace sdk
@@ -0,0 +1,82 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The Adaptive sampler samples a ratio of the traces, like the TraceIdRatioBased
+ * sampler, and retunes that ratio at every adjustment interval so that the rate
+ * of sampled spans approaches the target. The new ratio is the target rate over
+ * the rate at which spans were started during the last interval, averaged with
+ * the previous ratio to damp spikes.
+ *
+ * The ratio is only updated by the thread that starts the first span of an
+ * interval, with atomic operations, so that sampling never blocks.
+ *
+ * Sampled spans carry the entry kTraceStateKey=ratio:<ratio> in their
+ * tracestate, where ratio is the one they were sampled with.
+ */
+class AdaptiveSampler : public Sampler
+{
+public:
+  static constexpr const char *kTraceStateKey = "otel-sampler";
+
+  /**
+   * @param target_spans_per_second the rate of sampled spans to approach, > 0.
+   * @param adjustment_interval the interval at which the ratio is retuned.
+   * @param initial_ratio the ratio used during the first interval, 1.0 >= ratio >= 0.0.
+   * @throws invalid_argument if target_spans_per_second is not positive
+   */
+  explicit AdaptiveSampler(
+      double target_spans_per_second,
+      std::chrono::steady_clock::duration adjustment_interval = std::chrono::seconds(1),
+      double initial_ratio                                    = 1.0);
+
+  /**
+   * @return Returns either RECORD_AND_SAMPLE or DROP based on the current
+   * ratio and the provided trace_id.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext &parent_context,
+      opentelemetry::trace::TraceId trace_id,
+      nostd::string_view /*name*/,
+      opentelemetry::trace::SpanKind /*span_kind*/,
+      const opentelemetry::common::KeyValueIterable & /*attributes*/,
+      const opentelemetry::trace::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be AdaptiveSampler{100.000000}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * @return the ratio of traces currently sampled.
+   */
+  double GetRatio() const noexcept;
+
+private:
+  void Adjust(int64_t now) noexcept;
+
+  std::string description_;
+  const double target_spans_per_second_;
+  const int64_t adjustment_interval_;
+  std::atomic<double> ratio_;
+  std::atomic<uint64_t> threshold_;
+  // Spans started since interval_start_, in steady clock nanoseconds.
+  std::atomic<uint64_t> started_spans_;
+  std::atomic<int64_t> interval_start_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
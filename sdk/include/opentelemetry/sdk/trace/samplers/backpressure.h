@@ -0,0 +1,69 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/common/backpressure_signal.h"
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <memory>
+#include <string>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The Backpressure sampler is a composite sampler which sheds load when the processor it is
+ * paired with falls behind, before the spans it would drop are built. The pairing is a
+ * BackpressureSignal shared with the processor, see BatchSpanProcessorOptions.
+ *
+ * While the backpressure level is at most the threshold, the decisions of the delegate are kept.
+ * Past it, the spans the delegate samples are kept with a probability decreasing linearly from 1
+ * to 0 as the level goes from the threshold to 1. The probability is applied to the trace id, as
+ * by the TraceIdRatioBased sampler, so the spans of a trace are shed together at a given level.
+ */
+class BackpressureSampler : public Sampler
+{
+public:
+  /**
+   * @param delegate_sampler the sampler whose decisions are kept without backpressure.
+   * @param signal the backpressure of the processor the spans are sent to.
+   * @param threshold the backpressure level past which spans are shed, 1.0 > threshold >= 0.0.
+   * @throws invalid_argument if delegate_sampler or signal is null, or threshold is out of range
+   */
+  BackpressureSampler(std::shared_ptr<Sampler> delegate_sampler,
+                      std::shared_ptr<const common::BackpressureSignal> signal,
+                      double threshold = 0.5);
+
+  /**
+   * @return Returns the decision of the delegate, turned into DROP for the spans shed.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext &parent_context,
+      opentelemetry::trace::TraceId trace_id,
+      nostd::string_view name,
+      opentelemetry::trace::SpanKind span_kind,
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const opentelemetry::trace::SpanContextKeyValueIterable &links) noexcept override;
+
+  /**
+   * @return Description MUST be Backpressure{delegate_sampler_.getDescription()}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * @return the probability with which the spans sampled by the delegate are currently kept.
+   */
+  double GetKeepRatio() const noexcept;
+
+private:
+  const std::shared_ptr<Sampler> delegate_sampler_;
+  const std::shared_ptr<const common::BackpressureSignal> signal_;
+  const double threshold_;
+  std::string description_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,87 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <cstdint>
+#include <string>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The ConsistentProbabilityBased sampler samples with a probability which is a power of two,
+ * recorded in the `ot` entry of the tracestate as in the OpenTelemetry specification of
+ * probability sampling, so that the spans sampled can be counted downstream: each stands for
+ * 2^p spans.
+ *
+ * - The p-value is the negated base-2 logarithm of the probability, 0 to 62, or 63 for a zero
+ *   probability. Other probabilities are sampled with one of the two p-values surrounding them,
+ *   picked at random with the weights whose mean is the probability.
+ * - The r-value is the randomness of the trace, 0 to 62, r >= k with a probability of 2^-k. It
+ *   is the one of the parent when in its tracestate, else it is the number of leading zeros of
+ *   the last 8 bytes of the trace id, which are random.
+ *
+ * A span is sampled if p <= r: services sampling a trace at different probabilities sample
+ * consistent subsets of it. Sampled spans carry ot=p:<p>;r:<r>, the others ot=r:<r>; other
+ * fields of the entry are kept.
+ */
+class ConsistentProbabilityBasedSampler : public Sampler
+{
+public:
+  static constexpr const char *kTraceStateKey = "ot";
+  static constexpr int kMaxPValue             = 63;
+  static constexpr int kMaxRValue             = 62;
+
+  /**
+   * @param probability the probability of sampling a span, 1.0 >= probability >= 0.0.
+   */
+  explicit ConsistentProbabilityBasedSampler(double probability) noexcept;
+
+  /**
+   * @return Returns RECORD_AND_SAMPLE if p <= r, DROP otherwise.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext &parent_context,
+      opentelemetry::trace::TraceId trace_id,
+      nostd::string_view /*name*/,
+      opentelemetry::trace::SpanKind /*span_kind*/,
+      const opentelemetry::common::KeyValueIterable & /*attributes*/,
+      const opentelemetry::trace::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be ConsistentProbabilityBasedSampler{0.250000}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * Returns the r-value of a trace id: the number of leading zeros of its last 8 bytes, at most
+   * kMaxRValue.
+   */
+  static int GetRValue(const opentelemetry::trace::TraceId &trace_id) noexcept;
+
+  /**
+   * Parses the value of an `ot` tracestate entry.
+   * @param p_value set to the p-value of the entry, or -1 if it has none or it is invalid.
+   * @param r_value set to the r-value of the entry, or -1 if it has none or it is invalid.
+   * @param other_fields set to the other fields of the entry, separated by ';'.
+   */
+  static void ParseTraceStateValue(nostd::string_view value,
+                                   int &p_value,
+                                   int &r_value,
+                                   std::string &other_fields);
+
+private:
+  std::string description_;
+  // The smaller p-value, and the threshold below which a 64 bit random number picks it rather
+  // than the next one. UINT64_MAX if the probability is a power of two.
+  int p_value_;
+  uint64_t lower_p_threshold_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
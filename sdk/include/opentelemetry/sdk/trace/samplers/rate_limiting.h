@@ -0,0 +1,64 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <atomic>
+#include <cstdint>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * The RateLimiting sampler samples at most a given number of spans per second,
+ * whatever the rate at which spans are started. Decisions are taken from a
+ * token bucket holding up to one second worth of spans, which is updated with
+ * a compare-and-swap and never blocks.
+ *
+ * Sampled spans carry the entry kTraceStateKey=rate:<spans_per_second> in
+ * their tracestate.
+ */
+class RateLimitingSampler : public Sampler
+{
+public:
+  static constexpr const char *kTraceStateKey = "otel-sampler";
+
+  /**
+   * @param spans_per_second the maximum rate of sampled spans, > 0.
+   * @throws invalid_argument if spans_per_second is not positive
+   */
+  explicit RateLimitingSampler(double spans_per_second);
+
+  /**
+   * @return Returns RECORD_AND_SAMPLE if the bucket holds a token, DROP
+   * otherwise.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext &parent_context,
+      opentelemetry::trace::TraceId /*trace_id*/,
+      nostd::string_view /*name*/,
+      opentelemetry::trace::SpanKind /*span_kind*/,
+      const opentelemetry::common::KeyValueIterable & /*attributes*/,
+      const opentelemetry::trace::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be RateLimitingSampler{100.000000}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+private:
+  std::string description_;
+  std::string trace_state_value_;
+  // Nanoseconds between two tokens, and capacity of the bucket in nanoseconds.
+  const int64_t interval_;
+  const int64_t burst_;
+  // Time, in steady clock nanoseconds, up to which the tokens taken so far are paid for.
+  std::atomic<int64_t> paid_until_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,118 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A rule of the RuleBased sampler: the spans it matches, and the ratio of their traces sampled.
+ */
+struct SamplingRule
+{
+  /* The name of the spans matched, any if empty. */
+  std::string span_name;
+
+  /* The kinds of the spans matched, any if empty. */
+  std::vector<opentelemetry::trace::SpanKind> span_kinds;
+
+  /* Start attributes the spans matched must all have, with these string values. */
+  std::vector<std::pair<std::string, std::string>> attributes;
+
+  /* The ratio of the traces sampled, 1.0 >= ratio >= 0.0. */
+  double ratio = 1.0;
+};
+
+/**
+ * The RuleBased sampler samples each span at the ratio of the first rule it matches, on its
+ * span name, kind and start attributes, or at the default ratio if it matches none. Like the
+ * TraceIdRatioBased sampler, ratios are applied to the trace id.
+ *
+ * The rules are compiled when the sampler is created, each given a bit in a mask, and so are the
+ * distinct attribute predicates: a span is matched with a hash lookup of its name, one of its
+ * kind, and one per start attribute whose key appears in a predicate, followed by operations on
+ * the masks. No rule is scanned and nothing is allocated while sampling.
+ *
+ * At most kMaxRules rules and kMaxPredicates distinct attribute predicates are supported.
+ */
+class RuleBasedSampler : public Sampler
+{
+public:
+  static constexpr size_t kMaxRules      = 64;
+  static constexpr size_t kMaxPredicates = 64;
+
+  /**
+   * @param rules the rules, in the order they are tried.
+   * @param default_ratio the ratio of the spans which match no rule, 1.0 >= ratio >= 0.0.
+   * @throws invalid_argument if there are more than kMaxRules rules or kMaxPredicates predicates
+   */
+  explicit RuleBasedSampler(std::vector<SamplingRule> rules, double default_ratio = 1.0);
+
+  /**
+   * @return Returns either RECORD_AND_SAMPLE or DROP based on the ratio of the rule matched and
+   * the provided trace_id.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext & /*parent_context*/,
+      opentelemetry::trace::TraceId trace_id,
+      nostd::string_view name,
+      opentelemetry::trace::SpanKind span_kind,
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const opentelemetry::trace::SpanContextKeyValueIterable & /*links*/) noexcept override;
+
+  /**
+   * @return Description MUST be RuleBasedSampler{<number of rules>,<default ratio>}
+   */
+  nostd::string_view GetDescription() const noexcept override;
+
+  /**
+   * @return the index of the first rule matched by a span, or the number of rules if none is.
+   */
+  size_t FindRule(nostd::string_view name,
+                  opentelemetry::trace::SpanKind span_kind,
+                  const opentelemetry::common::KeyValueIterable &attributes) const noexcept;
+
+private:
+  // FNV-1a, like AttributeKey::hash().
+  struct StringViewHash
+  {
+    size_t operator()(nostd::string_view value) const noexcept;
+  };
+
+  template <class T>
+  using StringViewMap = std::unordered_map<nostd::string_view, T, StringViewHash>;
+
+  static constexpr size_t kNumSpanKinds = 5;
+
+  // The maps are keyed by views of the strings of rules_, which is never modified.
+  const std::vector<SamplingRule> rules_;
+  std::string description_;
+
+  // Rules matching any name, and rules matching each name.
+  uint64_t any_name_rules_ = 0;
+  StringViewMap<uint64_t> name_rules_;
+  // Rules matching each span kind.
+  uint64_t kind_rules_[kNumSpanKinds] = {};
+  // Rules with attribute predicates, and the predicates of each rule.
+  uint64_t predicated_rules_ = 0;
+  std::vector<uint64_t> rule_predicates_;
+  // The predicates satisfied by each key and value.
+  StringViewMap<StringViewMap<uint64_t>> predicates_;
+
+  // Thresholds the first 8 bytes of the trace id are compared with, for each rule then default.
+  std::vector<uint64_t> thresholds_;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,97 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+
+#include "opentelemetry/sdk/trace/arena_span_data.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * A reference to an ended span which was recorded once into an ArenaSpanData, and is shared by
+ * the processors of a fan-out MultiSpanProcessor. The span is immutable: the setters do nothing.
+ * It is destroyed along with the last SharedRecordable referring to it.
+ */
+class SharedRecordable final : public Recordable
+{
+public:
+  explicit SharedRecordable(std::shared_ptr<const ArenaSpanData> span_data) noexcept
+      : span_data_(std::move(span_data))
+  {}
+
+  const ArenaSpanData *GetSharedSpanData() const noexcept override { return span_data_.get(); }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext & /* span_context */,
+                   opentelemetry::trace::SpanId /* parent_span_id */) noexcept override
+  {}
+
+  void SetAttribute(nostd::string_view /* key */,
+                    const opentelemetry::common::AttributeValue & /* value */) noexcept override
+  {}
+
+  void AddEvent(nostd::string_view /* name */,
+                opentelemetry::common::SystemTimestamp /* timestamp */,
+                const opentelemetry::common::KeyValueIterable & /* attributes */) noexcept override
+  {}
+
+  void AddLink(const opentelemetry::trace::SpanContext & /* span_context */,
+               const opentelemetry::common::KeyValueIterable & /* attributes */) noexcept override
+  {}
+
+  void SetStatus(opentelemetry::trace::StatusCode /* code */,
+                 nostd::string_view /* description */) noexcept override
+  {}
+
+  void SetName(nostd::string_view /* name */) noexcept override {}
+
+  void SetSpanKind(opentelemetry::trace::SpanKind /* span_kind */) noexcept override {}
+
+  void SetResource(const opentelemetry::sdk::resource::Resource & /* resource */) noexcept override
+  {}
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp /* start_time */) noexcept override {}
+
+  void SetDuration(std::chrono::nanoseconds /* duration */) noexcept override {}
+
+  void SetInstrumentationLibrary(
+      const InstrumentationLibrary & /* instrumentation_library */) noexcept override
+  {}
+
+private:
+  std::shared_ptr<const ArenaSpanData> span_data_;
+};
+
+/**
+ * Replaces a recordable standing for a shared span with a recordable made by `make_recordable`,
+ * into which the shared span is replayed. Other recordables are left as they are.
+ */
+template <class MakeRecordable>
+void ResolveSharedRecordable(std::unique_ptr<Recordable> &recordable,
+                             MakeRecordable &&make_recordable) noexcept
+{
+  if (recordable == nullptr)
+  {
+    return;
+  }
+  const ArenaSpanData *span_data = recordable->GetSharedSpanData();
+  if (span_data == nullptr)
+  {
+    return;
+  }
+  std::unique_ptr<Recordable> own = make_recordable();
+  if (own != nullptr)
+  {
+    span_data->Replay(*own);
+  }
+  recordable = std::move(own);
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -4,22 +4,47 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
+#include <vector>
 
 #include "opentelemetry/common/spin_lock_mutex.h"
 #include "opentelemetry/sdk/trace/exporter.h"
 #include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/shared_recordable.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace trace
 {
+/**
+ * Struct to hold simple span processor options.
+ */
+struct SimpleSpanProcessorOptions
+{
+  /**
+   * The number of finished spans exported together. Spans are accumulated on the threads ending
+   * them, and the thread ending the span which completes a batch exports it; there is no
+   * background thread. With the default of 1, every span is exported as soon as it ends.
+   */
+  size_t max_export_batch_size = 1;
+
+  /**
+   * The longest time the first span of a partial batch waits for the batch to complete. Since no
+   * thread wakes up to export it, a late batch is exported when the next span ends, or on
+   * ForceFlush or Shutdown.
+   */
+  std::chrono::milliseconds max_export_delay = (std::chrono::milliseconds::max)();
+};
+
 /**
  * The simple span processor passes finished recordables to the configured
- * SpanExporter, as soon as they are finished.
+ * SpanExporter, as soon as they are finished, or in micro-batches of
+ * SimpleSpanProcessorOptions::max_export_batch_size spans, exported by the
+ * thread ending the last span of the batch.
  *
- * OnEnd and ForceFlush are no-ops.
+ * ForceFlush exports the spans of a partial batch.
  *
  * All calls to the configured SpanExporter are synchronized using a
  * spin-lock on an atomic_flag.
@@ -30,9 +55,12 @@ class SimpleSpanProcessor : public SpanProcessor
   /**
    * Initialize a simple span processor.
    * @param exporter the exporter used by the span processor
+   * @param options the options of the micro-batches of spans
    */
-  explicit SimpleSpanProcessor(std::unique_ptr<SpanExporter> &&exporter) noexcept
-      : exporter_(std::move(exporter))
+  explicit SimpleSpanProcessor(
+      std::unique_ptr<SpanExporter> &&exporter,
+      const SimpleSpanProcessorOptions &options = SimpleSpanProcessorOptions()) noexcept
+      : exporter_(std::move(exporter)), options_(options)
   {}
 
   std::unique_ptr<Recordable> MakeRecordable() noexcept override
@@ -46,19 +74,33 @@ class SimpleSpanProcessor : public SpanProcessor
 
   void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override
   {
-    nostd::span<std::unique_ptr<Recordable>> batch(&span, 1);
+    ResolveSharedRecordable(span, [this] { return exporter_->MakeRecordable(); });
     const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-    if (exporter_->Export(batch) == sdk::common::ExportResult::kFailure)
+    if (options_.max_export_batch_size <= 1)
     {
-      /* Once it is defined how the SDK does logging, an error should be
-       * logged in this case. */
+      nostd::span<std::unique_ptr<Recordable>> batch(&span, 1);
+      Export(batch);
+      return;
+    }
+
+    bool delayed = options_.max_export_delay != (std::chrono::milliseconds::max)();
+    if (batch_.empty() && delayed)
+    {
+      batch_start_ = std::chrono::steady_clock::now();
+    }
+    batch_.push_back(std::move(span));
+    if (batch_.size() >= options_.max_export_batch_size ||
+        (delayed && std::chrono::steady_clock::now() - batch_start_ >= options_.max_export_delay))
+    {
+      ExportBatch();
     }
   }
 
   bool ForceFlush(
       std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override
   {
-    return true;
+    const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+    return ExportBatch();
   }
 
   bool Shutdown(
@@ -67,6 +109,7 @@ class SimpleSpanProcessor : public SpanProcessor
     // We only call shutdown ONCE.
     if (exporter_ != nullptr && !shutdown_latch_.test_and_set(std::memory_order_acquire))
     {
+      ForceFlush(timeout);
       return exporter_->Shutdown(timeout);
     }
     return true;
@@ -75,8 +118,35 @@ class SimpleSpanProcessor : public SpanProcessor
   ~SimpleSpanProcessor() { Shutdown(); }
 
 private:
+  // Exports batch, with lock_ held.
+  bool Export(const nostd::span<std::unique_ptr<Recordable>> &batch) noexcept
+  {
+    if (exporter_->Export(batch) == sdk::common::ExportResult::kFailure)
+    {
+      /* Once it is defined how the SDK does logging, an error should be
+       * logged in this case. */
+      return false;
+    }
+    return true;
+  }
+
+  // Exports the spans of the current batch, if any, with lock_ held.
+  bool ExportBatch() noexcept
+  {
+    if (batch_.empty())
+    {
+      return true;
+    }
+    bool result = Export(nostd::span<std::unique_ptr<Recordable>>(batch_.data(), batch_.size()));
+    batch_.clear();
+    return result;
+  }
+
   std::unique_ptr<SpanExporter> exporter_;
+  const SimpleSpanProcessorOptions options_;
   opentelemetry::common::SpinLockMutex lock_;
+  std::vector<std::unique_ptr<Recordable>> batch_;
+  std::chrono::steady_clock::time_point batch_start_;
   std::atomic_flag shutdown_latch_ = ATOMIC_FLAG_INIT;
 };
 }  // namespace trace
@@ -0,0 +1,188 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/trace/span_id.h"
+#include "opentelemetry/trace/span_metadata.h"
+#include "opentelemetry/trace/trace_id.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/**
+ * Struct to hold span compression SpanProcessor options.
+ */
+struct SpanCompressionProcessorOptions
+{
+  /**
+   * Only spans of this kind are compressed. Client spans, calls to other services and databases,
+   * are the leaves of their traces: no span refers to a compressed span as its parent.
+   */
+  opentelemetry::trace::SpanKind kind = opentelemetry::trace::SpanKind::kClient;
+
+  /* Only spans lasting less than this are compressed, so that slow calls stay visible. */
+  std::chrono::nanoseconds max_duration = std::chrono::milliseconds(50);
+
+  /**
+   * The maximum number of runs of siblings pending at the same time. Once it is reached, spans
+   * which would start a new run are forwarded as they are.
+   */
+  size_t max_pending_runs = 4096;
+
+  /**
+   * The number of buckets the pending runs are spread across. Each bucket has its own lock, so
+   * that spans of different parents ending concurrently rarely contend.
+   */
+  size_t num_buckets = 16;
+};
+
+/**
+ * Counters of a SpanCompressionProcessor, see SpanCompressionProcessor::GetStats.
+ */
+struct SpanCompressionProcessorStats
+{
+  /* Runs of siblings currently pending, waiting for a different sibling or their parent. */
+  size_t pending_runs = 0;
+
+  /* Spans forwarded in place of a run of at least two siblings. */
+  uint64_t composite_spans = 0;
+
+  /* Spans merged into the first span of their run, and not forwarded. */
+  uint64_t compressed_spans = 0;
+};
+
+/**
+ * This is an implementation of the SpanProcessor which collapses consecutive identical sibling
+ * spans, like the queries of an N+1 query pattern, before forwarding the spans to the wrapped
+ * processor, typically a BatchSpanProcessor.
+ *
+ * Siblings are identical when they have the same parent, name, kind and attribute keys. A span of
+ * the configured kind, shorter than max_duration, without events nor an error status, starts a
+ * run of siblings, which the next identical siblings join. The run ends at the first different
+ * sibling, when the parent ends, or at ForceFlush and Shutdown; its first span is then forwarded
+ * with, for runs of several spans:
+ * - the duration extended to the end of the last span of the run,
+ * - a "span.compression.count" attribute, the number of spans of the run,
+ * - a "span.compression.duration_sum" attribute, the sum of their durations in nanoseconds.
+ */
+class SpanCompressionProcessor : public SpanProcessor
+{
+public:
+  /**
+   * @param processor - The processor to forward the spans to.
+   * @param options - The span compression SpanProcessor options.
+   */
+  SpanCompressionProcessor(std::unique_ptr<SpanProcessor> &&processor,
+                           const SpanCompressionProcessorOptions &options);
+
+  /**
+   * Requests a Recordable(Span) from the wrapped processor, and wraps it to observe the identity,
+   * name, kind, attribute keys, events, status and timing of the span.
+   */
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  void OnStart(Recordable &span,
+               const opentelemetry::trace::SpanContext &parent_context) noexcept override;
+
+  /**
+   * Merges the ended span into the run of its siblings, starts a new run with it, or forwards it.
+   */
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
+
+  /**
+   * Forwards the pending runs, then flushes the wrapped processor.
+   */
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Forwards the pending runs, then shuts down the wrapped processor.
+   */
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Returns a snapshot of the processor's counters. Safe to call from any thread.
+   */
+  SpanCompressionProcessorStats GetStats() const noexcept;
+
+  ~SpanCompressionProcessor();
+
+private:
+  struct ParentKey
+  {
+    opentelemetry::trace::TraceId trace_id;
+    opentelemetry::trace::SpanId span_id;
+
+    bool operator==(const ParentKey &other) const noexcept
+    {
+      return trace_id == other.trace_id && span_id == other.span_id;
+    }
+  };
+
+  struct ParentKeyHash
+  {
+    size_t operator()(const ParentKey &key) const noexcept;
+  };
+
+  /* The spans merged so far into the first span of a run of identical siblings. */
+  struct Run
+  {
+    std::unique_ptr<Recordable> first;
+    uint64_t count = 1;
+    std::chrono::nanoseconds duration_sum{0};
+    std::chrono::system_clock::time_point end;
+  };
+
+  struct Bucket
+  {
+    std::mutex lock;
+    std::unordered_map<ParentKey, Run, ParentKeyHash> runs;
+  };
+
+  Bucket &GetBucket(const ParentKey &key) noexcept;
+
+  /**
+   * Removes the pending run of the children of the given parent, if any, into `run`.
+   */
+  bool TakeRun(const ParentKey &key, Run &run) noexcept;
+
+  /**
+   * Forwards the first span of a run to the wrapped processor, as a composite span if the run
+   * has several spans.
+   */
+  void Forward(Run &&run) noexcept;
+
+  /**
+   * Forwards the pending runs of every bucket.
+   */
+  void ForwardAll() noexcept;
+
+  std::unique_ptr<SpanProcessor> processor_;
+  const opentelemetry::trace::SpanKind kind_;
+  const std::chrono::nanoseconds max_duration_;
+  const size_t max_pending_runs_;
+  const size_t num_buckets_;
+  std::unique_ptr<Bucket[]> buckets_;
+
+  std::atomic<size_t> pending_runs_{0};
+  std::atomic<uint64_t> composite_spans_{0};
+  std::atomic<uint64_t> compressed_spans_{0};
+  std::atomic_flag shutdown_latch_ = ATOMIC_FLAG_INIT;
+  std::atomic<bool> is_shutdown_{false};
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -10,6 +10,8 @@
 #include "opentelemetry/common/timestamp.h"
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/common/binary_encoding.h"
+#include "opentelemetry/sdk/common/small_vector.h"
 #include "opentelemetry/sdk/trace/recordable.h"
 #include "opentelemetry/trace/canonical_code.h"
 #include "opentelemetry/trace/span.h"
@@ -51,15 +53,21 @@ class SpanDataEvent
    * Get the attributes for this event
    * @return the attributes for this event
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
+  const common::FlatAttributeMap &GetAttributes() const noexcept { return attribute_map_; }
+
+  /**
+   * Estimates the number of bytes of this event once serialized, see Recordable::GetEstimatedSize
+   */
+  size_t GetEstimatedSize() const noexcept
   {
-    return attribute_map_.GetAttributes();
+    // The timestamp and the framing of the event.
+    return 16 + name_.size() + common::EstimateAttributesSize(attribute_map_);
   }
 
 private:
   std::string name_;
   opentelemetry::common::SystemTimestamp timestamp_;
-  common::AttributeMap attribute_map_;
+  common::FlatAttributeMap attribute_map_;
 };
 
 /**
@@ -77,10 +85,7 @@ class SpanDataLink
    * Get the attributes for this link
    * @return the attributes for this link
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attribute_map_.GetAttributes();
-  }
+  const common::FlatAttributeMap &GetAttributes() const noexcept { return attribute_map_; }
 
   /**
    * Get the span context for this link
@@ -88,11 +93,27 @@ class SpanDataLink
    */
   const opentelemetry::trace::SpanContext &GetSpanContext() const noexcept { return span_context_; }
 
+  /**
+   * Estimates the number of bytes of this link once serialized, see Recordable::GetEstimatedSize
+   */
+  size_t GetEstimatedSize() const noexcept
+  {
+    // The trace and span ids and the framing of the link.
+    return 32 + common::EstimateAttributesSize(attribute_map_);
+  }
+
 private:
   opentelemetry::trace::SpanContext span_context_;
-  common::AttributeMap attribute_map_;
+  common::FlatAttributeMap attribute_map_;
 };
 
+/**
+ * The events and links of a SpanData. Most spans have few of them, so the first ones are stored
+ * in the SpanData itself.
+ */
+using SpanDataEvents = common::SmallVector<SpanDataEvent, 3>;
+using SpanDataLinks  = common::SmallVector<SpanDataLink, 2>;
+
 /**
  * SpanData is a representation of all data collected by a span.
  */
@@ -201,22 +222,37 @@ class SpanData final : public Recordable
    * Get the attributes for this span
    * @return the attributes for this span
    */
-  const std::unordered_map<std::string, common::OwnedAttributeValue> &GetAttributes() const noexcept
-  {
-    return attribute_map_.GetAttributes();
-  }
+  const common::SpanAttributeMap &GetAttributes() const noexcept { return attribute_map_; }
 
   /**
    * Get the events associated with this span
    * @return the events associated with this span
    */
-  const std::vector<SpanDataEvent> &GetEvents() const noexcept { return events_; }
+  const SpanDataEvents &GetEvents() const noexcept { return events_; }
 
   /**
    * Get the links associated with this span
    * @return the links associated with this span
    */
-  const std::vector<SpanDataLink> &GetLinks() const noexcept { return links_; }
+  const SpanDataLinks &GetLinks() const noexcept { return links_; }
+
+  /**
+   * Get the number of attributes dropped because of the span limits
+   * @return the number of dropped attributes
+   */
+  uint32_t GetDroppedAttributesCount() const noexcept { return dropped_attributes_count_; }
+
+  /**
+   * Get the number of events dropped because of the span limits
+   * @return the number of dropped events
+   */
+  uint32_t GetDroppedEventsCount() const noexcept { return dropped_events_count_; }
+
+  /**
+   * Get the number of links dropped because of the span limits
+   * @return the number of dropped links
+   */
+  uint32_t GetDroppedLinksCount() const noexcept { return dropped_links_count_; }
 
   void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
                    opentelemetry::trace::SpanId parent_span_id) noexcept override
@@ -238,27 +274,25 @@ class SpanData final : public Recordable
                     opentelemetry::common::KeyValueIterableView<std::map<std::string, int>>(
                         {})) noexcept override
   {
-    SpanDataEvent event(std::string(name), timestamp, attributes);
-    events_.push_back(event);
+    events_.emplace_back(std::string(name), timestamp, attributes);
   }
 
   void AddLink(const opentelemetry::trace::SpanContext &span_context,
                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
   {
-    SpanDataLink link(span_context, attributes);
-    links_.push_back(link);
+    links_.emplace_back(span_context, attributes);
   }
 
   void SetStatus(opentelemetry::trace::StatusCode code,
                  nostd::string_view description) noexcept override
   {
     status_code_ = code;
-    status_desc_ = std::string(description);
+    status_desc_.assign(description.data(), description.size());
   }
 
   void SetName(nostd::string_view name) noexcept override
   {
-    name_ = std::string(name.data(), name.length());
+    name_.assign(name.data(), name.length());
   }
 
   void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
@@ -284,7 +318,218 @@ class SpanData final : public Recordable
     instrumentation_library_ = &instrumentation_library;
   }
 
+  void Reserve(size_t attributes, size_t events) noexcept override
+  {
+    attribute_map_.reserve(attributes);
+    events_.reserve(events);
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    dropped_attributes_count_ = attributes;
+    dropped_events_count_     = events;
+    dropped_links_count_      = links;
+  }
+
+  size_t GetEstimatedSize() const noexcept override
+  {
+    // The ids, timestamps, kind, status code and framing of the span.
+    size_t size = 64 + name_.size() + status_desc_.size() +
+                  common::EstimateAttributesSize(attribute_map_);
+    for (auto &event : events_)
+    {
+      size += event.GetEstimatedSize();
+    }
+    for (auto &link : links_)
+    {
+      size += link.GetEstimatedSize();
+    }
+    return size;
+  }
+
+  RecordableGroupingKey GetGroupingKey() const noexcept override
+  {
+    RecordableGroupingKey key;
+    key.resource                = resource_;
+    key.instrumentation_library = instrumentation_library_;
+    key.trace_id                = span_context_.trace_id();
+    return key;
+  }
+
+  common::JournalRecordType AppendJournalRecord(std::string &out) const noexcept override
+  {
+    AppendBinary(out);
+    return common::JournalRecordType::kSpan;
+  }
+
+  /**
+   * Appends the span, without its resource and instrumentation library, in the binary encoding of
+   * common/binary_encoding.h: its trace id, span id, uint8_t trace flags, parent span id, uint8_t
+   * kind and status code, its name and status description, int64_t start time since the epoch and
+   * duration in nanoseconds, uint32_t dropped attributes, events and links counts, its attributes,
+   * then a uint32_t count of events (name, int64_t timestamp, attributes) and of links (trace id,
+   * span id, uint8_t trace flags, attributes). The trace states are not kept.
+   */
+  void AppendBinary(std::string &out) const
+  {
+    AppendSpanContext(out, span_context_);
+    common::AppendBinaryBytes(out, parent_span_id_.Id().data(),
+                              opentelemetry::trace::SpanId::kSize);
+    common::AppendBinary(out, static_cast<uint8_t>(span_kind_));
+    common::AppendBinary(out, static_cast<uint8_t>(status_code_));
+    common::AppendBinaryString(out, name_);
+    common::AppendBinaryString(out, status_desc_);
+    common::AppendBinary(out, static_cast<int64_t>(start_time_.time_since_epoch().count()));
+    common::AppendBinary(out, static_cast<int64_t>(duration_.count()));
+    common::AppendBinary(out, dropped_attributes_count_);
+    common::AppendBinary(out, dropped_events_count_);
+    common::AppendBinary(out, dropped_links_count_);
+    common::AppendBinaryAttributes(out, attribute_map_);
+    common::AppendBinary(out, static_cast<uint32_t>(events_.size()));
+    for (const auto &event : events_)
+    {
+      common::AppendBinaryString(out, event.GetName());
+      common::AppendBinary(out,
+                           static_cast<int64_t>(event.GetTimestamp().time_since_epoch().count()));
+      common::AppendBinaryAttributes(out, event.GetAttributes());
+    }
+    common::AppendBinary(out, static_cast<uint32_t>(links_.size()));
+    for (const auto &link : links_)
+    {
+      AppendSpanContext(out, link.GetSpanContext());
+      common::AppendBinaryAttributes(out, link.GetAttributes());
+    }
+  }
+
+  /**
+   * Records a span appended by AppendBinary, leaving the resource and instrumentation library
+   * as they are.
+   * @return false if the encoding is truncated or invalid
+   */
+  bool ReadBinary(common::BinaryDecoder &in)
+  {
+    uint8_t parent_span_id[opentelemetry::trace::SpanId::kSize];
+    uint8_t kind   = 0;
+    uint8_t status = 0;
+    int64_t start    = 0;
+    int64_t duration = 0;
+    if (!GetSpanContext(in, span_context_) ||
+        !in.GetBytes(parent_span_id, sizeof(parent_span_id)) || !in.GetValue(kind) ||
+        !in.GetValue(status) || !in.GetString(name_) ||
+        !in.GetString(status_desc_) || !in.GetValue(start) || !in.GetValue(duration) ||
+        !in.GetValue(dropped_attributes_count_) || !in.GetValue(dropped_events_count_) ||
+        !in.GetValue(dropped_links_count_))
+    {
+      return false;
+    }
+    parent_span_id_ = opentelemetry::trace::SpanId(parent_span_id);
+    span_kind_      = static_cast<opentelemetry::trace::SpanKind>(kind);
+    status_code_    = static_cast<opentelemetry::trace::StatusCode>(status);
+    start_time_     = opentelemetry::common::SystemTimestamp(std::chrono::nanoseconds(start));
+    duration_       = std::chrono::nanoseconds(duration);
+    if (!in.GetAttributes([&](std::string &&key, common::OwnedAttributeValue &&value) {
+          common::ViewAttributeValue(
+              value, [&](const opentelemetry::common::AttributeValue &view) {
+                attribute_map_.SetAttribute(key, view);
+              });
+        }))
+    {
+      return false;
+    }
+
+    uint32_t count = 0;
+    if (!in.GetValue(count))
+    {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      std::string event_name;
+      int64_t timestamp = 0;
+      common::FlatAttributeMap attributes;
+      if (!in.GetString(event_name) || !in.GetValue(timestamp) ||
+          !GetFlatAttributes(in, attributes))
+      {
+        return false;
+      }
+      events_.emplace_back(
+          std::move(event_name),
+          opentelemetry::common::SystemTimestamp(std::chrono::nanoseconds(timestamp)),
+          common::OwnedAttributesIterable<common::FlatAttributeMap>(attributes));
+    }
+
+    if (!in.GetValue(count))
+    {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      opentelemetry::trace::SpanContext link_context(false, false);
+      common::FlatAttributeMap attributes;
+      if (!GetSpanContext(in, link_context) || !GetFlatAttributes(in, attributes))
+      {
+        return false;
+      }
+      links_.emplace_back(link_context,
+                          common::OwnedAttributesIterable<common::FlatAttributeMap>(attributes));
+    }
+    return true;
+  }
+
+  bool Reset() noexcept override
+  {
+    span_context_   = opentelemetry::trace::SpanContext(false, false);
+    parent_span_id_ = opentelemetry::trace::SpanId();
+    start_time_     = opentelemetry::common::SystemTimestamp();
+    duration_       = std::chrono::nanoseconds(0);
+    name_.clear();
+    status_code_ = opentelemetry::trace::StatusCode::kUnset;
+    status_desc_.clear();
+    attribute_map_.clear();
+    events_.clear();
+    links_.clear();
+    dropped_attributes_count_ = 0;
+    dropped_events_count_     = 0;
+    dropped_links_count_      = 0;
+    span_kind_                = opentelemetry::trace::SpanKind::kInternal;
+    resource_                 = nullptr;
+    instrumentation_library_  = nullptr;
+    return true;
+  }
+
 private:
+  static void AppendSpanContext(std::string &out, const opentelemetry::trace::SpanContext &context)
+  {
+    common::AppendBinaryBytes(out, context.trace_id().Id().data(),
+                              opentelemetry::trace::TraceId::kSize);
+    common::AppendBinaryBytes(out, context.span_id().Id().data(),
+                              opentelemetry::trace::SpanId::kSize);
+    common::AppendBinary(out, context.trace_flags().flags());
+  }
+
+  static bool GetSpanContext(common::BinaryDecoder &in, opentelemetry::trace::SpanContext &context)
+  {
+    uint8_t trace_id[opentelemetry::trace::TraceId::kSize];
+    uint8_t span_id[opentelemetry::trace::SpanId::kSize];
+    uint8_t flags = 0;
+    if (!in.GetBytes(trace_id, sizeof(trace_id)) || !in.GetBytes(span_id, sizeof(span_id)) ||
+        !in.GetValue(flags))
+    {
+      return false;
+    }
+    context = opentelemetry::trace::SpanContext(
+        opentelemetry::trace::TraceId(trace_id), opentelemetry::trace::SpanId(span_id),
+        opentelemetry::trace::TraceFlags(flags), false);
+    return true;
+  }
+
+  static bool GetFlatAttributes(common::BinaryDecoder &in, common::FlatAttributeMap &attributes)
+  {
+    return in.GetAttributes([&](std::string &&key, common::OwnedAttributeValue &&value) {
+      attributes.emplace_back(std::move(key), std::move(value));
+    });
+  }
+
   opentelemetry::trace::SpanContext span_context_{false, false};
   opentelemetry::trace::SpanId parent_span_id_;
   opentelemetry::common::SystemTimestamp start_time_;
@@ -292,9 +537,12 @@ class SpanData final : public Recordable
   std::string name_;
   opentelemetry::trace::StatusCode status_code_{opentelemetry::trace::StatusCode::kUnset};
   std::string status_desc_;
-  common::AttributeMap attribute_map_;
-  std::vector<SpanDataEvent> events_;
-  std::vector<SpanDataLink> links_;
+  common::SpanAttributeMap attribute_map_;
+  SpanDataEvents events_;
+  SpanDataLinks links_;
+  uint32_t dropped_attributes_count_ = 0;
+  uint32_t dropped_events_count_     = 0;
+  uint32_t dropped_links_count_      = 0;
   opentelemetry::trace::SpanKind span_kind_{opentelemetry::trace::SpanKind::kInternal};
   const opentelemetry::sdk::resource::Resource *resource_;
   const InstrumentationLibrary *instrumentation_library_;
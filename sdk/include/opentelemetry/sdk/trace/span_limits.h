@@ -0,0 +1,56 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * Limits on the data recorded by a span, enforced by the span before anything
+ * is handed to its recordable. They bound the memory taken by each span, and so
+ * the memory of the queues which buffer ended spans.
+ *
+ * Attributes, events and links beyond the limits are dropped, and the span
+ * reports how many it dropped with Recordable::SetDroppedCounts. Attribute
+ * values longer than max_attribute_value_length are truncated: string values to
+ * that many bytes, and string arrays element by element.
+ *
+ * The defaults are those of the OpenTelemetry specification.
+ */
+struct SpanLimits
+{
+  /**
+   * The maximum number of distinct attribute keys of a span. Setting an
+   * attribute which the span already has does not count against the limit.
+   */
+  size_t max_attributes = 128;
+
+  /**
+   * The maximum length in bytes of string attribute values, of the span as well
+   * as of its events and links.
+   */
+  size_t max_attribute_value_length = (std::numeric_limits<size_t>::max)();
+
+  /* The maximum number of events of a span. */
+  size_t max_events = 128;
+
+  /* The maximum number of links of a span. */
+  size_t max_links = 128;
+
+  /* The maximum number of attributes of an event. */
+  size_t max_attributes_per_event = 128;
+
+  /* The maximum number of attributes of a link. */
+  size_t max_attributes_per_link = 128;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
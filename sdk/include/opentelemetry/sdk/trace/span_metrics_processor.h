@@ -0,0 +1,151 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef ENABLE_METRICS_PREVIEW
+
+#  include "opentelemetry/metrics/meter.h"
+#  include "opentelemetry/nostd/shared_ptr.h"
+#  include "opentelemetry/sdk/common/attribute_utils.h"
+#  include "opentelemetry/sdk/common/shared_spin_lock_mutex.h"
+#  include "opentelemetry/sdk/trace/processor.h"
+#  include "opentelemetry/trace/span_metadata.h"
+
+#  include <atomic>
+#  include <memory>
+#  include <string>
+#  include <unordered_map>
+#  include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/**
+ * Struct to hold span metrics SpanProcessor options.
+ */
+struct SpanMetricsProcessorOptions
+{
+  /* The prefix of the names of the instruments, followed by ".calls" and ".duration". */
+  std::string name_prefix = "traces.span.metrics";
+
+  /**
+   * The keys of the span attributes added as attributes of the metrics, next to the span name,
+   * kind and status code. Only scalar values are kept: spans setting an array for one of these
+   * keys are recorded as if they did not set it.
+   */
+  std::vector<std::string> dimension_keys;
+
+  /**
+   * The maximum number of series the processor keeps bound instruments for. Once it is reached,
+   * spans of new series are recorded through the unbound instruments, which resolve their
+   * attributes at each call and are capped by the cardinality limit of the meter's views.
+   */
+  size_t max_series = 1000;
+};
+
+/**
+ * Counters of a SpanMetricsProcessor, see SpanMetricsProcessor::GetStats.
+ */
+struct SpanMetricsProcessorStats
+{
+  /* Series with bound instruments. */
+  size_t series = 0;
+
+  /* Spans recorded through the unbound instruments because max_series was reached. */
+  uint64_t unbound_spans = 0;
+};
+
+/**
+ * This is an implementation of the SpanProcessor which derives request rate, error and duration
+ * (RED) metrics from the spans as they end, so that they stay accurate however few traces are
+ * exported. For each ended span it records, attributed with "span.name", "span.kind",
+ * "status.code" and the configured dimensions:
+ * - one to the `<name_prefix>.calls` counter,
+ * - the duration of the span in milliseconds to the `<name_prefix>.duration` histogram.
+ *
+ * It exports nothing itself: add it to the tracer provider next to the processor exporting the
+ * spans. Its recordables only keep what the metrics need, and it records through instruments
+ * bound to each series, so that a span costs one shared lookup. It only sees the spans recorded:
+ * pair it with a sampler which records every span, and drop the spans at export, e.g. with a
+ * TailSamplingProcessor, rather than with a sampler which drops them at start.
+ */
+class SpanMetricsProcessor : public SpanProcessor
+{
+public:
+  /**
+   * @param meter - The meter to create the instruments with. It must outlive the processor.
+   * @param options - The span metrics SpanProcessor options.
+   */
+  SpanMetricsProcessor(nostd::shared_ptr<opentelemetry::metrics::Meter> meter,
+                       const SpanMetricsProcessorOptions &options);
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  void OnStart(Recordable &span,
+               const opentelemetry::trace::SpanContext &parent_context) noexcept override;
+
+  /**
+   * Records the ended span to the metrics of its series.
+   */
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
+
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Returns a snapshot of the processor's counters. Safe to call from any thread.
+   */
+  SpanMetricsProcessorStats GetStats() const noexcept;
+
+  /* The span attributes one series of metrics is recorded for. */
+  struct SeriesKey
+  {
+    struct Dimension
+    {
+      bool present = false;
+      opentelemetry::sdk::common::OwnedAttributeValue value;
+    };
+
+    std::string name;
+    opentelemetry::trace::SpanKind kind     = opentelemetry::trace::SpanKind::kInternal;
+    opentelemetry::trace::StatusCode status = opentelemetry::trace::StatusCode::kUnset;
+    /* The values of the dimension keys, in their order. */
+    std::vector<Dimension> dimensions;
+
+    bool operator==(const SeriesKey &other) const noexcept;
+  };
+
+private:
+  struct SeriesKeyHash
+  {
+    size_t operator()(const SeriesKey &key) const noexcept;
+  };
+
+  struct Series
+  {
+    nostd::shared_ptr<opentelemetry::metrics::BoundCounter<long>> calls;
+    nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<double>> duration;
+  };
+
+  void Record(const SeriesKey &key, std::chrono::nanoseconds duration) noexcept;
+
+  const std::vector<std::string> dimension_keys_;
+  const size_t max_series_;
+  nostd::shared_ptr<opentelemetry::metrics::Counter<long>> calls_;
+  nostd::shared_ptr<opentelemetry::metrics::Histogram<double>> duration_;
+
+  mutable opentelemetry::sdk::common::SharedSpinLockMutex lock_;
+  std::unordered_map<SeriesKey, Series, SeriesKeyHash> series_;
+  std::atomic<uint64_t> unbound_spans_{0};
+  std::atomic<bool> is_shutdown_{false};
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
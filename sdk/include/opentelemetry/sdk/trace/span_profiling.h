@@ -0,0 +1,50 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/** Returns the number of allocations the calling thread made so far. */
+using AllocationCounter = uint64_t (*)();
+
+/** The attribute of the CPU time, in nanoseconds, the thread of a span spent in it. */
+constexpr char kSpanThreadCpuTimeKey[] = "thread.cpu_time_ns";
+
+/** The attribute of the number of allocations the thread of a span made in it. */
+constexpr char kSpanThreadAllocationsKey[] = "thread.allocations";
+
+/**
+ * Options recording what the thread of each span spent between its start and its end, as
+ * attributes of the span. Both cost a read at the start and at the end of each span when
+ * enabled, and nothing when disabled. Spans ended on another thread than the one they started
+ * on record neither.
+ */
+struct SpanProfilingOptions
+{
+  // Records the CPU time of the thread as kSpanThreadCpuTimeKey, where the platform has a
+  // thread CPU clock.
+  bool record_cpu_time = false;
+
+  // Records the allocations counted by this hook as kSpanThreadAllocationsKey, e.g. from a
+  // malloc hook counting per thread. nullptr not to record allocations.
+  AllocationCounter allocation_counter = nullptr;
+};
+
+/**
+ * @return the CPU time the calling thread consumed so far, in nanoseconds, or -1 if the
+ * platform has no thread CPU clock.
+ */
+int64_t GetThreadCpuTimeNanos() noexcept;
+
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
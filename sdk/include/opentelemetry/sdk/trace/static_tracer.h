@@ -0,0 +1,231 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <initializer_list>
+#include <utility>
+
+#include "opentelemetry/common/attribute_value.h"
+#include "opentelemetry/common/key_value_iterable_view.h"
+#include "opentelemetry/context/runtime_context.h"
+#include "opentelemetry/nostd/shared_ptr.h"
+#include "opentelemetry/nostd/string_view.h"
+#include "opentelemetry/nostd/unique_ptr.h"
+#include "opentelemetry/sdk/trace/tracer.h"
+#include "opentelemetry/trace/span.h"
+#include "opentelemetry/trace/span_context_kv_iterable.h"
+#include "opentelemetry/trace/span_startoptions.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/**
+ * Compile-time tracing policies of a StaticTracer.
+ *
+ * StaticTracingDisabled compiles the instrumentation out: the spans are empty objects and every
+ * call on them is an empty inline function.
+ * StaticTracingSampledOnly only starts spans inside a sampled trace, the active span being
+ * sampled, and otherwise skips the tracer altogether. It never starts a trace.
+ * StaticTracingFull starts a span on every call, as the Tracer API does.
+ */
+struct StaticTracingDisabled
+{
+  static constexpr bool kEnabled     = false;
+  static constexpr bool kSampledOnly = false;
+};
+
+struct StaticTracingSampledOnly
+{
+  static constexpr bool kEnabled     = true;
+  static constexpr bool kSampledOnly = true;
+};
+
+struct StaticTracingFull
+{
+  static constexpr bool kEnabled     = true;
+  static constexpr bool kSampledOnly = false;
+};
+
+using StaticAttributes =
+    std::initializer_list<std::pair<nostd::string_view, opentelemetry::common::AttributeValue>>;
+
+/**
+ * Makes a StaticSpan the active span until it is destroyed, see StaticSpan::Activate().
+ */
+template <class Policy, bool Enabled = Policy::kEnabled>
+class StaticScope
+{
+public:
+  explicit StaticScope(nostd::unique_ptr<context::Token> token) noexcept
+      : token_(std::move(token))
+  {}
+
+private:
+  nostd::unique_ptr<context::Token> token_;
+};
+
+template <class Policy>
+class StaticScope<Policy, false>
+{};
+
+/**
+ * A span started by a StaticTracer, ended when it is destroyed. A span which is not recorded,
+ * because of the policy or the sampler, holds no span and ignores the calls made on it.
+ */
+template <class Policy, bool Enabled = Policy::kEnabled>
+class StaticSpan
+{
+public:
+  StaticSpan() noexcept = default;
+  explicit StaticSpan(nostd::shared_ptr<trace_api::Span> span) noexcept : span_(std::move(span))
+  {}
+  StaticSpan(StaticSpan &&) noexcept = default;
+  StaticSpan &operator=(StaticSpan &&) noexcept = default;
+
+  ~StaticSpan() { End(); }
+
+  bool IsRecording() const noexcept { return span_ != nullptr && span_->IsRecording(); }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept
+  {
+    if (span_ != nullptr)
+    {
+      span_->SetAttribute(key, value);
+    }
+  }
+
+  void AddEvent(nostd::string_view name) noexcept
+  {
+    if (span_ != nullptr)
+    {
+      span_->AddEvent(name);
+    }
+  }
+
+  void AddEvent(nostd::string_view name, StaticAttributes attributes) noexcept
+  {
+    if (span_ != nullptr)
+    {
+      span_->AddEvent(name, attributes);
+    }
+  }
+
+  void SetStatus(trace_api::StatusCode code, nostd::string_view description = "") noexcept
+  {
+    if (span_ != nullptr)
+    {
+      span_->SetStatus(code, description);
+    }
+  }
+
+  /**
+   * Makes the span the active one, so that the spans started in its scope are its children.
+   */
+  StaticScope<Policy> Activate() const noexcept
+  {
+    if (span_ == nullptr)
+    {
+      return StaticScope<Policy>(nullptr);
+    }
+    return StaticScope<Policy>(context::RuntimeContext::Attach(
+        context::RuntimeContext::GetCurrent().SetValue(trace_api::GetSpanContextKey(), span_)));
+  }
+
+  void End() noexcept
+  {
+    if (span_ != nullptr)
+    {
+      span_->End();
+      span_ = nullptr;
+    }
+  }
+
+  /** Returns the span, nullptr if it is not recorded. */
+  const nostd::shared_ptr<trace_api::Span> &GetSpan() const noexcept { return span_; }
+
+private:
+  nostd::shared_ptr<trace_api::Span> span_;
+};
+
+template <class Policy>
+class StaticSpan<Policy, false>
+{
+public:
+  bool IsRecording() const noexcept { return false; }
+  void SetAttribute(nostd::string_view, const opentelemetry::common::AttributeValue &) noexcept {}
+  void AddEvent(nostd::string_view) noexcept {}
+  void AddEvent(nostd::string_view, StaticAttributes) noexcept {}
+  void SetStatus(trace_api::StatusCode, nostd::string_view = "") noexcept {}
+  StaticScope<Policy> Activate() const noexcept { return StaticScope<Policy>(); }
+  void End() noexcept {}
+};
+
+/**
+ * A header-only tracing facade over the SDK Tracer, for instrumentation whose cost is decided at
+ * compile time by a policy: library code templated on the policy, or using a StaticTracer alias
+ * selected by a build flag, is compiled out entirely with StaticTracingDisabled.
+ *
+ * As the SDK Tracer is final, StartSpan() calls it directly rather than through the virtual
+ * trace_api::Tracer, and the tests of the policy are resolved by the compiler. StaticTracer
+ * coexists with the Tracer API, which keeps its stable ABI: both start spans of the same tracer.
+ */
+template <class Policy, bool Enabled = Policy::kEnabled>
+class StaticTracer
+{
+public:
+  /**
+   * @param tracer the SDK tracer the spans are started from. It must outlive the StaticTracer.
+   */
+  explicit StaticTracer(Tracer &tracer) noexcept : tracer_(&tracer) {}
+
+  StaticSpan<Policy> StartSpan(nostd::string_view name,
+                               const trace_api::StartSpanOptions &options = {}) noexcept
+  {
+    return StartSpan(name, {}, options);
+  }
+
+  StaticSpan<Policy> StartSpan(nostd::string_view name,
+                               StaticAttributes attributes,
+                               const trace_api::StartSpanOptions &options = {}) noexcept
+  {
+    if (Policy::kSampledOnly && !context::RuntimeContext::GetActiveTraceFlags().IsSampled())
+    {
+      return StaticSpan<Policy>();
+    }
+    return StaticSpan<Policy>(tracer_->StartSpan(
+        name, opentelemetry::common::KeyValueIterableView<StaticAttributes>(attributes),
+        trace_api::NullSpanContext(), options));
+  }
+
+private:
+  Tracer *tracer_;
+};
+
+template <class Policy>
+class StaticTracer<Policy, false>
+{
+public:
+  explicit StaticTracer(Tracer &) noexcept {}
+
+  StaticSpan<Policy> StartSpan(nostd::string_view,
+                               const trace_api::StartSpanOptions & = {}) noexcept
+  {
+    return StaticSpan<Policy>();
+  }
+
+  StaticSpan<Policy> StartSpan(nostd::string_view,
+                               StaticAttributes,
+                               const trace_api::StartSpanOptions & = {}) noexcept
+  {
+    return StaticSpan<Policy>();
+  }
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
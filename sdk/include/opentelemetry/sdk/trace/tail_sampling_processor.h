@@ -0,0 +1,178 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/important_span_recordable.h"
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/trace/trace_id.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+/**
+ * Struct to hold tail sampling SpanProcessor options.
+ */
+struct TailSamplingProcessorOptions
+{
+  /**
+   * The ratio of the traces kept when none of their spans is an error, is slow or sets one of the
+   * keep_attribute_keys. The decision is taken from the trace id, like TraceIdRatioBasedSampler.
+   */
+  double sampling_ratio = 0.01;
+
+  /* Traces with a span ended with StatusCode::kError are kept. */
+  bool keep_errors = true;
+
+  /* Traces with a span lasting at least this long are kept. */
+  std::chrono::nanoseconds latency_threshold = std::chrono::seconds(1);
+
+  /* Traces with a span setting an attribute with one of these keys are kept. */
+  std::vector<std::string> keep_attribute_keys;
+
+  /**
+   * The maximum number of spans buffered while waiting for the local roots of their traces to
+   * end. Once it is reached, the oldest trace of the bucket of the next ended span is decided
+   * early, with what is known of it at that time.
+   */
+  size_t max_buffered_spans = 8192;
+
+  /**
+   * The number of buckets the pending traces are spread across. Each bucket has its own lock, so
+   * that spans of different traces ending concurrently rarely contend.
+   */
+  size_t num_buckets = 16;
+};
+
+/**
+ * Counters of a TailSamplingProcessor, see TailSamplingProcessor::GetStats.
+ */
+struct TailSamplingProcessorStats
+{
+  /* Spans currently buffered, waiting for the local roots of their traces to end. */
+  size_t buffered_spans = 0;
+
+  /* Traces whose spans were forwarded to the wrapped processor. */
+  uint64_t kept_traces = 0;
+
+  /* Traces whose spans were dropped. */
+  uint64_t dropped_traces = 0;
+
+  /* Traces decided before their local root ended, because max_buffered_spans was reached. */
+  uint64_t evicted_traces = 0;
+};
+
+/**
+ * This is an implementation of the SpanProcessor which decides whether to keep a trace once all
+ * of its local spans have ended, rather than when it starts.
+ *
+ * Ended spans are buffered per trace id until the local root of their trace, the span started
+ * without a parent or with a remote one, ends. The spans of the trace are then forwarded to the
+ * wrapped processor, typically a BatchSpanProcessor, if any of them is an error, is slow or sets
+ * one of the configured attributes, or if the trace id is sampled by the configured ratio; and
+ * dropped otherwise.
+ *
+ * Spans should be created with a sampler recording all of them, such as AlwaysOnSampler.
+ */
+class TailSamplingProcessor : public SpanProcessor
+{
+public:
+  /**
+   * @param processor - The processor to forward the spans of the kept traces to.
+   * @param options - The tail sampling SpanProcessor options.
+   */
+  TailSamplingProcessor(std::unique_ptr<SpanProcessor> &&processor,
+                        const TailSamplingProcessorOptions &options);
+
+  /**
+   * Requests a Recordable(Span) from the wrapped processor, and wraps it to observe the status,
+   * duration and attributes of the span.
+   */
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override;
+
+  void OnStart(Recordable &span,
+               const opentelemetry::trace::SpanContext &parent_context) noexcept override;
+
+  /**
+   * Buffers the ended span, or decides whether to keep its trace if it is a local root.
+   */
+  void OnEnd(std::unique_ptr<Recordable> &&span) noexcept override;
+
+  /**
+   * Flushes the wrapped processor. Traces whose local root has not ended stay buffered.
+   */
+  bool ForceFlush(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Decides all the buffered traces with what is known of them, then shuts down the wrapped
+   * processor.
+   */
+  bool Shutdown(
+      std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept override;
+
+  /**
+   * Returns a snapshot of the processor's counters. Safe to call from any thread.
+   */
+  TailSamplingProcessorStats GetStats() const noexcept;
+
+  ~TailSamplingProcessor();
+
+private:
+  struct TraceIdHash
+  {
+    size_t operator()(const opentelemetry::trace::TraceId &trace_id) const noexcept;
+  };
+
+  /* The ended spans of a trace whose local root has not ended yet. */
+  struct PendingTrace
+  {
+    std::vector<std::unique_ptr<Recordable>> spans;
+    bool keep = false;
+    std::chrono::steady_clock::time_point first_end;
+  };
+
+  struct Bucket
+  {
+    std::mutex lock;
+    std::unordered_map<opentelemetry::trace::TraceId, PendingTrace, TraceIdHash> traces;
+  };
+
+  /**
+   * Whether a trace with the given id and flag is kept.
+   */
+  bool ShouldKeep(const opentelemetry::trace::TraceId &trace_id, bool keep) const noexcept;
+
+  /**
+   * Forwards the spans to the wrapped processor if keep is true, and drops them otherwise.
+   */
+  void Decide(std::vector<std::unique_ptr<Recordable>> &&spans, bool keep) noexcept;
+
+  std::unique_ptr<SpanProcessor> processor_;
+  const uint64_t threshold_;
+  const ImportantSpanRules keep_rules_;
+  const size_t max_buffered_spans_;
+  const size_t num_buckets_;
+  std::unique_ptr<Bucket[]> buckets_;
+
+  std::atomic<size_t> buffered_spans_{0};
+  std::atomic<uint64_t> kept_traces_{0};
+  std::atomic<uint64_t> dropped_traces_{0};
+  std::atomic<uint64_t> evicted_traces_{0};
+  std::atomic_flag shutdown_latch_ = ATOMIC_FLAG_INIT;
+  std::atomic<bool> is_shutdown_{false};
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
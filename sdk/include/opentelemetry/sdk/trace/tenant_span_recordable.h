@@ -0,0 +1,206 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "opentelemetry/nostd/variant.h"
+#include "opentelemetry/sdk/common/attribute_utils.h"
+#include "opentelemetry/sdk/trace/arena_span_data.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace detail
+{
+/* Writes the tenant an attribute value stands for: strings, integers and booleans. */
+struct TenantWriter
+{
+  std::string &tenant;
+
+  bool operator()(bool value) const
+  {
+    tenant = value ? "true" : "false";
+    return true;
+  }
+  bool operator()(int32_t value) const { return Write(std::to_string(value)); }
+  bool operator()(int64_t value) const { return Write(std::to_string(value)); }
+  bool operator()(uint32_t value) const { return Write(std::to_string(value)); }
+  bool operator()(uint64_t value) const { return Write(std::to_string(value)); }
+  bool operator()(const char *value) const { return Write(value); }
+  bool operator()(nostd::string_view value) const
+  {
+    tenant.assign(value.data(), value.size());
+    return true;
+  }
+
+  template <class T>
+  bool operator()(const T &) const
+  {
+    return false;
+  }
+
+  bool Write(std::string value) const
+  {
+    tenant = std::move(value);
+    return true;
+  }
+};
+}  // namespace detail
+
+/**
+ * How the batch processor finds the tenant of a span for fair queuing, see
+ * BatchSpanProcessorOptions::fair_queuing: the value of the span attribute `key`, or else of the
+ * resource attribute `key`, or else the empty tenant. Only strings, integers and booleans name a
+ * tenant.
+ */
+struct TenantKey
+{
+  std::string key;
+
+  bool GetTenant(const opentelemetry::common::AttributeValue &value,
+                 std::string &tenant) const noexcept
+  {
+    return nostd::visit(detail::TenantWriter{tenant}, value);
+  }
+
+  void GetResourceTenant(const opentelemetry::sdk::resource::Resource &resource,
+                         std::string &tenant) const noexcept
+  {
+    const auto &attributes = resource.GetAttributes();
+    auto it                = attributes.find(key);
+    if (it != attributes.end())
+    {
+      common::ViewAttributeValue(
+          it->second,
+          [&](const opentelemetry::common::AttributeValue &value) { GetTenant(value, tenant); });
+    }
+  }
+
+  /**
+   * Returns the tenant of a span recorded once for several processors, see SharedRecordable.
+   */
+  std::string GetTenant(const ArenaSpanData &span) const noexcept
+  {
+    std::string tenant;
+    bool found = !span.GetAttributes().ForEachKeyValue(
+        [&](nostd::string_view attribute_key, opentelemetry::common::AttributeValue value) {
+          return attribute_key != key || !GetTenant(value, tenant);
+        });
+    if (!found && span.GetResource() != nullptr)
+    {
+      GetResourceTenant(*span.GetResource(), tenant);
+    }
+    return tenant;
+  }
+};
+
+/**
+ * Forwards to the recordable of a processor, and records the tenant of the span according to the
+ * given key, which must outlive it.
+ */
+class TenantSpanRecordable : public Recordable
+{
+public:
+  TenantSpanRecordable(std::unique_ptr<Recordable> &&recordable, const TenantKey &key) noexcept
+      : recordable_(std::move(recordable)), key_(key)
+  {}
+
+  std::unique_ptr<Recordable> ReleaseRecordable() noexcept { return std::move(recordable_); }
+
+  std::string &GetTenant() noexcept { return tenant_; }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext &span_context,
+                   opentelemetry::trace::SpanId parent_span_id) noexcept override
+  {
+    recordable_->SetIdentity(span_context, parent_span_id);
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    if (key == key_.key && key_.GetTenant(value, tenant_))
+    {
+      from_span_ = true;
+    }
+    recordable_->SetAttribute(key, value);
+  }
+
+  void AddEvent(nostd::string_view name,
+                opentelemetry::common::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    recordable_->AddEvent(name, timestamp, attributes);
+  }
+
+  void AddLink(const opentelemetry::trace::SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    recordable_->AddLink(span_context, attributes);
+  }
+
+  void SetStatus(opentelemetry::trace::StatusCode code,
+                 nostd::string_view description) noexcept override
+  {
+    recordable_->SetStatus(code, description);
+  }
+
+  void SetName(nostd::string_view name) noexcept override { recordable_->SetName(name); }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    recordable_->SetSpanKind(span_kind);
+  }
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept override
+  {
+    if (!from_span_)
+    {
+      key_.GetResourceTenant(resource, tenant_);
+    }
+    recordable_->SetResource(resource);
+  }
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp start_time) noexcept override
+  {
+    recordable_->SetStartTime(start_time);
+  }
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override
+  {
+    recordable_->SetDuration(duration);
+  }
+
+  void SetInstrumentationLibrary(
+      const InstrumentationLibrary &instrumentation_library) noexcept override
+  {
+    recordable_->SetInstrumentationLibrary(instrumentation_library);
+  }
+
+  void Reserve(size_t attributes, size_t events) noexcept override
+  {
+    recordable_->Reserve(attributes, events);
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    recordable_->SetDroppedCounts(attributes, events, links);
+  }
+
+private:
+  std::unique_ptr<Recordable> recordable_;
+  const TenantKey &key_;
+  std::string tenant_;
+  // Whether tenant_ comes from a span attribute, which takes precedence over the resource.
+  bool from_span_ = false;
+};
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -44,9 +44,30 @@ class Tracer final : public trace_api::Tracer, public std::enable_shared_from_th
   /** Returns the configured span processor. */
   SpanProcessor &GetProcessor() noexcept { return context_->GetProcessor(); }
 
+  /** Returns the processor for a span being started, see TracerContext::AcquireProcessor. */
+  TracerContext::ProcessorEntry &AcquireProcessor() noexcept
+  {
+    return context_->AcquireProcessor();
+  }
+
+  /** Releases the processor of an ended span, see TracerContext::ReleaseProcessor. */
+  void ReleaseProcessor(TracerContext::ProcessorEntry &entry) noexcept
+  {
+    context_->ReleaseProcessor(entry);
+  }
+
   /** Returns the configured Id generator */
   IdGenerator &GetIdGenerator() const noexcept { return context_->GetIdGenerator(); }
 
+  /** Returns the limits on the data recorded by the spans of this tracer. */
+  const SpanLimits &GetSpanLimits() const noexcept { return context_->GetSpanLimits(); }
+
+  /** Returns the clock of the timestamps of the spans of this tracer. */
+  opentelemetry::sdk::common::Clock &GetClock() const noexcept { return context_->GetClock(); }
+
+  /** Returns what the spans of this tracer record of the work of their thread. */
+  SpanProfilingOptions GetSpanProfiling() const noexcept { return context_->GetSpanProfiling(); }
+
   /** Returns the associated instruementation library */
   const InstrumentationLibrary &GetInstrumentationLibrary() const noexcept
   {
@@ -4,12 +4,19 @@
 #pragma once
 
 #include "opentelemetry/sdk/common/atomic_unique_ptr.h"
+#include "opentelemetry/sdk/common/clock.h"
 #include "opentelemetry/sdk/resource/resource.h"
 #include "opentelemetry/sdk/trace/processor.h"
 #include "opentelemetry/sdk/trace/random_id_generator.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
+#include "opentelemetry/sdk/trace/span_limits.h"
+#include "opentelemetry/sdk/trace/span_profiling.h"
 #include "opentelemetry/version.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -28,6 +35,13 @@ namespace trace
  * if this object is alive, and they will work together. If this object is destroyed, then no shared
  * references to Processor, Exporter, Recordable, Custom Iterator etc. should exist, and all
  *   associated pipelines will have been flushed.
+ *
+ * The sampler and the processors can be replaced at runtime, e.g. to change the sampling rate or
+ * the exporter, and the tracers already handed out use the new ones for their next spans. Spans
+ * read the current sampler and processor through an atomic pointer, without a lock: a replacement
+ * waits for the threads reading the replaced ones, then destroys the replaced sampler. The spans
+ * started before a replacement end on the processor they started with, counted per processor,
+ * and the last of them flushes, shuts down and destroys the replaced processor.
  */
 class TracerContext
 {
@@ -38,7 +52,11 @@ class TracerContext
           opentelemetry::sdk::resource::Resource::Create({}),
       std::unique_ptr<Sampler> sampler = std::unique_ptr<AlwaysOnSampler>(new AlwaysOnSampler),
       std::unique_ptr<IdGenerator> id_generator =
-          std::unique_ptr<IdGenerator>(new RandomIdGenerator())) noexcept;
+          std::unique_ptr<IdGenerator>(new RandomIdGenerator()),
+      const SpanLimits &span_limits = SpanLimits(),
+      std::unique_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::unique_ptr<opentelemetry::sdk::common::Clock>(
+              new opentelemetry::sdk::common::PreciseClock())) noexcept;
 
   /**
    * Attaches a span processor to list of configured processors to this tracer context.
@@ -51,11 +69,66 @@ class TracerContext
   void AddProcessor(std::unique_ptr<SpanProcessor> processor) noexcept;
 
   /**
-   * Obtain the sampler associated with this tracer.
+   * Replaces the sampler, for the spans started from now on, and destroys the replaced one once
+   * the samplings in progress returned. Thread safe.
+   * @param sampler The new sampler. This must not be a nullptr.
+   */
+  void SetSampler(std::unique_ptr<Sampler> sampler) noexcept;
+
+  /**
+   * Replaces the processors by `processors`, for the spans started from now on. The spans in
+   * flight end on the replaced processors, which are flushed, shut down and destroyed once the
+   * last of them ended, by the thread ending it. Until then ForceFlush and Shutdown include them.
+   * Thread safe.
+   * @param processors The new span processors. Ownership is given to the `TracerContext`.
+   */
+  void SetProcessors(std::vector<std::unique_ptr<SpanProcessor>> &&processors) noexcept;
+
+  /**
+   * Obtain the sampler associated with this tracer. The sampler is destroyed once replaced, see
+   * SetSampler: samples with ShouldSample to use it while it may be replaced.
    * @return The sampler for this tracer.
    */
   Sampler &GetSampler() const noexcept;
 
+  /**
+   * Calls ShouldSample of the current sampler, which SetSampler does not destroy until it
+   * returned.
+   */
+  SamplingResult ShouldSample(
+      const opentelemetry::trace::SpanContext &parent_context,
+      opentelemetry::trace::TraceId trace_id,
+      nostd::string_view name,
+      opentelemetry::trace::SpanKind span_kind,
+      const opentelemetry::common::KeyValueIterable &attributes,
+      const opentelemetry::trace::SpanContextKeyValueIterable &links) noexcept;
+
+  /**
+   * A processor, with the number of spans started on it which did not end yet, plus one while it
+   * is the current processor.
+   */
+  struct ProcessorEntry
+  {
+    explicit ProcessorEntry(std::unique_ptr<SpanProcessor> &&span_processor) noexcept
+        : processor(std::move(span_processor))
+    {}
+
+    std::unique_ptr<SpanProcessor> processor;
+    std::atomic<size_t> active_spans{1};
+  };
+
+  /**
+   * Returns the current processor for a span being started, counted as used by the span until it
+   * is passed to ReleaseProcessor, even if the processors are replaced in the meantime.
+   */
+  ProcessorEntry &AcquireProcessor() noexcept;
+
+  /**
+   * Releases a processor returned by AcquireProcessor, once the span ended on it. Releasing the
+   * last span of a replaced processor flushes, shuts down and destroys it.
+   */
+  void ReleaseProcessor(ProcessorEntry &entry) noexcept;
+
   /**
    * Obtain the configured (composite) processor.
    *
@@ -77,22 +150,92 @@ class TracerContext
   opentelemetry::sdk::trace::IdGenerator &GetIdGenerator() const noexcept;
 
   /**
-   * Force all active SpanProcessors to flush any buffered spans
+   * Obtain the limits on the data recorded by the spans of this tracer context.
+   * @return The span limits for this tracer context.
+   */
+  const SpanLimits &GetSpanLimits() const noexcept;
+
+  /**
+   * Obtain the clock of the timestamps of spans and span events.
+   * @return The clock for this tracer context.
+   */
+  opentelemetry::sdk::common::Clock &GetClock() const noexcept;
+
+  /**
+   * Sets what the spans started from now on record of the work of their thread. Thread safe.
+   * @param options The profiling options, all disabled by default.
+   */
+  void SetSpanProfiling(const SpanProfilingOptions &options) noexcept;
+
+  /**
+   * Obtain the profiling options of the spans.
+   * @return The span profiling options for this tracer context.
+   */
+  SpanProfilingOptions GetSpanProfiling() const noexcept
+  {
+    SpanProfilingOptions options;
+    options.record_cpu_time    = record_cpu_time_.load(std::memory_order_relaxed);
+    options.allocation_counter = allocation_counter_.load(std::memory_order_relaxed);
+    return options;
+  }
+
+  /**
+   * Force all active SpanProcessors, including the replaced ones, to flush any buffered spans
    * within the given timeout.
    */
   bool ForceFlush(std::chrono::microseconds timeout = (std::chrono::microseconds::max)()) noexcept;
 
   /**
-   * Shutdown the span processor associated with this tracer provider.
+   * Shutdown the span processors associated with this tracer provider, including the replaced
+   * ones.
    */
   bool Shutdown() noexcept;
 
 private:
+  /**
+   * Marks the start of a read of the current sampler or processor.
+   * @return The epoch to pass to LeaveRead.
+   */
+  size_t EnterRead() noexcept;
+
+  /**
+   * Marks the end of a read started by EnterRead.
+   */
+  void LeaveRead(size_t epoch) noexcept;
+
+  /**
+   * Waits for the threads which may still read the sampler or the processor replaced before the
+   * call. Called with update_lock_ held.
+   */
+  void WaitForReaders() noexcept;
+
   //  order of declaration is important here - resource object should be destroyed after processor.
   opentelemetry::sdk::resource::Resource resource_;
-  std::unique_ptr<Sampler> sampler_;
   std::unique_ptr<IdGenerator> id_generator_;
-  std::unique_ptr<SpanProcessor> processor_;
+  SpanLimits span_limits_;
+  std::unique_ptr<opentelemetry::sdk::common::Clock> clock_;
+
+  /* The span profiling options, read on every span start */
+  std::atomic<bool> record_cpu_time_{false};
+  std::atomic<AllocationCounter> allocation_counter_{nullptr};
+
+  /* The current sampler and processor, read without a lock */
+  std::atomic<Sampler *> sampler_;
+  std::atomic<ProcessorEntry *> processor_;
+
+  /* The threads reading the current sampler or processor, by the parity of the epoch they
+   * entered in, see WaitForReaders */
+  std::atomic<size_t> epoch_{0};
+  std::atomic<size_t> readers_[2]{{0}, {0}};
+
+  /* Guards the replacements, and the members below */
+  std::mutex update_lock_;
+
+  /* The current sampler */
+  std::unique_ptr<Sampler> owned_sampler_;
+
+  /* The current processor, and the replaced ones with spans in flight */
+  std::vector<std::unique_ptr<ProcessorEntry>> processors_;
 };
 
 }  // namespace trace
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "opentelemetry/nostd/shared_ptr.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library_map.h"
 #include "opentelemetry/sdk/resource/resource.h"
 #include "opentelemetry/sdk/trace/processor.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
@@ -34,6 +35,9 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
    * not be a nullptr.
    * @param id_generator The custom id generator for this tracer provider. This must
    * not be a nullptr
+   * @param span_limits The limits on the data recorded by spans.
+   * @param clock The clock of the timestamps of spans, e.g. a CoarseClock where reading the
+   * precise clocks is slow. This must not be a nullptr.
    */
   explicit TracerProvider(
       std::unique_ptr<SpanProcessor> processor,
@@ -42,7 +46,11 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
       std::unique_ptr<Sampler> sampler = std::unique_ptr<AlwaysOnSampler>(new AlwaysOnSampler),
       std::unique_ptr<opentelemetry::sdk::trace::IdGenerator> id_generator =
           std::unique_ptr<opentelemetry::sdk::trace::IdGenerator>(
-              new RandomIdGenerator())) noexcept;
+              new RandomIdGenerator()),
+      const SpanLimits &span_limits = SpanLimits(),
+      std::unique_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::unique_ptr<opentelemetry::sdk::common::Clock>(
+              new opentelemetry::sdk::common::PreciseClock())) noexcept;
 
   explicit TracerProvider(
       std::vector<std::unique_ptr<SpanProcessor>> &&processors,
@@ -51,7 +59,11 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
       std::unique_ptr<Sampler> sampler = std::unique_ptr<AlwaysOnSampler>(new AlwaysOnSampler),
       std::unique_ptr<opentelemetry::sdk::trace::IdGenerator> id_generator =
           std::unique_ptr<opentelemetry::sdk::trace::IdGenerator>(
-              new RandomIdGenerator())) noexcept;
+              new RandomIdGenerator()),
+      const SpanLimits &span_limits = SpanLimits(),
+      std::unique_ptr<opentelemetry::sdk::common::Clock> clock =
+          std::unique_ptr<opentelemetry::sdk::common::Clock>(
+              new opentelemetry::sdk::common::PreciseClock())) noexcept;
 
   /**
    * Initialize a new tracer provider with a specified context
@@ -76,6 +88,24 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
    */
   void AddProcessor(std::unique_ptr<SpanProcessor> processor) noexcept;
 
+  /**
+   * Replaces the sampler of the tracers of this tracer provider, for their spans started from now
+   * on. See TracerContext::SetSampler.
+   */
+  void SetSampler(std::unique_ptr<Sampler> sampler) noexcept;
+
+  /**
+   * Replaces the span processors of this tracer provider, for the spans started from now on. The
+   * spans in flight end on the replaced processors. See TracerContext::SetProcessors.
+   */
+  void SetProcessors(std::vector<std::unique_ptr<SpanProcessor>> &&processors) noexcept;
+
+  /**
+   * Makes the spans started from now on record the CPU time and the allocations of their thread
+   * as attributes. See TracerContext::SetSpanProfiling.
+   */
+  void SetSpanProfiling(const SpanProfilingOptions &options) noexcept;
+
   /**
    * Obtain the resource associated with this tracer provider.
    * @return The resource for this tracer provider.
@@ -94,9 +124,8 @@ class TracerProvider final : public opentelemetry::trace::TracerProvider
 
 private:
   // order of declaration is important here - tracers should destroy only after context.
-  std::vector<std::shared_ptr<opentelemetry::sdk::trace::Tracer>> tracers_;
+  instrumentationlibrary::InstrumentationLibraryMap<opentelemetry::sdk::trace::Tracer> tracers_;
   std::shared_ptr<sdk::trace::TracerContext> context_;
-  std::mutex lock_;
 };
 }  // namespace trace
 }  // namespace sdk
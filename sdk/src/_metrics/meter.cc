@@ -6,6 +6,8 @@
 #  include "opentelemetry/sdk/_metrics/meter.h"
 #  include "opentelemetry/common/macros.h"
 
+#  include <iterator>
+
 namespace metrics_api = opentelemetry::metrics;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -600,153 +602,104 @@ std::vector<Record> Meter::Collect() noexcept
   return records;
 }
 
-// Must cast to sdk::SynchronousInstrument to have access to GetRecords() function
 void Meter::CollectMetrics(std::vector<Record> &records)
 {
+  CollectSyncInstruments<short>(short_metrics_, records);
+  CollectSyncInstruments<int>(int_metrics_, records);
+  CollectSyncInstruments<float>(float_metrics_, records);
+  CollectSyncInstruments<double>(double_metrics_, records);
+}
+
+// Must cast to sdk::SynchronousInstrument to have access to GetRecords() function
+template <typename T>
+void Meter::CollectSyncInstruments(
+    std::map<std::string, std::shared_ptr<metrics_api::SynchronousInstrument<T>>> &metrics,
+    std::vector<Record> &records)
+{
+  // Only the snapshot is taken under the lock, so that instruments can be created while the
+  // aggregators are checkpointed.
+  std::vector<std::shared_ptr<metrics_api::SynchronousInstrument<T>>> snapshot;
   metrics_lock_.lock();
-  for (auto i = short_metrics_.begin(); i != short_metrics_.end();)
-  {
-    CollectSingleSyncInstrument<short>(i, records);
-    if (i->second.use_count() == 1)  // Evaluates to true if user's shared_ptr has been deleted
-    {
-      i = short_metrics_.erase(i);  // Remove instrument that is no longer accessible
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = int_metrics_.begin(); i != int_metrics_.end();)
-  {
-    CollectSingleSyncInstrument<int>(i, records);
-    if (i->second.use_count() == 1)  // Evaluates to true if user's shared_ptr has been deleted
-    {
-      i = int_metrics_.erase(i);  // Remove instrument that is no longer accessible
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = float_metrics_.begin(); i != float_metrics_.end();)
+  snapshot.reserve(metrics.size());
+  for (auto i = metrics.begin(); i != metrics.end();)
   {
-    CollectSingleSyncInstrument<float>(i, records);
     if (i->second.use_count() == 1)  // Evaluates to true if user's shared_ptr has been deleted
     {
-      i = float_metrics_.erase(i);  // Remove instrument that is no longer accessible
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = double_metrics_.begin(); i != double_metrics_.end();)
-  {
-    CollectSingleSyncInstrument<double>(i, records);
-    if (i->second.use_count() == 1)  // Evaluates to true if user's shared_ptr has been deleted
-    {
-      i = double_metrics_.erase(i);  // Remove instrument that is no longer accessible
+      // Remove instrument that is no longer accessible, after collecting it a last time
+      snapshot.push_back(std::move(i->second));
+      i = metrics.erase(i);
     }
     else
     {
+      snapshot.push_back(i->second);
       i++;
     }
   }
   metrics_lock_.unlock();
-}
 
-template <typename T>
-void Meter::CollectSingleSyncInstrument(
-    typename std::map<std::string, std::shared_ptr<metrics_api::SynchronousInstrument<T>>>::iterator
-        i,
-    std::vector<Record> &records)
-{
-  if (!i->second->IsEnabled())
+  for (const auto &instrument : snapshot)
   {
-    i++;
-    return;
-  }
+    if (!instrument->IsEnabled())
+    {
+      continue;
+    }
 #  ifdef OPENTELEMETRY_RTTI_ENABLED
-  auto cast_ptr = std::dynamic_pointer_cast<SynchronousInstrument<T>>(i->second);
+    auto cast_ptr = std::dynamic_pointer_cast<SynchronousInstrument<T>>(instrument);
 #  else
-  auto cast_ptr = std::static_pointer_cast<SynchronousInstrument<T>>(i->second);
+    auto cast_ptr = std::static_pointer_cast<SynchronousInstrument<T>>(instrument);
 #  endif
-  std::vector<Record> new_records = cast_ptr->GetRecords();
-  records.insert(records.begin(), new_records.begin(), new_records.end());
+    std::vector<Record> new_records = cast_ptr->GetRecords();
+    records.insert(records.end(), std::make_move_iterator(new_records.begin()),
+                   std::make_move_iterator(new_records.end()));
+  }
 }
 
 void Meter::CollectObservers(std::vector<Record> &records)
 {
+  CollectAsyncInstruments<short>(short_observers_, records);
+  CollectAsyncInstruments<int>(int_observers_, records);
+  CollectAsyncInstruments<float>(float_observers_, records);
+  CollectAsyncInstruments<double>(double_observers_, records);
+}
+
+template <typename T>
+void Meter::CollectAsyncInstruments(
+    std::map<std::string, std::shared_ptr<metrics_api::AsynchronousInstrument<T>>> &observers,
+    std::vector<Record> &records)
+{
+  std::vector<std::shared_ptr<metrics_api::AsynchronousInstrument<T>>> snapshot;
   observers_lock_.lock();
-  for (auto i = short_observers_.begin(); i != short_observers_.end();)
+  snapshot.reserve(observers.size());
+  for (auto i = observers.begin(); i != observers.end();)
   {
-    CollectSingleAsyncInstrument<short>(i, records);
     if (i->second.use_count() == 1)
     {
-      i = short_observers_.erase(i);
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = int_observers_.begin(); i != int_observers_.end();)
-  {
-    CollectSingleAsyncInstrument<int>(i, records);
-    if (i->second.use_count() == 1)
-    {
-      i = int_observers_.erase(i);
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = float_observers_.begin(); i != float_observers_.end();)
-  {
-    CollectSingleAsyncInstrument<float>(i, records);
-    if (i->second.use_count() == 1)
-    {
-      i = float_observers_.erase(i);
-    }
-    else
-    {
-      i++;
-    }
-  }
-  for (auto i = double_observers_.begin(); i != double_observers_.end();)
-  {
-    CollectSingleAsyncInstrument<double>(i, records);
-    if (i->second.use_count() == 1)
-    {
-      i = double_observers_.erase(i);
+      snapshot.push_back(std::move(i->second));
+      i = observers.erase(i);
     }
     else
     {
+      snapshot.push_back(i->second);
       i++;
     }
   }
   observers_lock_.unlock();
-}
 
-template <typename T>
-void Meter::CollectSingleAsyncInstrument(
-    typename std::map<std::string,
-                      std::shared_ptr<metrics_api::AsynchronousInstrument<T>>>::iterator i,
-    std::vector<Record> &records)
-{
-  if (!i->second->IsEnabled())
+  for (const auto &instrument : snapshot)
   {
-    i++;
-    return;
-  }
+    if (!instrument->IsEnabled())
+    {
+      continue;
+    }
 #  ifdef OPENTELEMETRY_RTTI_ENABLED
-  auto cast_ptr = std::dynamic_pointer_cast<AsynchronousInstrument<T>>(i->second);
+    auto cast_ptr = std::dynamic_pointer_cast<AsynchronousInstrument<T>>(instrument);
 #  else
-  auto cast_ptr = std::static_pointer_cast<AsynchronousInstrument<T>>(i->second);
+    auto cast_ptr = std::static_pointer_cast<AsynchronousInstrument<T>>(instrument);
 #  endif
-  std::vector<Record> new_records = cast_ptr->GetRecords();
-  records.insert(records.begin(), new_records.begin(), new_records.end());
+    std::vector<Record> new_records = cast_ptr->GetRecords();
+    records.insert(records.end(), std::make_move_iterator(new_records.begin()),
+                   std::make_move_iterator(new_records.end()));
+  }
 }
 
 bool Meter::IsValidName(nostd::string_view name)
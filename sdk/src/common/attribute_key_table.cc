@@ -0,0 +1,122 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/attribute_key_table.h"
+#include "opentelemetry/sdk/common/semantic_attribute_keys.h"
+
+#include <cstring>
+#include <mutex>
+#include <new>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+constexpr AttributeKeyTable::KeyId AttributeKeyTable::kInvalidKeyId;
+constexpr size_t AttributeKeyTable::kMaxKeys;
+constexpr size_t AttributeKeyTable::kChunkSize;
+constexpr size_t AttributeKeyTable::kNumChunks;
+
+AttributeKeyTable &AttributeKeyTable::GetInstance() noexcept
+{
+  static AttributeKeyTable table(kSemanticAttributeKeys);
+  return table;
+}
+
+AttributeKeyTable::AttributeKeyTable() noexcept
+{
+  for (auto &chunk : chunks_)
+  {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+AttributeKeyTable::AttributeKeyTable(
+    nostd::span<const opentelemetry::common::AttributeKey> keys) noexcept
+    : AttributeKeyTable()
+{
+  for (const auto &key : keys)
+  {
+    Intern(key.name());
+  }
+  num_initial_keys_ = size();
+}
+
+AttributeKeyTable::~AttributeKeyTable()
+{
+  for (auto &chunk : chunks_)
+  {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+size_t AttributeKeyTable::KeyHash::operator()(nostd::string_view key) const noexcept
+{
+  // FNV-1a
+  size_t hash = static_cast<size_t>(14695981039346656037ULL);
+  for (char c : key)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= static_cast<size_t>(1099511628211ULL);
+  }
+  return hash;
+}
+
+AttributeKeyTable::KeyId AttributeKeyTable::Find(nostd::string_view key) const noexcept
+{
+  SharedSpinLockGuard<SharedSpinLockMutex> guard(lock_);
+  auto it = ids_.find(key);
+  return it == ids_.end() ? kInvalidKeyId : it->second;
+}
+
+AttributeKeyTable::KeyId AttributeKeyTable::Intern(nostd::string_view key) noexcept
+{
+  KeyId id = Find(key);
+  if (id != kInvalidKeyId)
+  {
+    return id;
+  }
+
+  std::lock_guard<SharedSpinLockMutex> guard(lock_);
+  auto it = ids_.find(key);
+  if (it != ids_.end())
+  {
+    return it->second;
+  }
+
+  const size_t size = size_.load(std::memory_order_relaxed);
+  if (size >= kMaxKeys)
+  {
+    return kInvalidKeyId;
+  }
+
+  Entry *chunk = chunks_[size / kChunkSize].load(std::memory_order_relaxed);
+  if (chunk == nullptr)
+  {
+    chunk = new (std::nothrow) Entry[kChunkSize];
+    if (chunk == nullptr)
+    {
+      return kInvalidKeyId;
+    }
+    chunks_[size / kChunkSize].store(chunk, std::memory_order_release);
+  }
+
+  std::unique_ptr<char[]> copy(new (std::nothrow) char[key.size() + 1]);
+  if (copy == nullptr)
+  {
+    return kInvalidKeyId;
+  }
+  std::memcpy(copy.get(), key.data(), key.size());
+  copy[key.size()] = '\0';
+  id               = static_cast<KeyId>(size);
+  ids_.emplace(nostd::string_view(copy.get(), key.size()), id);
+  storage_.push_back(std::move(copy));
+
+  chunk[size % kChunkSize] = Entry{storage_.back().get(), key.size()};
+  size_.store(size + 1, std::memory_order_release);
+  return id;
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
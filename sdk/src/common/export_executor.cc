@@ -0,0 +1,241 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/export_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+constexpr std::chrono::microseconds ExportExecutor::kWhenWokenUp;
+
+class ExportExecutor::Task
+{
+public:
+  enum class State
+  {
+    kIdle,
+    kQueued,
+    kRunning
+  };
+
+  explicit Task(TaskFunction function_arg) : function(std::move(function_arg)) {}
+
+  TaskFunction function;
+  State state = State::kIdle;
+
+  bool is_suspended = false;
+  // Whether the task was woken up while it was running.
+  bool is_woken_up = false;
+  // Incremented each time the task is scheduled or queued, which makes its earlier timers stale.
+  uint64_t generation = 0;
+  std::thread::id runner;
+};
+
+ExportExecutor::ExportExecutor(size_t num_threads, const ThreadOptions &thread_options)
+    : num_threads_((std::max)(num_threads, size_t{1})),
+      thread_options_(thread_options),
+      fork_handler_([this] { PrepareFork(); }, [this] { AfterFork(); }, [this] { AfterFork(); })
+{}
+
+ExportExecutor::~ExportExecutor()
+{
+  StopThreads();
+}
+
+std::shared_ptr<ExportExecutor::Task> ExportExecutor::AddTask(TaskFunction function,
+                                                              std::chrono::microseconds delay)
+{
+  std::shared_ptr<Task> task(new Task(std::move(function)));
+  std::lock_guard<std::mutex> guard(m_);
+  if (!are_threads_started_)
+  {
+    StartThreads();
+  }
+  ScheduleLocked(task, delay);
+  return task;
+}
+
+void ExportExecutor::WakeUp(const std::shared_ptr<Task> &task) noexcept
+{
+  std::lock_guard<std::mutex> guard(m_);
+  if (task->is_suspended)
+  {
+    return;
+  }
+  if (task->state == Task::State::kRunning)
+  {
+    task->is_woken_up = true;
+  }
+  else if (task->state == Task::State::kIdle)
+  {
+    QueueLocked(task);
+  }
+}
+
+void ExportExecutor::SuspendTask(const std::shared_ptr<Task> &task) noexcept
+{
+  std::unique_lock<std::mutex> lk(m_);
+  task->is_suspended = true;
+  ++task->generation;
+  if (task->state == Task::State::kQueued)
+  {
+    ready_.erase(std::find(ready_.begin(), ready_.end(), task));
+    task->state = Task::State::kIdle;
+  }
+  else if (task->state == Task::State::kRunning && task->runner != std::this_thread::get_id())
+  {
+    done_cv_.wait(lk, [&task] { return task->state != Task::State::kRunning; });
+  }
+}
+
+void ExportExecutor::ResumeTask(const std::shared_ptr<Task> &task,
+                                std::chrono::microseconds delay) noexcept
+{
+  std::lock_guard<std::mutex> guard(m_);
+  if (!task->is_suspended)
+  {
+    return;
+  }
+  task->is_suspended = false;
+  // A task resuming itself is scheduled with the delay it returns.
+  if (task->state == Task::State::kIdle)
+  {
+    ScheduleLocked(task, delay);
+  }
+}
+
+void ExportExecutor::ScheduleLocked(const std::shared_ptr<Task> &task,
+                                    std::chrono::microseconds delay)
+{
+  if (delay <= std::chrono::microseconds::zero())
+  {
+    QueueLocked(task);
+    return;
+  }
+  ++task->generation;
+  auto now = Clock::now();
+  if (delay >=
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::time_point::max() - now))
+  {
+    // Never expires, including kWhenWokenUp.
+    return;
+  }
+  timers_.push(Timer{now + delay, task->generation, task});
+  // The new deadline may be earlier than the ones the threads wait for.
+  work_cv_.notify_one();
+}
+
+void ExportExecutor::QueueLocked(const std::shared_ptr<Task> &task)
+{
+  ++task->generation;
+  task->state = Task::State::kQueued;
+  ready_.push_back(task);
+  work_cv_.notify_one();
+}
+
+void ExportExecutor::DoWork()
+{
+  ApplyThreadOptions(thread_options_, "otel-executor");
+  std::unique_lock<std::mutex> lk(m_);
+  while (!stopping_)
+  {
+    if (!ready_.empty())
+    {
+      std::shared_ptr<Task> task = std::move(ready_.front());
+      ready_.pop_front();
+      task->state       = Task::State::kRunning;
+      task->runner      = std::this_thread::get_id();
+      task->is_woken_up = false;
+      lk.unlock();
+      std::chrono::microseconds delay = task->function();
+      lk.lock();
+      task->state  = Task::State::kIdle;
+      task->runner = std::thread::id();
+      if (!task->is_suspended)
+      {
+        if (task->is_woken_up)
+        {
+          QueueLocked(task);
+        }
+        else
+        {
+          ScheduleLocked(task, delay);
+        }
+      }
+      done_cv_.notify_all();
+      continue;
+    }
+
+    if (timers_.empty())
+    {
+      work_cv_.wait(lk);
+      continue;
+    }
+    const Timer &timer = timers_.top();
+    if (timer.generation != timer.task->generation)
+    {
+      // The task was queued, rescheduled or suspended since.
+      timers_.pop();
+      continue;
+    }
+    if (timer.deadline <= Clock::now())
+    {
+      std::shared_ptr<Task> task = timer.task;
+      timers_.pop();
+      QueueLocked(task);
+      continue;
+    }
+    // A copy, as the timer may be popped by another thread while this one waits.
+    Clock::time_point deadline = timer.deadline;
+    work_cv_.wait_until(lk, deadline);
+  }
+}
+
+void ExportExecutor::StartThreads()
+{
+  stopping_            = false;
+  are_threads_started_ = true;
+  for (size_t i = 0; i < num_threads_; ++i)
+  {
+    threads_.emplace_back(&ExportExecutor::DoWork, this);
+  }
+}
+
+void ExportExecutor::StopThreads()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_);
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &thread : threads_)
+  {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+void ExportExecutor::PrepareFork()
+{
+  // The tasks left queued or scheduled run after the fork.
+  StopThreads();
+  // Released by AfterFork.
+  m_.lock();
+}
+
+void ExportExecutor::AfterFork()
+{
+  if (are_threads_started_)
+  {
+    StartThreads();
+  }
+  m_.unlock();
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -77,6 +78,51 @@ class FastRandomNumberGenerator
 private:
   std::array<uint64_t, 2> state_{};
 };
+
+/**
+ * Fills buffers in bulk with kLanes independent streams of the FastRandomNumberGenerator
+ * algorithm. The states of the streams are stored lane by lane, so that compilers can vectorize
+ * the update of all the lanes.
+ */
+class BulkFastRandomNumberGenerator
+{
+public:
+  static constexpr size_t kLanes = 4;
+
+  BulkFastRandomNumberGenerator() noexcept = default;
+
+  template <class SeedSequence>
+  void seed(SeedSequence &seed_sequence) noexcept
+  {
+    seed_sequence.generate(reinterpret_cast<uint32_t *>(state_a_.data()),
+                           reinterpret_cast<uint32_t *>(state_a_.data() + kLanes));
+    seed_sequence.generate(reinterpret_cast<uint32_t *>(state_b_.data()),
+                           reinterpret_cast<uint32_t *>(state_b_.data() + kLanes));
+  }
+
+  // Fills buffer with size random numbers. size must be a multiple of kLanes.
+  void Fill(uint64_t *buffer, size_t size) noexcept
+  {
+    for (size_t i = 0; i < size; i += kLanes)
+    {
+      for (size_t lane = 0; lane < kLanes; ++lane)
+      {
+        auto t         = state_a_[lane];
+        auto s         = state_b_[lane];
+        state_a_[lane] = s;
+        t ^= t << 23;        // a
+        t ^= t >> 17;        // b
+        t ^= s ^ (s >> 26);  // c
+        state_b_[lane]   = t;
+        buffer[i + lane] = t + s;
+      }
+    }
+  }
+
+private:
+  std::array<uint64_t, kLanes> state_a_{};
+  std::array<uint64_t, kLanes> state_b_{};
+};
 }  // namespace common
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,87 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/fork_handler.h"
+#include "src/common/platform/fork.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+struct ForkHandlerRegistry
+{
+  std::mutex lock;
+  std::vector<const ForkHandlerRegistration *> registrations;
+};
+
+// Never destroyed, so that registrations of static objects may outlive it.
+ForkHandlerRegistry &GetRegistry()
+{
+  static ForkHandlerRegistry *registry = new ForkHandlerRegistry;
+  return *registry;
+}
+
+void OnPrepare() noexcept
+{
+  ForkHandlerRegistry &registry = GetRegistry();
+  // Released by OnParent or OnChild, once the fork is done.
+  registry.lock.lock();
+  for (auto it = registry.registrations.rbegin(); it != registry.registrations.rend(); ++it)
+  {
+    (*it)->Prepare();
+  }
+}
+
+void OnParent() noexcept
+{
+  ForkHandlerRegistry &registry = GetRegistry();
+  for (const ForkHandlerRegistration *registration : registry.registrations)
+  {
+    registration->Parent();
+  }
+  registry.lock.unlock();
+}
+
+void OnChild() noexcept
+{
+  ForkHandlerRegistry &registry = GetRegistry();
+  for (const ForkHandlerRegistration *registration : registry.registrations)
+  {
+    registration->Child();
+  }
+  registry.lock.unlock();
+}
+}  // namespace
+
+ForkHandlerRegistration::ForkHandlerRegistration(std::function<void()> prepare,
+                                                 std::function<void()> parent,
+                                                 std::function<void()> child)
+    : prepare_(std::move(prepare)), parent_(std::move(parent)), child_(std::move(child))
+{
+  static std::once_flag at_fork_once;
+  std::call_once(at_fork_once, [] { platform::AtFork(OnPrepare, OnParent, OnChild); });
+
+  ForkHandlerRegistry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  registry.registrations.push_back(this);
+}
+
+ForkHandlerRegistration::~ForkHandlerRegistration()
+{
+  ForkHandlerRegistry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.lock);
+  registry.registrations.erase(
+      std::find(registry.registrations.begin(), registry.registrations.end(), this));
+}
+
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,126 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/numa.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+#ifdef __linux__
+// Parses a list of ids in the format of the kernel, such as "0-3,8,10-11".
+std::vector<size_t> ParseIdList(const std::string &list)
+{
+  std::vector<size_t> ids;
+  const char *pos = list.c_str();
+  while (*pos >= '0' && *pos <= '9')
+  {
+    char *end    = nullptr;
+    size_t first = std::strtoul(pos, &end, 10);
+    size_t last  = first;
+    if (*end == '-')
+    {
+      last = std::strtoul(end + 1, &end, 10);
+    }
+    for (size_t id = first; id <= last; ++id)
+    {
+      ids.push_back(id);
+    }
+    pos = *end == ',' ? end + 1 : end;
+  }
+  return ids;
+}
+
+std::string ReadLine(const std::string &path)
+{
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+#endif
+
+struct NumaTopology
+{
+  NumaTopology()
+  {
+#ifdef __linux__
+    std::vector<size_t> nodes = ParseIdList(ReadLine("/sys/devices/system/node/online"));
+    for (size_t index = 0; nodes.size() > 1 && index < nodes.size(); ++index)
+    {
+      std::string path =
+          "/sys/devices/system/node/node" + std::to_string(nodes[index]) + "/cpulist";
+      for (size_t cpu : ParseIdList(ReadLine(path)))
+      {
+        if (cpu >= node_of_cpu.size())
+        {
+          node_of_cpu.resize(cpu + 1, 0);
+        }
+        node_of_cpu[cpu] = static_cast<uint16_t>(index);
+      }
+    }
+    if (!node_of_cpu.empty())
+    {
+      node_count = nodes.size();
+    }
+#endif
+  }
+
+  size_t node_count = 1;
+  // The dense index of the node of each CPU, empty with a single node.
+  std::vector<uint16_t> node_of_cpu;
+};
+
+const NumaTopology &GetTopology() noexcept
+{
+  static const NumaTopology topology;
+  return topology;
+}
+
+#ifdef __linux__
+// Number of GetCurrentNumaNode() calls served from the cache of a thread.
+constexpr uint32_t kNumaNodeCacheCalls = 64;
+#endif
+}  // namespace
+
+size_t GetNumaNodeCount() noexcept
+{
+  return GetTopology().node_count;
+}
+
+size_t GetCurrentNumaNode() noexcept
+{
+#ifdef __linux__
+  static thread_local size_t node      = 0;
+  static thread_local uint32_t pending = 0;
+  if (pending-- != 0)
+  {
+    return node;
+  }
+  pending                      = kNumaNodeCacheCalls - 1;
+  const NumaTopology &topology = GetTopology();
+  int cpu                      = ::sched_getcpu();
+  node = cpu >= 0 && static_cast<size_t>(cpu) < topology.node_of_cpu.size()
+             ? topology.node_of_cpu[cpu]
+             : 0;
+  return node;
+#else
+  return 0;
+#endif
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -45,26 +45,62 @@ class TlsRandomNumberGenerator
 };
 
 thread_local FastRandomNumberGenerator TlsRandomNumberGenerator::engine_{};
-}  // namespace
 
-FastRandomNumberGenerator &Random::GetRandomNumberGenerator() noexcept
+// Hands out random numbers from a thread_local buffer, refilled kBufferSize at a time by a
+// BulkFastRandomNumberGenerator. Like TlsRandomNumberGenerator, it is seeded again after forking,
+// dropping the numbers left in the buffer that the parent process would hand out as well.
+class TlsBufferedRandomNumberGenerator
 {
-  static thread_local TlsRandomNumberGenerator random_number_generator{};
-  return TlsRandomNumberGenerator::engine();
-}
+public:
+  TlsBufferedRandomNumberGenerator() noexcept
+  {
+    Seed();
+    platform::AtFork(nullptr, nullptr, OnFork);
+  }
 
-uint64_t Random::GenerateRandom64() noexcept
-{
-  return GetRandomNumberGenerator()();
-}
+  static uint64_t Next() noexcept
+  {
+    if (index_ == kBufferSize)
+    {
+      engine_.Fill(buffer_, kBufferSize);
+      index_ = 0;
+    }
+    return buffer_[index_++];
+  }
 
-void Random::GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept
+private:
+  static constexpr size_t kBufferSize = 64;
+
+  static thread_local BulkFastRandomNumberGenerator engine_;
+  static thread_local uint64_t buffer_[kBufferSize];
+  static thread_local size_t index_;
+
+  static void OnFork() noexcept { Seed(); }
+
+  static void Seed() noexcept
+  {
+    std::random_device random_device;
+    std::seed_seq seed_seq{random_device(), random_device(), random_device(), random_device()};
+    engine_.seed(seed_seq);
+    index_ = kBufferSize;
+  }
+};
+
+constexpr size_t TlsBufferedRandomNumberGenerator::kBufferSize;
+thread_local BulkFastRandomNumberGenerator TlsBufferedRandomNumberGenerator::engine_{};
+thread_local uint64_t
+    TlsBufferedRandomNumberGenerator::buffer_[TlsBufferedRandomNumberGenerator::kBufferSize];
+thread_local size_t TlsBufferedRandomNumberGenerator::index_ =
+    TlsBufferedRandomNumberGenerator::kBufferSize;
+
+template <class Generate>
+void FillRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer, Generate generate) noexcept
 {
   auto buf_size = buffer.size();
 
   for (size_t i = 0; i < buf_size; i += sizeof(uint64_t))
   {
-    uint64_t value = GenerateRandom64();
+    uint64_t value = generate();
     if (i + sizeof(uint64_t) <= buf_size)
     {
       memcpy(&buffer[i], &value, sizeof(uint64_t));
@@ -75,6 +111,34 @@ void Random::GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) no
     }
   }
 }
+}  // namespace
+
+FastRandomNumberGenerator &Random::GetRandomNumberGenerator() noexcept
+{
+  static thread_local TlsRandomNumberGenerator random_number_generator{};
+  return TlsRandomNumberGenerator::engine();
+}
+
+uint64_t Random::GenerateRandom64() noexcept
+{
+  return GetRandomNumberGenerator()();
+}
+
+void Random::GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept
+{
+  FillRandomBuffer(buffer, [] { return GenerateRandom64(); });
+}
+
+uint64_t Random::GenerateBufferedRandom64() noexcept
+{
+  static thread_local TlsBufferedRandomNumberGenerator random_number_generator{};
+  return TlsBufferedRandomNumberGenerator::Next();
+}
+
+void Random::GenerateBufferedRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept
+{
+  FillRandomBuffer(buffer, [] { return GenerateBufferedRandom64(); });
+}
 }  // namespace common
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
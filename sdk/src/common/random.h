@@ -30,6 +30,20 @@ class Random
    */
   static void GenerateRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept;
 
+  /**
+   * @return an unsigned 64 bit random number, taken from a thread-local buffer
+   * which is refilled in bulk.
+   */
+  static uint64_t GenerateBufferedRandom64() noexcept;
+
+  /**
+   * Fill the passed span with random bytes, taken from a thread-local buffer
+   * which is refilled in bulk.
+   *
+   * @param buffer A span of bytes.
+   */
+  static void GenerateBufferedRandomBuffer(opentelemetry::nostd::span<uint8_t> buffer) noexcept;
+
 private:
   /**
    * @return a seeded thread-local random number generator.
@@ -0,0 +1,236 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/record_journal.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+constexpr char kJournalMagic[]      = "OTJRNL01";
+constexpr size_t kCapacityOffset    = 8;
+constexpr size_t kHeadOffset        = 16;
+constexpr size_t kJournalHeaderSize = 64;
+
+constexpr size_t kRecordHeaderSize = 16;
+constexpr size_t kRecordAlignment  = 8;
+constexpr uint32_t kMaxPayloadSize = 0xFFFFFF;
+// The type of the records filling the end of the ring when the next record does not fit there.
+constexpr uint8_t kPaddingType = 0xFF;
+
+size_t AlignRecord(size_t size)
+{
+  return (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+uint32_t Hash(const uint8_t *data, size_t size)
+{
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+void WriteRecordHeader(uint8_t *record,
+                       uint64_t position,
+                       uint8_t type,
+                       uint32_t size,
+                       uint32_t hash)
+{
+  uint32_t type_and_size = (static_cast<uint32_t>(type) << 24) | size;
+  std::memcpy(record + 8, &type_and_size, sizeof(type_and_size));
+  std::memcpy(record + 12, &hash, sizeof(hash));
+  // The position is written last: a record whose position does not match is torn.
+  std::memcpy(record, &position, sizeof(position));
+}
+}  // namespace
+
+RecordJournal::RecordJournal(int fd, uint8_t *data, size_t capacity) noexcept
+    : fd_(fd), data_(data), capacity_(capacity)
+{}
+
+std::atomic<uint64_t> &RecordJournal::Head() noexcept
+{
+  return *reinterpret_cast<std::atomic<uint64_t> *>(data_ + kHeadOffset);
+}
+
+bool RecordJournal::Append(JournalRecordType type, nostd::string_view payload) noexcept
+{
+  const size_t record_size = AlignRecord(kRecordHeaderSize + payload.size());
+  if (payload.size() > kMaxPayloadSize || record_size > capacity_)
+  {
+    return false;
+  }
+
+  // Reserves the room of the record, after a padding record if it does not fit before the end of
+  // the ring.
+  std::atomic<uint64_t> &head = Head();
+  uint64_t position           = head.load(std::memory_order_relaxed);
+  uint64_t record_position    = 0;
+  size_t padding              = 0;
+  do
+  {
+    size_t offset   = static_cast<size_t>(position % capacity_);
+    padding         = offset + record_size > capacity_ ? capacity_ - offset : 0;
+    record_position = position + padding;
+  } while (!head.compare_exchange_weak(position, record_position + record_size,
+                                       std::memory_order_relaxed));
+
+  uint8_t *ring = data_ + kJournalHeaderSize;
+  if (padding >= kRecordHeaderSize)
+  {
+    WriteRecordHeader(ring + position % capacity_, position, kPaddingType,
+                      static_cast<uint32_t>(padding - kRecordHeaderSize), Hash(nullptr, 0));
+  }
+  uint8_t *record = ring + record_position % capacity_;
+  if (!payload.empty())
+  {
+    std::memcpy(record + kRecordHeaderSize, payload.data(), payload.size());
+  }
+  WriteRecordHeader(record, record_position, static_cast<uint8_t>(type),
+                    static_cast<uint32_t>(payload.size()),
+                    Hash(record + kRecordHeaderSize, payload.size()));
+  return true;
+}
+
+bool RecordJournal::Recover(
+    const std::string &path,
+    nostd::function_ref<void(JournalRecordType, nostd::string_view)> callback)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (content.size() < kJournalHeaderSize ||
+      content.compare(0, sizeof(kJournalMagic) - 1, kJournalMagic) != 0)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] " << path << " is not a journal");
+    return false;
+  }
+  uint64_t capacity = 0;
+  uint64_t head     = 0;
+  std::memcpy(&capacity, &content[kCapacityOffset], sizeof(capacity));
+  std::memcpy(&head, &content[kHeadOffset], sizeof(head));
+  if (capacity == 0 || capacity % kRecordAlignment != 0 ||
+      content.size() < kJournalHeaderSize + capacity)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] " << path << " is truncated");
+    return false;
+  }
+
+  // Walks the last lap of the ring, recognizing records by their position and hash: those whose
+  // start was overwritten by the next lap, and those whose writer crashed, are skipped 8 bytes at
+  // a time until the next intact record.
+  const uint8_t *ring = reinterpret_cast<const uint8_t *>(content.data()) + kJournalHeaderSize;
+  uint64_t position   = head > capacity ? head - capacity : 0;
+  while (position + kRecordHeaderSize <= head)
+  {
+    size_t offset = static_cast<size_t>(position % capacity);
+    if (capacity - offset < kRecordHeaderSize)
+    {
+      position += capacity - offset;
+      continue;
+    }
+    const uint8_t *record = ring + offset;
+    uint64_t record_position;
+    uint32_t type_and_size;
+    uint32_t hash;
+    std::memcpy(&record_position, record, sizeof(record_position));
+    std::memcpy(&type_and_size, record + 8, sizeof(type_and_size));
+    std::memcpy(&hash, record + 12, sizeof(hash));
+    uint8_t type = static_cast<uint8_t>(type_and_size >> 24);
+    size_t size  = type_and_size & kMaxPayloadSize;
+    if (record_position != position || offset + kRecordHeaderSize + size > capacity ||
+        position + kRecordHeaderSize + size > head ||
+        Hash(record + kRecordHeaderSize, size) != hash)
+    {
+      position += kRecordAlignment;
+      continue;
+    }
+    if (type != kPaddingType)
+    {
+      callback(static_cast<JournalRecordType>(type),
+               nostd::string_view(reinterpret_cast<const char *>(record + kRecordHeaderSize),
+                                  size));
+    }
+    position += AlignRecord(kRecordHeaderSize + size);
+  }
+  return true;
+}
+
+#if defined(_WIN32)
+
+std::shared_ptr<RecordJournal> RecordJournal::Open(const std::string &, size_t) noexcept
+{
+  OTEL_INTERNAL_LOG_ERROR("[Record Journal] Journals are not supported on this platform");
+  return nullptr;
+}
+
+RecordJournal::~RecordJournal() {}
+
+#else
+
+std::shared_ptr<RecordJournal> RecordJournal::Open(const std::string &path,
+                                                   size_t capacity) noexcept
+{
+  capacity = AlignRecord(capacity);
+  if (capacity < kRecordHeaderSize)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] Invalid capacity " << capacity);
+    return nullptr;
+  }
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] Cannot create " << path);
+    return nullptr;
+  }
+  const size_t size = kJournalHeaderSize + capacity;
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] Cannot allocate " << size << " bytes for " << path);
+    close(fd);
+    return nullptr;
+  }
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED)
+  {
+    OTEL_INTERNAL_LOG_ERROR("[Record Journal] Cannot map " << path);
+    close(fd);
+    return nullptr;
+  }
+
+  auto bytes = static_cast<uint8_t *>(data);
+  std::memcpy(bytes, kJournalMagic, sizeof(kJournalMagic) - 1);
+  uint64_t capacity_field = capacity;
+  std::memcpy(bytes + kCapacityOffset, &capacity_field, sizeof(capacity_field));
+  new (bytes + kHeadOffset) std::atomic<uint64_t>(0);
+  return std::shared_ptr<RecordJournal>(new RecordJournal(fd, bytes, capacity));
+}
+
+RecordJournal::~RecordJournal()
+{
+  munmap(data_, kJournalHeaderSize + capacity_);
+  close(fd_);
+}
+
+#endif
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,19 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/telemetry_switch.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+std::atomic<bool> TelemetrySwitch::enabled_{true};
+
+void TelemetrySwitch::SetEnabled(bool enabled) noexcept
+{
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
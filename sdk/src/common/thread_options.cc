@@ -0,0 +1,141 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/thread_options.h"
+
+#include <cerrno>
+#include <mutex>
+
+#include "opentelemetry/sdk/common/global_log_handler.h"
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#elif defined(__APPLE__)
+#  include <pthread.h>
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace common
+{
+namespace
+{
+std::mutex &DefaultThreadOptionsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+ThreadOptions &DefaultThreadOptions()
+{
+  static ThreadOptions options;
+  return options;
+}
+
+void SetThreadName(const std::string &name)
+{
+#if defined(__linux__)
+  // The kernel limits names to 15 characters and the terminating null.
+  int error = pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+  if (error != 0)
+  {
+    OTEL_INTERNAL_LOG_WARN("[Thread Options] Cannot name the thread " << name << ", error "
+                                                                      << error);
+  }
+#elif defined(__APPLE__)
+  pthread_setname_np(name.c_str());
+#else
+  (void)name;
+#endif
+}
+
+void SetThreadAffinity(const std::string &name, const std::vector<int> &cpus)
+{
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus)
+  {
+    if (cpu >= 0 && cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &set);
+    }
+  }
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (error != 0)
+  {
+    OTEL_INTERNAL_LOG_WARN("[Thread Options] Cannot set the CPU affinity of the thread "
+                           << name << ", error " << error);
+  }
+#else
+  (void)cpus;
+  OTEL_INTERNAL_LOG_WARN("[Thread Options] CPU affinity is not supported on this platform, the "
+                         "thread "
+                         << name << " keeps the affinity it inherits");
+#endif
+}
+
+void SetThreadNice(const std::string &name, int nice)
+{
+#if defined(__linux__)
+  // On Linux the niceness is a property of each thread, addressed by its thread id.
+  if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) != 0)
+  {
+    OTEL_INTERNAL_LOG_WARN("[Thread Options] Cannot set the niceness of the thread "
+                           << name << " to " << nice << ", error " << errno);
+  }
+#else
+  (void)nice;
+  OTEL_INTERNAL_LOG_WARN("[Thread Options] Niceness is not supported on this platform, the thread "
+                         << name << " keeps the priority it inherits");
+#endif
+}
+}  // namespace
+
+void SetDefaultThreadOptions(const ThreadOptions &options)
+{
+  std::lock_guard<std::mutex> guard(DefaultThreadOptionsMutex());
+  DefaultThreadOptions() = options;
+}
+
+ThreadOptions GetDefaultThreadOptions()
+{
+  std::lock_guard<std::mutex> guard(DefaultThreadOptionsMutex());
+  return DefaultThreadOptions();
+}
+
+void ApplyThreadOptions(const ThreadOptions &options, const char *default_name) noexcept
+{
+  ThreadOptions defaults = GetDefaultThreadOptions();
+
+  std::string name = !options.name.empty()
+                         ? options.name
+                         : (!defaults.name.empty() ? defaults.name : std::string(default_name));
+  SetThreadName(name);
+
+  const std::vector<int> &cpus =
+      !options.cpu_affinity.empty() ? options.cpu_affinity : defaults.cpu_affinity;
+  if (!cpus.empty())
+  {
+    SetThreadAffinity(name, cpus);
+  }
+
+  if (options.set_nice || defaults.set_nice)
+  {
+    SetThreadNice(name, options.set_nice ? options.nice : defaults.nice);
+  }
+
+  const auto &on_start = options.on_start ? options.on_start : defaults.on_start;
+  if (on_start)
+  {
+    on_start(name);
+  }
+}
+}  // namespace common
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -3,10 +3,11 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 #  include "opentelemetry/sdk/logs/batch_log_processor.h"
+#  include "opentelemetry/sdk/common/export_batch_splitter.h"
+#  include "opentelemetry/sdk/common/tracepoint.h"
+#  include "opentelemetry/sdk/logs/shared_log_record.h"
 
 #  include <vector>
-using opentelemetry::sdk::common::AtomicUniquePtr;
-using opentelemetry::sdk::common::CircularBufferRange;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -16,17 +17,51 @@ namespace logs
 BatchLogProcessor::BatchLogProcessor(std::unique_ptr<LogExporter> &&exporter,
                                      const size_t max_queue_size,
                                      const std::chrono::milliseconds scheduled_delay_millis,
-                                     const size_t max_export_batch_size)
+                                     const size_t max_export_batch_size,
+                                     const size_t max_recycled_recordables,
+                                     const size_t max_export_batch_bytes,
+                                     const bool preallocate_recordables,
+                                     std::shared_ptr<common::ExportExecutor> executor,
+                                     const common::ThreadOptions &thread_options,
+                                     std::shared_ptr<common::RecordJournal> journal)
     : exporter_(std::move(exporter)),
       max_queue_size_(max_queue_size),
       scheduled_delay_millis_(scheduled_delay_millis),
       max_export_batch_size_(max_export_batch_size),
+      max_export_batch_bytes_(max_export_batch_bytes),
+      worker_timeout_(scheduled_delay_millis),
       buffer_(max_queue_size_),
-      worker_thread_(&BatchLogProcessor::DoBackgroundWork, this)
-{}
+      recycled_(max_recycled_recordables, 1),
+      journal_(std::move(journal)),
+      thread_options_(thread_options),
+      executor_(std::move(executor)),
+      fork_handler_([this] { PrepareFork(); },
+                    [this] { ParentAfterFork(); },
+                    [this] { ChildAfterFork(); })
+{
+  if (preallocate_recordables && exporter_ != nullptr)
+  {
+    slots_.reset(new common::RecordableSlotRing<Recordable>(
+        max_queue_size_, [this] { return exporter_->MakeRecordable(); }));
+  }
+}
 
 std::unique_ptr<Recordable> BatchLogProcessor::MakeRecordable() noexcept
 {
+  std::unique_ptr<Recordable> recordable;
+  if (slots_ != nullptr)
+  {
+    recordable = slots_->Take();
+    if (recordable != nullptr)
+    {
+      return recordable;
+    }
+  }
+  recordable = recycled_.Take();
+  if (recordable != nullptr)
+  {
+    return recordable;
+  }
   return exporter_->MakeRecordable();
 }
 
@@ -37,17 +72,30 @@ void BatchLogProcessor::OnReceive(std::unique_ptr<Recordable> &&record) noexcept
     return;
   }
 
+  if (is_worker_started_.load(std::memory_order_acquire) == false)
+  {
+    StartWorker();
+  }
+
+  if (journal_ != nullptr)
+  {
+    journal_->AppendRecordable(*record);
+  }
+
   if (buffer_.Add(record) == false)
   {
+    stats_.RecordDropped();
+    OTEL_SDK_TRACEPOINT0(batch_log_processor__drop);
     return;
   }
+  OTEL_SDK_TRACEPOINT1(batch_log_processor__enqueue, buffer_.size());
 
   // If the queue gets at least half full a preemptive notification is
   // sent to the worker thread to start a new export cycle.
   if (buffer_.size() >= max_queue_size_ / 2)
   {
     // signal the worker thread
-    cv_.notify_one();
+    synchronizer_.WakeUp();
   }
 }
 
@@ -58,78 +106,94 @@ bool BatchLogProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
     return false;
   }
 
-  is_force_flush_ = true;
-
-  // Keep attempting to wake up the worker thread
-  while (is_force_flush_.load() == true)
+  if (is_worker_started_.load(std::memory_order_acquire) == false)
   {
-    cv_.notify_one();
+    // Nothing was queued yet.
+    return true;
   }
 
-  // Now wait for the worker thread to signal back from the Export method
-  std::unique_lock<std::mutex> lk(force_flush_cv_m_);
-  while (is_force_flush_notified_.load() == false)
+  return synchronizer_.ForceFlush(timeout);
+}
+
+void BatchLogProcessor::StartWorker() noexcept
+{
+  std::lock_guard<std::mutex> shutdown_guard{shutdown_m_};
+  if (is_shutdown_.load() == false && is_worker_started_.load() == false)
   {
-    force_flush_cv_.wait(lk);
+    if (executor_ != nullptr)
+    {
+      worker_task_ = executor_->AddTask([this] { return RunWorkerTask(); }, worker_timeout_);
+      synchronizer_.SetWorkerTask([this] { executor_->WakeUp(worker_task_); });
+    }
+    else
+    {
+      worker_thread_ = std::thread(&BatchLogProcessor::DoBackgroundWork, this);
+    }
+    is_worker_started_.store(true, std::memory_order_release);
   }
-
-  // Notify the worker thread
-  is_force_flush_notified_ = false;
-
-  return true;
 }
 
 void BatchLogProcessor::DoBackgroundWork()
 {
-  auto timeout = scheduled_delay_millis_;
+  common::ApplyThreadOptions(thread_options_, "otel-blp");
+  worker_timeout_ = scheduled_delay_millis_;
+  // Wait for `worker_timeout_` milliseconds, or until woken up by a full queue, a force flush or
+  // a shutdown request.
+  while (RunCycle(synchronizer_.WaitForWork(worker_timeout_)))
+  {
+  }
+}
 
-  while (true)
+std::chrono::microseconds BatchLogProcessor::RunWorkerTask()
+{
+  if (!RunCycle(synchronizer_.TakeWork()))
   {
-    // Wait for `timeout` milliseconds
-    std::unique_lock<std::mutex> lk(cv_m_);
-    cv_.wait_for(lk, timeout);
+    return common::ExportExecutor::kWhenWokenUp;
+  }
+  return worker_timeout_;
+}
 
-    if (is_shutdown_.load() == true)
-    {
-      DrainQueue();
-      return;
-    }
+bool BatchLogProcessor::RunCycle(uint64_t flush_generation)
+{
+  if (is_shutdown_.load() == true)
+  {
+    DrainQueue();
+    synchronizer_.Stop();
+    return false;
+  }
 
-    bool was_force_flush_called = is_force_flush_.load();
+  if (synchronizer_.IsPauseRequested())
+  {
+    return false;
+  }
 
-    // Check if this export was the result of a force flush.
-    if (was_force_flush_called == true)
-    {
-      // Since this export was the result of a force flush, signal the
-      // main thread that the worker thread has been notified
-      is_force_flush_ = false;
-    }
-    else
-    {
-      // If the buffer was empty during the entire `timeout` time interval,
-      // go back to waiting. If this was a spurious wake-up, we export only if
-      // `buffer_` is not empty. This is acceptable because batching is a best
-      // mechanism effort here.
-      if (buffer_.empty() == true)
-      {
-        continue;
-      }
-    }
+  bool was_force_flush_called = flush_generation != 0;
 
-    auto start = std::chrono::steady_clock::now();
-    Export(was_force_flush_called);
-    auto end      = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+  // If the buffer was empty during the entire `timeout` time interval, go back to waiting.
+  // If this was a spurious wake-up, we export only if `buffer_` is not empty. This is
+  // acceptable because batching is a best mechanism effort here.
+  if (was_force_flush_called == false && buffer_.empty() == true)
+  {
+    worker_timeout_ = scheduled_delay_millis_;
+    return true;
+  }
 
-    // Subtract the duration of this export call from the next `timeout`.
-    timeout = scheduled_delay_millis_ - duration;
+  auto start = std::chrono::steady_clock::now();
+  Export(was_force_flush_called);
+  if (was_force_flush_called == true)
+  {
+    synchronizer_.NotifyFlushCompleted(flush_generation);
   }
+  auto end      = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  // Subtract the duration of this export call from the next `timeout`.
+  worker_timeout_ = scheduled_delay_millis_ - duration;
+  return true;
 }
 
 void BatchLogProcessor::Export(const bool was_force_flush_called)
 {
-  std::vector<std::unique_ptr<Recordable>> records_arr;
-
   size_t num_records_to_export;
 
   if (was_force_flush_called == true)
@@ -142,28 +206,34 @@ void BatchLogProcessor::Export(const bool was_force_flush_called)
         buffer_.size() >= max_export_batch_size_ ? max_export_batch_size_ : buffer_.size();
   }
 
-  buffer_.Consume(num_records_to_export,
-                  [&](CircularBufferRange<AtomicUniquePtr<Recordable>> range) noexcept {
-                    range.ForEach([&](AtomicUniquePtr<Recordable> &ptr) {
-                      std::unique_ptr<Recordable> swap_ptr = std::unique_ptr<Recordable>(nullptr);
-                      ptr.Swap(swap_ptr);
-                      records_arr.push_back(std::unique_ptr<Recordable>(swap_ptr.release()));
-                      return true;
-                    });
-                  });
-
-  exporter_->Export(
-      nostd::span<std::unique_ptr<Recordable>>(records_arr.data(), records_arr.size()));
+  // The batch vector is reused from one export to the next, and left empty after each.
+  std::vector<std::unique_ptr<Recordable>> &records_arr = export_batch_;
+  buffer_.ConsumeInto(num_records_to_export, records_arr);
 
-  // Notify the main thread in case this export was the result of a force flush.
-  if (was_force_flush_called == true)
+  // Logs shared with other processors are only turned into recordables of the exporter here, on
+  // the worker thread.
+  for (auto &record : records_arr)
   {
-    is_force_flush_notified_ = true;
-    while (is_force_flush_notified_.load() == true)
-    {
-      force_flush_cv_.notify_one();
-    }
+    ResolveSharedRecordable(record, [this] { return MakeRecordable(); });
   }
+
+  common::ForEachExportBatch(
+      records_arr, max_export_batch_bytes_, [this](nostd::span<std::unique_ptr<Recordable>> batch) {
+        auto start = std::chrono::steady_clock::now();
+        OTEL_SDK_TRACEPOINT2(export__begin, "logs", batch.size());
+        auto result = exporter_->Export(batch);
+        OTEL_SDK_TRACEPOINT3(export__end, "logs", batch.size(), static_cast<int>(result));
+        stats_.RecordExport(batch.size(), std::chrono::steady_clock::now() - start, result);
+        exporter_->Recycle(batch);
+        // Keep the recordables the exporter neither took nor recycled itself, in the free slots
+        // first.
+        if (slots_ != nullptr)
+        {
+          slots_->Recycle(batch);
+        }
+        recycled_.Recycle(batch);
+      });
+  records_arr.clear();
 }
 
 void BatchLogProcessor::DrainQueue()
@@ -181,9 +251,16 @@ bool BatchLogProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
 
   if (worker_thread_.joinable())
   {
-    cv_.notify_one();
+    synchronizer_.RequestShutdown();
     worker_thread_.join();
   }
+  else if (worker_task_ != nullptr)
+  {
+    // Unless the task already did, drain the queue once it no longer runs.
+    executor_->SuspendTask(worker_task_);
+    DrainQueue();
+    synchronizer_.Stop();
+  }
 
   // Should only shutdown exporter ONCE.
   if (!already_shutdown && exporter_ != nullptr)
@@ -194,6 +271,63 @@ bool BatchLogProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
   return true;
 }
 
+void BatchLogProcessor::PrepareFork()
+{
+  // Released by ParentAfterFork or ChildAfterFork.
+  shutdown_m_.lock();
+  if (worker_thread_.joinable())
+  {
+    synchronizer_.RequestPause();
+    worker_thread_.join();
+  }
+  else if (worker_task_ != nullptr)
+  {
+    executor_->SuspendTask(worker_task_);
+  }
+  synchronizer_.PrepareFork();
+}
+
+void BatchLogProcessor::ParentAfterFork()
+{
+  synchronizer_.ParentAfterFork();
+  if (is_shutdown_.load() == false && is_worker_started_.load() == true)
+  {
+    RestartWorker();
+  }
+  shutdown_m_.unlock();
+}
+
+void BatchLogProcessor::ChildAfterFork()
+{
+  synchronizer_.ChildAfterFork();
+  if (is_shutdown_.load() == false && is_worker_started_.load() == true)
+  {
+    buffer_.Clear();
+    RestartWorker();
+  }
+  shutdown_m_.unlock();
+}
+
+void BatchLogProcessor::RestartWorker()
+{
+  if (worker_task_ != nullptr)
+  {
+    worker_timeout_ = scheduled_delay_millis_;
+    executor_->ResumeTask(worker_task_, worker_timeout_);
+    return;
+  }
+  worker_thread_ = std::thread(&BatchLogProcessor::DoBackgroundWork, this);
+}
+
+common::BatchProcessorStats BatchLogProcessor::GetStats() const noexcept
+{
+  common::BatchProcessorStats stats = stats_.GetStats();
+  stats.enqueued                    = buffer_.production_count();
+  stats.queue_size                  = buffer_.size();
+  stats.max_queue_size              = buffer_.max_size();
+  return stats;
+}
+
 BatchLogProcessor::~BatchLogProcessor()
 {
   if (is_shutdown_.load() == false)
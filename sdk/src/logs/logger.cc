@@ -3,9 +3,10 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 #  include "opentelemetry/sdk/logs/logger.h"
+#  include "opentelemetry/sdk/common/tracepoint.h"
 #  include "opentelemetry/sdk/logs/log_record.h"
 #  include "opentelemetry/sdk_config.h"
-#  include "opentelemetry/trace/provider.h"
+#  include "opentelemetry/trace/tracer.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -43,15 +44,15 @@ void Logger::Log(opentelemetry::logs::Severity severity,
                  trace_api::TraceFlags trace_flags,
                  common::SystemTimestamp timestamp) noexcept
 {
-  // If this logger does not have a processor, no need to create a log record
-  if (!context_)
+  // If this logger does not have a processor, or the severity is below the minimum severity of
+  // the logger, no need to create a log record
+  if (!Enabled(severity))
   {
     return;
   }
+  OTEL_SDK_TRACEPOINT1(log__emit, static_cast<int>(severity));
   auto &processor = context_->GetProcessor();
 
-  // TODO: Sampler (should include check for minSeverity)
-
   auto recordable = processor.MakeRecordable();
   if (recordable == nullptr)
   {
@@ -73,9 +74,7 @@ void Logger::Log(opentelemetry::logs::Severity severity,
   });
 
   // Inject trace_id/span_id/trace_flags if none is set by user
-  auto provider     = trace_api::Provider::GetTracerProvider();
-  auto tracer       = provider->GetTracer(logger_name_);
-  auto span_context = tracer->GetCurrentSpan()->GetContext();
+  trace_api::SpanContext span_context = trace_api::Tracer::GetCurrentSpanContext();
 
   // Leave these fields in the recordable empty if neither the passed in values
   // nor the context values are valid (e.g. the application is not using traces)
@@ -61,49 +61,25 @@ nostd::shared_ptr<opentelemetry::logs::Logger> LoggerProvider::GetLogger(
     nostd::string_view library_version,
     nostd::string_view schema_url) noexcept
 {
-  // Ensure only one thread can read/write from the map of loggers
-  std::lock_guard<std::mutex> lock_guard{lock_};
-
-  // If a logger with a name "logger_name" already exists, return it
-  for (auto &logger : loggers_)
-  {
-    auto &logger_lib = logger->GetInstrumentationLibrary();
-    if (logger->GetName() == logger_name &&
-        logger_lib.equal(library_name, library_version, schema_url))
-    {
-      return nostd::shared_ptr<opentelemetry::logs::Logger>{logger};
-    }
-  }
-
-  // Check if creating a new logger would exceed the max number of loggers
-  // TODO: Remove the noexcept from the API's and SDK's GetLogger(~)
-  /*
-  if (loggers_.size() > MAX_LOGGER_COUNT)
-  {
-#if __EXCEPTIONS
-    throw std::length_error("Number of loggers exceeds max count");
-#else
-    std::terminate();
-#endif
-  }
-  */
-
   // https://github.com/open-telemetry/opentelemetry-specification/blob/main/specification/logs/data-model.md#field-instrumentationscope
-  opentelemetry::nostd::unique_ptr<instrumentationlibrary::InstrumentationLibrary> lib;
   if (library_name.empty())
   {
-    lib = instrumentationlibrary::InstrumentationLibrary::Create(logger_name, library_version,
-                                                                 schema_url);
-  }
-  else
-  {
-    lib = instrumentationlibrary::InstrumentationLibrary::Create(library_name, library_version,
-                                                                 schema_url);
+    library_name = logger_name;
   }
 
-  loggers_.push_back(std::shared_ptr<opentelemetry::sdk::logs::Logger>(
-      new Logger(logger_name, context_, std::move(lib))));
-  return nostd::shared_ptr<opentelemetry::logs::Logger>{loggers_.back()};
+  // If a logger with a name "logger_name" already exists, return it
+  size_t hash = loggers_.Hash(library_name, library_version, schema_url, logger_name);
+  return nostd::shared_ptr<opentelemetry::logs::Logger>{loggers_.FindOrInsert(
+      hash,
+      [&](Logger &logger) {
+        return logger.GetName() == logger_name &&
+               logger.GetInstrumentationLibrary().equal(library_name, library_version, schema_url);
+      },
+      [&]() {
+        auto lib = instrumentationlibrary::InstrumentationLibrary::Create(
+            library_name, library_version, schema_url);
+        return std::shared_ptr<Logger>(new Logger(logger_name, context_, std::move(lib)));
+      })};
 }
 
 nostd::shared_ptr<opentelemetry::logs::Logger> LoggerProvider::GetLogger(
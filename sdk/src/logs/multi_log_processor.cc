@@ -4,8 +4,13 @@
 #ifdef ENABLE_LOGS_PREVIEW
 
 #  include "opentelemetry/sdk/logs/multi_log_processor.h"
+#  include "opentelemetry/sdk/common/global_log_handler.h"
+#  include "opentelemetry/sdk/common/shared_deadline.h"
+#  include "opentelemetry/sdk/logs/pooled_log_record.h"
+#  include "opentelemetry/sdk/logs/shared_log_record.h"
 
 #  include <chrono>
+#  include <functional>
 #  include <memory>
 #  include <vector>
 
@@ -15,7 +20,9 @@ namespace sdk
 namespace logs
 {
 
-MultiLogProcessor::MultiLogProcessor(std::vector<std::unique_ptr<LogProcessor>> &&processors)
+MultiLogProcessor::MultiLogProcessor(std::vector<std::unique_ptr<LogProcessor>> &&processors,
+                                     const MultiLogProcessorOptions &options)
+    : fan_out_(options.fan_out)
 {
   for (auto &processor : processors)
   {
@@ -39,6 +46,10 @@ void MultiLogProcessor::AddProcessor(std::unique_ptr<LogProcessor> &&processor)
 
 std::unique_ptr<Recordable> MultiLogProcessor::MakeRecordable() noexcept
 {
+  if (fan_out_)
+  {
+    return std::unique_ptr<Recordable>(new PooledLogRecord());
+  }
   auto recordable       = std::unique_ptr<Recordable>(new MultiRecordable);
   auto multi_recordable = static_cast<MultiRecordable *>(recordable.get());
   for (auto &processor : processors_)
@@ -54,6 +65,15 @@ void MultiLogProcessor::OnReceive(std::unique_ptr<Recordable> &&record) noexcept
   {
     return;
   }
+  if (fan_out_)
+  {
+    std::shared_ptr<const PooledLogRecord> shared(static_cast<PooledLogRecord *>(record.release()));
+    for (auto &processor : processors_)
+    {
+      processor->OnReceive(std::unique_ptr<Recordable>(new SharedLogRecord(shared)));
+    }
+    return;
+  }
   auto multi_recordable = static_cast<MultiRecordable *>(record.get());
 
   for (auto &processor : processors_)
@@ -68,77 +88,38 @@ void MultiLogProcessor::OnReceive(std::unique_ptr<Recordable> &&record) noexcept
 
 bool MultiLogProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
 {
-  // Converto nanos to prevent overflow
-  std::chrono::nanoseconds timeout_ns = std::chrono::nanoseconds::max();
-  if (std::chrono::duration_cast<std::chrono::microseconds>(timeout_ns) > timeout)
-  {
-    timeout_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout);
-  }
-  bool result           = true;
-  auto start_time       = std::chrono::system_clock::now();
-  auto overflow_checker = std::chrono::system_clock::time_point::max();
-  std::chrono::system_clock::time_point expire_time;
-  if (overflow_checker - start_time <= timeout_ns)
-  {
-    expire_time = overflow_checker;
-  }
-  else
-  {
-    expire_time =
-        start_time + std::chrono::duration_cast<std::chrono::system_clock::duration>(timeout_ns);
-  }
-  for (auto &processor : processors_)
-  {
-    if (!processor->ForceFlush(std::chrono::duration_cast<std::chrono::microseconds>(timeout_ns)))
-    {
-      result = false;
-    }
-    start_time = std::chrono::system_clock::now();
-    if (expire_time > start_time)
-    {
-      timeout_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(expire_time - start_time);
-    }
-    else
-    {
-      timeout_ns = std::chrono::nanoseconds::zero();
-    }
-  }
-  return result;
+  return ForEachProcessorConcurrently(
+      "ForceFlush", timeout, [](LogProcessor &processor, std::chrono::microseconds remaining) {
+        return processor.ForceFlush(remaining);
+      });
 }
 
 bool MultiLogProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
 {
-  // Converto nanos to prevent overflow
-  std::chrono::nanoseconds timeout_ns = std::chrono::nanoseconds::max();
-  if (std::chrono::duration_cast<std::chrono::microseconds>(timeout_ns) > timeout)
-  {
-    timeout_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout);
-  }
-  bool result           = true;
-  auto start_time       = std::chrono::system_clock::now();
-  auto overflow_checker = std::chrono::system_clock::time_point::max();
-  std::chrono::system_clock::time_point expire_time;
-  if (overflow_checker - start_time <= timeout_ns)
-  {
-    expire_time = overflow_checker;
-  }
-  else
-  {
-    expire_time =
-        start_time + std::chrono::duration_cast<std::chrono::system_clock::duration>(timeout_ns);
-  }
-  for (auto &processor : processors_)
+  return ForEachProcessorConcurrently(
+      "Shutdown", timeout, [](LogProcessor &processor, std::chrono::microseconds remaining) {
+        return processor.Shutdown(remaining);
+      });
+}
+
+bool MultiLogProcessor::ForEachProcessorConcurrently(
+    const char *name,
+    std::chrono::microseconds timeout,
+    const std::function<bool(LogProcessor &, std::chrono::microseconds)> &operation) noexcept
+{
+  auto run = [&](size_t index, std::chrono::microseconds remaining) {
+    return operation(*processors_[index], remaining);
+  };
+  std::vector<bool> succeeded = common::RunWithSharedDeadline(processors_.size(), timeout, run);
+
+  bool result = true;
+  for (size_t i = 0; i < succeeded.size(); ++i)
   {
-    result |=
-        processor->Shutdown(std::chrono::duration_cast<std::chrono::microseconds>(timeout_ns));
-    start_time = std::chrono::system_clock::now();
-    if (expire_time > start_time)
-    {
-      timeout_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(expire_time - start_time);
-    }
-    else
+    if (!succeeded[i])
     {
-      timeout_ns = std::chrono::nanoseconds::zero();
+      OTEL_INTERNAL_LOG_WARN("[MultiLogProcessor::" << name << "] processor " << i
+                                                    << " failed or missed the deadline");
+      result = false;
     }
   }
   return result;
@@ -80,6 +80,14 @@ void MultiRecordable::SetBody(nostd::string_view message) noexcept
   }
 }
 
+void MultiRecordable::SetBodyValue(const opentelemetry::common::AttributeValue &message) noexcept
+{
+  for (auto &recordable : recordables_)
+  {
+    recordable.second->SetBodyValue(message);
+  }
+}
+
 void MultiRecordable::SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept
 {
   for (auto &recordable : recordables_)
@@ -0,0 +1,189 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef ENABLE_LOGS_PREVIEW
+#  include "opentelemetry/sdk/logs/pooled_log_record.h"
+
+#  include <algorithm>
+#  include <mutex>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace logs
+{
+namespace
+{
+/**
+ * Assigns an AttributeValue to an OwnedAttributeValue, reusing the memory of the string it
+ * already holds for string values.
+ */
+struct OwnedValueAssigner
+{
+  common::OwnedAttributeValue &target;
+
+  void operator()(nostd::string_view value)
+  {
+    if (nostd::holds_alternative<std::string>(target))
+    {
+      nostd::get<std::string>(target).assign(value.data(), value.size());
+    }
+    else
+    {
+      target = std::string(value.data(), value.size());
+    }
+  }
+
+  void operator()(const char *value) { (*this)(nostd::string_view(value)); }
+
+  template <class T>
+  void operator()(const T &value)
+  {
+    common::AttributeConverter converter;
+    target = converter(value);
+  }
+};
+}  // namespace
+
+void PooledLogRecord::SetBody(nostd::string_view message) noexcept
+{
+  OwnedValueAssigner{body_}(message);
+}
+
+void PooledLogRecord::SetBodyValue(const opentelemetry::common::AttributeValue &message) noexcept
+{
+  nostd::visit(OwnedValueAssigner{body_}, message);
+}
+
+void PooledLogRecord::SetAttribute(nostd::string_view key,
+                                   const opentelemetry::common::AttributeValue &value) noexcept
+{
+  for (size_t i = 0; i < attribute_count_; ++i)
+  {
+    Attribute &attribute = GetAttribute(i);
+    if (attribute.key.size() == key.size() &&
+        attribute.key.compare(0, key.size(), key.data(), key.size()) == 0)
+    {
+      nostd::visit(OwnedValueAssigner{attribute.value}, value);
+      return;
+    }
+  }
+
+  if (attribute_count_ >= kInlineAttributes + overflow_attributes_.size())
+  {
+    overflow_attributes_.emplace_back();
+  }
+  Attribute &attribute = GetAttribute(attribute_count_++);
+  attribute.key.assign(key.data(), key.size());
+  nostd::visit(OwnedValueAssigner{attribute.value}, value);
+}
+
+void PooledLogRecord::ForEachAttribute(
+    nostd::function_ref<bool(nostd::string_view, const common::OwnedAttributeValue &)> callback)
+    const noexcept
+{
+  for (size_t i = 0; i < attribute_count_; ++i)
+  {
+    const Attribute &attribute = GetAttribute(i);
+    if (!callback(attribute.key, attribute.value))
+    {
+      return;
+    }
+  }
+}
+
+void PooledLogRecord::Replay(Recordable &target) const noexcept
+{
+  target.SetTimestamp(timestamp_);
+  target.SetSeverity(severity_);
+  common::ViewAttributeValue(body_, [&](const opentelemetry::common::AttributeValue &body) {
+    target.SetBodyValue(body);
+  });
+  if (resource_ != nullptr)
+  {
+    target.SetResource(*resource_);
+  }
+  for (size_t i = 0; i < attribute_count_; ++i)
+  {
+    const Attribute &attribute = GetAttribute(i);
+    common::ViewAttributeValue(attribute.value,
+                               [&](const opentelemetry::common::AttributeValue &value) {
+                                 target.SetAttribute(attribute.key, value);
+                               });
+  }
+  target.SetTraceId(trace_id_);
+  target.SetSpanId(span_id_);
+  target.SetTraceFlags(trace_flags_);
+  if (instrumentation_library_ != nullptr)
+  {
+    target.SetInstrumentationLibrary(*instrumentation_library_);
+  }
+}
+
+bool PooledLogRecord::Reset() noexcept
+{
+  timestamp_ = opentelemetry::common::SystemTimestamp();
+  severity_  = opentelemetry::logs::Severity::kInvalid;
+  if (nostd::holds_alternative<std::string>(body_))
+  {
+    nostd::get<std::string>(body_).clear();
+  }
+  else
+  {
+    body_ = std::string();
+  }
+  resource_                = nullptr;
+  trace_id_                = opentelemetry::trace::TraceId();
+  span_id_                 = opentelemetry::trace::SpanId();
+  trace_flags_             = opentelemetry::trace::TraceFlags();
+  instrumentation_library_ = nullptr;
+  // The keys and values are overwritten when the attributes are set again.
+  attribute_count_ = 0;
+  return true;
+}
+
+std::unique_ptr<Recordable> LogRecordPool::MakeRecordable() noexcept
+{
+  {
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    if (!free_records_.empty())
+    {
+      std::unique_ptr<Recordable> record(std::move(free_records_.back()));
+      free_records_.pop_back();
+      return record;
+    }
+  }
+  return std::unique_ptr<Recordable>(new PooledLogRecord());
+}
+
+void LogRecordPool::Recycle(nostd::span<std::unique_ptr<Recordable>> records) noexcept
+{
+  for (auto &record : records)
+  {
+    if (record != nullptr)
+    {
+      static_cast<PooledLogRecord *>(record.get())->Reset();
+    }
+  }
+
+  std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+  for (auto &record : records)
+  {
+    if (record == nullptr || free_records_.size() >= max_size_)
+    {
+      continue;
+    }
+    free_records_.emplace_back(static_cast<PooledLogRecord *>(record.release()));
+  }
+}
+
+size_t LogRecordPool::GetSize() const noexcept
+{
+  std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+  return free_records_.size();
+}
+
+}  // namespace logs
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
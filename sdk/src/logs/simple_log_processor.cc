@@ -3,6 +3,7 @@
 
 #ifdef ENABLE_LOGS_PREVIEW
 #  include "opentelemetry/sdk/logs/simple_log_processor.h"
+#  include "opentelemetry/sdk/logs/shared_log_record.h"
 
 #  include <chrono>
 #  include <vector>
@@ -17,7 +18,8 @@ namespace logs
  * @param exporter the configured exporter where log records are sent
  */
 SimpleLogProcessor::SimpleLogProcessor(std::unique_ptr<LogExporter> &&exporter)
-    : exporter_(std::move(exporter))
+    : exporter_(std::move(exporter)),
+      concurrent_export_(exporter_ != nullptr && exporter_->IsExportThreadSafe())
 {}
 
 std::unique_ptr<Recordable> SimpleLogProcessor::MakeRecordable() noexcept
@@ -31,14 +33,25 @@ std::unique_ptr<Recordable> SimpleLogProcessor::MakeRecordable() noexcept
  */
 void SimpleLogProcessor::OnReceive(std::unique_ptr<Recordable> &&record) noexcept
 {
+  ResolveSharedRecordable(record, [this] { return exporter_->MakeRecordable(); });
   nostd::span<std::unique_ptr<Recordable>> batch(&record, 1);
+  if (concurrent_export_)
+  {
+    ExportBatch(batch);
+    return;
+  }
   // Get lock to ensure Export() is never called concurrently
   const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  ExportBatch(batch);
+}
 
+void SimpleLogProcessor::ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch) noexcept
+{
   if (exporter_->Export(batch) != sdk::common::ExportResult::kSuccess)
   {
     /* Alert user of the failed export */
   }
+  exporter_->Recycle(batch);
 }
 /**
  *  The simple processor does not have any log records to flush so this method is not used
@@ -0,0 +1,398 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/aggregation/exponential_histogram_aggregation.h"
+#  include "opentelemetry/version.h"
+
+#  include <cmath>
+#  include <cstring>
+#  include <mutex>
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+namespace
+{
+
+constexpr uint64_t kMantissaMask = (static_cast<uint64_t>(1) << 52) - 1;
+constexpr uint64_t kExponentMask = 0x7ff;
+constexpr int32_t kExponentShift = 52;
+constexpr int32_t kExponentBias  = 1023;
+
+/**
+ * @return the number of times the index range [low, high] must be halved to fit in `max_size`
+ * buckets.
+ */
+int32_t ScaleChange(int64_t low, int64_t high, size_t max_size) noexcept
+{
+  int32_t change = 0;
+  while (high - low >= static_cast<int64_t>(max_size))
+  {
+    low >>= 1;
+    high >>= 1;
+    ++change;
+  }
+  return change;
+}
+
+/**
+ * Widens [low, high] so that it also covers the indexes used by `buckets`.
+ */
+void ExtendRange(const ExponentialHistogramBuckets &buckets, int64_t &low, int64_t &high) noexcept
+{
+  if (buckets.counts_.empty())
+  {
+    return;
+  }
+  int64_t first = buckets.offset_;
+  int64_t last  = first + static_cast<int64_t>(buckets.counts_.size()) - 1;
+  low           = first < low ? first : low;
+  high          = last > high ? last : high;
+}
+
+/**
+ * @return the scale change that lets both `a` and `b` fit in `max_size` buckets at once.
+ */
+int32_t ScaleChange(const ExponentialHistogramBuckets &a,
+                    const ExponentialHistogramBuckets &b,
+                    size_t max_size) noexcept
+{
+  int64_t low  = INT64_MAX;
+  int64_t high = INT64_MIN;
+  ExtendRange(a, low, high);
+  ExtendRange(b, low, high);
+  return low > high ? 0 : ScaleChange(low, high, max_size);
+}
+
+void Downscale(ExponentialHistogramBuckets &buckets, int32_t change) noexcept
+{
+  if (change <= 0 || buckets.counts_.empty())
+  {
+    return;
+  }
+  int32_t offset = buckets.offset_ >> change;
+  int32_t last   = (buckets.offset_ + static_cast<int32_t>(buckets.counts_.size()) - 1) >> change;
+  std::vector<uint64_t> counts(static_cast<size_t>(last - offset + 1), 0);
+  for (size_t i = 0; i < buckets.counts_.size(); i++)
+  {
+    int32_t index = (buckets.offset_ + static_cast<int32_t>(i)) >> change;
+    counts[static_cast<size_t>(index - offset)] += buckets.counts_[i];
+  }
+  buckets.offset_ = offset;
+  buckets.counts_ = std::move(counts);
+}
+
+void AddToBucket(ExponentialHistogramBuckets &buckets, int32_t index, uint64_t count) noexcept
+{
+  if (buckets.counts_.empty())
+  {
+    buckets.offset_ = index;
+    buckets.counts_.assign(1, count);
+    return;
+  }
+  if (index < buckets.offset_)
+  {
+    buckets.counts_.insert(buckets.counts_.begin(), static_cast<size_t>(buckets.offset_ - index),
+                           0);
+    buckets.offset_ = index;
+  }
+  size_t position = static_cast<size_t>(index - buckets.offset_);
+  if (position >= buckets.counts_.size())
+  {
+    buckets.counts_.resize(position + 1, 0);
+  }
+  buckets.counts_[position] += count;
+}
+
+void AddBuckets(ExponentialHistogramBuckets &into, const ExponentialHistogramBuckets &from) noexcept
+{
+  for (size_t i = 0; i < from.counts_.size(); i++)
+  {
+    if (from.counts_[i] != 0)
+    {
+      AddToBucket(into, from.offset_ + static_cast<int32_t>(i), from.counts_[i]);
+    }
+  }
+}
+
+void SubtractBuckets(ExponentialHistogramBuckets &from,
+                     const ExponentialHistogramBuckets &buckets) noexcept
+{
+  for (size_t i = 0; i < buckets.counts_.size(); i++)
+  {
+    int64_t position =
+        static_cast<int64_t>(buckets.offset_) + static_cast<int64_t>(i) - from.offset_;
+    if (position >= 0 && position < static_cast<int64_t>(from.counts_.size()))
+    {
+      from.counts_[static_cast<size_t>(position)] -= buckets.counts_[i];
+    }
+  }
+}
+
+/**
+ * Brings `a` and `b` to a common scale at which the buckets of each sign of both fit in
+ * `max_size` buckets.
+ */
+void AlignScales(ExponentialHistogramPointData &a,
+                 ExponentialHistogramPointData &b,
+                 size_t max_size) noexcept
+{
+  int32_t scale = a.scale_ < b.scale_ ? a.scale_ : b.scale_;
+  ExponentialHistogramDownscale(a, a.scale_ - scale);
+  ExponentialHistogramDownscale(b, b.scale_ - scale);
+  int32_t positive_change = ScaleChange(a.positive_buckets_, b.positive_buckets_, max_size);
+  int32_t negative_change = ScaleChange(a.negative_buckets_, b.negative_buckets_, max_size);
+  int32_t change = positive_change > negative_change ? positive_change : negative_change;
+  ExponentialHistogramDownscale(a, change);
+  ExponentialHistogramDownscale(b, change);
+}
+
+}  // namespace
+
+int32_t ExponentialHistogramIndex(double value, int32_t scale) noexcept
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  int32_t exponent  = static_cast<int32_t>((bits >> kExponentShift) & kExponentMask);
+  uint64_t mantissa = bits & kMantissaMask;
+  if (exponent == 0)
+  {
+    // Subnormal: normalize through frexp, which returns a fraction in [0.5, 1).
+    int fraction_exponent;
+    double fraction = std::frexp(value, &fraction_exponent);
+    exponent        = static_cast<int32_t>(fraction_exponent) - 1;
+    mantissa        = fraction == 0.5 ? 0 : 1;
+  }
+  else
+  {
+    exponent -= kExponentBias;
+  }
+  if (scale <= 0)
+  {
+    // Exact powers of two are the upper bound of the bucket below: subtract one when the mantissa
+    // is zero, which (mantissa - 1) >> 63 yields without a branch.
+    int32_t correction = static_cast<int32_t>((mantissa - 1) >> 63);
+    return (exponent - correction) >> -scale;
+  }
+  if (mantissa == 0)
+  {
+    return exponent * (static_cast<int32_t>(1) << scale) - 1;
+  }
+  return static_cast<int32_t>(std::floor(std::ldexp(std::log2(value), scale)));
+}
+
+void ExponentialHistogramDownscale(ExponentialHistogramPointData &point, int32_t change) noexcept
+{
+  if (change <= 0)
+  {
+    return;
+  }
+  Downscale(point.positive_buckets_, change);
+  Downscale(point.negative_buckets_, change);
+  point.scale_ -= change;
+}
+
+template <class T>
+void ExponentialHistogramRecord(ExponentialHistogramPointData &point,
+                                T value,
+                                size_t max_size) noexcept
+{
+  double measurement = static_cast<double>(value);
+  if (!std::isfinite(measurement))
+  {
+    return;
+  }
+  point.count_ += 1;
+  point.sum_ = nostd::get<T>(point.sum_) + value;
+  if (measurement == 0)
+  {
+    point.zero_count_ += 1;
+    return;
+  }
+  auto &buckets = measurement > 0 ? point.positive_buckets_ : point.negative_buckets_;
+  int32_t index = ExponentialHistogramIndex(std::fabs(measurement), point.scale_);
+  int64_t low   = index;
+  int64_t high  = index;
+  ExtendRange(buckets, low, high);
+  int32_t change = ScaleChange(low, high, max_size);
+  if (change > 0)
+  {
+    ExponentialHistogramDownscale(point, change);
+    index >>= change;
+  }
+  AddToBucket(buckets, index, 1);
+}
+
+template <class T>
+void ExponentialHistogramMerge(ExponentialHistogramPointData &current,
+                               ExponentialHistogramPointData delta,
+                               size_t max_size) noexcept
+{
+  AlignScales(current, delta, max_size);
+  AddBuckets(current.positive_buckets_, delta.positive_buckets_);
+  AddBuckets(current.negative_buckets_, delta.negative_buckets_);
+  current.sum_ = nostd::get<T>(current.sum_) + nostd::get<T>(delta.sum_);
+  current.count_ += delta.count_;
+  current.zero_count_ += delta.zero_count_;
+}
+
+template <class T>
+void ExponentialHistogramDiff(ExponentialHistogramPointData current,
+                              ExponentialHistogramPointData &next,
+                              size_t max_size) noexcept
+{
+  AlignScales(current, next, max_size);
+  SubtractBuckets(next.positive_buckets_, current.positive_buckets_);
+  SubtractBuckets(next.negative_buckets_, current.negative_buckets_);
+  next.sum_ = nostd::get<T>(next.sum_) - nostd::get<T>(current.sum_);
+  next.count_ -= current.count_;
+  next.zero_count_ -= current.zero_count_;
+}
+
+template void ExponentialHistogramRecord<long>(ExponentialHistogramPointData &,
+                                               long,
+                                               size_t) noexcept;
+template void ExponentialHistogramRecord<double>(ExponentialHistogramPointData &,
+                                                 double,
+                                                 size_t) noexcept;
+template void ExponentialHistogramMerge<long>(ExponentialHistogramPointData &,
+                                              ExponentialHistogramPointData,
+                                              size_t) noexcept;
+template void ExponentialHistogramMerge<double>(ExponentialHistogramPointData &,
+                                                ExponentialHistogramPointData,
+                                                size_t) noexcept;
+template void ExponentialHistogramDiff<long>(ExponentialHistogramPointData,
+                                             ExponentialHistogramPointData &,
+                                             size_t) noexcept;
+template void ExponentialHistogramDiff<double>(ExponentialHistogramPointData,
+                                               ExponentialHistogramPointData &,
+                                               size_t) noexcept;
+
+LongExponentialHistogramAggregation::LongExponentialHistogramAggregation(size_t max_size)
+    : max_size_(max_size < 2 ? 2 : max_size)
+{
+  point_data_.sum_   = 0l;
+  point_data_.scale_ = kExponentialHistogramMaxScale;
+}
+
+LongExponentialHistogramAggregation::LongExponentialHistogramAggregation(
+    ExponentialHistogramPointData &&data)
+    : point_data_{std::move(data)}, max_size_(kExponentialHistogramMaxSize)
+{}
+
+LongExponentialHistogramAggregation::LongExponentialHistogramAggregation(
+    const ExponentialHistogramPointData &data)
+    : point_data_{data}, max_size_(kExponentialHistogramMaxSize)
+{}
+
+void LongExponentialHistogramAggregation::Aggregate(long value,
+                                                    const PointAttributes &attributes) noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  ExponentialHistogramRecord<long>(point_data_, value, max_size_);
+}
+
+std::unique_ptr<Aggregation> LongExponentialHistogramAggregation::Merge(
+    const Aggregation &delta) const noexcept
+{
+  auto curr_value  = nostd::get<ExponentialHistogramPointData>(ToPoint());
+  auto delta_value = nostd::get<ExponentialHistogramPointData>(
+      (static_cast<const LongExponentialHistogramAggregation &>(delta).ToPoint()));
+  ExponentialHistogramMerge<long>(curr_value, std::move(delta_value), max_size_);
+  auto aggr         = new LongExponentialHistogramAggregation(max_size_);
+  aggr->point_data_ = std::move(curr_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+void LongExponentialHistogramAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto delta_value = nostd::get<ExponentialHistogramPointData>(delta.ToPoint());
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  ExponentialHistogramMerge<long>(point_data_, std::move(delta_value), max_size_);
+}
+
+std::unique_ptr<Aggregation> LongExponentialHistogramAggregation::Diff(
+    const Aggregation &next) const noexcept
+{
+  auto curr_value = nostd::get<ExponentialHistogramPointData>(ToPoint());
+  auto next_value = nostd::get<ExponentialHistogramPointData>(
+      (static_cast<const LongExponentialHistogramAggregation &>(next).ToPoint()));
+  ExponentialHistogramDiff<long>(std::move(curr_value), next_value, max_size_);
+  auto aggr         = new LongExponentialHistogramAggregation(max_size_);
+  aggr->point_data_ = std::move(next_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+PointType LongExponentialHistogramAggregation::ToPoint() const noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  return point_data_;
+}
+
+DoubleExponentialHistogramAggregation::DoubleExponentialHistogramAggregation(size_t max_size)
+    : max_size_(max_size < 2 ? 2 : max_size)
+{
+  point_data_.sum_   = 0.0;
+  point_data_.scale_ = kExponentialHistogramMaxScale;
+}
+
+DoubleExponentialHistogramAggregation::DoubleExponentialHistogramAggregation(
+    ExponentialHistogramPointData &&data)
+    : point_data_{std::move(data)}, max_size_(kExponentialHistogramMaxSize)
+{}
+
+DoubleExponentialHistogramAggregation::DoubleExponentialHistogramAggregation(
+    const ExponentialHistogramPointData &data)
+    : point_data_{data}, max_size_(kExponentialHistogramMaxSize)
+{}
+
+void DoubleExponentialHistogramAggregation::Aggregate(double value,
+                                                      const PointAttributes &attributes) noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  ExponentialHistogramRecord<double>(point_data_, value, max_size_);
+}
+
+std::unique_ptr<Aggregation> DoubleExponentialHistogramAggregation::Merge(
+    const Aggregation &delta) const noexcept
+{
+  auto curr_value  = nostd::get<ExponentialHistogramPointData>(ToPoint());
+  auto delta_value = nostd::get<ExponentialHistogramPointData>(
+      (static_cast<const DoubleExponentialHistogramAggregation &>(delta).ToPoint()));
+  ExponentialHistogramMerge<double>(curr_value, std::move(delta_value), max_size_);
+  auto aggr         = new DoubleExponentialHistogramAggregation(max_size_);
+  aggr->point_data_ = std::move(curr_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+void DoubleExponentialHistogramAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto delta_value = nostd::get<ExponentialHistogramPointData>(delta.ToPoint());
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  ExponentialHistogramMerge<double>(point_data_, std::move(delta_value), max_size_);
+}
+
+std::unique_ptr<Aggregation> DoubleExponentialHistogramAggregation::Diff(
+    const Aggregation &next) const noexcept
+{
+  auto curr_value = nostd::get<ExponentialHistogramPointData>(ToPoint());
+  auto next_value = nostd::get<ExponentialHistogramPointData>(
+      (static_cast<const DoubleExponentialHistogramAggregation &>(next).ToPoint()));
+  ExponentialHistogramDiff<double>(std::move(curr_value), next_value, max_size_);
+  auto aggr         = new DoubleExponentialHistogramAggregation(max_size_);
+  aggr->point_data_ = std::move(next_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+PointType DoubleExponentialHistogramAggregation::ToPoint() const noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  return point_data_;
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
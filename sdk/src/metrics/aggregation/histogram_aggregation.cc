@@ -14,37 +14,40 @@ namespace metrics
 
 LongHistogramAggregation::LongHistogramAggregation()
 {
-  point_data_.boundaries_ = std::list<long>{0l, 5l, 10l, 25l, 50l, 75l, 100l, 250l, 500l, 1000l};
-  point_data_.counts_ =
-      std::vector<uint64_t>(nostd::get<std::list<long>>(point_data_.boundaries_).size() + 1, 0);
-  point_data_.sum_   = 0l;
-  point_data_.count_ = 0;
+  // Shared by all the series of the default histograms.
+  static const HistogramBoundaries<long> default_boundaries{0l,  5l,   10l,  25l,  50l,
+                                                            75l, 100l, 250l, 500l, 1000l};
+  point_data_.boundaries_ = default_boundaries;
+  point_data_.counts_     = std::vector<uint64_t>(default_boundaries.size() + 1, 0);
+  point_data_.sum_        = 0l;
+  point_data_.count_      = 0;
+  bucket_boundaries_      = &nostd::get<HistogramBoundaries<long>>(point_data_.boundaries_).get();
 }
 
 LongHistogramAggregation::LongHistogramAggregation(HistogramPointData &&data)
-    : point_data_{std::move(data)}
+    : point_data_{std::move(data)},
+      bucket_boundaries_{&nostd::get<HistogramBoundaries<long>>(point_data_.boundaries_).get()}
 {}
 
 LongHistogramAggregation::LongHistogramAggregation(const HistogramPointData &data)
-    : point_data_{data}
+    : point_data_{data},
+      bucket_boundaries_{&nostd::get<HistogramBoundaries<long>>(point_data_.boundaries_).get()}
 {}
 
 void LongHistogramAggregation::Aggregate(long value, const PointAttributes &attributes) noexcept
 {
   const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.count_ += 1;
-  point_data_.sum_ = nostd::get<long>(point_data_.sum_) + value;
-  size_t index     = 0;
-  for (auto it = nostd::get<std::list<long>>(point_data_.boundaries_).begin();
-       it != nostd::get<std::list<long>>(point_data_.boundaries_).end(); ++it)
+  if (point_data_.count_ == 0 || value < nostd::get<long>(point_data_.min_))
   {
-    if (value < *it)
-    {
-      point_data_.counts_[index] += 1;
-      return;
-    }
-    index++;
+    point_data_.min_ = value;
   }
+  if (point_data_.count_ == 0 || value > nostd::get<long>(point_data_.max_))
+  {
+    point_data_.max_ = value;
+  }
+  point_data_.count_ += 1;
+  point_data_.sum_ = nostd::get<long>(point_data_.sum_) + value;
+  point_data_.counts_[HistogramBucketIndex(*bucket_boundaries_, value)] += 1;
 }
 
 std::unique_ptr<Aggregation> LongHistogramAggregation::Merge(
@@ -53,9 +56,17 @@ std::unique_ptr<Aggregation> LongHistogramAggregation::Merge(
   auto curr_value  = nostd::get<HistogramPointData>(ToPoint());
   auto delta_value = nostd::get<HistogramPointData>(
       (static_cast<const LongHistogramAggregation &>(delta).ToPoint()));
-  LongHistogramAggregation *aggr = new LongHistogramAggregation();
-  HistogramMerge<long>(curr_value, delta_value, aggr->point_data_);
-  return std::unique_ptr<Aggregation>(aggr);
+  HistogramPointData result_value = curr_value;
+  HistogramMerge<long>(curr_value, delta_value, result_value);
+  return std::unique_ptr<Aggregation>(new LongHistogramAggregation(std::move(result_value)));
+}
+
+void LongHistogramAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto &other = static_cast<const LongHistogramAggregation &>(delta);
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> other_locked(other.lock_);
+  HistogramMerge<long>(point_data_, other.point_data_, point_data_);
 }
 
 std::unique_ptr<Aggregation> LongHistogramAggregation::Diff(const Aggregation &next) const noexcept
@@ -63,9 +74,9 @@ std::unique_ptr<Aggregation> LongHistogramAggregation::Diff(const Aggregation &n
   auto curr_value = nostd::get<HistogramPointData>(ToPoint());
   auto next_value = nostd::get<HistogramPointData>(
       (static_cast<const LongHistogramAggregation &>(next).ToPoint()));
-  LongHistogramAggregation *aggr = new LongHistogramAggregation();
-  HistogramDiff<long>(curr_value, next_value, aggr->point_data_);
-  return std::unique_ptr<Aggregation>(aggr);
+  HistogramPointData result_value = curr_value;
+  HistogramDiff<long>(curr_value, next_value, result_value);
+  return std::unique_ptr<Aggregation>(new LongHistogramAggregation(std::move(result_value)));
 }
 
 PointType LongHistogramAggregation::ToPoint() const noexcept
@@ -75,38 +86,40 @@ PointType LongHistogramAggregation::ToPoint() const noexcept
 
 DoubleHistogramAggregation::DoubleHistogramAggregation()
 {
-  point_data_.boundaries_ =
-      std::list<double>{0.0, 5.0, 10.0, 25.0, 50.0, 75.0, 100.0, 250.0, 500.0, 1000.0};
-  point_data_.counts_ =
-      std::vector<uint64_t>(nostd::get<std::list<double>>(point_data_.boundaries_).size() + 1, 0);
-  point_data_.sum_   = 0.0;
-  point_data_.count_ = 0;
+  // Shared by all the series of the default histograms.
+  static const HistogramBoundaries<double> default_boundaries{0.0,   5.0,   10.0,  25.0,  50.0,
+                                                              75.0,  100.0, 250.0, 500.0, 1000.0};
+  point_data_.boundaries_ = default_boundaries;
+  point_data_.counts_     = std::vector<uint64_t>(default_boundaries.size() + 1, 0);
+  point_data_.sum_        = 0.0;
+  point_data_.count_      = 0;
+  bucket_boundaries_      = &nostd::get<HistogramBoundaries<double>>(point_data_.boundaries_).get();
 }
 
 DoubleHistogramAggregation::DoubleHistogramAggregation(HistogramPointData &&data)
-    : point_data_{std::move(data)}
+    : point_data_{std::move(data)},
+      bucket_boundaries_{&nostd::get<HistogramBoundaries<double>>(point_data_.boundaries_).get()}
 {}
 
 DoubleHistogramAggregation::DoubleHistogramAggregation(const HistogramPointData &data)
-    : point_data_{data}
+    : point_data_{data},
+      bucket_boundaries_{&nostd::get<HistogramBoundaries<double>>(point_data_.boundaries_).get()}
 {}
 
 void DoubleHistogramAggregation::Aggregate(double value, const PointAttributes &attributes) noexcept
 {
   const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.count_ += 1;
-  point_data_.sum_ = nostd::get<double>(point_data_.sum_) + value;
-  size_t index     = 0;
-  for (auto it = nostd::get<std::list<double>>(point_data_.boundaries_).begin();
-       it != nostd::get<std::list<double>>(point_data_.boundaries_).end(); ++it)
+  if (point_data_.count_ == 0 || value < nostd::get<double>(point_data_.min_))
   {
-    if (value < *it)
-    {
-      point_data_.counts_[index] += 1;
-      return;
-    }
-    index++;
+    point_data_.min_ = value;
   }
+  if (point_data_.count_ == 0 || value > nostd::get<double>(point_data_.max_))
+  {
+    point_data_.max_ = value;
+  }
+  point_data_.count_ += 1;
+  point_data_.sum_ = nostd::get<double>(point_data_.sum_) + value;
+  point_data_.counts_[HistogramBucketIndex(*bucket_boundaries_, value)] += 1;
 }
 
 std::unique_ptr<Aggregation> DoubleHistogramAggregation::Merge(
@@ -115,9 +128,17 @@ std::unique_ptr<Aggregation> DoubleHistogramAggregation::Merge(
   auto curr_value  = nostd::get<HistogramPointData>(ToPoint());
   auto delta_value = nostd::get<HistogramPointData>(
       (static_cast<const DoubleHistogramAggregation &>(delta).ToPoint()));
-  DoubleHistogramAggregation *aggr = new DoubleHistogramAggregation();
-  HistogramMerge<double>(curr_value, delta_value, aggr->point_data_);
-  return std::unique_ptr<Aggregation>(aggr);
+  HistogramPointData result_value = curr_value;
+  HistogramMerge<double>(curr_value, delta_value, result_value);
+  return std::unique_ptr<Aggregation>(new DoubleHistogramAggregation(std::move(result_value)));
+}
+
+void DoubleHistogramAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto &other = static_cast<const DoubleHistogramAggregation &>(delta);
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> other_locked(other.lock_);
+  HistogramMerge<double>(point_data_, other.point_data_, point_data_);
 }
 
 std::unique_ptr<Aggregation> DoubleHistogramAggregation::Diff(
@@ -126,9 +147,9 @@ std::unique_ptr<Aggregation> DoubleHistogramAggregation::Diff(
   auto curr_value = nostd::get<HistogramPointData>(ToPoint());
   auto next_value = nostd::get<HistogramPointData>(
       (static_cast<const DoubleHistogramAggregation &>(next).ToPoint()));
-  DoubleHistogramAggregation *aggr = new DoubleHistogramAggregation();
-  HistogramDiff<double>(curr_value, next_value, aggr->point_data_);
-  return std::unique_ptr<Aggregation>(aggr);
+  HistogramPointData result_value = curr_value;
+  HistogramDiff<double>(curr_value, next_value, result_value);
+  return std::unique_ptr<Aggregation>(new DoubleHistogramAggregation(std::move(result_value)));
 }
 
 PointType DoubleHistogramAggregation::ToPoint() const noexcept
@@ -6,7 +6,6 @@
 #  include "opentelemetry/common/timestamp.h"
 #  include "opentelemetry/version.h"
 
-#  include <mutex>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -15,24 +14,25 @@ namespace metrics
 {
 
 LongLastValueAggregation::LongLastValueAggregation()
-{
-  point_data_.is_lastvalue_valid_ = false;
-  point_data_.value_              = 0l;
-}
+    : value_(0l), is_lastvalue_valid_(false), sample_ts_{}
+{}
 
 LongLastValueAggregation::LongLastValueAggregation(LastValuePointData &&data)
-    : point_data_{std::move(data)}
+    : value_(nostd::get<long>(data.value_)),
+      is_lastvalue_valid_(data.is_lastvalue_valid_),
+      sample_ts_(data.sample_ts_)
 {}
 
 LongLastValueAggregation::LongLastValueAggregation(const LastValuePointData &data)
-    : point_data_{data}
+    : value_(nostd::get<long>(data.value_)),
+      is_lastvalue_valid_(data.is_lastvalue_valid_),
+      sample_ts_(data.sample_ts_)
 {}
 
 void LongLastValueAggregation::Aggregate(long value, const PointAttributes &attributes) noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.is_lastvalue_valid_ = true;
-  point_data_.value_              = value;
+  value_.store(value, std::memory_order_relaxed);
+  is_lastvalue_valid_.store(true, std::memory_order_release);
 }
 
 std::unique_ptr<Aggregation> LongLastValueAggregation::Merge(
@@ -51,6 +51,20 @@ std::unique_ptr<Aggregation> LongLastValueAggregation::Merge(
   }
 }
 
+void LongLastValueAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto &other = static_cast<const LongLastValueAggregation &>(delta);
+  // Like Merge, keep this value only if it is the more recent one.
+  if (!other.is_lastvalue_valid_.load(std::memory_order_acquire) ||
+      sample_ts_.time_since_epoch() > other.sample_ts_.time_since_epoch())
+  {
+    return;
+  }
+  value_.store(other.value_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  sample_ts_ = other.sample_ts_;
+  is_lastvalue_valid_.store(true, std::memory_order_release);
+}
+
 std::unique_ptr<Aggregation> LongLastValueAggregation::Diff(const Aggregation &next) const noexcept
 {
   if (nostd::get<LastValuePointData>(ToPoint()).sample_ts_.time_since_epoch() >
@@ -68,28 +82,33 @@ std::unique_ptr<Aggregation> LongLastValueAggregation::Diff(const Aggregation &n
 
 PointType LongLastValueAggregation::ToPoint() const noexcept
 {
-  return point_data_;
+  LastValuePointData point_data;
+  point_data.is_lastvalue_valid_ = is_lastvalue_valid_.load(std::memory_order_acquire);
+  point_data.value_              = value_.load(std::memory_order_relaxed);
+  point_data.sample_ts_          = sample_ts_;
+  return point_data;
 }
 
 DoubleLastValueAggregation::DoubleLastValueAggregation()
-{
-  point_data_.is_lastvalue_valid_ = false;
-  point_data_.value_              = 0.0;
-}
+    : value_(0.0), is_lastvalue_valid_(false), sample_ts_{}
+{}
 
 DoubleLastValueAggregation::DoubleLastValueAggregation(LastValuePointData &&data)
-    : point_data_{std::move(data)}
+    : value_(nostd::get<double>(data.value_)),
+      is_lastvalue_valid_(data.is_lastvalue_valid_),
+      sample_ts_(data.sample_ts_)
 {}
 
 DoubleLastValueAggregation::DoubleLastValueAggregation(const LastValuePointData &data)
-    : point_data_{data}
+    : value_(nostd::get<double>(data.value_)),
+      is_lastvalue_valid_(data.is_lastvalue_valid_),
+      sample_ts_(data.sample_ts_)
 {}
 
 void DoubleLastValueAggregation::Aggregate(double value, const PointAttributes &attributes) noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.is_lastvalue_valid_ = true;
-  point_data_.value_              = value;
+  value_.store(value, std::memory_order_relaxed);
+  is_lastvalue_valid_.store(true, std::memory_order_release);
 }
 
 std::unique_ptr<Aggregation> DoubleLastValueAggregation::Merge(
@@ -99,13 +118,27 @@ std::unique_ptr<Aggregation> DoubleLastValueAggregation::Merge(
       nostd::get<LastValuePointData>(delta.ToPoint()).sample_ts_.time_since_epoch())
   {
     LastValuePointData merge_data = std::move(nostd::get<LastValuePointData>(ToPoint()));
-    return std::unique_ptr<Aggregation>(new LongLastValueAggregation(std::move(merge_data)));
+    return std::unique_ptr<Aggregation>(new DoubleLastValueAggregation(std::move(merge_data)));
   }
   else
   {
     LastValuePointData merge_data = std::move(nostd::get<LastValuePointData>(delta.ToPoint()));
-    return std::unique_ptr<Aggregation>(new LongLastValueAggregation(std::move(merge_data)));
+    return std::unique_ptr<Aggregation>(new DoubleLastValueAggregation(std::move(merge_data)));
+  }
+}
+
+void DoubleLastValueAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto &other = static_cast<const DoubleLastValueAggregation &>(delta);
+  // Like Merge, keep this value only if it is the more recent one.
+  if (!other.is_lastvalue_valid_.load(std::memory_order_acquire) ||
+      sample_ts_.time_since_epoch() > other.sample_ts_.time_since_epoch())
+  {
+    return;
   }
+  value_.store(other.value_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  sample_ts_ = other.sample_ts_;
+  is_lastvalue_valid_.store(true, std::memory_order_release);
 }
 
 std::unique_ptr<Aggregation> DoubleLastValueAggregation::Diff(
@@ -115,18 +148,22 @@ std::unique_ptr<Aggregation> DoubleLastValueAggregation::Diff(
       nostd::get<LastValuePointData>(next.ToPoint()).sample_ts_.time_since_epoch())
   {
     LastValuePointData diff_data = std::move(nostd::get<LastValuePointData>(ToPoint()));
-    return std::unique_ptr<Aggregation>(new LongLastValueAggregation(std::move(diff_data)));
+    return std::unique_ptr<Aggregation>(new DoubleLastValueAggregation(std::move(diff_data)));
   }
   else
   {
     LastValuePointData diff_data = std::move(nostd::get<LastValuePointData>(next.ToPoint()));
-    return std::unique_ptr<Aggregation>(new LongLastValueAggregation(std::move(diff_data)));
+    return std::unique_ptr<Aggregation>(new DoubleLastValueAggregation(std::move(diff_data)));
   }
 }
 
 PointType DoubleLastValueAggregation::ToPoint() const noexcept
 {
-  return point_data_;
+  LastValuePointData point_data;
+  point_data.is_lastvalue_valid_ = is_lastvalue_valid_.load(std::memory_order_acquire);
+  point_data.value_              = value_.load(std::memory_order_relaxed);
+  point_data.sample_ts_          = sample_ts_;
+  return point_data;
 }
 }  // namespace metrics
 }  // namespace sdk
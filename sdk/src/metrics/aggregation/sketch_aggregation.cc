@@ -0,0 +1,439 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/aggregation/sketch_aggregation.h"
+#  include "opentelemetry/version.h"
+
+#  include <cmath>
+#  include <limits>
+#  include <mutex>
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+namespace
+{
+
+double ValidAccuracy(double relative_accuracy) noexcept
+{
+  return relative_accuracy > 0 && relative_accuracy <= 0.5 ? relative_accuracy
+                                                           : kSketchRelativeAccuracy;
+}
+
+/**
+ * Adds `count` to bucket `index`, first collapsing the lowest buckets into the lowest one kept if
+ * the buckets would exceed `max_size`. Indexes below the lowest bucket kept go to that bucket.
+ */
+void AddCount(ExponentialHistogramBuckets &buckets,
+              int64_t index,
+              uint64_t count,
+              size_t max_size) noexcept
+{
+  auto &counts = buckets.counts_;
+  if (counts.empty())
+  {
+    buckets.offset_ = static_cast<int32_t>(index);
+    counts.push_back(count);
+    return;
+  }
+  int64_t low  = buckets.offset_;
+  int64_t high = low + static_cast<int64_t>(counts.size()) - 1;
+  if (index >= low && index <= high)
+  {
+    counts[static_cast<size_t>(index - low)] += count;
+    return;
+  }
+
+  int64_t new_low  = index < low ? index : low;
+  int64_t new_high = index > high ? index : high;
+  if (new_high - new_low >= static_cast<int64_t>(max_size))
+  {
+    new_low = new_high - static_cast<int64_t>(max_size) + 1;
+  }
+  if (new_low > low)
+  {
+    size_t collapsed_size = static_cast<size_t>(new_low - low);
+    if (collapsed_size > counts.size())
+    {
+      collapsed_size = counts.size();
+    }
+    uint64_t collapsed = 0;
+    for (size_t i = 0; i < collapsed_size; ++i)
+    {
+      collapsed += counts[i];
+    }
+    counts.erase(counts.begin(), counts.begin() + collapsed_size);
+    if (counts.empty())
+    {
+      counts.push_back(0);
+    }
+    counts[0] += collapsed;
+  }
+  else if (new_low < low)
+  {
+    counts.insert(counts.begin(), static_cast<size_t>(low - new_low), 0);
+  }
+  buckets.offset_ = static_cast<int32_t>(new_low);
+  if (new_high - new_low + 1 > static_cast<int64_t>(counts.size()))
+  {
+    counts.resize(static_cast<size_t>(new_high - new_low + 1), 0);
+  }
+  index = index < new_low ? new_low : index;
+  counts[static_cast<size_t>(index - new_low)] += count;
+}
+
+/**
+ * Adds the counts of `delta` to `current`. Both must have the same relative accuracy.
+ */
+void AddBuckets(ExponentialHistogramBuckets &current,
+                const ExponentialHistogramBuckets &delta,
+                size_t max_size) noexcept
+{
+  // Increasing indexes only ever grow the buckets at their end.
+  for (size_t i = 0; i < delta.counts_.size(); ++i)
+  {
+    if (delta.counts_[i] != 0)
+    {
+      AddCount(current, static_cast<int64_t>(delta.offset_) + static_cast<int64_t>(i),
+               delta.counts_[i], max_size);
+    }
+  }
+}
+
+/**
+ * Adds the counts of `delta`, of another relative accuracy, to `current` by recording the value
+ * representing each of its buckets.
+ */
+void AddBuckets(ExponentialHistogramBuckets &current,
+                double multiplier,
+                const ExponentialHistogramBuckets &delta,
+                double delta_accuracy,
+                size_t max_size) noexcept
+{
+  for (size_t i = 0; i < delta.counts_.size(); ++i)
+  {
+    if (delta.counts_[i] != 0)
+    {
+      double value = SketchValue(delta.offset_ + static_cast<int32_t>(i), delta_accuracy);
+      AddCount(current, SketchIndex(value, multiplier), delta.counts_[i], max_size);
+    }
+  }
+}
+
+/**
+ * Subtracts the counts of `current` from `next`. The buckets `next` collapsed are subtracted from
+ * its lowest bucket, where they were collapsed into.
+ */
+void SubtractBuckets(ExponentialHistogramBuckets &next,
+                     const ExponentialHistogramBuckets &current) noexcept
+{
+  if (next.counts_.empty())
+  {
+    return;
+  }
+  int64_t low  = next.offset_;
+  int64_t high = low + static_cast<int64_t>(next.counts_.size()) - 1;
+  for (size_t i = 0; i < current.counts_.size(); ++i)
+  {
+    int64_t index = static_cast<int64_t>(current.offset_) + static_cast<int64_t>(i);
+    index         = index < low ? low : index;
+    if (index > high)
+    {
+      continue;
+    }
+    uint64_t &count = next.counts_[static_cast<size_t>(index - low)];
+    count -= current.counts_[i] < count ? current.counts_[i] : count;
+  }
+}
+
+void MergeMinMax(SketchPointData &current, double min, double max) noexcept
+{
+  if (current.count_ == 0)
+  {
+    current.min_ = min;
+    current.max_ = max;
+    return;
+  }
+  current.min_ = min < current.min_ ? min : current.min_;
+  current.max_ = max > current.max_ ? max : current.max_;
+}
+
+}  // namespace
+
+double SketchIndexMultiplier(double relative_accuracy) noexcept
+{
+  relative_accuracy = ValidAccuracy(relative_accuracy);
+  return 1 / std::log((1 + relative_accuracy) / (1 - relative_accuracy));
+}
+
+int32_t SketchIndex(double value, double multiplier) noexcept
+{
+  return static_cast<int32_t>(std::ceil(std::log(value) * multiplier));
+}
+
+double SketchValue(int32_t index, double relative_accuracy) noexcept
+{
+  relative_accuracy = ValidAccuracy(relative_accuracy);
+  double gamma      = (1 + relative_accuracy) / (1 - relative_accuracy);
+  // The midpoint of (gamma^(index - 1), gamma^index] in relative terms.
+  return 2 * std::pow(gamma, index) / (gamma + 1);
+}
+
+template <class T>
+void SketchRecord(SketchPointData &point, T value, double multiplier, size_t max_size) noexcept
+{
+  double measurement = static_cast<double>(value);
+  if (std::isnan(measurement) || std::isinf(measurement))
+  {
+    return;
+  }
+  MergeMinMax(point, measurement, measurement);
+  point.sum_ = nostd::get<T>(point.sum_) + value;
+  point.count_ += 1;
+  if (measurement > 0)
+  {
+    AddCount(point.positive_buckets_, SketchIndex(measurement, multiplier), 1, max_size);
+  }
+  else if (measurement < 0)
+  {
+    AddCount(point.negative_buckets_, SketchIndex(-measurement, multiplier), 1, max_size);
+  }
+  else
+  {
+    point.zero_count_ += 1;
+  }
+}
+
+template <class T>
+void SketchMerge(SketchPointData &current, const SketchPointData &delta, size_t max_size) noexcept
+{
+  if (delta.count_ == 0)
+  {
+    return;
+  }
+  if (current.count_ == 0)
+  {
+    current.relative_accuracy_ = delta.relative_accuracy_;
+  }
+  if (current.relative_accuracy_ == delta.relative_accuracy_)
+  {
+    AddBuckets(current.positive_buckets_, delta.positive_buckets_, max_size);
+    AddBuckets(current.negative_buckets_, delta.negative_buckets_, max_size);
+  }
+  else
+  {
+    double multiplier = SketchIndexMultiplier(current.relative_accuracy_);
+    AddBuckets(current.positive_buckets_, multiplier, delta.positive_buckets_,
+               delta.relative_accuracy_, max_size);
+    AddBuckets(current.negative_buckets_, multiplier, delta.negative_buckets_,
+               delta.relative_accuracy_, max_size);
+  }
+  MergeMinMax(current, delta.min_, delta.max_);
+  current.sum_ = nostd::get<T>(current.sum_) + nostd::get<T>(delta.sum_);
+  current.count_ += delta.count_;
+  current.zero_count_ += delta.zero_count_;
+}
+
+template <class T>
+void SketchDiff(const SketchPointData &current, SketchPointData &next) noexcept
+{
+  SubtractBuckets(next.positive_buckets_, current.positive_buckets_);
+  SubtractBuckets(next.negative_buckets_, current.negative_buckets_);
+  next.sum_ = nostd::get<T>(next.sum_) - nostd::get<T>(current.sum_);
+  next.count_ -= current.count_;
+  next.zero_count_ -= current.zero_count_;
+}
+
+double SketchQuantile(const SketchPointData &point, double q) noexcept
+{
+  if (point.count_ == 0 || !(q >= 0 && q <= 1))
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(point.count_ - 1));
+  if (rank == 0)
+  {
+    return point.min_;
+  }
+  if (rank >= point.count_ - 1)
+  {
+    return point.max_;
+  }
+  double estimate = point.max_;
+  uint64_t seen   = 0;
+  bool found      = false;
+  // In increasing order of value: negative buckets from the highest index, zeros, then positive
+  // buckets from the lowest index.
+  const auto &negative = point.negative_buckets_;
+  for (size_t i = negative.counts_.size(); i-- > 0 && !found;)
+  {
+    seen += negative.counts_[i];
+    if (seen > rank)
+    {
+      estimate = -SketchValue(negative.offset_ + static_cast<int32_t>(i), point.relative_accuracy_);
+      found    = true;
+    }
+  }
+  seen += point.zero_count_;
+  if (!found && seen > rank)
+  {
+    estimate = 0;
+    found    = true;
+  }
+  const auto &positive = point.positive_buckets_;
+  for (size_t i = 0; i < positive.counts_.size() && !found; ++i)
+  {
+    seen += positive.counts_[i];
+    if (seen > rank)
+    {
+      estimate = SketchValue(positive.offset_ + static_cast<int32_t>(i), point.relative_accuracy_);
+      found    = true;
+    }
+  }
+  estimate = estimate < point.min_ ? point.min_ : estimate;
+  return estimate > point.max_ ? point.max_ : estimate;
+}
+
+template void SketchRecord<long>(SketchPointData &, long, double, size_t) noexcept;
+template void SketchRecord<double>(SketchPointData &, double, double, size_t) noexcept;
+template void SketchMerge<long>(SketchPointData &, const SketchPointData &, size_t) noexcept;
+template void SketchMerge<double>(SketchPointData &, const SketchPointData &, size_t) noexcept;
+template void SketchDiff<long>(const SketchPointData &, SketchPointData &) noexcept;
+template void SketchDiff<double>(const SketchPointData &, SketchPointData &) noexcept;
+
+LongSketchAggregation::LongSketchAggregation(double relative_accuracy, size_t max_size)
+    : multiplier_(SketchIndexMultiplier(relative_accuracy)), max_size_(max_size < 2 ? 2 : max_size)
+{
+  point_data_.sum_               = 0l;
+  point_data_.relative_accuracy_ = ValidAccuracy(relative_accuracy);
+}
+
+LongSketchAggregation::LongSketchAggregation(SketchPointData &&data)
+    : point_data_{std::move(data)},
+      multiplier_(SketchIndexMultiplier(point_data_.relative_accuracy_)),
+      max_size_(kSketchMaxSize)
+{
+  point_data_.relative_accuracy_ = ValidAccuracy(point_data_.relative_accuracy_);
+}
+
+LongSketchAggregation::LongSketchAggregation(const SketchPointData &data)
+    : point_data_{data},
+      multiplier_(SketchIndexMultiplier(point_data_.relative_accuracy_)),
+      max_size_(kSketchMaxSize)
+{
+  point_data_.relative_accuracy_ = ValidAccuracy(point_data_.relative_accuracy_);
+}
+
+void LongSketchAggregation::Aggregate(long value, const PointAttributes &attributes) noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  SketchRecord<long>(point_data_, value, multiplier_, max_size_);
+}
+
+std::unique_ptr<Aggregation> LongSketchAggregation::Merge(const Aggregation &delta) const noexcept
+{
+  auto curr_value  = nostd::get<SketchPointData>(ToPoint());
+  auto delta_value = nostd::get<SketchPointData>(
+      (static_cast<const LongSketchAggregation &>(delta).ToPoint()));
+  SketchMerge<long>(curr_value, delta_value, max_size_);
+  auto aggr         = new LongSketchAggregation(curr_value.relative_accuracy_, max_size_);
+  aggr->point_data_ = std::move(curr_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+void LongSketchAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto delta_value = nostd::get<SketchPointData>(delta.ToPoint());
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  SketchMerge<long>(point_data_, delta_value, max_size_);
+  multiplier_ = SketchIndexMultiplier(point_data_.relative_accuracy_);
+}
+
+std::unique_ptr<Aggregation> LongSketchAggregation::Diff(const Aggregation &next) const noexcept
+{
+  auto curr_value = nostd::get<SketchPointData>(ToPoint());
+  auto next_value = nostd::get<SketchPointData>(
+      (static_cast<const LongSketchAggregation &>(next).ToPoint()));
+  SketchDiff<long>(curr_value, next_value);
+  auto aggr         = new LongSketchAggregation(next_value.relative_accuracy_, max_size_);
+  aggr->point_data_ = std::move(next_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+PointType LongSketchAggregation::ToPoint() const noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  return point_data_;
+}
+
+DoubleSketchAggregation::DoubleSketchAggregation(double relative_accuracy, size_t max_size)
+    : multiplier_(SketchIndexMultiplier(relative_accuracy)), max_size_(max_size < 2 ? 2 : max_size)
+{
+  point_data_.sum_               = 0.0;
+  point_data_.relative_accuracy_ = ValidAccuracy(relative_accuracy);
+}
+
+DoubleSketchAggregation::DoubleSketchAggregation(SketchPointData &&data)
+    : point_data_{std::move(data)},
+      multiplier_(SketchIndexMultiplier(point_data_.relative_accuracy_)),
+      max_size_(kSketchMaxSize)
+{
+  point_data_.relative_accuracy_ = ValidAccuracy(point_data_.relative_accuracy_);
+}
+
+DoubleSketchAggregation::DoubleSketchAggregation(const SketchPointData &data)
+    : point_data_{data},
+      multiplier_(SketchIndexMultiplier(point_data_.relative_accuracy_)),
+      max_size_(kSketchMaxSize)
+{
+  point_data_.relative_accuracy_ = ValidAccuracy(point_data_.relative_accuracy_);
+}
+
+void DoubleSketchAggregation::Aggregate(double value, const PointAttributes &attributes) noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  SketchRecord<double>(point_data_, value, multiplier_, max_size_);
+}
+
+std::unique_ptr<Aggregation> DoubleSketchAggregation::Merge(const Aggregation &delta) const noexcept
+{
+  auto curr_value  = nostd::get<SketchPointData>(ToPoint());
+  auto delta_value = nostd::get<SketchPointData>(
+      (static_cast<const DoubleSketchAggregation &>(delta).ToPoint()));
+  SketchMerge<double>(curr_value, delta_value, max_size_);
+  auto aggr         = new DoubleSketchAggregation(curr_value.relative_accuracy_, max_size_);
+  aggr->point_data_ = std::move(curr_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+void DoubleSketchAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  auto delta_value = nostd::get<SketchPointData>(delta.ToPoint());
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  SketchMerge<double>(point_data_, delta_value, max_size_);
+  multiplier_ = SketchIndexMultiplier(point_data_.relative_accuracy_);
+}
+
+std::unique_ptr<Aggregation> DoubleSketchAggregation::Diff(const Aggregation &next) const noexcept
+{
+  auto curr_value = nostd::get<SketchPointData>(ToPoint());
+  auto next_value = nostd::get<SketchPointData>(
+      (static_cast<const DoubleSketchAggregation &>(next).ToPoint()));
+  SketchDiff<double>(curr_value, next_value);
+  auto aggr         = new DoubleSketchAggregation(next_value.relative_accuracy_, max_size_);
+  aggr->point_data_ = std::move(next_value);
+  return std::unique_ptr<Aggregation>(aggr);
+}
+
+PointType DoubleSketchAggregation::ToPoint() const noexcept
+{
+  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
+  return point_data_;
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -6,106 +6,216 @@
 #  include "opentelemetry/sdk/metrics/data/point_data.h"
 #  include "opentelemetry/version.h"
 
-#  include <iostream>
-#  include <mutex>
-
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
 
-LongSumAggregation::LongSumAggregation()
+LongSumAggregation::LongSumAggregation() : value_(0l) {}
+
+LongSumAggregation::LongSumAggregation(SumPointData &&data)
+    : value_(nostd::get<long>(data.value_))
+{}
+
+LongSumAggregation::LongSumAggregation(const SumPointData &data)
+    : value_(nostd::get<long>(data.value_))
+{}
+
+std::unique_ptr<Aggregation> LongSumAggregation::Merge(const Aggregation &delta) const noexcept
 {
-  point_data_.value_ = 0l;
+  long merge_value = static_cast<const LongSumAggregation &>(delta).value_.load(
+                         std::memory_order_relaxed) +
+                     value_.load(std::memory_order_relaxed);
+  std::unique_ptr<Aggregation> aggr(new LongSumAggregation());
+  static_cast<LongSumAggregation *>(aggr.get())->value_.store(merge_value,
+                                                              std::memory_order_relaxed);
+  return aggr;
 }
 
-LongSumAggregation::LongSumAggregation(SumPointData &&data) : point_data_{std::move(data)} {}
+void LongSumAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  value_.fetch_add(
+      static_cast<const LongSumAggregation &>(delta).value_.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+}
 
-LongSumAggregation::LongSumAggregation(const SumPointData &data) : point_data_{data} {}
+std::unique_ptr<Aggregation> LongSumAggregation::Diff(const Aggregation &next) const noexcept
+{
+  long diff_value =
+      static_cast<const LongSumAggregation &>(next).value_.load(std::memory_order_relaxed) -
+      value_.load(std::memory_order_relaxed);
+  std::unique_ptr<Aggregation> aggr(new LongSumAggregation());
+  static_cast<LongSumAggregation *>(aggr.get())->value_.store(diff_value,
+                                                              std::memory_order_relaxed);
+  return aggr;
+}
 
-void LongSumAggregation::Aggregate(long value, const PointAttributes &attributes) noexcept
+PointType LongSumAggregation::ToPoint() const noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.value_ = nostd::get<long>(point_data_.value_) + value;
+  SumPointData point_data;
+  point_data.value_ = value_.load(std::memory_order_relaxed);
+  return point_data;
 }
 
-std::unique_ptr<Aggregation> LongSumAggregation::Merge(const Aggregation &delta) const noexcept
+DoubleSumAggregation::DoubleSumAggregation() : value_(0.0) {}
+
+DoubleSumAggregation::DoubleSumAggregation(SumPointData &&data)
+    : value_(nostd::get<double>(data.value_))
+{}
+
+DoubleSumAggregation::DoubleSumAggregation(const SumPointData &data)
+    : value_(nostd::get<double>(data.value_))
+{}
+
+std::unique_ptr<Aggregation> DoubleSumAggregation::Merge(const Aggregation &delta) const noexcept
 {
-  long merge_value =
-      nostd::get<long>(
-          nostd::get<SumPointData>((static_cast<const LongSumAggregation &>(delta).ToPoint()))
-              .value_) +
-      nostd::get<long>(nostd::get<SumPointData>(ToPoint()).value_);
-  std::unique_ptr<Aggregation> aggr(new LongSumAggregation());
-  static_cast<LongSumAggregation *>(aggr.get())->point_data_.value_ = merge_value;
+  double merge_value = static_cast<const DoubleSumAggregation &>(delta).value_.load(
+                           std::memory_order_relaxed) +
+                       value_.load(std::memory_order_relaxed);
+  std::unique_ptr<Aggregation> aggr(new DoubleSumAggregation());
+  static_cast<DoubleSumAggregation *>(aggr.get())->value_.store(merge_value,
+                                                                std::memory_order_relaxed);
   return aggr;
 }
 
-std::unique_ptr<Aggregation> LongSumAggregation::Diff(const Aggregation &next) const noexcept
+void DoubleSumAggregation::MergeFrom(const Aggregation &delta) noexcept
 {
+  Aggregate(
+      static_cast<const DoubleSumAggregation &>(delta).value_.load(std::memory_order_relaxed));
+}
 
-  long diff_value = nostd::get<long>(nostd::get<SumPointData>(
-                                         (static_cast<const LongSumAggregation &>(next).ToPoint()))
-                                         .value_) -
-                    nostd::get<long>(nostd::get<SumPointData>(ToPoint()).value_);
-  std::unique_ptr<Aggregation> aggr(new LongSumAggregation());
-  static_cast<LongSumAggregation *>(aggr.get())->point_data_.value_ = diff_value;
+std::unique_ptr<Aggregation> DoubleSumAggregation::Diff(const Aggregation &next) const noexcept
+{
+  double diff_value =
+      static_cast<const DoubleSumAggregation &>(next).value_.load(std::memory_order_relaxed) -
+      value_.load(std::memory_order_relaxed);
+  std::unique_ptr<Aggregation> aggr(new DoubleSumAggregation());
+  static_cast<DoubleSumAggregation *>(aggr.get())->value_.store(diff_value,
+                                                                std::memory_order_relaxed);
   return aggr;
 }
 
-PointType LongSumAggregation::ToPoint() const noexcept
+PointType DoubleSumAggregation::ToPoint() const noexcept
 {
-  return point_data_;
+  SumPointData point_data;
+  point_data.value_ = value_.load(std::memory_order_relaxed);
+  return point_data;
 }
 
-DoubleSumAggregation::DoubleSumAggregation()
+LongStripedSumAggregation::LongStripedSumAggregation() {}
+
+LongStripedSumAggregation::LongStripedSumAggregation(SumPointData &&data)
 {
-  point_data_.value_ = 0.0;
+  cells_[0].value.store(nostd::get<long>(data.value_), std::memory_order_relaxed);
 }
 
-DoubleSumAggregation::DoubleSumAggregation(SumPointData &&data) : point_data_(std::move(data)) {}
+LongStripedSumAggregation::LongStripedSumAggregation(const SumPointData &data)
+{
+  cells_[0].value.store(nostd::get<long>(data.value_), std::memory_order_relaxed);
+}
 
-DoubleSumAggregation::DoubleSumAggregation(const SumPointData &data) : point_data_(data) {}
+long LongStripedSumAggregation::Load() const noexcept
+{
+  long value = 0;
+  for (auto &cell : cells_)
+  {
+    value += cell.value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
 
-void DoubleSumAggregation::Aggregate(double value, const PointAttributes &attributes) noexcept
+std::unique_ptr<Aggregation> LongStripedSumAggregation::Merge(
+    const Aggregation &delta) const noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  point_data_.value_ = nostd::get<double>(point_data_.value_) + value;
+  std::unique_ptr<Aggregation> aggr(new LongStripedSumAggregation());
+  static_cast<LongStripedSumAggregation *>(aggr.get())
+      ->cells_[0]
+      .value.store(static_cast<const LongStripedSumAggregation &>(delta).Load() + Load(),
+                   std::memory_order_relaxed);
+  return aggr;
 }
 
-std::unique_ptr<Aggregation> DoubleSumAggregation::Merge(const Aggregation &delta) const noexcept
+void LongStripedSumAggregation::MergeFrom(const Aggregation &delta) noexcept
 {
-  double merge_value =
-      nostd::get<double>(
-          nostd::get<SumPointData>((static_cast<const DoubleSumAggregation &>(delta).ToPoint()))
-              .value_) +
-      nostd::get<double>(nostd::get<SumPointData>(ToPoint()).value_);
-  std::unique_ptr<Aggregation> aggr(new DoubleSumAggregation());
-  static_cast<DoubleSumAggregation *>(aggr.get())->point_data_.value_ = merge_value;
+  Aggregate(static_cast<const LongStripedSumAggregation &>(delta).Load());
+}
+
+std::unique_ptr<Aggregation> LongStripedSumAggregation::Diff(
+    const Aggregation &next) const noexcept
+{
+  std::unique_ptr<Aggregation> aggr(new LongStripedSumAggregation());
+  static_cast<LongStripedSumAggregation *>(aggr.get())
+      ->cells_[0]
+      .value.store(static_cast<const LongStripedSumAggregation &>(next).Load() - Load(),
+                   std::memory_order_relaxed);
   return aggr;
 }
 
-std::unique_ptr<Aggregation> DoubleSumAggregation::Diff(const Aggregation &next) const noexcept
+PointType LongStripedSumAggregation::ToPoint() const noexcept
 {
+  SumPointData point_data;
+  point_data.value_ = Load();
+  return point_data;
+}
 
-  double diff_value =
-      nostd::get<double>(
-          nostd::get<SumPointData>((static_cast<const DoubleSumAggregation &>(next).ToPoint()))
-              .value_) -
-      nostd::get<double>(nostd::get<SumPointData>(ToPoint()).value_);
-  std::unique_ptr<Aggregation> aggr(new DoubleSumAggregation());
-  static_cast<DoubleSumAggregation *>(aggr.get())->point_data_.value_ = diff_value;
+DoubleStripedSumAggregation::DoubleStripedSumAggregation() {}
+
+DoubleStripedSumAggregation::DoubleStripedSumAggregation(SumPointData &&data)
+{
+  cells_[0].value.store(nostd::get<double>(data.value_), std::memory_order_relaxed);
+}
+
+DoubleStripedSumAggregation::DoubleStripedSumAggregation(const SumPointData &data)
+{
+  cells_[0].value.store(nostd::get<double>(data.value_), std::memory_order_relaxed);
+}
+
+double DoubleStripedSumAggregation::Load() const noexcept
+{
+  double value = 0.0;
+  for (auto &cell : cells_)
+  {
+    value += cell.value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+std::unique_ptr<Aggregation> DoubleStripedSumAggregation::Merge(
+    const Aggregation &delta) const noexcept
+{
+  std::unique_ptr<Aggregation> aggr(new DoubleStripedSumAggregation());
+  static_cast<DoubleStripedSumAggregation *>(aggr.get())
+      ->cells_[0]
+      .value.store(static_cast<const DoubleStripedSumAggregation &>(delta).Load() + Load(),
+                   std::memory_order_relaxed);
   return aggr;
 }
 
-PointType DoubleSumAggregation::ToPoint() const noexcept
+void DoubleStripedSumAggregation::MergeFrom(const Aggregation &delta) noexcept
+{
+  Aggregate(static_cast<const DoubleStripedSumAggregation &>(delta).Load());
+}
+
+std::unique_ptr<Aggregation> DoubleStripedSumAggregation::Diff(
+    const Aggregation &next) const noexcept
+{
+  std::unique_ptr<Aggregation> aggr(new DoubleStripedSumAggregation());
+  static_cast<DoubleStripedSumAggregation *>(aggr.get())
+      ->cells_[0]
+      .value.store(static_cast<const DoubleStripedSumAggregation &>(next).Load() - Load(),
+                   std::memory_order_relaxed);
+  return aggr;
+}
+
+PointType DoubleStripedSumAggregation::ToPoint() const noexcept
 {
-  const std::lock_guard<opentelemetry::common::SpinLockMutex> locked(lock_);
-  return point_data_;
+  SumPointData point_data;
+  point_data.value_ = Load();
+  return point_data;
 }
 
 }  // namespace metrics
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
-#endif
\ No newline at end of file
+#endif
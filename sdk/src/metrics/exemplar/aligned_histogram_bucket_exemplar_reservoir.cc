@@ -0,0 +1,46 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/exemplar/aligned_histogram_bucket_exemplar_reservoir.h"
+#  include "opentelemetry/sdk/metrics/aggregation/histogram_aggregation.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+void AlignedHistogramBucketExemplarReservoir::OfferMeasurement(
+    long value,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const opentelemetry::context::Context &context) noexcept
+{
+  cells_[HistogramBucketIndex(boundaries_, static_cast<double>(value))].RecordMeasurement(
+      value, attributes, context, *clock_);
+}
+
+void AlignedHistogramBucketExemplarReservoir::OfferMeasurement(
+    double value,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const opentelemetry::context::Context &context) noexcept
+{
+  cells_[HistogramBucketIndex(boundaries_, value)].RecordMeasurement(value, attributes, context,
+                                                                    *clock_);
+}
+
+std::vector<ExemplarData> AlignedHistogramBucketExemplarReservoir::CollectAndReset(
+    const MetricAttributes &pointAttributes) noexcept
+{
+  std::vector<ExemplarData> exemplars;
+  for (auto &cell : cells_)
+  {
+    cell.CollectAndReset(pointAttributes, exemplars);
+  }
+  return exemplars;
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
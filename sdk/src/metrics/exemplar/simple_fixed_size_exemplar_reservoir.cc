@@ -0,0 +1,66 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/exemplar/simple_fixed_size_exemplar_reservoir.h"
+#  include "src/common/random.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+size_t SimpleFixedSizeExemplarReservoir::NextCellIndex() noexcept
+{
+  uint64_t count = num_measurements_.fetch_add(1, std::memory_order_relaxed);
+  if (count < cells_.size())
+  {
+    return static_cast<size_t>(count);
+  }
+  // Keep the measurement with probability size / (count + 1), in a random cell.
+  uint64_t index = opentelemetry::sdk::common::Random::GenerateRandom64() % (count + 1);
+  return index < cells_.size() ? static_cast<size_t>(index) : cells_.size();
+}
+
+void SimpleFixedSizeExemplarReservoir::OfferMeasurement(
+    long value,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const opentelemetry::context::Context &context) noexcept
+{
+  size_t index = NextCellIndex();
+  if (index < cells_.size())
+  {
+    cells_[index].RecordMeasurement(value, attributes, context, *clock_);
+  }
+}
+
+void SimpleFixedSizeExemplarReservoir::OfferMeasurement(
+    double value,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const opentelemetry::context::Context &context) noexcept
+{
+  size_t index = NextCellIndex();
+  if (index < cells_.size())
+  {
+    cells_[index].RecordMeasurement(value, attributes, context, *clock_);
+  }
+}
+
+std::vector<ExemplarData> SimpleFixedSizeExemplarReservoir::CollectAndReset(
+    const MetricAttributes &pointAttributes) noexcept
+{
+  std::vector<ExemplarData> exemplars;
+  for (auto &cell : cells_)
+  {
+    cell.CollectAndReset(pointAttributes, exemplars);
+  }
+  // Start a new sample.
+  num_measurements_.store(0, std::memory_order_relaxed);
+  return exemplars;
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
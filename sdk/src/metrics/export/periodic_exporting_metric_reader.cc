@@ -6,8 +6,9 @@
 #  include "opentelemetry/sdk/common/global_log_handler.h"
 #  include "opentelemetry/sdk/metrics/metric_exporter.h"
 
+#  include <algorithm>
 #  include <chrono>
-#  include <future>
+#  include <utility>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -22,7 +23,11 @@ PeriodicExportingMetricReader::PeriodicExportingMetricReader(
     : MetricReader(aggregation_temporality),
       exporter_{std::move(exporter)},
       export_interval_millis_{option.export_interval_millis},
-      export_timeout_millis_{option.export_timeout_millis}
+      export_timeout_millis_{option.export_timeout_millis},
+      align_to_wall_clock_{option.align_to_wall_clock},
+      thread_options_{option.thread_options},
+      executor_{option.executor},
+      fork_handler_([this] { PrepareFork(); }, [this] { AfterFork(); }, [this] { AfterFork(); })
 {
   if (export_interval_millis_ <= export_timeout_millis_)
   {
@@ -32,52 +37,255 @@ PeriodicExportingMetricReader::PeriodicExportingMetricReader(
     export_interval_millis_ = kExportIntervalMillis;
     export_timeout_millis_  = kExportTimeOutMillis;
   }
+  if (option.export_changed_only)
+  {
+    SetChangedOnlyExport((std::max)(option.changed_only_keepalive_collections, size_t{1}));
+  }
+}
+
+PeriodicExportingMetricReader::~PeriodicExportingMetricReader()
+{
+  if (collect_task_ != nullptr)
+  {
+    executor_->SuspendTask(collect_task_);
+    executor_->SuspendTask(export_task_);
+  }
 }
 
 void PeriodicExportingMetricReader::OnInitialized() noexcept
 {
-  worker_thread_ = std::thread(&PeriodicExportingMetricReader::DoBackgroundWork, this);
+  std::lock_guard<std::mutex> guard(threads_m_);
+  StartThreads();
+}
+
+void PeriodicExportingMetricReader::StartThreads()
+{
+  if (executor_ != nullptr)
+  {
+    next_collection_ = FirstCollection();
+    auto delay       = std::chrono::duration_cast<std::chrono::microseconds>(
+        next_collection_ - std::chrono::steady_clock::now());
+    if (collect_task_ == nullptr)
+    {
+      export_task_  = executor_->AddTask([this] { return RunExportTask(); },
+                                         sdk::common::ExportExecutor::kWhenWokenUp);
+      collect_task_ = executor_->AddTask([this] { return RunCollectTask(); }, delay);
+    }
+    else
+    {
+      executor_->ResumeTask(export_task_, sdk::common::ExportExecutor::kWhenWokenUp);
+      executor_->ResumeTask(collect_task_, delay);
+    }
+    return;
+  }
+  stopping_        = false;
+  export_stopping_ = false;
+  export_thread_   = std::thread(&PeriodicExportingMetricReader::DoExportWork, this);
+  worker_thread_   = std::thread(&PeriodicExportingMetricReader::DoBackgroundWork, this);
+}
+
+void PeriodicExportingMetricReader::StopThreads()
+{
+  if (collect_task_ != nullptr)
+  {
+    executor_->SuspendTask(collect_task_);
+    executor_->SuspendTask(export_task_);
+    // Export the last metrics collected, as the export thread does.
+    std::unique_lock<std::mutex> lk(export_m_);
+    if (has_pending_metrics_)
+    {
+      ExportPendingMetrics(lk);
+    }
+    return;
+  }
+  if (worker_thread_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> guard(cv_m_);
+      stopping_ = true;
+    }
+    cv_.notify_one();
+    worker_thread_.join();
+  }
+  // The export thread exports the last metrics collected before stopping.
+  if (export_thread_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> guard(export_m_);
+      export_stopping_ = true;
+    }
+    export_cv_.notify_one();
+    export_thread_.join();
+  }
+}
+
+void PeriodicExportingMetricReader::PrepareFork()
+{
+  // Released by AfterFork.
+  threads_m_.lock();
+  are_threads_paused_ = worker_thread_.joinable() || collect_task_ != nullptr;
+  StopThreads();
+}
+
+void PeriodicExportingMetricReader::AfterFork()
+{
+  if (are_threads_paused_)
+  {
+    are_threads_paused_ = false;
+    StartThreads();
+  }
+  threads_m_.unlock();
+}
+
+std::chrono::steady_clock::time_point PeriodicExportingMetricReader::NextCollection(
+    std::chrono::steady_clock::time_point last_collection) const noexcept
+{
+  auto now  = std::chrono::steady_clock::now();
+  auto next = last_collection + export_interval_millis_;
+  if (align_to_wall_clock_)
+  {
+    // The next multiple of the interval on the system clock, at least half an interval after the
+    // last collection in case the clocks drifted apart.
+    auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    next = now + (export_interval_millis_ - since_epoch % export_interval_millis_);
+    if (next - last_collection < export_interval_millis_ / 2)
+    {
+      next += export_interval_millis_;
+    }
+    return next;
+  }
+  if (next <= now)
+  {
+    // Skip the collections missed, rather than running them back to back.
+    next += (now - next) / export_interval_millis_ * export_interval_millis_ +
+            export_interval_millis_;
+  }
+  return next;
+}
+
+std::chrono::steady_clock::time_point PeriodicExportingMetricReader::FirstCollection()
+    const noexcept
+{
+  auto collection = std::chrono::steady_clock::now();
+  if (align_to_wall_clock_)
+  {
+    collection = NextCollection(collection - export_interval_millis_);
+  }
+  return collection;
 }
 
 void PeriodicExportingMetricReader::DoBackgroundWork()
 {
+  sdk::common::ApplyThreadOptions(thread_options_, "otel-collect");
   std::unique_lock<std::mutex> lk(cv_m_);
-  do
+  auto collection = FirstCollection();
+  while (!cv_.wait_until(lk, collection, [this] { return stopping_; }))
+  {
+    lk.unlock();
+    CollectAndQueue();
+    lk.lock();
+    collection = NextCollection(collection);
+  }
+}
+
+void PeriodicExportingMetricReader::CollectAndQueue()
+{
   {
-    if (IsShutdown())
+    std::lock_guard<std::mutex> guard(export_m_);
+    if (has_pending_metrics_)
+    {
+      OTEL_INTERNAL_LOG_WARN(
+          "[Periodic Exporting Metric Reader] The previous collection is still waiting for the "
+          "export, skipping this one");
+      return;
+    }
+  }
+  auto start = std::chrono::steady_clock::now();
+  Collect([this, start](ResourceMetrics &metric_data) {
+    if (std::chrono::steady_clock::now() - start > export_timeout_millis_)
+    {
+      OTEL_INTERNAL_LOG_ERROR(
+          "[Periodic Exporting Metric Reader] Collect took longer configured time: "
+          << export_timeout_millis_.count() << " ms, and timed out");
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(export_m_);
+      // The producer gets the buffers of the metrics exported before in return, and reuses them
+      // for the next collection.
+      std::swap(pending_metrics_, metric_data);
+      pending_collection_time_ = start;
+      has_pending_metrics_     = true;
+    }
+    export_cv_.notify_one();
+    if (export_task_ != nullptr)
+    {
+      executor_->WakeUp(export_task_);
+    }
+    return true;
+  });
+}
+
+std::chrono::microseconds PeriodicExportingMetricReader::RunCollectTask()
+{
+  CollectAndQueue();
+  next_collection_ = NextCollection(next_collection_);
+  return std::chrono::duration_cast<std::chrono::microseconds>(next_collection_ -
+                                                               std::chrono::steady_clock::now());
+}
+
+std::chrono::microseconds PeriodicExportingMetricReader::RunExportTask()
+{
+  std::unique_lock<std::mutex> lk(export_m_);
+  if (has_pending_metrics_)
+  {
+    ExportPendingMetrics(lk);
+  }
+  return sdk::common::ExportExecutor::kWhenWokenUp;
+}
+
+void PeriodicExportingMetricReader::DoExportWork()
+{
+  sdk::common::ApplyThreadOptions(thread_options_, "otel-export");
+  std::unique_lock<std::mutex> lk(export_m_);
+  while (true)
+  {
+    export_cv_.wait(lk, [this] { return has_pending_metrics_ || export_stopping_; });
+    if (!has_pending_metrics_)
     {
       break;
     }
-    std::atomic<bool> cancel_export_for_timeout{false};
-    auto start          = std::chrono::steady_clock::now();
-    auto future_receive = std::async(std::launch::async, [this, &cancel_export_for_timeout] {
-      Collect([this, &cancel_export_for_timeout](ResourceMetrics &metric_data) {
-        if (cancel_export_for_timeout)
-        {
-          OTEL_INTERNAL_LOG_ERROR(
-              "[Periodic Exporting Metric Reader] Collect took longer configured time: "
-              << export_timeout_millis_.count() << " ms, and timed out");
-          return false;
-        }
-        this->exporter_->Export(metric_data);
-        return true;
-      });
-    });
-    std::future_status status;
-    do
+    ExportPendingMetrics(lk);
+  }
+}
+
+void PeriodicExportingMetricReader::ExportPendingMetrics(std::unique_lock<std::mutex> &lk)
+{
+  std::swap(pending_metrics_, exporting_metrics_);
+  auto collection_time = pending_collection_time_;
+  has_pending_metrics_ = false;
+  lk.unlock();
+
+  auto start = std::chrono::steady_clock::now();
+  if (start - collection_time > export_timeout_millis_)
+  {
+    OTEL_INTERNAL_LOG_ERROR(
+        "[Periodic Exporting Metric Reader] Collected metrics waited longer than the export "
+        "timeout: "
+        << export_timeout_millis_.count() << " ms for the previous export, and were dropped");
+  }
+  else
+  {
+    exporter_->Export(exporting_metrics_);
+    if (std::chrono::steady_clock::now() - start > export_timeout_millis_)
     {
-      status = future_receive.wait_for(std::chrono::milliseconds(export_timeout_millis_));
-      if (status == std::future_status::timeout)
-      {
-        cancel_export_for_timeout = true;
-        break;
-      }
-    } while (status != std::future_status::ready);
-    auto end            = std::chrono::steady_clock::now();
-    auto export_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    auto remaining_wait_interval_ms = export_interval_millis_ - export_time_ms;
-    cv_.wait_for(lk, remaining_wait_interval_ms);
-  } while (true);
+      OTEL_INTERNAL_LOG_ERROR("[Periodic Exporting Metric Reader] Export took longer than "
+                              "the export timeout: "
+                              << export_timeout_millis_.count() << " ms");
+    }
+  }
+  lk.lock();
 }
 
 bool PeriodicExportingMetricReader::OnForceFlush(std::chrono::microseconds timeout) noexcept
@@ -87,10 +295,9 @@ bool PeriodicExportingMetricReader::OnForceFlush(std::chrono::microseconds timeo
 
 bool PeriodicExportingMetricReader::OnShutDown(std::chrono::microseconds timeout) noexcept
 {
-  if (worker_thread_.joinable())
   {
-    cv_.notify_one();
-    worker_thread_.join();
+    std::lock_guard<std::mutex> guard(threads_m_);
+    StopThreads();
   }
   return exporter_->Shutdown(timeout);
 }
@@ -0,0 +1,177 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/internal_metrics.h"
+#  include "opentelemetry/sdk/metrics/metric_reader.h"
+
+#  include <chrono>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+namespace metrics_api = opentelemetry::metrics;
+
+InternalMetrics::InternalMetrics(nostd::shared_ptr<metrics_api::Meter> meter)
+    : meter_(std::move(meter))
+{
+  meter_->CreateLongObservableGauge(
+      "otel.sdk.processor.queue.size",
+      &ObserveProcessors<&common::BatchProcessorStats::queue_size>,
+      "Items waiting in the queue of the processor", "{items}", this);
+  meter_->CreateLongObservableGauge(
+      "otel.sdk.processor.queue.capacity",
+      &ObserveProcessors<&common::BatchProcessorStats::max_queue_size>,
+      "Capacity of the queue of the processor", "{items}", this);
+  meter_->CreateLongObservableCounter("otel.sdk.processor.enqueued",
+                                      &ObserveProcessors<&common::BatchProcessorStats::enqueued>,
+                                      "Items accepted into the queue", "{items}", this);
+  meter_->CreateLongObservableCounter("otel.sdk.processor.dropped",
+                                      &ObserveProcessors<&common::BatchProcessorStats::dropped>,
+                                      "Items dropped because the queue was full", "{items}", this);
+  meter_->CreateLongObservableCounter("otel.sdk.processor.exported",
+                                      &ObserveProcessors<&common::BatchProcessorStats::exported>,
+                                      "Items passed to the exporter", "{items}", this);
+  meter_->CreateLongObservableCounter(
+      "otel.sdk.processor.export_failed",
+      &ObserveProcessors<&common::BatchProcessorStats::export_failed>,
+      "Items passed to the exporter in batches which failed", "{items}", this);
+  meter_->CreateLongObservableCounter(
+      "otel.sdk.processor.exports", &ObserveProcessors<&common::BatchProcessorStats::export_count>,
+      "Batches passed to the exporter", "{batches}", this);
+  meter_->CreateDoubleObservableCounter("otel.sdk.processor.export.duration",
+                                        &ObserveExportDuration,
+                                        "Time spent in the exporter", "s", this);
+
+  meter_->CreateLongObservableCounter("otel.sdk.exporter.requests",
+                                      &ObserveExporters<&ExporterStats::requests>,
+                                      "Requests sent, retries included", "{requests}", this);
+  meter_->CreateLongObservableCounter("otel.sdk.exporter.request.size",
+                                      &ObserveExporters<&ExporterStats::request_bytes>,
+                                      "Bytes of the payloads of the requests sent", "By", this);
+  meter_->CreateLongObservableCounter("otel.sdk.exporter.retries",
+                                      &ObserveExporters<&ExporterStats::retries>,
+                                      "Retries of failed requests", "{requests}", this);
+  meter_->CreateLongObservableCounter("otel.sdk.exporter.dropped",
+                                      &ObserveExporters<&ExporterStats::dropped>,
+                                      "Requests given up", "{requests}", this);
+  meter_->CreateLongObservableGauge("otel.sdk.exporter.retry_queue.size",
+                                    &ObserveExporters<&ExporterStats::retry_queue_size>,
+                                    "Requests waiting for a retry", "{requests}", this);
+
+  meter_->CreateLongObservableCounter("otel.sdk.metric_reader.collections", &ObserveCollections,
+                                      "Collections of the reader", "{collections}", this);
+  meter_->CreateDoubleObservableCounter("otel.sdk.metric_reader.collection.duration",
+                                        &ObserveCollectionDuration,
+                                        "Time spent aggregating the collected metrics", "s", this);
+  meter_->CreateLongObservableGauge("otel.sdk.metric_reader.series", &ObserveSeries,
+                                    "Series of each instrument in the last collection",
+                                    "{series}", this);
+}
+
+void InternalMetrics::AddBatchProcessor(nostd::string_view name,
+                                        std::function<common::BatchProcessorStats()> get_stats)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  processors_.push_back({std::string(name.data(), name.size()), std::move(get_stats)});
+}
+
+void InternalMetrics::AddExporter(nostd::string_view name,
+                                  std::function<ExporterStats()> get_stats)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  exporters_.push_back({std::string(name.data(), name.size()), std::move(get_stats)});
+}
+
+void InternalMetrics::AddMetricReader(nostd::string_view name, MetricReader &reader)
+{
+  reader.SetSeriesTracking(true);
+  std::lock_guard<std::mutex> guard(lock_);
+  readers_.emplace_back(std::string(name.data(), name.size()), &reader);
+}
+
+template <uint64_t common::BatchProcessorStats::*field>
+void InternalMetrics::ObserveProcessors(metrics_api::ObserverResult<long> &result, void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &processor : self->processors_)
+  {
+    result.Observe(static_cast<long>(processor.get_stats().*field),
+                   {{"processor", nostd::string_view(processor.name)}});
+  }
+}
+
+template <uint64_t ExporterStats::*field>
+void InternalMetrics::ObserveExporters(metrics_api::ObserverResult<long> &result, void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &exporter : self->exporters_)
+  {
+    result.Observe(static_cast<long>(exporter.get_stats().*field),
+                   {{"exporter", nostd::string_view(exporter.name)}});
+  }
+}
+
+void InternalMetrics::ObserveExportDuration(metrics_api::ObserverResult<double> &result,
+                                            void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &processor : self->processors_)
+  {
+    auto duration = processor.get_stats().total_export_duration;
+    result.Observe(std::chrono::duration<double>(duration).count(),
+                   {{"processor", nostd::string_view(processor.name)}});
+  }
+}
+
+void InternalMetrics::ObserveCollections(metrics_api::ObserverResult<long> &result, void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &reader : self->readers_)
+  {
+    result.Observe(static_cast<long>(reader.second->GetStats().collections),
+                   {{"reader", nostd::string_view(reader.first)}});
+  }
+}
+
+void InternalMetrics::ObserveCollectionDuration(metrics_api::ObserverResult<double> &result,
+                                                void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &reader : self->readers_)
+  {
+    auto duration = reader.second->GetStats().total_collection_duration;
+    result.Observe(std::chrono::duration<double>(duration).count(),
+                   {{"reader", nostd::string_view(reader.first)}});
+  }
+}
+
+void InternalMetrics::ObserveSeries(metrics_api::ObserverResult<long> &result, void *state)
+{
+  auto self = static_cast<InternalMetrics *>(state);
+  std::lock_guard<std::mutex> guard(self->lock_);
+  for (auto &reader : self->readers_)
+  {
+    auto stats = reader.second->GetStats();
+    for (auto &instrument : stats.series)
+    {
+      result.Observe(static_cast<long>(instrument.series),
+                     {{"reader", nostd::string_view(reader.first)},
+                      {"meter", nostd::string_view(instrument.meter_name)},
+                      {"instrument", nostd::string_view(instrument.instrument_name)}});
+    }
+  }
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
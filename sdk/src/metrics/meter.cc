@@ -7,6 +7,7 @@
 #  include "opentelemetry/nostd/shared_ptr.h"
 #  include "opentelemetry/sdk/metrics/async_instruments.h"
 #  include "opentelemetry/sdk/metrics/exemplar/no_exemplar_reservoir.h"
+#  include "opentelemetry/sdk/metrics/state/columnar_sum_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/state/multi_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/state/sync_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/sync_instruments.h"
@@ -14,7 +15,12 @@
 
 #  include "opentelemetry/version.h"
 
+#  include <algorithm>
+#  include <atomic>
+#  include <cmath>
+#  include <condition_variable>
 #  include <memory>
+#  include <mutex>
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -25,6 +31,28 @@ namespace metrics
 namespace metrics = opentelemetry::metrics;
 namespace nostd   = opentelemetry::nostd;
 
+namespace
+{
+/* Whether the storage of `view` for a synchronous instrument is a ColumnarSumMetricStorage: the
+ * view asks for it, and the columns can hold what the view aggregates. */
+bool UsesColumnarStorage(const View &view, const InstrumentDescriptor &instrument_descriptor)
+{
+  if (!view.UsesColumnarStorage() || view.GetMaxIdleCollections() != 0 ||
+      view.GetAggregationCardinalityLimit() > kColumnarStorageMaxSeries)
+  {
+    return false;
+  }
+  AggregationType aggregation_type = view.GetAggregationType();
+  if (aggregation_type == AggregationType::kDefault)
+  {
+    aggregation_type = DefaultAggregation::GetDefaultAggregationType(instrument_descriptor.type_);
+  }
+  return aggregation_type == AggregationType::kSum &&
+         (instrument_descriptor.type_ == InstrumentType::kCounter ||
+          instrument_descriptor.type_ == InstrumentType::kUpDownCounter);
+}
+}  // namespace
+
 Meter::Meter(std::shared_ptr<MeterContext> meter_context,
              std::unique_ptr<sdk::instrumentationlibrary::InstrumentationLibrary>
                  instrumentation_library) noexcept
@@ -194,6 +222,106 @@ void Meter::CreateDoubleObservableUpDownCounter(nostd::string_view name,
   RegisterAsyncMetricStorage<double>(instrument_descriptor, callback, state);
 }
 
+void Meter::CreateBatchObservableInstruments(
+    nostd::span<const metrics::BatchObservableInstrument> instruments,
+    void (*callback)(metrics::BatchObserverResult &, void *),
+    void *state) noexcept
+{
+  using Kind      = metrics::BatchObservableInstrument::Kind;
+  using ValueType = metrics::BatchObservableInstrument::ValueType;
+
+  std::unique_ptr<BatchObservableCallback> batch(
+      new BatchObservableCallback(callback, state, instruments.size()));
+  for (size_t i = 0; i < instruments.size(); ++i)
+  {
+    auto &instrument = instruments[i];
+    InstrumentType type;
+    switch (instrument.kind)
+    {
+      case Kind::kCounter:
+        type = InstrumentType::kObservableCounter;
+        break;
+      case Kind::kUpDownCounter:
+        type = InstrumentType::kObservableUpDownCounter;
+        break;
+      default:
+        type = InstrumentType::kObservableGauge;
+        break;
+    }
+    InstrumentDescriptor instrument_descriptor = {
+        std::string{instrument.name.data(), instrument.name.size()},
+        std::string{instrument.description.data(), instrument.description.size()},
+        std::string{instrument.unit.data(), instrument.unit.size()}, type,
+        instrument.value_type == ValueType::kDouble ? InstrumentValueType::kDouble
+                                                    : InstrumentValueType::kLong};
+    if (instrument.value_type == ValueType::kDouble)
+    {
+      RegisterAsyncMetricStorage<double>(instrument_descriptor,
+                                         &BatchObservableCallback::Observe<double>, nullptr,
+                                         batch.get(), i);
+    }
+    else
+    {
+      RegisterAsyncMetricStorage<long>(instrument_descriptor,
+                                       &BatchObservableCallback::Observe<long>, nullptr,
+                                       batch.get(), i);
+    }
+  }
+  batch_callbacks_.push_back(std::move(batch));
+}
+
+void Meter::RecordBatch(const opentelemetry::common::KeyValueIterable &attributes,
+                        nostd::span<const metrics::SyncMeasurement> measurements,
+                        const opentelemetry::context::Context &context) noexcept
+{
+  using InstrumentKind = metrics::SyncMeasurement::InstrumentKind;
+
+  // Hashed once for the storages of all the instruments.
+  HashedAttributes hashed_attributes(attributes);
+  for (auto &measurement : measurements)
+  {
+    auto &instrument    = measurement.GetInstrument();
+    long long_value     = measurement.GetLongValue();
+    double double_value = measurement.GetDoubleValue();
+    switch (measurement.GetInstrumentKind())
+    {
+      case InstrumentKind::kLongCounter:
+        static_cast<LongCounter &>(instrument).RecordLong(long_value, hashed_attributes, context);
+        break;
+      case InstrumentKind::kDoubleCounter:
+        static_cast<DoubleCounter &>(instrument)
+            .RecordDouble(double_value, hashed_attributes, context);
+        break;
+      case InstrumentKind::kLongUpDownCounter:
+        static_cast<LongUpDownCounter &>(instrument)
+            .RecordLong(long_value, hashed_attributes, context);
+        break;
+      case InstrumentKind::kDoubleUpDownCounter:
+        static_cast<DoubleUpDownCounter &>(instrument)
+            .RecordDouble(double_value, hashed_attributes, context);
+        break;
+      case InstrumentKind::kLongHistogram:
+        if (long_value < 0)
+        {
+          // Rejected, and reported, by the histogram.
+          measurement.Record(attributes, context);
+          break;
+        }
+        static_cast<LongHistogram &>(instrument).RecordLong(long_value, hashed_attributes, context);
+        break;
+      case InstrumentKind::kDoubleHistogram:
+        if (double_value < 0 || std::isnan(double_value) || std::isinf(double_value))
+        {
+          measurement.Record(attributes, context);
+          break;
+        }
+        static_cast<DoubleHistogram &>(instrument)
+            .RecordDouble(double_value, hashed_attributes, context);
+        break;
+    }
+  }
+}
+
 const sdk::instrumentationlibrary::InstrumentationLibrary *Meter::GetInstrumentationLibrary()
     const noexcept
 {
@@ -203,12 +331,38 @@ const sdk::instrumentationlibrary::InstrumentationLibrary *Meter::GetInstrumenta
 std::unique_ptr<WritableMetricStorage> Meter::RegisterMetricStorage(
     InstrumentDescriptor &instrument_descriptor)
 {
-  auto view_registry = meter_context_->GetViewRegistry();
   std::unique_ptr<WritableMetricStorage> storages(new MultiMetricStorage());
+  auto multi_storage = static_cast<MultiMetricStorage *>(storages.get());
 
-  auto success = view_registry->FindViews(
+  auto registered = sync_instrument_storages_.find(instrument_descriptor.name_);
+  if (registered != sync_instrument_storages_.end())
+  {
+    const InstrumentDescriptor &existing = registered->second.instrument_descriptor;
+    if (existing.type_ == instrument_descriptor.type_ &&
+        existing.value_type_ == instrument_descriptor.value_type_ &&
+        existing.unit_ == instrument_descriptor.unit_ &&
+        existing.description_ == instrument_descriptor.description_)
+    {
+      // The same instrument again: it records into the storages already collected.
+      for (auto &storage : registered->second.storages)
+      {
+        multi_storage->AddStorage(storage);
+      }
+      return storages;
+    }
+    // A conflicting duplicate records nowhere, so that the first instrument keeps being collected.
+    OTEL_INTERNAL_LOG_WARN("[Meter::RegisterMetricStorage] - Instrument "
+                           << instrument_descriptor.name_
+                           << " is already registered with a different type, unit or description."
+                           << " Only the first registered one will be collected");
+    return storages;
+  }
+
+  std::vector<std::shared_ptr<WritableMetricStorage>> writable_storages;
+  auto view_registry = meter_context_->GetViewRegistry();
+  auto success       = view_registry->FindViews(
       instrument_descriptor, *instrumentation_library_,
-      [this, &instrument_descriptor, &storages](const View &view) {
+      [this, &instrument_descriptor, multi_storage, &writable_storages](const View &view) {
         auto view_instr_desc = instrument_descriptor;
         if (!view.GetName().empty())
         {
@@ -218,14 +372,43 @@ std::unique_ptr<WritableMetricStorage> Meter::RegisterMetricStorage(
         {
           view_instr_desc.description_ = view.GetDescription();
         }
-        auto storage = std::shared_ptr<SyncMetricStorage>(new SyncMetricStorage(
+        if (UsesColumnarStorage(view, view_instr_desc))
+        {
+          std::shared_ptr<MetricStorage> storage;
+          std::shared_ptr<WritableMetricStorage> writable_storage;
+          if (view_instr_desc.value_type_ == InstrumentValueType::kLong)
+          {
+            auto columnar_storage = std::make_shared<ColumnarSumMetricStorage<long>>(
+                view_instr_desc, &view.GetAttributesProcessor(),
+                view.GetAggregationCardinalityLimit());
+            storage          = columnar_storage;
+            writable_storage = columnar_storage;
+          }
+          else
+          {
+            auto columnar_storage = std::make_shared<ColumnarSumMetricStorage<double>>(
+                view_instr_desc, &view.GetAttributesProcessor(),
+                view.GetAggregationCardinalityLimit());
+            storage          = columnar_storage;
+            writable_storage = columnar_storage;
+          }
+          storage_registry_[instrument_descriptor.name_] = storage;
+          multi_storage->AddStorage(writable_storage);
+          writable_storages.push_back(writable_storage);
+          return true;
+        }
+        auto storage = SyncMetricStorage::Create(
             view_instr_desc, view.GetAggregationType(), &view.GetAttributesProcessor(),
-            NoExemplarReservoir::GetNoExemplarReservoir()));
+            NoExemplarReservoir::GetNoExemplarReservoir(), view.GetAggregationCardinalityLimit(),
+            view.GetMaxIdleCollections(), meter_context_->GetStoragePartitionCount(),
+            meter_context_->GetMemoryBudget());
         storage_registry_[instrument_descriptor.name_] = storage;
-        auto multi_storage = static_cast<MultiMetricStorage *>(storages.get());
         multi_storage->AddStorage(storage);
+        writable_storages.push_back(storage);
         return true;
       });
+  sync_instrument_storages_[instrument_descriptor.name_] = {instrument_descriptor,
+                                                            std::move(writable_storages)};
 
   if (!success)
   {
@@ -241,16 +424,94 @@ std::vector<MetricData> Meter::Collect(CollectorHandle *collector,
                                        opentelemetry::common::SystemTimestamp collect_ts) noexcept
 {
   std::vector<MetricData> metric_data_list;
+  Collect(collector, collect_ts, metric_data_list);
+  return metric_data_list;
+}
+
+void Meter::Collect(CollectorHandle *collector,
+                    opentelemetry::common::SystemTimestamp collect_ts,
+                    std::vector<MetricData> &metric_data_list) noexcept
+{
+  // Lets the observable callbacks of the meter run while the storages are being collected.
   for (auto &metric_storage : storage_registry_)
   {
-    metric_storage.second->Collect(collector, meter_context_->GetCollectors(),
-                                   meter_context_->GetSDKStartTime(), collect_ts,
-                                   [&metric_data_list](MetricData metric_data) {
-                                     metric_data_list.push_back(metric_data);
-                                     return true;
-                                   });
+    metric_storage.second->BeginCollect();
+  }
+
+  ObservableCallbackExecutor *executor = meter_context_->GetCollectionExecutor();
+  size_t parallelism =
+      (std::min)(meter_context_->GetCollectionParallelism(), storage_registry_.size());
+  if (parallelism <= 1 || executor == nullptr)
+  {
+    // Swap the results with the entries of the previous collection, which the storages then
+    // refill next time.
+    size_t used = 0;
+    for (auto &metric_storage : storage_registry_)
+    {
+      metric_storage.second->Collect(collector, meter_context_->GetCollectors(),
+                                     meter_context_->GetSDKStartTime(), collect_ts,
+                                     [&metric_data_list, &used](MetricData &metric_data) {
+                                       if (used == metric_data_list.size())
+                                       {
+                                         metric_data_list.emplace_back();
+                                       }
+                                       std::swap(metric_data_list[used++], metric_data);
+                                       return true;
+                                     });
+    }
+    metric_data_list.erase(metric_data_list.begin() + used, metric_data_list.end());
+    return;
+  }
+
+  // Workers take the next storage to collect until none is left. Each storage has a slot of its
+  // own for its results, so that they are reported in the same order as by a single thread.
+  std::vector<MetricStorage *> storages;
+  storages.reserve(storage_registry_.size());
+  for (auto &metric_storage : storage_registry_)
+  {
+    storages.push_back(metric_storage.second.get());
+  }
+  std::vector<std::vector<MetricData>> results(storages.size());
+  std::atomic<size_t> next_storage{0};
+  auto worker = [&]() {
+    for (size_t i = next_storage++; i < storages.size(); i = next_storage++)
+    {
+      storages[i]->Collect(collector, meter_context_->GetCollectors(),
+                           meter_context_->GetSDKStartTime(), collect_ts,
+                           [&results, i](MetricData &metric_data) {
+                             results[i].emplace_back();
+                             std::swap(results[i].back(), metric_data);
+                             return true;
+                           });
+    }
+  };
+  // The threads of the executor help the reader's thread, which then waits for them to return.
+  std::mutex workers_lock;
+  std::condition_variable workers_done;
+  size_t running_workers = parallelism - 1;
+  for (size_t i = 1; i < parallelism; i++)
+  {
+    executor->Submit([&]() {
+      worker();
+      std::lock_guard<std::mutex> guard(workers_lock);
+      if (--running_workers == 0)
+      {
+        workers_done.notify_one();
+      }
+    });
+  }
+  worker();
+  std::unique_lock<std::mutex> lock(workers_lock);
+  workers_done.wait(lock, [&running_workers] { return running_workers == 0; });
+
+  metric_data_list.clear();
+  for (auto &storage_results : results)
+  {
+    for (auto &metric_data : storage_results)
+    {
+      metric_data_list.push_back(std::move(metric_data));
+    }
   }
-  return metric_data_list;
 }
 
 }  // namespace metrics
@@ -4,6 +4,7 @@
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/meter_context.h"
 #  include "opentelemetry/sdk/common/global_log_handler.h"
+#  include "opentelemetry/sdk/common/numa.h"
 #  include "opentelemetry/sdk/metrics/metric_reader.h"
 #  include "opentelemetry/sdk_config.h"
 #  include "opentelemetry/version.h"
@@ -44,6 +45,71 @@ opentelemetry::common::SystemTimestamp MeterContext::GetSDKStartTime() noexcept
   return sdk_start_ts_;
 }
 
+void MeterContext::SetCollectionParallelism(size_t parallelism) noexcept
+{
+  collection_executor_.reset();
+  if (parallelism > 1)
+  {
+    // The reader's thread is one of the collecting threads.
+    collection_executor_.reset(new ObservableCallbackExecutor(parallelism - 1, "otel-collection"));
+  }
+  collection_parallelism_ = collection_executor_ ? collection_executor_->GetThreadCount() + 1 : 1;
+}
+
+size_t MeterContext::GetCollectionParallelism() const noexcept
+{
+  return collection_parallelism_;
+}
+
+ObservableCallbackExecutor *MeterContext::GetCollectionExecutor() const noexcept
+{
+  return collection_executor_.get();
+}
+
+void MeterContext::SetNumaAwareStorage(bool numa_aware) noexcept
+{
+  storage_partition_count_ = numa_aware ? opentelemetry::sdk::common::GetNumaNodeCount() : 1;
+}
+
+size_t MeterContext::GetStoragePartitionCount() const noexcept
+{
+  return storage_partition_count_;
+}
+
+void MeterContext::SetMemoryBudget(
+    std::shared_ptr<opentelemetry::sdk::common::MemoryBudget> memory_budget) noexcept
+{
+  memory_budget_ = std::move(memory_budget);
+}
+
+const std::shared_ptr<opentelemetry::sdk::common::MemoryBudget> &MeterContext::GetMemoryBudget()
+    const noexcept
+{
+  return memory_budget_;
+}
+
+void MeterContext::SetObservableCallbackOptions(const ObservableCallbackOptions &options) noexcept
+{
+  observable_callback_executor_.reset(
+      options.num_threads > 0 ? new ObservableCallbackExecutor(options.num_threads) : nullptr);
+  if (observable_callback_executor_ && observable_callback_executor_->GetThreadCount() == 0)
+  {
+    // No thread could be started: the callbacks run inline.
+    observable_callback_executor_.reset();
+  }
+  observable_callback_timeout_ = options.timeout;
+}
+
+ObservableCallbackExecutor *MeterContext::GetObservableCallbackExecutor() const noexcept
+{
+  return observable_callback_executor_.get();
+}
+
+std::chrono::milliseconds MeterContext::GetObservableCallbackTimeout() const noexcept
+{
+  return observable_callback_timeout_;
+}
+
 void MeterContext::AddMetricReader(std::unique_ptr<MetricReader> reader) noexcept
 {
   auto collector =
@@ -38,20 +38,19 @@ nostd::shared_ptr<metrics_api::Meter> MeterProvider::GetMeter(
     name = "";
   }
 
-  const std::lock_guard<std::mutex> guard(lock_);
-
-  for (auto &meter : context_->GetMeters())
-  {
-    auto meter_lib = meter->GetInstrumentationLibrary();
-    if (meter_lib->equal(name, version, schema_url))
-    {
-      return nostd::shared_ptr<metrics_api::Meter>{meter};
-    }
-  }
-  auto lib   = instrumentationlibrary::InstrumentationLibrary::Create(name, version, schema_url);
-  auto meter = std::shared_ptr<Meter>(new Meter(context_, std::move(lib)));
-  context_->AddMeter(meter);
-  return nostd::shared_ptr<metrics_api::Meter>{meter};
+  size_t hash = meters_.Hash(name, version, schema_url);
+  return nostd::shared_ptr<metrics_api::Meter>{meters_.FindOrInsert(
+      hash,
+      [&](const Meter &meter) {
+        return meter.GetInstrumentationLibrary()->equal(name, version, schema_url);
+      },
+      [&]() {
+        auto lib =
+            instrumentationlibrary::InstrumentationLibrary::Create(name, version, schema_url);
+        auto meter = std::shared_ptr<Meter>(new Meter(context_, std::move(lib)));
+        context_->AddMeter(meter);
+        return meter;
+      })};
 }
 
 const resource::Resource &MeterProvider::GetResource() const noexcept
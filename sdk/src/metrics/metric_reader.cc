@@ -3,6 +3,7 @@
 
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/metric_reader.h"
+#  include "opentelemetry/sdk/common/tracepoint.h"
 #  include "opentelemetry/sdk/metrics/export/metric_producer.h"
 
 #  include <mutex>
@@ -36,13 +37,70 @@ bool MetricReader::Collect(
     OTEL_INTERNAL_LOG_WARN(
         "MetricReader::Collect Cannot invoke Collect(). No MetricProducer registered for "
         "collection!")
+    return false;
   }
   if (IsShutdown())
   {
     OTEL_INTERNAL_LOG_WARN("MetricReader::Collect Cannot invoke Collect(). Shutdown in progress!");
   }
 
-  return metric_producer_->Collect(callback);
+  auto start = std::chrono::steady_clock::now();
+  OTEL_SDK_TRACEPOINT0(collect__begin);
+  return metric_producer_->Collect([&](ResourceMetrics &metric_data) {
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    OTEL_SDK_TRACEPOINT1(collect__end, static_cast<int64_t>(duration.count()) * 1000);
+    std::vector<MetricReaderStats::InstrumentSeries> series;
+    bool track_series = track_series_.load(std::memory_order_relaxed);
+    if (track_series)
+    {
+      for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+      {
+        for (auto &data : instrumentation_info.metric_data_)
+        {
+          series.push_back({instrumentation_info.instrumentation_library_->GetName(),
+                            data.instrument_descriptor.name_, data.point_data_attr_.size()});
+        }
+      }
+    }
+    {
+      std::lock_guard<std::mutex> guard(stats_lock_);
+      stats_.collections++;
+      stats_.last_collection_duration = duration;
+      stats_.total_collection_duration += duration;
+      if (track_series)
+      {
+        stats_.series.swap(series);
+      }
+    }
+    return callback(metric_data);
+  });
+}
+
+MetricReaderStats MetricReader::GetStats() const
+{
+  std::lock_guard<std::mutex> guard(stats_lock_);
+  return stats_;
+}
+
+void MetricReader::SetSeriesTracking(bool enabled) noexcept
+{
+  track_series_.store(enabled, std::memory_order_relaxed);
+  if (!enabled)
+  {
+    std::lock_guard<std::mutex> guard(stats_lock_);
+    stats_.series.clear();
+  }
+}
+
+void MetricReader::SetChangedOnlyExport(size_t keepalive_collections) noexcept
+{
+  unchanged_keepalive_.store(keepalive_collections, std::memory_order_relaxed);
+}
+
+size_t MetricReader::GetUnchangedSeriesKeepalive() const noexcept
+{
+  return unchanged_keepalive_.load(std::memory_order_relaxed);
 }
 
 bool MetricReader::Shutdown(std::chrono::microseconds timeout) noexcept
@@ -0,0 +1,139 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/state/batch_observable_callback.h"
+
+#  include <algorithm>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+/* Reports the observations of an instrument to the results of all its storages. */
+template <class T>
+class BatchObservableCallback::MultiObserverResult final
+    : public opentelemetry::metrics::ObserverResult<T>
+{
+public:
+  void AddResult(ObserverResult<T> *result) { results_.push_back(result); }
+
+  void Observe(T value) noexcept override
+  {
+    for (auto result : results_)
+    {
+      result->Observe(value);
+    }
+  }
+
+  void Observe(T value, const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    for (auto result : results_)
+    {
+      result->Observe(value, attributes);
+    }
+  }
+
+private:
+  std::vector<ObserverResult<T> *> results_;
+};
+
+/* The results of a run of the callback. */
+class BatchObservableCallback::Result final : public opentelemetry::metrics::BatchObserverResult
+{
+public:
+  // The result past the instruments, to which no storage subscribes, drops the observations
+  // reported for an index out of range.
+  explicit Result(size_t instrument_count)
+      : long_results_(instrument_count + 1), double_results_(instrument_count + 1)
+  {}
+
+  opentelemetry::metrics::ObserverResult<long> &GetLongResult(size_t index) noexcept override
+  {
+    return long_results_[(std::min)(index, long_results_.size() - 1)];
+  }
+
+  opentelemetry::metrics::ObserverResult<double> &GetDoubleResult(size_t index) noexcept override
+  {
+    return double_results_[(std::min)(index, double_results_.size() - 1)];
+  }
+
+  // No storage subscribes to the results of the other value type than the instrument's, so they
+  // drop the observations too.
+  std::vector<MultiObserverResult<long>> long_results_;
+  std::vector<MultiObserverResult<double>> double_results_;
+};
+
+BatchObservableCallback::BatchObservableCallback(
+    void (*callback)(opentelemetry::metrics::BatchObserverResult &, void *),
+    void *state,
+    size_t instrument_count) noexcept
+    : callback_(callback), state_(state), instrument_count_(instrument_count)
+{}
+
+BatchObservableCallback::Subscriber *BatchObservableCallback::Subscribe(
+    size_t index,
+    bool is_double,
+    const AttributesProcessor *attributes_processor)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  subscribers_.emplace_back(new Subscriber(this, index, is_double, attributes_processor));
+  return subscribers_.back().get();
+}
+
+void BatchObservableCallback::Run()
+{
+  Result result(instrument_count_);
+  for (auto &subscriber : subscribers_)
+  {
+    if (subscriber->is_double_)
+    {
+      subscriber->double_result_.reset(
+          new ObserverResult<double>(subscriber->attributes_processor_));
+      result.double_results_[subscriber->index_].AddResult(subscriber->double_result_.get());
+    }
+    else
+    {
+      subscriber->long_result_.reset(new ObserverResult<long>(subscriber->attributes_processor_));
+      result.long_results_[subscriber->index_].AddResult(subscriber->long_result_.get());
+    }
+    subscriber->pending_ = true;
+  }
+  callback_(result, state_);
+}
+
+void BatchObservableCallback::Take(Subscriber &subscriber, ObserverResult<long> &result)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!subscriber.pending_)
+  {
+    Run();
+  }
+  subscriber.pending_ = false;
+  if (subscriber.long_result_)
+  {
+    result.Swap(*subscriber.long_result_);
+    subscriber.long_result_.reset();
+  }
+}
+
+void BatchObservableCallback::Take(Subscriber &subscriber, ObserverResult<double> &result)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!subscriber.pending_)
+  {
+    Run();
+  }
+  subscriber.pending_ = false;
+  if (subscriber.double_result_)
+  {
+    result.Swap(*subscriber.double_result_);
+    subscriber.double_result_.reset();
+  }
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
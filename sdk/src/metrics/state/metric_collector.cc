@@ -29,20 +29,26 @@ AggregationTemporality MetricCollector::GetAggregationTemporality() noexcept
   return metric_reader_->GetAggregationTemporality();
 }
 
+size_t MetricCollector::GetUnchangedSeriesKeepalive() noexcept
+{
+  return metric_reader_->GetUnchangedSeriesKeepalive();
+}
+
 bool MetricCollector::Collect(
     nostd::function_ref<bool(ResourceMetrics &metric_data)> callback) noexcept
 {
-  ResourceMetrics resource_metrics;
-  for (auto &meter : meter_context_->GetMeters())
+  std::lock_guard<std::mutex> guard(collect_lock_);
+  auto meters                   = meter_context_->GetMeters();
+  auto &instrumentation_metrics = resource_metrics_.instrumentation_info_metric_data_;
+  instrumentation_metrics.resize(meters.size());
+  for (size_t i = 0; i < meters.size(); i++)
   {
     auto collection_ts = std::chrono::system_clock::now();
-    InstrumentationInfoMetrics instrumentation_info_metrics;
-    instrumentation_info_metrics.metric_data_             = meter->Collect(this, collection_ts);
-    instrumentation_info_metrics.instrumentation_library_ = meter->GetInstrumentationLibrary();
-    resource_metrics.instrumentation_info_metric_data_.push_back(instrumentation_info_metrics);
+    meters[i]->Collect(this, collection_ts, instrumentation_metrics[i].metric_data_);
+    instrumentation_metrics[i].instrumentation_library_ = meters[i]->GetInstrumentationLibrary();
   }
-  resource_metrics.resource_ = &meter_context_->GetResource();
-  callback(resource_metrics);
+  resource_metrics_.resource_ = &meter_context_->GetResource();
+  callback(resource_metrics_);
   return true;
 }
 
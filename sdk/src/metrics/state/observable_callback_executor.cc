@@ -0,0 +1,91 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/state/observable_callback_executor.h"
+#  include "opentelemetry/sdk/common/global_log_handler.h"
+#  include "opentelemetry/sdk/common/thread_options.h"
+
+#  include <system_error>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace metrics
+{
+
+ObservableCallbackExecutor::ObservableCallbackExecutor(size_t num_threads,
+                                                       const char *thread_name)
+    : thread_name_(thread_name)
+{
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; i++)
+  {
+#  if __EXCEPTIONS
+    try
+    {
+      workers_.emplace_back(&ObservableCallbackExecutor::DoWork, this);
+    }
+    catch (const std::system_error &e)
+    {
+      // Keeps the threads already started, which the destructor joins.
+      OTEL_INTERNAL_LOG_ERROR("[ObservableCallbackExecutor] Started " << i << " of " << num_threads
+                                                                      << " threads: " << e.what());
+      break;
+    }
+#  else
+    workers_.emplace_back(&ObservableCallbackExecutor::DoWork, this);
+#  endif
+  }
+}
+
+ObservableCallbackExecutor::~ObservableCallbackExecutor()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    stopped_ = true;
+    tasks_.clear();
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+void ObservableCallbackExecutor::Submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (stopped_)
+    {
+      return;
+    }
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void ObservableCallbackExecutor::DoWork()
+{
+  sdk::common::ApplyThreadOptions(sdk::common::ThreadOptions(), thread_name_);
+  std::unique_lock<std::mutex> lock(lock_);
+  for (;;)
+  {
+    cv_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+    if (stopped_)
+    {
+      return;
+    }
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+}  // namespace metrics
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
@@ -4,6 +4,7 @@
 #ifndef ENABLE_METRICS_PREVIEW
 
 #  include "opentelemetry/sdk/metrics/state/sync_metric_storage.h"
+#  include "opentelemetry/sdk/common/global_log_handler.h"
 
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
@@ -11,20 +12,225 @@ namespace sdk
 namespace metrics
 {
 
+namespace
+{
+template <class LongAggregation, class DoubleAggregation>
+std::shared_ptr<SyncMetricStorage> CreateTyped(
+    InstrumentDescriptor instrument_descriptor,
+    const AggregationType aggregation_type,
+    const AttributesProcessor *attributes_processor,
+    nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir,
+    size_t attributes_limit,
+    size_t max_idle_collections,
+    size_t partition_count,
+    std::shared_ptr<common::MemoryBudget> memory_budget)
+{
+  if (instrument_descriptor.value_type_ == InstrumentValueType::kLong)
+  {
+    return std::shared_ptr<SyncMetricStorage>(new TypedSyncMetricStorage<long, LongAggregation>(
+        instrument_descriptor, aggregation_type, attributes_processor,
+        std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+        std::move(memory_budget)));
+  }
+  return std::shared_ptr<SyncMetricStorage>(new TypedSyncMetricStorage<double, DoubleAggregation>(
+      instrument_descriptor, aggregation_type, attributes_processor,
+      std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+      std::move(memory_budget)));
+}
+}  // namespace
+
+std::shared_ptr<SyncMetricStorage> SyncMetricStorage::Create(
+    InstrumentDescriptor instrument_descriptor,
+    const AggregationType aggregation_type,
+    const AttributesProcessor *attributes_processor,
+    nostd::shared_ptr<ExemplarReservoir> &&exemplar_reservoir,
+    size_t attributes_limit,
+    size_t max_idle_collections,
+    size_t partition_count,
+    std::shared_ptr<common::MemoryBudget> memory_budget)
+{
+  // Must pick the aggregation DefaultAggregation::CreateAggregation() creates, which the rest of
+  // the collection path assumes.
+  AggregationType resolved_type = aggregation_type;
+  if (resolved_type == AggregationType::kDefault)
+  {
+    resolved_type = DefaultAggregation::GetDefaultAggregationType(instrument_descriptor.type_);
+  }
+  switch (resolved_type)
+  {
+    case AggregationType::kSum:
+      return CreateTyped<LongSumAggregation, DoubleSumAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    case AggregationType::kStripedSum:
+      return CreateTyped<LongStripedSumAggregation, DoubleStripedSumAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    case AggregationType::kHistogram:
+      return CreateTyped<LongHistogramAggregation, DoubleHistogramAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    case AggregationType::kExponentialHistogram:
+      return CreateTyped<LongExponentialHistogramAggregation,
+                         DoubleExponentialHistogramAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    case AggregationType::kSketch:
+      return CreateTyped<LongSketchAggregation, DoubleSketchAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    case AggregationType::kLastValue:
+      return CreateTyped<LongLastValueAggregation, DoubleLastValueAggregation>(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget));
+    default:
+      return std::shared_ptr<SyncMetricStorage>(new SyncMetricStorage(
+          instrument_descriptor, aggregation_type, attributes_processor,
+          std::move(exemplar_reservoir), attributes_limit, max_idle_collections, partition_count,
+          std::move(memory_budget)));
+  }
+}
+
+class SyncMetricStorage::BoundStorage : public BoundWritableMetricStorage
+{
+public:
+  BoundStorage(std::shared_ptr<BoundSeries> series, InstrumentValueType value_type)
+      : series_(std::move(series)), value_type_(value_type)
+  {}
+
+  void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override
+  {
+    if (value_type_ != InstrumentValueType::kLong)
+    {
+      return;
+    }
+    series_->aggregation->Aggregate(value);
+    series_->updated.store(true, std::memory_order_release);
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
+  {
+    if (value_type_ != InstrumentValueType::kDouble)
+    {
+      return;
+    }
+    series_->aggregation->Aggregate(value);
+    series_->updated.store(true, std::memory_order_release);
+  }
+
+private:
+  std::shared_ptr<BoundSeries> series_;
+  InstrumentValueType value_type_;
+};
+
+std::unique_ptr<BoundWritableMetricStorage> SyncMetricStorage::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  std::shared_ptr<BoundSeries> series(new BoundSeries(attributes_processor_->process(attributes),
+                                                      create_default_aggregation_(),
+                                                      create_default_aggregation_()));
+  {
+    std::lock_guard<std::mutex> guard(bound_series_lock_);
+    bound_series_.push_back(series);
+  }
+  return std::unique_ptr<BoundWritableMetricStorage>(
+      new BoundStorage(std::move(series), instrument_descriptor_.value_type_));
+}
+
+void SyncMetricStorage::CollectBoundSeries(AttributesHashMap &delta_metrics) noexcept
+{
+  std::lock_guard<std::mutex> guard(bound_series_lock_);
+  for (size_t i = 0; i < bound_series_.size();)
+  {
+    BoundSeries &series = *bound_series_[i];
+    if (series.updated.exchange(false, std::memory_order_acq_rel))
+    {
+      std::unique_ptr<Aggregation> snapshot = create_default_aggregation_();
+      snapshot->MergeFrom(*series.aggregation);
+      std::unique_ptr<Aggregation> delta = series.last_collected->Diff(*snapshot);
+      series.last_collected              = std::move(snapshot);
+
+      // Several handles, as well as unbound recordings, may share the same attributes.
+      bool created          = false;
+      Aggregation *existing = delta_metrics.GetOrSetDefault(series.attributes, [&]() {
+        created = true;
+        return std::move(delta);
+      });
+      if (!created)
+      {
+        existing->MergeFrom(*delta);
+      }
+    }
+
+    // Only the storage holds the series: no handle can record into it anymore.
+    if (bound_series_[i].use_count() == 1 && !series.updated.load(std::memory_order_acquire))
+    {
+      bound_series_[i] = std::move(bound_series_.back());
+      bound_series_.pop_back();
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+void SyncMetricStorage::WarnOverflow(size_t overflow_count, size_t reported) const noexcept
+{
+  if (overflow_count > reported)
+  {
+    OTEL_INTERNAL_LOG_WARN("[SyncMetricStorage::Collect] - "
+                           << overflow_count - reported << " measurements of instrument "
+                           << instrument_descriptor_.name_
+                           << " exceeded the cardinality limit and were folded into the "
+                              "overflow series");
+  }
+}
+
 bool SyncMetricStorage::Collect(CollectorHandle *collector,
                                 nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                                 opentelemetry::common::SystemTimestamp sdk_start_ts,
                                 opentelemetry::common::SystemTimestamp collection_ts,
-                                nostd::function_ref<bool(MetricData)> callback) noexcept
+                                nostd::function_ref<bool(MetricData &)> callback) noexcept
 {
-  opentelemetry::common::SystemTimestamp last_collection_ts = sdk_start_ts;
-  auto aggregation_temporarily = collector->GetAggregationTemporality();
+  std::lock_guard<std::mutex> guard(collect_lock_);
+  for (auto &col : collectors)
+  {
+    cumulative_in_place_ = cumulative_in_place_ &&
+                           col->GetAggregationTemporality() == AggregationTemporality::kCumulative;
+  }
+  if (cumulative_in_place_)
+  {
+    // Report the running totals in place: there is nothing to stash or merge. The bound series
+    // add what they recorded since the previous collection to them.
+    bool result = true;
+    attributes_hashmap_.Update([&](AttributesHashMap &cumulative_metrics) {
+      CollectBoundSeries(cumulative_metrics);
+      WarnOverflow(cumulative_metrics.OverflowCount(), cumulative_overflow_count_);
+      cumulative_overflow_count_ = cumulative_metrics.OverflowCount();
+      result = temporal_metric_storage_.buildCumulativeMetrics(collector, sdk_start_ts,
+                                                               collection_ts, cumulative_metrics,
+                                                               callback);
+    });
+    return result;
+  }
 
   // Add the current delta metrics to `unreported metrics stash` for all the collectors,
   // this will also empty the delta metrics hashmap, and make it available for
-  // recordings
-  std::shared_ptr<AttributesHashMap> delta_metrics = std::move(attributes_hashmap_);
-  attributes_hashmap_.reset(new AttributesHashMap);
+  // recordings. Swap() returns once no recording thread uses the delta metrics anymore.
+  // After running totals were kept in place, the first swap hands them over as a single delta.
+  size_t overflow_count = 0;
+  std::shared_ptr<AttributesHashMap> delta_metrics(
+      attributes_hashmap_.Swap(create_default_aggregation_, overflow_count));
+  WarnOverflow(overflow_count, cumulative_overflow_count_);
+  cumulative_overflow_count_ = 0;
+  CollectBoundSeries(*delta_metrics);
 
   return temporal_metric_storage_.buildMetrics(collector, collectors, sdk_start_ts, collection_ts,
                                                std::move(delta_metrics), callback);
@@ -6,122 +6,309 @@
 #  include "opentelemetry/sdk/metrics/state/temporal_metric_storage.h"
 #  include "opentelemetry/sdk/metrics/aggregation/default_aggregation.h"
 
+#  include <cstring>
+#  include <iterator>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
 namespace metrics
 {
+namespace
+{
+uint64_t ValueFingerprint(const ValueType &value) noexcept
+{
+  if (nostd::holds_alternative<long>(value))
+  {
+    return static_cast<uint64_t>(nostd::get<long>(value));
+  }
+  double v      = nostd::get<double>(value);
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+/* Identifies the measurements aggregated in a cumulative point: it changes with each of them. */
+struct PointFingerprint
+{
+  uint64_t operator()(const SumPointData &point) { return ValueFingerprint(point.value_); }
+
+  uint64_t operator()(const LastValuePointData &point)
+  {
+    return static_cast<uint64_t>(point.sample_ts_.time_since_epoch().count());
+  }
+
+  uint64_t operator()(const HistogramPointData &point) { return point.count_; }
 
-TemporalMetricStorage::TemporalMetricStorage(InstrumentDescriptor instrument_descriptor)
-    : instrument_descriptor_(instrument_descriptor)
+  uint64_t operator()(const ExponentialHistogramPointData &point) { return point.count_; }
+
+  uint64_t operator()(const SketchPointData &point) { return point.count_; }
+
+  uint64_t operator()(const DropPointData &) { return 0; }
+};
+}  // namespace
+
+TemporalMetricStorage::TemporalMetricStorage(InstrumentDescriptor instrument_descriptor,
+                                             AggregationType aggregation_type,
+                                             size_t attributes_limit,
+                                             size_t max_idle_collections)
+    : instrument_descriptor_(instrument_descriptor),
+      aggregation_type_(aggregation_type),
+      attributes_limit_(attributes_limit),
+      max_idle_collections_(max_idle_collections)
 {}
 
+void TemporalMetricStorage::MergeInto(AttributesHashMap &target,
+                                      const AttributesHashMap &delta,
+                                      CumulativeMetrics *cumulative) const noexcept
+{
+  // The hashes stored in `delta` are reused rather than computed again for each merge.
+  delta.GetAllEntriesWithHash([&](size_t hash, const MetricAttributes &attributes,
+                                  Aggregation &aggregation) {
+    bool created          = false;
+    Aggregation *existing = target.GetOrSetDefault(hash, attributes, [&]() {
+      created = true;
+      return DefaultAggregation::CloneAggregation(aggregation_type_, instrument_descriptor_,
+                                                  aggregation);
+    });
+    if (!created)
+    {
+      existing->MergeFrom(aggregation);
+    }
+    if (cumulative)
+    {
+      cumulative->last_updates[existing] = cumulative->collection_count;
+    }
+    return true;
+  });
+}
+
+void TemporalMetricStorage::EvictIdleSeries(CumulativeMetrics &cumulative) const noexcept
+{
+  cumulative.attributes_map->EraseIf([&](const MetricAttributes &, Aggregation &aggregation) {
+    auto last_update = cumulative.last_updates.find(&aggregation);
+    if (last_update != cumulative.last_updates.end() &&
+        cumulative.collection_count - last_update->second < max_idle_collections_)
+    {
+      return false;
+    }
+    if (last_update != cumulative.last_updates.end())
+    {
+      cumulative.last_updates.erase(last_update);
+    }
+    return true;
+  });
+}
+
+void TemporalMetricStorage::TrimUnreportedDeltas(
+    nostd::span<std::shared_ptr<CollectorHandle>> collectors) noexcept
+{
+  for (auto it = last_reported_metrics_.begin(); it != last_reported_metrics_.end();)
+  {
+    bool present = false;
+    for (auto &col : collectors)
+    {
+      present = present || col.get() == it->first;
+    }
+    it = present ? std::next(it) : last_reported_metrics_.erase(it);
+  }
+
+  uint64_t reported = first_delta_ + unreported_deltas_.size();
+  for (auto &col : collectors)
+  {
+    uint64_t next_delta = cumulative_metrics_.next_delta;
+    if (col->GetAggregationTemporality() == AggregationTemporality::kDelta)
+    {
+      next_delta = last_reported_metrics_[col.get()].next_delta;
+    }
+    reported = next_delta < reported ? next_delta : reported;
+  }
+  while (first_delta_ < reported)
+  {
+    unreported_deltas_.pop_front();
+    first_delta_++;
+  }
+}
+
 bool TemporalMetricStorage::buildMetrics(CollectorHandle *collector,
                                          nostd::span<std::shared_ptr<CollectorHandle>> collectors,
                                          opentelemetry::common::SystemTimestamp sdk_start_ts,
                                          opentelemetry::common::SystemTimestamp collection_ts,
                                          std::shared_ptr<AttributesHashMap> delta_metrics,
-                                         nostd::function_ref<bool(MetricData)> callback) noexcept
+                                         nostd::function_ref<bool(MetricData &)> callback) noexcept
 {
   std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
-  opentelemetry::common::SystemTimestamp last_collection_ts = sdk_start_ts;
   auto aggregation_temporarily = collector->GetAggregationTemporality();
-  for (auto &col : collectors)
-  {
-    unreported_metrics_[col.get()].push_back(delta_metrics);
-  }
 
-  // Get the unreported metrics for the `collector` from `unreported metrics stash`
-  // since last collection, this will also cleanup the unreported metrics for `collector`
-  // from the stash.
-  auto present = unreported_metrics_.find(collector);
-  if (present == unreported_metrics_.end())
-  {
-    // no unreported metrics for the collector, return.
-    return true;
-  }
-  auto unreported_list = std::move(present->second);
-  // Iterate over the unreporter metrics for `collector` and store result in `merged_metrics`
-  std::unique_ptr<AttributesHashMap> merged_metrics(new AttributesHashMap);
-  for (auto &agg_hashmap : unreported_list)
+  // The delta map is stashed once for all the collectors. Collectors seen for the first time get
+  // the delta maps from this one on.
+  uint64_t delta_sequence = first_delta_ + unreported_deltas_.size();
+  auto state              = [&](CollectorHandle *col) -> LastReportedMetrics & {
+    auto reported = last_reported_metrics_.find(col);
+    if (reported == last_reported_metrics_.end())
+    {
+      reported = last_reported_metrics_.insert(std::make_pair(col, LastReportedMetrics{})).first;
+      reported->second.collection_ts = sdk_start_ts;
+      reported->second.next_delta    = delta_sequence;
+    }
+    return reported->second;
+  };
+  for (auto &col : collectors)
   {
-    agg_hashmap->GetAllEnteries(
-        [&merged_metrics, this](const MetricAttributes &attributes, Aggregation &aggregation) {
-          auto agg = merged_metrics->Get(attributes);
-          if (agg)
-          {
-            merged_metrics->Set(attributes, agg->Merge(aggregation));
-          }
-          else
-          {
-            merged_metrics->Set(
-                attributes,
-                DefaultAggregation::CreateAggregation(instrument_descriptor_)->Merge(aggregation));
-            merged_metrics->GetAllEnteries(
-                [](const MetricAttributes &attr, Aggregation &aggr) { return true; });
-          }
-          return true;
-        });
+    state(col.get());
   }
-  // Get the last reported metrics for the `collector` from `last reported metrics` stash
-  //   - If the aggregation_temporarily for the collector is cumulative
-  //       - Merge the last reported metrics with unreported metrics (which is in merged_metrics),
-  //           Final result of merge would be in merged_metrics.
-  //       - Move the final merge to the `last reported metrics` stash.
-  //   - If the aggregation_temporarily is delta
-  //       - Store the unreported metrics for `collector` (which is in merged_mtrics) to
-  //          `last reported metrics` stash.
+  LastReportedMetrics &reported = state(collector);
+  unreported_deltas_.push_back(std::move(delta_metrics));
+  uint64_t end_delta = delta_sequence + 1;
 
-  auto reported = last_reported_metrics_.find(collector);
-  if (reported != last_reported_metrics_.end())
+  // The unreported delta maps are shared with the other collectors and must not be modified.
+  //   - If the aggregation_temporarily for the collector is cumulative, merge the delta maps not
+  //       merged yet in place into the cumulative metrics shared by all the cumulative
+  //       collectors, and report them.
+  //   - If the aggregation_temporarily is delta, report a single unreported map as is, or merge
+  //       several of them into a new map.
+  std::shared_ptr<AttributesHashMap> delta_result;
+  const AttributesHashMap *result_to_export;
+  if (aggregation_temporarily == AggregationTemporality::kCumulative)
   {
-    last_collection_ts     = last_reported_metrics_[collector].collection_ts;
-    auto last_aggr_hashmap = std::move(last_reported_metrics_[collector].attributes_map);
-    if (aggregation_temporarily == AggregationTemporality::kCumulative)
+    auto &cumulative = cumulative_metrics_.attributes_map;
+    if (!cumulative)
     {
-      // merge current delta to previous cumulative
-      last_aggr_hashmap->GetAllEnteries(
-          [&merged_metrics, this](const MetricAttributes &attributes, Aggregation &aggregation) {
-            auto agg = merged_metrics->Get(attributes);
-            if (agg)
-            {
-              merged_metrics->Set(attributes, agg->Merge(aggregation));
-            }
-            else
-            {
-              merged_metrics->Set(attributes,
-                                  DefaultAggregation::CreateAggregation(instrument_descriptor_));
-            }
-            return true;
-          });
+      cumulative.reset(
+          new AttributesHashMap(AttributesHashMap::kDefaultShardCount, attributes_limit_));
     }
-    last_reported_metrics_[collector] =
-        LastReportedMetrics{std::move(merged_metrics), collection_ts};
+    bool evict_idle_series = max_idle_collections_ > 0;
+    cumulative_metrics_.collection_count++;
+    for (uint64_t i = cumulative_metrics_.next_delta; i < end_delta; i++)
+    {
+      MergeInto(*cumulative, *unreported_deltas_[i - first_delta_],
+                evict_idle_series ? &cumulative_metrics_ : nullptr);
+    }
+    cumulative_metrics_.next_delta = end_delta;
+    if (evict_idle_series)
+    {
+      EvictIdleSeries(cumulative_metrics_);
+    }
+    result_to_export = cumulative.get();
   }
   else
   {
-    merged_metrics->GetAllEnteries(
-        [](const MetricAttributes &attr, Aggregation &aggr) { return true; });
-    last_reported_metrics_.insert(
-        std::make_pair(collector, LastReportedMetrics{std::move(merged_metrics), collection_ts}));
+    if (end_delta - reported.next_delta == 1)
+    {
+      delta_result = unreported_deltas_[reported.next_delta - first_delta_];
+    }
+    else
+    {
+      delta_result.reset(
+          new AttributesHashMap(AttributesHashMap::kDefaultShardCount, attributes_limit_));
+      for (uint64_t i = reported.next_delta; i < end_delta; i++)
+      {
+        MergeInto(*delta_result, *unreported_deltas_[i - first_delta_]);
+      }
+    }
+    reported.next_delta = end_delta;
+    result_to_export    = delta_result.get();
   }
 
-  // Generate the MetricData from the final merged_metrics, and invoke callback over it.
+  size_t unchanged_keepalive = aggregation_temporarily == AggregationTemporality::kCumulative
+                                   ? collector->GetUnchangedSeriesKeepalive()
+                                   : 0;
+  bool result = ReportMetrics(reported, unchanged_keepalive, aggregation_temporarily,
+                              collection_ts, *result_to_export, callback);
+  TrimUnreportedDeltas(collectors);
+  return result;
+}
+
+bool TemporalMetricStorage::buildCumulativeMetrics(
+    CollectorHandle *collector,
+    opentelemetry::common::SystemTimestamp sdk_start_ts,
+    opentelemetry::common::SystemTimestamp collection_ts,
+    const AttributesHashMap &cumulative_metrics,
+    nostd::function_ref<bool(MetricData &)> callback) noexcept
+{
+  std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+  auto reported = last_reported_metrics_.find(collector);
+  if (reported == last_reported_metrics_.end())
+  {
+    reported =
+        last_reported_metrics_.insert(std::make_pair(collector, LastReportedMetrics{})).first;
+    reported->second.collection_ts = sdk_start_ts;
+  }
+  return ReportMetrics(reported->second, collector->GetUnchangedSeriesKeepalive(),
+                       AggregationTemporality::kCumulative, collection_ts, cumulative_metrics,
+                       callback);
+}
 
-  AttributesHashMap *result_to_export = (last_reported_metrics_[collector]).attributes_map.get();
-  MetricData metric_data;
+bool TemporalMetricStorage::ReportMetrics(LastReportedMetrics &reported,
+                                          size_t unchanged_keepalive,
+                                          AggregationTemporality aggregation_temporality,
+                                          opentelemetry::common::SystemTimestamp collection_ts,
+                                          const AttributesHashMap &metrics,
+                                          nostd::function_ref<bool(MetricData &)> callback) noexcept
+{
+  MetricData &metric_data             = reported.metric_data;
   metric_data.instrument_descriptor   = instrument_descriptor_;
-  metric_data.aggregation_temporality = aggregation_temporarily;
-  metric_data.start_ts                = last_collection_ts;
+  metric_data.aggregation_temporality = aggregation_temporality;
+  metric_data.start_ts                = reported.collection_ts;
   metric_data.end_ts                  = collection_ts;
-  result_to_export->GetAllEnteries(
-      [&metric_data](const MetricAttributes &attributes, Aggregation &aggregation) {
-        PointDataAttributes point_data_attr;
-        point_data_attr.point_data = aggregation.ToPoint();
-        point_data_attr.attributes = attributes;
-        metric_data.point_data_attr_.push_back(point_data_attr);
+  reported.collection_ts              = collection_ts;
+  // Assign over the points of the previous collection rather than rebuilding them.
+  auto &points = metric_data.point_data_attr_;
+  size_t used  = 0;
+  if (unchanged_keepalive == 0)
+  {
+    reported.reported_series.clear();
+    metrics.GetAllEnteries(
+        [&points, &used](const MetricAttributes &attributes, Aggregation &aggregation) {
+          if (used == points.size())
+          {
+            points.emplace_back();
+          }
+          points[used].point_data = aggregation.ToPoint();
+          points[used].attributes = attributes;
+          used++;
+          return true;
+        });
+    points.erase(points.begin() + used, points.end());
+    return callback(metric_data);
+  }
+
+  // Leave out the series whose measurements were all reported, unless their keepalive is due.
+  const uint64_t collection = ++reported.collection_count;
+  auto &reported_series     = reported.reported_series;
+  metrics.GetAllEntriesWithHash(
+      [&](size_t hash, const MetricAttributes &attributes, Aggregation &aggregation) {
+        if (used == points.size())
+        {
+          points.emplace_back();
+        }
+        points[used].point_data = aggregation.ToPoint();
+        uint64_t fingerprint    = nostd::visit(PointFingerprint(), points[used].point_data);
+        auto it                 = reported_series.find(&aggregation);
+        if (it == reported_series.end() || it->second.attributes_hash != hash)
+        {
+          // A new series, or another one allocated where a dropped series was.
+          it = reported_series.insert(std::make_pair(&aggregation, ReportedSeries{})).first;
+          it->second.attributes_hash = hash;
+        }
+        else if (it->second.fingerprint == fingerprint &&
+                 collection - it->second.reported_collection < unchanged_keepalive)
+        {
+          it->second.seen_collection = collection;
+          return true;
+        }
+        it->second.fingerprint         = fingerprint;
+        it->second.reported_collection = collection;
+        it->second.seen_collection     = collection;
+        points[used].attributes        = attributes;
+        used++;
         return true;
       });
+  points.erase(points.begin() + used, points.end());
+  for (auto it = reported_series.begin(); it != reported_series.end();)
+  {
+    it = it->second.seen_collection == collection ? std::next(it) : reported_series.erase(it);
+  }
   return callback(metric_data);
 }
 
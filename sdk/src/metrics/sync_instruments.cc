@@ -3,6 +3,7 @@
 
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/sync_instruments.h"
+#  include "opentelemetry/sdk/common/telemetry_switch.h"
 #  include "opentelemetry/sdk/metrics/state/metric_storage.h"
 #  include "opentelemetry/sdk_config.h"
 
@@ -13,6 +14,127 @@ namespace sdk
 {
 namespace metrics
 {
+void Synchronous::RecordLong(long value,
+                             const HashedAttributes &attributes,
+                             const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  return storage_->RecordLong(value, attributes, context);
+}
+
+void Synchronous::RecordDouble(double value,
+                               const HashedAttributes &attributes,
+                               const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  return storage_->RecordDouble(value, attributes, context);
+}
+
+BoundSynchronous::BoundSynchronous(InstrumentDescriptor instrument_descriptor,
+                                   std::unique_ptr<BoundWritableMetricStorage> storage)
+    : instrument_descriptor_(instrument_descriptor), storage_(std::move(storage))
+{}
+
+BoundSynchronous::~BoundSynchronous() = default;
+
+LongBoundCounter::LongBoundCounter(InstrumentDescriptor instrument_descriptor,
+                                   std::unique_ptr<BoundWritableMetricStorage> storage)
+    : BoundSynchronous(instrument_descriptor, std::move(storage))
+{}
+
+void LongBoundCounter::Add(long value) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  auto context = opentelemetry::context::Context{};
+  return storage_->RecordLong(value, context);
+}
+
+void LongBoundCounter::Add(long value, const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  return storage_->RecordLong(value, context);
+}
+
+DoubleBoundCounter::DoubleBoundCounter(InstrumentDescriptor instrument_descriptor,
+                                       std::unique_ptr<BoundWritableMetricStorage> storage)
+    : BoundSynchronous(instrument_descriptor, std::move(storage))
+{}
+
+void DoubleBoundCounter::Add(double value) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  auto context = opentelemetry::context::Context{};
+  return storage_->RecordDouble(value, context);
+}
+
+void DoubleBoundCounter::Add(double value, const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  return storage_->RecordDouble(value, context);
+}
+
+LongBoundHistogram::LongBoundHistogram(InstrumentDescriptor instrument_descriptor,
+                                       std::unique_ptr<BoundWritableMetricStorage> storage)
+    : BoundSynchronous(instrument_descriptor, std::move(storage))
+{}
+
+void LongBoundHistogram::Record(long value, const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  if (value < 0)
+  {
+    OTEL_INTERNAL_LOG_WARN(
+        "[LongBoundHistogram::Record(value)] negative value provided to histogram Name:"
+        << instrument_descriptor_.name_ << " Value:" << value);
+    return;
+  }
+  return storage_->RecordLong(value, context);
+}
+
+DoubleBoundHistogram::DoubleBoundHistogram(InstrumentDescriptor instrument_descriptor,
+                                           std::unique_ptr<BoundWritableMetricStorage> storage)
+    : BoundSynchronous(instrument_descriptor, std::move(storage))
+{}
+
+void DoubleBoundHistogram::Record(double value,
+                                  const opentelemetry::context::Context &context) noexcept
+{
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
+  if (value < 0 || std::isnan(value) || std::isinf(value))
+  {
+    OTEL_INTERNAL_LOG_WARN(
+        "[DoubleBoundHistogram::Record(value)] negative/nan/infinite value provided to histogram "
+        "Name:"
+        << instrument_descriptor_.name_);
+    return;
+  }
+  return storage_->RecordDouble(value, context);
+}
+
 LongCounter::LongCounter(InstrumentDescriptor instrument_descriptor,
                          std::unique_ptr<WritableMetricStorage> storage)
     : Synchronous(instrument_descriptor, std::move(storage))
@@ -21,6 +143,10 @@ LongCounter::LongCounter(InstrumentDescriptor instrument_descriptor,
 void LongCounter::Add(long value,
                       const opentelemetry::common::KeyValueIterable &attributes) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordLong(value, attributes, context);
 }
@@ -29,20 +155,39 @@ void LongCounter::Add(long value,
                       const opentelemetry::common::KeyValueIterable &attributes,
                       const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordLong(value, attributes, context);
 }
 
 void LongCounter::Add(long value) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordLong(value, context);
 }
 
 void LongCounter::Add(long value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordLong(value, context);
 }
 
+nostd::shared_ptr<opentelemetry::metrics::BoundCounter<long>> LongCounter::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  return nostd::shared_ptr<opentelemetry::metrics::BoundCounter<long>>{
+      new LongBoundCounter(instrument_descriptor_, storage_->Bind(attributes))};
+}
+
 DoubleCounter::DoubleCounter(InstrumentDescriptor instrument_descriptor,
                              std::unique_ptr<WritableMetricStorage> storage)
     : Synchronous(instrument_descriptor, std::move(storage))
@@ -51,6 +196,10 @@ DoubleCounter::DoubleCounter(InstrumentDescriptor instrument_descriptor,
 void DoubleCounter::Add(double value,
                         const opentelemetry::common::KeyValueIterable &attributes) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordDouble(value, attributes, context);
 }
@@ -59,20 +208,39 @@ void DoubleCounter::Add(double value,
                         const opentelemetry::common::KeyValueIterable &attributes,
                         const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordDouble(value, attributes, context);
 }
 
 void DoubleCounter::Add(double value) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordDouble(value, context);
 }
 
 void DoubleCounter::Add(double value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordDouble(value, context);
 }
 
+nostd::shared_ptr<opentelemetry::metrics::BoundCounter<double>> DoubleCounter::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  return nostd::shared_ptr<opentelemetry::metrics::BoundCounter<double>>{
+      new DoubleBoundCounter(instrument_descriptor_, storage_->Bind(attributes))};
+}
+
 LongUpDownCounter::LongUpDownCounter(InstrumentDescriptor instrument_descriptor,
                                      std::unique_ptr<WritableMetricStorage> storage)
     : Synchronous(instrument_descriptor, std::move(storage))
@@ -81,6 +249,10 @@ LongUpDownCounter::LongUpDownCounter(InstrumentDescriptor instrument_descriptor,
 void LongUpDownCounter::Add(long value,
                             const opentelemetry::common::KeyValueIterable &attributes) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordLong(value, attributes, context);
 }
@@ -89,17 +261,29 @@ void LongUpDownCounter::Add(long value,
                             const opentelemetry::common::KeyValueIterable &attributes,
                             const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordLong(value, attributes, context);
 }
 
 void LongUpDownCounter::Add(long value) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordLong(value, context);
 }
 
 void LongUpDownCounter::Add(long value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordLong(value, context);
 }
 
@@ -111,6 +295,10 @@ DoubleUpDownCounter::DoubleUpDownCounter(InstrumentDescriptor instrument_descrip
 void DoubleUpDownCounter::Add(double value,
                               const opentelemetry::common::KeyValueIterable &attributes) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordDouble(value, attributes, context);
 }
@@ -119,17 +307,29 @@ void DoubleUpDownCounter::Add(double value,
                               const opentelemetry::common::KeyValueIterable &attributes,
                               const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordDouble(value, attributes, context);
 }
 
 void DoubleUpDownCounter::Add(double value) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   auto context = opentelemetry::context::Context{};
   return storage_->RecordDouble(value, context);
 }
 
 void DoubleUpDownCounter::Add(double value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   return storage_->RecordDouble(value, context);
 }
 
@@ -142,6 +342,10 @@ void LongHistogram::Record(long value,
                            const opentelemetry::common::KeyValueIterable &attributes,
                            const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   if (value < 0)
   {
     OTEL_INTERNAL_LOG_WARN(
@@ -154,6 +358,10 @@ void LongHistogram::Record(long value,
 
 void LongHistogram::Record(long value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   if (value < 0)
   {
     OTEL_INTERNAL_LOG_WARN(
@@ -164,6 +372,13 @@ void LongHistogram::Record(long value, const opentelemetry::context::Context &co
   return storage_->RecordLong(value, context);
 }
 
+nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<long>> LongHistogram::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  return nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<long>>{
+      new LongBoundHistogram(instrument_descriptor_, storage_->Bind(attributes))};
+}
+
 DoubleHistogram::DoubleHistogram(InstrumentDescriptor instrument_descriptor,
                                  std::unique_ptr<WritableMetricStorage> storage)
     : Synchronous(instrument_descriptor, std::move(storage))
@@ -173,6 +388,10 @@ void DoubleHistogram::Record(double value,
                              const opentelemetry::common::KeyValueIterable &attributes,
                              const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   if (value < 0 || std::isnan(value) || std::isinf(value))
   {
     OTEL_INTERNAL_LOG_WARN(
@@ -186,6 +405,10 @@ void DoubleHistogram::Record(double value,
 
 void DoubleHistogram::Record(double value, const opentelemetry::context::Context &context) noexcept
 {
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return;
+  }
   if (value < 0 || std::isnan(value) || std::isinf(value))
   {
     OTEL_INTERNAL_LOG_WARN(
@@ -196,6 +419,13 @@ void DoubleHistogram::Record(double value, const opentelemetry::context::Context
   return storage_->RecordDouble(value, context);
 }
 
+nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<double>> DoubleHistogram::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  return nostd::shared_ptr<opentelemetry::metrics::BoundHistogram<double>>{
+      new DoubleBoundHistogram(instrument_descriptor_, storage_->Bind(attributes))};
+}
+
 }  // namespace metrics
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -3,8 +3,20 @@
 
 #include "opentelemetry/sdk/resource/resource_detector.h"
 #include "opentelemetry/sdk/common/env_variables.h"
+#include "opentelemetry/sdk/common/global_log_handler.h"
 #include "opentelemetry/sdk/resource/resource.h"
 
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <locale>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -34,6 +46,330 @@ Resource OTELResourceDetector::Detect() noexcept
   return Resource(attributes);
 }
 
+namespace
+{
+/**
+ * The results of the detectors of a ParallelResourceDetector, shared with their threads so that
+ * a thread which outlives the Detect call can still store its result.
+ */
+struct DetectionState
+{
+  std::mutex lock;
+  std::condition_variable done;
+  std::vector<std::unique_ptr<Resource>> resources;
+  size_t pending = 0;
+};
+}  // namespace
+
+ParallelResourceDetector::ParallelResourceDetector(
+    std::vector<std::shared_ptr<ResourceDetector>> detectors,
+    std::chrono::milliseconds timeout) noexcept
+    : detectors_(std::move(detectors)), timeout_(timeout)
+{}
+
+Resource ParallelResourceDetector::Detect() noexcept
+{
+  auto state = std::make_shared<DetectionState>();
+  state->resources.resize(detectors_.size());
+  state->pending = detectors_.size();
+  for (size_t i = 0; i < detectors_.size(); ++i)
+  {
+    std::shared_ptr<ResourceDetector> detector = detectors_[i];
+    std::thread([state, detector, i]() {
+      std::unique_ptr<Resource> resource(new Resource(detector->Detect()));
+      std::lock_guard<std::mutex> guard(state->lock);
+      state->resources[i] = std::move(resource);
+      if (--state->pending == 0)
+      {
+        state->done.notify_all();
+      }
+    }).detach();
+  }
+
+  std::unique_lock<std::mutex> lock(state->lock);
+  if (!state->done.wait_for(lock, timeout_, [&state] { return state->pending == 0; }))
+  {
+    OTEL_INTERNAL_LOG_WARN("[Parallel Resource Detector] "
+                           << state->pending
+                           << " detector(s) did not finish in time, their resources are ignored");
+  }
+
+  Resource resource = Resource::GetEmpty();
+  for (auto &detected : state->resources)
+  {
+    if (detected != nullptr)
+    {
+      resource = resource.Merge(*detected);
+    }
+  }
+  return resource;
+}
+
+namespace
+{
+// The first line of a cache file is this marker, followed by the time the file was written in
+// seconds since the epoch. The second line is the schema URL, and each of the next lines an
+// attribute: its type, key and value separated by tabs.
+const char kResourceCacheMarker[] = "opentelemetry-resource-cache-v1";
+
+std::string EscapeCacheField(const std::string &field)
+{
+  std::string escaped;
+  escaped.reserve(field.size());
+  for (char c : field)
+  {
+    switch (c)
+    {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\r':
+        escaped += "\\r";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+bool UnescapeCacheField(const std::string &field, std::string &unescaped)
+{
+  unescaped.clear();
+  for (size_t i = 0; i < field.size(); ++i)
+  {
+    if (field[i] != '\\')
+    {
+      unescaped += field[i];
+      continue;
+    }
+    if (++i == field.size())
+    {
+      return false;
+    }
+    switch (field[i])
+    {
+      case '\\':
+        unescaped += '\\';
+        break;
+      case 't':
+        unescaped += '\t';
+        break;
+      case 'n':
+        unescaped += '\n';
+        break;
+      case 'r':
+        unescaped += '\r';
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Writes the line of a scalar attribute, the only ones cached.
+ */
+struct CacheLineWriter
+{
+  std::ostream &out;
+  const std::string &key;
+
+  template <class T>
+  bool Write(char type, const T &value)
+  {
+    out << type << '\t' << EscapeCacheField(key) << '\t' << value << '\n';
+    return true;
+  }
+
+  bool operator()(bool value) { return Write('b', value ? 1 : 0); }
+  bool operator()(int32_t value) { return Write('i', value); }
+  bool operator()(uint32_t value) { return Write('u', value); }
+  bool operator()(int64_t value) { return Write('l', value); }
+  bool operator()(uint64_t value) { return Write('L', value); }
+  bool operator()(double value) { return Write('d', value); }
+  bool operator()(const std::string &value) { return Write('s', EscapeCacheField(value)); }
+
+  template <class T>
+  bool operator()(const std::vector<T> &)
+  {
+    return false;
+  }
+};
+
+template <class T>
+bool ParseCacheNumber(const std::string &text, opentelemetry::common::AttributeValue &value)
+{
+  std::istringstream in(text);
+  in.imbue(std::locale::classic());
+  T number;
+  in >> number;
+  if (in.fail() || !in.eof())
+  {
+    return false;
+  }
+  value = number;
+  return true;
+}
+
+bool ParseCacheValue(const std::string &type,
+                     const std::string &text,
+                     opentelemetry::common::AttributeValue &value,
+                     std::string &storage)
+{
+  if (type == "b" && (text == "0" || text == "1"))
+  {
+    value = text == "1";
+    return true;
+  }
+  if (type == "i")
+  {
+    return ParseCacheNumber<int32_t>(text, value);
+  }
+  if (type == "u")
+  {
+    return ParseCacheNumber<uint32_t>(text, value);
+  }
+  if (type == "l")
+  {
+    return ParseCacheNumber<int64_t>(text, value);
+  }
+  if (type == "L")
+  {
+    return ParseCacheNumber<uint64_t>(text, value);
+  }
+  if (type == "d")
+  {
+    return ParseCacheNumber<double>(text, value);
+  }
+  if (type == "s" && UnescapeCacheField(text, storage))
+  {
+    value = nostd::string_view(storage);
+    return true;
+  }
+  return false;
+}
+
+bool ReadResourceCache(const std::string &path,
+                       std::chrono::seconds max_age,
+                       ResourceAttributes &attributes,
+                       std::string &schema_url)
+{
+  std::ifstream in(path);
+  std::string line;
+  if (!in || !std::getline(in, line))
+  {
+    return false;
+  }
+  std::istringstream header(line);
+  header.imbue(std::locale::classic());
+  std::string marker;
+  int64_t written = 0;
+  if (!(header >> marker >> written) || marker != kResourceCacheMarker)
+  {
+    return false;
+  }
+  auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+                 .count();
+  if (now - written > max_age.count() || written > now)
+  {
+    return false;
+  }
+
+  if (!std::getline(in, line) || !UnescapeCacheField(line, schema_url))
+  {
+    return false;
+  }
+  std::string key;
+  std::string storage;
+  while (std::getline(in, line))
+  {
+    size_t type_end = line.find('\t');
+    size_t key_end  = type_end == std::string::npos ? type_end : line.find('\t', type_end + 1);
+    if (key_end == std::string::npos)
+    {
+      return false;
+    }
+    opentelemetry::common::AttributeValue value;
+    if (!UnescapeCacheField(line.substr(type_end + 1, key_end - type_end - 1), key) ||
+        !ParseCacheValue(line.substr(0, type_end), line.substr(key_end + 1), value, storage))
+    {
+      return false;
+    }
+    attributes.SetAttribute(key, value);
+  }
+  return true;
+}
+
+void WriteResourceCache(const std::string &path, const Resource &resource)
+{
+  std::ostringstream out;
+  out.imbue(std::locale::classic());
+  out.precision(17);
+  out << kResourceCacheMarker << ' '
+      << std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+             .count()
+      << '\n'
+      << EscapeCacheField(resource.GetSchemaURL()) << '\n';
+  for (const auto &attribute : resource.GetAttributes())
+  {
+    if (!nostd::visit(CacheLineWriter{out, attribute.first}, attribute.second))
+    {
+      OTEL_INTERNAL_LOG_DEBUG("[Cached Resource Detector] Resource not cached, attribute "
+                              << attribute.first << " is an array");
+      return;
+    }
+  }
+
+  // The file is written aside and renamed, so that a concurrent reader never sees it partially
+  // written.
+  std::string temporary_path = path + ".tmp";
+  {
+    std::ofstream file(temporary_path, std::ios::trunc);
+    file << out.str();
+    if (!file.flush())
+    {
+      OTEL_INTERNAL_LOG_WARN("[Cached Resource Detector] Cannot write " << temporary_path);
+      return;
+    }
+  }
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+  {
+    OTEL_INTERNAL_LOG_WARN("[Cached Resource Detector] Cannot replace " << path);
+    std::remove(temporary_path.c_str());
+  }
+}
+}  // namespace
+
+CachedResourceDetector::CachedResourceDetector(std::shared_ptr<ResourceDetector> detector,
+                                               std::string path,
+                                               std::chrono::seconds max_age) noexcept
+    : detector_(std::move(detector)), path_(std::move(path)), max_age_(max_age)
+{}
+
+Resource CachedResourceDetector::Detect() noexcept
+{
+  ResourceAttributes attributes;
+  std::string schema_url;
+  if (ReadResourceCache(path_, max_age_, attributes, schema_url))
+  {
+    return Resource(attributes, schema_url);
+  }
+
+  Resource resource = detector_->Detect();
+  WriteResourceCache(path_, resource);
+  return resource;
+}
+
 }  // namespace resource
 }  // namespace sdk
 OPENTELEMETRY_END_NAMESPACE
@@ -2,11 +2,14 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/sdk/common/export_batch_splitter.h"
+#include "opentelemetry/sdk/common/tracepoint.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <vector>
-using opentelemetry::sdk::common::AtomicUniquePtr;
 using opentelemetry::sdk::common::CircularBuffer;
-using opentelemetry::sdk::common::CircularBufferRange;
 using opentelemetry::trace::SpanContext;
 
 OPENTELEMETRY_BEGIN_NAMESPACE
@@ -20,12 +23,88 @@ BatchSpanProcessor::BatchSpanProcessor(std::unique_ptr<SpanExporter> &&exporter,
       max_queue_size_(options.max_queue_size),
       schedule_delay_millis_(options.schedule_delay_millis),
       max_export_batch_size_(options.max_export_batch_size),
-      buffer_(max_queue_size_),
-      worker_thread_(&BatchSpanProcessor::DoBackgroundWork, this)
-{}
+      max_concurrent_exports_(options.max_concurrent_exports),
+      max_in_flight_export_bytes_(options.max_in_flight_export_bytes),
+      deferred_recordables_(options.deferred_recordables),
+      max_export_batch_bytes_(options.max_export_batch_bytes),
+      group_by_trace_(options.group_by_trace),
+      adaptive_scheduler_(options.adaptive_batching
+                              ? new common::AdaptiveBatchScheduler(
+                                    options.min_export_batch_size,
+                                    options.max_export_batch_size,
+                                    options.min_schedule_delay_millis,
+                                    options.schedule_delay_millis)
+                              : nullptr),
+      export_batch_size_(max_export_batch_size_),
+      last_adaptive_update_(std::chrono::steady_clock::now()),
+      worker_schedule_delay_(schedule_delay_millis_),
+      worker_timeout_(schedule_delay_millis_),
+      async_export_state_(new AsyncExportState),
+      buffer_(max_queue_size_,
+              options.fair_queuing.key.empty() ? options.num_queue_shards
+                                               : options.fair_queuing.num_queues),
+      priority_rules_(options.priority_rules),
+      priority_buffer_(options.max_priority_queue_size, options.num_queue_shards),
+      recycled_(options.max_recycled_recordables, options.num_queue_shards),
+      stats_(new common::BatchProcessorStatsRecorder),
+      thread_options_(options.thread_options),
+      executor_(options.executor),
+      local_buffers_(options.thread_local_buffer_size > 0 && options.fair_queuing.key.empty()
+                         ? new common::ThreadLocalBuffers<Recordable>(
+                               options.thread_local_buffer_size,
+                               [this](std::vector<std::unique_ptr<Recordable>> &spans) {
+                                 HandOff(spans);
+                               })
+                         : nullptr),
+      memory_budget_(options.memory_budget),
+      backpressure_signal_(options.backpressure_signal),
+      tenant_key_{options.fair_queuing.key},
+      fair_queue_quantum_(options.fair_queuing.quantum),
+      tenant_drops_(options.fair_queuing.key.empty()
+                        ? nullptr
+                        : new common::TenantDropCounter(options.fair_queuing.max_tracked_tenants)),
+      journal_(options.journal),
+      fork_handler_([this] { PrepareFork(); },
+                    [this] { ParentAfterFork(); },
+                    [this] { ChildAfterFork(); })
+{
+  if (memory_budget_ != nullptr)
+  {
+    // Exporting frees the charges of the exported spans.
+    pressure_listener_id_ =
+        memory_budget_->AddPressureListener([this](common::MemoryPressure pressure) {
+          if (pressure != common::MemoryPressure::kNone)
+          {
+            synchronizer_.WakeUp();
+          }
+        });
+  }
+}
 
 std::unique_ptr<Recordable> BatchSpanProcessor::MakeRecordable() noexcept
 {
+  std::unique_ptr<Recordable> recordable =
+      deferred_recordables_ ? std::unique_ptr<Recordable>(new ArenaSpanData)
+                            : MakeExporterRecordable();
+  if (tenant_drops_ != nullptr)
+  {
+    recordable.reset(new TenantSpanRecordable(std::move(recordable), tenant_key_));
+  }
+  if (priority_buffer_.max_size() != 0)
+  {
+    return std::unique_ptr<Recordable>(
+        new ImportantSpanRecordable(std::move(recordable), priority_rules_));
+  }
+  return recordable;
+}
+
+std::unique_ptr<Recordable> BatchSpanProcessor::MakeExporterRecordable() noexcept
+{
+  std::unique_ptr<Recordable> recordable = recycled_.Take();
+  if (recordable != nullptr)
+  {
+    return recordable;
+  }
   return exporter_->MakeRecordable();
 }
 
@@ -41,17 +120,143 @@ void BatchSpanProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
     return;
   }
 
-  if (buffer_.Add(span) == false)
+  if (is_worker_started_.load(std::memory_order_acquire) == false)
+  {
+    StartWorker();
+  }
+
+  const bool important = priority_buffer_.max_size() != 0 && UnwrapPrioritySpan(span);
+  std::string tenant;
+  if (tenant_drops_ != nullptr)
+  {
+    UnwrapTenantSpan(span, tenant);
+  }
+  size_t charged_bytes = 0;
+  if (memory_budget_ != nullptr)
+  {
+    charged_bytes = GetChargedBytes(*span);
+    if (!memory_budget_->TryCharge(charged_bytes, important ? common::MemoryPriority::kHigh
+                                                            : common::MemoryPriority::kNormal))
+    {
+      RecordDropped();
+      if (tenant_drops_ != nullptr)
+      {
+        tenant_drops_->RecordDropped(tenant);
+      }
+      return;
+    }
+  }
+
+  if (journal_ != nullptr)
+  {
+    journal_->AppendRecordable(*span);
+  }
+
+  const CircularBuffer<Recordable> *shard = nullptr;
+  if (important)
   {
+    // Priority spans which do not fit in their partition fall back to the rest of the queue.
+    shard = priority_buffer_.AddToShard(span);
+  }
+  else if (local_buffers_ != nullptr)
+  {
+    local_buffers_->Add(std::move(span));
+    return;
+  }
+
+  if (shard == nullptr)
+  {
+    // With fair queuing, a tenant whose sub-queue is full only drops its own spans.
+    shard = tenant_drops_ != nullptr
+                ? buffer_.AddToShardAt(std::hash<std::string>()(tenant), span)
+                : buffer_.AddToShard(span);
+  }
+  if (shard == nullptr)
+  {
+    if (memory_budget_ != nullptr)
+    {
+      memory_budget_->Release(charged_bytes);
+    }
+    RecordDropped();
+    if (tenant_drops_ != nullptr)
+    {
+      tenant_drops_->RecordDropped(tenant);
+    }
+    return;
+  }
+  OTEL_SDK_TRACEPOINT1(batch_span_processor__enqueue, shard->size());
+  WakeUpIfHalfFull(*shard);
+}
+
+bool BatchSpanProcessor::UnwrapPrioritySpan(std::unique_ptr<Recordable> &span) const noexcept
+{
+  // Spans shared by a fan-out MultiSpanProcessor were not made by MakeRecordable.
+  const ArenaSpanData *shared_span = span->GetSharedSpanData();
+  if (shared_span != nullptr)
+  {
+    return priority_rules_.IsImportant(*shared_span);
+  }
+  std::unique_ptr<ImportantSpanRecordable> wrapper(
+      static_cast<ImportantSpanRecordable *>(span.release()));
+  span = wrapper->ReleaseRecordable();
+  return wrapper->IsImportant();
+}
+
+void BatchSpanProcessor::UnwrapTenantSpan(std::unique_ptr<Recordable> &span,
+                                          std::string &tenant) const noexcept
+{
+  // Spans shared by a fan-out MultiSpanProcessor were not made by MakeRecordable.
+  const ArenaSpanData *shared_span = span->GetSharedSpanData();
+  if (shared_span != nullptr)
+  {
+    tenant = tenant_key_.GetTenant(*shared_span);
     return;
   }
+  std::unique_ptr<TenantSpanRecordable> wrapper(
+      static_cast<TenantSpanRecordable *>(span.release()));
+  span   = wrapper->ReleaseRecordable();
+  tenant = std::move(wrapper->GetTenant());
+}
 
+void BatchSpanProcessor::WakeUpIfHalfFull(const CircularBuffer<Recordable> &shard) noexcept
+{
   // If the queue gets at least half full a preemptive notification is
-  // sent to the worker thread to start a new export cycle.
+  // sent to the worker thread to start a new export cycle. Only the shard
+  // that was just written to is checked, to keep other shards' counters
+  // out of this thread's cache.
+  if (shard.size() >= shard.max_size() / 2)
+  {
+    // signal the worker thread
+    synchronizer_.WakeUp();
+  }
+}
+
+void BatchSpanProcessor::RecordDropped() noexcept
+{
+  stats_->RecordDropped();
+  OTEL_SDK_TRACEPOINT0(batch_span_processor__drop);
+  if (backpressure_signal_ != nullptr)
+  {
+    backpressure_signal_->SetQueueFull();
+  }
+}
+
+void BatchSpanProcessor::HandOff(std::vector<std::unique_ptr<Recordable>> &spans) noexcept
+{
+  size_t added = buffer_.AddBatch(spans);
+  for (size_t i = added; i < spans.size(); ++i)
+  {
+    RecordDropped();
+  }
+  // AddBatch leaves the spans which did not fit at the end.
+  ReleaseCharges(nostd::span<const std::unique_ptr<Recordable>>(spans.data() + added,
+                                                                spans.size() - added));
+  spans.clear();
+
   if (buffer_.size() >= max_queue_size_ / 2)
   {
     // signal the worker thread
-    cv_.notify_one();
+    synchronizer_.WakeUp();
   }
 }
 
@@ -62,120 +267,330 @@ bool BatchSpanProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
     return false;
   }
 
-  is_force_flush_ = true;
-
-  // Keep attempting to wake up the worker thread
-  while (is_force_flush_.load() == true)
+  if (is_worker_started_.load(std::memory_order_acquire) == false)
   {
-    cv_.notify_one();
+    // Nothing was queued yet.
+    return true;
   }
 
-  // Now wait for the worker thread to signal back from the Export method
-  std::unique_lock<std::mutex> lk(force_flush_cv_m_);
-  while (is_force_flush_notified_.load() == false)
+  return synchronizer_.ForceFlush(timeout);
+}
+
+void BatchSpanProcessor::StartWorker() noexcept
+{
+  std::lock_guard<std::mutex> shutdown_guard{shutdown_m_};
+  if (is_shutdown_.load() == false && is_worker_started_.load() == false)
   {
-    force_flush_cv_.wait(lk);
+    if (executor_ != nullptr)
+    {
+      worker_task_ = executor_->AddTask([this] { return RunWorkerTask(); }, worker_timeout_);
+      synchronizer_.SetWorkerTask([this] { executor_->WakeUp(worker_task_); });
+    }
+    else
+    {
+      worker_thread_ = std::thread(&BatchSpanProcessor::DoBackgroundWork, this);
+    }
+    is_worker_started_.store(true, std::memory_order_release);
   }
+}
 
-  // Notify the worker thread
-  is_force_flush_notified_ = false;
-
-  return true;
+void BatchSpanProcessor::ResetWorkerSchedule() noexcept
+{
+  worker_schedule_delay_ = schedule_delay_millis_;
+  worker_timeout_        = schedule_delay_millis_;
 }
 
 void BatchSpanProcessor::DoBackgroundWork()
 {
-  auto timeout = schedule_delay_millis_;
+  common::ApplyThreadOptions(thread_options_, "otel-bsp");
+  ResetWorkerSchedule();
+  // Wait for `worker_timeout_` milliseconds, or until woken up by a full queue, a force flush or
+  // a shutdown request.
+  while (RunCycle(synchronizer_.WaitForWork(worker_timeout_)))
+  {
+  }
+}
+
+std::chrono::microseconds BatchSpanProcessor::RunWorkerTask()
+{
+  if (!RunCycle(synchronizer_.TakeWork()))
+  {
+    return common::ExportExecutor::kWhenWokenUp;
+  }
+  return worker_timeout_;
+}
 
-  while (true)
+bool BatchSpanProcessor::RunCycle(uint64_t flush_generation)
+{
+  if (is_shutdown_.load() == true)
   {
-    // Wait for `timeout` milliseconds
-    std::unique_lock<std::mutex> lk(cv_m_);
-    cv_.wait_for(lk, timeout);
+    DrainQueue();
+    synchronizer_.Stop();
+    return false;
+  }
 
-    if (is_shutdown_.load() == true)
-    {
-      DrainQueue();
-      return;
-    }
+  if (synchronizer_.IsPauseRequested())
+  {
+    // The process is about to fork: nothing may be left in flight in the exporter.
+    WaitForAsyncExports(0);
+    return false;
+  }
 
-    bool was_force_flush_called = is_force_flush_.load();
+  bool was_force_flush_called = flush_generation != 0;
 
-    // Check if this export was the result of a force flush.
-    if (was_force_flush_called == true)
-    {
-      // Since this export was the result of a force flush, signal the
-      // main thread that the worker thread has been notified
-      is_force_flush_ = false;
-    }
-    else
-    {
-      // If the buffer was empty during the entire `timeout` time interval,
-      // go back to waiting. If this was a spurious wake-up, we export only if
-      // `buffer_` is not empty. This is acceptable because batching is a best
-      // mechanism effort here.
-      if (buffer_.empty() == true)
-      {
-        timeout = schedule_delay_millis_;
-        continue;
-      }
-    }
+  // Collect the spans of the threads which did not fill their buffer since the last cycle.
+  if (local_buffers_ != nullptr)
+  {
+    local_buffers_->Flush();
+  }
+
+  // If the buffer was empty during the entire `timeout` time interval, go back to waiting.
+  // If this was a spurious wake-up, we export only if `buffer_` is not empty. This is
+  // acceptable because batching is a best mechanism effort here.
+  if (was_force_flush_called == false && buffer_.empty() == true &&
+      priority_buffer_.empty() == true)
+  {
+    PublishBackpressure(std::chrono::steady_clock::duration::zero(), worker_schedule_delay_);
+    worker_schedule_delay_ = UpdateAdaptiveSchedule(std::chrono::steady_clock::duration::zero());
+    worker_timeout_        = worker_schedule_delay_;
+    return true;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  Export(was_force_flush_called);
+  if (was_force_flush_called == true)
+  {
+    // A force flush is only complete once its spans have left the exporter
+    WaitForAsyncExports(0);
+    synchronizer_.NotifyFlushCompleted(flush_generation);
+  }
+  auto end      = std::chrono::steady_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+  PublishBackpressure(end - start, worker_schedule_delay_);
 
-    auto start = std::chrono::steady_clock::now();
-    Export(was_force_flush_called);
-    auto end      = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+  // Subtract the duration of this export call from the next `timeout`.
+  worker_schedule_delay_ = UpdateAdaptiveSchedule(end - start);
+  worker_timeout_        = worker_schedule_delay_ - duration;
 
-    // Subtract the duration of this export call from the next `timeout`.
-    timeout = schedule_delay_millis_ - duration;
+  // In adaptive mode, keep exporting without waiting while a full batch is already queued.
+  if (adaptive_scheduler_ != nullptr &&
+      buffer_.size() + priority_buffer_.size() >= export_batch_size_)
+  {
+    worker_timeout_ = std::chrono::milliseconds::zero();
   }
+  return true;
 }
 
-void BatchSpanProcessor::Export(const bool was_force_flush_called)
+void BatchSpanProcessor::PublishBackpressure(std::chrono::steady_clock::duration export_duration,
+                                             std::chrono::milliseconds schedule_delay) noexcept
 {
-  std::vector<std::unique_ptr<Recordable>> spans_arr;
+  if (backpressure_signal_ == nullptr)
+  {
+    return;
+  }
+  backpressure_signal_->SetQueueOccupancy(
+      static_cast<double>(buffer_.size() + priority_buffer_.size()) /
+      static_cast<double>(buffer_.max_size() + priority_buffer_.max_size()));
+  // An export cycle lasts the schedule delay: exporting for as long means falling behind.
+  backpressure_signal_->SetExportLag(
+      schedule_delay.count() > 0
+          ? std::chrono::duration<double>(export_duration).count() /
+                std::chrono::duration<double>(schedule_delay).count()
+          : 0.0);
+}
+
+std::chrono::milliseconds BatchSpanProcessor::UpdateAdaptiveSchedule(
+    std::chrono::steady_clock::duration export_duration)
+{
+  if (adaptive_scheduler_ == nullptr)
+  {
+    return schedule_delay_millis_;
+  }
 
+  auto now                  = std::chrono::steady_clock::now();
+  uint64_t production_count = buffer_.production_count() + priority_buffer_.production_count();
+  adaptive_scheduler_->Update(production_count - last_production_count_,
+                              now - last_adaptive_update_, export_duration);
+  last_production_count_ = production_count;
+  last_adaptive_update_  = now;
+
+  export_batch_size_ = adaptive_scheduler_->batch_size();
+  return adaptive_scheduler_->schedule_delay();
+}
+
+void BatchSpanProcessor::Export(const bool was_force_flush_called)
+{
   size_t num_spans_to_export;
+  size_t queue_size = buffer_.size() + priority_buffer_.size();
 
   if (was_force_flush_called == true)
   {
-    num_spans_to_export = buffer_.size();
+    num_spans_to_export = queue_size;
   }
   else
   {
-    num_spans_to_export =
-        buffer_.size() >= max_export_batch_size_ ? max_export_batch_size_ : buffer_.size();
+    num_spans_to_export = queue_size >= export_batch_size_ ? export_batch_size_ : queue_size;
   }
 
-  buffer_.Consume(num_spans_to_export,
-                  [&](CircularBufferRange<AtomicUniquePtr<Recordable>> range) noexcept {
-                    range.ForEach([&](AtomicUniquePtr<Recordable> &ptr) {
-                      std::unique_ptr<Recordable> swap_ptr = std::unique_ptr<Recordable>(nullptr);
-                      ptr.Swap(swap_ptr);
-                      spans_arr.push_back(std::unique_ptr<Recordable>(swap_ptr.release()));
-                      return true;
-                    });
-                  });
+  // The batch vector is reused from one export to the next, and left empty after each. Priority
+  // spans go first.
+  std::vector<std::unique_ptr<Recordable>> &spans_arr = export_batch_;
+  size_t num_priority_spans = priority_buffer_.ConsumeInto(num_spans_to_export, spans_arr);
+  if (tenant_drops_ != nullptr)
+  {
+    buffer_.ConsumeFairInto(num_spans_to_export - num_priority_spans, fair_queue_quantum_,
+                            spans_arr);
+  }
+  else
+  {
+    buffer_.ConsumeInto(num_spans_to_export - num_priority_spans, spans_arr);
+  }
+  ReleaseCharges(spans_arr);
 
-  exporter_->Export(nostd::span<std::unique_ptr<Recordable>>(spans_arr.data(), spans_arr.size()));
+  // Spans shared with other processors, and deferred spans, are only turned into recordables of
+  // the exporter here, on the worker thread.
+  for (auto &span : spans_arr)
+  {
+    if (deferred_recordables_ && span->GetSharedSpanData() == nullptr)
+    {
+      std::unique_ptr<Recordable> recordable = MakeExporterRecordable();
+      if (recordable != nullptr)
+      {
+        static_cast<const ArenaSpanData &>(*span).Replay(*recordable);
+      }
+      span = std::move(recordable);
+      continue;
+    }
+    ResolveSharedRecordable(span, [this] { return MakeExporterRecordable(); });
+  }
 
-  // Notify the main thread in case this export was the result of a force flush.
-  if (was_force_flush_called == true)
+  if (group_by_trace_)
+  {
+    GroupByTrace(spans_arr);
+  }
+
+  common::ForEachExportBatch(spans_arr, max_export_batch_bytes_,
+                             [this](nostd::span<std::unique_ptr<Recordable>> batch) {
+                               ExportBatch(batch);
+                             });
+  spans_arr.clear();
+}
+
+void BatchSpanProcessor::GroupByTrace(std::vector<std::unique_ptr<Recordable>> &spans)
+{
+  // The keys are read once per span, rather than once per comparison.
+  grouping_keys_.clear();
+  grouping_keys_.reserve(spans.size());
+  for (size_t i = 0; i < spans.size(); ++i)
+  {
+    grouping_keys_.emplace_back(
+        spans[i] != nullptr ? spans[i]->GetGroupingKey() : RecordableGroupingKey(), i);
+  }
+
+  std::less<const void *> less;
+  std::sort(grouping_keys_.begin(), grouping_keys_.end(),
+            [&less](const std::pair<RecordableGroupingKey, size_t> &lhs,
+                    const std::pair<RecordableGroupingKey, size_t> &rhs) {
+              if (lhs.first.resource != rhs.first.resource)
+              {
+                return less(lhs.first.resource, rhs.first.resource);
+              }
+              if (lhs.first.instrumentation_library != rhs.first.instrumentation_library)
+              {
+                return less(lhs.first.instrumentation_library, rhs.first.instrumentation_library);
+              }
+              int order = std::memcmp(lhs.first.trace_id.Id().data(),
+                                      rhs.first.trace_id.Id().data(),
+                                      opentelemetry::trace::TraceId::kSize);
+              if (order != 0)
+              {
+                return order < 0;
+              }
+              // The position keeps the order of the spans of a group.
+              return lhs.second < rhs.second;
+            });
+
+  grouped_batch_.clear();
+  grouped_batch_.reserve(spans.size());
+  for (auto &key : grouping_keys_)
+  {
+    grouped_batch_.push_back(std::move(spans[key.second]));
+  }
+  spans.swap(grouped_batch_);
+  grouped_batch_.clear();
+}
+
+void BatchSpanProcessor::ExportBatch(nostd::span<std::unique_ptr<Recordable>> batch)
+{
+  auto start = std::chrono::steady_clock::now();
+  if (max_concurrent_exports_ <= 1)
+  {
+    OTEL_SDK_TRACEPOINT2(export__begin, "traces", batch.size());
+    auto result = exporter_->Export(batch);
+    OTEL_SDK_TRACEPOINT3(export__end, "traces", batch.size(), static_cast<int>(result));
+    stats_->RecordExport(batch.size(), std::chrono::steady_clock::now() - start, result);
+    // The exporter is done with the spans it did not take, their recordables can be reused.
+    recycled_.Recycle(batch);
+    return;
+  }
+
+  // Backpressure: keep at most max_concurrent_exports_ batches, and max_in_flight_export_bytes_,
+  // in flight. Spans keep queuing up in the buffer while the worker waits here.
+  size_t batch_bytes = 0;
+  if (max_in_flight_export_bytes_ > 0)
   {
-    is_force_flush_notified_ = true;
-    while (is_force_flush_notified_.load() == true)
+    for (auto &span : batch)
     {
-      force_flush_cv_.notify_one();
+      batch_bytes += span != nullptr ? span->GetEstimatedSize() : 0;
     }
   }
+  WaitForAsyncExports(max_concurrent_exports_ - 1, batch_bytes);
+  {
+    std::lock_guard<std::mutex> guard(async_export_state_->m);
+    ++async_export_state_->in_flight;
+    async_export_state_->in_flight_bytes += batch_bytes;
+  }
+
+  std::shared_ptr<AsyncExportState> state                 = async_export_state_;
+  std::shared_ptr<common::BatchProcessorStatsRecorder> stats = stats_;
+  size_t batch_size                                        = batch.size();
+  OTEL_SDK_TRACEPOINT2(export__begin, "traces", batch_size);
+  exporter_->ExportAsync(batch, [state, stats, batch_size, batch_bytes,
+                                 start](sdk::common::ExportResult result) {
+    OTEL_SDK_TRACEPOINT3(export__end, "traces", batch_size, static_cast<int>(result));
+    stats->RecordExport(batch_size, std::chrono::steady_clock::now() - start, result);
+    {
+      std::lock_guard<std::mutex> guard(state->m);
+      --state->in_flight;
+      state->in_flight_bytes -= batch_bytes;
+    }
+    state->cv.notify_all();
+  });
+}
+
+void BatchSpanProcessor::WaitForAsyncExports(size_t max_in_flight, size_t batch_bytes)
+{
+  std::unique_lock<std::mutex> lk(async_export_state_->m);
+  async_export_state_->cv.wait(lk, [this, max_in_flight, batch_bytes] {
+    const AsyncExportState &state = *async_export_state_;
+    return state.in_flight <= max_in_flight &&
+           (max_in_flight_export_bytes_ == 0 || state.in_flight == 0 ||
+            state.in_flight_bytes + batch_bytes <= max_in_flight_export_bytes_);
+  });
 }
 
 void BatchSpanProcessor::DrainQueue()
 {
-  while (buffer_.empty() == false)
+  if (local_buffers_ != nullptr)
+  {
+    local_buffers_->Flush();
+  }
+  while (buffer_.empty() == false || priority_buffer_.empty() == false)
   {
     Export(false);
   }
+  WaitForAsyncExports(0);
 }
 
 bool BatchSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
@@ -185,9 +600,16 @@ bool BatchSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
 
   if (worker_thread_.joinable())
   {
-    cv_.notify_one();
+    synchronizer_.RequestShutdown();
     worker_thread_.join();
   }
+  else if (worker_task_ != nullptr)
+  {
+    // Unless the task already did, drain the queue once it no longer runs.
+    executor_->SuspendTask(worker_task_);
+    DrainQueue();
+    synchronizer_.Stop();
+  }
 
   // Should only shutdown exporter ONCE.
   if (!already_shutdown && exporter_ != nullptr)
@@ -198,8 +620,115 @@ bool BatchSpanProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
   return true;
 }
 
+void BatchSpanProcessor::PrepareFork()
+{
+  // Released by ParentAfterFork or ChildAfterFork.
+  shutdown_m_.lock();
+  if (worker_thread_.joinable())
+  {
+    synchronizer_.RequestPause();
+    worker_thread_.join();
+  }
+  else if (worker_task_ != nullptr)
+  {
+    executor_->SuspendTask(worker_task_);
+    WaitForAsyncExports(0);
+  }
+  synchronizer_.PrepareFork();
+  if (local_buffers_ != nullptr)
+  {
+    local_buffers_->PrepareFork();
+  }
+}
+
+void BatchSpanProcessor::ParentAfterFork()
+{
+  if (local_buffers_ != nullptr)
+  {
+    local_buffers_->AfterFork(false);
+  }
+  synchronizer_.ParentAfterFork();
+  if (is_shutdown_.load() == false && is_worker_started_.load() == true)
+  {
+    RestartWorker();
+  }
+  shutdown_m_.unlock();
+}
+
+void BatchSpanProcessor::ChildAfterFork()
+{
+  if (local_buffers_ != nullptr)
+  {
+    local_buffers_->AfterFork(true);
+  }
+  synchronizer_.ChildAfterFork();
+  if (is_shutdown_.load() == false && is_worker_started_.load() == true)
+  {
+    if (memory_budget_ != nullptr)
+    {
+      // The budget is shared with the other components of the child, which were forked with it.
+      std::vector<std::unique_ptr<Recordable>> spans;
+      priority_buffer_.ConsumeInto(priority_buffer_.size(), spans);
+      buffer_.ConsumeInto(buffer_.size(), spans);
+      ReleaseCharges(spans);
+    }
+    buffer_.Clear();
+    priority_buffer_.Clear();
+    RestartWorker();
+  }
+  shutdown_m_.unlock();
+}
+
+void BatchSpanProcessor::RestartWorker()
+{
+  if (worker_task_ != nullptr)
+  {
+    ResetWorkerSchedule();
+    executor_->ResumeTask(worker_task_, worker_timeout_);
+    return;
+  }
+  worker_thread_ = std::thread(&BatchSpanProcessor::DoBackgroundWork, this);
+}
+
+common::BatchProcessorStats BatchSpanProcessor::GetStats() const noexcept
+{
+  common::BatchProcessorStats stats = stats_->GetStats();
+  stats.enqueued       = buffer_.production_count() + priority_buffer_.production_count();
+  stats.queue_size     = buffer_.size() + priority_buffer_.size();
+  stats.max_queue_size = buffer_.max_size() + priority_buffer_.max_size();
+  return stats;
+}
+
+std::map<std::string, uint64_t> BatchSpanProcessor::GetTenantDrops() const
+{
+  if (tenant_drops_ == nullptr)
+  {
+    return {};
+  }
+  return tenant_drops_->GetDrops();
+}
+
+void BatchSpanProcessor::ReleaseCharges(
+    nostd::span<const std::unique_ptr<Recordable>> spans) noexcept
+{
+  if (memory_budget_ == nullptr)
+  {
+    return;
+  }
+  size_t bytes = 0;
+  for (const auto &span : spans)
+  {
+    bytes += GetChargedBytes(*span);
+  }
+  memory_budget_->Release(bytes);
+}
+
 BatchSpanProcessor::~BatchSpanProcessor()
 {
+  if (memory_budget_ != nullptr)
+  {
+    memory_budget_->RemovePressureListener(pressure_listener_id_);
+  }
   if (is_shutdown_.load() == false)
   {
     Shutdown();
@@ -15,14 +15,28 @@ namespace trace_api = opentelemetry::trace;
 trace_api::SpanId RandomIdGenerator::GenerateSpanId() noexcept
 {
   uint8_t span_id_buf[trace_api::SpanId::kSize];
-  sdk::common::Random::GenerateRandomBuffer(span_id_buf);
+  if (buffered_)
+  {
+    sdk::common::Random::GenerateBufferedRandomBuffer(span_id_buf);
+  }
+  else
+  {
+    sdk::common::Random::GenerateRandomBuffer(span_id_buf);
+  }
   return trace_api::SpanId(span_id_buf);
 }
 
 trace_api::TraceId RandomIdGenerator::GenerateTraceId() noexcept
 {
   uint8_t trace_id_buf[trace_api::TraceId::kSize];
-  sdk::common::Random::GenerateRandomBuffer(trace_id_buf);
+  if (buffered_)
+  {
+    sdk::common::Random::GenerateBufferedRandomBuffer(trace_id_buf);
+  }
+  else
+  {
+    sdk::common::Random::GenerateRandomBuffer(trace_id_buf);
+  }
   return trace_api::TraceId(trace_id_buf);
 }
 }  // namespace trace
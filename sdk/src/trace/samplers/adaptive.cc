@@ -0,0 +1,113 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/adaptive.h"
+#include "src/trace/samplers/threshold.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace trace_api = opentelemetry::trace;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+int64_t NowNanos() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double ClampRatio(double ratio) noexcept
+{
+  return std::min(std::max(ratio, 0.0), 1.0);
+}
+}  // namespace
+
+constexpr const char *AdaptiveSampler::kTraceStateKey;
+
+AdaptiveSampler::AdaptiveSampler(double target_spans_per_second,
+                                 std::chrono::steady_clock::duration adjustment_interval,
+                                 double initial_ratio)
+    : target_spans_per_second_(target_spans_per_second),
+      adjustment_interval_(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(adjustment_interval).count()),
+      ratio_(ClampRatio(initial_ratio)),
+      threshold_(RatioToThreshold(ClampRatio(initial_ratio))),
+      started_spans_(0),
+      interval_start_(NowNanos())
+{
+  if (!(target_spans_per_second > 0))
+  {
+    throw std::invalid_argument("target_spans_per_second must be positive");
+  }
+  description_ = "AdaptiveSampler{" + std::to_string(target_spans_per_second) + "}";
+}
+
+SamplingResult AdaptiveSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId trace_id,
+    nostd::string_view /*name*/,
+    trace_api::SpanKind /*span_kind*/,
+    const opentelemetry::common::KeyValueIterable & /*attributes*/,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  started_spans_.fetch_add(1, std::memory_order_relaxed);
+  const int64_t now = NowNanos();
+  if (now - interval_start_.load(std::memory_order_relaxed) >= adjustment_interval_)
+  {
+    Adjust(now);
+  }
+
+  const uint64_t threshold = threshold_.load(std::memory_order_relaxed);
+  if (threshold == 0 || TraceIdValue(trace_id) > threshold)
+  {
+    return {Decision::DROP, nullptr};
+  }
+
+  auto trace_state = parent_context.IsValid() ? parent_context.trace_state()
+                                              : trace_api::TraceState::GetDefault();
+  return {Decision::RECORD_AND_SAMPLE, nullptr,
+          trace_state->Set(kTraceStateKey,
+                           "ratio:" + std::to_string(ratio_.load(std::memory_order_relaxed)))};
+}
+
+void AdaptiveSampler::Adjust(int64_t now) noexcept
+{
+  int64_t interval_start = interval_start_.load(std::memory_order_relaxed);
+  if (now - interval_start < adjustment_interval_ ||
+      !interval_start_.compare_exchange_strong(interval_start, now, std::memory_order_relaxed))
+  {
+    // Another thread adjusts the ratio for this interval.
+    return;
+  }
+
+  const double started_per_second =
+      static_cast<double>(started_spans_.exchange(0, std::memory_order_relaxed)) * 1e9 /
+      static_cast<double>(now - interval_start);
+  const double ratio = ratio_.load(std::memory_order_relaxed);
+  const double ideal_ratio =
+      started_per_second > 0 ? ClampRatio(target_spans_per_second_ / started_per_second) : 1.0;
+  const double new_ratio = (ratio + ideal_ratio) / 2;
+
+  ratio_.store(new_ratio, std::memory_order_relaxed);
+  threshold_.store(RatioToThreshold(new_ratio), std::memory_order_relaxed);
+}
+
+nostd::string_view AdaptiveSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+
+double AdaptiveSampler::GetRatio() const noexcept
+{
+  return ratio_.load(std::memory_order_relaxed);
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
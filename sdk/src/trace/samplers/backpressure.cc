@@ -0,0 +1,68 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/backpressure.h"
+#include "src/trace/samplers/threshold.h"
+
+#include <stdexcept>
+
+namespace trace_api = opentelemetry::trace;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+BackpressureSampler::BackpressureSampler(std::shared_ptr<Sampler> delegate_sampler,
+                                         std::shared_ptr<const common::BackpressureSignal> signal,
+                                         double threshold)
+    : delegate_sampler_(std::move(delegate_sampler)),
+      signal_(std::move(signal)),
+      threshold_(threshold)
+{
+  if (delegate_sampler_ == nullptr || signal_ == nullptr)
+  {
+    throw std::invalid_argument("delegate_sampler and signal must not be null");
+  }
+  if (!(threshold >= 0.0 && threshold < 1.0))
+  {
+    throw std::invalid_argument("threshold must be in [0, 1)");
+  }
+  description_ = "Backpressure{" + std::string{delegate_sampler_->GetDescription()} + "}";
+}
+
+SamplingResult BackpressureSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId trace_id,
+    nostd::string_view name,
+    trace_api::SpanKind span_kind,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const trace_api::SpanContextKeyValueIterable &links) noexcept
+{
+  // Checked first: under backpressure, the delegate is not even asked for the spans shed.
+  const double keep_ratio = GetKeepRatio();
+  if (keep_ratio < 1.0 && TraceIdValue(trace_id) >= RatioToThreshold(keep_ratio))
+  {
+    return {Decision::DROP, nullptr};
+  }
+  return delegate_sampler_->ShouldSample(parent_context, trace_id, name, span_kind, attributes,
+                                         links);
+}
+
+nostd::string_view BackpressureSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+
+double BackpressureSampler::GetKeepRatio() const noexcept
+{
+  const double level = signal_->GetLevel();
+  if (level <= threshold_)
+  {
+    return 1.0;
+  }
+  return (1.0 - level) / (1.0 - threshold_);
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,176 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/consistent_probability.h"
+#include "src/common/random.h"
+#include "src/trace/samplers/threshold.h"
+
+#include <cmath>
+
+namespace trace_api = opentelemetry::trace;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+// Parses a p-value or r-value, from 0 to max_value. Returns -1 if it is not one.
+int ParseValue(nostd::string_view value, int max_value) noexcept
+{
+  if (value.empty() || value.size() > 2)
+  {
+    return -1;
+  }
+  int result = 0;
+  for (char c : value)
+  {
+    if (c < '0' || c > '9')
+    {
+      return -1;
+    }
+    result = result * 10 + (c - '0');
+  }
+  return result <= max_value ? result : -1;
+}
+}  // namespace
+
+constexpr const char *ConsistentProbabilityBasedSampler::kTraceStateKey;
+constexpr int ConsistentProbabilityBasedSampler::kMaxPValue;
+constexpr int ConsistentProbabilityBasedSampler::kMaxRValue;
+
+ConsistentProbabilityBasedSampler::ConsistentProbabilityBasedSampler(double probability) noexcept
+{
+  if (probability > 1.0)
+  {
+    probability = 1.0;
+  }
+  description_ = "ConsistentProbabilityBasedSampler{" + std::to_string(probability) + "}";
+
+  if (!(probability >= std::ldexp(1.0, -kMaxRValue)))
+  {
+    // Too small to be told from zero.
+    p_value_           = kMaxPValue;
+    lower_p_threshold_ = UINT64_MAX;
+    return;
+  }
+  // probability is in (2^-(p + 1), 2^-p].
+  int exponent          = 0;
+  const double mantissa = std::frexp(probability, &exponent);
+  p_value_              = -exponent + (mantissa == 0.5 ? 1 : 0);
+  if (mantissa == 0.5)
+  {
+    lower_p_threshold_ = UINT64_MAX;
+    return;
+  }
+  // Picking p with a weight w and p + 1 otherwise samples w * 2^-p + (1 - w) * 2^-(p + 1).
+  lower_p_threshold_ = RatioToThreshold(std::ldexp(probability, p_value_ + 1) - 1.0);
+}
+
+SamplingResult ConsistentProbabilityBasedSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId trace_id,
+    nostd::string_view /*name*/,
+    trace_api::SpanKind /*span_kind*/,
+    const opentelemetry::common::KeyValueIterable & /*attributes*/,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  auto trace_state = parent_context.IsValid() ? parent_context.trace_state()
+                                              : trace_api::TraceState::GetDefault();
+
+  int parent_p_value = -1;
+  int r_value        = -1;
+  std::string other_fields;
+  std::string entry;
+  if (trace_state->Get(kTraceStateKey, entry))
+  {
+    ParseTraceStateValue(entry, parent_p_value, r_value, other_fields);
+  }
+  if (r_value < 0)
+  {
+    r_value = GetRValue(trace_id);
+  }
+
+  int p_value = p_value_;
+  if (lower_p_threshold_ != UINT64_MAX &&
+      sdk::common::Random::GenerateBufferedRandom64() >= lower_p_threshold_)
+  {
+    ++p_value;
+  }
+
+  const bool sampled = p_value <= r_value;
+  entry              = sampled ? "p:" + std::to_string(p_value) + ";r:" : "r:";
+  entry += std::to_string(r_value);
+  if (!other_fields.empty())
+  {
+    entry += ';';
+    entry += other_fields;
+  }
+  return {sampled ? Decision::RECORD_AND_SAMPLE : Decision::DROP, nullptr,
+          trace_state->Set(kTraceStateKey, entry)};
+}
+
+nostd::string_view ConsistentProbabilityBasedSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+
+int ConsistentProbabilityBasedSampler::GetRValue(const trace_api::TraceId &trace_id) noexcept
+{
+  const uint8_t *bytes = trace_id.Id().data() + trace_api::TraceId::kSize - 8;
+  int r_value          = 0;
+  for (size_t i = 0; i < 8 && r_value < kMaxRValue; ++i)
+  {
+    if (bytes[i] != 0)
+    {
+      for (uint8_t mask = 0x80; (bytes[i] & mask) == 0; mask >>= 1)
+      {
+        ++r_value;
+      }
+      break;
+    }
+    r_value += 8;
+  }
+  return r_value < kMaxRValue ? r_value : kMaxRValue;
+}
+
+void ConsistentProbabilityBasedSampler::ParseTraceStateValue(nostd::string_view value,
+                                                             int &p_value,
+                                                             int &r_value,
+                                                             std::string &other_fields)
+{
+  p_value = -1;
+  r_value = -1;
+  other_fields.clear();
+  size_t start = 0;
+  while (start < value.size())
+  {
+    size_t end = start;
+    while (end < value.size() && value[end] != ';')
+    {
+      ++end;
+    }
+    nostd::string_view field = value.substr(start, end - start);
+    if (field.size() >= 2 && field[0] == 'p' && field[1] == ':')
+    {
+      p_value = ParseValue(field.substr(2), kMaxPValue);
+    }
+    else if (field.size() >= 2 && field[0] == 'r' && field[1] == ':')
+    {
+      r_value = ParseValue(field.substr(2), kMaxRValue);
+    }
+    else if (!field.empty())
+    {
+      if (!other_fields.empty())
+      {
+        other_fields += ';';
+      }
+      other_fields.append(field.data(), field.size());
+    }
+    start = end + 1;
+  }
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
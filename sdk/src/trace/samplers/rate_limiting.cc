@@ -0,0 +1,80 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/rate_limiting.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace trace_api = opentelemetry::trace;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+// Caps the interval between two tokens to about 30 years, keeping the time arithmetic in range.
+constexpr double kMaxIntervalNanos = 1e18;
+
+int64_t NowNanos() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+constexpr const char *RateLimitingSampler::kTraceStateKey;
+
+RateLimitingSampler::RateLimitingSampler(double spans_per_second)
+    : interval_(spans_per_second > 0
+                    ? static_cast<int64_t>(std::min(1e9 / spans_per_second, kMaxIntervalNanos))
+                    : 0),
+      burst_(std::max(interval_, static_cast<int64_t>(1e9))),
+      paid_until_(NowNanos() - burst_)
+{
+  if (!(spans_per_second > 0))
+  {
+    throw std::invalid_argument("spans_per_second must be positive");
+  }
+  description_       = "RateLimitingSampler{" + std::to_string(spans_per_second) + "}";
+  trace_state_value_ = "rate:" + std::to_string(spans_per_second);
+}
+
+SamplingResult RateLimitingSampler::ShouldSample(
+    const trace_api::SpanContext &parent_context,
+    trace_api::TraceId /*trace_id*/,
+    nostd::string_view /*name*/,
+    trace_api::SpanKind /*span_kind*/,
+    const opentelemetry::common::KeyValueIterable & /*attributes*/,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  const int64_t now  = NowNanos();
+  int64_t paid_until = paid_until_.load(std::memory_order_relaxed);
+  int64_t next;
+  do
+  {
+    // The bucket refills up to burst_ nanoseconds worth of tokens.
+    next = std::max(paid_until, now - burst_) + interval_;
+    if (next > now)
+    {
+      return {Decision::DROP, nullptr};
+    }
+  } while (!paid_until_.compare_exchange_weak(paid_until, next, std::memory_order_relaxed));
+
+  auto trace_state = parent_context.IsValid() ? parent_context.trace_state()
+                                              : trace_api::TraceState::GetDefault();
+  return {Decision::RECORD_AND_SAMPLE, nullptr,
+          trace_state->Set(kTraceStateKey, trace_state_value_)};
+}
+
+nostd::string_view RateLimitingSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,191 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
+#include "src/trace/samplers/threshold.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace trace_api = opentelemetry::trace;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+// Sets `string_value` to the value of a string attribute, returns false for the other types.
+bool GetStringValue(const opentelemetry::common::AttributeValue &value,
+                    nostd::string_view &string_value) noexcept
+{
+  if (nostd::holds_alternative<nostd::string_view>(value))
+  {
+    string_value = nostd::get<nostd::string_view>(value);
+    return true;
+  }
+  if (nostd::holds_alternative<const char *>(value))
+  {
+    string_value = nostd::get<const char *>(value);
+    return true;
+  }
+  return false;
+}
+}  // namespace
+
+constexpr size_t RuleBasedSampler::kMaxRules;
+constexpr size_t RuleBasedSampler::kMaxPredicates;
+
+size_t RuleBasedSampler::StringViewHash::operator()(nostd::string_view value) const noexcept
+{
+  size_t hash = static_cast<size_t>(14695981039346656037ULL);
+  for (char c : value)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= static_cast<size_t>(1099511628211ULL);
+  }
+  return hash;
+}
+
+RuleBasedSampler::RuleBasedSampler(std::vector<SamplingRule> rules, double default_ratio)
+    : rules_(std::move(rules))
+{
+  if (rules_.size() > kMaxRules)
+  {
+    throw std::invalid_argument("too many sampling rules");
+  }
+
+  size_t num_predicates = 0;
+  for (size_t i = 0; i < rules_.size(); ++i)
+  {
+    const SamplingRule &rule = rules_[i];
+    const uint64_t bit       = uint64_t{1} << i;
+
+    if (rule.span_name.empty())
+    {
+      any_name_rules_ |= bit;
+    }
+    else
+    {
+      name_rules_[rule.span_name] |= bit;
+    }
+
+    for (size_t kind = 0; kind < kNumSpanKinds; ++kind)
+    {
+      if (rule.span_kinds.empty() ||
+          std::find(rule.span_kinds.begin(), rule.span_kinds.end(),
+                    static_cast<trace_api::SpanKind>(kind)) != rule.span_kinds.end())
+      {
+        kind_rules_[kind] |= bit;
+      }
+    }
+
+    uint64_t predicates = 0;
+    for (const auto &attribute : rule.attributes)
+    {
+      // Rules sharing a predicate share its bit.
+      uint64_t &predicate = predicates_[attribute.first][attribute.second];
+      if (predicate == 0)
+      {
+        if (num_predicates == kMaxPredicates)
+        {
+          throw std::invalid_argument("too many sampling rule attribute predicates");
+        }
+        predicate = uint64_t{1} << num_predicates++;
+      }
+      predicates |= predicate;
+    }
+    rule_predicates_.push_back(predicates);
+    if (predicates != 0)
+    {
+      predicated_rules_ |= bit;
+    }
+
+    thresholds_.push_back(RatioToThreshold(rule.ratio));
+  }
+  thresholds_.push_back(RatioToThreshold(default_ratio));
+
+  description_ = "RuleBasedSampler{" + std::to_string(rules_.size()) + "," +
+                 std::to_string(default_ratio) + "}";
+}
+
+size_t RuleBasedSampler::FindRule(
+    nostd::string_view name,
+    trace_api::SpanKind span_kind,
+    const opentelemetry::common::KeyValueIterable &attributes) const noexcept
+{
+  uint64_t candidates = any_name_rules_;
+  auto name_it        = name_rules_.find(name);
+  if (name_it != name_rules_.end())
+  {
+    candidates |= name_it->second;
+  }
+  const size_t kind = static_cast<size_t>(span_kind);
+  candidates &= kind < kNumSpanKinds ? kind_rules_[kind] : 0;
+
+  if ((candidates & predicated_rules_) != 0)
+  {
+    uint64_t satisfied = 0;
+    attributes.ForEachKeyValue([&](nostd::string_view key,
+                                   opentelemetry::common::AttributeValue value) noexcept {
+      auto key_it = predicates_.find(key);
+      if (key_it == predicates_.end())
+      {
+        return true;
+      }
+      nostd::string_view string_value;
+      if (GetStringValue(value, string_value))
+      {
+        auto value_it = key_it->second.find(string_value);
+        if (value_it != key_it->second.end())
+        {
+          satisfied |= value_it->second;
+        }
+      }
+      return true;
+    });
+
+    for (size_t i = 0; i < rule_predicates_.size(); ++i)
+    {
+      if ((rule_predicates_[i] & ~satisfied) != 0)
+      {
+        candidates &= ~(uint64_t{1} << i);
+      }
+    }
+  }
+
+  // The first rule is the lowest bit set.
+  for (size_t i = 0; candidates != 0; ++i, candidates >>= 1)
+  {
+    if ((candidates & 1) != 0)
+    {
+      return i;
+    }
+  }
+  return rules_.size();
+}
+
+SamplingResult RuleBasedSampler::ShouldSample(
+    const trace_api::SpanContext & /*parent_context*/,
+    trace_api::TraceId trace_id,
+    nostd::string_view name,
+    trace_api::SpanKind span_kind,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const trace_api::SpanContextKeyValueIterable & /*links*/) noexcept
+{
+  const uint64_t threshold = thresholds_[FindRule(name, span_kind, attributes)];
+  if (threshold != UINT64_MAX && TraceIdValue(trace_id) >= threshold)
+  {
+    return {Decision::DROP, nullptr};
+  }
+  return {Decision::RECORD_AND_SAMPLE, nullptr};
+}
+
+nostd::string_view RuleBasedSampler::GetDescription() const noexcept
+{
+  return description_;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
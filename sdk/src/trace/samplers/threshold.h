@@ -0,0 +1,53 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "opentelemetry/trace/trace_id.h"
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/**
+ * Converts a sampling ratio to a threshold in [0, UINT64_MAX], compared with TraceIdValue. Ratios
+ * below 0 and NaN map to 0, ratios above 1 to UINT64_MAX.
+ */
+inline uint64_t RatioToThreshold(double ratio) noexcept
+{
+  if (!(ratio > 0.0))
+    return 0;
+  if (ratio >= 1.0)
+    return UINT64_MAX;
+
+  // We can't directly return ratio * UINT64_MAX.
+  //
+  // UINT64_MAX is (2^64)-1, but as a double rounds up to 2^64.
+  // For probabilities >= 1-(2^-54), the product wraps to zero!
+  // Instead, calculate the high and low 32 bits separately.
+  const double product = UINT32_MAX * ratio;
+  double hi_bits, lo_bits = ldexp(modf(product, &hi_bits), 32) + product;
+  return (static_cast<uint64_t>(hi_bits) << 32) + static_cast<uint64_t>(lo_bits);
+}
+
+/**
+ * Returns the first 8 bytes of a trace id, which the samplers compare with their threshold.
+ */
+inline uint64_t TraceIdValue(const opentelemetry::trace::TraceId &trace_id) noexcept
+{
+  static_assert(opentelemetry::trace::TraceId::kSize >= 8,
+                "TraceID must be at least 8 bytes long.");
+
+  uint64_t value = 0;
+  std::memcpy(&value, trace_id.Id().data(), sizeof(value));
+  return value;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
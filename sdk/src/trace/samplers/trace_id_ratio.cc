@@ -14,40 +14,20 @@
 // limitations under the License.
 
 #include "opentelemetry/sdk/trace/samplers/trace_id_ratio.h"
+#include "src/trace/samplers/threshold.h"
 
-#include <cmath>
 #include <cstdint>
 #include <stdexcept>
 
 namespace trace_api = opentelemetry::trace;
 
-namespace
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
 {
-/**
- * Converts a ratio in [0, 1] to a threshold in [0, UINT64_MAX]
- *
- * @param ratio a required value top be converted to uint64_t. is
- * bounded by 1 >= ratio >= 0.
- * @return Returns threshold value computed after converting ratio to
- * uint64_t datatype
- */
-uint64_t CalculateThreshold(double ratio) noexcept
+namespace trace
+{
+namespace
 {
-  if (ratio <= 0.0)
-    return 0;
-  if (ratio >= 1.0)
-    return UINT64_MAX;
-
-  // We can't directly return ratio * UINT64_MAX.
-  //
-  // UINT64_MAX is (2^64)-1, but as a double rounds up to 2^64.
-  // For probabilities >= 1-(2^-54), the product wraps to zero!
-  // Instead, calculate the high and low 32 bits separately.
-  const double product = UINT32_MAX * ratio;
-  double hi_bits, lo_bits = ldexp(modf(product, &hi_bits), 32) + product;
-  return (static_cast<uint64_t>(hi_bits) << 32) + static_cast<uint64_t>(lo_bits);
-}
-
 /**
  * @param trace_id a required value to be converted to uint64_t. trace_id must
  * at least 8 bytes long
@@ -56,25 +36,14 @@ uint64_t CalculateThreshold(double ratio) noexcept
  */
 uint64_t CalculateThresholdFromBuffer(const trace_api::TraceId &trace_id) noexcept
 {
-  // We only use the first 8 bytes of TraceId.
-  static_assert(trace_api::TraceId::kSize >= 8, "TraceID must be at least 8 bytes long.");
-
-  uint64_t res = 0;
-  std::memcpy(&res, &trace_id, 8);
+  double ratio = (double)TraceIdValue(trace_id) / UINT64_MAX;
 
-  double ratio = (double)res / UINT64_MAX;
-
-  return CalculateThreshold(ratio);
+  return RatioToThreshold(ratio);
 }
 }  // namespace
 
-OPENTELEMETRY_BEGIN_NAMESPACE
-namespace sdk
-{
-namespace trace
-{
 TraceIdRatioBasedSampler::TraceIdRatioBasedSampler(double ratio)
-    : threshold_(CalculateThreshold(ratio))
+    : threshold_(RatioToThreshold(ratio))
 {
   if (ratio > 1.0)
     ratio = 1.0;
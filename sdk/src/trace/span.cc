@@ -5,9 +5,15 @@
 #include "src/common/random.h"
 
 #include "opentelemetry/context/runtime_context.h"
+#include "opentelemetry/sdk/common/tracepoint.h"
 #include "opentelemetry/trace/trace_flags.h"
 #include "opentelemetry/version.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -20,11 +26,11 @@ namespace common = opentelemetry::common;
 
 namespace
 {
-SystemTimestamp NowOr(const SystemTimestamp &system)
+SystemTimestamp NowOr(const SystemTimestamp &system, sdk::common::Clock &clock)
 {
   if (system == SystemTimestamp())
   {
-    return SystemTimestamp(std::chrono::system_clock::now());
+    return clock.SystemNow();
   }
   else
   {
@@ -32,30 +38,152 @@ SystemTimestamp NowOr(const SystemTimestamp &system)
   }
 }
 
-SteadyTimestamp NowOr(const SteadyTimestamp &steady)
+SteadyTimestamp NowOr(const SteadyTimestamp &steady, sdk::common::Clock &clock)
 {
   if (steady == SteadyTimestamp())
   {
-    return SteadyTimestamp(std::chrono::steady_clock::now());
+    return clock.SteadyNow();
   }
   else
   {
     return steady;
   }
 }
+size_t HashKey(nostd::string_view key) noexcept
+{
+  // FNV-1a
+  size_t hash = static_cast<size_t>(14695981039346656037ULL);
+  for (char c : key)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= static_cast<size_t>(1099511628211ULL);
+  }
+  return hash;
+}
+
+/**
+ * Returns value with its strings cut to max_length bytes. Truncated string
+ * arrays are views of storage.
+ */
+common::AttributeValue TruncateValue(const common::AttributeValue &value,
+                                     size_t max_length,
+                                     std::vector<nostd::string_view> &storage) noexcept
+{
+  if (nostd::holds_alternative<const char *>(value))
+  {
+    const char *str = nostd::get<const char *>(value);
+    if (max_length != (std::numeric_limits<size_t>::max)() &&
+        strnlen(str, max_length + 1) > max_length)
+    {
+      return nostd::string_view(str, max_length);
+    }
+  }
+  else if (nostd::holds_alternative<nostd::string_view>(value))
+  {
+    nostd::string_view str = nostd::get<nostd::string_view>(value);
+    if (str.size() > max_length)
+    {
+      return str.substr(0, max_length);
+    }
+  }
+  else if (nostd::holds_alternative<nostd::span<const nostd::string_view>>(value))
+  {
+    auto strs = nostd::get<nostd::span<const nostd::string_view>>(value);
+    if (std::any_of(strs.begin(), strs.end(),
+                    [max_length](nostd::string_view str) { return str.size() > max_length; }))
+    {
+      storage.clear();
+      for (nostd::string_view str : strs)
+      {
+        storage.push_back(str.substr(0, max_length));
+      }
+      return nostd::span<const nostd::string_view>(storage.data(), storage.size());
+    }
+  }
+  return value;
+}
+
+/**
+ * The first max_attributes of a set of attributes, with their strings cut to
+ * max_value_length bytes.
+ */
+class LimitedAttributes final : public common::KeyValueIterable
+{
+public:
+  LimitedAttributes(const common::KeyValueIterable &attributes,
+                    size_t max_attributes,
+                    size_t max_value_length) noexcept
+      : attributes_(attributes),
+        max_attributes_(max_attributes),
+        max_value_length_(max_value_length)
+  {}
+
+  bool ForEachKeyValue(nostd::function_ref<bool(nostd::string_view, common::AttributeValue)>
+                           callback) const noexcept override
+  {
+    size_t count  = 0;
+    bool complete = true;
+    std::vector<nostd::string_view> storage;
+    attributes_.ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) noexcept {
+      if (count++ == max_attributes_)
+      {
+        return false;
+      }
+      complete = callback(key, TruncateValue(value, max_value_length_, storage));
+      return complete;
+    });
+    return complete;
+  }
+
+  size_t size() const noexcept override { return (std::min)(attributes_.size(), max_attributes_); }
+
+private:
+  const common::KeyValueIterable &attributes_;
+  const size_t max_attributes_;
+  const size_t max_value_length_;
+};
 }  // namespace
 
+Span::Guard::Guard(const Span &span) noexcept
+{
+  if (!span.single_owner_)
+  {
+    lock_ = std::unique_lock<std::mutex>(span.mu_);
+    return;
+  }
+#ifndef NDEBUG
+  in_use_ = &span.in_use_;
+  const bool was_in_use = in_use_->exchange(true, std::memory_order_acquire);
+  assert(!was_in_use && "single-owner span used by several threads at the same time");
+  (void)was_in_use;
+#endif
+}
+
+Span::Guard::~Guard()
+{
+#ifndef NDEBUG
+  if (in_use_ != nullptr)
+  {
+    in_use_->store(false, std::memory_order_release);
+  }
+#endif
+}
+
 Span::Span(std::shared_ptr<Tracer> &&tracer,
            nostd::string_view name,
            const common::KeyValueIterable &attributes,
            const trace_api::SpanContextKeyValueIterable &links,
            const trace_api::StartSpanOptions &options,
            const trace_api::SpanContext &parent_span_context,
-           std::unique_ptr<trace_api::SpanContext> span_context) noexcept
+           const trace_api::SpanContext &span_context) noexcept
     : tracer_{std::move(tracer)},
-      recordable_{tracer_->GetProcessor().MakeRecordable()},
+      limits_{tracer_->GetSpanLimits()},
+      single_owner_{options.single_owner},
+      processor_entry_{tracer_->AcquireProcessor()},
+      processor_{*processor_entry_.processor},
+      recordable_{processor_.MakeRecordable()},
       start_steady_time{options.start_steady_time},
-      span_context_(std::move(span_context)),
+      span_context_(span_context),
       has_ended_{false}
 {
   if (recordable_ == nullptr)
@@ -64,26 +192,61 @@ Span::Span(std::shared_ptr<Tracer> &&tracer,
   }
   recordable_->SetName(name);
   recordable_->SetInstrumentationLibrary(tracer_->GetInstrumentationLibrary());
-  recordable_->SetIdentity(*span_context_, parent_span_context.IsValid()
-                                               ? parent_span_context.span_id()
-                                               : trace_api::SpanId());
+  recordable_->SetIdentity(span_context_, parent_span_context.IsValid()
+                                              ? parent_span_context.span_id()
+                                              : trace_api::SpanId());
+  if (options.expected_attributes > 0 || options.expected_events > 0)
+  {
+    recordable_->Reserve((std::min)(options.expected_attributes, limits_.max_attributes),
+                         (std::min)(options.expected_events, limits_.max_events));
+  }
 
+  std::vector<nostd::string_view> storage;
   attributes.ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) noexcept {
-    recordable_->SetAttribute(key, value);
+    if (AdmitAttribute(key))
+    {
+      recordable_->SetAttribute(key,
+                                TruncateValue(value, limits_.max_attribute_value_length, storage));
+    }
     return true;
   });
 
+  size_t num_links = 0;
   links.ForEachKeyValue([&](opentelemetry::trace::SpanContext span_context,
                             const common::KeyValueIterable &attributes) {
-    recordable_->AddLink(span_context, attributes);
+    if (num_links++ >= limits_.max_links)
+    {
+      ++dropped_links_;
+      return true;
+    }
+    recordable_->AddLink(span_context,
+                         LimitedAttributes(attributes, limits_.max_attributes_per_link,
+                                           limits_.max_attribute_value_length));
     return true;
   });
 
   recordable_->SetSpanKind(options.kind);
-  recordable_->SetStartTime(NowOr(options.start_system_time));
-  start_steady_time = NowOr(options.start_steady_time);
+  recordable_->SetStartTime(NowOr(options.start_system_time, tracer_->GetClock()));
+  start_steady_time = NowOr(options.start_steady_time, tracer_->GetClock());
   recordable_->SetResource(tracer_->GetResource());
-  tracer_->GetProcessor().OnStart(*recordable_, parent_span_context);
+  processor_.OnStart(*recordable_, parent_span_context);
+
+  SpanProfilingOptions profiling = tracer_->GetSpanProfiling();
+  if (profiling.record_cpu_time || profiling.allocation_counter != nullptr)
+  {
+    start_thread_ = std::this_thread::get_id();
+    if (profiling.record_cpu_time)
+    {
+      start_cpu_time_ns_ = GetThreadCpuTimeNanos();
+    }
+    if (profiling.allocation_counter != nullptr)
+    {
+      allocation_counter_ = profiling.allocation_counter;
+      start_allocations_  = allocation_counter_();
+    }
+  }
+  OTEL_SDK_TRACEPOINT2(span__start, span_context_.trace_id().Id().data(),
+                       span_context_.span_id().Id().data());
 }
 
 Span::~Span()
@@ -91,31 +254,60 @@ Span::~Span()
   End();
 }
 
+bool Span::AdmitAttribute(nostd::string_view key) noexcept
+{
+  const size_t hash = HashKey(key);
+  if (std::find(attribute_key_hashes_.begin(), attribute_key_hashes_.end(), hash) !=
+      attribute_key_hashes_.end())
+  {
+    return true;
+  }
+  if (attribute_key_hashes_.size() >= limits_.max_attributes)
+  {
+    ++dropped_attributes_;
+    return false;
+  }
+  attribute_key_hashes_.push_back(hash);
+  return true;
+}
+
+bool Span::AdmitEvent() noexcept
+{
+  if (num_events_ >= limits_.max_events)
+  {
+    ++dropped_events_;
+    return false;
+  }
+  ++num_events_;
+  return true;
+}
+
 void Span::SetAttribute(nostd::string_view key, const common::AttributeValue &value) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
-  if (recordable_ == nullptr)
+  Guard guard{*this};
+  if (recordable_ == nullptr || !AdmitAttribute(key))
   {
     return;
   }
 
-  recordable_->SetAttribute(key, value);
+  std::vector<nostd::string_view> storage;
+  recordable_->SetAttribute(key, TruncateValue(value, limits_.max_attribute_value_length, storage));
 }
 
 void Span::AddEvent(nostd::string_view name) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
-  if (recordable_ == nullptr)
+  Guard guard{*this};
+  if (recordable_ == nullptr || !AdmitEvent())
   {
     return;
   }
-  recordable_->AddEvent(name);
+  recordable_->AddEvent(name, tracer_->GetClock().SystemNow());
 }
 
 void Span::AddEvent(nostd::string_view name, SystemTimestamp timestamp) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
-  if (recordable_ == nullptr)
+  Guard guard{*this};
+  if (recordable_ == nullptr || !AdmitEvent())
   {
     return;
   }
@@ -126,17 +318,19 @@ void Span::AddEvent(nostd::string_view name,
                     SystemTimestamp timestamp,
                     const common::KeyValueIterable &attributes) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
-  if (recordable_ == nullptr)
+  Guard guard{*this};
+  if (recordable_ == nullptr || !AdmitEvent())
   {
     return;
   }
-  recordable_->AddEvent(name, timestamp, attributes);
+  recordable_->AddEvent(name, timestamp,
+                        LimitedAttributes(attributes, limits_.max_attributes_per_event,
+                                          limits_.max_attribute_value_length));
 }
 
 void Span::SetStatus(opentelemetry::trace::StatusCode code, nostd::string_view description) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
+  Guard guard{*this};
   if (recordable_ == nullptr)
   {
     return;
@@ -146,7 +340,7 @@ void Span::SetStatus(opentelemetry::trace::StatusCode code, nostd::string_view d
 
 void Span::UpdateName(nostd::string_view name) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
+  Guard guard{*this};
   if (recordable_ == nullptr)
   {
     return;
@@ -156,7 +350,7 @@ void Span::UpdateName(nostd::string_view name) noexcept
 
 void Span::End(const trace_api::EndSpanOptions &options) noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
+  Guard guard{*this};
 
   if (has_ended_ == true)
   {
@@ -166,20 +360,58 @@ void Span::End(const trace_api::EndSpanOptions &options) noexcept
 
   if (recordable_ == nullptr)
   {
+    tracer_->ReleaseProcessor(processor_entry_);
     return;
   }
 
-  auto end_steady_time = NowOr(options.end_steady_time);
-  recordable_->SetDuration(std::chrono::steady_clock::time_point(end_steady_time) -
-                           std::chrono::steady_clock::time_point(start_steady_time));
+  if (start_cpu_time_ns_ >= 0 || allocation_counter_ != nullptr)
+  {
+    RecordProfile();
+  }
 
-  tracer_->GetProcessor().OnEnd(std::move(recordable_));
+  if (dropped_attributes_ != 0 || dropped_events_ != 0 || dropped_links_ != 0)
+  {
+    recordable_->SetDroppedCounts(dropped_attributes_, dropped_events_, dropped_links_);
+  }
+
+  auto end_steady_time = NowOr(options.end_steady_time, tracer_->GetClock());
+  auto duration        = std::chrono::steady_clock::time_point(end_steady_time) -
+                         std::chrono::steady_clock::time_point(start_steady_time);
+  recordable_->SetDuration(duration);
+  OTEL_SDK_TRACEPOINT3(
+      span__end, span_context_.trace_id().Id().data(), span_context_.span_id().Id().data(),
+      static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+
+  processor_.OnEnd(std::move(recordable_));
   recordable_.reset();
+  tracer_->ReleaseProcessor(processor_entry_);
+}
+
+void Span::RecordProfile() noexcept
+{
+  // The clock and the counter of another thread tell nothing about the span.
+  if (std::this_thread::get_id() != start_thread_)
+  {
+    return;
+  }
+  if (start_cpu_time_ns_ >= 0)
+  {
+    int64_t end_cpu_time_ns = GetThreadCpuTimeNanos();
+    if (end_cpu_time_ns >= start_cpu_time_ns_)
+    {
+      recordable_->SetAttribute(kSpanThreadCpuTimeKey, end_cpu_time_ns - start_cpu_time_ns_);
+    }
+  }
+  if (allocation_counter_ != nullptr)
+  {
+    recordable_->SetAttribute(kSpanThreadAllocationsKey,
+                              allocation_counter_() - start_allocations_);
+  }
 }
 
 bool Span::IsRecording() const noexcept
 {
-  std::lock_guard<std::mutex> lock_guard{mu_};
+  Guard guard{*this};
   return recordable_ != nullptr;
 }
 }  // namespace trace
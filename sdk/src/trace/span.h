@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "opentelemetry/sdk/trace/tracer.h"
 #include "opentelemetry/version.h"
@@ -22,7 +25,7 @@ class Span final : public opentelemetry::trace::Span
        const opentelemetry::trace::SpanContextKeyValueIterable &links,
        const opentelemetry::trace::StartSpanOptions &options,
        const opentelemetry::trace::SpanContext &parent_span_context,
-       std::unique_ptr<opentelemetry::trace::SpanContext> span_context) noexcept;
+       const opentelemetry::trace::SpanContext &span_context) noexcept;
 
   ~Span() override;
 
@@ -48,18 +51,75 @@ class Span final : public opentelemetry::trace::Span
 
   bool IsRecording() const noexcept override;
 
-  opentelemetry::trace::SpanContext GetContext() const noexcept override
-  {
-    return *span_context_.get();
-  }
+  opentelemetry::trace::SpanContext GetContext() const noexcept override { return span_context_; }
 
 private:
+  /**
+   * Locks mu_ for the duration of a call, unless the span was started with
+   * StartSpanOptions::single_owner. Debug builds then check instead that no two
+   * threads use the span at the same time.
+   */
+  class Guard
+  {
+  public:
+    explicit Guard(const Span &span) noexcept;
+    ~Guard();
+
+  private:
+    std::unique_lock<std::mutex> lock_;
+#ifndef NDEBUG
+    std::atomic<bool> *in_use_ = nullptr;
+#endif
+  };
+
+  /**
+   * Returns whether an attribute with this key may be set under the span
+   * limits, counting it as dropped if not.
+   */
+  bool AdmitAttribute(nostd::string_view key) noexcept;
+
+  /**
+   * Returns whether one more event may be added under the span limits,
+   * counting it as dropped if not.
+   */
+  bool AdmitEvent() noexcept;
+
+  /**
+   * Records the CPU time and the allocations of the thread since the span started, see
+   * SpanProfilingOptions.
+   */
+  void RecordProfile() noexcept;
+
   std::shared_ptr<Tracer> tracer_;
+  const SpanLimits &limits_;
+  const bool single_owner_;
   mutable std::mutex mu_;
+#ifndef NDEBUG
+  mutable std::atomic<bool> in_use_{false};
+#endif
+  // The processor of the tracer when the span started, which the span ends on even if the
+  // processors of the tracer were replaced since, released once the span ended.
+  TracerContext::ProcessorEntry &processor_entry_;
+  SpanProcessor &processor_;
   std::unique_ptr<Recordable> recordable_;
   opentelemetry::common::SteadyTimestamp start_steady_time;
-  std::unique_ptr<opentelemetry::trace::SpanContext> span_context_;
+  // Held by value, in the same allocation as the span.
+  const opentelemetry::trace::SpanContext span_context_;
   bool has_ended_;
+
+  // Hashes of the attribute keys set so far, to tell new keys from updated ones.
+  std::vector<size_t> attribute_key_hashes_;
+  size_t num_events_           = 0;
+  uint32_t dropped_attributes_ = 0;
+  uint32_t dropped_events_     = 0;
+  uint32_t dropped_links_      = 0;
+
+  // The thread CPU time and allocation count when the span started, when recorded: -1 and
+  // nullptr otherwise.
+  int64_t start_cpu_time_ns_            = -1;
+  AllocationCounter allocation_counter_ = nullptr;
+  uint64_t start_allocations_           = 0;
+  std::thread::id start_thread_;
 };
 }  // namespace trace
 }  // namespace sdk
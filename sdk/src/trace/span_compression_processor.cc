@@ -0,0 +1,374 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/span_compression_processor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+using opentelemetry::trace::SpanContext;
+using opentelemetry::trace::SpanId;
+using opentelemetry::trace::TraceId;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+/**
+ * Forwards to the recordable of the wrapped processor, and records what makes the span
+ * compressible and identical to its siblings.
+ */
+class CompressionRecordable final : public Recordable
+{
+public:
+  explicit CompressionRecordable(std::unique_ptr<Recordable> &&recordable) noexcept
+      : recordable_(std::move(recordable))
+  {}
+
+  Recordable &GetRecordable() noexcept { return *recordable_; }
+
+  std::unique_ptr<Recordable> ReleaseRecordable() noexcept { return std::move(recordable_); }
+
+  const TraceId &GetTraceId() const noexcept { return trace_id_; }
+
+  const SpanId &GetSpanId() const noexcept { return span_id_; }
+
+  const SpanId &GetParentSpanId() const noexcept { return parent_span_id_; }
+
+  std::chrono::nanoseconds GetDuration() const noexcept { return duration_; }
+
+  std::chrono::system_clock::time_point GetStart() const noexcept { return start_time_; }
+
+  std::chrono::system_clock::time_point GetEnd() const noexcept
+  {
+    return GetStart() +
+           std::chrono::duration_cast<std::chrono::system_clock::duration>(duration_);
+  }
+
+  /* Whether the span may be merged with identical siblings. */
+  bool IsCompressible(opentelemetry::trace::SpanKind kind,
+                      std::chrono::nanoseconds max_duration) const noexcept
+  {
+    return parent_span_id_.IsValid() && kind_ == kind && duration_ < max_duration &&
+           !has_events_or_links_ && status_ != opentelemetry::trace::StatusCode::kError;
+  }
+
+  /* Whether the spans have the same name, kind and attribute keys. */
+  bool IsIdentical(const CompressionRecordable &other) const noexcept
+  {
+    if (kind_ != other.kind_ || name_ != other.name_ ||
+        attribute_key_hashes_.size() != other.attribute_key_hashes_.size())
+    {
+      return false;
+    }
+    for (size_t hash : attribute_key_hashes_)
+    {
+      if (std::find(other.attribute_key_hashes_.begin(), other.attribute_key_hashes_.end(),
+                    hash) == other.attribute_key_hashes_.end())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void SetIdentity(const SpanContext &span_context, SpanId parent_span_id) noexcept override
+  {
+    trace_id_       = span_context.trace_id();
+    span_id_        = span_context.span_id();
+    parent_span_id_ = parent_span_id;
+    recordable_->SetIdentity(span_context, parent_span_id);
+  }
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    size_t hash = std::hash<std::string>()(std::string(key.data(), key.size()));
+    if (std::find(attribute_key_hashes_.begin(), attribute_key_hashes_.end(), hash) ==
+        attribute_key_hashes_.end())
+    {
+      attribute_key_hashes_.push_back(hash);
+    }
+    recordable_->SetAttribute(key, value);
+  }
+
+  void AddEvent(nostd::string_view name,
+                opentelemetry::common::SystemTimestamp timestamp,
+                const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    has_events_or_links_ = true;
+    recordable_->AddEvent(name, timestamp, attributes);
+  }
+
+  void AddLink(const SpanContext &span_context,
+               const opentelemetry::common::KeyValueIterable &attributes) noexcept override
+  {
+    has_events_or_links_ = true;
+    recordable_->AddLink(span_context, attributes);
+  }
+
+  void SetStatus(opentelemetry::trace::StatusCode code,
+                 nostd::string_view description) noexcept override
+  {
+    status_ = code;
+    recordable_->SetStatus(code, description);
+  }
+
+  void SetName(nostd::string_view name) noexcept override
+  {
+    name_.assign(name.data(), name.size());
+    recordable_->SetName(name);
+  }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    kind_ = span_kind;
+    recordable_->SetSpanKind(span_kind);
+  }
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &resource) noexcept override
+  {
+    recordable_->SetResource(resource);
+  }
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp start_time) noexcept override
+  {
+    start_time_ = start_time;
+    recordable_->SetStartTime(start_time);
+  }
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override
+  {
+    duration_ = duration;
+    recordable_->SetDuration(duration);
+  }
+
+  void SetInstrumentationLibrary(
+      const InstrumentationLibrary &instrumentation_library) noexcept override
+  {
+    recordable_->SetInstrumentationLibrary(instrumentation_library);
+  }
+
+  void Reserve(size_t attributes, size_t events) noexcept override
+  {
+    recordable_->Reserve(attributes, events);
+  }
+
+  void SetDroppedCounts(uint32_t attributes, uint32_t events, uint32_t links) noexcept override
+  {
+    recordable_->SetDroppedCounts(attributes, events, links);
+  }
+
+private:
+  std::unique_ptr<Recordable> recordable_;
+  TraceId trace_id_;
+  SpanId span_id_;
+  SpanId parent_span_id_;
+  std::string name_;
+  opentelemetry::trace::SpanKind kind_ = opentelemetry::trace::SpanKind::kInternal;
+  opentelemetry::trace::StatusCode status_ = opentelemetry::trace::StatusCode::kUnset;
+  opentelemetry::common::SystemTimestamp start_time_;
+  std::chrono::nanoseconds duration_{0};
+  std::vector<size_t> attribute_key_hashes_;
+  bool has_events_or_links_ = false;
+};
+}  // namespace
+
+size_t SpanCompressionProcessor::ParentKeyHash::operator()(const ParentKey &key) const noexcept
+{
+  // Span ids are random, their bytes are as good a hash as any.
+  uint64_t value = 0;
+  std::memcpy(&value, key.span_id.Id().data(), sizeof(value));
+  return static_cast<size_t>(value);
+}
+
+SpanCompressionProcessor::SpanCompressionProcessor(std::unique_ptr<SpanProcessor> &&processor,
+                                                   const SpanCompressionProcessorOptions &options)
+    : processor_(std::move(processor)),
+      kind_(options.kind),
+      max_duration_(options.max_duration),
+      max_pending_runs_(options.max_pending_runs),
+      num_buckets_(options.num_buckets > 0 ? options.num_buckets : 1),
+      buckets_(new Bucket[num_buckets_])
+{}
+
+std::unique_ptr<Recordable> SpanCompressionProcessor::MakeRecordable() noexcept
+{
+  return std::unique_ptr<Recordable>(new CompressionRecordable(processor_->MakeRecordable()));
+}
+
+void SpanCompressionProcessor::OnStart(Recordable &span, const SpanContext &parent_context) noexcept
+{
+  processor_->OnStart(static_cast<CompressionRecordable &>(span).GetRecordable(), parent_context);
+}
+
+void SpanCompressionProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
+{
+  if (is_shutdown_.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  auto &recordable = static_cast<CompressionRecordable &>(*span);
+
+  // The children of the span all ended before it: their run has no more siblings to come.
+  Run children;
+  if (TakeRun({recordable.GetTraceId(), recordable.GetSpanId()}, children))
+  {
+    Forward(std::move(children));
+  }
+
+  if (!recordable.GetParentSpanId().IsValid())
+  {
+    processor_->OnEnd(recordable.ReleaseRecordable());
+    return;
+  }
+
+  const bool compressible = recordable.IsCompressible(kind_, max_duration_);
+  ParentKey parent{recordable.GetTraceId(), recordable.GetParentSpanId()};
+  Bucket &bucket = GetBucket(parent);
+  Run previous;
+  bool has_previous = false;
+  {
+    std::lock_guard<std::mutex> guard(bucket.lock);
+    auto it = bucket.runs.find(parent);
+    if (it != bucket.runs.end())
+    {
+      Run &run   = it->second;
+      auto first = static_cast<CompressionRecordable *>(run.first.get());
+      if (compressible && first->IsIdentical(recordable))
+      {
+        ++run.count;
+        run.duration_sum += recordable.GetDuration();
+        run.end = (std::max)(run.end, recordable.GetEnd());
+        compressed_spans_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      // A different sibling ends the run, and starts the next one if it is compressible.
+      previous     = std::move(run);
+      has_previous = true;
+      if (compressible)
+      {
+        run              = Run();
+        run.duration_sum = recordable.GetDuration();
+        run.end          = recordable.GetEnd();
+        run.first        = std::move(span);
+      }
+      else
+      {
+        bucket.runs.erase(it);
+        pending_runs_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    else if (compressible && pending_runs_.load(std::memory_order_relaxed) < max_pending_runs_)
+    {
+      Run &run         = bucket.runs[parent];
+      run.duration_sum = recordable.GetDuration();
+      run.end          = recordable.GetEnd();
+      run.first        = std::move(span);
+      pending_runs_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (has_previous)
+  {
+    Forward(std::move(previous));
+  }
+  if (span != nullptr)
+  {
+    processor_->OnEnd(static_cast<CompressionRecordable &>(*span).ReleaseRecordable());
+  }
+}
+
+SpanCompressionProcessor::Bucket &SpanCompressionProcessor::GetBucket(const ParentKey &key) noexcept
+{
+  return buckets_[ParentKeyHash()(key) % num_buckets_];
+}
+
+bool SpanCompressionProcessor::TakeRun(const ParentKey &key, Run &run) noexcept
+{
+  Bucket &bucket = GetBucket(key);
+  std::lock_guard<std::mutex> guard(bucket.lock);
+  auto it = bucket.runs.find(key);
+  if (it == bucket.runs.end())
+  {
+    return false;
+  }
+  run = std::move(it->second);
+  bucket.runs.erase(it);
+  pending_runs_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+void SpanCompressionProcessor::Forward(Run &&run) noexcept
+{
+  auto &first = static_cast<CompressionRecordable &>(*run.first);
+  if (run.count > 1)
+  {
+    Recordable &recordable = first.GetRecordable();
+    recordable.SetAttribute("span.compression.count", static_cast<int64_t>(run.count));
+    recordable.SetAttribute("span.compression.duration_sum",
+                            static_cast<int64_t>(run.duration_sum.count()));
+    recordable.SetDuration(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(run.end - first.GetStart()));
+    composite_spans_.fetch_add(1, std::memory_order_relaxed);
+  }
+  processor_->OnEnd(first.ReleaseRecordable());
+}
+
+void SpanCompressionProcessor::ForwardAll() noexcept
+{
+  for (size_t i = 0; i < num_buckets_; ++i)
+  {
+    std::unordered_map<ParentKey, Run, ParentKeyHash> runs;
+    {
+      std::lock_guard<std::mutex> guard(buckets_[i].lock);
+      runs.swap(buckets_[i].runs);
+    }
+    pending_runs_.fetch_sub(runs.size(), std::memory_order_relaxed);
+    for (auto &run : runs)
+    {
+      Forward(std::move(run.second));
+    }
+  }
+}
+
+bool SpanCompressionProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+  ForwardAll();
+  return processor_->ForceFlush(timeout);
+}
+
+bool SpanCompressionProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  if (shutdown_latch_.test_and_set(std::memory_order_acquire))
+  {
+    return true;
+  }
+  ForwardAll();
+  is_shutdown_.store(true, std::memory_order_release);
+  return processor_->Shutdown(timeout);
+}
+
+SpanCompressionProcessorStats SpanCompressionProcessor::GetStats() const noexcept
+{
+  SpanCompressionProcessorStats stats;
+  stats.pending_runs     = pending_runs_.load(std::memory_order_relaxed);
+  stats.composite_spans  = composite_spans_.load(std::memory_order_relaxed);
+  stats.compressed_spans = compressed_spans_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+SpanCompressionProcessor::~SpanCompressionProcessor()
+{
+  Shutdown();
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,335 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/trace/span_metrics_processor.h"
+#  include "opentelemetry/context/context.h"
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
+#  include "opentelemetry/sdk/trace/arena_span_data.h"
+
+#  include <functional>
+#  include <mutex>
+#  include <utility>
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+namespace metrics_api = opentelemetry::metrics;
+
+using SeriesKey = SpanMetricsProcessor::SeriesKey;
+
+/* Converts the scalar attribute values to their owned representation, and rejects arrays. */
+struct ScalarAttributeConverter
+{
+  template <class T>
+  bool operator()(T v)
+  {
+    value = v;
+    return true;
+  }
+
+  bool operator()(nostd::string_view v)
+  {
+    value = std::string(v.data(), v.size());
+    return true;
+  }
+
+  bool operator()(const char *v) { return (*this)(nostd::string_view(v)); }
+
+  template <class T>
+  bool operator()(nostd::span<const T>)
+  {
+    return false;
+  }
+
+  opentelemetry::sdk::common::OwnedAttributeValue &value;
+};
+
+/* Refers to a scalar owned attribute value as a non-owning one. */
+struct ScalarAttributeView
+{
+  template <class T>
+  opentelemetry::common::AttributeValue operator()(const T &v)
+  {
+    return v;
+  }
+
+  opentelemetry::common::AttributeValue operator()(const std::string &v)
+  {
+    return nostd::string_view(v);
+  }
+
+  template <class T>
+  opentelemetry::common::AttributeValue operator()(const std::vector<T> &)
+  {
+    return false;
+  }
+};
+
+nostd::string_view SpanKindName(opentelemetry::trace::SpanKind kind) noexcept
+{
+  switch (kind)
+  {
+    case opentelemetry::trace::SpanKind::kServer:
+      return "SPAN_KIND_SERVER";
+    case opentelemetry::trace::SpanKind::kClient:
+      return "SPAN_KIND_CLIENT";
+    case opentelemetry::trace::SpanKind::kProducer:
+      return "SPAN_KIND_PRODUCER";
+    case opentelemetry::trace::SpanKind::kConsumer:
+      return "SPAN_KIND_CONSUMER";
+    default:
+      return "SPAN_KIND_INTERNAL";
+  }
+}
+
+nostd::string_view StatusCodeName(opentelemetry::trace::StatusCode code) noexcept
+{
+  switch (code)
+  {
+    case opentelemetry::trace::StatusCode::kOk:
+      return "STATUS_CODE_OK";
+    case opentelemetry::trace::StatusCode::kError:
+      return "STATUS_CODE_ERROR";
+    default:
+      return "STATUS_CODE_UNSET";
+  }
+}
+
+/**
+ * Only keeps what the metrics of a span are keyed by, and its duration.
+ */
+class SpanMetricsRecordable final : public Recordable
+{
+public:
+  explicit SpanMetricsRecordable(const std::vector<std::string> &dimension_keys) noexcept
+      : dimension_keys_(dimension_keys)
+  {
+    key_.dimensions.resize(dimension_keys.size());
+  }
+
+  const SeriesKey &GetSeriesKey() const noexcept { return key_; }
+
+  std::chrono::nanoseconds GetDuration() const noexcept { return duration_; }
+
+  void SetIdentity(const opentelemetry::trace::SpanContext &,
+                   opentelemetry::trace::SpanId) noexcept override
+  {}
+
+  void SetAttribute(nostd::string_view key,
+                    const opentelemetry::common::AttributeValue &value) noexcept override
+  {
+    for (size_t i = 0; i < dimension_keys_.size(); ++i)
+    {
+      if (key == dimension_keys_[i])
+      {
+        auto &dimension   = key_.dimensions[i];
+        dimension.present = nostd::visit(ScalarAttributeConverter{dimension.value}, value);
+        return;
+      }
+    }
+  }
+
+  void AddEvent(nostd::string_view,
+                opentelemetry::common::SystemTimestamp,
+                const opentelemetry::common::KeyValueIterable &) noexcept override
+  {}
+
+  void AddLink(const opentelemetry::trace::SpanContext &,
+               const opentelemetry::common::KeyValueIterable &) noexcept override
+  {}
+
+  void SetStatus(opentelemetry::trace::StatusCode code, nostd::string_view) noexcept override
+  {
+    key_.status = code;
+  }
+
+  void SetName(nostd::string_view name) noexcept override
+  {
+    key_.name.assign(name.data(), name.size());
+  }
+
+  void SetSpanKind(opentelemetry::trace::SpanKind span_kind) noexcept override
+  {
+    key_.kind = span_kind;
+  }
+
+  void SetResource(const opentelemetry::sdk::resource::Resource &) noexcept override {}
+
+  void SetStartTime(opentelemetry::common::SystemTimestamp) noexcept override {}
+
+  void SetDuration(std::chrono::nanoseconds duration) noexcept override { duration_ = duration; }
+
+  void SetInstrumentationLibrary(const InstrumentationLibrary &) noexcept override {}
+
+private:
+  const std::vector<std::string> &dimension_keys_;
+  SeriesKey key_;
+  std::chrono::nanoseconds duration_{0};
+};
+}  // namespace
+
+bool SpanMetricsProcessor::SeriesKey::operator==(const SeriesKey &other) const noexcept
+{
+  if (kind != other.kind || status != other.status || name != other.name)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < dimensions.size(); ++i)
+  {
+    if (dimensions[i].present != other.dimensions[i].present ||
+        (dimensions[i].present && !(dimensions[i].value == other.dimensions[i].value)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SpanMetricsProcessor::SeriesKeyHash::operator()(const SeriesKey &key) const noexcept
+{
+  size_t seed = std::hash<std::string>()(key.name);
+  opentelemetry::sdk::common::CombineHash(seed, static_cast<size_t>(key.kind));
+  opentelemetry::sdk::common::CombineHash(seed, static_cast<size_t>(key.status));
+  for (auto &dimension : key.dimensions)
+  {
+    opentelemetry::sdk::common::CombineHash(
+        seed, dimension.present
+                  ? opentelemetry::sdk::common::GetHashForAttribute("", dimension.value)
+                  : 0);
+  }
+  return seed;
+}
+
+SpanMetricsProcessor::SpanMetricsProcessor(nostd::shared_ptr<metrics_api::Meter> meter,
+                                           const SpanMetricsProcessorOptions &options)
+    : dimension_keys_(options.dimension_keys),
+      max_series_(options.max_series),
+      calls_(meter->CreateLongCounter(options.name_prefix + ".calls", "Spans ended", "{spans}")),
+      duration_(meter->CreateDoubleHistogram(options.name_prefix + ".duration",
+                                             "Duration of the spans", "ms"))
+{}
+
+std::unique_ptr<Recordable> SpanMetricsProcessor::MakeRecordable() noexcept
+{
+  return std::unique_ptr<Recordable>(new SpanMetricsRecordable(dimension_keys_));
+}
+
+void SpanMetricsProcessor::OnStart(Recordable &, const opentelemetry::trace::SpanContext &) noexcept
+{}
+
+void SpanMetricsProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
+{
+  if (is_shutdown_.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  const ArenaSpanData *span_data = span->GetSharedSpanData();
+  if (span_data == nullptr)
+  {
+    auto &recordable = static_cast<SpanMetricsRecordable &>(*span);
+    Record(recordable.GetSeriesKey(), recordable.GetDuration());
+    return;
+  }
+
+  // Recorded once for several processors by a MultiSpanProcessor.
+  SpanMetricsRecordable recordable(dimension_keys_);
+  recordable.SetName(span_data->GetName());
+  recordable.SetSpanKind(span_data->GetSpanKind());
+  recordable.SetStatus(span_data->GetStatus(), "");
+  span_data->GetAttributes().ForEachKeyValue(
+      [&recordable](nostd::string_view key, opentelemetry::common::AttributeValue value) noexcept {
+        recordable.SetAttribute(key, value);
+        return true;
+      });
+  Record(recordable.GetSeriesKey(), span_data->GetDuration());
+}
+
+void SpanMetricsProcessor::Record(const SeriesKey &key, std::chrono::nanoseconds duration) noexcept
+{
+  const double duration_ms = std::chrono::duration<double, std::milli>(duration).count();
+  const opentelemetry::context::Context context;
+  {
+    opentelemetry::sdk::common::SharedSpinLockGuard<opentelemetry::sdk::common::SharedSpinLockMutex>
+        guard(lock_);
+    auto it = series_.find(key);
+    if (it != series_.end())
+    {
+      it->second.calls->Add(1);
+      it->second.duration->Record(duration_ms, context);
+      return;
+    }
+  }
+
+  std::vector<std::pair<nostd::string_view, opentelemetry::common::AttributeValue>> attributes;
+  attributes.reserve(3 + dimension_keys_.size());
+  attributes.emplace_back("span.name", nostd::string_view(key.name));
+  attributes.emplace_back("span.kind", SpanKindName(key.kind));
+  attributes.emplace_back("status.code", StatusCodeName(key.status));
+  for (size_t i = 0; i < dimension_keys_.size(); ++i)
+  {
+    if (key.dimensions[i].present)
+    {
+      attributes.emplace_back(dimension_keys_[i],
+                              nostd::visit(ScalarAttributeView(), key.dimensions[i].value));
+    }
+  }
+
+  Series series;
+  {
+    std::lock_guard<opentelemetry::sdk::common::SharedSpinLockMutex> guard(lock_);
+    auto it = series_.find(key);
+    if (it != series_.end())
+    {
+      series = it->second;
+    }
+    else if (series_.size() < max_series_)
+    {
+      series.calls    = calls_->Bind(attributes);
+      series.duration = duration_->Bind(attributes);
+      series_.emplace(key, series);
+    }
+  }
+
+  if (!series.calls)
+  {
+    unbound_spans_.fetch_add(1, std::memory_order_relaxed);
+    calls_->Add(1, attributes);
+    duration_->Record(duration_ms, attributes, context);
+    return;
+  }
+  series.calls->Add(1);
+  series.duration->Record(duration_ms, context);
+}
+
+bool SpanMetricsProcessor::ForceFlush(std::chrono::microseconds) noexcept
+{
+  return true;
+}
+
+bool SpanMetricsProcessor::Shutdown(std::chrono::microseconds) noexcept
+{
+  is_shutdown_.store(true, std::memory_order_release);
+  return true;
+}
+
+SpanMetricsProcessorStats SpanMetricsProcessor::GetStats() const noexcept
+{
+  SpanMetricsProcessorStats stats;
+  {
+    opentelemetry::sdk::common::SharedSpinLockGuard<opentelemetry::sdk::common::SharedSpinLockMutex>
+        guard(lock_);
+    stats.series = series_.size();
+  }
+  stats.unbound_spans = unbound_spans_.load(std::memory_order_relaxed);
+  return stats;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
+#endif
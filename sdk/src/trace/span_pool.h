@@ -0,0 +1,136 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "opentelemetry/version.h"
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+/* The blocks each thread keeps for reuse, of each size allocated through a SpanPoolAllocator. */
+constexpr size_t kMaxPooledSpansPerThread = 128;
+
+namespace detail
+{
+struct FreeSpanBlock
+{
+  FreeSpanBlock *next;
+};
+
+/**
+ * The free blocks of one size of a thread. Trivially destructible, so that it stays usable by the
+ * spans released after the thread-local destructors ran, which then go back to the heap.
+ */
+struct SpanBlockList
+{
+  FreeSpanBlock *head;
+  size_t size;
+  bool closed;
+};
+
+template <size_t Size>
+SpanBlockList &GetSpanBlockList() noexcept
+{
+  static thread_local SpanBlockList list{nullptr, 0, false};
+  return list;
+}
+
+/* Returns the blocks of a thread to the heap when the thread exits. */
+template <size_t Size>
+struct SpanBlockListCloser
+{
+  ~SpanBlockListCloser()
+  {
+    SpanBlockList &list = GetSpanBlockList<Size>();
+    while (list.head != nullptr)
+    {
+      FreeSpanBlock *block = list.head;
+      list.head            = block->next;
+      ::operator delete(block);
+    }
+    list.size   = 0;
+    list.closed = true;
+  }
+};
+}  // namespace detail
+
+/**
+ * An allocator reusing the blocks of the objects it allocates one at a time, from a free list of
+ * the thread releasing them. Given to std::allocate_shared, it makes the spans, together with
+ * their control block, in a single allocation which the next span started on the thread reuses,
+ * so that starting a span allocates nothing once the pool is warm.
+ */
+template <class T>
+class SpanPoolAllocator
+{
+public:
+  using value_type = T;
+
+  SpanPoolAllocator() noexcept = default;
+
+  template <class U>
+  SpanPoolAllocator(const SpanPoolAllocator<U> &) noexcept
+  {}
+
+  T *allocate(size_t n)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not pooled");
+    if (n == 1)
+    {
+      detail::SpanBlockList &list = detail::GetSpanBlockList<kBlockSize>();
+      if (list.head != nullptr)
+      {
+        detail::FreeSpanBlock *block = list.head;
+        list.head                    = block->next;
+        --list.size;
+        return reinterpret_cast<T *>(block);
+      }
+      return static_cast<T *>(::operator new(kBlockSize));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, size_t n) noexcept
+  {
+    if (n == 1)
+    {
+      static thread_local detail::SpanBlockListCloser<kBlockSize> closer;
+      (void)closer;
+      detail::SpanBlockList &list = detail::GetSpanBlockList<kBlockSize>();
+      if (!list.closed && list.size < kMaxPooledSpansPerThread)
+      {
+        auto block  = reinterpret_cast<detail::FreeSpanBlock *>(pointer);
+        block->next = list.head;
+        list.head   = block;
+        ++list.size;
+        return;
+      }
+    }
+    ::operator delete(pointer);
+  }
+
+private:
+  static constexpr size_t kBlockSize =
+      sizeof(T) > sizeof(detail::FreeSpanBlock) ? sizeof(T) : sizeof(detail::FreeSpanBlock);
+};
+
+template <class T, class U>
+bool operator==(const SpanPoolAllocator<T> &, const SpanPoolAllocator<U> &) noexcept
+{
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const SpanPoolAllocator<T> &, const SpanPoolAllocator<U> &) noexcept
+{
+  return false;
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
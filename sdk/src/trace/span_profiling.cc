@@ -0,0 +1,45 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/span_profiling.h"
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+
+int64_t GetThreadCpuTimeNanos() noexcept
+{
+#if defined(_WIN32)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+  {
+    return -1;
+  }
+  // FILETIMEs count 100 ns intervals.
+  auto to_ticks = [](const FILETIME &time) {
+    return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  return (to_ticks(kernel_time) + to_ticks(user_time)) * 100;
+#elif defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+  {
+    return -1;
+  }
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+  return -1;
+#endif
+}
+
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,226 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/tail_sampling_processor.h"
+#include "src/trace/samplers/threshold.h"
+
+using opentelemetry::trace::SpanContext;
+using opentelemetry::trace::TraceId;
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace sdk
+{
+namespace trace
+{
+namespace
+{
+ImportantSpanRules MakeKeepRules(const TailSamplingProcessorOptions &options)
+{
+  ImportantSpanRules rules;
+  rules.errors            = options.keep_errors;
+  rules.latency_threshold = options.latency_threshold;
+  rules.attribute_keys    = options.keep_attribute_keys;
+  return rules;
+}
+
+/**
+ * Forwards to the recordable of the wrapped processor, and records what the keep decision of
+ * the trace depends on.
+ */
+class TailSamplingRecordable final : public ImportantSpanRecordable
+{
+public:
+  TailSamplingRecordable(std::unique_ptr<Recordable> &&recordable,
+                         const ImportantSpanRules &keep_rules) noexcept
+      : ImportantSpanRecordable(std::move(recordable), keep_rules)
+  {}
+
+  const TraceId &GetTraceId() const noexcept { return trace_id_; }
+
+  bool IsLocalRoot() const noexcept { return is_local_root_; }
+
+  void SetLocalRoot(bool is_local_root) noexcept { is_local_root_ = is_local_root; }
+
+  bool ShouldKeep() const noexcept { return IsImportant(); }
+
+  void SetIdentity(const SpanContext &span_context,
+                   opentelemetry::trace::SpanId parent_span_id) noexcept override
+  {
+    trace_id_ = span_context.trace_id();
+    ImportantSpanRecordable::SetIdentity(span_context, parent_span_id);
+  }
+
+private:
+  TraceId trace_id_;
+  bool is_local_root_ = true;
+};
+}  // namespace
+
+size_t TailSamplingProcessor::TraceIdHash::operator()(const TraceId &trace_id) const noexcept
+{
+  // Trace ids are random, their first bytes are as good a hash as any.
+  return static_cast<size_t>(TraceIdValue(trace_id));
+}
+
+TailSamplingProcessor::TailSamplingProcessor(std::unique_ptr<SpanProcessor> &&processor,
+                                             const TailSamplingProcessorOptions &options)
+    : processor_(std::move(processor)),
+      threshold_(RatioToThreshold(options.sampling_ratio)),
+      keep_rules_(MakeKeepRules(options)),
+      max_buffered_spans_(options.max_buffered_spans),
+      num_buckets_(options.num_buckets > 0 ? options.num_buckets : 1),
+      buckets_(new Bucket[num_buckets_])
+{}
+
+std::unique_ptr<Recordable> TailSamplingProcessor::MakeRecordable() noexcept
+{
+  return std::unique_ptr<Recordable>(
+      new TailSamplingRecordable(processor_->MakeRecordable(), keep_rules_));
+}
+
+void TailSamplingProcessor::OnStart(Recordable &span, const SpanContext &parent_context) noexcept
+{
+  auto &recordable = static_cast<TailSamplingRecordable &>(span);
+  recordable.SetLocalRoot(!parent_context.IsValid() || parent_context.IsRemote());
+  processor_->OnStart(recordable.GetRecordable(), parent_context);
+}
+
+void TailSamplingProcessor::OnEnd(std::unique_ptr<Recordable> &&span) noexcept
+{
+  if (is_shutdown_.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  auto &recordable     = static_cast<TailSamplingRecordable &>(*span);
+  const TraceId &trace = recordable.GetTraceId();
+  Bucket &bucket       = buckets_[TraceIdHash()(trace) % num_buckets_];
+
+  std::vector<std::unique_ptr<Recordable>> decided;
+  TraceId decided_trace;
+  bool keep = false;
+  {
+    std::lock_guard<std::mutex> guard(bucket.lock);
+    auto it = bucket.traces.find(trace);
+
+    if (recordable.IsLocalRoot())
+    {
+      keep          = recordable.ShouldKeep();
+      decided_trace = trace;
+      if (it != bucket.traces.end())
+      {
+        keep    = keep || it->second.keep;
+        decided = std::move(it->second.spans);
+        bucket.traces.erase(it);
+        buffered_spans_.fetch_sub(decided.size(), std::memory_order_relaxed);
+      }
+      decided.push_back(std::move(span));
+    }
+    else
+    {
+      if (buffered_spans_.load(std::memory_order_relaxed) >= max_buffered_spans_)
+      {
+        // Decide the trace of this bucket which has been pending for the longest time.
+        auto oldest = bucket.traces.begin();
+        for (auto pending = bucket.traces.begin(); pending != bucket.traces.end(); ++pending)
+        {
+          if (pending->second.first_end < oldest->second.first_end)
+          {
+            oldest = pending;
+          }
+        }
+        if (oldest != bucket.traces.end())
+        {
+          keep          = oldest->second.keep;
+          decided       = std::move(oldest->second.spans);
+          decided_trace = oldest->first;
+          bucket.traces.erase(oldest);
+          buffered_spans_.fetch_sub(decided.size(), std::memory_order_relaxed);
+          evicted_traces_.fetch_add(1, std::memory_order_relaxed);
+          it = bucket.traces.find(trace);
+        }
+      }
+
+      if (it == bucket.traces.end())
+      {
+        it                   = bucket.traces.emplace(trace, PendingTrace()).first;
+        it->second.first_end = std::chrono::steady_clock::now();
+      }
+      it->second.keep = it->second.keep || recordable.ShouldKeep();
+      it->second.spans.push_back(std::move(span));
+      buffered_spans_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (!decided.empty())
+  {
+    Decide(std::move(decided), ShouldKeep(decided_trace, keep));
+  }
+}
+
+bool TailSamplingProcessor::ShouldKeep(const TraceId &trace_id, bool keep) const noexcept
+{
+  return keep || (threshold_ != 0 && TraceIdValue(trace_id) <= threshold_);
+}
+
+void TailSamplingProcessor::Decide(std::vector<std::unique_ptr<Recordable>> &&spans,
+                                   bool keep) noexcept
+{
+  if (!keep)
+  {
+    dropped_traces_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  kept_traces_.fetch_add(1, std::memory_order_relaxed);
+  for (auto &span : spans)
+  {
+    processor_->OnEnd(static_cast<TailSamplingRecordable &>(*span).ReleaseRecordable());
+  }
+}
+
+bool TailSamplingProcessor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+  return processor_->ForceFlush(timeout);
+}
+
+bool TailSamplingProcessor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+  if (shutdown_latch_.test_and_set(std::memory_order_acquire))
+  {
+    return true;
+  }
+
+  for (size_t i = 0; i < num_buckets_; ++i)
+  {
+    std::unordered_map<TraceId, PendingTrace, TraceIdHash> traces;
+    {
+      std::lock_guard<std::mutex> guard(buckets_[i].lock);
+      traces.swap(buckets_[i].traces);
+    }
+    for (auto &pending : traces)
+    {
+      buffered_spans_.fetch_sub(pending.second.spans.size(), std::memory_order_relaxed);
+      Decide(std::move(pending.second.spans), ShouldKeep(pending.first, pending.second.keep));
+    }
+  }
+  is_shutdown_.store(true, std::memory_order_release);
+  return processor_->Shutdown(timeout);
+}
+
+TailSamplingProcessorStats TailSamplingProcessor::GetStats() const noexcept
+{
+  TailSamplingProcessorStats stats;
+  stats.buffered_spans = buffered_spans_.load(std::memory_order_relaxed);
+  stats.kept_traces    = kept_traces_.load(std::memory_order_relaxed);
+  stats.dropped_traces = dropped_traces_.load(std::memory_order_relaxed);
+  stats.evicted_traces = evicted_traces_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+TailSamplingProcessor::~TailSamplingProcessor()
+{
+  Shutdown();
+}
+}  // namespace trace
+}  // namespace sdk
+OPENTELEMETRY_END_NAMESPACE
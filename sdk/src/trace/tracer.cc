@@ -5,9 +5,12 @@
 #include "opentelemetry/context/runtime_context.h"
 #include "opentelemetry/nostd/shared_ptr.h"
 #include "opentelemetry/sdk/common/atomic_shared_ptr.h"
+#include "opentelemetry/sdk/common/telemetry_switch.h"
 #include "opentelemetry/trace/context.h"
+#include "opentelemetry/trace/default_span.h"
 #include "opentelemetry/version.h"
 #include "src/trace/span.h"
+#include "src/trace/span_pool.h"
 
 #include <memory>
 
@@ -16,6 +19,16 @@ namespace sdk
 {
 namespace trace
 {
+namespace
+{
+// Returned by StartSpan while telemetry is switched off, shared so that no span is allocated.
+const nostd::shared_ptr<trace_api::Span> &GetDisabledSpan() noexcept
+{
+  static const nostd::shared_ptr<trace_api::Span> span{
+      new trace_api::DefaultSpan(trace_api::SpanContext::GetInvalid())};
+  return span;
+}
+}  // namespace
 
 Tracer::Tracer(std::shared_ptr<sdk::trace::TracerContext> context,
                std::unique_ptr<InstrumentationLibrary> instrumentation_library) noexcept
@@ -28,10 +41,17 @@ nostd::shared_ptr<trace_api::Span> Tracer::StartSpan(
     const trace_api::SpanContextKeyValueIterable &links,
     const trace_api::StartSpanOptions &options) noexcept
 {
-  trace_api::SpanContext parent_context = GetCurrentSpan()->GetContext();
+  if (!common::TelemetrySwitch::IsEnabled())
+  {
+    return GetDisabledSpan();
+  }
+
+  // The runtime context is only read when no valid parent is given, and the active span may parent
+  // the span.
+  trace_api::SpanContext parent_context = trace_api::SpanContext::GetInvalid();
   if (nostd::holds_alternative<trace_api::SpanContext>(options.parent))
   {
-    auto span_context = nostd::get<trace_api::SpanContext>(options.parent);
+    const auto &span_context = nostd::get<trace_api::SpanContext>(options.parent);
     if (span_context.IsValid())
     {
       parent_context = span_context;
@@ -39,7 +59,7 @@ nostd::shared_ptr<trace_api::Span> Tracer::StartSpan(
   }
   else if (nostd::holds_alternative<context::Context>(options.parent))
   {
-    auto context = nostd::get<context::Context>(options.parent);
+    const auto &context = nostd::get<context::Context>(options.parent);
     // fetch span context from parent span stored in the context
     auto span_context = opentelemetry::trace::GetSpan(context)->GetContext();
     if (span_context.IsValid())
@@ -47,6 +67,10 @@ nostd::shared_ptr<trace_api::Span> Tracer::StartSpan(
       parent_context = span_context;
     }
   }
+  if (!parent_context.IsValid() && !options.ignore_active_span)
+  {
+    parent_context = GetCurrentSpanContext();
+  }
 
   trace_api::TraceId trace_id;
   trace_api::SpanId span_id = GetIdGenerator().GenerateSpanId();
@@ -62,44 +86,44 @@ nostd::shared_ptr<trace_api::Span> Tracer::StartSpan(
     trace_id = GetIdGenerator().GenerateTraceId();
   }
 
-  auto sampling_result = context_->GetSampler().ShouldSample(parent_context, trace_id, name,
-                                                             options.kind, attributes, links);
+  auto sampling_result =
+      context_->ShouldSample(parent_context, trace_id, name, options.kind, attributes, links);
   auto trace_flags     = sampling_result.decision == Decision::DROP
                          ? trace_api::TraceFlags{}
                          : trace_api::TraceFlags{trace_api::TraceFlags::kIsSampled};
 
-  auto span_context = std::unique_ptr<trace_api::SpanContext>(new trace_api::SpanContext(
-      trace_id, span_id, trace_flags, false,
-      sampling_result.trace_state ? sampling_result.trace_state
-                                  : is_parent_span_valid ? parent_context.trace_state()
-                                                         : trace_api::TraceState::GetDefault()));
+  // A child shares the trace state of its parent, unless the sampler replaced it.
+  trace_api::SpanContext child_context =
+      sampling_result.trace_state
+          ? trace_api::SpanContext(trace_id, span_id, trace_flags, false,
+                                   std::move(sampling_result.trace_state))
+      : is_parent_span_valid ? trace_api::SpanContext(parent_context, span_id, trace_flags)
+                             : trace_api::SpanContext(trace_id, span_id, trace_flags, false);
 
   if (sampling_result.decision == Decision::DROP)
   {
-    // create no-op span with valid span-context.
-
-    auto noop_span = nostd::shared_ptr<trace_api::Span>{
-        new (std::nothrow) trace_api::NoopSpan(this->shared_from_this(), std::move(span_context))};
-    return noop_span;
+    // Dropped spans only propagate their span context: they hold it by value, and neither
+    // reference the tracer nor build a recordable, so that dropping costs a single allocation.
+    return nostd::shared_ptr<trace_api::Span>{
+        new (std::nothrow) trace_api::DefaultSpan(std::move(child_context))};
   }
-  else
-  {
 
-    auto span = nostd::shared_ptr<trace_api::Span>{
-        new (std::nothrow) Span{this->shared_from_this(), name, attributes, links, options,
-                                parent_context, std::move(span_context)}};
+  // The span, its control block and its span context are a single allocation, reused from the
+  // spans the thread released.
+  auto span = nostd::shared_ptr<trace_api::Span>{std::allocate_shared<Span>(
+      SpanPoolAllocator<Span>(), this->shared_from_this(), name, attributes, links, options,
+      parent_context, child_context)};
 
-    // if the attributes is not nullptr, add attributes to the span.
-    if (sampling_result.attributes)
+  // if the attributes is not nullptr, add attributes to the span.
+  if (sampling_result.attributes)
+  {
+    for (auto &kv : *sampling_result.attributes)
     {
-      for (auto &kv : *sampling_result.attributes)
-      {
-        span->SetAttribute(kv.first, kv.second);
-      }
+      span->SetAttribute(kv.first, kv.second);
     }
-
-    return span;
   }
+
+  return span;
 }
 
 void Tracer::ForceFlushWithMicroseconds(uint64_t timeout) noexcept
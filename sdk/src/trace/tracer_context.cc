@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "opentelemetry/sdk/trace/tracer_context.h"
+#include "opentelemetry/sdk/common/shared_deadline.h"
 #include "opentelemetry/sdk/trace/multi_span_processor.h"
 
+#include <thread>
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 namespace sdk
 {
@@ -14,16 +17,126 @@ namespace resource = opentelemetry::sdk::resource;
 TracerContext::TracerContext(std::vector<std::unique_ptr<SpanProcessor>> &&processors,
                              resource::Resource resource,
                              std::unique_ptr<Sampler> sampler,
-                             std::unique_ptr<IdGenerator> id_generator) noexcept
+                             std::unique_ptr<IdGenerator> id_generator,
+                             const SpanLimits &span_limits,
+                             std::unique_ptr<opentelemetry::sdk::common::Clock> clock) noexcept
     : resource_(resource),
-      sampler_(std::move(sampler)),
       id_generator_(std::move(id_generator)),
-      processor_(std::unique_ptr<SpanProcessor>(new MultiSpanProcessor(std::move(processors))))
-{}
+      span_limits_(span_limits),
+      clock_(std::move(clock)),
+      sampler_(sampler.get()),
+      processor_(nullptr),
+      owned_sampler_(std::move(sampler))
+{
+  processors_.emplace_back(new ProcessorEntry(
+      std::unique_ptr<SpanProcessor>(new MultiSpanProcessor(std::move(processors)))));
+  processor_.store(processors_.back().get());
+}
+
+size_t TracerContext::EnterRead() noexcept
+{
+  size_t epoch = epoch_.load() & 1;
+  readers_[epoch].fetch_add(1);
+  return epoch;
+}
+
+void TracerContext::LeaveRead(size_t epoch) noexcept
+{
+  readers_[epoch].fetch_sub(1);
+}
+
+void TracerContext::WaitForReaders() noexcept
+{
+  // A reader may take the epoch before a flip and enter after the wait for its parity: it then
+  // reads the replacement, but the next flip does not wait for it. Waiting for both parities
+  // covers it, and each wait only lasts as long as the reads entered before its flip.
+  for (int i = 0; i < 2; ++i)
+  {
+    size_t previous = epoch_.fetch_add(1) & 1;
+    while (readers_[previous].load() != 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void TracerContext::SetSampler(std::unique_ptr<Sampler> sampler) noexcept
+{
+  std::lock_guard<std::mutex> guard{update_lock_};
+  sampler_.store(sampler.get());
+  owned_sampler_.swap(sampler);
+  WaitForReaders();
+  // The replaced sampler is destroyed here, with no sampling left in progress.
+}
+
+void TracerContext::SetProcessors(std::vector<std::unique_ptr<SpanProcessor>> &&processors) noexcept
+{
+  std::unique_ptr<ProcessorEntry> entry(new ProcessorEntry(
+      std::unique_ptr<SpanProcessor>(new MultiSpanProcessor(std::move(processors)))));
+  ProcessorEntry *replaced = nullptr;
+  {
+    std::lock_guard<std::mutex> guard{update_lock_};
+    processors_.push_back(std::move(entry));
+    replaced = processor_.exchange(processors_.back().get());
+    WaitForReaders();
+  }
+  // No span acquires the replaced processor anymore: release its count as the current one.
+  ReleaseProcessor(*replaced);
+}
 
 Sampler &TracerContext::GetSampler() const noexcept
 {
-  return *sampler_;
+  return *sampler_.load(std::memory_order_acquire);
+}
+
+SamplingResult TracerContext::ShouldSample(
+    const opentelemetry::trace::SpanContext &parent_context,
+    opentelemetry::trace::TraceId trace_id,
+    nostd::string_view name,
+    opentelemetry::trace::SpanKind span_kind,
+    const opentelemetry::common::KeyValueIterable &attributes,
+    const opentelemetry::trace::SpanContextKeyValueIterable &links) noexcept
+{
+  size_t epoch = EnterRead();
+  SamplingResult result =
+      sampler_.load()->ShouldSample(parent_context, trace_id, name, span_kind, attributes, links);
+  LeaveRead(epoch);
+  return result;
+}
+
+TracerContext::ProcessorEntry &TracerContext::AcquireProcessor() noexcept
+{
+  size_t epoch          = EnterRead();
+  ProcessorEntry *entry = processor_.load();
+  entry->active_spans.fetch_add(1);
+  LeaveRead(epoch);
+  return *entry;
+}
+
+void TracerContext::ReleaseProcessor(ProcessorEntry &entry) noexcept
+{
+  if (entry.active_spans.fetch_sub(1) != 1)
+  {
+    return;
+  }
+  std::unique_ptr<ProcessorEntry> drained;
+  {
+    std::lock_guard<std::mutex> guard{update_lock_};
+    for (auto it = processors_.begin(); it != processors_.end(); ++it)
+    {
+      if (it->get() == &entry)
+      {
+        drained = std::move(*it);
+        processors_.erase(it);
+        break;
+      }
+    }
+  }
+  if (drained != nullptr)
+  {
+    drained->processor->ForceFlush();
+    drained->processor->Shutdown();
+  }
 }
 
 const resource::Resource &TracerContext::GetResource() const noexcept
@@ -36,26 +149,58 @@ opentelemetry::sdk::trace::IdGenerator &TracerContext::GetIdGenerator() const no
   return *id_generator_;
 }
 
+const SpanLimits &TracerContext::GetSpanLimits() const noexcept
+{
+  return span_limits_;
+}
+
+opentelemetry::sdk::common::Clock &TracerContext::GetClock() const noexcept
+{
+  return *clock_;
+}
+
+void TracerContext::SetSpanProfiling(const SpanProfilingOptions &options) noexcept
+{
+  record_cpu_time_.store(options.record_cpu_time, std::memory_order_relaxed);
+  allocation_counter_.store(options.allocation_counter, std::memory_order_relaxed);
+}
+
 void TracerContext::AddProcessor(std::unique_ptr<SpanProcessor> processor) noexcept
 {
 
-  auto multi_processor = static_cast<MultiSpanProcessor *>(processor_.get());
+  auto multi_processor = static_cast<MultiSpanProcessor *>(&GetProcessor());
   multi_processor->AddProcessor(std::move(processor));
 }
 
 SpanProcessor &TracerContext::GetProcessor() const noexcept
 {
-  return *processor_;
+  return *processor_.load(std::memory_order_acquire)->processor;
 }
 
 bool TracerContext::ForceFlush(std::chrono::microseconds timeout) noexcept
 {
-  return processor_->ForceFlush(timeout);
+  const auto deadline = opentelemetry::sdk::common::GetDeadline(timeout);
+  bool result         = true;
+  // Held so that no replaced processor is destroyed meanwhile. The current processor first, the
+  // replaced ones have few spans left.
+  std::lock_guard<std::mutex> guard{update_lock_};
+  for (auto it = processors_.rbegin(); it != processors_.rend(); ++it)
+  {
+    auto remaining = opentelemetry::sdk::common::GetRemainingTime(deadline);
+    result         = (*it)->processor->ForceFlush(remaining) && result;
+  }
+  return result;
 }
 
 bool TracerContext::Shutdown() noexcept
 {
-  return processor_->Shutdown();
+  bool result = true;
+  std::lock_guard<std::mutex> guard{update_lock_};
+  for (auto it = processors_.rbegin(); it != processors_.rend(); ++it)
+  {
+    result = (*it)->processor->Shutdown() && result;
+  }
+  return result;
 }
 
 }  // namespace trace
@@ -19,21 +19,27 @@ TracerProvider::TracerProvider(std::shared_ptr<sdk::trace::TracerContext> contex
 TracerProvider::TracerProvider(std::unique_ptr<SpanProcessor> processor,
                                resource::Resource resource,
                                std::unique_ptr<Sampler> sampler,
-                               std::unique_ptr<IdGenerator> id_generator) noexcept
+                               std::unique_ptr<IdGenerator> id_generator,
+                               const SpanLimits &span_limits,
+                               std::unique_ptr<opentelemetry::sdk::common::Clock> clock) noexcept
 {
   std::vector<std::unique_ptr<SpanProcessor>> processors;
   processors.push_back(std::move(processor));
   context_ = std::make_shared<TracerContext>(std::move(processors), resource, std::move(sampler),
-                                             std::move(id_generator));
+                                             std::move(id_generator), span_limits,
+                                             std::move(clock));
 }
 
 TracerProvider::TracerProvider(std::vector<std::unique_ptr<SpanProcessor>> &&processors,
                                resource::Resource resource,
                                std::unique_ptr<Sampler> sampler,
-                               std::unique_ptr<IdGenerator> id_generator) noexcept
+                               std::unique_ptr<IdGenerator> id_generator,
+                               const SpanLimits &span_limits,
+                               std::unique_ptr<opentelemetry::sdk::common::Clock> clock) noexcept
 {
   context_ = std::make_shared<TracerContext>(std::move(processors), resource, std::move(sampler),
-                                             std::move(id_generator));
+                                             std::move(id_generator), span_limits,
+                                             std::move(clock));
 }
 
 TracerProvider::~TracerProvider()
@@ -62,21 +68,16 @@ nostd::shared_ptr<trace_api::Tracer> TracerProvider::GetTracer(
     OTEL_INTERNAL_LOG_ERROR("[TracerProvider::GetTracer] Library name is empty.");
   }
 
-  const std::lock_guard<std::mutex> guard(lock_);
-
-  for (auto &tracer : tracers_)
-  {
-    auto &tracer_lib = tracer->GetInstrumentationLibrary();
-    if (tracer_lib.equal(library_name, library_version, schema_url))
-    {
-      return nostd::shared_ptr<trace_api::Tracer>{tracer};
-    }
-  }
-
-  auto lib = InstrumentationLibrary::Create(library_name, library_version, schema_url);
-  tracers_.push_back(std::shared_ptr<opentelemetry::sdk::trace::Tracer>(
-      new sdk::trace::Tracer(context_, std::move(lib))));
-  return nostd::shared_ptr<trace_api::Tracer>{tracers_.back()};
+  size_t hash = tracers_.Hash(library_name, library_version, schema_url);
+  return nostd::shared_ptr<trace_api::Tracer>{tracers_.FindOrInsert(
+      hash,
+      [&](const Tracer &tracer) {
+        return tracer.GetInstrumentationLibrary().equal(library_name, library_version, schema_url);
+      },
+      [&]() {
+        auto lib = InstrumentationLibrary::Create(library_name, library_version, schema_url);
+        return std::shared_ptr<Tracer>(new Tracer(context_, std::move(lib)));
+      })};
 }
 
 void TracerProvider::AddProcessor(std::unique_ptr<SpanProcessor> processor) noexcept
@@ -84,6 +85,22 @@ void TracerProvider::AddProcessor(std::unique_ptr<SpanProcessor> processor) noex
   context_->AddProcessor(std::move(processor));
 }
 
+void TracerProvider::SetSampler(std::unique_ptr<Sampler> sampler) noexcept
+{
+  context_->SetSampler(std::move(sampler));
+}
+
+void TracerProvider::SetProcessors(
+    std::vector<std::unique_ptr<SpanProcessor>> &&processors) noexcept
+{
+  context_->SetProcessors(std::move(processors));
+}
+
+void TracerProvider::SetSpanProfiling(const SpanProfilingOptions &options) noexcept
+{
+  context_->SetSpanProfiling(options);
+}
+
 const resource::Resource &TracerProvider::GetResource() const noexcept
 {
   return context_->GetResource();
@@ -8,8 +8,10 @@
 #  include <iostream>
 #  include <map>
 #  include <memory>
+#  include <atomic>
 #  include <string>
 #  include <thread>
+#  include <vector>
 
 #  include "opentelemetry/common/macros.h"
 #  include "opentelemetry/sdk/_metrics/async_instruments.h"
@@ -316,6 +318,50 @@ TEST(Counter, StressAdd)
             3000);
 }
 
+TEST(Counter, StressAddWhileCollecting)
+{
+  std::shared_ptr<Counter<int>> alpha(new Counter<int>("test", "none", "unitless", true));
+
+  std::map<std::string, std::string> labels  = {{"key", "value"}};
+  std::map<std::string, std::string> labels1 = {{"key1", "value1"}};
+
+  auto labelkv  = common::KeyValueIterableView<decltype(labels)>{labels};
+  auto labelkv1 = common::KeyValueIterableView<decltype(labels1)>{labels1};
+
+  // Collections prune the bound instruments between adds, which must bind them again.
+  std::atomic<bool> done(false);
+  int collected = 0;
+  std::thread collector([&] {
+    while (!done.load())
+    {
+      for (auto &record : alpha->GetRecords())
+      {
+        collected += nostd::get<std::shared_ptr<Aggregator<int>>>(record.GetAggregator())
+                         ->get_checkpoint()[0];
+      }
+    }
+  });
+
+  std::vector<std::thread> adders;
+  adders.emplace_back(CounterCallback, alpha, 2000, labelkv);
+  adders.emplace_back(CounterCallback, alpha, 2000, labelkv);
+  adders.emplace_back(CounterCallback, alpha, 3000, labelkv1);
+  for (auto &adder : adders)
+  {
+    adder.join();
+  }
+  done.store(true);
+  collector.join();
+
+  for (auto &record : alpha->GetRecords())
+  {
+    collected +=
+        nostd::get<std::shared_ptr<Aggregator<int>>>(record.GetAggregator())->get_checkpoint()[0];
+  }
+  EXPECT_EQ(collected, 7000);
+  EXPECT_EQ(alpha->boundInstruments_.size(), 0);
+}
+
 void UpDownCounterCallback(std::shared_ptr<UpDownCounter<int>> in,
                            int freq,
                            const common::KeyValueIterable &labels)
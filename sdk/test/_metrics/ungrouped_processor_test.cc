@@ -598,4 +598,56 @@ TEST(UngroupedMetricsProcessor, UngroupedProcessorKeepsRecordInformationStateful
                 ->get_checkpoint(),
             test_aggregator->get_checkpoint());
 }
+
+/* Test that records whose keys only differ by their content, and not by the length of their
+   strings, are not merged together */
+TEST(UngroupedMetricsProcessor, UngroupedProcessorSeparatesKeysOfSameLength)
+{
+  auto processor = std::unique_ptr<metric_sdk::MetricsProcessor>(
+      new metric_sdk::UngroupedMetricsProcessor(true));
+
+  auto aggregator_a = std::shared_ptr<metric_sdk::Aggregator<int>>(
+      new metric_sdk::CounterAggregator<int>(metrics_api::InstrumentKind::Counter));
+  auto aggregator_b = std::shared_ptr<metric_sdk::Aggregator<int>>(
+      new metric_sdk::CounterAggregator<int>(metrics_api::InstrumentKind::Counter));
+  auto aggregator_c = std::shared_ptr<metric_sdk::Aggregator<int>>(
+      new metric_sdk::CounterAggregator<int>(metrics_api::InstrumentKind::UpDownCounter));
+
+  aggregator_a->update(1);
+  aggregator_a->checkpoint();
+  aggregator_b->update(10);
+  aggregator_b->checkpoint();
+  aggregator_c->update(100);
+  aggregator_c->checkpoint();
+
+  processor->process(metric_sdk::Record("name_a", "description", "labels", aggregator_a));
+  processor->process(metric_sdk::Record("name_b", "description", "labels", aggregator_b));
+  processor->process(metric_sdk::Record("name_a", "description", "labels", aggregator_c));
+  processor->process(metric_sdk::Record("name_a", "description", "labels", aggregator_a));
+
+  std::vector<metric_sdk::Record> checkpoint = processor->CheckpointSelf();
+  ASSERT_EQ(checkpoint.size(), 3);
+
+  int name_a_counter = 0;
+  for (auto &record : checkpoint)
+  {
+    auto aggregator = nostd::get<std::shared_ptr<metric_sdk::Aggregator<int>>>(
+        record.GetAggregator());
+    if (record.GetName() == "name_b")
+    {
+      EXPECT_EQ(aggregator->get_checkpoint()[0], 10);
+    }
+    else if (aggregator->get_instrument_kind() == metrics_api::InstrumentKind::UpDownCounter)
+    {
+      EXPECT_EQ(aggregator->get_checkpoint()[0], 100);
+    }
+    else
+    {
+      // Both records of the name_a counter were merged in the same aggregator.
+      EXPECT_EQ(aggregator->get_checkpoint()[0], 2);
+      ++name_a_counter;
+    }
+  }
+  EXPECT_EQ(name_a_counter, 1);
+}
 #endif
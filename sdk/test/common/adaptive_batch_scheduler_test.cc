@@ -0,0 +1,74 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/adaptive_batch_scheduler.h"
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::AdaptiveBatchScheduler;
+
+namespace
+{
+const size_t kMinBatchSize = 64;
+const size_t kMaxBatchSize = 512;
+const std::chrono::milliseconds kMinDelay(100);
+const std::chrono::milliseconds kMaxDelay(5000);
+}  // namespace
+
+TEST(AdaptiveBatchSchedulerTest, StartsAtUpperBounds)
+{
+  AdaptiveBatchScheduler scheduler{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  EXPECT_EQ(scheduler.batch_size(), kMaxBatchSize);
+  EXPECT_EQ(scheduler.schedule_delay(), kMaxDelay);
+}
+
+TEST(AdaptiveBatchSchedulerTest, QuietTrafficUsesSmallBatchesAndLongDelays)
+{
+  AdaptiveBatchScheduler scheduler{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  // 5 spans per second
+  for (int i = 0; i < 10; ++i)
+  {
+    scheduler.Update(25, std::chrono::seconds(5), std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(scheduler.batch_size(), kMinBatchSize);
+  EXPECT_EQ(scheduler.schedule_delay(), kMaxDelay);
+}
+
+TEST(AdaptiveBatchSchedulerTest, SpikesUseLargeBatchesAndShortDelays)
+{
+  AdaptiveBatchScheduler scheduler{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  // 100000 spans per second
+  for (int i = 0; i < 10; ++i)
+  {
+    scheduler.Update(10000, std::chrono::milliseconds(100), std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(scheduler.batch_size(), kMaxBatchSize);
+  EXPECT_EQ(scheduler.schedule_delay(), kMinDelay);
+}
+
+TEST(AdaptiveBatchSchedulerTest, DelayTracksBatchFillTime)
+{
+  AdaptiveBatchScheduler scheduler{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  // 512 spans per second fill a maximal batch in one second
+  scheduler.Update(512, std::chrono::seconds(1), std::chrono::milliseconds(0));
+  EXPECT_EQ(scheduler.schedule_delay(), std::chrono::milliseconds(1000));
+}
+
+TEST(AdaptiveBatchSchedulerTest, SlowExporterGrowsBatches)
+{
+  AdaptiveBatchScheduler fast{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  AdaptiveBatchScheduler slow{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  // 50 spans per second
+  fast.Update(50, std::chrono::seconds(1), std::chrono::milliseconds(1));
+  slow.Update(50, std::chrono::seconds(1), std::chrono::milliseconds(1000));
+  EXPECT_GT(slow.batch_size(), fast.batch_size());
+  EXPECT_LE(slow.batch_size(), kMaxBatchSize);
+}
+
+TEST(AdaptiveBatchSchedulerTest, IgnoresEmptyIntervals)
+{
+  AdaptiveBatchScheduler scheduler{kMinBatchSize, kMaxBatchSize, kMinDelay, kMaxDelay};
+  scheduler.Update(1000, std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+  EXPECT_EQ(scheduler.batch_size(), kMaxBatchSize);
+  EXPECT_EQ(scheduler.schedule_delay(), kMaxDelay);
+}
@@ -0,0 +1,65 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/arena.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+
+using opentelemetry::sdk::common::Arena;
+namespace nostd = opentelemetry::nostd;
+
+TEST(ArenaTest, AllocatesFromInitialBlock)
+{
+  alignas(std::max_align_t) char block[128];
+  Arena arena(block, sizeof(block));
+
+  void *first  = arena.Allocate(10, 1);
+  void *second = arena.Allocate(8, 8);
+  EXPECT_EQ(block, first);
+  EXPECT_EQ(block + 16, second);
+  EXPECT_EQ(0, arena.GetHeapSize());
+
+  // Allocations which do not fit in the initial block are taken from the heap.
+  void *third = arena.Allocate(200);
+  EXPECT_NE(nullptr, third);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(third) % alignof(std::max_align_t));
+  EXPECT_LT(0, arena.GetHeapSize());
+
+  arena.Reset();
+  EXPECT_EQ(0, arena.GetHeapSize());
+  EXPECT_EQ(block, arena.Allocate(1, 1));
+}
+
+TEST(ArenaTest, GrowsOnHeap)
+{
+  Arena arena;
+  EXPECT_EQ(0, arena.GetHeapSize());
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    uint64_t *value = arena.AllocateArray<uint64_t>(1);
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(value) % alignof(uint64_t));
+    *value = i;
+  }
+  EXPECT_GE(arena.GetHeapSize(), 1000 * sizeof(uint64_t));
+}
+
+TEST(ArenaTest, CopiesStringsAndSpans)
+{
+  Arena arena;
+  std::string str = "string";
+  auto str_copy   = arena.CopyString(str);
+  str             = "modified";
+  EXPECT_EQ("string", str_copy);
+  EXPECT_EQ(0, arena.CopyString("").size());
+
+  int32_t values[] = {1, 2, 3};
+  auto values_copy = arena.CopySpan(nostd::span<const int32_t>(values));
+  values[0]        = 4;
+  ASSERT_EQ(3, values_copy.size());
+  EXPECT_EQ(1, values_copy[0]);
+  EXPECT_EQ(3, values_copy[2]);
+}
@@ -0,0 +1,105 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/attribute_key_table.h"
+#include "opentelemetry/sdk/common/semantic_attribute_keys.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using opentelemetry::common::AttributeKey;
+using opentelemetry::sdk::common::AttributeKeyTable;
+
+TEST(AttributeKeyTableTest, Intern)
+{
+  AttributeKeyTable table;
+  EXPECT_EQ(AttributeKeyTable::kInvalidKeyId, table.Find("http.method"));
+
+  std::string key = "http.method";
+  auto id         = table.Intern(key);
+  key             = "modified";
+  EXPECT_NE(AttributeKeyTable::kInvalidKeyId, id);
+  EXPECT_EQ(id, table.Intern("http.method"));
+  EXPECT_EQ(id, table.Find("http.method"));
+  EXPECT_EQ("http.method", table.GetKey(id));
+
+  auto other_id = table.Intern("net.peer.name");
+  EXPECT_NE(id, other_id);
+  EXPECT_EQ("net.peer.name", table.GetKey(other_id));
+  EXPECT_EQ(2, table.size());
+}
+
+TEST(AttributeKeyTableTest, Full)
+{
+  AttributeKeyTable table;
+  for (size_t i = 0; i < AttributeKeyTable::kMaxKeys; ++i)
+  {
+    ASSERT_EQ(i, table.Intern("key" + std::to_string(i)));
+  }
+  EXPECT_EQ(AttributeKeyTable::kInvalidKeyId, table.Intern("one more key"));
+  EXPECT_EQ(0, table.Intern("key0"));
+  EXPECT_EQ("key1025", table.GetKey(1025));
+}
+
+TEST(AttributeKeyTableTest, ConcurrentIntern)
+{
+  AttributeKeyTable table;
+  const int kNumThreads = 4;
+  const int kNumKeys    = 2000;
+  std::vector<std::vector<AttributeKeyTable::KeyId>> ids(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&table, &ids, t] {
+      for (int i = 0; i < kNumKeys; ++i)
+      {
+        ids[t].push_back(table.Intern("key" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(kNumKeys, table.size());
+  for (int i = 0; i < kNumKeys; ++i)
+  {
+    for (int t = 1; t < kNumThreads; ++t)
+    {
+      ASSERT_EQ(ids[0][i], ids[t][i]);
+    }
+    ASSERT_EQ("key" + std::to_string(i), table.GetKey(ids[0][i]));
+  }
+}
+
+TEST(AttributeKeyTableTest, InitialKeys)
+{
+  constexpr AttributeKey kKeys[] = {AttributeKey("http.method", 0), AttributeKey("http.route", 1)};
+  AttributeKeyTable table(kKeys);
+  EXPECT_EQ(2, table.size());
+  EXPECT_EQ(0, table.Intern(kKeys[0]));
+  EXPECT_EQ(1, table.Intern(kKeys[1]));
+  EXPECT_EQ(1, table.Find("http.route"));
+  EXPECT_EQ("http.method", table.GetKey(0));
+
+  // Keys without an id, or with the id of another table, are looked up by name.
+  EXPECT_EQ(0, table.Intern(AttributeKey("http.method")));
+  EXPECT_EQ(2, table.Intern(AttributeKey("net.peer.name", 5)));
+  EXPECT_EQ(2, table.Intern(AttributeKey("net.peer.name")));
+}
+
+TEST(AttributeKeyTableTest, SemanticAttributeKeys)
+{
+  auto &table = AttributeKeyTable::GetInstance();
+  for (const auto &key : opentelemetry::sdk::common::kSemanticAttributeKeys)
+  {
+    ASSERT_EQ(key.id(), table.Find(key.name()));
+    ASSERT_EQ(key.name(), table.GetKey(key.id()));
+  }
+  EXPECT_EQ(opentelemetry::trace::attribute_keys::kHttpMethod.id(), table.Find("http.method"));
+  EXPECT_EQ(opentelemetry::sdk::resource::attribute_keys::kServiceName.id(),
+            table.Intern(opentelemetry::sdk::resource::attribute_keys::kServiceName));
+}
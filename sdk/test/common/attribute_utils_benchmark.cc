@@ -0,0 +1,68 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include "opentelemetry/sdk/common/attribute_utils.h"
+
+#include <vector>
+
+using namespace opentelemetry::sdk::common;
+using opentelemetry::common::AttributeValue;
+namespace
+{
+// The attribute values of a typical span: mostly scalars and strings.
+std::vector<AttributeValue> ScalarValues()
+{
+  return {true,
+          int32_t{200},
+          int64_t{1234567890},
+          3.25,
+          "GET",
+          opentelemetry::nostd::string_view("/api/v1/users/{id}/orders")};
+}
+
+void BM_AttributeConverterVisit(benchmark::State &state)
+{
+  auto values = ScalarValues();
+  AttributeConverter converter;
+  while (state.KeepRunning())
+  {
+    for (auto &value : values)
+    {
+      benchmark::DoNotOptimize(opentelemetry::nostd::visit(converter, value));
+    }
+  }
+}
+BENCHMARK(BM_AttributeConverterVisit);
+
+void BM_ConvertAttributeValue(benchmark::State &state)
+{
+  auto values = ScalarValues();
+  while (state.KeepRunning())
+  {
+    for (auto &value : values)
+    {
+      benchmark::DoNotOptimize(ConvertAttributeValue(value));
+    }
+  }
+}
+BENCHMARK(BM_ConvertAttributeValue);
+
+template <class Map>
+void BM_SetAttribute(benchmark::State &state)
+{
+  auto values        = ScalarValues();
+  const char *keys[] = {"k1", "k2", "k3", "k4", "k5", "k6"};
+  Map map;
+  while (state.KeepRunning())
+  {
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      map.SetAttribute(keys[i], values[i]);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_SetAttribute, AttributeMap);
+BENCHMARK_TEMPLATE(BM_SetAttribute, FlatOrderedAttributeMap);
+}  // namespace
+BENCHMARK_MAIN();
@@ -51,3 +51,123 @@ TEST(OrderedAttributeMapTest, AttributesConstruction)
     EXPECT_EQ(opentelemetry::nostd::get<int>(attribute_map.GetAttributes().at(keys[i])), values[i]);
   }
 }
+
+TEST(FlatAttributeMapTest, AttributesConstruction)
+{
+  const int kNumAttributes              = 3;
+  std::string keys[kNumAttributes]      = {"attr1", "attr2", "attr3"};
+  int values[kNumAttributes]            = {15, 24, 37};
+  std::map<std::string, int> attributes = {
+      {keys[0], values[0]}, {keys[1], values[1]}, {keys[2], values[2]}};
+
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, int>> iterable(attributes);
+  opentelemetry::sdk::common::FlatAttributeMap attribute_map(iterable);
+
+  ASSERT_EQ(attribute_map.size(), kNumAttributes);
+  for (int i = 0; i < kNumAttributes; i++)
+  {
+    EXPECT_EQ(opentelemetry::nostd::get<int>(attribute_map.at(keys[i])), values[i]);
+  }
+  EXPECT_EQ(attribute_map.find("attr4"), attribute_map.end());
+}
+
+TEST(FlatAttributeMapTest, SetAttributeReplaces)
+{
+  opentelemetry::sdk::common::FlatAttributeMap attribute_map;
+  attribute_map.SetAttribute("attr1", 1);
+  attribute_map.SetAttribute("attr2", 2);
+  attribute_map.SetAttribute("attr1", "replaced");
+
+  ASSERT_EQ(attribute_map.size(), 2);
+  EXPECT_EQ(attribute_map[0].first, "attr1");
+  EXPECT_EQ(opentelemetry::nostd::get<std::string>(attribute_map.at("attr1")), "replaced");
+  EXPECT_EQ(opentelemetry::nostd::get<int32_t>(attribute_map.at("attr2")), 2);
+}
+
+TEST(FlatOrderedAttributeMapTest, SortedByKey)
+{
+  std::map<std::string, int> attributes = {{"attr3", 3}, {"attr1", 1}, {"attr2", 2}};
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, int>> iterable(attributes);
+  opentelemetry::sdk::common::FlatOrderedAttributeMap attribute_map(iterable);
+  attribute_map.SetAttribute("attr0", "first");
+  attribute_map.SetAttribute("attr2", 20);
+
+  opentelemetry::sdk::common::OrderedAttributeMap ordered_map(iterable);
+  ordered_map.SetAttribute("attr0", "first");
+  ordered_map.SetAttribute("attr2", 20);
+
+  ASSERT_EQ(attribute_map.size(), ordered_map.size());
+  auto it = attribute_map.begin();
+  for (auto &kv : ordered_map)
+  {
+    EXPECT_EQ(it->first, kv.first);
+    EXPECT_EQ(it->second, kv.second);
+    ++it;
+  }
+  EXPECT_EQ(opentelemetry::nostd::get<int32_t>(attribute_map.at("attr2")), 20);
+  EXPECT_EQ(attribute_map.count("attr4"), 0);
+  EXPECT_EQ(attribute_map.find("attr4"), attribute_map.end());
+}
+
+TEST(FlatOrderedAttributeMapTest, MapOperations)
+{
+  opentelemetry::sdk::common::FlatOrderedAttributeMap attribute_map = {{"b", 2}, {"a", 1}};
+  EXPECT_FALSE(attribute_map.insert({"a", int32_t(10)}).second);
+  EXPECT_TRUE(attribute_map.insert({"c", int32_t(3)}).second);
+  attribute_map["d"] = true;
+  EXPECT_EQ(attribute_map.erase("b"), 1);
+  EXPECT_EQ(attribute_map.erase("b"), 0);
+
+  opentelemetry::sdk::common::FlatOrderedAttributeMap expected = {
+      {"a", 1}, {"c", 3}, {"d", true}};
+  EXPECT_EQ(attribute_map, expected);
+  attribute_map.clear();
+  EXPECT_TRUE(attribute_map.empty());
+  EXPECT_NE(attribute_map, expected);
+}
+
+TEST(FlatOrderedAttributeMapTest, FindInLargeMap)
+{
+  opentelemetry::sdk::common::FlatOrderedAttributeMap attribute_map;
+  for (int i = 0; i < 40; i++)
+  {
+    attribute_map.SetAttribute("attr" + std::to_string(i), i);
+  }
+  ASSERT_EQ(attribute_map.size(), 40);
+  for (int i = 0; i < 40; i++)
+  {
+    auto it = attribute_map.find("attr" + std::to_string(i));
+    ASSERT_NE(it, attribute_map.end());
+    EXPECT_EQ(opentelemetry::nostd::get<int32_t>(it->second), i);
+  }
+  EXPECT_EQ(attribute_map.find("attr40"), attribute_map.end());
+}
+
+TEST(AttributeConverterTest, ConvertAttributeValue)
+{
+  namespace nostd = opentelemetry::nostd;
+  using opentelemetry::common::AttributeValue;
+  using opentelemetry::sdk::common::AttributeConverter;
+  using opentelemetry::sdk::common::ConvertAttributeValue;
+
+  const int64_t ints[]               = {1, 2};
+  const nostd::string_view strings[] = {"a", "b"};
+  std::vector<AttributeValue> values = {true,
+                                        int32_t{-1},
+                                        int64_t{-2},
+                                        uint32_t{3},
+                                        4.5,
+                                        "c string",
+                                        nostd::string_view("string view"),
+                                        nostd::span<const int64_t>(ints),
+                                        nostd::span<const nostd::string_view>(strings),
+                                        uint64_t{6}};
+  AttributeConverter converter;
+  for (auto &value : values)
+  {
+    // The fast path gives the same owned value as the visitor
+    EXPECT_EQ(ConvertAttributeValue(value), nostd::visit(converter, value));
+  }
+  EXPECT_EQ(nostd::get<std::string>(ConvertAttributeValue(values[5])), "c string");
+  EXPECT_EQ(nostd::get<std::string>(ConvertAttributeValue(values[6])), "string view");
+}
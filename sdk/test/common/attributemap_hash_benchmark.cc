@@ -4,19 +4,112 @@
 #include <benchmark/benchmark.h>
 #include "opentelemetry/sdk/common/attributemap_hash.h"
 
+#include <map>
+#include <string>
+
 using namespace opentelemetry::sdk::common;
 namespace
 {
+template <class Map>
 void BM_AttributeMapHash(benchmark::State &state)
 {
-  OrderedAttributeMap map1 = {{"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"},  {"k4", "v4"},
-                              {"k5", true}, {"k6", 12},   {"k7", 12.209}};
+  Map map1 = {{"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"},   {"k4", "v4"},
+              {"k5", true}, {"k6", 12},   {"k7", 12.209}};
   while (state.KeepRunning())
   {
     benchmark::DoNotOptimize(GetHashForAttributeMap(map1));
   }
 }
-BENCHMARK(BM_AttributeMapHash);
+BENCHMARK_TEMPLATE(BM_AttributeMapHash, OrderedAttributeMap);
+BENCHMARK_TEMPLATE(BM_AttributeMapHash, FlatOrderedAttributeMap);
+
+// Attributes of a typical HTTP server metric, with keys and values longer than a word.
+void BM_AttributeMapHashHttpAttributes(benchmark::State &state)
+{
+  OrderedAttributeMap map1 = {{"http.method", "GET"},
+                              {"http.status_code", 200},
+                              {"http.route", "/api/v1/users/{id}/orders"},
+                              {"net.peer.name", "frontend.example.com"},
+                              {"service.namespace", "checkout"}};
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(GetHashForAttributeMap(map1));
+  }
+}
+BENCHMARK(BM_AttributeMapHashHttpAttributes);
+
+void BM_KeyValueIterableHash(benchmark::State &state)
+{
+  std::map<std::string, std::string> attributes = {
+      {"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"}, {"k4", "v4"}};
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, std::string>> iterable(
+      attributes);
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(
+        GetHashForAttributeMap(iterable, [](opentelemetry::nostd::string_view) { return true; }));
+  }
+}
+BENCHMARK(BM_KeyValueIterableHash);
+
+// Builds a map of state.range(0) attributes, as a span or a metric measurement does.
+template <class Map>
+void BM_AttributeMapBuild(benchmark::State &state)
+{
+  std::map<std::string, int64_t> attributes;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    attributes["attribute.key" + std::to_string(i)] = i;
+  }
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, int64_t>> iterable(
+      attributes);
+  while (state.KeepRunning())
+  {
+    Map map(iterable);
+    benchmark::DoNotOptimize(map);
+  }
+}
+BENCHMARK_TEMPLATE(BM_AttributeMapBuild, AttributeMap)->Arg(5)->Arg(15);
+BENCHMARK_TEMPLATE(BM_AttributeMapBuild, OrderedAttributeMap)->Arg(5)->Arg(15);
+BENCHMARK_TEMPLATE(BM_AttributeMapBuild, FlatOrderedAttributeMap)->Arg(5)->Arg(15);
+
+// Looks up every key of a map of state.range(0) attributes.
+template <class Map>
+void BM_AttributeMapFind(benchmark::State &state)
+{
+  Map map;
+  std::vector<std::string> keys;
+  for (int64_t i = 0; i < state.range(0); ++i)
+  {
+    keys.push_back("attribute.key" + std::to_string(i));
+    map.SetAttribute(keys.back(), i);
+  }
+  while (state.KeepRunning())
+  {
+    for (auto &key : keys)
+    {
+      benchmark::DoNotOptimize(map.find(key));
+    }
+  }
+}
+BENCHMARK_TEMPLATE(BM_AttributeMapFind, AttributeMap)->Arg(5)->Arg(15);
+BENCHMARK_TEMPLATE(BM_AttributeMapFind, OrderedAttributeMap)->Arg(5)->Arg(15);
+BENCHMARK_TEMPLATE(BM_AttributeMapFind, FlatOrderedAttributeMap)->Arg(5)->Arg(15);
+
+// Compares two equal maps, as the metric storage does to find the series of a measurement.
+template <class Map>
+void BM_AttributeMapEquals(benchmark::State &state)
+{
+  Map map1 = {{"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"},   {"k4", "v4"},
+              {"k5", true}, {"k6", 12},   {"k7", 12.209}};
+  Map map2 = map1;
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(map1 == map2);
+  }
+}
+BENCHMARK_TEMPLATE(BM_AttributeMapEquals, OrderedAttributeMap);
+BENCHMARK_TEMPLATE(BM_AttributeMapEquals, FlatOrderedAttributeMap);
 
 }  // namespace
 BENCHMARK_MAIN();
@@ -4,6 +4,9 @@
 #include "opentelemetry/sdk/common/attributemap_hash.h"
 #include <gtest/gtest.h>
 
+#include <map>
+#include <string>
+
 using namespace opentelemetry::sdk::common;
 TEST(AttributeMapHashTest, BasicTests)
 {
@@ -29,4 +32,56 @@ TEST(AttributeMapHashTest, BasicTests)
     OrderedAttributeMap map1 = {};
     EXPECT_TRUE(GetHashForAttributeMap(map1) == 0);
   }
-}
\ No newline at end of file
+}
+
+TEST(AttributeMapHashTest, KeyValueIterable)
+{
+  using opentelemetry::common::KeyValueIterableView;
+  auto all_keys = [](opentelemetry::nostd::string_view) { return true; };
+
+  std::map<std::string, std::string> unordered = {{"k3", "v3"}, {"k1", "v1"}, {"k2", "v2"}};
+  KeyValueIterableView<std::map<std::string, std::string>> iterable(unordered);
+  OrderedAttributeMap map1 = {{"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"}};
+  EXPECT_EQ(GetHashForAttributeMap(iterable, all_keys), GetHashForAttributeMap(map1));
+  EXPECT_TRUE(AttributeMapEquals(map1, iterable, all_keys));
+
+  // Filtered keys take no part in the hash or the comparison.
+  auto no_k3 = [](opentelemetry::nostd::string_view key) { return key != "k3"; };
+  OrderedAttributeMap map2 = {{"k1", "v1"}, {"k2", "v2"}};
+  EXPECT_EQ(GetHashForAttributeMap(iterable, no_k3), GetHashForAttributeMap(map2));
+  EXPECT_TRUE(AttributeMapEquals(map2, iterable, no_k3));
+  EXPECT_FALSE(AttributeMapEquals(map1, iterable, no_k3));
+  EXPECT_FALSE(AttributeMapEquals(map2, iterable, all_keys));
+
+  // Values must match in type as well as in content.
+  std::map<std::string, int64_t> numbers = {{"k1", 10}};
+  KeyValueIterableView<std::map<std::string, int64_t>> number_iterable(numbers);
+  OrderedAttributeMap map3 = {{"k1", static_cast<int64_t>(10)}};
+  OrderedAttributeMap map4 = {{"k1", 10}};
+  EXPECT_EQ(GetHashForAttributeMap(number_iterable, all_keys), GetHashForAttributeMap(map3));
+  EXPECT_TRUE(AttributeMapEquals(map3, number_iterable, all_keys));
+  EXPECT_FALSE(AttributeMapEquals(map4, number_iterable, all_keys));
+}
+
+TEST(AttributeMapHashTest, RawBytes)
+{
+  // Strings are hashed a word at a time, including their trailing bytes.
+  OrderedAttributeMap map1 = {{"key", "a string longer than one word"}};
+  OrderedAttributeMap map2 = {{"key", "a string longer than one word!"}};
+  OrderedAttributeMap map3 = {{"key", "a string longer than one worD"}};
+  EXPECT_NE(GetHashForAttributeMap(map1), GetHashForAttributeMap(map2));
+  EXPECT_NE(GetHashForAttributeMap(map1), GetHashForAttributeMap(map3));
+
+  // The elements of string arrays are not simply concatenated.
+  std::vector<opentelemetry::nostd::string_view> split1 = {"ab", "c"};
+  std::vector<opentelemetry::nostd::string_view> split2 = {"a", "bc"};
+  OrderedAttributeMap map4 = {{"key", split1}};
+  OrderedAttributeMap map5 = {{"key", split2}};
+  EXPECT_NE(GetHashForAttributeMap(map4), GetHashForAttributeMap(map5));
+
+  // Equal values hash alike.
+  OrderedAttributeMap zero     = {{"key", 0.0}};
+  OrderedAttributeMap neg_zero = {{"key", -0.0}};
+  EXPECT_EQ(zero, neg_zero);
+  EXPECT_EQ(GetHashForAttributeMap(zero), GetHashForAttributeMap(neg_zero));
+}
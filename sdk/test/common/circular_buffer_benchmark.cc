@@ -12,10 +12,12 @@
 #include <vector>
 
 #include "opentelemetry/sdk/common/circular_buffer.h"
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
 #include "test/common/baseline_circular_buffer.h"
 using opentelemetry::sdk::common::AtomicUniquePtr;
 using opentelemetry::sdk::common::CircularBuffer;
 using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::ShardedCircularBuffer;
 using opentelemetry::testing::BaselineCircularBuffer;
 
 const int N = 10000;
@@ -44,6 +46,20 @@ static uint64_t ConsumeBufferNumbers(CircularBuffer<uint64_t> &buffer) noexcept
   return result;
 }
 
+static uint64_t ConsumeBufferNumbers(ShardedCircularBuffer<uint64_t> &buffer) noexcept
+{
+  uint64_t result = 0;
+  buffer.Consume(buffer.size(),
+                 [&](CircularBufferRange<AtomicUniquePtr<uint64_t>> &range) noexcept {
+                   range.ForEach([&](AtomicUniquePtr<uint64_t> &ptr) noexcept {
+                     result += *ptr;
+                     ptr.Reset();
+                     return true;
+                   });
+                 });
+  return result;
+}
+
 template <class Buffer>
 static void GenerateNumbersForThread(Buffer &buffer, int n, std::atomic<uint64_t> &sum) noexcept
 {
@@ -128,6 +144,97 @@ static void BM_LockFreeBuffer(benchmark::State &state)
   }
 }
 
-BENCHMARK(BM_LockFreeBuffer)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK(BM_LockFreeBuffer)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+static void BM_ShardedLockFreeBuffer(benchmark::State &state)
+{
+  const size_t max_elements = 500;
+  const int num_threads     = static_cast<int>(state.range(0));
+  const size_t num_shards   = static_cast<size_t>(state.range(1));
+  const int n               = static_cast<int>(N / num_threads);
+  ShardedCircularBuffer<uint64_t> buffer{max_elements, num_shards};
+  for (auto _ : state)
+  {
+    RunSimulation(buffer, num_threads, n);
+  }
+}
+
+// Arguments are {producer threads, shards}.
+BENCHMARK(BM_ShardedLockFreeBuffer)
+    ->Args({1, 1})
+    ->Args({2, 2})
+    ->Args({4, 2})
+    ->Args({4, 4})
+    ->Args({8, 4})
+    ->Args({8, 8})
+    ->Args({16, 8})
+    ->Args({16, 16});
+
+// Refills the buffer with the elements of a batch, so that the consume benchmarks below do not
+// measure allocations.
+static void RefillBuffer(CircularBuffer<uint64_t> &buffer,
+                         std::vector<std::unique_ptr<uint64_t>> &batch) noexcept
+{
+  for (auto &element : batch)
+  {
+    buffer.Add(element);
+  }
+  batch.clear();
+}
+
+// Consume a batch the way the batch processors used to: swapping each element out of its slot
+// into a new vector.
+static void BM_ConsumeBatchBySwap(benchmark::State &state)
+{
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  CircularBuffer<uint64_t> buffer{batch_size};
+  std::vector<std::unique_ptr<uint64_t>> batch;
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    batch.emplace_back(new uint64_t{i});
+  }
+  for (auto _ : state)
+  {
+    RefillBuffer(buffer, batch);
+    std::vector<std::unique_ptr<uint64_t>> consumed;
+    buffer.Consume(buffer.size(),
+                   [&](CircularBufferRange<AtomicUniquePtr<uint64_t>> range) noexcept {
+                     range.ForEach([&](AtomicUniquePtr<uint64_t> &ptr) noexcept {
+                       std::unique_ptr<uint64_t> swap_ptr;
+                       ptr.Swap(swap_ptr);
+                       consumed.push_back(std::move(swap_ptr));
+                       return true;
+                     });
+                   });
+    benchmark::DoNotOptimize(consumed.data());
+    batch.swap(consumed);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_ConsumeBatchBySwap)->Arg(64)->Arg(512)->Arg(2048);
+
+// Consume a batch with ConsumeInto, into a reused vector.
+static void BM_ConsumeBatchInto(benchmark::State &state)
+{
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  CircularBuffer<uint64_t> buffer{batch_size};
+  std::vector<std::unique_ptr<uint64_t>> batch;
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    batch.emplace_back(new uint64_t{i});
+  }
+  std::vector<std::unique_ptr<uint64_t>> consumed;
+  for (auto _ : state)
+  {
+    RefillBuffer(buffer, batch);
+    buffer.ConsumeInto(buffer.size(), consumed);
+    benchmark::DoNotOptimize(consumed.data());
+    batch.swap(consumed);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_ConsumeBatchInto)->Arg(64)->Arg(512)->Arg(2048);
 
 BENCHMARK_MAIN();
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 using opentelemetry::sdk::common::AtomicUniquePtr;
@@ -116,6 +117,37 @@ TEST(CircularBufferTest, AddOnFull)
   EXPECT_EQ(*x, 33);
 }
 
+TEST(CircularBufferTest, AddBatch)
+{
+  CircularBuffer<int> buffer{10};
+  std::vector<std::unique_ptr<int>> batch;
+  for (int i = 0; i < 6; ++i)
+  {
+    batch.emplace_back(new int{i});
+  }
+  EXPECT_EQ(buffer.AddBatch(batch), 6);
+  EXPECT_EQ(buffer.size(), 6);
+
+  // Only the first 4 elements fit.
+  for (int i = 0; i < 6; ++i)
+  {
+    batch[i].reset(new int{10 + i});
+  }
+  EXPECT_EQ(buffer.AddBatch(batch), 4);
+  EXPECT_EQ(batch[3], nullptr);
+  ASSERT_NE(batch[4], nullptr);
+  EXPECT_EQ(*batch[4], 14);
+
+  std::vector<std::unique_ptr<int>> out;
+  EXPECT_EQ(buffer.ConsumeInto(buffer.size(), out), 10);
+  std::vector<int> values;
+  for (auto &value : out)
+  {
+    values.push_back(*value);
+  }
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4, 5, 10, 11, 12, 13}));
+}
+
 TEST(CircularBufferTest, Consume)
 {
   CircularBuffer<int> buffer{10};
@@ -135,6 +167,41 @@ TEST(CircularBufferTest, Consume)
   EXPECT_EQ(count, 5);
 }
 
+TEST(CircularBufferTest, ConsumeInto)
+{
+  CircularBuffer<int> buffer{10};
+  // Start near the end of the storage, so that the consumed elements wrap around.
+  for (int i = 0; i < 8; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  buffer.Consume(8);
+  for (int i = 0; i < static_cast<int>(buffer.max_size()); ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+
+  std::vector<std::unique_ptr<int>> out;
+  EXPECT_EQ(buffer.ConsumeInto(6, out), 6);
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_EQ(buffer.ConsumeInto(6, out), 4);
+  EXPECT_TRUE(buffer.empty());
+  ASSERT_EQ(out.size(), 10);
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(*out[i], i);
+  }
+
+  // The consumed slots are free again.
+  for (int i = 0; i < static_cast<int>(buffer.max_size()); ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+}
+
 TEST(CircularBufferTest, Simulation)
 {
   const int num_producer_threads = 4;
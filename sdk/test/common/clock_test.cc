@@ -0,0 +1,56 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/clock.h"
+
+#include <gtest/gtest.h>
+
+using opentelemetry::sdk::common::Clock;
+using opentelemetry::sdk::common::CoarseClock;
+using opentelemetry::sdk::common::PreciseClock;
+
+namespace
+{
+void ExpectConsistentWithChrono(Clock &clock)
+{
+  // Coarse clocks may lag the precise ones by up to a tick.
+  const auto tolerance = std::chrono::milliseconds(100);
+
+  auto system_before = std::chrono::system_clock::now().time_since_epoch();
+  auto steady_before = std::chrono::steady_clock::now().time_since_epoch();
+  auto system        = clock.SystemNow().time_since_epoch();
+  auto steady        = clock.SteadyNow().time_since_epoch();
+  auto system_after  = std::chrono::system_clock::now().time_since_epoch();
+  auto steady_after  = std::chrono::steady_clock::now().time_since_epoch();
+
+  EXPECT_GE(system, system_before - tolerance);
+  EXPECT_LE(system, system_after);
+  EXPECT_GE(steady, steady_before - tolerance);
+  EXPECT_LE(steady, steady_after);
+}
+
+void ExpectMonotonic(Clock &clock)
+{
+  auto previous = clock.SteadyNow().time_since_epoch();
+  for (int i = 0; i < 1000; ++i)
+  {
+    auto now = clock.SteadyNow().time_since_epoch();
+    EXPECT_GE(now, previous);
+    previous = now;
+  }
+}
+}  // namespace
+
+TEST(ClockTest, PreciseClock)
+{
+  PreciseClock clock;
+  ExpectConsistentWithChrono(clock);
+  ExpectMonotonic(clock);
+}
+
+TEST(ClockTest, CoarseClock)
+{
+  CoarseClock clock;
+  ExpectConsistentWithChrono(clock);
+  ExpectMonotonic(clock);
+}
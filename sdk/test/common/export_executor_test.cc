@@ -0,0 +1,147 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/export_executor.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using opentelemetry::sdk::common::ExportExecutor;
+
+namespace
+{
+// Polls `condition` until it holds or a generous timeout expires.
+template <class Condition>
+bool WaitUntil(Condition condition)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+TEST(ExportExecutor, RunsTasksPeriodically)
+{
+  ExportExecutor executor(2);
+  std::atomic<int> first_runs{0};
+  std::atomic<int> second_runs{0};
+  auto first = executor.AddTask(
+      [&first_runs]() -> std::chrono::microseconds {
+        ++first_runs;
+        return std::chrono::microseconds(1000);
+      },
+      std::chrono::microseconds::zero());
+  auto second = executor.AddTask(
+      [&second_runs]() -> std::chrono::microseconds {
+        ++second_runs;
+        return std::chrono::microseconds(2000);
+      },
+      std::chrono::microseconds(1000));
+
+  EXPECT_TRUE(WaitUntil([&] { return first_runs >= 5 && second_runs >= 3; }));
+  executor.SuspendTask(first);
+  executor.SuspendTask(second);
+  EXPECT_EQ(2u, executor.GetThreadCount());
+}
+
+TEST(ExportExecutor, WakeUp)
+{
+  ExportExecutor executor;
+  std::atomic<int> runs{0};
+  auto task = executor.AddTask(
+      [&runs]() -> std::chrono::microseconds {
+        ++runs;
+        return ExportExecutor::kWhenWokenUp;
+      },
+      std::chrono::hours(1));
+
+  executor.WakeUp(task);
+  EXPECT_TRUE(WaitUntil([&] { return runs == 1; }));
+  executor.WakeUp(task);
+  EXPECT_TRUE(WaitUntil([&] { return runs == 2; }));
+  executor.SuspendTask(task);
+}
+
+TEST(ExportExecutor, NeverRunsATaskConcurrently)
+{
+  ExportExecutor executor(4);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::atomic<int> runs{0};
+  auto task = executor.AddTask(
+      [&]() -> std::chrono::microseconds {
+        int now_running = ++running;
+        if (now_running > max_running)
+        {
+          max_running = now_running;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        --running;
+        ++runs;
+        return ExportExecutor::kWhenWokenUp;
+      },
+      ExportExecutor::kWhenWokenUp);
+
+  // Wakes the task up before, while and after it runs.
+  std::atomic<bool> stop{false};
+  std::thread waker([&] {
+    while (runs < 20 && !stop)
+    {
+      executor.WakeUp(task);
+    }
+  });
+  EXPECT_TRUE(WaitUntil([&] { return runs >= 20; }));
+  stop = true;
+  waker.join();
+  executor.SuspendTask(task);
+  EXPECT_EQ(1, max_running.load());
+}
+
+TEST(ExportExecutor, SuspendAndResume)
+{
+  ExportExecutor executor(2);
+  std::atomic<bool> is_running{false};
+  std::atomic<bool> release{false};
+  std::atomic<int> runs{0};
+  auto task = executor.AddTask(
+      [&]() -> std::chrono::microseconds {
+        is_running = true;
+        while (!release)
+        {
+          std::this_thread::yield();
+        }
+        is_running = false;
+        ++runs;
+        return std::chrono::microseconds::zero();
+      },
+      std::chrono::microseconds::zero());
+
+  ASSERT_TRUE(WaitUntil([&] { return is_running.load(); }));
+  std::thread releaser([&release] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    release = true;
+  });
+  // Waits for the current run to return.
+  executor.SuspendTask(task);
+  EXPECT_FALSE(is_running);
+  int suspended_runs = runs;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(suspended_runs, runs);
+  executor.WakeUp(task);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(suspended_runs, runs);
+
+  executor.ResumeTask(task, std::chrono::microseconds::zero());
+  EXPECT_TRUE(WaitUntil([&] { return runs > suspended_runs; }));
+  executor.SuspendTask(task);
+  releaser.join();
+}
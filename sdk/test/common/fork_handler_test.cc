@@ -0,0 +1,61 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/fork_handler.h"
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+#ifdef __unix__
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using opentelemetry::sdk::common::ForkHandlerRegistration;
+
+#ifdef __unix__
+TEST(ForkHandlerRegistration, RunsAroundFork)
+{
+  std::string calls;
+  ForkHandlerRegistration first([&calls] { calls += "prepare1 "; },
+                                [&calls] { calls += "parent1 "; },
+                                [&calls] { calls += "child1 "; });
+  ForkHandlerRegistration second([&calls] { calls += "prepare2 "; },
+                                 [&calls] { calls += "parent2 "; },
+                                 [&calls] { calls += "child2 "; });
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    _exit(calls == "prepare2 prepare1 child1 child2 " ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ASSERT_GT(pid, 0);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+  EXPECT_EQ("prepare2 prepare1 parent1 parent2 ", calls);
+}
+
+TEST(ForkHandlerRegistration, Unregister)
+{
+  std::string calls;
+  {
+    ForkHandlerRegistration registration([&calls] { calls += "prepare "; },
+                                         [&calls] { calls += "parent "; },
+                                         [&calls] { calls += "child "; });
+  }
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    _exit(calls.empty() ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ASSERT_GT(pid, 0);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+  EXPECT_TRUE(calls.empty());
+}
+#endif
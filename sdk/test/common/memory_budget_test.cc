@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/memory_budget.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using opentelemetry::sdk::common::MemoryBudget;
+using opentelemetry::sdk::common::MemoryPressure;
+using opentelemetry::sdk::common::MemoryPriority;
+
+TEST(MemoryBudget, RefusesChargesByPriority)
+{
+  MemoryBudget budget(1000);
+
+  EXPECT_TRUE(budget.TryCharge(700, MemoryPriority::kLow));
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+  EXPECT_FALSE(budget.TryCharge(1, MemoryPriority::kLow));
+
+  EXPECT_TRUE(budget.TryCharge(150, MemoryPriority::kNormal));
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kElevated);
+  EXPECT_FALSE(budget.TryCharge(1, MemoryPriority::kNormal));
+
+  EXPECT_TRUE(budget.TryCharge(150, MemoryPriority::kHigh));
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kCritical);
+  EXPECT_FALSE(budget.TryCharge(1, MemoryPriority::kHigh));
+
+  EXPECT_EQ(budget.GetUsage(), 1000u);
+  EXPECT_EQ(budget.GetRefusedCount(), 3u);
+}
+
+TEST(MemoryBudget, ReleaseAndForcedCharge)
+{
+  MemoryBudget budget(100);
+
+  EXPECT_FALSE(budget.TryCharge(101, MemoryPriority::kHigh));
+  budget.Charge(150);
+  EXPECT_EQ(budget.GetUsage(), 150u);
+  EXPECT_FALSE(budget.TryCharge(1, MemoryPriority::kHigh));
+
+  budget.Release(150);
+  EXPECT_EQ(budget.GetUsage(), 0u);
+  EXPECT_EQ(budget.GetPressure(), MemoryPressure::kNone);
+  EXPECT_TRUE(budget.TryCharge(100, MemoryPriority::kHigh));
+}
+
+TEST(MemoryBudget, NotifiesPressureChanges)
+{
+  MemoryBudget budget(100);
+  std::vector<MemoryPressure> notified;
+  size_t id = budget.AddPressureListener(
+      [&notified](MemoryPressure pressure) { notified.push_back(pressure); });
+
+  budget.Charge(50);
+  budget.Charge(30);
+  budget.Charge(10);
+  budget.Charge(5);
+  budget.Release(95);
+  ASSERT_EQ(notified.size(), 3u);
+  EXPECT_EQ(notified[0], MemoryPressure::kElevated);
+  EXPECT_EQ(notified[1], MemoryPressure::kCritical);
+  EXPECT_EQ(notified[2], MemoryPressure::kNone);
+
+  budget.RemovePressureListener(id);
+  budget.Charge(100);
+  EXPECT_EQ(notified.size(), 3u);
+}
+
+TEST(MemoryBudget, ConcurrentChargesStayWithinLimit)
+{
+  MemoryBudget budget(10000);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&budget] {
+      for (int j = 0; j < 10000; ++j)
+      {
+        if (budget.TryCharge(10, MemoryPriority::kHigh))
+        {
+          EXPECT_LE(budget.GetUsage(), budget.GetLimit());
+          if (j % 2 == 0)
+          {
+            budget.Release(10);
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(budget.GetUsage(), budget.GetLimit());
+}
@@ -0,0 +1,33 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/numa.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using opentelemetry::sdk::common::GetCurrentNumaNode;
+using opentelemetry::sdk::common::GetNumaNodeCount;
+
+TEST(Numa, CurrentNodeIsInRange)
+{
+  const size_t node_count = GetNumaNodeCount();
+  EXPECT_GE(node_count, 1);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([node_count]() {
+      // Past the calls served from the cache of the thread.
+      for (int j = 0; j < 1000; ++j)
+      {
+        EXPECT_LT(GetCurrentNumaNode(), node_count);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
@@ -21,6 +21,37 @@ void BM_RandomIdGeneration(benchmark::State &state)
 }
 BENCHMARK(BM_RandomIdGeneration);
 
+void BM_BufferedRandomIdGeneration(benchmark::State &state)
+{
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(Random::GenerateBufferedRandom64());
+  }
+}
+BENCHMARK(BM_BufferedRandomIdGeneration);
+
+void BM_RandomTraceIdGeneration(benchmark::State &state)
+{
+  uint8_t trace_id[16];
+  while (state.KeepRunning())
+  {
+    Random::GenerateRandomBuffer(trace_id);
+    benchmark::DoNotOptimize(trace_id);
+  }
+}
+BENCHMARK(BM_RandomTraceIdGeneration);
+
+void BM_BufferedRandomTraceIdGeneration(benchmark::State &state)
+{
+  uint8_t trace_id[16];
+  while (state.KeepRunning())
+  {
+    Random::GenerateBufferedRandomBuffer(trace_id);
+    benchmark::DoNotOptimize(trace_id);
+  }
+}
+BENCHMARK(BM_BufferedRandomTraceIdGeneration);
+
 void BM_RandomIdStdGeneration(benchmark::State &state)
 {
   std::mt19937_64 generator{0};
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 #include <gtest/gtest.h>
 using opentelemetry::sdk::common::Random;
@@ -33,3 +34,28 @@ TEST(RandomTest, GenerateRandomBuffer)
     EXPECT_FALSE(std::equal(std::begin(buf1), std::end(buf1), std::begin(buf2)));
   }
 }
+
+TEST(RandomTest, GenerateBufferedRandom64)
+{
+  // Spans several refills of the buffer.
+  std::vector<uint64_t> values;
+  for (int i = 0; i < 1000; i++)
+  {
+    values.push_back(Random::GenerateBufferedRandom64());
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(std::unique(values.begin(), values.end()), values.end());
+}
+
+TEST(RandomTest, GenerateBufferedRandomBuffer)
+{
+  for (auto size : {7, 8, 9, 16, 17})
+  {
+    std::vector<uint8_t> buf1(size);
+    std::vector<uint8_t> buf2(size);
+
+    Random::GenerateBufferedRandomBuffer(buf1);
+    Random::GenerateBufferedRandomBuffer(buf2);
+    EXPECT_FALSE(std::equal(std::begin(buf1), std::end(buf1), std::begin(buf2)));
+  }
+}
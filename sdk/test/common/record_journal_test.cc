@@ -0,0 +1,145 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/record_journal.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using opentelemetry::sdk::common::BinaryDecoder;
+using opentelemetry::sdk::common::JournalRecordType;
+using opentelemetry::sdk::common::RecordJournal;
+namespace nostd = opentelemetry::nostd;
+namespace trace = opentelemetry::trace;
+
+#if !defined(_WIN32)
+
+namespace
+{
+class RecordJournalTest : public ::testing::Test
+{
+protected:
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  std::vector<std::pair<JournalRecordType, std::string>> Recover()
+  {
+    std::vector<std::pair<JournalRecordType, std::string>> records;
+    EXPECT_TRUE(RecordJournal::Recover(path_, [&](JournalRecordType type, nostd::string_view data) {
+      records.emplace_back(type, std::string(data.data(), data.size()));
+    }));
+    return records;
+  }
+
+  std::string path_ = "record_journal_test.bin";
+};
+}  // namespace
+
+TEST_F(RecordJournalTest, RecoversTheAppendedRecords)
+{
+  auto journal = RecordJournal::Open(path_, 1024);
+  ASSERT_NE(nullptr, journal);
+  EXPECT_TRUE(journal->Append(JournalRecordType::kSpan, "first"));
+  EXPECT_TRUE(journal->Append(JournalRecordType::kLogRecord, ""));
+  EXPECT_TRUE(journal->Append(JournalRecordType::kOtlpSpan, "third"));
+  EXPECT_FALSE(journal->Append(JournalRecordType::kSpan, std::string(2048, 'x')));
+
+  auto records = Recover();
+  ASSERT_EQ(3, records.size());
+  EXPECT_EQ(JournalRecordType::kSpan, records[0].first);
+  EXPECT_EQ("first", records[0].second);
+  EXPECT_EQ(JournalRecordType::kLogRecord, records[1].first);
+  EXPECT_EQ("", records[1].second);
+  EXPECT_EQ(JournalRecordType::kOtlpSpan, records[2].first);
+  EXPECT_EQ("third", records[2].second);
+}
+
+TEST_F(RecordJournalTest, KeepsTheLatestRecordsOnceFull)
+{
+  auto journal = RecordJournal::Open(path_, 256);
+  ASSERT_NE(nullptr, journal);
+  for (int i = 0; i < 50; ++i)
+  {
+    journal->Append(JournalRecordType::kSpan,
+                    "record " + std::to_string(i) + std::string(i % 7, '.'));
+  }
+
+  // The records left are the latest ones, in order, up to the last one.
+  auto records = Recover();
+  ASSERT_GE(records.size(), 4);
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    int index = static_cast<int>(50 - records.size() + i);
+    EXPECT_EQ("record " + std::to_string(index) + std::string(index % 7, '.'), records[i].second);
+  }
+}
+
+TEST_F(RecordJournalTest, SkipsTornRecords)
+{
+  {
+    auto journal = RecordJournal::Open(path_, 1024);
+    ASSERT_NE(nullptr, journal);
+    journal->Append(JournalRecordType::kSpan, "first");
+    journal->Append(JournalRecordType::kSpan, "second");
+    journal->Append(JournalRecordType::kSpan, "third");
+  }
+  {
+    // Overwrites the payload of the second record, after the 64 bytes file header, the 24 bytes
+    // of the first record and the 16 bytes header of the second.
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(64 + 24 + 16);
+    file.write("XX", 2);
+  }
+
+  auto records = Recover();
+  ASSERT_EQ(2, records.size());
+  EXPECT_EQ("first", records[0].second);
+  EXPECT_EQ("third", records[1].second);
+}
+
+TEST_F(RecordJournalTest, RecoversSpans)
+{
+  opentelemetry::sdk::trace::SpanData span;
+  uint8_t trace_id[trace::TraceId::kSize] = {1};
+  uint8_t span_id[trace::SpanId::kSize]   = {2};
+  span.SetIdentity(trace::SpanContext(trace::TraceId(trace_id), trace::SpanId(span_id),
+                                      trace::TraceFlags(trace::TraceFlags::kIsSampled), false),
+                   trace::SpanId());
+  span.SetName("span");
+  span.SetAttribute("key", "value");
+  span.AddEvent("event");
+  {
+    auto journal = RecordJournal::Open(path_, 1024);
+    ASSERT_NE(nullptr, journal);
+    journal->AppendRecordable(span);
+  }
+
+  auto records = Recover();
+  ASSERT_EQ(1, records.size());
+  ASSERT_EQ(JournalRecordType::kSpan, records[0].first);
+  opentelemetry::sdk::trace::SpanData recovered;
+  BinaryDecoder decoder(records[0].second.data(), records[0].second.size());
+  ASSERT_TRUE(recovered.ReadBinary(decoder));
+  EXPECT_EQ(span.GetSpanContext(), recovered.GetSpanContext());
+  EXPECT_EQ("span", std::string(recovered.GetName()));
+  EXPECT_EQ("value", nostd::get<std::string>(recovered.GetAttributes().at("key")));
+  ASSERT_EQ(1, recovered.GetEvents().size());
+  EXPECT_EQ("event", recovered.GetEvents()[0].GetName());
+}
+
+TEST_F(RecordJournalTest, RejectsOtherFiles)
+{
+  {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    file << "not a journal";
+  }
+  auto ignore = [](JournalRecordType, nostd::string_view) {};
+  EXPECT_FALSE(RecordJournal::Recover(path_, ignore));
+  EXPECT_FALSE(RecordJournal::Recover("no_such_record_journal.bin", ignore));
+}
+
+#endif
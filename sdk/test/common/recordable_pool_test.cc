@@ -0,0 +1,139 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/recordable_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::RecordablePool;
+namespace nostd = opentelemetry::nostd;
+
+namespace
+{
+struct TestRecordable
+{
+  explicit TestRecordable(bool reusable = true) : reusable(reusable) {}
+
+  bool Reset() noexcept
+  {
+    ++reset_count;
+    value = 0;
+    return reusable;
+  }
+
+  bool reusable;
+  int value       = 0;
+  int reset_count = 0;
+};
+
+using Records = std::vector<std::unique_ptr<TestRecordable>>;
+
+void Recycle(RecordablePool<TestRecordable> &pool, Records &records)
+{
+  pool.Recycle(nostd::span<std::unique_ptr<TestRecordable>>(records.data(), records.size()));
+}
+}  // namespace
+
+TEST(RecordablePoolTest, TakeResetRecordables)
+{
+  RecordablePool<TestRecordable> pool{4, 1};
+  EXPECT_EQ(pool.Take(), nullptr);
+
+  Records records;
+  records.emplace_back(new TestRecordable);
+  records.back()->value = 42;
+  TestRecordable *first = records.back().get();
+  Recycle(pool, records);
+  EXPECT_EQ(records[0], nullptr);
+  EXPECT_EQ(pool.size(), 1);
+
+  auto record = pool.Take();
+  EXPECT_EQ(record.get(), first);
+  EXPECT_EQ(record->value, 0);
+  EXPECT_EQ(record->reset_count, 1);
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_EQ(pool.Take(), nullptr);
+}
+
+TEST(RecordablePoolTest, KeepsOnlyReusableRecordables)
+{
+  RecordablePool<TestRecordable> pool{2, 1};
+  Records records;
+  records.emplace_back(nullptr);
+  records.emplace_back(new TestRecordable(false));
+  records.emplace_back(new TestRecordable);
+  records.emplace_back(new TestRecordable);
+  records.emplace_back(new TestRecordable);
+  Recycle(pool, records);
+
+  EXPECT_EQ(pool.size(), 2);
+  // The recordables which cannot be reset, or beyond the size of the pool, are left in place.
+  EXPECT_NE(records[1], nullptr);
+  EXPECT_EQ(records[2], nullptr);
+  EXPECT_EQ(records[3], nullptr);
+  EXPECT_NE(records[4], nullptr);
+}
+
+TEST(RecordablePoolTest, ZeroSizeKeepsNothing)
+{
+  RecordablePool<TestRecordable> pool{0, 4};
+  Records records;
+  records.emplace_back(new TestRecordable);
+  Recycle(pool, records);
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_NE(records[0], nullptr);
+  EXPECT_EQ(pool.Take(), nullptr);
+}
+
+TEST(RecordablePoolTest, TakeFromOtherShards)
+{
+  RecordablePool<TestRecordable> pool{8, 4};
+  Records records;
+  for (int i = 0; i < 8; ++i)
+  {
+    records.emplace_back(new TestRecordable);
+  }
+  Recycle(pool, records);
+  EXPECT_EQ(pool.size(), 8);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_NE(pool.Take(), nullptr);
+  }
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_EQ(pool.Take(), nullptr);
+}
+
+TEST(RecordablePoolTest, ConcurrentTake)
+{
+  const int num_threads = 4;
+  const int num_records = 1000;
+  RecordablePool<TestRecordable> pool{num_records, num_threads};
+  Records records;
+  for (int i = 0; i < num_records; ++i)
+  {
+    records.emplace_back(new TestRecordable);
+  }
+  Recycle(pool, records);
+
+  std::atomic<int> taken{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&] {
+      while (pool.Take() != nullptr)
+      {
+        ++taken;
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(taken.load(), num_records);
+  EXPECT_EQ(pool.size(), 0);
+}
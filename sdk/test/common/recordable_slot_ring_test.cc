@@ -0,0 +1,170 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/recordable_slot_ring.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::RecordableSlotRing;
+namespace nostd = opentelemetry::nostd;
+
+namespace
+{
+struct TestRecordable
+{
+  explicit TestRecordable(bool reusable = true) : reusable(reusable) {}
+
+  bool Reset() noexcept
+  {
+    ++reset_count;
+    value = 0;
+    return reusable;
+  }
+
+  bool reusable;
+  int value       = 0;
+  int reset_count = 0;
+};
+
+using Records = std::vector<std::unique_ptr<TestRecordable>>;
+
+std::unique_ptr<TestRecordable> MakeTestRecordable()
+{
+  return std::unique_ptr<TestRecordable>(new TestRecordable);
+}
+
+void Recycle(RecordableSlotRing<TestRecordable> &ring, Records &records)
+{
+  ring.Recycle(nostd::span<std::unique_ptr<TestRecordable>>(records.data(), records.size()));
+}
+}  // namespace
+
+TEST(RecordableSlotRingTest, PreallocatesRecordables)
+{
+  int made = 0;
+  RecordableSlotRing<TestRecordable> ring{4, [&made] {
+                                            ++made;
+                                            return MakeTestRecordable();
+                                          }};
+  EXPECT_EQ(made, 4);
+  EXPECT_EQ(ring.size(), 4u);
+  EXPECT_EQ(ring.max_size(), 4u);
+
+  Records records;
+  for (int i = 0; i < 4; ++i)
+  {
+    records.push_back(ring.Take());
+    EXPECT_NE(records.back(), nullptr);
+  }
+  EXPECT_EQ(ring.Take(), nullptr);
+  EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(RecordableSlotRingTest, ReusesGivenBackRecordables)
+{
+  RecordableSlotRing<TestRecordable> ring{2, MakeTestRecordable};
+  Records records;
+  records.push_back(ring.Take());
+  records.push_back(ring.Take());
+  std::set<TestRecordable *> preallocated{records[0].get(), records[1].get()};
+  records[0]->value = 42;
+
+  // The ring cycles through the same recordables.
+  for (int round = 0; round < 3; ++round)
+  {
+    Recycle(ring, records);
+    EXPECT_EQ(records[0], nullptr);
+    EXPECT_EQ(records[1], nullptr);
+    EXPECT_EQ(ring.size(), 2u);
+    records[0] = ring.Take();
+    records[1] = ring.Take();
+    EXPECT_EQ(preallocated.count(records[0].get()), 1u);
+    EXPECT_EQ(preallocated.count(records[1].get()), 1u);
+    EXPECT_EQ(records[0]->value, 0);
+  }
+}
+
+TEST(RecordableSlotRingTest, KeepsOnlyReusableRecordables)
+{
+  RecordableSlotRing<TestRecordable> ring{2, MakeTestRecordable};
+  Records taken;
+  taken.push_back(ring.Take());
+  taken.push_back(ring.Take());
+
+  Records records;
+  records.emplace_back(nullptr);
+  records.emplace_back(new TestRecordable(false));
+  records.emplace_back(new TestRecordable);
+  records.emplace_back(new TestRecordable);
+  records.emplace_back(new TestRecordable);
+  Recycle(ring, records);
+
+  EXPECT_EQ(ring.size(), 2u);
+  // The recordables which cannot be reset, or for which there is no free slot, are left in place.
+  EXPECT_NE(records[1], nullptr);
+  EXPECT_EQ(records[2], nullptr);
+  EXPECT_EQ(records[3], nullptr);
+  EXPECT_NE(records[4], nullptr);
+}
+
+TEST(RecordableSlotRingTest, FactoryFailures)
+{
+  int made = 0;
+  RecordableSlotRing<TestRecordable> ring{3, [&made] {
+                                            return ++made == 2 ? nullptr : MakeTestRecordable();
+                                          }};
+  EXPECT_EQ(ring.size(), 2u);
+
+  // The slot left empty is free for a recordable given back.
+  Records records;
+  records.emplace_back(new TestRecordable);
+  Recycle(ring, records);
+  EXPECT_EQ(records[0], nullptr);
+  EXPECT_EQ(ring.size(), 3u);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_NE(ring.Take(), nullptr);
+  }
+  EXPECT_EQ(ring.Take(), nullptr);
+}
+
+TEST(RecordableSlotRingTest, ConcurrentTakeAndRecycle)
+{
+  const int num_threads    = 4;
+  const int num_iterations = 10000;
+  const size_t num_records = 64;
+  RecordableSlotRing<TestRecordable> ring{num_records, MakeTestRecordable};
+
+  std::atomic<int> empty{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&] {
+      Records records(1);
+      for (int j = 0; j < num_iterations; ++j)
+      {
+        records[0] = ring.Take();
+        if (records[0] == nullptr)
+        {
+          ++empty;
+          continue;
+        }
+        EXPECT_EQ(records[0]->value, 0);
+        records[0]->value = j;
+        Recycle(ring, records);
+        EXPECT_EQ(records[0], nullptr);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  // Fewer threads than recordables: a thread always finds one.
+  EXPECT_EQ(empty.load(), 0);
+  EXPECT_EQ(ring.size(), num_records);
+}
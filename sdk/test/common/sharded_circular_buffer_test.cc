@@ -0,0 +1,226 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/sharded_circular_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::AtomicUniquePtr;
+using opentelemetry::sdk::common::CircularBufferRange;
+using opentelemetry::sdk::common::ShardedCircularBuffer;
+
+static std::vector<int> ConsumeAll(ShardedCircularBuffer<int> &buffer, size_t n)
+{
+  std::vector<int> result;
+  buffer.Consume(n, [&](CircularBufferRange<AtomicUniquePtr<int>> range) noexcept {
+    range.ForEach([&](AtomicUniquePtr<int> &ptr) noexcept {
+      result.push_back(*ptr);
+      ptr.Reset();
+      return true;
+    });
+  });
+  return result;
+}
+
+TEST(ShardedCircularBufferTest, SingleShardKeepsOrder)
+{
+  ShardedCircularBuffer<int> buffer{10, 1};
+  EXPECT_EQ(buffer.num_shards(), 1);
+  EXPECT_EQ(buffer.max_size(), 10);
+  for (int i = 0; i < 10; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+    EXPECT_EQ(x, nullptr);
+  }
+  std::unique_ptr<int> x{new int{33}};
+  EXPECT_FALSE(buffer.Add(x));
+  EXPECT_NE(x, nullptr);
+
+  auto numbers = ConsumeAll(buffer, 4);
+  EXPECT_EQ(numbers, (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(buffer.size(), 6);
+}
+
+TEST(ShardedCircularBufferTest, ConsumeIntoVisitsShards)
+{
+  ShardedCircularBuffer<int> buffer{8, 4};
+  for (int i = 0; i < 8; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+
+  std::vector<std::unique_ptr<int>> out;
+  EXPECT_EQ(buffer.ConsumeInto(5, out), 5);
+  EXPECT_EQ(buffer.size(), 3);
+  EXPECT_EQ(buffer.ConsumeInto(10, out), 3);
+  EXPECT_TRUE(buffer.empty());
+
+  std::vector<int> numbers;
+  for (auto &x : out)
+  {
+    numbers.push_back(*x);
+  }
+  std::sort(numbers.begin(), numbers.end());
+  EXPECT_EQ(numbers, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(ShardedCircularBufferTest, ConsumeFairIntoSharesTurns)
+{
+  ShardedCircularBuffer<int> buffer{30, 3};
+  for (int i = 0; i < 10; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_NE(buffer.AddToShardAt(0, x), nullptr);
+  }
+  std::unique_ptr<int> overflow{new int{10}};
+  EXPECT_EQ(buffer.AddToShardAt(0, overflow), nullptr);
+  EXPECT_NE(overflow, nullptr);
+  for (int i = 100; i < 102; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_NE(buffer.AddToShardAt(4, x), nullptr);
+  }
+
+  // The busy shard gets two elements per turn, like the others, and keeps the rest of its turn
+  // when a call runs out of elements.
+  std::vector<std::unique_ptr<int>> out;
+  EXPECT_EQ(buffer.ConsumeFairInto(5, 2, out), 5);
+  EXPECT_EQ(buffer.ConsumeFairInto(4, 2, out), 4);
+  std::vector<int> numbers;
+  for (auto &x : out)
+  {
+    numbers.push_back(*x);
+  }
+  EXPECT_EQ(numbers, (std::vector<int>{0, 1, 100, 101, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(buffer.ConsumeFairInto(10, 2, out), 3);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ShardedCircularBufferTest, ZeroShardsIsOneShard)
+{
+  ShardedCircularBuffer<int> buffer{10, 0};
+  EXPECT_EQ(buffer.num_shards(), 1);
+  EXPECT_EQ(buffer.max_size(), 10);
+}
+
+TEST(ShardedCircularBufferTest, CapacityIsSplitAcrossShards)
+{
+  ShardedCircularBuffer<int> buffer{10, 3};
+  EXPECT_EQ(buffer.num_shards(), 3);
+  EXPECT_EQ(buffer.max_size(), 10);
+
+  // A single thread spills over into the other shards once its own is full.
+  for (int i = 0; i < 10; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  std::unique_ptr<int> x{new int{33}};
+  EXPECT_FALSE(buffer.Add(x));
+  EXPECT_EQ(buffer.size(), 10);
+
+  auto numbers = ConsumeAll(buffer, buffer.size());
+  std::sort(numbers.begin(), numbers.end());
+  EXPECT_EQ(numbers, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ShardedCircularBufferTest, AddBatchSpillsToOtherShards)
+{
+  ShardedCircularBuffer<int> buffer{12, 3};
+  std::vector<std::unique_ptr<int>> batch;
+  for (int i = 0; i < 14; ++i)
+  {
+    batch.emplace_back(new int{i});
+  }
+  EXPECT_EQ(buffer.AddBatch(batch), buffer.max_size());
+  EXPECT_EQ(buffer.size(), buffer.max_size());
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    EXPECT_EQ(batch[i] == nullptr, i < buffer.max_size());
+  }
+}
+
+TEST(ShardedCircularBufferTest, Clear)
+{
+  ShardedCircularBuffer<int> buffer{10, 4};
+  for (int i = 0; i < 7; ++i)
+  {
+    std::unique_ptr<int> x{new int{i}};
+    EXPECT_TRUE(buffer.Add(x));
+  }
+  buffer.Clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(ShardedCircularBufferTest, Simulation)
+{
+  const int num_producer_threads = 4;
+  const int n                    = 25000;
+  for (size_t num_shards : {1, 2, 4, 8})
+  {
+    ShardedCircularBuffer<uint32_t> buffer{100, num_shards};
+    std::vector<std::vector<uint32_t>> thread_numbers(num_producer_threads);
+    std::vector<uint32_t> consumer_numbers;
+    std::atomic<bool> exit{false};
+
+    std::thread consumer{[&] {
+      while (true)
+      {
+        bool done = exit.load();
+        buffer.Consume(buffer.size(),
+                       [&](CircularBufferRange<AtomicUniquePtr<uint32_t>> range) noexcept {
+                         range.ForEach([&](AtomicUniquePtr<uint32_t> &ptr) noexcept {
+                           consumer_numbers.push_back(*ptr);
+                           ptr.Reset();
+                           return true;
+                         });
+                       });
+        if (done && buffer.empty())
+        {
+          return;
+        }
+      }
+    }};
+
+    std::vector<std::thread> producers;
+    for (int thread_index = 0; thread_index < num_producer_threads; ++thread_index)
+    {
+      producers.emplace_back([&, thread_index] {
+        std::mt19937 random_number_generator{std::random_device{}()};
+        for (int i = 0; i < n; ++i)
+        {
+          auto value = static_cast<uint32_t>(random_number_generator());
+          std::unique_ptr<uint32_t> x{new uint32_t{value}};
+          if (buffer.Add(x))
+          {
+            thread_numbers[thread_index].push_back(value);
+          }
+        }
+      });
+    }
+    for (auto &producer : producers)
+    {
+      producer.join();
+    }
+    exit = true;
+    consumer.join();
+
+    std::vector<uint32_t> producer_numbers;
+    for (auto &numbers : thread_numbers)
+    {
+      producer_numbers.insert(producer_numbers.end(), numbers.begin(), numbers.end());
+    }
+    std::sort(producer_numbers.begin(), producer_numbers.end());
+    std::sort(consumer_numbers.begin(), consumer_numbers.end());
+    EXPECT_EQ(producer_numbers, consumer_numbers);
+  }
+}
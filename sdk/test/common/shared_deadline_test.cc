@@ -0,0 +1,70 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/shared_deadline.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using opentelemetry::sdk::common::GetDeadline;
+using opentelemetry::sdk::common::RunWithSharedDeadline;
+
+TEST(SharedDeadline, RunsConcurrently)
+{
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  auto start     = std::chrono::steady_clock::now();
+  auto succeeded = RunWithSharedDeadline(
+      4, std::chrono::seconds(10), [&](size_t, std::chrono::microseconds timeout) {
+        EXPECT_GT(timeout, std::chrono::seconds(9));
+        int now_running = ++running;
+        int previous    = max_running.load();
+        while (previous < now_running && !max_running.compare_exchange_weak(previous, now_running))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        --running;
+        return true;
+      });
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_EQ(4, succeeded.size());
+  for (bool result : succeeded)
+  {
+    EXPECT_TRUE(result);
+  }
+  EXPECT_EQ(4, max_running.load());
+  EXPECT_LT(elapsed, std::chrono::milliseconds(700));
+}
+
+TEST(SharedDeadline, ReportsFailuresAndMissedDeadline)
+{
+  auto succeeded = RunWithSharedDeadline(
+      3, std::chrono::milliseconds(100), [](size_t index, std::chrono::microseconds) {
+        if (index == 1)
+        {
+          return false;
+        }
+        if (index == 2)
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        return true;
+      });
+
+  ASSERT_EQ(3, succeeded.size());
+  EXPECT_TRUE(succeeded[0]);
+  EXPECT_FALSE(succeeded[1]);
+  EXPECT_FALSE(succeeded[2]);
+}
+
+TEST(SharedDeadline, NoOverflow)
+{
+  EXPECT_EQ((std::chrono::steady_clock::time_point::max)(),
+            GetDeadline((std::chrono::microseconds::max)()));
+  EXPECT_TRUE(RunWithSharedDeadline(0, std::chrono::microseconds::zero(),
+                                    [](size_t, std::chrono::microseconds) { return true; })
+                  .empty());
+}
@@ -0,0 +1,90 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/small_vector.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using opentelemetry::sdk::common::SmallVector;
+
+TEST(SmallVector, InlineThenHeap)
+{
+  SmallVector<std::string, 2> values;
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(values.capacity(), 2);
+
+  values.push_back("a");
+  values.emplace_back(3, 'b');
+  EXPECT_TRUE(values.is_inline());
+
+  values.push_back("c");
+  EXPECT_FALSE(values.is_inline());
+  ASSERT_EQ(values.size(), 3);
+  EXPECT_EQ(values[0], "a");
+  EXPECT_EQ(values.at(1), "bbb");
+  EXPECT_EQ(values.back(), "c");
+
+  std::string joined;
+  for (const auto &value : values)
+  {
+    joined += value;
+  }
+  EXPECT_EQ(joined, "abbbc");
+}
+
+TEST(SmallVector, ClearKeepsCapacity)
+{
+  SmallVector<std::string, 1> values;
+  values.push_back("a");
+  values.push_back("b");
+  size_t capacity = values.capacity();
+
+  values.clear();
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(values.capacity(), capacity);
+  EXPECT_FALSE(values.is_inline());
+}
+
+TEST(SmallVector, PushBackOwnElement)
+{
+  SmallVector<std::string, 1> values;
+  values.push_back(std::string(64, 'x'));
+  values.push_back(values[0]);
+  ASSERT_EQ(values.size(), 2);
+  EXPECT_EQ(values[1], std::string(64, 'x'));
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+  for (size_t count : {1, 4})
+  {
+    SmallVector<std::unique_ptr<int>, 2> values;
+    for (size_t i = 0; i < count; ++i)
+    {
+      values.emplace_back(new int(static_cast<int>(i)));
+    }
+    int *first = values[0].get();
+
+    SmallVector<std::unique_ptr<int>, 2> moved(std::move(values));
+    EXPECT_TRUE(values.empty());
+    ASSERT_EQ(moved.size(), count);
+    EXPECT_EQ(moved[0].get(), first);
+
+    values = std::move(moved);
+    ASSERT_EQ(values.size(), count);
+    EXPECT_EQ(*values.back(), static_cast<int>(count - 1));
+  }
+
+  SmallVector<std::string, 2> values;
+  values.push_back("a");
+  values.push_back("b");
+  values.push_back("c");
+  SmallVector<std::string, 2> copy(values);
+  ASSERT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy[2], "c");
+  copy = SmallVector<std::string, 2>();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(values.size(), 3);
+}
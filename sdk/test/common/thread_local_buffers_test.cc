@@ -0,0 +1,85 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/thread_local_buffers.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+using opentelemetry::sdk::common::ThreadLocalBuffers;
+
+namespace
+{
+/* Collects the elements handed off, and the size of each hand-off. */
+struct HandOffs
+{
+  std::vector<int> elements;
+  std::vector<size_t> sizes;
+
+  std::function<void(std::vector<std::unique_ptr<int>> &)> Callback()
+  {
+    return [this](std::vector<std::unique_ptr<int>> &batch) {
+      sizes.push_back(batch.size());
+      for (auto &element : batch)
+      {
+        elements.push_back(*element);
+      }
+      batch.clear();
+    };
+  }
+};
+}  // namespace
+
+TEST(ThreadLocalBuffersTest, HandsOffFullBuffers)
+{
+  HandOffs hand_offs;
+  ThreadLocalBuffers<int> buffers{4, hand_offs.Callback()};
+  for (int i = 0; i < 10; ++i)
+  {
+    buffers.Add(std::unique_ptr<int>(new int{i}));
+  }
+  EXPECT_EQ(hand_offs.sizes, (std::vector<size_t>{4, 4}));
+
+  buffers.Flush();
+  EXPECT_EQ(hand_offs.sizes, (std::vector<size_t>{4, 4, 2}));
+  EXPECT_EQ(hand_offs.elements, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  // Empty buffers are not handed off.
+  buffers.Flush();
+  EXPECT_EQ(hand_offs.sizes.size(), 3);
+}
+
+TEST(ThreadLocalBuffersTest, HandsOffBuffersOfExitingThreads)
+{
+  HandOffs hand_offs;
+  ThreadLocalBuffers<int> buffers{4, hand_offs.Callback()};
+  std::thread thread{[&buffers] {
+    buffers.Add(std::unique_ptr<int>(new int{1}));
+    buffers.Add(std::unique_ptr<int>(new int{2}));
+  }};
+  thread.join();
+  EXPECT_EQ(hand_offs.elements, (std::vector<int>{1, 2}));
+
+  // The buffer of the exited thread is forgotten.
+  buffers.Flush();
+  EXPECT_EQ(hand_offs.sizes.size(), 1);
+}
+
+TEST(ThreadLocalBuffersTest, KeepsOneBufferPerOwner)
+{
+  HandOffs first_hand_offs;
+  HandOffs second_hand_offs;
+  {
+    ThreadLocalBuffers<int> first{2, first_hand_offs.Callback()};
+    first.Add(std::unique_ptr<int>(new int{1}));
+  }
+
+  // A new owner, possibly at the same address, does not reuse the buffer of the destroyed one.
+  ThreadLocalBuffers<int> second{2, second_hand_offs.Callback()};
+  second.Add(std::unique_ptr<int>(new int{2}));
+  second.Flush();
+  EXPECT_TRUE(first_hand_offs.elements.empty());
+  EXPECT_EQ(second_hand_offs.elements, (std::vector<int>{2}));
+}
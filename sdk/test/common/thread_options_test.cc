@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/common/thread_options.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+using opentelemetry::sdk::common::ApplyThreadOptions;
+using opentelemetry::sdk::common::GetDefaultThreadOptions;
+using opentelemetry::sdk::common::SetDefaultThreadOptions;
+using opentelemetry::sdk::common::ThreadOptions;
+
+namespace
+{
+// Applies `options` on a new thread.
+void StartThread(const ThreadOptions &options, const char *default_name)
+{
+  std::thread thread([&] { ApplyThreadOptions(options, default_name); });
+  thread.join();
+}
+}  // namespace
+
+TEST(ThreadOptions, CallsOnStartWithTheName)
+{
+  ThreadOptions options;
+  std::string started_name;
+  options.on_start = [&started_name](const std::string &name) { started_name = name; };
+
+  StartThread(options, "otel-test");
+  EXPECT_EQ("otel-test", started_name);
+
+  options.name = "telemetry";
+  StartThread(options, "otel-test");
+  EXPECT_EQ("telemetry", started_name);
+}
+
+TEST(ThreadOptions, FallsBackOnTheDefaults)
+{
+  std::string started_name;
+  ThreadOptions defaults;
+  defaults.on_start = [&started_name](const std::string &name) { started_name = name; };
+  SetDefaultThreadOptions(defaults);
+
+  StartThread(ThreadOptions(), "otel-test");
+  EXPECT_EQ("otel-test", started_name);
+
+  // The options of the thread win over the defaults.
+  std::string own_name;
+  ThreadOptions options;
+  options.on_start = [&own_name](const std::string &name) { own_name = name; };
+  started_name.clear();
+  StartThread(options, "otel-own");
+  EXPECT_EQ("otel-own", own_name);
+  EXPECT_TRUE(started_name.empty());
+
+  SetDefaultThreadOptions(ThreadOptions());
+  EXPECT_FALSE(GetDefaultThreadOptions().on_start);
+}
+
+#ifdef __linux__
+TEST(ThreadOptions, SetsTheNameAndAffinity)
+{
+  cpu_set_t allowed;
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed))
+  {
+    ++cpu;
+  }
+
+  ThreadOptions options;
+  options.name         = "otel-a-long-thread-name";
+  options.cpu_affinity = {cpu};
+  char name[16]        = {};
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  std::thread thread([&] {
+    ApplyThreadOptions(options, "otel-test");
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    sched_getaffinity(0, sizeof(affinity), &affinity);
+  });
+  thread.join();
+
+  // Truncated to the 15 characters the kernel keeps.
+  EXPECT_EQ("otel-a-long-thr", std::string(name));
+  EXPECT_EQ(1, CPU_COUNT(&affinity));
+  EXPECT_TRUE(CPU_ISSET(cpu, &affinity));
+}
+#endif
@@ -3,9 +3,11 @@
 
 #include "opentelemetry/nostd/string_view.h"
 #include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library_map.h"
 
 #include <gtest/gtest.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace opentelemetry;
@@ -24,3 +26,68 @@ TEST(InstrumentationLibrary, CreateInstrumentationLibrary)
   EXPECT_EQ(instrumentation_library->GetVersion(), library_version);
   EXPECT_EQ(instrumentation_library->GetSchemaURL(), schema_url);
 }
+
+TEST(InstrumentationLibraryMap, FindOrInsert)
+{
+  InstrumentationLibraryMap<InstrumentationLibrary> map;
+  int created     = 0;
+  auto get       = [&](nostd::string_view name, nostd::string_view version) {
+    return map.FindOrInsert(
+        map.Hash(name, version, ""),
+        [&](const InstrumentationLibrary &lib) { return lib.equal(name, version, ""); },
+        [&]() {
+          ++created;
+          return std::shared_ptr<InstrumentationLibrary>(
+              InstrumentationLibrary::Create(name, version).release());
+        });
+  };
+
+  auto lib1 = get("library", "1.0.0");
+  auto lib2 = get("library", "2.0.0");
+  EXPECT_NE(lib1, lib2);
+  EXPECT_EQ(lib1, get("library", "1.0.0"));
+  EXPECT_EQ(lib2, get("library", "2.0.0"));
+  EXPECT_EQ(created, 2);
+
+  EXPECT_EQ(lib1, map.Find(map.Hash("library", "1.0.0", ""), [](const InstrumentationLibrary &lib) {
+    return lib.equal("library", "1.0.0", "");
+  }));
+  EXPECT_EQ(nullptr, map.Find(map.Hash("other", "", ""), [](const InstrumentationLibrary &lib) {
+    return lib.equal("other", "", "");
+  }));
+}
+
+TEST(InstrumentationLibraryMap, ConcurrentFindOrInsert)
+{
+  InstrumentationLibraryMap<InstrumentationLibrary> map;
+  std::vector<std::shared_ptr<InstrumentationLibrary>> libs(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < libs.size(); ++i)
+  {
+    threads.emplace_back([&map, &libs, i]() {
+      for (int j = 0; j < 100; ++j)
+      {
+        std::string name = "library" + std::to_string(j % 10);
+        auto lib         = map.FindOrInsert(
+            map.Hash(name, "", ""),
+            [&](const InstrumentationLibrary &lib) { return lib.equal(name, "", ""); },
+            [&]() {
+              return std::shared_ptr<InstrumentationLibrary>(
+                  InstrumentationLibrary::Create(name).release());
+            });
+        if (j == 0)
+        {
+          libs[i] = lib;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  for (auto &lib : libs)
+  {
+    EXPECT_EQ(lib, libs[0]);
+  }
+}
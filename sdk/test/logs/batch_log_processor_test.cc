@@ -42,6 +42,8 @@ class MockLogExporter final : public LogExporter
   {
     *is_export_completed_ = false;  // Meant exclusively to test scheduled_delay_millis
 
+    std::this_thread::sleep_for(export_delay_);
+
     for (auto &record : records)
     {
       auto log = std::unique_ptr<LogRecord>(static_cast<LogRecord *>(record.release()));
@@ -174,6 +176,33 @@ TEST_F(BatchLogProcessorTest, TestForceFlush)
   }
 }
 
+TEST_F(BatchLogProcessorTest, TestForceFlushTimeout)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<LogRecord>>> logs_received(
+      new std::vector<std::unique_ptr<LogRecord>>);
+  const std::chrono::milliseconds export_delay(500);
+
+  auto batch_processor =
+      GetMockProcessor(logs_received, is_shutdown, is_export_completed, export_delay);
+  const int num_logs = 3;
+
+  for (int i = 0; i < num_logs; ++i)
+  {
+    auto log = batch_processor->MakeRecordable();
+    log->SetBody("Log" + std::to_string(i));
+    batch_processor->OnReceive(std::move(log));
+  }
+
+  // The exporter is slower than the timeout
+  EXPECT_FALSE(batch_processor->ForceFlush(std::chrono::milliseconds(50)));
+
+  // Without a timeout, ForceFlush waits for the export to complete
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_logs, logs_received->size());
+}
+
 TEST_F(BatchLogProcessorTest, TestManyLogsLoss)
 {
   /* Test that when exporting more than max_queue_size logs, some are most likely lost*/
@@ -266,4 +295,139 @@ TEST_F(BatchLogProcessorTest, TestScheduledDelayMillis)
     EXPECT_EQ("Log" + std::to_string(i), logs_received->at(i)->GetBody());
   }
 }
+
+TEST_F(BatchLogProcessorTest, TestStats)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<LogRecord>>> logs_received(
+      new std::vector<std::unique_ptr<LogRecord>>);
+
+  const std::chrono::milliseconds export_delay(20);
+  const size_t max_queue_size        = 16;
+  const size_t max_export_batch_size = 8;
+
+  auto batch_processor = std::shared_ptr<BatchLogProcessor>(new BatchLogProcessor(
+      std::unique_ptr<LogExporter>(
+          new MockLogExporter(logs_received, is_shutdown, is_export_completed, export_delay)),
+      max_queue_size, std::chrono::milliseconds(5000), max_export_batch_size));
+
+  // The queue overflows well before the slow exporter drains it
+  const int num_logs = 64;
+  for (int i = 0; i < num_logs; ++i)
+  {
+    auto log = batch_processor->MakeRecordable();
+    log->SetBody("Log" + std::to_string(i));
+    batch_processor->OnReceive(std::move(log));
+  }
+
+  auto stats = batch_processor->GetStats();
+  EXPECT_GT(stats.dropped, 0);
+  EXPECT_EQ(num_logs, stats.enqueued + stats.dropped);
+  EXPECT_EQ(max_queue_size, stats.max_queue_size);
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  stats = batch_processor->GetStats();
+  EXPECT_EQ(stats.enqueued, stats.exported);
+  EXPECT_EQ(logs_received->size(), stats.exported);
+  EXPECT_EQ(0, stats.queue_size);
+  EXPECT_GE(stats.export_count, 1);
+
+  uint64_t bucketed_exports = 0;
+  for (auto count : stats.export_duration_counts)
+  {
+    bucketed_exports += count;
+  }
+  EXPECT_EQ(stats.export_count, bucketed_exports);
+}
+
+/**
+ * Counts the recordables it makes, and leaves the exported recordables to the processor
+ */
+class CountingLogExporter final : public LogExporter
+{
+public:
+  explicit CountingLogExporter(std::shared_ptr<std::atomic<size_t>> made,
+                               std::shared_ptr<std::atomic<size_t>> exported)
+      : made_(made), exported_(exported)
+  {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    ++*made_;
+    return std::unique_ptr<Recordable>(new LogRecord());
+  }
+
+  ExportResult Export(
+      const opentelemetry::nostd::span<std::unique_ptr<Recordable>> &records) noexcept override
+  {
+    *exported_ += records.size();
+    return ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds /* timeout */) noexcept override { return true; }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> made_;
+  std::shared_ptr<std::atomic<size_t>> exported_;
+};
+
+TEST_F(BatchLogProcessorTest, TestPreallocatedRecordables)
+{
+  std::shared_ptr<std::atomic<size_t>> made(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> exported(new std::atomic<size_t>(0));
+  const size_t max_queue_size = 16;
+
+  BatchLogProcessor batch_processor(
+      std::unique_ptr<LogExporter>(new CountingLogExporter(made, exported)), max_queue_size,
+      std::chrono::milliseconds(5000), 8, 0, 0, true);
+  EXPECT_EQ(max_queue_size, made->load());
+
+  // The logs are recorded into the preallocated recordables, given back after each export.
+  const size_t num_logs = 100;
+  for (size_t i = 0; i < num_logs; ++i)
+  {
+    auto log = batch_processor.MakeRecordable();
+    log->SetBody("Log" + std::to_string(i));
+    batch_processor.OnReceive(std::move(log));
+    if (i % 8 == 7)
+    {
+      EXPECT_TRUE(batch_processor.ForceFlush());
+    }
+  }
+  EXPECT_TRUE(batch_processor.ForceFlush());
+  EXPECT_EQ(num_logs, exported->load());
+  EXPECT_EQ(max_queue_size, made->load());
+}
+
+TEST_F(BatchLogProcessorTest, TestSharedExecutor)
+{
+  std::shared_ptr<opentelemetry::sdk::common::ExportExecutor> executor(
+      new opentelemetry::sdk::common::ExportExecutor(1));
+  std::shared_ptr<std::atomic<size_t>> made(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> first_exported(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> second_exported(new std::atomic<size_t>(0));
+
+  BatchLogProcessor first_processor(
+      std::unique_ptr<LogExporter>(new CountingLogExporter(made, first_exported)), 2048,
+      std::chrono::milliseconds(5000), 512, 2048, 0, false, executor);
+  BatchLogProcessor second_processor(
+      std::unique_ptr<LogExporter>(new CountingLogExporter(made, second_exported)), 2048,
+      std::chrono::milliseconds(5000), 512, 2048, 0, false, executor);
+
+  const size_t num_logs = 10;
+  for (size_t i = 0; i < num_logs; ++i)
+  {
+    first_processor.OnReceive(first_processor.MakeRecordable());
+    second_processor.OnReceive(second_processor.MakeRecordable());
+  }
+  EXPECT_TRUE(first_processor.ForceFlush());
+  EXPECT_EQ(num_logs, first_exported->load());
+
+  // A shutdown drains the queue.
+  EXPECT_TRUE(second_processor.Shutdown());
+  EXPECT_EQ(num_logs, second_exported->load());
+  EXPECT_TRUE(first_processor.Shutdown());
+}
 #endif
@@ -63,4 +63,52 @@ TEST(LogRecord, SetAndGet)
   ASSERT_EQ(record.GetTraceFlags(), trace_flags);
   ASSERT_EQ(record.GetTimestamp().time_since_epoch(), now.time_since_epoch());
 }
+
+TEST(LogRecord, Reset)
+{
+  LogRecord record;
+  record.SetSeverity(logs_api::Severity::kInfo);
+  record.SetBody("Message");
+  record.SetAttribute("attr1", (int64_t)314159);
+  record.SetTimestamp(std::chrono::system_clock::now());
+
+  EXPECT_TRUE(record.Reset());
+  EXPECT_EQ(record.GetSeverity(), logs_api::Severity::kInvalid);
+  EXPECT_EQ(record.GetBody(), "");
+  EXPECT_EQ(record.GetAttributes().size(), 0);
+  EXPECT_EQ(record.GetTimestamp().time_since_epoch(), std::chrono::nanoseconds(0));
+}
+
+TEST(LogRecord, BinaryRoundTrip)
+{
+  LogRecord record;
+  uint8_t trace_id_buf[trace_api::TraceId::kSize] = {1};
+  uint8_t span_id_buf[trace_api::SpanId::kSize]   = {2};
+  record.SetSeverity(logs_api::Severity::kWarn);
+  record.SetBody("Message");
+  record.SetAttribute("attr1", (int64_t)314159);
+  record.SetTraceId(trace_api::TraceId(trace_id_buf));
+  record.SetSpanId(trace_api::SpanId(span_id_buf));
+  record.SetTraceFlags(trace_api::TraceFlags(trace_api::TraceFlags::kIsSampled));
+  record.SetTimestamp(std::chrono::system_clock::now());
+
+  std::string encoded;
+  EXPECT_EQ(opentelemetry::sdk::common::JournalRecordType::kLogRecord,
+            record.AppendJournalRecord(encoded));
+  LogRecord decoded;
+  opentelemetry::sdk::common::BinaryDecoder decoder(encoded.data(), encoded.size());
+  ASSERT_TRUE(decoded.ReadBinary(decoder));
+  EXPECT_EQ(logs_api::Severity::kWarn, decoded.GetSeverity());
+  EXPECT_EQ("Message", decoded.GetBody());
+  EXPECT_EQ(314159, nostd::get<int64_t>(decoded.GetAttributes().at("attr1")));
+  EXPECT_EQ(record.GetTraceId(), decoded.GetTraceId());
+  EXPECT_EQ(record.GetSpanId(), decoded.GetSpanId());
+  EXPECT_EQ(record.GetTraceFlags(), decoded.GetTraceFlags());
+  EXPECT_EQ(record.GetTimestamp().time_since_epoch(), decoded.GetTimestamp().time_since_epoch());
+
+  // A truncated encoding is rejected.
+  LogRecord truncated;
+  opentelemetry::sdk::common::BinaryDecoder short_decoder(encoded.data(), encoded.size() - 1);
+  EXPECT_FALSE(truncated.ReadBinary(short_decoder));
+}
 #endif
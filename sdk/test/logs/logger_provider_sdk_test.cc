@@ -58,6 +58,10 @@ TEST(LoggerProviderSDK, LoggerProviderGetLoggerSimple)
   ASSERT_EQ(logger1, logger3);
   auto sdk_logger3 = static_cast<opentelemetry::sdk::logs::Logger *>(logger3.get());
   ASSERT_EQ(sdk_logger3->GetInstrumentationLibrary(), sdk_logger1->GetInstrumentationLibrary());
+
+  // Also when the library name defaults to the logger name
+  auto logger4 = lp->GetLogger("logger2", "", "", "", schema_url);
+  ASSERT_EQ(logger2, logger4);
 }
 
 TEST(LoggerProviderSDK, LoggerProviderLoggerArguments)
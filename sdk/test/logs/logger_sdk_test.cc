@@ -5,6 +5,7 @@
 
 #  include "opentelemetry/sdk/logs/log_record.h"
 #  include "opentelemetry/sdk/logs/logger.h"
+#  include "opentelemetry/sdk/logs/message_template.h"
 
 #  include <gtest/gtest.h>
 
@@ -94,4 +95,98 @@ TEST(LoggerSDK, LogToAProcessor)
   ASSERT_EQ(shared_recordable->GetSeverity(), logs_api::Severity::kWarn);
   ASSERT_EQ(shared_recordable->GetBody(), "Log Message");
 }
+
+TEST(LoggerSDK, MinimumSeverity)
+{
+  auto lp     = std::shared_ptr<LoggerProvider>(new LoggerProvider());
+  auto logger = lp->GetLogger("logger", "", "opentelelemtry_library");
+  auto shared_recordable = std::shared_ptr<LogRecord>(new LogRecord());
+  lp->AddProcessor(std::unique_ptr<LogProcessor>(new MockProcessor(shared_recordable)));
+
+  auto sdk_logger = static_cast<opentelemetry::sdk::logs::Logger *>(logger.get());
+  EXPECT_EQ(sdk_logger->GetMinimumSeverity(), logs_api::Severity::kInvalid);
+  EXPECT_TRUE(logger->Enabled(logs_api::Severity::kTrace));
+
+  sdk_logger->SetMinimumSeverity(logs_api::Severity::kWarn);
+  EXPECT_FALSE(logger->Enabled(logs_api::Severity::kInfo4));
+  EXPECT_TRUE(logger->Enabled(logs_api::Severity::kWarn));
+
+  // Log events below the minimum severity never reach the processor
+  logger->Log(logs_api::Severity::kDebug, "Debug Message");
+  ASSERT_EQ(shared_recordable->GetSeverity(), logs_api::Severity::kInvalid);
+  ASSERT_EQ(shared_recordable->GetBody(), "");
+
+  logger->Log(logs_api::Severity::kError, "Error Message");
+  ASSERT_EQ(shared_recordable->GetSeverity(), logs_api::Severity::kError);
+  ASSERT_EQ(shared_recordable->GetBody(), "Error Message");
+}
+
+TEST(LoggerSDK, TelemetryDisabled)
+{
+  using opentelemetry::sdk::common::TelemetrySwitch;
+  auto lp     = std::shared_ptr<LoggerProvider>(new LoggerProvider());
+  auto logger = lp->GetLogger("logger", "", "opentelelemtry_library");
+  auto shared_recordable = std::shared_ptr<LogRecord>(new LogRecord());
+  lp->AddProcessor(std::unique_ptr<LogProcessor>(new MockProcessor(shared_recordable)));
+
+  TelemetrySwitch::SetEnabled(false);
+  EXPECT_FALSE(logger->Enabled(logs_api::Severity::kFatal));
+  logger->Log(logs_api::Severity::kFatal, "Fatal Message");
+  TelemetrySwitch::SetEnabled(true);
+  ASSERT_EQ(shared_recordable->GetBody(), "");
+
+  logger->Log(logs_api::Severity::kFatal, "Fatal Message");
+  ASSERT_EQ(shared_recordable->GetBody(), "Fatal Message");
+}
+
+// A processor which keeps the body, the attributes and the formatted message of the last record
+class TemplateProcessor final : public LogProcessor
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord);
+  }
+
+  void OnReceive(std::unique_ptr<Recordable> &&record) noexcept override
+  {
+    auto log_record = static_cast<LogRecord *>(record.get());
+    body            = log_record->GetBody();
+    attribute_count = log_record->GetAttributes().size();
+    message         = FormatMessageTemplate(log_record->GetBody(), log_record->GetAttributes());
+  }
+
+  bool ForceFlush(std::chrono::microseconds /* timeout */) noexcept override { return true; }
+
+  bool Shutdown(std::chrono::microseconds /* timeout */) noexcept override { return true; }
+
+  std::string body;
+  size_t attribute_count = 0;
+  std::string message;
+};
+
+TEST(LoggerSDK, LogTemplate)
+{
+  auto lp        = std::shared_ptr<LoggerProvider>(new LoggerProvider());
+  auto processor = new TemplateProcessor;
+  lp->AddProcessor(std::unique_ptr<LogProcessor>(processor));
+  auto logger = lp->GetLogger("logger", "", "opentelelemtry_library");
+
+  // The template is the body, the arguments are attributes, the message is formatted on export.
+  std::string path = "/index.html";
+  logger->LogTemplate(logs_api::Severity::kInfo, "GET {} took {} ms, cached: {}", path, 2.5, true);
+  EXPECT_EQ(processor->body, "GET {} took {} ms, cached: {}");
+  EXPECT_EQ(processor->attribute_count, 3u);
+  EXPECT_EQ(processor->message, "GET /index.html took 2.5 ms, cached: true");
+
+  // Placeholders without an argument are left as they are.
+  logger->LogTemplate(logs_api::Severity::kInfo, "{} of {} {", 1);
+  EXPECT_EQ(processor->message, "1 of {} {");
+
+  // Nothing is stored for a disabled severity.
+  static_cast<opentelemetry::sdk::logs::Logger *>(logger.get())
+      ->SetMinimumSeverity(logs_api::Severity::kWarn);
+  logger->LogTemplate(logs_api::Severity::kInfo, "Dropped {}", 2);
+  EXPECT_EQ(processor->body, "{} of {} {");
+}
 #endif
@@ -0,0 +1,97 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/sdk/logs/multi_log_processor.h"
+#  include "opentelemetry/sdk/logs/batch_log_processor.h"
+#  include "opentelemetry/sdk/logs/exporter.h"
+#  include "opentelemetry/sdk/logs/log_record.h"
+#  include "opentelemetry/sdk/logs/pooled_log_record.h"
+#  include "opentelemetry/sdk/logs/simple_log_processor.h"
+
+#  include <gtest/gtest.h>
+#  include <mutex>
+
+using namespace opentelemetry::sdk::logs;
+using opentelemetry::sdk::common::ExportResult;
+namespace nostd = opentelemetry::nostd;
+
+/**
+ * An exporter which keeps the bodies of the logs it exports.
+ */
+class BodyLogExporter final : public LogExporter
+{
+public:
+  explicit BodyLogExporter(std::shared_ptr<std::vector<std::string>> bodies) : bodies_(bodies) {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord());
+  }
+
+  ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &records) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &record : records)
+    {
+      bodies_->push_back(static_cast<LogRecord *>(record.get())->GetBody());
+    }
+    return ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds /* timeout */) noexcept override { return true; }
+
+private:
+  std::mutex lock_;
+  std::shared_ptr<std::vector<std::string>> bodies_;
+};
+
+static void Log(LogProcessor &processor, nostd::string_view body)
+{
+  auto record = processor.MakeRecordable();
+  record->SetBody(body);
+  processor.OnReceive(std::move(record));
+}
+
+TEST(MultiLogProcessor, RecordsForEachProcessor)
+{
+  std::shared_ptr<std::vector<std::string>> first(new std::vector<std::string>);
+  std::shared_ptr<std::vector<std::string>> second(new std::vector<std::string>);
+  std::vector<std::unique_ptr<LogProcessor>> processors;
+  processors.emplace_back(
+      new SimpleLogProcessor(std::unique_ptr<LogExporter>(new BodyLogExporter(first))));
+  processors.emplace_back(
+      new SimpleLogProcessor(std::unique_ptr<LogExporter>(new BodyLogExporter(second))));
+  MultiLogProcessor processor(std::move(processors));
+
+  Log(processor, "log");
+  EXPECT_EQ(*first, std::vector<std::string>({"log"}));
+  EXPECT_EQ(*second, std::vector<std::string>({"log"}));
+}
+
+TEST(MultiLogProcessor, FanOutRecordsOnce)
+{
+  std::shared_ptr<std::vector<std::string>> simple(new std::vector<std::string>);
+  std::shared_ptr<std::vector<std::string>> batch(new std::vector<std::string>);
+  std::vector<std::unique_ptr<LogProcessor>> processors;
+  processors.emplace_back(
+      new SimpleLogProcessor(std::unique_ptr<LogExporter>(new BodyLogExporter(simple))));
+  processors.emplace_back(
+      new BatchLogProcessor(std::unique_ptr<LogExporter>(new BodyLogExporter(batch))));
+  MultiLogProcessorOptions options;
+  options.fan_out = true;
+  MultiLogProcessor processor(std::move(processors), options);
+
+  // The log is recorded once, whatever the number of processors.
+  EXPECT_NE(nullptr, dynamic_cast<PooledLogRecord *>(processor.MakeRecordable().get()));
+
+  Log(processor, "log1");
+  Log(processor, "log2");
+  EXPECT_TRUE(processor.ForceFlush());
+
+  // Each processor replays the shared log into a recordable of its exporter.
+  EXPECT_EQ(*simple, std::vector<std::string>({"log1", "log2"}));
+  EXPECT_EQ(*batch, std::vector<std::string>({"log1", "log2"}));
+}
+#endif
@@ -0,0 +1,179 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef ENABLE_LOGS_PREVIEW
+
+#  include "opentelemetry/sdk/logs/pooled_log_record.h"
+#  include "opentelemetry/sdk/logs/batch_log_processor.h"
+#  include "opentelemetry/sdk/logs/exporter.h"
+
+#  include <gtest/gtest.h>
+#  include <atomic>
+#  include <chrono>
+
+using namespace opentelemetry::sdk::logs;
+using namespace opentelemetry::sdk::common;
+namespace nostd = opentelemetry::nostd;
+
+/**
+ * An exporter which takes its records from a pool, and counts the bodies it exports.
+ */
+class PoolingLogExporter final : public LogExporter
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override { return pool_.MakeRecordable(); }
+
+  ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &records) noexcept override
+  {
+    for (auto &record : records)
+    {
+      auto log = static_cast<PooledLogRecord *>(record.get());
+      if (nostd::holds_alternative<int64_t>(log->GetBody()))
+      {
+        exported_ += nostd::get<int64_t>(log->GetBody());
+      }
+    }
+    return ExportResult::kSuccess;
+  }
+
+  void Recycle(nostd::span<std::unique_ptr<Recordable>> records) noexcept override
+  {
+    pool_.Recycle(records);
+  }
+
+  bool Shutdown(std::chrono::microseconds /* timeout */) noexcept override { return true; }
+
+  LogRecordPool pool_;
+  std::atomic<int64_t> exported_{0};
+};
+
+TEST(PooledLogRecord, TypedBody)
+{
+  PooledLogRecord record;
+  EXPECT_EQ(nostd::get<std::string>(record.GetBody()), "");
+
+  record.SetBody("message");
+  EXPECT_EQ(nostd::get<std::string>(record.GetBody()), "message");
+
+  record.SetBodyValue(int64_t(42));
+  ASSERT_TRUE(nostd::holds_alternative<int64_t>(record.GetBody()));
+  EXPECT_EQ(nostd::get<int64_t>(record.GetBody()), 42);
+
+  record.SetBodyValue(nostd::string_view("text"));
+  EXPECT_EQ(nostd::get<std::string>(record.GetBody()), "text");
+}
+
+TEST(PooledLogRecord, AttributesBeyondInlineStorage)
+{
+  PooledLogRecord record;
+  const size_t count = PooledLogRecord::kInlineAttributes + 3;
+  for (size_t i = 0; i < count; ++i)
+  {
+    record.SetAttribute("key" + std::to_string(i), static_cast<int64_t>(i));
+  }
+  record.SetAttribute("key1", "replaced");
+  record.SetAttribute("key9", "replaced");
+  EXPECT_EQ(record.GetAttributeCount(), count);
+
+  size_t index = 0;
+  record.ForEachAttribute([&](nostd::string_view key, const OwnedAttributeValue &value) {
+    EXPECT_EQ(std::string(key.data(), key.size()), "key" + std::to_string(index));
+    if (index == 1 || index == 9)
+    {
+      EXPECT_EQ(nostd::get<std::string>(value), "replaced");
+    }
+    else
+    {
+      EXPECT_EQ(nostd::get<int64_t>(value), static_cast<int64_t>(index));
+    }
+    ++index;
+    return true;
+  });
+  EXPECT_EQ(index, count);
+}
+
+TEST(PooledLogRecord, ResetKeepsMemory)
+{
+  PooledLogRecord record;
+  const std::string body(256, 'x');
+  record.SetBody(body);
+  record.SetSeverity(opentelemetry::logs::Severity::kError);
+  record.SetAttribute("key", "value");
+  const char *data = nostd::get<std::string>(record.GetBody()).data();
+
+  record.Reset();
+  EXPECT_EQ(record.GetSeverity(), opentelemetry::logs::Severity::kInvalid);
+  EXPECT_EQ(record.GetAttributeCount(), 0);
+  EXPECT_EQ(nostd::get<std::string>(record.GetBody()), "");
+
+  record.SetBody(body);
+  EXPECT_EQ(nostd::get<std::string>(record.GetBody()).data(), data);
+}
+
+TEST(LogRecordPool, ReuseRecords)
+{
+  LogRecordPool pool(1);
+  std::unique_ptr<Recordable> records[2] = {pool.MakeRecordable(), pool.MakeRecordable()};
+  Recordable *first                      = records[0].get();
+  records[0]->SetBody("first");
+
+  pool.Recycle(nostd::span<std::unique_ptr<Recordable>>(records, 2));
+  EXPECT_EQ(pool.GetSize(), 1);
+  EXPECT_EQ(records[0], nullptr);
+  // Beyond the size of the pool, the record is left to its owner.
+  EXPECT_NE(records[1], nullptr);
+
+  auto record = pool.MakeRecordable();
+  EXPECT_EQ(record.get(), first);
+  EXPECT_EQ(nostd::get<std::string>(static_cast<PooledLogRecord *>(record.get())->GetBody()), "");
+  EXPECT_EQ(pool.GetSize(), 0);
+}
+
+TEST(LogRecordPool, BatchLogProcessorRecycles)
+{
+  auto exporter = new PoolingLogExporter();
+  BatchLogProcessor processor(std::unique_ptr<LogExporter>(exporter), 64,
+                              std::chrono::milliseconds(5000), 64);
+  for (int64_t i = 1; i <= 10; ++i)
+  {
+    auto record = processor.MakeRecordable();
+    record->SetBodyValue(i);
+    processor.OnReceive(std::move(record));
+  }
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_EQ(exporter->exported_.load(), 55);
+  EXPECT_EQ(exporter->pool_.GetSize(), 10);
+
+  // The next records come from the pool.
+  auto record = processor.MakeRecordable();
+  EXPECT_EQ(exporter->pool_.GetSize(), 9);
+}
+
+TEST(PooledLogRecord, Replay)
+{
+  PooledLogRecord record;
+  record.SetSeverity(opentelemetry::logs::Severity::kWarn);
+  record.SetBodyValue(int64_t(42));
+  record.SetAttribute("key", "value");
+  const bool flags[] = {true, false};
+  record.SetAttribute("flags", nostd::span<const bool>(flags));
+
+  PooledLogRecord copy;
+  record.Replay(copy);
+  EXPECT_EQ(copy.GetSeverity(), opentelemetry::logs::Severity::kWarn);
+  EXPECT_EQ(nostd::get<int64_t>(copy.GetBody()), 42);
+  ASSERT_EQ(copy.GetAttributeCount(), 2);
+  copy.ForEachAttribute([](nostd::string_view key, const OwnedAttributeValue &value) {
+    if (key == "key")
+    {
+      EXPECT_EQ(nostd::get<std::string>(value), "value");
+    }
+    else
+    {
+      EXPECT_EQ(nostd::get<std::vector<bool>>(value), std::vector<bool>({true, false}));
+    }
+    return true;
+  });
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 #  include <gtest/gtest.h>
 
+#  include <atomic>
 #  include <chrono>
 #  include <thread>
 
@@ -149,4 +150,63 @@ TEST(SimpleLogProcessorTest, ShutDownFail)
   // Expect failure result when exporter fails to shutdown
   EXPECT_EQ(false, processor.Shutdown());
 }
+
+// A test exporter counting the exports in progress, each waiting for another one to start
+class ConcurrentExporter final : public LogExporter
+{
+public:
+  explicit ConcurrentExporter(bool thread_safe) : thread_safe_(thread_safe) {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new LogRecord());
+  }
+
+  ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &) noexcept override
+  {
+    int exporting = ++exporting_;
+    int max       = max_exporting_.load();
+    while (exporting > max && !max_exporting_.compare_exchange_weak(max, exporting))
+    {
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (max_exporting_.load() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::yield();
+    }
+    --exporting_;
+    return ExportResult::kSuccess;
+  }
+
+  bool IsExportThreadSafe() const noexcept override { return thread_safe_; }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+
+  static std::atomic<int> max_exporting_;
+
+private:
+  bool thread_safe_;
+  std::atomic<int> exporting_{0};
+};
+
+std::atomic<int> ConcurrentExporter::max_exporting_{0};
+
+// Receives a record on each of two threads at once, returning the most exports seen at once.
+int ReceiveConcurrently(bool thread_safe)
+{
+  ConcurrentExporter::max_exporting_ = 0;
+  SimpleLogProcessor processor(std::unique_ptr<LogExporter>(new ConcurrentExporter(thread_safe)));
+  std::thread first([&processor] { processor.OnReceive(processor.MakeRecordable()); });
+  std::thread second([&processor] { processor.OnReceive(processor.MakeRecordable()); });
+  first.join();
+  second.join();
+  return ConcurrentExporter::max_exporting_;
+}
+
+// Tests that only exporters with a thread-safe export are called concurrently
+TEST(SimpleLogProcessorTest, ExportsConcurrentlyForThreadSafeExporters)
+{
+  EXPECT_EQ(2, ReceiveConcurrently(true));
+  EXPECT_EQ(1, ReceiveConcurrently(false));
+}
 #endif
@@ -3,12 +3,19 @@
 
 #ifndef ENABLE_METRICS_PREVIEW
 #  include <gtest/gtest.h>
+#  include "opentelemetry/sdk/metrics/aggregation/exponential_histogram_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/histogram_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/lastvalue_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/sketch_aggregation.h"
 #  include "opentelemetry/sdk/metrics/aggregation/sum_aggregation.h"
 
 #  include "opentelemetry/nostd/variant.h"
 
+#  include <cmath>
+#  include <limits>
+#  include <thread>
+#  include <vector>
+
 using namespace opentelemetry::sdk::metrics;
 namespace nostd = opentelemetry::nostd;
 TEST(Aggregation, LongSumAggregation)
@@ -39,6 +46,46 @@ TEST(Aggregation, DoubleSumAggregation)
   EXPECT_EQ(nostd::get<double>(sum_data.value_), 13.0);
 }
 
+TEST(Aggregation, LongStripedSumAggregationConcurrent)
+{
+  LongStripedSumAggregation aggr;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i)
+  {
+    threads.emplace_back([&aggr] {
+      for (int j = 0; j < 10000; ++j)
+      {
+        aggr.Aggregate(1l, {});
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  auto sum_data = nostd::get<SumPointData>(aggr.ToPoint());
+  EXPECT_EQ(nostd::get<long>(sum_data.value_), 80000l);
+}
+
+TEST(Aggregation, DoubleStripedSumMergeDiff)
+{
+  DoubleStripedSumAggregation aggr1;
+  DoubleStripedSumAggregation aggr2;
+  aggr1.Aggregate(1.5, {});
+  aggr2.Aggregate(1.5, {});
+  aggr2.Aggregate(2.0, {});
+
+  auto merged = aggr1.Merge(aggr2);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(nostd::get<SumPointData>(merged->ToPoint()).value_), 5.0);
+  auto diff = aggr1.Diff(aggr2);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(nostd::get<SumPointData>(diff->ToPoint()).value_), 2.0);
+
+  aggr1.MergeFrom(aggr2);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(nostd::get<SumPointData>(aggr1.ToPoint()).value_), 5.0);
+  DoubleStripedSumAggregation copy(nostd::get<SumPointData>(aggr1.ToPoint()));
+  EXPECT_DOUBLE_EQ(nostd::get<double>(nostd::get<SumPointData>(copy.ToPoint()).value_), 5.0);
+}
+
 TEST(Aggregation, LongLastValueAggregation)
 {
   LongLastValueAggregation aggr;
@@ -74,7 +121,7 @@ TEST(Aggregation, LongHistogramAggregation)
   ASSERT_TRUE(nostd::holds_alternative<HistogramPointData>(data));
   auto histogram_data = nostd::get<HistogramPointData>(data);
   ASSERT_TRUE(nostd::holds_alternative<long>(histogram_data.sum_));
-  ASSERT_TRUE(nostd::holds_alternative<std::list<long>>(histogram_data.boundaries_));
+  ASSERT_TRUE(nostd::holds_alternative<HistogramBoundaries<long>>(histogram_data.boundaries_));
   EXPECT_EQ(nostd::get<long>(histogram_data.sum_), 0);
   EXPECT_EQ(histogram_data.count_, 0);
   EXPECT_NO_THROW(aggr.Aggregate(12l, {}));   // lies in fourth bucket
@@ -130,7 +177,7 @@ TEST(Aggregation, DoubleHistogramAggregation)
   ASSERT_TRUE(nostd::holds_alternative<HistogramPointData>(data));
   auto histogram_data = nostd::get<HistogramPointData>(data);
   ASSERT_TRUE(nostd::holds_alternative<double>(histogram_data.sum_));
-  ASSERT_TRUE(nostd::holds_alternative<std::list<double>>(histogram_data.boundaries_));
+  ASSERT_TRUE(nostd::holds_alternative<HistogramBoundaries<double>>(histogram_data.boundaries_));
   EXPECT_EQ(nostd::get<double>(histogram_data.sum_), 0);
   EXPECT_EQ(histogram_data.count_, 0);
   EXPECT_NO_THROW(aggr.Aggregate(12.0, {}));   // lies in fourth bucket
@@ -179,4 +226,419 @@ TEST(Aggregation, DoubleHistogramAggregation)
   EXPECT_EQ(histogram_data.counts_[4], 0);  // aggr2(28.1) - aggr1(25.1)
   EXPECT_EQ(histogram_data.counts_[7], 1);  // aggr2(105.0) - aggr1(0)
 }
+
+TEST(Aggregation, HistogramAggregationMinMax)
+{
+  LongHistogramAggregation aggr1;
+  aggr1.Aggregate(12l, {});
+  aggr1.Aggregate(-3l, {});
+  aggr1.Aggregate(100l, {});
+  auto histogram_data = nostd::get<HistogramPointData>(aggr1.ToPoint());
+  EXPECT_TRUE(histogram_data.record_min_max_);
+  EXPECT_EQ(nostd::get<long>(histogram_data.min_), -3);
+  EXPECT_EQ(nostd::get<long>(histogram_data.max_), 100);
+
+  // Merge keeps the extremes of both, and ignores an empty aggregation.
+  LongHistogramAggregation aggr2;
+  aggr2.Aggregate(250l, {});
+  aggr2.Aggregate(7l, {});
+  histogram_data = nostd::get<HistogramPointData>(aggr1.Merge(aggr2)->ToPoint());
+  EXPECT_EQ(nostd::get<long>(histogram_data.min_), -3);
+  EXPECT_EQ(nostd::get<long>(histogram_data.max_), 250);
+  LongHistogramAggregation empty;
+  histogram_data = nostd::get<HistogramPointData>(empty.Merge(aggr2)->ToPoint());
+  EXPECT_EQ(nostd::get<long>(histogram_data.min_), 7);
+  EXPECT_EQ(nostd::get<long>(histogram_data.max_), 250);
+  aggr2.MergeFrom(empty);
+  histogram_data = nostd::get<HistogramPointData>(aggr2.ToPoint());
+  EXPECT_EQ(nostd::get<long>(histogram_data.min_), 7);
+  EXPECT_EQ(nostd::get<long>(histogram_data.max_), 250);
+
+  // The extremes of a difference are only known from an empty aggregation.
+  histogram_data = nostd::get<HistogramPointData>(empty.Diff(aggr1)->ToPoint());
+  EXPECT_TRUE(histogram_data.record_min_max_);
+  EXPECT_EQ(nostd::get<long>(histogram_data.min_), -3);
+  EXPECT_EQ(nostd::get<long>(histogram_data.max_), 100);
+  auto merged = aggr1.Merge(aggr2);
+  auto diff   = aggr1.Diff(*merged);
+  EXPECT_FALSE(nostd::get<HistogramPointData>(diff->ToPoint()).record_min_max_);
+  EXPECT_FALSE(nostd::get<HistogramPointData>(aggr2.Merge(*diff)->ToPoint()).record_min_max_);
+
+  DoubleHistogramAggregation aggr3;
+  aggr3.Aggregate(2.5, {});
+  aggr3.Aggregate(-0.5, {});
+  histogram_data = nostd::get<HistogramPointData>(aggr3.ToPoint());
+  EXPECT_DOUBLE_EQ(nostd::get<double>(histogram_data.min_), -0.5);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(histogram_data.max_), 2.5);
+}
+
+TEST(Aggregation, HistogramBucketIndex)
+{
+  // Short list: linear count.
+  std::vector<long> boundaries{0, 5, 10};
+  EXPECT_EQ(HistogramBucketIndex(boundaries, -1l), 0);
+  EXPECT_EQ(HistogramBucketIndex(boundaries, 0l), 1);
+  EXPECT_EQ(HistogramBucketIndex(boundaries, 9l), 2);
+  EXPECT_EQ(HistogramBucketIndex(boundaries, 10l), 3);
+  EXPECT_EQ(HistogramBucketIndex(std::vector<long>{}, 10l), 0);
+
+  // Long list: binary search, checked against the linear count.
+  std::vector<double> many;
+  for (int i = 0; i < 100; i++)
+  {
+    many.push_back(i * 2.5);
+  }
+  for (double value = -5.0; value < 260.0; value += 1.25)
+  {
+    size_t expected = 0;
+    while (expected < many.size() && many[expected] <= value)
+    {
+      ++expected;
+    }
+    EXPECT_EQ(HistogramBucketIndex(many, value), expected) << value;
+  }
+}
+
+TEST(Aggregation, HistogramBoundariesShared)
+{
+  LongHistogramAggregation aggr1;
+  LongHistogramAggregation aggr2;
+  aggr2.Aggregate(12l, {});
+  auto point1 = nostd::get<HistogramPointData>(aggr1.ToPoint());
+  auto point2 = nostd::get<HistogramPointData>(aggr2.ToPoint());
+  auto merged = nostd::get<HistogramPointData>(aggr1.Merge(aggr2)->ToPoint());
+
+  // The series, their points and the merged point all refer to one array.
+  auto &boundaries = nostd::get<HistogramBoundaries<long>>(point1.boundaries_).get();
+  EXPECT_EQ(10, boundaries.size());
+  EXPECT_EQ(&boundaries, &nostd::get<HistogramBoundaries<long>>(point2.boundaries_).get());
+  EXPECT_EQ(&boundaries, &nostd::get<HistogramBoundaries<long>>(merged.boundaries_).get());
+  EXPECT_EQ(1, merged.counts_[3]);
+
+  // Boundaries built from a list are equal to, but distinct from, the shared ones.
+  HistogramBoundaries<long> copy(std::list<long>(boundaries.begin(), boundaries.end()));
+  EXPECT_TRUE(copy == nostd::get<HistogramBoundaries<long>>(point1.boundaries_));
+  EXPECT_NE(&boundaries, &copy.get());
+  EXPECT_TRUE(HistogramBoundaries<double>().empty());
+}
+
+TEST(Aggregation, HistogramAggregationCustomBoundaries)
+{
+  HistogramPointData point;
+  std::list<double> boundaries;
+  for (int i = 1; i <= 32; i++)
+  {
+    boundaries.push_back(i * 10.0);
+  }
+  point.boundaries_ = boundaries;
+  point.counts_     = std::vector<uint64_t>(boundaries.size() + 1, 0);
+  point.sum_        = 0.0;
+  DoubleHistogramAggregation aggr(point);
+  aggr.Aggregate(5.0, {});
+  aggr.Aggregate(155.0, {});
+  aggr.Aggregate(1000.0, {});
+
+  auto histogram_data = nostd::get<HistogramPointData>(aggr.ToPoint());
+  EXPECT_EQ(histogram_data.count_, 3);
+  EXPECT_EQ(nostd::get<HistogramBoundaries<double>>(histogram_data.boundaries_).size(), 32);
+  EXPECT_EQ(histogram_data.counts_[0], 1);
+  EXPECT_EQ(histogram_data.counts_[15], 1);
+  EXPECT_EQ(histogram_data.counts_[32], 1);  // overflow bucket
+
+  // Merge and Diff keep the custom boundaries.
+  DoubleHistogramAggregation aggr2(point);
+  aggr2.Aggregate(315.0, {});
+  auto merged = aggr.Merge(aggr2);
+  merged->Aggregate(25.0, {});
+  histogram_data = nostd::get<HistogramPointData>(merged->ToPoint());
+  EXPECT_EQ(histogram_data.count_, 5);
+  EXPECT_EQ(nostd::get<double>(histogram_data.sum_), 1500.0);
+  EXPECT_EQ(histogram_data.counts_[2], 1);
+  EXPECT_EQ(histogram_data.counts_[31], 1);
+
+  auto diff      = aggr.Diff(*merged);
+  histogram_data = nostd::get<HistogramPointData>(diff->ToPoint());
+  EXPECT_EQ(histogram_data.count_, 2);
+  EXPECT_EQ(nostd::get<double>(histogram_data.sum_), 340.0);
+  EXPECT_EQ(histogram_data.counts_[32], 0);
+}
+
+TEST(Aggregation, ExponentialHistogramIndex)
+{
+  // Buckets are upper-inclusive: 2^i belongs to bucket i - 1 at scale 0.
+  EXPECT_EQ(ExponentialHistogramIndex(1.0, 0), -1);
+  EXPECT_EQ(ExponentialHistogramIndex(1.5, 0), 0);
+  EXPECT_EQ(ExponentialHistogramIndex(2.0, 0), 0);
+  EXPECT_EQ(ExponentialHistogramIndex(3.0, 0), 1);
+  EXPECT_EQ(ExponentialHistogramIndex(0.5, 0), -2);
+  EXPECT_EQ(ExponentialHistogramIndex(4.0, -1), 0);
+  EXPECT_EQ(ExponentialHistogramIndex(5.0, -1), 1);
+  EXPECT_EQ(ExponentialHistogramIndex(std::numeric_limits<double>::denorm_min(), 0), -1075);
+  EXPECT_EQ(ExponentialHistogramIndex(std::numeric_limits<double>::max(), 0), 1023);
+
+  // Positive scales agree with the definition of the buckets.
+  for (int32_t scale = 1; scale <= kExponentialHistogramMaxScale; scale += 3)
+  {
+    for (double value : {1.0, 1.3, 2.0, 7.77, 1024.0, 0.001, 123456.789})
+    {
+      int32_t index = ExponentialHistogramIndex(value, scale);
+      EXPECT_LT(std::pow(2.0, std::ldexp(index, -scale)), value * (1 + 1e-12)) << value;
+      EXPECT_GE(std::pow(2.0, std::ldexp(index + 1, -scale)), value * (1 - 1e-12)) << value;
+    }
+  }
+}
+
+TEST(Aggregation, LongExponentialHistogramAggregation)
+{
+  LongExponentialHistogramAggregation aggr;
+  auto data = aggr.ToPoint();
+  ASSERT_TRUE(nostd::holds_alternative<ExponentialHistogramPointData>(data));
+  auto histogram_data = nostd::get<ExponentialHistogramPointData>(data);
+  EXPECT_EQ(nostd::get<long>(histogram_data.sum_), 0);
+  EXPECT_EQ(histogram_data.count_, 0);
+  EXPECT_EQ(histogram_data.scale_, kExponentialHistogramMaxScale);
+
+  aggr.Aggregate(0l, {});
+  aggr.Aggregate(4l, {});
+  histogram_data = nostd::get<ExponentialHistogramPointData>(aggr.ToPoint());
+  EXPECT_EQ(nostd::get<long>(histogram_data.sum_), 4);
+  EXPECT_EQ(histogram_data.count_, 2);
+  EXPECT_EQ(histogram_data.zero_count_, 1);
+  EXPECT_EQ(histogram_data.scale_, kExponentialHistogramMaxScale);
+  EXPECT_EQ(histogram_data.positive_buckets_.counts_, std::vector<uint64_t>{1});
+  EXPECT_EQ(histogram_data.positive_buckets_.offset_, (2 << kExponentialHistogramMaxScale) - 1);
+}
+
+TEST(Aggregation, DoubleExponentialHistogramAggregationRescales)
+{
+  DoubleExponentialHistogramAggregation aggr(20);
+  double sum = 0;
+  for (int i = 1; i <= 10000; i++)
+  {
+    aggr.Aggregate(static_cast<double>(i), {});
+    aggr.Aggregate(-0.5 * i, {});
+    sum += 0.5 * i;
+  }
+  aggr.Aggregate(std::numeric_limits<double>::quiet_NaN(), {});
+  auto histogram_data = nostd::get<ExponentialHistogramPointData>(aggr.ToPoint());
+  EXPECT_EQ(histogram_data.count_, 20000);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(histogram_data.sum_), sum);
+  EXPECT_LE(histogram_data.positive_buckets_.counts_.size(), 20);
+  EXPECT_LE(histogram_data.negative_buckets_.counts_.size(), 20);
+  // 1..10000 spans more than 13 powers of two: 20 buckets need scale 0.
+  EXPECT_EQ(histogram_data.scale_, 0);
+  uint64_t positive = 0;
+  for (auto count : histogram_data.positive_buckets_.counts_)
+  {
+    positive += count;
+  }
+  EXPECT_EQ(positive, 10000);
+  EXPECT_EQ(histogram_data.positive_buckets_.offset_, -1);      // 1
+  EXPECT_EQ(histogram_data.positive_buckets_.counts_[1], 1);    // 2
+  EXPECT_EQ(histogram_data.positive_buckets_.counts_[2], 2);    // 3, 4
+  EXPECT_EQ(histogram_data.negative_buckets_.offset_, -2);      // 0.5
+}
+
+TEST(Aggregation, DoubleExponentialHistogramMergeDiff)
+{
+  DoubleExponentialHistogramAggregation aggr1;
+  aggr1.Aggregate(1.5, {});
+  aggr1.Aggregate(0.0, {});
+
+  DoubleExponentialHistogramAggregation aggr2(8);
+  for (double value = 1; value < 1000; value *= 3)
+  {
+    aggr2.Aggregate(value, {});
+  }
+  auto histogram_data2 = nostd::get<ExponentialHistogramPointData>(aggr2.ToPoint());
+  EXPECT_LT(histogram_data2.scale_, kExponentialHistogramMaxScale);
+
+  auto aggr3           = aggr1.Merge(aggr2);
+  auto histogram_data3 = nostd::get<ExponentialHistogramPointData>(aggr3->ToPoint());
+  EXPECT_EQ(histogram_data3.count_, 9);
+  EXPECT_EQ(histogram_data3.zero_count_, 1);
+  EXPECT_LE(histogram_data3.scale_, histogram_data2.scale_);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(histogram_data3.sum_), 1.5 + 1 + 3 + 9 + 27 + 81 + 243 + 729);
+
+  auto aggr4           = aggr2.Diff(*aggr3);
+  auto histogram_data4 = nostd::get<ExponentialHistogramPointData>(aggr4->ToPoint());
+  EXPECT_EQ(histogram_data4.count_, 2);
+  EXPECT_EQ(histogram_data4.zero_count_, 1);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(histogram_data4.sum_), 1.5);
+  uint64_t positive = 0;
+  for (size_t i = 0; i < histogram_data4.positive_buckets_.counts_.size(); i++)
+  {
+    positive += histogram_data4.positive_buckets_.counts_[i];
+    if (histogram_data4.positive_buckets_.counts_[i] != 0)
+    {
+      EXPECT_EQ(histogram_data4.positive_buckets_.offset_ + static_cast<int32_t>(i),
+                ExponentialHistogramIndex(1.5, histogram_data4.scale_));
+    }
+  }
+  EXPECT_EQ(positive, 1);
+}
+
+TEST(Aggregation, SketchIndex)
+{
+  for (double accuracy : {0.001, 0.01, 0.05})
+  {
+    double multiplier = SketchIndexMultiplier(accuracy);
+    double gamma      = (1 + accuracy) / (1 - accuracy);
+    for (double value : {1.0, 1.3, 2.0, 7.77, 1024.0, 0.001, 123456.789})
+    {
+      int32_t index = SketchIndex(value, multiplier);
+      EXPECT_LT(std::pow(gamma, index - 1), value * (1 + 1e-12)) << value;
+      EXPECT_GE(std::pow(gamma, index), value * (1 - 1e-12)) << value;
+      EXPECT_LE(std::fabs(SketchValue(index, accuracy) - value), value * accuracy * (1 + 1e-9))
+          << value;
+    }
+  }
+}
+
+TEST(Aggregation, DoubleSketchAggregationQuantiles)
+{
+  DoubleSketchAggregation aggr;
+  auto sketch_data = nostd::get<SketchPointData>(aggr.ToPoint());
+  EXPECT_EQ(sketch_data.count_, 0);
+  EXPECT_EQ(sketch_data.relative_accuracy_, kSketchRelativeAccuracy);
+  EXPECT_TRUE(std::isnan(SketchQuantile(sketch_data, 0.5)));
+
+  for (int i = 1; i <= 10000; i++)
+  {
+    aggr.Aggregate(static_cast<double>(i), {});
+  }
+  aggr.Aggregate(0.0, {});
+  aggr.Aggregate(-5.0, {});
+  aggr.Aggregate(std::numeric_limits<double>::quiet_NaN(), {});
+  sketch_data = nostd::get<SketchPointData>(aggr.ToPoint());
+  EXPECT_EQ(sketch_data.count_, 10002);
+  EXPECT_EQ(sketch_data.zero_count_, 1);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(sketch_data.sum_), 50005000.0 - 5.0);
+  EXPECT_EQ(sketch_data.min_, -5.0);
+  EXPECT_EQ(sketch_data.max_, 10000.0);
+
+  // Ranks are q * (count - 1): the sorted values are -5, 0, 1, 2, ...
+  EXPECT_EQ(SketchQuantile(sketch_data, 0), -5.0);
+  EXPECT_EQ(SketchQuantile(sketch_data, 1), 10000.0);
+  EXPECT_NEAR(SketchQuantile(sketch_data, 0.0001), 0.0, 1e-12);
+  EXPECT_NEAR(SketchQuantile(sketch_data, 0.5), 4999.0, 4999.0 * kSketchRelativeAccuracy);
+  EXPECT_NEAR(SketchQuantile(sketch_data, 0.99), 9900.0, 9900.0 * kSketchRelativeAccuracy);
+}
+
+TEST(Aggregation, LongSketchAggregationCollapses)
+{
+  LongSketchAggregation aggr(0.01, 64);
+  for (long i = 1; i <= 100000; i++)
+  {
+    aggr.Aggregate(i, {});
+  }
+  auto sketch_data = nostd::get<SketchPointData>(aggr.ToPoint());
+  EXPECT_EQ(sketch_data.count_, 100000);
+  EXPECT_EQ(nostd::get<long>(sketch_data.sum_), 5000050000l);
+  EXPECT_LE(sketch_data.positive_buckets_.counts_.size(), 64);
+  uint64_t positive = 0;
+  for (auto count : sketch_data.positive_buckets_.counts_)
+  {
+    positive += count;
+  }
+  EXPECT_EQ(positive, 100000);
+  // The lowest values were collapsed, the high quantiles keep their accuracy.
+  EXPECT_NEAR(SketchQuantile(sketch_data, 0.99), 99000.0, 99000.0 * 0.01);
+  EXPECT_NEAR(SketchQuantile(sketch_data, 0.9), 90000.0, 90000.0 * 0.01);
+}
+
+TEST(Aggregation, DoubleSketchMergeDiff)
+{
+  DoubleSketchAggregation aggr1;
+  aggr1.Aggregate(1.5, {});
+  aggr1.Aggregate(0.0, {});
+
+  DoubleSketchAggregation aggr2;
+  for (double value = 1; value < 1000; value *= 3)
+  {
+    aggr2.Aggregate(value, {});
+    aggr2.Aggregate(-value, {});
+  }
+
+  auto aggr3        = aggr1.Merge(aggr2);
+  auto sketch_data3 = nostd::get<SketchPointData>(aggr3->ToPoint());
+  EXPECT_EQ(sketch_data3.count_, 16);
+  EXPECT_EQ(sketch_data3.zero_count_, 1);
+  EXPECT_EQ(sketch_data3.min_, -729.0);
+  EXPECT_EQ(sketch_data3.max_, 729.0);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(sketch_data3.sum_), 1.5);
+
+  aggr1.MergeFrom(aggr2);
+  auto sketch_data1 = nostd::get<SketchPointData>(aggr1.ToPoint());
+  EXPECT_EQ(sketch_data1.positive_buckets_.counts_, sketch_data3.positive_buckets_.counts_);
+  EXPECT_EQ(sketch_data1.negative_buckets_.counts_, sketch_data3.negative_buckets_.counts_);
+
+  auto aggr4        = aggr2.Diff(*aggr3);
+  auto sketch_data4 = nostd::get<SketchPointData>(aggr4->ToPoint());
+  EXPECT_EQ(sketch_data4.count_, 2);
+  EXPECT_EQ(sketch_data4.zero_count_, 1);
+  EXPECT_DOUBLE_EQ(nostd::get<double>(sketch_data4.sum_), 1.5);
+  uint64_t positive = 0;
+  for (size_t i = 0; i < sketch_data4.positive_buckets_.counts_.size(); i++)
+  {
+    positive += sketch_data4.positive_buckets_.counts_[i];
+    if (sketch_data4.positive_buckets_.counts_[i] != 0)
+    {
+      EXPECT_EQ(sketch_data4.positive_buckets_.offset_ + static_cast<int32_t>(i),
+                SketchIndex(1.5, SketchIndexMultiplier(kSketchRelativeAccuracy)));
+    }
+  }
+  EXPECT_EQ(positive, 1);
+  for (auto count : sketch_data4.negative_buckets_.counts_)
+  {
+    EXPECT_EQ(count, 0);
+  }
+}
+
+TEST(Aggregation, MergeFrom)
+{
+  LongSumAggregation sum1, sum2;
+  sum1.Aggregate(3l, {});
+  sum2.Aggregate(4l, {});
+  sum1.MergeFrom(sum2);
+  EXPECT_EQ(nostd::get<long>(nostd::get<SumPointData>(sum1.ToPoint()).value_), 7);
+  EXPECT_EQ(nostd::get<long>(nostd::get<SumPointData>(sum2.ToPoint()).value_), 4);
+
+  DoubleLastValueAggregation last1, last2, empty;
+  last1.Aggregate(1.5, {});
+  last2.Aggregate(2.5, {});
+  last1.MergeFrom(last2);
+  last1.MergeFrom(empty);
+  auto last_data = nostd::get<LastValuePointData>(last1.ToPoint());
+  EXPECT_TRUE(last_data.is_lastvalue_valid_);
+  EXPECT_EQ(nostd::get<double>(last_data.value_), 2.5);
+
+  LongHistogramAggregation histogram1, histogram2;
+  histogram1.Aggregate(1l, {});
+  histogram2.Aggregate(30l, {});
+  histogram2.Aggregate(2l, {});
+  auto merged = histogram1.Merge(histogram2);
+  histogram1.MergeFrom(histogram2);
+  auto histogram_data = nostd::get<HistogramPointData>(histogram1.ToPoint());
+  auto merged_data    = nostd::get<HistogramPointData>(merged->ToPoint());
+  EXPECT_EQ(histogram_data.count_, 3);
+  EXPECT_EQ(nostd::get<long>(histogram_data.sum_), 33);
+  EXPECT_EQ(histogram_data.counts_, merged_data.counts_);
+
+  DoubleExponentialHistogramAggregation exponential1, exponential2(4);
+  exponential1.Aggregate(1.5, {});
+  for (double value = 1; value < 1000; value *= 2)
+  {
+    exponential2.Aggregate(value, {});
+  }
+  auto exponential_merged = exponential1.Merge(exponential2);
+  exponential1.MergeFrom(exponential2);
+  auto exponential_data = nostd::get<ExponentialHistogramPointData>(exponential1.ToPoint());
+  auto exponential_merged_data =
+      nostd::get<ExponentialHistogramPointData>(exponential_merged->ToPoint());
+  EXPECT_EQ(exponential_data.count_, 11);
+  EXPECT_EQ(exponential_data.scale_, exponential_merged_data.scale_);
+  EXPECT_EQ(exponential_data.positive_buckets_.counts_,
+            exponential_merged_data.positive_buckets_.counts_);
+}
 #endif
@@ -12,6 +12,9 @@
 #  include "opentelemetry/sdk/metrics/state/metric_collector.h"
 
 #  include <gtest/gtest.h>
+#  include <atomic>
+#  include <chrono>
+#  include <thread>
 #  include <vector>
 
 using namespace opentelemetry::sdk::metrics;
@@ -129,4 +132,173 @@ INSTANTIATE_TEST_SUITE_P(WritableMetricStorageTestLong,
                          ::testing::Values(AggregationTemporality::kCumulative,
                                            AggregationTemporality::kDelta));
 
-#endif
\ No newline at end of file
+static void ThreeSeriesFetcher(opentelemetry::metrics::ObserverResult<long> &observer_result,
+                               void * /*state*/)
+{
+  observer_result.Observe(20l, {{"RequestType", "GET"}});
+  observer_result.Observe(10l, {{"RequestType", "PUT"}});
+  observer_result.Observe(5l, {{"RequestType", "POST"}});
+}
+
+TEST(AsyncMetricStorageTest, CardinalityLimit)
+{
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kObservableCounter,
+                                     InstrumentValueType::kLong};
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kDelta));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  opentelemetry::sdk::metrics::AsyncMetricStorage<long> storage(
+      instr_desc, AggregationType::kSum, ThreeSeriesFetcher, new DefaultAttributesProcessor(),
+      nullptr, 2);
+
+  size_t count_attributes = 0;
+  size_t count_overflow   = 0;
+  long total              = 0;
+  storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                  [&](const MetricData data) {
+                    for (auto data_attr : data.point_data_attr_)
+                    {
+                      auto data = opentelemetry::nostd::get<SumPointData>(data_attr.point_data);
+                      total += opentelemetry::nostd::get<long>(data.value_);
+                      count_attributes++;
+                      if (data_attr.attributes == AttributesHashMap::GetOverflowAttributes())
+                      {
+                        count_overflow++;
+                      }
+                    }
+                    return true;
+                  });
+  // One series of its own, the other two observations folded into the overflow series.
+  EXPECT_EQ(count_attributes, 2);
+  EXPECT_EQ(count_overflow, 1);
+  EXPECT_EQ(total, 35l);
+}
+
+static void GrowingCounterFetcher(opentelemetry::metrics::ObserverResult<long> &observer_result,
+                                  void *state)
+{
+  long &count = *static_cast<long *>(state);
+  ++count;
+  observer_result.Observe(10 * count, {{"RequestType", "GET"}});
+  if (count >= 2)
+  {
+    observer_result.Observe(count, {{"RequestType", "PUT"}});
+  }
+}
+
+TEST_P(WritableMetricStorageTestFixture, CumulativeObservationsToDelta)
+{
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kObservableCounter,
+                                     InstrumentValueType::kLong};
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+
+  AggregationTemporality temporality = GetParam();
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  long count = 0;
+  opentelemetry::sdk::metrics::AsyncMetricStorage<long> storage(
+      instr_desc, AggregationType::kDefault, GrowingCounterFetcher,
+      new DefaultAttributesProcessor(), &count);
+
+  auto collect = [&]() {
+    std::map<std::string, long> values;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        auto data = opentelemetry::nostd::get<SumPointData>(data_attr.point_data);
+                        values[opentelemetry::nostd::get<std::string>(
+                            data_attr.attributes.find("RequestType")->second)] =
+                            opentelemetry::nostd::get<long>(data.value_);
+                      }
+                      return true;
+                    });
+    return values;
+  };
+
+  // The observations are cumulative: delta collectors get their increase since the last
+  // collection, cumulative collectors the observations themselves.
+  bool delta  = temporality == AggregationTemporality::kDelta;
+  auto values = collect();
+  EXPECT_EQ(10l, values["GET"]);
+  EXPECT_EQ(0, values.count("PUT"));
+  values = collect();
+  EXPECT_EQ(delta ? 10l : 20l, values["GET"]);
+  EXPECT_EQ(2l, values["PUT"]);
+  values = collect();
+  EXPECT_EQ(delta ? 10l : 30l, values["GET"]);
+  EXPECT_EQ(delta ? 1l : 3l, values["PUT"]);
+}
+
+class SlowFetcher
+{
+public:
+  static void Fetcher(opentelemetry::metrics::ObserverResult<long> &observer_result,
+                      void * /*state*/)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms.load()));
+    long count = ++fetch_count;
+    observer_result.Observe(count * 10, {{"RequestType", "GET"}});
+  }
+
+  static std::atomic<long> fetch_count;
+  static std::atomic<int> delay_ms;
+};
+
+std::atomic<long> SlowFetcher::fetch_count{0};
+std::atomic<int> SlowFetcher::delay_ms{0};
+
+TEST(AsyncMetricStorageTest, CallbackTimeout)
+{
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kObservableGauge,
+                                     InstrumentValueType::kLong};
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  ObservableCallbackExecutor executor(2);
+  opentelemetry::sdk::metrics::AsyncMetricStorage<long> storage(
+      instr_desc, AggregationType::kLastValue, SlowFetcher::Fetcher,
+      new DefaultAttributesProcessor(), nullptr);
+  storage.SetCallbackExecutor(&executor, std::chrono::milliseconds(50));
+
+  auto collect = [&]() {
+    long value = -1;
+    storage.BeginCollect();
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        auto data =
+                            opentelemetry::nostd::get<LastValuePointData>(data_attr.point_data);
+                        value = opentelemetry::nostd::get<long>(data.value_);
+                      }
+                      return true;
+                    });
+    return value;
+  };
+
+  // A callback completing in time reports its observations.
+  EXPECT_EQ(collect(), 10l);
+
+  // A late callback is not waited for; the last observations are reported instead.
+  SlowFetcher::delay_ms = 500;
+  EXPECT_EQ(collect(), 10l);
+  EXPECT_EQ(SlowFetcher::fetch_count.load(), 1l);
+
+  // Once it completes, the next collection reports its observations without running it again.
+  SlowFetcher::delay_ms = 0;
+  std::this_thread::sleep_for(std::chrono::milliseconds(700));
+  EXPECT_EQ(SlowFetcher::fetch_count.load(), 2l);
+  EXPECT_EQ(collect(), 20l);
+  EXPECT_EQ(SlowFetcher::fetch_count.load(), 2l);
+  EXPECT_GE(storage.GetLastCallbackDuration(), std::chrono::milliseconds(500));
+
+  EXPECT_EQ(collect(), 30l);
+}
+
+#endif
@@ -48,6 +48,32 @@ void BM_AttributseHashMap(benchmark::State &state)
 }
 
 BENCHMARK(BM_AttributseHashMap);
+
+// Records into a few existing series from several threads at once, which is the hot path of a
+// synchronous instrument.
+void BM_AttributesHashMapMultiThreaded(benchmark::State &state)
+{
+  static AttributesHashMap hash_map;
+  static const std::vector<MetricAttributes> attributes = {
+      {{"k1", "v1"}, {"k2", "v2"}},
+      {{"k1", "v1"}, {"k2", "v2"}, {"k3", "v3"}},
+      {{"k1", "v2"}, {"k2", "v2"}},
+      {{"k1", "v2"}, {"k2", "v2"}, {"k3", "v3"}}};
+
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    hash_map.GetOrSetDefault(attributes[i++ % attributes.size()], create_default_aggregation)
+        ->Aggregate(1l);
+  }
+}
+
+BENCHMARK(BM_AttributesHashMapMultiThreaded)->ThreadRange(1, 16);
 }  // namespace
 #endif
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -4,10 +4,19 @@
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/state/attributes_hashmap.h"
 #  include <gtest/gtest.h>
+#  include "opentelemetry/sdk/common/memory_budget.h"
 #  include "opentelemetry/sdk/metrics/aggregation/drop_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/sum_aggregation.h"
 #  include "opentelemetry/sdk/metrics/instruments.h"
+#  include "opentelemetry/sdk/metrics/state/double_buffered_attributes_hashmap.h"
+#  include "opentelemetry/sdk/metrics/state/partitioned_attributes_hashmap.h"
 
+#  include <atomic>
 #  include <functional>
+#  include <map>
+#  include <string>
+#  include <thread>
+#  include <vector>
 
 using namespace opentelemetry::sdk::metrics;
 namespace nostd = opentelemetry::nostd;
@@ -68,4 +77,244 @@ TEST(AttributesHashMap, BasicTests)
   EXPECT_EQ(count, hash_map.Size());
 }
 
-#endif
\ No newline at end of file
+TEST(AttributesHashMap, GetOrSetDefaultKeyValueIterable)
+{
+  AttributesHashMap hash_map;
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+  DefaultAttributesProcessor default_processor;
+  FilteringAttributesProcessor filtering_processor({{"k1", true}});
+
+  std::map<std::string, std::string> attributes = {{"k2", "v2"}, {"k1", "v1"}};
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, std::string>> iterable(
+      attributes);
+
+  Aggregation *aggregation =
+      hash_map.GetOrSetDefault(iterable, &default_processor, create_default_aggregation);
+  EXPECT_EQ(hash_map.Size(), 1);
+  EXPECT_EQ(aggregation, hash_map.Get({{"k1", "v1"}, {"k2", "v2"}}));
+  EXPECT_EQ(aggregation,
+            hash_map.GetOrSetDefault(iterable, &default_processor, create_default_aggregation));
+  EXPECT_EQ(hash_map.Size(), 1);
+
+  // The filtered series is a different one.
+  Aggregation *filtered =
+      hash_map.GetOrSetDefault(iterable, &filtering_processor, create_default_aggregation);
+  EXPECT_NE(aggregation, filtered);
+  EXPECT_EQ(filtered, hash_map.Get({{"k1", "v1"}}));
+  EXPECT_EQ(filtered,
+            hash_map.GetOrSetDefault(iterable, &filtering_processor, create_default_aggregation));
+  EXPECT_EQ(hash_map.Size(), 2);
+}
+
+TEST(AttributesHashMap, ConcurrentGetOrSetDefault)
+{
+  AttributesHashMap hash_map(4);
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+
+  const size_t num_threads = 8;
+  const size_t num_series  = 64;
+  std::vector<std::vector<Aggregation *>> results(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++)
+  {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < num_series; i++)
+      {
+        MetricAttributes attributes = {{"series", static_cast<int64_t>(i)}};
+        results[t].push_back(hash_map.GetOrSetDefault(attributes, create_default_aggregation));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // Every thread must have observed the same aggregation for a given series.
+  EXPECT_EQ(hash_map.Size(), num_series);
+  for (size_t i = 0; i < num_series; i++)
+  {
+    MetricAttributes attributes = {{"series", static_cast<int64_t>(i)}};
+    for (size_t t = 0; t < num_threads; t++)
+    {
+      EXPECT_EQ(results[t][i], hash_map.Get(attributes));
+    }
+  }
+}
+
+TEST(AttributesHashMap, AttributesLimit)
+{
+  AttributesHashMap hash_map(4, 3);
+  size_t created = 0;
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      [&created]() -> std::unique_ptr<Aggregation> {
+    created++;
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+
+  Aggregation *first  = hash_map.GetOrSetDefault({{"k", "1"}}, create_default_aggregation);
+  Aggregation *second = hash_map.GetOrSetDefault({{"k", "2"}}, create_default_aggregation);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(hash_map.OverflowCount(), 0);
+
+  // New attribute sets past the limit share the overflow series.
+  Aggregation *overflow = hash_map.GetOrSetDefault({{"k", "3"}}, create_default_aggregation);
+  EXPECT_EQ(overflow, hash_map.Get(AttributesHashMap::GetOverflowAttributes()));
+  EXPECT_EQ(overflow, hash_map.GetOrSetDefault({{"k", "4"}}, create_default_aggregation));
+  EXPECT_EQ(hash_map.OverflowCount(), 2);
+  EXPECT_FALSE(hash_map.Has({{"k", "3"}}));
+
+  // Existing series are still found.
+  EXPECT_EQ(first, hash_map.GetOrSetDefault({{"k", "1"}}, create_default_aggregation));
+  EXPECT_EQ(hash_map.Size(), 3);
+  EXPECT_EQ(created, 3);
+}
+
+TEST(AttributesHashMap, MemoryBudget)
+{
+  // Room for two series {"k", "n"} at the normal priority, but not three.
+  auto budget = std::make_shared<opentelemetry::sdk::common::MemoryBudget>(1000);
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+  {
+    AttributesHashMap hash_map(4, kAggregationCardinalityLimit, budget);
+    hash_map.GetOrSetDefault({{"k", "1"}}, create_default_aggregation);
+    hash_map.GetOrSetDefault({{"k", "2"}}, create_default_aggregation);
+    EXPECT_EQ(budget->GetUsage(), 2 * AttributesHashMap::EstimateSeriesBytes({{"k", "1"}}));
+    EXPECT_EQ(hash_map.OverflowCount(), 0);
+
+    // The charge of a new series is refused: it gets the overflow series, which is always charged.
+    Aggregation *overflow = hash_map.GetOrSetDefault({{"k", "3"}}, create_default_aggregation);
+    EXPECT_EQ(overflow, hash_map.Get(AttributesHashMap::GetOverflowAttributes()));
+    EXPECT_EQ(hash_map.OverflowCount(), 1);
+    EXPECT_EQ(budget->GetRefusedCount(), 1);
+    EXPECT_EQ(hash_map.Size(), 3);
+
+    size_t usage = budget->GetUsage();
+    hash_map.EraseIf([](const MetricAttributes &attributes, Aggregation &) {
+      return attributes == MetricAttributes{{"k", "1"}};
+    });
+    EXPECT_EQ(budget->GetUsage(), usage - AttributesHashMap::EstimateSeriesBytes({{"k", "1"}}));
+  }
+  EXPECT_EQ(budget->GetUsage(), 0);
+}
+
+TEST(AttributesHashMap, MergeWithStoredHashes)
+{
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new DropAggregation);
+  };
+  AttributesHashMap source;
+  source.GetOrSetDefault({{"k", "1"}}, create_default_aggregation);
+  source.GetOrSetDefault({{"k", "2"}, {"j", 2}}, create_default_aggregation);
+
+  AttributesHashMap target;
+  Aggregation *existing = target.GetOrSetDefault({{"k", "1"}}, create_default_aggregation);
+  size_t visited        = 0;
+  source.GetAllEntriesWithHash(
+      [&](size_t hash, const MetricAttributes &attributes, Aggregation &) {
+        EXPECT_EQ(hash, opentelemetry::sdk::common::GetHashForAttributeMap(attributes));
+        target.GetOrSetDefault(hash, attributes, create_default_aggregation);
+        visited++;
+        return true;
+      });
+  EXPECT_EQ(visited, 2);
+  EXPECT_EQ(target.Size(), 2);
+  EXPECT_EQ(target.Get({{"k", "1"}}), existing);
+  EXPECT_TRUE(target.Has({{"k", "2"}, {"j", 2}}));
+}
+
+TEST(DoubleBufferedAttributesHashMap, ConcurrentUpdateAndSwap)
+{
+  DoubleBufferedAttributesHashMap hash_map;
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new LongSumAggregation);
+  };
+  auto sum_of = [](AttributesHashMap &map) {
+    long sum = 0;
+    map.GetAllEnteries([&](const MetricAttributes &, Aggregation &aggregation) {
+      sum += nostd::get<long>(nostd::get<SumPointData>(aggregation.ToPoint()).value_);
+      return true;
+    });
+    return sum;
+  };
+
+  const size_t num_threads    = 4;
+  const size_t num_recordings = 10000;
+  std::atomic<size_t> running_threads(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++)
+  {
+    threads.emplace_back([&, t]() {
+      MetricAttributes attributes = {{"thread", static_cast<int64_t>(t)}};
+      for (size_t i = 0; i < num_recordings; i++)
+      {
+        hash_map.Update([&](AttributesHashMap &map) {
+          map.GetOrSetDefault(attributes, create_default_aggregation)->Aggregate(1l);
+        });
+      }
+      running_threads--;
+    });
+  }
+
+  // No recording may be lost or land in a map after it has been swapped out.
+  long collected = 0;
+  while (running_threads > 0)
+  {
+    collected += sum_of(*hash_map.Swap());
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  collected += sum_of(*hash_map.Swap());
+  EXPECT_EQ(collected, static_cast<long>(num_threads * num_recordings));
+}
+
+TEST(PartitionedAttributesHashMap, SwapMergesPartitions)
+{
+  PartitionedAttributesHashMap hash_map(3, 2);
+  EXPECT_EQ(hash_map.GetPartitionCount(), 2);
+  std::function<std::unique_ptr<Aggregation>()> create_default_aggregation =
+      []() -> std::unique_ptr<Aggregation> {
+    return std::unique_ptr<Aggregation>(new LongSumAggregation);
+  };
+  auto add = [&](size_t partition, const MetricAttributes &attributes, long value) {
+    hash_map.Update(partition, [&](AttributesHashMap &map) {
+      map.GetOrSetDefault(attributes, create_default_aggregation)->Aggregate(value);
+    });
+  };
+  add(0, {{"k", "1"}}, 1);
+  add(1, {{"k", "1"}}, 2);
+  add(1, {{"k", "2"}}, 4);
+  // Within the limit of its partition, but not of the merged map.
+  add(0, {{"k", "3"}}, 8);
+  add(1, {{"k", "4"}}, 16);
+
+  size_t overflow_count = 0;
+  auto merged           = hash_map.Swap(create_default_aggregation, overflow_count);
+  auto value_of         = [&](const MetricAttributes &attributes) {
+    return nostd::get<long>(nostd::get<SumPointData>(merged->Get(attributes)->ToPoint()).value_);
+  };
+  EXPECT_EQ(merged->Size(), 3);
+  EXPECT_EQ(value_of({{"k", "1"}}), 3);
+  EXPECT_EQ(value_of({{"k", "3"}}), 8);
+  EXPECT_EQ(value_of(AttributesHashMap::GetOverflowAttributes()), 20);
+  EXPECT_EQ(overflow_count, 2);
+
+  // The partitions are empty after the swap.
+  EXPECT_EQ(hash_map.Swap(create_default_aggregation, overflow_count)->Size(), 0);
+  EXPECT_EQ(overflow_count, 0);
+}
+
+#endif
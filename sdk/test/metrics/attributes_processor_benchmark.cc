@@ -4,6 +4,7 @@
 #include <benchmark/benchmark.h>
 #ifndef ENABLE_METRICS_PREVIEW
 #  include <map>
+#  include "opentelemetry/sdk/common/attributemap_hash.h"
 #  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
 using namespace opentelemetry::sdk::metrics;
 namespace
@@ -22,6 +23,28 @@ void BM_AttributseProcessorFilter(benchmark::State &state)
 }
 
 BENCHMARK(BM_AttributseProcessorFilter);
+
+// The lookup key of an existing series, hashed from the filtered attributes as
+// AttributesHashMap::GetOrSetDefault does.
+void BM_AttributesProcessorFilteredHash(benchmark::State &state)
+{
+  std::map<std::string, int> attributes = {{"http.method", 1},      {"http.route", 2},
+                                           {"http.status_code", 3}, {"net.peer.name", 4},
+                                           {"net.peer.port", 5},    {"user_agent", 6}};
+  FilteringAttributesProcessor attributes_processor(
+      {{"http.method", true}, {"http.route", true}, {"http.status_code", true}});
+  opentelemetry::common::KeyValueIterableView<std::map<std::string, int>> iterable(attributes);
+  auto is_key_present = [&attributes_processor](opentelemetry::nostd::string_view key) {
+    return attributes_processor.isPresent(key);
+  };
+  while (state.KeepRunning())
+  {
+    benchmark::DoNotOptimize(
+        opentelemetry::sdk::common::GetHashForAttributeMap(iterable, is_key_present));
+  }
+}
+
+BENCHMARK(BM_AttributesProcessorFilteredHash);
 }  // namespace
 #endif
 BENCHMARK_MAIN();
@@ -46,4 +46,52 @@ TEST(AttributesProcessor, FilteringAllAttributesProcessor)
   EXPECT_EQ(filter.size(), kNumFilterAttributes);
 }
 
+TEST(AttributesProcessor, FilteringAttributesProcessorIsPresent)
+{
+  std::unordered_map<std::string, bool> filter;
+  for (int i = 0; i < 100; ++i)
+  {
+    filter["key" + std::to_string(i)] = true;
+  }
+  filter[""]                                = true;
+  filter[std::string(100, 'x')]             = true;
+  FilteringAttributesProcessor attributes_processor(filter);
+  for (auto &kv : filter)
+  {
+    EXPECT_TRUE(attributes_processor.isPresent(kv.first));
+  }
+  EXPECT_FALSE(attributes_processor.isPresent("key100"));
+  EXPECT_FALSE(attributes_processor.isPresent("kez1"));
+  EXPECT_FALSE(attributes_processor.isPresent("key"));
+  EXPECT_FALSE(attributes_processor.isPresent(std::string(99, 'x')));
+  EXPECT_FALSE(attributes_processor.isPresent(std::string(101, 'x')));
+  EXPECT_FALSE(FilteringAttributesProcessor().isPresent(""));
+}
+
+TEST(AttributesProcessor, IsPresentFromProcess)
+{
+  // A processor only overriding process() keeps the keys that process() keeps.
+  class KeepShortKeysProcessor : public AttributesProcessor
+  {
+  public:
+    MetricAttributes process(const KeyValueIterable &attributes) const noexcept override
+    {
+      MetricAttributes result;
+      attributes.ForEachKeyValue(
+          [&](opentelemetry::nostd::string_view key, AttributeValue value) noexcept {
+            if (key.size() <= 3)
+            {
+              result.SetAttribute(key, value);
+            }
+            return true;
+          });
+      return result;
+    }
+  };
+
+  KeepShortKeysProcessor attributes_processor;
+  EXPECT_TRUE(attributes_processor.isPresent("key"));
+  EXPECT_FALSE(attributes_processor.isPresent("key1"));
+}
+
 #endif
@@ -0,0 +1,210 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/state/columnar_sum_metric_storage.h"
+#  include "opentelemetry/common/key_value_iterable_view.h"
+#  include "opentelemetry/sdk/metrics/instruments.h"
+#  include "opentelemetry/sdk/metrics/view/attributes_processor.h"
+
+#  include <gtest/gtest.h>
+#  include <map>
+#  include <thread>
+
+using namespace opentelemetry::sdk::metrics;
+using namespace opentelemetry::common;
+using M = std::map<std::string, std::string>;
+
+namespace
+{
+class MockCollectorHandle : public CollectorHandle
+{
+public:
+  MockCollectorHandle(AggregationTemporality temp, size_t unchanged_keepalive = 0)
+      : temporality(temp), unchanged_keepalive(unchanged_keepalive)
+  {}
+
+  AggregationTemporality GetAggregationTemporality() noexcept override { return temporality; }
+
+  size_t GetUnchangedSeriesKeepalive() noexcept override { return unchanged_keepalive; }
+
+private:
+  AggregationTemporality temporality;
+  size_t unchanged_keepalive;
+};
+
+/* The value of each series collected, keyed by its "RequestType" attribute. */
+template <class T>
+std::map<std::string, T> Collect(ColumnarSumMetricStorage<T> &storage,
+                                 CollectorHandle *collector,
+                                 std::vector<std::shared_ptr<CollectorHandle>> &collectors)
+{
+  std::map<std::string, T> values;
+  auto now = std::chrono::system_clock::now();
+  storage.Collect(collector, collectors, now, now, [&values](MetricData &data) {
+    for (auto &point : data.point_data_attr_)
+    {
+      auto it         = point.attributes.find("RequestType");
+      std::string key = it == point.attributes.end()
+                            ? ""
+                            : opentelemetry::nostd::get<std::string>(it->second);
+      auto value      = opentelemetry::nostd::get<SumPointData>(point.point_data).value_;
+      values[key]     = opentelemetry::nostd::get<T>(value);
+    }
+    return true;
+  });
+  return values;
+}
+}  // namespace
+
+class ColumnarSumMetricStorageTest : public ::testing::TestWithParam<AggregationTemporality>
+{};
+
+TEST_P(ColumnarSumMetricStorageTest, LongSum)
+{
+  AggregationTemporality temporality = GetParam();
+  InstrumentDescriptor instr_desc    = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  DefaultAttributesProcessor processor;
+  ColumnarSumMetricStorage<long> storage(instr_desc, &processor);
+  M get = {{"RequestType", "GET"}};
+  M put = {{"RequestType", "PUT"}};
+  opentelemetry::context::Context context;
+
+  storage.RecordLong(10l, KeyValueIterableView<M>(get), context);
+  storage.RecordLong(30l, KeyValueIterableView<M>(put), context);
+  storage.RecordLong(20l, KeyValueIterableView<M>(get), context);
+  storage.RecordLong(5l, context);
+  // Values of another type are ignored.
+  storage.RecordDouble(100.0, KeyValueIterableView<M>(get), context);
+
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  auto values = Collect(storage, collector.get(), collectors);
+  EXPECT_EQ(3, values.size());
+  EXPECT_EQ(30l, values["GET"]);
+  EXPECT_EQ(30l, values["PUT"]);
+  EXPECT_EQ(5l, values[""]);
+
+  storage.RecordLong(50l, KeyValueIterableView<M>(get), context);
+  values = Collect(storage, collector.get(), collectors);
+  if (temporality == AggregationTemporality::kDelta)
+  {
+    // Only the series recorded into since the previous collection.
+    EXPECT_EQ(1, values.size());
+    EXPECT_EQ(50l, values["GET"]);
+  }
+  else
+  {
+    EXPECT_EQ(3, values.size());
+    EXPECT_EQ(80l, values["GET"]);
+    EXPECT_EQ(30l, values["PUT"]);
+  }
+  EXPECT_EQ(3, storage.GetSeriesCount());
+}
+
+TEST_P(ColumnarSumMetricStorageTest, DoubleSumConcurrentBound)
+{
+  AggregationTemporality temporality = GetParam();
+  InstrumentDescriptor instr_desc    = {"name", "desc", "1unit", InstrumentType::kUpDownCounter,
+                                     InstrumentValueType::kDouble};
+  DefaultAttributesProcessor processor;
+  ColumnarSumMetricStorage<double> storage(instr_desc, &processor);
+  M get = {{"RequestType", "GET"}};
+  auto bound = storage.Bind(KeyValueIterableView<M>(get));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&storage, &bound, &get]() {
+      opentelemetry::context::Context context;
+      for (int j = 0; j < 1000; ++j)
+      {
+        bound->RecordDouble(1.0, context);
+        storage.RecordDouble(-0.5, KeyValueIterableView<M>(get), context);
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  auto values = Collect(storage, collector.get(), collectors);
+  EXPECT_EQ(1, values.size());
+  EXPECT_DOUBLE_EQ(2000.0, values["GET"]);
+}
+
+INSTANTIATE_TEST_SUITE_P(ColumnarSumMetricStorageTestTemporality,
+                         ColumnarSumMetricStorageTest,
+                         ::testing::Values(AggregationTemporality::kCumulative,
+                                           AggregationTemporality::kDelta));
+
+TEST(ColumnarSumMetricStorage, Overflow)
+{
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  DefaultAttributesProcessor processor;
+  // More series than a block, the last one being the overflow series.
+  const size_t limit = kColumnarStorageBlockSize + 10;
+  ColumnarSumMetricStorage<long> storage(instr_desc, &processor, limit);
+  opentelemetry::context::Context context;
+  for (size_t i = 0; i < limit + 5; ++i)
+  {
+    M attributes = {{"RequestType", std::to_string(i)}};
+    storage.RecordLong(1l, KeyValueIterableView<M>(attributes), context);
+  }
+  EXPECT_EQ(limit, storage.GetSeriesCount());
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  long overflow = 0;
+  size_t points = 0;
+  auto now      = std::chrono::system_clock::now();
+  storage.Collect(collector.get(), collectors, now, now, [&](MetricData &data) {
+    for (auto &point : data.point_data_attr_)
+    {
+      points++;
+      if (point.attributes == AttributesHashMap::GetOverflowAttributes())
+      {
+        overflow = opentelemetry::nostd::get<long>(
+            opentelemetry::nostd::get<SumPointData>(point.point_data).value_);
+      }
+    }
+    return true;
+  });
+  EXPECT_EQ(limit, points);
+  EXPECT_EQ(6l, overflow);
+}
+
+TEST(ColumnarSumMetricStorage, UnchangedSeriesKeepalive)
+{
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  DefaultAttributesProcessor processor;
+  ColumnarSumMetricStorage<long> storage(instr_desc, &processor);
+  M get = {{"RequestType", "GET"}};
+  M put = {{"RequestType", "PUT"}};
+  opentelemetry::context::Context context;
+  storage.RecordLong(1l, KeyValueIterableView<M>(get), context);
+  storage.RecordLong(1l, KeyValueIterableView<M>(put), context);
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative, 2));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  EXPECT_EQ(2, Collect(storage, collector.get(), collectors).size());
+
+  storage.RecordLong(1l, KeyValueIterableView<M>(get), context);
+  auto values = Collect(storage, collector.get(), collectors);
+  EXPECT_EQ(1, values.size());
+  EXPECT_EQ(2l, values["GET"]);
+
+  // The keepalive of the unchanged series is due.
+  values = Collect(storage, collector.get(), collectors);
+  EXPECT_EQ(1, values.size());
+  EXPECT_EQ(1l, values["PUT"]);
+}
+#endif
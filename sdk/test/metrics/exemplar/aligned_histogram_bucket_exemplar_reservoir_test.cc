@@ -0,0 +1,41 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/exemplar/aligned_histogram_bucket_exemplar_reservoir.h"
+#  include <gtest/gtest.h>
+#  include "opentelemetry/sdk/common/empty_attributes.h"
+
+#  include <set>
+
+using namespace opentelemetry::sdk::metrics;
+
+TEST(AlignedHistogramBucketExemplarReservoir, KeepsLastMeasurementPerBucket)
+{
+  auto reservoir =
+      AlignedHistogramBucketExemplarReservoir::GetAlignedHistogramBucketExemplarReservoir(
+          {10.0, 100.0});
+  // Buckets (-inf, 10), [10, 100) and [100, +inf), as counted by the histogram aggregation.
+  for (double value : {1.0, 5.0, 50.0, 500.0, 1000.0})
+  {
+    reservoir->OfferMeasurement(value, opentelemetry::sdk::GetEmptyAttributes(),
+                                opentelemetry::context::Context{});
+  }
+  reservoir->OfferMeasurement(10l, opentelemetry::sdk::GetEmptyAttributes(),
+                              opentelemetry::context::Context{});
+
+  auto exemplars = reservoir->CollectAndReset({});
+  ASSERT_EQ(exemplars.size(), 3);
+  std::set<double> values;
+  for (auto &exemplar : exemplars)
+  {
+    auto value = exemplar.GetValue();
+    values.insert(opentelemetry::nostd::holds_alternative<long>(value)
+                      ? static_cast<double>(opentelemetry::nostd::get<long>(value))
+                      : opentelemetry::nostd::get<double>(value));
+  }
+  EXPECT_EQ(values, (std::set<double>{5.0, 10.0, 1000.0}));
+  EXPECT_TRUE(reservoir->CollectAndReset({}).empty());
+}
+
+#endif
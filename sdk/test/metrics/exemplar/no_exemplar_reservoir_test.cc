@@ -3,6 +3,7 @@
 
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/exemplar/no_exemplar_reservoir.h"
+#  include "opentelemetry/sdk/common/empty_attributes.h"
 #  include <gtest/gtest.h>
 
 using namespace opentelemetry::sdk::metrics;
@@ -10,11 +11,10 @@ using namespace opentelemetry::sdk::metrics;
 TEST(NoExemplarReservoir, OfferMeasurement)
 {
   auto reservoir = opentelemetry::sdk::metrics::NoExemplarReservoir::GetNoExemplarReservoir();
-  EXPECT_NO_THROW(reservoir->OfferMeasurement(1.0, MetricAttributes{},
-                                              opentelemetry::context::Context{},
-                                              std::chrono::system_clock::now()));
-  EXPECT_NO_THROW(reservoir->OfferMeasurement(
-      1l, MetricAttributes{}, opentelemetry::context::Context{}, std::chrono::system_clock::now()));
+  EXPECT_NO_THROW(reservoir->OfferMeasurement(1.0, opentelemetry::sdk::GetEmptyAttributes(),
+                                              opentelemetry::context::Context{}));
+  EXPECT_NO_THROW(reservoir->OfferMeasurement(1l, opentelemetry::sdk::GetEmptyAttributes(),
+                                              opentelemetry::context::Context{}));
   auto exemplar_data = reservoir->CollectAndReset(MetricAttributes{});
   ASSERT_TRUE(exemplar_data.empty());
 }
@@ -0,0 +1,97 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/exemplar/simple_fixed_size_exemplar_reservoir.h"
+#  include <gtest/gtest.h>
+#  include "opentelemetry/common/key_value_iterable_view.h"
+
+#  include <map>
+#  include <string>
+#  include <thread>
+#  include <vector>
+
+using namespace opentelemetry::sdk::metrics;
+using opentelemetry::common::KeyValueIterableView;
+
+TEST(SimpleFixedSizeExemplarReservoir, KeepsAtMostSizeMeasurements)
+{
+  auto reservoir = SimpleFixedSizeExemplarReservoir::GetSimpleFixedSizeExemplarReservoir(4);
+  std::map<std::string, std::string> attributes = {{"key", "value"}, {"filtered", "out"}};
+  for (long i = 0; i < 2; i++)
+  {
+    reservoir->OfferMeasurement(
+        i, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+        opentelemetry::context::Context{});
+  }
+
+  // Fewer measurements than cells: all are kept.
+  auto exemplars = reservoir->CollectAndReset({{"key", "value"}});
+  ASSERT_EQ(exemplars.size(), 2);
+  for (auto &exemplar : exemplars)
+  {
+    EXPECT_EQ(exemplar.GetFilteredAttributes(), MetricAttributes({{"filtered", "out"}}));
+    EXPECT_FALSE(exemplar.GetSpanContext().IsValid());
+  }
+  EXPECT_TRUE(reservoir->CollectAndReset({{"key", "value"}}).empty());
+
+  for (double i = 0; i < 100; i++)
+  {
+    reservoir->OfferMeasurement(
+        i, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+        opentelemetry::context::Context{});
+  }
+  exemplars = reservoir->CollectAndReset({});
+  EXPECT_EQ(exemplars.size(), 4);
+  for (auto &exemplar : exemplars)
+  {
+    double value = opentelemetry::nostd::get<double>(exemplar.GetValue());
+    EXPECT_GE(value, 0);
+    EXPECT_LT(value, 100);
+    EXPECT_EQ(exemplar.GetFilteredAttributes().size(), 2);
+  }
+}
+
+TEST(SimpleFixedSizeExemplarReservoir, CollectsMatchingPointOnly)
+{
+  SimpleFixedSizeExemplarReservoir reservoir(4);
+  std::map<std::string, std::string> get = {{"method", "GET"}};
+  std::map<std::string, std::string> put = {{"method", "PUT"}};
+  reservoir.OfferMeasurement(1l, KeyValueIterableView<std::map<std::string, std::string>>(get),
+                             opentelemetry::context::Context{});
+  reservoir.OfferMeasurement(2l, KeyValueIterableView<std::map<std::string, std::string>>(put),
+                             opentelemetry::context::Context{});
+
+  auto exemplars = reservoir.CollectAndReset({{"method", "PUT"}});
+  ASSERT_EQ(exemplars.size(), 1);
+  EXPECT_EQ(opentelemetry::nostd::get<long>(exemplars[0].GetValue()), 2l);
+  EXPECT_TRUE(exemplars[0].GetFilteredAttributes().empty());
+}
+
+TEST(SimpleFixedSizeExemplarReservoir, ConcurrentOffers)
+{
+  SimpleFixedSizeExemplarReservoir reservoir(8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&reservoir]() {
+      std::map<std::string, std::string> attributes = {{"key", "value"}};
+      for (long i = 0; i < 1000; i++)
+      {
+        reservoir.OfferMeasurement(
+            i, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+            opentelemetry::context::Context{});
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  // Offers that found their cell busy are dropped, so not every cell needs to be filled.
+  auto exemplars = reservoir.CollectAndReset({{"key", "value"}});
+  EXPECT_GE(exemplars.size(), 1);
+  EXPECT_LE(exemplars.size(), 8);
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/exemplar/trace_based_exemplar_filter.h"
+#  include "opentelemetry/context/runtime_context.h"
+#  include "opentelemetry/trace/context.h"
+#  include "opentelemetry/trace/default_span.h"
+#  include "opentelemetry/trace/scope.h"
+
+#  include <gtest/gtest.h>
+
+using namespace opentelemetry::sdk::metrics;
+namespace context = opentelemetry::context;
+namespace nostd   = opentelemetry::nostd;
+namespace trace   = opentelemetry::trace;
+
+namespace
+{
+nostd::shared_ptr<trace::Span> MakeSpan(bool sampled)
+{
+  const uint8_t trace_id[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  const uint8_t span_id[8]   = {1, 2, 3, 4, 5, 6, 7, 8};
+  trace::SpanContext span_context(
+      trace::TraceId(trace_id), trace::SpanId(span_id),
+      trace::TraceFlags(sampled ? trace::TraceFlags::kIsSampled : 0), false);
+  return nostd::shared_ptr<trace::Span>(new trace::DefaultSpan(span_context));
+}
+}  // namespace
+
+TEST(TraceBasedExemplarFilter, ActiveSpan)
+{
+  auto filter = TraceBasedExemplarFilter::GetTraceBasedExemplarFilter();
+  EXPECT_FALSE(filter->ShouldSampleMeasurement(1l, MetricAttributes{}, context::Context{}));
+
+  {
+    trace::Scope scope(MakeSpan(true));
+    EXPECT_TRUE(filter->ShouldSampleMeasurement(1l, MetricAttributes{}, context::Context{}));
+    EXPECT_TRUE(filter->ShouldSampleMeasurement(1.0, MetricAttributes{}, context::Context{}));
+  }
+  {
+    trace::Scope scope(MakeSpan(false));
+    EXPECT_FALSE(filter->ShouldSampleMeasurement(1l, MetricAttributes{}, context::Context{}));
+  }
+}
+
+TEST(TraceBasedExemplarFilter, ExplicitContext)
+{
+  auto filter = TraceBasedExemplarFilter::GetTraceBasedExemplarFilter();
+  context::Context empty;
+  context::Context sampled   = trace::SetSpan(empty, MakeSpan(true));
+  context::Context unsampled = trace::SetSpan(empty, MakeSpan(false));
+
+  EXPECT_TRUE(filter->ShouldSampleMeasurement(1l, MetricAttributes{}, sampled));
+
+  // The span of the context passed in takes precedence over the active span.
+  trace::Scope scope(MakeSpan(true));
+  EXPECT_FALSE(filter->ShouldSampleMeasurement(1.0, MetricAttributes{}, unsampled));
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/aggregation/histogram_aggregation.h"
+
+#  include <list>
+#  include <vector>
+
+using namespace opentelemetry::sdk::metrics;
+namespace
+{
+
+// The linear walk over a std::list the contiguous lookup replaced, kept as a baseline.
+size_t ListBucketIndex(const std::list<double> &boundaries, double value)
+{
+  size_t index = 0;
+  for (auto it = boundaries.begin(); it != boundaries.end(); ++it)
+  {
+    if (value < *it)
+    {
+      return index;
+    }
+    index++;
+  }
+  return index;
+}
+
+std::vector<double> MakeBoundaries(int64_t count)
+{
+  std::vector<double> boundaries;
+  for (int64_t i = 0; i < count; i++)
+  {
+    boundaries.push_back(static_cast<double>(i) * 10.0);
+  }
+  return boundaries;
+}
+
+void BM_ListBucketIndex(benchmark::State &state)
+{
+  auto vector = MakeBoundaries(state.range(0));
+  std::list<double> boundaries(vector.begin(), vector.end());
+  double max   = static_cast<double>(state.range(0)) * 10.0;
+  double value = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(ListBucketIndex(boundaries, value));
+    value = value < max ? value + 7.0 : 0;
+  }
+}
+BENCHMARK(BM_ListBucketIndex)->Arg(10)->Arg(16)->Arg(64)->Arg(256);
+
+void BM_HistogramBucketIndex(benchmark::State &state)
+{
+  auto boundaries = MakeBoundaries(state.range(0));
+  double max      = static_cast<double>(state.range(0)) * 10.0;
+  double value    = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(HistogramBucketIndex(boundaries, value));
+    value = value < max ? value + 7.0 : 0;
+  }
+}
+BENCHMARK(BM_HistogramBucketIndex)->Arg(10)->Arg(16)->Arg(64)->Arg(256);
+
+void BM_DoubleHistogramAggregate(benchmark::State &state)
+{
+  DoubleHistogramAggregation aggregation;
+  double value = 0;
+  for (auto _ : state)
+  {
+    aggregation.Aggregate(value, {});
+    value = value < 1100.0 ? value + 7.0 : 0;
+  }
+}
+BENCHMARK(BM_DoubleHistogramAggregate);
+
+}  // namespace
+#endif
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/internal_metrics.h"
+#  include <gtest/gtest.h>
+#  include "opentelemetry/sdk/metrics/meter_provider.h"
+#  include "opentelemetry/sdk/metrics/metric_reader.h"
+#  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
+#  include "opentelemetry/sdk/metrics/view/meter_selector.h"
+#  include "opentelemetry/sdk/metrics/view/view.h"
+
+#  include <initializer_list>
+#  include <map>
+#  include <string>
+
+using namespace opentelemetry;
+using namespace opentelemetry::sdk::metrics;
+
+namespace
+{
+class MockMetricReader : public MetricReader
+{
+public:
+  bool OnForceFlush(std::chrono::microseconds) noexcept override { return true; }
+  bool OnShutDown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+/* Adds unnamed views of the instruments of a meter, so that they keep their names. */
+void AddUnnamedViews(MeterProvider &meter_provider,
+                     const std::string &meter_name,
+                     std::initializer_list<InstrumentType> instrument_types)
+{
+  for (auto instrument_type : instrument_types)
+  {
+    meter_provider.AddView(
+        std::unique_ptr<InstrumentSelector>(new InstrumentSelector(instrument_type, "*")),
+        std::unique_ptr<MeterSelector>(new MeterSelector(meter_name, "", "")),
+        std::unique_ptr<View>(new View("")));
+  }
+}
+
+/* The value of each point of a collection, keyed by metric name and the given attribute. */
+std::map<std::string, double> CollectPoints(MetricReader &reader, const std::string &attribute)
+{
+  std::map<std::string, double> points;
+  reader.Collect([&](ResourceMetrics &metric_data) {
+    for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+    {
+      for (auto &data : instrumentation_info.metric_data_)
+      {
+        for (auto &point : data.point_data_attr_)
+        {
+          auto it = point.attributes.find(attribute);
+          if (it == point.attributes.end())
+          {
+            continue;
+          }
+          std::string key =
+              data.instrument_descriptor.name_ + "/" + nostd::get<std::string>(it->second);
+          ValueType value;
+          if (nostd::holds_alternative<SumPointData>(point.point_data))
+          {
+            value = nostd::get<SumPointData>(point.point_data).value_;
+          }
+          else
+          {
+            value = nostd::get<LastValuePointData>(point.point_data).value_;
+          }
+          points[key] = nostd::holds_alternative<long>(value)
+                            ? static_cast<double>(nostd::get<long>(value))
+                            : nostd::get<double>(value);
+        }
+      }
+    }
+    return true;
+  });
+  return points;
+}
+}  // namespace
+
+TEST(InternalMetricsTest, ReportsComponentCounters)
+{
+  MeterProvider meter_provider;
+  MockMetricReader *reader = new MockMetricReader;
+  meter_provider.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  AddUnnamedViews(meter_provider, "otel-sdk",
+                  {InstrumentType::kObservableCounter, InstrumentType::kObservableGauge});
+
+  InternalMetrics internal_metrics(meter_provider.GetMeter("otel-sdk"));
+  internal_metrics.AddBatchProcessor("spans", [] {
+    sdk::common::BatchProcessorStats stats;
+    stats.enqueued              = 10;
+    stats.dropped               = 3;
+    stats.queue_size            = 5;
+    stats.max_queue_size        = 2048;
+    stats.total_export_duration = std::chrono::milliseconds(250);
+    return stats;
+  });
+  internal_metrics.AddExporter("otlp", [] {
+    ExporterStats stats;
+    stats.requests      = 4;
+    stats.request_bytes = 1000;
+    stats.retries       = 1;
+    return stats;
+  });
+  internal_metrics.AddMetricReader("reader", *reader);
+
+  auto points = CollectPoints(*reader, "processor");
+  EXPECT_EQ(points["otel.sdk.processor.enqueued/spans"], 10);
+  EXPECT_EQ(points["otel.sdk.processor.dropped/spans"], 3);
+  EXPECT_EQ(points["otel.sdk.processor.queue.size/spans"], 5);
+  EXPECT_EQ(points["otel.sdk.processor.queue.capacity/spans"], 2048);
+  EXPECT_DOUBLE_EQ(points["otel.sdk.processor.export.duration/spans"], 0.25);
+
+  points = CollectPoints(*reader, "exporter");
+  EXPECT_EQ(points["otel.sdk.exporter.requests/otlp"], 4);
+  EXPECT_EQ(points["otel.sdk.exporter.request.size/otlp"], 1000);
+  EXPECT_EQ(points["otel.sdk.exporter.retries/otlp"], 1);
+  EXPECT_EQ(points["otel.sdk.exporter.dropped/otlp"], 0);
+
+  // The observations are made before the collection which reports them completes.
+  points = CollectPoints(*reader, "reader");
+  EXPECT_EQ(points["otel.sdk.metric_reader.collections/reader"], 2);
+  EXPECT_EQ(reader->GetStats().collections, 3);
+}
+
+TEST(InternalMetricsTest, ReportsSeriesPerInstrument)
+{
+  MeterProvider meter_provider;
+  MockMetricReader *reader = new MockMetricReader;
+  meter_provider.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  AddUnnamedViews(meter_provider, "app", {InstrumentType::kCounter});
+  AddUnnamedViews(meter_provider, "otel-sdk", {InstrumentType::kObservableGauge});
+  auto counter = meter_provider.GetMeter("app")->CreateLongCounter("requests");
+  counter->Add(1, {{"route", "a"}});
+  counter->Add(1, {{"route", "b"}});
+  counter->Add(1, {{"route", "c"}});
+
+  // Series are not tracked by default.
+  reader->Collect([](ResourceMetrics &) { return true; });
+  EXPECT_TRUE(reader->GetStats().series.empty());
+
+  InternalMetrics internal_metrics(meter_provider.GetMeter("otel-sdk"));
+  internal_metrics.AddMetricReader("reader", *reader);
+  reader->Collect([](ResourceMetrics &) { return true; });
+  auto points = CollectPoints(*reader, "instrument");
+  EXPECT_EQ(points["otel.sdk.metric_reader.series/requests"], 3);
+}
+#endif
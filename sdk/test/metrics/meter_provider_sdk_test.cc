@@ -10,6 +10,11 @@
 #  include "opentelemetry/sdk/metrics/metric_reader.h"
 #  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
 #  include "opentelemetry/sdk/metrics/view/meter_selector.h"
+#  include "opentelemetry/sdk/metrics/view/view.h"
+
+#  include <initializer_list>
+#  include <map>
+#  include <string>
 
 using namespace opentelemetry::sdk::metrics;
 
@@ -88,4 +93,244 @@ TEST(MeterProvider, GetMeter)
   ASSERT_NO_THROW(
       mp1.AddView(std::move(instrument_selector), std::move(meter_selector), std::move(view)));
 }
+
+namespace
+{
+/* Adds unnamed views of the instruments of a meter, so that they keep their names. */
+void AddUnnamedViews(MeterProvider &mp,
+                     const std::string &meter_name,
+                     std::initializer_list<InstrumentType> instrument_types)
+{
+  for (auto instrument_type : instrument_types)
+  {
+    mp.AddView(std::unique_ptr<InstrumentSelector>(new InstrumentSelector(instrument_type, "*")),
+               std::unique_ptr<MeterSelector>(new MeterSelector(meter_name, "", "")),
+               std::unique_ptr<View>(new View("")));
+  }
+}
+}  // namespace
+
+TEST(MeterProvider, RecordBatch)
+{
+  MeterProvider mp;
+  auto reader = new MockMetricReader(std::unique_ptr<MetricExporter>(new MockMetricExporter()));
+  mp.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  AddUnnamedViews(mp, "batch", {InstrumentType::kCounter, InstrumentType::kUpDownCounter});
+  std::unordered_map<std::string, bool> allowed_keys = {{"route", true}};
+  mp.AddView(std::unique_ptr<InstrumentSelector>(
+                 new InstrumentSelector(InstrumentType::kHistogram, "duration")),
+             std::unique_ptr<MeterSelector>(new MeterSelector("batch", "", "")),
+             std::unique_ptr<View>(new View(
+                 "duration", "", AggregationType::kHistogram,
+                 std::unique_ptr<AttributesProcessor>(
+                     new FilteringAttributesProcessor(allowed_keys)))));
+  auto meter    = mp.GetMeter("batch");
+  auto requests = meter->CreateLongCounter("requests");
+  auto bytes    = meter->CreateDoubleUpDownCounter("bytes");
+  auto duration = meter->CreateDoubleHistogram("duration");
+
+  for (double ms : {1.0, 2.0, -1.0})
+  {
+    meter->RecordBatch({{"route", "/users"}, {"method", "GET"}},
+                       {{*requests, 1l}, {*bytes, 10.0}, {*duration, ms}});
+  }
+  // Recorded into the same series as the batches.
+  requests->Add(1, {{"method", "GET"}, {"route", "/users"}});
+
+  // Series by instrument name and number of attributes.
+  std::map<std::string, size_t> attribute_counts;
+  reader->Collect([&](ResourceMetrics &metric_data) {
+    for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+    {
+      for (auto &data : instrumentation_info.metric_data_)
+      {
+        EXPECT_EQ(1, data.point_data_attr_.size());
+        if (data.point_data_attr_.empty())
+        {
+          continue;
+        }
+        auto &point = data.point_data_attr_[0];
+        attribute_counts[data.instrument_descriptor.name_] = point.attributes.size();
+        if (data.instrument_descriptor.name_ == "requests")
+        {
+          EXPECT_EQ(4l, opentelemetry::nostd::get<long>(
+                            opentelemetry::nostd::get<SumPointData>(point.point_data).value_));
+        }
+        else if (data.instrument_descriptor.name_ == "bytes")
+        {
+          auto &value = opentelemetry::nostd::get<SumPointData>(point.point_data).value_;
+          EXPECT_DOUBLE_EQ(30.0, opentelemetry::nostd::get<double>(value));
+        }
+        else
+        {
+          // The negative duration was dropped.
+          EXPECT_EQ(2, opentelemetry::nostd::get<HistogramPointData>(point.point_data).count_);
+        }
+      }
+    }
+    return true;
+  });
+  EXPECT_EQ(2, attribute_counts["requests"]);
+  EXPECT_EQ(2, attribute_counts["bytes"]);
+  EXPECT_EQ(1, attribute_counts["duration"]);
+}
+
+TEST(MeterProvider, ColumnarStorageView)
+{
+  MeterProvider mp;
+  auto reader = new MockMetricReader(std::unique_ptr<MetricExporter>(new MockMetricExporter()));
+  mp.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  mp.AddView(std::unique_ptr<InstrumentSelector>(
+                 new InstrumentSelector(InstrumentType::kCounter, "requests")),
+             std::unique_ptr<MeterSelector>(new MeterSelector("columnar", "", "")),
+             std::unique_ptr<View>(new View(
+                 "", "", AggregationType::kDefault,
+                 std::unique_ptr<AttributesProcessor>(new DefaultAttributesProcessor()),
+                 kAggregationCardinalityLimit, 0, true)));
+  auto meter    = mp.GetMeter("columnar");
+  auto requests = meter->CreateLongCounter("requests");
+  requests->Add(1, {{"route", "/users"}});
+  requests->Add(2, {{"route", "/users"}});
+  requests->Add(4, {{"route", "/orders"}});
+  requests->Bind({{"route", "/orders"}})->Add(8);
+
+  std::map<std::string, long> values;
+  reader->Collect([&](ResourceMetrics &metric_data) {
+    for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+    {
+      for (auto &data : instrumentation_info.metric_data_)
+      {
+        for (auto &point : data.point_data_attr_)
+        {
+          auto &route = opentelemetry::nostd::get<std::string>(point.attributes["route"]);
+          auto &value = opentelemetry::nostd::get<SumPointData>(point.point_data).value_;
+          values[route] = opentelemetry::nostd::get<long>(value);
+        }
+      }
+    }
+    return true;
+  });
+  EXPECT_EQ(2, values.size());
+  EXPECT_EQ(3l, values["/users"]);
+  EXPECT_EQ(12l, values["/orders"]);
+}
+
+namespace
+{
+
+struct PoolStats
+{
+  long connections = 0;
+  double wait_ms   = 0;
+  int reads        = 0;
+};
+
+void ObservePoolStats(opentelemetry::metrics::BatchObserverResult &result, void *state)
+{
+  auto &stats = *static_cast<PoolStats *>(state);
+  ++stats.reads;
+  result.GetLongResult(0).Observe(stats.connections, {{"pool", "main"}});
+  result.GetDoubleResult(1).Observe(stats.wait_ms, {{"pool", "main"}});
+  // Of the wrong value type, or out of range: dropped.
+  result.GetDoubleResult(0).Observe(1.0);
+  result.GetLongResult(2).Observe(1);
+}
+}  // namespace
+
+TEST(MeterProvider, BatchObservableInstruments)
+{
+  using Instrument = opentelemetry::metrics::BatchObservableInstrument;
+
+  MeterProvider mp;
+  auto reader = new MockMetricReader(std::unique_ptr<MetricExporter>(new MockMetricExporter()));
+  mp.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  AddUnnamedViews(mp, "batch",
+                  {InstrumentType::kObservableGauge, InstrumentType::kObservableCounter});
+  auto meter = mp.GetMeter("batch");
+  PoolStats stats;
+  meter->CreateBatchObservableInstruments(
+      {{Instrument::Kind::kGauge, Instrument::ValueType::kLong, "connections"},
+       {Instrument::Kind::kCounter, Instrument::ValueType::kDouble, "wait", "", "ms"}},
+      &ObservePoolStats, &stats);
+
+  for (int collection = 1; collection <= 2; ++collection)
+  {
+    stats.connections = 10 * collection;
+    stats.wait_ms     = 1.5 * collection;
+    std::map<std::string, std::string> points;
+    reader->Collect([&](ResourceMetrics &metric_data) {
+      for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+      {
+        for (auto &data : instrumentation_info.metric_data_)
+        {
+          EXPECT_EQ(1, data.point_data_attr_.size());
+          for (auto &point : data.point_data_attr_)
+          {
+            EXPECT_EQ(1, point.attributes.size());
+            if (data.instrument_descriptor.name_ == "connections")
+            {
+              auto &value = opentelemetry::nostd::get<LastValuePointData>(point.point_data).value_;
+              points["connections"] = std::to_string(opentelemetry::nostd::get<long>(value));
+            }
+            else
+            {
+              auto &value = opentelemetry::nostd::get<SumPointData>(point.point_data).value_;
+              points["wait"] = std::to_string(opentelemetry::nostd::get<double>(value));
+            }
+          }
+        }
+      }
+      return true;
+    });
+    // The callback ran once for both instruments.
+    EXPECT_EQ(collection, stats.reads);
+    EXPECT_EQ(std::to_string(10l * collection), points["connections"]);
+    EXPECT_EQ(std::to_string(1.5 * collection), points["wait"]);
+  }
+}
+
+TEST(MeterProvider, DuplicateInstruments)
+{
+  MeterProvider mp;
+  auto reader = new MockMetricReader(std::unique_ptr<MetricExporter>(new MockMetricExporter()));
+  mp.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  auto meter = mp.GetMeter("plugins");
+  auto first = meter->CreateLongCounter("requests", "served requests", "1");
+  auto again = meter->CreateLongCounter("requests", "served requests", "1");
+  first->Add(1, {{"plugin", "a"}});
+  again->Add(2, {{"plugin", "a"}});
+  again->Bind({{"plugin", "a"}})->Add(4);
+
+  auto collect = [reader]() {
+    std::map<std::string, long> values;
+    reader->Collect([&](ResourceMetrics &metric_data) {
+      for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+      {
+        for (auto &data : instrumentation_info.metric_data_)
+        {
+          for (auto &point : data.point_data_attr_)
+          {
+            auto &value = opentelemetry::nostd::get<SumPointData>(point.point_data).value_;
+            values[data.instrument_descriptor.description_] +=
+                opentelemetry::nostd::get<long>(value);
+          }
+        }
+      }
+      return true;
+    });
+    return values;
+  };
+  // Both instruments recorded into the same series.
+  auto values = collect();
+  EXPECT_EQ(1, values.size());
+  EXPECT_EQ(7l, values["served requests"]);
+
+  // A conflicting duplicate records nowhere, and the first instruments are still collected.
+  auto conflicting = meter->CreateLongCounter("requests", "other requests", "1");
+  conflicting->Add(8, {{"plugin", "b"}});
+  first->Add(16, {{"plugin", "a"}});
+  values = collect();
+  EXPECT_EQ(1, values.size());
+  EXPECT_EQ(23l, values["served requests"]);
+}
 #endif
@@ -5,8 +5,13 @@
 #  include "opentelemetry/sdk/metrics/metric_reader.h"
 #  include <gtest/gtest.h>
 #  include "opentelemetry/sdk/metrics/meter_context.h"
+#  include "opentelemetry/sdk/metrics/meter_provider.h"
 #  include "opentelemetry/sdk/metrics/metric_exporter.h"
 
+#  include <algorithm>
+#  include <string>
+#  include <vector>
+
 using namespace opentelemetry;
 using namespace opentelemetry::sdk::instrumentationlibrary;
 using namespace opentelemetry::sdk::metrics;
@@ -36,4 +41,85 @@ TEST(MetricReaderTest, BasicTests)
       new MetricCollector(std::move(meter_context2), std::move(metric_reader2));
   EXPECT_NO_THROW(metric_producer->Collect([](ResourceMetrics &metric_data) { return true; }));
 }
+
+TEST(MetricReaderTest, ParallelCollection)
+{
+  std::shared_ptr<MeterContext> meter_context(new MeterContext());
+  meter_context->SetCollectionParallelism(4);
+  EXPECT_EQ(meter_context->GetCollectionParallelism(), 4);
+  // The reader's thread collects along with 3 threads kept for all the collections.
+  ASSERT_NE(meter_context->GetCollectionExecutor(), nullptr);
+  EXPECT_EQ(meter_context->GetCollectionExecutor()->GetThreadCount(), 3);
+  MeterProvider meter_provider(meter_context);
+  MockMetricReader *reader = new MockMetricReader(AggregationTemporality::kCumulative);
+  meter_provider.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+
+  const long num_counters = 32;
+  auto meter              = meter_provider.GetMeter("meter");
+  std::vector<nostd::shared_ptr<opentelemetry::metrics::Counter<long>>> counters;
+  for (long i = 0; i < num_counters; i++)
+  {
+    counters.push_back(meter->CreateLongCounter("counter" + std::to_string(i)));
+    counters.back()->Add(i);
+  }
+
+  for (int collection = 1; collection <= 2; collection++)
+  {
+    std::vector<bool> reported(num_counters, false);
+    reader->Collect([&](ResourceMetrics &metric_data) {
+      for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+      {
+        for (auto &data : instrumentation_info.metric_data_)
+        {
+          // Every counter holds a distinct value, its index.
+          EXPECT_EQ(data.point_data_attr_.size(), 1);
+          for (auto &point : data.point_data_attr_)
+          {
+            long i = nostd::get<long>(nostd::get<SumPointData>(point.point_data).value_);
+            EXPECT_FALSE(reported[i]);
+            reported[i] = true;
+          }
+        }
+      }
+      return true;
+    });
+    EXPECT_EQ(std::count(reported.begin(), reported.end(), true), num_counters);
+  }
+}
+
+TEST(MetricReaderTest, ReusesCollectionBuffers)
+{
+  std::shared_ptr<MeterContext> meter_context(new MeterContext());
+  MeterProvider meter_provider(meter_context);
+  MockMetricReader *reader = new MockMetricReader(AggregationTemporality::kCumulative);
+  meter_provider.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+  auto counter = meter_provider.GetMeter("meter")->CreateLongCounter("counter");
+
+  // The points of a collection are refilled two collections later: the storage and the collector
+  // swap their buffers every time.
+  std::vector<const PointDataAttributes *> points;
+  for (long collection = 1; collection <= 3; collection++)
+  {
+    counter->Add(1, {{"key", "a"}});
+    counter->Add(1, {{"key", "b"}});
+    reader->Collect([&](ResourceMetrics &metric_data) {
+      for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+      {
+        for (auto &data : instrumentation_info.metric_data_)
+        {
+          EXPECT_EQ(data.point_data_attr_.size(), 2);
+          for (auto &point : data.point_data_attr_)
+          {
+            EXPECT_EQ(nostd::get<long>(nostd::get<SumPointData>(point.point_data).value_),
+                      collection);
+          }
+          points.push_back(data.point_data_attr_.data());
+        }
+      }
+      return true;
+    });
+  }
+  ASSERT_EQ(points.size(), 3);
+  EXPECT_EQ(points[0], points[2]);
+}
 #endif
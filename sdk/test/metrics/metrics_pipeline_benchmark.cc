@@ -0,0 +1,248 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/metrics/meter_provider.h"
+#  include "opentelemetry/sdk/metrics/metric_reader.h"
+#  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
+#  include "opentelemetry/sdk/metrics/view/meter_selector.h"
+#  include "opentelemetry/sdk/metrics/view/view.h"
+
+#  include <chrono>
+#  include <cstdint>
+#  include <map>
+#  include <memory>
+#  include <string>
+
+using namespace opentelemetry::sdk::metrics;
+namespace metrics_api = opentelemetry::metrics;
+namespace nostd       = opentelemetry::nostd;
+
+namespace
+{
+// The largest number of series the benchmarks record into.
+constexpr int64_t kMaxSeries = 1 << 20;
+
+class BenchmarkMetricReader : public MetricReader
+{
+public:
+  explicit BenchmarkMetricReader(AggregationTemporality temporality) : MetricReader(temporality) {}
+
+  bool OnForceFlush(std::chrono::microseconds) noexcept override { return true; }
+
+  bool OnShutDown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+/**
+ * A meter provider with one reader, whose instruments named "instrument" are aggregated with the
+ * given aggregation and a cardinality limit above kMaxSeries.
+ */
+struct Pipeline
+{
+  Pipeline(InstrumentType instrument_type,
+           AggregationType aggregation_type,
+           AggregationTemporality temporality)
+      : reader(new BenchmarkMetricReader(temporality))
+  {
+    provider.AddMetricReader(std::unique_ptr<MetricReader>(reader));
+    provider.AddView(
+        std::unique_ptr<InstrumentSelector>(new InstrumentSelector(instrument_type, "instrument")),
+        std::unique_ptr<MeterSelector>(new MeterSelector("benchmark", "", "")),
+        std::unique_ptr<View>(new View("instrument", "", aggregation_type,
+                                       std::unique_ptr<AttributesProcessor>(
+                                           new DefaultAttributesProcessor()),
+                                       kMaxSeries + 1)));
+    meter = provider.GetMeter("benchmark");
+  }
+
+  MeterProvider provider;
+  BenchmarkMetricReader *reader;
+  nostd::shared_ptr<metrics_api::Meter> meter;
+};
+
+/* Collects the metrics of `pipeline`, returning the number of points reported. */
+int64_t Collect(Pipeline &pipeline)
+{
+  int64_t points = 0;
+  pipeline.reader->Collect([&points](ResourceMetrics &metric_data) {
+    for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+    {
+      for (auto &data : instrumentation_info.metric_data_)
+      {
+        points += static_cast<int64_t>(data.point_data_attr_.size());
+      }
+    }
+    return true;
+  });
+  return points;
+}
+
+// Shared by the threads of a benchmark: created by thread 0 before they enter the loop together,
+// and destroyed by it after they leave it.
+std::unique_ptr<Pipeline> shared_pipeline;
+nostd::shared_ptr<metrics_api::Counter<long>> shared_counter;
+nostd::shared_ptr<metrics_api::Histogram<double>> shared_histogram;
+
+/**
+ * Adds to a counter from all threads, cycling through state.range(0) series, each thread starting
+ * at a different one.
+ */
+void BM_CounterAdd(benchmark::State &state, AggregationType aggregation_type)
+{
+  if (state.thread_index() == 0)
+  {
+    shared_pipeline.reset(new Pipeline(InstrumentType::kCounter, aggregation_type,
+                                       AggregationTemporality::kCumulative));
+    shared_counter = shared_pipeline->meter->CreateLongCounter("instrument");
+  }
+  const int64_t series = state.range(0);
+  int64_t index        = state.thread_index() % series;
+  for (auto _ : state)
+  {
+    shared_counter->Add(1, {{"series", index}});
+    if (++index == series)
+    {
+      index = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+  {
+    shared_counter = nullptr;
+    shared_pipeline.reset();
+  }
+}
+
+/* Records into a histogram from all threads, like BM_CounterAdd. */
+void BM_HistogramRecord(benchmark::State &state, AggregationType aggregation_type)
+{
+  if (state.thread_index() == 0)
+  {
+    shared_pipeline.reset(new Pipeline(InstrumentType::kHistogram, aggregation_type,
+                                       AggregationTemporality::kCumulative));
+    shared_histogram = shared_pipeline->meter->CreateDoubleHistogram("instrument");
+  }
+  const int64_t series = state.range(0);
+  int64_t index        = state.thread_index() % series;
+  double value         = 1;
+  opentelemetry::context::Context context;
+  for (auto _ : state)
+  {
+    shared_histogram->Record(value, {{"series", index}}, context);
+    value = value < 10000 ? value * 1.5 : 1;
+    if (++index == series)
+    {
+      index = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0)
+  {
+    shared_histogram = nullptr;
+    shared_pipeline.reset();
+  }
+}
+
+/**
+ * Measures the time a reader with the given temporality takes to collect state.range(0) series, all
+ * of which were recorded into since the previous collection.
+ */
+void BM_Collect(benchmark::State &state, AggregationTemporality temporality)
+{
+  Pipeline pipeline(InstrumentType::kCounter, AggregationType::kSum, temporality);
+  auto counter         = pipeline.meter->CreateLongCounter("instrument");
+  const int64_t series = state.range(0);
+  int64_t points       = 0;
+  for (auto _ : state)
+  {
+    for (int64_t index = 0; index < series; ++index)
+    {
+      counter->Add(1, {{"series", index}});
+    }
+    auto start = std::chrono::steady_clock::now();
+    points     = Collect(pipeline);
+    state.SetIterationTime(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  state.counters["points"] = static_cast<double>(points);
+  state.SetItemsProcessed(state.iterations() * series);
+}
+
+/**
+ * Records the metrics of a request, three counters and two histograms sharing its attributes, one
+ * instrument at a time or with Meter::RecordBatch.
+ */
+void BM_RecordRequest(benchmark::State &state, bool batch)
+{
+  Pipeline pipeline(InstrumentType::kCounter, AggregationType::kSum,
+                    AggregationTemporality::kCumulative);
+  auto &meter    = *pipeline.meter;
+  auto requests  = meter.CreateLongCounter("requests");
+  auto errors    = meter.CreateLongCounter("errors");
+  auto bytes     = meter.CreateDoubleCounter("bytes");
+  auto duration  = meter.CreateDoubleHistogram("duration");
+  auto body_size = meter.CreateLongHistogram("body_size");
+  const int64_t series = state.range(0);
+  int64_t index        = 0;
+  opentelemetry::context::Context context;
+  for (auto _ : state)
+  {
+    std::map<std::string, opentelemetry::common::AttributeValue> attributes = {
+        {"http.route", "/users"}, {"http.method", "GET"}, {"series", index}};
+    if (batch)
+    {
+      metrics_api::SyncMeasurement measurements[] = {
+          {*requests, 1l}, {*errors, 0l}, {*bytes, 512.0}, {*duration, 3.5}, {*body_size, 128l}};
+      meter.RecordBatch(attributes, measurements, context);
+    }
+    else
+    {
+      requests->Add(1, attributes, context);
+      errors->Add(0, attributes, context);
+      bytes->Add(512.0, attributes, context);
+      duration->Record(3.5, attributes, context);
+      body_size->Record(128, attributes, context);
+    }
+    if (++index == series)
+    {
+      index = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void SeriesAndThreads(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->ArgName("series")->Arg(1)->Arg(1 << 10)->Arg(kMaxSeries);
+  benchmark->ThreadRange(1, 64)->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(BM_CounterAdd, sum, AggregationType::kSum)->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_CounterAdd, striped_sum, AggregationType::kStripedSum)
+    ->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_CounterAdd, last_value, AggregationType::kLastValue)->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_CounterAdd, drop, AggregationType::kDrop)->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_HistogramRecord, histogram, AggregationType::kHistogram)
+    ->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_HistogramRecord,
+                  exponential_histogram,
+                  AggregationType::kExponentialHistogram)
+    ->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_HistogramRecord, sketch, AggregationType::kSketch)->Apply(SeriesAndThreads);
+BENCHMARK_CAPTURE(BM_RecordRequest, separate, false)->ArgName("series")->Arg(1)->Arg(1 << 10);
+BENCHMARK_CAPTURE(BM_RecordRequest, batch, true)->ArgName("series")->Arg(1)->Arg(1 << 10);
+
+void CollectedSeries(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->ArgName("series")->RangeMultiplier(32)->Range(1, kMaxSeries);
+  benchmark->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_CAPTURE(BM_Collect, delta, AggregationTemporality::kDelta)->Apply(CollectedSeries);
+BENCHMARK_CAPTURE(BM_Collect, cumulative, AggregationTemporality::kCumulative)
+    ->Apply(CollectedSeries);
+
+}  // namespace
+#endif
+BENCHMARK_MAIN();
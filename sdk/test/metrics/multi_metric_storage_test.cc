@@ -8,6 +8,8 @@
 #  include "opentelemetry/sdk/metrics/instruments.h"
 
 #  include <gtest/gtest.h>
+#  include <map>
+#  include <string>
 
 using namespace opentelemetry;
 using namespace opentelemetry::sdk::instrumentationlibrary;
@@ -40,10 +42,38 @@ class TestMetricStorage : public WritableMetricStorage
     num_calls_double++;
   }
 
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &attributes) noexcept override;
+
   size_t num_calls_long;
   size_t num_calls_double;
 };
 
+class TestBoundMetricStorage : public BoundWritableMetricStorage
+{
+public:
+  TestBoundMetricStorage(TestMetricStorage &storage) : storage_(storage) {}
+
+  void RecordLong(long value, const opentelemetry::context::Context &context) noexcept override
+  {
+    storage_.num_calls_long++;
+  }
+
+  void RecordDouble(double value, const opentelemetry::context::Context &context) noexcept override
+  {
+    storage_.num_calls_double++;
+  }
+
+private:
+  TestMetricStorage &storage_;
+};
+
+std::unique_ptr<BoundWritableMetricStorage> TestMetricStorage::Bind(
+    const opentelemetry::common::KeyValueIterable &attributes) noexcept
+{
+  return std::unique_ptr<BoundWritableMetricStorage>(new TestBoundMetricStorage(*this));
+}
+
 TEST(MultiMetricStorageTest, BasicTests)
 {
   std::shared_ptr<opentelemetry::sdk::metrics::WritableMetricStorage> storage(
@@ -59,4 +89,27 @@ TEST(MultiMetricStorageTest, BasicTests)
   EXPECT_EQ(static_cast<TestMetricStorage *>(storage.get())->num_calls_long, 3);
   EXPECT_EQ(static_cast<TestMetricStorage *>(storage.get())->num_calls_double, 1);
 }
+
+TEST(MultiMetricStorageTest, Bind)
+{
+  std::shared_ptr<opentelemetry::sdk::metrics::WritableMetricStorage> storage1(
+      new TestMetricStorage());
+  std::shared_ptr<opentelemetry::sdk::metrics::WritableMetricStorage> storage2(
+      new TestMetricStorage());
+  MultiMetricStorage storages{};
+  storages.AddStorage(storage1);
+  storages.AddStorage(storage2);
+
+  std::map<std::string, std::string> attributes = {{"k1", "v1"}};
+  auto bound = storages.Bind(opentelemetry::common::KeyValueIterableView<
+                             std::map<std::string, std::string>>(attributes));
+  EXPECT_NO_THROW(bound->RecordLong(10l, opentelemetry::context::Context{}));
+  EXPECT_NO_THROW(bound->RecordDouble(10.0, opentelemetry::context::Context{}));
+
+  for (auto &storage : {storage1, storage2})
+  {
+    EXPECT_EQ(static_cast<TestMetricStorage *>(storage.get())->num_calls_long, 1);
+    EXPECT_EQ(static_cast<TestMetricStorage *>(storage.get())->num_calls_double, 1);
+  }
+}
 #endif
@@ -16,8 +16,13 @@ using namespace opentelemetry::sdk::metrics;
 class MockPushMetricExporter : public MetricExporter
 {
 public:
+  MockPushMetricExporter(std::chrono::milliseconds export_delay = std::chrono::milliseconds::zero())
+      : export_delay_{export_delay}
+  {}
+
   opentelemetry::sdk::common::ExportResult Export(const ResourceMetrics &record) noexcept override
   {
+    std::this_thread::sleep_for(export_delay_);
     records_.push_back(record);
     return opentelemetry::sdk::common::ExportResult::kSuccess;
   }
@@ -36,6 +41,7 @@ class MockPushMetricExporter : public MetricExporter
   size_t GetDataCount() { return records_.size(); }
 
 private:
+  std::chrono::milliseconds export_delay_;
   std::vector<ResourceMetrics> records_;
 };
 
@@ -49,6 +55,7 @@ class MockMetricProducer : public MetricProducer
   bool Collect(nostd::function_ref<bool(ResourceMetrics &)> callback) noexcept override
   {
     std::this_thread::sleep_for(sleep_ms_);
+    collection_times_.push_back(std::chrono::system_clock::now());
     data_sent_size_++;
     ResourceMetrics data;
     callback(data);
@@ -57,8 +64,14 @@ class MockMetricProducer : public MetricProducer
 
   size_t GetDataCount() { return data_sent_size_; }
 
+  const std::vector<std::chrono::system_clock::time_point> &GetCollectionTimes()
+  {
+    return collection_times_;
+  }
+
 private:
   std::chrono::microseconds sleep_ms_;
+  std::vector<std::chrono::system_clock::time_point> collection_times_;
   size_t data_sent_size_;
 };
 
@@ -78,4 +91,77 @@ TEST(PeriodicExporingMetricReader, BasicTests)
             static_cast<MockMetricProducer *>(&producer)->GetDataCount());
 }
 
+TEST(PeriodicExporingMetricReader, SlowExportDoesNotDelayCollection)
+{
+  std::unique_ptr<MetricExporter> exporter(
+      new MockPushMetricExporter(std::chrono::milliseconds(350)));
+  PeriodicExportingMetricReaderOptions options;
+  options.export_timeout_millis  = std::chrono::milliseconds(80);
+  options.export_interval_millis = std::chrono::milliseconds(100);
+  auto exporter_ptr              = exporter.get();
+  PeriodicExportingMetricReader reader(std::move(exporter), options);
+  MockMetricProducer producer;
+  reader.SetMetricProducer(&producer);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  reader.Shutdown();
+
+  // The collections go on while the exports run, and those which waited longer than the export
+  // timeout for an export are dropped.
+  size_t exported = static_cast<MockPushMetricExporter *>(exporter_ptr)->GetDataCount();
+  EXPECT_GE(exported, 1);
+  EXPECT_GT(producer.GetDataCount(), exported);
+  EXPECT_GE(producer.GetDataCount(), 4);
+}
+
+TEST(PeriodicExporingMetricReader, AlignToWallClock)
+{
+  std::unique_ptr<MetricExporter> exporter(new MockPushMetricExporter());
+  PeriodicExportingMetricReaderOptions options;
+  options.export_timeout_millis  = std::chrono::milliseconds(200);
+  options.export_interval_millis = std::chrono::milliseconds(500);
+  options.align_to_wall_clock    = true;
+  PeriodicExportingMetricReader reader(std::move(exporter), options);
+  MockMetricProducer producer;
+  reader.SetMetricProducer(&producer);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1300));
+  reader.Shutdown();
+
+  ASSERT_GE(producer.GetCollectionTimes().size(), 2);
+  for (auto time : producer.GetCollectionTimes())
+  {
+    auto since_epoch =
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch());
+    EXPECT_LT((since_epoch % options.export_interval_millis).count(), 100);
+  }
+}
+
+TEST(PeriodicExporingMetricReader, SharedExecutor)
+{
+  std::shared_ptr<sdk::common::ExportExecutor> executor(new sdk::common::ExportExecutor(2));
+  PeriodicExportingMetricReaderOptions options;
+  options.export_timeout_millis  = std::chrono::milliseconds(50);
+  options.export_interval_millis = std::chrono::milliseconds(100);
+  options.executor               = executor;
+
+  std::unique_ptr<MetricExporter> first_exporter(new MockPushMetricExporter());
+  std::unique_ptr<MetricExporter> second_exporter(new MockPushMetricExporter());
+  auto first_exporter_ptr  = static_cast<MockPushMetricExporter *>(first_exporter.get());
+  auto second_exporter_ptr = static_cast<MockPushMetricExporter *>(second_exporter.get());
+  PeriodicExportingMetricReader first_reader(std::move(first_exporter), options);
+  PeriodicExportingMetricReader second_reader(std::move(second_exporter), options);
+  MockMetricProducer first_producer;
+  MockMetricProducer second_producer;
+  first_reader.SetMetricProducer(&first_producer);
+  second_reader.SetMetricProducer(&second_producer);
+  std::this_thread::sleep_for(std::chrono::milliseconds(550));
+  first_reader.Shutdown();
+  second_reader.Shutdown();
+
+  // Both readers collected on their schedule, and exported each collection.
+  EXPECT_GE(first_producer.GetDataCount(), 3);
+  EXPECT_GE(second_producer.GetDataCount(), 3);
+  EXPECT_EQ(first_producer.GetDataCount(), first_exporter_ptr->GetDataCount());
+  EXPECT_EQ(second_producer.GetDataCount(), second_exporter_ptr->GetDataCount());
+}
+
 #endif
\ No newline at end of file
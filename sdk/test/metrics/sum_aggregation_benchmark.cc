@@ -0,0 +1,71 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/common/spin_lock_mutex.h"
+#  include "opentelemetry/sdk/metrics/aggregation/lastvalue_aggregation.h"
+#  include "opentelemetry/sdk/metrics/aggregation/sum_aggregation.h"
+
+#  include <mutex>
+
+using namespace opentelemetry::sdk::metrics;
+namespace
+{
+
+// The spinlock-guarded sums the lock-free aggregations replaced, kept as a baseline.
+template <class T>
+class SpinLockSum
+{
+public:
+  void Aggregate(T value) noexcept
+  {
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    value_ += value;
+  }
+
+private:
+  opentelemetry::common::SpinLockMutex lock_;
+  T value_ = 0;
+};
+
+template <class T>
+class SpinLockLastValue
+{
+public:
+  void Aggregate(T value) noexcept
+  {
+    std::lock_guard<opentelemetry::common::SpinLockMutex> guard(lock_);
+    is_lastvalue_valid_ = true;
+    value_              = value;
+  }
+
+private:
+  opentelemetry::common::SpinLockMutex lock_;
+  bool is_lastvalue_valid_ = false;
+  T value_                 = 0;
+};
+
+// All threads record into the same series, the worst case for contention.
+template <class Aggregation, class T>
+void BM_Aggregate(benchmark::State &state)
+{
+  static Aggregation aggregation;
+  for (auto _ : state)
+  {
+    aggregation.Aggregate(static_cast<T>(1));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Aggregate, SpinLockSum<long>, long)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, LongSumAggregation, long)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, SpinLockSum<double>, double)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, DoubleSumAggregation, double)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, SpinLockLastValue<long>, long)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, LongLastValueAggregation, long)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, SpinLockLastValue<double>, double)->ThreadRange(1, 16);
+BENCHMARK_TEMPLATE(BM_Aggregate, DoubleLastValueAggregation, double)->ThreadRange(1, 16);
+
+}  // namespace
+#endif
+BENCHMARK_MAIN();
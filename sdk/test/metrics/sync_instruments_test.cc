@@ -4,6 +4,7 @@
 #ifndef ENABLE_METRICS_PREVIEW
 #  include "opentelemetry/sdk/metrics/sync_instruments.h"
 #  include "opentelemetry/context/context.h"
+#  include "opentelemetry/sdk/common/telemetry_switch.h"
 #  include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
 #  include "opentelemetry/sdk/metrics/exemplar/no_exemplar_reservoir.h"
 #  include "opentelemetry/sdk/metrics/state/multi_metric_storage.h"
@@ -20,6 +21,46 @@ auto instrumentation_library = InstrumentationLibrary::Create("opentelemetry-cpp
 
 using M = std::map<std::string, std::string>;
 
+namespace
+{
+// Counts the measurements recorded into it.
+class CountingMetricStorage : public WritableMetricStorage
+{
+public:
+  explicit CountingMetricStorage(int &count) : count_(count) {}
+
+  void RecordLong(long, const opentelemetry::context::Context &) noexcept override { ++count_; }
+
+  void RecordLong(long,
+                  const opentelemetry::common::KeyValueIterable &,
+                  const opentelemetry::context::Context &) noexcept override
+  {
+    ++count_;
+  }
+
+  void RecordDouble(double, const opentelemetry::context::Context &) noexcept override
+  {
+    ++count_;
+  }
+
+  void RecordDouble(double,
+                    const opentelemetry::common::KeyValueIterable &,
+                    const opentelemetry::context::Context &) noexcept override
+  {
+    ++count_;
+  }
+
+  std::unique_ptr<BoundWritableMetricStorage> Bind(
+      const opentelemetry::common::KeyValueIterable &) noexcept override
+  {
+    return nullptr;
+  }
+
+private:
+  int &count_;
+};
+}  // namespace
+
 TEST(SyncInstruments, LongCounter)
 {
   InstrumentDescriptor instrument_descriptor = {
@@ -135,4 +176,24 @@ TEST(SyncInstruments, DoubleHistogram)
                                  opentelemetry::context::Context{}));
 }
 
+
+TEST(SyncInstruments, TelemetryDisabled)
+{
+  using opentelemetry::sdk::common::TelemetrySwitch;
+  InstrumentDescriptor instrument_descriptor = {
+      "long_counter", "description", "1", InstrumentType::kCounter, InstrumentValueType::kLong};
+  int count = 0;
+  LongCounter counter(instrument_descriptor,
+                      std::unique_ptr<WritableMetricStorage>(new CountingMetricStorage(count)));
+
+  TelemetrySwitch::SetEnabled(false);
+  counter.Add(10l);
+  counter.Add(10l,
+              opentelemetry::common::KeyValueIterableView<M>({{"abc", "123"}, {"xyz", "456"}}));
+  TelemetrySwitch::SetEnabled(true);
+  EXPECT_EQ(0, count);
+
+  counter.Add(10l);
+  EXPECT_EQ(1, count);
+}
 #endif
\ No newline at end of file
@@ -18,12 +18,17 @@ using M = std::map<std::string, std::string>;
 class MockCollectorHandle : public CollectorHandle
 {
 public:
-  MockCollectorHandle(AggregationTemporality temp) : temporality(temp) {}
+  MockCollectorHandle(AggregationTemporality temp, size_t unchanged_keepalive = 0)
+      : temporality(temp), unchanged_keepalive(unchanged_keepalive)
+  {}
 
   AggregationTemporality GetAggregationTemporality() noexcept override { return temporality; }
 
+  size_t GetUnchangedSeriesKeepalive() noexcept override { return unchanged_keepalive; }
+
 private:
   AggregationTemporality temporality;
+  size_t unchanged_keepalive;
 };
 
 class WritableMetricStorageTestFixture : public ::testing::TestWithParam<AggregationTemporality>
@@ -130,6 +135,63 @@ TEST_P(WritableMetricStorageTestFixture, LongSumAggregation)
         return true;
       });
 }
+TEST_P(WritableMetricStorageTestFixture, LongSumAggregationBound)
+{
+  AggregationTemporality temporality = GetParam();
+  auto sdk_start_ts                  = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc    = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  std::map<std::string, std::string> attributes_get = {{"RequestType", "GET"}};
+
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+  auto bound_get =
+      storage.Bind(KeyValueIterableView<std::map<std::string, std::string>>(attributes_get));
+
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors;
+  collectors.push_back(collector);
+
+  // Returns the GET value of the collection, or -1 if it has no GET point.
+  auto collect_get = [&]() {
+    long value = -1;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        if (opentelemetry::nostd::get<std::string>(
+                                data_attr.attributes.find("RequestType")->second) == "GET")
+                        {
+                          value = opentelemetry::nostd::get<long>(
+                              opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_);
+                        }
+                      }
+                      return true;
+                    });
+    return value;
+  };
+
+  // Bound and unbound recordings with the same attributes land in the same series.
+  bound_get->RecordLong(10l, opentelemetry::context::Context{});
+  storage.RecordLong(20l, KeyValueIterableView<std::map<std::string, std::string>>(attributes_get),
+                     opentelemetry::context::Context{});
+  bound_get->RecordDouble(5.0, opentelemetry::context::Context{});  // wrong value type, ignored
+  EXPECT_EQ(collect_get(), 30l);
+
+  // The handle keeps working across collections.
+  bound_get->RecordLong(40l, opentelemetry::context::Context{});
+  EXPECT_EQ(collect_get(), temporality == AggregationTemporality::kDelta ? 40l : 70l);
+
+  // An idle bound series reports nothing new.
+  EXPECT_EQ(collect_get(), temporality == AggregationTemporality::kDelta ? -1l : 70l);
+
+  // Releasing the handle keeps what it recorded.
+  bound_get->RecordLong(5l, opentelemetry::context::Context{});
+  bound_get.reset();
+  EXPECT_EQ(collect_get(), temporality == AggregationTemporality::kDelta ? 5l : 75l);
+}
+
 INSTANTIATE_TEST_SUITE_P(WritableMetricStorageTestLong,
                          WritableMetricStorageTestFixture,
                          ::testing::Values(AggregationTemporality::kCumulative,
@@ -238,9 +300,491 @@ TEST_P(WritableMetricStorageTestFixture, DoubleSumAggregation)
         return true;
       });
 }
+
+TEST_P(WritableMetricStorageTestFixture, DoubleExponentialHistogramAggregation)
+{
+  AggregationTemporality temporality = GetParam();
+  auto sdk_start_ts                  = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc    = {"name", "desc", "1unit", InstrumentType::kHistogram,
+                                     InstrumentValueType::kDouble};
+  std::map<std::string, std::string> attributes = {{"RequestType", "GET"}};
+
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kExponentialHistogram, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors;
+  collectors.push_back(collector);
+
+  uint64_t expected_count = 0;
+  double expected_sum     = 0;
+  for (int round = 0; round < 2; round++)
+  {
+    if (temporality == AggregationTemporality::kDelta)
+    {
+      expected_count = 0;
+      expected_sum   = 0;
+    }
+    for (double value = 0.5; value < 5000; value *= 2.5)
+    {
+      storage.RecordDouble(value,
+                           KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                           opentelemetry::context::Context{});
+      expected_count++;
+      expected_sum += value;
+    }
+    size_t count_attributes = 0;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        auto data = opentelemetry::nostd::get<ExponentialHistogramPointData>(
+                            data_attr.point_data);
+                        EXPECT_EQ(data.count_, expected_count);
+                        EXPECT_DOUBLE_EQ(opentelemetry::nostd::get<double>(data.sum_),
+                                         expected_sum);
+                        uint64_t bucket_count = 0;
+                        for (auto count : data.positive_buckets_.counts_)
+                        {
+                          bucket_count += count;
+                        }
+                        EXPECT_EQ(bucket_count, expected_count);
+                        count_attributes++;
+                      }
+                      return true;
+                    });
+    EXPECT_EQ(count_attributes, 1);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(WritableMetricStorageTestDouble,
                          WritableMetricStorageTestFixture,
                          ::testing::Values(AggregationTemporality::kCumulative,
                                            AggregationTemporality::kDelta));
 
+TEST(SyncMetricStorageTest, MultipleCollectors)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  std::map<std::string, std::string> attributes = {{"RequestType", "GET"}};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+
+  std::shared_ptr<CollectorHandle> delta(new MockCollectorHandle(AggregationTemporality::kDelta));
+  std::shared_ptr<CollectorHandle> cumulative(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{delta, cumulative};
+
+  // Returns the sum reported to `collector`, or -1 if it got no point.
+  auto collect = [&](CollectorHandle *collector) {
+    long value = -1;
+    storage.Collect(collector, collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        value = opentelemetry::nostd::get<long>(
+                            opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_);
+                      }
+                      return true;
+                    });
+    return value;
+  };
+  auto record = [&](long value) {
+    storage.RecordLong(value, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  record(10l);
+  EXPECT_EQ(collect(delta.get()), 10l);
+  record(20l);
+  EXPECT_EQ(collect(delta.get()), 20l);
+  // The cumulative collector gets both deltas it has not seen yet, merged.
+  EXPECT_EQ(collect(cumulative.get()), 30l);
+  record(5l);
+  EXPECT_EQ(collect(cumulative.get()), 35l);
+  // The delta collector gets everything since its last collection, over several deltas.
+  EXPECT_EQ(collect(delta.get()), 5l);
+  EXPECT_EQ(collect(delta.get()), -1l);
+  EXPECT_EQ(collect(cumulative.get()), 35l);
+}
+
+TEST(SyncMetricStorageTest, SharedCumulativeState)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  std::map<std::string, std::string> attributes = {{"RequestType", "GET"}};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+
+  std::shared_ptr<CollectorHandle> pull(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::shared_ptr<CollectorHandle> push(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::shared_ptr<CollectorHandle> delta(new MockCollectorHandle(AggregationTemporality::kDelta));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{pull, push, delta};
+
+  // Returns the sum reported to `collector`, or -1 if it got no point.
+  auto collect = [&](CollectorHandle *collector) {
+    long value = -1;
+    storage.Collect(collector, collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        value = opentelemetry::nostd::get<long>(
+                            opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_);
+                      }
+                      return true;
+                    });
+    return value;
+  };
+  auto record = [&](long value) {
+    storage.RecordLong(value, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  // The cumulative collectors report the same cumulative state, whichever collects first.
+  record(10l);
+  EXPECT_EQ(collect(pull.get()), 10l);
+  record(5l);
+  EXPECT_EQ(collect(push.get()), 15l);
+  EXPECT_EQ(collect(pull.get()), 15l);
+  record(1l);
+  EXPECT_EQ(collect(pull.get()), 16l);
+  EXPECT_EQ(collect(push.get()), 16l);
+  // The delta collector still gets everything since its last collection.
+  EXPECT_EQ(collect(delta.get()), 16l);
+  record(4l);
+  EXPECT_EQ(collect(delta.get()), 4l);
+  EXPECT_EQ(collect(push.get()), 20l);
+
+  // A collector removed from the list no longer holds back the delta maps.
+  collectors = {pull, push};
+  record(2l);
+  EXPECT_EQ(collect(pull.get()), 22l);
+  EXPECT_EQ(collect(push.get()), 22l);
+}
+
+TEST(SyncMetricStorageTest, CumulativeInPlace)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  std::map<std::string, std::string> attributes = {{"RequestType", "GET"}};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+
+  std::shared_ptr<CollectorHandle> cumulative(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::shared_ptr<CollectorHandle> delta(new MockCollectorHandle(AggregationTemporality::kDelta));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{cumulative};
+
+  // Returns the sum of the points reported to `collector`, or -1 if it got no point.
+  auto collect = [&](CollectorHandle *collector) {
+    long value = -1;
+    storage.Collect(collector, collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        value = (value < 0 ? 0 : value) +
+                                opentelemetry::nostd::get<long>(
+                                    opentelemetry::nostd::get<SumPointData>(data_attr.point_data)
+                                        .value_);
+                      }
+                      return true;
+                    });
+    return value;
+  };
+  auto record = [&](long value) {
+    storage.RecordLong(value, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  EXPECT_EQ(collect(cumulative.get()), -1l);
+  record(10l);
+  EXPECT_EQ(collect(cumulative.get()), 10l);
+  record(5l);
+  EXPECT_EQ(collect(cumulative.get()), 15l);
+  EXPECT_EQ(collect(cumulative.get()), 15l);
+
+  // Bound series add to the running totals, and keep them once unbound.
+  std::map<std::string, std::string> bound_attributes = {{"RequestType", "PUT"}};
+  {
+    auto bound = storage.Bind(
+        KeyValueIterableView<std::map<std::string, std::string>>(bound_attributes));
+    bound->RecordLong(3l, opentelemetry::context::Context{});
+  }
+  EXPECT_EQ(collect(cumulative.get()), 18l);
+
+  // A delta collector hands the running totals over to the temporal storage, as a single delta.
+  collectors = {cumulative, delta};
+  record(1l);
+  EXPECT_EQ(collect(delta.get()), 19l);
+  record(2l);
+  EXPECT_EQ(collect(delta.get()), 2l);
+  EXPECT_EQ(collect(cumulative.get()), 21l);
+}
+
+TEST(SyncMetricStorageTest, CardinalityLimit)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir(), 3);
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  // Returns the reported sums by request id, "overflow" standing for the overflow series.
+  auto collect = [&]() {
+    std::map<std::string, long> values;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        auto id   = data_attr.attributes.find("id");
+                        auto name = id == data_attr.attributes.end()
+                                        ? std::string("overflow")
+                                        : opentelemetry::nostd::get<std::string>(id->second);
+                        values[name] = opentelemetry::nostd::get<long>(
+                            opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_);
+                      }
+                      return true;
+                    });
+    return values;
+  };
+  auto record = [&](const std::string &id) {
+    std::map<std::string, std::string> attributes = {{"id", id}};
+    storage.RecordLong(1l, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  record("a");
+  record("b");
+  record("c");
+  record("d");
+  record("a");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 2l}, {"b", 1l}, {"overflow", 2l}}));
+
+  // A new series of a later cycle fits its delta map, but not the reported cumulative metrics.
+  record("e");
+  record("b");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 2l}, {"b", 2l}, {"overflow", 3l}}));
+}
+
+TEST(SyncMetricStorageTest, EvictIdleSeries)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir(), kAggregationCardinalityLimit, 2);
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  auto collect = [&]() {
+    std::map<std::string, long> values;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        values[opentelemetry::nostd::get<std::string>(
+                            data_attr.attributes.find("id")->second)] =
+                            opentelemetry::nostd::get<long>(
+                                opentelemetry::nostd::get<SumPointData>(data_attr.point_data)
+                                    .value_);
+                      }
+                      return true;
+                    });
+    return values;
+  };
+  auto record = [&](const std::string &id) {
+    std::map<std::string, std::string> attributes = {{"id", id}};
+    storage.RecordLong(1l, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  record("a");
+  record("b");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 1l}, {"b", 1l}}));
+  record("a");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 2l}, {"b", 1l}}));
+  // "b" was not updated in the last two collections.
+  record("a");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 3l}}));
+  // An evicted series starts over.
+  record("b");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 3l}, {"b", 1l}}));
+}
+
+class ChangedOnlyTestFixture : public ::testing::TestWithParam<size_t>
+{};
+
+TEST_P(ChangedOnlyTestFixture, ReportsChangedSeries)
+{
+  // Without idle series eviction the running totals are kept in place, with it they are merged
+  // from the delta maps.
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  opentelemetry::sdk::metrics::SyncMetricStorage storage(
+      instr_desc, AggregationType::kSum, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir(), kAggregationCardinalityLimit, GetParam());
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative, 3));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+
+  auto collect = [&]() {
+    std::map<std::string, long> values;
+    storage.Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                    [&](const MetricData data) {
+                      for (auto data_attr : data.point_data_attr_)
+                      {
+                        values[opentelemetry::nostd::get<std::string>(
+                            data_attr.attributes.find("id")->second)] =
+                            opentelemetry::nostd::get<long>(
+                                opentelemetry::nostd::get<SumPointData>(data_attr.point_data)
+                                    .value_);
+                      }
+                      return true;
+                    });
+    return values;
+  };
+  auto record = [&](const std::string &id) {
+    std::map<std::string, std::string> attributes = {{"id", id}};
+    storage.RecordLong(1l, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                       opentelemetry::context::Context{});
+  };
+
+  record("a");
+  record("b");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 1l}, {"b", 1l}}));
+  record("a");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 2l}}));
+  EXPECT_EQ(collect(), (std::map<std::string, long>{}));
+  // "b" was last reported three collections ago.
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"b", 1l}}));
+  record("b");
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 2l}, {"b", 2l}}));
+}
+
+INSTANTIATE_TEST_SUITE_P(ChangedOnly, ChangedOnlyTestFixture, ::testing::Values(0, 100));
+
+TEST(SyncMetricStorageTest, CreateTyped)
+{
+  auto sdk_start_ts               = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  auto storage                    = SyncMetricStorage::Create(
+      instr_desc, AggregationType::kDefault, new DefaultAttributesProcessor(),
+      NoExemplarReservoir::GetNoExemplarReservoir());
+  using LongSumStorage = TypedSyncMetricStorage<long, LongSumAggregation>;
+  EXPECT_NE(dynamic_cast<LongSumStorage *>(storage.get()), nullptr);
+
+  std::map<std::string, std::string> attributes = {{"RequestType", "GET"}};
+  storage->RecordLong(10l, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                      opentelemetry::context::Context{});
+  storage->RecordLong(5l, opentelemetry::context::Context{});
+  // Measurements of the other value type are dropped.
+  storage->RecordDouble(20.0, KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                        opentelemetry::context::Context{});
+  storage->RecordDouble(20.0, opentelemetry::context::Context{});
+
+  std::shared_ptr<CollectorHandle> collector(
+      new MockCollectorHandle(AggregationTemporality::kCumulative));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  long total              = 0;
+  size_t count_attributes = 0;
+  storage->Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                   [&](const MetricData data) {
+                     for (auto data_attr : data.point_data_attr_)
+                     {
+                       total += opentelemetry::nostd::get<long>(
+                           opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_);
+                       count_attributes++;
+                     }
+                     return true;
+                   });
+  EXPECT_EQ(count_attributes, 2);
+  EXPECT_EQ(total, 15l);
+
+  instr_desc.type_       = InstrumentType::kHistogram;
+  instr_desc.value_type_ = InstrumentValueType::kDouble;
+  storage                = SyncMetricStorage::Create(instr_desc, AggregationType::kDefault,
+                                                     new DefaultAttributesProcessor(),
+                                                     NoExemplarReservoir::GetNoExemplarReservoir());
+  using DoubleHistogramStorage = TypedSyncMetricStorage<double, DoubleHistogramAggregation>;
+  EXPECT_NE(dynamic_cast<DoubleHistogramStorage *>(storage.get()), nullptr);
+}
+
+class PartitionedTestFixture : public ::testing::TestWithParam<AggregationTemporality>
+{};
+
+TEST_P(PartitionedTestFixture, LongSumAcrossCollections)
+{
+  AggregationTemporality temporality = GetParam();
+  auto sdk_start_ts                  = std::chrono::system_clock::now();
+  InstrumentDescriptor instr_desc    = {"name", "desc", "1unit", InstrumentType::kCounter,
+                                     InstrumentValueType::kLong};
+  auto storage = SyncMetricStorage::Create(instr_desc, AggregationType::kSum,
+                                           new DefaultAttributesProcessor(),
+                                           NoExemplarReservoir::GetNoExemplarReservoir(),
+                                           kAggregationCardinalityLimit, 0, 2);
+
+  std::shared_ptr<CollectorHandle> collector(new MockCollectorHandle(temporality));
+  std::vector<std::shared_ptr<CollectorHandle>> collectors{collector};
+  auto collect = [&]() {
+    std::map<std::string, long> values;
+    storage->Collect(collector.get(), collectors, sdk_start_ts, std::chrono::system_clock::now(),
+                     [&](const MetricData data) {
+                       for (auto data_attr : data.point_data_attr_)
+                       {
+                         auto &id = data_attr.attributes.find("id")->second;
+                         auto &value =
+                             opentelemetry::nostd::get<SumPointData>(data_attr.point_data).value_;
+                         values[opentelemetry::nostd::get<std::string>(id)] =
+                             opentelemetry::nostd::get<long>(value);
+                       }
+                       return true;
+                     });
+    return values;
+  };
+  auto record = [&](const std::string &id, long value) {
+    std::map<std::string, std::string> attributes = {{"id", id}};
+    storage->RecordLong(value,
+                        KeyValueIterableView<std::map<std::string, std::string>>(attributes),
+                        opentelemetry::context::Context{});
+  };
+
+  record("a", 1l);
+  record("b", 2l);
+  EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 1l}, {"b", 2l}}));
+  record("a", 4l);
+  if (temporality == AggregationTemporality::kDelta)
+  {
+    EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 4l}}));
+  }
+  else
+  {
+    EXPECT_EQ(collect(), (std::map<std::string, long>{{"a", 5l}, {"b", 2l}}));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Partitioned,
+                         PartitionedTestFixture,
+                         ::testing::Values(AggregationTemporality::kCumulative,
+                                           AggregationTemporality::kDelta));
+
 #endif
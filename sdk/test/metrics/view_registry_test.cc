@@ -70,13 +70,85 @@ TEST(ViewRegistry, FindNonExistingView)
       registry.FindViews(default_instrument_descriptor, *default_instrumentation_lib.get(),
                          [&count, &view_name, &view_description](const View &view) {
                            count++;
-#  if HAVE_WORKING_REGEX
                            EXPECT_EQ(view.GetName(), view_name);
                            EXPECT_EQ(view.GetDescription(), view_description);
-#  endif
                            return true;
                          });
   EXPECT_EQ(count, 1);
   EXPECT_EQ(status, true);
 }
+
+TEST(ViewRegistry, PatternPredicate)
+{
+  EXPECT_TRUE(PatternPredicate("http.*").Match("http.requests"));
+  EXPECT_TRUE(PatternPredicate("http.*").Match("http."));
+  EXPECT_FALSE(PatternPredicate("http.*").Match("rpc.requests"));
+  EXPECT_TRUE(PatternPredicate("*.count").Match("requests.count"));
+  EXPECT_FALSE(PatternPredicate("*.count").Match("requests.counter"));
+  EXPECT_TRUE(PatternPredicate("a*b*c").Match("abc"));
+  EXPECT_TRUE(PatternPredicate("a*b*c").Match("axxbxxbxxc"));
+  EXPECT_FALSE(PatternPredicate("a*b*c").Match("axxcxxb"));
+  EXPECT_FALSE(PatternPredicate("ab*ba").Match("aba"));
+  EXPECT_TRUE(PatternPredicate("a?c").Match("abc"));
+  EXPECT_FALSE(PatternPredicate("a?c").Match("ac"));
+  EXPECT_TRUE(PatternPredicate("*?b*").Match("ab"));
+  EXPECT_FALSE(PatternPredicate("*?b*").Match("b"));
+  EXPECT_TRUE(PatternPredicate("**").Match(""));
+  EXPECT_TRUE(PatternPredicate("").Match(""));
+  EXPECT_FALSE(PatternPredicate("").Match("a"));
+}
+
+static void AddView(ViewRegistry &registry,
+                    const std::string &view_name,
+                    const std::string &instrument_name)
+{
+  registry.AddView(
+      std::unique_ptr<InstrumentSelector>(
+          new InstrumentSelector(InstrumentType::kCounter, instrument_name)),
+      std::unique_ptr<MeterSelector>(new MeterSelector("meter", "", "")),
+      std::unique_ptr<View>(new View(view_name)));
+}
+
+static std::vector<std::string> FindViewNames(const ViewRegistry &registry,
+                                              const std::string &instrument_name,
+                                              InstrumentType type = InstrumentType::kCounter)
+{
+  InstrumentDescriptor descriptor = {instrument_name, "", "1", type, InstrumentValueType::kLong};
+  auto library                    = InstrumentationLibrary::Create("meter");
+  std::vector<std::string> names;
+  registry.FindViews(descriptor, *library, [&names](const View &view) {
+    names.push_back(view.GetName());
+    return true;
+  });
+  return names;
+}
+
+TEST(ViewRegistry, FindViewsInRegistrationOrder)
+{
+  ViewRegistry registry;
+  AddView(registry, "all", "*");
+  AddView(registry, "exact", "http.requests");
+  AddView(registry, "http", "http.*");
+  AddView(registry, "other", "rpc.requests");
+
+  EXPECT_EQ(FindViewNames(registry, "http.requests"),
+            std::vector<std::string>({"all", "exact", "http"}));
+  EXPECT_EQ(FindViewNames(registry, "http.errors"), std::vector<std::string>({"all", "http"}));
+  EXPECT_EQ(FindViewNames(registry, "rpc.requests"), std::vector<std::string>({"all", "other"}));
+  EXPECT_EQ(FindViewNames(registry, "http.requests", InstrumentType::kHistogram),
+            std::vector<std::string>({"otel-default-view"}));
+}
+
+TEST(ViewRegistry, AddViewInvalidatesResolvedViews)
+{
+  ViewRegistry registry;
+  AddView(registry, "exact", "http.requests");
+  EXPECT_EQ(FindViewNames(registry, "http.requests"), std::vector<std::string>({"exact"}));
+  EXPECT_EQ(FindViewNames(registry, "http.errors"),
+            std::vector<std::string>({"otel-default-view"}));
+
+  AddView(registry, "http", "http.*");
+  EXPECT_EQ(FindViewNames(registry, "http.requests"), std::vector<std::string>({"exact", "http"}));
+  EXPECT_EQ(FindViewNames(registry, "http.errors"), std::vector<std::string>({"http"}));
+}
 #endif
@@ -8,9 +8,16 @@
 #include "opentelemetry/sdk/resource/experimental_semantic_conventions.h"
 #include "opentelemetry/sdk/resource/resource_detector.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -211,3 +218,115 @@ TEST(ResourceTest, OtelResourceDetectorEmptyEnv)
   EXPECT_EQ(received_attributes.size(), expected_attributes.size());
 }
 #endif
+
+namespace
+{
+/**
+ * A detector returning a fixed resource, after a delay, and counting its calls.
+ */
+class FixedResourceDetector : public ResourceDetector
+{
+public:
+  FixedResourceDetector(ResourceAttributes attributes,
+                        std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+      : attributes_(std::move(attributes)), delay_(delay)
+  {}
+
+  Resource Detect() noexcept override
+  {
+    ++calls_;
+    std::this_thread::sleep_for(delay_);
+    return TestResource(attributes_);
+  }
+
+  std::atomic<int> calls_{0};
+
+private:
+  ResourceAttributes attributes_;
+  std::chrono::milliseconds delay_;
+};
+}  // namespace
+
+TEST(ResourceTest, ParallelResourceDetector)
+{
+  std::vector<std::shared_ptr<ResourceDetector>> detectors = {
+      std::make_shared<FixedResourceDetector>(ResourceAttributes{{"a", "1"}, {"b", "1"}},
+                                              std::chrono::milliseconds(20)),
+      std::make_shared<FixedResourceDetector>(ResourceAttributes{{"b", "2"}, {"c", "2"}})};
+  ParallelResourceDetector detector(detectors);
+
+  auto attributes = detector.Detect().GetAttributes();
+  EXPECT_EQ(attributes.size(), 3);
+  EXPECT_EQ(nostd::get<std::string>(attributes["a"]), "1");
+  // The later detector wins, even though it finished first.
+  EXPECT_EQ(nostd::get<std::string>(attributes["b"]), "2");
+  EXPECT_EQ(nostd::get<std::string>(attributes["c"]), "2");
+}
+
+TEST(ResourceTest, ParallelResourceDetectorTimeout)
+{
+  std::vector<std::shared_ptr<ResourceDetector>> detectors = {
+      std::make_shared<FixedResourceDetector>(ResourceAttributes{{"slow", true}},
+                                              std::chrono::milliseconds(2000)),
+      std::make_shared<FixedResourceDetector>(ResourceAttributes{{"fast", true}})};
+  ParallelResourceDetector detector(detectors, std::chrono::milliseconds(50));
+
+  auto start      = std::chrono::steady_clock::now();
+  auto attributes = detector.Detect().GetAttributes();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+  EXPECT_EQ(attributes.size(), 1);
+  EXPECT_TRUE(attributes.find("fast") != attributes.end());
+}
+
+TEST(ResourceTest, CachedResourceDetector)
+{
+  const std::string path = "cached_resource_detector_test.cache";
+  std::remove(path.c_str());
+
+  ResourceAttributes expected = {{"bool", true},
+                                 {"int", int32_t(-3)},
+                                 {"uint", uint32_t(3)},
+                                 {"int64", int64_t(-1) << 40},
+                                 {"uint64", uint64_t(1) << 63},
+                                 {"double", 0.1},
+                                 {"string", "tab\tnew\nline\\"},
+                                 {"key\twith\ttabs", "value"}};
+  auto source = std::make_shared<FixedResourceDetector>(expected);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    CachedResourceDetector detector(source, path);
+    auto attributes = detector.Detect().GetAttributes();
+    EXPECT_EQ(attributes.size(), expected.size());
+    for (auto &attribute : expected)
+    {
+      ASSERT_TRUE(attributes.find(attribute.first) != attributes.end()) << attribute.first;
+      EXPECT_TRUE(attributes[attribute.first] == attribute.second) << attribute.first;
+    }
+  }
+  // The second detector read the file.
+  EXPECT_EQ(source->calls_.load(), 1);
+
+  CachedResourceDetector expired(source, path, std::chrono::seconds(-1));
+  expired.Detect();
+  EXPECT_EQ(source->calls_.load(), 2);
+
+  std::remove(path.c_str());
+}
+
+TEST(ResourceTest, CachedResourceDetectorSkipsArrays)
+{
+  const std::string path = "cached_resource_detector_arrays_test.cache";
+  std::remove(path.c_str());
+
+  const int32_t values[] = {1, 2};
+  ResourceAttributes attributes;
+  attributes.SetAttribute("array", nostd::span<const int32_t>(values));
+  auto source = std::make_shared<FixedResourceDetector>(attributes);
+
+  CachedResourceDetector detector(source, path);
+  EXPECT_EQ(detector.Detect().GetAttributes().size(), 1);
+  EXPECT_EQ(detector.Detect().GetAttributes().size(), 1);
+  EXPECT_EQ(source->calls_.load(), 2);
+  EXPECT_FALSE(std::ifstream(path).good());
+}
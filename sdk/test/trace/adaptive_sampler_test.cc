@@ -0,0 +1,114 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/adaptive.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+#include "src/common/random.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using opentelemetry::sdk::common::Random;
+using opentelemetry::sdk::trace::AdaptiveSampler;
+using opentelemetry::sdk::trace::Decision;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+
+namespace
+{
+using M = std::map<std::string, int>;
+using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+
+/*
+ * Returns the number of RECORD_AND_SAMPLE decisions taken by the sampler for
+ * the given number of random trace ids.
+ */
+int RunShouldSampleCountDecision(AdaptiveSampler &sampler, int iterations)
+{
+  M m1 = {{}};
+  L l1 = {{trace_api::SpanContext(false, false), {}}};
+  common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  int actual_count = 0;
+  for (int i = 0; i < iterations; ++i)
+  {
+    uint8_t buf[16] = {0};
+    Random::GenerateRandomBuffer(buf);
+
+    auto result = sampler.ShouldSample(trace_api::SpanContext::GetInvalid(),
+                                       trace_api::TraceId(buf), "", trace_api::SpanKind::kInternal,
+                                       view, links);
+    if (result.decision == Decision::RECORD_AND_SAMPLE)
+    {
+      ++actual_count;
+    }
+  }
+  return actual_count;
+}
+}  // namespace
+
+TEST(AdaptiveSampler, InitialRatio)
+{
+  AdaptiveSampler sampler(10, std::chrono::hours(1), 0.5);
+  ASSERT_EQ(0.5, sampler.GetRatio());
+
+  int iterations = 100000;
+  int sampled    = RunShouldSampleCountDecision(sampler, iterations);
+  ASSERT_GT(sampled, iterations * 0.49);
+  ASSERT_LT(sampled, iterations * 0.51);
+
+  AdaptiveSampler all(10, std::chrono::hours(1));
+  ASSERT_EQ(iterations, RunShouldSampleCountDecision(all, iterations));
+
+  AdaptiveSampler none(10, std::chrono::hours(1), 0.0);
+  ASSERT_EQ(0, RunShouldSampleCountDecision(none, iterations));
+}
+
+TEST(AdaptiveSampler, AdjustsRatioTowardsTarget)
+{
+  AdaptiveSampler sampler(10, std::chrono::milliseconds(100));
+
+  // Far more spans than the target are started during the first interval.
+  RunShouldSampleCountDecision(sampler, 1000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  RunShouldSampleCountDecision(sampler, 1);
+  double ratio = sampler.GetRatio();
+  ASSERT_GE(ratio, 0.5);
+  ASSERT_LT(ratio, 0.6);
+
+  // Fewer spans than the target are started during the second interval.
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  RunShouldSampleCountDecision(sampler, 1);
+  ASSERT_GT(sampler.GetRatio(), ratio);
+}
+
+TEST(AdaptiveSampler, SetsTraceState)
+{
+  AdaptiveSampler sampler(10, std::chrono::hours(1));
+
+  M m1 = {{}};
+  L l1 = {{trace_api::SpanContext(false, false), {}}};
+  common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  auto sampling_result =
+      sampler.ShouldSample(trace_api::SpanContext::GetInvalid(), trace_api::TraceId(), "",
+                           trace_api::SpanKind::kInternal, view, links);
+  ASSERT_EQ(Decision::RECORD_AND_SAMPLE, sampling_result.decision);
+
+  std::string value;
+  ASSERT_TRUE(sampling_result.trace_state->Get(AdaptiveSampler::kTraceStateKey, value));
+  ASSERT_EQ("ratio:1.000000", value);
+}
+
+TEST(AdaptiveSampler, GetDescription)
+{
+  AdaptiveSampler sampler(100);
+  ASSERT_EQ("AdaptiveSampler{100.000000}", sampler.GetDescription());
+
+  ASSERT_THROW(AdaptiveSampler(0), std::invalid_argument);
+}
@@ -0,0 +1,170 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/arena_span_data.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/common/key_value_iterable_view.h"
+#include "opentelemetry/nostd/variant.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using opentelemetry::sdk::trace::ArenaSpanData;
+using opentelemetry::sdk::trace::ArenaSpanDataEvent;
+using opentelemetry::sdk::trace::ArenaSpanDataLink;
+using opentelemetry::sdk::trace::SpanData;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+namespace nostd     = opentelemetry::nostd;
+
+TEST(ArenaSpanData, DefaultValues)
+{
+  ArenaSpanData data;
+
+  ASSERT_EQ(data.GetSpanContext(), trace_api::SpanContext(false, false));
+  ASSERT_EQ(data.GetParentSpanId(), trace_api::SpanId());
+  ASSERT_EQ(data.GetName(), "");
+  ASSERT_EQ(data.GetStatus(), trace_api::StatusCode::kUnset);
+  ASSERT_EQ(data.GetDescription(), "");
+  ASSERT_EQ(data.GetDuration(), std::chrono::nanoseconds(0));
+  ASSERT_EQ(data.GetAttributes().size(), 0);
+  ASSERT_TRUE(data.ForEachEvent([](const ArenaSpanDataEvent &) { return false; }));
+  ASSERT_TRUE(data.ForEachLink([](const ArenaSpanDataLink &) { return false; }));
+}
+
+TEST(ArenaSpanData, Set)
+{
+  constexpr uint8_t trace_id_buf[] = {1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8};
+  constexpr uint8_t span_id_buf[]  = {1, 2, 3, 4, 5, 6, 7, 8};
+  const trace_api::SpanContext span_context{
+      trace_api::TraceId{trace_id_buf}, trace_api::SpanId{span_id_buf},
+      trace_api::TraceFlags{trace_api::TraceFlags::kIsSampled}, true,
+      trace_api::TraceState::GetDefault()->Set("key1", "value")};
+  common::SystemTimestamp now(std::chrono::system_clock::now());
+
+  ArenaSpanData data;
+  std::string name = "span name";
+  data.SetIdentity(span_context, trace_api::SpanId{span_id_buf});
+  data.SetName(name);
+  name = "modified";
+  data.SetStatus(trace_api::StatusCode::kOk, "description");
+  data.SetDuration(std::chrono::nanoseconds(1000000));
+
+  ASSERT_EQ(data.GetSpanContext(), span_context);
+  ASSERT_EQ(data.GetName(), "span name");
+  ASSERT_EQ(data.GetStatus(), trace_api::StatusCode::kOk);
+  ASSERT_EQ(data.GetDescription(), "description");
+  ASSERT_EQ(data.GetDuration(), std::chrono::nanoseconds(1000000));
+
+  std::string value                    = "value";
+  std::vector<nostd::string_view> list = {"a", "b"};
+  data.SetAttribute("attr1", (int64_t)314159);
+  data.SetAttribute("attr2", nostd::string_view(value));
+  data.SetAttribute("attr3", nostd::span<const nostd::string_view>(list));
+  data.SetAttribute("attr1", (int64_t)271828);
+  value = "modified";
+  list  = {"c", "d"};
+
+  ASSERT_EQ(data.GetAttributes().size(), 3);
+  std::map<std::string, common::AttributeValue> attributes;
+  data.GetAttributes().ForEachKeyValue([&](nostd::string_view key, common::AttributeValue value) {
+    attributes[std::string(key)] = value;
+    return true;
+  });
+  ASSERT_EQ(nostd::get<int64_t>(attributes["attr1"]), 271828);
+  ASSERT_EQ(nostd::get<nostd::string_view>(attributes["attr2"]), "value");
+  auto copied_list = nostd::get<nostd::span<const nostd::string_view>>(attributes["attr3"]);
+  ASSERT_EQ(copied_list.size(), 2);
+  ASSERT_EQ(copied_list[1], "b");
+
+  // Keys are interned in the process-wide table.
+  auto &key_table = opentelemetry::sdk::common::AttributeKeyTable::GetInstance();
+  data.GetAttributes().ForEachKeyIdValue(
+      [&](opentelemetry::sdk::common::AttributeKeyTable::KeyId key_id, nostd::string_view key,
+          common::AttributeValue) {
+        EXPECT_EQ(key_table.GetKey(key_id), key);
+        return true;
+      });
+}
+
+TEST(ArenaSpanData, EventsAndLinks)
+{
+  ArenaSpanData data;
+  common::SystemTimestamp now(std::chrono::system_clock::now());
+  std::map<std::string, int> attributes = {{"attr1", 1}};
+
+  for (int i = 0; i < 100; ++i)
+  {
+    data.AddEvent("event" + std::to_string(i), now,
+                  common::KeyValueIterableView<std::map<std::string, int>>(attributes));
+  }
+  data.AddLink(trace_api::SpanContext(false, false),
+               common::KeyValueIterableView<std::map<std::string, int>>(attributes));
+
+  int num_events = 0;
+  data.ForEachEvent([&](const ArenaSpanDataEvent &event) {
+    EXPECT_EQ(event.GetName(), "event" + std::to_string(num_events));
+    EXPECT_EQ(event.GetTimestamp(), now);
+    EXPECT_EQ(event.GetAttributes().size(), 1);
+    ++num_events;
+    return true;
+  });
+  ASSERT_EQ(num_events, 100);
+
+  int num_links = 0;
+  data.ForEachLink([&](const ArenaSpanDataLink &link) {
+    EXPECT_EQ(link.GetAttributes().size(), 1);
+    ++num_links;
+    return true;
+  });
+  ASSERT_EQ(num_links, 1);
+
+  // 100 events do not fit in the inline block.
+  ASSERT_LT(0, data.GetArenaHeapSize());
+}
+
+TEST(ArenaSpanData, Replay)
+{
+  constexpr uint8_t trace_id_buf[] = {1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8};
+  constexpr uint8_t span_id_buf[]  = {1, 2, 3, 4, 5, 6, 7, 8};
+  const trace_api::SpanContext span_context{
+      trace_api::TraceId{trace_id_buf}, trace_api::SpanId{span_id_buf},
+      trace_api::TraceFlags{trace_api::TraceFlags::kIsSampled}, true};
+  common::SystemTimestamp now(std::chrono::system_clock::now());
+  std::map<std::string, int> attributes = {{"attr1", 1}};
+
+  ArenaSpanData data;
+  data.SetIdentity(span_context, trace_api::SpanId{span_id_buf});
+  data.SetName("span name");
+  data.SetSpanKind(trace_api::SpanKind::kClient);
+  data.SetStatus(trace_api::StatusCode::kError, "description");
+  data.SetStartTime(now);
+  data.SetDuration(std::chrono::nanoseconds(1000));
+  data.SetAttribute("attr1", "value");
+  data.AddEvent("event1", now,
+                common::KeyValueIterableView<std::map<std::string, int>>(attributes));
+  data.AddLink(span_context, common::KeyValueIterableView<std::map<std::string, int>>(attributes));
+  data.SetDroppedCounts(1, 2, 3);
+
+  SpanData copy;
+  data.Replay(copy);
+  EXPECT_EQ(copy.GetSpanContext(), span_context);
+  EXPECT_EQ(copy.GetParentSpanId(), trace_api::SpanId{span_id_buf});
+  EXPECT_EQ(copy.GetName(), "span name");
+  EXPECT_EQ(copy.GetSpanKind(), trace_api::SpanKind::kClient);
+  EXPECT_EQ(copy.GetStatus(), trace_api::StatusCode::kError);
+  EXPECT_EQ(copy.GetDescription(), "description");
+  EXPECT_EQ(copy.GetStartTime(), now);
+  EXPECT_EQ(copy.GetDuration(), std::chrono::nanoseconds(1000));
+  EXPECT_EQ(nostd::get<std::string>(copy.GetAttributes().at("attr1")), "value");
+  ASSERT_EQ(copy.GetEvents().size(), 1);
+  EXPECT_EQ(copy.GetEvents()[0].GetName(), "event1");
+  EXPECT_EQ(nostd::get<int32_t>(copy.GetEvents()[0].GetAttributes().at("attr1")), 1);
+  ASSERT_EQ(copy.GetLinks().size(), 1);
+  EXPECT_EQ(copy.GetLinks()[0].GetSpanContext(), span_context);
+  EXPECT_EQ(copy.GetDroppedAttributesCount(), 1);
+  EXPECT_EQ(copy.GetDroppedEventsCount(), 2);
+  EXPECT_EQ(copy.GetDroppedLinksCount(), 3);
+}
@@ -0,0 +1,107 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/backpressure.h"
+#include "opentelemetry/sdk/trace/samplers/always_off.h"
+#include "opentelemetry/sdk/trace/samplers/always_on.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+#include "src/common/random.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using opentelemetry::sdk::common::BackpressureSignal;
+using opentelemetry::sdk::common::Random;
+using opentelemetry::sdk::trace::AlwaysOffSampler;
+using opentelemetry::sdk::trace::AlwaysOnSampler;
+using opentelemetry::sdk::trace::BackpressureSampler;
+using opentelemetry::sdk::trace::Decision;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+
+namespace
+{
+using M = std::map<std::string, int>;
+using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+
+/*
+ * Returns the number of RECORD_AND_SAMPLE decisions taken by the sampler for
+ * the given number of random trace ids.
+ */
+int RunShouldSampleCountDecision(BackpressureSampler &sampler, int iterations)
+{
+  M m1 = {{}};
+  L l1 = {{trace_api::SpanContext(false, false), {}}};
+  common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  int actual_count = 0;
+  for (int i = 0; i < iterations; ++i)
+  {
+    uint8_t buf[16] = {0};
+    Random::GenerateRandomBuffer(buf);
+
+    auto result = sampler.ShouldSample(trace_api::SpanContext::GetInvalid(),
+                                       trace_api::TraceId(buf), "", trace_api::SpanKind::kInternal,
+                                       view, links);
+    if (result.decision == Decision::RECORD_AND_SAMPLE)
+    {
+      ++actual_count;
+    }
+  }
+  return actual_count;
+}
+}  // namespace
+
+TEST(BackpressureSampler, KeepsDelegateDecisionsBelowThreshold)
+{
+  auto signal = std::make_shared<BackpressureSignal>();
+  BackpressureSampler sampler(std::make_shared<AlwaysOnSampler>(), signal, 0.5);
+  ASSERT_EQ(1.0, sampler.GetKeepRatio());
+  ASSERT_EQ(1000, RunShouldSampleCountDecision(sampler, 1000));
+
+  signal->SetQueueOccupancy(0.5);
+  ASSERT_EQ(1.0, sampler.GetKeepRatio());
+  ASSERT_EQ(1000, RunShouldSampleCountDecision(sampler, 1000));
+
+  BackpressureSampler off_sampler(std::make_shared<AlwaysOffSampler>(), signal, 0.5);
+  ASSERT_EQ(0, RunShouldSampleCountDecision(off_sampler, 1000));
+}
+
+TEST(BackpressureSampler, ShedsSpansPastThreshold)
+{
+  auto signal = std::make_shared<BackpressureSignal>();
+  BackpressureSampler sampler(std::make_shared<AlwaysOnSampler>(), signal, 0.5);
+
+  // Halfway between the threshold and a full queue, half the traces are kept.
+  signal->SetExportLag(0.75);
+  ASSERT_DOUBLE_EQ(0.5, sampler.GetKeepRatio());
+  int iterations = 100000;
+  int sampled    = RunShouldSampleCountDecision(sampler, iterations);
+  ASSERT_NEAR(iterations / 2, sampled, iterations / 50);
+
+  // The processor drops spans: every span is shed.
+  signal->SetQueueFull();
+  ASSERT_EQ(0.0, sampler.GetKeepRatio());
+  ASSERT_EQ(0, RunShouldSampleCountDecision(sampler, 1000));
+
+  signal->SetQueueOccupancy(0.0);
+  signal->SetExportLag(0.0);
+  ASSERT_EQ(1000, RunShouldSampleCountDecision(sampler, 1000));
+}
+
+TEST(BackpressureSampler, GetDescription)
+{
+  auto signal = std::make_shared<BackpressureSignal>();
+  BackpressureSampler sampler(std::make_shared<AlwaysOnSampler>(), signal);
+  ASSERT_EQ("Backpressure{AlwaysOnSampler}", sampler.GetDescription());
+
+  ASSERT_THROW(BackpressureSampler(nullptr, signal), std::invalid_argument);
+  ASSERT_THROW(BackpressureSampler(std::make_shared<AlwaysOnSampler>(), nullptr),
+               std::invalid_argument);
+  ASSERT_THROW(BackpressureSampler(std::make_shared<AlwaysOnSampler>(), signal, 1.0),
+               std::invalid_argument);
+}
@@ -6,9 +6,20 @@
 #include "opentelemetry/sdk/trace/tracer.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <map>
 #include <thread>
 
+#ifdef __unix__
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
 OPENTELEMETRY_BEGIN_NAMESPACE
 
 /**
@@ -73,6 +84,119 @@ class MockSpanExporter final : public sdk::trace::SpanExporter
   const std::chrono::milliseconds export_delay_;
 };
 
+/**
+ * Returns a mock span exporter that completes each ExportAsync call on its own thread after a delay
+ */
+class MockAsyncSpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  MockAsyncSpanExporter(std::shared_ptr<std::atomic<size_t>> spans_received,
+                        std::shared_ptr<std::atomic<size_t>> max_in_flight,
+                        const std::chrono::milliseconds export_delay) noexcept
+      : spans_received_(spans_received), max_in_flight_(max_in_flight), export_delay_(export_delay)
+  {}
+
+  ~MockAsyncSpanExporter() override { Shutdown(); }
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    *spans_received_ += recordables.size();
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  void ExportAsync(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables,
+      std::function<void(sdk::common::ExportResult)> &&result_callback) noexcept override
+  {
+    size_t in_flight = ++in_flight_;
+    size_t observed  = max_in_flight_->load();
+    while (in_flight > observed && !max_in_flight_->compare_exchange_weak(observed, in_flight))
+    {
+    }
+
+    std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::Recordable>>> batch(
+        new std::vector<std::unique_ptr<sdk::trace::Recordable>>);
+    for (auto &recordable : recordables)
+    {
+      batch->push_back(std::move(recordable));
+    }
+
+    std::lock_guard<std::mutex> guard(threads_m_);
+    threads_.emplace_back([this, batch, result_callback] {
+      std::this_thread::sleep_for(export_delay_);
+      *spans_received_ += batch->size();
+      --in_flight_;
+      result_callback(sdk::common::ExportResult::kSuccess);
+    });
+  }
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override
+  {
+    std::lock_guard<std::mutex> guard(threads_m_);
+    for (auto &thread : threads_)
+    {
+      thread.join();
+    }
+    threads_.clear();
+    return true;
+  }
+
+private:
+  std::shared_ptr<std::atomic<size_t>> spans_received_;
+  std::shared_ptr<std::atomic<size_t>> max_in_flight_;
+  const std::chrono::milliseconds export_delay_;
+  std::atomic<size_t> in_flight_{0};
+  std::mutex threads_m_;
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * Returns a mock span exporter which leaves the spans in the batch, and counts the recordables it
+ * makes
+ */
+class MockReadOnlySpanExporter final : public sdk::trace::SpanExporter
+{
+public:
+  MockReadOnlySpanExporter(std::shared_ptr<std::vector<std::string>> names_received,
+                           std::shared_ptr<std::atomic<size_t>> recordables_made) noexcept
+      : names_received_(names_received), recordables_made_(recordables_made)
+  {}
+
+  std::unique_ptr<sdk::trace::Recordable> MakeRecordable() noexcept override
+  {
+    ++*recordables_made_;
+    return std::unique_ptr<sdk::trace::Recordable>(new sdk::trace::SpanData);
+  }
+
+  sdk::common::ExportResult Export(
+      const nostd::span<std::unique_ptr<sdk::trace::Recordable>> &recordables) noexcept override
+  {
+    for (auto &recordable : recordables)
+    {
+      names_received_->push_back(
+          std::string(static_cast<sdk::trace::SpanData *>(recordable.get())->GetName()));
+    }
+    return sdk::common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(
+      std::chrono::microseconds timeout = std::chrono::microseconds::max()) noexcept override
+  {
+    return true;
+  }
+
+private:
+  std::shared_ptr<std::vector<std::string>> names_received_;
+  std::shared_ptr<std::atomic<size_t>> recordables_made_;
+};
+
 /**
  * Fixture Class
  */
@@ -89,8 +213,7 @@ class BatchSpanProcessorTestPeer : public testing::Test
     for (int i = 0; i < num_spans; ++i)
     {
       test_spans->push_back(processor->MakeRecordable());
-      static_cast<sdk::trace::SpanData *>(test_spans->at(i).get())
-          ->SetName("Span " + std::to_string(i));
+      test_spans->at(i)->SetName("Span " + std::to_string(i));
     }
 
     return test_spans;
@@ -131,6 +254,25 @@ TEST_F(BatchSpanProcessorTestPeer, TestShutdown)
   EXPECT_TRUE(is_shutdown->load());
 }
 
+TEST_F(BatchSpanProcessorTestPeer, TestShutdownWithoutSpans)
+{
+  /* Test that a processor whose worker thread was never started flushes and shuts down */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          sdk::trace::BatchSpanProcessorOptions()));
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_TRUE(batch_processor->Shutdown());
+  EXPECT_TRUE(is_shutdown->load());
+  EXPECT_EQ(0, spans_received->size());
+}
+
 TEST_F(BatchSpanProcessorTestPeer, TestForceFlush)
 {
   std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
@@ -181,6 +323,35 @@ TEST_F(BatchSpanProcessorTestPeer, TestForceFlush)
   }
 }
 
+TEST_F(BatchSpanProcessorTestPeer, TestForceFlushTimeout)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(500);
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(
+              new MockSpanExporter(spans_received, is_shutdown, is_export_completed, export_delay)),
+          sdk::trace::BatchSpanProcessorOptions()));
+  const int num_spans = 3;
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  // The exporter is slower than the timeout
+  EXPECT_FALSE(batch_processor->ForceFlush(std::chrono::milliseconds(50)));
+
+  // Without a timeout, ForceFlush waits for the export to complete
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_spans, spans_received->size());
+}
+
 TEST_F(BatchSpanProcessorTestPeer, TestManySpansLoss)
 {
   /* Test that when exporting more than max_queue_size spans, some are most likely lost*/
@@ -288,4 +459,851 @@ TEST_F(BatchSpanProcessorTestPeer, TestScheduleDelayMillis)
   }
 }
 
+TEST_F(BatchSpanProcessorTestPeer, TestShardedQueue)
+{
+  /* Test that no spans are lost when several threads end spans into a sharded queue */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const int num_threads      = 4;
+  const int spans_per_thread = 256;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.num_queue_shards = num_threads;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  std::vector<std::unique_ptr<std::vector<std::unique_ptr<sdk::trace::Recordable>>>> test_spans;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    test_spans.push_back(GetTestSpans(batch_processor, spans_per_thread));
+  }
+
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    auto thread_spans = test_spans[thread_index].get();
+    threads.emplace_back([batch_processor, thread_spans] {
+      for (auto &span : *thread_spans)
+      {
+        batch_processor->OnEnd(std::move(span));
+      }
+    });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  EXPECT_EQ(num_threads * spans_per_thread, spans_received->size());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestThreadLocalBuffers)
+{
+  /* Test that the spans left in the buffers of the threads are exported by ForceFlush, whether the
+     threads are still running or exited */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const int num_threads      = 4;
+  const int spans_per_thread = 100;
+  const int spans_at_exit    = 10;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.thread_local_buffer_size = 32;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  std::vector<std::unique_ptr<std::vector<std::unique_ptr<sdk::trace::Recordable>>>> test_spans;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    test_spans.push_back(GetTestSpans(batch_processor, spans_per_thread + spans_at_exit));
+  }
+
+  std::atomic<int> threads_waiting{0};
+  std::atomic<bool> flushed{false};
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < num_threads; ++thread_index)
+  {
+    auto thread_spans = test_spans[thread_index].get();
+    threads.emplace_back([&, batch_processor, thread_spans] {
+      for (int i = 0; i < spans_per_thread; ++i)
+      {
+        batch_processor->OnEnd(std::move(thread_spans->at(i)));
+      }
+      ++threads_waiting;
+      while (!flushed.load())
+      {
+        std::this_thread::yield();
+      }
+      for (int i = spans_per_thread; i < spans_per_thread + spans_at_exit; ++i)
+      {
+        batch_processor->OnEnd(std::move(thread_spans->at(i)));
+      }
+    });
+  }
+
+  while (threads_waiting.load() < num_threads)
+  {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_threads * spans_per_thread, spans_received->size());
+
+  flushed.store(true);
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_threads * (spans_per_thread + spans_at_exit), spans_received->size());
+  EXPECT_EQ(0, batch_processor->GetStats().dropped);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestPriorityQueue)
+{
+  /* Test that error spans are kept in their reserved partition while the queue overflows */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+
+  const size_t num_spans       = 16;
+  const size_t num_error_spans = 4;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size          = 4;
+  options.max_export_batch_size   = 1;
+  options.max_priority_queue_size = num_error_spans;
+
+  // The slow exporter keeps the worker busy with at most one span while the queue overflows.
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(
+              spans_received, is_shutdown, is_export_completed, std::chrono::milliseconds(100))),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans + num_error_spans);
+  for (size_t i = num_spans; i < num_spans + num_error_spans; ++i)
+  {
+    test_spans->at(i)->SetStatus(opentelemetry::trace::StatusCode::kError, "failed");
+  }
+  for (auto &span : *test_spans)
+  {
+    batch_processor->OnEnd(std::move(span));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  size_t error_spans_received = 0;
+  for (auto &span : *spans_received)
+  {
+    if (span->GetStatus() == opentelemetry::trace::StatusCode::kError)
+    {
+      ++error_spans_received;
+    }
+  }
+  EXPECT_EQ(num_error_spans, error_spans_received);
+  EXPECT_GT(batch_processor->GetStats().dropped, 0);
+  EXPECT_EQ(num_spans + num_error_spans,
+            spans_received->size() + batch_processor->GetStats().dropped);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestDeferredRecordables)
+{
+  /* Test that spans recorded into ArenaSpanData are replayed into the exporter's recordables */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const int num_spans = 10;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.deferred_recordables    = true;
+  options.max_priority_queue_size = 2;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (auto &span : *test_spans)
+  {
+    span->SetAttribute("key", "value");
+    batch_processor->OnEnd(std::move(span));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  ASSERT_EQ(num_spans, spans_received->size());
+  for (int i = 0; i < num_spans; ++i)
+  {
+    EXPECT_EQ("Span " + std::to_string(i), spans_received->at(i)->GetName());
+    EXPECT_EQ("value", opentelemetry::nostd::get<std::string>(
+                           spans_received->at(i)->GetAttributes().at("key")));
+  }
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestMaxExportBatchBytes)
+{
+  /* Test that batches are split by the estimated size of their spans, in order */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const int num_spans = 10;
+  const std::string value(1000, 'x');
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_export_batch_bytes = 2500;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (auto &span : *test_spans)
+  {
+    span->SetAttribute("key", value);
+    batch_processor->OnEnd(std::move(span));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  ASSERT_EQ(num_spans, spans_received->size());
+  for (int i = 0; i < num_spans; ++i)
+  {
+    EXPECT_EQ("Span " + std::to_string(i), spans_received->at(i)->GetName());
+  }
+  // At most two spans of about 1100 bytes fit in an export.
+  EXPECT_GE(batch_processor->GetStats().export_count, num_spans / 2);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestGroupByTrace)
+{
+  /* Test that the spans of a trace are contiguous in the exports, in the order they ended */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const int num_traces = 3;
+  const int num_spans  = 12;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.group_by_trace = true;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  // The traces are interleaved, and end in the reverse order of their ids.
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    uint8_t trace_id[opentelemetry::trace::TraceId::kSize] = {};
+    uint8_t span_id[opentelemetry::trace::SpanId::kSize]   = {};
+
+    trace_id[0] = static_cast<uint8_t>(num_traces - i % num_traces);
+    span_id[0]  = static_cast<uint8_t>(i + 1);
+    test_spans->at(i)->SetIdentity(
+        opentelemetry::trace::SpanContext(opentelemetry::trace::TraceId(trace_id),
+                                          opentelemetry::trace::SpanId(span_id),
+                                          opentelemetry::trace::TraceFlags(), false),
+        opentelemetry::trace::SpanId());
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  ASSERT_EQ(num_spans, spans_received->size());
+  for (int i = 0; i < num_spans; ++i)
+  {
+    int trace = i / (num_spans / num_traces);
+    int index = i % (num_spans / num_traces);
+    EXPECT_EQ(trace + 1, spans_received->at(i)->GetTraceId().Id()[0]);
+    EXPECT_EQ("Span " + std::to_string(num_traces - 1 - trace + index * num_traces),
+              spans_received->at(i)->GetName());
+  }
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestConcurrentAsyncExports)
+{
+  /* Test that batches are handed off while earlier exports are still in flight, without
+     exceeding max_concurrent_exports */
+
+  std::shared_ptr<std::atomic<size_t>> spans_received(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> max_in_flight(new std::atomic<size_t>(0));
+  const std::chrono::milliseconds export_delay(100);
+
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size         = 64;
+  options.max_export_batch_size  = 16;
+  options.schedule_delay_millis  = std::chrono::milliseconds(5);
+  options.max_concurrent_exports = 4;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockAsyncSpanExporter>(
+              new MockAsyncSpanExporter(spans_received, max_in_flight, export_delay)),
+          options));
+
+  const size_t num_spans = options.max_queue_size;
+  auto test_spans        = GetTestSpans(batch_processor, static_cast<int>(num_spans));
+  for (auto &span : *test_spans)
+  {
+    batch_processor->OnEnd(std::move(span));
+  }
+
+  // The worker hands off a batch every schedule_delay_millis, well before the first one completes
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_spans, spans_received->load());
+  EXPECT_GT(max_in_flight->load(), 1);
+  EXPECT_LE(max_in_flight->load(), options.max_concurrent_exports);
+
+  EXPECT_TRUE(batch_processor->Shutdown());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestInFlightExportBytes)
+{
+  /* Test that max_in_flight_export_bytes holds batches back while earlier ones are in flight */
+
+  std::shared_ptr<std::atomic<size_t>> spans_received(new std::atomic<size_t>(0));
+  std::shared_ptr<std::atomic<size_t>> max_in_flight(new std::atomic<size_t>(0));
+  const std::chrono::milliseconds export_delay(20);
+
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size         = 64;
+  options.max_export_batch_size  = 16;
+  options.schedule_delay_millis  = std::chrono::milliseconds(5);
+  options.max_concurrent_exports = 4;
+  // Less than any batch, which is then only handed off once none is in flight.
+  options.max_in_flight_export_bytes = 1;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockAsyncSpanExporter>(
+              new MockAsyncSpanExporter(spans_received, max_in_flight, export_delay)),
+          options));
+
+  const size_t num_spans = options.max_queue_size;
+  auto test_spans        = GetTestSpans(batch_processor, static_cast<int>(num_spans));
+  for (auto &span : *test_spans)
+  {
+    batch_processor->OnEnd(std::move(span));
+  }
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_spans, spans_received->load());
+  EXPECT_EQ(1, max_in_flight->load());
+
+  EXPECT_TRUE(batch_processor->Shutdown());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestStats)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(20);
+
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size        = 16;
+  options.max_export_batch_size = 8;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(
+              new MockSpanExporter(spans_received, is_shutdown, is_export_completed, export_delay)),
+          options));
+
+  auto stats = batch_processor->GetStats();
+  EXPECT_EQ(0, stats.enqueued);
+  EXPECT_EQ(0, stats.dropped);
+  EXPECT_EQ(16, stats.max_queue_size);
+
+  // The queue overflows well before the slow exporter drains it
+  const int num_spans = 64;
+  auto test_spans     = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  stats = batch_processor->GetStats();
+  EXPECT_GT(stats.dropped, 0);
+  EXPECT_EQ(num_spans, stats.enqueued + stats.dropped);
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  stats = batch_processor->GetStats();
+  EXPECT_EQ(stats.enqueued, stats.exported);
+  EXPECT_EQ(spans_received->size(), stats.exported);
+  EXPECT_EQ(0, stats.export_failed);
+  EXPECT_EQ(0, stats.queue_size);
+  EXPECT_GE(stats.export_count, 1);
+  EXPECT_LE(stats.max_batch_size, 16);
+  EXPECT_GE(stats.total_export_duration, export_delay * stats.export_count);
+
+  uint64_t bucketed_exports = 0;
+  for (auto count : stats.export_duration_counts)
+  {
+    bucketed_exports += count;
+  }
+  EXPECT_EQ(stats.export_count, bucketed_exports);
+  // 20ms exports never land in the [0ms, 1ms] bucket
+  EXPECT_EQ(0, stats.export_duration_counts[0]);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestMemoryBudget)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  const size_t limit = 100 * sdk::trace::BatchSpanProcessor::kSpanOverheadBytes;
+  auto budget        = std::make_shared<sdk::common::MemoryBudget>(limit);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.schedule_delay_millis = std::chrono::milliseconds(60000);
+  options.memory_budget         = budget;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  // Another component holds the whole budget: the spans are dropped.
+  budget->Charge(limit);
+  auto test_spans = GetTestSpans(batch_processor, 8);
+  for (int i = 0; i < 4; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+  EXPECT_EQ(4, batch_processor->GetStats().dropped);
+  EXPECT_EQ(limit, budget->GetUsage());
+
+  budget->Release(limit);
+  for (int i = 4; i < 8; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+  EXPECT_EQ(4, batch_processor->GetStats().enqueued);
+  EXPECT_GE(budget->GetUsage(), 4 * sdk::trace::BatchSpanProcessor::kSpanOverheadBytes);
+
+  // Pressure from elsewhere exports the queued spans early, releasing their charges.
+  const size_t external = limit - budget->GetUsage();
+  budget->Charge(external);
+  for (int i = 0; i < 500 && spans_received->size() < 4; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(4, spans_received->size());
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(external, budget->GetUsage());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestBackpressureSignal)
+{
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::atomic<bool>> is_export_completed(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  const std::chrono::milliseconds export_delay(500);
+
+  auto signal = std::make_shared<sdk::common::BackpressureSignal>();
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size        = 4;
+  options.max_export_batch_size = 4;
+  options.schedule_delay_millis = std::chrono::milliseconds(60000);
+  options.backpressure_signal   = signal;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(
+              new MockSpanExporter(spans_received, is_shutdown, is_export_completed, export_delay)),
+          options));
+  EXPECT_EQ(0.0, signal->GetLevel());
+
+  // The queue overflows while the first export is still running.
+  const int num_spans = 16;
+  auto test_spans     = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+  EXPECT_GT(batch_processor->GetStats().dropped, 0);
+  EXPECT_EQ(1.0, signal->GetLevel());
+
+  // Once drained, the queue is empty and the exports are short next to the schedule delay.
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(0.0, signal->GetQueueOccupancy());
+  EXPECT_LT(signal->GetLevel(), 0.5);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestAdaptiveBatching)
+{
+  /* Test that a burst larger than the queue's half is drained without waiting for the
+     maximum schedule delay */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.adaptive_batching         = true;
+  options.schedule_delay_millis     = std::chrono::milliseconds(5000);
+  options.min_schedule_delay_millis = std::chrono::milliseconds(10);
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  const int num_spans = 2048;
+  auto test_spans     = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  // The half-full wake up starts a cycle; the backlog is then exported batch after batch.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  auto stats = batch_processor->GetStats();
+  EXPECT_EQ(num_spans, stats.exported);
+  EXPECT_LE(stats.max_batch_size, options.max_export_batch_size);
+
+  EXPECT_TRUE(batch_processor->Shutdown());
+  EXPECT_EQ(num_spans, spans_received->size());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestRecycleRecordables)
+{
+  /* Test that the recordables of exported spans are reset and handed out again */
+
+  std::shared_ptr<std::vector<std::string>> names_received(new std::vector<std::string>);
+  std::shared_ptr<std::atomic<size_t>> recordables_made(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_recycled_recordables = 2;
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockReadOnlySpanExporter>(
+              new MockReadOnlySpanExporter(names_received, recordables_made)),
+          options));
+  const int num_spans = 3;
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(num_spans, names_received->size());
+  EXPECT_EQ(num_spans, recordables_made->load());
+
+  // Two recordables were kept, the third one is made by the exporter.
+  for (int i = 0; i < 2; ++i)
+  {
+    auto recordable = batch_processor->MakeRecordable();
+    EXPECT_EQ("", static_cast<sdk::trace::SpanData *>(recordable.get())->GetName());
+  }
+  EXPECT_EQ(num_spans, recordables_made->load());
+  batch_processor->MakeRecordable();
+  EXPECT_EQ(num_spans + 1, recordables_made->load());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestSharedExecutor)
+{
+  /* Test that processors sharing an executor of one thread export, flush and shut down */
+
+  std::shared_ptr<sdk::common::ExportExecutor> executor(new sdk::common::ExportExecutor(1));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.executor              = executor;
+  options.schedule_delay_millis = std::chrono::milliseconds(10);
+
+  const int num_processors = 3;
+  const int num_spans      = 5;
+  std::vector<std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>>> spans_received;
+  std::vector<std::shared_ptr<std::atomic<bool>>> is_shutdown;
+  std::vector<std::shared_ptr<sdk::trace::BatchSpanProcessor>> processors;
+  for (int i = 0; i < num_processors; ++i)
+  {
+    spans_received.emplace_back(new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+    is_shutdown.emplace_back(new std::atomic<bool>(false));
+    processors.emplace_back(new sdk::trace::BatchSpanProcessor(
+        std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received[i], is_shutdown[i])),
+        options));
+  }
+
+  for (auto &processor : processors)
+  {
+    auto test_spans = GetTestSpans(processor, num_spans);
+    for (int i = 0; i < num_spans; ++i)
+    {
+      processor->OnEnd(std::move(test_spans->at(i)));
+    }
+  }
+  EXPECT_TRUE(processors[0]->ForceFlush());
+  EXPECT_EQ(num_spans, spans_received[0]->size());
+
+  // The other processors export on their schedule.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (spans_received[1]->size() < num_spans && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(processors[1]->ForceFlush());
+  EXPECT_EQ(num_spans, spans_received[1]->size());
+
+  // A shutdown drains the queue.
+  auto last_spans = GetTestSpans(processors[2], 1);
+  processors[2]->OnEnd(std::move(last_spans->at(0)));
+  EXPECT_TRUE(processors[2]->Shutdown());
+  EXPECT_EQ(num_spans + 1, spans_received[2]->size());
+  EXPECT_TRUE(is_shutdown[2]->load());
+  EXPECT_FALSE(processors[2]->ForceFlush());
+
+  for (auto &processor : processors)
+  {
+    EXPECT_TRUE(processor->Shutdown());
+  }
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestThreadOptions)
+{
+  /* Test that the worker thread applies its options before exporting */
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  std::string started_name;
+  std::thread::id started_thread;
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.thread_options.on_start = [&](const std::string &name) {
+    started_name   = name;
+    started_thread = std::this_thread::get_id();
+  };
+  std::shared_ptr<sdk::trace::BatchSpanProcessor> batch_processor(
+      new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  auto test_spans = GetTestSpans(batch_processor, 1);
+  batch_processor->OnEnd(std::move(test_spans->at(0)));
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ(1, spans_received->size());
+  EXPECT_EQ("otel-bsp", started_name);
+  EXPECT_NE(std::this_thread::get_id(), started_thread);
+  EXPECT_TRUE(batch_processor->Shutdown());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestFairQueuing)
+{
+  /* Test that a noisy tenant only drops its own spans */
+
+  const size_t num_queues = 4;
+  // Two tenants hashed to different sub-queues.
+  std::string noisy = "tenant-0";
+  std::string quiet;
+  for (int i = 1; quiet.empty(); ++i)
+  {
+    std::string tenant = "tenant-" + std::to_string(i);
+    if (std::hash<std::string>()(tenant) % num_queues !=
+        std::hash<std::string>()(noisy) % num_queues)
+    {
+      quiet = tenant;
+    }
+  }
+
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.max_queue_size          = 40;
+  options.max_export_batch_size   = 40;
+  options.fair_queuing.key        = "tenant";
+  options.fair_queuing.num_queues = num_queues;
+  options.fair_queuing.quantum    = 2;
+  // The thread of the executor is kept busy until all the spans are queued, so that the worker
+  // does not export any of them before.
+  options.executor = std::make_shared<sdk::common::ExportExecutor>(1);
+  std::promise<void> blocking, released;
+  std::shared_future<void> released_future = released.get_future().share();
+  auto blocker = options.executor->AddTask(
+      [&blocking, released_future] {
+        blocking.set_value();
+        released_future.wait();
+        return std::chrono::microseconds::max();
+      },
+      std::chrono::microseconds(0));
+  blocking.get_future().wait();
+  std::shared_ptr<sdk::trace::BatchSpanProcessor> batch_processor(
+      new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  // The noisy tenant is named by a span attribute, the quiet one by the resource.
+  auto resource = sdk::resource::Resource::Create({{"tenant", quiet}});
+  for (int i = 0; i < 30; ++i)
+  {
+    auto span = batch_processor->MakeRecordable();
+    span->SetName(noisy);
+    span->SetAttribute("tenant", noisy);
+    batch_processor->OnEnd(std::move(span));
+  }
+  for (int i = 0; i < 5; ++i)
+  {
+    auto span = batch_processor->MakeRecordable();
+    span->SetName(quiet);
+    span->SetResource(resource);
+    batch_processor->OnEnd(std::move(span));
+  }
+  released.set_value();
+  EXPECT_TRUE(batch_processor->ForceFlush());
+
+  // Each sub-queue holds 10 spans, and the quiet tenant gets every other turn.
+  ASSERT_EQ(15, spans_received->size());
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    names.push_back(std::string(spans_received->at(i)->GetName()));
+  }
+  EXPECT_EQ(2, std::count(names.begin(), names.end(), quiet));
+  EXPECT_EQ(20, batch_processor->GetStats().dropped);
+  EXPECT_EQ((std::map<std::string, uint64_t>{{noisy, 20}}), batch_processor->GetTenantDrops());
+  EXPECT_TRUE(batch_processor->Shutdown());
+  options.executor->SuspendTask(blocker);
+}
+
+#ifdef __unix__
+TEST_F(BatchSpanProcessorTestPeer, TestJournal)
+{
+  /* Test that the queued spans are written to the journal, exported or not */
+
+  const std::string path = "batch_span_processor_journal.bin";
+  std::shared_ptr<std::atomic<bool>> is_shutdown(new std::atomic<bool>(false));
+  std::shared_ptr<std::vector<std::unique_ptr<sdk::trace::SpanData>>> spans_received(
+      new std::vector<std::unique_ptr<sdk::trace::SpanData>>);
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.journal = sdk::common::RecordJournal::Open(path, 4096);
+  ASSERT_NE(nullptr, options.journal);
+  std::shared_ptr<sdk::trace::BatchSpanProcessor> batch_processor(
+      new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockSpanExporter>(new MockSpanExporter(spans_received, is_shutdown)),
+          options));
+
+  const int num_spans = 3;
+  auto test_spans     = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+  EXPECT_TRUE(batch_processor->Shutdown());
+
+  std::vector<std::string> names;
+  EXPECT_TRUE(sdk::common::RecordJournal::Recover(
+      path, [&](sdk::common::JournalRecordType type, nostd::string_view data) {
+        EXPECT_EQ(sdk::common::JournalRecordType::kSpan, type);
+        sdk::trace::SpanData span;
+        sdk::common::BinaryDecoder decoder(data.data(), data.size());
+        EXPECT_TRUE(span.ReadBinary(decoder));
+        names.push_back(std::string(span.GetName()));
+      }));
+  EXPECT_EQ(std::vector<std::string>({"Span 0", "Span 1", "Span 2"}), names);
+  std::remove(path.c_str());
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestFork)
+{
+  /* Test that the worker thread runs on both sides of a fork, and that the child does not export
+   * the spans queued by the parent */
+
+  std::shared_ptr<std::vector<std::string>> names_received(new std::vector<std::string>);
+  std::shared_ptr<std::atomic<size_t>> recordables_made(new std::atomic<size_t>(0));
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockReadOnlySpanExporter>(
+              new MockReadOnlySpanExporter(names_received, recordables_made)),
+          sdk::trace::BatchSpanProcessorOptions()));
+  const int num_spans = 2;
+
+  auto test_spans = GetTestSpans(batch_processor, num_spans);
+  for (int i = 0; i < num_spans; ++i)
+  {
+    batch_processor->OnEnd(std::move(test_spans->at(i)));
+  }
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    auto child_span = batch_processor->MakeRecordable();
+    static_cast<sdk::trace::SpanData *>(child_span.get())->SetName("Child span");
+    batch_processor->OnEnd(std::move(child_span));
+    bool exported = batch_processor->ForceFlush() &&
+                    *names_received == std::vector<std::string>{"Child span"};
+    _exit(exported ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ASSERT_GT(pid, 0);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ((std::vector<std::string>{"Span 0", "Span 1"}), *names_received);
+}
+
+TEST_F(BatchSpanProcessorTestPeer, TestExecutorFork)
+{
+  /* Test that the task of the executor runs on both sides of a fork */
+
+  std::shared_ptr<std::vector<std::string>> names_received(new std::vector<std::string>);
+  std::shared_ptr<std::atomic<size_t>> recordables_made(new std::atomic<size_t>(0));
+  sdk::trace::BatchSpanProcessorOptions options{};
+  options.executor = std::make_shared<sdk::common::ExportExecutor>(2);
+
+  auto batch_processor =
+      std::shared_ptr<sdk::trace::BatchSpanProcessor>(new sdk::trace::BatchSpanProcessor(
+          std::unique_ptr<MockReadOnlySpanExporter>(
+              new MockReadOnlySpanExporter(names_received, recordables_made)),
+          options));
+
+  auto test_span = batch_processor->MakeRecordable();
+  static_cast<sdk::trace::SpanData *>(test_span.get())->SetName("Parent span");
+  batch_processor->OnEnd(std::move(test_span));
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    auto child_span = batch_processor->MakeRecordable();
+    static_cast<sdk::trace::SpanData *>(child_span.get())->SetName("Child span");
+    batch_processor->OnEnd(std::move(child_span));
+    bool exported = batch_processor->ForceFlush() &&
+                    *names_received == std::vector<std::string>{"Child span"};
+    _exit(exported ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ASSERT_GT(pid, 0);
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(EXIT_SUCCESS, WEXITSTATUS(status));
+
+  EXPECT_TRUE(batch_processor->ForceFlush());
+  EXPECT_EQ((std::vector<std::string>{"Parent span"}), *names_received);
+}
+#endif
+
 OPENTELEMETRY_END_NAMESPACE
@@ -0,0 +1,161 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/consistent_probability.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+#include "src/common/random.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+using opentelemetry::sdk::common::Random;
+using opentelemetry::sdk::trace::ConsistentProbabilityBasedSampler;
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::SamplingResult;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+
+namespace
+{
+using M = std::map<std::string, int>;
+using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+
+SamplingResult Sample(ConsistentProbabilityBasedSampler &sampler,
+                      const trace_api::SpanContext &parent_context,
+                      trace_api::TraceId trace_id)
+{
+  M m1;
+  L l1;
+  common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+  return sampler.ShouldSample(parent_context, trace_id, "", trace_api::SpanKind::kInternal, view,
+                              links);
+}
+
+trace_api::TraceId RandomTraceId()
+{
+  uint8_t buf[16] = {0};
+  Random::GenerateRandomBuffer(buf);
+  return trace_api::TraceId(buf);
+}
+
+std::string GetEntry(const SamplingResult &result)
+{
+  std::string entry;
+  result.trace_state->Get(ConsistentProbabilityBasedSampler::kTraceStateKey, entry);
+  return entry;
+}
+
+/*
+ * Returns the number of RECORD_AND_SAMPLE decisions taken by the sampler for
+ * the given number of random root trace ids.
+ */
+int RunShouldSampleCountDecision(ConsistentProbabilityBasedSampler &sampler, int iterations)
+{
+  int actual_count = 0;
+  for (int i = 0; i < iterations; ++i)
+  {
+    if (Sample(sampler, trace_api::SpanContext::GetInvalid(), RandomTraceId()).decision ==
+        Decision::RECORD_AND_SAMPLE)
+    {
+      ++actual_count;
+    }
+  }
+  return actual_count;
+}
+}  // namespace
+
+TEST(ConsistentProbabilityBasedSampler, GetRValue)
+{
+  uint8_t buf[16] = {0};
+  buf[8]          = 0x80;
+  EXPECT_EQ(0, ConsistentProbabilityBasedSampler::GetRValue(trace_api::TraceId(buf)));
+  buf[8] = 0x01;
+  EXPECT_EQ(7, ConsistentProbabilityBasedSampler::GetRValue(trace_api::TraceId(buf)));
+  buf[8]  = 0;
+  buf[10] = 0x20;
+  EXPECT_EQ(18, ConsistentProbabilityBasedSampler::GetRValue(trace_api::TraceId(buf)));
+  buf[10] = 0;
+  // The first 8 bytes are not used.
+  buf[0] = 0xff;
+  EXPECT_EQ(62, ConsistentProbabilityBasedSampler::GetRValue(trace_api::TraceId(buf)));
+}
+
+TEST(ConsistentProbabilityBasedSampler, ParseTraceStateValue)
+{
+  int p_value = 0;
+  int r_value = 0;
+  std::string other_fields;
+  ConsistentProbabilityBasedSampler::ParseTraceStateValue("p:3;r:10;x:y", p_value, r_value,
+                                                          other_fields);
+  EXPECT_EQ(3, p_value);
+  EXPECT_EQ(10, r_value);
+  EXPECT_EQ("x:y", other_fields);
+
+  ConsistentProbabilityBasedSampler::ParseTraceStateValue("a:b;r:63;p:64", p_value, r_value,
+                                                          other_fields);
+  EXPECT_EQ(-1, p_value);
+  EXPECT_EQ(-1, r_value);
+  EXPECT_EQ("a:b", other_fields);
+}
+
+TEST(ConsistentProbabilityBasedSampler, RecordsPValue)
+{
+  ConsistentProbabilityBasedSampler sampler(0.25);
+  uint8_t buf[16] = {0};
+  buf[8]          = 0x20;  // r = 2
+
+  auto result = Sample(sampler, trace_api::SpanContext::GetInvalid(), trace_api::TraceId(buf));
+  EXPECT_EQ(Decision::RECORD_AND_SAMPLE, result.decision);
+  EXPECT_EQ("p:2;r:2", GetEntry(result));
+
+  buf[8] = 0x40;  // r = 1
+  result = Sample(sampler, trace_api::SpanContext::GetInvalid(), trace_api::TraceId(buf));
+  EXPECT_EQ(Decision::DROP, result.decision);
+  EXPECT_EQ("r:1", GetEntry(result));
+}
+
+TEST(ConsistentProbabilityBasedSampler, UsesParentRValue)
+{
+  ConsistentProbabilityBasedSampler sampler(0.25);
+  uint8_t buf[16]     = {0};
+  buf[8]              = 0x80;  // r = 0 from the trace id
+  uint8_t span_buf[8] = {1};
+
+  auto parent_state = trace_api::TraceState::FromHeader("ot=p:1;r:5;x:y,other=1");
+  trace_api::SpanContext parent(trace_api::TraceId(buf), trace_api::SpanId(span_buf),
+                                trace_api::TraceFlags(trace_api::TraceFlags::kIsSampled), true,
+                                parent_state);
+  auto result = Sample(sampler, parent, trace_api::TraceId(buf));
+  EXPECT_EQ(Decision::RECORD_AND_SAMPLE, result.decision);
+  EXPECT_EQ("p:2;r:5;x:y", GetEntry(result));
+  std::string other;
+  EXPECT_TRUE(result.trace_state->Get("other", other));
+  EXPECT_EQ("1", other);
+}
+
+TEST(ConsistentProbabilityBasedSampler, Probabilities)
+{
+  int iterations = 100000;
+
+  ConsistentProbabilityBasedSampler always(1.0);
+  EXPECT_EQ(iterations, RunShouldSampleCountDecision(always, iterations));
+
+  ConsistentProbabilityBasedSampler never(0.0);
+  EXPECT_EQ(0, RunShouldSampleCountDecision(never, iterations));
+
+  ConsistentProbabilityBasedSampler quarter(0.25);
+  EXPECT_NEAR(iterations / 4, RunShouldSampleCountDecision(quarter, iterations), iterations / 50);
+
+  // Between two powers of two: sampled at p = 1 or p = 2.
+  ConsistentProbabilityBasedSampler sampler(0.3);
+  EXPECT_NEAR(iterations * 0.3, RunShouldSampleCountDecision(sampler, iterations),
+              iterations / 50);
+}
+
+TEST(ConsistentProbabilityBasedSampler, GetDescription)
+{
+  ConsistentProbabilityBasedSampler sampler(0.25);
+  ASSERT_EQ("ConsistentProbabilityBasedSampler{0.250000}", sampler.GetDescription());
+}
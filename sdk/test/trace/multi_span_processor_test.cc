@@ -0,0 +1,158 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/multi_span_processor.h"
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::exporter::memory::InMemorySpanData;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+using opentelemetry::trace::SpanContext;
+
+namespace
+{
+std::unique_ptr<SpanProcessor> MakeSimpleProcessor(std::shared_ptr<InMemorySpanData> &span_data)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  span_data = exporter->GetData();
+  return std::unique_ptr<SpanProcessor>(new SimpleSpanProcessor(std::move(exporter)));
+}
+
+std::unique_ptr<SpanProcessor> MakeBatchProcessor(std::shared_ptr<InMemorySpanData> &span_data)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  span_data = exporter->GetData();
+  return std::unique_ptr<SpanProcessor>(
+      new BatchSpanProcessor(std::move(exporter), BatchSpanProcessorOptions()));
+}
+
+// Takes `delay` to flush or shut down, then returns `result`.
+class SlowProcessor : public SpanProcessor
+{
+public:
+  SlowProcessor(std::chrono::milliseconds delay, bool result) : delay_(delay), result_(result) {}
+
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  void OnStart(Recordable &, const SpanContext &) noexcept override {}
+
+  void OnEnd(std::unique_ptr<Recordable> &&) noexcept override {}
+
+  bool ForceFlush(std::chrono::microseconds) noexcept override
+  {
+    std::this_thread::sleep_for(delay_);
+    return result_;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override
+  {
+    std::this_thread::sleep_for(delay_);
+    return result_;
+  }
+
+private:
+  std::chrono::milliseconds delay_;
+  bool result_;
+};
+
+void RecordSpan(SpanProcessor &processor, opentelemetry::nostd::string_view name)
+{
+  auto recordable = processor.MakeRecordable();
+  processor.OnStart(*recordable, SpanContext::GetInvalid());
+  recordable->SetName(name);
+  recordable->SetAttribute("key", "value");
+  processor.OnEnd(std::move(recordable));
+}
+}  // namespace
+
+TEST(MultiSpanProcessor, RecordsForEachProcessor)
+{
+  std::shared_ptr<InMemorySpanData> first, second;
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(MakeSimpleProcessor(first));
+  processors.push_back(MakeSimpleProcessor(second));
+  MultiSpanProcessor processor(std::move(processors));
+
+  RecordSpan(processor, "span");
+  auto first_spans  = first->GetSpans();
+  auto second_spans = second->GetSpans();
+  ASSERT_EQ(1, first_spans.size());
+  ASSERT_EQ(1, second_spans.size());
+  EXPECT_EQ("span", first_spans[0]->GetName());
+  EXPECT_EQ("span", second_spans[0]->GetName());
+}
+
+TEST(MultiSpanProcessor, FanOutRecordsOnce)
+{
+  std::shared_ptr<InMemorySpanData> simple, batch;
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(MakeSimpleProcessor(simple));
+  processors.push_back(MakeBatchProcessor(batch));
+  MultiSpanProcessorOptions options;
+  options.fan_out = true;
+  MultiSpanProcessor processor(std::move(processors), options);
+
+  auto recordable = processor.MakeRecordable();
+  // The span is recorded once, whatever the number of processors.
+  EXPECT_NE(nullptr, dynamic_cast<ArenaSpanData *>(recordable.get()));
+  recordable.reset();
+
+  RecordSpan(processor, "span1");
+  RecordSpan(processor, "span2");
+  EXPECT_TRUE(processor.ForceFlush());
+
+  // Each processor replays the shared span into a recordable of its exporter.
+  for (auto &span_data : {simple, batch})
+  {
+    auto spans = span_data->GetSpans();
+    ASSERT_EQ(2, spans.size());
+    EXPECT_EQ("span1", spans[0]->GetName());
+    EXPECT_EQ("span2", spans[1]->GetName());
+    EXPECT_EQ("value", opentelemetry::nostd::get<std::string>(spans[0]->GetAttributes().at("key")));
+  }
+}
+
+TEST(MultiSpanProcessor, FlushesConcurrently)
+{
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  for (int i = 0; i < 3; ++i)
+  {
+    processors.emplace_back(new SlowProcessor(std::chrono::milliseconds(200), true));
+  }
+  MultiSpanProcessor processor(std::move(processors));
+
+  // The processors share the timeout rather than taking it in turn.
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(processor.ForceFlush(std::chrono::seconds(10)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(processor.Shutdown(std::chrono::seconds(10)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST(MultiSpanProcessor, FlushFailsIfAnyProcessorFails)
+{
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.emplace_back(new SlowProcessor(std::chrono::milliseconds(0), true));
+  processors.emplace_back(new SlowProcessor(std::chrono::milliseconds(0), false));
+  MultiSpanProcessor failing(std::move(processors));
+  EXPECT_FALSE(failing.ForceFlush());
+
+  // A processor returning after the deadline missed it.
+  processors.clear();
+  processors.emplace_back(new SlowProcessor(std::chrono::milliseconds(0), true));
+  processors.emplace_back(new SlowProcessor(std::chrono::milliseconds(200), true));
+  MultiSpanProcessor slow(std::move(processors));
+  EXPECT_FALSE(slow.ForceFlush(std::chrono::milliseconds(50)));
+}
@@ -0,0 +1,74 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "test/trace/pipeline_benchmark.h"
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+namespace common = opentelemetry::sdk::common;
+namespace nostd  = opentelemetry::nostd;
+
+namespace
+{
+// Discards the spans, to measure the pipeline without the cost of exporting.
+class NullSpanExporter final : public SpanExporter
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  common::ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &) noexcept override
+  {
+    return common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+void BM_PipelineNullExporter(benchmark::State &state)
+{
+  pipeline_benchmark::RunPipeline(
+      state, [] { return std::unique_ptr<SpanExporter>(new NullSpanExporter); });
+}
+BENCHMARK(BM_PipelineNullExporter)->Apply(pipeline_benchmark::PipelineArguments);
+
+// Same as BM_PipelineNullExporter, with the spans buffered per thread before reaching the queue.
+void BM_PipelineThreadLocalBuffers(benchmark::State &state)
+{
+  BatchSpanProcessorOptions options;
+  options.thread_local_buffer_size = 32;
+  pipeline_benchmark::RunPipeline(
+      state, [] { return std::unique_ptr<SpanExporter>(new NullSpanExporter); }, options);
+}
+BENCHMARK(BM_PipelineThreadLocalBuffers)->Apply(pipeline_benchmark::PipelineArguments);
+
+void BM_PipelineInMemoryExporter(benchmark::State &state)
+{
+  // A ring keeps the memory used by the exporter bounded however long the benchmark runs.
+  pipeline_benchmark::RunPipeline(
+      state, [] { return std::unique_ptr<SpanExporter>(new InMemorySpanExporter(4096, true)); });
+}
+BENCHMARK(BM_PipelineInMemoryExporter)->Apply(pipeline_benchmark::PipelineArguments);
+
+// Same as BM_PipelineInMemoryExporter, with the exporter's recordables made on the worker thread.
+void BM_PipelineDeferredRecordables(benchmark::State &state)
+{
+  BatchSpanProcessorOptions options;
+  options.deferred_recordables = true;
+  pipeline_benchmark::RunPipeline(
+      state, [] { return std::unique_ptr<SpanExporter>(new InMemorySpanExporter(4096, true)); },
+      options);
+}
+BENCHMARK(BM_PipelineDeferredRecordables)->Apply(pipeline_benchmark::PipelineArguments);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/sdk/trace/tracer_provider.h"
+#include "opentelemetry/test_common/allocation_counter.h"
+#include "opentelemetry/trace/tracer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * A harness driving spans through the whole tracing pipeline: threads creating nested spans with
+ * attributes through the API, the SDK tracer, a BatchSpanProcessor and an exporter. The benchmarks
+ * built on it report, besides the time per iteration:
+ * - spans: the spans ended per second,
+ * - start_p50_ns, start_p99_ns, end_p50_ns, end_p99_ns: percentiles of the latency of StartSpan
+ *   and End, including the cost of reading the clock twice,
+ * - allocs_per_span: the heap allocations per span, in all threads,
+ * - drop_rate: the share of spans dropped by the processor because its queue was full.
+ */
+
+namespace pipeline_benchmark
+{
+namespace sdktrace = opentelemetry::sdk::trace;
+namespace trace    = opentelemetry::trace;
+
+/* The root spans each thread creates per iteration. */
+constexpr int kRootSpansPerThread = 100;
+
+/* The attributes set on each span. */
+constexpr int kAttributesPerSpan = 4;
+
+inline int64_t NanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              start)
+      .count();
+}
+
+inline double Percentile(std::vector<int64_t> &samples, double percentile)
+{
+  if (samples.empty())
+  {
+    return 0;
+  }
+  auto nth = samples.begin() + static_cast<std::ptrdiff_t>((samples.size() - 1) * percentile);
+  std::nth_element(samples.begin(), nth, samples.end());
+  return static_cast<double>(*nth);
+}
+
+/* The StartSpan and End latencies measured by a thread, in nanoseconds. */
+struct Latencies
+{
+  std::vector<int64_t> start;
+  std::vector<int64_t> end;
+};
+
+/* Creates kRootSpansPerThread chains of `depth` nested spans. */
+inline void CreateSpans(trace::Tracer &tracer, int depth, Latencies &latencies)
+{
+  std::vector<opentelemetry::nostd::shared_ptr<trace::Span>> chain(depth);
+  for (int root = 0; root < kRootSpansPerThread; ++root)
+  {
+    for (int level = 0; level < depth; ++level)
+    {
+      trace::StartSpanOptions options;
+      if (level > 0)
+      {
+        options.parent = chain[level - 1]->GetContext();
+      }
+      auto start = std::chrono::steady_clock::now();
+      chain[level] = tracer.StartSpan("pipeline", options);
+      latencies.start.push_back(NanosecondsSince(start));
+      for (int attribute = 0; attribute < kAttributesPerSpan; ++attribute)
+      {
+        chain[level]->SetAttribute("attribute", attribute);
+      }
+    }
+    for (int level = depth - 1; level >= 0; --level)
+    {
+      auto start = std::chrono::steady_clock::now();
+      chain[level]->End();
+      latencies.end.push_back(NanosecondsSince(start));
+      chain[level] = nullptr;
+    }
+  }
+}
+
+using ExporterFactory = std::function<std::unique_ptr<sdktrace::SpanExporter>()>;
+
+/**
+ * Runs the pipeline with state.range(0) threads, each creating chains of state.range(1) nested
+ * spans, into the exporter made by `make_exporter`, through a processor with the given options.
+ */
+inline void RunPipeline(benchmark::State &state,
+                        const ExporterFactory &make_exporter,
+                        const sdktrace::BatchSpanProcessorOptions &options = {})
+{
+  const int num_threads = static_cast<int>(state.range(0));
+  const int depth       = static_cast<int>(state.range(1));
+
+  auto processor = new sdktrace::BatchSpanProcessor(make_exporter(), options);
+  sdktrace::TracerProvider provider{std::unique_ptr<sdktrace::SpanProcessor>(processor)};
+  auto tracer = provider.GetTracer("pipeline_benchmark");
+
+  std::vector<Latencies> latencies(num_threads);
+  uint64_t spans       = 0;
+  uint64_t allocations = 0;
+  opentelemetry::test_common::ScopedAllocationCounter allocation_counter;
+  const size_t spans_per_thread = static_cast<size_t>(kRootSpansPerThread) * depth;
+  for (auto _ : state)
+  {
+    // Reserved ahead, so that recording the latencies allocates nothing while spans are counted.
+    for (auto &thread_latencies : latencies)
+    {
+      thread_latencies.start.reserve(thread_latencies.start.size() + spans_per_thread);
+      thread_latencies.end.reserve(thread_latencies.end.size() + spans_per_thread);
+    }
+    uint64_t allocations_before = allocation_counter.Get().count;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i)
+    {
+      threads.emplace_back([&tracer, depth, &latencies, i] {
+        CreateSpans(*tracer, depth, latencies[i]);
+      });
+    }
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+    provider.ForceFlush();
+    allocations += allocation_counter.Get().count - allocations_before;
+    spans += static_cast<uint64_t>(num_threads) * spans_per_thread;
+  }
+
+  Latencies merged;
+  for (auto &thread_latencies : latencies)
+  {
+    merged.start.insert(merged.start.end(), thread_latencies.start.begin(),
+                        thread_latencies.start.end());
+    merged.end.insert(merged.end.end(), thread_latencies.end.begin(), thread_latencies.end.end());
+  }
+  auto stats = processor->GetStats();
+
+  state.counters["spans"] =
+      benchmark::Counter(static_cast<double>(spans), benchmark::Counter::kIsRate);
+  state.counters["start_p50_ns"] = Percentile(merged.start, 0.5);
+  state.counters["start_p99_ns"] = Percentile(merged.start, 0.99);
+  state.counters["end_p50_ns"]   = Percentile(merged.end, 0.5);
+  state.counters["end_p99_ns"]   = Percentile(merged.end, 0.99);
+  state.counters["allocs_per_span"] =
+      spans == 0 ? 0 : static_cast<double>(allocations) / static_cast<double>(spans);
+  uint64_t offered = stats.enqueued + stats.dropped;
+  state.counters["drop_rate"] =
+      offered == 0 ? 0 : static_cast<double>(stats.dropped) / static_cast<double>(offered);
+}
+
+/* The thread counts and nesting depths the pipeline benchmarks run with. */
+inline void PipelineArguments(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->Args({1, 1})->Args({1, 4})->Args({4, 4})->Args({8, 4});
+  benchmark->ArgNames({"threads", "depth"})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+}  // namespace pipeline_benchmark
@@ -0,0 +1,82 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/rate_limiting.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::RateLimitingSampler;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+
+namespace
+{
+using M = std::map<std::string, int>;
+using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+
+opentelemetry::sdk::trace::SamplingResult ShouldSample(RateLimitingSampler &sampler,
+                                                       const trace_api::SpanContext &parent)
+{
+  M m1 = {{}};
+  L l1 = {{trace_api::SpanContext(false, false), {}}};
+  common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+  return sampler.ShouldSample(parent, trace_api::TraceId(), "", trace_api::SpanKind::kInternal,
+                              view, links);
+}
+}  // namespace
+
+TEST(RateLimitingSampler, ShouldSampleUpToRate)
+{
+  RateLimitingSampler sampler(5);
+
+  // The bucket starts with one second worth of spans.
+  int sampled = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    if (ShouldSample(sampler, trace_api::SpanContext::GetInvalid()).decision ==
+        Decision::RECORD_AND_SAMPLE)
+    {
+      ++sampled;
+    }
+  }
+  ASSERT_GE(sampled, 5);
+  ASSERT_LE(sampled, 6);
+}
+
+TEST(RateLimitingSampler, SetsTraceState)
+{
+  RateLimitingSampler sampler(2);
+
+  auto sampling_result = ShouldSample(sampler, trace_api::SpanContext::GetInvalid());
+  ASSERT_EQ(Decision::RECORD_AND_SAMPLE, sampling_result.decision);
+  ASSERT_EQ(nullptr, sampling_result.attributes);
+
+  std::string value;
+  ASSERT_TRUE(sampling_result.trace_state->Get(RateLimitingSampler::kTraceStateKey, value));
+  ASSERT_EQ("rate:2.000000", value);
+
+  // Entries of the parent are kept, the sampler entry is replaced.
+  uint8_t trace_id_buffer[trace_api::TraceId::kSize] = {1};
+  uint8_t span_id_buffer[trace_api::SpanId::kSize]   = {1};
+  trace_api::SpanContext parent(trace_api::TraceId{trace_id_buffer},
+                                trace_api::SpanId{span_id_buffer}, trace_api::TraceFlags{1}, true,
+                                trace_api::TraceState::FromHeader("otel-sampler=rate:1,k=v"));
+  sampling_result = ShouldSample(sampler, parent);
+  ASSERT_EQ(Decision::RECORD_AND_SAMPLE, sampling_result.decision);
+  ASSERT_EQ("otel-sampler=rate:2.000000,k=v", sampling_result.trace_state->ToHeader());
+}
+
+TEST(RateLimitingSampler, GetDescription)
+{
+  RateLimitingSampler sampler(100);
+  ASSERT_EQ("RateLimitingSampler{100.000000}", sampler.GetDescription());
+
+  ASSERT_THROW(RateLimitingSampler(0), std::invalid_argument);
+  ASSERT_THROW(RateLimitingSampler(-1), std::invalid_argument);
+}
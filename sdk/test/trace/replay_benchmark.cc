@@ -0,0 +1,107 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/exporters/memory/span_capture.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "test/trace/replay_benchmark.h"
+#include "test/trace/span_shapes.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+using opentelemetry::exporter::memory::SpanCapture;
+using opentelemetry::exporter::memory::SpanCaptureExporter;
+namespace common = opentelemetry::sdk::common;
+namespace nostd  = opentelemetry::nostd;
+
+namespace
+{
+// Discards the spans, to measure the pipeline without the cost of exporting.
+class NullSpanExporter final : public SpanExporter
+{
+public:
+  std::unique_ptr<Recordable> MakeRecordable() noexcept override
+  {
+    return std::unique_ptr<Recordable>(new SpanData);
+  }
+
+  common::ExportResult Export(const nostd::span<std::unique_ptr<Recordable>> &) noexcept override
+  {
+    return common::ExportResult::kSuccess;
+  }
+
+  bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+// Captures a batch of each span shape, for when no capture file is given.
+std::unique_ptr<SpanCapture> CaptureSyntheticSpans()
+{
+  const std::string path = "replay_benchmark_capture.bin";
+  {
+    SpanCaptureExporter exporter(path);
+    const span_shapes::SpanShape shapes[] = {span_shapes::SpanShape::kMinimal,
+                                             span_shapes::SpanShape::kTypical,
+                                             span_shapes::SpanShape::kLarge};
+    uint64_t index = 0;
+    for (auto shape : shapes)
+    {
+      std::vector<std::unique_ptr<Recordable>> batch;
+      for (int i = 0; i < span_shapes::kSpansPerBatch; ++i)
+      {
+        batch.push_back(exporter.MakeRecordable());
+        span_shapes::FillSpan(*batch.back(), shape, index++);
+      }
+      exporter.Export(nostd::span<std::unique_ptr<Recordable>>(batch.data(), batch.size()));
+    }
+    exporter.Shutdown();
+  }
+  auto capture = SpanCapture::Load(path);
+  std::remove(path.c_str());
+  return capture;
+}
+
+// The spans replayed: those of the capture file named by OTEL_SPAN_CAPTURE, or synthetic ones.
+const SpanCapture &GetCapture()
+{
+  static std::unique_ptr<SpanCapture> capture = [] {
+    const char *path = std::getenv("OTEL_SPAN_CAPTURE");
+    std::unique_ptr<SpanCapture> loaded =
+        path != nullptr ? SpanCapture::Load(path) : CaptureSyntheticSpans();
+    if (loaded == nullptr)
+    {
+      std::cerr << "Cannot load the span capture " << path << std::endl;
+      std::exit(1);
+    }
+    return loaded;
+  }();
+  return *capture;
+}
+
+void BM_ReplayNullExporter(benchmark::State &state)
+{
+  replay_benchmark::RunReplay(state, GetCapture(),
+                              [] { return std::unique_ptr<SpanExporter>(new NullSpanExporter); });
+}
+BENCHMARK(BM_ReplayNullExporter)->Apply(replay_benchmark::ReplayArguments);
+
+void BM_ReplayInMemoryExporter(benchmark::State &state)
+{
+  // A ring keeps the memory used by the exporter bounded however long the benchmark runs.
+  replay_benchmark::RunReplay(state, GetCapture(), [] {
+    return std::unique_ptr<SpanExporter>(new InMemorySpanExporter(4096, true));
+  });
+}
+BENCHMARK(BM_ReplayInMemoryExporter)->Apply(replay_benchmark::ReplayArguments);
+}  // namespace
+
+BENCHMARK_MAIN();
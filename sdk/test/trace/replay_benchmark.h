@@ -0,0 +1,95 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/exporters/memory/span_capture.h"
+#include "opentelemetry/sdk/trace/batch_span_processor.h"
+#include "opentelemetry/test_common/allocation_counter.h"
+#include "test/trace/pipeline_benchmark.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * A harness replaying the spans of a capture file, written by SpanCaptureExporter, into a
+ * BatchSpanProcessor and an exporter, so that a configuration is measured against the span stream
+ * of a real application rather than synthetic spans. Each iteration replays the whole capture from
+ * one thread, at state.range(0) spans per second, or as fast as possible for 0. The benchmarks
+ * built on it report, besides the time per iteration:
+ * - spans: the spans replayed per second,
+ * - end_p50_ns, end_p99_ns: percentiles of the latency of making, recording and ending a span,
+ * - allocs_per_span: the heap allocations per span, in all threads,
+ * - drop_rate: the share of spans dropped by the processor because its queue was full.
+ */
+
+namespace replay_benchmark
+{
+namespace sdktrace = opentelemetry::sdk::trace;
+
+using opentelemetry::exporter::memory::SpanCapture;
+
+/**
+ * Replays `capture` into the exporter made by `make_exporter`, through a processor with the given
+ * options.
+ */
+inline void RunReplay(benchmark::State &state,
+                      const SpanCapture &capture,
+                      const pipeline_benchmark::ExporterFactory &make_exporter,
+                      const sdktrace::BatchSpanProcessorOptions &options = {})
+{
+  const int64_t rate = state.range(0);
+  sdktrace::BatchSpanProcessor processor(make_exporter(), options);
+
+  std::vector<int64_t> latencies;
+  uint64_t spans       = 0;
+  uint64_t allocations = 0;
+  opentelemetry::test_common::ScopedAllocationCounter allocation_counter;
+  for (auto _ : state)
+  {
+    // Reserved ahead, so that recording the latencies allocates nothing while spans are counted.
+    latencies.reserve(latencies.size() + capture.size());
+    uint64_t allocations_before = allocation_counter.Get().count;
+    auto begin                  = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < capture.size(); ++i)
+    {
+      if (rate > 0)
+      {
+        std::this_thread::sleep_until(begin + std::chrono::nanoseconds(
+                                                  static_cast<int64_t>(i) * 1000000000 / rate));
+      }
+      auto start      = std::chrono::steady_clock::now();
+      auto recordable = processor.MakeRecordable();
+      capture.Replay(i, *recordable);
+      processor.OnEnd(std::move(recordable));
+      latencies.push_back(pipeline_benchmark::NanosecondsSince(start));
+    }
+    processor.ForceFlush();
+    allocations += allocation_counter.Get().count - allocations_before;
+    spans += capture.size();
+  }
+  auto stats = processor.GetStats();
+  processor.Shutdown();
+
+  state.counters["spans"] =
+      benchmark::Counter(static_cast<double>(spans), benchmark::Counter::kIsRate);
+  state.counters["end_p50_ns"] = pipeline_benchmark::Percentile(latencies, 0.5);
+  state.counters["end_p99_ns"] = pipeline_benchmark::Percentile(latencies, 0.99);
+  state.counters["allocs_per_span"] =
+      spans == 0 ? 0 : static_cast<double>(allocations) / static_cast<double>(spans);
+  uint64_t offered = stats.enqueued + stats.dropped;
+  state.counters["drop_rate"] =
+      offered == 0 ? 0 : static_cast<double>(stats.dropped) / static_cast<double>(offered);
+}
+
+/* The replay rates, in spans per second, the replay benchmarks run with. */
+inline void ReplayArguments(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->Arg(0)->Arg(100000)->Arg(1000000);
+  benchmark->ArgNames({"rate"})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+}  // namespace replay_benchmark
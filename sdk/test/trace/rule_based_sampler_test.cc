@@ -0,0 +1,148 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
+#include "opentelemetry/trace/span_context_kv_iterable_view.h"
+#include "src/common/random.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+using opentelemetry::sdk::common::Random;
+using opentelemetry::sdk::trace::Decision;
+using opentelemetry::sdk::trace::RuleBasedSampler;
+using opentelemetry::sdk::trace::SamplingRule;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+namespace nostd     = opentelemetry::nostd;
+
+namespace
+{
+using M = std::map<std::string, std::string>;
+using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+
+std::vector<SamplingRule> RouteRules()
+{
+  std::vector<SamplingRule> rules(3);
+  rules[0].attributes = {{"http.route", "/health"}};
+  rules[0].ratio      = 0.0;
+  rules[1].span_name  = "checkout";
+  rules[1].ratio      = 1.0;
+  rules[2].span_kinds = {trace_api::SpanKind::kServer};
+  rules[2].attributes = {{"http.route", "/cart"}, {"http.method", "POST"}};
+  rules[2].ratio      = 0.5;
+  return rules;
+}
+
+size_t FindRule(const RuleBasedSampler &sampler,
+                nostd::string_view name,
+                trace_api::SpanKind kind,
+                const M &attributes)
+{
+  return sampler.FindRule(name, kind, common::KeyValueIterableView<M>{attributes});
+}
+
+/*
+ * Returns the number of RECORD_AND_SAMPLE decisions taken by the sampler for
+ * the given number of random trace ids.
+ */
+int RunShouldSampleCountDecision(RuleBasedSampler &sampler,
+                                 nostd::string_view name,
+                                 trace_api::SpanKind kind,
+                                 const M &attributes,
+                                 int iterations)
+{
+  L l1;
+  common::KeyValueIterableView<M> view{attributes};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  int actual_count = 0;
+  for (int i = 0; i < iterations; ++i)
+  {
+    uint8_t buf[16] = {0};
+    Random::GenerateRandomBuffer(buf);
+
+    auto result = sampler.ShouldSample(trace_api::SpanContext::GetInvalid(),
+                                       trace_api::TraceId(buf), name, kind, view, links);
+    if (result.decision == Decision::RECORD_AND_SAMPLE)
+    {
+      ++actual_count;
+    }
+  }
+  return actual_count;
+}
+}  // namespace
+
+TEST(RuleBasedSampler, FindRule)
+{
+  RuleBasedSampler sampler(RouteRules(), 0.05);
+  const auto kServer   = trace_api::SpanKind::kServer;
+  const auto kInternal = trace_api::SpanKind::kInternal;
+
+  EXPECT_EQ(0, FindRule(sampler, "GET", kServer, {{"http.route", "/health"}}));
+  EXPECT_EQ(1, FindRule(sampler, "checkout", kInternal, {}));
+  // The first rule matched wins.
+  EXPECT_EQ(0, FindRule(sampler, "checkout", kInternal, {{"http.route", "/health"}}));
+
+  EXPECT_EQ(2, FindRule(sampler, "POST", kServer,
+                        {{"http.method", "POST"}, {"http.route", "/cart"}, {"other", "x"}}));
+  // Every predicate must be satisfied, and the kind must match.
+  EXPECT_EQ(3, FindRule(sampler, "POST", kServer, {{"http.route", "/cart"}}));
+  EXPECT_EQ(3,
+            FindRule(sampler, "GET", kServer, {{"http.method", "GET"}, {"http.route", "/cart"}}));
+  EXPECT_EQ(3, FindRule(sampler, "POST", kInternal,
+                        {{"http.method", "POST"}, {"http.route", "/cart"}}));
+  EXPECT_EQ(3, FindRule(sampler, "other", kServer, {}));
+}
+
+TEST(RuleBasedSampler, NonStringAttributes)
+{
+  std::vector<SamplingRule> rules(1);
+  rules[0].attributes = {{"key", "1"}};
+  RuleBasedSampler sampler(std::move(rules), 0.0);
+
+  std::map<std::string, int> int_attributes = {{"key", 1}};
+  EXPECT_EQ(1, sampler.FindRule("", trace_api::SpanKind::kInternal,
+                                common::KeyValueIterableView<std::map<std::string, int>>{
+                                    int_attributes}));
+
+  std::map<std::string, const char *> c_attributes = {{"key", "1"}};
+  EXPECT_EQ(0, sampler.FindRule("", trace_api::SpanKind::kInternal,
+                                common::KeyValueIterableView<std::map<std::string, const char *>>{
+                                    c_attributes}));
+}
+
+TEST(RuleBasedSampler, ShouldSample)
+{
+  RuleBasedSampler sampler(RouteRules(), 0.05);
+  const auto kServer = trace_api::SpanKind::kServer;
+  int iterations     = 100000;
+
+  EXPECT_EQ(0, RunShouldSampleCountDecision(sampler, "GET", kServer, {{"http.route", "/health"}},
+                                            iterations));
+  EXPECT_EQ(iterations, RunShouldSampleCountDecision(sampler, "checkout", kServer, {}, iterations));
+  EXPECT_NEAR(iterations / 2,
+              RunShouldSampleCountDecision(sampler, "POST", kServer,
+                                           {{"http.method", "POST"}, {"http.route", "/cart"}},
+                                           iterations),
+              iterations / 50);
+  EXPECT_NEAR(iterations / 20,
+              RunShouldSampleCountDecision(sampler, "other", kServer, {}, iterations),
+              iterations / 100);
+}
+
+TEST(RuleBasedSampler, GetDescription)
+{
+  RuleBasedSampler sampler(RouteRules(), 0.05);
+  ASSERT_EQ("RuleBasedSampler{3,0.050000}", sampler.GetDescription());
+
+  ASSERT_THROW(RuleBasedSampler(std::vector<SamplingRule>(65)), std::invalid_argument);
+  std::vector<SamplingRule> rules(1);
+  for (int i = 0; i < 65; ++i)
+  {
+    rules[0].attributes.emplace_back("key", std::to_string(i));
+  }
+  ASSERT_THROW(RuleBasedSampler(std::move(rules)), std::invalid_argument);
+}
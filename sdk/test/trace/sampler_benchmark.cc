@@ -7,12 +7,17 @@
 #include "opentelemetry/sdk/trace/samplers/always_off.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
 #include "opentelemetry/sdk/trace/samplers/parent.h"
+#include "opentelemetry/sdk/trace/samplers/rule_based.h"
 #include "opentelemetry/sdk/trace/samplers/trace_id_ratio.h"
 #include "opentelemetry/sdk/trace/simple_processor.h"
 #include "opentelemetry/sdk/trace/span_data.h"
 #include "opentelemetry/sdk/trace/tracer.h"
+#include "opentelemetry/test_common/allocation_counter.h"
 
 #include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -117,17 +122,51 @@ void BM_TraceIdRatioBasedSamplerShouldSample(benchmark::State &state)
 }
 BENCHMARK(BM_TraceIdRatioBasedSamplerShouldSample);
 
+// Per-route rates, matched on the start attributes of a server span.
+void BM_RuleBasedSamplerShouldSample(benchmark::State &state)
+{
+  std::vector<SamplingRule> rules(3);
+  rules[0].attributes = {{"http.route", "/health"}};
+  rules[0].ratio      = 0.0;
+  rules[1].attributes = {{"http.route", "/ready"}};
+  rules[1].ratio      = 0.0;
+  rules[2].span_kinds = {opentelemetry::trace::SpanKind::kServer};
+  rules[2].attributes = {{"http.route", "/checkout"}};
+  rules[2].ratio      = 1.0;
+  RuleBasedSampler sampler(std::move(rules), 0.05);
+
+  opentelemetry::trace::TraceId trace_id;
+  using M = std::map<std::string, std::string>;
+  M m1    = {{"http.method", "POST"}, {"http.route", "/checkout"}, {"http.scheme", "https"}};
+  using L = std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>>;
+  L l1;
+
+  opentelemetry::common::KeyValueIterableView<M> view{m1};
+  trace_api::SpanContextKeyValueIterableView<L> links{l1};
+
+  while (state.KeepRunning())
+  {
+    auto invalid_ctx = SpanContext::GetInvalid();
+    benchmark::DoNotOptimize(sampler.ShouldSample(
+        invalid_ctx, trace_id, "POST /checkout", opentelemetry::trace::SpanKind::kServer, view,
+        links));
+  }
+}
+BENCHMARK(BM_RuleBasedSamplerShouldSample);
+
 // Sampler Helper Function
-void BenchmarkSpanCreation(std::shared_ptr<Sampler> sampler, benchmark::State &state)
+void BenchmarkSpanCreation(std::unique_ptr<Sampler> sampler, benchmark::State &state)
 {
   std::unique_ptr<SpanExporter> exporter(new InMemorySpanExporter());
   std::unique_ptr<SpanProcessor> processor(new SimpleSpanProcessor(std::move(exporter)));
   std::vector<std::unique_ptr<SpanProcessor>> processors;
   processors.push_back(std::move(processor));
-  auto context  = std::make_shared<TracerContext>(std::move(processors));
   auto resource = opentelemetry::sdk::resource::Resource::Create({});
+  auto context  = std::make_shared<TracerContext>(std::move(processors), resource,
+                                                  std::move(sampler));
   auto tracer   = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
 
+  opentelemetry::test_common::ScopedAllocationCounter allocation_counter;
   while (state.KeepRunning())
   {
     auto span = tracer->StartSpan("span");
@@ -136,21 +175,100 @@ void BenchmarkSpanCreation(std::shared_ptr<Sampler> sampler, benchmark::State &s
 
     span->End();
   }
+  allocation_counter.Report(state);
 }
 
 // Test to measure performance for span creation
 void BM_SpanCreation(benchmark::State &state)
 {
-  BenchmarkSpanCreation(std::move(std::make_shared<AlwaysOnSampler>()), state);
+  BenchmarkSpanCreation(std::unique_ptr<Sampler>(new AlwaysOnSampler()), state);
 }
 BENCHMARK(BM_SpanCreation);
 
 // Test to measure performance overhead for no-op span creation
 void BM_NoopSpanCreation(benchmark::State &state)
 {
-  BenchmarkSpanCreation(std::move(std::make_shared<AlwaysOffSampler>()), state);
+  BenchmarkSpanCreation(std::unique_ptr<Sampler>(new AlwaysOffSampler()), state);
 }
 BENCHMARK(BM_NoopSpanCreation);
 
+// Sampler Helper Function
+void BenchmarkSpanCreationWithAttributesAndLinks(std::unique_ptr<Sampler> sampler,
+                                                 benchmark::State &state)
+{
+  std::unique_ptr<SpanExporter> exporter(new InMemorySpanExporter());
+  std::unique_ptr<SpanProcessor> processor(new SimpleSpanProcessor(std::move(exporter)));
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(std::move(processor));
+  auto resource = opentelemetry::sdk::resource::Resource::Create({});
+  auto context  = std::make_shared<TracerContext>(std::move(processors), resource,
+                                                  std::move(sampler));
+  auto tracer   = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  std::map<std::string, int> attributes = {
+      {"attr1", 1}, {"attr2", 2}, {"attr3", 3}, {"attr4", 4}, {"attr5", 5}};
+  std::vector<std::pair<trace_api::SpanContext, std::map<std::string, std::string>>> links = {
+      {trace_api::SpanContext(false, false), {{"link", "1"}}},
+      {trace_api::SpanContext(false, false), {{"link", "2"}}}};
+
+  opentelemetry::test_common::ScopedAllocationCounter allocation_counter;
+  while (state.KeepRunning())
+  {
+    auto span = tracer->StartSpan("span", attributes, links);
+    span->End();
+  }
+  allocation_counter.Report(state);
+}
+
+void BM_SpanCreationWithAttributesAndLinks(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributesAndLinks(std::unique_ptr<Sampler>(new AlwaysOnSampler()),
+                                              state);
+}
+BENCHMARK(BM_SpanCreationWithAttributesAndLinks);
+
+// Dropped spans neither copy the attributes nor the links.
+void BM_DroppedSpanCreationWithAttributesAndLinks(benchmark::State &state)
+{
+  BenchmarkSpanCreationWithAttributesAndLinks(std::unique_ptr<Sampler>(new AlwaysOffSampler()),
+                                              state);
+}
+BENCHMARK(BM_DroppedSpanCreationWithAttributesAndLinks);
+
+// Span Helper Function
+void BenchmarkSpanMutation(bool single_owner, benchmark::State &state)
+{
+  std::unique_ptr<SpanExporter> exporter(new InMemorySpanExporter());
+  std::unique_ptr<SpanProcessor> processor(new SimpleSpanProcessor(std::move(exporter)));
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(std::move(processor));
+  auto context = std::make_shared<TracerContext>(std::move(processors));
+  auto tracer  = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  trace_api::StartSpanOptions options;
+  options.single_owner = single_owner;
+  auto span            = tracer->StartSpan("span", options);
+
+  while (state.KeepRunning())
+  {
+    span->SetAttribute("attr1", 3.1);
+    span->SetStatus(trace_api::StatusCode::kOk, "");
+  }
+  span->End();
+}
+
+void BM_SpanMutation(benchmark::State &state)
+{
+  BenchmarkSpanMutation(false, state);
+}
+BENCHMARK(BM_SpanMutation);
+
+// Single-owner spans are mutated without locking.
+void BM_SingleOwnerSpanMutation(benchmark::State &state)
+{
+  BenchmarkSpanMutation(true, state);
+}
+BENCHMARK(BM_SingleOwnerSpanMutation);
+
 }  // namespace
 BENCHMARK_MAIN();
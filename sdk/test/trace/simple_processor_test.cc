@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 using namespace opentelemetry::sdk::trace;
 using namespace opentelemetry::sdk::common;
 using opentelemetry::exporter::memory::InMemorySpanData;
@@ -34,6 +36,55 @@ TEST(SimpleProcessor, ToInMemorySpanExporter)
   EXPECT_TRUE(processor.Shutdown());
 }
 
+TEST(SimpleProcessor, ExportBatches)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  SimpleSpanProcessorOptions options;
+  options.max_export_batch_size = 3;
+  SimpleSpanProcessor processor(std::move(exporter), options);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    processor.OnEnd(processor.MakeRecordable());
+  }
+  EXPECT_EQ(0, span_data->GetSpans().size());
+
+  // The third span completes the batch
+  processor.OnEnd(processor.MakeRecordable());
+  EXPECT_EQ(3, span_data->GetSpans().size());
+
+  processor.OnEnd(processor.MakeRecordable());
+  EXPECT_EQ(0, span_data->GetSpans().size());
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_EQ(1, span_data->GetSpans().size());
+  EXPECT_TRUE(processor.ForceFlush());
+  EXPECT_EQ(0, span_data->GetSpans().size());
+
+  // Shutdown exports the partial batch
+  processor.OnEnd(processor.MakeRecordable());
+  EXPECT_TRUE(processor.Shutdown());
+  EXPECT_EQ(1, span_data->GetSpans().size());
+}
+
+TEST(SimpleProcessor, ExportDelayedBatch)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  SimpleSpanProcessorOptions options;
+  options.max_export_batch_size = 100;
+  options.max_export_delay      = std::chrono::milliseconds(1);
+  SimpleSpanProcessor processor(std::move(exporter), options);
+
+  processor.OnEnd(processor.MakeRecordable());
+  EXPECT_EQ(0, span_data->GetSpans().size());
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  // The span ending after the delay exports the batch
+  processor.OnEnd(processor.MakeRecordable());
+  EXPECT_EQ(2, span_data->GetSpans().size());
+}
+
 // An exporter that does nothing but record (and give back ) the # of times Shutdown was called.
 class RecordShutdownExporter final : public SpanExporter
 {
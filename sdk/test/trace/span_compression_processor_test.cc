@@ -0,0 +1,106 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/span_compression_processor.h"
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/sdk/trace/tracer.h"
+
+#include <gtest/gtest.h>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::exporter::memory::InMemorySpanData;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+namespace nostd     = opentelemetry::nostd;
+namespace trace_api = opentelemetry::trace;
+
+class SpanCompressionProcessorTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+    span_data_ = exporter->GetData();
+    std::unique_ptr<SpanProcessor> simple_processor(new SimpleSpanProcessor(std::move(exporter)));
+    processor_ = new SpanCompressionProcessor(std::move(simple_processor),
+                                              SpanCompressionProcessorOptions());
+
+    std::vector<std::unique_ptr<SpanProcessor>> processors;
+    processors.push_back(std::unique_ptr<SpanProcessor>(processor_));
+    tracer_.reset(new Tracer(std::make_shared<TracerContext>(std::move(processors))));
+  }
+
+  // Starts and ends a child of the given span.
+  void AddChild(trace_api::Span &parent,
+                nostd::string_view name,
+                trace_api::SpanKind kind = trace_api::SpanKind::kClient)
+  {
+    trace_api::StartSpanOptions options;
+    options.parent = parent.GetContext();
+    options.kind   = kind;
+    auto child     = tracer_->StartSpan(name, {{"db.statement", "SELECT"}}, options);
+    child->End();
+  }
+
+  std::shared_ptr<InMemorySpanData> span_data_;
+  SpanCompressionProcessor *processor_ = nullptr;
+  std::shared_ptr<trace_api::Tracer> tracer_;
+};
+
+TEST_F(SpanCompressionProcessorTest, MergesIdenticalSiblings)
+{
+  auto root = tracer_->StartSpan("root");
+  for (int i = 0; i < 3; ++i)
+  {
+    AddChild(*root, "query");
+  }
+  EXPECT_EQ(0, span_data_->GetSpans().size());
+  EXPECT_EQ(1, processor_->GetStats().pending_runs);
+  root->End();
+
+  auto spans = span_data_->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("query", spans[0]->GetName());
+  EXPECT_EQ(3, nostd::get<int64_t>(spans[0]->GetAttributes().at("span.compression.count")));
+  EXPECT_LE(nostd::get<int64_t>(spans[0]->GetAttributes().at("span.compression.duration_sum")),
+            spans[0]->GetDuration().count());
+  EXPECT_EQ("root", spans[1]->GetName());
+
+  auto stats = processor_->GetStats();
+  EXPECT_EQ(0, stats.pending_runs);
+  EXPECT_EQ(1, stats.composite_spans);
+  EXPECT_EQ(2, stats.compressed_spans);
+}
+
+TEST_F(SpanCompressionProcessorTest, KeepsDifferentSiblings)
+{
+  auto root = tracer_->StartSpan("root");
+  AddChild(*root, "query");
+  AddChild(*root, "other query");
+  AddChild(*root, "query", trace_api::SpanKind::kInternal);
+  AddChild(*root, "query");
+  root->End();
+
+  auto spans = span_data_->GetSpans();
+  ASSERT_EQ(5, spans.size());
+  for (auto &span : spans)
+  {
+    EXPECT_EQ(0, span->GetAttributes().count("span.compression.count"));
+  }
+  EXPECT_EQ(0, processor_->GetStats().compressed_spans);
+}
+
+TEST_F(SpanCompressionProcessorTest, ForceFlushForwardsPendingRuns)
+{
+  auto root = tracer_->StartSpan("root");
+  AddChild(*root, "query");
+  AddChild(*root, "query");
+  EXPECT_TRUE(processor_->ForceFlush());
+
+  auto spans = span_data_->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ(2, nostd::get<int64_t>(spans[0]->GetAttributes().at("span.compression.count")));
+  EXPECT_EQ(0, processor_->GetStats().pending_runs);
+  root->End();
+}
@@ -0,0 +1,62 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/common/key_value_iterable_view.h"
+#include "opentelemetry/sdk/trace/arena_span_data.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace opentelemetry::sdk::trace;
+namespace trace_api = opentelemetry::trace;
+namespace common    = opentelemetry::common;
+
+namespace
+{
+// Records a typical span: a name, five attributes with string values, two events and a link.
+template <typename T>
+void BenchmarkRecordSpan(benchmark::State &state)
+{
+  std::map<std::string, std::string> attributes = {{"http.method", "GET"},
+                                                   {"http.url", "https://example.com/api/v1/users"},
+                                                   {"http.status_code", "200"},
+                                                   {"net.peer.name", "example.com"},
+                                                   {"component", "http"}};
+  std::map<std::string, int> event_attributes   = {{"bytes", 1024}};
+  common::KeyValueIterableView<std::map<std::string, int>> event_view{event_attributes};
+  common::SystemTimestamp now(std::chrono::system_clock::now());
+
+  while (state.KeepRunning())
+  {
+    std::unique_ptr<Recordable> recordable(new T());
+    recordable->SetName("GET /api/v1/users");
+    for (auto &attribute : attributes)
+    {
+      recordable->SetAttribute(attribute.first, attribute.second);
+    }
+    recordable->AddEvent("message sent", now, event_view);
+    recordable->AddEvent("message received", now, event_view);
+    recordable->AddLink(trace_api::SpanContext(false, false), event_view);
+    recordable->SetStatus(trace_api::StatusCode::kOk, "");
+    benchmark::DoNotOptimize(recordable.get());
+  }
+}
+
+void BM_SpanDataRecordSpan(benchmark::State &state)
+{
+  BenchmarkRecordSpan<SpanData>(state);
+}
+BENCHMARK(BM_SpanDataRecordSpan);
+
+void BM_ArenaSpanDataRecordSpan(benchmark::State &state)
+{
+  BenchmarkRecordSpan<ArenaSpanData>(state);
+}
+BENCHMARK(BM_ArenaSpanDataRecordSpan);
+
+}  // namespace
+BENCHMARK_MAIN();
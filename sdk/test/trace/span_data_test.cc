@@ -133,3 +133,51 @@ TEST(SpanData, Links)
     EXPECT_EQ(nostd::get<int64_t>(data.GetLinks().at(0).GetAttributes().at(keys[i])), values[i]);
   }
 }
+
+TEST(SpanData, Reset)
+{
+  uint8_t span_id_buf[trace_api::SpanId::kSize] = {
+      1,
+  };
+  uint8_t trace_id_buf[trace_api::TraceId::kSize] = {
+      2,
+  };
+  const auto span_context = trace_api::SpanContext(
+      trace_api::TraceId{trace_id_buf}, trace_api::SpanId{span_id_buf},
+      trace_api::TraceFlags{trace_api::TraceFlags::kIsSampled}, true);
+  common::SystemTimestamp now(std::chrono::system_clock::now());
+
+  SpanData data;
+  data.SetIdentity(span_context, trace_api::SpanId{span_id_buf});
+  data.SetName(std::string(64, 'x'));
+  data.SetSpanKind(trace_api::SpanKind::kServer);
+  data.SetStatus(trace_api::StatusCode::kError, "description");
+  data.SetStartTime(now);
+  data.SetDuration(std::chrono::nanoseconds(1000000));
+  data.SetAttribute("attr1", (int64_t)314159);
+  data.AddEvent("event1", now);
+  std::map<std::string, int64_t> link_attributes;
+  data.AddLink(span_context,
+               common::KeyValueIterableView<std::map<std::string, int64_t>>(link_attributes));
+  data.SetDroppedCounts(1, 2, 3);
+  const char *name = data.GetName().data();
+
+  EXPECT_TRUE(data.Reset());
+  trace_api::SpanContext empty_span_context{false, false};
+  EXPECT_EQ(data.GetSpanContext(), empty_span_context);
+  EXPECT_EQ(data.GetParentSpanId(), trace_api::SpanId());
+  EXPECT_EQ(data.GetName(), "");
+  EXPECT_EQ(data.GetSpanKind(), trace_api::SpanKind::kInternal);
+  EXPECT_EQ(data.GetStatus(), trace_api::StatusCode::kUnset);
+  EXPECT_EQ(data.GetDescription(), "");
+  EXPECT_EQ(data.GetStartTime().time_since_epoch(), std::chrono::nanoseconds(0));
+  EXPECT_EQ(data.GetDuration(), std::chrono::nanoseconds(0));
+  EXPECT_EQ(data.GetAttributes().size(), 0);
+  EXPECT_EQ(data.GetEvents().size(), 0);
+  EXPECT_EQ(data.GetLinks().size(), 0);
+  EXPECT_EQ(data.GetDroppedAttributesCount(), 0);
+
+  // The name keeps its memory.
+  data.SetName(std::string(64, 'y'));
+  EXPECT_EQ(data.GetName().data(), name);
+}
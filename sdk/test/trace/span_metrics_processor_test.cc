@@ -0,0 +1,171 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ENABLE_METRICS_PREVIEW
+#  include "opentelemetry/sdk/trace/span_metrics_processor.h"
+#  include "opentelemetry/sdk/metrics/meter_provider.h"
+#  include "opentelemetry/sdk/metrics/metric_reader.h"
+#  include "opentelemetry/sdk/metrics/view/instrument_selector.h"
+#  include "opentelemetry/sdk/metrics/view/meter_selector.h"
+#  include "opentelemetry/sdk/metrics/view/view.h"
+#  include "opentelemetry/sdk/trace/multi_span_processor.h"
+#  include "opentelemetry/sdk/trace/tracer.h"
+
+#  include <gtest/gtest.h>
+#  include <map>
+#  include <string>
+
+using namespace opentelemetry::sdk::trace;
+namespace metrics_sdk = opentelemetry::sdk::metrics;
+namespace nostd       = opentelemetry::nostd;
+namespace trace_api   = opentelemetry::trace;
+
+namespace
+{
+class MockMetricReader : public metrics_sdk::MetricReader
+{
+public:
+  bool OnForceFlush(std::chrono::microseconds) noexcept override { return true; }
+  bool OnShutDown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+/* The calls and the duration count of each series, keyed by "span.name/status.code[/route]". */
+struct Points
+{
+  std::map<std::string, long> calls;
+  std::map<std::string, uint64_t> durations;
+};
+
+std::string GetString(const metrics_sdk::PointDataAttributes &point, const std::string &key)
+{
+  auto it = point.attributes.find(key);
+  return it == point.attributes.end() ? "" : nostd::get<std::string>(it->second);
+}
+
+Points CollectPoints(metrics_sdk::MetricReader &reader)
+{
+  Points points;
+  reader.Collect([&](metrics_sdk::ResourceMetrics &metric_data) {
+    for (auto &instrumentation_info : metric_data.instrumentation_info_metric_data_)
+    {
+      for (auto &data : instrumentation_info.metric_data_)
+      {
+        for (auto &point : data.point_data_attr_)
+        {
+          std::string key = GetString(point, "span.name") + "/" + GetString(point, "status.code");
+          std::string route = GetString(point, "http.route");
+          if (!route.empty())
+          {
+            key += "/" + route;
+          }
+          if (data.instrument_descriptor.name_ == "traces.span.metrics.calls")
+          {
+            auto value = nostd::get<metrics_sdk::SumPointData>(point.point_data).value_;
+            points.calls[key] = nostd::get<long>(value);
+          }
+          else
+          {
+            points.durations[key] =
+                nostd::get<metrics_sdk::HistogramPointData>(point.point_data).count_;
+          }
+        }
+      }
+    }
+    return true;
+  });
+  return points;
+}
+}  // namespace
+
+class SpanMetricsProcessorTest : public testing::Test
+{
+protected:
+  void Init(const SpanMetricsProcessorOptions &options, bool fan_out = false)
+  {
+    reader_ = new MockMetricReader;
+    meter_provider_.AddMetricReader(std::unique_ptr<metrics_sdk::MetricReader>(reader_));
+    // Unnamed views, so that the instruments keep their names.
+    for (auto instrument_type :
+         {metrics_sdk::InstrumentType::kCounter, metrics_sdk::InstrumentType::kHistogram})
+    {
+      meter_provider_.AddView(
+          std::unique_ptr<metrics_sdk::InstrumentSelector>(
+              new metrics_sdk::InstrumentSelector(instrument_type, "*")),
+          std::unique_ptr<metrics_sdk::MeterSelector>(
+              new metrics_sdk::MeterSelector("span-metrics", "", "")),
+          std::unique_ptr<metrics_sdk::View>(new metrics_sdk::View("")));
+    }
+    processor_ = new SpanMetricsProcessor(meter_provider_.GetMeter("span-metrics"), options);
+
+    std::vector<std::unique_ptr<SpanProcessor>> processors;
+    processors.push_back(std::unique_ptr<SpanProcessor>(processor_));
+    MultiSpanProcessorOptions multi_options;
+    multi_options.fan_out = fan_out;
+    std::vector<std::unique_ptr<SpanProcessor>> multi_processor;
+    multi_processor.emplace_back(new MultiSpanProcessor(std::move(processors), multi_options));
+    tracer_.reset(new Tracer(std::make_shared<TracerContext>(std::move(multi_processor))));
+  }
+
+  void EndSpan(nostd::string_view name, nostd::string_view route, bool error = false)
+  {
+    auto span = tracer_->StartSpan(name, {{"http.route", route}, {"http.target", "/users/1"}});
+    if (error)
+    {
+      span->SetStatus(trace_api::StatusCode::kError, "failed");
+    }
+    span->End();
+  }
+
+  metrics_sdk::MeterProvider meter_provider_;
+  MockMetricReader *reader_        = nullptr;
+  SpanMetricsProcessor *processor_ = nullptr;
+  std::shared_ptr<trace_api::Tracer> tracer_;
+};
+
+TEST_F(SpanMetricsProcessorTest, RecordsCallsAndDurations)
+{
+  Init(SpanMetricsProcessorOptions());
+  EndSpan("GET", "/users");
+  EndSpan("GET", "/users");
+  EndSpan("GET", "/orders", true);
+
+  auto points = CollectPoints(*reader_);
+  EXPECT_EQ(2, points.calls["GET/STATUS_CODE_UNSET"]);
+  EXPECT_EQ(1, points.calls["GET/STATUS_CODE_ERROR"]);
+  EXPECT_EQ(2, points.durations["GET/STATUS_CODE_UNSET"]);
+  EXPECT_EQ(1, points.durations["GET/STATUS_CODE_ERROR"]);
+  EXPECT_EQ(2, processor_->GetStats().series);
+}
+
+TEST_F(SpanMetricsProcessorTest, AddsDimensions)
+{
+  SpanMetricsProcessorOptions options;
+  options.dimension_keys = {"http.route"};
+  Init(options, true);
+  EndSpan("GET", "/users");
+  EndSpan("GET", "/users");
+  EndSpan("GET", "/orders");
+
+  auto points = CollectPoints(*reader_);
+  EXPECT_EQ(2, points.calls["GET/STATUS_CODE_UNSET//users"]);
+  EXPECT_EQ(1, points.calls["GET/STATUS_CODE_UNSET//orders"]);
+  EXPECT_EQ(2, processor_->GetStats().series);
+}
+
+TEST_F(SpanMetricsProcessorTest, RecordsUnboundBeyondMaxSeries)
+{
+  SpanMetricsProcessorOptions options;
+  options.max_series = 1;
+  Init(options);
+  EndSpan("GET", "/users");
+  EndSpan("POST", "/users");
+  EndSpan("POST", "/users");
+
+  auto points = CollectPoints(*reader_);
+  EXPECT_EQ(1, points.calls["GET/STATUS_CODE_UNSET"]);
+  EXPECT_EQ(2, points.calls["POST/STATUS_CODE_UNSET"]);
+  auto stats = processor_->GetStats();
+  EXPECT_EQ(1, stats.series);
+  EXPECT_EQ(2, stats.unbound_spans);
+}
+#endif
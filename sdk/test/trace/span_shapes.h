@@ -0,0 +1,161 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "opentelemetry/common/attribute_value.h"
+#include "opentelemetry/common/key_value_iterable_view.h"
+#include "opentelemetry/sdk/instrumentationlibrary/instrumentation_library.h"
+#include "opentelemetry/sdk/resource/resource.h"
+#include "opentelemetry/sdk/trace/recordable.h"
+#include "opentelemetry/trace/span_context.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+/**
+ * The spans the exporter benchmarks serialize, so that their results compare across exporters:
+ * - kMinimal: a name, the identity, the kind and the timestamps of a span,
+ * - kTypical: a server span, with the 8 attributes and the status of an HTTP request,
+ * - kLarge: a span with 32 attributes, 8 events with 2 attributes each and 4 links.
+ * All have the same resource and instrumentation library.
+ */
+
+namespace span_shapes
+{
+namespace common   = opentelemetry::common;
+namespace sdktrace = opentelemetry::sdk::trace;
+namespace trace    = opentelemetry::trace;
+
+/* The spans per batch, the default max_export_batch_size of the BatchSpanProcessor. */
+constexpr int kSpansPerBatch = 512;
+
+enum class SpanShape
+{
+  kMinimal,
+  kTypical,
+  kLarge
+};
+
+inline trace::SpanContext MakeSpanContext(uint64_t index, uint8_t salt)
+{
+  uint8_t trace_id[trace::TraceId::kSize] = {1, 2, 3, 4, 5, 6, 7, 8};
+  uint8_t span_id[trace::SpanId::kSize]   = {salt};
+  std::memcpy(trace_id + 8, &index, sizeof(index));
+  std::memcpy(span_id + 1, &index, 7);
+  return trace::SpanContext(trace::TraceId(trace_id), trace::SpanId(span_id),
+                            trace::TraceFlags(trace::TraceFlags::kIsSampled), false);
+}
+
+inline const opentelemetry::sdk::resource::Resource &GetResource()
+{
+  static const auto resource = opentelemetry::sdk::resource::Resource::Create(
+      {{"service.name", "benchmark"}, {"service.version", "1.0.0"}, {"host.name", "localhost"}});
+  return resource;
+}
+
+inline const opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary &
+GetInstrumentationLibrary()
+{
+  static const auto library =
+      opentelemetry::sdk::instrumentationlibrary::InstrumentationLibrary::Create("benchmark",
+                                                                               "1.0.0");
+  return *library;
+}
+
+/* Records the span of the given shape into `recordable`, with ids derived from `index`. */
+inline void FillSpan(sdktrace::Recordable &recordable, SpanShape shape, uint64_t index)
+{
+  auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1600000000) +
+                                                     std::chrono::microseconds(index));
+  recordable.SetIdentity(MakeSpanContext(index, 1), MakeSpanContext(index, 2).span_id());
+  recordable.SetResource(GetResource());
+  recordable.SetInstrumentationLibrary(GetInstrumentationLibrary());
+  recordable.SetStartTime(common::SystemTimestamp(start));
+  recordable.SetDuration(std::chrono::microseconds(1500));
+  if (shape == SpanShape::kMinimal)
+  {
+    recordable.SetName("span");
+    recordable.SetSpanKind(trace::SpanKind::kInternal);
+    return;
+  }
+
+  recordable.SetName("GET /api/v1/users/{id}");
+  recordable.SetSpanKind(trace::SpanKind::kServer);
+  recordable.SetAttribute("http.method", "GET");
+  recordable.SetAttribute("http.scheme", "https");
+  recordable.SetAttribute("http.target", "/api/v1/users/12345?expand=groups");
+  recordable.SetAttribute("http.route", "/api/v1/users/{id}");
+  recordable.SetAttribute("http.status_code", 200);
+  recordable.SetAttribute("http.user_agent", "Mozilla/5.0 (X11; Linux x86_64) benchmark/1.0");
+  recordable.SetAttribute("net.peer.ip", "192.168.1.10");
+  recordable.SetAttribute("net.peer.port", 51234);
+  recordable.SetStatus(trace::StatusCode::kOk, "");
+  if (shape == SpanShape::kTypical)
+  {
+    return;
+  }
+
+  static const char *const kKeys[] = {
+      "attribute.0",  "attribute.1",  "attribute.2",  "attribute.3",  "attribute.4",
+      "attribute.5",  "attribute.6",  "attribute.7",  "attribute.8",  "attribute.9",
+      "attribute.10", "attribute.11", "attribute.12", "attribute.13", "attribute.14",
+      "attribute.15", "attribute.16", "attribute.17", "attribute.18", "attribute.19",
+      "attribute.20", "attribute.21", "attribute.22", "attribute.23"};
+  for (int i = 0; i < 24; ++i)
+  {
+    switch (i % 4)
+    {
+      case 0:
+        recordable.SetAttribute(kKeys[i], "a string value of moderate length");
+        break;
+      case 1:
+        recordable.SetAttribute(kKeys[i], static_cast<int64_t>(i) * 1000003);
+        break;
+      case 2:
+        recordable.SetAttribute(kKeys[i], i * 0.5);
+        break;
+      default:
+        recordable.SetAttribute(kKeys[i], i % 8 == 3);
+        break;
+    }
+  }
+  std::map<std::string, common::AttributeValue> event_attributes = {
+      {"exception.type", "std::runtime_error"}, {"retry.count", 2}};
+  for (int i = 0; i < 8; ++i)
+  {
+    auto timestamp = common::SystemTimestamp(start + std::chrono::microseconds(100 * i));
+    recordable.AddEvent("retry", timestamp,
+                        common::KeyValueIterableView<decltype(event_attributes)>(event_attributes));
+  }
+  std::map<std::string, common::AttributeValue> link_attributes = {{"link.kind", "follows"}};
+  for (uint8_t i = 0; i < 4; ++i)
+  {
+    recordable.AddLink(MakeSpanContext(index, 3 + i),
+                       common::KeyValueIterableView<decltype(link_attributes)>(link_attributes));
+  }
+}
+
+/* Reports the spans and the bytes they were serialized into as the throughput of `state`. */
+inline void ReportThroughput(benchmark::State &state, uint64_t bytes)
+{
+  state.SetItemsProcessed(state.iterations() * kSpansPerBatch);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  state.counters["bytes_per_span"] =
+      static_cast<double>(bytes) / static_cast<double>(state.iterations() * kSpansPerBatch);
+}
+
+/* Registers one benchmark argument per shape, named "shape". */
+inline void ApplyShapes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->ArgName("shape")
+      ->Arg(static_cast<int>(SpanShape::kMinimal))
+      ->Arg(static_cast<int>(SpanShape::kTypical))
+      ->Arg(static_cast<int>(SpanShape::kLarge));
+}
+}  // namespace span_shapes
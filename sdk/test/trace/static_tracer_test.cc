@@ -0,0 +1,96 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/static_tracer.h"
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+using namespace opentelemetry::sdk::trace;
+namespace nostd = opentelemetry::nostd;
+using opentelemetry::exporter::memory::InMemorySpanData;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+
+namespace
+{
+std::shared_ptr<Tracer> MakeTracer(std::shared_ptr<InMemorySpanData> &span_data)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  span_data = exporter->GetData();
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.emplace_back(new SimpleSpanProcessor(std::move(exporter)));
+  return std::make_shared<Tracer>(std::make_shared<TracerContext>(std::move(processors)));
+}
+
+// Instrumented library code, specialized at compile time by the policy.
+template <class Policy>
+void HandleRequest(StaticTracer<Policy> &tracer)
+{
+  auto span = tracer.StartSpan("handle", {{"route", "/users"}});
+  span.SetAttribute("status", 200);
+  auto scope = span.Activate();
+  auto child = tracer.StartSpan("query");
+  child.AddEvent("rows", {{"count", 3}});
+}
+}  // namespace
+
+TEST(StaticTracer, Disabled)
+{
+  static_assert(std::is_empty<StaticSpan<StaticTracingDisabled>>::value,
+                "a disabled span holds nothing");
+  static_assert(std::is_empty<StaticTracer<StaticTracingDisabled>>::value,
+                "a disabled tracer holds nothing");
+
+  std::shared_ptr<InMemorySpanData> span_data;
+  auto tracer = MakeTracer(span_data);
+  StaticTracer<StaticTracingDisabled> static_tracer(*tracer);
+  HandleRequest(static_tracer);
+  EXPECT_TRUE(span_data->GetSpans().empty());
+}
+
+TEST(StaticTracer, Full)
+{
+  std::shared_ptr<InMemorySpanData> span_data;
+  auto tracer = MakeTracer(span_data);
+  StaticTracer<StaticTracingFull> static_tracer(*tracer);
+  HandleRequest(static_tracer);
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  // The child ended first, in the scope of its parent.
+  EXPECT_EQ("query", spans.at(0)->GetName());
+  EXPECT_EQ(1, spans.at(0)->GetEvents().size());
+  EXPECT_EQ("handle", spans.at(1)->GetName());
+  EXPECT_EQ(spans.at(1)->GetSpanId(), spans.at(0)->GetParentSpanId());
+  EXPECT_EQ("/users", nostd::get<std::string>(spans.at(1)->GetAttributes().at("route")));
+  EXPECT_EQ(200, nostd::get<int32_t>(spans.at(1)->GetAttributes().at("status")));
+}
+
+TEST(StaticTracer, SampledOnly)
+{
+  std::shared_ptr<InMemorySpanData> span_data;
+  auto tracer = MakeTracer(span_data);
+  StaticTracer<StaticTracingSampledOnly> static_tracer(*tracer);
+
+  // Outside of a sampled trace, nothing is started.
+  HandleRequest(static_tracer);
+  EXPECT_TRUE(span_data->GetSpans().empty());
+
+  // Within one, the spans are children of the active span.
+  opentelemetry::trace::Tracer &api_tracer = *tracer;
+  auto root                                = api_tracer.StartSpan("root");
+  {
+    opentelemetry::trace::Scope scope(root);
+    HandleRequest(static_tracer);
+  }
+  root->End();
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(3, spans.size());
+  EXPECT_EQ("query", spans.at(0)->GetName());
+  EXPECT_EQ("handle", spans.at(1)->GetName());
+  EXPECT_EQ(spans.at(2)->GetSpanId(), spans.at(1)->GetParentSpanId());
+}
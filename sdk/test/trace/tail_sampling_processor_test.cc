@@ -0,0 +1,161 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/sdk/trace/tail_sampling_processor.h"
+#include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/trace/simple_processor.h"
+#include "opentelemetry/sdk/trace/span_data.h"
+#include "opentelemetry/sdk/trace/tracer.h"
+
+#include <gtest/gtest.h>
+#include <functional>
+
+using namespace opentelemetry::sdk::trace;
+using opentelemetry::exporter::memory::InMemorySpanData;
+using opentelemetry::exporter::memory::InMemorySpanExporter;
+namespace trace_api = opentelemetry::trace;
+
+class TailSamplingProcessorTest : public testing::Test
+{
+protected:
+  void Init(const TailSamplingProcessorOptions &options)
+  {
+    std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+    span_data_ = exporter->GetData();
+    std::unique_ptr<SpanProcessor> simple_processor(new SimpleSpanProcessor(std::move(exporter)));
+    processor_ = new TailSamplingProcessor(std::move(simple_processor), options);
+
+    std::vector<std::unique_ptr<SpanProcessor>> processors;
+    processors.push_back(std::unique_ptr<SpanProcessor>(processor_));
+    tracer_.reset(new Tracer(std::make_shared<TracerContext>(std::move(processors))));
+  }
+
+  // Starts a root span and one child, and ends the child.
+  opentelemetry::nostd::shared_ptr<trace_api::Span> StartTrace(
+      const std::function<void(trace_api::Span &)> &decorate_child = [](trace_api::Span &) {})
+  {
+    auto root = tracer_->StartSpan("root");
+    trace_api::StartSpanOptions options;
+    options.parent = root->GetContext();
+    auto child     = tracer_->StartSpan("child", options);
+    decorate_child(*child);
+    child->End();
+    return root;
+  }
+
+  std::shared_ptr<InMemorySpanData> span_data_;
+  TailSamplingProcessor *processor_ = nullptr;
+  std::shared_ptr<trace_api::Tracer> tracer_;
+};
+
+TEST_F(TailSamplingProcessorTest, DropsOrdinaryTraces)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio = 0;
+  Init(options);
+
+  auto root = StartTrace();
+  EXPECT_EQ(1, processor_->GetStats().buffered_spans);
+  root->End();
+
+  EXPECT_EQ(0, span_data_->GetSpans().size());
+  auto stats = processor_->GetStats();
+  EXPECT_EQ(0, stats.buffered_spans);
+  EXPECT_EQ(0, stats.kept_traces);
+  EXPECT_EQ(1, stats.dropped_traces);
+}
+
+TEST_F(TailSamplingProcessorTest, KeepsErrorTraces)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio = 0;
+  Init(options);
+
+  auto root = StartTrace(
+      [](trace_api::Span &child) { child.SetStatus(trace_api::StatusCode::kError, "failed"); });
+  EXPECT_EQ(0, span_data_->GetSpans().size());
+  root->End();
+
+  auto spans = span_data_->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("child", spans[0]->GetName());
+  EXPECT_EQ("root", spans[1]->GetName());
+  EXPECT_EQ(1, processor_->GetStats().kept_traces);
+}
+
+TEST_F(TailSamplingProcessorTest, KeepsSlowTraces)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio    = 0;
+  options.latency_threshold = std::chrono::nanoseconds(0);
+  Init(options);
+
+  StartTrace()->End();
+  EXPECT_EQ(2, span_data_->GetSpans().size());
+}
+
+TEST_F(TailSamplingProcessorTest, KeepsTracesWithAttributes)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio      = 0;
+  options.keep_attribute_keys = {"debug"};
+  Init(options);
+
+  StartTrace([](trace_api::Span &child) { child.SetAttribute("other", true); })->End();
+  EXPECT_EQ(0, span_data_->GetSpans().size());
+
+  StartTrace([](trace_api::Span &child) { child.SetAttribute("debug", true); })->End();
+  EXPECT_EQ(2, span_data_->GetSpans().size());
+}
+
+TEST_F(TailSamplingProcessorTest, KeepsSampledTraces)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio = 1.0;
+  Init(options);
+
+  StartTrace()->End();
+  EXPECT_EQ(2, span_data_->GetSpans().size());
+}
+
+TEST_F(TailSamplingProcessorTest, EvictsOldestTrace)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio     = 0;
+  options.max_buffered_spans = 2;
+  options.num_buckets        = 1;
+  Init(options);
+
+  auto first = StartTrace(
+      [](trace_api::Span &child) { child.SetStatus(trace_api::StatusCode::kError, "failed"); });
+  auto second = StartTrace();
+  EXPECT_EQ(2, processor_->GetStats().buffered_spans);
+
+  // The first trace is decided early to make room for the third, its error is kept.
+  auto third = StartTrace();
+  auto stats = processor_->GetStats();
+  EXPECT_EQ(2, stats.buffered_spans);
+  EXPECT_EQ(1, stats.evicted_traces);
+  EXPECT_EQ(1, stats.kept_traces);
+  EXPECT_EQ(1, span_data_->GetSpans().size());
+
+  second->End();
+  third->End();
+  EXPECT_EQ(0, processor_->GetStats().buffered_spans);
+  EXPECT_EQ(2, processor_->GetStats().dropped_traces);
+  first->End();
+}
+
+TEST_F(TailSamplingProcessorTest, ShutdownDecidesBufferedTraces)
+{
+  TailSamplingProcessorOptions options;
+  options.sampling_ratio = 0;
+  Init(options);
+
+  auto root = StartTrace(
+      [](trace_api::Span &child) { child.SetStatus(trace_api::StatusCode::kError, "failed"); });
+  EXPECT_TRUE(processor_->Shutdown());
+  EXPECT_EQ(1, span_data_->GetSpans().size());
+  EXPECT_EQ(0, processor_->GetStats().buffered_spans);
+  root->End();
+}
@@ -3,6 +3,7 @@
 
 #include "opentelemetry/sdk/trace/tracer.h"
 #include "opentelemetry/exporters/memory/in_memory_span_exporter.h"
+#include "opentelemetry/sdk/common/telemetry_switch.h"
 #include "opentelemetry/sdk/resource/resource.h"
 #include "opentelemetry/sdk/trace/samplers/always_off.h"
 #include "opentelemetry/sdk/trace/samplers/always_on.h"
@@ -13,6 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace opentelemetry::sdk::trace;
 using namespace opentelemetry::sdk::resource;
 using opentelemetry::common::SteadyTimestamp;
@@ -79,6 +84,57 @@ class MockIdGenerator : public IdGenerator
   uint8_t buf_trace[16] = {1, 2, 3, 4, 5, 6, 7, 8, 8, 7, 6, 5, 4, 3, 2, 1};
 };
 
+/**
+ * A Mock Clock advancing by 10ns on every read
+ */
+class MockClock : public opentelemetry::sdk::common::Clock
+{
+  SystemTimestamp SystemNow() noexcept override
+  {
+    return SystemTimestamp(std::chrono::nanoseconds(system_ += 10));
+  }
+
+  SteadyTimestamp SteadyNow() noexcept override
+  {
+    return SteadyTimestamp(std::chrono::nanoseconds(steady_ += 10));
+  }
+  int64_t system_ = 1000;
+  int64_t steady_ = 0;
+};
+
+/**
+ * A simple span processor recording its destruction
+ */
+class DestroyedSpanProcessor final : public SimpleSpanProcessor
+{
+public:
+  DestroyedSpanProcessor(std::unique_ptr<SpanExporter> &&exporter,
+                         std::shared_ptr<std::atomic<bool>> destroyed)
+      : SimpleSpanProcessor(std::move(exporter)), destroyed_(std::move(destroyed))
+  {}
+
+  ~DestroyedSpanProcessor() override { *destroyed_ = true; }
+
+private:
+  std::shared_ptr<std::atomic<bool>> destroyed_;
+};
+
+/**
+ * An always-on sampler recording its destruction
+ */
+class DestroyedSampler final : public AlwaysOnSampler
+{
+public:
+  explicit DestroyedSampler(std::shared_ptr<std::atomic<bool>> destroyed)
+      : destroyed_(std::move(destroyed))
+  {}
+
+  ~DestroyedSampler() override { *destroyed_ = true; }
+
+private:
+  std::shared_ptr<std::atomic<bool>> destroyed_;
+};
+
 namespace
 {
 std::shared_ptr<opentelemetry::trace::Tracer> initTracer(std::unique_ptr<SpanExporter> &&exporter)
@@ -106,6 +162,19 @@ std::shared_ptr<opentelemetry::trace::Tracer> initTracer(
   return std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
 }
 
+std::shared_ptr<opentelemetry::trace::Tracer> initTracer(std::unique_ptr<SpanExporter> &&exporter,
+                                                         const SpanLimits &span_limits)
+{
+  auto processor = std::unique_ptr<SpanProcessor>(new SimpleSpanProcessor(std::move(exporter)));
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(std::move(processor));
+  auto context = std::make_shared<TracerContext>(
+      std::move(processors), Resource::Create({}),
+      std::unique_ptr<Sampler>(new AlwaysOnSampler()),
+      std::unique_ptr<IdGenerator>(new RandomIdGenerator()), span_limits);
+  return std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+}
+
 }  // namespace
 
 TEST(Tracer, ToInMemorySpanExporter)
@@ -159,6 +228,102 @@ TEST(Tracer, StartSpanSampleOn)
   ASSERT_LT(std::chrono::nanoseconds(0), cur_span_data->GetDuration());
 }
 
+TEST(Tracer, StartSingleOwnerSpan)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto tracer                                 = initTracer(std::move(exporter));
+
+  opentelemetry::trace::StartSpanOptions options;
+  options.single_owner = true;
+  auto span            = tracer->StartSpan("span 1", options);
+  span->SetAttribute("attr1", 314159);
+  span->AddEvent("event 1");
+  span->SetStatus(opentelemetry::trace::StatusCode::kError, "error");
+  span->UpdateName("span 2");
+  EXPECT_TRUE(span->IsRecording());
+  span->End();
+  EXPECT_FALSE(span->IsRecording());
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  auto &cur_span_data = spans.at(0);
+  EXPECT_EQ("span 2", cur_span_data->GetName());
+  EXPECT_EQ(314159, nostd::get<int32_t>(cur_span_data->GetAttributes().at("attr1")));
+  EXPECT_EQ(1, cur_span_data->GetEvents().size());
+  EXPECT_EQ(opentelemetry::trace::StatusCode::kError, cur_span_data->GetStatus());
+}
+
+TEST(Tracer, StartSpanWithExpectedSizes)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  SpanLimits limits;
+  limits.max_events = 6;
+  auto tracer       = initTracer(std::move(exporter), limits);
+
+  opentelemetry::trace::StartSpanOptions options;
+  options.expected_attributes = 12;
+  options.expected_events     = 8;
+  auto span                   = tracer->StartSpan("span", {{"attr1", 1}}, options);
+  span->AddEvent("event1");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ(1, spans.at(0)->GetAttributes().size());
+  // Room was reserved for the expected events, within the span limits.
+  EXPECT_EQ(1, spans.at(0)->GetEvents().size());
+  EXPECT_GE(spans.at(0)->GetEvents().capacity(), 6u);
+}
+
+namespace
+{
+uint64_t test_allocations = 0;
+
+uint64_t CountTestAllocations()
+{
+  return test_allocations;
+}
+}  // namespace
+
+TEST(Tracer, SpanProfiling)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.emplace_back(new SimpleSpanProcessor(std::move(exporter)));
+  auto context = std::make_shared<TracerContext>(std::move(processors));
+  auto tracer  = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  // Disabled by default.
+  tracer->StartSpan("span 1")->End();
+
+  SpanProfilingOptions profiling;
+  profiling.record_cpu_time    = true;
+  profiling.allocation_counter = &CountTestAllocations;
+  context->SetSpanProfiling(profiling);
+  auto span = tracer->StartSpan("span 2");
+  test_allocations += 3;
+  volatile uint64_t sum = 0;
+  for (int i = 0; i < 100000; ++i)
+  {
+    sum = sum + i;
+  }
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ(0, spans.at(0)->GetAttributes().count(kSpanThreadCpuTimeKey));
+  EXPECT_EQ(0, spans.at(0)->GetAttributes().count(kSpanThreadAllocationsKey));
+  auto &attributes = spans.at(1)->GetAttributes();
+  EXPECT_EQ(3u, nostd::get<uint64_t>(attributes.at(kSpanThreadAllocationsKey)));
+  if (GetThreadCpuTimeNanos() >= 0)
+  {
+    EXPECT_GE(nostd::get<int64_t>(attributes.at(kSpanThreadCpuTimeKey)), 0);
+  }
+}
+
 TEST(Tracer, StartSpanSampleOff)
 {
   std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
@@ -172,6 +337,7 @@ TEST(Tracer, StartSpanSampleOff)
   auto context = span->GetContext();
   EXPECT_TRUE(context.IsValid());
   EXPECT_FALSE(context.IsSampled());
+  EXPECT_FALSE(span->IsRecording());
 
   span->End();
   // The span doesn't write any span data because the sampling decision is alway
@@ -179,6 +345,117 @@ TEST(Tracer, StartSpanSampleOff)
   ASSERT_EQ(0, span_data->GetSpans().size());
 }
 
+TEST(Tracer, StartSpanWhileTelemetryDisabled)
+{
+  using opentelemetry::sdk::common::TelemetrySwitch;
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto tracer                                 = initTracer(std::move(exporter));
+
+  TelemetrySwitch::SetEnabled(false);
+  auto span  = tracer->StartSpan("span 1");
+  auto other = tracer->StartSpan("span 2");
+  TelemetrySwitch::SetEnabled(true);
+
+  // The same invalid span is returned, and nothing is recorded.
+  EXPECT_EQ(span.get(), other.get());
+  EXPECT_FALSE(span->GetContext().IsValid());
+  EXPECT_FALSE(span->IsRecording());
+  span->End();
+  EXPECT_EQ(0, span_data->GetSpans().size());
+
+  // Switching telemetry back on takes effect for the same tracer.
+  tracer->StartSpan("span 3")->End();
+  EXPECT_EQ(1, span_data->GetSpans().size());
+}
+
+TEST(Tracer, ReplaceSamplerAndProcessors)
+{
+  auto processor1_destroyed = std::make_shared<std::atomic<bool>>(false);
+  auto sampler1_destroyed   = std::make_shared<std::atomic<bool>>(false);
+  std::unique_ptr<InMemorySpanExporter> exporter1(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data1 = exporter1->GetData();
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.emplace_back(new DestroyedSpanProcessor(std::move(exporter1), processor1_destroyed));
+  auto context = std::make_shared<TracerContext>(
+      std::move(processors), Resource::Create({}),
+      std::unique_ptr<Sampler>(new DestroyedSampler(sampler1_destroyed)));
+  auto tracer = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  auto span1 = tracer->StartSpan("span 1");
+
+  std::unique_ptr<InMemorySpanExporter> exporter2(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data2 = exporter2->GetData();
+  processors.clear();
+  processors.emplace_back(new SimpleSpanProcessor(std::move(exporter2)));
+  context->SetProcessors(std::move(processors));
+
+  // The span in flight ends on the processor it started with, the next ones on the new one.
+  auto span2 = tracer->StartSpan("span 2");
+  span2->End();
+  EXPECT_FALSE(*processor1_destroyed);
+  span1->End();
+  ASSERT_EQ(1, span_data1->GetSpans().size());
+  ASSERT_EQ(1, span_data2->GetSpans().size());
+
+  // The last span of the replaced processor released it.
+  EXPECT_TRUE(*processor1_destroyed);
+
+  context->SetSampler(std::unique_ptr<Sampler>(new AlwaysOffSampler()));
+  EXPECT_TRUE(*sampler1_destroyed);
+  auto span3 = tracer->StartSpan("span 3");
+  EXPECT_FALSE(span3->IsRecording());
+  span3->End();
+  EXPECT_EQ(0, span_data2->GetSpans().size());
+
+  EXPECT_TRUE(context->ForceFlush());
+  EXPECT_TRUE(context->Shutdown());
+}
+
+TEST(Tracer, ReplaceProcessorsWhileStartingSpans)
+{
+  std::vector<std::shared_ptr<std::atomic<bool>>> destroyed;
+  auto make_processors = [&destroyed]() {
+    destroyed.push_back(std::make_shared<std::atomic<bool>>(false));
+    std::vector<std::unique_ptr<SpanProcessor>> processors;
+    processors.emplace_back(new DestroyedSpanProcessor(
+        std::unique_ptr<SpanExporter>(new InMemorySpanExporter()), destroyed.back()));
+    return processors;
+  };
+  auto context = std::make_shared<TracerContext>(make_processors());
+  auto tracer  = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&tracer, &done]() {
+      while (!done)
+      {
+        auto span = tracer->StartSpan("span");
+        span->End();
+      }
+    });
+  }
+  for (int i = 0; i < 50; ++i)
+  {
+    context->SetProcessors(make_processors());
+    context->SetSampler(std::unique_ptr<Sampler>(new AlwaysOnSampler()));
+  }
+  done = true;
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  // All the replaced processors drained, and were released.
+  for (size_t i = 0; i + 1 < destroyed.size(); ++i)
+  {
+    EXPECT_TRUE(*destroyed[i]);
+  }
+  EXPECT_FALSE(*destroyed.back());
+}
+
 TEST(Tracer, StartSpanCustomIdGenerator)
 {
   IdGenerator *id_generator = new MockIdGenerator();
@@ -217,6 +494,34 @@ TEST(Tracer, StartSpanWithOptionsTime)
   ASSERT_EQ(std::chrono::nanoseconds(30), cur_span_data->GetDuration());
 }
 
+TEST(Tracer, StartSpanCustomClock)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto processor = std::unique_ptr<SpanProcessor>(new SimpleSpanProcessor(std::move(exporter)));
+  std::vector<std::unique_ptr<SpanProcessor>> processors;
+  processors.push_back(std::move(processor));
+  auto context = std::make_shared<TracerContext>(
+      std::move(processors), Resource::Create({}), std::unique_ptr<Sampler>(new AlwaysOnSampler()),
+      std::unique_ptr<IdGenerator>(new RandomIdGenerator()), SpanLimits(),
+      std::unique_ptr<opentelemetry::sdk::common::Clock>(new MockClock()));
+  auto tracer = std::shared_ptr<opentelemetry::trace::Tracer>(new Tracer(context));
+
+  auto span = tracer->StartSpan("span 1");
+  span->AddEvent("event 1");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+
+  auto &cur_span_data = spans.at(0);
+  EXPECT_EQ(std::chrono::nanoseconds(1010), cur_span_data->GetStartTime().time_since_epoch());
+  EXPECT_EQ(std::chrono::nanoseconds(10), cur_span_data->GetDuration());
+  ASSERT_EQ(1, cur_span_data->GetEvents().size());
+  EXPECT_EQ(std::chrono::nanoseconds(1020),
+            cur_span_data->GetEvents().at(0).GetTimestamp().time_since_epoch());
+}
+
 TEST(Tracer, StartSpanWithAttributes)
 {
   std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
@@ -513,6 +818,66 @@ TEST(Tracer, SpanSetLinks)
   }
 }
 
+TEST(Tracer, SpanLimitsAttributes)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  SpanLimits limits;
+  limits.max_attributes             = 2;
+  limits.max_attribute_value_length = 3;
+  auto tracer                       = initTracer(std::move(exporter), limits);
+
+  auto span                 = tracer->StartSpan("span", {{"attr1", "abcdef"}});
+  nostd::string_view strs[] = {"a", "abcd"};
+  span->SetAttribute("attr2", nostd::span<const nostd::string_view>(strs));
+  span->SetAttribute("attr3", 3);
+  // Updating an attribute the span already has is not limited.
+  span->SetAttribute("attr1", "xy");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  auto &attributes = spans.at(0)->GetAttributes();
+  ASSERT_EQ(2, attributes.size());
+  EXPECT_EQ("xy", nostd::get<std::string>(attributes.at("attr1")));
+  EXPECT_EQ((std::vector<std::string>{"a", "abc"}),
+            nostd::get<std::vector<std::string>>(attributes.at("attr2")));
+  EXPECT_EQ(1, spans.at(0)->GetDroppedAttributesCount());
+  EXPECT_EQ(0, spans.at(0)->GetDroppedEventsCount());
+  EXPECT_EQ(0, spans.at(0)->GetDroppedLinksCount());
+}
+
+TEST(Tracer, SpanLimitsEventsAndLinks)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  SpanLimits limits;
+  limits.max_events               = 1;
+  limits.max_links                = 1;
+  limits.max_attributes_per_event = 1;
+  limits.max_attributes_per_link  = 1;
+  auto tracer                     = initTracer(std::move(exporter), limits);
+
+  auto span = tracer->StartSpan("span", {},
+                                {{SpanContext(false, false), {{"attr1", 1}, {"attr2", 2}}},
+                                 {SpanContext(false, false), {{"attr3", 3}}}});
+  span->AddEvent("event1", SystemTimestamp(), {{"attr1", 1}, {"attr2", 2}});
+  span->AddEvent("event2");
+  span->AddEvent("event3");
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  ASSERT_EQ(1, spans.at(0)->GetLinks().size());
+  EXPECT_EQ(1, spans.at(0)->GetLinks().at(0).GetAttributes().size());
+  ASSERT_EQ(1, spans.at(0)->GetEvents().size());
+  EXPECT_EQ("event1", spans.at(0)->GetEvents().at(0).GetName());
+  EXPECT_EQ(1, spans.at(0)->GetEvents().at(0).GetAttributes().size());
+  EXPECT_EQ(0, spans.at(0)->GetDroppedAttributesCount());
+  EXPECT_EQ(2, spans.at(0)->GetDroppedEventsCount());
+  EXPECT_EQ(1, spans.at(0)->GetDroppedLinksCount());
+}
+
 TEST(Tracer, TestAlwaysOnSampler)
 {
   std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
@@ -729,3 +1094,52 @@ TEST(Tracer, SpanCleanupWithScope)
   }
   EXPECT_EQ(4, span_data->GetSpans().size());
 }
+
+TEST(Tracer, ReusesTheMemoryOfReleasedSpans)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto tracer                                 = initTracer(std::move(exporter));
+
+  auto span          = tracer->StartSpan("span0");
+  const void *memory = span.get();
+  auto context       = span->GetContext();
+  span->End();
+  span = nullptr;
+
+  // The next span started on the thread takes the memory back, with its own context.
+  span = tracer->StartSpan("span1");
+  EXPECT_EQ(memory, span.get());
+  EXPECT_TRUE(span->GetContext().IsValid());
+  EXPECT_NE(context.span_id(), span->GetContext().span_id());
+  span->End();
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("span1", spans.at(1)->GetName());
+  EXPECT_EQ(context.span_id(), spans.at(0)->GetSpanId());
+}
+
+TEST(Tracer, StartSpanWithExplicitParentIgnoresTheActiveSpan)
+{
+  std::unique_ptr<InMemorySpanExporter> exporter(new InMemorySpanExporter());
+  std::shared_ptr<InMemorySpanData> span_data = exporter->GetData();
+  auto tracer                                 = initTracer(std::move(exporter));
+
+  auto parent = tracer->StartSpan("parent");
+  auto active = tracer->StartSpan("active");
+  {
+    trace_api::Scope scope(active);
+    auto child = tracer->StartSpan("child", parent->GetContext());
+    auto root  = tracer->StartSpan("root", SpanContext::GetInvalid());
+    EXPECT_EQ(parent->GetContext().trace_id(), child->GetContext().trace_id());
+    EXPECT_NE(active->GetContext().trace_id(), root->GetContext().trace_id());
+    child->End();
+    root->End();
+  }
+
+  auto spans = span_data->GetSpans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ(parent->GetContext().span_id(), spans.at(0)->GetParentSpanId());
+  EXPECT_FALSE(spans.at(1)->GetParentSpanId().IsValid());
+}
@@ -0,0 +1,71 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "opentelemetry/version.h"
+
+/**
+ * Allocation tracking for the benchmarks, linked into all of them by otel_cc_benchmark and the
+ * CMake benchmark targets. It replaces the global operator new and delete to count the calls to
+ * operator new and the bytes they request, and registers a benchmark::MemoryManager, so that every
+ * benchmark reports the allocations per iteration ("allocs_per_iter", and "total_allocated_bytes"
+ * with the Google Benchmark versions supporting it) in its JSON results.
+ *
+ * Allocations are only counted while a ScopedAllocationCounter lives or while the memory manager
+ * runs a benchmark, so that the timed runs of the other benchmarks do not contend on the counters.
+ */
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace test_common
+{
+
+struct AllocationStats
+{
+  /* The calls to operator new */
+  uint64_t count = 0;
+  /* The bytes requested from operator new */
+  uint64_t bytes = 0;
+};
+
+/**
+ * Returns the allocations counted so far, in all threads.
+ */
+AllocationStats GetAllocationStats() noexcept;
+
+/**
+ * Counts the allocations of all threads while it lives, for benchmarks reporting them alongside
+ * the timings of their timed runs.
+ */
+class ScopedAllocationCounter
+{
+public:
+  ScopedAllocationCounter() noexcept;
+
+  ScopedAllocationCounter(const ScopedAllocationCounter &) = delete;
+  ScopedAllocationCounter &operator=(const ScopedAllocationCounter &) = delete;
+
+  ~ScopedAllocationCounter();
+
+  /**
+   * Returns the allocations counted since the counter was created.
+   */
+  AllocationStats Get() const noexcept;
+
+  /**
+   * Reports the allocations counted since the counter was created as the "allocations" and
+   * "allocated_bytes" counters of `state`, averaged over the iterations of all threads. In a
+   * multi-threaded benchmark, the counter should be created and reported by a single thread.
+   */
+  void Report(benchmark::State &state) const;
+
+private:
+  AllocationStats start_;
+};
+
+}  // namespace test_common
+OPENTELEMETRY_END_NAMESPACE
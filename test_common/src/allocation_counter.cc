@@ -0,0 +1,167 @@
+// Copyright The OpenTelemetry Authors
+// SPDX-License-Identifier: Apache-2.0
+
+#include "opentelemetry/test_common/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+// The live ScopedAllocationCounters, plus one while the memory manager runs a benchmark.
+std::atomic<int> counting_scopes{0};
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+void *Allocate(std::size_t size) noexcept
+{
+  if (counting_scopes.load(std::memory_order_relaxed) > 0)
+  {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+// Sets the total_allocated_bytes of the results of the Google Benchmark versions which have it.
+template <class Result>
+auto SetTotalAllocatedBytes(Result &result, int64_t bytes, int)
+    -> decltype(result.total_allocated_bytes = bytes, void())
+{
+  result.total_allocated_bytes = bytes;
+}
+
+template <class Result>
+void SetTotalAllocatedBytes(Result &, int64_t, long)
+{}
+
+class CountingMemoryManager : public benchmark::MemoryManager
+{
+public:
+  void Start() override
+  {
+    counting_scopes.fetch_add(1, std::memory_order_relaxed);
+    start_ = opentelemetry::test_common::GetAllocationStats();
+  }
+
+  // Overrides the only Stop of the older Google Benchmark versions, which the newer call too.
+  void Stop(Result *result) override
+  {
+    auto stats = opentelemetry::test_common::GetAllocationStats();
+    counting_scopes.fetch_sub(1, std::memory_order_relaxed);
+    result->num_allocs = static_cast<int64_t>(stats.count - start_.count);
+    SetTotalAllocatedBytes(*result, static_cast<int64_t>(stats.bytes - start_.bytes), 0);
+  }
+
+private:
+  opentelemetry::test_common::AllocationStats start_;
+};
+
+struct MemoryManagerRegistration
+{
+  MemoryManagerRegistration() { benchmark::RegisterMemoryManager(&memory_manager); }
+
+  CountingMemoryManager memory_manager;
+} memory_manager_registration;
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+  void *ptr = Allocate(size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  return Allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return Allocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+  std::free(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+#endif
+
+OPENTELEMETRY_BEGIN_NAMESPACE
+namespace test_common
+{
+
+AllocationStats GetAllocationStats() noexcept
+{
+  AllocationStats stats;
+  stats.count = allocation_count.load(std::memory_order_relaxed);
+  stats.bytes = allocated_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter() noexcept
+{
+  counting_scopes.fetch_add(1, std::memory_order_relaxed);
+  start_ = GetAllocationStats();
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter()
+{
+  counting_scopes.fetch_sub(1, std::memory_order_relaxed);
+}
+
+AllocationStats ScopedAllocationCounter::Get() const noexcept
+{
+  AllocationStats stats = GetAllocationStats();
+  stats.count -= start_.count;
+  stats.bytes -= start_.bytes;
+  return stats;
+}
+
+void ScopedAllocationCounter::Report(benchmark::State &state) const
+{
+  AllocationStats stats = Get();
+  state.counters["allocations"] =
+      benchmark::Counter(static_cast<double>(stats.count), benchmark::Counter::kAvgIterations);
+  state.counters["allocated_bytes"] =
+      benchmark::Counter(static_cast<double>(stats.bytes), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace test_common
+OPENTELEMETRY_END_NAMESPACE